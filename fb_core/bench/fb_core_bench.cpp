@@ -0,0 +1,453 @@
+/// @file fb_core_bench.cpp
+/// @brief Repeatable fb_core benchmarks for regression tracking: rings
+///        against std::deque, CSV parsing, timer jitter and stop_watch cost
+/// @note Run with --format=json to get one JSON object per result line for
+///       comparison across builds.
+
+#include <fb/circular_buffer.h>
+#include <fb/csv_parser.h>
+#include <fb/csv_view.h>
+#include <fb/fast_stop_watch.h>
+#include <fb/latency_histogram.h>
+#include <fb/stop_watch.h>
+#include <fb/thread_pool.h>
+#include <fb/timer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// ============================================================================
+// Results and reporting
+// ============================================================================
+
+enum class output_format { table, json, csv };
+
+struct result {
+  std::string benchmark;
+  std::string variant;
+  std::vector<std::pair<std::string, double>> metrics;
+  std::string skipped; ///< Reason the benchmark could not run, if any
+};
+
+struct options {
+  output_format format = output_format::table;
+  std::string filter;
+  std::size_t scale = 10; ///< Iteration multiplier; --quick sets 1
+};
+
+std::string format_number(double value) {
+  std::ostringstream out;
+  if (value == static_cast<double>(static_cast<std::int64_t>(value)))
+    out << static_cast<std::int64_t>(value);
+  else
+    out << std::fixed << std::setprecision(2) << value;
+  return out.str();
+}
+
+std::string json_escape(const std::string &text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+void report(const options &opts, const result &r) {
+  switch (opts.format) {
+  case output_format::json: {
+    std::cout << "{\"benchmark\":\"" << r.benchmark << "\",\"variant\":\""
+              << r.variant << "\"";
+    if (!r.skipped.empty())
+      std::cout << ",\"skipped\":\"" << json_escape(r.skipped) << "\"";
+    for (const auto &metric : r.metrics)
+      std::cout << ",\"" << metric.first << "\":" << format_number(metric.second);
+    std::cout << "}\n";
+    break;
+  }
+  case output_format::csv:
+    for (const auto &metric : r.metrics)
+      std::cout << r.benchmark << ',' << r.variant << ',' << metric.first << ','
+                << format_number(metric.second) << '\n';
+    if (!r.skipped.empty())
+      std::cout << r.benchmark << ',' << r.variant << ",skipped,0\n";
+    break;
+  case output_format::table:
+    std::cout << std::left << std::setw(22) << r.benchmark << std::setw(18)
+              << r.variant;
+    if (!r.skipped.empty())
+      std::cout << "skipped: " << r.skipped;
+    for (const auto &metric : r.metrics)
+      std::cout << ' ' << metric.first << '=' << format_number(metric.second);
+    std::cout << '\n';
+    break;
+  }
+  std::cout.flush();
+}
+
+bool selected(const options &opts, const std::string &name) {
+  return opts.filter.empty() || name.find(opts.filter) != std::string::npos;
+}
+
+/// @brief Keep @p value alive so the loop computing it is not removed
+template <typename T> void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile T sink;
+  sink = value;
+#endif
+}
+
+/// @brief @p value, hidden from constant propagation like a runtime setting
+std::size_t opaque(std::size_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : "+r"(value));
+#endif
+  return value;
+}
+
+void add_rate(result &r, std::size_t operations, clock_type::duration elapsed) {
+  const double ns = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  r.metrics.emplace_back("ops", static_cast<double>(operations));
+  r.metrics.emplace_back("ns_per_op", ns / static_cast<double>(operations));
+  r.metrics.emplace_back("mops_per_s", static_cast<double>(operations) * 1e3 / ns);
+}
+
+// ============================================================================
+// circular_buffer
+// ============================================================================
+
+// Passed through opaque() so the modulo variant cannot fold it into a mask
+constexpr std::size_t RING_CAPACITY = 1024;
+
+/// @brief An empty buffer of RING_CAPACITY; std::deque grows on demand
+template <typename Buffer> Buffer make_ring() {
+  return Buffer(opaque(RING_CAPACITY));
+}
+
+template <> std::deque<std::uint64_t> make_ring<std::deque<std::uint64_t>>() {
+  return {};
+}
+
+/// @brief push_back/pop_front pairs on a half-full buffer, wrapping constantly
+template <typename Buffer>
+void bench_ring_push_pop(const options &opts, const char *variant) {
+  Buffer buffer = make_ring<Buffer>();
+  for (std::size_t i = 0; i < RING_CAPACITY / 2; ++i)
+    buffer.push_back(i);
+
+  const std::size_t operations = 2000000 * opts.scale;
+  std::uint64_t sum = 0;
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < operations; ++i) {
+    buffer.push_back(i);
+    sum += buffer.front();
+    buffer.pop_front();
+  }
+  const auto elapsed = clock_type::now() - start;
+  do_not_optimize(sum);
+
+  result r{"ring_push_pop", variant, {}, {}};
+  add_rate(r, operations, elapsed);
+  report(opts, r);
+}
+
+/// @brief operator[] over every element of a full, wrapped buffer
+template <typename Buffer>
+void bench_ring_index(const options &opts, const char *variant) {
+  Buffer buffer = make_ring<Buffer>();
+  for (std::size_t i = 0; i < RING_CAPACITY + RING_CAPACITY / 3; ++i)
+    buffer.push_back(i);
+
+  const std::size_t passes = 2000 * opts.scale;
+  std::uint64_t sum = 0;
+  const auto start = clock_type::now();
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+      sum += buffer[i];
+    do_not_optimize(sum);
+  }
+  const auto elapsed = clock_type::now() - start;
+
+  result r{"ring_index", variant, {}, {}};
+  add_rate(r, passes * buffer.size(), elapsed);
+  report(opts, r);
+}
+
+/// @brief Range-for over a full, wrapped buffer (iterator increments and derefs)
+template <typename Buffer>
+void bench_ring_iterate(const options &opts, const char *variant) {
+  Buffer buffer = make_ring<Buffer>();
+  for (std::size_t i = 0; i < RING_CAPACITY + RING_CAPACITY / 3; ++i)
+    buffer.push_back(i);
+
+  const std::size_t passes = 2000 * opts.scale;
+  std::uint64_t sum = 0;
+  const auto start = clock_type::now();
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    for (std::uint64_t value : buffer)
+      sum += value;
+    do_not_optimize(sum);
+  }
+  const auto elapsed = clock_type::now() - start;
+
+  result r{"ring_iterate", variant, {}, {}};
+  add_rate(r, passes * buffer.size(), elapsed);
+  report(opts, r);
+}
+
+using modulo_ring = fb::circular_buffer<std::uint64_t>;
+using mask_ring   = fb::pow2_circular_buffer<std::uint64_t>;
+using deque_ring  = std::deque<std::uint64_t>;
+
+// ============================================================================
+// CSV parsing
+// ============================================================================
+
+constexpr std::size_t CSV_INPUT_SIZE = 16 * 1024 * 1024;
+
+/// @brief Trade-like rows of plain numbers and symbols, no quotes
+std::string make_plain_csv() {
+  static const char *const symbols[] = {"AAPL", "MSFT", "GOOG", "AMZN", "NVDA", "META"};
+  std::mt19937_64 rng(42);
+  std::string text = "id,time,sym,px,qty,venue\n";
+  for (std::uint64_t id = 0; text.size() < CSV_INPUT_SIZE; ++id) {
+    text += std::to_string(id);
+    text += ",2024-01-02T09:30:00.";
+    text += std::to_string(100000 + rng() % 900000);
+    text += ',';
+    text += symbols[rng() % 6];
+    text += ',';
+    text += std::to_string(100 + rng() % 400);
+    text += '.';
+    text += std::to_string(10 + rng() % 90);
+    text += ',';
+    text += std::to_string(1 + rng() % 5000);
+    text += ",XNAS\n";
+  }
+  return text;
+}
+
+/// @brief Every field quoted, with embedded delimiters, escaped quotes and line breaks
+std::string make_quoted_csv() {
+  std::mt19937_64 rng(7);
+  std::string text = "\"id\",\"name\",\"comment\",\"address\"\n";
+  for (std::uint64_t id = 0; text.size() < CSV_INPUT_SIZE; ++id) {
+    text += '"';
+    text += std::to_string(id);
+    text += "\",\"Smith, John ";
+    text += std::to_string(rng() % 1000);
+    text += "\",\"said \"\"hello\"\", then \"\"bye\"\"\",\"";
+    text += std::to_string(rng() % 10000);
+    text += " Main St\nSuite ";
+    text += std::to_string(rng() % 100);
+    text += ", Springfield\"\n";
+  }
+  return text;
+}
+
+/// @brief Parse @p text with @p parse on every pass and report the fastest
+template <typename Parse>
+void bench_csv_parse(const options &opts, const char *benchmark, const char *variant,
+                     const std::string &text, Parse &&parse) {
+  const std::size_t passes = 1 + opts.scale / 5;
+  clock_type::duration best = clock_type::duration::max();
+  std::size_t rows = 0;
+  for (std::size_t pass = 0; pass < passes; ++pass) {
+    const auto start = clock_type::now();
+    rows = parse(text);
+    best = std::min(best, clock_type::now() - start);
+  }
+
+  const double ns = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(best).count());
+  result r{benchmark, variant, {}, {}};
+  r.metrics.emplace_back("bytes", static_cast<double>(text.size()));
+  r.metrics.emplace_back("rows", static_cast<double>(rows));
+  r.metrics.emplace_back("gb_per_s", static_cast<double>(text.size()) / ns);
+  report(opts, r);
+}
+
+/// @brief csv_parser, csv_view and parallel csv_view over one input
+void bench_csv(const options &opts, const char *benchmark, const std::string &text) {
+  bench_csv_parse(opts, benchmark, "csv_parser", text, [](const std::string &input) {
+    std::istringstream stream(input);
+    const fb::csv_parser parser(stream);
+    return parser.row_count();
+  });
+  bench_csv_parse(opts, benchmark, "csv_view", text, [](const std::string &input) {
+    return fb::csv_view::from_buffer(input).row_count();
+  });
+  bench_csv_parse(opts, benchmark, "csv_view_parallel", text, [](const std::string &input) {
+    return fb::csv_view::from_buffer(input, {}, fb::thread_pool::shared()).row_count();
+  });
+}
+
+// ============================================================================
+// timer jitter
+// ============================================================================
+
+constexpr std::chrono::milliseconds TIMER_INTERVAL{5};
+
+/// @brief Deviation of each interval between firings of a repeating timer
+void bench_timer_jitter(const options &opts, fb::timer_accuracy accuracy, const char *variant) {
+  const std::size_t firings = 40 * opts.scale;
+  std::vector<clock_type::time_point> fired(firings + 1);
+  std::atomic<std::size_t> next{0};
+  std::promise<void> done;
+
+  fb::timer t;
+  t.set_accuracy(accuracy);
+  t.timeout.connect([&]() {
+    const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+    if (i <= firings) {
+      fired[i] = clock_type::now();
+      if (i == firings)
+        done.set_value();
+    }
+  });
+  t.start(std::chrono::duration_cast<std::chrono::nanoseconds>(TIMER_INTERVAL));
+  done.get_future().wait();
+  t.stop();
+
+  fb::latency_histogram jitter;
+  for (std::size_t i = 1; i <= firings; ++i) {
+    const auto interval = fired[i] - fired[i - 1];
+    const auto deviation = interval > TIMER_INTERVAL ? interval - TIMER_INTERVAL
+                                                     : TIMER_INTERVAL - interval;
+    jitter.record(std::chrono::duration_cast<std::chrono::nanoseconds>(deviation));
+  }
+
+  const fb::latency_snapshot summary = jitter.snapshot();
+  const auto us = [](std::chrono::nanoseconds value) {
+    return static_cast<double>(value.count()) / 1e3;
+  };
+  result r{"timer_jitter", variant, {}, {}};
+  r.metrics.emplace_back("samples", static_cast<double>(summary.count));
+  r.metrics.emplace_back("interval_us", us(TIMER_INTERVAL));
+  r.metrics.emplace_back("mean_us", us(summary.mean));
+  r.metrics.emplace_back("p50_us", us(summary.p50));
+  r.metrics.emplace_back("p90_us", us(summary.p90));
+  r.metrics.emplace_back("p99_us", us(summary.p99));
+  r.metrics.emplace_back("max_us", us(summary.max));
+  report(opts, r);
+}
+
+// ============================================================================
+// stop_watch overhead
+// ============================================================================
+
+/// @brief One start() and stop() pair per operation
+template <typename StopWatch>
+void bench_stop_watch(const options &opts, const char *variant) {
+  StopWatch watch;
+  const std::size_t operations = 1000000 * opts.scale;
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < operations; ++i) {
+    watch.start();
+    watch.stop();
+  }
+  const auto elapsed = clock_type::now() - start;
+  do_not_optimize(watch.elapsed_time().count());
+
+  result r{"stop_watch_start_stop", variant, {}, {}};
+  add_rate(r, operations, elapsed);
+  report(opts, r);
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+void usage() {
+  std::cout << "usage: fb_core_bench [--format=table|json|csv] [--quick] "
+               "[--filter=<substring>]\n"
+               "benchmarks: ring_push_pop ring_index ring_iterate csv_plain "
+               "csv_quoted timer_jitter stop_watch_start_stop\n";
+}
+
+template <typename Fn>
+void run(const options &opts, const std::string &name, Fn &&fn) {
+  if (!selected(opts, name))
+    return;
+  try {
+    fn();
+  } catch (const std::exception &ex) {
+    result r{name, "error", {}, ex.what()};
+    report(opts, r);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--format=json")
+      opts.format = output_format::json;
+    else if (arg == "--format=csv")
+      opts.format = output_format::csv;
+    else if (arg == "--format=table")
+      opts.format = output_format::table;
+    else if (arg == "--quick")
+      opts.scale = 1;
+    else if (arg.rfind("--filter=", 0) == 0)
+      opts.filter = arg.substr(9);
+    else {
+      usage();
+      return arg == "--help" ? 0 : 2;
+    }
+  }
+
+  if (opts.format == output_format::csv)
+    std::cout << "benchmark,variant,metric,value\n";
+
+  run(opts, "ring_push_pop", [&]() { bench_ring_push_pop<modulo_ring>(opts, "modulo"); });
+  run(opts, "ring_push_pop", [&]() { bench_ring_push_pop<mask_ring>(opts, "pow2_mask"); });
+  run(opts, "ring_index", [&]() { bench_ring_index<modulo_ring>(opts, "modulo"); });
+  run(opts, "ring_index", [&]() { bench_ring_index<mask_ring>(opts, "pow2_mask"); });
+  run(opts, "ring_iterate", [&]() { bench_ring_iterate<modulo_ring>(opts, "modulo"); });
+  run(opts, "ring_iterate", [&]() { bench_ring_iterate<mask_ring>(opts, "pow2_mask"); });
+  run(opts, "ring_push_pop", [&]() { bench_ring_push_pop<deque_ring>(opts, "std_deque"); });
+  run(opts, "ring_index", [&]() { bench_ring_index<deque_ring>(opts, "std_deque"); });
+  run(opts, "ring_iterate", [&]() { bench_ring_iterate<deque_ring>(opts, "std_deque"); });
+
+  run(opts, "csv_plain", [&]() { bench_csv(opts, "csv_plain", make_plain_csv()); });
+  run(opts, "csv_quoted", [&]() { bench_csv(opts, "csv_quoted", make_quoted_csv()); });
+
+  run(opts, "timer_jitter", [&]() { bench_timer_jitter(opts, fb::timer_accuracy::coarse, "coarse"); });
+  run(opts, "timer_jitter", [&]() { bench_timer_jitter(opts, fb::timer_accuracy::precise, "precise"); });
+  run(opts, "timer_jitter", [&]() {
+    bench_timer_jitter(opts, fb::timer_accuracy::very_precise, "very_precise");
+  });
+
+  run(opts, "stop_watch_start_stop", [&]() { bench_stop_watch<fb::stop_watch>(opts, "stop_watch"); });
+  run(opts, "stop_watch_start_stop", [&]() {
+    bench_stop_watch<fb::fast_stop_watch>(opts, "fast_stop_watch");
+  });
+  run(opts, "stop_watch_start_stop", [&]() {
+    bench_stop_watch<fb::atomic_stop_watch>(opts, "atomic_stop_watch");
+  });
+
+  return 0;
+}
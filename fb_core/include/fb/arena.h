@@ -0,0 +1,138 @@
+/// @file arena.h
+/// @brief Monotonic arena: bump-pointer allocation, freed all at once
+///
+/// A monotonic_arena hands out memory by advancing a pointer through large
+/// chunks and never frees individual allocations. Everything allocated since
+/// the last reset() goes away together, which suits work with a clear end:
+/// one message, one request, one parsed file. It is a
+/// std::pmr::memory_resource, so std::pmr containers, pmr_string_builder and
+/// the allocator-taking constructors of the circular buffers use it directly.
+///
+/// Features:
+/// - Allocation is an align-up and a compare in the common case
+/// - reset() rewinds to the first chunk and keeps every chunk for reuse, so a
+///   steady-state cycle of allocate ... reset() never reaches the upstream
+/// - An optional caller buffer (e.g. on the stack) is used before any chunk
+/// - Chunks double in size, up to MAX_CHUNK_SIZE, as the arena grows
+///
+/// Differences from std::pmr::monotonic_buffer_resource: release() there
+/// returns every chunk to the upstream, so the next cycle allocates them
+/// again; reset() here keeps them.
+///
+/// Thread Safety:
+/// - Not thread-safe; use one arena per thread (or per task)
+///
+/// Example:
+/// @code
+/// fb::monotonic_arena arena;
+/// for (const auto& message : messages)
+/// {
+///   std::pmr::vector<std::pmr::string> fields(&arena);
+///   decode(message, fields);
+///   publish(fields);
+///   arena.reset();  // Destroy fields first: reset() does not run destructors
+/// }
+/// @endcode
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace fb
+{
+
+/// @brief Bump-pointer memory resource reset in one step
+class monotonic_arena : public std::pmr::memory_resource
+{
+public:
+  /// Size of the first chunk unless given
+  static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+  /// Chunks stop doubling at this size; larger requests still get a chunk of their own
+  static constexpr std::size_t MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+
+  /// @brief Construct an arena taking chunks from @p upstream
+  ///
+  /// No memory is taken until the first allocation.
+  ///
+  /// @param chunk_size Size of the first chunk; later chunks double
+  /// @param upstream Source of the chunks; must outlive the arena
+  explicit monotonic_arena(std::size_t                 chunk_size = DEFAULT_CHUNK_SIZE,
+                           std::pmr::memory_resource* upstream   = std::pmr::new_delete_resource());
+
+  /// @brief Construct an arena that allocates from @p buffer first
+  ///
+  /// @param buffer Memory to use before any chunk; must outlive the arena
+  /// @param size Size of @p buffer in bytes
+  /// @param upstream Source of the chunks needed once @p buffer is full
+  monotonic_arena(void* buffer, std::size_t size, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+  /// @brief Return every chunk to the upstream
+  ~monotonic_arena() override;
+
+  monotonic_arena(const monotonic_arena&)            = delete;
+  monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+  /// @brief Forget every allocation and start again from the first chunk
+  ///
+  /// Chunks are kept. Destructors are not run: destroy objects that own
+  /// resources before resetting.
+  void reset() noexcept;
+
+  /// @brief Forget every allocation and return the chunks to the upstream
+  void release() noexcept;
+
+  /// @brief Bytes handed out since construction or the last reset()/release()
+  [[nodiscard]] std::size_t bytes_used() const noexcept
+  {
+    return m_used;
+  }
+
+  /// @brief Bytes of chunk memory held, excluding a caller buffer
+  [[nodiscard]] std::size_t bytes_reserved() const noexcept
+  {
+    return m_reserved;
+  }
+
+  /// @brief Source of the chunks
+  [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept
+  {
+    return m_upstream;
+  }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+  /// Does nothing; memory comes back on reset()/release()
+  void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+  /// @brief Header at the start of each region allocated from
+  struct chunk
+  {
+    chunk*      next;
+    std::size_t size;  ///< Including this header
+    bool        owned; ///< From the upstream, rather than the caller buffer
+  };
+
+  /// Header size rounded so the first allocation of a chunk is max-aligned
+  static constexpr std::size_t HEADER_SIZE =
+      (sizeof(chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+  void* allocate_slow(std::size_t bytes, std::size_t alignment);
+  void  enter(chunk* region) noexcept;
+
+  std::pmr::memory_resource* m_upstream;
+  chunk*                     m_first   = nullptr; ///< Caller buffer, if any, then chunks in order
+  chunk*                     m_current = nullptr; ///< Chunk being carved
+  char*                      m_cursor  = nullptr;
+  char*                      m_end     = nullptr;
+  std::size_t                m_next_chunk_size;
+  std::size_t                m_used     = 0;
+  std::size_t                m_reserved = 0;
+};
+
+} // namespace fb
@@ -6,12 +6,15 @@
  *****************************************************************************/
 
 #include "circular_buffer_iterator.h"
+#include "span_compat.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 namespace fb {
 
@@ -24,10 +27,17 @@ namespace fb {
  * The class also provides random access through the @ref operator[]()
  * function and its random access iterator.
  *
+ * Whole ranges are moved in and out with @ref push_back_n and
+ * @ref pop_front_n, which copy with memcpy for trivially copyable types.
+ * @ref array_one and @ref array_two expose the contents as at most two
+ * contiguous spans; for trivially copyable types @ref free_array_one,
+ * @ref free_array_two and @ref commit_back do the same for the free space,
+ * so e.g. a circular_buffer<char> can be filled by recv() in place.
+ *
  * @note Subscripting the array with an invalid (out of range) index number
  * is undefined, for both for reading and writing.
  *
- * This class template accepts three template parameters:
+ * This class template accepts four template parameters:
  *   - T                            The type of object contained
  *   - always_accept_data_when_full Determines the behavior of
  *                                     @ref push_back when the buffer is full.
@@ -38,16 +48,21 @@ namespace fb {
  *                                     exception raised.
  *   - Alloc                        Allocator type to use (in line with other
  *                                     STL containers).
+ *   - power_of_two_capacity        Set to true the capacity must be a power
+ *                                     of two and every index wraps with a mask
+ *                                     instead of a modulo or compare; see
+ *                                     @ref pow2_circular_buffer.
  */
 template <typename T,
           bool     always_accept_data_when_full = true,
-          typename Alloc                        = std::allocator<T> >
+          typename Alloc                        = std::allocator<T>,
+          bool     power_of_two_capacity        = false>
 class circular_buffer
 {
 public:
 
   // Typedefs
-  typedef circular_buffer<T, always_accept_data_when_full, Alloc>
+  typedef circular_buffer<T, always_accept_data_when_full, Alloc, power_of_two_capacity>
   self_type;
 
   using allocator_type   = Alloc;
@@ -71,10 +86,12 @@ public:
   typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
 
-  explicit circular_buffer(size_t capacity );
+  explicit circular_buffer(size_t capacity, const allocator_type &alloc = allocator_type());
 
   circular_buffer(const circular_buffer &other);
 
+  circular_buffer(const circular_buffer &other, const allocator_type &alloc);
+
   template <class InputIterator>
   circular_buffer(InputIterator from, InputIterator to)
     : m_allocatorT()
@@ -86,7 +103,7 @@ public:
   {
     m_data = allocator_traits::allocate(m_allocatorT, m_arraySize);
     reset_positions();
-    circular_buffer tmp(1);
+    circular_buffer tmp(1, m_allocatorT);
     tmp.assign_and_reserve(from, to);
     swap(tmp);
   }
@@ -95,7 +112,8 @@ public:
 
   circular_buffer &operator=(const self_type &other)
   {
-    circular_buffer tmp(other);
+    // The allocator stays; a stateful one (e.g. std::pmr) is not reassigned
+    circular_buffer tmp(other, m_allocatorT);
     swap(tmp);
     return *this;
   }
@@ -151,6 +169,21 @@ public:
 
   void pop_front();
 
+  size_t push_back_n(const value_type *items, size_t count);
+  size_t pop_front_n(value_type *items, size_t count);
+  size_t pop_front_n(size_t count);
+
+  // Contents, oldest first: array_one() then array_two()
+  span<value_type>       array_one();
+  span<value_type>       array_two();
+  span<const value_type> array_one() const;
+  span<const value_type> array_two() const;
+
+  // Free space in push order, for trivially copyable types only
+  span<value_type> free_array_one();
+  span<value_type> free_array_two();
+  void commit_back(size_t count);
+
   void clear();
 
   reference       operator[](size_t n)       {return at_unchecked(n);}
@@ -185,7 +218,14 @@ private:
 
   constexpr size_t normalize(size_t n) const
   {
-    return n % m_arraySize;
+    if constexpr (power_of_two_capacity)
+    {
+      return n & (m_arraySize - 1);
+    }
+    else
+    {
+      return n % m_arraySize;
+    }
   }
 
   // Converts external index to an array subscript
@@ -212,6 +252,10 @@ private:
 
   void increment_head();
 
+  void advance_tail(size_t count);
+
+  void advance_head(size_t count);
+
   void reset_positions()
   {
     m_head = (m_arraySize > 1) ? 1 : 0;
@@ -241,7 +285,7 @@ private:
       if (m_size == m_arraySize)
       {
         const size_t grown_capacity = std::max(m_arraySize + 1,
-                                               static_cast<size_t>(m_arraySize * 1.5));
+                                               m_arraySize + m_arraySize / 2);
         reserve(grown_capacity);
       }
       push_back(*from);
@@ -259,11 +303,24 @@ private:
   size_t       m_size;
 };
 
+/**
+ * @brief A circular_buffer whose capacity must be a power of two.
+ *
+ * operator[], the iterators and push/pop then wrap indices with a mask.
+ * The constructor throws std::invalid_argument for any other capacity, and
+ * reserve() rounds up to the next power of two.
+ */
+template <typename T,
+          bool     always_accept_data_when_full = true,
+          typename Alloc                        = std::allocator<T> >
+using pow2_circular_buffer = circular_buffer<T, always_accept_data_when_full, Alloc, true>;
+
 template <typename T,
           bool consume_policy,
-          typename Alloc>
-bool operator==(const circular_buffer<T, consume_policy, Alloc> &a,
-                const circular_buffer<T, consume_policy, Alloc> &b)
+          typename Alloc,
+          bool pow2>
+bool operator==(const circular_buffer<T, consume_policy, Alloc, pow2> &a,
+                const circular_buffer<T, consume_policy, Alloc, pow2> &b)
 {
   // Be careful how you understand std::equal here, it can be confusing.
   // https://en.cppreference.com/w/cpp/algorithm/equal
@@ -272,18 +329,20 @@ bool operator==(const circular_buffer<T, consume_policy, Alloc> &a,
 
 template <typename T,
           bool consume_policy,
-          typename Alloc>
-bool operator!=(const circular_buffer<T, consume_policy, Alloc> &a,
-                const circular_buffer<T, consume_policy, Alloc> &b)
+          typename Alloc,
+          bool pow2>
+bool operator!=(const circular_buffer<T, consume_policy, Alloc, pow2> &a,
+                const circular_buffer<T, consume_policy, Alloc, pow2> &b)
 {
   return a.size() != b.size() || !std::equal(a.begin(), a.end(), b.begin());
 }
 
 template <typename T,
           bool consume_policy,
-          typename Alloc> inline
-bool operator<(const circular_buffer<T, consume_policy, Alloc> &a,
-               const circular_buffer<T, consume_policy, Alloc> &b)
+          typename Alloc,
+          bool pow2> inline
+bool operator<(const circular_buffer<T, consume_policy, Alloc, pow2> &a,
+               const circular_buffer<T, consume_policy, Alloc, pow2> &b)
 {
   return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
 }
@@ -294,9 +353,10 @@ bool operator<(const circular_buffer<T, consume_policy, Alloc> &a,
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-circular_buffer<T, consume_policy, Alloc>::circular_buffer(size_t capacity):
-  m_allocatorT()
+         typename Alloc,
+         bool pow2> inline
+circular_buffer<T, consume_policy, Alloc, pow2>::circular_buffer(size_t capacity, const allocator_type &alloc):
+  m_allocatorT(alloc)
   , m_data(nullptr)
   , m_arraySize(capacity)
   , m_head(0)
@@ -307,6 +367,10 @@ circular_buffer<T, consume_policy, Alloc>::circular_buffer(size_t capacity):
   {
     throw std::invalid_argument("circular_buffer capacity must be greater than zero");
   }
+  if (pow2 && (capacity & (capacity - 1)) != 0)
+  {
+    throw std::invalid_argument("pow2_circular_buffer capacity must be a power of two");
+  }
   m_data = allocator_traits::allocate(m_allocatorT, m_arraySize);
   reset_positions();
 }
@@ -316,8 +380,9 @@ circular_buffer<T, consume_policy, Alloc>::circular_buffer(size_t capacity):
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-circular_buffer<T, consume_policy, Alloc>::~circular_buffer()
+         typename Alloc,
+         bool pow2> inline
+circular_buffer<T, consume_policy, Alloc, pow2>::~circular_buffer()
 {
   destroy_all_elements();
   allocator_traits::deallocate(m_allocatorT, m_data, m_arraySize);
@@ -328,8 +393,9 @@ circular_buffer<T, consume_policy, Alloc>::~circular_buffer()
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-size_t circular_buffer<T, consume_policy, Alloc>::max_size() const
+         typename Alloc,
+         bool pow2> inline
+size_t circular_buffer<T, consume_policy, Alloc, pow2>::max_size() const
 {
   return allocator_traits::max_size(m_allocatorT);
 }
@@ -339,12 +405,22 @@ size_t circular_buffer<T, consume_policy, Alloc>::max_size() const
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-void circular_buffer<T, consume_policy, Alloc>::reserve(size_t new_size)
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::reserve(size_t new_size)
 {
   if (capacity() < new_size)
   {
-    circular_buffer tmp(new_size);
+    if (pow2)
+    {
+      size_t rounded = 1;
+      while (rounded < new_size)
+      {
+        rounded <<= 1;
+      }
+      new_size = rounded;
+    }
+    circular_buffer tmp(new_size, m_allocatorT);
     tmp.assign_into(begin(), end());
     swap(tmp);
   }
@@ -356,8 +432,9 @@ void circular_buffer<T, consume_policy, Alloc>::reserve(size_t new_size)
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-void circular_buffer<T, consume_policy, Alloc>::pop_front()
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::pop_front()
 {
   size_t destroy_pos = m_head;
   increment_head();
@@ -369,10 +446,15 @@ void circular_buffer<T, consume_policy, Alloc>::pop_front()
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-void circular_buffer<T, consume_policy, Alloc>::swap(circular_buffer<T, consume_policy, Alloc> &other)
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::swap(circular_buffer<T, consume_policy, Alloc, pow2> &other)
 {
-  std::swap(m_allocatorT,    other.m_allocatorT);
+  if constexpr (allocator_traits::propagate_on_container_swap::value)
+  {
+    using std::swap;
+    swap(m_allocatorT, other.m_allocatorT);
+  }
   std::swap(m_data,         other.m_data);
   std::swap(m_arraySize,    other.m_arraySize);
   std::swap(m_head,          other.m_head);
@@ -385,9 +467,23 @@ void circular_buffer<T, consume_policy, Alloc>::swap(circular_buffer<T, consume_
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-circular_buffer<T, consume_policy, Alloc>::circular_buffer(const circular_buffer<T, consume_policy, Alloc> &other):
-  m_allocatorT(allocator_traits::select_on_container_copy_construction(other.m_allocatorT))
+         typename Alloc,
+         bool pow2> inline
+circular_buffer<T, consume_policy, Alloc, pow2>::circular_buffer(const circular_buffer<T, consume_policy, Alloc, pow2> &other):
+  circular_buffer(other, allocator_traits::select_on_container_copy_construction(other.m_allocatorT))
+{
+}
+
+/**
+ * @brief Copy Constructor allocating from @p alloc.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+circular_buffer<T, consume_policy, Alloc, pow2>::circular_buffer(const circular_buffer<T, consume_policy, Alloc, pow2> &other,
+                                                                 const allocator_type &alloc):
+  m_allocatorT(alloc)
   , m_data(nullptr)
   , m_arraySize(other.m_arraySize)
   , m_head(other.m_head)
@@ -413,8 +509,9 @@ circular_buffer<T, consume_policy, Alloc>::circular_buffer(const circular_buffer
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-void circular_buffer<T, consume_policy, Alloc>::clear()
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::clear()
 {
   for (size_t n = 0; n < m_size; ++n)
   {
@@ -428,8 +525,9 @@ void circular_buffer<T, consume_policy, Alloc>::clear()
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-void circular_buffer<T, consume_policy, Alloc>::increment_tail()
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::increment_tail()
 {
   ++m_size;
   m_tail = next_tail();
@@ -440,9 +538,14 @@ void circular_buffer<T, consume_policy, Alloc>::increment_tail()
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-size_t circular_buffer<T, consume_policy, Alloc>::next_tail()
+         typename Alloc,
+         bool pow2> inline
+size_t circular_buffer<T, consume_policy, Alloc, pow2>::next_tail()
 {
+  if (pow2)
+  {
+    return (m_tail + 1) & (m_arraySize - 1);
+  }
   return (m_tail+1 == m_arraySize) ? 0 : m_tail+1;
 }
 
@@ -451,12 +554,18 @@ size_t circular_buffer<T, consume_policy, Alloc>::next_tail()
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-void circular_buffer<T, consume_policy, Alloc>::increment_head()
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::increment_head()
 {
-  ++m_head;
   --m_size;
 
+  if (pow2)
+  {
+    m_head = (m_head + 1) & (m_arraySize - 1);
+    return;
+  }
+  ++m_head;
   if (m_head == m_arraySize) m_head = 0;
 }
 
@@ -465,8 +574,9 @@ void circular_buffer<T, consume_policy, Alloc>::increment_head()
  */
 template<typename T,
          bool consume_policy,
-         typename Alloc> inline
-void circular_buffer<T, consume_policy, Alloc>::destroy_all_elements()
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::destroy_all_elements()
 {
   for (size_t n = 0; n < m_size; ++n)
   {
@@ -474,5 +584,266 @@ void circular_buffer<T, consume_policy, Alloc>::destroy_all_elements()
   }
 }
 
+/**
+ * @brief Appends @p count items, oldest first.
+ *
+ * Follows the class policy when the items do not fit: with
+ * always_accept_data_when_full the oldest elements are dropped (only the
+ * last capacity() items remain if @p count exceeds it); otherwise only the
+ * leading items that fit are added. Trivially copyable items are copied
+ * with at most two memcpy calls.
+ *
+ * @return Number of items taken from @p items.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+size_t circular_buffer<T, consume_policy, Alloc, pow2>::push_back_n(const value_type *items, size_t count)
+{
+  const size_t accepted = count;
+  if (consume_policy)
+  {
+    if (count > m_arraySize)
+    {
+      items += count - m_arraySize;
+      count  = m_arraySize;
+    }
+    if (count > m_arraySize - m_size)
+    {
+      pop_front_n(count - (m_arraySize - m_size));
+    }
+  }
+  else
+  {
+    count = std::min(count, m_arraySize - m_size);
+  }
+
+  if constexpr (std::is_trivially_copyable<value_type>::value)
+  {
+    const span<value_type> first = free_array_one();
+    const size_t first_count     = std::min(count, first.size());
+    if (first_count)
+    {
+      std::memcpy(first.data(), items, first_count * sizeof(value_type));
+    }
+    if (count > first_count)
+    {
+      std::memcpy(m_data, items + first_count, (count - first_count) * sizeof(value_type));
+    }
+    advance_tail(count);
+  }
+  else
+  {
+    for (size_t n = 0; n < count; ++n)
+    {
+      push_back(items[n]);
+    }
+  }
+  return consume_policy ? accepted : count;
+}
+
+/**
+ * @brief Moves up to @p count of the oldest elements into @p items and
+ * removes them.
+ *
+ * @return Number of elements moved, at most size().
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+size_t circular_buffer<T, consume_policy, Alloc, pow2>::pop_front_n(value_type *items, size_t count)
+{
+  count = std::min(count, m_size);
+  if constexpr (std::is_trivially_copyable<value_type>::value)
+  {
+    const span<value_type> first = array_one();
+    const size_t first_count     = std::min(count, first.size());
+    if (first_count)
+    {
+      std::memcpy(items, first.data(), first_count * sizeof(value_type));
+    }
+    if (count > first_count)
+    {
+      std::memcpy(items + first_count, m_data, (count - first_count) * sizeof(value_type));
+    }
+    advance_head(count);
+  }
+  else
+  {
+    for (size_t n = 0; n < count; ++n)
+    {
+      items[n] = std::move(front());
+      pop_front();
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Removes up to @p count of the oldest elements.
+ *
+ * @return Number of elements removed, at most size().
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+size_t circular_buffer<T, consume_policy, Alloc, pow2>::pop_front_n(size_t count)
+{
+  count = std::min(count, m_size);
+  if constexpr (std::is_trivially_destructible<value_type>::value)
+  {
+    advance_head(count);
+  }
+  else
+  {
+    for (size_t n = 0; n < count; ++n)
+    {
+      pop_front();
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief The oldest elements, up to the end of the storage array.
+ *
+ * Empty only if the buffer is.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+span<typename circular_buffer<T, consume_policy, Alloc, pow2>::value_type>
+circular_buffer<T, consume_policy, Alloc, pow2>::array_one()
+{
+  return span<value_type>(m_data + m_head, std::min(m_size, m_arraySize - m_head));
+}
+
+/**
+ * @brief The elements that wrapped round to the start of the storage array.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+span<typename circular_buffer<T, consume_policy, Alloc, pow2>::value_type>
+circular_buffer<T, consume_policy, Alloc, pow2>::array_two()
+{
+  return span<value_type>(m_data, m_size - std::min(m_size, m_arraySize - m_head));
+}
+
+/**
+ * @brief The oldest elements, up to the end of the storage array.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+span<const typename circular_buffer<T, consume_policy, Alloc, pow2>::value_type>
+circular_buffer<T, consume_policy, Alloc, pow2>::array_one() const
+{
+  return span<const value_type>(m_data + m_head, std::min(m_size, m_arraySize - m_head));
+}
+
+/**
+ * @brief The elements that wrapped round to the start of the storage array.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+span<const typename circular_buffer<T, consume_policy, Alloc, pow2>::value_type>
+circular_buffer<T, consume_policy, Alloc, pow2>::array_two() const
+{
+  return span<const value_type>(m_data, m_size - std::min(m_size, m_arraySize - m_head));
+}
+
+/**
+ * @brief Free slots that the next push fills, up to the end of the storage
+ * array. Write into them, then call @ref commit_back.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+span<typename circular_buffer<T, consume_policy, Alloc, pow2>::value_type>
+circular_buffer<T, consume_policy, Alloc, pow2>::free_array_one()
+{
+  static_assert(std::is_trivially_copyable<value_type>::value,
+                "free_array_one() needs a trivially copyable value_type");
+  if (m_size == m_arraySize)
+  {
+    return span<value_type>();
+  }
+  const size_t next = next_tail();
+  return span<value_type>(m_data + next, std::min(m_arraySize - m_size, m_arraySize - next));
+}
+
+/**
+ * @brief Free slots after those of @ref free_array_one, at the start of the
+ * storage array.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+span<typename circular_buffer<T, consume_policy, Alloc, pow2>::value_type>
+circular_buffer<T, consume_policy, Alloc, pow2>::free_array_two()
+{
+  static_assert(std::is_trivially_copyable<value_type>::value,
+                "free_array_two() needs a trivially copyable value_type");
+  const size_t free_count = m_arraySize - m_size;
+  return span<value_type>(m_data, free_count - free_array_one().size());
+}
+
+/**
+ * @brief Appends the @p count elements written to the free spans.
+ *
+ * @throws std::length_error If count exceeds the free space.
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::commit_back(size_t count)
+{
+  static_assert(std::is_trivially_copyable<value_type>::value,
+                "commit_back() needs a trivially copyable value_type");
+  if (count > m_arraySize - m_size)
+  {
+    throw std::length_error("fb::circular_buffer::commit_back() count exceeds free space");
+  }
+  advance_tail(count);
+}
+
+/**
+ * @brief
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::advance_tail(size_t count)
+{
+  m_size += count;
+  m_tail  = normalize(m_tail + count);
+}
+
+/**
+ * @brief
+ */
+template<typename T,
+         bool consume_policy,
+         typename Alloc,
+         bool pow2> inline
+void circular_buffer<T, consume_policy, Alloc, pow2>::advance_head(size_t count)
+{
+  m_size -= count;
+  m_head  = normalize(m_head + count);
+}
+
 } //namespace
 
@@ -0,0 +1,237 @@
+/// @file csv_columns.h
+/// @brief Schema-driven loading of CSV columns into typed arrays
+///
+/// csv_parser::get_column() builds a std::vector<std::string> per call, and
+/// numeric work then converts every cell a second time. csv_columns takes a
+/// schema naming the columns wanted and their types, streams the input
+/// through a csv_reader and converts each cell as its row is read, into one
+/// contiguous array per column.
+///
+/// Features:
+/// - int64, float64, fixed-point decimal, dictionary-encoded string and
+///   timestamp columns
+/// - Columns are fb::span over contiguous storage, ready for vector loops
+/// - No std::string per cell: cells are converted straight from the read
+///   buffer, and dictionary values are stored once
+/// - Columns missing from the schema are skipped
+/// - Locale-independent conversions with the row and column in every error
+///
+/// Thread Safety:
+/// - A loaded csv_columns is immutable; concurrent reads are safe
+///
+/// Example:
+/// @code
+/// const fb::csv_schema schema = {
+///     {"time", fb::csv_column_type::timestamp},
+///     {"sym", fb::csv_column_type::dictionary},
+///     {"px", fb::csv_column_type::decimal, 4},
+///     {"qty", fb::csv_column_type::int64},
+/// };
+/// fb::csv_columns trades(std::filesystem::path("trades.csv"), schema);
+///
+/// std::int64_t volume = 0;
+/// for (std::int64_t qty : trades.int64s("qty"))
+/// {
+///   volume += qty;
+/// }
+/// @endcode
+
+#pragma once
+
+#include "csv_parser.h"
+#include "span_compat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace fb
+{
+
+class csv_reader;
+
+/// @brief Type a column is converted to
+enum class csv_column_type
+{
+  int64,      ///< Signed decimal integer, into std::int64_t
+  float64,    ///< Decimal or scientific floating point, into double
+  decimal,    ///< Fixed-point decimal, into std::int64_t units of 10^-scale
+  dictionary, ///< String, into a std::uint32_t code per row and one copy per distinct value
+  timestamp,  ///< ISO 8601 date and time, into std::int64_t nanoseconds since the Unix epoch (UTC)
+};
+
+/// @brief One column of a csv_schema
+struct csv_column_spec
+{
+  std::string     name;      ///< Header name; without headers, a label for position in the schema
+  csv_column_type type;      ///< What the cells are converted to
+  int             scale = 0; ///< Digits after the point of a decimal column, 0 to 18
+};
+
+/// @brief The columns to load, in the order csv_columns stores them
+///
+/// With headers, columns are matched by name and may be listed in any
+/// order. Without headers, the schema lists the columns of the input from
+/// the first, in order.
+using csv_schema = std::vector<csv_column_spec>;
+
+/// @brief Typed columnar table loaded from CSV
+///
+/// Basic Usage:
+/// @code
+/// fb::csv_columns quotes(std::filesystem::path("quotes.csv"),
+///                        {{"bid", fb::csv_column_type::float64}, {"ask", fb::csv_column_type::float64}});
+///
+/// fb::span<const double> bid = quotes.doubles("bid");
+/// fb::span<const double> ask = quotes.doubles("ask");
+/// for (std::size_t i = 0; i < quotes.row_count(); ++i)
+/// {
+///   spread += ask[i] - bid[i];
+/// }
+/// @endcode
+///
+/// Cells are converted after csv_config trimming. Timestamps read
+/// "YYYY-MM-DD", optionally followed by 'T' or ' ' and "HH:MM:SS" with up
+/// to nine fraction digits, then an optional 'Z' or "+HH:MM"/"-HH:MM"
+/// offset. A decimal keeps at most scale digits after the point, beyond
+/// trailing zeros. An empty or missing cell is an error for every type but
+/// dictionary, where it is the empty string.
+class csv_columns
+{
+public:
+  // ============================================================================
+  // Type Aliases
+  // ============================================================================
+
+  /// @brief Size type for indices and counts
+  using size_type = std::size_t;
+
+  // ============================================================================
+  // Constructors
+  // ============================================================================
+
+  /// @brief Load the columns of @p schema from a file
+  ///
+  /// @param filepath Path to the CSV file
+  /// @param schema Columns to load
+  /// @param config Parser configuration options
+  /// @throw std::runtime_error if the file cannot be opened, on invalid CSV
+  ///        or on a cell that does not convert to its column type
+  /// @throw std::invalid_argument on an invalid schema, or a column of it
+  ///        missing from the headers
+  csv_columns(const std::filesystem::path& filepath, csv_schema schema, const csv_config& config = {});
+
+  /// @brief Load the columns of @p schema from a stream
+  ///
+  /// @param stream Input stream positioned at the start of CSV data
+  /// @param schema Columns to load
+  /// @param config Parser configuration options
+  /// @throw std::runtime_error on invalid CSV or a cell that does not
+  ///        convert to its column type
+  /// @throw std::invalid_argument on an invalid schema, or a column of it
+  ///        missing from the headers
+  csv_columns(std::istream& stream, csv_schema schema, const csv_config& config = {});
+
+  // ============================================================================
+  // Table Information
+  // ============================================================================
+
+  /// @brief Number of data rows
+  [[nodiscard]] size_type row_count() const noexcept
+  {
+    return m_row_count;
+  }
+
+  /// @brief Number of loaded columns, the size of the schema
+  [[nodiscard]] size_type column_count() const noexcept
+  {
+    return m_columns.size();
+  }
+
+  /// @brief The schema the columns were loaded with
+  [[nodiscard]] const csv_schema& schema() const noexcept
+  {
+    return m_schema;
+  }
+
+  /// @brief Index in the schema of the column named @p name
+  /// @throw std::invalid_argument if no column has that name
+  [[nodiscard]] size_type column_index(std::string_view name) const;
+
+  // ============================================================================
+  // Column Access
+  // ============================================================================
+  //
+  // Each accessor takes the column's index in the schema or its name, and
+  // throws std::out_of_range for an index past the schema and
+  // std::invalid_argument for an unknown name or a column of another type.
+
+  /// @brief Values of an int64 column
+  [[nodiscard]] span<const std::int64_t> int64s(size_type column) const;
+  [[nodiscard]] span<const std::int64_t> int64s(std::string_view name) const;
+
+  /// @brief Values of a float64 column
+  [[nodiscard]] span<const double> doubles(size_type column) const;
+  [[nodiscard]] span<const double> doubles(std::string_view name) const;
+
+  /// @brief Values of a decimal column, in units of 10^-scale
+  [[nodiscard]] span<const std::int64_t> decimals(size_type column) const;
+  [[nodiscard]] span<const std::int64_t> decimals(std::string_view name) const;
+
+  /// @brief Values of a timestamp column, in nanoseconds since 1970-01-01T00:00:00Z
+  [[nodiscard]] span<const std::int64_t> timestamps(size_type column) const;
+  [[nodiscard]] span<const std::int64_t> timestamps(std::string_view name) const;
+
+  /// @brief Per-row codes of a dictionary column, indices into dictionary()
+  [[nodiscard]] span<const std::uint32_t> codes(size_type column) const;
+  [[nodiscard]] span<const std::uint32_t> codes(std::string_view name) const;
+
+  /// @brief Distinct values of a dictionary column, in order of first appearance
+  [[nodiscard]] const std::vector<std::string>& dictionary(size_type column) const;
+  [[nodiscard]] const std::vector<std::string>& dictionary(std::string_view name) const;
+
+private:
+  // ============================================================================
+  // Private Types
+  // ============================================================================
+
+  /// @brief Storage of one column; only the members of its type are used
+  struct column_data
+  {
+    size_type                                      source{0}; ///< Field index in the CSV rows
+    std::vector<std::int64_t>                      integers;  ///< int64, decimal and timestamp values
+    std::vector<double>                            doubles;   ///< float64 values
+    std::vector<std::uint32_t>                     codes;     ///< dictionary codes
+    std::vector<std::string>                       values;    ///< dictionary values by code
+    std::unordered_map<std::string, std::uint32_t> lookup;    ///< dictionary codes by value
+  };
+
+  // ============================================================================
+  // Private Methods
+  // ============================================================================
+
+  /// @brief Match the schema to @p reader's columns and convert every row
+  void load(csv_reader& reader, const std::string& source_name);
+
+  /// @brief Convert @p cell and append it to column @p index
+  void append(size_type index, std::string_view cell, size_type line_number, const std::string& source_name);
+
+  /// @brief Column @p column, checked to be of @p type
+  [[nodiscard]] const column_data& typed(size_type column, csv_column_type type) const;
+
+  // ============================================================================
+  // Member Variables
+  // ============================================================================
+
+  csv_schema               m_schema;       ///< Columns and their types
+  std::vector<column_data> m_columns;      ///< Storage, in schema order
+  size_type                m_row_count{0}; ///< Number of data rows
+  std::string              m_key;          ///< Dictionary lookup key reused while loading
+};
+
+} // namespace fb
@@ -125,6 +125,18 @@ struct csv_config
 ///     std::cout << std::endl;
 /// }
 /// @endcode
+///
+/// Column Handle Example:
+/// @code
+/// fb::csv_parser trades("trades.csv");
+/// const auto px  = trades.column("px");   // Header looked up once
+/// const auto qty = trades.column("qty");
+/// double notional = 0.0;
+/// for (fb::csv_parser::size_type r = 0; r < trades.row_count(); ++r) {
+///     const auto row = trades.row(r);
+///     notional += row.as<double>(px) * row.as<double>(qty);
+/// }
+/// @endcode
 class csv_parser
 {
 public:
@@ -144,6 +156,96 @@ public:
   /// @brief Const iterator type for row iteration
   using const_iterator = std::vector<row_type>::const_iterator;
 
+  // ============================================================================
+  // Column Handles and Row Views
+  // ============================================================================
+
+  /// @brief A column resolved once, so row loops need no header lookup per cell
+  ///
+  /// Get one from column() before the loop. It belongs to the parser that
+  /// made it.
+  class column_ref
+  {
+  public:
+    /// @brief Zero-based index of the column
+    [[nodiscard]] size_type index() const noexcept
+    {
+      return m_index;
+    }
+
+  private:
+    friend class csv_parser;
+
+    explicit column_ref(size_type index) noexcept
+        : m_index(index)
+    {
+    }
+
+    size_type m_index;
+  };
+
+  /// @brief One data row, its cells as views into the parser
+  ///
+  /// Valid while the parser exists. Indexing is an array access; in
+  /// non-strict mode a field missing from a short row reads as empty.
+  class row_view
+  {
+  public:
+    /// @brief Number of fields in this row
+    [[nodiscard]] size_type size() const noexcept
+    {
+      return m_fields->size();
+    }
+
+    /// @brief Zero-based index of this row, excluding the header
+    [[nodiscard]] size_type index() const noexcept
+    {
+      return m_row;
+    }
+
+    /// @brief Cell in column @p col, or an empty view past the last field
+    [[nodiscard]] std::string_view operator[](column_ref col) const noexcept
+    {
+      return (*this)[col.index()];
+    }
+
+    /// @brief Cell @p col, or an empty view past the last field
+    [[nodiscard]] std::string_view operator[](size_type col) const noexcept
+    {
+      return col < m_fields->size() ? std::string_view((*m_fields)[col]) : std::string_view();
+    }
+
+    /// @brief Cell in column @p col converted to @p T
+    ///
+    /// @p T is int, long, long long, unsigned long, unsigned long long,
+    /// float or double. Conversions follow fb::to_int(), fb::to_double()
+    /// and the like: locale-independent, surrounding whitespace ignored,
+    /// nothing else after the number.
+    ///
+    /// @throw std::runtime_error if the cell is not a @p T, naming the row and column
+    template <typename T>
+    [[nodiscard]] T as(column_ref col) const
+    {
+      T value{};
+      m_parser->convert_cell((*this)[col], value, m_row, col.index());
+      return value;
+    }
+
+  private:
+    friend class csv_parser;
+
+    row_view(const csv_parser* parser, const row_type* fields, size_type row) noexcept
+        : m_parser(parser)
+        , m_fields(fields)
+        , m_row(row)
+    {
+    }
+
+    const csv_parser* m_parser;
+    const row_type*   m_fields;
+    size_type         m_row;
+  };
+
   // ============================================================================
   // Constructors
   // ============================================================================
@@ -281,6 +383,42 @@ public:
   /// @return Vector of header names, or empty vector if headers not enabled
   [[nodiscard]] std::vector<std::string> get_headers() const;
 
+  /// @brief Resolve a column by header name, once, for use in row loops
+  ///
+  /// @code
+  /// const auto price = parser.column("price");
+  /// for (csv_parser::size_type r = 0; r < parser.row_count(); ++r)
+  /// {
+  ///   total += parser.row(r).as<double>(price);
+  /// }
+  /// @endcode
+  ///
+  /// @param header_name Column header name
+  /// @return Handle to the column
+  /// @throw std::invalid_argument if headers not enabled or header not found
+  [[nodiscard]] column_ref column(const std::string& header_name) const;
+
+  /// @brief Resolve a column by index
+  ///
+  /// @param col_index Zero-based column index
+  /// @return Handle to the column
+  /// @throw std::out_of_range if col_index >= column_count()
+  [[nodiscard]] column_ref column(size_type col_index) const;
+
+  /// @brief Get a row as views, without copying it
+  ///
+  /// @param row_index Zero-based row index
+  /// @throw std::out_of_range if row_index >= row_count()
+  [[nodiscard]] row_view row(size_type row_index) const;
+
+  /// @brief Get a cell as a view, without copying it
+  ///
+  /// @param row Row index (0-based, excluding header)
+  /// @param col Column from column()
+  /// @return The cell, or an empty view for a field missing in non-strict mode
+  /// @throw std::out_of_range if row index is invalid
+  [[nodiscard]] std::string_view cell(size_type row, column_ref col) const;
+
   // ============================================================================
   // Iterator Support
   // ============================================================================
@@ -350,9 +488,6 @@ private:
   /// @brief Main parsing function
   void parse(std::istream& stream);
 
-  /// @brief Detect and skip UTF-8 BOM at stream start
-  void detect_and_skip_bom(std::istream& stream);
-
   /// @brief Validate a string contains valid UTF-8
   void validate_utf8_string(const std::string& str, size_type line_number) const;
 
@@ -365,18 +500,18 @@ private:
   /// @brief Apply whitespace trimming if configured
   [[nodiscard]] std::string apply_trimming(const std::string& field) const;
 
-  /// @brief Check if a field needs quoting for RFC 4180 output
-  [[nodiscard]] bool needs_quoting(const std::string& field) const;
-
-  /// @brief Quote a field for RFC 4180 output
-  [[nodiscard]] std::string quote_field(const std::string& field) const;
-
-  /// @brief Write a single row in RFC 4180 format
-  void write_row(std::ostream& out, const row_type& row) const;
-
   /// @brief Get column index for a header name
   [[nodiscard]] size_type column_index_for_header(const std::string& header_name) const;
 
+  /// @brief Convert a cell for row_view::as(), or throw naming its row and column
+  void convert_cell(std::string_view cell, int& value, size_type row, size_type col) const;
+  void convert_cell(std::string_view cell, long& value, size_type row, size_type col) const;
+  void convert_cell(std::string_view cell, long long& value, size_type row, size_type col) const;
+  void convert_cell(std::string_view cell, unsigned long& value, size_type row, size_type col) const;
+  void convert_cell(std::string_view cell, unsigned long long& value, size_type row, size_type col) const;
+  void convert_cell(std::string_view cell, float& value, size_type row, size_type col) const;
+  void convert_cell(std::string_view cell, double& value, size_type row, size_type col) const;
+
   // ============================================================================
   // Member Variables
   // ============================================================================
@@ -0,0 +1,338 @@
+/// @file csv_reader.h
+/// @brief Streaming CSV reader yielding one row at a time
+///
+/// csv_parser and csv_view hold the whole table. csv_reader reads its input
+/// through a fixed buffer and hands out one row at a time, so memory stays
+/// constant however large the input is: a rolling trade log bigger than RAM
+/// is read in one pass.
+///
+/// Features:
+/// - Same csv_config options, parsing rules and errors as csv_parser
+/// - Pull (read_row()), callback (for_each_row()) and input iterator styles
+/// - Rows are std::string_view into the read buffer; only fields with
+///   escaped quotes ("") are unescaped, into a buffer reused across rows
+/// - The row vector is reused: no allocation per row once warmed up
+/// - The buffer grows only for a row longer than itself
+/// - Rows straddling a read are never moved: the buffer is a
+///   mirrored_ring_buffer, so the unconsumed bytes stay contiguous in place
+///
+/// Thread Safety:
+/// - A csv_reader is NOT thread-safe
+/// - row() and its views are valid until the next read_row()
+///
+/// Example:
+/// @code
+/// std::ifstream log("trades-2026-10-14.csv", std::ios::binary);
+/// fb::csv_reader trades(log);
+/// const auto price = trades.column_index("price");
+/// while (trades.read_row())
+/// {
+///   std::string_view px = trades.row()[price];
+///   // process row...
+/// }
+/// @endcode
+
+#pragma once
+
+#include "csv_parser.h"
+#include "mirrored_ring_buffer.h"
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace fb
+{
+
+/// Buffer size csv_reader starts with
+inline constexpr std::size_t CSV_READER_BUFFER_SIZE = 64 * 1024;
+
+/// @brief Forward-only CSV reader over a stream
+///
+/// Basic Usage:
+/// @code
+/// fb::csv_reader reader(std::filesystem::path("quotes.csv"));
+///
+/// reader.for_each_row([](const fb::csv_reader::row_type& row) {
+///   // row[0], row[1], ...
+/// });
+///
+/// for (const auto& row : fb::csv_reader(std::cin))
+/// {
+///   // ...
+/// }
+/// @endcode
+class csv_reader
+{
+public:
+  // ============================================================================
+  // Type Aliases
+  // ============================================================================
+
+  /// @brief The fields of the current row, valid until the next read
+  using row_type = std::vector<std::string_view>;
+
+  /// @brief Size type for indices and counts
+  using size_type = std::size_t;
+
+  /// @brief Input iterator over the remaining rows
+  ///
+  /// Incrementing reads the next row; all iterators of a reader share its
+  /// current row.
+  class iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = row_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const row_type*;
+    using reference         = const row_type&;
+
+    iterator() noexcept = default;
+
+    reference operator*() const noexcept
+    {
+      return m_reader->row();
+    }
+
+    pointer operator->() const noexcept
+    {
+      return &m_reader->row();
+    }
+
+    iterator& operator++()
+    {
+      if (!m_reader->read_row())
+      {
+        m_reader = nullptr;
+      }
+      return *this;
+    }
+
+    friend bool operator==(const iterator& a, const iterator& b) noexcept
+    {
+      return a.m_reader == b.m_reader;
+    }
+
+    friend bool operator!=(const iterator& a, const iterator& b) noexcept
+    {
+      return a.m_reader != b.m_reader;
+    }
+
+  private:
+    friend class csv_reader;
+
+    explicit iterator(csv_reader* reader) noexcept
+        : m_reader(reader)
+    {
+    }
+
+    csv_reader* m_reader = nullptr; ///< nullptr once past the last row
+  };
+
+  // ============================================================================
+  // Constructors
+  // ============================================================================
+
+  /// @brief Read from a stream, which must outlive the reader
+  ///
+  /// With has_headers, the header row is read here.
+  ///
+  /// @param stream Input stream positioned at the start of CSV data
+  /// @param config Parser configuration options
+  /// @param buffer_size Initial read buffer size in bytes
+  /// @throw std::runtime_error if the header row is invalid CSV
+  /// @throw std::invalid_argument on duplicate headers
+  explicit csv_reader(std::istream& stream, const csv_config& config = {},
+                      std::size_t buffer_size = CSV_READER_BUFFER_SIZE);
+
+  /// @brief Open and read a file
+  ///
+  /// @param filepath Path to the CSV file
+  /// @param config Parser configuration options
+  /// @param buffer_size Initial read buffer size in bytes
+  /// @throw std::runtime_error if the file cannot be opened
+  explicit csv_reader(const std::filesystem::path& filepath, const csv_config& config = {},
+                      std::size_t buffer_size = CSV_READER_BUFFER_SIZE);
+
+  /// @brief Default destructor
+  ~csv_reader() = default;
+
+  // Non-copyable but moveable
+  csv_reader(const csv_reader&)                = delete;
+  csv_reader& operator=(const csv_reader&)     = delete;
+  csv_reader(csv_reader&&) noexcept            = default;
+  csv_reader& operator=(csv_reader&&) noexcept = default;
+
+  // ============================================================================
+  // Reading
+  // ============================================================================
+
+  /// @brief Read the next data row into row()
+  ///
+  /// Empty rows are skipped in non-strict mode, as csv_parser does.
+  ///
+  /// @return false at the end of the input
+  /// @throw std::runtime_error on invalid CSV or a stream read error
+  bool read_row();
+
+  /// @brief The row read by the last successful read_row()
+  [[nodiscard]] const row_type& row() const noexcept
+  {
+    return m_row;
+  }
+
+  /// @brief Call @p callback with each remaining row
+  ///
+  /// A callback returning bool stops the reading by returning false.
+  ///
+  /// @return Number of rows passed to the callback
+  template <typename Callback>
+  size_type for_each_row(Callback&& callback)
+  {
+    size_type count = 0;
+    while (read_row())
+    {
+      ++count;
+      if constexpr (std::is_same_v<std::invoke_result_t<Callback&, const row_type&>, bool>)
+      {
+        if (!callback(m_row))
+        {
+          break;
+        }
+      }
+      else
+      {
+        callback(m_row);
+      }
+    }
+    return count;
+  }
+
+  // ============================================================================
+  // Iterator Support
+  // ============================================================================
+
+  /// @brief Read the next row and return an iterator to it
+  [[nodiscard]] iterator begin()
+  {
+    return ++iterator(this);
+  }
+
+  [[nodiscard]] iterator end() noexcept
+  {
+    return iterator();
+  }
+
+  // ============================================================================
+  // Headers and Position
+  // ============================================================================
+
+  /// @brief Column headers, or an empty vector if headers not enabled
+  [[nodiscard]] const std::vector<std::string>& get_headers() const noexcept
+  {
+    return m_headers;
+  }
+
+  /// @brief Index of the column with header @p header_name
+  ///
+  /// Look it up once and index row() with it in the loop.
+  ///
+  /// @throw std::invalid_argument if headers not enabled or header not found
+  [[nodiscard]] size_type column_index(std::string_view header_name) const;
+
+  /// @brief Number of columns seen so far
+  ///
+  /// The header count with headers, else the first row's field count; in
+  /// non-strict mode the largest field count read so far.
+  [[nodiscard]] size_type column_count() const noexcept
+  {
+    return m_column_count;
+  }
+
+  /// @brief Number of data rows read so far
+  [[nodiscard]] size_type rows_read() const noexcept
+  {
+    return m_rows_read;
+  }
+
+  /// @brief Line on which the current row ends (1-based)
+  [[nodiscard]] size_type line_number() const noexcept
+  {
+    return m_row_line;
+  }
+
+  /// @brief Parser configuration
+  [[nodiscard]] const csv_config& config() const noexcept
+  {
+    return m_config;
+  }
+
+private:
+  // ============================================================================
+  // Private Types
+  // ============================================================================
+
+  /// @brief Where a field of the row being parsed lives
+  struct field_ref
+  {
+    std::size_t offset;  ///< From the row start in the buffer, or in m_unescaped
+    std::size_t size;    ///< Field length in bytes
+    bool        escaped; ///< The bytes are in m_unescaped
+  };
+
+  // ============================================================================
+  // Private Methods
+  // ============================================================================
+
+  csv_reader(std::istream* stream, std::unique_ptr<std::ifstream> file, const csv_config& config,
+             std::size_t buffer_size, std::string source_name);
+
+  /// @brief Read more input after the unconsumed bytes; false at EOF
+  bool fill();
+
+  /// @brief Read the next non-empty row into m_row, header or data
+  bool next_row();
+
+  /// @brief Parse one row from the buffer into m_fields
+  /// @return false when the buffered bytes end before the row does
+  bool parse_row(std::size_t& row_size, size_type& lines);
+
+  /// @brief Resolve, validate and check the parsed row
+  /// @return false for an empty row skipped in non-strict mode
+  bool finalize_row(const char* row_start);
+
+  // ============================================================================
+  // Member Variables
+  // ============================================================================
+
+  csv_config                                      m_config;             ///< Parser configuration
+  std::unique_ptr<std::ifstream>                  m_file;               ///< Owned stream, when opened from a path
+  std::istream*                                   m_stream;             ///< Where rows are read from
+  std::string                                     m_source_name;        ///< Source name for errors
+  mirrored_ring_buffer                            m_buffer;             ///< Unconsumed bytes, the row being parsed first
+  std::size_t                                     m_window;             ///< Most bytes buffered before m_buffer grows
+  bool                                            m_eof{false};         ///< The stream has no more bytes
+  bool                                            m_bom_checked{false}; ///< The UTF-8 BOM was looked for
+  std::array<bool, 256>                           m_stops{};            ///< Characters ending an unquoted field
+  std::vector<field_ref>                          m_fields;             ///< Fields of the row being parsed
+  std::vector<char>                               m_unescaped;          ///< Unescaped fields of the current row
+  row_type                                        m_row;                ///< The current row
+  std::vector<std::string>                        m_headers;            ///< Header names
+  std::unordered_map<std::string_view, size_type> m_header_index;       ///< Views of m_headers to indices
+  size_type                                       m_column_count{0};    ///< Number of columns
+  size_type                                       m_rows_read{0};       ///< Data rows returned so far
+  size_type                                       m_line_number{1};     ///< Line the next row starts on
+  size_type                                       m_row_line{0};        ///< Line the current row ends on
+};
+
+} // namespace fb
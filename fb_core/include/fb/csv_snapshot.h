@@ -0,0 +1,455 @@
+/// @file csv_snapshot.h
+/// @brief Binary snapshot of a parsed CSV table, mapped back without parsing
+///
+/// Parsing a large CSV file on every start costs seconds. csv_snapshot
+/// writes a parsed csv_parser to a compact binary file once, keyed on the
+/// source file's size and modification time, and later maps that file and
+/// serves cells as std::string_view into the mapping. A restart whose
+/// source has not changed then costs one mmap() and a checksum pass.
+///
+/// File layout (native byte order, 8-byte aligned sections):
+/// - Header: magic, format version, byte-order mark, csv_config, source
+///   size and mtime, counts, and CRC-32s of the payload and of the header
+/// - Row bounds: row_count + 1 uint64 indices into the field offsets
+/// - Field offsets: field_count + 1 uint64 offsets into the text; field i
+///   is text[offsets[i], offsets[i + 1]), header fields first
+/// - Text: every field's bytes, back to back, already unescaped
+///
+/// Features:
+/// - Zero-copy load: offsets and text are read in place from the mapping
+/// - Versioned; files of another version, byte order or config are refused
+/// - CRC-32 (fb::crc32) of header and payload detect truncated or damaged files
+/// - Written to a temporary file and renamed, so readers never see half a file
+/// - Same accessors as csv_view: row_view, get_cell(), get_column(), ...
+///
+/// Thread Safety:
+/// - All const methods may be called from any number of threads at once
+/// - Views stay valid while the csv_snapshot exists, including after a move
+///
+/// Example:
+/// @code
+/// // Parses instruments.csv only when it changed since the last run
+/// auto instruments = fb::csv_snapshot::load_or_build("instruments.csv", "instruments.fbcs");
+/// std::string_view venue = instruments.get_cell(0, "venue");
+/// @endcode
+
+#pragma once
+
+#include "csv_parser.h"
+#include "mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace fb
+{
+
+/// @brief Read-only CSV table mapped from a snapshot file
+///
+/// Basic Usage:
+/// @code
+/// fb::csv_parser parsed("quotes.csv");
+/// fb::csv_snapshot::write(parsed, "quotes.fbcs", fb::csv_snapshot::source_stamp::of("quotes.csv"));
+///
+/// fb::csv_snapshot quotes("quotes.fbcs");
+/// for (const auto& row : quotes)
+/// {
+///   std::string_view symbol = row[0];
+/// }
+/// @endcode
+///
+/// A snapshot holds the table exactly as csv_parser returned it: trimmed
+/// and unescaped cells, rows as long as they were in non-strict mode.
+class csv_snapshot
+{
+public:
+  // ============================================================================
+  // Type Aliases and Constants
+  // ============================================================================
+
+  /// @brief Size type for indices and counts
+  using size_type = std::size_t;
+
+  /// Version written to new snapshots; other versions are refused on load
+  static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+  /// @brief Identity of a source file: its size and modification time
+  struct source_stamp
+  {
+    std::uint64_t size  = 0; ///< Bytes
+    std::int64_t  mtime = 0; ///< Nanoseconds since the filesystem clock's epoch
+
+    /// @brief Stamp of @p filepath as it is now
+    /// @throw std::filesystem::filesystem_error if the file cannot be read
+    [[nodiscard]] static source_stamp of(const std::filesystem::path& filepath);
+
+    friend bool operator==(const source_stamp& a, const source_stamp& b) noexcept
+    {
+      return a.size == b.size && a.mtime == b.mtime;
+    }
+
+    friend bool operator!=(const source_stamp& a, const source_stamp& b) noexcept
+    {
+      return !(a == b);
+    }
+  };
+
+  // ============================================================================
+  // Row View
+  // ============================================================================
+
+  /// @brief The fields of one row, valid while the csv_snapshot exists
+  class row_view
+  {
+  public:
+    /// @brief Iterator over the fields of a row
+    class const_iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = std::string_view;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const std::string_view*;
+      using reference         = std::string_view;
+
+      const_iterator() noexcept = default;
+
+      reference operator*() const noexcept
+      {
+        return m_row->field(m_index);
+      }
+
+      const_iterator& operator++() noexcept
+      {
+        ++m_index;
+        return *this;
+      }
+
+      const_iterator operator++(int) noexcept
+      {
+        const_iterator previous = *this;
+        ++m_index;
+        return previous;
+      }
+
+      friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+      {
+        return a.m_index == b.m_index;
+      }
+
+      friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept
+      {
+        return a.m_index != b.m_index;
+      }
+
+    private:
+      friend class row_view;
+
+      const_iterator(const row_view* row, size_type index) noexcept
+          : m_row(row)
+          , m_index(index)
+      {
+      }
+
+      const row_view* m_row   = nullptr;
+      size_type       m_index = 0;
+    };
+
+    /// @brief Number of fields in this row
+    [[nodiscard]] size_type size() const noexcept
+    {
+      return m_size;
+    }
+
+    /// @brief Check if the row has no fields
+    [[nodiscard]] bool empty() const noexcept
+    {
+      return m_size == 0;
+    }
+
+    /// @brief Field @p index, or an empty view past the last field
+    [[nodiscard]] std::string_view operator[](size_type index) const noexcept
+    {
+      return index < m_size ? field(index) : std::string_view();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+      return {this, 0};
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+      return {this, m_size};
+    }
+
+    /// @brief Copy the fields into owned strings
+    [[nodiscard]] csv_parser::row_type to_strings() const;
+
+  private:
+    friend class csv_snapshot;
+
+    row_view(const char* text, const std::uint64_t* offsets, size_type size) noexcept
+        : m_text(text)
+        , m_offsets(offsets)
+        , m_size(size)
+    {
+    }
+
+    [[nodiscard]] std::string_view field(size_type index) const noexcept
+    {
+      return {m_text + m_offsets[index], m_offsets[index + 1] - m_offsets[index]};
+    }
+
+    const char*          m_text;
+    const std::uint64_t* m_offsets; ///< Offsets of this row's fields, and one past
+    size_type            m_size;
+  };
+
+  /// @brief Iterator over the data rows
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = row_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const row_view*;
+    using reference         = row_view;
+
+    const_iterator() noexcept = default;
+
+    reference operator*() const noexcept
+    {
+      return m_table->row_at(m_index);
+    }
+
+    const_iterator& operator++() noexcept
+    {
+      ++m_index;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept
+    {
+      const_iterator previous = *this;
+      ++m_index;
+      return previous;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_index == b.m_index;
+    }
+
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_index != b.m_index;
+    }
+
+  private:
+    friend class csv_snapshot;
+
+    const_iterator(const csv_snapshot* table, size_type index) noexcept
+        : m_table(table)
+        , m_index(index)
+    {
+    }
+
+    const csv_snapshot* m_table = nullptr;
+    size_type           m_index = 0;
+  };
+
+  // ============================================================================
+  // Writing and Loading
+  // ============================================================================
+
+  /// @brief Write @p table to a snapshot file
+  ///
+  /// The file is written next to @p snapshot_path and renamed over it, so a
+  /// concurrent reader sees the old snapshot or the new one, never a part.
+  ///
+  /// @param table Parsed table to store
+  /// @param snapshot_path File to create or replace
+  /// @param source Stamp of the file @p table was parsed from, checked by
+  ///        load_or_build()
+  /// @throw std::runtime_error if the file cannot be written
+  static void write(const csv_parser& table, const std::filesystem::path& snapshot_path,
+                    const source_stamp& source);
+
+  /// @brief Write @p table, parsed from a stream, to a snapshot file with an empty stamp
+  /// @throw std::runtime_error if the file cannot be written
+  static void write(const csv_parser& table, const std::filesystem::path& snapshot_path);
+
+  /// @brief Map and check a snapshot file
+  ///
+  /// The header is always checked. With @p verify_checksum, the payload's
+  /// CRC-32 is too, which reads the whole file; without it, only the sizes
+  /// are, and a damaged payload may read as wrong cells.
+  ///
+  /// @param snapshot_path File written by write()
+  /// @param verify_checksum Check the payload CRC-32
+  /// @throw std::runtime_error if the file cannot be mapped, is not a
+  ///        snapshot, has another format version or byte order, or is
+  ///        truncated or damaged
+  explicit csv_snapshot(const std::filesystem::path& snapshot_path, bool verify_checksum = true);
+
+  /// @brief Map the snapshot of @p csv_path, or parse it and write one
+  ///
+  /// The snapshot is used when it loads and was written from a source of
+  /// the same size and modification time with the same @p config.
+  /// Otherwise the CSV is parsed with csv_parser and the snapshot replaced;
+  /// the stamp is taken before parsing, so a source changed meanwhile is
+  /// parsed again next time.
+  ///
+  /// @param csv_path Source CSV file
+  /// @param snapshot_path Snapshot file to read or (re)write
+  /// @param config Parser configuration options
+  /// @throw std::runtime_error if the CSV cannot be read or parsed, or the
+  ///        snapshot cannot be written
+  /// @throw std::invalid_argument as csv_parser does
+  [[nodiscard]] static csv_snapshot load_or_build(const std::filesystem::path& csv_path,
+                                                  const std::filesystem::path& snapshot_path,
+                                                  const csv_config&            config = {});
+
+  /// @brief Default destructor
+  ~csv_snapshot() = default;
+
+  // Non-copyable but moveable
+  csv_snapshot(const csv_snapshot&)                = delete;
+  csv_snapshot& operator=(const csv_snapshot&)     = delete;
+  csv_snapshot(csv_snapshot&&) noexcept            = default;
+  csv_snapshot& operator=(csv_snapshot&&) noexcept = default;
+
+  // ============================================================================
+  // Snapshot Information
+  // ============================================================================
+
+  /// @brief Stamp of the source the snapshot was written from
+  [[nodiscard]] const source_stamp& source() const noexcept
+  {
+    return m_source;
+  }
+
+  /// @brief Configuration the source was parsed with
+  [[nodiscard]] const csv_config& config() const noexcept
+  {
+    return m_config;
+  }
+
+  /// @brief Check if the snapshot is of a source with @p source stamp parsed with @p config
+  [[nodiscard]] bool matches(const source_stamp& source, const csv_config& config) const noexcept;
+
+  /// @brief Size of the snapshot file in bytes
+  [[nodiscard]] size_type file_size() const noexcept
+  {
+    return m_file.size();
+  }
+
+  // ============================================================================
+  // Dimension Methods
+  // ============================================================================
+
+  /// @brief Number of data rows, excluding the header row
+  [[nodiscard]] size_type row_count() const noexcept
+  {
+    return m_row_count;
+  }
+
+  /// @brief Number of columns, as csv_parser::column_count()
+  [[nodiscard]] size_type column_count() const noexcept
+  {
+    return m_column_count;
+  }
+
+  // ============================================================================
+  // Data Access Methods
+  // ============================================================================
+
+  /// @brief Get a row by index
+  ///
+  /// @param row_index Zero-based row index, excluding the header
+  /// @throw std::out_of_range if row_index >= row_count()
+  [[nodiscard]] row_view get_row(size_type row_index) const;
+
+  /// @brief Get a column by index, without the header
+  ///
+  /// @throw std::out_of_range if col_index >= column_count()
+  [[nodiscard]] std::vector<std::string_view> get_column(size_type col_index) const;
+
+  /// @brief Get a column by header name
+  ///
+  /// @throw std::invalid_argument if headers not enabled or header not found
+  [[nodiscard]] std::vector<std::string_view> get_column(std::string_view header_name) const;
+
+  /// @brief Get a cell by row and column index
+  ///
+  /// @return The cell, or an empty view for a field missing in non-strict mode
+  /// @throw std::out_of_range if indices are invalid
+  [[nodiscard]] std::string_view get_cell(size_type row, size_type col) const;
+
+  /// @brief Get a cell by row index and column header
+  ///
+  /// @throw std::out_of_range if row index is invalid
+  /// @throw std::invalid_argument if headers not enabled or header not found
+  [[nodiscard]] std::string_view get_cell(size_type row, std::string_view col_header) const;
+
+  /// @brief Get all column headers, or an empty vector if headers are disabled
+  [[nodiscard]] std::vector<std::string_view> get_headers() const;
+
+  // ============================================================================
+  // Iterator Support
+  // ============================================================================
+
+  [[nodiscard]] const_iterator begin() const noexcept
+  {
+    return {this, 0};
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept
+  {
+    return {this, m_row_count};
+  }
+
+private:
+  // ============================================================================
+  // Private Methods
+  // ============================================================================
+
+  /// @brief Check the mapped header and payload and point into them
+  void open(bool verify_checksum);
+
+  /// @brief Build the header name to index map
+  void build_header_index();
+
+  [[nodiscard]] size_type column_index_for_header(std::string_view header_name) const;
+
+  [[nodiscard]] row_view row_at(size_type index) const noexcept
+  {
+    const std::uint64_t first = m_row_bounds[index];
+    return {m_text, m_offsets + first, m_row_bounds[index + 1] - first};
+  }
+
+  // ============================================================================
+  // Member Variables
+  // ============================================================================
+
+  mapped_file                                     m_file;               ///< The snapshot file
+  std::string                                     m_source_name;        ///< Snapshot path for errors
+  csv_config                                      m_config;             ///< Configuration of the source parse
+  source_stamp                                    m_source;             ///< Stamp of the source
+  const std::uint64_t*                            m_row_bounds{nullptr}; ///< Row r is fields [bounds[r], bounds[r + 1])
+  const std::uint64_t*                            m_offsets{nullptr};   ///< Field i is text[offsets[i], offsets[i + 1])
+  const char*                                     m_text{nullptr};      ///< Field bytes
+  size_type                                       m_header_count{0};    ///< Fields of the header row
+  size_type                                       m_row_count{0};       ///< Number of data rows
+  size_type                                       m_column_count{0};    ///< Number of columns
+  std::unordered_map<std::string_view, size_type> m_header_index;       ///< Header to index map
+};
+
+} // namespace fb
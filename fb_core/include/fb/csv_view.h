@@ -0,0 +1,472 @@
+/// @file csv_view.h
+/// @brief Zero-copy CSV reader over a memory-mapped file
+///
+/// csv_parser copies every cell into its own std::string. csv_view instead
+/// maps the file and records where each field starts and ends, so cells are
+/// std::string_view into the mapping. Only quoted fields with escaped
+/// quotes ("") are unescaped into a side buffer.
+///
+/// Features:
+/// - Same csv_config options, parsing rules and errors as csv_parser
+/// - 16 bytes per field instead of a std::string and its heap block
+/// - Rows and cells as string_view; no per-cell allocation on access
+/// - Parses a caller's buffer as well as a mapped file
+/// - Optional parallel parsing of large inputs on a thread_pool
+///
+/// Thread Safety:
+/// - All const methods may be called from any number of threads at once
+/// - Views stay valid while the csv_view exists, including after a move
+///
+/// Example:
+/// @code
+/// fb::csv_view instruments("reference/instruments.csv");
+/// for (const auto& row : instruments)
+/// {
+///   std::string_view isin = row[0];
+///   // process row...
+/// }
+/// std::string_view venue = instruments.get_cell(0, "venue");
+/// @endcode
+
+#pragma once
+
+#include "csv_parser.h"
+#include "mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace fb
+{
+
+class thread_pool;
+
+/// Bytes of input per task when parsing in parallel
+inline constexpr std::size_t CSV_PARALLEL_CHUNK_SIZE = 4 * 1024 * 1024;
+
+/// @brief Read-only CSV table whose cells are views into its input
+///
+/// Basic Usage:
+/// @code
+/// fb::csv_view table("data.csv");
+///
+/// std::cout << "Rows: " << table.row_count() << std::endl;
+/// std::string_view age = table.get_cell(0, "Age");
+///
+/// // A buffer the caller keeps alive
+/// auto inline_table = fb::csv_view::from_buffer("a,b\n1,2\n");
+/// @endcode
+///
+/// Parallel Parsing:
+/// @code
+/// fb::csv_view trades("trades.csv", {}, fb::thread_pool::shared());
+/// @endcode
+///
+/// The input is cut into chunks of about CSV_PARALLEL_CHUNK_SIZE bytes.
+/// One pass counts the quotes of each chunk; the parity of the quotes
+/// before a cut tells whether it falls inside a quoted field, so each
+/// chunk starts at the first line ending outside quotes after its cut.
+/// The chunks are then parsed at once and their rows joined in order.
+/// Quote parity is exact for valid strict-mode input; a chunk that does
+/// not end where the next one starts (a stray quote in non-strict mode),
+/// or any parse error, makes the whole input parse again on the calling
+/// thread, so results and errors are those of the serial parse.
+class csv_view
+{
+  struct field_ref;
+
+public:
+  // ============================================================================
+  // Type Aliases
+  // ============================================================================
+
+  /// @brief Size type for indices and counts
+  using size_type = std::size_t;
+
+  // ============================================================================
+  // Row View
+  // ============================================================================
+
+  /// @brief The fields of one row, valid while the csv_view exists
+  class row_view
+  {
+  public:
+    /// @brief Iterator over the fields of a row
+    class const_iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = std::string_view;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const std::string_view*;
+      using reference         = std::string_view;
+
+      const_iterator() noexcept = default;
+
+      reference operator*() const noexcept
+      {
+        return m_row->field(m_index);
+      }
+
+      const_iterator& operator++() noexcept
+      {
+        ++m_index;
+        return *this;
+      }
+
+      const_iterator operator++(int) noexcept
+      {
+        const_iterator previous = *this;
+        ++m_index;
+        return previous;
+      }
+
+      friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+      {
+        return a.m_index == b.m_index;
+      }
+
+      friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept
+      {
+        return a.m_index != b.m_index;
+      }
+
+    private:
+      friend class row_view;
+
+      const_iterator(const row_view* row, size_type index) noexcept
+          : m_row(row)
+          , m_index(index)
+      {
+      }
+
+      const row_view* m_row   = nullptr;
+      size_type       m_index = 0;
+    };
+
+    /// @brief Number of fields in this row
+    [[nodiscard]] size_type size() const noexcept
+    {
+      return m_size;
+    }
+
+    /// @brief Check if the row has no fields
+    [[nodiscard]] bool empty() const noexcept
+    {
+      return m_size == 0;
+    }
+
+    /// @brief Field @p index, or an empty view past the last field
+    ///
+    /// In non-strict mode rows may be shorter than column_count(); missing
+    /// fields read as empty, as in csv_parser::get_cell().
+    [[nodiscard]] std::string_view operator[](size_type index) const noexcept
+    {
+      return index < m_size ? field(index) : std::string_view();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+      return {this, 0};
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+      return {this, m_size};
+    }
+
+    /// @brief Copy the fields into owned strings
+    [[nodiscard]] csv_parser::row_type to_strings() const;
+
+  private:
+    friend class csv_view;
+
+    row_view(const csv_view* table, const field_ref* fields, size_type size) noexcept
+        : m_table(table)
+        , m_fields(fields)
+        , m_size(size)
+    {
+    }
+
+    [[nodiscard]] std::string_view field(size_type index) const noexcept
+    {
+      return m_table->resolve(m_fields[index]);
+    }
+
+    const csv_view*  m_table;
+    const field_ref* m_fields;
+    size_type        m_size;
+  };
+
+  /// @brief Iterator over the data rows
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = row_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const row_view*;
+    using reference         = row_view;
+
+    const_iterator() noexcept = default;
+
+    reference operator*() const noexcept
+    {
+      return m_table->row_at(m_index);
+    }
+
+    const_iterator& operator++() noexcept
+    {
+      ++m_index;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept
+    {
+      const_iterator previous = *this;
+      ++m_index;
+      return previous;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_index == b.m_index;
+    }
+
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_index != b.m_index;
+    }
+
+  private:
+    friend class csv_view;
+
+    const_iterator(const csv_view* table, size_type index) noexcept
+        : m_table(table)
+        , m_index(index)
+    {
+    }
+
+    const csv_view* m_table = nullptr;
+    size_type       m_index = 0;
+  };
+
+  // ============================================================================
+  // Constructors
+  // ============================================================================
+
+  /// @brief Map @p filepath and parse it
+  ///
+  /// @param filepath Path to the CSV file
+  /// @param config Parser configuration options
+  /// @throw std::runtime_error if the file cannot be mapped or contains invalid CSV
+  /// @throw std::invalid_argument if headers are enabled and two are equal
+  explicit csv_view(const std::filesystem::path& filepath, const csv_config& config = {});
+
+  /// @brief Parse @p data, which must outlive the returned csv_view
+  ///
+  /// @param data CSV text
+  /// @param config Parser configuration options
+  /// @throw std::runtime_error if @p data contains invalid CSV
+  /// @throw std::invalid_argument if headers are enabled and two are equal
+  [[nodiscard]] static csv_view from_buffer(std::string_view data, const csv_config& config = {});
+
+  /// @brief Map @p filepath and parse it on @p pool's workers
+  ///
+  /// The calling thread parses chunks too, so this may be called from a
+  /// task of @p pool.
+  ///
+  /// @param filepath Path to the CSV file
+  /// @param config Parser configuration options
+  /// @param pool Workers to parse chunks on
+  /// @param chunk_size Bytes of input per chunk
+  /// @throw std::runtime_error if the file cannot be mapped or contains invalid CSV
+  /// @throw std::invalid_argument if headers are enabled and two are equal
+  csv_view(const std::filesystem::path& filepath, const csv_config& config, thread_pool& pool,
+           size_type chunk_size = CSV_PARALLEL_CHUNK_SIZE);
+
+  /// @brief Parse @p data on @p pool's workers
+  ///
+  /// @param data CSV text, which must outlive the returned csv_view
+  /// @param config Parser configuration options
+  /// @param pool Workers to parse chunks on
+  /// @param chunk_size Bytes of input per chunk
+  /// @throw std::runtime_error if @p data contains invalid CSV
+  /// @throw std::invalid_argument if headers are enabled and two are equal
+  [[nodiscard]] static csv_view from_buffer(std::string_view data, const csv_config& config, thread_pool& pool,
+                                            size_type chunk_size = CSV_PARALLEL_CHUNK_SIZE);
+
+  /// @brief Default destructor
+  ~csv_view() = default;
+
+  // Non-copyable but moveable
+  csv_view(const csv_view&)                = delete;
+  csv_view& operator=(const csv_view&)     = delete;
+  csv_view(csv_view&&) noexcept            = default;
+  csv_view& operator=(csv_view&&) noexcept = default;
+
+  // ============================================================================
+  // Dimension Methods
+  // ============================================================================
+
+  /// @brief Number of data rows, excluding the header row
+  [[nodiscard]] size_type row_count() const noexcept
+  {
+    return m_row_bounds.size() - 1;
+  }
+
+  /// @brief Number of columns, as csv_parser::column_count()
+  [[nodiscard]] size_type column_count() const noexcept
+  {
+    return m_column_count;
+  }
+
+  // ============================================================================
+  // Data Access Methods
+  // ============================================================================
+
+  /// @brief Get a row by index
+  ///
+  /// @param row_index Zero-based row index, excluding the header
+  /// @throw std::out_of_range if row_index >= row_count()
+  [[nodiscard]] row_view get_row(size_type row_index) const;
+
+  /// @brief Get a column by index, without the header
+  ///
+  /// @throw std::out_of_range if col_index >= column_count()
+  [[nodiscard]] std::vector<std::string_view> get_column(size_type col_index) const;
+
+  /// @brief Get a column by header name
+  ///
+  /// @throw std::invalid_argument if headers not enabled or header not found
+  [[nodiscard]] std::vector<std::string_view> get_column(std::string_view header_name) const;
+
+  /// @brief Get a cell by row and column index
+  ///
+  /// @return The cell, or an empty view for a field missing in non-strict mode
+  /// @throw std::out_of_range if indices are invalid
+  [[nodiscard]] std::string_view get_cell(size_type row, size_type col) const;
+
+  /// @brief Get a cell by row index and column header
+  ///
+  /// @throw std::out_of_range if row index is invalid
+  /// @throw std::invalid_argument if headers not enabled or header not found
+  [[nodiscard]] std::string_view get_cell(size_type row, std::string_view col_header) const;
+
+  /// @brief Get all column headers, or an empty vector if headers are disabled
+  [[nodiscard]] std::vector<std::string_view> get_headers() const;
+
+  /// @brief Bytes copied to unescape quoted fields containing ""
+  [[nodiscard]] size_type unescaped_bytes() const noexcept
+  {
+    return m_unescaped.size();
+  }
+
+  // ============================================================================
+  // Iterator Support
+  // ============================================================================
+
+  [[nodiscard]] const_iterator begin() const noexcept
+  {
+    return {this, 0};
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept
+  {
+    return {this, row_count()};
+  }
+
+  // ============================================================================
+  // Configuration Access
+  // ============================================================================
+
+  /// @brief Get the parser configuration
+  [[nodiscard]] const csv_config& config() const noexcept
+  {
+    return m_config;
+  }
+
+private:
+  // ============================================================================
+  // Private Types
+  // ============================================================================
+
+  /// @brief Where a field's bytes are: the input or the unescape buffer
+  struct field_ref
+  {
+    std::uint64_t offset;  ///< From the start of the input or m_unescaped
+    std::uint32_t size;    ///< Field length in bytes
+    std::uint32_t escaped; ///< Non-zero when the bytes are in m_unescaped
+  };
+
+  // ============================================================================
+  // Private Methods
+  // ============================================================================
+
+  /// @brief Fields and rows parsed from a range of the input
+  struct parsed_range;
+
+  csv_view(const std::filesystem::path& filepath, const csv_config& config, thread_pool* pool,
+           size_type chunk_size);
+
+  csv_view(std::string_view data, const csv_config& config, std::string source_name, thread_pool* pool,
+           size_type chunk_size);
+
+  /// @brief Record the offsets of every field of m_input, on @p pool if given
+  void parse(thread_pool* pool, size_type chunk_size);
+
+  /// @brief Parse the rows of m_input that start in [@p begin, @p stop)
+  ///
+  /// With @p whole_input, also takes the header row and checks field counts
+  /// as it goes; for a chunk, parse_parallel() checks them when joining.
+  void parse_range(size_type begin, size_type stop, parsed_range& out, bool whole_input) const;
+
+  /// @brief Parse m_input from @p begin in chunks on @p pool
+  /// @return false if the chunks do not join up or one fails to parse
+  bool parse_parallel(thread_pool& pool, size_type begin, size_type chunk_size);
+
+  /// @brief Start of the row after the first line ending at or after @p pos
+  [[nodiscard]] size_type row_start_after(size_type pos, bool in_quotes) const noexcept;
+
+  /// @brief Check the row that starts at field @p row_first and keep or drop it
+  void finalize_row(parsed_range& out, size_type row_first, size_type line_number, bool whole_input) const;
+
+  /// @brief Build the header name to index map
+  void build_header_index();
+
+  [[nodiscard]] size_type column_index_for_header(std::string_view header_name) const;
+
+  [[nodiscard]] std::string_view resolve(const field_ref& ref) const noexcept
+  {
+    return {(ref.escaped != 0 ? m_unescaped.data() : m_input.data()) + ref.offset, ref.size};
+  }
+
+  [[nodiscard]] row_view row_at(size_type index) const noexcept
+  {
+    const size_type first = m_row_bounds[index];
+    return {this, m_fields.data() + first, m_row_bounds[index + 1] - first};
+  }
+
+  // ============================================================================
+  // Member Variables
+  // ============================================================================
+
+  csv_config                                      m_config;          ///< Parser configuration
+  mapped_file                                     m_file;            ///< Mapping, when constructed from a path
+  std::string_view                                m_input;           ///< The CSV text
+  std::string                                     m_source_name;     ///< Source name for errors
+  std::vector<field_ref>                          m_fields;          ///< Every field, header first
+  std::vector<size_type>                          m_row_bounds{0};   ///< Row r is fields [bounds[r], bounds[r + 1])
+  std::vector<char>                               m_unescaped;       ///< Unescaped quoted fields
+  std::unordered_map<std::string_view, size_type> m_header_index;    ///< Header to index map
+  size_type                                       m_header_count{0}; ///< Fields of the header row
+  size_type                                       m_column_count{0}; ///< Number of columns
+};
+
+} // namespace fb
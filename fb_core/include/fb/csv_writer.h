@@ -0,0 +1,223 @@
+/// @file csv_writer.h
+/// @brief Buffered streaming CSV writer
+///
+/// csv_writer appends fields straight into one output buffer and hands it
+/// to the stream only when full, so writing a row allocates nothing: no
+/// std::string per field for quoting, and numbers are formatted with
+/// std::to_chars in place.
+///
+/// Features:
+/// - RFC 4180 output: fields quoted only when they hold a quote, the
+///   delimiter, CR or LF, quotes doubled, CRLF line endings
+/// - The bytes needing quotes are found 64 at a time, with the SIMD
+///   classification the CSV parsers use
+/// - Integer and floating-point fields, in shortest round-trip form for
+///   doubles
+/// - Field-at-a-time or row-at-a-time writing
+///
+/// Thread Safety:
+/// - A csv_writer is NOT thread-safe
+///
+/// Example:
+/// @code
+/// std::ofstream out("eod-2026-10-14.csv", std::ios::binary);
+/// fb::csv_writer csv(out);
+/// csv.write_row("sym", "px", "qty");
+/// for (const auto& fill : fills)
+/// {
+///   csv.write_row(fill.symbol, fill.price, fill.quantity);
+/// }
+/// csv.flush();
+/// @endcode
+
+#pragma once
+
+#include "csv_parser.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace fb
+{
+
+/// Output buffer size csv_writer uses
+inline constexpr std::size_t CSV_WRITER_BUFFER_SIZE = 1024 * 1024;
+
+/// @brief Forward-only CSV writer into a stream
+///
+/// Basic Usage:
+/// @code
+/// fb::csv_writer writer(std::filesystem::path("out.csv"));
+///
+/// writer.field("EURUSD").field(1.0712).field(100).end_row();
+/// writer.write_row("USDJPY", 149.25, -20);
+/// @endcode
+///
+/// Only csv_config::delimiter applies; the other options are for reading.
+/// Rows go to the stream when the buffer fills, on flush() and on
+/// destruction.
+class csv_writer
+{
+public:
+  // ============================================================================
+  // Type Aliases
+  // ============================================================================
+
+  /// @brief Size type for counts
+  using size_type = std::size_t;
+
+  // ============================================================================
+  // Constructors
+  // ============================================================================
+
+  /// @brief Write to a stream, which must outlive the writer
+  ///
+  /// @param stream Output stream
+  /// @param config Output configuration; only the delimiter is used
+  /// @param buffer_size Output buffer size in bytes
+  explicit csv_writer(std::ostream& stream, const csv_config& config = {},
+                      std::size_t buffer_size = CSV_WRITER_BUFFER_SIZE);
+
+  /// @brief Create or truncate a file and write to it
+  ///
+  /// @param filepath Path to the CSV file
+  /// @param config Output configuration; only the delimiter is used
+  /// @param buffer_size Output buffer size in bytes
+  /// @throw std::runtime_error if the file cannot be opened
+  explicit csv_writer(const std::filesystem::path& filepath, const csv_config& config = {},
+                      std::size_t buffer_size = CSV_WRITER_BUFFER_SIZE);
+
+  /// @brief Write out the buffer; errors are ignored here, call flush() to see them
+  ~csv_writer();
+
+  // Non-copyable and non-moveable: the buffer belongs to one stream
+  csv_writer(const csv_writer&)            = delete;
+  csv_writer& operator=(const csv_writer&) = delete;
+  csv_writer(csv_writer&&)                 = delete;
+  csv_writer& operator=(csv_writer&&)      = delete;
+
+  // ============================================================================
+  // Writing
+  // ============================================================================
+
+  /// @brief Append a text field to the current row, quoted if needed
+  csv_writer& field(std::string_view value);
+
+  /// @brief Append an integer field to the current row
+  template <typename T,
+            std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>, int> = 0>
+  csv_writer& field(T value)
+  {
+    if constexpr (std::is_signed_v<T>)
+    {
+      append_integer(static_cast<std::int64_t>(value));
+    }
+    else
+    {
+      append_integer(static_cast<std::uint64_t>(value));
+    }
+    return *this;
+  }
+
+  /// @brief Append a floating-point field, in its shortest round-trip form
+  csv_writer& field(double value);
+
+  /// @brief End the current row
+  csv_writer& end_row();
+
+  /// @brief Write @p fields, text or numbers, as one row
+  template <typename... Fields>
+  csv_writer& write_row(const Fields&... fields)
+  {
+    (field(fields), ...);
+    return end_row();
+  }
+
+  /// @brief Write the fields of a csv_parser row as one row
+  csv_writer& write_row(const std::vector<std::string>& row);
+
+  /// @brief Write the fields of a csv_reader row as one row
+  csv_writer& write_row(const std::vector<std::string_view>& row);
+
+  /// @brief Write out the buffer and flush the stream
+  /// @throw std::runtime_error if the stream fails
+  void flush();
+
+  // ============================================================================
+  // Statistics
+  // ============================================================================
+
+  /// @brief Rows ended so far
+  [[nodiscard]] size_type rows_written() const noexcept
+  {
+    return m_rows_written;
+  }
+
+  /// @brief Bytes of CSV produced so far, buffered or not
+  [[nodiscard]] size_type bytes_written() const noexcept
+  {
+    return m_flushed_bytes + m_size;
+  }
+
+  /// @brief Output configuration
+  [[nodiscard]] const csv_config& config() const noexcept
+  {
+    return m_config;
+  }
+
+private:
+  // ============================================================================
+  // Private Methods
+  // ============================================================================
+
+  csv_writer(std::ostream* stream, std::unique_ptr<std::ofstream> file, const csv_config& config,
+             std::size_t buffer_size, std::string target_name);
+
+  void append_integer(std::int64_t value);
+  void append_integer(std::uint64_t value);
+
+  /// @brief Append a formatted number as a field
+  void append_number(const char* text, std::size_t count);
+
+  /// @brief Room for @p count more bytes in the buffer
+  /// @return false if @p count is larger than the whole buffer
+  bool reserve(std::size_t count);
+
+  /// @brief Append bytes, through the buffer or straight to the stream
+  void put(const char* data, std::size_t count);
+
+  /// @brief Write out the buffer without flushing the stream
+  void write_buffer();
+
+  /// @brief The delimiter, unless the field starts the row
+  void begin_field();
+
+  /// @brief Append @p value between quotes, doubling its quotes
+  /// @param clean Length of the prefix of @p value known to hold no quote
+  void append_quoted(std::string_view value, std::size_t clean);
+
+  // ============================================================================
+  // Member Variables
+  // ============================================================================
+
+  csv_config                     m_config;              ///< Output configuration
+  std::unique_ptr<std::ofstream> m_file;                ///< Owned stream, when opened from a path
+  std::ostream*                  m_stream;              ///< Where rows are written
+  std::string                    m_target_name;         ///< Target name for errors
+  std::vector<char>              m_buffer;              ///< Output buffer
+  std::size_t                    m_size{0};             ///< Bytes in m_buffer
+  size_type                      m_flushed_bytes{0};    ///< Bytes handed to the stream
+  size_type                      m_rows_written{0};     ///< Rows ended so far
+  bool                           m_row_started{false};  ///< The current row has a field
+  bool                           m_plain_numbers{true}; ///< Formatted numbers never need quoting
+};
+
+} // namespace fb
@@ -0,0 +1,76 @@
+/// @file csv_scan.h
+/// @brief Internal 64-byte structural scanner shared by the CSV parsers
+///
+/// Stage 1 of the CSV parse: each 64-byte block is classified into
+/// bitmasks of quotes, separators (the delimiter, \r and \n) and line
+/// feeds, and the inclusive prefix XOR of the quote mask (a carry-less
+/// multiply by all ones where the CPU has one) marks the bytes inside
+/// quoted fields. A field then ends at the lowest separator bit outside
+/// quotes, found with one count-trailing-zeros.
+///
+/// Stage 2 stays in the parsers: a field without quotes, or quoted with
+/// no escaped quote and nothing after the closing quote, is taken straight
+/// from the scan. Anything else, including every error case, goes through
+/// the byte-at-a-time rules, and the next scan restarts from where those
+/// left off, so csv_config semantics are those of the scalar parse.
+///
+/// csv_writer uses the same classification to find the fields to quote.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace fb::detail
+{
+
+/// @brief How far a field reaches, from csv_structural_scanner::scan_field()
+struct csv_field_scan
+{
+  std::size_t end;        ///< Offset of the separator ending the field, or the input size
+  std::size_t quotes;     ///< Quotes in [start, end)
+  std::size_t line_feeds; ///< Line feeds in [start, end), all inside quotes
+};
+
+/// @brief Bitmasks of one 64-byte block, bit i for byte i
+struct csv_block_masks
+{
+  std::uint64_t quote;     ///< '"'
+  std::uint64_t separator; ///< The delimiter, '\r' or '\n'
+  std::uint64_t line_feed; ///< '\n'
+  std::uint64_t inside;    ///< Inside quotes, if the block starts outside
+};
+
+/// @brief Offset of the first quote, @p delimiter, '\r' or '\n' in @p text,
+/// or its size: the bytes that make a written field need quoting
+[[nodiscard]] std::size_t find_csv_special(std::string_view text, char delimiter) noexcept;
+
+/// @brief Finds field ends a 64-byte block at a time
+///
+/// Keeps the masks of the last block classified, so the fields of one
+/// block cost one classification between them.
+class csv_structural_scanner
+{
+public:
+  csv_structural_scanner(std::string_view text, char delimiter) noexcept
+      : m_text(text)
+      , m_delimiter(delimiter)
+  {
+  }
+
+  /// @brief Scan the field starting at @p start
+  /// @pre @p start is a field start, so outside quotes
+  [[nodiscard]] csv_field_scan scan_field(std::size_t start) noexcept;
+
+private:
+  /// @brief Classify the block at @p base
+  void load(std::size_t base) noexcept;
+
+  std::string_view m_text;
+  char             m_delimiter;
+  std::size_t      m_base = std::string_view::npos; ///< Offset of the classified block
+  csv_block_masks  m_masks{};
+};
+
+} // namespace fb::detail
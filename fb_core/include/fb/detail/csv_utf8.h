@@ -0,0 +1,81 @@
+/// @file csv_utf8.h
+/// @brief UTF-8 check shared by csv_parser and csv_view
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace fb::detail
+{
+
+/// @brief What check_utf8() found wrong, if anything
+enum class utf8_error
+{
+  none,
+  invalid_sequence,    ///< A byte that cannot start a sequence
+  invalid_continuation ///< A lead byte not followed by enough continuation bytes
+};
+
+/// @brief Check the lead and continuation bytes of @p str
+inline utf8_error check_utf8(std::string_view str) noexcept
+{
+  for (std::size_t i = 0; i < str.size();)
+  {
+    // ASCII fast path: eight bytes at a time
+    std::uint64_t word = 0;
+    if (i + sizeof(word) <= str.size())
+    {
+      std::memcpy(&word, str.data() + i, sizeof(word));
+      if ((word & 0x8080808080808080ULL) == 0)
+      {
+        i += sizeof(word);
+        continue;
+      }
+    }
+
+    auto        c                     = static_cast<unsigned char>(str[i]);
+    std::size_t expected_continuation = 0;
+
+    if ((c & 0x80) == 0)
+    {
+      // ASCII: 0xxxxxxx
+      ++i;
+      continue;
+    }
+    else if ((c & 0xE0) == 0xC0)
+    {
+      // 2-byte: 110xxxxx
+      expected_continuation = 1;
+    }
+    else if ((c & 0xF0) == 0xE0)
+    {
+      // 3-byte: 1110xxxx
+      expected_continuation = 2;
+    }
+    else if ((c & 0xF8) == 0xF0)
+    {
+      // 4-byte: 11110xxx
+      expected_continuation = 3;
+    }
+    else
+    {
+      return utf8_error::invalid_sequence;
+    }
+
+    // Validate continuation bytes
+    for (std::size_t j = 1; j <= expected_continuation; ++j)
+    {
+      if (i + j >= str.size() || (static_cast<unsigned char>(str[i + j]) & 0xC0) != 0x80)
+      {
+        return utf8_error::invalid_continuation;
+      }
+    }
+    i += 1 + expected_continuation;
+  }
+  return utf8_error::none;
+}
+
+} // namespace fb::detail
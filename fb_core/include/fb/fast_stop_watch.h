@@ -0,0 +1,445 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define FB_TSC_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+#define FB_TSC_ARM64 1
+#endif
+
+namespace fb {
+
+/**
+ * @brief Cycle counter clock for hot-path timing.
+ *
+ * Reads the x86 time stamp counter (rdtsc, fenced with lfence so it is not
+ * reordered with the code being timed) or the ARM64 virtual counter
+ * (cntvct_el0). The tick rate is measured once, on first use, against
+ * std::chrono::steady_clock on x86, and read from cntfrq_el0 on ARM64.
+ *
+ * The first call into the clock therefore takes about 5 ms on x86; call
+ * is_hardware() during startup to take that cost there.
+ *
+ * Reading the counter takes a few nanoseconds and never enters the kernel.
+ * Where no constant-rate counter exists (other CPUs, or an x86 CPU without
+ * an invariant TSC) the clock falls back to steady_clock; see is_hardware().
+ */
+class tsc_clock
+{
+public:
+  using duration = std::chrono::nanoseconds;
+
+  [[nodiscard]] static std::uint64_t now() noexcept;
+  [[nodiscard]] static std::uint64_t ticks_between(std::uint64_t begin, std::uint64_t end) noexcept;
+  [[nodiscard]] static duration to_duration(std::uint64_t ticks) noexcept;
+  [[nodiscard]] static double ticks_per_second() noexcept;
+  [[nodiscard]] static bool is_hardware() noexcept;
+
+private:
+
+  struct calibration
+  {
+    bool   hardware;          ///< Ticks come from the CPU counter
+    double nanoseconds_per_tick;
+  };
+
+  static const calibration& calibrated() noexcept;
+  static calibration calibrate() noexcept;
+  static std::uint64_t read_counter() noexcept;
+  static std::uint64_t steady_ticks() noexcept;
+};
+
+/**
+ * @brief Lock-free stopwatch for a single owning thread.
+ *
+ * Same interface as stop_watch, but timed with tsc_clock and without any
+ * locking, so start() and stop() cost a counter read each. Use it from one
+ * thread at a time; atomic_stop_watch may be shared.
+ */
+class fast_stop_watch
+{
+public:
+  using clock_type = tsc_clock;
+  using duration = std::chrono::nanoseconds;
+
+  explicit fast_stop_watch(bool start_immediately = true) noexcept;
+  void start() noexcept;
+  void stop() noexcept;
+  [[nodiscard]] duration elapsed_time() const noexcept;
+  [[nodiscard]] std::uint64_t elapsed_ticks() const noexcept;
+  [[nodiscard]] bool is_running() const noexcept;
+  void reset(bool start_immediately = true) noexcept;
+
+private:
+
+  std::uint64_t m_start_ticks;
+  std::uint64_t m_accumulated;
+  bool m_is_running;
+};
+
+/**
+ * @brief Thread-safe stopwatch built on one atomic word instead of a mutex.
+ *
+ * Same interface as stop_watch, timed with tsc_clock. The whole state is
+ * one 64-bit word: while running it holds the start tick minus the time
+ * accumulated so far, with the top bit set; while stopped it holds the
+ * accumulated ticks. start() and stop() are one compare-and-swap each and
+ * elapsed_time() is one load, so any number of threads may use it at once.
+ */
+class atomic_stop_watch
+{
+public:
+  using clock_type = tsc_clock;
+  using duration = std::chrono::nanoseconds;
+
+  explicit atomic_stop_watch(bool start_immediately = true) noexcept;
+  void start() noexcept;
+  void stop() noexcept;
+  [[nodiscard]] duration elapsed_time() const noexcept;
+  [[nodiscard]] std::uint64_t elapsed_ticks() const noexcept;
+  [[nodiscard]] bool is_running() const noexcept;
+  void reset(bool start_immediately = true) noexcept;
+
+private:
+
+  static constexpr std::uint64_t RUNNING = std::uint64_t(1) << 63;
+
+  std::atomic<std::uint64_t> m_state;
+};
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+/**
+ * @brief Current counter value in ticks.
+ *
+ * Only differences between two readings are meaningful; convert them with
+ * to_duration().
+ */
+inline std::uint64_t tsc_clock::now() noexcept
+{
+  if (calibrated().hardware)
+  {
+    return read_counter();
+  }
+  return steady_ticks();
+}
+
+/**
+ * @brief Ticks from @p begin to @p end, or 0 if @p end reads earlier.
+ *
+ * The counters of different cores may differ by a few ticks, so a thread
+ * that migrates between two readings can see time run backwards.
+ */
+inline std::uint64_t tsc_clock::ticks_between(std::uint64_t begin, std::uint64_t end) noexcept
+{
+  return end > begin ? end - begin : 0;
+}
+
+/**
+ * @brief Convert a number of ticks to nanoseconds.
+ */
+inline tsc_clock::duration tsc_clock::to_duration(std::uint64_t ticks) noexcept
+{
+  return duration(static_cast<duration::rep>(static_cast<double>(ticks) * calibrated().nanoseconds_per_tick));
+}
+
+/**
+ * @brief Counter frequency, as measured or reported at calibration.
+ */
+inline double tsc_clock::ticks_per_second() noexcept
+{
+  return 1e9 / calibrated().nanoseconds_per_tick;
+}
+
+/**
+ * @brief Check if ticks come from the CPU counter rather than steady_clock.
+ */
+inline bool tsc_clock::is_hardware() noexcept
+{
+  return calibrated().hardware;
+}
+
+/**
+ * @brief The calibration, measured by the first caller only.
+ */
+inline const tsc_clock::calibration& tsc_clock::calibrated() noexcept
+{
+  static const calibration result = calibrate();
+  return result;
+}
+
+/**
+ * @brief Find the counter and its rate.
+ *
+ * On x86 this spins for about 5 ms comparing the counter with steady_clock.
+ */
+inline tsc_clock::calibration tsc_clock::calibrate() noexcept
+{
+#if defined(FB_TSC_X86)
+  // CPUID.80000007H:EDX[8] announces a TSC that ticks at a constant rate
+  unsigned int registers[4] = {0, 0, 0, 0};
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, static_cast<int>(0x80000000u));
+  if (static_cast<unsigned int>(info[0]) >= 0x80000007u)
+  {
+    __cpuid(info, static_cast<int>(0x80000007u));
+    registers[3] = static_cast<unsigned int>(info[3]);
+  }
+#else
+  if (__get_cpuid_max(0x80000000u, nullptr) >= 0x80000007u)
+  {
+    __get_cpuid(0x80000007u, &registers[0], &registers[1], &registers[2], &registers[3]);
+  }
+#endif
+  if ((registers[3] & (1u << 8)) != 0)
+  {
+    const auto          steady_begin = std::chrono::steady_clock::now();
+    const std::uint64_t ticks_begin  = read_counter();
+    auto                steady_end   = steady_begin;
+    while (steady_end - steady_begin < std::chrono::milliseconds(5))
+    {
+      steady_end = std::chrono::steady_clock::now();
+    }
+    const std::uint64_t ticks_end = read_counter();
+
+    const auto nanoseconds = std::chrono::duration_cast<duration>(steady_end - steady_begin).count();
+    if (ticks_end > ticks_begin)
+    {
+      return {true, static_cast<double>(nanoseconds) / static_cast<double>(ticks_end - ticks_begin)};
+    }
+  }
+#elif defined(FB_TSC_ARM64)
+  std::uint64_t frequency = 0;
+  asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+  if (frequency != 0)
+  {
+    return {true, 1e9 / static_cast<double>(frequency)};
+  }
+#endif
+  return {false, 1.0};
+}
+
+/**
+ * @brief Read the CPU counter, ordered with the surrounding instructions.
+ */
+inline std::uint64_t tsc_clock::read_counter() noexcept
+{
+#if defined(FB_TSC_X86)
+  _mm_lfence();
+  const std::uint64_t ticks = __rdtsc();
+  _mm_lfence();
+  return ticks;
+#elif defined(FB_TSC_ARM64)
+  std::uint64_t ticks = 0;
+  asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(ticks) : : "memory");
+  return ticks;
+#else
+  return steady_ticks();
+#endif
+}
+
+/**
+ * @brief steady_clock in nanoseconds, the fallback tick source.
+ */
+inline std::uint64_t tsc_clock::steady_ticks() noexcept
+{
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Construct a new fast_stop_watch
+ *
+ * @param start_immediately If true, the stopwatch starts immediately after construction.
+ *                         If false, the stopwatch is created in stopped state.
+ */
+inline fast_stop_watch::fast_stop_watch(bool start_immediately) noexcept
+  : m_start_ticks(0)
+  , m_accumulated(0)
+  , m_is_running(false)
+{
+  if (start_immediately)
+  {
+    start();
+  }
+}
+
+/**
+ * @brief Start or resume the stopwatch; no effect if already running.
+ */
+inline void fast_stop_watch::start() noexcept
+{
+  if (m_is_running)
+  {
+    return;
+  }
+
+  m_start_ticks = clock_type::now();
+  m_is_running = true;
+}
+
+/**
+ * @brief Stop the stopwatch and accumulate the elapsed time.
+ */
+inline void fast_stop_watch::stop() noexcept
+{
+  if (!m_is_running)
+  {
+    return;
+  }
+
+  m_accumulated += clock_type::ticks_between(m_start_ticks, clock_type::now());
+  m_is_running = false;
+}
+
+/**
+ * @brief Total elapsed time, including previous runs.
+ */
+inline fast_stop_watch::duration fast_stop_watch::elapsed_time() const noexcept
+{
+  return clock_type::to_duration(elapsed_ticks());
+}
+
+/**
+ * @brief Total elapsed time in raw tsc_clock ticks.
+ */
+inline std::uint64_t fast_stop_watch::elapsed_ticks() const noexcept
+{
+  if (m_is_running)
+  {
+    return m_accumulated + clock_type::ticks_between(m_start_ticks, clock_type::now());
+  }
+  return m_accumulated;
+}
+
+/**
+ * @brief Check if the stopwatch is running.
+ */
+inline bool fast_stop_watch::is_running() const noexcept
+{
+  return m_is_running;
+}
+
+/**
+ * @brief Reset the accumulated time to zero and optionally restart.
+ *
+ * @param start_immediately If true, restart the stopwatch immediately after reset.
+ */
+inline void fast_stop_watch::reset(bool start_immediately) noexcept
+{
+  m_accumulated = 0;
+  m_is_running = false;
+
+  if (start_immediately)
+  {
+    start();
+  }
+}
+
+/**
+ * @brief Construct a new atomic_stop_watch
+ *
+ * @param start_immediately If true, the stopwatch starts immediately after construction.
+ *                         If false, the stopwatch is created in stopped state.
+ */
+inline atomic_stop_watch::atomic_stop_watch(bool start_immediately) noexcept
+  : m_state(start_immediately ? (clock_type::now() | RUNNING) : 0)
+{
+}
+
+/**
+ * @brief Start or resume the stopwatch; no effect if already running.
+ *
+ * Thread-safe and can be called from any thread.
+ */
+inline void atomic_stop_watch::start() noexcept
+{
+  std::uint64_t state = m_state.load(std::memory_order_relaxed);
+  while ((state & RUNNING) == 0)
+  {
+    // Backdate the start by the accumulated time, so one word holds both
+    const std::uint64_t base = clock_type::now() - state;
+    if (m_state.compare_exchange_weak(state, base | RUNNING, std::memory_order_acq_rel,
+                                      std::memory_order_relaxed))
+    {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Stop the stopwatch and accumulate the elapsed time.
+ *
+ * Thread-safe and can be called from any thread.
+ */
+inline void atomic_stop_watch::stop() noexcept
+{
+  std::uint64_t state = m_state.load(std::memory_order_relaxed);
+  while ((state & RUNNING) != 0)
+  {
+    const std::uint64_t accumulated = clock_type::ticks_between(state & ~RUNNING, clock_type::now());
+    if (m_state.compare_exchange_weak(state, accumulated, std::memory_order_acq_rel,
+                                      std::memory_order_relaxed))
+    {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Total elapsed time, including previous runs.
+ */
+inline atomic_stop_watch::duration atomic_stop_watch::elapsed_time() const noexcept
+{
+  return clock_type::to_duration(elapsed_ticks());
+}
+
+/**
+ * @brief Total elapsed time in raw tsc_clock ticks.
+ */
+inline std::uint64_t atomic_stop_watch::elapsed_ticks() const noexcept
+{
+  const std::uint64_t state = m_state.load(std::memory_order_acquire);
+  if ((state & RUNNING) != 0)
+  {
+    return clock_type::ticks_between(state & ~RUNNING, clock_type::now());
+  }
+  return state;
+}
+
+/**
+ * @brief Check if the stopwatch is running.
+ *
+ * @note A snapshot; another thread may change the state right after.
+ */
+inline bool atomic_stop_watch::is_running() const noexcept
+{
+  return (m_state.load(std::memory_order_acquire) & RUNNING) != 0;
+}
+
+/**
+ * @brief Reset the accumulated time to zero and optionally restart.
+ *
+ * @param start_immediately If true, restart the stopwatch immediately after reset.
+ */
+inline void atomic_stop_watch::reset(bool start_immediately) noexcept
+{
+  m_state.store(start_immediately ? (clock_type::now() | RUNNING) : 0, std::memory_order_release);
+}
+
+}  // namespace fb
+
+#undef FB_TSC_X86
+#undef FB_TSC_ARM64
@@ -4,7 +4,9 @@
 
 // Include fb_core components
 #include "stop_watch.h"
+#include "thread_pool.h"
 #include "timer.h"
+#include "timer_service.h"
 
 namespace fb {
 
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace fb {
+
+/**
+ * @brief Point-in-time summary of a latency_histogram
+ */
+struct latency_snapshot
+{
+  std::uint64_t count = 0;          ///< Number of recorded samples
+  std::chrono::nanoseconds min{0};  ///< Smallest sample
+  std::chrono::nanoseconds max{0};  ///< Largest sample
+  std::chrono::nanoseconds mean{0}; ///< Arithmetic mean
+  std::chrono::nanoseconds p50{0};  ///< Median
+  std::chrono::nanoseconds p90{0};  ///< 90th percentile
+  std::chrono::nanoseconds p99{0};  ///< 99th percentile
+  std::chrono::nanoseconds p999{0}; ///< 99.9th percentile
+};
+
+/**
+ * @brief Lock-free HDR-style histogram of nanosecond latencies.
+ *
+ * Values below 64 ns are counted exactly; above that every power-of-two
+ * range is split into 32 linear sub-buckets, so any recorded value is
+ * reported within about 3% over the full 64-bit range using a fixed table
+ * of counters. record() is a handful of relaxed atomic operations and is
+ * safe to call from many threads at once; snapshot() and
+ * value_at_percentile() may run concurrently with recording and then see a
+ * slightly stale but self-consistent distribution.
+ */
+class latency_histogram
+{
+public:
+
+  static constexpr std::size_t BUCKET_COUNT = 1920;
+
+  latency_histogram();
+
+  latency_histogram(const latency_histogram&)            = delete;
+  latency_histogram& operator=(const latency_histogram&) = delete;
+
+  void record(const std::chrono::nanoseconds& value) noexcept;
+
+  std::uint64_t count() const noexcept;
+  std::chrono::nanoseconds value_at_percentile(double percentile) const;
+  latency_snapshot snapshot() const;
+
+  void reset() noexcept;
+
+private:
+
+  std::unique_ptr<std::atomic<std::uint64_t>[]> m_counts; ///< Per-bucket sample counts
+  std::atomic<std::uint64_t> m_count;                      ///< Number of samples
+  std::atomic<std::uint64_t> m_total;                      ///< Sum of all samples (ns)
+  std::atomic<std::uint64_t> m_min;                        ///< Smallest sample (ns)
+  std::atomic<std::uint64_t> m_max;                        ///< Largest sample (ns)
+
+  static std::size_t bucket_index(std::uint64_t value) noexcept;
+  static std::uint64_t bucket_upper(std::size_t index) noexcept;
+};
+
+} // namespace fb
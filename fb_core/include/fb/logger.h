@@ -0,0 +1,332 @@
+/// @file logger.h
+/// @brief Asynchronous logger: callers enqueue raw arguments, a thread formats
+///
+/// logger::info("fill {} @ {}", quantity, price) copies the format string
+/// pointer, a tsc_clock timestamp and the argument values into a ring owned
+/// by the calling thread and returns. A background thread started by
+/// logger::start() drains every ring, formats the lines with fb::format_to
+/// and writes each batch with a single write, so the caller never formats
+/// text, takes a lock or blocks on I/O.
+///
+/// Features:
+/// - Logging is one level check and one push of a 128-byte record into a
+///   lock-free single-producer ring; no lock and no allocation after the
+///   thread's first message
+/// - Arithmetic, char, bool and pointer arguments are copied as they are;
+///   const char*, std::string and std::string_view are copied as text,
+///   truncated to what fits in the record
+/// - Lines from all threads are written in timestamp order within each batch
+/// - A full ring drops new messages and counts them (see dropped()) rather
+///   than blocking the thread that logs
+/// - Before start() and after stop(), messages are formatted and written
+///   to stderr on the calling thread
+///
+/// Thread Safety:
+/// - Messages may be logged from any number of threads
+/// - start(), stop(), flush() and set_level() may be called from any thread
+///
+/// Example:
+/// @code
+/// fb::logger::start("server.log");
+/// fb::logger::info("listening on port {}", port);
+/// fb::logger::warning("{} packets dropped on {}", dropped, interface_name);
+/// fb::logger::stop();
+/// @endcode
+
+#pragma once
+
+#include "fast_stop_watch.h"
+#include "spsc_circular_buffer.h"
+
+#include <fb/format.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace fb
+{
+
+/// @brief Severity of a log message
+enum class log_level : std::uint8_t
+{
+  trace,
+  debug,
+  info,
+  warning,
+  error,
+  critical,
+  off, ///< As a threshold: log nothing
+};
+
+namespace detail
+{
+
+/// Argument bytes carried by one log record
+constexpr std::size_t LOG_PAYLOAD_SIZE = 96;
+
+/// @brief Whether @p T is logged as text rather than copied as a value
+template <typename T>
+constexpr bool is_log_text_v = std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+                               std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+/// @brief Type an argument of type @p T is read back as when formatting
+template <typename T>
+using log_decoded_t = std::conditional_t<is_log_text_v<std::decay_t<T>>, std::string_view, std::decay_t<T>>;
+
+/// @brief Record bytes an argument needs besides its text
+template <typename T>
+constexpr std::size_t log_fixed_size_v = is_log_text_v<std::decay_t<T>> ? sizeof(std::uint16_t) : sizeof(std::decay_t<T>);
+
+template <typename T>
+void encode_log_arg(unsigned char*& pos, std::size_t& text_budget, const T& value) noexcept
+{
+  using type = std::decay_t<T>;
+  if constexpr (is_log_text_v<type>)
+  {
+    std::string_view text;
+    if constexpr (std::is_pointer_v<type>)
+    {
+      const char* const str = value;
+      text                  = str != nullptr ? std::string_view(str) : std::string_view("(null)");
+    }
+    else
+    {
+      text = value;
+    }
+    const auto length = static_cast<std::uint16_t>(text.size() < text_budget ? text.size() : text_budget);
+    std::memcpy(pos, &length, sizeof(length));
+    std::memcpy(pos + sizeof(length), text.data(), length);
+    pos += sizeof(length) + length;
+    text_budget -= length;
+  }
+  else
+  {
+    static_assert(std::is_trivially_copyable_v<type>,
+                  "log arguments must be text or trivially copyable; format other types at the call site");
+    std::memcpy(pos, &value, sizeof(type));
+    pos += sizeof(type);
+  }
+}
+
+template <typename T>
+log_decoded_t<T> decode_log_arg(const unsigned char*& pos) noexcept
+{
+  using type = std::decay_t<T>;
+  if constexpr (is_log_text_v<type>)
+  {
+    std::uint16_t length = 0;
+    std::memcpy(&length, pos, sizeof(length));
+    const std::string_view text(reinterpret_cast<const char*>(pos + sizeof(length)), length);
+    pos += sizeof(length) + length;
+    return text;
+  }
+  else
+  {
+    type value;
+    std::memcpy(&value, pos, sizeof(type));
+    pos += sizeof(type);
+    return value;
+  }
+}
+
+/// @brief Decode the arguments of a record and append the formatted message
+template <typename... Args>
+void format_log_record(std::string& out, const char* fmt, const unsigned char* payload)
+{
+  [[maybe_unused]] const unsigned char* pos = payload;
+  // Braced initialization decodes left to right, the order they were encoded
+  const std::tuple<log_decoded_t<Args>...> values{decode_log_arg<Args>(pos)...};
+  std::apply([&out, fmt](const auto&... value) { fb::format_to(std::back_inserter(out), fmt, value...); }, values);
+}
+
+/// @brief One message as queued by the logging thread
+struct alignas(64) log_record
+{
+  using format_fn = void (*)(std::string& out, const char* fmt, const unsigned char* payload);
+
+  log_record() noexcept = default;
+
+  template <typename... Args>
+  log_record(log_level message_level, const char* message_format, std::uint64_t ticks, const Args&... args) noexcept
+      : format(&format_log_record<Args...>)
+      , fmt(message_format)
+      , timestamp(ticks)
+      , level(message_level)
+  {
+    constexpr std::size_t fixed = (std::size_t{0} + ... + log_fixed_size_v<Args>);
+    static_assert(fixed <= LOG_PAYLOAD_SIZE, "too many log arguments for one record");
+
+    [[maybe_unused]] unsigned char* pos         = payload;
+    [[maybe_unused]] std::size_t    text_budget = LOG_PAYLOAD_SIZE - fixed;
+    (encode_log_arg(pos, text_budget, args), ...);
+  }
+
+  format_fn     format    = nullptr;
+  const char*   fmt       = nullptr; ///< Format string; must outlive the logger session
+  std::uint64_t timestamp = 0;       ///< tsc_clock ticks when logged
+  log_level     level     = log_level::info;
+  unsigned char payload[LOG_PAYLOAD_SIZE]; ///< Encoded arguments
+};
+
+/// @brief The log ring of one thread; the thread produces, the writer consumes
+struct log_buffer
+{
+  log_buffer(std::size_t capacity, std::uint32_t thread_id)
+      : records(capacity)
+      , id(thread_id)
+  {
+  }
+
+  spsc_circular_buffer<log_record> records;
+  std::atomic<std::uint64_t>       dropped{0};
+  const std::uint32_t              id;
+};
+
+/// Lowest level logged; messages below it cost one relaxed load
+extern std::atomic<log_level> log_threshold;
+
+/// Set between logger::start() and logger::stop()
+extern std::atomic<bool> log_collecting;
+
+/// @brief The calling thread's ring, created on first use; nullptr if that failed
+log_buffer* this_thread_log_buffer() noexcept;
+
+/// @brief Format and write one record to stderr on the calling thread
+void write_log_unbuffered(const log_record& record) noexcept;
+
+} // namespace detail
+
+/// @brief Process-wide asynchronous logger
+class logger
+{
+public:
+  /// Default ring size per thread, in messages
+  static constexpr std::size_t DEFAULT_RECORDS_PER_THREAD = 4 * 1024;
+
+  /// @brief Begin writing messages to @p filepath, appending to it
+  ///
+  /// @param filepath Log file
+  /// @param flush_interval How often the background thread drains the rings
+  /// @param records_per_thread Ring size, rounded up to a power of two, of
+  ///                           threads that log their first message during
+  ///                           this session
+  /// @throw std::logic_error if a session is already running
+  /// @throw std::runtime_error if the file cannot be opened
+  static void start(const std::filesystem::path& filepath,
+                    std::chrono::milliseconds    flush_interval     = std::chrono::milliseconds(10),
+                    std::size_t                  records_per_thread = DEFAULT_RECORDS_PER_THREAD);
+
+  /// @brief Begin writing messages to @p stream (e.g. stdout), which stays open
+  ///
+  /// @throw std::logic_error if a session is already running
+  static void start(std::FILE*                stream,
+                    std::chrono::milliseconds flush_interval     = std::chrono::milliseconds(10),
+                    std::size_t               records_per_thread = DEFAULT_RECORDS_PER_THREAD);
+
+  /// @brief Write the remaining messages and end the session
+  ///
+  /// Does nothing if no session is running.
+  static void stop();
+
+  /// @brief Write the messages queued so far without waiting for the writer
+  static void flush();
+
+  /// @brief Check if messages are being queued for the background thread
+  [[nodiscard]] static bool is_running() noexcept
+  {
+    return detail::log_collecting.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Log messages at @p level and above (default info)
+  static void set_level(log_level level) noexcept
+  {
+    detail::log_threshold.store(level, std::memory_order_relaxed);
+  }
+
+  /// @brief Current threshold
+  [[nodiscard]] static log_level level() noexcept
+  {
+    return detail::log_threshold.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Check if a message at @p level would be logged
+  [[nodiscard]] static bool enabled(log_level level) noexcept
+  {
+    return level >= detail::log_threshold.load(std::memory_order_relaxed) && level != log_level::off;
+  }
+
+  /// @brief Messages dropped in this session because a thread's ring was full
+  [[nodiscard]] static std::uint64_t dropped() noexcept;
+
+  /// @brief Queue a message
+  ///
+  /// @param level Severity
+  /// @param fmt fb::format string; a string literal, as only the pointer is kept
+  /// @param args Values for the replacement fields
+  template <typename... Args>
+  static void log(log_level level, const char* fmt, const Args&... args) noexcept
+  {
+    if (!enabled(level))
+    {
+      return;
+    }
+    if (!is_running())
+    {
+      detail::write_log_unbuffered(detail::log_record(level, fmt, tsc_clock::now(), args...));
+      return;
+    }
+    detail::log_buffer* buffer = detail::this_thread_log_buffer();
+    if (buffer != nullptr && !buffer->records.emplace_back(level, fmt, tsc_clock::now(), args...))
+    {
+      buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename... Args>
+  static void trace(const char* fmt, const Args&... args) noexcept
+  {
+    log(log_level::trace, fmt, args...);
+  }
+
+  template <typename... Args>
+  static void debug(const char* fmt, const Args&... args) noexcept
+  {
+    log(log_level::debug, fmt, args...);
+  }
+
+  template <typename... Args>
+  static void info(const char* fmt, const Args&... args) noexcept
+  {
+    log(log_level::info, fmt, args...);
+  }
+
+  template <typename... Args>
+  static void warning(const char* fmt, const Args&... args) noexcept
+  {
+    log(log_level::warning, fmt, args...);
+  }
+
+  template <typename... Args>
+  static void error(const char* fmt, const Args&... args) noexcept
+  {
+    log(log_level::error, fmt, args...);
+  }
+
+  template <typename... Args>
+  static void critical(const char* fmt, const Args&... args) noexcept
+  {
+    log(log_level::critical, fmt, args...);
+  }
+};
+
+} // namespace fb
@@ -0,0 +1,92 @@
+/// @file mapped_file.h
+/// @brief Read-only memory mapping of a whole file
+///
+/// Maps a file into the address space so it can be read as one
+/// std::string_view without copying. Pages are loaded by the kernel on
+/// first touch and shared with the page cache, so mapping a multi-GB file
+/// is near-instant and costs no heap memory.
+///
+/// Features:
+/// - POSIX mmap() of the whole file, read-only and private
+/// - Empty files map to an empty view
+/// - Move-only RAII ownership; the mapping is released on destruction
+/// - On platforms without mmap() the file is read into one heap block
+///
+/// Thread Safety:
+/// - A mapped_file may be read from any number of threads at once
+/// - Truncating the file while it is mapped makes reads past the new end
+///   fault (SIGBUS); map files that are no longer being written
+///
+/// Example:
+/// @code
+/// fb::mapped_file file("quotes.csv");
+/// std::string_view text = file.view();
+/// std::size_t lines = std::count(text.begin(), text.end(), '\n');
+/// @endcode
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace fb
+{
+
+/// @brief Read-only view of a file's contents backed by a memory mapping
+class mapped_file
+{
+public:
+  /// @brief Construct an empty mapping
+  mapped_file() noexcept = default;
+
+  /// @brief Map the whole of @p filepath
+  ///
+  /// @param filepath File to map
+  /// @throw std::system_error if the file cannot be opened, sized or mapped
+  explicit mapped_file(const std::filesystem::path& filepath);
+
+  /// @brief Unmap the file
+  ~mapped_file();
+
+  // Non-copyable but moveable
+  mapped_file(const mapped_file&)            = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  mapped_file(mapped_file&& other) noexcept;
+  mapped_file& operator=(mapped_file&& other) noexcept;
+
+  /// @brief First byte of the file, or nullptr when empty
+  [[nodiscard]] const char* data() const noexcept
+  {
+    return m_data;
+  }
+
+  /// @brief Size of the file in bytes
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return m_size;
+  }
+
+  /// @brief Check if the file is empty
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_size == 0;
+  }
+
+  /// @brief The whole file
+  [[nodiscard]] std::string_view view() const noexcept
+  {
+    return {m_data, m_size};
+  }
+
+private:
+  /// @brief Unmap and reset to empty
+  void release() noexcept;
+
+  const char*             m_data = nullptr; ///< Mapped or owned bytes
+  std::size_t             m_size = 0;       ///< Bytes at m_data
+  std::unique_ptr<char[]> m_owned;          ///< Heap copy where mmap() is unavailable
+};
+
+} // namespace fb
@@ -0,0 +1,262 @@
+/// @file metrics.h
+/// @brief Named counters, gauges and latency histograms exported on demand
+///
+/// A metrics_registry maps Prometheus-style names to metrics and renders
+/// them all as Prometheus text or JSON when scraped. Metrics come in two
+/// flavours:
+/// - Owned: counter(), gauge() and histogram() create the metric inside the
+///   registry and return a reference to record into directly
+/// - Pulled: add_counter(), add_gauge() and add_histogram() register a
+///   function that reads an existing statistic (tcp_server, udp_server,
+///   event_queue, ...) only when the registry is exported
+///
+/// Features:
+/// - Recording never touches the registry: counters are per-thread
+///   sharded_counters, gauges one relaxed atomic, histograms a
+///   latency_histogram, so the data path takes no lock
+/// - Pulled metrics cost nothing until a scrape
+/// - metrics_registration handles unregister pulled metrics on
+///   destruction, so a component can go away before the registry
+///
+/// Thread Safety:
+/// - Metrics may be recorded from any number of threads
+/// - Registration, removal and export may be called from any thread; they
+///   share one mutex, which export holds while calling read functions, so a
+///   read function never runs after its registration is gone. Read
+///   functions must not call back into the registry.
+///
+/// Example:
+/// @code
+/// auto& parsed = fb::metrics_registry::global().counter("quotes_parsed_total", "Quotes parsed");
+/// parsed.add();
+///
+/// fb::event_queue queue;
+/// auto registration = fb::metrics_registry::global().add_counter(
+///     "quote_queue_dropped_total", "Quote events dropped",
+///     [&queue]() { return queue.dropped_count(); });
+///
+/// std::string scrape = fb::metrics_registry::global().to_prometheus();
+/// @endcode
+
+#pragma once
+
+#include "latency_histogram.h"
+#include "sharded_counters.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fb
+{
+
+/// @brief Kind of a registered metric
+enum class metric_type
+{
+  counter,   ///< Monotonic total
+  gauge,     ///< Value that goes up and down
+  histogram, ///< Latency distribution, exported as a Prometheus summary
+};
+
+/// @brief Monotonic counter split into per-thread shards
+class metric_counter
+{
+public:
+  /// @param shards Shards to spread over; 0 sizes to the hardware concurrency
+  explicit metric_counter(std::size_t shards = 0)
+      : m_counts(shards)
+  {
+  }
+
+  /// @brief Add @p n from the calling thread
+  void add(std::uint64_t n = 1) noexcept
+  {
+    m_counts.add(0, n);
+  }
+
+  /// @brief Sum over all shards
+  [[nodiscard]] std::uint64_t value() const noexcept
+  {
+    return m_counts.value(0);
+  }
+
+private:
+  sharded_counters<1> m_counts;
+};
+
+/// @brief Signed value that is set or adjusted rather than only counted up
+class metric_gauge
+{
+public:
+  /// @brief Replace the value
+  void set(std::int64_t value) noexcept
+  {
+    m_value.store(value, std::memory_order_relaxed);
+  }
+
+  /// @brief Adjust the value by @p delta, which may be negative
+  void add(std::int64_t delta) noexcept
+  {
+    m_value.fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  /// @brief Current value
+  [[nodiscard]] std::int64_t value() const noexcept
+  {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::int64_t> m_value{0};
+};
+
+class metrics_registry;
+
+/// @brief Keeps pulled metrics registered; removes them when destroyed
+///
+/// Move-only. Destroy it (or call reset()) before whatever its read
+/// functions refer to, and before the registry itself.
+class metrics_registration
+{
+public:
+  /// @brief Construct a handle that registers nothing
+  metrics_registration() noexcept = default;
+
+  /// @brief Unregister every metric held
+  ~metrics_registration();
+
+  // Non-copyable but moveable
+  metrics_registration(const metrics_registration&)            = delete;
+  metrics_registration& operator=(const metrics_registration&) = delete;
+  metrics_registration(metrics_registration&& other) noexcept;
+  metrics_registration& operator=(metrics_registration&& other) noexcept;
+
+  /// @brief Take over the metrics held by @p other
+  ///
+  /// @throw std::invalid_argument if both hold metrics of different registries
+  void append(metrics_registration&& other);
+
+  /// @brief Unregister every metric held now
+  void reset() noexcept;
+
+  /// @brief Check if no metric is held
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_metrics.empty();
+  }
+
+private:
+  friend class metrics_registry;
+
+  metrics_registration(metrics_registry* registry, std::string name, std::uint64_t id);
+
+  metrics_registry*                                  m_registry = nullptr;
+  std::vector<std::pair<std::string, std::uint64_t>> m_metrics; ///< Name and registration id
+};
+
+/// @brief Named metrics rendered as Prometheus text or JSON
+class metrics_registry
+{
+public:
+  metrics_registry()  = default;
+  ~metrics_registry() = default;
+
+  metrics_registry(const metrics_registry&)            = delete;
+  metrics_registry& operator=(const metrics_registry&) = delete;
+
+  /// @brief Process-wide registry, for components that are not handed one
+  static metrics_registry& global();
+
+  /// @brief Find or create an owned counter
+  ///
+  /// Names follow Prometheus rules: [a-zA-Z_:][a-zA-Z0-9_:]*, conventionally
+  /// ending in _total for counters. Owned metrics live as long as the registry.
+  ///
+  /// @throw std::invalid_argument if the name is invalid or taken by another type
+  metric_counter& counter(const std::string& name, const std::string& help = {});
+
+  /// @brief Find or create an owned gauge
+  ///
+  /// @throw std::invalid_argument if the name is invalid or taken by another type
+  metric_gauge& gauge(const std::string& name, const std::string& help = {});
+
+  /// @brief Find or create an owned latency histogram
+  ///
+  /// Exported in seconds; name it accordingly (e.g. parse_latency_seconds).
+  ///
+  /// @throw std::invalid_argument if the name is invalid or taken by another type
+  latency_histogram& histogram(const std::string& name, const std::string& help = {});
+
+  /// @brief Register a counter read by @p read at export time
+  ///
+  /// @throw std::invalid_argument if the name is invalid or already registered
+  [[nodiscard]] metrics_registration add_counter(const std::string& name, const std::string& help,
+                                                 std::function<std::uint64_t()> read);
+
+  /// @brief Register a gauge read by @p read at export time
+  ///
+  /// @throw std::invalid_argument if the name is invalid or already registered
+  [[nodiscard]] metrics_registration add_gauge(const std::string& name, const std::string& help,
+                                               std::function<std::int64_t()> read);
+
+  /// @brief Register a latency distribution read by @p read at export time
+  ///
+  /// @throw std::invalid_argument if the name is invalid or already registered
+  [[nodiscard]] metrics_registration add_histogram(const std::string& name, const std::string& help,
+                                                   std::function<latency_snapshot()> read);
+
+  /// @brief Remove a metric, owned or pulled
+  ///
+  /// References to a removed owned metric dangle.
+  ///
+  /// @return false if no metric has that name
+  bool remove(const std::string& name);
+
+  /// @brief Check if a metric is registered under @p name
+  [[nodiscard]] bool contains(const std::string& name) const;
+
+  /// @brief Number of registered metrics
+  [[nodiscard]] std::size_t size() const;
+
+  /// @brief Every metric in Prometheus text exposition format 0.0.4
+  ///
+  /// Histograms become summaries with 0.5/0.9/0.99/0.999 quantiles, _sum
+  /// and _count, all in seconds.
+  [[nodiscard]] std::string to_prometheus() const;
+
+  /// @brief Every metric as one JSON object keyed by name
+  ///
+  /// Histograms report count and min/max/mean/p50/p90/p99/p999 in nanoseconds.
+  [[nodiscard]] std::string to_json() const;
+
+private:
+  friend class metrics_registration;
+
+  struct entry
+  {
+    metric_type                       type;
+    std::string                       help;
+    std::function<std::uint64_t()>    read_counter;
+    std::function<std::int64_t()>     read_gauge;
+    std::function<latency_snapshot()> read_histogram;
+    std::shared_ptr<void>             owned;           ///< The metric itself, for owned metrics
+    std::uint64_t                     registration = 0; ///< Id of the pulled registration, 0 if owned
+  };
+
+  entry&               find_or_create(const std::string& name, const std::string& help, metric_type type);
+  metrics_registration add(const std::string& name, entry pulled);
+  void                 unregister(const std::string& name, std::uint64_t id) noexcept;
+
+  mutable std::mutex           m_mutex;
+  std::map<std::string, entry> m_entries; ///< Sorted, so exports are stable
+  std::uint64_t                m_next_registration = 1;
+};
+
+} // namespace fb
@@ -0,0 +1,165 @@
+/// @file mirrored_ring_buffer.h
+/// @brief Circular byte buffer whose readable bytes are always contiguous
+///
+/// A byte-stream companion to fb::circular_buffer for protocol and file
+/// parsers. The storage is mapped twice, back to back, in virtual memory, so
+/// the bytes after the end of the ring are the bytes at its start. A run of
+/// buffered bytes that wraps round the ring therefore still reads as one
+/// pointer and length, and a message that straddles the wrap point can be
+/// parsed in place, with no copy and no compaction.
+///
+/// Features:
+/// - Linux memfd_create() (shm_open() on other POSIX systems) mapped twice
+///   with mmap() over one reserved address range
+/// - Readable bytes (@ref view) and free space (@ref write_data) are each
+///   one contiguous range, so reads go straight into the ring
+/// - Capacity is a whole number of pages and can grow with @ref reserve
+/// - Move-only RAII ownership; the mappings are released on destruction
+/// - Where the double mapping is unavailable the buffer falls back to one
+///   heap block and compacts it when needed (see @ref is_mirrored)
+///
+/// Thread Safety:
+/// - Not thread-safe; use one buffer per reading thread
+///
+/// Example:
+/// @code
+/// fb::mirrored_ring_buffer ring(64 * 1024);
+/// const auto received = ::recv(fd, ring.write_data(), ring.free_space(), 0);
+/// ring.commit_back(static_cast<std::size_t>(received));
+/// while (auto length = complete_message(ring.view()))
+/// {
+///   handle(ring.view().substr(0, length));
+///   ring.pop_front_n(length);
+/// }
+/// @endcode
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace fb
+{
+
+/// @brief FIFO byte buffer with contiguous readable and writable ranges
+class mirrored_ring_buffer
+{
+public:
+  /// @brief Construct a buffer of at least one page
+  ///
+  /// @param capacity Minimum capacity in bytes; rounded up to a whole
+  ///                 number of pages
+  /// @throw std::bad_alloc if the storage cannot be allocated
+  explicit mirrored_ring_buffer(std::size_t capacity = 0);
+
+  /// @brief Unmap the storage
+  ~mirrored_ring_buffer();
+
+  // Non-copyable but moveable
+  mirrored_ring_buffer(const mirrored_ring_buffer&)            = delete;
+  mirrored_ring_buffer& operator=(const mirrored_ring_buffer&) = delete;
+  mirrored_ring_buffer(mirrored_ring_buffer&& other) noexcept;
+  mirrored_ring_buffer& operator=(mirrored_ring_buffer&& other) noexcept;
+
+  /// @brief Oldest buffered byte; the next size() bytes are contiguous
+  [[nodiscard]] const char* data() const noexcept
+  {
+    return m_base + m_begin;
+  }
+
+  /// @brief Number of buffered bytes
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return m_size;
+  }
+
+  /// @brief Check if no bytes are buffered
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_size == 0;
+  }
+
+  /// @brief Check if no more bytes can be written without @ref reserve
+  [[nodiscard]] bool full() const noexcept
+  {
+    return m_size == m_capacity;
+  }
+
+  /// @brief Total capacity in bytes, a multiple of the page size
+  [[nodiscard]] std::size_t capacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+  /// @brief Number of bytes that can be written at @ref write_data
+  [[nodiscard]] std::size_t free_space() const noexcept
+  {
+    return m_capacity - m_size;
+  }
+
+  /// @brief All buffered bytes, oldest first
+  [[nodiscard]] std::string_view view() const noexcept
+  {
+    return {data(), m_size};
+  }
+
+  /// @brief Check if the storage is double-mapped rather than compacted
+  [[nodiscard]] bool is_mirrored() const noexcept
+  {
+    return m_mirrored;
+  }
+
+  /// @brief Start of the free_space() writable bytes after the buffered ones
+  ///
+  /// Bytes written here become readable once passed to @ref commit_back.
+  /// In the heap fallback this may move the buffered bytes, invalidating
+  /// pointers previously obtained from @ref data.
+  [[nodiscard]] char* write_data() noexcept;
+
+  /// @brief Append @p count bytes already written at @ref write_data
+  ///
+  /// @throw std::length_error if @p count exceeds free_space()
+  void commit_back(std::size_t count);
+
+  /// @brief Copy up to free_space() bytes from @p bytes to the back
+  ///
+  /// @return The number of bytes copied
+  std::size_t push_back_n(const char* bytes, std::size_t count) noexcept;
+
+  /// @brief Consume up to @p count bytes from the front
+  ///
+  /// @return The number of bytes consumed
+  std::size_t pop_front_n(std::size_t count) noexcept;
+
+  /// @brief Discard all buffered bytes, keeping the capacity
+  void clear() noexcept;
+
+  /// @brief Grow the capacity to at least @p capacity bytes
+  ///
+  /// Buffered bytes are kept but move to new storage, invalidating
+  /// pointers previously obtained from @ref data and @ref write_data.
+  /// Does nothing if the buffer is already large enough.
+  ///
+  /// @throw std::bad_alloc if the new storage cannot be allocated
+  void reserve(std::size_t capacity);
+
+  /// @brief Granularity of the capacity, the system page size
+  [[nodiscard]] static std::size_t page_size() noexcept;
+
+private:
+  /// @brief Allocate @p capacity bytes of mirrored or heap storage
+  void allocate(std::size_t capacity);
+
+  /// @brief Unmap or free the storage and reset to empty
+  void release() noexcept;
+
+  char*                   m_base     = nullptr; ///< Start of the storage
+  std::size_t             m_capacity = 0;       ///< Bytes in one copy of the ring
+  std::size_t             m_begin    = 0;       ///< Offset of the oldest byte
+  std::size_t             m_size     = 0;       ///< Buffered bytes
+  bool                    m_mirrored = false;   ///< Storage is mapped twice
+  std::unique_ptr<char[]> m_owned;              ///< Heap block where mirroring is unavailable
+};
+
+} // namespace fb
@@ -0,0 +1,285 @@
+#pragma once
+
+/******************************************************************************
+ * Toolbox Lock-Free Multi-Producer / Single-Consumer Circular Buffer
+ *****************************************************************************/
+
+#include "fb/detail/atomic_utils.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace fb {
+
+/**
+ * @brief Lock-free circular buffer for many producer threads and one consumer.
+ *
+ * Same API as @ref spsc_circular_buffer, but any number of threads may call
+ * @ref push_back concurrently. A producer claims a slot by advancing the tail
+ * with a compare-and-swap, constructs the element and then publishes it by
+ * stamping the slot's sequence number; the consumer reads the sequence of the
+ * slot at the head, so it never reads the contended tail and a producer that
+ * is still constructing holds up only the elements behind its own.
+ *
+ * The head (consumer) and the tail (producers) live on separate cache lines.
+ * Producers share a cached copy of the head and reload the real one only when
+ * that copy says the buffer is full.
+ *
+ * A full buffer never overwrites; @ref push_back returns false.
+ *
+ * @note Calling the consumer functions from more than one thread is
+ * undefined.
+ *
+ * This class template accepts two template parameters:
+ *   - T      The type of object contained
+ *   - Alloc  Allocator type to use (in line with other STL containers).
+ */
+template <typename T, typename Alloc = std::allocator<T> >
+class mpsc_circular_buffer
+{
+public:
+
+  using allocator_type   = Alloc;
+  using allocator_traits = std::allocator_traits<allocator_type>;
+
+  using value_type      = typename allocator_traits::value_type;
+  using reference       = value_type&;
+  using const_reference = const value_type&;
+
+  typedef size_t size_type;
+
+  explicit mpsc_circular_buffer(size_t capacity, const allocator_type &alloc = allocator_type());
+  ~mpsc_circular_buffer();
+
+  mpsc_circular_buffer(const mpsc_circular_buffer &)            = delete;
+  mpsc_circular_buffer &operator=(const mpsc_circular_buffer &) = delete;
+
+  allocator_type get_allocator() const { return m_allocatorT; }
+
+  // Producers
+  bool push_back(const value_type &item) { return emplace_back(item);            }
+  bool push_back(value_type &&item)      { return emplace_back(std::move(item)); }
+
+  template <typename... Args>
+  bool emplace_back(Args &&...args);
+
+  // Consumer
+  value_type *front();
+  void pop_front();
+  bool pop_front(value_type &item);
+  void clear();
+
+  // Any thread; exact only while no other thread uses the buffer
+  size_t size()     const;
+  bool   empty()    const { return size() == 0;           }
+  bool   full()     const { return size() == m_arraySize; }
+  size_t capacity() const { return m_arraySize;           }
+
+private:
+
+  void release_head(size_t head);
+
+  static size_t round_up_pow2(size_t value);
+
+  allocator_type  m_allocatorT;
+  value_type     *m_data;
+  const size_t    m_arraySize;
+  const size_t    m_mask;
+
+  // Slot i holds the element of index n once m_published[i] == n + 1
+  std::unique_ptr<std::atomic<size_t>[]> m_published;
+
+  // Written by the consumer only
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<size_t> m_head{0};
+
+  // Written by the producers
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<size_t> m_tail{0};
+  std::atomic<size_t> m_cached_head{0};
+};
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+/**
+ * @brief Class Constructor.
+ *
+ * @param capacity Minimum number of elements; rounded up to a power of two
+ *                 so slots are found with a mask instead of a division.
+ * @param alloc    Allocator for the element array, e.g. a
+ *                 std::pmr::polymorphic_allocator over an fb::monotonic_arena.
+ * @throws std::invalid_argument If capacity is zero.
+ */
+template <typename T, typename Alloc> inline
+mpsc_circular_buffer<T, Alloc>::mpsc_circular_buffer(size_t capacity, const allocator_type &alloc):
+  m_allocatorT(alloc)
+  , m_data(nullptr)
+  , m_arraySize(round_up_pow2(capacity))
+  , m_mask(m_arraySize - 1)
+  , m_published(new std::atomic<size_t>[m_arraySize])
+{
+  for (size_t i = 0; i < m_arraySize; ++i)
+  {
+    m_published[i].store(0, std::memory_order_relaxed);
+  }
+  m_data = allocator_traits::allocate(m_allocatorT, m_arraySize);
+}
+
+/**
+ * @brief Class Destructor. Destroys the elements still held.
+ */
+template <typename T, typename Alloc> inline
+mpsc_circular_buffer<T, Alloc>::~mpsc_circular_buffer()
+{
+  clear();
+  allocator_traits::deallocate(m_allocatorT, m_data, m_arraySize);
+}
+
+/**
+ * @brief Construct an element at the back. Safe from any number of threads.
+ *
+ * @return False, constructing nothing, if the buffer is full.
+ */
+template <typename T, typename Alloc>
+template <typename... Args> inline
+bool mpsc_circular_buffer<T, Alloc>::emplace_back(Args &&...args)
+{
+  size_t tail = m_tail.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    // Acquire pairs with the consumer's release of the slot being reused
+    if (tail - m_cached_head.load(std::memory_order_acquire) >= m_arraySize)
+    {
+      const size_t head = m_head.load(std::memory_order_acquire);
+      if (tail - head >= m_arraySize)
+      {
+        // Another producer may have claimed the last slot since the load
+        const size_t current = m_tail.load(std::memory_order_relaxed);
+        if (current == tail)
+        {
+          return false;
+        }
+        tail = current;
+        continue;
+      }
+      m_cached_head.store(head, std::memory_order_release);
+    }
+    if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+    {
+      break;
+    }
+  }
+
+  allocator_traits::construct(m_allocatorT, m_data + (tail & m_mask), std::forward<Args>(args)...);
+  m_published[tail & m_mask].store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Oldest element, or nullptr if none is published yet. Consumer only.
+ *
+ * The element stays valid until the consumer pops it.
+ */
+template <typename T, typename Alloc> inline
+typename mpsc_circular_buffer<T, Alloc>::value_type *mpsc_circular_buffer<T, Alloc>::front()
+{
+  const size_t head = m_head.load(std::memory_order_relaxed);
+  if (m_published[head & m_mask].load(std::memory_order_acquire) != head + 1)
+  {
+    return nullptr;
+  }
+  return m_data + (head & m_mask);
+}
+
+/**
+ * @brief Destroy the oldest element; does nothing if empty. Consumer only.
+ */
+template <typename T, typename Alloc> inline
+void mpsc_circular_buffer<T, Alloc>::pop_front()
+{
+  value_type *item = front();
+  if (item != nullptr)
+  {
+    allocator_traits::destroy(m_allocatorT, item);
+    release_head(m_head.load(std::memory_order_relaxed));
+  }
+}
+
+/**
+ * @brief Move the oldest element out and destroy it. Consumer only.
+ *
+ * @return False, leaving @p item untouched, if the buffer is empty.
+ */
+template <typename T, typename Alloc> inline
+bool mpsc_circular_buffer<T, Alloc>::pop_front(value_type &item)
+{
+  value_type *oldest = front();
+  if (oldest == nullptr)
+  {
+    return false;
+  }
+  item = std::move(*oldest);
+  allocator_traits::destroy(m_allocatorT, oldest);
+  release_head(m_head.load(std::memory_order_relaxed));
+  return true;
+}
+
+/**
+ * @brief Destroy every published element. Consumer only.
+ */
+template <typename T, typename Alloc> inline
+void mpsc_circular_buffer<T, Alloc>::clear()
+{
+  while (front() != nullptr)
+  {
+    pop_front();
+  }
+}
+
+/**
+ * @brief Number of elements claimed by producers and not yet popped.
+ *
+ * Includes elements a producer is still constructing.
+ */
+template <typename T, typename Alloc> inline
+size_t mpsc_circular_buffer<T, Alloc>::size() const
+{
+  // Head first: reading it second could see it pass the tail read first
+  const size_t head = m_head.load(std::memory_order_acquire);
+  const size_t tail = m_tail.load(std::memory_order_acquire);
+  return tail - head;
+}
+
+/**
+ * @brief Hand the slot at @p head back to the producers.
+ */
+template <typename T, typename Alloc> inline
+void mpsc_circular_buffer<T, Alloc>::release_head(size_t head)
+{
+  m_head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Smallest power of two not below @p value.
+ *
+ * @throws std::invalid_argument If value is zero.
+ */
+template <typename T, typename Alloc> inline
+size_t mpsc_circular_buffer<T, Alloc>::round_up_pow2(size_t value)
+{
+  if (value == 0)
+  {
+    throw std::invalid_argument("mpsc_circular_buffer capacity must be greater than zero");
+  }
+  size_t result = 1;
+  while (result < value)
+  {
+    result <<= 1;
+  }
+  return result;
+}
+
+} // namespace fb
@@ -0,0 +1,305 @@
+/// @file object_pool.h
+/// @brief Fixed-size block pool with per-thread caches, and adapters over it
+///
+/// fixed_pool hands out blocks of one size carved from large chunks. Freed
+/// blocks go to a lock-free stack shared by all threads; a thread that needs
+/// a block takes the whole stack into its own cache at once, so allocation
+/// is usually a pop from a thread-local list and freeing one compare-and-swap.
+/// Blocks may be freed on any thread, which is what producer/consumer hand-
+/// offs (allocate on the receiving thread, free on a worker) need. Push and
+/// take-all are immune to ABA, so no tagged pointers are needed.
+///
+/// On top of it:
+/// - object_pool<T> constructs T in pooled blocks and hands them out as
+///   std::unique_ptr with a deleter that returns the block
+/// - pool_resource is a std::pmr::memory_resource serving small requests
+///   from a fixed_pool and larger ones from an upstream resource, for
+///   std::pmr containers and std::allocate_shared with a
+///   std::pmr::polymorphic_allocator
+///
+/// Chunks are returned to the upstream only when the pool is destroyed; a
+/// pool sized for a burst keeps that memory.
+///
+/// Thread Safety:
+/// - allocate() and deallocate() may be called from any number of threads
+/// - Destroy the pool only after every block is freed and no thread
+///   allocates from it
+///
+/// Example:
+/// @code
+/// fb::object_pool<order> orders;
+/// auto o = orders.make(id, price, quantity);  // std::unique_ptr<order, ...>
+/// queue.push(std::move(o));                   // Freed back to the pool on any thread
+///
+/// fb::pool_resource nodes(64);
+/// std::pmr::map<int, int> book(&nodes);       // Map nodes come from the pool
+/// @endcode
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace fb
+{
+
+/// @brief Thread-safe pool of blocks of one size and alignment
+class fixed_pool
+{
+public:
+  /// Blocks carved from each chunk unless given
+  static constexpr std::size_t DEFAULT_BLOCKS_PER_CHUNK = 64;
+
+  /// @brief Construct a pool; no memory is taken until the first allocation
+  ///
+  /// @param block_size Bytes per block; at least the size of a pointer is used
+  /// @param block_alignment Alignment of each block, a power of two
+  /// @param blocks_per_chunk Blocks taken from the upstream at a time
+  /// @param upstream Source of the chunks; must outlive the pool
+  /// @throw std::invalid_argument if @p block_alignment is not a power of two
+  explicit fixed_pool(std::size_t                 block_size,
+                      std::size_t                 block_alignment  = alignof(std::max_align_t),
+                      std::size_t                 blocks_per_chunk = DEFAULT_BLOCKS_PER_CHUNK,
+                      std::pmr::memory_resource* upstream         = std::pmr::new_delete_resource());
+
+  /// @brief Return every chunk to the upstream; blocks still in use dangle
+  ~fixed_pool() = default;
+
+  fixed_pool(const fixed_pool&)            = delete;
+  fixed_pool& operator=(const fixed_pool&) = delete;
+
+  /// @brief Take a block
+  ///
+  /// @throw std::bad_alloc if a new chunk cannot be allocated
+  [[nodiscard]] void* allocate();
+
+  /// @brief Give back a block from allocate(), on any thread
+  void deallocate(void* block) noexcept;
+
+  /// @brief Bytes per block, as rounded up for the free list and alignment
+  [[nodiscard]] std::size_t block_size() const noexcept
+  {
+    return m_state->block_size;
+  }
+
+  /// @brief Alignment of every block
+  [[nodiscard]] std::size_t block_alignment() const noexcept
+  {
+    return m_state->block_alignment;
+  }
+
+  /// @brief Blocks carved so far, in use or free
+  [[nodiscard]] std::size_t capacity() const;
+
+private:
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  /// @brief Everything a thread cache may outlive the pool by referring to
+  struct state
+  {
+    state(std::size_t size, std::size_t alignment, std::size_t per_chunk, std::pmr::memory_resource* source);
+    ~state();
+
+    state(const state&)            = delete;
+    state& operator=(const state&) = delete;
+
+    free_block* take_all() noexcept
+    {
+      return returned.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    /// @brief Push the list @p first ... @p last onto the shared stack
+    void push(free_block* first, free_block* last) noexcept
+    {
+      last->next = returned.load(std::memory_order_relaxed);
+      while (!returned.compare_exchange_weak(last->next, first, std::memory_order_release,
+                                             std::memory_order_relaxed))
+      {
+      }
+    }
+
+    /// @brief Carve a new chunk into a linked list of blocks
+    free_block* grow();
+
+    const std::size_t          block_size;
+    const std::size_t          block_alignment;
+    const std::size_t          blocks_per_chunk;
+    std::pmr::memory_resource* upstream;
+    const std::uint64_t        id;                ///< Unique for the process lifetime
+    std::atomic<free_block*>   returned{nullptr}; ///< Freed blocks, any thread
+    mutable std::mutex         chunks_mutex;
+    std::vector<void*>         chunks;
+  };
+
+  /// @brief The calling thread's caches, one per pool it allocated from
+  struct thread_cache;
+
+  /// @brief The calling thread's cached free list for @p owner
+  static free_block*& cached_blocks(const std::shared_ptr<state>& owner);
+
+  std::shared_ptr<state> m_state;
+};
+
+/// @brief Pool constructing objects of type @p T in fixed_pool blocks
+template <typename T>
+class object_pool
+{
+public:
+  /// @brief Destroys an object and returns its block, or deletes it if no pool is set
+  class deleter
+  {
+  public:
+    /// @brief A deleter that calls delete, so heap objects can share the pointer type
+    deleter() noexcept = default;
+
+    explicit deleter(object_pool* pool) noexcept
+        : m_pool(pool)
+    {
+    }
+
+    void operator()(T* object) const noexcept
+    {
+      if (m_pool != nullptr)
+      {
+        m_pool->destroy(object);
+      }
+      else
+      {
+        delete object;
+      }
+    }
+
+  private:
+    object_pool* m_pool = nullptr;
+  };
+
+  /// Owning pointer to a pooled (or, with a default deleter, heap) object
+  using pointer = std::unique_ptr<T, deleter>;
+
+  /// @param objects_per_chunk Objects' worth of memory taken from the upstream at a time
+  /// @param upstream Source of the chunks; must outlive the pool
+  explicit object_pool(std::size_t                 objects_per_chunk = fixed_pool::DEFAULT_BLOCKS_PER_CHUNK,
+                       std::pmr::memory_resource* upstream          = std::pmr::new_delete_resource())
+      : m_blocks(sizeof(T), alignof(T), objects_per_chunk, upstream)
+  {
+  }
+
+  /// @brief Construct an object in a pooled block
+  template <typename... Args>
+  [[nodiscard]] pointer make(Args&&... args)
+  {
+    return pointer(create(std::forward<Args>(args)...), deleter(this));
+  }
+
+  /// @brief Construct an object in a pooled block; give it back with destroy()
+  template <typename... Args>
+  [[nodiscard]] T* create(Args&&... args)
+  {
+    void* block = m_blocks.allocate();
+    try
+    {
+      return ::new (block) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      m_blocks.deallocate(block);
+      throw;
+    }
+  }
+
+  /// @brief Destroy an object from create() and return its block, on any thread
+  void destroy(T* object) noexcept
+  {
+    if (object != nullptr)
+    {
+      object->~T();
+      m_blocks.deallocate(object);
+    }
+  }
+
+  /// @brief The underlying block pool
+  [[nodiscard]] fixed_pool& blocks() noexcept
+  {
+    return m_blocks;
+  }
+
+private:
+  fixed_pool m_blocks;
+};
+
+/// @brief std::pmr::memory_resource serving small requests from a fixed_pool
+///
+/// Requests of at most block_size bytes and block_alignment alignment come
+/// from the pool; anything else goes to the upstream. Useful for node-based
+/// std::pmr containers and for std::allocate_shared, whose control block
+/// and object then share one pooled block.
+class pool_resource : public std::pmr::memory_resource
+{
+public:
+  /// @param block_size Largest request served from the pool
+  /// @param block_alignment Largest alignment served from the pool
+  /// @param upstream Source of the pool's chunks and of larger requests
+  explicit pool_resource(std::size_t                 block_size,
+                         std::size_t                 block_alignment = alignof(std::max_align_t),
+                         std::pmr::memory_resource* upstream        = std::pmr::new_delete_resource())
+      : m_pool(block_size, block_alignment, fixed_pool::DEFAULT_BLOCKS_PER_CHUNK, upstream)
+      , m_upstream(upstream)
+  {
+  }
+
+  /// @brief The pool serving small requests
+  [[nodiscard]] fixed_pool& pool() noexcept
+  {
+    return m_pool;
+  }
+
+  /// @brief Source of larger requests
+  [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept
+  {
+    return m_upstream;
+  }
+
+protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    return fits(bytes, alignment) ? m_pool.allocate() : m_upstream->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override
+  {
+    if (fits(bytes, alignment))
+    {
+      m_pool.deallocate(memory);
+    }
+    else
+    {
+      m_upstream->deallocate(memory, bytes, alignment);
+    }
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+
+private:
+  bool fits(std::size_t bytes, std::size_t alignment) const noexcept
+  {
+    return bytes <= m_pool.block_size() && alignment <= m_pool.block_alignment();
+  }
+
+  fixed_pool                 m_pool;
+  std::pmr::memory_resource* m_upstream;
+};
+
+} // namespace fb
@@ -0,0 +1,150 @@
+/// @file profiler.h
+/// @brief Scoped profiling zones exported as Chrome trace / Perfetto JSON
+///
+/// FB_PROFILE_ZONE("name") times the rest of the enclosing scope with
+/// tsc_clock and stores the zone in a ring owned by the calling thread.
+/// A background thread started by profiler::start() drains every ring into
+/// a trace file that chrome://tracing and ui.perfetto.dev open directly.
+///
+/// Features:
+/// - Recording a zone is two counter reads and one push into a lock-free
+///   single-producer ring; no lock and no allocation after the thread's
+///   first zone
+/// - Zones are only recorded between start() and stop(); otherwise a zone
+///   costs one relaxed atomic load
+/// - A full ring drops new zones and counts them (see dropped()) rather
+///   than blocking the thread being measured
+/// - FB_PROFILE_ZONE compiles to nothing unless FB_PROFILING is 1 (CMake
+///   option FB_CORE_PROFILING, which also instruments csv_parser::parse,
+///   signal::emit and udp_server::process_packet)
+///
+/// Thread Safety:
+/// - Zones may be recorded from any number of threads
+/// - start(), stop() and flush() may be called from any thread
+///
+/// Example:
+/// @code
+/// fb::profiler::start("trace.json");
+/// {
+///   FB_PROFILE_ZONE("load quotes");
+///   fb::csv_parser quotes("quotes.csv");
+/// }
+/// fb::profiler::stop();  // Open trace.json in ui.perfetto.dev
+/// @endcode
+
+#pragma once
+
+#include "fast_stop_watch.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#ifndef FB_PROFILING
+#define FB_PROFILING 0
+#endif
+
+namespace fb
+{
+
+/// @brief One finished zone, as stored in a thread's ring
+struct profile_record
+{
+  const char*   name;  ///< Zone name; must outlive the profiler session
+  std::uint64_t begin; ///< tsc_clock ticks at zone entry
+  std::uint64_t end;   ///< tsc_clock ticks at zone exit
+};
+
+namespace detail
+{
+
+/// Set between profiler::start() and profiler::stop()
+extern std::atomic<bool> profiler_collecting;
+
+} // namespace detail
+
+/// @brief Process-wide trace collection
+class profiler
+{
+public:
+  /// Default ring size per thread, in zones
+  static constexpr std::size_t DEFAULT_RECORDS_PER_THREAD = 16 * 1024;
+
+  /// @brief Begin collecting zones and writing them to @p filepath
+  ///
+  /// @param filepath Trace file, overwritten
+  /// @param flush_interval How often the background thread drains the rings
+  /// @param records_per_thread Ring size, rounded up to a power of two, of
+  ///                           threads that record their first zone during
+  ///                           this session
+  /// @throw std::logic_error if a session is already running
+  /// @throw std::runtime_error if the file cannot be opened
+  static void start(const std::filesystem::path& filepath,
+                    std::chrono::milliseconds    flush_interval     = std::chrono::milliseconds(100),
+                    std::size_t                  records_per_thread = DEFAULT_RECORDS_PER_THREAD);
+
+  /// @brief Stop collecting, write the remaining zones and close the file
+  ///
+  /// Does nothing if no session is running.
+  static void stop();
+
+  /// @brief Write the zones recorded so far without waiting for the flusher
+  static void flush();
+
+  /// @brief Check if zones are being collected
+  [[nodiscard]] static bool is_running() noexcept
+  {
+    return detail::profiler_collecting.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Zones dropped in this session because a thread's ring was full
+  [[nodiscard]] static std::uint64_t dropped() noexcept;
+
+  /// @brief Name the calling thread in traces
+  static void set_thread_name(std::string name);
+
+  /// @brief Store a finished zone in the calling thread's ring
+  static void record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+};
+
+/// @brief RAII zone: records its lifetime under @p name on destruction
+class profile_zone
+{
+public:
+  /// @param name Zone name; a string literal, as only the pointer is kept
+  explicit profile_zone(const char* name) noexcept
+      : m_name(name)
+      , m_begin(profiler::is_running() ? tsc_clock::now() : 0)
+  {
+  }
+
+  ~profile_zone()
+  {
+    if (m_begin != 0)
+    {
+      profiler::record(m_name, m_begin, tsc_clock::now());
+    }
+  }
+
+  profile_zone(const profile_zone&)            = delete;
+  profile_zone& operator=(const profile_zone&) = delete;
+
+private:
+  const char*   m_name;
+  std::uint64_t m_begin; ///< 0 when not recording
+};
+
+} // namespace fb
+
+#define FB_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FB_PROFILE_CONCAT(a, b)      FB_PROFILE_CONCAT_IMPL(a, b)
+
+#if FB_PROFILING
+/// @brief Time the rest of the enclosing scope as a zone named @p name
+#define FB_PROFILE_ZONE(name) const ::fb::profile_zone FB_PROFILE_CONCAT(fb_profile_zone_, __LINE__)(name)
+#else
+#define FB_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
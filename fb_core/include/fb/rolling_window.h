@@ -0,0 +1,497 @@
+#pragma once
+
+/******************************************************************************
+ * Toolbox Rolling Statistics Window
+ *****************************************************************************/
+
+#include "circular_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fb {
+
+namespace detail {
+
+/**
+ * @brief Fixed-capacity monotonic deque tracking the extreme of a window.
+ *
+ * Holds (value, sequence) pairs ordered by Compare from front to back. A new
+ * value first drops every entry from the back that can no longer be the
+ * extreme while it is in the window, so each value is pushed and popped at
+ * most once and the front is always the extreme of the window.
+ */
+template <typename T, typename Compare>
+class monotonic_queue
+{
+public:
+
+  explicit monotonic_queue(size_t capacity):
+    m_entries(capacity), m_head(0), m_size(0) {}
+
+  /** @brief Add the value with sequence number @p sequence at the back. */
+  void push(const T &value, uint64_t sequence)
+  {
+    while (m_size != 0 && !Compare()(m_entries[slot(m_size - 1)].first, value))
+    {
+      --m_size;
+    }
+    m_entries[slot(m_size)] = std::make_pair(value, sequence);
+    ++m_size;
+  }
+
+  /** @brief Drop the front if it is the value with sequence @p sequence. */
+  void evict(uint64_t sequence)
+  {
+    if (m_size != 0 && m_entries[m_head].second == sequence)
+    {
+      m_head = slot(1);
+      --m_size;
+    }
+  }
+
+  void clear() { m_head = 0; m_size = 0; }
+
+  const T &front() const { return m_entries[m_head].first; }
+
+private:
+
+  size_t slot(size_t offset) const
+  {
+    const size_t index = m_head + offset;
+    return index < m_entries.size() ? index : index - m_entries.size();
+  }
+
+  std::vector<std::pair<T, uint64_t> > m_entries;
+  size_t                               m_head;
+  size_t                               m_size;
+};
+
+} // namespace detail
+
+/**
+ * @brief Statistics over the most recent values pushed, kept up to date.
+ *
+ * The last @ref capacity values are held in a @ref circular_buffer that
+ * overwrites its oldest value when full. Each @ref push_back updates the
+ * statistics for the new value and for the value it evicts, so reading them
+ * never iterates the window:
+ *
+ *   - @ref sum and @ref mean in O(1), from a running sum
+ *   - @ref variance and @ref stddev in O(1), from a running Welford sum of
+ *     squared deviations that supports removal
+ *   - @ref min and @ref max in O(1), with O(1) amortized updates from two
+ *     monotonic deques
+ *   - @ref quantile approximately, from a histogram of the window with 32
+ *     logarithmic sub-buckets per power of two (like latency_histogram), so
+ *     any quantile is reported within about 3%. Magnitudes below 2^-32
+ *     count as zero and those from 2^64 up share the last bucket.
+ *
+ * Floating point sums drift as values are added and removed, so they are
+ * recomputed from the window once per @ref capacity evictions, which adds
+ * O(1) amortized work per value.
+ *
+ * @note NaN values are not supported. Not thread-safe.
+ *
+ * This class template accepts one template parameter:
+ *   - T  The arithmetic type of the values
+ */
+template <typename T>
+class rolling_window
+{
+  static_assert(std::is_arithmetic<T>::value, "rolling_window requires an arithmetic type");
+
+public:
+
+  typedef T      value_type;
+  typedef size_t size_type;
+
+  /// Exact running sum type: widest integer of T's signedness, or floating
+  typedef typename std::conditional<
+    std::is_floating_point<T>::value, typename std::common_type<T, double>::type,
+    typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type
+  >::type sum_type;
+
+  explicit rolling_window(size_t capacity);
+
+  void push_back(const value_type &value);
+  void pop_front();
+  void clear();
+
+  size_t size()     const { return m_values.size();     }
+  size_t capacity() const { return m_values.capacity(); }
+  bool   empty()    const { return m_values.empty();    }
+  bool   full()     const { return m_values.full();     }
+
+  /// The values in the window, oldest first
+  const circular_buffer<T> &values() const { return m_values; }
+
+  sum_type sum() const { return m_sum; }
+  double   mean() const;
+  double   variance() const;
+  double   stddev() const { return std::sqrt(variance()); }
+
+  const value_type &min() const;
+  const value_type &max() const;
+
+  double quantile(double q) const;
+  double median() const { return quantile(0.5); }
+
+private:
+
+  static constexpr int    SUB_BUCKET_BITS = 5;
+  static constexpr size_t SUB_BUCKETS     = size_t(1) << SUB_BUCKET_BITS;
+  static constexpr int    EXPONENT_MIN    = -31;
+  static constexpr int    EXPONENT_COUNT  = 96;
+  static constexpr size_t ZERO_GROUP      = EXPONENT_COUNT;
+  static constexpr size_t GROUP_COUNT     = 2 * EXPONENT_COUNT + 1;
+  static constexpr double ZERO_BELOW      = 1.0 / 4294967296.0;  // 2^(EXPONENT_MIN - 1)
+
+  void add(const value_type &value);
+  void remove(const value_type &value);
+  void refresh();
+
+  static size_t bucket_index(double value);
+  static double bucket_value(size_t index);
+
+  circular_buffer<T> m_values;
+  uint64_t           m_first;      // Sequence number of the oldest value
+  uint64_t           m_evictions;  // Evictions since the last refresh()
+
+  sum_type m_sum;
+  double   m_mean;                 // Welford mean, for m_m2
+  double   m_m2;                   // Sum of squared deviations from m_mean
+
+  detail::monotonic_queue<T, std::less<T> >    m_min;
+  detail::monotonic_queue<T, std::greater<T> > m_max;
+
+  // Histogram buckets in value order: negative groups, zero, positive groups
+  std::vector<uint32_t> m_buckets;
+  std::vector<uint32_t> m_groups;  // Per power of two totals of m_buckets
+};
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+/**
+ * @brief Class Constructor.
+ *
+ * @param capacity Number of most recent values the statistics cover.
+ * @throws std::invalid_argument If capacity is zero.
+ */
+template <typename T> inline
+rolling_window<T>::rolling_window(size_t capacity):
+  m_values(capacity)
+  , m_first(0)
+  , m_evictions(0)
+  , m_sum(0)
+  , m_mean(0)
+  , m_m2(0)
+  , m_min(capacity)
+  , m_max(capacity)
+  , m_buckets(GROUP_COUNT * SUB_BUCKETS, 0)
+  , m_groups(GROUP_COUNT, 0)
+{
+}
+
+/**
+ * @brief Add a value, evicting the oldest first if the window is full.
+ */
+template <typename T> inline
+void rolling_window<T>::push_back(const value_type &value)
+{
+  if (full())
+  {
+    pop_front();
+  }
+  m_values.push_back(value);
+  add(value);
+  if (m_evictions >= capacity())
+  {
+    refresh();
+  }
+}
+
+/**
+ * @brief Evict the oldest value; does nothing if the window is empty.
+ */
+template <typename T> inline
+void rolling_window<T>::pop_front()
+{
+  if (empty())
+  {
+    return;
+  }
+  remove(m_values.front());
+  m_min.evict(m_first);
+  m_max.evict(m_first);
+  ++m_first;
+  ++m_evictions;
+  m_values.pop_front();
+}
+
+/**
+ * @brief Evict every value.
+ */
+template <typename T> inline
+void rolling_window<T>::clear()
+{
+  m_values.clear();
+  m_min.clear();
+  m_max.clear();
+  m_first     = 0;
+  m_evictions = 0;
+  m_sum       = 0;
+  m_mean      = 0;
+  m_m2        = 0;
+  std::fill(m_buckets.begin(), m_buckets.end(), 0);
+  std::fill(m_groups.begin(), m_groups.end(), 0);
+}
+
+/**
+ * @brief Arithmetic mean of the window, 0 if it is empty.
+ */
+template <typename T> inline
+double rolling_window<T>::mean() const
+{
+  return empty() ? 0.0 : static_cast<double>(m_sum) / static_cast<double>(size());
+}
+
+/**
+ * @brief Population variance of the window, 0 if it is empty.
+ */
+template <typename T> inline
+double rolling_window<T>::variance() const
+{
+  return empty() ? 0.0 : m_m2 / static_cast<double>(size());
+}
+
+/**
+ * @brief Smallest value in the window.
+ *
+ * @throws std::out_of_range If the window is empty.
+ */
+template <typename T> inline
+const typename rolling_window<T>::value_type &rolling_window<T>::min() const
+{
+  if (empty())
+  {
+    throw std::out_of_range("rolling_window::min() of an empty window");
+  }
+  return m_min.front();
+}
+
+/**
+ * @brief Largest value in the window.
+ *
+ * @throws std::out_of_range If the window is empty.
+ */
+template <typename T> inline
+const typename rolling_window<T>::value_type &rolling_window<T>::max() const
+{
+  if (empty())
+  {
+    throw std::out_of_range("rolling_window::max() of an empty window");
+  }
+  return m_max.front();
+}
+
+/**
+ * @brief Approximate nearest-rank quantile of the window.
+ *
+ * Cost is proportional to the number of histogram buckets, not to the
+ * window size. 0 and 1 return min() and max() exactly; other results are
+ * clamped to that range.
+ *
+ * @param q Quantile in [0, 1], e.g. 0.99 for the 99th percentile.
+ * @throws std::invalid_argument If q is outside [0, 1].
+ * @throws std::out_of_range If the window is empty.
+ */
+template <typename T> inline
+double rolling_window<T>::quantile(double q) const
+{
+  if (!(q >= 0.0 && q <= 1.0))
+  {
+    throw std::invalid_argument("rolling_window::quantile() requires 0 <= q <= 1");
+  }
+  const double lowest  = static_cast<double>(min());
+  const double highest = static_cast<double>(max());
+  if (q == 0.0)
+  {
+    return lowest;
+  }
+  if (q == 1.0)
+  {
+    return highest;
+  }
+
+  const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(size()))));
+  uint64_t   seen = 0;
+  size_t     group = 0;
+  while (seen + m_groups[group] < rank)
+  {
+    seen += m_groups[group];
+    ++group;
+  }
+  size_t index = group * SUB_BUCKETS;
+  while (seen + m_buckets[index] < rank)
+  {
+    seen += m_buckets[index];
+    ++index;
+  }
+  return std::min(std::max(bucket_value(index), lowest), highest);
+}
+
+/**
+ * @brief Account for a value entering the window.
+ */
+template <typename T> inline
+void rolling_window<T>::add(const value_type &value)
+{
+  const uint64_t sequence = m_first + size() - 1;
+  m_min.push(value, sequence);
+  m_max.push(value, sequence);
+
+  m_sum += static_cast<sum_type>(value);
+
+  const double x     = static_cast<double>(value);
+  const double delta = x - m_mean;
+  m_mean += delta / static_cast<double>(size());
+  m_m2   += delta * (x - m_mean);
+
+  const size_t index = bucket_index(x);
+  ++m_buckets[index];
+  ++m_groups[index / SUB_BUCKETS];
+}
+
+/**
+ * @brief Account for a value leaving the window; called before it is popped.
+ */
+template <typename T> inline
+void rolling_window<T>::remove(const value_type &value)
+{
+  m_sum -= static_cast<sum_type>(value);
+
+  const double x = static_cast<double>(value);
+  const size_t n = size();
+  if (n == 1)
+  {
+    m_mean = 0;
+    m_m2   = 0;
+  }
+  else
+  {
+    const double old_mean = m_mean;
+    m_mean -= (x - old_mean) / static_cast<double>(n - 1);
+    m_m2   -= (x - old_mean) * (x - m_mean);
+    if (m_m2 < 0)
+    {
+      m_m2 = 0;
+    }
+  }
+
+  const size_t index = bucket_index(x);
+  --m_buckets[index];
+  --m_groups[index / SUB_BUCKETS];
+}
+
+/**
+ * @brief Recompute the floating point sums from the window to drop drift.
+ */
+template <typename T> inline
+void rolling_window<T>::refresh()
+{
+  m_evictions = 0;
+
+  if (std::is_floating_point<T>::value)
+  {
+    sum_type sum = 0;
+    for (const value_type &value : m_values)
+    {
+      sum += static_cast<sum_type>(value);
+    }
+    m_sum = sum;
+  }
+
+  double total = 0;
+  for (const value_type &value : m_values)
+  {
+    total += static_cast<double>(value);
+  }
+  m_mean = total / static_cast<double>(size());
+
+  double m2 = 0;
+  for (const value_type &value : m_values)
+  {
+    const double delta = static_cast<double>(value) - m_mean;
+    m2 += delta * delta;
+  }
+  m_m2 = m2;
+}
+
+/**
+ * @brief Histogram bucket of @p value; buckets increase with the value.
+ */
+template <typename T> inline
+size_t rolling_window<T>::bucket_index(double value)
+{
+  const double magnitude = std::fabs(value);
+  if (!(magnitude >= ZERO_BELOW))
+  {
+    return ZERO_GROUP * SUB_BUCKETS;
+  }
+
+  // magnitude = mantissa * 2^exponent with mantissa in [0.5, 1)
+  int          exponent = 0;
+  const double mantissa = std::frexp(magnitude, &exponent);
+  size_t       group;
+  size_t       sub;
+  if (exponent - EXPONENT_MIN >= EXPONENT_COUNT)
+  {
+    group = EXPONENT_COUNT - 1;
+    sub   = SUB_BUCKETS - 1;
+  }
+  else
+  {
+    group = static_cast<size_t>(exponent - EXPONENT_MIN);
+    sub   = std::min(static_cast<size_t>((mantissa * 2.0 - 1.0) * static_cast<double>(SUB_BUCKETS)),
+                     SUB_BUCKETS - 1);
+  }
+
+  if (value < 0)
+  {
+    return (ZERO_GROUP - 1 - group) * SUB_BUCKETS + (SUB_BUCKETS - 1 - sub);
+  }
+  return (ZERO_GROUP + 1 + group) * SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Midpoint of the values counted in bucket @p index.
+ */
+template <typename T> inline
+double rolling_window<T>::bucket_value(size_t index)
+{
+  const size_t slot_group = index / SUB_BUCKETS;
+  if (slot_group == ZERO_GROUP)
+  {
+    return 0.0;
+  }
+
+  const bool   negative = slot_group < ZERO_GROUP;
+  const size_t group    = negative ? ZERO_GROUP - 1 - slot_group : slot_group - ZERO_GROUP - 1;
+  const size_t sub      = negative ? SUB_BUCKETS - 1 - index % SUB_BUCKETS : index % SUB_BUCKETS;
+
+  const double mantissa  = 1.0 + (static_cast<double>(sub) + 0.5) / static_cast<double>(SUB_BUCKETS);
+  const double magnitude = std::ldexp(mantissa, static_cast<int>(group) + EXPONENT_MIN - 1);
+  return negative ? -magnitude : magnitude;
+}
+
+} // namespace fb
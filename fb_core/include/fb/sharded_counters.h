@@ -0,0 +1,157 @@
+#pragma once
+
+#include <fb/detail/atomic_utils.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace fb {
+
+namespace detail {
+
+/**
+ * @brief Small per-thread number used to pick a counter shard.
+ *
+ * Threads are numbered round-robin on first use, so the first threads that
+ * touch any sharded_counters land on distinct shards.
+ */
+inline std::size_t counter_shard_hint() noexcept
+{
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t hint = next.fetch_add(1, std::memory_order_relaxed);
+  return hint;
+}
+
+} // namespace detail
+
+/**
+ * @brief Statistics counters split into cache-line shards, summed on read.
+ *
+ * Every thread updates the shard picked by its thread number, so workers
+ * counting packets at the same time write to different cache lines instead
+ * of bouncing one line between cores. A shard holds all @p Fields counters,
+ * which keeps a thread's updates to related counters on a single line.
+ * Updates are relaxed atomic adds (threads beyond the shard count share
+ * shards), and reads add the shards up, so a value read while others write
+ * is a recent total rather than a snapshot.
+ *
+ * Besides counting, a field can track a per-thread latest value through
+ * set() and max(), e.g. the time of the last packet.
+ *
+ * @tparam Fields Number of counters kept together.
+ */
+template <std::size_t Fields>
+class sharded_counters
+{
+public:
+
+  static constexpr std::size_t MAX_SHARDS = 64;
+
+  /**
+   * @brief Create zeroed counters.
+   *
+   * @param shards Shards to spread over, rounded up to a power of two and
+   * capped at MAX_SHARDS; 0 sizes to the hardware concurrency.
+   */
+  explicit sharded_counters(std::size_t shards = 0) :
+    m_mask(round_shards(shards) - 1),
+    m_shards(new shard[m_mask + 1])
+  {
+  }
+
+  sharded_counters(const sharded_counters&)            = delete;
+  sharded_counters& operator=(const sharded_counters&) = delete;
+
+  /**
+   * @brief Add to a counter from the calling thread.
+   */
+  void add(std::size_t field, std::uint64_t n = 1) noexcept
+  {
+    local().values[field].fetch_add(n, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Record the calling thread's latest value of a field.
+   */
+  void set(std::size_t field, std::uint64_t value) noexcept
+  {
+    local().values[field].store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sum of a counter over all shards.
+   */
+  std::uint64_t value(std::size_t field) const noexcept
+  {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i <= m_mask; ++i)
+    {
+      total += m_shards[i].values[field].load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  /**
+   * @brief Largest value of a field over all shards (for set()).
+   */
+  std::uint64_t max(std::size_t field) const noexcept
+  {
+    std::uint64_t largest = 0;
+    for (std::size_t i = 0; i <= m_mask; ++i)
+    {
+      largest = std::max(largest, m_shards[i].values[field].load(std::memory_order_relaxed));
+    }
+    return largest;
+  }
+
+  /**
+   * @brief Overwrite a field so that value() and max() return @p value.
+   *
+   * Not atomic with respect to concurrent add(); meant for resets and for
+   * copying totals between instances.
+   */
+  void store(std::size_t field, std::uint64_t value) noexcept
+  {
+    for (std::size_t i = 1; i <= m_mask; ++i)
+    {
+      m_shards[i].values[field].store(0, std::memory_order_relaxed);
+    }
+    m_shards[0].values[field].store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Number of shards in use.
+   */
+  std::size_t shards() const noexcept { return m_mask + 1; }
+
+private:
+
+  struct alignas(detail::CACHE_LINE_SIZE) shard
+  {
+    std::atomic<std::uint64_t> values[Fields] = {};
+  };
+
+  static std::size_t round_shards(std::size_t shards) noexcept
+  {
+    if (shards == 0)
+    {
+      shards = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t rounded = 1;
+    while (rounded < shards && rounded < MAX_SHARDS)
+    {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+
+  shard& local() noexcept { return m_shards[detail::counter_shard_hint() & m_mask]; }
+
+  const std::size_t m_mask;          ///< shards() - 1
+  std::unique_ptr<shard[]> m_shards; ///< One cache-line-aligned block per shard
+};
+
+} // namespace fb
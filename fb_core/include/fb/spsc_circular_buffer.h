@@ -0,0 +1,254 @@
+#pragma once
+
+/******************************************************************************
+ * Toolbox Lock-Free Single-Producer / Single-Consumer Circular Buffer
+ *****************************************************************************/
+
+#include "fb/detail/atomic_utils.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace fb {
+
+/**
+ * @brief Lock-free circular buffer for one producer and one consumer thread.
+ *
+ * The thread-safe counterpart of @ref circular_buffer for handing data from
+ * one thread to another: one thread calls @ref push_back, another calls
+ * @ref front and @ref pop_front, and neither takes a lock.
+ *
+ * The head index is written only by the consumer and the tail only by the
+ * producer, each on its own cache line. Each side also keeps a private copy
+ * of the other side's index and reloads the shared one only when its copy
+ * says the buffer is full (producer) or empty (consumer), so in steady state
+ * the two threads rarely touch each other's cache lines.
+ *
+ * Unlike circular_buffer, a full buffer never overwrites: the producer cannot
+ * drop the oldest element without racing the consumer, so @ref push_back
+ * returns false instead. There are no iterators or random access.
+ *
+ * @note Calling the producer functions from more than one thread, or the
+ * consumer functions from more than one thread, is undefined. Use
+ * @ref mpsc_circular_buffer for several producers.
+ *
+ * This class template accepts two template parameters:
+ *   - T      The type of object contained
+ *   - Alloc  Allocator type to use (in line with other STL containers).
+ */
+template <typename T, typename Alloc = std::allocator<T> >
+class spsc_circular_buffer
+{
+public:
+
+  using allocator_type   = Alloc;
+  using allocator_traits = std::allocator_traits<allocator_type>;
+
+  using value_type      = typename allocator_traits::value_type;
+  using reference       = value_type&;
+  using const_reference = const value_type&;
+
+  typedef size_t size_type;
+
+  explicit spsc_circular_buffer(size_t capacity, const allocator_type &alloc = allocator_type());
+  ~spsc_circular_buffer();
+
+  spsc_circular_buffer(const spsc_circular_buffer &)            = delete;
+  spsc_circular_buffer &operator=(const spsc_circular_buffer &) = delete;
+
+  allocator_type get_allocator() const { return m_allocatorT; }
+
+  // Producer
+  bool push_back(const value_type &item) { return emplace_back(item);            }
+  bool push_back(value_type &&item)      { return emplace_back(std::move(item)); }
+
+  template <typename... Args>
+  bool emplace_back(Args &&...args);
+
+  // Consumer
+  value_type *front();
+  void pop_front();
+  bool pop_front(value_type &item);
+  void clear();
+
+  // Either thread; exact only while the other side is idle
+  size_t size()     const;
+  bool   empty()    const { return size() == 0;           }
+  bool   full()     const { return size() == m_arraySize; }
+  size_t capacity() const { return m_arraySize;           }
+
+private:
+
+  static size_t round_up_pow2(size_t value);
+
+  allocator_type  m_allocatorT;
+  value_type     *m_data;
+  const size_t    m_arraySize;
+  const size_t    m_mask;
+
+  // Written by the consumer only
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<size_t> m_head{0};
+  size_t m_cached_tail = 0;
+
+  // Written by the producer only
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<size_t> m_tail{0};
+  size_t m_cached_head = 0;
+};
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+/**
+ * @brief Class Constructor.
+ *
+ * @param capacity Minimum number of elements; rounded up to a power of two
+ *                 so slots are found with a mask instead of a division.
+ * @param alloc    Allocator for the element array, e.g. a
+ *                 std::pmr::polymorphic_allocator over an fb::monotonic_arena.
+ * @throws std::invalid_argument If capacity is zero.
+ */
+template <typename T, typename Alloc> inline
+spsc_circular_buffer<T, Alloc>::spsc_circular_buffer(size_t capacity, const allocator_type &alloc):
+  m_allocatorT(alloc)
+  , m_data(nullptr)
+  , m_arraySize(round_up_pow2(capacity))
+  , m_mask(m_arraySize - 1)
+{
+  m_data = allocator_traits::allocate(m_allocatorT, m_arraySize);
+}
+
+/**
+ * @brief Class Destructor. Destroys the elements still held.
+ */
+template <typename T, typename Alloc> inline
+spsc_circular_buffer<T, Alloc>::~spsc_circular_buffer()
+{
+  clear();
+  allocator_traits::deallocate(m_allocatorT, m_data, m_arraySize);
+}
+
+/**
+ * @brief Construct an element at the back. Producer only.
+ *
+ * @return False, constructing nothing, if the buffer is full.
+ */
+template <typename T, typename Alloc>
+template <typename... Args> inline
+bool spsc_circular_buffer<T, Alloc>::emplace_back(Args &&...args)
+{
+  const size_t tail = m_tail.load(std::memory_order_relaxed);
+  if (tail - m_cached_head == m_arraySize)
+  {
+    m_cached_head = m_head.load(std::memory_order_acquire);
+    if (tail - m_cached_head == m_arraySize)
+    {
+      return false;
+    }
+  }
+  allocator_traits::construct(m_allocatorT, m_data + (tail & m_mask), std::forward<Args>(args)...);
+  m_tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Oldest element, or nullptr if the buffer is empty. Consumer only.
+ *
+ * The element stays valid until the consumer pops it.
+ */
+template <typename T, typename Alloc> inline
+typename spsc_circular_buffer<T, Alloc>::value_type *spsc_circular_buffer<T, Alloc>::front()
+{
+  const size_t head = m_head.load(std::memory_order_relaxed);
+  if (head == m_cached_tail)
+  {
+    m_cached_tail = m_tail.load(std::memory_order_acquire);
+    if (head == m_cached_tail)
+    {
+      return nullptr;
+    }
+  }
+  return m_data + (head & m_mask);
+}
+
+/**
+ * @brief Destroy the oldest element; does nothing if empty. Consumer only.
+ */
+template <typename T, typename Alloc> inline
+void spsc_circular_buffer<T, Alloc>::pop_front()
+{
+  value_type *item = front();
+  if (item != nullptr)
+  {
+    allocator_traits::destroy(m_allocatorT, item);
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+}
+
+/**
+ * @brief Move the oldest element out and destroy it. Consumer only.
+ *
+ * @return False, leaving @p item untouched, if the buffer is empty.
+ */
+template <typename T, typename Alloc> inline
+bool spsc_circular_buffer<T, Alloc>::pop_front(value_type &item)
+{
+  value_type *oldest = front();
+  if (oldest == nullptr)
+  {
+    return false;
+  }
+  item = std::move(*oldest);
+  allocator_traits::destroy(m_allocatorT, oldest);
+  m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Destroy every element. Consumer only.
+ */
+template <typename T, typename Alloc> inline
+void spsc_circular_buffer<T, Alloc>::clear()
+{
+  while (front() != nullptr)
+  {
+    pop_front();
+  }
+}
+
+/**
+ * @brief Number of elements held.
+ */
+template <typename T, typename Alloc> inline
+size_t spsc_circular_buffer<T, Alloc>::size() const
+{
+  // Head first: reading it second could see it pass the tail read first
+  const size_t head = m_head.load(std::memory_order_acquire);
+  const size_t tail = m_tail.load(std::memory_order_acquire);
+  return tail - head;
+}
+
+/**
+ * @brief Smallest power of two not below @p value.
+ *
+ * @throws std::invalid_argument If value is zero.
+ */
+template <typename T, typename Alloc> inline
+size_t spsc_circular_buffer<T, Alloc>::round_up_pow2(size_t value)
+{
+  if (value == 0)
+  {
+    throw std::invalid_argument("spsc_circular_buffer capacity must be greater than zero");
+  }
+  size_t result = 1;
+  while (result < value)
+  {
+    result <<= 1;
+  }
+  return result;
+}
+
+} // namespace fb
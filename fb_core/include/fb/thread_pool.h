@@ -0,0 +1,526 @@
+/// @file thread_pool.h
+/// @brief Work-stealing thread pool shared by the FooBar components
+///
+/// One pool of worker threads that timers, servers and signal fan-out can
+/// share instead of each spawning threads of their own.
+///
+/// Features:
+/// - One task deque per worker: the owner pushes and pops at the back
+///   (newest first, cache-warm), idle workers steal from the front
+/// - Tasks up to task::INLINE_SIZE bytes are stored without allocation
+/// - Affinity hints: submit_to() queues on a chosen worker, and workers
+///   can be pinned to CPUs
+/// - Idle workers sleep; submit() wakes one only when some are asleep
+/// - Usable as the executor of fb::signal::emit_parallel()
+///
+/// Thread Safety:
+/// - submit() and submit_to() may be called from any thread, including
+///   from inside a task
+/// - The destructor runs every queued task, then joins the workers
+///
+/// Tasks must not throw: an exception escaping a task calls std::terminate.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace fb {
+
+/// @brief Move-only nullary callable with inline storage for small targets
+///
+/// Callables up to INLINE_SIZE bytes that are nothrow move constructible live
+/// inside the task; larger ones are allocated once on construction.
+class task
+{
+public:
+
+  static constexpr std::size_t INLINE_SIZE = 48;
+
+  task() noexcept = default;
+
+  template <typename F,
+            typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, task>>>
+  task(F && func);
+
+  task(task && other) noexcept;
+  task & operator=(task && other) noexcept;
+  ~task();
+
+  task(const task &)             = delete;
+  task & operator=(const task &) = delete;
+
+  /// @brief Invoke the stored callable
+  void operator()();
+
+  [[nodiscard]] explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+  /// @brief True if callable type @p F is stored without allocation
+  template <typename F>
+  static constexpr bool is_inline() noexcept
+  {
+    return sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<F>;
+  }
+
+private:
+
+  struct operations
+  {
+    void (*invoke)(void * storage);
+    void (*move)(void * from, void * to) noexcept; ///< Move-construct at @p to, destroy @p from
+    void (*destroy)(void * storage) noexcept;
+  };
+
+  template <typename F>
+  static F * inline_target(void * storage) noexcept
+  {
+    return std::launder(reinterpret_cast<F *>(storage));
+  }
+
+  template <typename F>
+  static F *& heap_target(void * storage) noexcept
+  {
+    return *std::launder(reinterpret_cast<F **>(storage));
+  }
+
+  template <typename F>
+  static constexpr operations inline_operations{
+      [](void * storage) { (*inline_target<F>(storage))(); },
+      [](void * from, void * to) noexcept
+      {
+        ::new (to) F(std::move(*inline_target<F>(from)));
+        inline_target<F>(from)->~F();
+      },
+      [](void * storage) noexcept { inline_target<F>(storage)->~F(); }};
+
+  template <typename F>
+  static constexpr operations heap_operations{
+      [](void * storage) { (*heap_target<F>(storage))(); },
+      [](void * from, void * to) noexcept { ::new (to) F *(heap_target<F>(from)); },
+      [](void * storage) noexcept { delete heap_target<F>(storage); }};
+
+  void reset() noexcept;
+
+  alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+  const operations * m_ops = nullptr;
+};
+
+/// @brief Thread pool construction options
+struct thread_pool_options
+{
+  /// Worker threads; 0 uses std::thread::hardware_concurrency()
+  std::size_t threads = 0;
+
+  /// CPUs to pin workers to: worker i runs on cpus[i % cpus.size()].
+  /// Empty leaves placement to the scheduler. Ignored off Linux.
+  std::vector<int> cpus;
+};
+
+/// @brief Work-stealing pool of worker threads
+///
+/// Basic Usage:
+/// @code
+/// fb::thread_pool pool(4);
+/// pool.submit([]() { compress_block(); });
+/// pool.wait_idle();  // Every submitted task has run
+/// @endcode
+///
+/// Sharing one pool:
+/// @code
+/// auto & pool = fb::thread_pool::shared();
+/// on_frame.emit_parallel(pool, frame);  // Slots fan out over the pool
+/// @endcode
+///
+/// Scheduling:
+/// - A task submitted from a worker goes to that worker's deque, others
+///   to the workers in turn; submit_to() picks the worker
+/// - A worker runs its own newest task first, then steals the oldest
+///   task of another worker, then sleeps
+/// - No fairness or ordering between tasks is guaranteed
+class thread_pool
+{
+public:
+
+  /// Returned by current_worker() outside the pool's workers
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  /// @brief Start @p threads workers (0: one per hardware thread)
+  explicit thread_pool(std::size_t threads = 0);
+
+  /// @brief Start workers as described by @p options
+  /// @throw std::invalid_argument if a CPU index is negative
+  explicit thread_pool(const thread_pool_options & options);
+
+  /// @brief Runs every queued task, then joins the workers
+  ~thread_pool();
+
+  thread_pool(const thread_pool &)             = delete;
+  thread_pool & operator=(const thread_pool &) = delete;
+  thread_pool(thread_pool &&)                  = delete;
+  thread_pool & operator=(thread_pool &&)      = delete;
+
+  /// @brief Queue @p func to run on some worker
+  template <typename F>
+  void submit(F && func);
+
+  /// @brief Queue @p func on worker @p worker (modulo size())
+  ///
+  /// A hint: the task stays on that worker's deque unless another worker
+  /// runs out of work and steals it.
+  template <typename F>
+  void submit_to(std::size_t worker, F && func);
+
+  /// @brief Block until every submitted task has finished
+  ///
+  /// Must not be called from a task of this pool.
+  void wait_idle();
+
+  /// @brief Number of worker threads
+  [[nodiscard]] std::size_t size() const noexcept { return m_workers.size(); }
+
+  /// @brief Tasks queued and not yet started
+  [[nodiscard]] std::size_t pending() const noexcept;
+
+  /// @brief Tasks a worker took from another worker's deque
+  [[nodiscard]] uint64_t stolen_count() const noexcept;
+
+  /// @brief Index of the calling worker of this pool, or npos
+  [[nodiscard]] std::size_t current_worker() const noexcept;
+
+  /// @brief Process-wide pool with one worker per hardware thread
+  ///
+  /// Created on first use and joined at exit.
+  static thread_pool & shared();
+
+private:
+
+  /// @brief One worker: its deque and thread
+  struct worker_state
+  {
+    std::mutex mutex;        ///< Guards tasks
+    std::deque<task> tasks;  ///< Owner at the back, thieves at the front
+    std::thread thread;
+  };
+
+  void start(const thread_pool_options & options);
+  void push(std::size_t index, task && work);
+  bool pop_local(std::size_t index, task & work);
+  bool steal(std::size_t thief, task & work);
+  void run(task & work);
+  void worker_loop(std::size_t index);
+
+  std::vector<std::unique_ptr<worker_state>> m_workers;
+
+  std::atomic<std::size_t> m_queued{0};     ///< Tasks in the deques
+  std::atomic<std::size_t> m_unfinished{0}; ///< Submitted and not yet finished
+  std::atomic<std::size_t> m_sleepers{0};   ///< Workers waiting on m_wake
+  std::atomic<std::size_t> m_next{0};       ///< Round-robin cursor for outside submitters
+  std::atomic<uint64_t> m_stolen{0};
+
+  std::mutex m_mutex;                ///< Guards m_stopping and the waits below
+  std::condition_variable m_wake;    ///< Work was queued, or stopping
+  std::condition_variable m_idle;    ///< m_unfinished reached zero
+  bool m_stopping = false;
+
+  /// Pool and index of the worker running on this thread
+  inline static thread_local const thread_pool * t_pool  = nullptr;
+  inline static thread_local std::size_t t_index         = npos;
+};
+
+// ============================================================================
+// Implementation - task
+// ============================================================================
+
+template <typename F, typename>
+inline task::task(F && func)
+{
+  using target = std::decay_t<F>;
+  if constexpr (is_inline<target>())
+  {
+    ::new (static_cast<void *>(m_storage)) target(std::forward<F>(func));
+    m_ops = &inline_operations<target>;
+  }
+  else
+  {
+    ::new (static_cast<void *>(m_storage)) target *(new target(std::forward<F>(func)));
+    m_ops = &heap_operations<target>;
+  }
+}
+
+inline task::task(task && other) noexcept :
+  m_ops(other.m_ops)
+{
+  if (m_ops != nullptr)
+  {
+    m_ops->move(other.m_storage, m_storage);
+    other.m_ops = nullptr;
+  }
+}
+
+inline task & task::operator=(task && other) noexcept
+{
+  if (this != &other)
+  {
+    reset();
+    m_ops = other.m_ops;
+    if (m_ops != nullptr)
+    {
+      m_ops->move(other.m_storage, m_storage);
+      other.m_ops = nullptr;
+    }
+  }
+  return *this;
+}
+
+inline task::~task()
+{
+  reset();
+}
+
+inline void task::operator()()
+{
+  m_ops->invoke(m_storage);
+}
+
+inline void task::reset() noexcept
+{
+  if (m_ops != nullptr)
+  {
+    m_ops->destroy(m_storage);
+    m_ops = nullptr;
+  }
+}
+
+// ============================================================================
+// Implementation - thread_pool
+// ============================================================================
+
+inline thread_pool::thread_pool(std::size_t threads)
+{
+  thread_pool_options options;
+  options.threads = threads;
+  start(options);
+}
+
+inline thread_pool::thread_pool(const thread_pool_options & options)
+{
+  for (int cpu : options.cpus)
+  {
+    if (cpu < 0)
+    {
+      throw std::invalid_argument("thread_pool CPU index must not be negative");
+    }
+  }
+  start(options);
+}
+
+/// @brief Stop the workers
+///
+/// Workers keep running tasks, including tasks those tasks submit, until
+/// every deque is empty.
+inline thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  for (auto & entry : m_workers)
+  {
+    entry->thread.join();
+  }
+}
+
+inline void thread_pool::start(const thread_pool_options & options)
+{
+  std::size_t threads = options.threads;
+  if (threads == 0)
+  {
+    threads = (std::max)(1u, std::thread::hardware_concurrency());
+  }
+
+  // Every deque exists before any worker can steal from it
+  m_workers.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i)
+  {
+    m_workers.push_back(std::make_unique<worker_state>());
+  }
+  for (std::size_t i = 0; i < threads; ++i)
+  {
+    m_workers[i]->thread = std::thread(&thread_pool::worker_loop, this, i);
+
+#ifdef __linux__
+    if (!options.cpus.empty())
+    {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(static_cast<std::size_t>(options.cpus[i % options.cpus.size()]), &set);
+      // Best effort: a CPU outside the process's mask leaves the worker unpinned
+      pthread_setaffinity_np(m_workers[i]->thread.native_handle(), sizeof(set), &set);
+    }
+#endif
+  }
+}
+
+template <typename F>
+inline void thread_pool::submit(F && func)
+{
+  std::size_t index = current_worker();
+  if (index == npos)
+  {
+    index = m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+  }
+  push(index, task(std::forward<F>(func)));
+}
+
+template <typename F>
+inline void thread_pool::submit_to(std::size_t worker, F && func)
+{
+  push(worker % m_workers.size(), task(std::forward<F>(func)));
+}
+
+inline void thread_pool::push(std::size_t index, task && work)
+{
+  m_unfinished.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(m_workers[index]->mutex);
+    m_workers[index]->tasks.push_back(std::move(work));
+  }
+
+  // Pairs with worker_loop(): a worker increments m_sleepers before it
+  // checks m_queued, so one of the two sides sees the other
+  m_queued.fetch_add(1, std::memory_order_seq_cst);
+  if (m_sleepers.load(std::memory_order_seq_cst) != 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_wake.notify_one();
+  }
+}
+
+inline bool thread_pool::pop_local(std::size_t index, task & work)
+{
+  worker_state & self = *m_workers[index];
+  std::lock_guard<std::mutex> lock(self.mutex);
+  if (self.tasks.empty())
+  {
+    return false;
+  }
+  work = std::move(self.tasks.back());
+  self.tasks.pop_back();
+  return true;
+}
+
+inline bool thread_pool::steal(std::size_t thief, task & work)
+{
+  const std::size_t count = m_workers.size();
+  for (std::size_t offset = 1; offset < count; ++offset)
+  {
+    worker_state & victim = *m_workers[(thief + offset) % count];
+    std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || victim.tasks.empty())
+    {
+      continue;
+    }
+    work = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    m_stolen.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+inline void thread_pool::run(task & work)
+{
+  m_queued.fetch_sub(1, std::memory_order_relaxed);
+  work();
+  work = task();
+
+  if (m_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_idle.notify_all();
+  }
+}
+
+inline void thread_pool::worker_loop(std::size_t index)
+{
+  t_pool  = this;
+  t_index = index;
+
+  task work;
+  for (;;)
+  {
+    if (pop_local(index, work) || steal(index, work))
+    {
+      run(work);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+    // Queued work this pass missed (a busy deque) keeps the worker awake
+    m_wake.wait(lock, [this]()
+    {
+      return m_stopping || m_queued.load(std::memory_order_seq_cst) != 0;
+    });
+    m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+    if (m_stopping && m_queued.load(std::memory_order_seq_cst) == 0)
+    {
+      return;
+    }
+  }
+}
+
+inline void thread_pool::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [this]()
+  {
+    return m_unfinished.load(std::memory_order_acquire) == 0;
+  });
+}
+
+inline std::size_t thread_pool::pending() const noexcept
+{
+  return m_queued.load(std::memory_order_relaxed);
+}
+
+inline uint64_t thread_pool::stolen_count() const noexcept
+{
+  return m_stolen.load(std::memory_order_relaxed);
+}
+
+inline std::size_t thread_pool::current_worker() const noexcept
+{
+  return t_pool == this ? t_index : npos;
+}
+
+inline thread_pool & thread_pool::shared()
+{
+  static thread_pool pool;
+  return pool;
+}
+
+} // namespace fb
@@ -0,0 +1,518 @@
+/// @file timer_service.h
+/// @brief Many timers multiplexed onto one thread
+///
+/// A timer_service keeps every armed timer in one 4-ary min-heap ordered by
+/// deadline and runs their callbacks on a thread or a few of its own, so
+/// timers cost a heap entry each instead of a thread each.
+///
+/// Features:
+/// - O(log n) arm and cancel; the next deadline is found in O(1)
+/// - One-shot and repeating timers, repeating ones on an absolute schedule
+///   without drift
+/// - Callbacks up to task::INLINE_SIZE bytes are stored without allocation
+/// - Ids carry a generation: cancelling a timer that already fired is a
+///   harmless no-op, even once its slot holds another timer
+/// - fb::timer attaches to a service instead of starting a thread
+/// - Optional slack: deadlines rounded up to a shared tick, so timers due
+///   in the same tick cost one wakeup between them
+///
+/// Thread Safety:
+/// - All methods may be called from any thread, including from inside a
+///   callback
+/// - cancel() returns only once the callback is not running, unless it is
+///   called from that callback
+///
+/// Callbacks must not throw: an exception escaping a callback calls
+/// std::terminate.
+
+#pragma once
+
+#include "fb/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fb {
+
+/// @brief Timers of any number on a fixed set of threads
+///
+/// Basic Usage:
+/// @code
+/// fb::timer_service timers;
+/// auto heartbeat = timers.schedule_every(std::chrono::seconds(1), []() { send_heartbeat(); });
+/// auto deadline  = timers.schedule_after(std::chrono::milliseconds(250), []() { cancel_order(); });
+/// timers.cancel(deadline);  // Filled in time
+/// @endcode
+///
+/// Scheduling:
+/// - Timers fire in deadline order, timers with equal deadlines in the
+///   order they were armed
+/// - A callback runs on one of the service threads; with one thread a
+///   slow callback delays the timers due after it
+/// - A repeating timer is re-armed once its callback returns, so its
+///   callbacks never overlap; periods missed meanwhile are skipped
+/// - With slack, a timer fires at the first multiple of the slack (since
+///   the steady_clock epoch) at or after its deadline, in arming order
+///   within a tick; repeating timers keep their own schedule and are only
+///   rounded when they fire
+class timer_service
+{
+public:
+
+  using clock    = std::chrono::steady_clock;
+  using timer_id = std::uint64_t;
+
+  /// Never returned by the schedule methods
+  static constexpr timer_id invalid_id = 0;
+
+  /// Slack of coarse()
+  static constexpr std::chrono::milliseconds COARSE_TICK{10};
+
+  /// @brief Start @p threads service threads (at least one)
+  ///
+  /// @param threads Service threads
+  /// @param slack Tick deadlines are rounded up to; zero fires them exactly
+  /// @throw std::invalid_argument if @p slack is negative
+  explicit timer_service(std::size_t threads = 1, clock::duration slack = clock::duration::zero());
+
+  /// @brief Drops the pending timers, waits for running callbacks, joins the threads
+  ///
+  /// Must not be called from a callback of this service.
+  ~timer_service();
+
+  timer_service(const timer_service &)             = delete;
+  timer_service & operator=(const timer_service &) = delete;
+  timer_service(timer_service &&)                  = delete;
+  timer_service & operator=(timer_service &&)      = delete;
+
+  /// @brief Run @p callback once at @p deadline
+  template <typename F>
+  timer_id schedule_at(clock::time_point deadline, F && callback);
+
+  /// @brief Run @p callback once, @p delay from now
+  template <typename F>
+  timer_id schedule_after(clock::duration delay, F && callback);
+
+  /// @brief Run @p callback every @p period, first @p period from now
+  /// @throw std::invalid_argument if @p period is not positive
+  template <typename F>
+  timer_id schedule_every(clock::duration period, F && callback);
+
+  /// @brief Run @p callback at @p first and every @p period after it
+  /// @throw std::invalid_argument if @p period is not positive
+  template <typename F>
+  timer_id schedule_every(clock::time_point first, clock::duration period, F && callback);
+
+  /// @brief Stop timer @p id from firing again
+  ///
+  /// If its callback is running on another thread, waits for it to return.
+  ///
+  /// @return false if @p id had already fired for the last time or been cancelled
+  bool cancel(timer_id id);
+
+  /// @brief Timers armed or running
+  [[nodiscard]] std::size_t size() const;
+
+  /// @brief Number of service threads
+  [[nodiscard]] std::size_t thread_count() const noexcept { return m_thread_count; }
+
+  /// @brief Tick deadlines are rounded up to, zero if none
+  [[nodiscard]] clock::duration slack() const noexcept { return m_slack; }
+
+  /// @brief Process-wide service with one thread
+  ///
+  /// Created on first use and joined at exit.
+  static timer_service & shared();
+
+  /// @brief Process-wide service with one thread and COARSE_TICK slack
+  ///
+  /// Runs the timers set to timer_accuracy::coarse. Created on first use
+  /// and joined at exit.
+  static timer_service & coarse();
+
+private:
+
+  static constexpr std::size_t ARITY = 4;
+  static constexpr std::size_t npos  = static_cast<std::size_t>(-1);
+
+  /// @brief One timer: a heap entry while armed, a free slot otherwise
+  struct entry
+  {
+    task callback;
+    clock::time_point deadline;     ///< Scheduled time
+    clock::time_point due;          ///< deadline rounded up to the slack; the heap key
+    clock::duration period{};       ///< Zero for one-shot timers
+    std::uint64_t sequence = 0;     ///< Arming order, breaks deadline ties
+    std::size_t heap_index = npos;  ///< Position in m_heap, npos when not armed
+    std::uint32_t generation = 1;   ///< Bumped on release so stale ids miss
+    bool running = false;           ///< Callback taken by a service thread
+    bool cancelled = false;         ///< Cancelled while running
+    std::thread::id runner;         ///< Thread running the callback
+  };
+
+  timer_id arm(clock::time_point deadline, clock::duration period, task && callback);
+  clock::time_point round_up(clock::time_point deadline) const noexcept;
+  std::uint32_t find(timer_id id) const noexcept;  ///< Slot of a live timer, or m_entries.size()
+  void release(std::uint32_t index);
+  void worker_loop();
+
+  bool earlier(std::uint32_t a, std::uint32_t b) const noexcept;
+  void place(std::size_t position, std::uint32_t index) noexcept;
+  void sift_up(std::size_t position) noexcept;
+  void sift_down(std::size_t position) noexcept;
+  void heap_push(std::uint32_t index);
+  void heap_erase(std::size_t position) noexcept;
+
+  std::vector<entry> m_entries;
+  std::vector<std::uint32_t> m_free;  ///< Released slots of m_entries
+  std::vector<std::uint32_t> m_heap;  ///< Armed slots, earliest deadline first
+  std::vector<std::thread> m_threads;
+  std::size_t m_thread_count = 0;
+  clock::duration m_slack;
+
+  mutable std::mutex m_mutex;       ///< Guards the timers and m_stopping
+  std::condition_variable m_wake;   ///< The earliest deadline changed, or stopping
+  std::condition_variable m_done;   ///< A callback cancelled while running returned
+  std::uint64_t m_sequence = 0;
+  bool m_stopping = false;
+};
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+inline timer_service::timer_service(std::size_t threads, clock::duration slack) :
+  m_slack(slack)
+{
+  if (slack < clock::duration::zero())
+  {
+    throw std::invalid_argument("timer_service slack must not be negative");
+  }
+
+  m_thread_count = (std::max)(threads, std::size_t{1});
+  m_threads.reserve(m_thread_count);
+  for (std::size_t i = 0; i < m_thread_count; ++i)
+  {
+    m_threads.emplace_back(&timer_service::worker_loop, this);
+  }
+}
+
+inline timer_service::~timer_service()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  for (auto & thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+template <typename F>
+inline timer_service::timer_id timer_service::schedule_at(clock::time_point deadline, F && callback)
+{
+  return arm(deadline, clock::duration::zero(), task(std::forward<F>(callback)));
+}
+
+template <typename F>
+inline timer_service::timer_id timer_service::schedule_after(clock::duration delay, F && callback)
+{
+  return schedule_at(clock::now() + delay, std::forward<F>(callback));
+}
+
+template <typename F>
+inline timer_service::timer_id timer_service::schedule_every(clock::duration period, F && callback)
+{
+  return schedule_every(clock::now() + period, period, std::forward<F>(callback));
+}
+
+template <typename F>
+inline timer_service::timer_id timer_service::schedule_every(clock::time_point first, clock::duration period,
+                                                             F && callback)
+{
+  if (period <= clock::duration::zero())
+  {
+    throw std::invalid_argument("timer_service period must be greater than 0");
+  }
+  return arm(first, period, task(std::forward<F>(callback)));
+}
+
+inline bool timer_service::cancel(timer_id id)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const std::uint32_t index = find(id);
+  if (index == m_entries.size())
+  {
+    return false;
+  }
+
+  entry & target = m_entries[index];
+  if (!target.running)
+  {
+    heap_erase(target.heap_index);
+    release(index);
+    return true;
+  }
+
+  // The callback is running: it is released when it returns
+  const bool repeating = target.period > clock::duration::zero() && !target.cancelled;
+  target.cancelled     = true;
+  if (target.runner != std::this_thread::get_id())
+  {
+    m_done.wait(lock, [this, id]() { return find(id) == m_entries.size(); });
+  }
+  return repeating;
+}
+
+inline std::size_t timer_service::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size() - m_free.size();
+}
+
+inline timer_service & timer_service::shared()
+{
+  static timer_service service;
+  return service;
+}
+
+inline timer_service & timer_service::coarse()
+{
+  static timer_service service(1, COARSE_TICK);
+  return service;
+}
+
+inline timer_service::timer_id timer_service::arm(clock::time_point deadline, clock::duration period,
+                                                  task && callback)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::uint32_t index;
+  if (m_free.empty())
+  {
+    index = static_cast<std::uint32_t>(m_entries.size());
+    m_entries.emplace_back();
+  }
+  else
+  {
+    index = m_free.back();
+    m_free.pop_back();
+  }
+
+  entry & armed   = m_entries[index];
+  armed.callback  = std::move(callback);
+  armed.deadline  = deadline;
+  armed.due       = round_up(deadline);
+  armed.period    = period;
+  armed.sequence  = m_sequence++;
+  armed.cancelled = false;
+  heap_push(index);
+
+  if (armed.heap_index == 0)
+  {
+    m_wake.notify_one();
+  }
+  return (static_cast<timer_id>(armed.generation) << 32) | index;
+}
+
+inline timer_service::clock::time_point timer_service::round_up(clock::time_point deadline) const noexcept
+{
+  if (m_slack == clock::duration::zero())
+  {
+    return deadline;
+  }
+
+  auto past = deadline.time_since_epoch() % m_slack;
+  if (past < clock::duration::zero())
+  {
+    past += m_slack;
+  }
+  return past == clock::duration::zero() ? deadline : deadline + (m_slack - past);
+}
+
+inline std::uint32_t timer_service::find(timer_id id) const noexcept
+{
+  const auto index = static_cast<std::uint32_t>(id & 0xffffffffu);
+  if (index >= m_entries.size())
+  {
+    return static_cast<std::uint32_t>(m_entries.size());
+  }
+
+  const entry & candidate = m_entries[index];
+  const bool live         = candidate.heap_index != npos || candidate.running;
+  if (!live || candidate.generation != static_cast<std::uint32_t>(id >> 32))
+  {
+    return static_cast<std::uint32_t>(m_entries.size());
+  }
+  return index;
+}
+
+inline void timer_service::release(std::uint32_t index)
+{
+  entry & slot   = m_entries[index];
+  slot.callback  = task();
+  slot.running   = false;
+  slot.cancelled = false;
+  if (++slot.generation == 0)
+  {
+    slot.generation = 1;
+  }
+  m_free.push_back(index);
+}
+
+inline void timer_service::worker_loop()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stopping)
+  {
+    if (m_heap.empty())
+    {
+      m_wake.wait(lock);
+      continue;
+    }
+
+    const clock::time_point next_due = m_entries[m_heap.front()].due;
+    if (clock::now() < next_due)
+    {
+      m_wake.wait_until(lock, next_due);
+      continue;
+    }
+
+    const std::uint32_t index = m_heap.front();
+    heap_erase(0);
+    entry & due = m_entries[index];
+    due.running = true;
+    due.runner  = std::this_thread::get_id();
+    task callback(std::move(due.callback));
+
+    // Another thread watches the next deadline while this one is busy
+    if (!m_heap.empty() && m_thread_count > 1)
+    {
+      m_wake.notify_one();
+    }
+
+    lock.unlock();
+    callback();
+    lock.lock();
+
+    // m_entries may have grown while unlocked
+    entry & ran = m_entries[index];
+    ran.running = false;
+    if (ran.period > clock::duration::zero() && !ran.cancelled && !m_stopping)
+    {
+      ran.callback = std::move(callback);
+      ran.deadline += ran.period;
+      const clock::time_point now = clock::now();
+      if (ran.deadline < now)
+      {
+        ran.deadline += ((now - ran.deadline) / ran.period + 1) * ran.period;
+      }
+      ran.due      = round_up(ran.deadline);
+      ran.sequence = m_sequence++;
+      heap_push(index);
+    }
+    else
+    {
+      const bool waited = ran.cancelled;
+      release(index);
+      if (waited)
+      {
+        m_done.notify_all();
+      }
+    }
+  }
+}
+
+// ============================================================================
+// Implementation - 4-ary heap
+// ============================================================================
+
+inline bool timer_service::earlier(std::uint32_t a, std::uint32_t b) const noexcept
+{
+  const entry & first  = m_entries[a];
+  const entry & second = m_entries[b];
+  return first.due < second.due || (first.due == second.due && first.sequence < second.sequence);
+}
+
+inline void timer_service::place(std::size_t position, std::uint32_t index) noexcept
+{
+  m_heap[position]            = index;
+  m_entries[index].heap_index = position;
+}
+
+inline void timer_service::sift_up(std::size_t position) noexcept
+{
+  const std::uint32_t index = m_heap[position];
+  while (position > 0)
+  {
+    const std::size_t parent = (position - 1) / ARITY;
+    if (!earlier(index, m_heap[parent]))
+    {
+      break;
+    }
+    place(position, m_heap[parent]);
+    position = parent;
+  }
+  place(position, index);
+}
+
+inline void timer_service::sift_down(std::size_t position) noexcept
+{
+  const std::uint32_t index = m_heap[position];
+  const std::size_t count   = m_heap.size();
+  while (true)
+  {
+    const std::size_t first = position * ARITY + 1;
+    if (first >= count)
+    {
+      break;
+    }
+
+    std::size_t best       = first;
+    const std::size_t last = (std::min)(first + ARITY, count);
+    for (std::size_t child = first + 1; child < last; ++child)
+    {
+      if (earlier(m_heap[child], m_heap[best]))
+      {
+        best = child;
+      }
+    }
+    if (!earlier(m_heap[best], index))
+    {
+      break;
+    }
+    place(position, m_heap[best]);
+    position = best;
+  }
+  place(position, index);
+}
+
+inline void timer_service::heap_push(std::uint32_t index)
+{
+  m_heap.push_back(index);
+  sift_up(m_heap.size() - 1);
+}
+
+inline void timer_service::heap_erase(std::size_t position) noexcept
+{
+  m_entries[m_heap[position]].heap_index = npos;
+  const std::uint32_t last               = m_heap.back();
+  m_heap.pop_back();
+  if (position < m_heap.size())
+  {
+    place(position, last);
+    sift_down(position);
+    sift_up(m_entries[last].heap_index);
+  }
+}
+
+} // namespace fb
@@ -0,0 +1,164 @@
+/// @file arena.cpp
+/// @brief Chunk management of monotonic_arena
+
+#include "fb/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace fb
+{
+
+namespace
+{
+
+char* align_up(char* pointer, std::size_t alignment) noexcept
+{
+  const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+  return pointer + ((alignment - address % alignment) % alignment);
+}
+
+} // namespace
+
+monotonic_arena::monotonic_arena(std::size_t chunk_size, std::pmr::memory_resource* upstream)
+    : m_upstream(upstream)
+    , m_next_chunk_size(std::max(chunk_size, 2 * HEADER_SIZE))
+{
+}
+
+monotonic_arena::monotonic_arena(void* buffer, std::size_t size, std::pmr::memory_resource* upstream)
+    : monotonic_arena(DEFAULT_CHUNK_SIZE, upstream)
+{
+  char* const       start  = static_cast<char*>(buffer);
+  char* const       header = align_up(start, alignof(chunk));
+  const std::size_t skip   = static_cast<std::size_t>(header - start);
+  if (buffer != nullptr && size > skip && size - skip > HEADER_SIZE)
+  {
+    m_first = ::new (header) chunk{nullptr, size - skip, false};
+    enter(m_first);
+  }
+}
+
+monotonic_arena::~monotonic_arena()
+{
+  release();
+}
+
+void monotonic_arena::reset() noexcept
+{
+  m_used = 0;
+  if (m_first != nullptr)
+  {
+    enter(m_first);
+  }
+}
+
+void monotonic_arena::release() noexcept
+{
+  chunk* region = m_first;
+  m_first       = nullptr;
+  while (region != nullptr)
+  {
+    chunk* const next = region->next;
+    if (region->owned)
+    {
+      m_upstream->deallocate(region, region->size, alignof(std::max_align_t));
+    }
+    else
+    {
+      // Only the caller buffer is not owned, and it always comes first
+      region->next = nullptr;
+      m_first      = region;
+    }
+    region = next;
+  }
+
+  m_current  = nullptr;
+  m_cursor   = nullptr;
+  m_end      = nullptr;
+  m_used     = 0;
+  m_reserved = 0;
+  reset();
+}
+
+// ============================================================================
+// Protected Methods
+// ============================================================================
+
+void* monotonic_arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+  if (m_current != nullptr)
+  {
+    char* const aligned = align_up(m_cursor, alignment);
+    if (aligned <= m_end && bytes <= static_cast<std::size_t>(m_end - aligned))
+    {
+      m_cursor = aligned + bytes;
+      m_used += bytes;
+      return aligned;
+    }
+  }
+  return allocate_slow(bytes, alignment);
+}
+
+void monotonic_arena::do_deallocate(void* /*memory*/, std::size_t /*bytes*/, std::size_t /*alignment*/)
+{
+}
+
+bool monotonic_arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+  return this == &other;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void* monotonic_arena::allocate_slow(std::size_t bytes, std::size_t alignment)
+{
+  // Chunks kept by reset() come first
+  chunk* next = m_current != nullptr ? m_current->next : m_first;
+  while (next != nullptr)
+  {
+    enter(next);
+    char* const aligned = align_up(m_cursor, alignment);
+    if (aligned <= m_end && bytes <= static_cast<std::size_t>(m_end - aligned))
+    {
+      m_cursor = aligned + bytes;
+      m_used += bytes;
+      return aligned;
+    }
+    next = m_current->next;
+  }
+
+  // A new chunk, after the current one; a request larger than the chunk size gets its own
+  const std::size_t size   = std::max(m_next_chunk_size, HEADER_SIZE + bytes + alignment);
+  void* const       memory = m_upstream->allocate(size, alignof(std::max_align_t));
+  chunk* const      region = ::new (memory) chunk{nullptr, size, true};
+  if (m_current != nullptr)
+  {
+    region->next    = m_current->next;
+    m_current->next = region;
+  }
+  else
+  {
+    m_first = region;
+  }
+  m_reserved += size;
+  m_next_chunk_size = std::min(m_next_chunk_size * 2, std::max(MAX_CHUNK_SIZE, m_next_chunk_size));
+
+  enter(region);
+  char* const aligned = align_up(m_cursor, alignment);
+  m_cursor            = aligned + bytes;
+  m_used += bytes;
+  return aligned;
+}
+
+void monotonic_arena::enter(chunk* region) noexcept
+{
+  m_current = region;
+  m_cursor  = reinterpret_cast<char*>(region) + HEADER_SIZE;
+  m_end     = reinterpret_cast<char*>(region) + region->size;
+}
+
+} // namespace fb
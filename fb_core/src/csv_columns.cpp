@@ -0,0 +1,524 @@
+/// @file csv_columns.cpp
+/// @brief Implementation of schema-driven columnar CSV loading
+
+#include "fb/csv_columns.h"
+
+#include "fb/csv_reader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+
+namespace fb
+{
+
+namespace
+{
+
+constexpr std::int64_t NANOS_PER_SECOND = 1'000'000'000;
+constexpr std::int64_t SECONDS_PER_DAY  = 86'400;
+constexpr int          MAX_SCALE        = 18;
+
+const char* type_name(csv_column_type type) noexcept
+{
+  switch (type)
+  {
+  case csv_column_type::int64:
+    return "int64";
+  case csv_column_type::float64:
+    return "float64";
+  case csv_column_type::decimal:
+    return "decimal";
+  case csv_column_type::dictionary:
+    return "dictionary";
+  case csv_column_type::timestamp:
+    return "timestamp";
+  }
+  return "unknown";
+}
+
+// ============================================================================
+// Number Conversions
+// ============================================================================
+
+/// Skip a leading '+', which std::from_chars does not take, but not "+-"
+bool skip_plus(const char*& first, const char* last) noexcept
+{
+  if (first != last && *first == '+')
+  {
+    ++first;
+    return first == last || *first != '-';
+  }
+  return true;
+}
+
+bool parse_int64(std::string_view cell, std::int64_t& value) noexcept
+{
+  const char* first = cell.data();
+  const char* last  = first + cell.size();
+  if (!skip_plus(first, last))
+  {
+    return false;
+  }
+  const auto [ptr, ec] = std::from_chars(first, last, value);
+  return ec == std::errc() && ptr == last;
+}
+
+bool parse_float64(std::string_view cell, double& value) noexcept
+{
+  const char* first = cell.data();
+  const char* last  = first + cell.size();
+  if (!skip_plus(first, last))
+  {
+    return false;
+  }
+  const auto [ptr, ec] = std::from_chars(first, last, value, std::chars_format::general);
+  return ec == std::errc() && ptr == last;
+}
+
+/// Append @p digit to @p magnitude, false past @p limit
+bool push_digit(std::uint64_t& magnitude, unsigned digit, std::uint64_t limit) noexcept
+{
+  if (magnitude > (limit - digit) / 10)
+  {
+    return false;
+  }
+  magnitude = magnitude * 10 + digit;
+  return true;
+}
+
+/// "[+-]digits[.digits]" as an integer count of 10^-scale, exactly
+bool parse_decimal(std::string_view cell, int scale, std::int64_t& value) noexcept
+{
+  std::size_t i        = 0;
+  const bool  negative = !cell.empty() && cell[0] == '-';
+  if (!cell.empty() && (cell[0] == '-' || cell[0] == '+'))
+  {
+    ++i;
+  }
+
+  const std::uint64_t limit =
+      static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + (negative ? 1u : 0u);
+  std::uint64_t magnitude = 0;
+  std::size_t   digits    = 0;
+  int           fraction  = -1; // Digits after the point, once seen
+  for (; i < cell.size(); ++i)
+  {
+    const char ch = cell[i];
+    if (ch == '.' && fraction < 0)
+    {
+      fraction = 0;
+      continue;
+    }
+    if (ch < '0' || ch > '9')
+    {
+      return false;
+    }
+    ++digits;
+    if (fraction == scale)
+    {
+      // Only trailing zeros may go past the scale
+      if (ch != '0')
+      {
+        return false;
+      }
+      continue;
+    }
+    if (fraction >= 0)
+    {
+      ++fraction;
+    }
+    if (!push_digit(magnitude, static_cast<unsigned>(ch - '0'), limit))
+    {
+      return false;
+    }
+  }
+  if (digits == 0)
+  {
+    return false;
+  }
+  for (int k = std::max(fraction, 0); k < scale; ++k)
+  {
+    if (!push_digit(magnitude, 0, limit))
+    {
+      return false;
+    }
+  }
+
+  value = negative && magnitude > 0 ? -static_cast<std::int64_t>(magnitude - 1) - 1
+                                    : static_cast<std::int64_t>(magnitude);
+  return true;
+}
+
+// ============================================================================
+// Timestamp Conversion
+// ============================================================================
+
+/// @p count digits at @p pos of @p text
+bool parse_digits(std::string_view text, std::size_t pos, std::size_t count, int& value) noexcept
+{
+  if (pos + count > text.size())
+  {
+    return false;
+  }
+  value = 0;
+  for (std::size_t k = pos; k < pos + count; ++k)
+  {
+    if (text[k] < '0' || text[k] > '9')
+    {
+      return false;
+    }
+    value = value * 10 + (text[k] - '0');
+  }
+  return true;
+}
+
+bool is_leap_year(int year) noexcept
+{
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int days_in_month(int year, int month) noexcept
+{
+  constexpr int DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && is_leap_year(year) ? 29 : DAYS[month - 1];
+}
+
+/// Days from 1970-01-01 to a proleptic Gregorian date (H. Hinnant's algorithm)
+std::int64_t days_from_civil(int year, int month, int day) noexcept
+{
+  year -= month <= 2 ? 1 : 0;
+  const int era         = (year >= 0 ? year : year - 399) / 400;
+  const int year_of_era = year - era * 400;
+  const int day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const int day_of_era  = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return std::int64_t{era} * 146'097 + day_of_era - 719'468;
+}
+
+/// "HH:MM" at @p pos as seconds
+bool parse_hours_minutes(std::string_view text, std::size_t pos, std::int64_t& seconds) noexcept
+{
+  int hour   = 0;
+  int minute = 0;
+  if (!parse_digits(text, pos, 2, hour) || pos + 2 >= text.size() || text[pos + 2] != ':' ||
+      !parse_digits(text, pos + 3, 2, minute) || hour > 23 || minute > 59)
+  {
+    return false;
+  }
+  seconds = std::int64_t{hour} * 3600 + minute * 60;
+  return true;
+}
+
+/// "YYYY-MM-DD[(T| )HH:MM:SS[.fraction][Z|(+|-)HH:MM]]" as UTC nanoseconds
+bool parse_timestamp(std::string_view cell, std::int64_t& nanoseconds) noexcept
+{
+  int year  = 0;
+  int month = 0;
+  int day   = 0;
+  if (!parse_digits(cell, 0, 4, year) || cell.size() < 10 || cell[4] != '-' || !parse_digits(cell, 5, 2, month) ||
+      cell[7] != '-' || !parse_digits(cell, 8, 2, day) || month < 1 || month > 12 || day < 1 ||
+      day > days_in_month(year, month))
+  {
+    return false;
+  }
+
+  std::int64_t seconds  = days_from_civil(year, month, day) * SECONDS_PER_DAY;
+  std::int64_t fraction = 0;
+  std::size_t  i        = 10;
+  if (i < cell.size() && (cell[i] == 'T' || cell[i] == ' '))
+  {
+    std::int64_t hours_minutes = 0;
+    int          second        = 0;
+    if (!parse_hours_minutes(cell, i + 1, hours_minutes) || i + 6 >= cell.size() || cell[i + 6] != ':' ||
+        !parse_digits(cell, i + 7, 2, second) || second > 59)
+    {
+      return false;
+    }
+    seconds += hours_minutes + second;
+    i += 9;
+
+    if (i < cell.size() && cell[i] == '.')
+    {
+      std::int64_t unit  = NANOS_PER_SECOND;
+      const auto   first = ++i;
+      while (i < cell.size() && cell[i] >= '0' && cell[i] <= '9')
+      {
+        if (unit == 1)
+        {
+          return false; // Finer than nanoseconds
+        }
+        unit /= 10;
+        fraction += (cell[i] - '0') * unit;
+        ++i;
+      }
+      if (i == first)
+      {
+        return false;
+      }
+    }
+
+    if (i < cell.size() && cell[i] == 'Z')
+    {
+      ++i;
+    }
+    else if (i < cell.size() && (cell[i] == '+' || cell[i] == '-'))
+    {
+      std::int64_t offset = 0;
+      if (!parse_hours_minutes(cell, i + 1, offset))
+      {
+        return false;
+      }
+      seconds -= cell[i] == '+' ? offset : -offset;
+      i += 6;
+    }
+  }
+  if (i != cell.size())
+  {
+    return false;
+  }
+
+  // About 1677-09-21 to 2262-04-11
+  constexpr std::int64_t max_seconds = std::numeric_limits<std::int64_t>::max() / NANOS_PER_SECOND - 1;
+  if (seconds > max_seconds || seconds < -max_seconds)
+  {
+    return false;
+  }
+  nanoseconds = seconds * NANOS_PER_SECOND + fraction;
+  return true;
+}
+
+} // namespace
+
+// ============================================================================
+// Constructors
+// ============================================================================
+
+csv_columns::csv_columns(const std::filesystem::path& filepath, csv_schema schema, const csv_config& config)
+    : m_schema(std::move(schema))
+{
+  csv_reader reader(filepath, config);
+  load(reader, filepath.string());
+}
+
+csv_columns::csv_columns(std::istream& stream, csv_schema schema, const csv_config& config)
+    : m_schema(std::move(schema))
+{
+  csv_reader reader(stream, config);
+  load(reader, "<stream>");
+}
+
+// ============================================================================
+// Column Access
+// ============================================================================
+
+csv_columns::size_type csv_columns::column_index(std::string_view name) const
+{
+  for (size_type i = 0; i < m_schema.size(); ++i)
+  {
+    if (m_schema[i].name == name)
+    {
+      return i;
+    }
+  }
+  throw std::invalid_argument("csv_columns: column \"" + std::string(name) + "\" not in schema");
+}
+
+span<const std::int64_t> csv_columns::int64s(size_type column) const
+{
+  return typed(column, csv_column_type::int64).integers;
+}
+
+span<const std::int64_t> csv_columns::int64s(std::string_view name) const
+{
+  return int64s(column_index(name));
+}
+
+span<const double> csv_columns::doubles(size_type column) const
+{
+  return typed(column, csv_column_type::float64).doubles;
+}
+
+span<const double> csv_columns::doubles(std::string_view name) const
+{
+  return doubles(column_index(name));
+}
+
+span<const std::int64_t> csv_columns::decimals(size_type column) const
+{
+  return typed(column, csv_column_type::decimal).integers;
+}
+
+span<const std::int64_t> csv_columns::decimals(std::string_view name) const
+{
+  return decimals(column_index(name));
+}
+
+span<const std::int64_t> csv_columns::timestamps(size_type column) const
+{
+  return typed(column, csv_column_type::timestamp).integers;
+}
+
+span<const std::int64_t> csv_columns::timestamps(std::string_view name) const
+{
+  return timestamps(column_index(name));
+}
+
+span<const std::uint32_t> csv_columns::codes(size_type column) const
+{
+  return typed(column, csv_column_type::dictionary).codes;
+}
+
+span<const std::uint32_t> csv_columns::codes(std::string_view name) const
+{
+  return codes(column_index(name));
+}
+
+const std::vector<std::string>& csv_columns::dictionary(size_type column) const
+{
+  return typed(column, csv_column_type::dictionary).values;
+}
+
+const std::vector<std::string>& csv_columns::dictionary(std::string_view name) const
+{
+  return dictionary(column_index(name));
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void csv_columns::load(csv_reader& reader, const std::string& source_name)
+{
+  m_columns.resize(m_schema.size());
+  for (size_type i = 0; i < m_schema.size(); ++i)
+  {
+    const csv_column_spec& spec = m_schema[i];
+    if (spec.type == csv_column_type::decimal && (spec.scale < 0 || spec.scale > MAX_SCALE))
+    {
+      throw std::invalid_argument("csv_columns: scale " + std::to_string(spec.scale) + " of decimal column \"" +
+                                  spec.name + "\" not in 0 to " + std::to_string(MAX_SCALE));
+    }
+    for (size_type j = 0; j < i; ++j)
+    {
+      if (m_schema[j].name == spec.name)
+      {
+        throw std::invalid_argument("csv_columns: duplicate column \"" + spec.name + "\" in schema");
+      }
+    }
+    m_columns[i].source = i;
+  }
+
+  if (reader.config().has_headers)
+  {
+    const std::vector<std::string>& headers = reader.get_headers();
+    if (headers.empty())
+    {
+      // No header row, so no rows at all
+      return;
+    }
+    for (size_type i = 0; i < m_schema.size(); ++i)
+    {
+      const auto it = std::find(headers.begin(), headers.end(), m_schema[i].name);
+      if (it == headers.end())
+      {
+        throw std::invalid_argument("csv_columns: column \"" + m_schema[i].name + "\" not found in " +
+                                    source_name);
+      }
+      m_columns[i].source = static_cast<size_type>(it - headers.begin());
+    }
+  }
+
+  while (reader.read_row())
+  {
+    const csv_reader::row_type& row = reader.row();
+    for (size_type i = 0; i < m_columns.size(); ++i)
+    {
+      const size_type source = m_columns[i].source;
+      append(i, source < row.size() ? row[source] : std::string_view(), reader.line_number(), source_name);
+    }
+    ++m_row_count;
+  }
+}
+
+void csv_columns::append(size_type index, std::string_view cell, size_type line_number,
+                         const std::string& source_name)
+{
+  const csv_column_spec& spec   = m_schema[index];
+  column_data&           column = m_columns[index];
+
+  bool valid = true;
+  switch (spec.type)
+  {
+  case csv_column_type::int64:
+  {
+    std::int64_t value = 0;
+    valid              = parse_int64(cell, value);
+    column.integers.push_back(value);
+    break;
+  }
+  case csv_column_type::float64:
+  {
+    double value = 0.0;
+    valid        = parse_float64(cell, value);
+    column.doubles.push_back(value);
+    break;
+  }
+  case csv_column_type::decimal:
+  {
+    std::int64_t value = 0;
+    valid              = parse_decimal(cell, spec.scale, value);
+    column.integers.push_back(value);
+    break;
+  }
+  case csv_column_type::timestamp:
+  {
+    std::int64_t value = 0;
+    valid              = parse_timestamp(cell, value);
+    column.integers.push_back(value);
+    break;
+  }
+  case csv_column_type::dictionary:
+  {
+    m_key.assign(cell.data(), cell.size());
+    auto it = column.lookup.find(m_key);
+    if (it == column.lookup.end())
+    {
+      if (column.values.size() > std::numeric_limits<std::uint32_t>::max())
+      {
+        throw std::runtime_error("csv_columns: more than 2^32 distinct values in column \"" + spec.name +
+                                 "\" in " + source_name);
+      }
+      it = column.lookup.emplace(m_key, static_cast<std::uint32_t>(column.values.size())).first;
+      column.values.push_back(m_key);
+    }
+    column.codes.push_back(it->second);
+    break;
+  }
+  }
+
+  if (!valid)
+  {
+    throw std::runtime_error("csv_columns: invalid " + std::string(type_name(spec.type)) + " \"" +
+                             std::string(cell) + "\" in column \"" + spec.name + "\" at line " +
+                             std::to_string(line_number) + " in " + source_name);
+  }
+}
+
+const csv_columns::column_data& csv_columns::typed(size_type column, csv_column_type type) const
+{
+  if (column >= m_columns.size())
+  {
+    throw std::out_of_range("csv_columns: column index " + std::to_string(column) +
+                            " out of range (column_count=" + std::to_string(m_columns.size()) + ")");
+  }
+  if (m_schema[column].type != type)
+  {
+    throw std::invalid_argument("csv_columns: column \"" + m_schema[column].name + "\" is " +
+                                type_name(m_schema[column].type) + ", not " + type_name(type));
+  }
+  return m_columns[column];
+}
+
+} // namespace fb
@@ -3,12 +3,39 @@
 
 #include "fb/csv_parser.h"
 
+#include "fb/csv_writer.h"
+#include "fb/profiler.h"
+#include "fb/string_utils.h"
+
+#include <fb/detail/csv_scan.h>
+#include <fb/detail/csv_utf8.h>
+
 #include <algorithm>
 #include <cctype>
+#include <optional>
 
 namespace fb
 {
 
+namespace
+{
+
+/// @brief Store @p parsed in @p value, or throw naming the cell
+template <typename T>
+void store_converted(const std::optional<T>& parsed, T& value, const char* type, std::string_view cell,
+                     std::size_t row, std::size_t col, const std::string& source_name)
+{
+  if (!parsed)
+  {
+    throw std::runtime_error("csv_parser: invalid " + std::string(type) + " \"" + std::string(cell) +
+                             "\" in row " + std::to_string(row) + ", column " + std::to_string(col) + " in " +
+                             source_name);
+  }
+  value = *parsed;
+}
+
+} // namespace
+
 // ============================================================================
 // Constructors
 // ============================================================================
@@ -149,6 +176,45 @@ std::vector<std::string> csv_parser::get_headers() const
   return m_headers;
 }
 
+// ============================================================================
+// Column Handles and Row Views
+// ============================================================================
+
+csv_parser::column_ref csv_parser::column(const std::string& header_name) const
+{
+  return column_ref(column_index_for_header(header_name));
+}
+
+csv_parser::column_ref csv_parser::column(size_type col_index) const
+{
+  if (col_index >= m_column_count)
+  {
+    throw std::out_of_range("csv_parser::column: column index " + std::to_string(col_index) +
+                            " out of range (column_count=" + std::to_string(m_column_count) + ")");
+  }
+  return column_ref(col_index);
+}
+
+csv_parser::row_view csv_parser::row(size_type row_index) const
+{
+  if (row_index >= m_data.size())
+  {
+    throw std::out_of_range("csv_parser::row: row index " + std::to_string(row_index) +
+                            " out of range (row_count=" + std::to_string(m_data.size()) + ")");
+  }
+  return row_view(this, &m_data[row_index], row_index);
+}
+
+std::string_view csv_parser::cell(size_type row, column_ref col) const
+{
+  if (row >= m_data.size())
+  {
+    throw std::out_of_range("csv_parser::cell: row index " + std::to_string(row) +
+                            " out of range (row_count=" + std::to_string(m_data.size()) + ")");
+  }
+  return row_view(this, &m_data[row], row)[col];
+}
+
 // ============================================================================
 // Iterator Support
 // ============================================================================
@@ -186,17 +252,21 @@ std::string csv_parser::to_rfc_4180() const
 
 void csv_parser::write_rfc_4180(std::ostream& out) const
 {
+  // RFC 4180 output is comma-delimited whatever the input was
+  csv_writer writer(out, csv_config{});
+
   // Write headers if enabled and present
   if (m_config.has_headers && !m_headers.empty())
   {
-    write_row(out, m_headers);
+    writer.write_row(m_headers);
   }
 
   // Write data rows
   for (const auto& row : m_data)
   {
-    write_row(out, row);
+    writer.write_row(row);
   }
+  writer.flush();
 }
 
 const csv_config& csv_parser::config() const noexcept
@@ -210,7 +280,18 @@ const csv_config& csv_parser::config() const noexcept
 
 void csv_parser::parse(std::istream& stream)
 {
-  detect_and_skip_bom(stream);
+  FB_PROFILE_ZONE("csv_parser::parse");
+
+  // Read everything first: the rows are kept in memory anyway, and a buffer
+  // lets plain fields be found a 64-byte block at a time
+  std::string text;
+  char        chunk[64 * 1024];
+  while (stream.read(chunk, sizeof(chunk)) || stream.gcount() > 0)
+  {
+    text.append(chunk, static_cast<std::size_t>(stream.gcount()));
+  }
+
+  detail::csv_structural_scanner scanner(text, m_config.delimiter);
 
   parse_state  state             = parse_state::field_start;
   size_type    line_number       = 1;
@@ -218,9 +299,34 @@ void csv_parser::parse(std::istream& stream)
   row_type     current_row;
   std::string  current_field;
 
-  char ch;
-  while (stream.get(ch))
+  // UTF-8 BOM: 0xEF 0xBB 0xBF
+  std::size_t i = text.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+  while (i < text.size())
   {
+    if (state == parse_state::field_start)
+    {
+      // Jump over a plain field in one block scan, to the state the byte
+      // rules would reach at its end: no quotes at all, or quoted with no
+      // escapes and the separator right after the closing quote
+      const detail::csv_field_scan scan = scanner.scan_field(i);
+      if (scan.end > i && scan.quotes == 0)
+      {
+        current_field.assign(text, i, scan.end - i);
+        state = parse_state::unquoted_field;
+        i     = scan.end;
+        continue;
+      }
+      if (scan.quotes == 2 && text[i] == '"' && text[scan.end - 1] == '"')
+      {
+        current_field.assign(text, i + 1, scan.end - i - 2);
+        line_number += scan.line_feeds;
+        state = parse_state::after_quote;
+        i     = scan.end;
+        continue;
+      }
+    }
+
+    const char ch = text[i++];
     switch (state)
     {
     case parse_state::field_start:
@@ -239,9 +345,9 @@ void csv_parser::parse(std::istream& stream)
       else if (ch == '\r')
       {
         // Handle CRLF - peek for LF
-        if (stream.peek() == '\n')
+        if (i < text.size() && text[i] == '\n')
         {
-          stream.get();
+          ++i;
         }
         // Empty field at end of row
         current_row.push_back(apply_trimming(current_field));
@@ -283,9 +389,9 @@ void csv_parser::parse(std::istream& stream)
       }
       else if (ch == '\r')
       {
-        if (stream.peek() == '\n')
+        if (i < text.size() && text[i] == '\n')
         {
-          stream.get();
+          ++i;
         }
         current_row.push_back(apply_trimming(current_field));
         current_field.clear();
@@ -338,9 +444,9 @@ void csv_parser::parse(std::istream& stream)
       }
       else if (ch == '\r')
       {
-        if (stream.peek() == '\n')
+        if (i < text.size() && text[i] == '\n')
         {
-          stream.get();
+          ++i;
         }
         current_row.push_back(current_field);
         current_field.clear();
@@ -414,68 +520,18 @@ void csv_parser::parse(std::istream& stream)
   }
 }
 
-void csv_parser::detect_and_skip_bom(std::istream& stream)
-{
-  // UTF-8 BOM: 0xEF 0xBB 0xBF
-  unsigned char bom[3];
-  auto bytes_read = stream.read(reinterpret_cast<char*>(bom), 3).gcount();
-
-  if (bytes_read == 3 && bom[0] == 0xEF && bom[1] == 0xBB && bom[2] == 0xBF)
-  {
-    // BOM detected and consumed - nothing more to do
-    return;
-  }
-
-  // Not a BOM - seek back to start
-  stream.clear();
-  stream.seekg(0);
-}
-
 void csv_parser::validate_utf8_string(const std::string& str, size_type line_number) const
 {
-  for (size_t i = 0; i < str.size();)
+  switch (detail::check_utf8(str))
   {
-    auto c = static_cast<unsigned char>(str[i]);
-    size_t expected_continuation = 0;
-
-    if ((c & 0x80) == 0)
-    {
-      // ASCII: 0xxxxxxx
-      ++i;
-      continue;
-    }
-    else if ((c & 0xE0) == 0xC0)
-    {
-      // 2-byte: 110xxxxx
-      expected_continuation = 1;
-    }
-    else if ((c & 0xF0) == 0xE0)
-    {
-      // 3-byte: 1110xxxx
-      expected_continuation = 2;
-    }
-    else if ((c & 0xF8) == 0xF0)
-    {
-      // 4-byte: 11110xxx
-      expected_continuation = 3;
-    }
-    else
-    {
-      throw std::runtime_error("csv_parser: invalid UTF-8 sequence at line " +
-                               std::to_string(line_number) + " in " + m_source_name);
-    }
-
-    // Validate continuation bytes
-    for (size_t j = 1; j <= expected_continuation; ++j)
-    {
-      if (i + j >= str.size() ||
-          (static_cast<unsigned char>(str[i + j]) & 0xC0) != 0x80)
-      {
-        throw std::runtime_error("csv_parser: invalid UTF-8 continuation at line " +
-                                 std::to_string(line_number) + " in " + m_source_name);
-      }
-    }
-    i += 1 + expected_continuation;
+  case detail::utf8_error::none:
+    return;
+  case detail::utf8_error::invalid_sequence:
+    throw std::runtime_error("csv_parser: invalid UTF-8 sequence at line " +
+                             std::to_string(line_number) + " in " + m_source_name);
+  case detail::utf8_error::invalid_continuation:
+    throw std::runtime_error("csv_parser: invalid UTF-8 continuation at line " +
+                             std::to_string(line_number) + " in " + m_source_name);
   }
 }
 
@@ -592,74 +648,56 @@ std::string csv_parser::apply_trimming(const std::string& field) const
   return std::string(start, end_it);
 }
 
-bool csv_parser::needs_quoting(const std::string& field) const
+csv_parser::size_type csv_parser::column_index_for_header(const std::string& header_name) const
 {
-  for (char ch : field)
+  if (!m_config.has_headers)
   {
-    if (ch == ',' || ch == '"' || ch == '\r' || ch == '\n')
-    {
-      return true;
-    }
+    throw std::invalid_argument("csv_parser: headers not enabled");
   }
-  return false;
-}
 
-std::string csv_parser::quote_field(const std::string& field) const
-{
-  std::string result;
-  result.reserve(field.size() + 2);
-  result += '"';
-  for (char ch : field)
+  auto it = m_header_index.find(header_name);
+  if (it == m_header_index.end())
   {
-    if (ch == '"')
-    {
-      result += "\"\"";
-    }
-    else
-    {
-      result += ch;
-    }
+    throw std::invalid_argument("csv_parser: header \"" + header_name + "\" not found");
   }
-  result += '"';
-  return result;
+
+  return it->second;
 }
 
-void csv_parser::write_row(std::ostream& out, const row_type& row) const
+void csv_parser::convert_cell(std::string_view cell, int& value, size_type row, size_type col) const
 {
-  for (size_type i = 0; i < row.size(); ++i)
-  {
-    if (i > 0)
-    {
-      out << ',';
-    }
+  store_converted(to_int(cell), value, "int", cell, row, col, m_source_name);
+}
 
-    const auto& field = row[i];
-    if (needs_quoting(field))
-    {
-      out << quote_field(field);
-    }
-    else
-    {
-      out << field;
-    }
-  }
-  out << "\r\n"; // RFC 4180 mandates CRLF
+void csv_parser::convert_cell(std::string_view cell, long& value, size_type row, size_type col) const
+{
+  store_converted(to_long(cell), value, "long", cell, row, col, m_source_name);
 }
 
-csv_parser::size_type csv_parser::column_index_for_header(const std::string& header_name) const
+void csv_parser::convert_cell(std::string_view cell, long long& value, size_type row, size_type col) const
 {
-  if (!m_config.has_headers)
-  {
-    throw std::invalid_argument("csv_parser: headers not enabled");
-  }
+  store_converted(to_llong(cell), value, "long long", cell, row, col, m_source_name);
+}
 
-  auto it = m_header_index.find(header_name);
-  if (it == m_header_index.end())
-  {
-    throw std::invalid_argument("csv_parser: header \"" + header_name + "\" not found");
-  }
+void csv_parser::convert_cell(std::string_view cell, unsigned long& value, size_type row, size_type col) const
+{
+  store_converted(to_ulong(cell), value, "unsigned long", cell, row, col, m_source_name);
+}
 
-  return it->second;
+void csv_parser::convert_cell(std::string_view cell, unsigned long long& value, size_type row,
+                              size_type col) const
+{
+  store_converted(to_ullong(cell), value, "unsigned long long", cell, row, col, m_source_name);
+}
+
+void csv_parser::convert_cell(std::string_view cell, float& value, size_type row, size_type col) const
+{
+  store_converted(to_float(cell), value, "float", cell, row, col, m_source_name);
+}
+
+void csv_parser::convert_cell(std::string_view cell, double& value, size_type row, size_type col) const
+{
+  store_converted(to_double(cell), value, "double", cell, row, col, m_source_name);
 }
 
 } // namespace fb
@@ -0,0 +1,435 @@
+/// @file csv_reader.cpp
+/// @brief Implementation of the streaming CSV reader
+
+#include "fb/csv_reader.h"
+
+#include <fb/detail/csv_utf8.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+bool is_space(char ch) noexcept
+{
+  return std::isspace(static_cast<unsigned char>(ch)) != 0;
+}
+
+} // namespace
+
+// ============================================================================
+// Constructors
+// ============================================================================
+
+csv_reader::csv_reader(std::istream& stream, const csv_config& config, std::size_t buffer_size)
+    : csv_reader(&stream, nullptr, config, buffer_size, "<stream>")
+{
+}
+
+csv_reader::csv_reader(const std::filesystem::path& filepath, const csv_config& config, std::size_t buffer_size)
+    : csv_reader(nullptr, std::make_unique<std::ifstream>(filepath, std::ios::binary), config, buffer_size,
+                 filepath.string())
+{
+}
+
+csv_reader::csv_reader(std::istream* stream, std::unique_ptr<std::ifstream> file, const csv_config& config,
+                       std::size_t buffer_size, std::string source_name)
+    : m_config(config)
+    , m_file(std::move(file))
+    , m_stream(m_file ? m_file.get() : stream)
+    , m_source_name(std::move(source_name))
+    , m_buffer(std::max<std::size_t>(buffer_size, 4))
+    , m_window(std::max<std::size_t>(buffer_size, 4))
+{
+  m_stops[static_cast<unsigned char>(m_config.delimiter)] = true;
+  m_stops['"']                                            = true;
+  m_stops['\r']                                           = true;
+  m_stops['\n']                                           = true;
+
+  if (m_file && !m_file->is_open())
+  {
+    throw std::runtime_error("csv_reader: cannot open file \"" + m_source_name + "\"");
+  }
+
+  if (m_config.has_headers && next_row())
+  {
+    m_headers.assign(m_row.begin(), m_row.end());
+    m_column_count = m_headers.size();
+    m_row.clear();
+    for (size_type i = 0; i < m_headers.size(); ++i)
+    {
+      auto [it, inserted] = m_header_index.emplace(m_headers[i], i);
+      if (!inserted)
+      {
+        throw std::invalid_argument("csv_reader: duplicate header \"" + m_headers[i] + "\" in " +
+                                    m_source_name);
+      }
+    }
+  }
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+bool csv_reader::read_row()
+{
+  if (!next_row())
+  {
+    m_row.clear();
+    return false;
+  }
+
+  const size_type count = m_row.size();
+  if (m_column_count == 0)
+  {
+    // First data row determines column count when no headers
+    m_column_count = count;
+  }
+
+  if (m_config.strict_mode && count != m_column_count)
+  {
+    throw std::runtime_error("csv_reader: inconsistent field count at line " + std::to_string(m_row_line) +
+                             " (expected " + std::to_string(m_column_count) + ", got " + std::to_string(count) +
+                             ") in " + m_source_name);
+  }
+
+  // In non-strict mode, update column count if this row has more fields
+  m_column_count = std::max(m_column_count, count);
+  ++m_rows_read;
+  return true;
+}
+
+csv_reader::size_type csv_reader::column_index(std::string_view header_name) const
+{
+  if (!m_config.has_headers)
+  {
+    throw std::invalid_argument("csv_reader: headers not enabled");
+  }
+
+  auto it = m_header_index.find(header_name);
+  if (it == m_header_index.end())
+  {
+    throw std::invalid_argument("csv_reader: header \"" + std::string(header_name) + "\" not found");
+  }
+  return it->second;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+bool csv_reader::fill()
+{
+  if (m_eof)
+  {
+    return false;
+  }
+
+  // The unconsumed bytes, which start the row being parsed, stay where they
+  // are: the ring keeps them contiguous with the bytes read after them
+  if (m_buffer.size() == m_window)
+  {
+    // One row fills the whole window
+    m_window *= 2;
+    m_buffer.reserve(m_window);
+  }
+
+  m_stream->read(m_buffer.write_data(), static_cast<std::streamsize>(m_window - m_buffer.size()));
+  const auto count = static_cast<std::size_t>(m_stream->gcount());
+  if (m_stream->bad())
+  {
+    throw std::runtime_error("csv_reader: read error in " + m_source_name);
+  }
+  m_buffer.commit_back(count);
+  if (count == 0 || m_stream->eof())
+  {
+    m_eof = true;
+  }
+  return count != 0;
+}
+
+bool csv_reader::next_row()
+{
+  for (;;)
+  {
+    if (!m_bom_checked)
+    {
+      // UTF-8 BOM: 0xEF 0xBB 0xBF
+      while (m_buffer.size() < 3 && fill())
+      {
+      }
+      if (m_buffer.size() >= 3 && std::memcmp(m_buffer.data(), "\xEF\xBB\xBF", 3) == 0)
+      {
+        m_buffer.pop_front_n(3);
+      }
+      m_bom_checked = true;
+    }
+
+    if (m_buffer.empty() && !fill())
+    {
+      return false;
+    }
+
+    std::size_t row_size = 0;
+    size_type   lines    = 0;
+    if (!parse_row(row_size, lines))
+    {
+      // The row continues past the buffered bytes; parse it again after the read
+      fill();
+      continue;
+    }
+
+    const char* row_start = m_buffer.data();
+    m_row_line            = m_line_number + lines;
+    m_buffer.pop_front_n(row_size);
+    m_line_number = m_row_line + 1;
+    if (finalize_row(row_start))
+    {
+      return true;
+    }
+  }
+}
+
+bool csv_reader::parse_row(std::size_t& row_size, size_type& lines)
+{
+  // The rules of csv_view::parse() for one row, giving up when the bytes
+  // run out before the row ends
+  const char* const text      = m_buffer.data();
+  const std::size_t size      = m_buffer.size();
+  const bool        eof       = m_eof;
+  const char        delimiter = m_config.delimiter;
+
+  m_fields.clear();
+  m_unescaped.clear();
+  lines = 0;
+
+  auto is_field_end = [&](std::size_t pos) {
+    return pos == size || text[pos] == delimiter || text[pos] == '\r' || text[pos] == '\n';
+  };
+
+  auto push_field = [&](std::size_t begin, std::size_t end, bool escaped, bool trim) {
+    const char* base = escaped ? m_unescaped.data() : text;
+    if (trim && m_config.trim_whitespace)
+    {
+      while (begin < end && is_space(base[begin]))
+      {
+        ++begin;
+      }
+      while (end > begin && is_space(base[end - 1]))
+      {
+        --end;
+      }
+    }
+    m_fields.push_back({begin, end - begin, escaped});
+  };
+
+  auto unescape = [&](std::size_t begin, std::size_t end) {
+    m_unescaped.insert(m_unescaped.end(), text + begin, text + end);
+  };
+
+  std::size_t i = 0;
+  for (;;)
+  {
+    if (i == size && !eof)
+    {
+      return false;
+    }
+
+    if (i < size && text[i] == '"')
+    {
+      const size_type field_start_line = m_line_number + lines;
+      std::size_t     segment          = ++i;
+      std::size_t     escaped_begin    = std::string_view::npos; // Start in m_unescaped once copying
+
+      for (;;)
+      {
+        const void* quote = std::memchr(text + i, '"', size - i);
+        if (quote == nullptr)
+        {
+          if (!eof)
+          {
+            return false;
+          }
+          throw std::runtime_error("csv_reader: unclosed quoted field starting at line " +
+                                   std::to_string(field_start_line) + " in " + m_source_name);
+        }
+        const auto close = static_cast<std::size_t>(static_cast<const char*>(quote) - text);
+        lines += static_cast<size_type>(std::count(text + i, text + close, '\n'));
+        i = close + 1;
+
+        // After the closing quote
+        if (!m_config.strict_mode)
+        {
+          while (!is_field_end(i) && text[i] != '"' && is_space(text[i]))
+          {
+            ++i;
+          }
+        }
+        if (i == size && !eof)
+        {
+          // A quote at the end of the bytes may be the first of an escaped pair
+          return false;
+        }
+
+        if (i < size && text[i] == '"')
+        {
+          // Escaped quote: keep one and continue the quoted field
+          if (escaped_begin == std::string_view::npos)
+          {
+            escaped_begin = m_unescaped.size();
+          }
+          unescape(segment, close + 1);
+          segment = ++i;
+          continue;
+        }
+
+        if (is_field_end(i))
+        {
+          if (escaped_begin == std::string_view::npos)
+          {
+            push_field(segment, close, false, false);
+          }
+          else
+          {
+            unescape(segment, close);
+            push_field(escaped_begin, m_unescaped.size(), true, false);
+          }
+          break;
+        }
+
+        if (m_config.strict_mode)
+        {
+          throw std::runtime_error("csv_reader: invalid character after closing quote at line " +
+                                   std::to_string(m_line_number + lines) + " in " + m_source_name);
+        }
+
+        // Non-strict: text after the closing quote continues the field
+        // unquoted, and the whole field is trimmed like an unquoted one
+        if (escaped_begin == std::string_view::npos)
+        {
+          escaped_begin = m_unescaped.size();
+        }
+        unescape(segment, close);
+        const std::size_t rest = i;
+        while (!is_field_end(i))
+        {
+          ++i;
+        }
+        if (i == size && !eof)
+        {
+          return false;
+        }
+        unescape(rest, i);
+        push_field(escaped_begin, m_unescaped.size(), true, true);
+        break;
+      }
+    }
+    else
+    {
+      const std::size_t begin = i;
+      for (;;)
+      {
+        while (i < size && !m_stops[static_cast<unsigned char>(text[i])])
+        {
+          ++i;
+        }
+        if (i == size || text[i] != '"')
+        {
+          break;
+        }
+        if (m_config.strict_mode)
+        {
+          throw std::runtime_error("csv_reader: quote in unquoted field at line " +
+                                   std::to_string(m_line_number + lines) + " in " + m_source_name);
+        }
+        // Non-strict mode: treat quote as literal character
+        ++i;
+      }
+      if (i == size && !eof)
+      {
+        return false;
+      }
+      push_field(begin, i, false, true);
+    }
+
+    if (i < size && text[i] == delimiter)
+    {
+      // A delimiter at EOF still ends in an empty last field
+      ++i;
+      continue;
+    }
+    break;
+  }
+
+  // Consume the line ending
+  if (i < size)
+  {
+    if (text[i] == '\r')
+    {
+      if (i + 1 == size && !eof)
+      {
+        // The \n of a \r\n may not be read yet
+        return false;
+      }
+      if (i + 1 < size && text[i + 1] == '\n')
+      {
+        ++i;
+      }
+    }
+    ++i;
+  }
+
+  row_size = i;
+  return true;
+}
+
+bool csv_reader::finalize_row(const char* row_start)
+{
+  m_row.clear();
+  for (const field_ref& field : m_fields)
+  {
+    m_row.emplace_back((field.escaped ? m_unescaped.data() : row_start) + field.offset, field.size);
+  }
+
+  // Validate UTF-8 if configured
+  if (m_config.validate_utf8)
+  {
+    for (std::string_view field : m_row)
+    {
+      switch (detail::check_utf8(field))
+      {
+      case detail::utf8_error::none:
+        break;
+      case detail::utf8_error::invalid_sequence:
+        throw std::runtime_error("csv_reader: invalid UTF-8 sequence at line " + std::to_string(m_row_line) +
+                                 " in " + m_source_name);
+      case detail::utf8_error::invalid_continuation:
+        throw std::runtime_error("csv_reader: invalid UTF-8 continuation at line " +
+                                 std::to_string(m_row_line) + " in " + m_source_name);
+      }
+    }
+  }
+
+  // Check for single empty field row
+  if (m_row.size() == 1 && m_row[0].empty())
+  {
+    if (m_config.strict_mode)
+    {
+      throw std::runtime_error("csv_reader: empty row at line " + std::to_string(m_row_line) + " in " +
+                               m_source_name);
+    }
+    // In non-strict mode, skip rows that are just empty
+    return false;
+  }
+  return true;
+}
+
+} // namespace fb
@@ -0,0 +1,337 @@
+/// @file csv_scan.cpp
+/// @brief SSE2, AVX2, NEON and scalar block classification for the CSV parsers
+
+#include <fb/detail/csv_scan.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FB_CSV_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) && defined(__x86_64__)
+// GCC and Clang compile the AVX2 and carry-less multiply kernels per
+// function and check the CPU at run time; other compilers keep to SSE2
+#define FB_CSV_AVX2 1
+#define FB_TARGET_PCLMUL __attribute__((target("pclmul")))
+#define FB_TARGET_AVX2_PCLMUL __attribute__((target("avx2,pclmul")))
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FB_CSV_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace fb::detail
+{
+
+namespace
+{
+
+constexpr std::size_t BLOCK = 64;
+
+using classify_fn = csv_block_masks (*)(const char* block, char delimiter);
+
+unsigned trailing_zeros(std::uint64_t mask) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index = 0;
+  _BitScanForward64(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+std::size_t popcount(std::uint64_t mask) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  return static_cast<std::size_t>(__popcnt64(mask));
+#else
+  return static_cast<std::size_t>(__builtin_popcountll(mask));
+#endif
+}
+
+/// Bit i set to the XOR of bits 0 to i: 1 from an opening quote up to,
+/// not including, its closing quote
+std::uint64_t prefix_xor(std::uint64_t bits) noexcept
+{
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+// ============================================================================
+// Scalar Kernel
+// ============================================================================
+
+[[maybe_unused]] csv_block_masks classify_scalar(const char* block, char delimiter)
+{
+  csv_block_masks masks{};
+  for (unsigned k = 0; k < BLOCK; ++k)
+  {
+    const char ch = block[k];
+    masks.quote |= std::uint64_t{ch == '"'} << k;
+    masks.separator |= std::uint64_t{ch == delimiter || ch == '\r' || ch == '\n'} << k;
+    masks.line_feed |= std::uint64_t{ch == '\n'} << k;
+  }
+  masks.inside = prefix_xor(masks.quote);
+  return masks;
+}
+
+// ============================================================================
+// SSE2 Kernels
+// ============================================================================
+
+#if FB_CSV_SSE2
+
+inline csv_block_masks classify_bytes_sse2(const char* block, char delimiter)
+{
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i delim = _mm_set1_epi8(delimiter);
+  const __m128i cr    = _mm_set1_epi8('\r');
+  const __m128i lf    = _mm_set1_epi8('\n');
+
+  csv_block_masks masks{};
+  for (unsigned k = 0; k < BLOCK / 16; ++k)
+  {
+    const __m128i bytes     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * k));
+    const __m128i line_feed = _mm_cmpeq_epi8(bytes, lf);
+    const __m128i separator =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, delim), _mm_cmpeq_epi8(bytes, cr)), line_feed);
+    const unsigned shift = 16 * k;
+    masks.quote |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)))}
+                   << shift;
+    masks.separator |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(separator))} << shift;
+    masks.line_feed |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(line_feed))} << shift;
+  }
+  return masks;
+}
+
+csv_block_masks classify_sse2(const char* block, char delimiter)
+{
+  csv_block_masks masks = classify_bytes_sse2(block, delimiter);
+  masks.inside          = prefix_xor(masks.quote);
+  return masks;
+}
+
+#endif // FB_CSV_SSE2
+
+// ============================================================================
+// AVX2 and Carry-Less Multiply Kernels
+// ============================================================================
+
+#if FB_CSV_AVX2
+
+/// prefix_xor() as one multiply by all ones without carries
+FB_TARGET_PCLMUL inline std::uint64_t prefix_xor_clmul(std::uint64_t bits)
+{
+  const __m128i product =
+      _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<long long>(bits)), _mm_set1_epi8(-1), 0);
+  return static_cast<std::uint64_t>(_mm_cvtsi128_si64(product));
+}
+
+FB_TARGET_PCLMUL csv_block_masks classify_sse2_clmul(const char* block, char delimiter)
+{
+  csv_block_masks masks = classify_bytes_sse2(block, delimiter);
+  masks.inside          = prefix_xor_clmul(masks.quote);
+  return masks;
+}
+
+FB_TARGET_AVX2_PCLMUL csv_block_masks classify_avx2(const char* block, char delimiter)
+{
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i delim = _mm256_set1_epi8(delimiter);
+  const __m256i cr    = _mm256_set1_epi8('\r');
+  const __m256i lf    = _mm256_set1_epi8('\n');
+
+  csv_block_masks masks{};
+  for (unsigned k = 0; k < BLOCK / 32; ++k)
+  {
+    const __m256i bytes     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * k));
+    const __m256i line_feed = _mm256_cmpeq_epi8(bytes, lf);
+    const __m256i separator =
+        _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, delim), _mm256_cmpeq_epi8(bytes, cr)), line_feed);
+    const unsigned shift = 32 * k;
+    masks.quote |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote)))}
+                   << shift;
+    masks.separator |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(separator))} << shift;
+    masks.line_feed |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(line_feed))} << shift;
+  }
+  masks.inside = prefix_xor_clmul(masks.quote);
+  return masks;
+}
+
+#endif // FB_CSV_AVX2
+
+// ============================================================================
+// NEON Kernel
+// ============================================================================
+
+#if FB_CSV_NEON
+
+alignas(16) constexpr std::uint8_t BIT_WEIGHTS[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+
+/// One bit per byte of four comparison results, @p q0 in the low bits
+std::uint64_t bitmask_neon(uint8x16_t q0, uint8x16_t q1, uint8x16_t q2, uint8x16_t q3) noexcept
+{
+  // Pairwise adds of the weighted bytes gather each 8 bytes into one
+  const uint8x16_t weights = vld1q_u8(BIT_WEIGHTS);
+  uint8x16_t       sum01   = vpaddq_u8(vandq_u8(q0, weights), vandq_u8(q1, weights));
+  uint8x16_t       sum23   = vpaddq_u8(vandq_u8(q2, weights), vandq_u8(q3, weights));
+  uint8x16_t       sum     = vpaddq_u8(sum01, sum23);
+  sum                      = vpaddq_u8(sum, sum);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+
+csv_block_masks classify_neon(const char* block, char delimiter)
+{
+  const uint8x16_t delim = vdupq_n_u8(static_cast<std::uint8_t>(delimiter));
+  uint8x16_t       quote[4];
+  uint8x16_t       separator[4];
+  uint8x16_t       line_feed[4];
+  for (unsigned k = 0; k < 4; ++k)
+  {
+    const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block + 16 * k));
+    quote[k]               = vceqq_u8(bytes, vdupq_n_u8('"'));
+    line_feed[k]           = vceqq_u8(bytes, vdupq_n_u8('\n'));
+    separator[k] = vorrq_u8(vorrq_u8(vceqq_u8(bytes, delim), vceqq_u8(bytes, vdupq_n_u8('\r'))), line_feed[k]);
+  }
+
+  csv_block_masks masks{bitmask_neon(quote[0], quote[1], quote[2], quote[3]),
+                        bitmask_neon(separator[0], separator[1], separator[2], separator[3]),
+                        bitmask_neon(line_feed[0], line_feed[1], line_feed[2], line_feed[3]), 0};
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+  masks.inside = vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64(masks.quote, ~std::uint64_t{0})), 0);
+#else
+  masks.inside = prefix_xor(masks.quote);
+#endif
+  return masks;
+}
+
+#endif // FB_CSV_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+classify_fn best_classify() noexcept
+{
+#if FB_CSV_AVX2
+  if (__builtin_cpu_supports("pclmul"))
+  {
+    return __builtin_cpu_supports("avx2") ? classify_avx2 : classify_sse2_clmul;
+  }
+#endif
+#if FB_CSV_SSE2
+  return classify_sse2;
+#elif FB_CSV_NEON
+  return classify_neon;
+#else
+  return classify_scalar;
+#endif
+}
+
+/// Classify the block at @p block, padding it when fewer than 64 of
+/// @p available bytes are left with a byte that is neither a quote nor a
+/// separator
+csv_block_masks classify_block(const char* block, std::size_t available, char delimiter) noexcept
+{
+  static const classify_fn classify = best_classify();
+
+  if (available >= BLOCK)
+  {
+    return classify(block, delimiter);
+  }
+  char padded[BLOCK];
+  std::memset(padded, delimiter == ' ' ? '_' : ' ', BLOCK);
+  std::memcpy(padded, block, available);
+  return classify(padded, delimiter);
+}
+
+} // namespace
+
+// ============================================================================
+// find_csv_special
+// ============================================================================
+
+std::size_t find_csv_special(std::string_view text, char delimiter) noexcept
+{
+  for (std::size_t base = 0; base < text.size(); base += BLOCK)
+  {
+    const csv_block_masks masks   = classify_block(text.data() + base, text.size() - base, delimiter);
+    const std::uint64_t   special = masks.quote | masks.separator;
+    if (special != 0)
+    {
+      return base + trailing_zeros(special);
+    }
+  }
+  return text.size();
+}
+
+// ============================================================================
+// csv_structural_scanner
+// ============================================================================
+
+void csv_structural_scanner::load(std::size_t base) noexcept
+{
+  m_base  = base;
+  m_masks = classify_block(m_text.data() + base, m_text.size() - base, m_delimiter);
+}
+
+csv_field_scan csv_structural_scanner::scan_field(std::size_t start) noexcept
+{
+  const std::size_t size = m_text.size();
+  if (start >= size)
+  {
+    return {size, 0, 0};
+  }
+  if (m_base == std::string_view::npos || start < m_base || start - m_base >= BLOCK)
+  {
+    load(start);
+  }
+
+  // The block's inside mask assumes it starts outside quotes; the quotes
+  // between its start and the field start flip it
+  const auto    shift = static_cast<unsigned>(start - m_base);
+  std::uint64_t keep  = ~std::uint64_t{0} << shift;
+  std::uint64_t flip  = shift > 0 && ((m_masks.inside >> (shift - 1)) & 1) != 0 ? ~std::uint64_t{0} : 0;
+
+  std::size_t quotes     = 0;
+  std::size_t line_feeds = 0;
+  for (;;)
+  {
+    const std::uint64_t inside = m_masks.inside ^ flip;
+    const std::uint64_t ends   = m_masks.separator & keep & ~inside;
+    if (ends != 0)
+    {
+      const unsigned      bit   = trailing_zeros(ends);
+      const std::uint64_t field = keep & ((std::uint64_t{1} << bit) - 1);
+      quotes += popcount(m_masks.quote & field);
+      line_feeds += popcount(m_masks.line_feed & field);
+      return {m_base + bit, quotes, line_feeds};
+    }
+
+    quotes += popcount(m_masks.quote & keep);
+    line_feeds += popcount(m_masks.line_feed & keep);
+    if (size - m_base <= BLOCK)
+    {
+      return {size, quotes, line_feeds};
+    }
+
+    // Carry the quote state into the next block
+    flip = (inside >> 63) != 0 ? ~std::uint64_t{0} : 0;
+    keep = ~std::uint64_t{0};
+    load(m_base + BLOCK);
+  }
+}
+
+} // namespace fb::detail
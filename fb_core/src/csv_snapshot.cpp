@@ -0,0 +1,408 @@
+/// @file csv_snapshot.cpp
+/// @brief Writing, checking and mapping CSV snapshot files
+
+#include "fb/csv_snapshot.h"
+
+#include "fb/profiler.h"
+#include "fb/string_hash.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace fb
+{
+
+namespace
+{
+
+constexpr char          SNAPSHOT_MAGIC[8] = {'F', 'B', 'C', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t BYTE_ORDER_MARK   = 0x01020304;
+
+constexpr std::uint32_t FLAG_HAS_HEADERS     = 1u << 0;
+constexpr std::uint32_t FLAG_TRIM_WHITESPACE = 1u << 1;
+constexpr std::uint32_t FLAG_STRICT_MODE     = 1u << 2;
+constexpr std::uint32_t FLAG_VALIDATE_UTF8   = 1u << 3;
+
+/// @brief First bytes of a snapshot file; the payload follows
+struct file_header
+{
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t flags;
+  std::uint32_t delimiter;
+  std::uint64_t source_size;
+  std::int64_t  source_mtime;
+  std::uint64_t header_count; ///< Fields of the header row
+  std::uint64_t row_count;
+  std::uint64_t column_count;
+  std::uint64_t field_count; ///< Header and data fields
+  std::uint64_t text_size;
+  std::uint32_t payload_crc; ///< CRC-32 of everything after the header
+  std::uint32_t header_crc;  ///< CRC-32 of the header up to this member
+};
+
+static_assert(sizeof(file_header) % alignof(std::uint64_t) == 0, "payload must start 8-byte aligned");
+
+std::uint32_t config_flags(const csv_config& config) noexcept
+{
+  return (config.has_headers ? FLAG_HAS_HEADERS : 0) | (config.trim_whitespace ? FLAG_TRIM_WHITESPACE : 0) |
+         (config.strict_mode ? FLAG_STRICT_MODE : 0) | (config.validate_utf8 ? FLAG_VALIDATE_UTF8 : 0);
+}
+
+std::uint32_t header_checksum(const file_header& header) noexcept
+{
+  return crc32(&header, offsetof(file_header, header_crc));
+}
+
+template <typename T>
+void write_array(std::ofstream& out, const std::vector<T>& values)
+{
+  out.write(reinterpret_cast<const char*>(values.data()),
+            static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+} // namespace
+
+// ============================================================================
+// source_stamp
+// ============================================================================
+
+csv_snapshot::source_stamp csv_snapshot::source_stamp::of(const std::filesystem::path& filepath)
+{
+  const auto modified = std::filesystem::last_write_time(filepath);
+  return {static_cast<std::uint64_t>(std::filesystem::file_size(filepath)),
+          static_cast<std::int64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(modified.time_since_epoch()).count())};
+}
+
+// ============================================================================
+// Writing and Loading
+// ============================================================================
+
+void csv_snapshot::write(const csv_parser& table, const std::filesystem::path& snapshot_path,
+                         const source_stamp& source)
+{
+  FB_PROFILE_ZONE("csv_snapshot::write");
+
+  const std::vector<std::string> headers = table.get_headers();
+
+  std::vector<std::uint64_t> row_bounds;
+  std::vector<std::uint64_t> offsets;
+  row_bounds.reserve(table.row_count() + 1);
+  offsets.reserve(headers.size() + table.row_count() * table.column_count() + 1);
+
+  std::uint64_t text_size = 0;
+  offsets.push_back(0);
+  for (const auto& header : headers)
+  {
+    text_size += header.size();
+    offsets.push_back(text_size);
+  }
+  for (const auto& row : table)
+  {
+    row_bounds.push_back(offsets.size() - 1);
+    for (const auto& field : row)
+    {
+      text_size += field.size();
+      offsets.push_back(text_size);
+    }
+  }
+  row_bounds.push_back(offsets.size() - 1);
+
+  file_header header{};
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version      = FORMAT_VERSION;
+  header.byte_order   = BYTE_ORDER_MARK;
+  header.flags        = config_flags(table.config());
+  header.delimiter    = static_cast<unsigned char>(table.config().delimiter);
+  header.source_size  = source.size;
+  header.source_mtime = source.mtime;
+  header.header_count = headers.size();
+  header.row_count    = table.row_count();
+  header.column_count = table.column_count();
+  header.field_count  = offsets.size() - 1;
+  header.text_size    = text_size;
+
+  std::uint32_t crc = crc32_update(0, row_bounds.data(), row_bounds.size() * sizeof(std::uint64_t));
+  crc               = crc32_update(crc, offsets.data(), offsets.size() * sizeof(std::uint64_t));
+  for (const auto& field : headers)
+  {
+    crc = crc32_update(crc, field);
+  }
+  for (const auto& row : table)
+  {
+    for (const auto& field : row)
+    {
+      crc = crc32_update(crc, field);
+    }
+  }
+  header.payload_crc = crc;
+  header.header_crc  = header_checksum(header);
+
+  std::filesystem::path temporary = snapshot_path;
+  temporary += ".tmp";
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+      throw std::runtime_error("csv_snapshot: cannot create file \"" + temporary.string() + "\"");
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_array(out, row_bounds);
+    write_array(out, offsets);
+    for (const auto& field : headers)
+    {
+      out.write(field.data(), static_cast<std::streamsize>(field.size()));
+    }
+    for (const auto& row : table)
+    {
+      for (const auto& field : row)
+      {
+        out.write(field.data(), static_cast<std::streamsize>(field.size()));
+      }
+    }
+    out.close();
+    if (!out)
+    {
+      std::error_code ignored;
+      std::filesystem::remove(temporary, ignored);
+      throw std::runtime_error("csv_snapshot: cannot write file \"" + temporary.string() + "\"");
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary, snapshot_path, error);
+  if (error)
+  {
+    std::error_code ignored;
+    std::filesystem::remove(temporary, ignored);
+    throw std::runtime_error("csv_snapshot: cannot replace file \"" + snapshot_path.string() +
+                             "\": " + error.message());
+  }
+}
+
+void csv_snapshot::write(const csv_parser& table, const std::filesystem::path& snapshot_path)
+{
+  write(table, snapshot_path, source_stamp{});
+}
+
+csv_snapshot::csv_snapshot(const std::filesystem::path& snapshot_path, bool verify_checksum)
+    : m_source_name(snapshot_path.string())
+{
+  try
+  {
+    m_file = mapped_file(snapshot_path);
+  }
+  catch (const std::system_error&)
+  {
+    throw std::runtime_error("csv_snapshot: cannot open file \"" + m_source_name + "\"");
+  }
+  open(verify_checksum);
+}
+
+csv_snapshot csv_snapshot::load_or_build(const std::filesystem::path& csv_path,
+                                         const std::filesystem::path& snapshot_path, const csv_config& config)
+{
+  source_stamp stamp;
+  try
+  {
+    stamp = source_stamp::of(csv_path);
+  }
+  catch (const std::filesystem::filesystem_error&)
+  {
+    throw std::runtime_error("csv_snapshot: cannot open file \"" + csv_path.string() + "\"");
+  }
+
+  try
+  {
+    csv_snapshot cached(snapshot_path);
+    if (cached.matches(stamp, config))
+    {
+      return cached;
+    }
+  }
+  catch (const std::runtime_error&)
+  {
+    // Missing, damaged, truncated or of another version: parse again and replace it
+  }
+
+  write(csv_parser(csv_path, config), snapshot_path, stamp);
+  return csv_snapshot(snapshot_path, false);
+}
+
+bool csv_snapshot::matches(const source_stamp& source, const csv_config& config) const noexcept
+{
+  return m_source == source && config_flags(m_config) == config_flags(config) &&
+         m_config.delimiter == config.delimiter;
+}
+
+// ============================================================================
+// Data Access Methods
+// ============================================================================
+
+csv_parser::row_type csv_snapshot::row_view::to_strings() const
+{
+  return csv_parser::row_type(begin(), end());
+}
+
+csv_snapshot::row_view csv_snapshot::get_row(size_type row_index) const
+{
+  if (row_index >= m_row_count)
+  {
+    throw std::out_of_range("csv_snapshot::get_row: row index " + std::to_string(row_index) +
+                            " out of range (row_count=" + std::to_string(m_row_count) + ")");
+  }
+  return row_at(row_index);
+}
+
+std::vector<std::string_view> csv_snapshot::get_column(size_type col_index) const
+{
+  if (col_index >= m_column_count)
+  {
+    throw std::out_of_range("csv_snapshot::get_column: column index " + std::to_string(col_index) +
+                            " out of range (column_count=" + std::to_string(m_column_count) + ")");
+  }
+
+  std::vector<std::string_view> result;
+  result.reserve(m_row_count);
+  for (size_type row = 0; row < m_row_count; ++row)
+  {
+    result.push_back(row_at(row)[col_index]);
+  }
+  return result;
+}
+
+std::vector<std::string_view> csv_snapshot::get_column(std::string_view header_name) const
+{
+  return get_column(column_index_for_header(header_name));
+}
+
+std::string_view csv_snapshot::get_cell(size_type row, size_type col) const
+{
+  if (row >= m_row_count)
+  {
+    throw std::out_of_range("csv_snapshot::get_cell: row index " + std::to_string(row) +
+                            " out of range (row_count=" + std::to_string(m_row_count) + ")");
+  }
+  if (col >= m_column_count)
+  {
+    throw std::out_of_range("csv_snapshot::get_cell: column index " + std::to_string(col) +
+                            " out of range (column_count=" + std::to_string(m_column_count) + ")");
+  }
+  return row_at(row)[col];
+}
+
+std::string_view csv_snapshot::get_cell(size_type row, std::string_view col_header) const
+{
+  return get_cell(row, column_index_for_header(col_header));
+}
+
+std::vector<std::string_view> csv_snapshot::get_headers() const
+{
+  const row_view header_row(m_text, m_offsets, m_header_count);
+  return std::vector<std::string_view>(header_row.begin(), header_row.end());
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void csv_snapshot::open(bool verify_checksum)
+{
+  FB_PROFILE_ZONE("csv_snapshot::open");
+
+  const auto fail = [this](const char* reason) {
+    throw std::runtime_error(std::string("csv_snapshot: ") + reason + " in " + m_source_name);
+  };
+
+  file_header header;
+  if (m_file.size() < sizeof(header))
+  {
+    fail("file too small for a snapshot header");
+  }
+  std::memcpy(&header, m_file.data(), sizeof(header));
+  if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0)
+  {
+    fail("not a snapshot file");
+  }
+  if (header.byte_order != BYTE_ORDER_MARK)
+  {
+    fail("snapshot written with another byte order");
+  }
+  if (header.version != FORMAT_VERSION)
+  {
+    throw std::runtime_error("csv_snapshot: format version " + std::to_string(header.version) +
+                             " is not supported (expected " + std::to_string(FORMAT_VERSION) + ") in " +
+                             m_source_name);
+  }
+  if (header.header_crc != header_checksum(header))
+  {
+    fail("header checksum mismatch");
+  }
+
+  // Each count is checked against the file size before it is multiplied, so nothing overflows
+  const std::uint64_t payload_size = m_file.size() - sizeof(header);
+  const std::uint64_t max_entries  = payload_size / sizeof(std::uint64_t);
+  if (header.row_count >= max_entries || header.field_count >= max_entries ||
+      header.row_count + header.field_count + 2 > max_entries || header.header_count > header.field_count ||
+      (header.row_count + header.field_count + 2) * sizeof(std::uint64_t) + header.text_size != payload_size)
+  {
+    fail("snapshot truncated or sizes inconsistent");
+  }
+
+  const char* payload = m_file.data() + sizeof(header);
+  m_row_bounds        = reinterpret_cast<const std::uint64_t*>(payload);
+  m_offsets           = m_row_bounds + header.row_count + 1;
+  m_text              = reinterpret_cast<const char*>(m_offsets + header.field_count + 1);
+  if (m_row_bounds[0] != header.header_count || m_row_bounds[header.row_count] != header.field_count ||
+      m_offsets[0] != 0 || m_offsets[header.field_count] != header.text_size)
+  {
+    fail("snapshot tables inconsistent");
+  }
+  if (verify_checksum && crc32(payload, static_cast<size_type>(payload_size)) != header.payload_crc)
+  {
+    fail("payload checksum mismatch");
+  }
+
+  m_config.has_headers     = (header.flags & FLAG_HAS_HEADERS) != 0;
+  m_config.trim_whitespace = (header.flags & FLAG_TRIM_WHITESPACE) != 0;
+  m_config.strict_mode     = (header.flags & FLAG_STRICT_MODE) != 0;
+  m_config.validate_utf8   = (header.flags & FLAG_VALIDATE_UTF8) != 0;
+  m_config.delimiter       = static_cast<char>(header.delimiter);
+  m_source                 = {header.source_size, header.source_mtime};
+  m_header_count           = static_cast<size_type>(header.header_count);
+  m_row_count              = static_cast<size_type>(header.row_count);
+  m_column_count           = static_cast<size_type>(header.column_count);
+  build_header_index();
+}
+
+void csv_snapshot::build_header_index()
+{
+  const row_view header_row(m_text, m_offsets, m_header_count);
+  for (size_type i = 0; i < m_header_count; ++i)
+  {
+    m_header_index.emplace(header_row[i], i);
+  }
+}
+
+csv_snapshot::size_type csv_snapshot::column_index_for_header(std::string_view header_name) const
+{
+  if (!m_config.has_headers)
+  {
+    throw std::invalid_argument("csv_snapshot: headers not enabled");
+  }
+
+  auto it = m_header_index.find(header_name);
+  if (it == m_header_index.end())
+  {
+    throw std::invalid_argument("csv_snapshot: header \"" + std::string(header_name) + "\" not found");
+  }
+  return it->second;
+}
+
+} // namespace fb
@@ -0,0 +1,728 @@
+/// @file csv_view.cpp
+/// @brief Implementation of the zero-copy CSV reader
+
+#include "fb/csv_view.h"
+
+#include "fb/thread_pool.h"
+
+#include <fb/detail/csv_scan.h>
+#include <fb/detail/csv_utf8.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+bool is_space(char ch) noexcept
+{
+  return std::isspace(static_cast<unsigned char>(ch)) != 0;
+}
+
+/// @brief Call body(0) to body(count - 1) on @p pool and the calling thread
+///
+/// The caller takes items too, so this finishes even when called from a
+/// task of a busy pool. @p body must not throw.
+template <typename Body>
+void run_in_parallel(thread_pool& pool, std::size_t count, const Body& body)
+{
+  struct shared_state
+  {
+    std::atomic<std::size_t> next{0};
+    std::size_t              done = 0;
+    std::mutex               mutex;
+    std::condition_variable  finished;
+  };
+
+  // A helper that starts after every item was taken returns without
+  // touching @p body, which may be gone by then
+  auto work = [count, body = &body](shared_state& state) {
+    std::size_t item;
+    while ((item = state.next.fetch_add(1, std::memory_order_relaxed)) < count)
+    {
+      (*body)(item);
+      std::lock_guard<std::mutex> lock(state.mutex);
+      if (++state.done == count)
+      {
+        state.finished.notify_all();
+      }
+    }
+  };
+
+  auto       state   = std::make_shared<shared_state>();
+  const auto helpers = std::min(pool.size(), count - 1);
+  for (std::size_t i = 0; i < helpers; ++i)
+  {
+    pool.submit([state, work]() { work(*state); });
+  }
+  work(*state);
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->finished.wait(lock, [&]() { return state->done == count; });
+}
+
+} // namespace
+
+// ============================================================================
+// Constructors
+// ============================================================================
+
+csv_view::csv_view(const std::filesystem::path& filepath, const csv_config& config)
+    : csv_view(filepath, config, nullptr, 0)
+{
+}
+
+csv_view::csv_view(const std::filesystem::path& filepath, const csv_config& config, thread_pool& pool,
+                   size_type chunk_size)
+    : csv_view(filepath, config, &pool, chunk_size)
+{
+}
+
+csv_view::csv_view(const std::filesystem::path& filepath, const csv_config& config, thread_pool* pool,
+                   size_type chunk_size)
+    : m_config(config), m_source_name(filepath.string())
+{
+  try
+  {
+    m_file = mapped_file(filepath);
+  }
+  catch (const std::system_error&)
+  {
+    throw std::runtime_error("csv_view: cannot open file \"" + m_source_name + "\"");
+  }
+  m_input = m_file.view();
+  parse(pool, chunk_size);
+}
+
+csv_view::csv_view(std::string_view data, const csv_config& config, std::string source_name, thread_pool* pool,
+                   size_type chunk_size)
+    : m_config(config), m_input(data), m_source_name(std::move(source_name))
+{
+  parse(pool, chunk_size);
+}
+
+csv_view csv_view::from_buffer(std::string_view data, const csv_config& config)
+{
+  return csv_view(data, config, "<buffer>", nullptr, 0);
+}
+
+csv_view csv_view::from_buffer(std::string_view data, const csv_config& config, thread_pool& pool,
+                               size_type chunk_size)
+{
+  return csv_view(data, config, "<buffer>", &pool, chunk_size);
+}
+
+// ============================================================================
+// Data Access Methods
+// ============================================================================
+
+csv_parser::row_type csv_view::row_view::to_strings() const
+{
+  return csv_parser::row_type(begin(), end());
+}
+
+csv_view::row_view csv_view::get_row(size_type row_index) const
+{
+  if (row_index >= row_count())
+  {
+    throw std::out_of_range("csv_view::get_row: row index " + std::to_string(row_index) +
+                            " out of range (row_count=" + std::to_string(row_count()) + ")");
+  }
+  return row_at(row_index);
+}
+
+std::vector<std::string_view> csv_view::get_column(size_type col_index) const
+{
+  if (col_index >= m_column_count)
+  {
+    throw std::out_of_range("csv_view::get_column: column index " + std::to_string(col_index) +
+                            " out of range (column_count=" + std::to_string(m_column_count) + ")");
+  }
+
+  std::vector<std::string_view> result;
+  result.reserve(row_count());
+  for (size_type row = 0; row < row_count(); ++row)
+  {
+    result.push_back(row_at(row)[col_index]);
+  }
+  return result;
+}
+
+std::vector<std::string_view> csv_view::get_column(std::string_view header_name) const
+{
+  return get_column(column_index_for_header(header_name));
+}
+
+std::string_view csv_view::get_cell(size_type row, size_type col) const
+{
+  if (row >= row_count())
+  {
+    throw std::out_of_range("csv_view::get_cell: row index " + std::to_string(row) +
+                            " out of range (row_count=" + std::to_string(row_count()) + ")");
+  }
+  if (col >= m_column_count)
+  {
+    throw std::out_of_range("csv_view::get_cell: column index " + std::to_string(col) +
+                            " out of range (column_count=" + std::to_string(m_column_count) + ")");
+  }
+  return row_at(row)[col];
+}
+
+std::string_view csv_view::get_cell(size_type row, std::string_view col_header) const
+{
+  return get_cell(row, column_index_for_header(col_header));
+}
+
+std::vector<std::string_view> csv_view::get_headers() const
+{
+  std::vector<std::string_view> headers;
+  headers.reserve(m_header_count);
+  for (size_type i = 0; i < m_header_count; ++i)
+  {
+    headers.push_back(resolve(m_fields[i]));
+  }
+  return headers;
+}
+
+// ============================================================================
+// Parsing
+// ============================================================================
+
+struct csv_view::parsed_range
+{
+  std::vector<field_ref> fields;
+  std::vector<size_type> row_bounds{0};
+  std::vector<char>      unescaped;
+  size_type              end{0};          ///< Offset after the last row
+  size_type              header_count{0}; ///< Whole input: fields of the header row
+  size_type              column_count{0}; ///< Whole input: as column_count()
+  size_type              first_fields{0}; ///< Chunk: fields of the first row
+  size_type              min_fields{std::numeric_limits<size_type>::max()}; ///< Chunk: of the other rows
+  size_type              max_fields{0};                                     ///< Chunk: of the other rows
+
+  [[nodiscard]] size_type row_count() const noexcept
+  {
+    return row_bounds.size() - 1;
+  }
+};
+
+void csv_view::parse(thread_pool* pool, size_type chunk_size)
+{
+  size_type begin = 0;
+  if (m_input.size() >= 3 && std::memcmp(m_input.data(), "\xEF\xBB\xBF", 3) == 0)
+  {
+    begin = 3;
+  }
+
+  const bool parallel = pool != nullptr && chunk_size > 0 && m_input.size() - begin > chunk_size;
+  if (!parallel || !parse_parallel(*pool, begin, chunk_size))
+  {
+    parsed_range all;
+    parse_range(begin, m_input.size(), all, true);
+    m_fields       = std::move(all.fields);
+    m_row_bounds   = std::move(all.row_bounds);
+    m_unescaped    = std::move(all.unescaped);
+    m_header_count = all.header_count;
+    m_column_count = all.column_count;
+  }
+
+  if (m_config.has_headers)
+  {
+    build_header_index();
+  }
+}
+
+void csv_view::parse_range(size_type begin, size_type stop, parsed_range& out, bool whole_input) const
+{
+  // Same rules as csv_parser::parse(), over offsets instead of characters
+  // appended to strings: a field is a range of the input unless it holds an
+  // escaped quote, or text after its closing quote in non-strict mode
+  const char* const text      = m_input.data();
+  const std::size_t size      = m_input.size();
+  const char        delimiter = m_config.delimiter;
+
+  // Characters that end an unquoted field
+  std::array<bool, 256> stops{};
+  stops[static_cast<unsigned char>(delimiter)] = true;
+  stops['"']                                   = true;
+  stops['\r']                                  = true;
+  stops['\n']                                  = true;
+
+  auto is_field_end = [&](std::size_t pos) {
+    return pos == size || text[pos] == delimiter || text[pos] == '\r' || text[pos] == '\n';
+  };
+
+  auto push_field = [&](std::size_t first, std::size_t last, bool escaped, bool trim) {
+    const char* base = escaped ? out.unescaped.data() : text;
+    if (trim && m_config.trim_whitespace)
+    {
+      while (first < last && is_space(base[first]))
+      {
+        ++first;
+      }
+      while (last > first && is_space(base[last - 1]))
+      {
+        --last;
+      }
+    }
+    if (last - first > std::numeric_limits<std::uint32_t>::max())
+    {
+      throw std::runtime_error("csv_view: field larger than 4 GiB in " + m_source_name);
+    }
+    out.fields.push_back({first, static_cast<std::uint32_t>(last - first), escaped ? 1u : 0u});
+  };
+
+  auto unescape = [&](std::size_t first, std::size_t last) {
+    out.unescaped.insert(out.unescaped.end(), text + first, text + last);
+  };
+
+  detail::csv_structural_scanner scanner(m_input, delimiter);
+
+  size_type   line_number = 1;
+  size_type   row_first   = out.fields.size();
+  std::size_t i           = begin;
+
+  while (i < stop)
+  {
+    // One row: fields separated by delimiters, up to a line ending or EOF
+    for (;;)
+    {
+      // Plain fields straight from the block scan: no quotes at all, or
+      // quoted with no escapes and the separator right after the quote
+      const detail::csv_field_scan scan = scanner.scan_field(i);
+      if (scan.quotes == 0)
+      {
+        push_field(i, scan.end, false, true);
+        i = scan.end;
+      }
+      else if (scan.quotes == 2 && text[i] == '"' && text[scan.end - 1] == '"')
+      {
+        push_field(i + 1, scan.end - 1, false, false);
+        line_number += scan.line_feeds;
+        i = scan.end;
+      }
+      else if (i < size && text[i] == '"')
+      {
+        const size_type field_start_line = line_number;
+        std::size_t     segment          = ++i;
+        std::size_t     escaped_begin    = std::string_view::npos; // Start in unescaped once copying
+
+        for (;;)
+        {
+          const void* quote = std::memchr(text + i, '"', size - i);
+          if (quote == nullptr)
+          {
+            throw std::runtime_error("csv_view: unclosed quoted field starting at line " +
+                                     std::to_string(field_start_line) + " in " + m_source_name);
+          }
+          const auto close = static_cast<std::size_t>(static_cast<const char*>(quote) - text);
+          line_number += static_cast<size_type>(std::count(text + i, text + close, '\n'));
+          i = close + 1;
+
+          // After the closing quote
+          if (!m_config.strict_mode)
+          {
+            while (!is_field_end(i) && text[i] != '"' && is_space(text[i]))
+            {
+              ++i;
+            }
+          }
+
+          if (i < size && text[i] == '"')
+          {
+            // Escaped quote: keep one and continue the quoted field
+            if (escaped_begin == std::string_view::npos)
+            {
+              escaped_begin = out.unescaped.size();
+            }
+            unescape(segment, close + 1);
+            segment = ++i;
+            continue;
+          }
+
+          if (is_field_end(i))
+          {
+            if (escaped_begin == std::string_view::npos)
+            {
+              push_field(segment, close, false, false);
+            }
+            else
+            {
+              unescape(segment, close);
+              push_field(escaped_begin, out.unescaped.size(), true, false);
+            }
+            break;
+          }
+
+          if (m_config.strict_mode)
+          {
+            throw std::runtime_error("csv_view: invalid character after closing quote at line " +
+                                     std::to_string(line_number) + " in " + m_source_name);
+          }
+
+          // Non-strict: text after the closing quote continues the field
+          // unquoted, and the whole field is trimmed like an unquoted one
+          if (escaped_begin == std::string_view::npos)
+          {
+            escaped_begin = out.unescaped.size();
+          }
+          unescape(segment, close);
+          const std::size_t rest = i;
+          while (!is_field_end(i))
+          {
+            ++i;
+          }
+          unescape(rest, i);
+          push_field(escaped_begin, out.unescaped.size(), true, true);
+          break;
+        }
+      }
+      else
+      {
+        const std::size_t first = i;
+        for (;;)
+        {
+          while (i < size && !stops[static_cast<unsigned char>(text[i])])
+          {
+            ++i;
+          }
+          if (i == size || text[i] != '"')
+          {
+            break;
+          }
+          if (m_config.strict_mode)
+          {
+            throw std::runtime_error("csv_view: quote in unquoted field at line " +
+                                     std::to_string(line_number) + " in " + m_source_name);
+          }
+          // Non-strict mode: treat quote as literal character
+          ++i;
+        }
+        push_field(first, i, false, true);
+      }
+
+      if (i < size && text[i] == delimiter)
+      {
+        // A delimiter at EOF still ends in an empty last field
+        ++i;
+        continue;
+      }
+      break;
+    }
+
+    finalize_row(out, row_first, line_number, whole_input);
+    row_first = out.fields.size();
+
+    if (i < size)
+    {
+      if (text[i] == '\r' && i + 1 < size && text[i + 1] == '\n')
+      {
+        ++i;
+      }
+      ++i;
+      ++line_number;
+    }
+  }
+
+  out.end = i;
+}
+
+void csv_view::finalize_row(parsed_range& out, size_type row_first, size_type line_number, bool whole_input) const
+{
+  const size_type count = out.fields.size() - row_first;
+
+  // Validate UTF-8 if configured
+  if (m_config.validate_utf8)
+  {
+    for (size_type f = row_first; f < out.fields.size(); ++f)
+    {
+      const field_ref& ref = out.fields[f];
+      const char*      base = ref.escaped != 0 ? out.unescaped.data() : m_input.data();
+      switch (detail::check_utf8(std::string_view(base + ref.offset, ref.size)))
+      {
+      case detail::utf8_error::none:
+        break;
+      case detail::utf8_error::invalid_sequence:
+        throw std::runtime_error("csv_view: invalid UTF-8 sequence at line " +
+                                 std::to_string(line_number) + " in " + m_source_name);
+      case detail::utf8_error::invalid_continuation:
+        throw std::runtime_error("csv_view: invalid UTF-8 continuation at line " +
+                                 std::to_string(line_number) + " in " + m_source_name);
+      }
+    }
+  }
+
+  // Check for single empty field row
+  if (count == 1 && out.fields[row_first].size == 0)
+  {
+    if (m_config.strict_mode)
+    {
+      throw std::runtime_error("csv_view: empty row at line " + std::to_string(line_number) + " in " +
+                               m_source_name);
+    }
+    // In non-strict mode, skip rows that are just empty
+    out.fields.resize(row_first);
+    return;
+  }
+
+  if (!whole_input)
+  {
+    // A chunk does not know which row is the header or the expected field
+    // count; parse_parallel() checks these from the counts
+    if (out.row_count() == 0)
+    {
+      out.first_fields = count;
+    }
+    else
+    {
+      out.min_fields = std::min(out.min_fields, count);
+      out.max_fields = std::max(out.max_fields, count);
+    }
+    out.row_bounds.push_back(out.fields.size());
+    return;
+  }
+
+  const bool is_header_row = m_config.has_headers && out.header_count == 0 && out.row_count() == 0;
+  if (is_header_row)
+  {
+    out.header_count  = count;
+    out.column_count  = count;
+    out.row_bounds[0] = out.fields.size();
+    return;
+  }
+
+  // Check row consistency
+  size_type expected_columns = out.column_count;
+  if (expected_columns == 0)
+  {
+    // First data row determines column count when no headers
+    expected_columns = count;
+    out.column_count = expected_columns;
+  }
+
+  if (m_config.strict_mode && count != expected_columns)
+  {
+    throw std::runtime_error("csv_view: inconsistent field count at line " + std::to_string(line_number) +
+                             " (expected " + std::to_string(expected_columns) + ", got " +
+                             std::to_string(count) + ") in " + m_source_name);
+  }
+
+  // In non-strict mode, update column count if this row has more fields
+  out.column_count = std::max(out.column_count, count);
+  out.row_bounds.push_back(out.fields.size());
+}
+
+// ============================================================================
+// Parallel Parsing
+// ============================================================================
+
+csv_view::size_type csv_view::row_start_after(size_type pos, bool in_quotes) const noexcept
+{
+  const char* const text = m_input.data();
+  const size_type   size = m_input.size();
+  for (; pos < size; ++pos)
+  {
+    const char ch = text[pos];
+    if (ch == '"')
+    {
+      in_quotes = !in_quotes;
+    }
+    else if (!in_quotes && (ch == '\n' || ch == '\r'))
+    {
+      return pos + (ch == '\r' && pos + 1 < size && text[pos + 1] == '\n' ? 2 : 1);
+    }
+  }
+  return size;
+}
+
+bool csv_view::parse_parallel(thread_pool& pool, size_type begin, size_type chunk_size)
+{
+  const char* const text   = m_input.data();
+  const size_type   size   = m_input.size();
+  const size_type   chunks = (size - begin + chunk_size - 1) / chunk_size;
+
+  auto cut = [&](size_type chunk) { return std::min(size, begin + chunk * chunk_size); };
+
+  // Pass 1: quotes before each cut. Their parity says whether the cut is
+  // inside a quoted field, as "" escapes count twice.
+  std::vector<size_type> quotes(chunks + 1, 0);
+  run_in_parallel(pool, chunks, [&](size_type chunk) {
+    quotes[chunk + 1] = static_cast<size_type>(std::count(text + cut(chunk), text + cut(chunk + 1), '"'));
+  });
+  for (size_type chunk = 1; chunk <= chunks; ++chunk)
+  {
+    quotes[chunk] += quotes[chunk - 1];
+  }
+
+  // Pass 2: each chunk parses the rows that start between its first row
+  // start and the next chunk's
+  auto row_start = [&](size_type chunk) {
+    if (chunk == 0)
+    {
+      return begin;
+    }
+    if (chunk == chunks)
+    {
+      return size;
+    }
+    return row_start_after(cut(chunk), quotes[chunk] % 2 != 0);
+  };
+
+  std::vector<parsed_range> ranges(chunks);
+  std::atomic<bool>         failed{false};
+  run_in_parallel(pool, chunks, [&](size_type chunk) {
+    try
+    {
+      const size_type stop = row_start(chunk + 1);
+      parse_range(row_start(chunk), stop, ranges[chunk], false);
+      if (ranges[chunk].end != stop)
+      {
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+    catch (...)
+    {
+      // A parse error, or a chunk that started mid-field; the serial parse
+      // reports the error, if any
+      failed.store(true, std::memory_order_relaxed);
+    }
+  });
+  if (failed.load(std::memory_order_relaxed))
+  {
+    return false;
+  }
+
+  // Header and field counts, as finalize_row() checks them on the whole input
+  const parsed_range* header = nullptr;
+  if (m_config.has_headers)
+  {
+    for (const parsed_range& range : ranges)
+    {
+      if (range.row_count() > 0)
+      {
+        header = &range;
+        break;
+      }
+    }
+  }
+
+  size_type expected = header != nullptr ? header->first_fields : 0;
+  size_type widest   = expected;
+  for (const parsed_range& range : ranges)
+  {
+    if (range.row_count() == 0)
+    {
+      continue;
+    }
+    if (&range != header)
+    {
+      if (expected == 0)
+      {
+        expected = range.first_fields;
+      }
+      if (m_config.strict_mode && range.first_fields != expected)
+      {
+        return false;
+      }
+      widest = std::max(widest, range.first_fields);
+    }
+    if (range.row_count() > 1)
+    {
+      if (m_config.strict_mode && (range.min_fields != expected || range.max_fields != expected))
+      {
+        return false;
+      }
+      widest = std::max(widest, range.max_fields);
+    }
+  }
+
+  const size_type header_count = header != nullptr ? header->first_fields : 0;
+
+  // Pass 3: join the chunks. Data rows only: the header's bound becomes
+  // m_row_bounds[0].
+  std::vector<size_type> field_base(chunks + 1, 0);
+  std::vector<size_type> row_base(chunks + 1, 0);
+  std::vector<size_type> unescaped_base(chunks + 1, 0);
+  for (size_type chunk = 0; chunk < chunks; ++chunk)
+  {
+    field_base[chunk + 1]     = field_base[chunk] + ranges[chunk].fields.size();
+    row_base[chunk + 1]       = row_base[chunk] + ranges[chunk].row_count();
+    unescaped_base[chunk + 1] = unescaped_base[chunk] + ranges[chunk].unescaped.size();
+  }
+
+  const size_type skipped = header != nullptr ? 1 : 0;
+  m_fields.resize(field_base[chunks]);
+  m_row_bounds.assign(row_base[chunks] + 1 - skipped, 0);
+  m_unescaped.resize(unescaped_base[chunks]);
+
+  run_in_parallel(pool, chunks, [&](size_type chunk) {
+    parsed_range& range = ranges[chunk];
+
+    field_ref* fields = m_fields.data() + field_base[chunk];
+    for (const field_ref& ref : range.fields)
+    {
+      *fields = ref;
+      if (ref.escaped != 0)
+      {
+        fields->offset += unescaped_base[chunk];
+      }
+      ++fields;
+    }
+
+    // Bound r + 1 of the joined rows ends row r
+    for (size_type row = 1; row <= range.row_count(); ++row)
+    {
+      m_row_bounds[row_base[chunk] + row - skipped] = field_base[chunk] + range.row_bounds[row];
+    }
+
+    std::copy(range.unescaped.begin(), range.unescaped.end(), m_unescaped.begin() +
+              static_cast<std::ptrdiff_t>(unescaped_base[chunk]));
+    range = parsed_range();
+  });
+
+  m_header_count = header_count;
+  m_column_count = m_config.strict_mode ? expected : widest;
+  return true;
+}
+
+void csv_view::build_header_index()
+{
+  for (size_type i = 0; i < m_header_count; ++i)
+  {
+    const std::string_view header = resolve(m_fields[i]);
+    auto [it, inserted]           = m_header_index.emplace(header, i);
+    if (!inserted)
+    {
+      throw std::invalid_argument("csv_view: duplicate header \"" + std::string(header) + "\" in " +
+                                  m_source_name);
+    }
+  }
+}
+
+csv_view::size_type csv_view::column_index_for_header(std::string_view header_name) const
+{
+  if (!m_config.has_headers)
+  {
+    throw std::invalid_argument("csv_view: headers not enabled");
+  }
+
+  auto it = m_header_index.find(header_name);
+  if (it == m_header_index.end())
+  {
+    throw std::invalid_argument("csv_view: header \"" + std::string(header_name) + "\" not found");
+  }
+  return it->second;
+}
+
+} // namespace fb
@@ -0,0 +1,236 @@
+/// @file csv_writer.cpp
+/// @brief Implementation of the buffered CSV writer
+
+#include "fb/csv_writer.h"
+
+#include <fb/detail/csv_scan.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+/// Room for any std::to_chars output of an int64, uint64 or double
+constexpr std::size_t NUMBER_SIZE = 32;
+
+} // namespace
+
+// ============================================================================
+// Constructors
+// ============================================================================
+
+csv_writer::csv_writer(std::ostream& stream, const csv_config& config, std::size_t buffer_size)
+    : csv_writer(&stream, nullptr, config, buffer_size, "<stream>")
+{
+}
+
+csv_writer::csv_writer(const std::filesystem::path& filepath, const csv_config& config, std::size_t buffer_size)
+    : csv_writer(nullptr, std::make_unique<std::ofstream>(filepath, std::ios::binary | std::ios::trunc), config,
+                 buffer_size, filepath.string())
+{
+}
+
+csv_writer::csv_writer(std::ostream* stream, std::unique_ptr<std::ofstream> file, const csv_config& config,
+                       std::size_t buffer_size, std::string target_name)
+    : m_config(config)
+    , m_file(std::move(file))
+    , m_stream(m_file ? m_file.get() : stream)
+    , m_target_name(std::move(target_name))
+    , m_buffer(std::max<std::size_t>(buffer_size, NUMBER_SIZE))
+{
+  if (m_file && !m_file->is_open())
+  {
+    throw std::runtime_error("csv_writer: cannot open file \"" + m_target_name + "\"");
+  }
+
+  // std::to_chars writes digits, signs, a point, an exponent, "inf" and "nan"
+  m_plain_numbers = std::string_view("0123456789+-.einfa").find(m_config.delimiter) == std::string_view::npos;
+}
+
+csv_writer::~csv_writer()
+{
+  try
+  {
+    flush();
+  }
+  catch (const std::exception&)
+  {
+    // Destructors must not throw; flush() reports the error to callers who ask
+  }
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+csv_writer& csv_writer::field(std::string_view value)
+{
+  begin_field();
+  const std::size_t special = detail::find_csv_special(value, m_config.delimiter);
+  if (special == value.size())
+  {
+    put(value.data(), value.size());
+  }
+  else
+  {
+    append_quoted(value, special);
+  }
+  return *this;
+}
+
+csv_writer& csv_writer::field(double value)
+{
+  char       text[NUMBER_SIZE];
+  const auto result = std::to_chars(text, text + NUMBER_SIZE, value);
+  append_number(text, static_cast<std::size_t>(result.ptr - text));
+  return *this;
+}
+
+csv_writer& csv_writer::end_row()
+{
+  put("\r\n", 2); // RFC 4180 mandates CRLF
+  m_row_started = false;
+  ++m_rows_written;
+  return *this;
+}
+
+csv_writer& csv_writer::write_row(const std::vector<std::string>& row)
+{
+  for (const std::string& value : row)
+  {
+    field(value);
+  }
+  return end_row();
+}
+
+csv_writer& csv_writer::write_row(const std::vector<std::string_view>& row)
+{
+  for (std::string_view value : row)
+  {
+    field(value);
+  }
+  return end_row();
+}
+
+void csv_writer::flush()
+{
+  write_buffer();
+  m_stream->flush();
+  if (!*m_stream)
+  {
+    throw std::runtime_error("csv_writer: write error in " + m_target_name);
+  }
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void csv_writer::append_integer(std::int64_t value)
+{
+  char       text[NUMBER_SIZE];
+  const auto result = std::to_chars(text, text + NUMBER_SIZE, value);
+  append_number(text, static_cast<std::size_t>(result.ptr - text));
+}
+
+void csv_writer::append_integer(std::uint64_t value)
+{
+  char       text[NUMBER_SIZE];
+  const auto result = std::to_chars(text, text + NUMBER_SIZE, value);
+  append_number(text, static_cast<std::size_t>(result.ptr - text));
+}
+
+void csv_writer::append_number(const char* text, std::size_t count)
+{
+  if (!m_plain_numbers)
+  {
+    // The delimiter is a character of numbers, such as '.'
+    field(std::string_view(text, count));
+    return;
+  }
+  begin_field();
+  put(text, count);
+}
+
+bool csv_writer::reserve(std::size_t count)
+{
+  if (m_buffer.size() - m_size >= count)
+  {
+    return true;
+  }
+  write_buffer();
+  return count <= m_buffer.size();
+}
+
+void csv_writer::put(const char* data, std::size_t count)
+{
+  if (reserve(count))
+  {
+    std::memcpy(m_buffer.data() + m_size, data, count);
+    m_size += count;
+    return;
+  }
+
+  // Larger than the whole buffer, which reserve() wrote out
+  m_stream->write(data, static_cast<std::streamsize>(count));
+  if (!*m_stream)
+  {
+    throw std::runtime_error("csv_writer: write error in " + m_target_name);
+  }
+  m_flushed_bytes += count;
+}
+
+void csv_writer::write_buffer()
+{
+  if (m_size == 0)
+  {
+    return;
+  }
+  m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_size));
+  if (!*m_stream)
+  {
+    throw std::runtime_error("csv_writer: write error in " + m_target_name);
+  }
+  m_flushed_bytes += m_size;
+  m_size = 0;
+}
+
+void csv_writer::begin_field()
+{
+  if (m_row_started)
+  {
+    put(&m_config.delimiter, 1);
+  }
+  m_row_started = true;
+}
+
+void csv_writer::append_quoted(std::string_view value, std::size_t clean)
+{
+  put("\"", 1);
+  std::size_t begin = 0;
+  std::size_t from  = clean;
+  for (;;)
+  {
+    const void* quote = std::memchr(value.data() + from, '"', value.size() - from);
+    if (quote == nullptr)
+    {
+      put(value.data() + begin, value.size() - begin);
+      break;
+    }
+    // Up to and including the quote, then the quote again
+    const auto end = static_cast<std::size_t>(static_cast<const char*>(quote) - value.data()) + 1;
+    put(value.data() + begin, end - begin);
+    put("\"", 1);
+    begin = from = end;
+  }
+  put("\"", 1);
+}
+
+} // namespace fb
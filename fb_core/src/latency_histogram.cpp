@@ -0,0 +1,262 @@
+#include <fb/latency_histogram.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace fb
+{
+
+namespace
+{
+
+/// Values below this are counted in their own bucket
+constexpr std::uint64_t LINEAR_LIMIT = 64;
+
+/// log2 of the sub-buckets per power-of-two range
+constexpr unsigned SUB_BUCKET_BITS = 5;
+constexpr std::uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;
+
+constexpr std::uint64_t NO_MIN = std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * @brief Index of the most significant set bit of a non-zero value.
+ */
+unsigned highest_bit(std::uint64_t value) noexcept
+{
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanReverse64(&index, value);
+  return static_cast<unsigned>(index);
+#else
+  return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+} // namespace
+
+/**
+ * @class fb::latency_histogram
+ * @brief Fixed-size, lock-free log-linear latency histogram.
+ *
+ * Bucket layout: indices [0, 64) hold the exact values 0-63 ns. Beyond that
+ * a value with highest bit b is shifted right by s = b - 5, leaving a top
+ * part in [32, 64); the bucket is 64 + 32 * (s - 1) + (top - 32). Each
+ * bucket therefore spans 2^s values around a magnitude of 2^b, bounding the
+ * relative error by 1/32.
+ */
+
+/**
+ * @brief Construct an empty histogram.
+ */
+latency_histogram::latency_histogram() :
+  m_counts(new std::atomic<std::uint64_t>[BUCKET_COUNT]),
+  m_count(0),
+  m_total(0),
+  m_min(NO_MIN),
+  m_max(0)
+{
+  for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+  {
+    m_counts[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Record one latency sample.
+ * @param value Sample; negative durations are recorded as zero
+ */
+void latency_histogram::record(const std::chrono::nanoseconds &value) noexcept
+{
+  const std::uint64_t ns =
+      value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0;
+
+  m_counts[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_total.fetch_add(ns, std::memory_order_relaxed);
+
+  std::uint64_t current = m_min.load(std::memory_order_relaxed);
+  while (ns < current &&
+         !m_min.compare_exchange_weak(current, ns, std::memory_order_relaxed))
+  {
+  }
+  current = m_max.load(std::memory_order_relaxed);
+  while (ns > current &&
+         !m_max.compare_exchange_weak(current, ns, std::memory_order_relaxed))
+  {
+  }
+}
+
+/**
+ * @brief Number of samples recorded since construction or reset().
+ */
+std::uint64_t latency_histogram::count() const noexcept
+{
+  return m_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Smallest value such that @p percentile percent of samples are at or
+ * below it (rounded up to its bucket's upper bound).
+ *
+ * @param percentile Percentile in the range [0, 100]
+ * @return Latency at the percentile, or zero if no samples were recorded
+ * @throws std::invalid_argument if percentile is outside [0, 100]
+ */
+std::chrono::nanoseconds
+latency_histogram::value_at_percentile(double percentile) const
+{
+  if (!(percentile >= 0.0 && percentile <= 100.0))
+  {
+    throw std::invalid_argument("Percentile must be within [0, 100]");
+  }
+
+  std::vector<std::uint64_t> counts(BUCKET_COUNT);
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+  {
+    counts[i] = m_counts[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0)
+  {
+    return std::chrono::nanoseconds(0);
+  }
+
+  const auto rank = std::max<std::uint64_t>(
+      1, static_cast<std::uint64_t>(
+             std::ceil(percentile / 100.0 * static_cast<double>(total))));
+  const std::uint64_t max = m_max.load(std::memory_order_relaxed);
+
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+  {
+    seen += counts[i];
+    if (seen >= rank)
+    {
+      return std::chrono::nanoseconds(
+          static_cast<std::chrono::nanoseconds::rep>(
+              std::min(bucket_upper(i), max)));
+    }
+  }
+  return std::chrono::nanoseconds(
+      static_cast<std::chrono::nanoseconds::rep>(max));
+}
+
+/**
+ * @brief Summarise the distribution in a single pass over the buckets.
+ * @return Count, min, max, mean and the p50/p90/p99/p999 latencies
+ */
+latency_snapshot latency_histogram::snapshot() const
+{
+  latency_snapshot result;
+
+  std::vector<std::uint64_t> counts(BUCKET_COUNT);
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+  {
+    counts[i] = m_counts[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0)
+  {
+    return result;
+  }
+
+  const std::uint64_t min = m_min.load(std::memory_order_relaxed);
+  const std::uint64_t max = m_max.load(std::memory_order_relaxed);
+  const std::uint64_t sum = m_total.load(std::memory_order_relaxed);
+  const std::uint64_t samples =
+      std::max<std::uint64_t>(1, m_count.load(std::memory_order_relaxed));
+
+  result.count = total;
+  result.min   = std::chrono::nanoseconds(
+      static_cast<std::chrono::nanoseconds::rep>(min == NO_MIN ? 0 : min));
+  result.max = std::chrono::nanoseconds(
+      static_cast<std::chrono::nanoseconds::rep>(max));
+  result.mean = std::chrono::nanoseconds(
+      static_cast<std::chrono::nanoseconds::rep>(sum / samples));
+
+  const double percentiles[]             = {50.0, 90.0, 99.0, 99.9};
+  std::chrono::nanoseconds *const outputs[] = {&result.p50, &result.p90,
+                                               &result.p99, &result.p999};
+
+  std::size_t next  = 0;
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < BUCKET_COUNT && next < 4; ++i)
+  {
+    seen += counts[i];
+    while (next < 4)
+    {
+      const auto rank = std::max<std::uint64_t>(
+          1, static_cast<std::uint64_t>(std::ceil(
+                 percentiles[next] / 100.0 * static_cast<double>(total))));
+      if (seen < rank)
+      {
+        break;
+      }
+      *outputs[next] = std::chrono::nanoseconds(
+          static_cast<std::chrono::nanoseconds::rep>(
+              std::min(bucket_upper(i), max)));
+      ++next;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Discard all samples.
+ *
+ * Samples recorded concurrently with the reset may be partially kept.
+ */
+void latency_histogram::reset() noexcept
+{
+  for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+  {
+    m_counts[i].store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_total.store(0, std::memory_order_relaxed);
+  m_min.store(NO_MIN, std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Map a value in nanoseconds to its bucket.
+ */
+std::size_t latency_histogram::bucket_index(std::uint64_t value) noexcept
+{
+  if (value < LINEAR_LIMIT)
+  {
+    return static_cast<std::size_t>(value);
+  }
+
+  const unsigned shift = highest_bit(value) - SUB_BUCKET_BITS;
+  const std::uint64_t top = value >> shift;
+  return static_cast<std::size_t>(LINEAR_LIMIT + SUB_BUCKETS * (shift - 1) +
+                                  (top - SUB_BUCKETS));
+}
+
+/**
+ * @brief Largest value that maps to a bucket.
+ */
+std::uint64_t latency_histogram::bucket_upper(std::size_t index) noexcept
+{
+  if (index < LINEAR_LIMIT)
+  {
+    return index;
+  }
+
+  const std::uint64_t offset = index - LINEAR_LIMIT;
+  const unsigned shift = static_cast<unsigned>(offset / SUB_BUCKETS) + 1;
+  const std::uint64_t top = offset % SUB_BUCKETS + SUB_BUCKETS;
+  return (top << shift) + ((1ull << shift) - 1);
+}
+
+} // namespace fb
@@ -0,0 +1,411 @@
+/// @file logger.cpp
+/// @brief Per-thread log rings and the batching writer
+
+#include "fb/logger.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <ctime>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fb
+{
+
+namespace detail
+{
+
+std::atomic<log_level> log_threshold{log_level::info};
+std::atomic<bool>      log_collecting{false};
+
+} // namespace detail
+
+namespace
+{
+
+constexpr const char* LEVEL_NAMES[] = {"TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "CRIT ", "OFF  "};
+
+/// @brief A queued record and the number of the thread that logged it
+struct pending_record
+{
+  detail::log_record record;
+  std::uint32_t      thread;
+};
+
+/// @brief Builds "YYYY-MM-DD HH:MM:SS" prefixes, reformatting once per second
+class timestamp_formatter
+{
+public:
+  void append(std::string& out, std::chrono::system_clock::time_point time)
+  {
+    const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    const auto seconds     = static_cast<std::time_t>(since_epoch / 1000000000);
+    if (seconds != m_seconds || m_length == 0)
+    {
+      std::tm utc{};
+#ifdef _WIN32
+      gmtime_s(&utc, &seconds);
+#else
+      gmtime_r(&seconds, &utc);
+#endif
+      const int written = std::snprintf(m_text, sizeof(m_text), "%04d-%02d-%02d %02d:%02d:%02d", utc.tm_year + 1900,
+                                        utc.tm_mon + 1, utc.tm_mday, utc.tm_hour, utc.tm_min, utc.tm_sec);
+      m_length  = written > 0 ? static_cast<std::size_t>(written) : 0;
+      m_seconds = seconds;
+    }
+    out.append(m_text, m_length);
+
+    char fraction[16];
+    std::snprintf(fraction, sizeof(fraction), ".%09lldZ ", static_cast<long long>(since_epoch % 1000000000));
+    out += fraction;
+  }
+
+private:
+  std::time_t m_seconds = 0;
+  char        m_text[32]{};
+  std::size_t m_length = 0;
+};
+
+/// @brief Append the line of @p record, without its timestamp
+void append_message(std::string& out, const detail::log_record& record, std::uint32_t thread)
+{
+  out += LEVEL_NAMES[static_cast<std::size_t>(record.level)];
+  out += " [";
+  out += std::to_string(thread);
+  out += "] ";
+  try
+  {
+    record.format(out, record.fmt, record.payload);
+  }
+  catch (const std::exception& e)
+  {
+    // A bad format string loses its own line, not the batch
+    out += "(format error: ";
+    out += e.what();
+    out += ") ";
+    out += record.fmt;
+  }
+  out += '\n';
+}
+
+/// @brief Every thread's ring, and the session writing them out
+class log_registry
+{
+public:
+  static log_registry& instance()
+  {
+    static log_registry registry;
+    return registry;
+  }
+
+  ~log_registry()
+  {
+    stop();
+  }
+
+  log_registry(const log_registry&)            = delete;
+  log_registry& operator=(const log_registry&) = delete;
+
+  detail::log_buffer* attach()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.push_back(std::make_unique<detail::log_buffer>(m_capacity, m_next_id++));
+    return m_buffers.back().get();
+  }
+
+  void detach(detail::log_buffer* buffer)
+  {
+    // The thread is gone, so nothing produces into its ring any more
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_out != nullptr)
+    {
+      drain(*buffer);
+      write_batch();
+    }
+    m_dropped += buffer->dropped.load(std::memory_order_relaxed);
+    m_buffers.erase(std::find_if(m_buffers.begin(), m_buffers.end(),
+                                 [buffer](const std::unique_ptr<detail::log_buffer>& owned) { return owned.get() == buffer; }));
+  }
+
+  void start(const std::filesystem::path& filepath, std::chrono::milliseconds flush_interval,
+             std::size_t records_per_thread)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    check_idle();
+#ifdef _WIN32
+    std::FILE* file = _wfopen(filepath.c_str(), L"ab");
+#else
+    std::FILE* file = std::fopen(filepath.c_str(), "ab");
+#endif
+    if (file == nullptr)
+    {
+      throw std::runtime_error("logger: cannot open file \"" + filepath.string() + "\"");
+    }
+    begin(file, true, flush_interval, records_per_thread);
+  }
+
+  void start(std::FILE* stream, std::chrono::milliseconds flush_interval, std::size_t records_per_thread)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    check_idle();
+    begin(stream, false, flush_interval, records_per_thread);
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_out == nullptr || m_stopping)
+      {
+        return;
+      }
+      detail::log_collecting.store(false, std::memory_order_relaxed);
+      m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_writer.join();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain_all();
+    write_batch();
+    if (m_owns_out)
+    {
+      std::fclose(m_out);
+    }
+    else
+    {
+      std::fflush(m_out);
+    }
+    m_out      = nullptr;
+    m_stopping = false;
+  }
+
+  void flush()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_out != nullptr)
+    {
+      drain_all();
+      write_batch();
+    }
+  }
+
+  std::uint64_t dropped()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint64_t               total = m_dropped;
+    for (const auto& buffer : m_buffers)
+    {
+      total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  void write_unbuffered(const detail::log_record& record)
+  {
+    const auto wall = std::chrono::system_clock::now();
+
+    std::string line;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_timestamps.append(line, wall);
+    }
+    append_message(line, record, 0);
+    std::fwrite(line.data(), 1, line.size(), stderr);
+  }
+
+private:
+  log_registry() = default;
+
+  void check_idle() const
+  {
+    if (m_out != nullptr)
+    {
+      throw std::logic_error("logger: a session is already running");
+    }
+  }
+
+  void begin(std::FILE* out, bool owns_out, std::chrono::milliseconds flush_interval, std::size_t records_per_thread)
+  {
+    // Messages left over from an earlier session were already written by its stop()
+    for (const auto& buffer : m_buffers)
+    {
+      buffer->records.clear();
+      buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+    m_out         = out;
+    m_owns_out    = owns_out;
+    m_dropped     = 0;
+    m_capacity    = std::max<std::size_t>(records_per_thread, 1);
+    m_interval    = flush_interval;
+    m_stopping    = false;
+    m_origin_tsc  = tsc_clock::now();
+    m_origin_wall = std::chrono::system_clock::now();
+
+    m_writer = std::thread([this]() { run_writer(); });
+    detail::log_collecting.store(true, std::memory_order_relaxed);
+  }
+
+  void run_writer()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping)
+    {
+      m_wake.wait_for(lock, m_interval, [this]() { return m_stopping; });
+      drain_all();
+      write_batch();
+    }
+  }
+
+  void drain_all()
+  {
+    for (const auto& buffer : m_buffers)
+    {
+      drain(*buffer);
+    }
+  }
+
+  void drain(detail::log_buffer& buffer)
+  {
+    pending_record pending{{}, buffer.id};
+    while (buffer.records.pop_front(pending.record))
+    {
+      m_pending.push_back(pending);
+    }
+  }
+
+  /// @brief Format the drained records in time order and write them at once
+  void write_batch()
+  {
+    if (m_pending.empty())
+    {
+      return;
+    }
+    std::stable_sort(m_pending.begin(), m_pending.end(), [](const pending_record& a, const pending_record& b) {
+      return a.record.timestamp < b.record.timestamp;
+    });
+
+    m_text.clear();
+    for (const auto& pending : m_pending)
+    {
+      const auto offset = tsc_clock::to_duration(tsc_clock::ticks_between(m_origin_tsc, pending.record.timestamp));
+      m_timestamps.append(m_text, m_origin_wall + std::chrono::duration_cast<std::chrono::system_clock::duration>(offset));
+      append_message(m_text, pending.record, pending.thread);
+    }
+    m_pending.clear();
+
+    std::fwrite(m_text.data(), 1, m_text.size(), m_out);
+    std::fflush(m_out);
+  }
+
+  std::mutex                                       m_mutex;
+  std::condition_variable                          m_wake;
+  std::vector<std::unique_ptr<detail::log_buffer>> m_buffers;
+  std::vector<pending_record>                      m_pending; ///< Drained, not yet written
+  std::string                                      m_text;    ///< Batch being formatted, reused
+  timestamp_formatter                              m_timestamps;
+  std::thread                                      m_writer;
+  std::FILE*                                       m_out      = nullptr;
+  bool                                             m_owns_out = false;
+  std::chrono::milliseconds                        m_interval{10};
+  std::size_t                                      m_capacity   = logger::DEFAULT_RECORDS_PER_THREAD;
+  std::uint64_t                                    m_origin_tsc = 0;
+  std::chrono::system_clock::time_point            m_origin_wall;
+  std::uint64_t                                    m_dropped   = 0; ///< From threads that have exited
+  std::uint32_t                                    m_next_id   = 1;
+  bool                                             m_stopping  = false;
+};
+
+/// @brief The calling thread's ring, handed back when the thread exits
+struct log_buffer_handle
+{
+  ~log_buffer_handle()
+  {
+    if (buffer != nullptr)
+    {
+      log_registry::instance().detach(buffer);
+    }
+  }
+
+  detail::log_buffer* get()
+  {
+    if (buffer == nullptr)
+    {
+      buffer = log_registry::instance().attach();
+    }
+    return buffer;
+  }
+
+  detail::log_buffer* buffer = nullptr;
+};
+
+thread_local log_buffer_handle t_log_buffer;
+
+} // namespace
+
+namespace detail
+{
+
+log_buffer* this_thread_log_buffer() noexcept
+{
+  try
+  {
+    return t_log_buffer.get();
+  }
+  catch (...)
+  {
+    // The thread's first message could not allocate its ring
+    return nullptr;
+  }
+}
+
+void write_log_unbuffered(const log_record& record) noexcept
+{
+  try
+  {
+    log_registry::instance().write_unbuffered(record);
+  }
+  catch (...)
+  {
+    // Logging must not throw into the caller
+  }
+}
+
+} // namespace detail
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void logger::start(const std::filesystem::path& filepath, std::chrono::milliseconds flush_interval,
+                   std::size_t records_per_thread)
+{
+  log_registry::instance().start(filepath, flush_interval, records_per_thread);
+}
+
+void logger::start(std::FILE* stream, std::chrono::milliseconds flush_interval, std::size_t records_per_thread)
+{
+  log_registry::instance().start(stream, flush_interval, records_per_thread);
+}
+
+void logger::stop()
+{
+  log_registry::instance().stop();
+}
+
+void logger::flush()
+{
+  log_registry::instance().flush();
+}
+
+std::uint64_t logger::dropped() noexcept
+{
+  return log_registry::instance().dropped();
+}
+
+} // namespace fb
@@ -0,0 +1,152 @@
+/// @file mapped_file.cpp
+/// @brief Implementation of read-only file mapping
+
+#include "fb/mapped_file.h"
+
+#include <cerrno>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fb
+{
+
+namespace
+{
+
+[[noreturn]] void throw_file_error(int error, const char* what, const std::filesystem::path& filepath)
+{
+  throw std::system_error(error, std::generic_category(),
+                          std::string("mapped_file: cannot ") + what + " \"" + filepath.string() + "\"");
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+#ifdef _WIN32
+
+mapped_file::mapped_file(const std::filesystem::path& filepath)
+{
+  // Without mmap() the file is read once into a heap block
+  std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+  {
+    throw_file_error(ENOENT, "open", filepath);
+  }
+  const std::streamoff size = file.tellg();
+  if (size < 0 || static_cast<unsigned long long>(size) > std::numeric_limits<std::size_t>::max())
+  {
+    throw_file_error(EFBIG, "size", filepath);
+  }
+  m_size = static_cast<std::size_t>(size);
+  if (m_size != 0)
+  {
+    m_owned.reset(new char[m_size]);
+    file.seekg(0);
+    if (!file.read(m_owned.get(), static_cast<std::streamsize>(m_size)))
+    {
+      throw_file_error(EIO, "read", filepath);
+    }
+    m_data = m_owned.get();
+  }
+}
+
+#else
+
+mapped_file::mapped_file(const std::filesystem::path& filepath)
+{
+  const int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    throw_file_error(errno, "open", filepath);
+  }
+
+  struct stat status{};
+  if (::fstat(fd, &status) != 0)
+  {
+    const int error = errno;
+    ::close(fd);
+    throw_file_error(error, "stat", filepath);
+  }
+  if (static_cast<unsigned long long>(status.st_size) > std::numeric_limits<std::size_t>::max())
+  {
+    ::close(fd);
+    throw_file_error(EFBIG, "map", filepath);
+  }
+
+  // mmap() rejects a zero length; an empty file is an empty view
+  const auto size = static_cast<std::size_t>(status.st_size);
+  if (size != 0)
+  {
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+      const int error = errno;
+      ::close(fd);
+      throw_file_error(error, "map", filepath);
+    }
+    m_data = static_cast<const char*>(mapping);
+    m_size = size;
+  }
+
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+}
+
+#endif
+
+mapped_file::~mapped_file()
+{
+  release();
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_owned(std::move(other.m_owned))
+{
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    m_data  = std::exchange(other.m_data, nullptr);
+    m_size  = std::exchange(other.m_size, 0);
+    m_owned = std::move(other.m_owned);
+  }
+  return *this;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void mapped_file::release() noexcept
+{
+#ifndef _WIN32
+  if (m_data != nullptr && !m_owned)
+  {
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+#endif
+  m_owned.reset();
+  m_data = nullptr;
+  m_size = 0;
+}
+
+} // namespace fb
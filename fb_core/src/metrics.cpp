@@ -0,0 +1,439 @@
+/// @file metrics.cpp
+/// @brief Metric registration and the Prometheus / JSON exporters
+
+#include "fb/metrics.h"
+
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+bool is_valid_name(const std::string& name) noexcept
+{
+  if (name.empty())
+  {
+    return false;
+  }
+  for (std::size_t i = 0; i < name.size(); ++i)
+  {
+    const char ch     = name[i];
+    const bool letter = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_' || ch == ':';
+    const bool digit  = ch >= '0' && ch <= '9';
+    if (!letter && !(digit && i > 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void check_name(const std::string& name)
+{
+  if (!is_valid_name(name))
+  {
+    throw std::invalid_argument("metrics_registry: invalid metric name \"" + name + "\"");
+  }
+}
+
+const char* type_name(metric_type type) noexcept
+{
+  switch (type)
+  {
+  case metric_type::counter:
+    return "counter";
+  case metric_type::gauge:
+    return "gauge";
+  case metric_type::histogram:
+    break;
+  }
+  return "histogram";
+}
+
+void append_unsigned(std::string& out, std::uint64_t value)
+{
+  char text[24];
+  std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(value));
+  out += text;
+}
+
+void append_signed(std::string& out, std::int64_t value)
+{
+  char text[24];
+  std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(value));
+  out += text;
+}
+
+/// @brief Append @p ns as decimal seconds, locale-free
+void append_seconds(std::string& out, std::uint64_t ns)
+{
+  char text[32];
+  std::snprintf(text, sizeof(text), "%llu.%09llu", static_cast<unsigned long long>(ns / 1000000000),
+                static_cast<unsigned long long>(ns % 1000000000));
+  out += text;
+}
+
+std::uint64_t to_ns(std::chrono::nanoseconds value) noexcept
+{
+  return value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0;
+}
+
+/// @brief Append HELP text, escaping as the Prometheus text format requires
+void append_help(std::string& out, const std::string& help)
+{
+  for (const char ch : help)
+  {
+    if (ch == '\\')
+    {
+      out += "\\\\";
+    }
+    else if (ch == '\n')
+    {
+      out += "\\n";
+    }
+    else
+    {
+      out += ch;
+    }
+  }
+}
+
+/// @brief Append @p text as the body of a JSON string
+void append_json_string(std::string& out, const std::string& text)
+{
+  for (const char ch : text)
+  {
+    if (ch == '"' || ch == '\\')
+    {
+      out += '\\';
+      out += ch;
+    }
+    else if (static_cast<unsigned char>(ch) < 0x20)
+    {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(ch));
+      out += escaped;
+    }
+    else
+    {
+      out += ch;
+    }
+  }
+}
+
+} // namespace
+
+// ============================================================================
+// metrics_registration
+// ============================================================================
+
+metrics_registration::metrics_registration(metrics_registry* registry, std::string name, std::uint64_t id)
+    : m_registry(registry)
+{
+  m_metrics.emplace_back(std::move(name), id);
+}
+
+metrics_registration::~metrics_registration()
+{
+  reset();
+}
+
+metrics_registration::metrics_registration(metrics_registration&& other) noexcept
+    : m_registry(other.m_registry)
+    , m_metrics(std::move(other.m_metrics))
+{
+  other.m_metrics.clear();
+}
+
+metrics_registration& metrics_registration::operator=(metrics_registration&& other) noexcept
+{
+  if (this != &other)
+  {
+    reset();
+    m_registry = other.m_registry;
+    m_metrics  = std::move(other.m_metrics);
+    other.m_metrics.clear();
+  }
+  return *this;
+}
+
+void metrics_registration::append(metrics_registration&& other)
+{
+  if (other.m_metrics.empty())
+  {
+    return;
+  }
+  if (!m_metrics.empty() && m_registry != other.m_registry)
+  {
+    throw std::invalid_argument("metrics_registration: cannot combine metrics of different registries");
+  }
+  m_registry = other.m_registry;
+  m_metrics.insert(m_metrics.end(), std::make_move_iterator(other.m_metrics.begin()),
+                   std::make_move_iterator(other.m_metrics.end()));
+  other.m_metrics.clear();
+}
+
+void metrics_registration::reset() noexcept
+{
+  for (const auto& [name, id] : m_metrics)
+  {
+    m_registry->unregister(name, id);
+  }
+  m_metrics.clear();
+}
+
+// ============================================================================
+// metrics_registry
+// ============================================================================
+
+metrics_registry& metrics_registry::global()
+{
+  static metrics_registry registry;
+  return registry;
+}
+
+metric_counter& metrics_registry::counter(const std::string& name, const std::string& help)
+{
+  return *static_cast<metric_counter*>(find_or_create(name, help, metric_type::counter).owned.get());
+}
+
+metric_gauge& metrics_registry::gauge(const std::string& name, const std::string& help)
+{
+  return *static_cast<metric_gauge*>(find_or_create(name, help, metric_type::gauge).owned.get());
+}
+
+latency_histogram& metrics_registry::histogram(const std::string& name, const std::string& help)
+{
+  return *static_cast<latency_histogram*>(find_or_create(name, help, metric_type::histogram).owned.get());
+}
+
+metrics_registration metrics_registry::add_counter(const std::string& name, const std::string& help,
+                                                   std::function<std::uint64_t()> read)
+{
+  entry pulled{metric_type::counter, help, std::move(read), {}, {}, nullptr, 0};
+  return add(name, std::move(pulled));
+}
+
+metrics_registration metrics_registry::add_gauge(const std::string& name, const std::string& help,
+                                                 std::function<std::int64_t()> read)
+{
+  entry pulled{metric_type::gauge, help, {}, std::move(read), {}, nullptr, 0};
+  return add(name, std::move(pulled));
+}
+
+metrics_registration metrics_registry::add_histogram(const std::string& name, const std::string& help,
+                                                     std::function<latency_snapshot()> read)
+{
+  entry pulled{metric_type::histogram, help, {}, {}, std::move(read), nullptr, 0};
+  return add(name, std::move(pulled));
+}
+
+bool metrics_registry::remove(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.erase(name) != 0;
+}
+
+bool metrics_registry::contains(const std::string& name) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.count(name) != 0;
+}
+
+std::size_t metrics_registry::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+std::string metrics_registry::to_prometheus() const
+{
+  std::string                 out;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (const auto& [name, metric] : m_entries)
+  {
+    if (!metric.help.empty())
+    {
+      out += "# HELP ";
+      out += name;
+      out += ' ';
+      append_help(out, metric.help);
+      out += '\n';
+    }
+    out += "# TYPE ";
+    out += name;
+    out += ' ';
+    out += metric.type == metric_type::histogram ? "summary" : type_name(metric.type);
+    out += '\n';
+
+    switch (metric.type)
+    {
+    case metric_type::counter:
+      out += name;
+      out += ' ';
+      append_unsigned(out, metric.read_counter());
+      out += '\n';
+      break;
+    case metric_type::gauge:
+      out += name;
+      out += ' ';
+      append_signed(out, metric.read_gauge());
+      out += '\n';
+      break;
+    case metric_type::histogram:
+    {
+      const latency_snapshot snapshot = metric.read_histogram();
+      const std::pair<const char*, std::chrono::nanoseconds> quantiles[] = {
+          {"0.5", snapshot.p50}, {"0.9", snapshot.p90}, {"0.99", snapshot.p99}, {"0.999", snapshot.p999}};
+      for (const auto& [quantile, value] : quantiles)
+      {
+        out += name;
+        out += "{quantile=\"";
+        out += quantile;
+        out += "\"} ";
+        append_seconds(out, to_ns(value));
+        out += '\n';
+      }
+      out += name;
+      out += "_sum ";
+      append_seconds(out, to_ns(snapshot.mean) * snapshot.count);
+      out += '\n';
+      out += name;
+      out += "_count ";
+      append_unsigned(out, snapshot.count);
+      out += '\n';
+      break;
+    }
+    }
+  }
+  return out;
+}
+
+std::string metrics_registry::to_json() const
+{
+  std::string                 out = "{";
+  bool                        first = true;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (const auto& [name, metric] : m_entries)
+  {
+    out += first ? "\"" : ",\"";
+    first = false;
+    append_json_string(out, name);
+    out += "\":{\"type\":\"";
+    out += type_name(metric.type);
+    out += "\",\"help\":\"";
+    append_json_string(out, metric.help);
+    out += '"';
+
+    switch (metric.type)
+    {
+    case metric_type::counter:
+      out += ",\"value\":";
+      append_unsigned(out, metric.read_counter());
+      break;
+    case metric_type::gauge:
+      out += ",\"value\":";
+      append_signed(out, metric.read_gauge());
+      break;
+    case metric_type::histogram:
+    {
+      const latency_snapshot snapshot = metric.read_histogram();
+      const std::pair<const char*, std::chrono::nanoseconds> fields[] = {
+          {"min_ns", snapshot.min}, {"max_ns", snapshot.max}, {"mean_ns", snapshot.mean},
+          {"p50_ns", snapshot.p50}, {"p90_ns", snapshot.p90}, {"p99_ns", snapshot.p99},
+          {"p999_ns", snapshot.p999}};
+      out += ",\"count\":";
+      append_unsigned(out, snapshot.count);
+      for (const auto& [field, value] : fields)
+      {
+        out += ",\"";
+        out += field;
+        out += "\":";
+        append_unsigned(out, to_ns(value));
+      }
+      break;
+    }
+    }
+    out += '}';
+  }
+  out += "}";
+  return out;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+metrics_registry::entry& metrics_registry::find_or_create(const std::string& name, const std::string& help,
+                                                          metric_type type)
+{
+  check_name(name);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto                  found = m_entries.find(name);
+  if (found != m_entries.end())
+  {
+    if (found->second.type != type || !found->second.owned)
+    {
+      throw std::invalid_argument("metrics_registry: \"" + name + "\" is already registered as another metric");
+    }
+    return found->second;
+  }
+
+  entry owned{type, help, {}, {}, {}, nullptr, 0};
+  switch (type)
+  {
+  case metric_type::counter:
+  {
+    auto counter       = std::make_shared<metric_counter>();
+    owned.read_counter = [metric = counter.get()]() { return metric->value(); };
+    owned.owned        = std::move(counter);
+    break;
+  }
+  case metric_type::gauge:
+  {
+    auto gauge       = std::make_shared<metric_gauge>();
+    owned.read_gauge = [metric = gauge.get()]() { return metric->value(); };
+    owned.owned      = std::move(gauge);
+    break;
+  }
+  case metric_type::histogram:
+  {
+    auto histogram       = std::make_shared<latency_histogram>();
+    owned.read_histogram = [metric = histogram.get()]() { return metric->snapshot(); };
+    owned.owned          = std::move(histogram);
+    break;
+  }
+  }
+  return m_entries.emplace(name, std::move(owned)).first->second;
+}
+
+metrics_registration metrics_registry::add(const std::string& name, entry pulled)
+{
+  check_name(name);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_entries.count(name) != 0)
+  {
+    throw std::invalid_argument("metrics_registry: \"" + name + "\" is already registered");
+  }
+  pulled.registration = m_next_registration++;
+  const std::uint64_t id = pulled.registration;
+  m_entries.emplace(name, std::move(pulled));
+  return metrics_registration(this, name, id);
+}
+
+void metrics_registry::unregister(const std::string& name, std::uint64_t id) noexcept
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto                  found = m_entries.find(name);
+  // The name may have been removed, and perhaps reused, since
+  if (found != m_entries.end() && found->second.registration == id)
+  {
+    m_entries.erase(found);
+  }
+}
+
+} // namespace fb
@@ -0,0 +1,260 @@
+/// @file mirrored_ring_buffer.cpp
+/// @brief Implementation of the double-mapped byte ring
+
+#include "fb/mirrored_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if !defined(__linux__) || !defined(MFD_CLOEXEC)
+#include <atomic>
+#include <string>
+#endif
+#endif
+
+namespace fb
+{
+
+namespace
+{
+
+#ifndef _WIN32
+
+/// @brief Anonymous shared memory object of @p size bytes, or -1
+int open_backing_file(std::size_t size) noexcept
+{
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+  const int fd = ::memfd_create("fb_mirrored_ring", MFD_CLOEXEC);
+#else
+  // Unlinked straight away, so the object lives only as long as the fd
+  static std::atomic<unsigned> counter{0};
+  const std::string name = "/fb_ring." + std::to_string(::getpid()) + "." +
+                           std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+  const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd >= 0)
+  {
+    ::shm_unlink(name.c_str());
+  }
+#endif
+  if (fd < 0)
+  {
+    return -1;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/// @brief Map @p size bytes twice in a row, or return nullptr
+char* map_mirrored(std::size_t size) noexcept
+{
+  const int fd = open_backing_file(size);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+
+  // Reserve both halves first so nothing else can be mapped in between
+  void* region = ::mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (region == MAP_FAILED)
+  {
+    ::close(fd);
+    return nullptr;
+  }
+  char* const base = static_cast<char*>(region);
+  void* const lower = ::mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+  void* const upper = ::mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+
+  // The mappings keep their own reference to the memory object
+  ::close(fd);
+  if (lower != base || upper != base + size)
+  {
+    ::munmap(region, 2 * size);
+    return nullptr;
+  }
+  return base;
+}
+
+#endif
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+mirrored_ring_buffer::mirrored_ring_buffer(std::size_t capacity)
+{
+  allocate(capacity);
+}
+
+mirrored_ring_buffer::~mirrored_ring_buffer()
+{
+  release();
+}
+
+mirrored_ring_buffer::mirrored_ring_buffer(mirrored_ring_buffer&& other) noexcept
+    : m_base(std::exchange(other.m_base, nullptr))
+    , m_capacity(std::exchange(other.m_capacity, 0))
+    , m_begin(std::exchange(other.m_begin, 0))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_mirrored(std::exchange(other.m_mirrored, false))
+    , m_owned(std::move(other.m_owned))
+{
+}
+
+mirrored_ring_buffer& mirrored_ring_buffer::operator=(mirrored_ring_buffer&& other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    m_base     = std::exchange(other.m_base, nullptr);
+    m_capacity = std::exchange(other.m_capacity, 0);
+    m_begin    = std::exchange(other.m_begin, 0);
+    m_size     = std::exchange(other.m_size, 0);
+    m_mirrored = std::exchange(other.m_mirrored, false);
+    m_owned    = std::move(other.m_owned);
+  }
+  return *this;
+}
+
+// ============================================================================
+// Reading and Writing
+// ============================================================================
+
+char* mirrored_ring_buffer::write_data() noexcept
+{
+  if (!m_mirrored && m_begin != 0)
+  {
+    // Without the second mapping the free space must follow the data
+    std::memmove(m_base, m_base + m_begin, m_size);
+    m_begin = 0;
+  }
+  return m_base + m_begin + m_size;
+}
+
+void mirrored_ring_buffer::commit_back(std::size_t count)
+{
+  if (count > free_space())
+  {
+    throw std::length_error("mirrored_ring_buffer: commit_back beyond free space");
+  }
+  m_size += count;
+}
+
+std::size_t mirrored_ring_buffer::push_back_n(const char* bytes, std::size_t count) noexcept
+{
+  count = std::min(count, free_space());
+  if (count != 0)
+  {
+    std::memcpy(write_data(), bytes, count);
+    m_size += count;
+  }
+  return count;
+}
+
+std::size_t mirrored_ring_buffer::pop_front_n(std::size_t count) noexcept
+{
+  count = std::min(count, m_size);
+  m_size -= count;
+  if (m_size == 0)
+  {
+    // Restarting at the front saves the heap fallback a later compaction
+    m_begin = 0;
+  }
+  else
+  {
+    m_begin += count;
+    if (m_mirrored && m_begin >= m_capacity)
+    {
+      m_begin -= m_capacity;
+    }
+  }
+  return count;
+}
+
+void mirrored_ring_buffer::clear() noexcept
+{
+  m_begin = 0;
+  m_size  = 0;
+}
+
+void mirrored_ring_buffer::reserve(std::size_t capacity)
+{
+  if (capacity <= m_capacity)
+  {
+    return;
+  }
+  mirrored_ring_buffer grown(capacity);
+  grown.push_back_n(data(), m_size);
+  *this = std::move(grown);
+}
+
+std::size_t mirrored_ring_buffer::page_size() noexcept
+{
+#ifdef _WIN32
+  return 4096;
+#else
+  static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+#endif
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void mirrored_ring_buffer::allocate(std::size_t capacity)
+{
+  const std::size_t page = page_size();
+  if (capacity > std::numeric_limits<std::size_t>::max() / 2 - page)
+  {
+    throw std::bad_alloc();
+  }
+  const std::size_t rounded = capacity == 0 ? page : (capacity + page - 1) / page * page;
+
+#ifndef _WIN32
+  m_base = map_mirrored(rounded);
+  if (m_base != nullptr)
+  {
+    m_capacity = rounded;
+    m_mirrored = true;
+    return;
+  }
+#endif
+
+  // Sandboxes may forbid memfd or shm; a compacted heap block still works
+  m_owned.reset(new char[rounded]);
+  m_base     = m_owned.get();
+  m_capacity = rounded;
+  m_mirrored = false;
+}
+
+void mirrored_ring_buffer::release() noexcept
+{
+#ifndef _WIN32
+  if (m_mirrored)
+  {
+    ::munmap(m_base, 2 * m_capacity);
+  }
+#endif
+  m_owned.reset();
+  m_base     = nullptr;
+  m_capacity = 0;
+  m_begin    = 0;
+  m_size     = 0;
+  m_mirrored = false;
+}
+
+} // namespace fb
@@ -0,0 +1,183 @@
+/// @file object_pool.cpp
+/// @brief fixed_pool chunks and per-thread caches
+
+#include "fb/object_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+std::atomic<std::uint64_t> g_next_pool_id{1};
+
+} // namespace
+
+/// @brief Free lists a thread took from the pools it allocated from
+///
+/// Entries refer to their pool weakly: a pool destroyed first leaves a
+/// stale entry, dropped the next time this thread meets a new pool. Blocks
+/// still cached when the thread exits go back to their pool's shared stack.
+struct fixed_pool::thread_cache
+{
+  struct entry
+  {
+    std::uint64_t        id;
+    std::weak_ptr<state> owner;
+    free_block*          head;
+  };
+
+  ~thread_cache()
+  {
+    for (auto& cached : entries)
+    {
+      if (cached.head == nullptr)
+      {
+        continue;
+      }
+      if (const auto owner = cached.owner.lock())
+      {
+        free_block* last = cached.head;
+        while (last->next != nullptr)
+        {
+          last = last->next;
+        }
+        owner->push(cached.head, last);
+      }
+    }
+  }
+
+  std::vector<entry> entries;
+  std::size_t        last_used = 0;
+};
+
+// ============================================================================
+// fixed_pool::state
+// ============================================================================
+
+fixed_pool::state::state(std::size_t size, std::size_t alignment, std::size_t per_chunk,
+                         std::pmr::memory_resource* source)
+    : block_size(((std::max(size, sizeof(free_block)) + alignment - 1) / alignment) * alignment)
+    , block_alignment(alignment)
+    , blocks_per_chunk(std::max<std::size_t>(per_chunk, 1))
+    , upstream(source)
+    , id(g_next_pool_id.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+fixed_pool::state::~state()
+{
+  for (void* chunk : chunks)
+  {
+    upstream->deallocate(chunk, block_size * blocks_per_chunk, block_alignment);
+  }
+}
+
+fixed_pool::free_block* fixed_pool::state::grow()
+{
+  const std::size_t chunk_size = block_size * blocks_per_chunk;
+  char*             chunk      = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(chunks_mutex);
+    chunk = static_cast<char*>(upstream->allocate(chunk_size, block_alignment));
+    try
+    {
+      chunks.push_back(chunk);
+    }
+    catch (...)
+    {
+      upstream->deallocate(chunk, chunk_size, block_alignment);
+      throw;
+    }
+  }
+
+  // Link the blocks in address order, so a fresh chunk is handed out sequentially
+  free_block* head = nullptr;
+  for (std::size_t i = blocks_per_chunk; i > 0; --i)
+  {
+    head = ::new (chunk + (i - 1) * block_size) free_block{head};
+  }
+  return head;
+}
+
+// ============================================================================
+// fixed_pool
+// ============================================================================
+
+fixed_pool::fixed_pool(std::size_t block_size, std::size_t block_alignment, std::size_t blocks_per_chunk,
+                       std::pmr::memory_resource* upstream)
+{
+  if (block_alignment == 0 || (block_alignment & (block_alignment - 1)) != 0)
+  {
+    throw std::invalid_argument("fixed_pool: block alignment must be a power of two");
+  }
+  m_state = std::make_shared<state>(block_size, std::max(block_alignment, alignof(free_block)), blocks_per_chunk,
+                                    upstream);
+}
+
+void* fixed_pool::allocate()
+{
+  free_block*& head = cached_blocks(m_state);
+  if (head == nullptr)
+  {
+    head = m_state->take_all();
+  }
+  if (head == nullptr)
+  {
+    head = m_state->grow();
+  }
+  free_block* block = head;
+  head              = block->next;
+  return block;
+}
+
+void fixed_pool::deallocate(void* block) noexcept
+{
+  if (block != nullptr)
+  {
+    free_block* freed = ::new (block) free_block{nullptr};
+    m_state->push(freed, freed);
+  }
+}
+
+std::size_t fixed_pool::capacity() const
+{
+  std::lock_guard<std::mutex> lock(m_state->chunks_mutex);
+  return m_state->chunks.size() * m_state->blocks_per_chunk;
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+fixed_pool::free_block*& fixed_pool::cached_blocks(const std::shared_ptr<state>& owner)
+{
+  static thread_local thread_cache cache;
+
+  auto& entries = cache.entries;
+  if (cache.last_used < entries.size() && entries[cache.last_used].id == owner->id)
+  {
+    return entries[cache.last_used].head;
+  }
+  for (std::size_t i = 0; i < entries.size(); ++i)
+  {
+    if (entries[i].id == owner->id)
+    {
+      cache.last_used = i;
+      return entries[i].head;
+    }
+  }
+
+  // First allocation from this pool on this thread; forget pools that are gone
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [](const thread_cache::entry& cached) { return cached.owner.expired(); }),
+                entries.end());
+  entries.push_back({owner->id, owner, nullptr});
+  cache.last_used = entries.size() - 1;
+  return entries.back().head;
+}
+
+} // namespace fb
@@ -0,0 +1,352 @@
+/// @file profiler.cpp
+/// @brief Per-thread zone rings and the Chrome trace writer
+
+#include "fb/profiler.h"
+
+#include "fb/spsc_circular_buffer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fb
+{
+
+namespace detail
+{
+
+std::atomic<bool> profiler_collecting{false};
+
+} // namespace detail
+
+namespace
+{
+
+/// @brief The zone ring of one thread; the thread produces, the writer consumes
+struct thread_trace
+{
+  thread_trace(std::size_t capacity, std::uint32_t thread_id)
+      : records(capacity)
+      , id(thread_id)
+  {
+  }
+
+  spsc_circular_buffer<profile_record> records;
+  std::atomic<std::uint64_t>           dropped{0};
+  const std::uint32_t                  id;
+  std::string                          name;                 ///< Guarded by the registry mutex
+  bool                                 name_written = false; ///< Guarded by the registry mutex
+};
+
+/// @brief Append @p text to @p out as the body of a JSON string
+void write_json_string(std::ofstream& out, const char* text)
+{
+  for (; *text != '\0'; ++text)
+  {
+    const char ch = *text;
+    if (ch == '"' || ch == '\\')
+    {
+      out.put('\\');
+      out.put(ch);
+    }
+    else if (static_cast<unsigned char>(ch) < 0x20)
+    {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(ch));
+      out << escaped;
+    }
+    else
+    {
+      out.put(ch);
+    }
+  }
+}
+
+/// @brief Append @p ticks as microseconds with nanosecond digits, locale-free
+void write_microseconds(std::ofstream& out, std::uint64_t ticks)
+{
+  const auto nanoseconds = static_cast<unsigned long long>(tsc_clock::to_duration(ticks).count());
+  char       text[32];
+  std::snprintf(text, sizeof(text), "%llu.%03llu", nanoseconds / 1000, nanoseconds % 1000);
+  out << text;
+}
+
+/// @brief Every thread's ring, and the session writing them out
+class trace_registry
+{
+public:
+  static trace_registry& instance()
+  {
+    static trace_registry registry;
+    return registry;
+  }
+
+  ~trace_registry()
+  {
+    stop();
+  }
+
+  trace_registry(const trace_registry&)            = delete;
+  trace_registry& operator=(const trace_registry&) = delete;
+
+  thread_trace* attach()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_traces.push_back(std::make_unique<thread_trace>(m_capacity, m_next_id++));
+    return m_traces.back().get();
+  }
+
+  void detach(thread_trace* trace)
+  {
+    // The thread is gone, so nothing produces into its ring any more
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_out.is_open())
+    {
+      drain(*trace);
+    }
+    m_dropped += trace->dropped.load(std::memory_order_relaxed);
+    m_traces.erase(std::find_if(m_traces.begin(), m_traces.end(),
+                                [trace](const std::unique_ptr<thread_trace>& owned) { return owned.get() == trace; }));
+  }
+
+  void set_name(thread_trace* trace, std::string name)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    trace->name         = std::move(name);
+    trace->name_written = false;
+  }
+
+  void start(const std::filesystem::path& filepath, std::chrono::milliseconds flush_interval,
+             std::size_t records_per_thread)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_out.is_open())
+    {
+      throw std::logic_error("profiler: a session is already running");
+    }
+    m_out.open(filepath, std::ios::binary | std::ios::trunc);
+    if (!m_out.is_open())
+    {
+      throw std::runtime_error("profiler: cannot open file \"" + filepath.string() + "\"");
+    }
+
+    // Zones left over from an earlier session end before this one begins
+    for (const auto& trace : m_traces)
+    {
+      trace->records.clear();
+      trace->dropped.store(0, std::memory_order_relaxed);
+      trace->name_written = false;
+    }
+    m_dropped     = 0;
+    m_capacity    = std::max<std::size_t>(records_per_thread, 1);
+    m_interval    = flush_interval;
+    m_first_event = true;
+    m_stopping    = false;
+    m_origin      = tsc_clock::now();
+    m_out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    m_flusher = std::thread([this]() { run_flusher(); });
+    detail::profiler_collecting.store(true, std::memory_order_relaxed);
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_out.is_open() || m_stopping)
+      {
+        return;
+      }
+      detail::profiler_collecting.store(false, std::memory_order_relaxed);
+      m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_flusher.join();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain_all();
+    m_out << "],\"otherData\":{\"dropped_zones\":\"" << dropped_locked() << "\"}}\n";
+    m_out.close();
+    m_stopping = false;
+  }
+
+  void flush()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_out.is_open())
+    {
+      drain_all();
+      m_out.flush();
+    }
+  }
+
+  std::uint64_t dropped()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return dropped_locked();
+  }
+
+private:
+  trace_registry() = default;
+
+  void run_flusher()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping)
+    {
+      m_wake.wait_for(lock, m_interval, [this]() { return m_stopping; });
+      drain_all();
+      m_out.flush();
+    }
+  }
+
+  std::uint64_t dropped_locked() const
+  {
+    std::uint64_t total = m_dropped;
+    for (const auto& trace : m_traces)
+    {
+      total += trace->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  void drain_all()
+  {
+    for (const auto& trace : m_traces)
+    {
+      drain(*trace);
+    }
+  }
+
+  void drain(thread_trace& trace)
+  {
+    if (!trace.name_written && !trace.name.empty())
+    {
+      begin_event();
+      m_out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << trace.id << ",\"args\":{\"name\":\"";
+      write_json_string(m_out, trace.name.c_str());
+      m_out << "\"}}";
+      trace.name_written = true;
+    }
+
+    profile_record record{};
+    while (trace.records.pop_front(record))
+    {
+      begin_event();
+      m_out << "{\"name\":\"";
+      write_json_string(m_out, record.name);
+      m_out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << trace.id << ",\"ts\":";
+      write_microseconds(m_out, tsc_clock::ticks_between(m_origin, record.begin));
+      m_out << ",\"dur\":";
+      write_microseconds(m_out, tsc_clock::ticks_between(record.begin, record.end));
+      m_out << '}';
+    }
+  }
+
+  void begin_event()
+  {
+    if (!m_first_event)
+    {
+      m_out.put(',');
+    }
+    m_out.put('\n');
+    m_first_event = false;
+  }
+
+  std::mutex                                 m_mutex;
+  std::condition_variable                    m_wake;
+  std::vector<std::unique_ptr<thread_trace>> m_traces;
+  std::thread                                m_flusher;
+  std::ofstream                              m_out;
+  std::chrono::milliseconds                  m_interval{100};
+  std::size_t                                m_capacity    = profiler::DEFAULT_RECORDS_PER_THREAD;
+  std::uint64_t                              m_origin      = 0;
+  std::uint64_t                              m_dropped     = 0; ///< From threads that have exited
+  std::uint32_t                              m_next_id     = 1;
+  bool                                       m_first_event = true;
+  bool                                       m_stopping    = false;
+};
+
+/// @brief The calling thread's ring, handed back when the thread exits
+struct thread_trace_handle
+{
+  ~thread_trace_handle()
+  {
+    if (trace != nullptr)
+    {
+      trace_registry::instance().detach(trace);
+    }
+  }
+
+  thread_trace* get()
+  {
+    if (trace == nullptr)
+    {
+      trace = trace_registry::instance().attach();
+    }
+    return trace;
+  }
+
+  thread_trace* trace = nullptr;
+};
+
+thread_local thread_trace_handle t_trace;
+
+} // namespace
+
+// ============================================================================
+// Public Methods
+// ============================================================================
+
+void profiler::start(const std::filesystem::path& filepath, std::chrono::milliseconds flush_interval,
+                     std::size_t records_per_thread)
+{
+  trace_registry::instance().start(filepath, flush_interval, records_per_thread);
+}
+
+void profiler::stop()
+{
+  trace_registry::instance().stop();
+}
+
+void profiler::flush()
+{
+  trace_registry::instance().flush();
+}
+
+std::uint64_t profiler::dropped() noexcept
+{
+  return trace_registry::instance().dropped();
+}
+
+void profiler::set_thread_name(std::string name)
+{
+  trace_registry::instance().set_name(t_trace.get(), std::move(name));
+}
+
+void profiler::record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept
+{
+  thread_trace* trace;
+  try
+  {
+    trace = t_trace.get();
+  }
+  catch (...)
+  {
+    // The thread's first zone could not allocate its ring
+    return;
+  }
+  if (!trace->records.push_back(profile_record{name, begin, end}))
+  {
+    trace->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+} // namespace fb
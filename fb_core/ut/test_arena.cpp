@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <fb/arena.h>
+#include <fb/circular_buffer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/// @brief Upstream that counts what the arena takes from it
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+  std::size_t allocations   = 0;
+  std::size_t deallocations = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override
+  {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+bool is_aligned(const void* memory, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(memory) % alignment == 0;
+}
+
+} // namespace
+
+TEST(MonotonicArenaTest, AllocationsAreAlignedAndDistinct)
+{
+  fb::monotonic_arena arena(1024);
+  char*               a = static_cast<char*>(arena.allocate(3, 1));
+  char*               b = static_cast<char*>(arena.allocate(8, 8));
+  char*               c = static_cast<char*>(arena.allocate(64, 64));
+  EXPECT_TRUE(is_aligned(b, 8));
+  EXPECT_TRUE(is_aligned(c, 64));
+  EXPECT_GE(b, a + 3);
+  EXPECT_GE(c, b + 8);
+  EXPECT_EQ(arena.bytes_used(), 75u);
+}
+
+TEST(MonotonicArenaTest, ResetKeepsChunksForReuse)
+{
+  counting_resource   upstream;
+  fb::monotonic_arena arena(256, &upstream);
+
+  for (int cycle = 0; cycle < 5; ++cycle)
+  {
+    for (int i = 0; i < 20; ++i)
+    {
+      static_cast<void>(arena.allocate(64, 8));
+    }
+    arena.reset();
+    EXPECT_EQ(arena.bytes_used(), 0u);
+  }
+  // Chunks grown in the first cycle serve every later one
+  const std::size_t grown = upstream.allocations;
+  EXPECT_GT(grown, 1u);
+  for (int i = 0; i < 20; ++i)
+  {
+    static_cast<void>(arena.allocate(64, 8));
+  }
+  EXPECT_EQ(upstream.allocations, grown);
+  EXPECT_EQ(upstream.deallocations, 0u);
+
+  arena.release();
+  EXPECT_EQ(upstream.deallocations, grown);
+  EXPECT_EQ(arena.bytes_reserved(), 0u);
+}
+
+TEST(MonotonicArenaTest, OversizedRequestGetsItsOwnChunk)
+{
+  counting_resource   upstream;
+  fb::monotonic_arena arena(256, &upstream);
+  void*               big = arena.allocate(10000, 16);
+  EXPECT_TRUE(is_aligned(big, 16));
+  EXPECT_GE(arena.bytes_reserved(), 10000u);
+
+  // The arena carries on in chunks of its own size
+  static_cast<void>(arena.allocate(64, 8));
+  EXPECT_EQ(upstream.allocations, 2u);
+}
+
+TEST(MonotonicArenaTest, CallerBufferIsUsedFirst)
+{
+  counting_resource     upstream;
+  alignas(16) std::byte buffer[512];
+  fb::monotonic_arena   arena(buffer, sizeof(buffer), &upstream);
+
+  void* first = arena.allocate(100, 8);
+  EXPECT_GE(static_cast<std::byte*>(first), buffer);
+  EXPECT_LT(static_cast<std::byte*>(first), buffer + sizeof(buffer));
+  EXPECT_EQ(upstream.allocations, 0u);
+
+  static_cast<void>(arena.allocate(1000, 8));
+  EXPECT_EQ(upstream.allocations, 1u);
+
+  arena.release();
+  EXPECT_EQ(upstream.deallocations, 1u);
+  EXPECT_EQ(arena.allocate(100, 8), first);
+}
+
+TEST(MonotonicArenaTest, BacksPmrContainers)
+{
+  fb::monotonic_arena arena;
+  {
+    std::pmr::vector<std::pmr::string> fields(&arena);
+    for (int i = 0; i < 100; ++i)
+    {
+      fields.emplace_back("a field long enough to leave the small string buffer " + std::to_string(i));
+    }
+    EXPECT_EQ(fields[42].get_allocator().resource(), &arena);
+    EXPECT_EQ(fields.back().substr(0, 7), "a field");
+  }
+  EXPECT_GT(arena.bytes_used(), 100u * 50u);
+  arena.reset();
+  EXPECT_EQ(arena.bytes_used(), 0u);
+}
+
+TEST(MonotonicArenaTest, CircularBufferTakesAnAllocator)
+{
+  fb::monotonic_arena arena;
+  using pmr_ring = fb::circular_buffer<int, true, std::pmr::polymorphic_allocator<int>>;
+
+  pmr_ring ring(4, &arena);
+  EXPECT_EQ(ring.get_allocator().resource(), &arena);
+  EXPECT_EQ(arena.bytes_used(), 4 * sizeof(int));
+
+  for (int i = 0; i < 6; ++i)
+  {
+    ring.push_back(i);
+  }
+  ring.reserve(8);
+  EXPECT_EQ(ring.get_allocator().resource(), &arena);
+
+  pmr_ring copy(ring, &arena);
+  copy = ring;
+  EXPECT_EQ(copy.get_allocator().resource(), &arena);
+  ASSERT_EQ(copy.size(), 4u);
+  EXPECT_EQ(copy.front(), 2);
+}
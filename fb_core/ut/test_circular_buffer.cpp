@@ -2,7 +2,9 @@
 
 #include "fb/circular_buffer.h"
 
+#include <cstring>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 using fb::circular_buffer;
@@ -128,3 +130,155 @@ TEST(CircularBufferTest, EqualityOperatorsCompareContents) {
   a.push_back(3);
   EXPECT_FALSE(a < b);
 }
+
+TEST(CircularBufferTest, PushBackNWrapsAndPopFrontNCopiesOut) {
+  circular_buffer<int> buffer(5);
+  const int first[] = {1, 2, 3, 4};
+  EXPECT_EQ(buffer.push_back_n(first, 4), 4u);
+
+  int out[5] = {};
+  EXPECT_EQ(buffer.pop_front_n(out, 3), 3u);
+  EXPECT_EQ(out[0], 1);
+  EXPECT_EQ(out[2], 3);
+
+  const int second[] = {5, 6, 7};  // wraps past the end of the array
+  EXPECT_EQ(buffer.push_back_n(second, 3), 3u);
+  EXPECT_EQ(std::vector<int>(buffer.begin(), buffer.end()), (std::vector<int>{4, 5, 6, 7}));
+  EXPECT_EQ(buffer.back(), 7);
+
+  EXPECT_EQ(buffer.pop_front_n(out, 10), 4u);
+  EXPECT_EQ(std::vector<int>(out, out + 4), (std::vector<int>{4, 5, 6, 7}));
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(CircularBufferTest, PushBackNFollowsFullPolicy) {
+  const int items[] = {1, 2, 3, 4, 5};
+
+  circular_buffer<int, true> overwriting(3);
+  overwriting.push_back(0);
+  EXPECT_EQ(overwriting.push_back_n(items, 2), 2u);
+  EXPECT_EQ(overwriting.push_back_n(items + 2, 1), 1u);  // drops the 0
+  EXPECT_EQ(std::vector<int>(overwriting.begin(), overwriting.end()), (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(overwriting.push_back_n(items, 5), 5u);  // only the last three remain
+  EXPECT_EQ(std::vector<int>(overwriting.begin(), overwriting.end()), (std::vector<int>{3, 4, 5}));
+
+  circular_buffer<int, false> rejecting(3);
+  rejecting.push_back(0);
+  EXPECT_EQ(rejecting.push_back_n(items, 5), 2u);
+  EXPECT_EQ(std::vector<int>(rejecting.begin(), rejecting.end()), (std::vector<int>{0, 1, 2}));
+}
+
+TEST(CircularBufferTest, BulkOperationsHandleNonTrivialTypes) {
+  circular_buffer<std::string> buffer(3);
+  const std::string items[] = {"a", "b", "c", "d"};
+  EXPECT_EQ(buffer.push_back_n(items, 4), 4u);
+  EXPECT_EQ(buffer.front(), "b");
+
+  std::string out[2];
+  EXPECT_EQ(buffer.pop_front_n(out, 2), 2u);
+  EXPECT_EQ(out[0], "b");
+  EXPECT_EQ(out[1], "c");
+  EXPECT_EQ(buffer.pop_front_n(5), 1u);
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(CircularBufferTest, ArraysCoverContentsInOrder) {
+  circular_buffer<int> buffer(4);
+  EXPECT_TRUE(buffer.array_one().empty());
+  EXPECT_TRUE(buffer.array_two().empty());
+
+  for (int i = 0; i < 4; ++i) {
+    buffer.push_back(i);
+  }
+  buffer.pop_front_n(2);
+  buffer.push_back(4);
+  buffer.push_back(5);
+
+  std::vector<int> joined;
+  const auto &view = buffer;
+  for (int value : view.array_one()) {
+    joined.push_back(value);
+  }
+  for (int value : view.array_two()) {
+    joined.push_back(value);
+  }
+  EXPECT_EQ(joined, (std::vector<int>{2, 3, 4, 5}));
+  EXPECT_EQ(buffer.array_one().size() + buffer.array_two().size(), buffer.size());
+
+  buffer.array_one()[0] = 20;
+  EXPECT_EQ(buffer.front(), 20);
+}
+
+TEST(CircularBufferTest, FreeArraysActAsReceiveRing) {
+  circular_buffer<char> ring(8);
+  const char *stream = "abcdefghijkl";
+  size_t offset = 0;
+
+  // Stand-in for recv(): fill the free space in place, then commit
+  auto receive = [&]() {
+    size_t received = 0;
+    for (auto space : {ring.free_array_one(), ring.free_array_two()}) {
+      const size_t n = std::min(space.size(), std::strlen(stream) - offset);
+      std::memcpy(space.data(), stream + offset, n);
+      offset += n;
+      received += n;
+    }
+    ring.commit_back(received);
+    return received;
+  };
+
+  EXPECT_EQ(receive(), 8u);
+  EXPECT_TRUE(ring.full());
+  EXPECT_TRUE(ring.free_array_one().empty());
+  EXPECT_TRUE(ring.free_array_two().empty());
+
+  char consumed[6];
+  EXPECT_EQ(ring.pop_front_n(consumed, 6), 6u);
+  EXPECT_EQ(std::string(consumed, 6), "abcdef");
+
+  EXPECT_EQ(receive(), 4u);
+  char rest[6];
+  EXPECT_EQ(ring.pop_front_n(rest, 6), 6u);
+  EXPECT_EQ(std::string(rest, 6), "ghijkl");
+
+  EXPECT_THROW(ring.commit_back(9), std::length_error);
+}
+
+TEST(CircularBufferTest, Pow2CapacityWrapsWithMask) {
+  fb::pow2_circular_buffer<int> buffer(4);
+  EXPECT_EQ(buffer.capacity(), 4u);
+
+  for (int i = 0; i < 10; ++i) {
+    buffer.push_back(i);  // overwrites, wrapping several times
+  }
+  EXPECT_EQ(std::vector<int>(buffer.begin(), buffer.end()), (std::vector<int>{6, 7, 8, 9}));
+  EXPECT_EQ(buffer[0], 6);
+  EXPECT_EQ(buffer.at(3), 9);
+  EXPECT_EQ(buffer.back(), 9);
+
+  buffer.pop_front();
+  buffer.pop_front();
+  const int more[] = {10, 11};
+  EXPECT_EQ(buffer.push_back_n(more, 2), 2u);
+  EXPECT_EQ(std::vector<int>(buffer.rbegin(), buffer.rend()), (std::vector<int>{11, 10, 9, 8}));
+  EXPECT_EQ(buffer.array_one().size() + buffer.array_two().size(), 4u);
+}
+
+TEST(CircularBufferTest, Pow2CapacityRejectsOtherSizes) {
+  EXPECT_THROW(fb::pow2_circular_buffer<int>(6), std::invalid_argument);
+  EXPECT_THROW(fb::pow2_circular_buffer<int>(0), std::invalid_argument);
+  EXPECT_NO_THROW(fb::pow2_circular_buffer<int>(1));
+
+  fb::pow2_circular_buffer<int, false> buffer(2);
+  buffer.push_back(1);
+  buffer.push_back(2);
+  buffer.push_back(3);  // rejected
+  buffer.reserve(5);    // rounds up
+  EXPECT_EQ(buffer.capacity(), 8u);
+  EXPECT_EQ(std::vector<int>(buffer.begin(), buffer.end()), (std::vector<int>{1, 2}));
+
+  const std::vector<int> source{1, 2, 3, 4, 5};
+  fb::pow2_circular_buffer<int> copied(source.begin(), source.end());
+  EXPECT_EQ(std::vector<int>(copied.begin(), copied.end()), source);
+  EXPECT_EQ(copied.capacity() & (copied.capacity() - 1), 0u);
+}
@@ -0,0 +1,262 @@
+/// @file test_csv_columns.cpp
+/// @brief Unit tests for schema-driven columnar CSV loading
+
+#include <gtest/gtest.h>
+
+#include <fb/csv_columns.h>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fb;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+namespace
+{
+
+/// @brief Load @p cells, one per row, as a single column of @p type
+csv_columns load_one(const std::string& cells, csv_column_type type, int scale = 0)
+{
+  std::istringstream stream("v\n" + cells);
+  return csv_columns(stream, {{"v", type, scale}});
+}
+
+template <typename T>
+std::vector<T> to_vector(span<const T> values)
+{
+  return std::vector<T>(values.begin(), values.end());
+}
+
+/// @brief Whether loading @p cell as @p type throws
+bool rejects(const std::string& cell, csv_column_type type, int scale = 0)
+{
+  try
+  {
+    (void)load_one(cell + "\n", type, scale);
+    return false;
+  }
+  catch (const std::runtime_error&)
+  {
+    return true;
+  }
+}
+
+} // namespace
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+TEST(CSVColumnsTest, LoadsSchemaColumnsByName)
+{
+  std::istringstream stream("time,sym,px,qty,note\n"
+                            "2026-10-14T09:30:00Z,EURUSD,1.0712,100,first\n"
+                            "2026-10-14T09:30:01.5Z,USDJPY,149.25,-20,\"second, quoted\"\n"
+                            "2026-10-14T09:30:02Z,EURUSD,1.0713,35,third\n");
+  const csv_schema schema = {
+      {"qty", csv_column_type::int64},
+      {"px", csv_column_type::decimal, 4},
+      {"sym", csv_column_type::dictionary},
+      {"time", csv_column_type::timestamp},
+  };
+  csv_columns trades(stream, schema);
+
+  EXPECT_EQ(trades.row_count(), 3u);
+  EXPECT_EQ(trades.column_count(), 4u);
+  EXPECT_EQ(trades.column_index("sym"), 2u);
+
+  EXPECT_EQ(to_vector(trades.int64s("qty")), (std::vector<std::int64_t>{100, -20, 35}));
+  EXPECT_EQ(to_vector(trades.decimals("px")), (std::vector<std::int64_t>{10712, 1492500, 10713}));
+  EXPECT_EQ(to_vector(trades.codes("sym")), (std::vector<std::uint32_t>{0, 1, 0}));
+  EXPECT_EQ(trades.dictionary("sym"), (std::vector<std::string>{"EURUSD", "USDJPY"}));
+
+  const std::int64_t open = 1'791'970'200'000'000'000; // 2026-10-14T09:30:00Z
+  EXPECT_EQ(to_vector(trades.timestamps(3)),
+            (std::vector<std::int64_t>{open, open + 1'500'000'000, open + 2'000'000'000}));
+}
+
+TEST(CSVColumnsTest, WithoutHeadersTheSchemaIsPositional)
+{
+  std::istringstream stream("1;2.5;x\n3;-0.25;y\n");
+  csv_config         config;
+  config.has_headers = false;
+  config.delimiter   = ';';
+  csv_columns table(stream, {{"id", csv_column_type::int64}, {"value", csv_column_type::float64}}, config);
+
+  EXPECT_EQ(table.row_count(), 2u);
+  EXPECT_EQ(to_vector(table.int64s(0)), (std::vector<std::int64_t>{1, 3}));
+  EXPECT_EQ(to_vector(table.doubles("value")), (std::vector<double>{2.5, -0.25}));
+}
+
+TEST(CSVColumnsTest, EmptyInput)
+{
+  std::istringstream stream("");
+  csv_columns        table(stream, {{"v", csv_column_type::int64}});
+
+  EXPECT_EQ(table.row_count(), 0u);
+  EXPECT_TRUE(table.int64s("v").empty());
+}
+
+// ============================================================================
+// Conversions
+// ============================================================================
+
+TEST(CSVColumnsTest, Int64)
+{
+  const csv_columns table = load_one("0\n+7\n-9223372036854775808\n9223372036854775807\n", csv_column_type::int64);
+  EXPECT_EQ(to_vector(table.int64s(0)), (std::vector<std::int64_t>{0, 7, INT64_MIN, INT64_MAX}));
+
+  EXPECT_TRUE(rejects("1.5", csv_column_type::int64));
+  EXPECT_TRUE(rejects("+-1", csv_column_type::int64));
+  EXPECT_TRUE(rejects("12a", csv_column_type::int64));
+  EXPECT_TRUE(rejects("9223372036854775808", csv_column_type::int64));
+}
+
+TEST(CSVColumnsTest, Float64)
+{
+  const auto values = to_vector(load_one("1.5\n-2e3\n+.25\n1E-2\ninf\n", csv_column_type::float64).doubles(0));
+  ASSERT_EQ(values.size(), 5u);
+  EXPECT_EQ(values[0], 1.5);
+  EXPECT_EQ(values[1], -2000.0);
+  EXPECT_EQ(values[2], 0.25);
+  EXPECT_EQ(values[3], 0.01);
+  EXPECT_TRUE(std::isinf(values[4]));
+
+  EXPECT_TRUE(rejects("1,5", csv_column_type::float64));
+  EXPECT_TRUE(rejects("0x10", csv_column_type::float64));
+}
+
+TEST(CSVColumnsTest, Decimal)
+{
+  EXPECT_EQ(to_vector(load_one("1.0712\n-0.5\n3\n.25\n2.5000\n-0\n", csv_column_type::decimal, 4).decimals(0)),
+            (std::vector<std::int64_t>{10712, -5000, 30000, 2500, 25000, 0}));
+  EXPECT_EQ(to_vector(load_one("-922337203685477.5808\n", csv_column_type::decimal, 4).decimals(0)),
+            (std::vector<std::int64_t>{INT64_MIN}));
+  EXPECT_EQ(to_vector(load_one("42\n", csv_column_type::decimal, 0).decimals(0)), (std::vector<std::int64_t>{42}));
+
+  EXPECT_TRUE(rejects("1.07125", csv_column_type::decimal, 4)); // Would round
+  EXPECT_TRUE(rejects("922337203685477.5808", csv_column_type::decimal, 4));
+  EXPECT_TRUE(rejects(".", csv_column_type::decimal, 4));
+  EXPECT_TRUE(rejects("1.2.3", csv_column_type::decimal, 4));
+  EXPECT_TRUE(rejects("1e3", csv_column_type::decimal, 4));
+}
+
+TEST(CSVColumnsTest, Timestamp)
+{
+  const auto values = to_vector(load_one("1970-01-01\n"
+                                         "1969-12-31T23:59:59Z\n"
+                                         "2024-02-29 00:00:00.000000001\n"
+                                         "2026-10-14T11:30:00+02:00\n"
+                                         "2026-10-14T04:30:00-05:00\n",
+                                         csv_column_type::timestamp)
+                                    .timestamps(0));
+  const std::int64_t open = 1'791'970'200'000'000'000; // 2026-10-14T09:30:00Z
+  EXPECT_EQ(values, (std::vector<std::int64_t>{0, -1'000'000'000, 1'709'164'800'000'000'001, open, open}));
+
+  EXPECT_TRUE(rejects("2023-02-29", csv_column_type::timestamp));
+  EXPECT_TRUE(rejects("2026-13-01", csv_column_type::timestamp));
+  EXPECT_TRUE(rejects("2026-10-14T24:00:00", csv_column_type::timestamp));
+  EXPECT_TRUE(rejects("2026-10-14T09:30", csv_column_type::timestamp));
+  EXPECT_TRUE(rejects("2026-10-14T09:30:00.", csv_column_type::timestamp));
+  EXPECT_TRUE(rejects("2026-10-14T09:30:00.0000000001", csv_column_type::timestamp));
+  EXPECT_TRUE(rejects("2026-10-14T09:30:00+0200", csv_column_type::timestamp));
+  EXPECT_TRUE(rejects("2300-01-01", csv_column_type::timestamp)); // Past int64 nanoseconds
+}
+
+TEST(CSVColumnsTest, DictionaryKeepsDistinctValuesOnce)
+{
+  std::istringstream stream("v,n\nb,1\na,2\n,3\nb,4\nb,5\na,6\n");
+  const csv_columns  table(stream, {{"v", csv_column_type::dictionary}});
+
+  EXPECT_EQ(to_vector(table.codes(0)), (std::vector<std::uint32_t>{0, 1, 2, 0, 0, 1}));
+  EXPECT_EQ(table.dictionary(0), (std::vector<std::string>{"b", "a", ""}));
+}
+
+// ============================================================================
+// Errors
+// ============================================================================
+
+TEST(CSVColumnsTest, ConversionErrorsNameTheCell)
+{
+  std::istringstream stream("id,qty\n1,10\n2,ten\n");
+  try
+  {
+    csv_columns table(stream, {{"qty", csv_column_type::int64}});
+    FAIL() << "expected std::runtime_error";
+  }
+  catch (const std::runtime_error& e)
+  {
+    EXPECT_STREQ(e.what(), "csv_columns: invalid int64 \"ten\" in column \"qty\" at line 3 in <stream>");
+  }
+}
+
+TEST(CSVColumnsTest, MissingCellsAreErrorsButForDictionaries)
+{
+  csv_config config;
+  config.strict_mode = false;
+
+  std::istringstream numbers("a,b\n1,2\n3\n");
+  EXPECT_THROW(csv_columns(numbers, {{"b", csv_column_type::int64}}, config), std::runtime_error);
+
+  std::istringstream strings("a,b\n1,2\n3\n");
+  csv_columns        table(strings, {{"b", csv_column_type::dictionary}}, config);
+  EXPECT_EQ(table.dictionary("b"), (std::vector<std::string>{"2", ""}));
+}
+
+TEST(CSVColumnsTest, InvalidSchemas)
+{
+  auto load = [](const csv_schema& schema) {
+    std::istringstream stream("a,b\n1,2\n");
+    return csv_columns(stream, schema);
+  };
+
+  EXPECT_THROW(load({{"c", csv_column_type::int64}}), std::invalid_argument);
+  EXPECT_THROW(load({{"a", csv_column_type::int64}, {"a", csv_column_type::float64}}), std::invalid_argument);
+  EXPECT_THROW(load({{"a", csv_column_type::decimal, 19}}), std::invalid_argument);
+  EXPECT_THROW(load({{"a", csv_column_type::decimal, -1}}), std::invalid_argument);
+}
+
+TEST(CSVColumnsTest, AccessErrors)
+{
+  const csv_columns table = load_one("1\n", csv_column_type::int64);
+
+  EXPECT_THROW((void)table.int64s(1), std::out_of_range);
+  EXPECT_THROW((void)table.int64s("w"), std::invalid_argument);
+  EXPECT_THROW((void)table.doubles(0), std::invalid_argument);
+  EXPECT_THROW((void)table.decimals("v"), std::invalid_argument);
+  EXPECT_THROW((void)table.dictionary(0), std::invalid_argument);
+}
+
+// ============================================================================
+// File-Based Tests
+// ============================================================================
+
+TEST(CSVColumnsTest, ConstructFromFilePath)
+{
+  const std::filesystem::path temp_path = std::filesystem::temp_directory_path() / "test_csv_columns.csv";
+  {
+    std::ofstream file(temp_path, std::ios::binary);
+    file << "Name,Age\nAlice,30\nBob,25\n";
+  }
+
+  {
+    csv_columns table(temp_path, {{"Age", csv_column_type::int64}});
+    EXPECT_EQ(to_vector(table.int64s("Age")), (std::vector<std::int64_t>{30, 25}));
+  }
+
+  std::filesystem::remove(temp_path);
+}
+
+TEST(CSVColumnsTest, FileNotFound)
+{
+  EXPECT_THROW(csv_columns(std::filesystem::path("/nonexistent/path/file.csv"), {{"a", csv_column_type::int64}}),
+               std::runtime_error);
+}
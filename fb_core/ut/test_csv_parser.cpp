@@ -8,6 +8,8 @@
 #include <sstream>
 #include <fstream>
 #include <filesystem>
+#include <string>
+#include <vector>
 
 using namespace fb;
 
@@ -447,6 +449,21 @@ TEST(CSVParserTest, InvalidUTF8_Strict)
   EXPECT_THROW(make_parser("Hello,\x80world\n", config), std::runtime_error);
 }
 
+TEST(CSVParserTest, InvalidUTF8_AfterLongASCIIRun)
+{
+  csv_config config;
+  config.has_headers   = false;
+  config.validate_utf8 = true;
+
+  // Multi-byte sequences and errors past the eight-byte ASCII fast path
+  auto parser = make_parser("reference data \xe4\xb8\x96,0123456789abcdef\xc3\xa9\n", config);
+  ASSERT_EQ(parser.row_count(), 1u);
+  EXPECT_EQ(parser.get_row(0)[1], "0123456789abcdef\xc3\xa9");
+
+  EXPECT_THROW(make_parser("0123456789abcdef\x80\n", config), std::runtime_error);
+  EXPECT_THROW(make_parser("0123456789abcde\xe4\xb8\n", config), std::runtime_error);
+}
+
 TEST(CSVParserTest, InvalidUTF8_NoValidation)
 {
   csv_config config;
@@ -506,6 +523,64 @@ TEST(CSVParserTest, EmptyIterator)
   EXPECT_EQ(parser.begin(), parser.end());
 }
 
+// ============================================================================
+// Column Handle Tests
+// ============================================================================
+
+TEST(CSVParserTest, ColumnHandleReadsRowsAsViews)
+{
+  auto       parser = make_parser("sym,px,qty\nAAPL,189.5,100\nMSFT, 402.25 ,-20\n");
+  const auto px     = parser.column("px");
+  const auto qty    = parser.column("qty");
+  EXPECT_EQ(px.index(), 1u);
+
+  double    notional = 0.0;
+  long long shares   = 0;
+  for (csv_parser::size_type r = 0; r < parser.row_count(); ++r)
+  {
+    const auto row = parser.row(r);
+    EXPECT_EQ(row.index(), r);
+    notional += row.as<double>(px) * row.as<double>(qty);
+    shares += row.as<long long>(qty);
+    EXPECT_EQ(row.as<int>(qty), row.as<long>(qty));
+  }
+  EXPECT_DOUBLE_EQ(notional, 189.5 * 100 - 402.25 * 20);
+  EXPECT_EQ(shares, 80);
+
+  // Views point into the parser's cells, not copies
+  const auto sym = parser.column(0);
+  EXPECT_EQ(parser.cell(1, sym), "MSFT");
+  EXPECT_EQ(parser.row(0)[sym].data(), parser.begin()->front().data());
+}
+
+TEST(CSVParserTest, ColumnHandleShortRowsAndErrors)
+{
+  csv_config config;
+  config.strict_mode = false;
+  auto parser        = make_parser("a,b,c\n1,x\n", config);
+
+  const auto c = parser.column("c");
+  EXPECT_EQ(parser.row(0).size(), 2u);
+  EXPECT_EQ(parser.cell(0, c), "");
+  EXPECT_THROW(static_cast<void>(parser.row(0).as<double>(c)), std::runtime_error);
+  EXPECT_THROW(static_cast<void>(parser.row(0).as<unsigned long>(parser.column("b"))), std::runtime_error);
+
+  EXPECT_THROW(static_cast<void>(parser.column("missing")), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(parser.column(3)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(parser.row(1)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(parser.cell(1, c)), std::out_of_range);
+
+  try
+  {
+    static_cast<void>(parser.row(0).as<int>(parser.column("b")));
+    FAIL() << "expected std::runtime_error";
+  }
+  catch (const std::runtime_error& e)
+  {
+    EXPECT_EQ(std::string(e.what()), "csv_parser: invalid int \"x\" in row 0, column 1 in <stream>");
+  }
+}
+
 // ============================================================================
 // RFC 4180 Output Tests
 // ============================================================================
@@ -822,6 +897,32 @@ TEST(CSVParserTest, TV013_UnclosedQuotedField)
   EXPECT_THROW(make_parser("\"a,b\n", config), std::runtime_error);
 }
 
+TEST(CSVParserTest, FieldsAcrossBlockBoundaries)
+{
+  // Plain fields are found 64 bytes at a time: fields of every length up
+  // to three blocks, so each one ends at every offset of a block
+  std::string                           csv;
+  std::vector<std::vector<std::string>> expected;
+  for (std::size_t length = 0; length < 192; ++length)
+  {
+    const std::string plain(length, 'x');
+    const std::string quoted = std::string(length / 2, ',') + "\n" + std::string(length / 2, 'q');
+    csv += plain + ",\"" + quoted + "\",\"a\"\"" + plain + "\"\n";
+    expected.push_back({plain, quoted, "a\"" + plain});
+  }
+
+  csv_config config;
+  config.has_headers = false;
+  config.strict_mode = true;
+  auto parser        = make_parser(csv, config);
+
+  ASSERT_EQ(parser.row_count(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i)
+  {
+    EXPECT_EQ(parser.get_row(i), expected[i]) << "row " << i;
+  }
+}
+
 // ============================================================================
 // File-Based Tests
 // ============================================================================
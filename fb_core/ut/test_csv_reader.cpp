@@ -0,0 +1,318 @@
+/// @file test_csv_reader.cpp
+/// @brief Unit tests for the streaming csv_reader
+
+#include <gtest/gtest.h>
+
+#include <fb/csv_reader.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fb;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+namespace
+{
+
+using table = std::vector<csv_parser::row_type>;
+
+/// @brief Rows of a csv_parser, or the error it throws
+std::string parse_with_parser(const std::string& input, const csv_config& config, table& rows,
+                              std::vector<std::string>& headers)
+{
+  try
+  {
+    std::istringstream stream(input);
+    csv_parser         parser(stream, config);
+    rows    = table(parser.begin(), parser.end());
+    headers = parser.get_headers();
+    return {};
+  }
+  catch (const std::exception& e)
+  {
+    return e.what();
+  }
+}
+
+/// @brief Rows of a csv_reader, or the error it throws with its prefix
+/// changed to csv_parser's
+std::string parse_with_reader(const std::string& input, const csv_config& config, std::size_t buffer_size,
+                              table& rows, std::vector<std::string>& headers)
+{
+  try
+  {
+    std::istringstream stream(input);
+    csv_reader         reader(stream, config, buffer_size);
+    headers = reader.get_headers();
+    while (reader.read_row())
+    {
+      rows.emplace_back(reader.row().begin(), reader.row().end());
+    }
+    return {};
+  }
+  catch (const std::exception& e)
+  {
+    std::string            message = e.what();
+    const std::string_view prefix  = "csv_reader";
+    if (message.compare(0, prefix.size(), prefix) == 0)
+    {
+      message.replace(0, prefix.size(), "csv_parser");
+    }
+    return message;
+  }
+}
+
+void expect_same_as_parser(const std::string& input, const csv_config& config)
+{
+  table                    expected_rows;
+  std::vector<std::string> expected_headers;
+  const std::string expected_error = parse_with_parser(input, config, expected_rows, expected_headers);
+
+  for (std::size_t buffer_size : {std::size_t{4}, std::size_t{5}, std::size_t{7}, std::size_t{64}})
+  {
+    table                    actual_rows;
+    std::vector<std::string> actual_headers;
+    const std::string actual_error = parse_with_reader(input, config, buffer_size, actual_rows, actual_headers);
+
+    if (actual_error.rfind("csv_parser: duplicate header", 0) == 0)
+    {
+      // The reader checks headers before reading on; the parser after the
+      // whole input, so it may report a later error first
+      EXPECT_FALSE(expected_error.empty()) << '"' << input << "\" " << buffer_size;
+      continue;
+    }
+    EXPECT_EQ(actual_error, expected_error) << '"' << input << "\" " << buffer_size;
+    if (expected_error.empty() && actual_error.empty())
+    {
+      EXPECT_EQ(actual_rows, expected_rows) << '"' << input << "\" " << buffer_size;
+      EXPECT_EQ(actual_headers, expected_headers) << '"' << input << "\" " << buffer_size;
+    }
+  }
+}
+
+std::vector<csv_config> all_configs()
+{
+  std::vector<csv_config> configs;
+  for (int bits = 0; bits < 16; ++bits)
+  {
+    csv_config config;
+    config.has_headers     = (bits & 1) != 0;
+    config.trim_whitespace = (bits & 2) != 0;
+    config.strict_mode     = (bits & 4) != 0;
+    config.delimiter       = (bits & 8) != 0 ? ';' : ',';
+    configs.push_back(config);
+  }
+  return configs;
+}
+
+} // namespace
+
+// ============================================================================
+// Equivalence with csv_parser
+// ============================================================================
+
+TEST(CSVReaderTest, MatchesParserOnEdgeCases)
+{
+  const std::vector<std::string> inputs = {
+      "",
+      "\n",
+      "a",
+      "a,b\n1,2\n",
+      "a,b\r\n1,2\r\n",
+      "a,b\r1,2\r",
+      "a,b\n1,2",
+      "a,b\n1,\n",
+      "a,b\n1,2,\n",
+      "a;b\n1;2\n",
+      "a,b\n\n1,2\n",
+      "a,b\n1\n",
+      "a,b\n1,2,3\n",
+      "\"a\",\"b\"\n\"1\",\"2\"\n",
+      "a,b\n\"x,y\",\"line1\nline2\"\n",
+      "a,b\n\"say \"\"hi\"\"\",2\n",
+      "a,b\n\"\"\"\",\"\"\n",
+      "a,b\n\"x\"  ,2\n",
+      "a,b\n\"x\" y,2\n",
+      "a,b\n\"x\"\"\" y\"z ,2\n",
+      "a,b\n\"open\n",
+      "a,b\nx\"y,2\n",
+      "a,b\n  x  ,\t2 \n",
+      "\xEF\xBB\xBFName,Age\nAlice,30\n",
+      "\xEF\xBB",
+      "a,a\n1,2\n",
+      "a,b\n\xC3\xA9,\xFF\n",
+      "a,b\n\xC3,1\n",
+      "a,b\n\"1\n2\",x\ny\n",
+  };
+
+  for (const csv_config& config : all_configs())
+  {
+    for (const std::string& input : inputs)
+    {
+      expect_same_as_parser(input, config);
+    }
+  }
+}
+
+TEST(CSVReaderTest, MatchesParserOnRandomInputs)
+{
+  std::mt19937           rng(92);
+  const std::string_view alphabet = "ab ,;\"\r\n";
+  for (int i = 0; i < 500; ++i)
+  {
+    std::string input(rng() % 24, ' ');
+    for (char& ch : input)
+    {
+      ch = alphabet[rng() % alphabet.size()];
+    }
+    for (const csv_config& config : all_configs())
+    {
+      expect_same_as_parser(input, config);
+    }
+  }
+}
+
+TEST(CSVReaderTest, MatchesParserOnLongRandomInputs)
+{
+  // Rows a few 64-byte blocks long, with sparse quotes and separators
+  std::mt19937           rng(94);
+  const std::string_view alphabet = "abcdefghijklmnopqrstuvwxyz ,;\"\r\n";
+  for (int i = 0; i < 200; ++i)
+  {
+    std::string input(rng() % 400, ' ');
+    for (char& ch : input)
+    {
+      ch = alphabet[rng() % alphabet.size()];
+    }
+    for (const csv_config& config : all_configs())
+    {
+      expect_same_as_parser(input, config);
+    }
+  }
+}
+
+// ============================================================================
+// Reading Styles
+// ============================================================================
+
+TEST(CSVReaderTest, PullRowsAndHeaders)
+{
+  std::istringstream stream("sym,px\nEURUSD,1.07\nUSDJPY,149.2\n");
+  csv_reader         reader(stream);
+
+  EXPECT_EQ(reader.get_headers(), (std::vector<std::string>{"sym", "px"}));
+  const auto px = reader.column_index("px");
+  EXPECT_EQ(px, 1u);
+
+  ASSERT_TRUE(reader.read_row());
+  EXPECT_EQ(reader.row()[px], "1.07");
+  EXPECT_EQ(reader.line_number(), 2u);
+  ASSERT_TRUE(reader.read_row());
+  EXPECT_EQ(reader.row()[0], "USDJPY");
+  EXPECT_FALSE(reader.read_row());
+  EXPECT_TRUE(reader.row().empty());
+  EXPECT_EQ(reader.rows_read(), 2u);
+
+  EXPECT_THROW((void)reader.column_index("qty"), std::invalid_argument);
+}
+
+TEST(CSVReaderTest, CallbackCanStopEarly)
+{
+  std::istringstream stream("n\n1\n2\n3\n4\n");
+  csv_reader         reader(stream);
+
+  std::vector<std::string> seen;
+  const auto count = reader.for_each_row([&](const csv_reader::row_type& row) {
+    seen.emplace_back(row[0]);
+    return row[0] != "2";
+  });
+  EXPECT_EQ(count, 2u);
+  EXPECT_EQ(seen, (std::vector<std::string>{"1", "2"}));
+
+  // A void callback reads the rest
+  EXPECT_EQ(reader.for_each_row([&](const csv_reader::row_type& row) { seen.emplace_back(row[0]); }), 2u);
+  EXPECT_EQ(seen.back(), "4");
+}
+
+TEST(CSVReaderTest, RangeFor)
+{
+  std::istringstream stream("a;b\n1;2\n3;4\n");
+  csv_config         config;
+  config.has_headers = false;
+  config.delimiter   = ';';
+
+  std::vector<std::string> first_fields;
+  for (const auto& row : csv_reader(stream, config))
+  {
+    first_fields.emplace_back(row[0]);
+  }
+  EXPECT_EQ(first_fields, (std::vector<std::string>{"a", "1", "3"}));
+}
+
+// ============================================================================
+// Buffering
+// ============================================================================
+
+TEST(CSVReaderTest, RowLongerThanTheBuffer)
+{
+  const std::string  long_field(100000, 'x');
+  std::istringstream stream("k,v\n1,\"" + long_field + "\"\"\"\n2," + long_field + "\n");
+  csv_reader         reader(stream, {}, 16);
+
+  ASSERT_TRUE(reader.read_row());
+  EXPECT_EQ(reader.row()[1], long_field + "\"");
+  ASSERT_TRUE(reader.read_row());
+  EXPECT_EQ(reader.row()[1], long_field);
+  EXPECT_FALSE(reader.read_row());
+}
+
+TEST(CSVReaderTest, ManyRowsThroughSmallBuffer)
+{
+  std::string input = "id,text\n";
+  for (int i = 0; i < 10000; ++i)
+  {
+    input += std::to_string(i) + ",\"row " + std::to_string(i) + "\"\r\n";
+  }
+  std::istringstream stream(input);
+  csv_reader         reader(stream, {}, 64);
+
+  std::size_t next = 0;
+  reader.for_each_row([&](const csv_reader::row_type& row) {
+    EXPECT_EQ(row[0], std::to_string(next));
+    ++next;
+  });
+  EXPECT_EQ(next, 10000u);
+  EXPECT_EQ(reader.rows_read(), 10000u);
+}
+
+// ============================================================================
+// File-Based Tests
+// ============================================================================
+
+TEST(CSVReaderTest, ConstructFromFilePath)
+{
+  const std::filesystem::path temp_path = std::filesystem::temp_directory_path() / "test_csv_reader.csv";
+  {
+    std::ofstream file(temp_path, std::ios::binary);
+    file << "Name,Age\nAlice,30\nBob,25\n";
+  }
+
+  {
+    csv_reader reader(temp_path);
+    EXPECT_EQ(reader.for_each_row([](const csv_reader::row_type&) {}), 2u);
+  }
+
+  std::filesystem::remove(temp_path);
+}
+
+TEST(CSVReaderTest, FileNotFound)
+{
+  EXPECT_THROW(csv_reader(std::filesystem::path("/nonexistent/path/file.csv")), std::runtime_error);
+}
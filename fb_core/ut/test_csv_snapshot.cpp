@@ -0,0 +1,222 @@
+/// @file test_csv_snapshot.cpp
+/// @brief Unit tests for csv_snapshot files
+
+#include <gtest/gtest.h>
+
+#include <fb/csv_snapshot.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fb;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+namespace
+{
+
+/// @brief A CSV file and a snapshot path in the temp directory, removed on destruction
+class snapshot_files
+{
+public:
+  explicit snapshot_files(const std::string& name)
+      : csv(std::filesystem::temp_directory_path() / (name + ".csv"))
+      , snapshot(std::filesystem::temp_directory_path() / (name + ".fbcs"))
+  {
+  }
+
+  ~snapshot_files()
+  {
+    std::error_code ignored;
+    std::filesystem::remove(csv, ignored);
+    std::filesystem::remove(snapshot, ignored);
+  }
+
+  void write_csv(const std::string& text) const
+  {
+    std::ofstream(csv, std::ios::binary) << text;
+  }
+
+  const std::filesystem::path csv;
+  const std::filesystem::path snapshot;
+};
+
+/// @brief Flip one byte of @p path at @p offset
+void corrupt(const std::filesystem::path& path, std::streamoff offset)
+{
+  std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+  file.seekg(offset);
+  const char byte = static_cast<char>(file.get());
+  file.seekp(offset);
+  file.put(static_cast<char>(byte ^ 0x5a));
+}
+
+} // namespace
+
+// ============================================================================
+// Round Trip
+// ============================================================================
+
+TEST(CSVSnapshotTest, RoundTripMatchesParser)
+{
+  snapshot_files files("test_csv_snapshot_round_trip");
+  std::istringstream input("sym,px,note\r\nAAPL,189.5,\"quoted, with comma\"\r\nMSFT,402.25,\"say \"\"hi\"\"\"\r\n"
+                           "EMPTY,,\r\n");
+  const csv_parser   parsed(input);
+  csv_snapshot::write(parsed, files.snapshot);
+
+  const csv_snapshot snapshot(files.snapshot);
+  ASSERT_EQ(snapshot.row_count(), parsed.row_count());
+  ASSERT_EQ(snapshot.column_count(), parsed.column_count());
+  EXPECT_EQ(snapshot.get_headers(), std::vector<std::string_view>({"sym", "px", "note"}));
+
+  std::size_t row_index = 0;
+  for (const auto& row : snapshot)
+  {
+    EXPECT_EQ(row.to_strings(), parsed.get_row(row_index));
+    ++row_index;
+  }
+  EXPECT_EQ(row_index, parsed.row_count());
+
+  EXPECT_EQ(snapshot.get_cell(1, "note"), "say \"hi\"");
+  EXPECT_EQ(snapshot.get_cell(2, 1), "");
+  EXPECT_EQ(snapshot.get_column("px"), std::vector<std::string_view>({"189.5", "402.25", ""}));
+}
+
+TEST(CSVSnapshotTest, RaggedRowsAndNoHeaders)
+{
+  snapshot_files files("test_csv_snapshot_ragged");
+  csv_config     config;
+  config.has_headers = false;
+  config.strict_mode = false;
+  config.delimiter   = ';';
+
+  std::istringstream input("a;b;c\nd\ne;f\n");
+  const csv_parser   parsed(input, config);
+  csv_snapshot::write(parsed, files.snapshot);
+
+  const csv_snapshot snapshot(files.snapshot);
+  EXPECT_EQ(snapshot.config().delimiter, ';');
+  EXPECT_FALSE(snapshot.config().has_headers);
+  EXPECT_FALSE(snapshot.config().strict_mode);
+  EXPECT_TRUE(snapshot.get_headers().empty());
+  EXPECT_EQ(snapshot.column_count(), 3u);
+  EXPECT_EQ(snapshot.get_row(1).size(), 1u);
+  EXPECT_EQ(snapshot.get_cell(1, 2), "");
+  EXPECT_EQ(snapshot.get_cell(2, 1), "f");
+  EXPECT_THROW(static_cast<void>(snapshot.get_cell(0, "a")), std::invalid_argument);
+}
+
+TEST(CSVSnapshotTest, ViewsSurviveMove)
+{
+  snapshot_files files("test_csv_snapshot_move");
+  std::istringstream input("k,v\nkey,value\n");
+  csv_snapshot::write(csv_parser(input), files.snapshot);
+
+  csv_snapshot           first(files.snapshot);
+  const std::string_view cell = first.get_cell(0, "v");
+  const csv_snapshot     second(std::move(first));
+  EXPECT_EQ(cell, "value");
+  EXPECT_EQ(second.get_cell(0, "k"), "key");
+}
+
+TEST(CSVSnapshotTest, AccessErrors)
+{
+  snapshot_files files("test_csv_snapshot_access");
+  std::istringstream input("a,b\n1,2\n");
+  csv_snapshot::write(csv_parser(input), files.snapshot);
+
+  const csv_snapshot snapshot(files.snapshot);
+  EXPECT_THROW(static_cast<void>(snapshot.get_row(1)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(snapshot.get_cell(0, 2)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(snapshot.get_column(2)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(snapshot.get_cell(0, "c")), std::invalid_argument);
+}
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+TEST(CSVSnapshotTest, RejectsDamagedFiles)
+{
+  snapshot_files files("test_csv_snapshot_damaged");
+  std::istringstream input("name,value\nalpha,1\nbeta,2\n");
+  csv_snapshot::write(csv_parser(input), files.snapshot);
+  const auto size = static_cast<std::streamoff>(std::filesystem::file_size(files.snapshot));
+
+  // Last byte of the text: caught by the payload checksum only
+  corrupt(files.snapshot, size - 1);
+  EXPECT_THROW(csv_snapshot{files.snapshot}, std::runtime_error);
+  EXPECT_NO_THROW(csv_snapshot(files.snapshot, false));
+  corrupt(files.snapshot, size - 1);
+  EXPECT_NO_THROW(csv_snapshot{files.snapshot});
+
+  // The header, which is always checked
+  corrupt(files.snapshot, 20);
+  EXPECT_THROW(csv_snapshot(files.snapshot, false), std::runtime_error);
+  corrupt(files.snapshot, 20);
+
+  // Truncated
+  std::filesystem::resize_file(files.snapshot, static_cast<std::uintmax_t>(size - 3));
+  EXPECT_THROW(csv_snapshot(files.snapshot, false), std::runtime_error);
+
+  // Not a snapshot at all
+  files.write_csv("name,value\n");
+  EXPECT_THROW(csv_snapshot{files.csv}, std::runtime_error);
+  EXPECT_THROW(csv_snapshot{std::filesystem::path("/nonexistent/path/file.fbcs")}, std::runtime_error);
+}
+
+// ============================================================================
+// load_or_build
+// ============================================================================
+
+TEST(CSVSnapshotTest, LoadOrBuildReusesAnUnchangedSource)
+{
+  snapshot_files files("test_csv_snapshot_reuse");
+  files.write_csv("id,qty\n1,100\n2,200\n");
+
+  {
+    const auto built = csv_snapshot::load_or_build(files.csv, files.snapshot);
+    EXPECT_EQ(built.source(), csv_snapshot::source_stamp::of(files.csv));
+    EXPECT_EQ(built.get_cell(1, "qty"), "200");
+  }
+
+  // A snapshot that is still current is used as it is, however stale its cells
+  std::istringstream other("id,qty\n1,999\n2,200\n");
+  csv_snapshot::write(csv_parser(other), files.snapshot, csv_snapshot::source_stamp::of(files.csv));
+  EXPECT_EQ(csv_snapshot::load_or_build(files.csv, files.snapshot).get_cell(0, "qty"), "999");
+
+  // Another config parses again
+  csv_config config;
+  config.has_headers = false;
+  const auto no_headers = csv_snapshot::load_or_build(files.csv, files.snapshot, config);
+  EXPECT_EQ(no_headers.row_count(), 3u);
+  EXPECT_EQ(no_headers.get_cell(1, 1), "100");
+}
+
+TEST(CSVSnapshotTest, LoadOrBuildRebuildsAChangedSource)
+{
+  snapshot_files files("test_csv_snapshot_rebuild");
+  files.write_csv("id,qty\n1,100\n");
+  EXPECT_EQ(csv_snapshot::load_or_build(files.csv, files.snapshot).row_count(), 1u);
+
+  // Same size, later mtime
+  files.write_csv("id,qty\n1,500\n");
+  std::filesystem::last_write_time(files.csv,
+                                   std::filesystem::last_write_time(files.csv) + std::chrono::seconds(2));
+  EXPECT_EQ(csv_snapshot::load_or_build(files.csv, files.snapshot).get_cell(0, "qty"), "500");
+
+  // Damaged snapshot
+  corrupt(files.snapshot, 0);
+  EXPECT_EQ(csv_snapshot::load_or_build(files.csv, files.snapshot).get_cell(0, "qty"), "500");
+  EXPECT_NO_THROW(csv_snapshot{files.snapshot});
+
+  EXPECT_THROW(static_cast<void>(csv_snapshot::load_or_build("/nonexistent/path/file.csv", files.snapshot)),
+               std::runtime_error);
+}
@@ -0,0 +1,449 @@
+/// @file test_csv_view.cpp
+/// @brief Unit tests for the zero-copy csv_view reader
+
+#include <gtest/gtest.h>
+
+#include <fb/csv_view.h>
+#include <fb/thread_pool.h>
+
+#include <filesystem>
+#include <future>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fb;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+namespace
+{
+
+using table = std::vector<csv_parser::row_type>;
+
+/// @brief Rows of a csv_parser, or the error it throws
+std::string parse_with_parser(const std::string& input, const csv_config& config, table& rows,
+                              std::vector<std::string>& headers)
+{
+  try
+  {
+    std::istringstream stream(input);
+    csv_parser         parser(stream, config);
+    rows    = table(parser.begin(), parser.end());
+    headers = parser.get_headers();
+    return {};
+  }
+  catch (const std::exception& e)
+  {
+    return e.what();
+  }
+}
+
+/// @brief Rows of a csv_view, or the error it throws, with its prefix and
+/// source name changed to csv_parser's
+std::string parse_with_view(const std::string& input, const csv_config& config, table& rows,
+                            std::vector<std::string>& headers)
+{
+  try
+  {
+    auto view = csv_view::from_buffer(input, config);
+    for (const auto& row : view)
+    {
+      rows.push_back(row.to_strings());
+    }
+    for (std::string_view header : view.get_headers())
+    {
+      headers.emplace_back(header);
+    }
+    return {};
+  }
+  catch (const std::exception& e)
+  {
+    std::string message = e.what();
+    const std::string_view prefix = "csv_view";
+    if (message.compare(0, prefix.size(), prefix) == 0)
+    {
+      message.replace(0, prefix.size(), "csv_parser");
+    }
+    const std::string_view source = "<buffer>";
+    if (message.size() >= source.size() && message.compare(message.size() - source.size(), source.size(), source) == 0)
+    {
+      message.replace(message.size() - source.size(), source.size(), "<stream>");
+    }
+    return message;
+  }
+}
+
+void expect_same_as_parser(const std::string& input, const csv_config& config)
+{
+  table                    expected_rows;
+  table                    actual_rows;
+  std::vector<std::string> expected_headers;
+  std::vector<std::string> actual_headers;
+
+  const std::string expected_error = parse_with_parser(input, config, expected_rows, expected_headers);
+  const std::string actual_error   = parse_with_view(input, config, actual_rows, actual_headers);
+
+  EXPECT_EQ(actual_error, expected_error) << '"' << input << '"';
+  if (expected_error.empty() && actual_error.empty())
+  {
+    EXPECT_EQ(actual_rows, expected_rows) << '"' << input << '"';
+    EXPECT_EQ(actual_headers, expected_headers) << '"' << input << '"';
+  }
+}
+
+std::vector<csv_config> all_configs()
+{
+  std::vector<csv_config> configs;
+  for (int bits = 0; bits < 16; ++bits)
+  {
+    csv_config config;
+    config.has_headers     = (bits & 1) != 0;
+    config.trim_whitespace = (bits & 2) != 0;
+    config.strict_mode     = (bits & 4) != 0;
+    config.delimiter       = (bits & 8) != 0 ? ';' : ',';
+    configs.push_back(config);
+  }
+  return configs;
+}
+
+} // namespace
+
+// ============================================================================
+// Equivalence with csv_parser
+// ============================================================================
+
+TEST(CSVViewTest, MatchesParserOnEdgeCases)
+{
+  const std::vector<std::string> inputs = {
+      "",
+      "\n",
+      "a",
+      "a,b\n1,2\n",
+      "a,b\r\n1,2\r\n",
+      "a,b\r1,2\r",
+      "a,b\n1,2",
+      "a,b\n1,\n",
+      "a,b\n1,2,\n",
+      "a;b\n1;2\n",
+      "a,b\n\n1,2\n",
+      "a,b\n1\n",
+      "a,b\n1,2,3\n",
+      "\"a\",\"b\"\n\"1\",\"2\"\n",
+      "a,b\n\"x,y\",\"line1\nline2\"\n",
+      "a,b\n\"say \"\"hi\"\"\",2\n",
+      "a,b\n\"\"\"\",\"\"\n",
+      "a,b\n\"x\"  ,2\n",
+      "a,b\n\"x\" y,2\n",
+      "a,b\n\"x\"\"\" y\"z ,2\n",
+      "a,b\n\"open\n",
+      "a,b\nx\"y,2\n",
+      "a,b\n  x  ,\t2 \n",
+      "\xEF\xBB\xBFName,Age\nAlice,30\n",
+      "a,a\n1,2\n",
+      "a,b\n\xC3\xA9,\xFF\n",
+      "a,b\n\xC3,1\n",
+      "a,b\n\"1\n2\",x\ny\n",
+  };
+
+  for (const csv_config& config : all_configs())
+  {
+    for (const std::string& input : inputs)
+    {
+      expect_same_as_parser(input, config);
+    }
+  }
+}
+
+TEST(CSVViewTest, MatchesParserOnRandomInputs)
+{
+  std::mt19937           rng(91);
+  const std::string_view alphabet = "ab ,;\"\r\n";
+  for (int i = 0; i < 2000; ++i)
+  {
+    std::string input(rng() % 24, ' ');
+    for (char& ch : input)
+    {
+      ch = alphabet[rng() % alphabet.size()];
+    }
+    for (const csv_config& config : all_configs())
+    {
+      expect_same_as_parser(input, config);
+    }
+  }
+}
+
+TEST(CSVViewTest, MatchesParserOnLongRandomInputs)
+{
+  // Rows a few 64-byte blocks long, with sparse quotes and separators
+  std::mt19937           rng(94);
+  const std::string_view alphabet = "abcdefghijklmnopqrstuvwxyz ,;\"\r\n";
+  for (int i = 0; i < 200; ++i)
+  {
+    std::string input(rng() % 400, ' ');
+    for (char& ch : input)
+    {
+      ch = alphabet[rng() % alphabet.size()];
+    }
+    for (const csv_config& config : all_configs())
+    {
+      expect_same_as_parser(input, config);
+    }
+  }
+}
+
+// ============================================================================
+// Parallel Parsing
+// ============================================================================
+
+namespace
+{
+
+/// @brief Rows, headers and column count of a csv_view, or its error
+std::string describe(const std::function<csv_view()>& make)
+{
+  try
+  {
+    const csv_view view = make();
+    std::string    out  = std::to_string(view.column_count()) + "|";
+    for (std::string_view header : view.get_headers())
+    {
+      out += std::string(header) + "|";
+    }
+    for (const auto& row : view)
+    {
+      out += "\n";
+      for (std::string_view field : row)
+      {
+        out += std::string(field) + "|";
+      }
+    }
+    return out;
+  }
+  catch (const std::exception& e)
+  {
+    return std::string("error: ") + e.what();
+  }
+}
+
+} // namespace
+
+TEST(CSVViewTest, ParallelMatchesSerial)
+{
+  thread_pool            pool(3);
+  std::mt19937           rng(93);
+  const std::string_view alphabet = "ab ,\"\"\r\n\n";
+  for (int i = 0; i < 300; ++i)
+  {
+    std::string input(rng() % 60, ' ');
+    for (char& ch : input)
+    {
+      ch = alphabet[rng() % alphabet.size()];
+    }
+    for (const csv_config& config : all_configs())
+    {
+      const std::string serial = describe([&]() { return csv_view::from_buffer(input, config); });
+      for (std::size_t chunk_size : {std::size_t{1}, std::size_t{3}, std::size_t{16}})
+      {
+        EXPECT_EQ(describe([&]() { return csv_view::from_buffer(input, config, pool, chunk_size); }), serial)
+            << '"' << input << "\" " << chunk_size;
+      }
+    }
+  }
+}
+
+TEST(CSVViewTest, ParallelSplitsInsideQuotedFields)
+{
+  std::string input = "id,text,qty\r\n";
+  for (int i = 0; i < 2000; ++i)
+  {
+    input += std::to_string(i) + ",\"multi\nline, \"\"quoted\"\"\r\ntext " + std::to_string(i) + "\"," +
+             std::to_string(i * 3) + "\r\n";
+  }
+
+  thread_pool pool(4);
+  const auto  serial   = csv_view::from_buffer(input);
+  const auto  parallel = csv_view::from_buffer(input, {}, pool, 257);
+
+  ASSERT_EQ(parallel.row_count(), 2000u);
+  EXPECT_EQ(parallel.column_count(), 3u);
+  for (std::size_t row = 0; row < parallel.row_count(); ++row)
+  {
+    EXPECT_EQ(parallel.get_row(row).to_strings(), serial.get_row(row).to_strings());
+  }
+  EXPECT_EQ(parallel.get_cell(1999, "text"), "multi\nline, \"quoted\"\r\ntext 1999");
+  EXPECT_EQ(parallel.unescaped_bytes(), serial.unescaped_bytes());
+}
+
+TEST(CSVViewTest, ParallelErrorsMatchSerial)
+{
+  std::string input = "a,b\n";
+  for (int i = 0; i < 500; ++i)
+  {
+    input += "x,y\n";
+  }
+  input += "1,2,3\n";
+
+  thread_pool pool(2);
+  try
+  {
+    (void)csv_view::from_buffer(input, {}, pool, 64);
+    FAIL() << "expected an exception";
+  }
+  catch (const std::runtime_error& e)
+  {
+    EXPECT_STREQ(e.what(), "csv_view: inconsistent field count at line 502 (expected 2, got 3) in <buffer>");
+  }
+}
+
+TEST(CSVViewTest, ParallelFromInsideThePool)
+{
+  std::string input = "k,v\n";
+  for (int i = 0; i < 1000; ++i)
+  {
+    input += "key" + std::to_string(i) + ",\"" + std::to_string(i) + "\"\n";
+  }
+
+  // The only worker parses while the calling task holds it
+  thread_pool             pool(1);
+  std::promise<std::size_t> rows;
+  pool.submit([&]() { rows.set_value(csv_view::from_buffer(input, {}, pool, 100).row_count()); });
+  EXPECT_EQ(rows.get_future().get(), 1000u);
+}
+
+// ============================================================================
+// Zero-Copy Behavior
+// ============================================================================
+
+TEST(CSVViewTest, CellsPointIntoTheBuffer)
+{
+  const std::string input = "Name,Note\nAlice,\"plain, quoted\"\nBob,\"say \"\"hi\"\"\"\n";
+  auto              view  = csv_view::from_buffer(input);
+
+  ASSERT_EQ(view.row_count(), 2u);
+  const std::string_view alice = view.get_cell(0, "Name");
+  EXPECT_EQ(alice, "Alice");
+  EXPECT_GE(alice.data(), input.data());
+  EXPECT_LT(alice.data(), input.data() + input.size());
+
+  // A quoted field without escapes is still a view of the input
+  const std::string_view note = view.get_cell(0, "Note");
+  EXPECT_EQ(note, "plain, quoted");
+  EXPECT_GE(note.data(), input.data());
+  EXPECT_LT(note.data(), input.data() + input.size());
+
+  // Only the field with escaped quotes is copied
+  EXPECT_EQ(view.get_cell(1, 1), "say \"hi\"");
+  EXPECT_EQ(view.unescaped_bytes(), std::string_view("say \"hi\"").size());
+}
+
+TEST(CSVViewTest, ViewsSurviveMove)
+{
+  const std::string input = "k,v\n\"a\"\"b\",1\n";
+  auto              view  = csv_view::from_buffer(input);
+  const auto        cell  = view.get_cell(0, 0);
+
+  csv_view moved = std::move(view);
+  EXPECT_EQ(cell, "a\"b");
+  EXPECT_EQ(moved.get_cell(0, "k").data(), cell.data());
+  EXPECT_EQ(moved.get_cell(0, "v"), "1");
+}
+
+// ============================================================================
+// Data Access
+// ============================================================================
+
+TEST(CSVViewTest, RowsColumnsAndMissingFields)
+{
+  csv_config config;
+  config.strict_mode = false;
+  auto view          = csv_view::from_buffer("a,b,c\n1,2\n3,4,5\n", config);
+
+  EXPECT_EQ(view.row_count(), 2u);
+  EXPECT_EQ(view.column_count(), 3u);
+
+  const auto row = view.get_row(0);
+  EXPECT_EQ(row.size(), 2u);
+  EXPECT_EQ(row[2], "");
+  EXPECT_EQ(view.get_cell(0, "c"), "");
+  EXPECT_EQ(view.get_column("c"), (std::vector<std::string_view>{"", "5"}));
+  EXPECT_EQ(view.get_column(0), (std::vector<std::string_view>{"1", "3"}));
+  EXPECT_EQ(view.get_headers(), (std::vector<std::string_view>{"a", "b", "c"}));
+}
+
+TEST(CSVViewTest, AccessErrors)
+{
+  auto view = csv_view::from_buffer("a,b\n1,2\n");
+
+  EXPECT_THROW((void)view.get_row(1), std::out_of_range);
+  EXPECT_THROW((void)view.get_cell(1, 0), std::out_of_range);
+  EXPECT_THROW((void)view.get_cell(0, 2), std::out_of_range);
+  EXPECT_THROW((void)view.get_column(2), std::out_of_range);
+  EXPECT_THROW((void)view.get_cell(0, "missing"), std::invalid_argument);
+
+  csv_config config;
+  config.has_headers = false;
+  auto headerless    = csv_view::from_buffer("1,2\n", config);
+  EXPECT_THROW((void)headerless.get_column("a"), std::invalid_argument);
+}
+
+TEST(CSVViewTest, ErrorsNameTheSource)
+{
+  try
+  {
+    (void)csv_view::from_buffer("a,b\n1\n");
+    FAIL() << "expected an exception";
+  }
+  catch (const std::runtime_error& e)
+  {
+    EXPECT_STREQ(e.what(), "csv_view: inconsistent field count at line 2 (expected 2, got 1) in <buffer>");
+  }
+}
+
+// ============================================================================
+// File-Based Tests
+// ============================================================================
+
+TEST(CSVViewTest, ConstructFromFilePath)
+{
+  const std::filesystem::path temp_path = std::filesystem::temp_directory_path() / "test_csv_view.csv";
+  {
+    std::ofstream file(temp_path, std::ios::binary);
+    file << "Name,Age\r\nAlice,30\r\n\"Bob \"\"B\"\"\",25\r\n";
+  }
+
+  {
+    csv_view view(temp_path);
+    EXPECT_EQ(view.row_count(), 2u);
+    EXPECT_EQ(view.get_cell(0, "Name"), "Alice");
+    EXPECT_EQ(view.get_cell(1, "Name"), "Bob \"B\"");
+    EXPECT_EQ(view.get_cell(1, "Age"), "25");
+  }
+
+  std::filesystem::remove(temp_path);
+}
+
+TEST(CSVViewTest, EmptyFile)
+{
+  const std::filesystem::path temp_path = std::filesystem::temp_directory_path() / "test_csv_view_empty.csv";
+  std::ofstream(temp_path).close();
+
+  {
+    csv_view view(temp_path);
+    EXPECT_EQ(view.row_count(), 0u);
+    EXPECT_EQ(view.column_count(), 0u);
+    EXPECT_TRUE(view.get_headers().empty());
+  }
+
+  std::filesystem::remove(temp_path);
+}
+
+TEST(CSVViewTest, FileNotFound)
+{
+  EXPECT_THROW(csv_view(std::filesystem::path("/nonexistent/path/file.csv")), std::runtime_error);
+}
@@ -0,0 +1,239 @@
+/// @file test_csv_writer.cpp
+/// @brief Unit tests for the buffered csv_writer
+
+#include <gtest/gtest.h>
+
+#include <fb/csv_writer.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fb;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+namespace
+{
+
+/// @brief CSV of @p rows as written by a csv_writer with @p buffer_size
+std::string write_all(const std::vector<std::vector<std::string>>& rows, const csv_config& config = {},
+                      std::size_t buffer_size = CSV_WRITER_BUFFER_SIZE)
+{
+  std::ostringstream out;
+  csv_writer         writer(out, config, buffer_size);
+  for (const auto& row : rows)
+  {
+    writer.write_row(row);
+  }
+  writer.flush();
+  return out.str();
+}
+
+} // namespace
+
+// ============================================================================
+// Fields
+// ============================================================================
+
+TEST(CSVWriterTest, TextAndNumberFields)
+{
+  std::ostringstream out;
+  {
+    csv_writer writer(out);
+    writer.write_row("sym", "px", "qty");
+    writer.field("EURUSD").field(1.0712).field(100).end_row();
+    writer.write_row(std::string("USDJPY"), 149.25, -20);
+    writer.write_row(std::numeric_limits<std::uint64_t>::max(), std::numeric_limits<std::int64_t>::min(), 0.1);
+    EXPECT_EQ(writer.rows_written(), 4u);
+  }
+
+  EXPECT_EQ(out.str(), "sym,px,qty\r\n"
+                       "EURUSD,1.0712,100\r\n"
+                       "USDJPY,149.25,-20\r\n"
+                       "18446744073709551615,-9223372036854775808,0.1\r\n");
+}
+
+TEST(CSVWriterTest, QuotesOnlyWhenNeeded)
+{
+  EXPECT_EQ(write_all({{"plain", "a,b", "say \"hi\"", "two\nlines", "cr\r", ""}}),
+            "plain,\"a,b\",\"say \"\"hi\"\"\",\"two\nlines\",\"cr\r\",\r\n");
+  EXPECT_EQ(write_all({{"\"", "\"\""}}), "\"\"\"\",\"\"\"\"\"\"\r\n");
+}
+
+TEST(CSVWriterTest, SpecialBytesPastTheFirstBlock)
+{
+  // The bytes needing quotes are found 64 at a time
+  for (std::size_t at = 0; at < 200; ++at)
+  {
+    std::string value(200, 'x');
+    value[at] = '"';
+    std::string expected(value);
+    expected.insert(at, 1, '"');
+    EXPECT_EQ(write_all({{value}}), "\"" + expected + "\"\r\n") << at;
+
+    value[at] = ',';
+    EXPECT_EQ(write_all({{value}}), "\"" + value + "\"\r\n") << at;
+  }
+}
+
+TEST(CSVWriterTest, DelimiterDecidesQuoting)
+{
+  csv_config semicolon;
+  semicolon.delimiter = ';';
+  EXPECT_EQ(write_all({{"a,b", "c;d"}}, semicolon), "a,b;\"c;d\"\r\n");
+
+  // A delimiter that numbers contain quotes them
+  csv_config         point;
+  point.delimiter = '.';
+  std::ostringstream out;
+  {
+    csv_writer writer(out, point);
+    writer.write_row(1.5, 2, "x");
+  }
+  EXPECT_EQ(out.str(), "\"1.5\".2.x\r\n");
+}
+
+TEST(CSVWriterTest, DoublesRoundTrip)
+{
+  std::mt19937_64 rng(96);
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double       value = std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+    std::ostringstream out;
+    {
+      csv_writer writer(out);
+      writer.write_row(value);
+    }
+    const std::string text = out.str();
+    EXPECT_EQ(std::stod(text.substr(0, text.size() - 2)), value) << text;
+  }
+}
+
+// ============================================================================
+// Equivalence with the Parsers
+// ============================================================================
+
+TEST(CSVWriterTest, RoundTripsThroughParser)
+{
+  std::mt19937           rng(96);
+  const std::string_view alphabet = "ab ,;\"\r\n";
+  csv_config             config;
+  config.has_headers     = false;
+  config.trim_whitespace = false;
+
+  std::vector<std::vector<std::string>> rows;
+  for (int i = 0; i < 500; ++i)
+  {
+    std::vector<std::string> row;
+    for (int column = 0; column < 3; ++column)
+    {
+      std::string value(rng() % 80, ' ');
+      for (char& ch : value)
+      {
+        ch = alphabet[rng() % alphabet.size()];
+      }
+      row.push_back(value);
+    }
+    rows.push_back(row);
+  }
+
+  for (char delimiter : {',', ';'})
+  {
+    config.delimiter = delimiter;
+    std::istringstream in(write_all(rows, config, 64));
+    csv_parser         parser(in, config);
+    EXPECT_EQ(std::vector<std::vector<std::string>>(parser.begin(), parser.end()), rows);
+  }
+}
+
+TEST(CSVWriterTest, MatchesToRfc4180)
+{
+  std::istringstream in("name,note\nAlice,\"a, b\"\nBob,\"say \"\"hi\"\"\"\n");
+  csv_parser         parser(in);
+
+  std::ostringstream out;
+  {
+    csv_writer writer(out);
+    writer.write_row(parser.get_headers());
+    for (const auto& row : parser)
+    {
+      writer.write_row(row);
+    }
+  }
+  EXPECT_EQ(out.str(), parser.to_rfc_4180());
+}
+
+// ============================================================================
+// Buffering
+// ============================================================================
+
+TEST(CSVWriterTest, FieldLargerThanTheBuffer)
+{
+  std::string value(100000, 'x');
+  value[50000] = '"';
+
+  std::ostringstream out;
+  csv_writer         writer(out, {}, 64);
+  writer.write_row("a", value, "b");
+  EXPECT_EQ(writer.bytes_written(), value.size() + 9);
+  writer.flush();
+
+  std::string expected(value);
+  expected.insert(50000, 1, '"');
+  EXPECT_EQ(out.str(), "a,\"" + expected + "\",b\r\n");
+}
+
+TEST(CSVWriterTest, BuffersUntilFlush)
+{
+  std::ostringstream out;
+  csv_writer         writer(out, {}, 1024);
+  writer.write_row("a", "b");
+  EXPECT_TRUE(out.str().empty());
+  EXPECT_EQ(writer.bytes_written(), 5u);
+
+  writer.flush();
+  EXPECT_EQ(out.str(), "a,b\r\n");
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    writer.write_row(i);
+  }
+  EXPECT_GT(out.str().size(), 5u); // Full buffers went out
+  writer.flush();
+  EXPECT_EQ(out.str().size(), writer.bytes_written());
+}
+
+// ============================================================================
+// File-Based Tests
+// ============================================================================
+
+TEST(CSVWriterTest, ConstructFromFilePath)
+{
+  const std::filesystem::path temp_path = std::filesystem::temp_directory_path() / "test_csv_writer.csv";
+  {
+    csv_writer writer(temp_path);
+    writer.write_row("Name", "Age");
+    writer.write_row("Alice", 30);
+  }
+
+  {
+    std::ifstream file(temp_path, std::ios::binary);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(file), {}), "Name,Age\r\nAlice,30\r\n");
+  }
+
+  std::filesystem::remove(temp_path);
+}
+
+TEST(CSVWriterTest, FileCannotBeOpened)
+{
+  EXPECT_THROW(csv_writer(std::filesystem::path("/nonexistent/path/file.csv")), std::runtime_error);
+}
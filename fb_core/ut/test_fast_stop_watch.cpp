@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <fb/fast_stop_watch.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+constexpr auto SLEEP_PADDING = 2ms;
+
+template <typename Watch>
+void expect_accumulates()
+{
+  Watch watch{false};
+  EXPECT_FALSE(watch.is_running());
+  EXPECT_EQ(watch.elapsed_time(), Watch::duration::zero());
+
+  watch.start();
+  EXPECT_TRUE(watch.is_running());
+  std::this_thread::sleep_for(SLEEP_PADDING);
+  watch.stop();
+  const auto first = watch.elapsed_time();
+  EXPECT_GE(first, SLEEP_PADDING);
+
+  // Stopped time is not counted, and stopping twice changes nothing
+  std::this_thread::sleep_for(SLEEP_PADDING);
+  watch.stop();
+  EXPECT_EQ(watch.elapsed_time(), first);
+
+  watch.start();
+  watch.start();
+  std::this_thread::sleep_for(SLEEP_PADDING);
+  watch.stop();
+  EXPECT_GE(watch.elapsed_time(), first + SLEEP_PADDING);
+  EXPECT_LT(watch.elapsed_time(), first + 1s);
+
+  watch.reset(false);
+  EXPECT_FALSE(watch.is_running());
+  EXPECT_EQ(watch.elapsed_ticks(), 0u);
+
+  watch.reset();
+  EXPECT_TRUE(watch.is_running());
+  std::this_thread::sleep_for(SLEEP_PADDING);
+  EXPECT_GE(watch.elapsed_time(), SLEEP_PADDING);
+}
+
+} // namespace
+
+TEST(TscClockTest, AgreesWithSteadyClock)
+{
+  // Calibrate outside the measured interval
+  (void)fb::tsc_clock::is_hardware();
+
+  const auto          steady_begin = std::chrono::steady_clock::now();
+  const std::uint64_t ticks_begin  = fb::tsc_clock::now();
+  std::this_thread::sleep_for(50ms);
+  const std::uint64_t ticks_end    = fb::tsc_clock::now();
+  const auto          steady_end   = std::chrono::steady_clock::now();
+
+  const auto measured = fb::tsc_clock::to_duration(fb::tsc_clock::ticks_between(ticks_begin, ticks_end));
+  const auto expected = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_end - steady_begin);
+  EXPECT_NEAR(static_cast<double>(measured.count()), static_cast<double>(expected.count()),
+              static_cast<double>(expected.count()) * 0.05);
+  EXPECT_GT(fb::tsc_clock::ticks_per_second(), 0.0);
+
+#if defined(__x86_64__) || defined(__aarch64__)
+  if (!fb::tsc_clock::is_hardware())
+  {
+    GTEST_LOG_(INFO) << "No constant-rate CPU counter, tsc_clock uses steady_clock";
+  }
+#endif
+}
+
+TEST(TscClockTest, TicksBetweenNeverUnderflows)
+{
+  EXPECT_EQ(fb::tsc_clock::ticks_between(10, 25), 15u);
+  EXPECT_EQ(fb::tsc_clock::ticks_between(25, 10), 0u);
+}
+
+TEST(FastStopWatchTest, StartsImmediatelyByDefault)
+{
+  fb::fast_stop_watch watch;
+  std::this_thread::sleep_for(SLEEP_PADDING);
+  EXPECT_TRUE(watch.is_running());
+  EXPECT_GE(watch.elapsed_time(), SLEEP_PADDING);
+}
+
+TEST(FastStopWatchTest, StartStopAccumulatesAndResets)
+{
+  expect_accumulates<fb::fast_stop_watch>();
+}
+
+TEST(AtomicStopWatchTest, StartStopAccumulatesAndResets)
+{
+  expect_accumulates<fb::atomic_stop_watch>();
+}
+
+TEST(AtomicStopWatchTest, SharedBetweenThreads)
+{
+  fb::atomic_stop_watch watch{false};
+  const auto            started = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&watch]() {
+      for (int i = 0; i < 10000; ++i)
+      {
+        watch.start();
+        (void)watch.elapsed_time();
+        watch.stop();
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  const auto wall = std::chrono::steady_clock::now() - started;
+
+  // Runs from different threads overlap, so the total cannot exceed the wall time
+  EXPECT_FALSE(watch.is_running());
+  EXPECT_LE(watch.elapsed_time(), std::chrono::duration_cast<std::chrono::nanoseconds>(wall) + 1ms);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <fb/latency_histogram.h>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+using std::chrono::nanoseconds;
+
+class LatencyHistogramTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(LatencyHistogramTest, EmptySnapshot) {
+    latency_histogram histogram;
+    latency_snapshot snapshot = histogram.snapshot();
+
+    EXPECT_EQ(snapshot.count, 0u);
+    EXPECT_EQ(snapshot.max, nanoseconds(0));
+    EXPECT_EQ(snapshot.p99, nanoseconds(0));
+    EXPECT_EQ(histogram.value_at_percentile(50.0), nanoseconds(0));
+}
+
+TEST_F(LatencyHistogramTest, SmallValuesAreExact) {
+    latency_histogram histogram;
+    for (int i = 1; i <= 50; ++i) {
+        histogram.record(nanoseconds(i));
+    }
+
+    latency_snapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 50u);
+    EXPECT_EQ(snapshot.min, nanoseconds(1));
+    EXPECT_EQ(snapshot.max, nanoseconds(50));
+    EXPECT_EQ(snapshot.p50, nanoseconds(25));
+    EXPECT_EQ(snapshot.p90, nanoseconds(45));
+    EXPECT_EQ(histogram.value_at_percentile(100.0), nanoseconds(50));
+}
+
+TEST_F(LatencyHistogramTest, PercentilesWithinRelativeError) {
+    latency_histogram histogram;
+    // 1 us .. 10 ms in 1 us steps
+    const std::int64_t samples = 10000;
+    for (std::int64_t i = 1; i <= samples; ++i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+
+    latency_snapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, static_cast<std::uint64_t>(samples));
+    EXPECT_EQ(snapshot.mean, nanoseconds(5000500));
+
+    auto near = [](nanoseconds actual, double expected) {
+        const double value = static_cast<double>(actual.count());
+        EXPECT_GE(value, expected);
+        EXPECT_LE(value, expected * 1.035);
+    };
+    near(snapshot.p50, 5000e3);
+    near(snapshot.p90, 9000e3);
+    near(snapshot.p99, 9900e3);
+    near(snapshot.p999, 9990e3);
+    EXPECT_LE(snapshot.p999, snapshot.max);
+}
+
+TEST_F(LatencyHistogramTest, ExtremesAndReset) {
+    latency_histogram histogram;
+    histogram.record(nanoseconds(-5));
+    histogram.record(nanoseconds((std::numeric_limits<nanoseconds::rep>::max)()));
+
+    latency_snapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 2u);
+    EXPECT_EQ(snapshot.min, nanoseconds(0));
+    EXPECT_EQ(snapshot.max, nanoseconds((std::numeric_limits<nanoseconds::rep>::max)()));
+
+    EXPECT_THROW(histogram.value_at_percentile(101.0), std::invalid_argument);
+    EXPECT_THROW(histogram.value_at_percentile(-1.0), std::invalid_argument);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.snapshot().count, 0u);
+}
+
+TEST_F(LatencyHistogramTest, ConcurrentRecording) {
+    latency_histogram histogram;
+    const int threads = 4;
+    const int per_thread = 20000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&histogram, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                histogram.record(nanoseconds(1000 * (t + 1)));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    latency_snapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, static_cast<std::uint64_t>(threads * per_thread));
+    EXPECT_EQ(snapshot.min, nanoseconds(1000));
+    EXPECT_EQ(snapshot.max, nanoseconds(4000));
+}
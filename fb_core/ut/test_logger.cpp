@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <fb/logger.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+class LoggerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_path = std::filesystem::temp_directory_path() /
+             ("fb_logger_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" +
+              ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".log");
+    std::error_code ignored;
+    std::filesystem::remove(m_path, ignored);
+  }
+
+  void TearDown() override
+  {
+    fb::logger::stop();
+    fb::logger::set_level(fb::log_level::info);
+    std::error_code ignored;
+    std::filesystem::remove(m_path, ignored);
+  }
+
+  std::string read_log() const
+  {
+    std::ifstream      in(m_path, std::ios::binary);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+  }
+
+  static std::size_t count(const std::string& text, const std::string& what)
+  {
+    std::size_t found = 0;
+    for (auto at = text.find(what); at != std::string::npos; at = text.find(what, at + what.size()))
+    {
+      ++found;
+    }
+    return found;
+  }
+
+  std::filesystem::path m_path;
+};
+
+} // namespace
+
+TEST_F(LoggerTest, FormatsArgumentsOnTheWriterThread)
+{
+  fb::logger::start(m_path);
+  EXPECT_TRUE(fb::logger::is_running());
+
+  std::string      symbol = "ESZ6";
+  const char*      venue  = "CME";
+  const char*      none   = nullptr;
+  std::string_view side   = "buy";
+  fb::logger::info("fill {} {} {} {:.2f} x{} ok={} [{}]", symbol, venue, side, 4512.25, 3u, true, none);
+  symbol = "overwritten";  // The text was copied when logged
+
+  fb::logger::stop();
+  EXPECT_FALSE(fb::logger::is_running());
+
+  const std::string log = read_log();
+  EXPECT_EQ(log.find("INFO  ["), 31u);
+  EXPECT_NE(log.find("] fill ESZ6 CME buy 4512.25 x3 ok=true [(null)]\n"), std::string::npos) << log;
+  // "YYYY-MM-DD HH:MM:SS.nnnnnnnnnZ "
+  ASSERT_GE(log.size(), 31u);
+  EXPECT_EQ(log[4], '-');
+  EXPECT_EQ(log[10], ' ');
+  EXPECT_EQ(log[19], '.');
+  EXPECT_EQ(log[29], 'Z');
+}
+
+TEST_F(LoggerTest, LevelThreshold)
+{
+  fb::logger::start(m_path);
+  fb::logger::set_level(fb::log_level::warning);
+  EXPECT_FALSE(fb::logger::enabled(fb::log_level::info));
+  EXPECT_TRUE(fb::logger::enabled(fb::log_level::error));
+
+  fb::logger::debug("hidden {}", 1);
+  fb::logger::info("hidden {}", 2);
+  fb::logger::warning("shown {}", 3);
+  fb::logger::critical("shown {}", 4);
+
+  fb::logger::set_level(fb::log_level::off);
+  fb::logger::critical("hidden {}", 5);
+  fb::logger::stop();
+
+  const std::string log = read_log();
+  EXPECT_EQ(count(log, "hidden"), 0u);
+  EXPECT_NE(log.find("WARN  ["), std::string::npos);
+  EXPECT_NE(log.find("] shown 3\n"), std::string::npos);
+  EXPECT_NE(log.find("CRIT  ["), std::string::npos);
+  EXPECT_NE(log.find("] shown 4\n"), std::string::npos);
+}
+
+TEST_F(LoggerTest, LinesFromEveryThreadInTimeOrder)
+{
+  // One long flush interval, so only stop() writes and the batch is sorted
+  fb::logger::start(m_path, 1h);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([t]() {
+      for (int i = 0; i < 100; ++i)
+      {
+        fb::logger::info("thread {} message {}", t, i);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  fb::logger::stop();
+
+  const std::string log = read_log();
+  EXPECT_EQ(count(log, "\n"), 400u);
+  for (int t = 0; t < 4; ++t)
+  {
+    EXPECT_EQ(count(log, "thread " + std::to_string(t) + " message"), 100u);
+  }
+
+  std::istringstream lines(log);
+  std::string        line;
+  std::string        previous;
+  while (std::getline(lines, line))
+  {
+    const std::string stamp = line.substr(0, 30);
+    EXPECT_LE(previous, stamp);
+    previous = stamp;
+  }
+  EXPECT_EQ(fb::logger::dropped(), 0u);
+}
+
+TEST_F(LoggerTest, LongTextIsTruncatedToTheRecord)
+{
+  fb::logger::start(m_path);
+  const std::string long_text(500, 'x');
+  fb::logger::info("[{}] {}", long_text, 7);
+  fb::logger::flush();
+
+  const std::string log = read_log();
+  EXPECT_NE(log.find("[" + std::string(fb::detail::LOG_PAYLOAD_SIZE - 2 - sizeof(int), 'x') + "] 7\n"),
+            std::string::npos);
+}
+
+TEST_F(LoggerTest, FullRingDropsAndCounts)
+{
+  fb::logger::start(m_path, 1h, 8);
+  std::thread producer([]() {
+    for (int i = 0; i < 20; ++i)
+    {
+      fb::logger::info("burst {}", i);
+    }
+    EXPECT_EQ(fb::logger::dropped(), 12u);
+  });
+  producer.join();
+  fb::logger::stop();
+
+  EXPECT_EQ(count(read_log(), "burst"), 8u);
+}
+
+TEST_F(LoggerTest, BadFormatStringKeepsTheLine)
+{
+  fb::logger::start(m_path);
+  fb::logger::error("missing {} {}", 1);
+  fb::logger::info("after");
+  fb::logger::stop();
+
+  const std::string log = read_log();
+  EXPECT_NE(log.find("(format error: "), std::string::npos);
+  EXPECT_NE(log.find("] after\n"), std::string::npos);
+}
+
+TEST_F(LoggerTest, OneSessionAtATime)
+{
+  fb::logger::start(m_path);
+  EXPECT_THROW(fb::logger::start(m_path), std::logic_error);
+  EXPECT_THROW(fb::logger::start(stdout), std::logic_error);
+  fb::logger::stop();
+  fb::logger::stop();  // Nothing running
+
+  EXPECT_THROW(fb::logger::start(m_path / "missing" / "server.log"), std::runtime_error);
+  EXPECT_FALSE(fb::logger::is_running());
+}
@@ -0,0 +1,82 @@
+/// @file test_mapped_file.cpp
+/// @brief Unit tests for mapped_file
+
+#include <gtest/gtest.h>
+
+#include <fb/mapped_file.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+using namespace fb;
+
+namespace
+{
+
+std::filesystem::path write_temp_file(const char* name, const std::string& contents)
+{
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+  std::ofstream               file(path, std::ios::binary);
+  file << contents;
+  return path;
+}
+
+} // namespace
+
+TEST(MappedFileTest, MapsContents)
+{
+  const std::string contents(100000, 'x');
+  const auto        path = write_temp_file("test_mapped_file.txt", contents + "end");
+
+  {
+    mapped_file file(path);
+    EXPECT_EQ(file.size(), contents.size() + 3);
+    EXPECT_FALSE(file.empty());
+    EXPECT_EQ(file.view().substr(contents.size()), "end");
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, EmptyFileAndDefault)
+{
+  const auto path = write_temp_file("test_mapped_file_empty.txt", "");
+
+  {
+    mapped_file file(path);
+    EXPECT_TRUE(file.empty());
+    EXPECT_EQ(file.view(), "");
+  }
+
+  mapped_file none;
+  EXPECT_TRUE(none.empty());
+  EXPECT_EQ(none.data(), nullptr);
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, MoveTransfersTheMapping)
+{
+  const auto path = write_temp_file("test_mapped_file_move.txt", "payload");
+
+  {
+    mapped_file first(path);
+    const char* data = first.data();
+
+    mapped_file second = std::move(first);
+    EXPECT_EQ(second.data(), data);
+    EXPECT_TRUE(first.empty()); // NOLINT(bugprone-use-after-move)
+
+    first = std::move(second);
+    EXPECT_EQ(first.view(), "payload");
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, MissingFileThrows)
+{
+  EXPECT_THROW(mapped_file(std::filesystem::path("/nonexistent/path/file.txt")), std::system_error);
+}
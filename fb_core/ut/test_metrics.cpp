@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "fb/metrics.h"
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using fb::metrics_registration;
+using fb::metrics_registry;
+
+TEST(MetricsTest, OwnedMetricsAreFoundByName) {
+  metrics_registry registry;
+  auto&            orders = registry.counter("orders_total", "Orders seen");
+  orders.add();
+  orders.add(4);
+  EXPECT_EQ(&registry.counter("orders_total"), &orders);
+  EXPECT_EQ(orders.value(), 5u);
+
+  auto& depth = registry.gauge("book_depth");
+  depth.set(10);
+  depth.add(-3);
+  EXPECT_EQ(depth.value(), 7);
+
+  registry.histogram("parse_latency_seconds").record(std::chrono::microseconds(2));
+  EXPECT_EQ(registry.histogram("parse_latency_seconds").count(), 1u);
+  EXPECT_EQ(registry.size(), 3u);
+
+  EXPECT_THROW(registry.gauge("orders_total"), std::invalid_argument);
+  EXPECT_THROW(registry.counter("9lives"), std::invalid_argument);
+  EXPECT_THROW(registry.counter("bad-name"), std::invalid_argument);
+  EXPECT_THROW(registry.counter(""), std::invalid_argument);
+}
+
+TEST(MetricsTest, CounterIsExactUnderConcurrentAdds) {
+  metrics_registry registry;
+  auto&            hits = registry.counter("hits_total");
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&hits]() {
+      for (int i = 0; i < 10000; ++i) {
+        hits.add();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(hits.value(), 40000u);
+}
+
+TEST(MetricsTest, RegistrationRemovesPulledMetrics) {
+  metrics_registry registry;
+  std::uint64_t    dropped = 2;
+  {
+    metrics_registration registration =
+        registry.add_counter("queue_dropped_total", "Events dropped", [&dropped]() { return dropped; });
+    registration.append(registry.add_gauge("queue_depth", "", []() { return std::int64_t{-1}; }));
+    EXPECT_TRUE(registry.contains("queue_dropped_total"));
+    EXPECT_THROW((void)registry.add_counter("queue_depth", "", []() { return std::uint64_t{0}; }),
+                 std::invalid_argument);
+
+    dropped = 9;
+    EXPECT_NE(registry.to_prometheus().find("queue_dropped_total 9\n"), std::string::npos);
+  }
+  EXPECT_EQ(registry.size(), 0u);
+
+  // A handle does not remove a metric that has since been replaced under its name
+  metrics_registration stale = registry.add_counter("reused_total", "", []() { return std::uint64_t{1}; });
+  EXPECT_TRUE(registry.remove("reused_total"));
+  EXPECT_FALSE(registry.remove("reused_total"));
+  metrics_registration current = registry.add_counter("reused_total", "", []() { return std::uint64_t{2}; });
+  stale.reset();
+  EXPECT_TRUE(registry.contains("reused_total"));
+
+  metrics_registry other;
+  metrics_registration foreign = other.add_counter("foreign_total", "", []() { return std::uint64_t{0}; });
+  EXPECT_THROW(current.append(std::move(foreign)), std::invalid_argument);
+}
+
+TEST(MetricsTest, PrometheusText) {
+  metrics_registry registry;
+  registry.counter("orders_total", "Orders seen\nper session").add(12);
+  registry.gauge("book_depth").set(-4);
+  auto& latency = registry.histogram("fill_latency_seconds", "Order to fill");
+  latency.record(std::chrono::microseconds(5));
+  latency.record(std::chrono::microseconds(5));
+
+  EXPECT_EQ(registry.to_prometheus(),
+            "# TYPE book_depth gauge\n"
+            "book_depth -4\n"
+            "# HELP fill_latency_seconds Order to fill\n"
+            "# TYPE fill_latency_seconds summary\n"
+            "fill_latency_seconds{quantile=\"0.5\"} 0.000005000\n"
+            "fill_latency_seconds{quantile=\"0.9\"} 0.000005000\n"
+            "fill_latency_seconds{quantile=\"0.99\"} 0.000005000\n"
+            "fill_latency_seconds{quantile=\"0.999\"} 0.000005000\n"
+            "fill_latency_seconds_sum 0.000010000\n"
+            "fill_latency_seconds_count 2\n"
+            "# HELP orders_total Orders seen\\nper session\n"
+            "# TYPE orders_total counter\n"
+            "orders_total 12\n");
+}
+
+TEST(MetricsTest, Json) {
+  metrics_registry registry;
+  EXPECT_EQ(registry.to_json(), "{}");
+
+  registry.counter("orders_total", "Orders \"seen\"").add(3);
+  auto registration = registry.add_histogram("rtt_seconds", "", []() {
+    fb::latency_snapshot snapshot;
+    snapshot.count = 1;
+    snapshot.min = snapshot.max = snapshot.mean = snapshot.p50 = snapshot.p90 = snapshot.p99 = snapshot.p999 =
+        std::chrono::nanoseconds(40);
+    return snapshot;
+  });
+
+  EXPECT_EQ(registry.to_json(),
+            "{\"orders_total\":{\"type\":\"counter\",\"help\":\"Orders \\\"seen\\\"\",\"value\":3},"
+            "\"rtt_seconds\":{\"type\":\"histogram\",\"help\":\"\",\"count\":1,\"min_ns\":40,\"max_ns\":40,"
+            "\"mean_ns\":40,\"p50_ns\":40,\"p90_ns\":40,\"p99_ns\":40,\"p999_ns\":40}}");
+}
@@ -0,0 +1,148 @@
+/// @file test_mirrored_ring_buffer.cpp
+/// @brief Unit tests for mirrored_ring_buffer
+
+#include <gtest/gtest.h>
+
+#include <fb/mirrored_ring_buffer.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace fb;
+
+TEST(MirroredRingBufferTest, CapacityIsWholePages)
+{
+  const std::size_t page = mirrored_ring_buffer::page_size();
+  ASSERT_GT(page, 0u);
+
+  mirrored_ring_buffer one;
+  EXPECT_EQ(one.capacity(), page);
+  EXPECT_TRUE(one.empty());
+  EXPECT_EQ(one.free_space(), page);
+
+  mirrored_ring_buffer rounded(page + 1);
+  EXPECT_EQ(rounded.capacity(), 2 * page);
+  EXPECT_EQ(mirrored_ring_buffer(page).capacity(), page);
+
+#ifdef __linux__
+  EXPECT_TRUE(one.is_mirrored());
+#endif
+}
+
+TEST(MirroredRingBufferTest, PushAndPopInOrder)
+{
+  mirrored_ring_buffer ring;
+  EXPECT_EQ(ring.push_back_n("hello ", 6), 6u);
+  EXPECT_EQ(ring.push_back_n("world", 5), 5u);
+  EXPECT_EQ(ring.view(), "hello world");
+
+  EXPECT_EQ(ring.pop_front_n(6), 6u);
+  EXPECT_EQ(ring.view(), "world");
+  EXPECT_EQ(ring.pop_front_n(100), 5u);
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.pop_front_n(1), 0u);
+}
+
+TEST(MirroredRingBufferTest, WrappedBytesStayContiguous)
+{
+  mirrored_ring_buffer ring;
+  const std::size_t    capacity = ring.capacity();
+
+  // Move the front close to the end of the ring
+  const std::string filler(capacity - 3, '.');
+  ring.push_back_n(filler.data(), filler.size());
+  ring.pop_front_n(filler.size() - 2);
+
+  // "..abcdef" now runs round the end of the ring and back to its start
+  EXPECT_EQ(ring.push_back_n("abcdef", 6), 6u);
+  EXPECT_EQ(ring.view(), "..abcdef");
+  EXPECT_EQ(std::memcmp(ring.data() + 2, "abcdef", 6), 0);
+
+  ring.pop_front_n(4);
+  EXPECT_EQ(ring.view(), "cdef");
+}
+
+TEST(MirroredRingBufferTest, WriteInPlaceAndCommit)
+{
+  mirrored_ring_buffer ring;
+  const std::size_t    capacity = ring.capacity();
+
+  for (std::size_t round = 0; round < 10; ++round)
+  {
+    // Leave one byte behind each round so the write position wraps
+    const std::size_t space = ring.free_space();
+    char*             out   = ring.write_data();
+    std::memset(out, 'a' + static_cast<int>(round), space);
+    ring.commit_back(space);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.view().front(), round == 0 ? 'a' : static_cast<char>('a' + round - 1));
+    EXPECT_EQ(ring.view().back(), static_cast<char>('a' + round));
+    ring.pop_front_n(capacity - 1);
+    EXPECT_EQ(ring.view(), std::string(1, static_cast<char>('a' + round)));
+  }
+
+  EXPECT_THROW(ring.commit_back(capacity), std::length_error);
+  EXPECT_EQ(ring.size(), 1u);
+}
+
+TEST(MirroredRingBufferTest, PushStopsWhenFull)
+{
+  mirrored_ring_buffer ring;
+  const std::string    bytes(ring.capacity() + 10, 'x');
+  EXPECT_EQ(ring.push_back_n(bytes.data(), bytes.size()), ring.capacity());
+  EXPECT_TRUE(ring.full());
+  EXPECT_EQ(ring.free_space(), 0u);
+  EXPECT_EQ(ring.push_back_n("y", 1), 0u);
+}
+
+TEST(MirroredRingBufferTest, ReserveKeepsWrappedContents)
+{
+  mirrored_ring_buffer ring;
+  const std::size_t    capacity = ring.capacity();
+
+  const std::string filler(capacity - 2, '.');
+  ring.push_back_n(filler.data(), filler.size());
+  ring.pop_front_n(filler.size());
+  ring.push_back_n("wrapped", 7);
+
+  ring.reserve(capacity);
+  EXPECT_EQ(ring.capacity(), capacity);
+
+  ring.reserve(capacity + 1);
+  EXPECT_EQ(ring.capacity(), 2 * capacity);
+  EXPECT_EQ(ring.view(), "wrapped");
+  EXPECT_EQ(ring.free_space(), 2 * capacity - 7);
+}
+
+TEST(MirroredRingBufferTest, ClearKeepsCapacity)
+{
+  mirrored_ring_buffer ring(3 * mirrored_ring_buffer::page_size());
+  ring.push_back_n("data", 4);
+  ring.clear();
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.capacity(), 3 * mirrored_ring_buffer::page_size());
+  EXPECT_EQ(ring.free_space(), ring.capacity());
+}
+
+TEST(MirroredRingBufferTest, MoveTransfersTheStorage)
+{
+  mirrored_ring_buffer first;
+  first.push_back_n("moved", 5);
+  const char*       data     = first.data();
+  const std::size_t capacity = first.capacity();
+
+  mirrored_ring_buffer second(std::move(first));
+  EXPECT_EQ(second.data(), data);
+  EXPECT_EQ(second.view(), "moved");
+  EXPECT_EQ(second.capacity(), capacity);
+  EXPECT_EQ(first.capacity(), 0u);
+  EXPECT_TRUE(first.empty());
+
+  mirrored_ring_buffer third;
+  third.push_back_n("old", 3);
+  third = std::move(second);
+  EXPECT_EQ(third.view(), "moved");
+  EXPECT_EQ(second.capacity(), 0u);
+}
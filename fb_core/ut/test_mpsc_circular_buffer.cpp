@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "fb/mpsc_circular_buffer.h"
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using fb::mpsc_circular_buffer;
+
+TEST(MpscCircularBufferTest, PushPopMaintainsOrder) {
+  mpsc_circular_buffer<int> buffer(4);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.front(), nullptr);
+
+  EXPECT_TRUE(buffer.push_back(1));
+  EXPECT_TRUE(buffer.push_back(2));
+  EXPECT_EQ(buffer.size(), 2u);
+
+  ASSERT_NE(buffer.front(), nullptr);
+  EXPECT_EQ(*buffer.front(), 1);
+  buffer.pop_front();
+
+  int value = 0;
+  EXPECT_TRUE(buffer.pop_front(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(buffer.pop_front(value));
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(MpscCircularBufferTest, RejectsWhenFullAndWraps) {
+  mpsc_circular_buffer<int> buffer(2);
+  for (int round = 0; round < 5; ++round) {
+    EXPECT_TRUE(buffer.push_back(round));
+    EXPECT_TRUE(buffer.push_back(round + 100));
+    EXPECT_TRUE(buffer.full());
+    EXPECT_FALSE(buffer.push_back(-1));
+
+    int value = 0;
+    EXPECT_TRUE(buffer.pop_front(value));
+    EXPECT_EQ(value, round);
+    EXPECT_TRUE(buffer.pop_front(value));
+    EXPECT_EQ(value, round + 100);
+  }
+}
+
+TEST(MpscCircularBufferTest, ZeroCapacityThrows) {
+  EXPECT_THROW(mpsc_circular_buffer<int>(0), std::invalid_argument);
+  EXPECT_EQ(mpsc_circular_buffer<int>(5).capacity(), 8u);
+}
+
+TEST(MpscCircularBufferTest, DestroysRemainingElements) {
+  auto tracked = std::make_shared<int>(0);
+  {
+    mpsc_circular_buffer<std::shared_ptr<int>> buffer(4);
+    buffer.push_back(tracked);
+    buffer.emplace_back(tracked);
+    EXPECT_EQ(tracked.use_count(), 3);
+  }
+  EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(MpscCircularBufferTest, ManyProducersKeepPerProducerOrder) {
+  constexpr int PRODUCERS = 4;
+  constexpr int PER_PRODUCER = 50000;
+  mpsc_circular_buffer<int> buffer(128);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < PRODUCERS; ++p) {
+    producers.emplace_back([&buffer, p]() {
+      for (int i = 0; i < PER_PRODUCER; ++i) {
+        while (!buffer.push_back(p * PER_PRODUCER + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> next(PRODUCERS, 0);
+  int received = 0;
+  while (received < PRODUCERS * PER_PRODUCER) {
+    int value = -1;
+    if (buffer.pop_front(value)) {
+      const auto producer = static_cast<size_t>(value / PER_PRODUCER);
+      ASSERT_EQ(value % PER_PRODUCER, next[producer]);
+      ++next[producer];
+      ++received;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (auto &thread : producers) {
+    thread.join();
+  }
+  EXPECT_TRUE(buffer.empty());
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <fb/object_pool.h>
+#include <fb/spsc_circular_buffer.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct tracked
+{
+  explicit tracked(int v)
+      : value(v)
+  {
+    ++alive;
+  }
+
+  ~tracked()
+  {
+    --alive;
+  }
+
+  int               value;
+  static inline int alive = 0;
+};
+
+struct throws_on_construction
+{
+  throws_on_construction()
+  {
+    throw std::runtime_error("construction failed");
+  }
+};
+
+} // namespace
+
+TEST(FixedPoolTest, BlocksAreAlignedAndReused)
+{
+  fb::fixed_pool pool(24, 32, 4);
+  EXPECT_EQ(pool.block_size(), 32u);
+  EXPECT_EQ(pool.block_alignment(), 32u);
+
+  std::set<void*> blocks;
+  for (int i = 0; i < 8; ++i)
+  {
+    void* block = pool.allocate();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % 32, 0u);
+    EXPECT_TRUE(blocks.insert(block).second);
+  }
+  EXPECT_EQ(pool.capacity(), 8u);
+
+  for (void* block : blocks)
+  {
+    pool.deallocate(block);
+  }
+  for (int i = 0; i < 8; ++i)
+  {
+    EXPECT_EQ(blocks.count(pool.allocate()), 1u);
+  }
+  EXPECT_EQ(pool.capacity(), 8u);
+}
+
+TEST(FixedPoolTest, RejectsBadAlignment)
+{
+  EXPECT_THROW(fb::fixed_pool(16, 3), std::invalid_argument);
+  EXPECT_THROW(fb::fixed_pool(16, 0), std::invalid_argument);
+}
+
+TEST(FixedPoolTest, BlocksFreedOnAnotherThreadComeBack)
+{
+  fb::fixed_pool                   pool(64, alignof(std::max_align_t), 16);
+  fb::spsc_circular_buffer<void*> handoff(1024);
+  constexpr int                    blocks = 10000;
+
+  std::thread consumer([&]() {
+    int   freed = 0;
+    void* block = nullptr;
+    while (freed < blocks)
+    {
+      if (handoff.pop_front(block))
+      {
+        pool.deallocate(block);
+        ++freed;
+      }
+    }
+  });
+
+  for (int i = 0; i < blocks; ++i)
+  {
+    void* block = pool.allocate();
+    while (!handoff.push_back(block))
+    {
+      std::this_thread::yield();
+    }
+  }
+  consumer.join();
+
+  // At most the ring's worth of blocks was ever out at once
+  EXPECT_LE(pool.capacity(), 1024u + 2 * 16u);
+}
+
+TEST(FixedPoolTest, CacheOfAnExitedThreadReturnsToThePool)
+{
+  fb::fixed_pool pool(32, alignof(std::max_align_t), 8);
+  std::thread([&pool]() {
+    // Takes a chunk of 8 into this thread's cache, uses one, frees it
+    pool.deallocate(pool.allocate());
+  }).join();
+
+  for (int i = 0; i < 8; ++i)
+  {
+    static_cast<void>(pool.allocate());
+  }
+  EXPECT_EQ(pool.capacity(), 8u);
+}
+
+TEST(ObjectPoolTest, MakeConstructsAndDeleterDestroys)
+{
+  fb::object_pool<tracked> pool;
+  {
+    auto first  = pool.make(1);
+    auto second = pool.make(2);
+    EXPECT_EQ(first->value, 1);
+    EXPECT_EQ(second->value, 2);
+    EXPECT_EQ(tracked::alive, 2);
+  }
+  EXPECT_EQ(tracked::alive, 0);
+
+  // A default deleter deletes, so heap objects can use the same pointer type
+  fb::object_pool<tracked>::pointer heap(new tracked(3));
+  EXPECT_EQ(tracked::alive, 1);
+  heap.reset();
+  EXPECT_EQ(tracked::alive, 0);
+
+  tracked* raw = pool.create(4);
+  EXPECT_EQ(raw->value, 4);
+  pool.destroy(raw);
+  EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(ObjectPoolTest, FailedConstructionReturnsTheBlock)
+{
+  fb::object_pool<throws_on_construction> pool(1);
+  EXPECT_THROW(static_cast<void>(pool.make()), std::runtime_error);
+  EXPECT_THROW(static_cast<void>(pool.make()), std::runtime_error);
+  EXPECT_EQ(pool.blocks().capacity(), 1u);
+}
+
+TEST(PoolResourceTest, SmallRequestsComeFromThePool)
+{
+  fb::pool_resource resource(64);
+  {
+    std::pmr::map<int, std::uint64_t> book(&resource);
+    for (int i = 0; i < 200; ++i)
+    {
+      book[i] = static_cast<std::uint64_t>(i) * 3;
+    }
+    EXPECT_EQ(book[150], 450u);
+  }
+  const std::size_t carved = resource.pool().capacity();
+  EXPECT_GE(carved, 200u);
+
+  // Larger requests bypass the pool
+  void* large = resource.allocate(1000);
+  resource.deallocate(large, 1000);
+  EXPECT_EQ(resource.pool().capacity(), carved);
+
+  auto shared = std::allocate_shared<std::uint64_t>(std::pmr::polymorphic_allocator<std::uint64_t>(&resource), 7u);
+  EXPECT_EQ(*shared, 7u);
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <fb/profiler.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+class ProfilerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_path = std::filesystem::temp_directory_path() /
+             ("fb_profiler_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" +
+              ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".json");
+  }
+
+  void TearDown() override
+  {
+    fb::profiler::stop();
+    std::error_code ignored;
+    std::filesystem::remove(m_path, ignored);
+  }
+
+  std::string read_trace() const
+  {
+    std::ifstream      in(m_path, std::ios::binary);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+  }
+
+  static std::size_t count(const std::string& text, const std::string& what)
+  {
+    std::size_t found = 0;
+    for (auto at = text.find(what); at != std::string::npos; at = text.find(what, at + what.size()))
+    {
+      ++found;
+    }
+    return found;
+  }
+
+  std::filesystem::path m_path;
+};
+
+} // namespace
+
+TEST_F(ProfilerTest, WritesZonesFromEveryThread)
+{
+  fb::profiler::start(m_path, 1ms);
+  EXPECT_TRUE(fb::profiler::is_running());
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t)
+  {
+    threads.emplace_back([t]() {
+      fb::profiler::set_thread_name("worker \"" + std::to_string(t) + "\"");
+      for (int i = 0; i < 100; ++i)
+      {
+        const fb::profile_zone zone("work");
+      }
+    });
+  }
+  {
+    const fb::profile_zone zone("main");
+    std::this_thread::sleep_for(2ms);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  fb::profiler::stop();
+  EXPECT_FALSE(fb::profiler::is_running());
+
+  const std::string trace = read_trace();
+  EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+  EXPECT_NE(trace.find("\"dropped_zones\":\"0\"}}"), std::string::npos);
+  EXPECT_EQ(count(trace, "{\"name\":\"work\",\"ph\":\"X\""), 300u);
+  EXPECT_EQ(count(trace, "{\"name\":\"main\",\"ph\":\"X\""), 1u);
+  EXPECT_EQ(count(trace, "\"ph\":\"M\""), 3u);
+  EXPECT_NE(trace.find("\"args\":{\"name\":\"worker \\\"1\\\"\"}"), std::string::npos);
+
+  // The main zone slept, so its duration is at least 2000 us
+  const auto main_at  = trace.find("{\"name\":\"main\"");
+  const auto dur_at   = trace.find("\"dur\":", main_at) + 6;
+  const double dur_us = std::stod(trace.substr(dur_at, trace.find('}', dur_at) - dur_at));
+  EXPECT_GE(dur_us, 2000.0);
+  EXPECT_LT(dur_us, 1e6);
+}
+
+TEST_F(ProfilerTest, NothingRecordedOutsideASession)
+{
+  {
+    const fb::profile_zone zone("before");
+  }
+  fb::profiler::start(m_path);
+  {
+    const fb::profile_zone zone("during");
+  }
+  fb::profiler::stop();
+  {
+    const fb::profile_zone zone("after");
+  }
+
+  const std::string trace = read_trace();
+  EXPECT_EQ(count(trace, "\"name\":\"during\""), 1u);
+  EXPECT_EQ(trace.find("\"name\":\"before\""), std::string::npos);
+  EXPECT_EQ(trace.find("\"name\":\"after\""), std::string::npos);
+}
+
+TEST_F(ProfilerTest, FullRingDropsAndCounts)
+{
+  // One long flush interval, so only stop() drains the ring
+  fb::profiler::start(m_path, 1h, 8);
+  std::thread producer([]() {
+    for (int i = 0; i < 20; ++i)
+    {
+      const fb::profile_zone zone("burst");
+    }
+    EXPECT_EQ(fb::profiler::dropped(), 12u);
+  });
+  producer.join();
+  EXPECT_EQ(fb::profiler::dropped(), 12u);
+  fb::profiler::stop();
+
+  const std::string trace = read_trace();
+  EXPECT_EQ(count(trace, "\"name\":\"burst\""), 8u);
+  EXPECT_NE(trace.find("\"dropped_zones\":\"12\""), std::string::npos);
+}
+
+TEST_F(ProfilerTest, OneSessionAtATime)
+{
+  fb::profiler::start(m_path);
+  EXPECT_THROW(fb::profiler::start(m_path), std::logic_error);
+  fb::profiler::stop();
+  fb::profiler::stop();  // Nothing running
+
+  EXPECT_THROW(fb::profiler::start(m_path / "missing" / "trace.json"), std::runtime_error);
+  EXPECT_FALSE(fb::profiler::is_running());
+}
+
+#if FB_PROFILING
+TEST_F(ProfilerTest, ZoneMacro)
+{
+  fb::profiler::start(m_path);
+  {
+    FB_PROFILE_ZONE("macro zone");
+  }
+  fb::profiler::stop();
+  EXPECT_EQ(count(read_trace(), "\"name\":\"macro zone\""), 1u);
+}
+#endif
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include "fb/rolling_window.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using fb::rolling_window;
+
+namespace {
+
+// Nearest-rank quantile of the values, the definition rolling_window approximates
+double exact_quantile(std::vector<double> values, double q) {
+  std::sort(values.begin(), values.end());
+  const auto rank = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(q * static_cast<double>(values.size()))));
+  return values[rank - 1];
+}
+
+} // namespace
+
+TEST(RollingWindowTest, StatisticsOfPartialWindow) {
+  rolling_window<double> window(8);
+  EXPECT_TRUE(window.empty());
+  EXPECT_EQ(window.mean(), 0.0);
+  EXPECT_EQ(window.variance(), 0.0);
+  EXPECT_THROW(window.min(), std::out_of_range);
+  EXPECT_THROW(window.quantile(0.5), std::out_of_range);
+
+  for (double value : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) {
+    window.push_back(value);
+  }
+  EXPECT_TRUE(window.full());
+  EXPECT_DOUBLE_EQ(window.sum(), 40.0);
+  EXPECT_DOUBLE_EQ(window.mean(), 5.0);
+  EXPECT_DOUBLE_EQ(window.variance(), 4.0);
+  EXPECT_DOUBLE_EQ(window.stddev(), 2.0);
+  EXPECT_EQ(window.min(), 2.0);
+  EXPECT_EQ(window.max(), 9.0);
+  EXPECT_EQ(window.quantile(0.0), 2.0);
+  EXPECT_EQ(window.quantile(1.0), 9.0);
+  EXPECT_NEAR(window.median(), 4.0, 4.0 * 0.032);
+}
+
+TEST(RollingWindowTest, EvictionUpdatesStatistics) {
+  rolling_window<int> window(3);
+  window.push_back(10);
+  window.push_back(1);
+  window.push_back(5);
+  EXPECT_EQ(window.min(), 1);
+  EXPECT_EQ(window.max(), 10);
+
+  window.push_back(3);  // Evicts 10
+  EXPECT_EQ(window.size(), 3u);
+  EXPECT_EQ(window.sum(), 9);
+  EXPECT_EQ(window.max(), 5);
+  EXPECT_EQ(window.min(), 1);
+
+  window.push_back(4);  // Evicts 1
+  window.push_back(2);  // Evicts 5
+  EXPECT_EQ(window.min(), 2);
+  EXPECT_EQ(window.max(), 4);
+  EXPECT_DOUBLE_EQ(window.mean(), 3.0);
+
+  std::vector<int> values(window.values().begin(), window.values().end());
+  EXPECT_EQ(values, (std::vector<int>{3, 4, 2}));
+}
+
+TEST(RollingWindowTest, PopFrontAndClear) {
+  rolling_window<int> window(4);
+  window.push_back(-5);
+  window.push_back(7);
+  window.pop_front();
+  EXPECT_EQ(window.size(), 1u);
+  EXPECT_EQ(window.min(), 7);
+  EXPECT_EQ(window.max(), 7);
+  EXPECT_DOUBLE_EQ(window.variance(), 0.0);
+
+  window.pop_front();
+  EXPECT_TRUE(window.empty());
+  window.pop_front();  // Nothing to evict
+  EXPECT_EQ(window.sum(), 0);
+
+  window.push_back(1);
+  window.push_back(2);
+  window.clear();
+  EXPECT_TRUE(window.empty());
+  window.push_back(3);
+  EXPECT_EQ(window.sum(), 3);
+  EXPECT_EQ(window.min(), 3);
+  EXPECT_EQ(window.quantile(0.5), 3.0);
+}
+
+TEST(RollingWindowTest, MatchesRecomputationOverLongStream) {
+  const std::size_t capacity = 100;
+  rolling_window<double> window(capacity);
+  std::mt19937_64 rng(42);
+  std::normal_distribution<double> price(100.0, 2.0);
+  std::vector<double> recent;
+
+  for (int i = 0; i < 5000; ++i) {
+    const double value = price(rng);
+    window.push_back(value);
+    recent.push_back(value);
+    if (recent.size() > capacity) {
+      recent.erase(recent.begin());
+    }
+
+    ASSERT_EQ(window.min(), *std::min_element(recent.begin(), recent.end()));
+    ASSERT_EQ(window.max(), *std::max_element(recent.begin(), recent.end()));
+
+    if (i % 97 == 0) {
+      double sum = 0;
+      for (double v : recent) sum += v;
+      const double mean = sum / static_cast<double>(recent.size());
+      double m2 = 0;
+      for (double v : recent) m2 += (v - mean) * (v - mean);
+      EXPECT_NEAR(window.mean(), mean, 1e-9);
+      EXPECT_NEAR(window.variance(), m2 / static_cast<double>(recent.size()), 1e-7);
+
+      for (double q : {0.01, 0.25, 0.5, 0.9, 0.99}) {
+        const double expected = exact_quantile(recent, q);
+        EXPECT_NEAR(window.quantile(q), expected, std::fabs(expected) * 0.032) << "q=" << q;
+      }
+    }
+  }
+}
+
+TEST(RollingWindowTest, QuantilesOfNegativeAndWideRangeValues) {
+  rolling_window<double> window(1000);
+  std::vector<double> values;
+  for (int i = 0; i < 1000; ++i) {
+    // -1e6 .. 1e9, crossing zero
+    const double value = (i < 300 ? -1.0 : 1.0) * std::pow(10.0, (i % 100) / 100.0 * 9.0 - 3.0);
+    window.push_back(value);
+    values.push_back(value);
+  }
+  for (double q : {0.05, 0.2, 0.29, 0.31, 0.5, 0.75, 0.999}) {
+    const double expected = exact_quantile(values, q);
+    EXPECT_NEAR(window.quantile(q), expected, std::fabs(expected) * 0.032) << "q=" << q;
+  }
+}
+
+TEST(RollingWindowTest, LatenciesAsIntegers) {
+  rolling_window<std::uint64_t> window(1000);
+  for (std::uint64_t ns = 1; ns <= 1000; ++ns) {
+    window.push_back(ns * 1000);
+  }
+  EXPECT_EQ(window.sum(), 500500000u);
+  EXPECT_EQ(window.min(), 1000u);
+  EXPECT_EQ(window.max(), 1000000u);
+  EXPECT_NEAR(window.quantile(0.99), 990000.0, 990000.0 * 0.032);
+  EXPECT_NEAR(window.quantile(0.5), 500000.0, 500000.0 * 0.032);
+}
+
+TEST(RollingWindowTest, InvalidArguments) {
+  EXPECT_THROW(rolling_window<double>(0), std::invalid_argument);
+
+  rolling_window<double> window(4);
+  window.push_back(1.0);
+  EXPECT_THROW(window.quantile(-0.1), std::invalid_argument);
+  EXPECT_THROW(window.quantile(1.5), std::invalid_argument);
+  EXPECT_THROW(window.quantile(std::nan("")), std::invalid_argument);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <fb/sharded_counters.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+class ShardedCountersTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(ShardedCountersTest, ShardCountRoundsUpToPowerOfTwo) {
+    EXPECT_EQ(sharded_counters<1>(3).shards(), 4u);
+    EXPECT_EQ(sharded_counters<1>(1).shards(), 1u);
+    EXPECT_EQ(sharded_counters<1>(1000).shards(), sharded_counters<1>::MAX_SHARDS);
+    EXPECT_GE(sharded_counters<1>().shards(), 1u);
+}
+
+TEST_F(ShardedCountersTest, FieldsCountIndependently) {
+    sharded_counters<3> counters(4);
+    counters.add(0);
+    counters.add(1, 10);
+    counters.add(1, 5);
+
+    EXPECT_EQ(counters.value(0), 1u);
+    EXPECT_EQ(counters.value(1), 15u);
+    EXPECT_EQ(counters.value(2), 0u);
+
+    counters.store(1, 7);
+    EXPECT_EQ(counters.value(1), 7u);
+    counters.add(1);
+    EXPECT_EQ(counters.value(1), 8u);
+}
+
+TEST_F(ShardedCountersTest, ConcurrentAddsAreNotLost) {
+    sharded_counters<2> counters(4);
+    const int num_threads = 8;
+    const std::uint64_t per_thread = 100000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&counters, per_thread] {
+            for (std::uint64_t i = 0; i < per_thread; ++i) {
+                counters.add(0);
+                counters.add(1, 2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counters.value(0), num_threads * per_thread);
+    EXPECT_EQ(counters.value(1), 2 * num_threads * per_thread);
+}
+
+TEST_F(ShardedCountersTest, MaxTracksLatestValuePerThread) {
+    sharded_counters<1> counters(8);
+    counters.set(0, 5);
+
+    std::thread other([&counters] { counters.set(0, 42); });
+    other.join();
+    EXPECT_EQ(counters.max(0), 42u);
+
+    counters.store(0, 3);
+    EXPECT_EQ(counters.max(0), 3u);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "fb/spsc_circular_buffer.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using fb::spsc_circular_buffer;
+
+TEST(SpscCircularBufferTest, PushPopMaintainsOrder) {
+  spsc_circular_buffer<int> buffer(4);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.front(), nullptr);
+
+  EXPECT_TRUE(buffer.push_back(1));
+  EXPECT_TRUE(buffer.push_back(2));
+  EXPECT_TRUE(buffer.push_back(3));
+  EXPECT_EQ(buffer.size(), 3u);
+
+  ASSERT_NE(buffer.front(), nullptr);
+  EXPECT_EQ(*buffer.front(), 1);
+  buffer.pop_front();
+
+  int value = 0;
+  EXPECT_TRUE(buffer.pop_front(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(buffer.pop_front(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(buffer.pop_front(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SpscCircularBufferTest, RejectsWhenFull) {
+  spsc_circular_buffer<int> buffer(2);
+  EXPECT_TRUE(buffer.push_back(10));
+  EXPECT_TRUE(buffer.push_back(20));
+  EXPECT_TRUE(buffer.full());
+
+  EXPECT_FALSE(buffer.push_back(30));  // never overwrites
+  EXPECT_EQ(*buffer.front(), 10);
+
+  buffer.pop_front();
+  EXPECT_TRUE(buffer.push_back(30));  // wraps
+  int value = 0;
+  EXPECT_TRUE(buffer.pop_front(value));
+  EXPECT_EQ(value, 20);
+  EXPECT_TRUE(buffer.pop_front(value));
+  EXPECT_EQ(value, 30);
+}
+
+TEST(SpscCircularBufferTest, CapacityRoundsUpToPowerOfTwo) {
+  EXPECT_EQ(spsc_circular_buffer<int>(1).capacity(), 1u);
+  EXPECT_EQ(spsc_circular_buffer<int>(3).capacity(), 4u);
+  EXPECT_EQ(spsc_circular_buffer<int>(1000).capacity(), 1024u);
+  EXPECT_THROW(spsc_circular_buffer<int>(0), std::invalid_argument);
+}
+
+TEST(SpscCircularBufferTest, DestroysRemainingElements) {
+  auto tracked = std::make_shared<int>(0);
+  {
+    spsc_circular_buffer<std::shared_ptr<int>> buffer(4);
+    buffer.push_back(tracked);
+    buffer.emplace_back(tracked);
+    EXPECT_EQ(tracked.use_count(), 3);
+
+    buffer.pop_front();
+    EXPECT_EQ(tracked.use_count(), 2);
+  }
+  EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(SpscCircularBufferTest, MovesOnlyTypesThrough) {
+  spsc_circular_buffer<std::unique_ptr<std::string>> buffer(2);
+  EXPECT_TRUE(buffer.push_back(std::make_unique<std::string>("tick")));
+
+  std::unique_ptr<std::string> out;
+  EXPECT_TRUE(buffer.pop_front(out));
+  ASSERT_NE(out, nullptr);
+  EXPECT_EQ(*out, "tick");
+}
+
+TEST(SpscCircularBufferTest, HandsOffAcrossThreadsInOrder) {
+  constexpr int COUNT = 200000;
+  spsc_circular_buffer<int> buffer(64);
+
+  std::thread producer([&buffer]() {
+    for (int i = 0; i < COUNT; ++i) {
+      while (!buffer.push_back(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0;
+  while (expected < COUNT) {
+    int value = -1;
+    if (buffer.pop_front(value)) {
+      ASSERT_EQ(value, expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(buffer.empty());
+}
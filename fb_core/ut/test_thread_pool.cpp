@@ -0,0 +1,220 @@
+/// @file test_thread_pool.cpp
+/// @brief Unit tests for the work-stealing thread pool
+
+#include <gtest/gtest.h>
+#include <fb/fb_signal.hpp>
+#include <fb/thread_pool.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+using namespace std::chrono_literals;
+
+// ============================================================================
+// Task Tests
+// ============================================================================
+
+TEST(TaskTest, SmallCallableStoredInline)
+{
+  int calls = 0;
+  auto small = [&calls]() { ++calls; };
+  EXPECT_TRUE(task::is_inline<decltype(small)>());
+
+  task t(small);
+  ASSERT_TRUE(t);
+  t();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(TaskTest, LargeAndMoveOnlyCallables)
+{
+  std::array<char, 128> payload{};
+  payload[127] = 'x';
+  char seen    = 0;
+  auto large   = [payload, &seen]() { seen = payload[127]; };
+  EXPECT_FALSE(task::is_inline<decltype(large)>());
+
+  task big(large);
+  big();
+  EXPECT_EQ(seen, 'x');
+
+  auto owned = std::make_unique<int>(7);
+  int value  = 0;
+  task move_only([owned = std::move(owned), &value]() { value = *owned; });
+  move_only();
+  EXPECT_EQ(value, 7);
+}
+
+TEST(TaskTest, MoveTransfersCallable)
+{
+  auto counter = std::make_shared<int>(0);
+  task first([counter]() { ++*counter; });
+  EXPECT_EQ(counter.use_count(), 2);
+
+  task second(std::move(first));
+  EXPECT_FALSE(first);
+  second();
+  EXPECT_EQ(*counter, 1);
+
+  task third;
+  third  = std::move(second);
+  second = task();
+  third();
+  EXPECT_EQ(*counter, 2);
+
+  third = task();
+  EXPECT_EQ(counter.use_count(), 1);
+}
+
+// ============================================================================
+// Thread Pool Tests
+// ============================================================================
+
+TEST(ThreadPoolTest, RunsEverySubmittedTask)
+{
+  thread_pool pool(4);
+  EXPECT_EQ(pool.size(), 4u);
+
+  std::atomic<int> total{0};
+  for (int i = 1; i <= 1000; ++i)
+  {
+    pool.submit([&total, i]() { total.fetch_add(i, std::memory_order_relaxed); });
+  }
+  pool.wait_idle();
+
+  EXPECT_EQ(total.load(), 500500);
+  EXPECT_EQ(pool.pending(), 0u);
+}
+
+TEST(ThreadPoolTest, DefaultSizeUsesHardwareThreads)
+{
+  thread_pool pool;
+  EXPECT_GE(pool.size(), 1u);
+}
+
+TEST(ThreadPoolTest, TasksSubmittedFromTasksRunOnWorkers)
+{
+  thread_pool pool(2);
+  std::atomic<int> same_worker{0};
+  std::atomic<int> done{0};
+
+  for (int i = 0; i < 2; ++i)
+  {
+    pool.submit([&pool, &same_worker, &done]()
+    {
+      const std::size_t parent = pool.current_worker();
+      pool.submit([&pool, &same_worker, &done, parent]()
+      {
+        // Stolen or not, it runs on one of the pool's workers
+        if (pool.current_worker() == parent)
+        {
+          same_worker.fetch_add(1);
+        }
+        EXPECT_NE(pool.current_worker(), thread_pool::npos);
+        done.fetch_add(1);
+      });
+    });
+  }
+  pool.wait_idle();
+
+  EXPECT_EQ(done.load(), 2);
+  EXPECT_LE(same_worker.load(), 2);
+  EXPECT_EQ(pool.current_worker(), thread_pool::npos);
+}
+
+TEST(ThreadPoolTest, IdleWorkersStealQueuedWork)
+{
+  thread_pool pool(4);
+  std::atomic<int> done{0};
+
+  // Every task lands on worker 0; the others only get work by stealing
+  for (int i = 0; i < 64; ++i)
+  {
+    pool.submit_to(0, [&done]()
+    {
+      std::this_thread::sleep_for(1ms);
+      done.fetch_add(1);
+    });
+  }
+  pool.wait_idle();
+
+  EXPECT_EQ(done.load(), 64);
+  EXPECT_GT(pool.stolen_count(), 0u);
+}
+
+TEST(ThreadPoolTest, DestructorRunsQueuedTasks)
+{
+  std::atomic<int> done{0};
+  {
+    thread_pool pool(2);
+    for (int i = 0; i < 100; ++i)
+    {
+      pool.submit([&done]() { done.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(done.load(), 100);
+}
+
+TEST(ThreadPoolTest, PinnedWorkers)
+{
+  thread_pool_options options;
+  options.threads = 2;
+  options.cpus    = {0};
+
+  thread_pool pool(options);
+  std::atomic<int> done{0};
+  pool.submit([&done]() { done.fetch_add(1); });
+  pool.submit([&done]() { done.fetch_add(1); });
+  pool.wait_idle();
+  EXPECT_EQ(done.load(), 2);
+
+  thread_pool_options invalid;
+  invalid.cpus = {-1};
+  EXPECT_THROW(thread_pool bad(invalid), std::invalid_argument);
+}
+
+TEST(ThreadPoolTest, SharedPoolIsOneInstance)
+{
+  EXPECT_EQ(&thread_pool::shared(), &thread_pool::shared());
+
+  std::atomic<bool> ran{false};
+  thread_pool::shared().submit([&ran]() { ran = true; });
+  thread_pool::shared().wait_idle();
+  EXPECT_TRUE(ran.load());
+}
+
+TEST(ThreadPoolTest, ExecutorForParallelEmission)
+{
+  thread_pool pool(4);
+  fb::signal<int> sig;
+  std::atomic<int> total{0};
+  std::atomic<int> first_band{0};
+  std::atomic<int> order_errors{0};
+
+  std::vector<fb::scoped_connection> conns;
+  for (int i = 0; i < 8; ++i)
+  {
+    conns.emplace_back(sig.connect([&](int value)
+    {
+      first_band.fetch_add(1);
+      total.fetch_add(value);
+    }, fb::priority::high));
+  }
+  conns.emplace_back(sig.connect([&](int)
+  {
+    if (first_band.load() != 8)
+    {
+      order_errors.fetch_add(1);
+    }
+  }, fb::priority::low));
+
+  sig.emit_parallel(pool, 2);
+
+  EXPECT_EQ(total.load(), 16);
+  EXPECT_EQ(order_errors.load(), 0);
+}
@@ -15,6 +15,8 @@
 #include <chrono>
 #include <atomic>
 #include <vector>
+#include <algorithm>
+#include <mutex>
 
 using namespace fb;
 using namespace std::chrono_literals;
@@ -538,9 +540,141 @@ TEST(TimerTest, AccuracyMode)
 
     t.set_accuracy(timer_accuracy::very_precise);
     EXPECT_EQ(t.accuracy(), timer_accuracy::very_precise);
+}
+
+TEST(TimerTest, VeryPreciseTimeouts)
+{
+    timer t;
+    t.set_accuracy(timer_accuracy::very_precise);
+
+    std::mutex mutex;
+    std::vector<std::chrono::steady_clock::time_point> fired;
+    t.timeout.connect([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        fired.push_back(std::chrono::steady_clock::now());
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    t.start(2ms);
+    std::this_thread::sleep_for(100ms);
+    t.stop();
+
+    // How late each timeout came after its slot on the 2ms grid
+    std::vector<std::chrono::nanoseconds> lateness;
+    for (const auto& at : fired) {
+        lateness.push_back((at - start) % std::chrono::nanoseconds(2ms));
+    }
+    ASSERT_GE(lateness.size(), 10u);
+    std::sort(lateness.begin(), lateness.end());
+    EXPECT_LT(lateness[lateness.size() / 2], 100us);
+}
+
+TEST(TimerTest, CoarseTimersShareOneThreadAndTick)
+{
+    const int numTimers = 50;
+    std::mutex mutex;
+    std::vector<std::thread::id> threads;
+    std::vector<std::chrono::steady_clock::time_point> fired;
+    std::vector<std::unique_ptr<timer>> timers;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numTimers; ++i) {
+        auto t = std::make_unique<timer>();
+        t->set_accuracy(timer_accuracy::coarse);
+        t->set_single_shot(true);
+        t->timeout.connect([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.push_back(std::this_thread::get_id());
+            fired.push_back(std::chrono::steady_clock::now());
+        });
+        t->start(1 + i % 25);
+        timers.push_back(std::move(t));
+    }
+
+    std::this_thread::sleep_for(80ms);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(fired.size(), static_cast<size_t>(numTimers));
+
+    // One service thread ran them all, in at most a few 10ms ticks
+    EXPECT_EQ(std::count(threads.begin(), threads.end(), threads.front()), numTimers);
+    EXPECT_NE(threads.front(), std::this_thread::get_id());
+
+    std::vector<std::chrono::steady_clock::rep> ticks;
+    for (const auto& at : fired) {
+        EXPECT_GE(at - start, 1ms);
+        ticks.push_back(at.time_since_epoch() / timer_service::COARSE_TICK);
+    }
+    ticks.erase(std::unique(ticks.begin(), ticks.end()), ticks.end());
+    EXPECT_LE(ticks.size(), 5u);
+}
+
+TEST(TimerTest, CoarseRepeatingTimer)
+{
+    timer t;
+    t.set_accuracy(timer_accuracy::coarse);
+    std::atomic<int> count{0};
+    t.timeout.connect([&count]() { count++; });
 
-    // Note: Accuracy mode doesn't affect behavior in current implementation
-    // This just tests the API
+    t.start(20);
+    EXPECT_TRUE(t.is_active());
+    std::this_thread::sleep_for(110ms);
+    t.stop();
+    EXPECT_FALSE(t.is_active());
+
+    const int stopped = count.load();
+    EXPECT_GE(stopped, 3);
+    EXPECT_LE(stopped, 6);
+    std::this_thread::sleep_for(40ms);
+    EXPECT_EQ(count.load(), stopped);
+}
+
+// ============================================================================
+// Sub-millisecond Interval Tests
+// ============================================================================
+
+TEST(TimerTest, ChronoInterval)
+{
+    timer t;
+    t.set_interval(std::chrono::seconds(2));
+    EXPECT_EQ(t.interval(), 2000);
+    EXPECT_EQ(t.interval_duration(), 2s);
+
+    t.set_interval(250us);
+    EXPECT_EQ(t.interval(), 0);
+    EXPECT_EQ(t.interval_duration(), 250us);
+
+    EXPECT_THROW(t.start(0ns), std::invalid_argument);
+    EXPECT_THROW(t.set_interval(-1ms), std::invalid_argument);
+    EXPECT_FALSE(t.is_active());
+}
+
+TEST(TimerTest, SubMillisecondRepeatingTimer)
+{
+    timer t;
+    std::atomic<int> count{0};
+    t.timeout.connect([&count]() { count++; });
+
+    t.start(250us);
+    std::this_thread::sleep_for(50ms);
+    t.stop();
+
+    EXPECT_GE(count.load(), 20);
+    EXPECT_LE(count.load(), 201);
+}
+
+TEST(TimerTest, SubMillisecondTimerOnStart)
+{
+    timer t;
+    std::atomic<int> count{0};
+    t.timeout.connect([&count]() { count++; });
+
+    t.set_interval(500us);
+    t.set_single_shot(true);
+    t.start();
+    std::this_thread::sleep_for(20ms);
+
+    EXPECT_EQ(count.load(), 1);
+    EXPECT_FALSE(t.is_active());
 }
 
 // ============================================================================
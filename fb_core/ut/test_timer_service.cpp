@@ -0,0 +1,387 @@
+/// @file test_timer_service.cpp
+/// @brief Unit tests for timer_service and timers attached to it
+
+#include <gtest/gtest.h>
+#include <fb/timer.h>
+#include <fb/timer_service.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace fb;
+using namespace std::chrono_literals;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+namespace
+{
+
+/// @brief Poll @p done for up to two seconds
+template <typename Predicate>
+bool wait_for(Predicate done)
+{
+  const auto give_up = std::chrono::steady_clock::now() + 2s;
+  while (!done())
+  {
+    if (std::chrono::steady_clock::now() > give_up)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+
+} // namespace
+
+// ============================================================================
+// Scheduling Tests
+// ============================================================================
+
+TEST(TimerServiceTest, FiresOnceAfterDelay)
+{
+  timer_service service;
+  EXPECT_EQ(service.thread_count(), 1u);
+
+  std::atomic<int> fired{0};
+  const auto start = std::chrono::steady_clock::now();
+  std::atomic<std::chrono::steady_clock::time_point> at{start};
+  service.schedule_after(20ms, [&]() {
+    at = std::chrono::steady_clock::now();
+    ++fired;
+  });
+  EXPECT_EQ(service.size(), 1u);
+
+  ASSERT_TRUE(wait_for([&]() { return fired.load() == 1; }));
+  EXPECT_GE(at.load() - start, 20ms);
+  std::this_thread::sleep_for(30ms);
+  EXPECT_EQ(fired.load(), 1);
+  EXPECT_EQ(service.size(), 0u);
+}
+
+TEST(TimerServiceTest, FiresInDeadlineOrder)
+{
+  timer_service service;
+
+  // Hold the service thread so every timer below is due by the time it runs
+  std::promise<void> release;
+  std::shared_future<void> gate = release.get_future().share();
+  service.schedule_after(0ms, [gate]() { gate.wait(); });
+
+  std::mt19937 rng(97);
+  const auto base = std::chrono::steady_clock::now();
+  std::mutex mutex;
+  std::vector<std::pair<long, int>> fired;
+  std::vector<std::pair<long, int>> expected;
+  std::vector<timer_service::timer_id> ids;
+  for (int i = 0; i < 2000; ++i)
+  {
+    const long offset = static_cast<long>(rng() % 500);  // Many equal deadlines
+    ids.push_back(service.schedule_at(base + std::chrono::microseconds(offset), [&mutex, &fired, offset, i]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      fired.emplace_back(offset, i);
+    }));
+    expected.emplace_back(offset, i);
+  }
+
+  // Cancel every third timer, which takes entries out of the middle of the heap
+  std::vector<std::pair<long, int>> kept;
+  for (std::size_t i = 0; i < ids.size(); ++i)
+  {
+    if (i % 3 == 0)
+    {
+      EXPECT_TRUE(service.cancel(ids[i]));
+    }
+    else
+    {
+      kept.push_back(expected[i]);
+    }
+  }
+  std::stable_sort(kept.begin(), kept.end(),
+                   [](const auto & a, const auto & b) { return a.first < b.first; });
+
+  release.set_value();
+  ASSERT_TRUE(wait_for([&]() { return service.size() == 0; }));
+  EXPECT_EQ(fired, kept);
+}
+
+TEST(TimerServiceTest, RepeatingTimer)
+{
+  timer_service service;
+  std::atomic<int> count{0};
+  const auto id = service.schedule_every(10ms, [&count]() { ++count; });
+
+  ASSERT_TRUE(wait_for([&]() { return count.load() >= 3; }));
+  EXPECT_TRUE(service.cancel(id));
+  const int stopped = count.load();
+  std::this_thread::sleep_for(30ms);
+  EXPECT_EQ(count.load(), stopped);
+  EXPECT_EQ(service.size(), 0u);
+}
+
+TEST(TimerServiceTest, ManyTimersOnOneThread)
+{
+  timer_service service;
+  std::atomic<int> fired{0};
+  std::vector<timer_service::timer_id> ids;
+  for (int i = 0; i < 10000; ++i)
+  {
+    ids.push_back(service.schedule_after(std::chrono::microseconds(i * 3), [&fired]() { ++fired; }));
+  }
+  int cancelled = 0;
+  for (std::size_t i = 0; i < ids.size(); i += 2)
+  {
+    cancelled += service.cancel(ids[i]) ? 1 : 0;
+  }
+
+  ASSERT_TRUE(wait_for([&]() { return service.size() == 0; }));
+  EXPECT_EQ(fired.load() + cancelled, 10000);
+}
+
+TEST(TimerServiceTest, SeveralThreads)
+{
+  timer_service service(2);
+  EXPECT_EQ(service.thread_count(), 2u);
+
+  // A slow callback on one thread does not hold up the other timers
+  std::promise<void> release;
+  std::shared_future<void> gate = release.get_future().share();
+  service.schedule_after(0ms, [gate]() { gate.wait(); });
+
+  std::atomic<bool> fired{false};
+  service.schedule_after(5ms, [&fired]() { fired = true; });
+  EXPECT_TRUE(wait_for([&]() { return fired.load(); }));
+  release.set_value();
+}
+
+TEST(TimerServiceTest, SlackRoundsDeadlinesUpToTicks)
+{
+  const auto tick = 10ms;
+  timer_service service(1, tick);
+  EXPECT_EQ(service.slack(), tick);
+
+  std::mutex mutex;
+  std::vector<std::pair<timer_service::clock::time_point, timer_service::clock::time_point>> fired;
+  const auto base = timer_service::clock::now();
+  for (int i = 0; i < 100; ++i)
+  {
+    const auto deadline = base + std::chrono::microseconds(250 * i);
+    service.schedule_at(deadline, [&mutex, &fired, deadline]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      fired.emplace_back(deadline, timer_service::clock::now());
+    });
+  }
+
+  ASSERT_TRUE(wait_for([&]() { return service.size() == 0; }));
+  std::vector<timer_service::clock::rep> ticks;
+  for (const auto & [deadline, at] : fired)
+  {
+    // Never early: on or after the first tick at or after the deadline
+    const auto tick_of_deadline = (deadline.time_since_epoch() + tick - 1ns) / tick;
+    EXPECT_GE(at.time_since_epoch() / tick, tick_of_deadline);
+    ticks.push_back(at.time_since_epoch() / tick);
+  }
+  ticks.erase(std::unique(ticks.begin(), ticks.end()), ticks.end());
+  EXPECT_LE(ticks.size(), 5u);  // 25ms of deadlines in three or four wakeups
+}
+
+TEST(TimerServiceTest, SlackKeepsRepeatingSchedule)
+{
+  // A 15ms period on a 10ms tick fires every 10 or 20ms, averaging 15ms
+  timer_service service(1, 10ms);
+  std::atomic<int> count{0};
+  const auto id = service.schedule_every(15ms, [&count]() { ++count; });
+  std::this_thread::sleep_for(160ms);
+  service.cancel(id);
+  EXPECT_GE(count.load(), 8);
+  EXPECT_LE(count.load(), 11);
+}
+
+TEST(TimerServiceTest, InvalidPeriod)
+{
+  timer_service service;
+  EXPECT_THROW(service.schedule_every(0ms, []() {}), std::invalid_argument);
+  EXPECT_THROW(service.schedule_every(-1ms, []() {}), std::invalid_argument);
+  EXPECT_THROW(timer_service(1, -1ms), std::invalid_argument);
+}
+
+// ============================================================================
+// Cancellation Tests
+// ============================================================================
+
+TEST(TimerServiceTest, CancelBeforeFiring)
+{
+  timer_service service;
+  std::atomic<bool> fired{false};
+  const auto id = service.schedule_after(20ms, [&fired]() { fired = true; });
+
+  EXPECT_TRUE(service.cancel(id));
+  EXPECT_FALSE(service.cancel(id));
+  EXPECT_FALSE(service.cancel(timer_service::invalid_id));
+  std::this_thread::sleep_for(40ms);
+  EXPECT_FALSE(fired.load());
+}
+
+TEST(TimerServiceTest, StaleIdDoesNotCancelReusedSlot)
+{
+  timer_service service;
+  std::atomic<int> fired{0};
+  const auto first = service.schedule_after(0ms, [&fired]() { ++fired; });
+  ASSERT_TRUE(wait_for([&]() { return fired.load() == 1; }));
+  ASSERT_TRUE(wait_for([&]() { return service.size() == 0; }));
+
+  const auto second = service.schedule_after(10ms, [&fired]() { ++fired; });
+  EXPECT_NE(first, second);
+  EXPECT_FALSE(service.cancel(first));
+  EXPECT_TRUE(wait_for([&]() { return fired.load() == 2; }));
+}
+
+TEST(TimerServiceTest, CancelFromOwnCallback)
+{
+  timer_service service;
+  std::atomic<int> count{0};
+  std::atomic<timer_service::timer_id> id{timer_service::invalid_id};
+  std::atomic<bool> cancelled{false};
+  id = service.schedule_every(5ms, [&]() {
+    ++count;
+    cancelled = service.cancel(id.load());
+  });
+
+  ASSERT_TRUE(wait_for([&]() { return service.size() == 0; }));
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(count.load(), 1);
+  EXPECT_TRUE(cancelled.load());
+}
+
+TEST(TimerServiceTest, CancelWaitsForRunningCallback)
+{
+  timer_service service;
+  std::atomic<bool> started{false};
+  std::atomic<bool> finished{false};
+  const auto id = service.schedule_every(1ms, [&]() {
+    started = true;
+    std::this_thread::sleep_for(30ms);
+    finished = true;
+  });
+
+  ASSERT_TRUE(wait_for([&]() { return started.load(); }));
+  EXPECT_TRUE(service.cancel(id));
+  EXPECT_TRUE(finished.load());
+}
+
+TEST(TimerServiceTest, DestructorDropsPendingTimers)
+{
+  std::atomic<bool> fired{false};
+  {
+    timer_service service;
+    service.schedule_after(50ms, [&fired]() { fired = true; });
+  }
+  std::this_thread::sleep_for(70ms);
+  EXPECT_FALSE(fired.load());
+}
+
+// ============================================================================
+// Attached Timer Tests
+// ============================================================================
+
+TEST(TimerServiceTest, TimerRunsOnService)
+{
+  timer_service service;
+  timer t(service);
+  std::atomic<int> count{0};
+  std::atomic<bool> on_service{true};
+  const auto caller = std::this_thread::get_id();
+  t.timeout.connect([&]() {
+    on_service = on_service && std::this_thread::get_id() != caller;
+    ++count;
+  });
+
+  t.start(10);
+  EXPECT_TRUE(t.is_active());
+  EXPECT_EQ(service.size(), 1u);
+  EXPECT_GT(t.remaining_time(), 0);
+
+  ASSERT_TRUE(wait_for([&]() { return count.load() >= 3; }));
+  t.stop();
+  EXPECT_FALSE(t.is_active());
+  EXPECT_EQ(service.size(), 0u);
+  EXPECT_TRUE(on_service.load());
+}
+
+TEST(TimerServiceTest, ManyTimersShareOneThread)
+{
+  timer_service service;
+  std::atomic<int> fired{0};
+  std::vector<std::unique_ptr<timer>> timers;
+  for (int i = 0; i < 500; ++i)
+  {
+    timers.push_back(std::make_unique<timer>(service));
+    timers.back()->set_single_shot(true);
+    timers.back()->timeout.connect([&fired]() { ++fired; });
+    timers.back()->start(5 + i % 20);
+  }
+
+  ASSERT_TRUE(wait_for([&]() { return fired.load() == 500; }));
+  for (const auto & t : timers)
+  {
+    EXPECT_FALSE(t->is_active());
+  }
+}
+
+TEST(TimerServiceTest, TimerStopAndRestartFromSlot)
+{
+  timer_service service;
+  timer t(service);
+  std::atomic<int> count{0};
+  t.timeout.connect([&]() {
+    if (++count == 2)
+    {
+      t.restart();
+    }
+    else if (count == 4)
+    {
+      t.stop();
+    }
+  });
+
+  t.start(5);
+  ASSERT_TRUE(wait_for([&]() { return !t.is_active(); }));
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(count.load(), 4);
+}
+
+TEST(TimerServiceTest, DestroyedTimerNeverFires)
+{
+  timer_service service;
+  std::atomic<bool> fired{false};
+  {
+    timer t(service);
+    t.timeout.connect([&fired]() { fired = true; });
+    t.start(10);
+  }
+  EXPECT_EQ(service.size(), 0u);
+  std::this_thread::sleep_for(30ms);
+  EXPECT_FALSE(fired.load());
+}
+
+TEST(TimerServiceTest, SingleShotOnService)
+{
+  timer_service service;
+  std::atomic<bool> fired{false};
+  auto t = timer::single_shot(service, 10, [&fired]() { fired = true; });
+  EXPECT_TRUE(t->is_single_shot());
+  EXPECT_EQ(service.size(), 1u);
+
+  ASSERT_TRUE(wait_for([&]() { return fired.load(); }));
+  EXPECT_FALSE(t->is_active());
+}
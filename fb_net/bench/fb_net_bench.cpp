@@ -0,0 +1,464 @@
+/// @file fb_net_bench.cpp
+/// @brief Repeatable network benchmarks for regression tracking
+/// @note All traffic stays on the loopback interface. Run with --format=json
+///       to get one JSON object per result line for comparison across builds.
+
+#include <fb/fb_net.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// ============================================================================
+// Results and reporting
+// ============================================================================
+
+enum class output_format { table, json, csv };
+
+struct result {
+  std::string benchmark;
+  std::string variant;
+  std::vector<std::pair<std::string, double>> metrics;
+  std::string skipped; ///< Reason the benchmark could not run, if any
+};
+
+struct options {
+  output_format format = output_format::table;
+  std::string filter;
+  std::size_t scale = 10; ///< Iteration multiplier; --quick sets 1
+};
+
+std::string format_number(double value) {
+  std::ostringstream out;
+  if (value == static_cast<double>(static_cast<std::int64_t>(value)))
+    out << static_cast<std::int64_t>(value);
+  else
+    out << std::fixed << std::setprecision(2) << value;
+  return out.str();
+}
+
+std::string json_escape(const std::string &text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+void report(const options &opts, const result &r) {
+  switch (opts.format) {
+  case output_format::json: {
+    std::cout << "{\"benchmark\":\"" << r.benchmark << "\",\"variant\":\""
+              << r.variant << "\"";
+    if (!r.skipped.empty())
+      std::cout << ",\"skipped\":\"" << json_escape(r.skipped) << "\"";
+    for (const auto &metric : r.metrics)
+      std::cout << ",\"" << metric.first << "\":" << format_number(metric.second);
+    std::cout << "}\n";
+    break;
+  }
+  case output_format::csv:
+    for (const auto &metric : r.metrics)
+      std::cout << r.benchmark << ',' << r.variant << ',' << metric.first << ','
+                << format_number(metric.second) << '\n';
+    if (!r.skipped.empty())
+      std::cout << r.benchmark << ',' << r.variant << ",skipped,0\n";
+    break;
+  case output_format::table:
+    std::cout << std::left << std::setw(22) << r.benchmark << std::setw(16)
+              << r.variant;
+    if (!r.skipped.empty())
+      std::cout << "skipped: " << r.skipped;
+    for (const auto &metric : r.metrics)
+      std::cout << ' ' << metric.first << '=' << format_number(metric.second);
+    std::cout << '\n';
+    break;
+  }
+  std::cout.flush();
+}
+
+bool selected(const options &opts, const std::string &name) {
+  return opts.filter.empty() || name.find(opts.filter) != std::string::npos;
+}
+
+void add_latency(result &r, const fb::latency_snapshot &s) {
+  r.metrics.emplace_back("samples", static_cast<double>(s.count));
+  r.metrics.emplace_back("mean_ns", static_cast<double>(s.mean.count()));
+  r.metrics.emplace_back("p50_ns", static_cast<double>(s.p50.count()));
+  r.metrics.emplace_back("p90_ns", static_cast<double>(s.p90.count()));
+  r.metrics.emplace_back("p99_ns", static_cast<double>(s.p99.count()));
+  r.metrics.emplace_back("p999_ns", static_cast<double>(s.p999.count()));
+  r.metrics.emplace_back("max_ns", static_cast<double>(s.max.count()));
+}
+
+fb::server_socket loopback_listener(int backlog = 128) {
+  fb::server_socket listener(fb::socket_address::Family::IPv4);
+  listener.bind(fb::socket_address("127.0.0.1", 0));
+  listener.listen(backlog);
+  return listener;
+}
+
+// ============================================================================
+// TCP echo round trip
+// ============================================================================
+
+class threaded_echo : public fb::tcp_server_connection {
+public:
+  using tcp_server_connection::tcp_server_connection;
+
+  void run() override {
+    socket().set_no_delay(true);
+    char buffer[64 * 1024];
+    try {
+      while (!stop_requested()) {
+        const int received = socket().receive_bytes(buffer, sizeof(buffer));
+        if (received <= 0)
+          break;
+        socket().send_bytes_all(buffer, received);
+      }
+    } catch (const std::exception &) {
+      // Client went away
+    }
+  }
+};
+
+class reactor_echo : public fb::tcp_reactor_connection {
+public:
+  using tcp_reactor_connection::tcp_reactor_connection;
+
+  void on_open() override { socket().set_no_delay(true); }
+
+  void on_readable() override {
+    char buffer[64 * 1024];
+    const int received = socket().receive_bytes(buffer, sizeof(buffer));
+    if (received <= 0) {
+      close();
+      return;
+    }
+    send_buffered(buffer, static_cast<std::size_t>(received));
+  }
+};
+
+void bench_tcp_echo_rtt(const options &opts, bool reactor, std::size_t payload) {
+  result r{"tcp_echo_rtt", std::string(reactor ? "reactor/" : "threaded/") +
+                               std::to_string(payload) + "B",
+           {}, {}};
+
+  fb::server_socket listener = loopback_listener();
+  const fb::socket_address address = listener.address();
+  fb::tcp_server server;
+  server.set_server_socket(std::move(listener));
+  if (reactor) {
+    server.set_reactor_factory(
+        [](fb::tcp_client socket, const fb::socket_address &peer) {
+          return std::make_unique<reactor_echo>(std::move(socket), peer);
+        },
+        1);
+  } else {
+    server.set_connection_factory(
+        [](fb::tcp_client socket, const fb::socket_address &peer) {
+          return std::make_unique<threaded_echo>(std::move(socket), peer);
+        });
+    server.set_connection_timeout(std::chrono::milliseconds(0));
+  }
+  server.start();
+
+  fb::tcp_client client(fb::socket_address::Family::IPv4);
+  client.connect(address, std::chrono::seconds(2));
+  client.set_no_delay(true);
+  client.set_receive_timeout(std::chrono::seconds(2));
+
+  std::vector<char> request(payload, 'x');
+  std::vector<char> reply(payload);
+  auto round_trip = [&]() {
+    client.send_bytes_all(request.data(), static_cast<int>(payload));
+    std::size_t received = 0;
+    while (received < payload) {
+      const int n = client.receive_bytes(reply.data() + received,
+                                         static_cast<int>(payload - received));
+      if (n <= 0)
+        throw std::runtime_error("Echo server closed the connection");
+      received += static_cast<std::size_t>(n);
+    }
+  };
+
+  for (std::size_t i = 0; i < 1000; ++i)
+    round_trip();
+
+  fb::latency_histogram histogram;
+  const std::size_t samples = 2000 * opts.scale;
+  for (std::size_t i = 0; i < samples; ++i) {
+    const auto start = clock_type::now();
+    round_trip();
+    histogram.record(clock_type::now() - start);
+  }
+
+  client.close();
+  server.stop();
+  add_latency(r, histogram.snapshot());
+  report(opts, r);
+}
+
+// ============================================================================
+// UDP packet rate
+// ============================================================================
+
+class counting_handler : public fb::udp_handler {
+public:
+  void handle_packet(const void *, std::size_t,
+                     const fb::socket_address &) override {}
+};
+
+void bench_udp_pps(const options &opts, std::size_t payload) {
+  result r{"udp_pps", std::to_string(payload) + "B", {}, {}};
+
+  fb::udp_socket receiver(fb::socket_address::Family::IPv4);
+  receiver.bind(fb::socket_address("127.0.0.1", 0));
+  const fb::socket_address address = receiver.address();
+
+  auto handler = std::make_shared<counting_handler>();
+  fb::udp_server server(std::move(receiver), handler);
+  server.start();
+
+  fb::udp_socket sender(fb::socket_address::Family::IPv4);
+  std::vector<char> datagram(payload, 'x');
+  const auto duration = std::chrono::milliseconds(100 * opts.scale);
+
+  std::uint64_t sent = 0;
+  const auto start = clock_type::now();
+  while (clock_type::now() - start < duration) {
+    for (int i = 0; i < 64; ++i) {
+      try {
+        sender.send_to(datagram.data(), static_cast<int>(payload), address);
+        ++sent;
+      } catch (const std::system_error &) {
+        // Socket buffer full; the datagram counts as not sent
+      }
+    }
+  }
+  const double seconds =
+      std::chrono::duration<double>(clock_type::now() - start).count();
+
+  // Let the server drain what is still queued
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  const std::uint64_t received = handler->packets_processed();
+  server.stop();
+
+  r.metrics.emplace_back("sent_pps", static_cast<double>(sent) / seconds);
+  r.metrics.emplace_back("received_pps", static_cast<double>(received) / seconds);
+  r.metrics.emplace_back(
+      "loss_pct",
+      sent == 0 ? 0.0
+                : 100.0 * static_cast<double>(sent - std::min(sent, received)) /
+                      static_cast<double>(sent));
+  r.metrics.emplace_back("received_mbps",
+                         static_cast<double>(received * payload) * 8.0 / seconds / 1e6);
+  report(opts, r);
+}
+
+// ============================================================================
+// poll_set scalability
+// ============================================================================
+
+/// Raise the open-file soft limit as far as allowed; returns the limit.
+std::size_t raise_fd_limit() {
+#ifndef _WIN32
+  rlimit limit{};
+  if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+    return 1024;
+  if (limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    getrlimit(RLIMIT_NOFILE, &limit);
+  }
+  const std::size_t current = limit.rlim_cur;
+  return current;
+#else
+  return 1 << 20;
+#endif
+}
+
+void bench_poll_set(const options &opts, std::size_t sockets) {
+  result r{"poll_set", std::to_string(sockets) + "_fds", {}, {}};
+
+  const std::size_t fd_limit = raise_fd_limit();
+  if (sockets + 64 > fd_limit) {
+    r.skipped = "open file limit " + std::to_string(fd_limit);
+    report(opts, r);
+    return;
+  }
+  if (!fb::poll_set::efficient_polling() && sockets > 1000) {
+    r.skipped = std::string("no scalable backend (") +
+                fb::poll_set::polling_method() + ")";
+    report(opts, r);
+    return;
+  }
+
+  // One ready socket among many idle ones: cost should track ready sockets
+  fb::udp_socket active(fb::socket_address::Family::IPv4);
+  active.bind(fb::socket_address("127.0.0.1", 0));
+  fb::udp_socket sender(fb::socket_address::Family::IPv4);
+  sender.send_to("x", 1, active.address());
+
+  std::vector<std::unique_ptr<fb::udp_socket>> idle;
+  idle.reserve(sockets - 1);
+  for (std::size_t i = 0; i + 1 < sockets; ++i)
+    idle.push_back(std::make_unique<fb::udp_socket>(fb::socket_address::Family::IPv4));
+
+  fb::poll_set poller;
+  const auto add_start = clock_type::now();
+  for (const auto &socket : idle)
+    poller.add(*socket, fb::poll_set::POLL_READ);
+  poller.add(active, fb::poll_set::POLL_READ);
+  const auto add_ns =
+      std::chrono::duration<double, std::nano>(clock_type::now() - add_start).count();
+
+  fb::latency_histogram histogram;
+  const std::size_t polls = 1000 * opts.scale;
+  for (std::size_t i = 0; i < polls; ++i) {
+    const auto start = clock_type::now();
+    poller.poll(std::chrono::milliseconds(0));
+    histogram.record(clock_type::now() - start);
+  }
+
+  const auto remove_start = clock_type::now();
+  for (const auto &socket : idle)
+    poller.remove(*socket);
+  const auto remove_ns =
+      std::chrono::duration<double, std::nano>(clock_type::now() - remove_start).count();
+
+  r.metrics.emplace_back("add_ns_per_fd", add_ns / static_cast<double>(sockets));
+  r.metrics.emplace_back("remove_ns_per_fd",
+                         remove_ns / static_cast<double>(sockets - 1));
+  const fb::latency_snapshot snapshot = histogram.snapshot();
+  r.metrics.emplace_back("poll_p50_ns", static_cast<double>(snapshot.p50.count()));
+  r.metrics.emplace_back("poll_p99_ns", static_cast<double>(snapshot.p99.count()));
+  report(opts, r);
+}
+
+// ============================================================================
+// Accept rate
+// ============================================================================
+
+class closing_connection : public fb::tcp_server_connection {
+public:
+  using tcp_server_connection::tcp_server_connection;
+  void run() override {}
+};
+
+void bench_accept_rate(const options &opts) {
+  result r{"accept_rate", "threaded", {}, {}};
+
+  fb::server_socket listener = loopback_listener(1024);
+  const fb::socket_address address = listener.address();
+  const std::size_t connections = 200 * opts.scale;
+
+  fb::tcp_server server;
+  server.set_server_socket(std::move(listener));
+  server.set_connection_factory(
+      [](fb::tcp_client socket, const fb::socket_address &peer) {
+        return std::make_unique<closing_connection>(std::move(socket), peer);
+      });
+  server.set_max_queued(connections);
+  server.start();
+
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < connections; ++i) {
+    fb::tcp_client client(fb::socket_address::Family::IPv4);
+    client.connect(address, std::chrono::seconds(2));
+  }
+  const auto deadline = clock_type::now() + std::chrono::seconds(10);
+  while (server.total_connections() < connections && clock_type::now() < deadline)
+    std::this_thread::yield();
+  const double seconds =
+      std::chrono::duration<double>(clock_type::now() - start).count();
+  const std::uint64_t accepted = server.total_connections();
+  server.stop();
+
+  r.metrics.emplace_back("connections", static_cast<double>(accepted));
+  r.metrics.emplace_back("accepts_per_sec", static_cast<double>(accepted) / seconds);
+  report(opts, r);
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+void usage() {
+  std::cout << "usage: fb_net_bench [--format=table|json|csv] [--quick] "
+               "[--filter=<substring>]\n";
+}
+
+template <typename Fn>
+void run(const options &opts, const std::string &name, Fn &&fn) {
+  if (!selected(opts, name))
+    return;
+  try {
+    fn();
+  } catch (const std::exception &ex) {
+    result r{name, "error", {}, ex.what()};
+    report(opts, r);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--format=json")
+      opts.format = output_format::json;
+    else if (arg == "--format=csv")
+      opts.format = output_format::csv;
+    else if (arg == "--format=table")
+      opts.format = output_format::table;
+    else if (arg == "--quick")
+      opts.scale = 1;
+    else if (arg.rfind("--filter=", 0) == 0)
+      opts.filter = arg.substr(9);
+    else {
+      usage();
+      return arg == "--help" ? 0 : 2;
+    }
+  }
+
+  fb::initialize_library();
+  if (opts.format == output_format::csv)
+    std::cout << "benchmark,variant,metric,value\n";
+
+  for (std::size_t payload : {std::size_t{64}, std::size_t{1024}, std::size_t{16384}}) {
+    run(opts, "tcp_echo_rtt", [&]() { bench_tcp_echo_rtt(opts, false, payload); });
+    run(opts, "tcp_echo_rtt", [&]() { bench_tcp_echo_rtt(opts, true, payload); });
+  }
+  for (std::size_t payload : {std::size_t{64}, std::size_t{512}, std::size_t{1400}, std::size_t{8192}})
+    run(opts, "udp_pps", [&]() { bench_udp_pps(opts, payload); });
+  for (std::size_t sockets : {std::size_t{1000}, std::size_t{10000}, std::size_t{100000}})
+    run(opts, "poll_set", [&]() { bench_poll_set(opts, sockets); });
+  run(opts, "accept_rate", [&]() { bench_accept_rate(opts); });
+
+  fb::cleanup_library();
+  return 0;
+}
@@ -30,6 +30,7 @@
 #include <fstream>
 #include <filesystem>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <thread>
 #include <sstream>
@@ -237,58 +238,36 @@ Ready for commands.
                 return;
             }
             
-            std::ifstream file(filepath, std::ios::binary);
-            if (!file.is_open()) {
-                send_response("ERROR Cannot open file: " + safe_filename);
-                return;
-            }
-            
-            // Get file size
-            file.seekg(0, std::ios::end);
-            const auto end_pos = file.tellg();
-            if (end_pos < 0) {
-                send_response("ERROR Failed to determine file size");
-                return;
-            }
-            const auto filesize = static_cast<std::size_t>(end_pos);
-            file.seekg(0, std::ios::beg);
+            const std::uint64_t filesize = std::filesystem::file_size(filepath);
             
             // Send file info
             send_response("OK " + std::to_string(filesize));
             
-            // Send file data
-            std::vector<char> buffer(BUFFER_SIZE);
-            std::size_t total_sent = 0;
+            // Send file data straight from the page cache (sendfile), one
+            // progress step at a time
+            constexpr std::uint64_t PROGRESS_STEP = 1024 * 1024;
+            std::uint64_t total_sent = 0;
             auto start_time = std::chrono::steady_clock::now();
             
-            while (!file.eof() && total_sent < filesize) {
-                file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
-                const auto bytes_read = file.gcount();
-                
-                if (bytes_read > 0) {
-                    if (bytes_read >
-                        static_cast<std::streamsize>((std::numeric_limits<int>::max)())) {
-                        throw std::length_error("Chunk size exceeds socket send capacity");
-                    }
-                    
-                    socket().send_bytes_all(buffer.data(), static_cast<int>(bytes_read));
-                    total_sent += static_cast<std::size_t>(bytes_read);
-                    
-                    // Progress update
-                    if ((total_sent % (1024 * 1024) == 0 || total_sent == filesize) &&
-                        filesize > 0) {
-                        const auto progress =
-                            (static_cast<double>(total_sent) * 100.0) /
-                            static_cast<double>(filesize);
-                        const auto previous_flags = std::cout.flags();
-                        const auto previous_precision = std::cout.precision();
-                        std::cout << "[DOWNLOAD] " << safe_filename << " - " << std::fixed
-                                  << std::setprecision(1) << progress << "% (" << total_sent << "/"
-                                  << filesize << " bytes)" << std::endl;
-                        std::cout.flags(previous_flags);
-                        std::cout.precision(previous_precision);
-                    }
+            while (total_sent < filesize) {
+                const auto chunk = std::min(PROGRESS_STEP, filesize - total_sent);
+                const auto sent = socket().send_file(filepath, total_sent, chunk);
+                if (sent == 0) {
+                    break; // File shrank while sending
                 }
+                total_sent += sent;
+                
+                // Progress update
+                const auto progress =
+                    (static_cast<double>(total_sent) * 100.0) /
+                    static_cast<double>(filesize);
+                const auto previous_flags = std::cout.flags();
+                const auto previous_precision = std::cout.precision();
+                std::cout << "[DOWNLOAD] " << safe_filename << " - " << std::fixed
+                          << std::setprecision(1) << progress << "% (" << total_sent << "/"
+                          << filesize << " bytes)" << std::endl;
+                std::cout.flags(previous_flags);
+                std::cout.precision(previous_precision);
             }
             
             auto end_time = std::chrono::steady_clock::now();
@@ -22,7 +22,6 @@
 
 #include <fb/fb_net.h>
 #include <iostream>
-#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -70,14 +69,16 @@ public:
                           << req.method << " " << req.path << std::endl;
                 
                 // Generate response
-                std::string response = generate_http_response(req);
+                std::string content;
+                std::string headers = generate_http_response(req, content);
                 
-                // Send response
-                const auto response_size = response.size();
-                if (response_size > static_cast<std::size_t>((std::numeric_limits<int>::max)())) {
-                    throw std::length_error("HTTP response exceeds maximum socket send size");
-                }
-                socket().send_bytes_all(response.c_str(), static_cast<int>(response_size));
+                // Send headers and body in one gathered write, without
+                // concatenating them first
+                const tcp_send_buffer segments[] = {
+                    {headers.data(), headers.size()},
+                    {content.data(), content.size()}
+                };
+                socket().send_vectored_all(segments, 2);
                 
                 // Close connection for HTTP/1.0 or if Connection: close
                 if (req.version == "HTTP/1.0" || req.connection == "close") {
@@ -189,12 +190,12 @@ private:
     /**
      * @brief Generate HTTP response for request
      * @param req Parsed HTTP request
-     * @return Complete HTTP response string
+     * @param content Receives the response body
+     * @return HTTP status line and headers
      */
-    std::string generate_http_response(const HTTPRequest& req)
+    std::string generate_http_response(const HTTPRequest& req, std::string& content)
     {
         std::ostringstream response;
-        std::string content;
         std::string status = "200 OK";
         std::string content_type = "text/html";
         
@@ -218,7 +219,6 @@ private:
         response << "Connection: " << req.connection << "\r\n";
         response << "Date: " << get_http_date() << "\r\n";
         response << "\r\n";
-        response << content;
         
         return response.str();
     }
@@ -3,19 +3,18 @@
  * @brief Port Scanner Example using FB_NET
  * 
  * This example demonstrates concurrent port scanning using FB_NET's
- * tcp_client and poll_set classes. It showcases how to efficiently
- * scan multiple ports simultaneously using polling and non-blocking
- * connection attempts.
+ * tcp_connector class. It scans many ports simultaneously from a single
+ * thread by keeping a window of non-blocking connects in flight.
  * 
  * Features demonstrated:
- * - Concurrent connection attempts using multiple tcp_client
- * - poll_set usage for managing multiple socket operations
+ * - Concurrent connection attempts with tcp_connector
+ * - Completion callbacks with per-attempt error codes
  * - Non-blocking socket operations
  * - Timeout handling for connection attempts
  * - Progress reporting and statistics
  * 
  * Usage:
- *   ./port_scanner <host> <start_port> <end_port> [threads]
+ *   ./port_scanner <host> <start_port> <end_port> [max_concurrent]
  *   Example: ./port_scanner localhost 20 80 10
  */
 
@@ -23,7 +22,6 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <thread>
 #include <atomic>
 #include <mutex>
 #include <chrono>
@@ -125,8 +123,32 @@ class ResultsCollector
   std::atomic<int> m_open_ports{0};
 };
 
+/**
+ * @brief Simple service name lookup for well-known ports
+ */
+std::string service_name(int port)
+{
+  switch (port) {
+  case 21: return "FTP";
+  case 22: return "SSH";
+  case 23: return "Telnet";
+  case 25: return "SMTP";
+  case 53: return "DNS";
+  case 80: return "HTTP";
+  case 110: return "POP3";
+  case 143: return "IMAP";
+  case 443: return "HTTPS";
+  case 993: return "IMAPS";
+  case 995: return "POP3S";
+  default: return "";
+  }
+}
+
 /**
  * @brief Port Scanner Worker
+ *
+ * Keeps up to max_concurrent non-blocking connects in flight on a single
+ * tcp_connector and refills the window as attempts complete.
  */
 class PortScanner
 {
@@ -150,86 +172,28 @@ class PortScanner
               << "-" << m_end_port << " (max " << m_max_concurrent
               << " concurrent)" << std::endl;
 
-    poll_set poll_set;
-    std::vector<std::unique_ptr<ConnectionAttempt>> active_connections;
+    tcp_connector connector;
     auto start_time = std::chrono::steady_clock::now();
+    const int total_ports = m_end_port - m_start_port + 1;
 
-    while (m_running && (m_current_port <= m_end_port || !active_connections.empty())) {
+    while (m_running && (m_current_port <= m_end_port || connector.pending() > 0)) {
       // Start new connections up to the limit
-      while (active_connections.size() < static_cast<size_t>(m_max_concurrent) &&
+      while (connector.pending() < static_cast<std::size_t>(m_max_concurrent) &&
              m_current_port <= m_end_port) {
-
+        const int port = m_current_port++;
         try {
-          auto attempt = std::make_unique<ConnectionAttempt>(m_host, m_current_port);
-          if (attempt->start()) {
-            poll_set.add(attempt->socket(), poll_set::POLL_WRITE);
-            active_connections.push_back(std::move(attempt));
-          }
+          start_attempt(connector, port);
         } catch (const std::exception&) {
           // Failed to start connection attempt
-          ScanResult result;
-          result.port = m_current_port;
-          result.is_open = false;
-          result.response_time = std::chrono::milliseconds(0);
-          m_collector.add_result(result);
+          m_collector.add_result({port, false, "", std::chrono::milliseconds(0)});
         }
-
-        m_current_port++;
       }
 
-      if (active_connections.empty()) {
-        break; // No more work to do
-      }
-
-      // Poll for socket events with timeout
-      std::vector<SocketEvent>  ready_sockets;
-      if (poll_set.poll(ready_sockets, std::chrono::milliseconds(100)) > 0) {
-
-        // Process ready sockets
-        auto it = active_connections.begin();
-        while (it != active_connections.end())
-        {
-          auto& attempt = *it;
-          bool completed = false;
-
-          // Check if this socket is ready
-          for (const auto& event : ready_sockets)
-          {
-            if (event.socket_ptr == &attempt->socket())
-            {
-              completed = attempt->check_completion();
-              if (completed)
-              {
-                poll_set.remove(attempt->socket());
-              }
-              break;
-            }
-          }
-
-          // Check for timeout
-          if (!completed && attempt->is_timed_out()) {
-            attempt->set_result(false, "timeout");
-            poll_set.remove(attempt->socket());
-            completed = true;
-          }
-
-          if (completed) {
-            // Collect result
-            ScanResult result = attempt->get_result();
-            m_collector.add_result(result);
-
-            // Remove from active list
-            it = active_connections.erase(it);
-          } else {
-            ++it;
-          }
-        }
-      }
-
-      // Update progress periodically
-      int total_ports = m_end_port - m_start_port + 1;
+      // Report completions; handlers record the results
+      connector.run(std::chrono::milliseconds(100));
       m_collector.print_progress(total_ports);
     }
+    connector.cancel_all();
 
     auto end_time = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -244,99 +208,24 @@ class PortScanner
   }
 
   private:
-  /**
-     * @brief Single connection attempt tracker
-     */
-  class ConnectionAttempt
-  {
-public:
-    ConnectionAttempt(const std::string& host, int port)
-      : m_host(host), m_port(port), m_start_time(std::chrono::steady_clock::now())
-    {
-    }
-
-    bool start()
-    {
-      try {
-        m_socket = tcp_client(socket_address::Family::IPv4);
-        m_socket.set_blocking(false);
-        m_socket.connect(socket_address(m_host, static_cast<std::uint16_t>(m_port)));
-        return true;
-      } catch (const std::exception&) {
-        // Connection failed immediately
-        set_result(false, "connection refused");
-        return false;
-      }
-    }
-
-    bool check_completion()
-    {
-      try {
-        // Simple check - if we can write to the socket, connection succeeded
-        // This is a simplified approach for the example
-        set_result(true, get_service_name());
-        return true;
-      } catch (const std::exception&) {
-        // Connection failed
-        set_result(false, "connection failed");
-        return true;
-      }
-    }
-
-    bool is_timed_out() const
-    {
-      auto now = std::chrono::steady_clock::now();
-      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_start_time);
-      return elapsed.count() > 3000; // 3 second timeout
-    }
-
-    void set_result(bool open, const std::string& info)
-    {
-      auto now = std::chrono::steady_clock::now();
-      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_start_time);
 
-      m_result.port = m_port;
-      m_result.is_open = open;
-      m_result.service_info = info;
-      m_result.response_time = elapsed;
-    }
-
-    ScanResult get_result() const
-    {
-      return m_result;
-    }
-
-    tcp_client& socket()
-    {
-      return m_socket;
-    }
-
-private:
-    std::string m_host;
-    int m_port;
-    tcp_client m_socket;
-    std::chrono::steady_clock::time_point m_start_time;
-    ScanResult m_result;
-
-    std::string get_service_name() const
-    {
-      // Simple service name lookup
-      switch (m_port) {
-      case 21: return "FTP";
-      case 22: return "SSH";
-      case 23: return "Telnet";
-      case 25: return "SMTP";
-      case 53: return "DNS";
-      case 80: return "HTTP";
-      case 110: return "POP3";
-      case 143: return "IMAP";
-      case 443: return "HTTPS";
-      case 993: return "IMAPS";
-      case 995: return "POP3S";
-      default: return "";
-      }
-    }
-  };
+  void start_attempt(tcp_connector& connector, int port)
+  {
+    const auto started = std::chrono::steady_clock::now();
+    connector.connect(
+        socket_address(m_host, static_cast<std::uint16_t>(port)),
+        std::chrono::milliseconds(3000),
+        [this, port, started](std::uint64_t, const socket_address&, tcp_client,
+                              const std::error_code& error) {
+          ScanResult result;
+          result.port = port;
+          result.is_open = !error;
+          result.service_info = error ? error.message() : service_name(port);
+          result.response_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - started);
+          m_collector.add_result(result);
+        });
+  }
 
   std::string m_host;
   int m_start_port;
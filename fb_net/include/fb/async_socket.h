@@ -0,0 +1,438 @@
+#pragma once
+
+/// @file async_socket.h
+/// @brief C++20 coroutine socket I/O driven by a poll_set
+///
+/// Header-only and compiled only when the including translation unit
+/// enables coroutines (FB_SIGNAL_HAS_COROUTINES), so fb_net itself keeps
+/// building as C++17.
+
+#include <fb/coroutine.hpp>
+
+#if FB_SIGNAL_HAS_COROUTINES
+
+#include <fb/event_queue.hpp>
+#include <fb/poll_set.h>
+#include <fb/socket_address.h>
+#include <fb/socket_base.h>
+#include <fb/udp_socket.h>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fb {
+
+namespace detail {
+
+/// @brief A coroutine suspended until its socket is ready
+struct io_waiter
+{
+  std::coroutine_handle<> handle;
+  bool (*retry)(io_waiter& self) = nullptr; ///< The awaitable's attempt()
+
+  /// @brief Try the operation again
+  /// @return false if it would still block
+  bool attempt() { return retry(*this); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Single-threaded event loop resuming coroutines on socket readiness
+ *
+ * Coroutines co_await async_receive() / async_send() (and the UDP
+ * variants); an operation that would block registers its socket with the
+ * reactor's poll_set and suspends. run() / run_once() poll and resume each
+ * coroutine whose socket became ready, on the calling thread. Protocol
+ * code reads sequentially while one thread serves many connections.
+ *
+ * Example:
+ * @code
+ * fb::detached_task echo(fb::async_reactor& reactor, fb::tcp_client& client)
+ * {
+ *   char buffer[512];
+ *   for (;;)
+ *   {
+ *     const int n = co_await fb::async_receive(reactor, client, buffer, 512);
+ *     if (n == 0) co_return;  // Peer closed
+ *     co_await fb::async_send_all(reactor, client, buffer, n);
+ *   }
+ * }
+ * @endcode
+ *
+ * @note Not thread-safe: await, run and stop from the reactor's thread.
+ * Cross-thread wake-ups go through an event_queue added with add(), e.g.
+ * `co_await sig.next(queue)`.
+ * @note At most one coroutine may wait to read, and one to write, per
+ * socket. A socket must outlive the operations awaiting it.
+ */
+class async_reactor
+{
+public:
+
+  async_reactor() = default;
+
+  async_reactor(const async_reactor&)            = delete;
+  async_reactor& operator=(const async_reactor&) = delete;
+
+  /// @brief Poll once and resume the coroutines whose sockets are ready
+  /// @return Number of coroutines resumed (queued events not counted)
+  std::size_t run_once(const std::chrono::milliseconds& timeout);
+
+  /// @brief Run until stop() or until no coroutine waits on a socket
+  void run();
+
+  /// @brief Make run() return after the current poll
+  void stop();
+
+  /// @brief Process @p queue on this reactor whenever it has events
+  ///
+  /// Lets a coroutine awaiting `sig.next(queue)` resume on the reactor
+  /// thread when another thread emits.
+  void add(event_queue& queue);
+  void remove(event_queue& queue);
+
+  /// @brief Coroutines suspended on a socket
+  std::size_t waiting() const;
+
+  /// @brief Suspend @p waiter until @p socket is ready for @p mode
+  /// (poll_set::POLL_READ or POLL_WRITE); used by the awaitables
+  void wait(socket_base& socket, int mode, detail::io_waiter* waiter);
+
+  /// @brief Forget @p waiter, whose coroutine is being destroyed
+  void cancel(socket_base& socket, int mode, detail::io_waiter* waiter);
+
+private:
+
+  struct interest
+  {
+    detail::io_waiter* reader = nullptr;
+    detail::io_waiter* writer = nullptr;
+    bool registered           = false;  ///< In m_poll
+  };
+
+  void update_interest(const socket_base& socket, interest& entry);
+
+  poll_set m_poll;
+  std::unordered_map<const socket_base*, interest> m_interest;
+  std::vector<SocketEvent> m_events;
+  std::vector<std::coroutine_handle<>> m_ready;
+  std::size_t m_waiting = 0;
+  bool m_stopped        = false;
+};
+
+/**
+ * @brief Awaitable socket operation, see async_receive() and friends
+ *
+ * The operation runs at once; only if it would block does the coroutine
+ * suspend. co_await yields its result or rethrows its error.
+ */
+template <typename Operation>
+class io_awaitable : private detail::io_waiter
+{
+public:
+
+  io_awaitable(async_reactor& reactor, socket_base& socket, int mode, Operation operation) :
+    m_reactor(reactor),
+    m_socket(socket),
+    m_mode(mode),
+    m_operation(std::move(operation))
+  {
+    retry = [](detail::io_waiter& self)
+    {
+      return static_cast<io_awaitable&>(self).attempt_operation();
+    };
+  }
+
+  io_awaitable(const io_awaitable&)            = delete;
+  io_awaitable& operator=(const io_awaitable&) = delete;
+
+  ~io_awaitable()
+  {
+    if (m_suspended)
+    {
+      m_reactor.cancel(m_socket, m_mode, this);
+    }
+  }
+
+  bool await_ready()
+  {
+    if (m_socket.get_blocking())
+    {
+      m_socket.set_blocking(false);
+    }
+    return attempt_operation();
+  }
+
+  void await_suspend(std::coroutine_handle<> awaiting)
+  {
+    handle = awaiting;
+    m_reactor.wait(m_socket, m_mode, this);
+    m_suspended = true;
+  }
+
+  auto await_resume()
+  {
+    m_suspended = false;
+    if (m_error)
+    {
+      std::rethrow_exception(m_error);
+    }
+    return m_result;
+  }
+
+private:
+
+  bool attempt_operation()
+  {
+    try
+    {
+      m_result = m_operation();
+      return true;
+    }
+    catch (const std::system_error& ex)
+    {
+      if (ex.code() == std::errc::resource_unavailable_try_again ||
+          ex.code() == std::errc::operation_would_block)
+      {
+        return false;
+      }
+      m_error = std::current_exception();
+    }
+    catch (...)
+    {
+      m_error = std::current_exception();
+    }
+    return true;
+  }
+
+  async_reactor& m_reactor;
+  socket_base& m_socket;
+  int m_mode;
+  Operation m_operation;
+  decltype(std::declval<Operation&>()()) m_result{};
+  std::exception_ptr m_error;
+  bool m_suspended = false;
+};
+
+/// @brief Receive up to @p length bytes; yields the count, 0 when the peer closed
+///
+/// For tcp_client and connected udp_socket. Switches the socket to
+/// non-blocking mode.
+template <typename Socket>
+auto async_receive(async_reactor& reactor, Socket& socket, void* buffer, int length, int flags = 0)
+{
+  auto operation = [&socket, buffer, length, flags]()
+  {
+    return socket.receive_bytes(buffer, length, flags);
+  };
+  return io_awaitable<decltype(operation)>(reactor, socket, poll_set::POLL_READ, operation);
+}
+
+/// @brief Send what fits of @p length bytes; yields the count sent
+template <typename Socket>
+auto async_send(async_reactor& reactor, Socket& socket, const void* buffer, int length, int flags = 0)
+{
+  auto operation = [&socket, buffer, length, flags]()
+  {
+    return socket.send_bytes(buffer, length, flags);
+  };
+  return io_awaitable<decltype(operation)>(reactor, socket, poll_set::POLL_WRITE, operation);
+}
+
+/// @brief Send all @p length bytes, suspending while the socket is full
+///
+/// Each step sends what fits; the remainder waits for writability. The
+/// coroutine yields @p length once every byte is sent.
+template <typename Socket>
+auto async_send_all(async_reactor& reactor, Socket& socket, const void* buffer, int length, int flags = 0)
+{
+  struct send_all
+  {
+    Socket& socket;
+    const char* data;
+    int length;
+    int flags;
+    int sent = 0;
+
+    int operator()()
+    {
+      while (sent < length)
+      {
+        // Throws would-block once the socket is full: resumed when writable
+        sent += socket.send_bytes(data + sent, length - sent, flags);
+      }
+      return sent;
+    }
+  };
+  return io_awaitable<send_all>(reactor, socket, poll_set::POLL_WRITE,
+                                send_all{socket, static_cast<const char*>(buffer), length, flags});
+}
+
+/// @brief Receive one datagram; yields its length and stores its source in @p sender
+inline auto async_receive_from(async_reactor& reactor, udp_socket& socket, void* buffer, int length,
+                               socket_address& sender, int flags = 0)
+{
+  auto operation = [&socket, buffer, length, &sender, flags]()
+  {
+    return socket.receive_from(buffer, length, sender, flags);
+  };
+  return io_awaitable<decltype(operation)>(reactor, socket, poll_set::POLL_READ, operation);
+}
+
+/// @brief Send one datagram to @p address; yields the bytes sent
+inline auto async_send_to(async_reactor& reactor, udp_socket& socket, const void* buffer, int length,
+                          const socket_address& address, int flags = 0)
+{
+  auto operation = [&socket, buffer, length, &address, flags]()
+  {
+    return socket.send_to(buffer, length, address, flags);
+  };
+  return io_awaitable<decltype(operation)>(reactor, socket, poll_set::POLL_WRITE, operation);
+}
+
+// ============================================================================
+// Implementation
+// ============================================================================
+
+inline std::size_t async_reactor::run_once(const std::chrono::milliseconds& timeout)
+{
+  m_poll.poll(m_events, timeout);
+
+  std::size_t resumed = 0;
+  for (const SocketEvent& event : m_events)
+  {
+    if (event.socket_ptr == nullptr)
+    {
+      // Queued slots, including coroutines awaiting sig.next(queue)
+      static_cast<event_queue*>(event.user_data)->process_pending();
+      continue;
+    }
+
+    // Looked up again: an earlier resumption may have dropped the socket
+    auto found = m_interest.find(event.socket_ptr);
+    if (found == m_interest.end())
+    {
+      continue;
+    }
+
+    interest& entry = found->second;
+    const bool failed = (event.mode & poll_set::POLL_ERROR) != 0;
+    if (entry.reader != nullptr && (failed || (event.mode & poll_set::POLL_READ) != 0) &&
+        entry.reader->attempt())
+    {
+      m_ready.push_back(entry.reader->handle);
+      entry.reader = nullptr;
+    }
+    if (entry.writer != nullptr && (failed || (event.mode & poll_set::POLL_WRITE) != 0) &&
+        entry.writer->attempt())
+    {
+      m_ready.push_back(entry.writer->handle);
+      entry.writer = nullptr;
+    }
+    update_interest(*event.socket_ptr, entry);
+
+    // Resumed after the bookkeeping: the coroutine may wait on this socket again
+    for (std::coroutine_handle<> handle : m_ready)
+    {
+      --m_waiting;
+      ++resumed;
+      handle.resume();
+    }
+    m_ready.clear();
+  }
+  return resumed;
+}
+
+inline void async_reactor::run()
+{
+  m_stopped = false;
+  while (!m_stopped && m_waiting > 0)
+  {
+    run_once(std::chrono::milliseconds(-1));
+  }
+}
+
+inline void async_reactor::stop()
+{
+  m_stopped = true;
+}
+
+inline void async_reactor::add(event_queue& queue)
+{
+  m_poll.add(queue, &queue);
+}
+
+inline void async_reactor::remove(event_queue& queue)
+{
+  m_poll.remove(queue);
+}
+
+inline std::size_t async_reactor::waiting() const
+{
+  return m_waiting;
+}
+
+inline void async_reactor::wait(socket_base& socket, int mode, detail::io_waiter* waiter)
+{
+  interest& entry = m_interest[&socket];
+  detail::io_waiter*& current = mode == poll_set::POLL_READ ? entry.reader : entry.writer;
+  if (current != nullptr)
+  {
+    throw std::logic_error("async_reactor: a coroutine already waits on this socket");
+  }
+  current = waiter;
+  ++m_waiting;
+  update_interest(socket, entry);
+}
+
+inline void async_reactor::cancel(socket_base& socket, int mode, detail::io_waiter* waiter)
+{
+  auto found = m_interest.find(&socket);
+  if (found == m_interest.end())
+  {
+    return;
+  }
+  detail::io_waiter*& current =
+      mode == poll_set::POLL_READ ? found->second.reader : found->second.writer;
+  if (current == waiter)
+  {
+    current = nullptr;
+    --m_waiting;
+    update_interest(socket, found->second);
+  }
+}
+
+inline void async_reactor::update_interest(const socket_base& socket, interest& entry)
+{
+  const int mode = (entry.reader != nullptr ? poll_set::POLL_READ : 0) |
+                   (entry.writer != nullptr ? poll_set::POLL_WRITE : 0);
+  if (mode == 0)
+  {
+    if (entry.registered)
+    {
+      m_poll.remove(socket);
+    }
+    m_interest.erase(&socket);
+    return;
+  }
+  if (entry.registered)
+  {
+    m_poll.update(socket, mode);
+  }
+  else
+  {
+    m_poll.add(socket, mode);
+    entry.registered = true;
+  }
+}
+
+} // namespace fb
+
+#endif // FB_SIGNAL_HAS_COROUTINES
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <fb/socket_address.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fb {
+
+/**
+ * @brief Caching host name resolver with background refresh.
+ *
+ * Constructing a socket_address from a host name calls getaddrinfo() on the
+ * calling thread every time. dns_resolver keeps the results for a
+ * configurable time to live, so repeated lookups (typically reconnects) are
+ * answered from memory. Entries that were used since their last lookup are
+ * refreshed by a background thread shortly before they expire, so hot names
+ * never block a caller after the first lookup. Failed lookups are cached for
+ * a shorter negative time to live.
+ *
+ * getaddrinfo() does not report record TTLs, so the cache lifetime is a
+ * resolver setting rather than taken from the DNS answer.
+ *
+ * All members are thread-safe.
+ */
+class dns_resolver
+{
+public:
+
+  using Family = socket_address::Family;
+
+  /// Resolves @p host for @p family; returns addresses with port 0 or throws
+  using lookup_function =
+      std::function<std::vector<socket_address>(const std::string& host, Family family)>;
+
+  static constexpr std::chrono::milliseconds DEFAULT_TTL{60000};
+  static constexpr std::chrono::milliseconds DEFAULT_NEGATIVE_TTL{5000};
+
+  explicit dns_resolver(const std::chrono::milliseconds& ttl = DEFAULT_TTL,
+                        const std::chrono::milliseconds& negative_ttl = DEFAULT_NEGATIVE_TTL);
+  ~dns_resolver();
+
+  dns_resolver(const dns_resolver&)            = delete;
+  dns_resolver& operator=(const dns_resolver&) = delete;
+
+  static dns_resolver& shared();
+
+  socket_address resolve(std::string_view host, std::uint16_t port,
+                         Family family = Family::IPv4);
+  std::vector<socket_address> resolve_all(std::string_view host, std::uint16_t port,
+                                          Family family = Family::IPv4);
+  std::future<socket_address> resolve_async(std::string_view host, std::uint16_t port,
+                                            Family family = Family::IPv4);
+  void prefetch(std::string_view host, Family family = Family::IPv4);
+
+  void invalidate(std::string_view host);
+  void clear();
+
+  void set_lookup(lookup_function lookup);
+  static std::vector<socket_address> system_lookup(const std::string& host, Family family);
+
+  std::size_t cached_hosts() const;
+  std::uint64_t cache_hits() const;
+  std::uint64_t cache_misses() const;
+  std::uint64_t refreshes() const;
+
+private:
+
+  using clock = std::chrono::steady_clock;
+  using key   = std::pair<std::string, int>;  ///< Host name and address family
+
+  struct entry
+  {
+    std::vector<socket_address> addresses;   ///< Port 0; empty for negative entries
+    std::string error;                       ///< Failure message of a negative entry
+    clock::time_point expires;               ///< No longer served after this
+    clock::time_point refresh_at;            ///< Background refresh becomes due
+    bool used = false;                       ///< Hit since the last lookup
+    bool refreshing = false;                 ///< Queued for background refresh
+  };
+
+  struct async_request
+  {
+    std::uint16_t port;
+    std::promise<socket_address> promise;
+  };
+
+  struct key_hash
+  {
+    std::size_t operator()(const key& k) const noexcept
+    {
+      return std::hash<std::string>{}(k.first) ^ static_cast<std::size_t>(k.second);
+    }
+  };
+
+  const std::chrono::milliseconds m_ttl;
+  const std::chrono::milliseconds m_negative_ttl;
+
+  mutable std::mutex m_mutex;                                  ///< Protects all members below
+  std::condition_variable m_wakeup;                            ///< Signals the refresh thread
+  std::unordered_map<key, entry, key_hash> m_cache;
+  std::map<key, std::vector<async_request>> m_async;           ///< Pending resolve_async() calls
+  lookup_function m_lookup;
+  bool m_stop;
+
+  std::atomic<std::uint64_t> m_hits;
+  std::atomic<std::uint64_t> m_misses;
+  std::atomic<std::uint64_t> m_refreshes;
+
+  std::thread m_thread;                                        ///< Background refresh thread
+
+  bool find_cached(const key& k, std::vector<socket_address>& addresses);
+  void store(const key& k, const std::vector<socket_address>& addresses,
+             const std::string& error, bool refresh);
+  void refresh_thread_proc();
+
+  static std::vector<socket_address> with_port(const std::vector<socket_address>& addresses,
+                                               std::uint16_t port);
+};
+
+} // namespace fb
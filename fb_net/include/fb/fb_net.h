@@ -24,25 +24,43 @@
  * 
  * **Foundation Layer (Layer 1)**
  * - socket_address: Network address abstraction with IPv4/IPv6 support
+ * - dns_resolver: Caching host name resolver with background refresh
  * - socket_base: Socket base class with platform abstraction
  * - Standard exception handling via `std::system_error` and STL exceptions
  *
  * **Core Socket Classes (Layer 2)**
  * - socket_base: Base socket class with fundamental operations
  * - tcp_client: TCP socket implementation for reliable connections
+ * - tls: Pluggable TLS engine (OpenSSL) with kernel TLS offload for tcp_client
  * - server_socket: TCP server socket for accepting incoming connections
  *
  * **Advanced I/O and Polling (Layer 3)**
  * - socket_stream: Stream interface for socket I/O operations
+ * - stream_buffer_pool: Shared, reusable buffers for socket_stream
  * - poll_set: Efficient polling mechanism for multiple sockets
  * - udp_socket: UDP socket implementation for unreliable communications
+ * - mpmc_queue: Bounded lock-free queue used for server work handoff
+ * - timer_wheel: Hierarchical timer wheel for connection deadlines
+ * - timer_source: timerfd/kqueue timer that poll_set reports next to sockets
+ * - send_pacer: Token-bucket pacer for rate-limited udp_client sends
+ * - io_ring: Completion-based batched socket I/O on Linux io_uring
  *
  * **Server Infrastructure (Layer 4)**
+ * - worker_pool_policy: Sizing rules for the server worker thread pools
+ * - thread_config: CPU affinity, naming and priority of server threads
+ * - output_budget: Outbound byte limits and backpressure policy for tcp_server
  * - tcp_server_connection: Base class for handling TCP client connections
+ * - tcp_reactor_connection: Callback-driven handler for tcp_server reactor mode
  * - tcp_server: Multi-threaded TCP server with connection pooling
+ * - http_server: Pipelined HTTP/1.1 keep-alive server on tcp_server reactor mode
+ * - tcp_connection_pool: Keep-alive pool of tcp_client connections per endpoint
+ * - tcp_connector: Many concurrent non-blocking connects driven by one poll_set
+ * - framed_connection: Length-prefixed message framing over tcp_client
  * - udp_handler: Base class for handling UDP packet processing
  * - udp_client: High-level UDP client with simplified interface
  * - udp_server: Multi-threaded UDP server with packet dispatch
+ * - multicast_feed: Sequenced multicast feed with gap detection and A/B arbitration
+ * - shm_channel: Shared-memory message channel between processes on one host
  * 
  * @section usage Basic Usage
  * 
@@ -212,6 +230,7 @@
 //
 
 #include "socket_address.h"      // Network address abstraction (IPv4/IPv6)
+#include "dns_resolver.h"        // Caching host name resolver
 #include "socket_base.h"        // Socket base class implementation
 
 //
@@ -219,6 +238,7 @@
 //
 
 #include "tcp_client.h"       // TCP socket implementation
+#include "tls.h"              // TLS engine interface
 #include "server_socket.h"       // TCP server socket
 
 //
@@ -226,18 +246,34 @@
 //
 
 #include "socket_stream.h"  // Stream interface for sockets
+#include "stream_buffer_pool.h" // Shared stream buffers
 #include "poll_set.h"       // Multi-socket polling mechanism
 #include "udp_socket.h"     // UDP socket implementation
+#include "mpmc_queue.h"     // Lock-free multi-producer/multi-consumer queue
+#include "timer_wheel.h"       // O(1) timer wheel
+#include "timer_source.h"      // Pollable kernel timer
+#include "send_pacer.h"        // Token-bucket send pacing
+#include "io_ring.h"        // io_uring submission/completion ring
 
 //
 // Server Infrastructure (Layer 4) - High-level server components
 //
 
+#include "worker_pool_policy.h"   // Worker pool sizing rules
+#include "thread_config.h"        // Server thread affinity and naming
+#include "output_budget.h"        // Outbound buffering limits
 #include "tcp_server_connection.h" // TCP connection handler base class
+#include "tcp_reactor_connection.h" // Non-blocking connection handler for reactor mode
 #include "tcp_server.h"          // Multi-threaded TCP server
+#include "http_server.h"         // HTTP/1.1 server on reactor mode
+#include "tcp_connection_pool.h" // Keep-alive client connection pool
+#include "tcp_connector.h"       // Non-blocking connect multiplexer
+#include "framed_connection.h"   // Length-prefixed message framing
 #include "udp_handler.h"         // UDP packet handler base class
 #include "udp_client.h"          // High-level UDP client
 #include "udp_server.h"          // Multi-threaded UDP server
+#include "multicast_feed.h"      // A/B arbitrated multicast feed
+#include "shm_channel.h"         // Shared-memory IPC channel
 
 /**
  * @namespace fb
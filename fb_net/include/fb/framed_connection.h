@@ -0,0 +1,90 @@
+#pragma once
+
+#include <fb/tcp_client.h>
+#include <fb/mirrored_ring_buffer.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace fb {
+
+/**
+ * @brief Length-prefixed message framing over a connected tcp_client.
+ *
+ * Each frame is a 4-byte big-endian payload length followed by the payload.
+ * Receiving reads as much as the input buffer holds with a single
+ * receive_bytes() call and then hands out every complete frame in it as a
+ * string_view into the buffer, so under load one system call serves many
+ * frames and no per-frame allocation takes place. Views stay valid until the
+ * next call that receives (receive(), receive_frames() or read_frame()).
+ *
+ * The input buffer is a mirrored_ring_buffer: the bytes of a frame that
+ * wraps round the end of the ring are still contiguous, so unconsumed bytes
+ * are never moved before a receive and a frame is never copied to be handed
+ * out whole. The buffer grows on demand to hold the largest frame seen, up
+ * to HEADER_SIZE + max_frame_size bytes rounded up to whole pages.
+ *
+ * Sending either writes header and payload with one gathered send
+ * (send_frame()) or batches frames in an output buffer until flush().
+ *
+ * @note Not thread-safe; the tcp_client must outlive the framed_connection.
+ */
+class framed_connection
+{
+public:
+
+  static constexpr std::size_t HEADER_SIZE            = 4;
+  static constexpr std::size_t DEFAULT_BUFFER_SIZE    = 64 * 1024;
+  static constexpr std::size_t DEFAULT_MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+  using frame_handler = std::function<void(std::string_view frame)>;
+
+  explicit framed_connection(tcp_client& client,
+                             std::size_t buffer_size    = DEFAULT_BUFFER_SIZE,
+                             std::size_t max_frame_size = DEFAULT_MAX_FRAME_SIZE);
+
+  framed_connection(const framed_connection&)            = delete;
+  framed_connection& operator=(const framed_connection&) = delete;
+
+  tcp_client& client();
+
+  // Receiving
+  std::size_t receive();
+  bool next_frame(std::string_view& frame);
+  std::size_t receive_frames(const frame_handler& handler);
+  bool read_frame(std::string_view& frame);
+  bool eof() const;
+
+  // Sending
+  void send_frame(std::string_view payload);
+  void queue_frame(std::string_view payload);
+  void flush();
+  std::size_t queued_bytes() const;
+
+  // Buffer state and statistics
+  std::size_t buffered_bytes() const;
+  std::size_t buffer_capacity() const;
+  std::size_t max_frame_size() const;
+  std::uint64_t receive_calls() const;
+  std::uint64_t frames_received() const;
+
+private:
+
+  void check_payload_size(std::size_t size) const;
+  std::size_t pending_frame_size() const;
+
+  tcp_client& m_client;
+  const std::size_t m_max_frame_size;
+
+  mirrored_ring_buffer m_input;   ///< Received bytes not yet handed out
+  bool m_eof;                     ///< Peer closed its side
+
+  std::vector<char> m_output;     ///< Frames queued by queue_frame()
+
+  std::uint64_t m_receive_calls;  ///< receive_bytes() calls made
+  std::uint64_t m_frames_received;///< Frames handed out
+};
+
+} // namespace fb
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <fb/tcp_server.h>
+#include <fb/server_socket.h>
+#include <fb/metrics.h>
+#include <fb/sharded_counters.h>
+#include <fb/fb_signal.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fb {
+
+/**
+ * @brief One request header; both views point into the connection buffer.
+ */
+struct http_header
+{
+  std::string_view name;  ///< Field name as sent
+  std::string_view value; ///< Field value without surrounding whitespace
+};
+
+/**
+ * @brief A parsed HTTP/1.x request.
+ *
+ * Every view points into the connection's receive buffer and is valid only
+ * for the duration of the handler call; copy what must outlive it.
+ */
+struct http_request
+{
+  std::string_view method;          ///< e.g. "GET"
+  std::string_view target;          ///< Request target as sent
+  std::string_view path;            ///< Target up to '?'
+  std::string_view query;           ///< Target after '?' (empty if none)
+  int version_minor = 1;            ///< 0 for HTTP/1.0, 1 for HTTP/1.1
+  bool keep_alive   = true;         ///< Connection stays open after the response
+  std::vector<http_header> headers; ///< Header fields in arrival order
+  std::string_view body;            ///< Content-Length bytes following the headers
+
+  std::string_view header(std::string_view name) const;
+};
+
+/**
+ * @brief Response filled in by an http_server handler.
+ *
+ * Defaults to "200 OK" with an empty body. The server adds Server, Date,
+ * Content-Length and (when needed) Connection itself; add_header() is for
+ * anything else. Instances are reused between requests on a connection, so
+ * the body's capacity carries over.
+ */
+class http_response
+{
+public:
+
+  http_response();
+
+  void set_status(int code, std::string_view reason = {});
+  int status() const;
+  void set_content_type(std::string_view type);
+  void add_header(std::string_view name, std::string_view value);
+  void set_body(std::string_view body);
+  void append_body(std::string_view data);
+  std::string& body();
+  void set_keep_alive(bool keep_alive);
+  bool keep_alive() const;
+  void reset();
+
+private:
+
+  friend class http_server;
+
+  int m_status;               ///< Status code
+  std::string m_reason;       ///< Custom reason phrase (empty: standard one)
+  std::string m_content_type; ///< Content-Type value (empty: header omitted)
+  std::string m_headers;      ///< Extra "Name: value\r\n" lines
+  std::string m_body;         ///< Response body
+  bool m_keep_alive;          ///< False closes the connection after sending
+};
+
+/**
+ * @class fb::http_server
+ * @brief HTTP/1.1 server for small, frequent requests (metrics, admin, health).
+ *
+ * Runs on tcp_server reactor mode: each connection is a non-blocking
+ * tcp_reactor_connection that reads into one buffer and parses requests in
+ * place, handing the handler string_views instead of copied strings.
+ * Pipelined requests that arrive together are all answered in that read's
+ * dispatch and written with a single send. Responses are assembled from
+ * pre-built status lines and a per-loop header block whose Date line is
+ * rebuilt once a second.
+ *
+ * Requests carry their body with Content-Length; chunked request bodies are
+ * answered with 501. The handler runs on an event-loop thread and must not
+ * block; it is called for one connection at a time, but for different
+ * connections concurrently on different loops.
+ *
+ * The underlying tcp_server is reachable through server() for idle
+ * timeouts, backpressure, thread configuration and statistics.
+ */
+class http_server
+{
+public:
+
+  using request_handler = std::function<void(const http_request&, http_response&)>;
+
+  static constexpr std::size_t DEFAULT_MAX_HEADER_SIZE = 8 * 1024;    ///< Request line and headers
+  static constexpr std::size_t DEFAULT_MAX_BODY_SIZE   = 1024 * 1024; ///< Request body
+  static constexpr std::size_t DEFAULT_READ_SIZE       = 16 * 1024;   ///< Initial receive buffer per connection
+
+  http_server();
+  http_server(fb::server_socket server_socket, request_handler handler, std::size_t event_loops = 0);
+
+  http_server(const http_server&) = delete;
+  http_server(http_server&&) = delete;
+  http_server& operator=(const http_server&) = delete;
+  http_server& operator=(http_server&&) = delete;
+  ~http_server();
+
+  void start();
+  void stop(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(5000));
+  bool is_running() const;
+
+  void set_server_socket(fb::server_socket server_socket);
+  void set_handler(request_handler handler, std::size_t event_loops = 0);
+  void set_max_header_size(std::size_t size);
+  void set_max_body_size(std::size_t size);
+  void set_server_name(const std::string& name);
+
+  std::size_t max_header_size() const;
+  std::size_t max_body_size() const;
+  const std::string& server_name() const;
+
+  tcp_server& server();
+  const tcp_server& server() const;
+
+  std::uint64_t total_requests() const;
+  std::uint64_t rejected_requests() const;
+  std::uint64_t handler_errors() const;
+
+  metrics_registration register_metrics(metrics_registry& registry, const std::string& prefix) const;
+
+  // Emitted on event-loop threads
+  fb::signal<const std::exception&, const std::string&> onException; ///< Handler threw (answered with 500)
+
+private:
+
+  class connection;
+
+  void append_response(std::string& out, const http_request* request, http_response& response);
+  void append_error(std::string& out, int code);
+
+  enum http_counter : std::size_t
+  {
+    REQUESTS,
+    REJECTED_REQUESTS,
+    HANDLER_ERRORS,
+    HTTP_COUNTERS
+  };
+
+  tcp_server m_server;                  ///< Reactor-mode transport
+  request_handler m_handler;            ///< Application handler
+  std::size_t m_max_header_size;        ///< Longest request line plus headers
+  std::size_t m_max_body_size;          ///< Longest request body
+  std::string m_server_name;            ///< Server header value (empty omits it)
+  std::string m_server_line;            ///< Pre-built "Server: ...\r\n"
+  sharded_counters<HTTP_COUNTERS> m_stats; ///< Per-loop shards, summed on read
+};
+
+/**
+ * @brief Answer a scrape of @p registry if the request is for it.
+ *
+ * Serves GET /metrics as Prometheus text and GET /metrics.json as JSON, so a
+ * handler can route to it before its own paths:
+ *
+ * @code
+ * fb::http_server admin(std::move(socket), [](const fb::http_request& request, fb::http_response& response) {
+ *   if (!fb::serve_metrics(request, response))
+ *   {
+ *     response.set_status(404);
+ *   }
+ * });
+ * @endcode
+ *
+ * @return true if the request was for a metrics path and has been answered
+ */
+bool serve_metrics(const http_request& request, http_response& response,
+                   const metrics_registry& registry = metrics_registry::global());
+
+} // namespace fb
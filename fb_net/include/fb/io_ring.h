@@ -0,0 +1,124 @@
+#pragma once
+
+#include <fb/socket_base.h>
+#include <fb/udp_socket.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fb {
+
+/**
+ * @brief Result of one operation submitted to an io_ring
+ */
+struct io_completion
+{
+  std::uint64_t user_data = 0; ///< Value passed when the operation was submitted
+  int result              = 0; ///< Bytes, accepted fd or poll_set mode bits; -errno on failure
+
+  io_completion(std::uint64_t data, int res) :
+    user_data(data),
+    result(res)
+  {}
+};
+
+/**
+ * @brief Caller-owned buffer registered with an io_ring for fixed I/O
+ */
+struct io_buffer
+{
+  void* data         = nullptr; ///< Start of the buffer
+  std::size_t length = 0;       ///< Buffer size in bytes
+};
+
+/**
+ * @brief Completion-based socket I/O on a shared Linux io_uring.
+ *
+ * Operations are queued with the submit_*() calls and handed to the kernel in
+ * a single io_uring_enter() by submit() or wait(); many sockets can share one
+ * ring, so a batch of receives, sends, accepts and readiness polls costs one
+ * system call instead of one per socket.
+ *
+ * Buffers, sockets and udp_receive_entry objects passed to a submission must
+ * stay valid until its completion has been returned by wait(). Completions
+ * are not ordered relative to submission.
+ *
+ * The ring is driven by the raw io_uring system calls, so no liburing
+ * dependency is needed. On other platforms (or kernels without io_uring)
+ * supported() returns false and construction throws.
+ *
+ * @note Not thread-safe; use one ring per thread.
+ */
+class io_ring
+{
+public:
+
+  static constexpr unsigned DEFAULT_ENTRIES = 256;
+
+  explicit io_ring(unsigned entries = DEFAULT_ENTRIES);
+  ~io_ring();
+
+  io_ring(const io_ring&)            = delete;
+  io_ring& operator=(const io_ring&) = delete;
+
+  static bool supported();
+
+  void register_buffers(const io_buffer* buffers, std::size_t count);
+  void unregister_buffers();
+
+  void submit_poll(const socket_base& socket, int mode, std::uint64_t user_data);
+  void submit_receive(const socket_base& socket, void* buffer, std::size_t length,
+                      std::uint64_t user_data, int flags = 0);
+  void submit_send(const socket_base& socket, const void* buffer, std::size_t length,
+                   std::uint64_t user_data, int flags = 0);
+  void submit_receive_fixed(const socket_base& socket, std::size_t buffer_index,
+                            std::size_t length, std::uint64_t user_data);
+  void submit_send_fixed(const socket_base& socket, std::size_t buffer_index,
+                         std::size_t length, std::uint64_t user_data);
+  void submit_accept(const socket_base& listener, std::uint64_t user_data);
+  void submit_receive_from(const socket_base& socket, udp_receive_entry& entry,
+                           std::uint64_t user_data, int flags = 0);
+
+  std::size_t submit();
+  int wait(std::vector<io_completion>& completions,
+           const std::chrono::milliseconds& timeout);
+
+  std::size_t pending() const;
+  std::size_t in_flight() const;
+  unsigned entries() const;
+
+private:
+
+  struct operation;
+
+  int m_ring_fd;                          ///< io_uring file descriptor
+  unsigned m_entries;                     ///< Submission queue size
+
+  void* m_sq_ring;                        ///< Mapped submission ring
+  std::size_t m_sq_ring_size;             ///< Size of m_sq_ring mapping
+  void* m_cq_ring;                        ///< Mapped completion ring (may alias m_sq_ring)
+  std::size_t m_cq_ring_size;             ///< Size of m_cq_ring mapping
+  void* m_sqes;                           ///< Mapped submission queue entries
+  std::size_t m_sqes_size;                ///< Size of m_sqes mapping
+
+  unsigned* m_sq_head;                    ///< Kernel-owned submission head
+  unsigned* m_sq_tail;                    ///< Submission tail published to the kernel
+  unsigned m_sq_mask;                     ///< Submission index mask
+  unsigned* m_sq_array;                   ///< Submission index array
+  unsigned* m_cq_head;                    ///< Completion head published to the kernel
+  unsigned* m_cq_tail;                    ///< Kernel-owned completion tail
+  unsigned m_cq_mask;                     ///< Completion index mask
+  void* m_cqes;                           ///< Completion queue entries
+
+  std::size_t m_pending;                  ///< Queued but not yet submitted entries
+  std::vector<operation> m_operations;    ///< Per-operation state, indexed by slot
+  std::vector<std::uint32_t> m_free_slots; ///< Unused m_operations slots
+  std::vector<io_buffer> m_buffers;       ///< Registered fixed buffers
+
+  void* next_sqe(std::uint32_t& slot, std::uint64_t user_data);
+  socket_t socket_fd(const socket_base& socket) const;
+  void release();
+};
+
+} // namespace fb
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <fb/detail/atomic_utils.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace fb {
+
+/**
+ * @brief Bounded lock-free multi-producer / multi-consumer queue.
+ *
+ * A ring of sequence-stamped cells (D. Vyukov's bounded MPMC design): each
+ * producer claims a slot by advancing the enqueue index with a CAS, writes
+ * the item and publishes it by bumping the slot's sequence; consumers do the
+ * same on the dequeue index. Indices and cells are padded to a cache line,
+ * matching the ring used by fb::event_queue, so producers and consumers do
+ * not false-share.
+ *
+ * try_push()/try_pop() never block. wait_pop() spins for a configurable
+ * number of attempts and then parks on a condition variable; producers only
+ * touch the mutex when a consumer is actually parked, so the uncontended
+ * handoff stays lock-free.
+ *
+ * @tparam T Movable, default-constructible element type.
+ */
+template <typename T>
+class mpmc_queue
+{
+public:
+
+  /**
+   * @brief Construct a queue holding at least @p capacity items.
+   *
+   * @param capacity Minimum capacity; rounded up to a power of two (at least 2,
+   *                 since the sequence scheme cannot tell a full one-slot ring
+   *                 from an empty one).
+   * @param spin_count Pop attempts made by wait_pop() before parking.
+   * @throws std::invalid_argument If capacity is zero.
+   */
+  explicit mpmc_queue(std::size_t capacity, std::size_t spin_count = 0) :
+    m_capacity(round_up_pow2(capacity)),
+    m_mask(m_capacity - 1),
+    m_cells(new cell[m_capacity]),
+    m_spin_count(spin_count)
+  {
+    for (std::size_t i = 0; i < m_capacity; ++i)
+    {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_queue(const mpmc_queue&) = delete;
+  mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+  /**
+   * @brief Enqueue an item without blocking.
+   *
+   * @param item Item to move into the queue; left untouched on failure.
+   * @return False if the queue is full.
+   */
+  bool try_push(T&& item)
+  {
+    cell* target = nullptr;
+    std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+      target = &m_cells[pos & m_mask];
+      std::size_t seq = target->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+      if (diff == 0)
+      {
+        if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    target->value = std::move(item);
+    target->sequence.store(pos + 1, std::memory_order_release);
+
+    // Pairs with the fence in wait_pop(): either we see the parked consumer
+    // or it sees the published item.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_parked.load(std::memory_order_relaxed) > 0)
+    {
+      std::lock_guard<std::mutex> lock(m_park_mutex);
+      m_park_condition.notify_one();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Enqueue a copy of an item without blocking.
+   *
+   * @param item Item to copy into the queue.
+   * @return False if the queue is full.
+   */
+  bool try_push(const T& item)
+  {
+    T copy(item);
+    return try_push(std::move(copy));
+  }
+
+  /**
+   * @brief Dequeue an item without blocking.
+   *
+   * @param item Receives the dequeued item.
+   * @return False if the queue is empty.
+   */
+  bool try_pop(T& item)
+  {
+    cell* source = nullptr;
+    std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+      source = &m_cells[pos & m_mask];
+      std::size_t seq = source->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+      if (diff == 0)
+      {
+        if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = m_dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    item = std::move(source->value);
+    source->value = T();
+    source->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Dequeue an item, spinning and then parking while empty.
+   *
+   * @param item Receives the dequeued item.
+   * @param timeout Maximum time to stay parked.
+   * @param should_stop Predicate checked while waiting; returning true aborts.
+   * @return True if an item was dequeued.
+   */
+  template <typename StopPredicate>
+  bool wait_pop(T& item, const std::chrono::milliseconds& timeout, StopPredicate should_stop)
+  {
+    if (try_pop(item))
+    {
+      return true;
+    }
+
+    detail::spin_wait waiter;
+    for (std::size_t i = 0; i < m_spin_count; ++i)
+    {
+      if (should_stop())
+      {
+        return false;
+      }
+      waiter.wait();
+      if (try_pop(item))
+      {
+        return true;
+      }
+    }
+
+    bool popped = false;
+    std::unique_lock<std::mutex> lock(m_park_mutex);
+    m_parked.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_park_condition.wait_for(lock, timeout, [&]
+    {
+      popped = try_pop(item);
+      return popped || should_stop();
+    });
+    m_parked.fetch_sub(1, std::memory_order_relaxed);
+    return popped;
+  }
+
+  /**
+   * @brief Wake every parked consumer (e.g. on shutdown).
+   */
+  void notify_all()
+  {
+    std::lock_guard<std::mutex> lock(m_park_mutex);
+    m_park_condition.notify_all();
+  }
+
+  /**
+   * @brief Approximate number of queued items.
+   */
+  std::size_t size_approx() const noexcept
+  {
+    std::size_t tail = m_enqueue_pos.load(std::memory_order_relaxed);
+    std::size_t head = m_dequeue_pos.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  /**
+   * @brief Check whether the queue is approximately empty.
+   */
+  bool empty_approx() const noexcept { return size_approx() == 0; }
+
+  /**
+   * @brief Number of slots in the ring.
+   */
+  std::size_t capacity() const noexcept { return m_capacity; }
+
+private:
+
+  struct alignas(detail::CACHE_LINE_SIZE) cell
+  {
+    std::atomic<std::size_t> sequence{0};
+    T value{};
+  };
+
+  static std::size_t round_up_pow2(std::size_t value)
+  {
+    if (value == 0)
+    {
+      throw std::invalid_argument("mpmc_queue capacity must be non-zero");
+    }
+    std::size_t result = 2;
+    while (result < value)
+    {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  const std::size_t m_capacity;
+  const std::size_t m_mask;
+  std::unique_ptr<cell[]> m_cells;
+  const std::size_t m_spin_count;
+
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> m_enqueue_pos{0};
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> m_dequeue_pos{0};
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<std::size_t> m_parked{0};
+  std::mutex m_park_mutex;
+  std::condition_variable m_park_condition;
+};
+
+} // namespace fb
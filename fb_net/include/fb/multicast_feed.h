@@ -0,0 +1,99 @@
+#pragma once
+
+#include <fb/udp_server.h>
+#include <fb/udp_socket.h>
+#include <fb/socket_address.h>
+#include <fb/fb_signal.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace fb {
+
+/**
+ * @brief Sequenced multicast feed with gap detection and A/B line arbitration.
+ *
+ * Market data and similar feeds publish every message on two redundant
+ * multicast lines (A and B) and number messages per channel. The first copy
+ * of each sequence number wins, whichever line it came from; later copies
+ * are dropped. A jump in the sequence is a gap: it is reported through onGap
+ * so the application can request a retransmission.
+ *
+ * Both lines feed one udp_server whose flow affinity routes each channel to
+ * a fixed worker, so all arbitration state of a channel is owned by one
+ * thread and needs no locks. Dropping a duplicate costs one sequence compare
+ * in that worker; the message handler only sees winners.
+ *
+ * Copies of missing sequence numbers that arrive after a gap was opened
+ * (typically from the slower line) are still delivered, flagged as
+ * recovered, as long as they are within RECOVERY_WINDOW of the gap start.
+ *
+ * The message handler runs on the worker threads; with several workers it
+ * is called concurrently for different channels, but never concurrently for
+ * the same channel.
+ */
+class multicast_feed
+{
+public:
+
+  /// @brief A message that won arbitration
+  struct message
+  {
+    std::uint32_t channel;   ///< Channel (partition) of the feed
+    std::uint64_t sequence;  ///< Sequence number within the channel
+    const void* data;        ///< Whole datagram; valid during the handler call
+    std::size_t length;      ///< Datagram length
+    bool recovered;          ///< Filled a gap after later messages were delivered
+  };
+
+  /// Extracts channel and sequence number; returns false for datagrams to ignore
+  using sequence_decoder = std::function<bool(const void* data, std::size_t length,
+                                              std::uint32_t& channel, std::uint64_t& sequence)>;
+  using message_handler = std::function<void(const message& msg)>;
+
+  static constexpr std::size_t RECOVERY_WINDOW = 64;  ///< Late copies accepted after a gap
+
+  multicast_feed(udp_socket line_a, message_handler handler);
+  multicast_feed(udp_socket line_a, udp_socket line_b, message_handler handler);
+  ~multicast_feed();
+
+  multicast_feed(const multicast_feed&)            = delete;
+  multicast_feed& operator=(const multicast_feed&) = delete;
+
+  static udp_socket open_line(const socket_address& group);
+  static udp_socket open_line(const socket_address& group, const socket_address& interface_address);
+  static bool decode_sequence(const void* data, std::size_t length,
+                              std::uint32_t& channel, std::uint64_t& sequence);
+
+  void set_decoder(sequence_decoder decoder);
+  void set_channels(std::size_t channels, std::size_t workers = 1);
+  std::size_t channels() const;
+
+  void start();
+  void stop();
+  bool is_running() const;
+
+  udp_server& server();
+
+  std::uint64_t delivered() const;
+  std::uint64_t duplicates() const;
+  std::uint64_t gaps() const;
+  std::uint64_t missing() const;
+  std::uint64_t recovered() const;
+  std::uint64_t rejected() const;
+
+  // Emitted on a worker thread when a channel skips sequence numbers:
+  // channel, first missing sequence, number of missing sequences
+  fb::signal<std::uint32_t, std::uint64_t, std::uint64_t> onGap;  ///< Retransmit-request hook
+
+private:
+
+  class arbiter;
+
+  std::shared_ptr<arbiter> m_arbiter;  ///< Shared handler holding per-channel state
+  udp_server m_server;                 ///< Receives both lines
+  std::size_t m_workers;               ///< Flow workers requested with set_channels()
+};
+
+} // namespace fb
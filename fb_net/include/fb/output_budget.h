@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace fb {
+
+/**
+ * @brief Outbound buffering limits applied to every connection of a tcp_server.
+ *
+ * Reactor connections queue what the socket cannot take right away (see
+ * tcp_reactor_connection::send_buffered()). A write that would push a
+ * connection past max_buffered, or the whole server past total_max_buffered,
+ * is refused as a unit so the producer can drop or retry it; the stream is
+ * never cut mid-message. Crossing high_watermark raises onOutputHigh so the
+ * producer can throttle before writes are refused; draining to
+ * low_watermark raises onOutputLow. Zero disables a limit.
+ *
+ * Thread-per-connection servers have no user-space queue: max_buffered sizes
+ * the kernel send buffer instead, and tcp_server_connection::send_within()
+ * bounds how long a slow client can hold a worker.
+ */
+struct backpressure_policy
+{
+  std::size_t max_buffered = 0;       ///< Bytes one connection may queue
+  std::size_t high_watermark = 0;     ///< Queued bytes that raise onOutputHigh (0 disables)
+  std::size_t low_watermark = 0;      ///< Queued bytes that raise onOutputLow after a high
+  std::size_t total_max_buffered = 0; ///< Bytes all connections of the server may queue
+};
+
+/**
+ * @brief Thread-safe byte account shared by the connections of one server.
+ *
+ * Connections acquire the bytes they queue and release them as they drain,
+ * so a single slow client cannot hold more than what is left of the limit.
+ */
+class output_budget
+{
+public:
+
+  explicit output_budget(std::size_t limit = 0);
+
+  output_budget(const output_budget&)            = delete;
+  output_budget& operator=(const output_budget&) = delete;
+
+  bool try_acquire(std::size_t bytes) noexcept;
+  void release(std::size_t bytes) noexcept;
+
+  std::size_t used() const noexcept;
+  std::size_t limit() const noexcept;
+  std::uint64_t refused() const noexcept;
+
+private:
+
+  std::atomic<std::size_t> m_used;      ///< Bytes currently acquired
+  std::atomic<std::uint64_t> m_refused; ///< Acquisitions that did not fit
+  const std::size_t m_limit;            ///< Maximum bytes; 0 means unlimited
+};
+
+} // namespace fb
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <fb/socket_base.h>
+#include <fb/event_queue.hpp>
 #include <vector>
-#include <map>
 #include <chrono>
+#include <cstddef>
 
 
 #ifdef __linux__
@@ -24,6 +25,8 @@
 
 namespace fb {
 
+class timer_source;
+
 /**
  * @brief Socket event information returned by poll operation
  */
@@ -31,10 +34,12 @@ struct SocketEvent
 {
   socket_base* socket_ptr =nullptr; ///< Pointer to the socket that has events
   int mode       =0;          ///< Event mode flags (combination of Mode values)
+  void* user_data =nullptr;   ///< Caller data registered with poll_set::add()
 
-  SocketEvent(socket_base* sock, int event_mode) :
+  SocketEvent(socket_base* sock, int event_mode, void* data = nullptr) :
     socket_ptr(sock),
-    mode(event_mode)
+    mode(event_mode),
+    user_data(data)
   {}
 };
 
@@ -51,9 +56,11 @@ public:
    */
   enum Mode : int
   {
-    POLL_READ  = 1,     ///< Monitor for read availability
-    POLL_WRITE = 2,     ///< Monitor for write availability
-    POLL_ERROR = 4      ///< Monitor for error conditions
+    POLL_READ    = 1,   ///< Monitor for read availability
+    POLL_WRITE   = 2,   ///< Monitor for write availability
+    POLL_ERROR   = 4,   ///< Monitor for error conditions
+    POLL_EDGE    = 8,   ///< Edge-triggered: report only new readiness (epoll/kqueue)
+    POLL_ONESHOT = 16   ///< Disarm after one event until re-armed with update()
   };
 
 
@@ -68,11 +75,20 @@ public:
   poll_set(poll_set&& other) noexcept;
   poll_set& operator=(poll_set&& other) noexcept;
 
-  void add(const socket_base& socket, int mode);
+  void add(const socket_base& socket, int mode, void* user_data = nullptr);
   void remove(const socket_base& socket);
   void update(const socket_base& socket, int mode);
   bool has(const socket_base& socket) const;
+
+  // Cross-thread signal delivery: events carry socket_ptr == nullptr
+  void add(event_queue& queue, void* user_data = nullptr);
+  void remove(event_queue& queue);
+
+  // Kernel timers: events carry socket_ptr == nullptr
+  void add(timer_source& timer, void* user_data = nullptr);
+  void remove(timer_source& timer);
   int  get_mode(const socket_base& socket) const;
+  void* get_user_data(const socket_base& socket) const;
   void clear();
   bool empty() const;
   int  poll(const std::chrono::milliseconds& timeout);
@@ -88,22 +104,29 @@ public:
 
 private:
 
+  static constexpr std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
   // Socket tracking
   struct SocketInfo
   {
     socket_t fd        = INVALID_SOCKET_VALUE;  ///< socket file descriptor
-    socket_base* socket_ptr = nullptr;          ///< Pointer to socket_base object
+    socket_base* socket_ptr = nullptr;          ///< Pointer to socket_base object (nullptr: event_queue or timer)
     int mode           = 0;                     ///< Current polling mode
+    bool disarmed      = false;                 ///< Oneshot fired (select fallback only)
+    void* user_data    = nullptr;               ///< Caller data echoed in SocketEvent
+    std::size_t event_index = NO_SLOT;          ///< Event being merged into (kqueue only)
 
     SocketInfo() = default;
-    SocketInfo(socket_t socket_fd, socket_base* sock, int poll_mode):
+    SocketInfo(socket_t socket_fd, socket_base* sock, int poll_mode, void* data):
       fd(socket_fd),
       socket_ptr(sock),
-      mode(poll_mode)
+      mode(poll_mode),
+      user_data(data)
     {}
   };
 
-  std::map<socket_t, SocketInfo> m_sockets;  ///< Map of socket fd to info
+  std::vector<SocketInfo> m_sockets;         ///< Registered sockets, densely packed
+  std::vector<std::size_t> m_fd_slots;       ///< fd -> 1-based index into m_sockets (0 = unused)
   std::vector<SocketEvent> m_events;                   ///< Events from last poll
 
 #ifdef __linux__
@@ -114,7 +137,7 @@ private:
   void init_epoll();
   void cleanup_epoll();
   int poll_epoll(const std::chrono::milliseconds& timeout);
-  int epoll_mode_to_events(int mode) const;
+  uint32_t epoll_mode_to_events(int mode) const;
   int epoll_events_to_mode(uint32_t events) const;
 
 #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
@@ -149,8 +172,14 @@ private:
 
   socket_t get_socket_fd(const socket_base& socket) const;
 
-  std::map<socket_t, SocketInfo>::iterator find_socket(const socket_base& socket);
-  std::map<socket_t, SocketInfo>::const_iterator find_socket(const socket_base& socket) const;
+  std::size_t fd_slot(socket_t fd) const;
+  std::size_t find_socket(const socket_base& socket) const;
+  void add_descriptor(socket_t fd, socket_base* socket, int mode, void* user_data);
+  void add_notifier(socket_t fd, void* user_data);
+  void remove_notifier(socket_t fd);
+  void remove_slot(std::size_t slot);
+  void insert_socket(const SocketInfo& info);
+  void erase_slot(std::size_t slot);
 };
 
 } // namespace fb
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace fb {
+
+/**
+ * @brief Token bucket deciding when each datagram may leave.
+ *
+ * Implemented as the generic cell rate algorithm: one theoretical departure
+ * time advances by length / rate for every datagram, and a datagram
+ * conforms while that time stays at most burst / rate ahead of now. That is the same as a bucket of
+ * burst_bytes refilled at bytes_per_second, with O(1) state and no timer.
+ *
+ * consume() returns the evenly spaced departure of the datagram, which
+ * kernel pacing (SO_TXTIME) uses as the transmit time; user-space pacing
+ * sends as soon as delay() reaches zero. Not thread-safe; udp_client keeps
+ * one per socket.
+ */
+class send_pacer
+{
+public:
+
+  using clock = std::chrono::steady_clock;
+
+  send_pacer();
+  send_pacer(std::uint64_t bytes_per_second, std::size_t burst_bytes);
+
+  bool enabled() const;
+  std::uint64_t rate() const;
+  std::size_t burst() const;
+
+  std::chrono::nanoseconds delay(std::size_t bytes, clock::time_point now) const;
+  clock::time_point consume(std::size_t bytes, clock::time_point now);
+  void refund(std::size_t bytes);
+
+private:
+
+  std::chrono::nanoseconds interval(std::size_t bytes) const;
+
+  std::uint64_t m_rate;                ///< Bytes per second (0: unpaced)
+  std::size_t m_burst;                 ///< Bucket depth in bytes
+  std::chrono::nanoseconds m_tolerance; ///< burst / rate
+  clock::time_point m_next;            ///< Theoretical departure of the next byte
+};
+
+} // namespace fb
@@ -3,6 +3,8 @@
 #include <fb/socket_base.h>
 #include <fb/tcp_client.h>
 #include <fb/socket_address.h>
+#include <chrono>
+#include <string>
 
 namespace fb {
 
@@ -28,6 +30,15 @@ public:
 
   virtual ~server_socket() = default;
 
+  static server_socket adopt(socket_t sockfd);
+
+  // Listener hand-off between processes
+
+  void send_listener(const std::string& unix_path,
+                     const std::chrono::milliseconds& timeout = std::chrono::seconds(5)) const;
+  static server_socket receive_listener(const std::string& unix_path,
+                                        const std::chrono::milliseconds& timeout = std::chrono::seconds(30));
+
   // Server socket operations
 
   void bind(const socket_address& address, bool reuse_address = true);
@@ -54,6 +65,9 @@ public:
 
 private:
 
+    struct adopt_tag {};
+    server_socket(adopt_tag, socket_t sockfd);
+
     void init_server_socket(socket_address::Family family);
 
     void setup_server(const socket_address& address,
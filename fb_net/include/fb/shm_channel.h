@@ -0,0 +1,141 @@
+#pragma once
+
+#include <fb/udp_socket.h>
+#include <fb/socket_address.h>
+#include <fb/fb_signal.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fb {
+
+/**
+ * @class fb::shm_channel
+ * @brief Message channel between processes on one host over a shared-memory ring.
+ *
+ * The receiving process create()s the channel: a ring of fixed-size message
+ * slots in a file under /dev/shm. Senders attach() by name and copy each
+ * message straight into the ring, so a hop costs two memcpy() calls and a
+ * few atomic operations, with no system call on the fast path. Slots carry
+ * sequence stamps (the scheme of fb::mpmc_queue) so any number of senders
+ * can share one ring; a channel created single_producer skips the claim CAS.
+ *
+ * send()/receive() follow udp_client: one call moves one whole message,
+ * messages longer than the receive buffer are truncated, and
+ * receive_with_timeout()/send_with_timeout() throw std::errc::timed_out.
+ * Unlike UDP nothing is dropped: send() waits (up to get_timeout()) while
+ * the ring is full.
+ *
+ * An idle receiver parks on wakeup_socket(), a datagram socket that senders
+ * only write to when the receiver has found the ring empty. It can also be
+ * added to a poll_set; after each wakeup, call try_receive() until it
+ * returns -1, which re-arms the wakeup.
+ *
+ * A sender that dies in the middle of send() leaves its slot unpublished and
+ * stalls the ring; the channel is meant for cooperating processes.
+ */
+class shm_channel
+{
+public:
+
+  static constexpr std::size_t DEFAULT_CAPACITY         = 1024; ///< Messages the ring holds
+  static constexpr std::size_t DEFAULT_MAX_MESSAGE_SIZE = 2048; ///< Largest message in bytes
+  static constexpr std::size_t DEFAULT_SPIN_COUNT       = 4096; ///< Checks before parking
+  static constexpr std::size_t MAX_NAME_LENGTH          = 64;   ///< Longest channel name
+
+  shm_channel();
+  shm_channel(const shm_channel&) = delete;
+  shm_channel(shm_channel&& other) noexcept;
+  shm_channel& operator=(const shm_channel&) = delete;
+  shm_channel& operator=(shm_channel&& other) noexcept;
+  ~shm_channel();
+
+  static shm_channel create(const std::string& name,
+                            std::size_t capacity = DEFAULT_CAPACITY,
+                            std::size_t max_message_size = DEFAULT_MAX_MESSAGE_SIZE,
+                            bool single_producer = false);
+  static shm_channel attach(const std::string& name);
+
+  void close();
+
+  // Sending end
+
+  int send(const void* buffer, std::size_t length);
+  int send(const std::string& message);
+  int send_with_timeout(const void* buffer,
+                        std::size_t length,
+                        const std::chrono::milliseconds& timeout);
+  bool try_send(const void* buffer, std::size_t length);
+
+  // Receiving end
+
+  int receive(void* buffer, std::size_t length);
+  int receive(std::string& message, std::size_t max_length = 1024);
+  int receive_with_timeout(void* buffer,
+                           std::size_t length,
+                           const std::chrono::milliseconds& timeout);
+  int try_receive(void* buffer, std::size_t length);
+
+  bool has_data_available(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(0));
+  const socket_base& wakeup_socket() const;
+
+  void set_timeout(const std::chrono::milliseconds& timeout);
+  std::chrono::milliseconds get_timeout() const;
+  void set_spin_count(std::size_t count);
+  std::size_t get_spin_count() const;
+
+  // Status queries
+
+  bool is_connected() const;
+  bool is_closed() const;
+  bool is_receiver() const;
+  const std::string& name() const;
+  std::size_t capacity() const;
+  std::size_t max_message_size() const;
+  std::size_t pending() const;
+
+  // Data transfer signals
+  fb::signal<const void*, std::size_t> onDataSent;     ///< Emitted after successful send
+  fb::signal<const void*, std::size_t> onDataReceived; ///< Emitted after successful receive
+
+  // Error signals
+  fb::signal<const std::string&> onSendError;    ///< Emitted on send failure
+  fb::signal<const std::string&> onReceiveError; ///< Emitted on receive failure
+  fb::signal<const std::string&> onTimeoutError; ///< Emitted on timeout
+
+private:
+
+  struct shared_header;
+  struct slot_header;
+
+  slot_header& slot(std::uint64_t position) const;
+  bool push(const void* buffer, std::size_t length);
+  int pop(void* buffer, std::size_t length);
+  bool ready() const;
+  bool wait_readable(const std::chrono::milliseconds& timeout);
+  void arm_wakeup();
+  void ring_wakeup();
+  void drain_wakeups();
+  void require_sender() const;
+  void require_receiver() const;
+  void validate_buffer(const void* buffer, std::size_t length) const;
+
+  shared_header* m_header;             ///< Start of the mapping
+  unsigned char* m_slots;              ///< First message slot
+  std::size_t m_mapping_size;          ///< Bytes mapped
+  std::size_t m_mask;                  ///< capacity() - 1
+  std::size_t m_slot_size;             ///< Bytes per slot, header included
+  bool m_receiver;                     ///< Created (and owns) the channel
+  bool m_single_producer;              ///< Publish without the claim CAS
+  std::uint64_t m_wakeups_seen;        ///< Wakeup datagrams drained (receiver)
+  std::string m_name;                  ///< Channel name
+  udp_socket m_wakeup;                 ///< Bound wakeup (receiver) or sender socket
+  socket_address m_wakeup_address;     ///< Address of the receiver's wakeup socket
+  std::chrono::milliseconds m_timeout; ///< Longest send() wait on a full ring
+  std::size_t m_spin_count;            ///< Ring checks before parking
+
+  static constexpr auto DEFAULT_TIMEOUT = std::chrono::milliseconds(30000);
+};
+
+} // namespace fb
@@ -2,12 +2,17 @@
 
 #include <string>
 #include <string_view>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <ostream>
 
 #ifdef _WIN32
   #include <winsock2.h>
   #include <ws2tcpip.h>
+  #include <afunix.h>
 #else
   #include <sys/socket.h>
   #include <netinet/in.h>
@@ -34,6 +39,10 @@ enum class AddressFamily : int
  * @brief Represents an internet (IP) endpoint/socket address.
  * The address can belong to IPv4 or IPv6 family.
  * IP addresses consist of a host address and a port number.
+ *
+ * UNIX_LOCAL addresses name a Unix domain socket by filesystem path instead;
+ * a leading '@' selects the Linux abstract namespace and an empty path is an
+ * unnamed socket (e.g. one end of a socket pair). They have no port.
  */
 class socket_address
 {
@@ -43,6 +52,9 @@ public:
 #ifdef AF_INET6
   static constexpr Family IPv6 = AddressFamily::IPv6;
 #endif
+#ifdef AF_UNIX
+  static constexpr Family UNIX_LOCAL = AddressFamily::UNIX_LOCAL;
+#endif
 
   socket_address();
   explicit socket_address(Family family);
@@ -66,6 +78,7 @@ public:
 
   std::string host() const;
   std::uint16_t port() const;
+  std::string path() const;
   socklen_t length() const;
 
   const struct sockaddr* addr() const;
@@ -73,6 +86,9 @@ public:
   int af() const;
 
   std::string to_string() const;
+  std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
+  static bool try_parse(std::string_view host_and_port, socket_address& address) noexcept;
 
   Family family() const;
 
@@ -80,12 +96,20 @@ public:
   bool operator==(const socket_address& other) const;
   bool operator!=(const socket_address& other) const;
 
+  std::size_t hash() const noexcept;
+
   enum : std::size_t
   {
 #ifdef AF_INET6
-    MAX_ADDRESS_LENGTH = sizeof(struct sockaddr_in6)
+    MAX_ADDRESS_LENGTH = sizeof(struct sockaddr_in6),
 #else
-    MAX_ADDRESS_LENGTH = sizeof(struct sockaddr_in)
+    MAX_ADDRESS_LENGTH = sizeof(struct sockaddr_in),
+#endif
+#ifdef AF_UNIX
+    MAX_PATH_LENGTH    = sizeof(sockaddr_un::sun_path) - 1,  ///< Longest UNIX_LOCAL path
+    MAX_STRING_LENGTH  = MAX_PATH_LENGTH + 1 > 53 ? MAX_PATH_LENGTH + 1 : 53,  ///< Longest to_chars() output
+#else
+    MAX_STRING_LENGTH  = 53  ///< Longest to_chars() output: "[" IPv6 "]:" port
 #endif
   };
 
@@ -100,7 +124,8 @@ private:
   void init_ipv6(const struct sockaddr_in6* addr);
 #endif
 
-  void parse_host_and_port(std::string_view host_and_port, std::string& host, std::uint16_t& port);
+  void parse_host_and_port(std::string_view host_and_port, std::string_view& host, std::uint16_t& port);
+  std::string_view address_bytes() const noexcept;
   std::uint16_t parse_port(std::string_view port_str);
   std::uint32_t resolve_host_ipv4(std::string_view host);
 
@@ -108,6 +133,13 @@ private:
   void resolve_host_ipv6(std::string_view host, struct sockaddr_in6& addr);
 #endif
 
+#ifdef AF_UNIX
+  struct unix_endpoint;
+
+  void init_unix(std::string_view path);
+  void init_unix(const struct sockaddr_un* addr, socklen_t length);
+#endif
+
   union
   {
     struct sockaddr_in m_ipv4_addr;
@@ -118,8 +150,29 @@ private:
   };
   
   Family m_family;
+#ifdef AF_UNIX
+  /// Path of a UNIX_LOCAL address, kept out of line so IP addresses stay
+  /// small; shared between copies and null when unnamed
+  std::shared_ptr<const unix_endpoint> m_unix;
+#endif
 };
 
 std::ostream& operator<<(std::ostream& ostr, const socket_address& address);
 
 } // namespace fb
+
+/**
+ * @brief Hash support so socket_address can key unordered containers.
+ */
+namespace std {
+
+template <>
+struct hash<fb::socket_address>
+{
+  std::size_t operator()(const fb::socket_address& address) const noexcept
+  {
+    return address.hash();
+  }
+};
+
+} // namespace std
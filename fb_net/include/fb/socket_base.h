@@ -38,6 +38,7 @@ namespace fb {
 class socket_base
 {
   friend class poll_set;  // Allow poll_set to access socket descriptor
+  friend class io_ring;   // Allow io_ring to submit I/O on the descriptor
 
 public:
 
@@ -152,6 +153,7 @@ protected:
   void ioctl(unsigned long request, int& arg);
   void ioctl(unsigned long request, void* arg);
   void set_connected(bool connected);  ///< Update connection state (for derived classes)
+  static void open_pair(Type type, socket_t (&fds)[2]);
 
 private:
 
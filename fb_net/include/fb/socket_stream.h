@@ -1,15 +1,22 @@
 #pragma once
 
 #include <fb/tcp_client.h>
+#include <fb/stream_buffer_pool.h>
 #include <iostream>
 #include <streambuf>
 #include <memory>
+#include <string_view>
 
 namespace fb {
 
 /**
  * @brief Stream buffer class for socket I/O operations.
  * This class provides the underlying buffer management for socket_stream.
+ *
+ * Besides the std::streambuf interface, peek()/peek_line() expose the
+ * buffered input as a string_view so parsers can work in place, and
+ * consume() advances past the bytes they used. Views stay valid until the
+ * next input operation on the stream.
  */
 class socket_stream_buf : public std::streambuf
 {
@@ -22,6 +29,13 @@ public:
   tcp_client& socket();
   std::size_t buffer_size() const;
   void set_buffer_size(std::size_t size);
+  void set_buffer_provider(std::shared_ptr<stream_buffer_provider> provider);
+  const std::shared_ptr<stream_buffer_provider>& buffer_provider() const;
+
+  // Zero-copy input access
+  std::string_view peek(std::size_t min_size = 1);
+  std::string_view peek_line(char delimiter = '\n');
+  void consume(std::size_t count);
 
 protected:
 
@@ -41,18 +55,22 @@ private:
 
   void init_input_buffer();
   void init_output_buffer();
+  void release_buffers();
+  char* acquire_buffer();
+  void release_buffer(char*& buffer);
   int flush_output_buffer();
   int fill_input_buffer();
 
   tcp_client& m_socket;
   std::size_t m_buffer_size;
+  std::shared_ptr<stream_buffer_provider> m_provider;  // nullptr = allocate per stream
 
   // Input buffer management
-  std::unique_ptr<char[]> m_input_buffer;
+  char* m_input_buffer;
   bool m_input_buffer_initialized;
 
   // Output buffer management
-  std::unique_ptr<char[]> m_output_buffer;
+  char* m_output_buffer;
   bool m_output_buffer_initialized;
 };
 
@@ -97,6 +115,12 @@ public:
   std::size_t buffer_size() const;
 
   void set_buffer_size(std::size_t size);
+  void set_buffer_provider(std::shared_ptr<stream_buffer_provider> provider);
+
+  std::string_view peek(std::size_t min_size = 1);
+  std::string_view peek_line(char delimiter = '\n');
+  void consume(std::size_t count);
+
   void set_no_delay(bool flag);
   bool get_no_delay();
   void set_keep_alive(bool flag);
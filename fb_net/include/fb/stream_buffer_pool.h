@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace fb {
+
+/**
+ * @brief Source of the I/O buffers used by socket_stream_buf.
+ *
+ * By default each stream allocates its own input and output buffers.
+ * Installing a provider lets many short-lived streams borrow buffers from a
+ * shared pool instead. release() is always called with the same size that
+ * was passed to acquire(). Providers shared between streams on different
+ * threads must be thread-safe.
+ */
+class stream_buffer_provider
+{
+public:
+
+  virtual ~stream_buffer_provider() = default;
+
+  virtual char* acquire(std::size_t size) = 0;
+  virtual void release(char* buffer, std::size_t size) noexcept = 0;
+};
+
+
+/**
+ * @brief Thread-safe free list of fixed-size stream buffers.
+ *
+ * Requests up to buffer_size() bytes are served from (and returned to) the
+ * free list; larger requests fall back to plain allocation. At most
+ * max_cached buffers are kept, and the rest are freed on release.
+ */
+class stream_buffer_pool : public stream_buffer_provider
+{
+public:
+
+  static constexpr std::size_t DEFAULT_BUFFER_SIZE = 8192;
+  static constexpr std::size_t DEFAULT_MAX_CACHED  = 64;
+
+  explicit stream_buffer_pool(std::size_t buffer_size = DEFAULT_BUFFER_SIZE,
+                              std::size_t max_cached  = DEFAULT_MAX_CACHED);
+  ~stream_buffer_pool() override;
+
+  stream_buffer_pool(const stream_buffer_pool&)            = delete;
+  stream_buffer_pool& operator=(const stream_buffer_pool&) = delete;
+
+  char* acquire(std::size_t size) override;
+  void release(char* buffer, std::size_t size) noexcept override;
+
+  std::size_t buffer_size() const;
+  std::size_t cached_buffers() const;
+
+private:
+
+  const std::size_t m_buffer_size;                    ///< Size of pooled buffers
+  const std::size_t m_max_cached;                     ///< Free list capacity
+  mutable std::mutex m_mutex;                         ///< Protects m_free
+  std::vector<std::unique_ptr<char[]>> m_free;        ///< Buffers ready for reuse
+};
+
+} // namespace fb
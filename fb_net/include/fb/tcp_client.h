@@ -2,16 +2,42 @@
 
 #include <fb/socket_base.h>
 #include <fb/socket_address.h>
+#include <fb/tls.h>
 #include <fb/fb_signal.hpp>
 #include <string>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
 
 namespace fb {
 
+/**
+ * @brief One segment of a gathered send (see tcp_client::send_vectored())
+ */
+struct tcp_send_buffer
+{
+  const void* data   = nullptr; ///< Segment start
+  std::size_t length = 0;       ///< Segment size in bytes
+};
+
+/**
+ * @brief One segment of a scattered receive (see tcp_client::receive_vectored())
+ */
+struct tcp_receive_buffer
+{
+  void* data         = nullptr; ///< Segment start
+  std::size_t length = 0;       ///< Segment capacity in bytes
+};
+
 /**
  * @brief TCP client socket implementation.
  * This class inherits from socket_base and adds TCP-specific client functionality.
  */
+class dns_resolver;
+
 class tcp_client : public socket_base
 {
 public:
@@ -22,6 +48,8 @@ public:
   tcp_client(const socket_address& address, const std::chrono::milliseconds& timeout);
   explicit tcp_client(socket_t sockfd);
   tcp_client(tcp_client&& other) noexcept;
+
+  static std::pair<tcp_client, tcp_client> socket_pair();
   
   virtual ~tcp_client() = default;
   tcp_client(const tcp_client&) = delete;
@@ -31,6 +59,9 @@ public:
 
   void connect(const socket_address& address);
   void connect(const socket_address& address, const std::chrono::milliseconds& timeout);
+  void connect(std::string_view host, std::uint16_t port, const std::chrono::milliseconds& timeout);
+  void connect(std::string_view host, std::uint16_t port, const std::chrono::milliseconds& timeout,
+               dns_resolver& resolver);
   void connect_non_blocking(const socket_address& address);
 
   int send_bytes(const void* buffer, int length, int flags = 0);
@@ -39,16 +70,29 @@ public:
   int receive(std::string& buffer, int length);
   int receive_bytes_exact(void* buffer, int length, int flags = 0);
   int send_bytes_all(const void* buffer, int length, int flags = 0);
+  int send_vectored(const tcp_send_buffer* buffers, std::size_t count, int flags = 0);
+  int send_vectored_all(const tcp_send_buffer* buffers, std::size_t count, int flags = 0);
+  int receive_vectored(tcp_receive_buffer* buffers, std::size_t count, int flags = 0);
+  std::uint64_t send_file(const std::string& path, std::uint64_t offset = 0, std::uint64_t length = 0);
+  std::uint64_t send_file(int file_descriptor, std::uint64_t offset = 0, std::uint64_t length = 0);
 
   void shutdown();
   void shutdown_receive();
   int shutdown_send();
   void send_urgent(unsigned char data);
 
+  // TLS
+
+  void start_tls(tls_context& context, tls_role role, const std::string& server_name = {});
+  bool secure() const override;
+  const tls_session* tls() const;
+
   // TCP-specific socket options
 
   void set_no_delay(bool flag);
   bool get_no_delay();
+  void set_cork(bool flag);
+  bool get_cork();
   void set_keep_alive(bool flag);
   bool get_keep_alive();
 
@@ -76,7 +120,12 @@ private:
   void init_tcp_socket(socket_address::Family family);
   int handle_partial_send(const void* buffer, int length, int sent, int flags);
   int handle_partial_receive(void* buffer, int length, int received, int flags);
+  int send_segments(const tcp_send_buffer* buffers, std::size_t count,
+                    std::size_t offset, int flags);
+  int tls_send(const void* buffer, int length);
+  int tls_receive(void* buffer, int length);
 
+  std::unique_ptr<tls_session> m_tls; ///< Set by start_tls()
 };
 
 } // namespace fb
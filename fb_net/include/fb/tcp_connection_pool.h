@@ -0,0 +1,144 @@
+#pragma once
+
+#include <fb/tcp_client.h>
+#include <fb/socket_address.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace fb {
+
+class tcp_connection_pool;
+
+/**
+ * @brief Exclusive use of one pooled connection.
+ *
+ * A lease returns its connection to the pool when destroyed or released.
+ * Call invalidate() after a protocol or I/O error so the connection is
+ * closed instead of being handed to the next caller. Leases are move-only
+ * and must not outlive the pool that created them.
+ */
+class tcp_connection_lease
+{
+public:
+
+  tcp_connection_lease() = default;
+  ~tcp_connection_lease();
+
+  tcp_connection_lease(const tcp_connection_lease&)            = delete;
+  tcp_connection_lease& operator=(const tcp_connection_lease&) = delete;
+
+  tcp_connection_lease(tcp_connection_lease&& other) noexcept;
+  tcp_connection_lease& operator=(tcp_connection_lease&& other) noexcept;
+
+  tcp_client& client();
+  tcp_client* operator->();
+  tcp_client& operator*();
+
+  const socket_address& address() const;
+  bool reused() const;
+  explicit operator bool() const;
+
+  void invalidate();
+  void release();
+
+private:
+
+  friend class tcp_connection_pool;
+
+  tcp_connection_lease(tcp_connection_pool* pool, const socket_address& address,
+                       tcp_client client, bool reused);
+
+  tcp_connection_pool* m_pool = nullptr; ///< Owning pool (nullptr once released)
+  socket_address m_address;              ///< Endpoint the connection is keyed by
+  tcp_client m_client{INVALID_SOCKET_VALUE}; ///< Leased connection
+  bool m_reused  = false;                ///< True if taken from the idle list
+  bool m_invalid = false;                ///< Close instead of returning to the pool
+};
+
+/**
+ * @brief Keep-alive pool of connected tcp_client sockets keyed by endpoint.
+ *
+ * acquire() hands out an idle connection to the requested address when one
+ * passes its health check, and connects a new one otherwise, so repeated
+ * request/response calls to the same backend skip the TCP handshake. Idle
+ * connections are reused most-recently-returned first, at most
+ * max_idle_per_address are kept per endpoint, and connections idle for longer
+ * than idle_timeout are closed instead of reused.
+ *
+ * The built-in health check rejects an idle connection that is readable: the
+ * peer either closed it or sent data nobody asked for. An additional check
+ * can be installed with set_health_check().
+ *
+ * @note All members are thread-safe; connects and health checks run outside
+ * the pool lock.
+ */
+class tcp_connection_pool
+{
+public:
+
+  using health_check = std::function<bool(tcp_client& client)>;
+
+  static constexpr std::size_t DEFAULT_MAX_IDLE = 8;
+  static constexpr auto DEFAULT_IDLE_TIMEOUT    = std::chrono::milliseconds(60000);
+  static constexpr auto DEFAULT_CONNECT_TIMEOUT = std::chrono::milliseconds(5000);
+
+  explicit tcp_connection_pool(std::size_t max_idle_per_address = DEFAULT_MAX_IDLE,
+                               const std::chrono::milliseconds& idle_timeout = DEFAULT_IDLE_TIMEOUT,
+                               const std::chrono::milliseconds& connect_timeout = DEFAULT_CONNECT_TIMEOUT);
+  ~tcp_connection_pool();
+
+  tcp_connection_pool(const tcp_connection_pool&)            = delete;
+  tcp_connection_pool& operator=(const tcp_connection_pool&) = delete;
+
+  tcp_connection_lease acquire(const socket_address& address);
+
+  void set_health_check(health_check check);
+  void set_no_delay(bool flag);
+
+  std::size_t prune();
+  void clear();
+
+  std::size_t idle_connections() const;
+  std::size_t idle_connections(const socket_address& address) const;
+  std::size_t leased_connections() const;
+  std::uint64_t connections_created() const;
+  std::uint64_t connections_reused() const;
+
+  std::size_t max_idle_per_address() const;
+  std::chrono::milliseconds idle_timeout() const;
+  std::chrono::milliseconds connect_timeout() const;
+
+private:
+
+  friend class tcp_connection_lease;
+
+  struct idle_connection
+  {
+    tcp_client client;
+    std::chrono::steady_clock::time_point since;
+  };
+
+  std::size_t m_max_idle;                   ///< Idle connections kept per endpoint
+  std::chrono::milliseconds m_idle_timeout; ///< Age after which idle connections are closed
+  std::chrono::milliseconds m_connect_timeout; ///< Timeout for new connections
+  bool m_no_delay;                          ///< Apply TCP_NODELAY to new connections
+  health_check m_health_check;              ///< Extra check before reuse
+
+  mutable std::mutex m_mutex;               ///< Guards m_no_delay, m_health_check and m_idle
+  std::map<socket_address, std::vector<idle_connection>> m_idle; ///< Idle connections per endpoint
+
+  std::atomic<std::size_t> m_leased;        ///< Connections currently leased
+  std::atomic<std::uint64_t> m_created;     ///< Connections opened by acquire()
+  std::atomic<std::uint64_t> m_reused;      ///< Leases served from the idle list
+
+  bool is_healthy(tcp_client& client, const health_check& check) const;
+  void give_back(const socket_address& address, tcp_client client, bool invalid);
+};
+
+} // namespace fb
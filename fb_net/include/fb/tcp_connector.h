@@ -0,0 +1,87 @@
+#pragma once
+
+#include <fb/tcp_client.h>
+#include <fb/poll_set.h>
+#include <fb/socket_address.h>
+#include <fb/fb_signal.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace fb {
+
+/**
+ * @brief Drives many non-blocking TCP connects from a single thread.
+ *
+ * connect() starts a non-blocking connect and returns at once; run() waits
+ * on all pending sockets with one poll_set and completes each attempt when
+ * its socket becomes writable, fails, or reaches its deadline. Completion is
+ * reported through the per-connect handler, which receives ownership of the
+ * (blocking, connected) tcp_client, and through the onConnected and
+ * onConnectFailed signals. Connecting to N endpoints therefore costs one
+ * round trip of wall time instead of N sequential connect(timeout) calls.
+ *
+ * Handlers run on the thread calling run() or wait() and may call connect()
+ * or cancel() themselves.
+ *
+ * @note Not thread-safe; drive each connector from one thread.
+ */
+class tcp_connector
+{
+public:
+
+  using connect_handler = std::function<void(std::uint64_t id, const socket_address& address,
+                                             tcp_client client, const std::error_code& error)>;
+
+  tcp_connector();
+  ~tcp_connector();
+
+  tcp_connector(const tcp_connector&)            = delete;
+  tcp_connector& operator=(const tcp_connector&) = delete;
+
+  std::uint64_t connect(const socket_address& address,
+                        const std::chrono::milliseconds& timeout,
+                        connect_handler handler = nullptr);
+
+  std::size_t run(const std::chrono::milliseconds& timeout);
+  bool wait(const std::chrono::milliseconds& timeout);
+
+  bool cancel(std::uint64_t id);
+  void cancel_all();
+
+  std::size_t pending() const;
+
+  // Signals for event-driven programming; emitted on the thread calling run()
+  fb::signal<std::uint64_t, const socket_address&> onConnected;          ///< Emitted when a connect succeeds
+  fb::signal<std::uint64_t, const socket_address&, const std::string&> onConnectFailed; ///< Emitted when a connect fails, times out or is cancelled
+
+private:
+
+  struct attempt
+  {
+    std::uint64_t id = 0;
+    socket_address address;
+    tcp_client client{INVALID_SOCKET_VALUE};
+    std::chrono::steady_clock::time_point deadline;
+    connect_handler handler;
+    std::error_code error;              ///< Set when the connect failed before polling
+  };
+
+  poll_set m_poll_set;                                          ///< Sockets with a connect in flight
+  std::unordered_map<std::uint64_t, std::unique_ptr<attempt>> m_attempts; ///< Pending attempts by id
+  std::vector<std::unique_ptr<attempt>> m_failed;               ///< Attempts that failed in connect()
+  std::vector<SocketEvent> m_events;                            ///< Reused poll result buffer
+  std::uint64_t m_next_id;                                      ///< Next attempt id
+
+  std::size_t complete(std::unique_ptr<attempt> op, const std::error_code& error);
+  std::size_t deliver_failed();
+  std::size_t expire(const std::chrono::steady_clock::time_point& now);
+};
+
+} // namespace fb
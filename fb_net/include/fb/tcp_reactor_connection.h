@@ -0,0 +1,113 @@
+#pragma once
+
+#include <fb/tcp_client.h>
+#include <fb/socket_address.h>
+#include <fb/output_budget.h>
+#include <fb/timer_wheel.h>
+#include <fb/fb_signal.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace fb {
+
+class tcp_server;
+
+/**
+ * @brief Base class for non-blocking TCP connections driven by a tcp_server
+ * event loop.
+ *
+ * Unlike tcp_server_connection, a reactor connection never owns a thread.
+ * The server's event-loop threads poll the socket and invoke on_readable() /
+ * on_writable() whenever the kernel reports readiness. Handlers must not
+ * block: read what is available, write what fits, and return.
+ *
+ * All callbacks for a given connection run on the same event-loop thread, so
+ * per-connection state needs no synchronization.
+ *
+ * @note The socket is placed in non-blocking mode before on_open() is called.
+ * receive_bytes()/send_bytes() raise std::system_error with
+ * std::errc::resource_unavailable_try_again when the operation would block.
+ * send_buffered() is the non-blocking alternative: it writes what fits and
+ * queues the rest, flushing it whenever the socket becomes writable, within
+ * the server's backpressure_policy.
+ */
+class tcp_reactor_connection
+{
+  friend class tcp_server;
+
+public:
+
+  tcp_reactor_connection(tcp_client socket, const socket_address& client_address);
+  tcp_reactor_connection(const tcp_reactor_connection&) = delete;
+  tcp_reactor_connection(tcp_reactor_connection&&) = delete;
+  tcp_reactor_connection& operator=(const tcp_reactor_connection&) = delete;
+  tcp_reactor_connection& operator=(tcp_reactor_connection&&) = delete;
+
+  virtual ~tcp_reactor_connection();
+
+  /// @brief Called once on the event-loop thread after registration
+  virtual void on_open();
+
+  /// @brief Called when the socket is readable (or has a pending error/EOF)
+  virtual void on_readable() = 0;
+
+  /// @brief Called when the socket is writable and write interest is set
+  virtual void on_writable();
+
+  /// @brief Called once before the socket is closed and the handler destroyed
+  virtual void on_close();
+
+  void close();
+  bool close_requested() const;
+  void set_write_interest(bool flag);
+  bool write_interest() const;
+  void set_write_coalescing(bool flag);
+  bool write_coalescing() const;
+
+  bool send_buffered(const void* buffer, std::size_t length);
+  std::size_t buffered_output() const;
+  std::uint64_t refused_writes() const;
+  void set_backpressure(const backpressure_policy& policy);
+  const backpressure_policy& backpressure() const;
+
+  tcp_client& socket();
+  const tcp_client& socket() const;
+  const socket_address& client_address() const;
+  std::chrono::steady_clock::duration uptime() const;
+
+  // Emitted on the event-loop thread with the bytes queued at the time
+  fb::signal<std::size_t> onOutputHigh;  ///< Queue reached the high watermark; throttle
+  fb::signal<std::size_t> onOutputLow;   ///< Queue drained to the low watermark; resume
+
+protected:
+
+  virtual void handle_exception(const std::exception& ex) noexcept;
+
+private:
+
+  bool wants_writable() const;
+  void flush_output();
+  std::size_t write_some(const char* data, std::size_t length);
+
+  tcp_client m_socket;                                ///< Non-blocking client socket
+  socket_address m_client_address;                    ///< Client's address
+  bool m_close_requested;                             ///< Set by close(); acted on by the loop
+  bool m_write_interest;                              ///< Whether POLL_WRITE is requested
+  bool m_write_coalescing;                            ///< Cork the socket around callbacks
+  std::chrono::steady_clock::time_point m_start_time; ///< Connection start time
+  std::vector<char> m_output;                         ///< Bytes the socket has not taken yet
+  std::size_t m_output_offset;                        ///< First unsent byte in m_output
+  bool m_output_high;                                 ///< onOutputHigh raised, onOutputLow pending
+  std::uint64_t m_refused_writes;                     ///< send_buffered() calls refused
+  backpressure_policy m_backpressure;                 ///< Per-connection limits
+  std::shared_ptr<output_budget> m_budget;            ///< Server-wide account, if any
+  std::uint64_t m_last_activity;                      ///< Loop tick of the last readiness callback
+  std::uint64_t m_output_progress;                    ///< Loop tick queued output last drained
+  timer_wheel::timer_id m_timer;                      ///< Pending timeout check, if any
+};
+
+} // namespace fb
@@ -2,6 +2,13 @@
 
 #include <fb/server_socket.h>
 #include <fb/tcp_server_connection.h>
+#include <fb/tcp_reactor_connection.h>
+#include <fb/mpmc_queue.h>
+#include <fb/latency_histogram.h>
+#include <fb/metrics.h>
+#include <fb/worker_pool_policy.h>
+#include <fb/output_budget.h>
+#include <fb/thread_config.h>
 #include <fb/socket_address.h>
 #include <fb/fb_signal.hpp>
 #include <memory>
@@ -13,6 +20,7 @@
 #include <atomic>
 #include <functional>
 #include <chrono>
+#include <string>
 
 namespace fb {
 
@@ -24,6 +32,12 @@ namespace fb {
  * `tcp_server_connection` handlers managed by a small worker pool. It tracks connections,
  * manages graceful shutdown, and exposes basic runtime statistics.
  *
+ * Reactor mode: when a reactor factory is installed via set_reactor_factory(),
+ * accepted sockets are switched to non-blocking mode and distributed
+ * round-robin across a fixed set of event-loop threads. Each loop owns a
+ * `poll_set` and drives `tcp_reactor_connection` callbacks, so the number of
+ * concurrent sessions is no longer bounded by the worker thread count.
+ *
  * @warning Move Operations: The server must be stopped before moving. Moving a running
  *          server results in undefined behavior because worker threads cannot be
  *          transferred between instances. Always call stop() before move construction
@@ -41,6 +55,14 @@ public:
      */
     using connection_factory = std::function<std::unique_ptr<tcp_server_connection>(tcp_client, const socket_address&)>;
 
+    /**
+     * @brief Factory type for reactor-mode connections
+     * @param socket Accepted client socket (switched to non-blocking by the server)
+     * @param client_address Address of the connected client
+     * @return Unique pointer to tcp_reactor_connection-derived instance
+     */
+    using reactor_connection_factory = std::function<std::unique_ptr<tcp_reactor_connection>(tcp_client, const socket_address&)>;
+
     tcp_server();
     tcp_server(fb::server_socket server_socket, 
               connection_factory connection_factory,
@@ -60,23 +82,49 @@ public:
     void stop(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(5000));
     bool is_running() const;
 
+    void hand_off_listener(const std::string& unix_path,
+                           const std::chrono::milliseconds& timeout = std::chrono::seconds(5));
+    bool drain(const std::chrono::milliseconds& timeout);
+
     // Server configuration
 
     void set_server_socket(fb::server_socket server_socket);
     void set_connection_factory(connection_factory factory);
+    void set_reactor_factory(reactor_connection_factory factory, std::size_t event_loops = 0);
     void set_max_threads(std::size_t max_threads);
+    void set_worker_pool(const worker_pool_policy& policy);
     void set_max_queued(std::size_t max_queued);
     void set_connection_timeout(const std::chrono::milliseconds& timeout);
     void set_idle_timeout(const std::chrono::milliseconds& timeout);
+    void set_lock_free_queue(bool enabled, std::size_t spin_count = 0);
+    void set_acceptor_shards(std::size_t shards, int backlog = 0);
+    void set_latency_tracking(bool enabled);
+    void set_backpressure(const backpressure_policy& policy);
+    void set_thread_configurator(thread_configurator configurator);
 
     // Server status and statistics
 
     const fb::server_socket& server_socket() const;
     std::size_t active_connections() const;
     std::size_t thread_count() const;
+    std::size_t event_loop_count() const;
+    bool is_reactor_mode() const;
+    bool lock_free_queue() const;
     std::uint64_t total_connections() const;
+    std::uint64_t timed_out_connections() const;
+    std::size_t acceptor_shards() const;
+    std::uint64_t shard_connections(std::size_t shard) const;
     std::size_t queued_connections() const;
     std::chrono::steady_clock::duration uptime() const;
+    bool latency_tracking() const;
+    const worker_pool_policy& worker_pool() const;
+    const backpressure_policy& backpressure() const;
+    std::size_t buffered_output() const;
+    std::uint64_t refused_writes() const;
+    latency_snapshot queue_latency() const;
+    latency_snapshot service_latency() const;
+    void reset_latency_statistics();
+    metrics_registration register_metrics(metrics_registry& registry, const std::string& prefix) const;
 
     // Signals for server events
     // Note: Signals are emitted on the acceptor/worker threads
@@ -86,6 +134,7 @@ public:
     fb::signal<const socket_address&> onConnectionAccepted;    ///< Emitted when new connection accepted
     fb::signal<const socket_address&> onConnectionClosed;      ///< Emitted when connection closes
     fb::signal<size_t> onActiveConnectionsChanged;             ///< Emitted when active connection count changes
+    fb::signal<std::chrono::nanoseconds, std::chrono::nanoseconds> onLatencyRecorded;  ///< Emitted with queue wait and service time per connection or reactor event
     fb::signal<const std::exception&, const std::string&> onException;  ///< Emitted when exception occurs
 
 protected:
@@ -96,33 +145,59 @@ protected:
 
 private:
 
+    struct reactor_loop;
+    struct acceptor_shard;
+
     // Server state
     fb::server_socket m_server_socket;
     connection_factory m_connection_factory;
+    reactor_connection_factory m_reactor_factory;
     std::atomic<bool> m_running;
     std::atomic<bool> m_should_stop;
+    std::atomic<bool> m_accepting;                        ///< False once the listener is handed off
     
     // Threading infrastructure
-    std::thread m_acceptor_thread;
+    std::vector<std::unique_ptr<acceptor_shard>> m_acceptors;
     std::vector<std::thread> m_worker_threads;
+    std::vector<std::thread> m_retired_threads;
     std::queue<std::unique_ptr<tcp_server_connection>> m_connection_queue;
     mutable std::mutex m_queue_mutex;
     std::condition_variable m_queue_condition;
     mutable std::mutex m_threads_mutex;
+    std::unique_ptr<mpmc_queue<std::unique_ptr<tcp_server_connection>>> m_lock_free_queue;
     
     // Active connections tracking
     std::vector<std::shared_ptr<tcp_server_connection>> m_active_connections;
     mutable std::mutex m_connections_mutex;
+
+    // Reactor mode (event loops are owned here, defined in tcp_server.cpp)
+    std::vector<std::unique_ptr<reactor_loop>> m_reactor_loops;
+    std::size_t m_event_loops;
+    std::atomic<std::size_t> m_next_loop;
+    std::atomic<std::size_t> m_reactor_connections;
+    std::atomic<std::uint64_t> m_timed_out_connections;
     
     // Configuration
     std::size_t m_max_threads;
     std::size_t m_max_queued;
     std::chrono::milliseconds m_connection_timeout;
     std::chrono::milliseconds m_idle_timeout;
+    bool m_use_lock_free_queue;
+    std::size_t m_queue_spin_count;
+    std::size_t m_acceptor_shards;
+    int m_shard_backlog;
+    worker_pool_policy m_pool_policy;
+    backpressure_policy m_backpressure;
+    std::shared_ptr<output_budget> m_output_budget;
+    thread_configurator m_thread_configurator;
+    std::atomic<std::size_t> m_worker_serial;             ///< Workers started since start()
     
     // Statistics
     std::atomic<std::uint64_t> m_total_connections;
     std::chrono::steady_clock::time_point m_start_time;
+    bool m_track_latency;
+    std::unique_ptr<latency_histogram> m_queue_latency;
+    std::unique_ptr<latency_histogram> m_service_latency;
     
     // Configuration validation
     bool m_has_socket;
@@ -130,15 +205,37 @@ private:
     
     // Thread pool management
     static constexpr std::size_t DEFAULT_MAX_THREADS = 100;
+    static constexpr std::size_t DEFAULT_MIN_THREADS = 4;
     static constexpr std::size_t DEFAULT_MAX_QUEUED = 100;
     static constexpr auto DEFAULT_CONNECTION_TIMEOUT = std::chrono::milliseconds(30000);
     static constexpr auto DEFAULT_IDLE_TIMEOUT = std::chrono::milliseconds(0);
+    static constexpr std::size_t DEFAULT_EVENT_LOOPS = 2;
+    static constexpr std::size_t DEFAULT_ACCEPTOR_SHARDS = 1;
+    static constexpr auto DRAIN_POLL_INTERVAL = std::chrono::milliseconds(10);
 
-    void acceptor_thread_proc();
+    void acceptor_thread_proc(acceptor_shard& shard, std::size_t index);
+    void open_acceptor_shards();
+    void join_acceptors();
     void worker_thread_proc();
+    void reactor_thread_proc(reactor_loop& loop, std::size_t index);
+    void configure_thread(thread_role role, std::size_t index) noexcept;
+    bool dispatch_to_reactor(tcp_client client_socket, const socket_address& client_address,
+                             std::atomic<std::uint64_t>& accepted);
+    void reactor_register(reactor_loop& loop, std::unique_ptr<tcp_reactor_connection> connection);
+    void reactor_dispatch_event(reactor_loop& loop, tcp_reactor_connection& connection, int mode);
+    void reactor_apply_state(reactor_loop& loop, tcp_reactor_connection& connection, bool had_write_interest);
+    void reactor_retire(reactor_loop& loop, tcp_reactor_connection& connection);
+    void reactor_check_timeout(reactor_loop& loop, tcp_reactor_connection& connection);
+    std::chrono::milliseconds reactor_timer_resolution() const;
+    void start_reactor_loops();
+    void stop_reactor_loops();
     void process_connection(std::unique_ptr<tcp_server_connection> connection);
+    void record_latency(bool queued, std::chrono::steady_clock::duration queue_wait,
+                        std::chrono::steady_clock::duration service_time);
     void cleanup_connections();
-    void add_worker_thread_if_needed();
+    void add_worker_thread_if_needed(bool queue_wait_exceeded = false);
+    bool retire_idle_worker(const std::chrono::steady_clock::time_point& idle_since);
+    std::size_t min_worker_threads() const;
     void validate_configuration() const;
     void shutdown_threads(const std::chrono::milliseconds& timeout);
     bool is_configured() const;
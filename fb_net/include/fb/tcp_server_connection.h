@@ -3,6 +3,8 @@
 #include <fb/tcp_client.h>
 #include <fb/socket_address.h>
 #include <fb/fb_signal.hpp>
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <atomic>
 
@@ -41,7 +43,9 @@ public:
   std::chrono::steady_clock::duration uptime() const;
   void set_timeout(const std::chrono::milliseconds& timeout);
   void set_no_delay(bool flag);
+  void set_cork(bool flag);
   void set_keep_alive(bool flag);
+  bool send_within(const void* buffer, std::size_t length, const std::chrono::milliseconds& timeout);
 
   // Signals for connection events
   // Note: Signals are emitted on the connection's worker thread
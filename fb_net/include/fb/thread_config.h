@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fb {
+
+/**
+ * @brief Kinds of threads the servers start.
+ */
+enum class thread_role
+{
+  acceptor, ///< tcp_server acceptor (one per acceptor shard)
+  reactor,  ///< tcp_server reactor-mode event loop
+  receiver, ///< udp_server receiver (one per receiving socket)
+  worker    ///< tcp_server or udp_server pool or flow worker
+};
+
+/**
+ * @brief Scheduling settings applied to a thread as it starts.
+ *
+ * Every field is optional; a default-constructed config leaves the thread
+ * as created. Used through set_thread_configurator() of tcp_server and
+ * udp_server to keep network threads on dedicated cores, name them for
+ * top/perf, and optionally run them under SCHED_FIFO.
+ */
+struct thread_config
+{
+  std::vector<int> cpus;     ///< CPUs the thread may run on (empty keeps the inherited set; Linux only)
+  std::string name;          ///< Thread name (empty keeps it; Linux truncates to 15 characters)
+  int realtime_priority = 0; ///< SCHED_FIFO priority (0 keeps the default policy; POSIX only)
+};
+
+/**
+ * @brief Callback choosing the config of each server thread.
+ *
+ * Called on the new thread before it does any work. @p index counts
+ * threads of one role: the shard, loop or receiving-socket number, and for
+ * workers the order of creation since start().
+ */
+using thread_configurator = std::function<thread_config(thread_role role, std::size_t index)>;
+
+void apply_thread_config(const thread_config& config);
+
+} // namespace fb
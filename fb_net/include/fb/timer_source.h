@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace fb {
+
+/**
+ * @brief Kernel timer that a poll_set reports like a readable socket.
+ *
+ * A timerfd on Linux; on BSD and macOS a private kqueue holding one
+ * EVFILT_TIMER, which the outer kqueue sees as readable when the timer
+ * fires. Added to a poll_set, its expirations arrive from poll() next to the
+ * socket events, so one reactor thread handles network I/O and timeouts
+ * without a timer thread, cross-thread handoff or locking.
+ *
+ * Events for the source carry a null socket_ptr and the user_data given to
+ * poll_set::add(); call read() when one is reported. Expirations that pile
+ * up between polls are counted, not queued: read() returns how many there
+ * were.
+ *
+ * On kqueue a repeating timer whose first delay differs from its interval
+ * is re-armed with the interval by the read() that collects the first
+ * expiration, so that period starts a little late. On other platforms
+ * construction throws.
+ *
+ * @note Not thread-safe; use each source from the thread that polls it.
+ */
+class timer_source
+{
+public:
+
+  timer_source();
+  timer_source(const timer_source&) = delete;
+  timer_source(timer_source&& other) noexcept;
+  timer_source& operator=(const timer_source&) = delete;
+  timer_source& operator=(timer_source&& other) noexcept;
+  ~timer_source();
+
+  void start(const std::chrono::nanoseconds& delay,
+             const std::chrono::nanoseconds& interval = std::chrono::nanoseconds::zero());
+  void stop();
+  std::uint64_t read();
+
+  bool is_active() const noexcept;
+  std::chrono::nanoseconds interval() const noexcept;
+  int native_handle() const noexcept;
+
+  static bool supported() noexcept;
+
+private:
+
+  void close() noexcept;
+  void arm(const std::chrono::nanoseconds& delay, const std::chrono::nanoseconds& interval);
+
+  int m_fd;                            ///< timerfd, or the private kqueue
+  bool m_active;                       ///< Armed and not yet expired for the last time
+  bool m_rearm;                        ///< First expiration pending, interval still to arm (kqueue only)
+  std::chrono::nanoseconds m_interval; ///< Period, zero for a one-shot timer
+};
+
+} // namespace fb
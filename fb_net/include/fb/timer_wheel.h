@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace fb {
+
+/**
+ * @brief Hierarchical timer wheel with O(1) schedule, cancel and tick.
+ *
+ * Time advances in fixed ticks of resolution(). Four levels of 64 slots
+ * cover 2^24 ticks: a timer is filed in the slot of the coarsest level that
+ * still distinguishes its expiry, and moves down a level each time the
+ * finer level wraps. Timers further out are parked in the top level and
+ * re-filed until they come within range. Expiry is late by at most one
+ * tick, never early.
+ *
+ * The wheel is not thread-safe; it is meant to be owned by one event loop,
+ * which calls advance() between polls. Callbacks run inside advance() and
+ * may schedule or cancel timers, including their own successors.
+ */
+class timer_wheel
+{
+public:
+
+  using timer_id = std::uint64_t;
+  using callback = std::function<void()>;
+
+  static constexpr timer_id INVALID_TIMER = 0;  ///< Never returned by schedule()
+
+  explicit timer_wheel(const std::chrono::milliseconds& resolution = std::chrono::milliseconds(10));
+
+  timer_wheel(const timer_wheel&)            = delete;
+  timer_wheel& operator=(const timer_wheel&) = delete;
+
+  timer_id schedule(std::uint64_t ticks, callback cb);
+  timer_id schedule_after(const std::chrono::milliseconds& delay, callback cb);
+  bool cancel(timer_id id) noexcept;
+
+  std::size_t tick(std::uint64_t ticks = 1);
+  std::size_t advance(std::chrono::steady_clock::time_point now);
+
+  std::uint64_t ticks_for(const std::chrono::milliseconds& duration) const;
+  std::uint64_t current_tick() const noexcept;
+  std::chrono::milliseconds resolution() const noexcept;
+  std::size_t size() const noexcept;
+  bool empty() const noexcept;
+
+private:
+
+  static constexpr std::size_t LEVELS = 4;
+  static constexpr unsigned SLOT_BITS = 6;
+  static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+  static constexpr std::uint64_t SLOT_MASK = SLOTS - 1;
+  static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+
+  struct node
+  {
+    std::uint64_t expiry = 0;      ///< Absolute tick the timer fires on
+    std::uint32_t prev = NIL;      ///< Previous node in the slot (or free) list
+    std::uint32_t next = NIL;      ///< Next node in the slot (or free) list
+    std::uint32_t generation = 0;  ///< Bumped on release; stale ids do not match
+    std::uint16_t slot = 0;        ///< level * SLOTS + slot index while armed
+    bool armed = false;            ///< Linked into a slot
+    callback cb;                   ///< Function run on expiry
+  };
+
+  void file(std::uint32_t index);
+  void unlink(std::uint32_t index) noexcept;
+  void release(std::uint32_t index) noexcept;
+  void cascade(std::size_t level);
+  std::size_t expire_current();
+
+  std::vector<node> m_nodes;                         ///< Timer storage, indexed by id
+  std::array<std::uint32_t, LEVELS * SLOTS> m_heads; ///< First node of every slot
+  std::uint32_t m_free;                              ///< Head of the free node list
+  std::size_t m_armed;                               ///< Timers currently scheduled
+  std::uint64_t m_tick;                              ///< Last tick processed
+  std::chrono::milliseconds m_resolution;            ///< Duration of one tick
+  std::chrono::steady_clock::time_point m_origin;    ///< Time of tick 0
+};
+
+} // namespace fb
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <fb/socket_base.h>
+#include <memory>
+#include <string>
+
+namespace fb {
+
+/**
+ * @brief Side of the TLS handshake a socket takes.
+ */
+enum class tls_role
+{
+  client, ///< Sends ClientHello, verifies the server
+  server  ///< Presents a certificate
+};
+
+/**
+ * @brief One established TLS connection, as returned by tls_context::handshake().
+ *
+ * Once the handshake is done an engine may hand the record layer to the
+ * kernel (Linux kTLS). kernel_send() then reports that plain writes on the
+ * descriptor, including sendfile() and gathered sends, are encrypted by the
+ * kernel, and tcp_client bypasses write(). Receives always go through read(),
+ * which lets the engine handle TLS control records; with kernel_receive() the
+ * kernel decrypts and read() only copies.
+ */
+class tls_session
+{
+public:
+
+  virtual ~tls_session() = default;
+
+  virtual bool kernel_send() const    = 0; ///< Kernel encrypts outgoing records
+  virtual bool kernel_receive() const = 0; ///< Kernel decrypts incoming records
+
+  /**
+   * @brief Encrypt and send; returns the bytes taken.
+   * @throws std::system_error resource_unavailable_try_again if a non-blocking
+   * socket would block, or on transport or protocol failure.
+   */
+  virtual int write(const void* buffer, int length) = 0;
+
+  /**
+   * @brief Receive and decrypt; returns 0 once the peer has closed.
+   * @throws std::system_error as write().
+   */
+  virtual int read(void* buffer, int length) = 0;
+
+  virtual int pending() const = 0;         ///< Decrypted bytes buffered by the engine
+  virtual void close_notify() noexcept = 0; ///< Send the TLS close alert (best effort)
+
+  virtual std::string protocol() const = 0; ///< Negotiated version, e.g. "TLSv1.3"
+  virtual std::string cipher() const   = 0; ///< Negotiated cipher suite
+};
+
+/**
+ * @brief Pluggable TLS engine: credentials, policy and the handshake.
+ *
+ * Implement this to use a TLS library other than the bundled OpenSSL
+ * engine (make_openssl_tls_context()). One context serves any number of
+ * connections; handshake() must be safe to call from several threads.
+ */
+class tls_context
+{
+public:
+
+  virtual ~tls_context() = default;
+
+  /**
+   * @brief Run the handshake on a connected, blocking socket.
+   *
+   * @param fd Socket descriptor; the session does not own it.
+   * @param role Which side of the handshake to take.
+   * @param server_name Host name for SNI and certificate checks (clients).
+   * @throws std::system_error If the handshake fails.
+   */
+  virtual std::unique_ptr<tls_session> handshake(socket_t fd, tls_role role,
+                                                 const std::string& server_name) = 0;
+};
+
+/**
+ * @brief Settings of the OpenSSL engine.
+ */
+struct openssl_tls_options
+{
+  std::string certificate_file;   ///< PEM certificate chain (required for servers)
+  std::string private_key_file;   ///< PEM private key of certificate_file
+  std::string ca_file;            ///< PEM trust anchors (empty: system defaults)
+  bool verify_peer = true;        ///< Clients: verify the server certificate and name
+  bool require_client_certificate = false; ///< Servers: mutual TLS
+  bool kernel_offload = true;     ///< Hand the record layer to kTLS when available
+};
+
+std::shared_ptr<tls_context> make_openssl_tls_context(tls_role role,
+                                                      const openssl_tls_options& options);
+
+} // namespace fb
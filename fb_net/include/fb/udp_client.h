@@ -2,9 +2,13 @@
 
 #include <fb/udp_socket.h>
 #include <fb/socket_address.h>
+#include <fb/send_pacer.h>
 #include <fb/fb_signal.hpp>
 #include <string>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace fb {
 
@@ -15,11 +19,18 @@ namespace fb {
  * Provides a simplified interface for UDP communication, built on top
  * of udp_socket. It supports both connected and connectionless operations,
  * automatic addressing, timeouts, and broadcast/multicast operations.
+ *
+ * set_pacing() caps the send rate with a token bucket. Every send call,
+ * including send_batch(), waits inline until its datagram conforms, so no
+ * separate pacing thread is needed; with kernel pacing the datagrams also
+ * carry an SO_TXTIME departure time so the fq qdisc spaces them evenly.
  */
 class udp_client
 {
 public:
 
+  static constexpr std::size_t DEFAULT_PACING_BURST = 16 * 1024; ///< Bucket depth when set_pacing() gets 0
+
   udp_client();
   explicit udp_client(socket_address::Family family);
   explicit udp_client(const socket_address& local_address, bool reuse_address = true);
@@ -50,6 +61,7 @@ public:
   int send_to(const std::string& message, const socket_address& address);
   int receive_from(void* buffer, std::size_t length, socket_address& sender_address);
   int receive_from(std::string& message, std::size_t max_length, socket_address& sender_address);
+  int send_batch(const udp_send_entry* entries, std::size_t count);
   int send_with_timeout(const void* buffer,
                         std::size_t length,
                         const std::chrono::milliseconds& timeout);
@@ -72,6 +84,14 @@ public:
   void set_send_buffer_size(int size);
   int get_send_buffer_size();
 
+  // Send pacing
+
+  void set_pacing(std::uint64_t bytes_per_second, std::size_t burst_bytes = 0, bool kernel_pacing = true);
+  std::uint64_t pacing_rate() const;
+  std::size_t pacing_burst() const;
+  bool kernel_pacing() const;
+  std::chrono::nanoseconds pacing_delay(std::size_t length) const;
+
   // Status queries
 
   bool is_connected() const;
@@ -116,11 +136,17 @@ private:
     bool m_is_connected; ///< Whether client is connected to specific address
     socket_address m_remote_address; ///< Remote address (when connected)
     std::chrono::milliseconds m_timeout; ///< Default timeout for operations
+    send_pacer m_pacer; ///< Token bucket applied to every send (disabled by default)
+    bool m_kernel_pacing; ///< Departures are handed to the qdisc with SO_TXTIME
+    std::vector<udp_send_entry> m_paced_batch; ///< send_batch() entries stamped with departures
 
     static constexpr auto DEFAULT_TIMEOUT = std::chrono::milliseconds(30000);
     static constexpr std::size_t DEFAULT_BUFFER_SIZE = 65507; // Max UDP payload size
 
     void init_client(socket_address::Family family);
+    void wait_for_pacer(std::size_t length) const;
+    int paced_send(const void* buffer, std::size_t length, const socket_address* destination);
+    int paced_send_batch(const udp_send_entry* entries, std::size_t count);
 };
 
 } // namespace fb
@@ -2,7 +2,10 @@
 
 #include <atomic>
 #include <chrono>
+#include <fb/metrics.h>
+#include <fb/sharded_counters.h>
 #include <fb/socket_address.h>
+#include <fb/udp_socket.h>
 #include <memory>
 
 namespace fb
@@ -21,6 +24,20 @@ class udp_handler
 {
 public:
 
+  /**
+   * @brief One datagram of a batch passed to handle_batch().
+   *
+   * Views borrow the server's packet buffers and are only valid for the
+   * duration of the call.
+   */
+  struct packet_view
+  {
+    const void * buffer;             ///< Packet payload
+    std::size_t length;              ///< Payload length in bytes
+    const socket_address * sender;   ///< Source endpoint of the packet
+    const udp_timestamp * timestamp; ///< Kernel receive timestamps
+  };
+
   udp_handler();
 
   /// @brief Copy/move operations disabled - handlers manage per-instance statistics
@@ -39,6 +56,13 @@ public:
                       std::size_t length,
                       const socket_address & sender_address) noexcept;
 
+  bool process_packet(const void * buffer,
+                      std::size_t length,
+                      const socket_address & sender_address,
+                      const udp_timestamp & timestamp) noexcept;
+
+  virtual std::size_t handle_batch(const packet_view * packets, std::size_t count);
+
   virtual std::string handler_name() const;
   virtual std::size_t max_packet_size() const;
   virtual bool can_handle_address(const socket_address & sender_address) const;
@@ -47,6 +71,8 @@ public:
   std::uint64_t bytes_processed() const;
   std::uint64_t error_count() const;
 
+  metrics_registration register_metrics(metrics_registry & registry, const std::string & prefix) const;
+
   std::chrono::steady_clock::time_point creation_time() const;
   std::chrono::steady_clock::time_point last_packet_time() const;
 
@@ -54,6 +80,10 @@ public:
 
 protected:
 
+  static const udp_timestamp & packet_timestamp() noexcept;
+
+  void record_batch(std::size_t processed, std::size_t bytes, std::size_t errors) noexcept;
+
   virtual void handle_exception(const std::exception & ex,
                                 const socket_address & sender_address) noexcept;
 
@@ -70,12 +100,19 @@ protected:
                                const socket_address & sender_address) const;
 
 private:
-  // Statistics are atomic to support shared handlers called from multiple worker threads
-  std::atomic<std::uint64_t> m_packets_processed{0};        ///< Number of packets processed
-  std::atomic<std::uint64_t> m_bytes_processed{0};          ///< Number of bytes processed
-  std::atomic<std::uint64_t> m_error_count{0};              ///< Number of errors encountered
+  enum statistic : std::size_t
+  {
+    PACKETS_PROCESSED, ///< Number of packets processed
+    BYTES_PROCESSED,   ///< Number of bytes processed
+    ERROR_COUNT,       ///< Number of errors encountered
+    LAST_PACKET_TIME,  ///< steady_clock ticks of the last packet, per thread
+    STATISTICS
+  };
+
+  // Sharded per thread so shared handlers called from many workers do not
+  // contend on the statistics cache line
+  sharded_counters<STATISTICS> m_statistics;
   std::chrono::steady_clock::time_point m_creation_time;    ///< Handler creation time
-  std::atomic<std::chrono::steady_clock::time_point::rep> m_last_packet_time_rep; ///< Last packet processing time (atomic rep)
 
   void initialize();
   void update_statistics(std::size_t length, bool success);
@@ -2,6 +2,13 @@
 
 #include <fb/udp_socket.h>
 #include <fb/udp_handler.h>
+#include <fb/mpmc_queue.h>
+#include <fb/sharded_counters.h>
+#include <fb/latency_histogram.h>
+#include <fb/metrics.h>
+#include <fb/object_pool.h>
+#include <fb/worker_pool_policy.h>
+#include <fb/thread_config.h>
 #include <fb/socket_address.h>
 #include <fb/fb_signal.hpp>
 #include <memory>
@@ -37,17 +44,39 @@ public:
         std::vector<std::uint8_t> buffer;
         socket_address sender_address;
         std::chrono::steady_clock::time_point received_time;
+        udp_timestamp kernel_timestamp; ///< Socket receive timestamps, if enabled
         
-        PacketData(const void* data, std::size_t length, const socket_address& sender)
+        PacketData() = default;
+
+        PacketData(const void* data, std::size_t length, const socket_address& sender,
+                   const udp_timestamp& timestamp = udp_timestamp())
          : buffer(static_cast<const std::uint8_t*>(data), 
                   static_cast<const std::uint8_t*>(data) + length),
            sender_address(sender),
-           received_time(std::chrono::steady_clock::now())
+           received_time(std::chrono::steady_clock::now()),
+           kernel_timestamp(timestamp)
+        {
+        }
+
+        /// @brief Refill a recycled instance; reuses the buffer's capacity
+        void assign(const void* data, std::size_t length, const socket_address& sender,
+                    const udp_timestamp& timestamp = udp_timestamp())
         {
+            buffer.assign(static_cast<const std::uint8_t*>(data),
+                          static_cast<const std::uint8_t*>(data) + length);
+            sender_address = sender;
+            received_time = std::chrono::steady_clock::now();
+            kernel_timestamp = timestamp;
         }
     };
 
+    /// Pool the server can allocate PacketData from (see set_packet_allocator())
+    using packet_pool = object_pool<PacketData>;
+    /// Owning packet pointer; a default deleter means the packet is on the heap
+    using packet_ptr = packet_pool::pointer;
+
     using HandlerFactory = std::function<std::unique_ptr<udp_handler>(const PacketData& packet_data)>;
+    using FlowKeyExtractor = std::function<std::uint64_t(const PacketData& packet_data)>;
 
     udp_server();
 
@@ -82,9 +111,37 @@ public:
     void set_handler_factory(HandlerFactory factory);
     void set_shared_handler(std::shared_ptr<udp_handler> handler);
     void set_max_threads(std::size_t max_threads);
+    void set_worker_pool(const worker_pool_policy& policy);
     void set_max_queued(std::size_t max_queued);
     void set_packet_buffer_size(std::size_t size);
     void set_packet_timeout(const std::chrono::milliseconds& timeout);
+    void set_receive_batch_size(std::size_t size);
+    void set_packet_pool_size(std::size_t size);
+    void set_packet_allocator(std::shared_ptr<packet_pool> pool);
+    void set_lock_free_queue(bool enabled, std::size_t spin_count = 0);
+    void set_receiver_shards(std::size_t shards, bool pin_to_cpus = false);
+    void add_receive_socket(udp_socket socket);
+    void set_busy_poll(const std::chrono::microseconds& spin_budget, int cpu = -1);
+    void set_latency_tracking(bool enabled);
+    void set_flow_affinity(std::size_t workers, FlowKeyExtractor key_extractor = nullptr);
+    void set_statistics_interval(const std::chrono::milliseconds& interval);
+    void set_handler_cache_size(std::size_t size);
+    void set_thread_configurator(thread_configurator configurator);
+
+    std::size_t receive_batch_size() const;
+    std::size_t packet_pool_size() const;
+    std::shared_ptr<packet_pool> packet_allocator() const;
+    std::size_t pooled_packets() const;
+    bool lock_free_queue() const;
+    std::size_t receiver_shards() const;
+    std::size_t receive_sockets() const;
+    std::chrono::microseconds busy_poll() const;
+    bool latency_tracking() const;
+    const worker_pool_policy& worker_pool() const;
+    std::size_t flow_workers() const;
+    std::chrono::milliseconds statistics_interval() const;
+    std::size_t handler_cache_size() const;
+    std::uint64_t handler_instances() const;
 
     const udp_socket& server_socket() const;
 
@@ -95,8 +152,14 @@ public:
 
     size_t queued_packets() const;
 
+    latency_snapshot queue_latency() const;
+    latency_snapshot service_latency() const;
+    void reset_latency_statistics();
+
     std::chrono::steady_clock::duration uptime() const;
 
+    metrics_registration register_metrics(metrics_registry& registry, const std::string& prefix) const;
+
     // fb::signal members for event-driven programming
     // Server lifecycle signals
     fb::signal<> onServerStarted;                          ///< Emitted when server starts
@@ -105,10 +168,12 @@ public:
 
     // Packet reception signals
     fb::signal<const void*, std::size_t, const socket_address&> onPacketReceived;  ///< Emitted when packet received
+    fb::signal<const void*, std::size_t, const socket_address&, const udp_timestamp&> onTimestampedPacketReceived;  ///< Emitted with receive timestamps when packet received
     fb::signal<std::size_t> onTotalPacketsChanged;                ///< Emitted when total packet count changes
     fb::signal<std::size_t> onProcessedPacketsChanged;            ///< Emitted when processed packet count changes
     fb::signal<std::size_t> onDroppedPacketsChanged;              ///< Emitted when dropped packet count changes
     fb::signal<std::size_t> onQueuedPacketsChanged;               ///< Emitted when queued packet count changes
+    fb::signal<std::chrono::nanoseconds, std::chrono::nanoseconds> onLatencyRecorded;  ///< Emitted with queue wait and service time per handled packet
 
     // Threading signals
     fb::signal<std::size_t> onWorkerThreadCreated;                ///< Emitted when worker thread created
@@ -134,24 +199,61 @@ private:
     std::atomic<bool> m_should_stop;
     
     // Threading infrastructure
-    std::thread m_receiver_thread;
+    std::vector<std::thread> m_receiver_threads;
+    std::vector<udp_socket> m_shard_sockets;
+    std::vector<udp_socket> m_extra_sockets;               ///< add_receive_socket(), one receiver each
+    std::shared_ptr<packet_pool> m_packet_allocator;       ///< Declared before every packet holder, outlives them
     std::vector<std::thread> m_worker_threads;
-    std::queue<std::unique_ptr<PacketData>> m_packet_queue;
+    std::vector<std::thread> m_retired_threads;
+    std::queue<packet_ptr> m_packet_queue;
     mutable std::mutex m_queue_mutex;
     std::condition_variable m_queue_condition;
     mutable std::mutex m_threads_mutex;
+    std::unique_ptr<mpmc_queue<packet_ptr>> m_lock_free_queue;
+    std::vector<std::unique_ptr<mpmc_queue<packet_ptr>>> m_flow_queues;
+    std::vector<packet_ptr> m_packet_pool;
+    mutable std::mutex m_pool_mutex;
     
     // Configuration
     std::size_t m_max_threads;
     std::size_t m_max_queued;
     std::size_t m_packet_buffer_size;
     std::chrono::milliseconds m_packet_timeout;
+    std::size_t m_receive_batch_size;
+    std::size_t m_packet_pool_size;
+    bool m_use_lock_free_queue;
+    std::size_t m_queue_spin_count;
+    std::size_t m_receiver_shards;
+    bool m_pin_receivers;
+    std::chrono::microseconds m_busy_poll_budget;
+    int m_busy_poll_cpu;
+    worker_pool_policy m_pool_policy;
+    std::size_t m_flow_workers;
+    FlowKeyExtractor m_flow_key;
+    std::size_t m_handler_cache_size;                        ///< Factory handlers kept per worker
+    thread_configurator m_thread_configurator;
+    std::atomic<std::size_t> m_worker_serial;                ///< Workers started since start()
     
     // Statistics
-    std::atomic<std::uint64_t> m_total_packets;
-    std::atomic<std::uint64_t> m_processed_packets;
-    std::atomic<std::uint64_t> m_dropped_packets;
+    enum packet_counter : std::size_t
+    {
+        TOTAL_PACKETS,
+        PROCESSED_PACKETS,
+        DROPPED_PACKETS,
+        PACKET_COUNTERS
+    };
+    sharded_counters<PACKET_COUNTERS> m_packets;              ///< Per-thread shards, summed on read
+    std::atomic<std::uint64_t> m_handler_instances;          ///< Handlers built by the factory
     std::chrono::steady_clock::time_point m_start_time;
+    bool m_track_latency;
+    std::unique_ptr<latency_histogram> m_queue_latency;
+    std::unique_ptr<latency_histogram> m_service_latency;
+    std::chrono::milliseconds m_statistics_interval;          ///< 0: counter signals per packet
+    std::atomic<std::int64_t> m_next_statistics;              ///< steady_clock ticks of next publication
+    std::uint64_t m_published_total;                          ///< Last values published, owned by the
+    std::uint64_t m_published_processed;                      ///< receiver that wins m_next_statistics
+    std::uint64_t m_published_dropped;
+    std::size_t m_published_queued;
     
     // Configuration validation
     bool m_has_socket;
@@ -159,15 +261,49 @@ private:
     
     // Thread pool management
     static constexpr std::size_t DEFAULT_MAX_THREADS = 10;
+    static constexpr std::size_t DEFAULT_MIN_THREADS = 2;
     static constexpr std::size_t DEFAULT_MAX_QUEUED = 1000;
     static constexpr std::size_t DEFAULT_PACKET_BUFFER_SIZE = 65507; // Max UDP payload
     static constexpr auto DEFAULT_PACKET_TIMEOUT = std::chrono::milliseconds(0);
+    static constexpr std::size_t DEFAULT_RECEIVE_BATCH_SIZE = 1;
+    static constexpr std::size_t MAX_RECEIVE_BATCH_SIZE = 1024;
+    static constexpr std::size_t DEFAULT_PACKET_POOL_SIZE = 256;
+    static constexpr std::size_t DEFAULT_RECEIVER_SHARDS = 1;
+    static constexpr std::size_t DEFAULT_HANDLER_CACHE_SIZE = 8;
+    static constexpr auto SOCKET_BUSY_POLL = std::chrono::microseconds(50);
 
-    void receiver_thread_proc();
+    void receiver_thread_proc(udp_socket& socket, std::size_t shard);
+    void open_shard_sockets();
+    bool wait_readable(udp_socket& socket);
     void worker_thread_proc();
-    void process_packet(std::unique_ptr<PacketData> packet_data);
+    void flow_worker_proc(std::size_t index);
+    void configure_thread(thread_role role, std::size_t index) noexcept;
+    void enqueue_packets(std::vector<packet_ptr>& batch);
+    void enqueue_flow_packets(std::vector<packet_ptr>& batch);
+    using handler_cache = std::vector<std::unique_ptr<udp_handler>>;
+
+    /// Scratch state owned by one worker thread
+    struct worker_state
+    {
+        handler_cache handlers;                            ///< Factory handlers reused by this worker
+        std::vector<packet_ptr> batch;    ///< Packets taken in one go
+        std::vector<const PacketData*> live;               ///< Unexpired packets of the batch
+        std::vector<udp_handler::packet_view> views;       ///< Run passed to handle_batch()
+    };
+
+    void process_taken(packet_ptr first, worker_state& state);
+    void process_packet(const PacketData& packet_data, handler_cache& handlers);
+    void process_batch(worker_state& state);
+    udp_handler* select_handler(const PacketData& packet_data, handler_cache& handlers,
+                                std::unique_ptr<udp_handler>& uncached);
+    packet_ptr acquire_packet(const void* data, std::size_t length, const socket_address& sender,
+                                               const udp_timestamp& timestamp);
+    void release_packet(packet_ptr packet_data);
     void cleanup_expired_packets();
-    void add_worker_thread_if_needed();
+    void publish_statistics(bool force = false);
+    void add_worker_thread_if_needed(bool queue_wait_exceeded = false);
+    bool retire_idle_worker(const std::chrono::steady_clock::time_point& idle_since);
+    std::size_t min_worker_threads() const;
     void validate_configuration() const;
     void shutdown_threads(const std::chrono::milliseconds& timeout);
     bool is_configured() const;
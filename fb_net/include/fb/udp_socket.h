@@ -4,9 +4,53 @@
 #include <fb/socket_address.h>
 #include <string>
 #include <chrono>
+#include <utility>
 
 namespace fb {
 
+/**
+ * @brief Receive timestamps reported by the kernel for one datagram.
+ *
+ * Both values are offsets from the epoch of the clock that produced them and
+ * are zero when not available. The software stamp uses the system (realtime)
+ * clock; the hardware stamp comes from the NIC's clock, which is only
+ * comparable to system time if the NIC is disciplined (e.g. by PTP).
+ */
+struct udp_timestamp
+{
+  std::chrono::nanoseconds software{0}; ///< Kernel receive time (system clock)
+  std::chrono::nanoseconds hardware{0}; ///< NIC receive time (raw hardware clock)
+
+  bool has_software() const { return software.count() != 0; }
+  bool has_hardware() const { return hardware.count() != 0; }
+};
+
+/**
+ * @brief One datagram slot for udp_socket::receive_batch().
+ *
+ * The caller owns the buffer; receive_batch() fills in length and sender,
+ * and timestamp when receive timestamps are enabled on the socket.
+ */
+struct udp_receive_entry
+{
+  void* buffer         = nullptr; ///< Destination buffer
+  std::size_t capacity = 0;       ///< Size of buffer in bytes
+  std::size_t length   = 0;       ///< Bytes received (output)
+  socket_address sender;          ///< Source address (output)
+  udp_timestamp timestamp;        ///< Receive timestamps (output)
+};
+
+/**
+ * @brief One outgoing datagram for udp_socket::send_batch().
+ */
+struct udp_send_entry
+{
+  const void* buffer = nullptr; ///< Payload to send
+  std::size_t length = 0;       ///< Payload size in bytes
+  socket_address destination;   ///< Target address
+  std::chrono::nanoseconds send_time{0}; ///< Departure on the steady clock when set_transmit_time() is on (0: now)
+};
+
 /**
  * @brief UDP Socket or "Datagram Socket" implementation.
  * This class inherits from socket_base and adds UDP-specific functionality.
@@ -15,12 +59,24 @@ class udp_socket : public socket_base
 {
 public:
 
+  /**
+   * @brief Receive timestamp sources for set_receive_timestamps()
+   */
+  enum TimestampMode
+  {
+      TIMESTAMP_NONE = 0,     ///< No receive timestamps
+      TIMESTAMP_SOFTWARE = 1, ///< Kernel software timestamps
+      TIMESTAMP_HARDWARE = 2  ///< NIC hardware timestamps, plus software as fallback
+  };
+
   udp_socket();
 
   explicit udp_socket(socket_address::Family family);
   explicit udp_socket(const socket_address& address, bool reuse_address = true);
   explicit udp_socket(socket_t sockfd);
 
+  static std::pair<udp_socket, udp_socket> socket_pair();
+
   udp_socket(const udp_socket&) = delete;
   udp_socket(udp_socket&& other) noexcept;
   udp_socket& operator=(const udp_socket&) = delete;
@@ -31,8 +87,12 @@ public:
 
   int send_to(const void* buffer, int length, const socket_address& address, int flags = 0);
   int receive_from(void* buffer, int length, socket_address& address, int flags = 0);
+  int receive_from(void* buffer, int length, socket_address& address,
+                   udp_timestamp& timestamp, int flags = 0);
   int send_to(const std::string& message, const socket_address& address);
   int receive_from(std::string& message, int max_length, socket_address& address);
+  int receive_batch(udp_receive_entry* entries, std::size_t count, int flags = 0);
+  int send_batch(const udp_send_entry* entries, std::size_t count, int flags = 0);
 
 
   void connect(const socket_address& address);
@@ -48,6 +108,12 @@ public:
   int  get_multicast_ttl();
   void set_multicast_loopback(bool flag);
   bool get_multicast_loopback();
+  void set_receive_timestamps(TimestampMode mode);
+  TimestampMode get_receive_timestamps() const;
+  void set_busy_poll(const std::chrono::microseconds& budget);
+  std::chrono::microseconds get_busy_poll();
+  void set_transmit_time(bool flag);
+  bool get_transmit_time() const;
   void join_group(const socket_address& group_address);
   void join_group(const socket_address& group_address, const socket_address& interface_address);
   void leave_group(const socket_address& group_address);
@@ -63,7 +129,9 @@ private:
   void init_udp_socket(socket_address::Family family);
   void validate_buffer(const void* buffer, int length) const;
 
-  bool m_is_connected; ///< Whether socket is connected to a specific address
+  bool m_is_connected;            ///< Whether socket is connected to a specific address
+  TimestampMode m_timestamp_mode; ///< Receive timestamps requested on the socket
+  bool m_transmit_time;           ///< SO_TXTIME enabled (send_batch() honours send_time)
 };
 
 } // namespace fb
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace fb {
+
+/**
+ * @brief Sizing rules for the worker thread pool of udp_server and tcp_server.
+ *
+ * The pool starts with min_threads workers and grows, one worker at a time
+ * and never beyond the server's max_threads, when either trigger fires:
+ *
+ * - the queue backlog exceeds queue_depth_per_thread items per worker, or
+ * - a worker dequeues an item that waited longer than queue_wait_threshold
+ *   while more work is still queued.
+ *
+ * A worker that finds no work for idle_timeout retires, as long as more than
+ * min_threads workers remain. The defaults reproduce a grow-only pool that
+ * adds a worker whenever the backlog exceeds the worker count.
+ */
+struct worker_pool_policy
+{
+  std::size_t min_threads = 0;                      ///< Workers kept when idle (0 selects the server default)
+  std::size_t queue_depth_per_thread = 1;           ///< Backlog per worker that triggers growth
+  std::chrono::microseconds queue_wait_threshold{0}; ///< Queue wait that triggers growth (0 disables)
+  std::chrono::milliseconds idle_timeout{0};        ///< Idle time before a surplus worker retires (0 never retires)
+};
+
+} // namespace fb
@@ -0,0 +1,551 @@
+#include <fb/dns_resolver.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#endif
+
+namespace fb
+{
+
+/**
+ * @class fb::dns_resolver
+ * @brief TTL cache in front of getaddrinfo() with refresh-ahead.
+ */
+
+/**
+ * @brief Create a resolver and start its refresh thread.
+ *
+ * @param ttl How long successful lookups are served from the cache.
+ * @param negative_ttl How long failed lookups are remembered.
+ * @throws std::invalid_argument If ttl is not positive or negative_ttl is negative.
+ */
+dns_resolver::dns_resolver(const std::chrono::milliseconds &ttl,
+                           const std::chrono::milliseconds &negative_ttl) :
+  m_ttl(ttl),
+  m_negative_ttl(negative_ttl),
+  m_lookup(&dns_resolver::system_lookup),
+  m_stop(false),
+  m_hits(0),
+  m_misses(0),
+  m_refreshes(0)
+{
+  if (ttl.count() <= 0)
+  {
+    throw std::invalid_argument("DNS cache TTL must be positive");
+  }
+  if (negative_ttl.count() < 0)
+  {
+    throw std::invalid_argument("Negative DNS cache TTL cannot be negative");
+  }
+  m_thread = std::thread(&dns_resolver::refresh_thread_proc, this);
+}
+
+/**
+ * @brief Stop the refresh thread.
+ *
+ * Futures of lookups still pending report std::future_errc::broken_promise.
+ */
+dns_resolver::~dns_resolver()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wakeup.notify_all();
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+}
+
+/**
+ * @brief Process-wide resolver with the default TTLs.
+ */
+dns_resolver &dns_resolver::shared()
+{
+  static dns_resolver resolver;
+  return resolver;
+}
+
+/**
+ * @brief Resolve a host name to its first address.
+ *
+ * @param host Host name or numeric address.
+ * @param port Port to put into the result.
+ * @param family Address family to look up.
+ * @return Resolved address.
+ * @throws std::runtime_error If the lookup fails (or failed within the
+ *         negative TTL).
+ */
+socket_address dns_resolver::resolve(std::string_view host, std::uint16_t port,
+                                     Family family)
+{
+  return resolve_all(host, port, family).front();
+}
+
+/**
+ * @brief Resolve a host name to all of its addresses.
+ *
+ * Served from the cache when possible; otherwise the lookup runs on the
+ * calling thread and its result is cached.
+ *
+ * @param host Host name or numeric address.
+ * @param port Port to put into each result.
+ * @param family Address family to look up.
+ * @return At least one address, in the order returned by the lookup.
+ * @throws std::runtime_error If the lookup fails.
+ */
+std::vector<socket_address> dns_resolver::resolve_all(std::string_view host,
+                                                      std::uint16_t port,
+                                                      Family family)
+{
+  const key k(std::string(host), static_cast<int>(family));
+
+  std::vector<socket_address> addresses;
+  if (!find_cached(k, addresses))
+  {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    lookup_function lookup;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      lookup = m_lookup;
+    }
+
+    std::string error;
+    try
+    {
+      addresses = lookup(k.first, family);
+      if (addresses.empty())
+      {
+        error = "No addresses found for host: " + k.first;
+      }
+    }
+    catch (const std::exception &ex)
+    {
+      error = ex.what();
+    }
+    store(k, addresses, error, false);
+
+    if (!error.empty())
+    {
+      throw std::runtime_error(error);
+    }
+  }
+  return with_port(addresses, port);
+}
+
+/**
+ * @brief Resolve without blocking the caller.
+ *
+ * Cache hits complete immediately; misses are resolved on the refresh
+ * thread. Concurrent requests for the same name share one lookup.
+ *
+ * @param host Host name or numeric address.
+ * @param port Port to put into the result.
+ * @param family Address family to look up.
+ * @return Future holding the first address, or std::runtime_error.
+ */
+std::future<socket_address> dns_resolver::resolve_async(std::string_view host,
+                                                        std::uint16_t port,
+                                                        Family family)
+{
+  key k(std::string(host), static_cast<int>(family));
+
+  std::promise<socket_address> promise;
+  std::future<socket_address> result = promise.get_future();
+  try
+  {
+    std::vector<socket_address> addresses;
+    if (find_cached(k, addresses))
+    {
+      promise.set_value(with_port(addresses, port).front());
+      return result;
+    }
+  }
+  catch (const std::exception &)
+  {
+    promise.set_exception(std::current_exception());
+    return result;
+  }
+
+  m_misses.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_async[std::move(k)].push_back(async_request{port, std::move(promise)});
+  }
+  m_wakeup.notify_one();
+  return result;
+}
+
+/**
+ * @brief Warm the cache for a host name in the background.
+ *
+ * @param host Host name to resolve.
+ * @param family Address family to look up.
+ */
+void dns_resolver::prefetch(std::string_view host, Family family)
+{
+  static_cast<void>(resolve_async(host, 0, family));
+}
+
+/**
+ * @brief Drop cached results for @p host (all families).
+ *
+ * Call after connecting to a cached address failed, so the next resolve
+ * performs a fresh lookup.
+ */
+void dns_resolver::invalidate(std::string_view host)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto it = m_cache.begin(); it != m_cache.end();)
+  {
+    if (it->first.first == host)
+    {
+      it = m_cache.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+/**
+ * @brief Drop every cached result.
+ */
+void dns_resolver::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_cache.clear();
+}
+
+/**
+ * @brief Replace the function that performs lookups.
+ *
+ * Defaults to system_lookup(). Mainly useful for tests and for plugging in
+ * a different name service.
+ *
+ * @param lookup Lookup function; nullptr restores system_lookup().
+ */
+void dns_resolver::set_lookup(lookup_function lookup)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lookup = lookup ? std::move(lookup) : lookup_function(&dns_resolver::system_lookup);
+}
+
+/**
+ * @brief Resolve @p host with getaddrinfo().
+ *
+ * @param host Host name or numeric address.
+ * @param family Address family to look up.
+ * @return Distinct addresses with port 0.
+ * @throws std::runtime_error If the lookup fails.
+ */
+std::vector<socket_address> dns_resolver::system_lookup(const std::string &host,
+                                                        Family family)
+{
+  struct addrinfo hints = {};
+  hints.ai_family       = static_cast<int>(family);
+  hints.ai_socktype     = SOCK_STREAM;
+
+  struct addrinfo *result = nullptr;
+  const int error = getaddrinfo(host.c_str(), nullptr, &hints, &result);
+  if (error != 0)
+  {
+#if defined(_WIN32)
+    const char *error_text = gai_strerrorA(error);
+#else
+    const char *error_text = gai_strerror(error);
+#endif
+    std::string message = "Failed to resolve hostname: " + host;
+    if (error_text != nullptr)
+    {
+      message.append(" (").append(error_text).append(")");
+    }
+    throw std::runtime_error(message);
+  }
+
+  std::vector<socket_address> addresses;
+  for (const struct addrinfo *ai = result; ai != nullptr; ai = ai->ai_next)
+  {
+    try
+    {
+      socket_address address(ai->ai_addr, static_cast<socklen_t>(ai->ai_addrlen));
+      if (std::find(addresses.begin(), addresses.end(), address) == addresses.end())
+      {
+        addresses.push_back(address);
+      }
+    }
+    catch (const std::invalid_argument &)
+    {
+      // Skip families socket_address cannot represent
+    }
+  }
+  freeaddrinfo(result);
+  return addresses;
+}
+
+/**
+ * @brief Number of host names currently cached (including failures).
+ */
+std::size_t dns_resolver::cached_hosts() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_cache.size();
+}
+
+/**
+ * @brief Lookups answered from the cache.
+ */
+std::uint64_t dns_resolver::cache_hits() const
+{
+  return m_hits.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Lookups that had to wait for a name resolution.
+ */
+std::uint64_t dns_resolver::cache_misses() const
+{
+  return m_misses.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Background refreshes performed.
+ */
+std::uint64_t dns_resolver::refreshes() const
+{
+  return m_refreshes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Look up a fresh cache entry.
+ *
+ * @param k Cache key.
+ * @param addresses Receives the cached addresses on a positive hit.
+ * @return True on a positive hit, false on a miss.
+ * @throws std::runtime_error On a negative hit.
+ */
+bool dns_resolver::find_cached(const key &k, std::vector<socket_address> &addresses)
+{
+  bool wake = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cache.find(k);
+    if (it == m_cache.end() || it->second.expires <= clock::now())
+    {
+      return false;
+    }
+
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    entry &cached = it->second;
+    if (!cached.error.empty())
+    {
+      throw std::runtime_error(cached.error);
+    }
+
+    // The first hit after a lookup makes the entry eligible for refresh
+    wake        = !cached.used;
+    cached.used = true;
+    addresses   = cached.addresses;
+  }
+  if (wake)
+  {
+    m_wakeup.notify_one();
+  }
+  return true;
+}
+
+/**
+ * @brief Record the outcome of a lookup.
+ *
+ * A failed background refresh keeps serving the previous addresses until
+ * they expire instead of replacing them with a negative entry.
+ *
+ * @param k Cache key.
+ * @param addresses Result of a successful lookup.
+ * @param error Failure message, empty on success.
+ * @param refresh True if this was a background refresh.
+ */
+void dns_resolver::store(const key &k, const std::vector<socket_address> &addresses,
+                         const std::string &error, bool refresh)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto now = clock::now();
+    entry &cached  = m_cache[k];
+    cached.refreshing = false;
+
+    if (!error.empty() && refresh && !cached.addresses.empty())
+    {
+      cached.refresh_at = cached.expires; // Retry on the next miss instead
+      return;
+    }
+
+    cached.used = false;
+    if (error.empty())
+    {
+      cached.addresses  = addresses;
+      cached.error.clear();
+      cached.expires    = now + m_ttl;
+      cached.refresh_at = now + m_ttl - m_ttl / 5;
+    }
+    else
+    {
+      cached.addresses.clear();
+      cached.error      = error;
+      cached.expires    = now + m_negative_ttl;
+      cached.refresh_at = cached.expires;
+    }
+  }
+  m_wakeup.notify_one();
+}
+
+/**
+ * @brief Refresh thread: resolve async requests, refresh hot entries ahead
+ * of expiry and evict entries nobody used.
+ */
+void dns_resolver::refresh_thread_proc()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop)
+  {
+    if (m_async.empty())
+    {
+      auto wake = clock::time_point::max();
+      for (const auto &item : m_cache)
+      {
+        const entry &cached = item.second;
+        if (!cached.refreshing)
+        {
+          wake = std::min(wake, cached.used ? cached.refresh_at : cached.expires);
+        }
+      }
+      if (wake == clock::time_point::max())
+      {
+        m_wakeup.wait(lock);
+      }
+      else
+      {
+        m_wakeup.wait_until(lock, wake);
+      }
+      if (m_stop)
+      {
+        break;
+      }
+    }
+
+    const auto now = clock::now();
+    std::vector<key> due;
+    for (auto it = m_cache.begin(); it != m_cache.end();)
+    {
+      entry &cached = it->second;
+      if (!cached.refreshing && cached.used && cached.error.empty() &&
+          cached.refresh_at <= now && now < cached.expires)
+      {
+        cached.refreshing = true;
+        due.push_back(it->first);
+        ++it;
+      }
+      else if (!cached.refreshing && cached.expires <= now)
+      {
+        it = m_cache.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    std::map<key, std::vector<async_request>> requests;
+    requests.swap(m_async);
+    const lookup_function lookup = m_lookup;
+    lock.unlock();
+
+    const auto run_lookup = [&lookup](const key &k, std::vector<socket_address> &addresses,
+                                      std::string &error)
+    {
+      try
+      {
+        addresses = lookup(k.first, static_cast<Family>(k.second));
+        if (addresses.empty())
+        {
+          error = "No addresses found for host: " + k.first;
+        }
+      }
+      catch (const std::exception &ex)
+      {
+        error = ex.what();
+      }
+    };
+
+    for (const key &k : due)
+    {
+      std::vector<socket_address> addresses;
+      std::string error;
+      run_lookup(k, addresses, error);
+      store(k, addresses, error, true);
+      m_refreshes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    for (auto &item : requests)
+    {
+      std::vector<socket_address> addresses;
+      std::string error;
+      run_lookup(item.first, addresses, error);
+      store(item.first, addresses, error, false);
+
+      for (auto &request : item.second)
+      {
+        if (error.empty())
+        {
+          request.promise.set_value(with_port(addresses, request.port).front());
+        }
+        else
+        {
+          request.promise.set_exception(
+              std::make_exception_ptr(std::runtime_error(error)));
+        }
+      }
+    }
+
+    lock.lock();
+  }
+}
+
+/**
+ * @brief Copy cached addresses, setting the requested port.
+ */
+std::vector<socket_address> dns_resolver::with_port(
+    const std::vector<socket_address> &addresses, std::uint16_t port)
+{
+  std::vector<socket_address> result;
+  result.reserve(addresses.size());
+  for (const auto &address : addresses)
+  {
+    struct sockaddr_storage storage = {};
+    std::memcpy(&storage, address.addr(), address.length());
+    if (storage.ss_family == AF_INET)
+    {
+      reinterpret_cast<struct sockaddr_in *>(&storage)->sin_port = htons(port);
+    }
+#ifdef AF_INET6
+    else if (storage.ss_family == AF_INET6)
+    {
+      reinterpret_cast<struct sockaddr_in6 *>(&storage)->sin6_port = htons(port);
+    }
+#endif
+    result.emplace_back(reinterpret_cast<const struct sockaddr *>(&storage),
+                        address.length());
+  }
+  return result;
+}
+
+} // namespace fb
@@ -0,0 +1,344 @@
+#include <fb/framed_connection.h>
+#include <fb/detail/socket_error_utils.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+constexpr std::size_t MAX_IO_CHUNK =
+    static_cast<std::size_t>(std::numeric_limits<int>::max());
+
+void encode_length(std::size_t length, unsigned char *header)
+{
+  header[0] = static_cast<unsigned char>((length >> 24) & 0xFF);
+  header[1] = static_cast<unsigned char>((length >> 16) & 0xFF);
+  header[2] = static_cast<unsigned char>((length >> 8) & 0xFF);
+  header[3] = static_cast<unsigned char>(length & 0xFF);
+}
+
+std::size_t decode_length(const char *data)
+{
+  const auto *header = reinterpret_cast<const unsigned char *>(data);
+  return (static_cast<std::size_t>(header[0]) << 24) |
+         (static_cast<std::size_t>(header[1]) << 16) |
+         (static_cast<std::size_t>(header[2]) << 8) |
+         static_cast<std::size_t>(header[3]);
+}
+
+} // namespace
+
+/**
+ * @class fb::framed_connection
+ * @brief Length-prefixed framing with batched receives and zero-copy frames.
+ */
+
+/**
+ * @brief Wrap a connected client.
+ *
+ * @param client Connected socket; must outlive this object.
+ * @param buffer_size Initial receive buffer size, rounded up to whole pages.
+ * @param max_frame_size Largest payload accepted or sent.
+ * @throws std::invalid_argument If buffer_size is smaller than HEADER_SIZE or
+ *         max_frame_size is zero or cannot be sent in one call.
+ */
+framed_connection::framed_connection(tcp_client &client,
+                                     std::size_t buffer_size,
+                                     std::size_t max_frame_size) :
+  m_client(client),
+  m_max_frame_size(max_frame_size),
+  m_input(buffer_size),
+  m_eof(false),
+  m_receive_calls(0),
+  m_frames_received(0)
+{
+  if (buffer_size < HEADER_SIZE)
+  {
+    throw std::invalid_argument("Buffer size must hold a frame header");
+  }
+  if (max_frame_size == 0 || max_frame_size > MAX_IO_CHUNK - HEADER_SIZE)
+  {
+    throw std::invalid_argument("Invalid maximum frame size");
+  }
+}
+
+/**
+ * @brief Get the underlying client.
+ */
+tcp_client &framed_connection::client() { return m_client; }
+
+/**
+ * @brief Read once from the socket into the receive buffer.
+ *
+ * Unconsumed bytes stay in place: the ring's free space always follows
+ * them contiguously. The buffer is grown if the pending frame does not fit,
+ * so a single receive_bytes() call can fill all remaining space.
+ * Invalidates previously returned frames.
+ *
+ * @return Bytes received; 0 at end of stream (see eof()) or when a complete
+ *         frame is already buffered and the buffer is full.
+ * @throws std::system_error On socket errors or timeouts, or with
+ *         std::errc::message_size if the pending frame exceeds max_frame_size().
+ */
+std::size_t framed_connection::receive()
+{
+  const std::size_t needed = pending_frame_size();
+  if (needed > m_input.capacity())
+  {
+    m_input.reserve(needed);
+  }
+
+  const std::size_t space = m_input.free_space();
+  if (space == 0)
+  {
+    return 0;
+  }
+
+  ++m_receive_calls;
+  const int received = m_client.receive_bytes(
+      m_input.write_data(), static_cast<int>(std::min(space, MAX_IO_CHUNK)));
+  if (received <= 0)
+  {
+    m_eof = true;
+    return 0;
+  }
+
+  m_input.commit_back(static_cast<std::size_t>(received));
+  return static_cast<std::size_t>(received);
+}
+
+/**
+ * @brief Take the next complete frame from the receive buffer, without I/O.
+ *
+ * @param frame Set to the payload on success; valid until the next receive.
+ * @return True if a complete frame was buffered.
+ * @throws std::system_error With std::errc::message_size if the frame header
+ *         announces more than max_frame_size() bytes.
+ */
+bool framed_connection::next_frame(std::string_view &frame)
+{
+  const std::size_t buffered = m_input.size();
+  if (buffered < HEADER_SIZE)
+  {
+    return false;
+  }
+
+  const std::size_t total = pending_frame_size();
+  if (buffered < total)
+  {
+    return false;
+  }
+
+  frame = std::string_view(m_input.data() + HEADER_SIZE, total - HEADER_SIZE);
+  m_input.pop_front_n(total);
+  ++m_frames_received;
+  return true;
+}
+
+/**
+ * @brief Deliver every buffered frame, receiving once if none is complete.
+ *
+ * The handler must not receive on this connection; it may send.
+ *
+ * @param handler Called once per frame with a view into the receive buffer.
+ * @return Number of frames delivered (0 if the receive completed no frame or
+ *         the stream ended; see eof()).
+ * @throws std::system_error On socket errors, timeouts or oversized frames.
+ */
+std::size_t framed_connection::receive_frames(const frame_handler &handler)
+{
+  std::string_view frame;
+  if (!next_frame(frame) && (receive() == 0 || !next_frame(frame)))
+  {
+    return 0;
+  }
+
+  std::size_t delivered = 0;
+  do
+  {
+    handler(frame);
+    ++delivered;
+  } while (next_frame(frame));
+  return delivered;
+}
+
+/**
+ * @brief Block until one complete frame is available.
+ *
+ * @param frame Set to the payload on success; valid until the next receive.
+ * @return True on success, false if the peer closed the connection between
+ *         frames.
+ * @throws std::system_error On socket errors or timeouts, with
+ *         std::errc::message_size for oversized frames, or with
+ *         std::errc::connection_aborted if the peer closed inside a frame.
+ */
+bool framed_connection::read_frame(std::string_view &frame)
+{
+  while (!next_frame(frame))
+  {
+    if (receive() == 0)
+    {
+      if (m_eof && m_input.empty())
+      {
+        return false;
+      }
+      detail::throw_system_error(std::errc::connection_aborted,
+                                 "Connection closed inside a frame");
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief True once a receive has seen the peer close the connection.
+ */
+bool framed_connection::eof() const { return m_eof; }
+
+/**
+ * @brief Send one frame immediately.
+ *
+ * Header and payload go out in a single gathered send. Frames queued with
+ * queue_frame() are sent first.
+ *
+ * @param payload Frame payload.
+ * @throws std::invalid_argument If the payload exceeds max_frame_size().
+ * @throws std::system_error If the frame cannot be sent completely.
+ */
+void framed_connection::send_frame(std::string_view payload)
+{
+  if (!m_output.empty())
+  {
+    queue_frame(payload);
+    flush();
+    return;
+  }
+
+  check_payload_size(payload.size());
+  unsigned char header[HEADER_SIZE];
+  encode_length(payload.size(), header);
+
+  const tcp_send_buffer segments[] = {{header, HEADER_SIZE},
+                                      {payload.data(), payload.size()}};
+  const std::size_t count = payload.empty() ? 1 : 2;
+  const int sent = m_client.send_vectored_all(segments, count);
+  if (sent < 0 || static_cast<std::size_t>(sent) != HEADER_SIZE + payload.size())
+  {
+    detail::throw_system_error(std::errc::io_error, "Incomplete frame send");
+  }
+}
+
+/**
+ * @brief Append a frame to the output buffer without sending it.
+ *
+ * @param payload Frame payload.
+ * @throws std::invalid_argument If the payload exceeds max_frame_size().
+ */
+void framed_connection::queue_frame(std::string_view payload)
+{
+  check_payload_size(payload.size());
+  unsigned char header[HEADER_SIZE];
+  encode_length(payload.size(), header);
+
+  m_output.insert(m_output.end(), header, header + HEADER_SIZE);
+  m_output.insert(m_output.end(), payload.begin(), payload.end());
+}
+
+/**
+ * @brief Send all queued frames.
+ *
+ * @throws std::system_error If the data cannot be sent completely; the
+ *         output buffer is discarded in that case.
+ */
+void framed_connection::flush()
+{
+  std::vector<char> output;
+  output.swap(m_output);
+
+  std::size_t offset = 0;
+  while (offset < output.size())
+  {
+    const std::size_t chunk = std::min(output.size() - offset, MAX_IO_CHUNK);
+    const int sent = m_client.send_bytes_all(output.data() + offset,
+                                             static_cast<int>(chunk));
+    if (sent < 0 || static_cast<std::size_t>(sent) != chunk)
+    {
+      detail::throw_system_error(std::errc::io_error, "Incomplete frame send");
+    }
+    offset += chunk;
+  }
+
+  // Keep the allocation for the next batch
+  output.clear();
+  m_output.swap(output);
+}
+
+/**
+ * @brief Bytes waiting in the output buffer.
+ */
+std::size_t framed_connection::queued_bytes() const { return m_output.size(); }
+
+/**
+ * @brief Received bytes not yet handed out as frames.
+ */
+std::size_t framed_connection::buffered_bytes() const { return m_input.size(); }
+
+/**
+ * @brief Current receive buffer size.
+ */
+std::size_t framed_connection::buffer_capacity() const { return m_input.capacity(); }
+
+/**
+ * @brief Largest payload accepted or sent.
+ */
+std::size_t framed_connection::max_frame_size() const { return m_max_frame_size; }
+
+/**
+ * @brief Number of receive_bytes() calls made so far.
+ *
+ * Divided by frames_received() this gives the system calls per frame.
+ */
+std::uint64_t framed_connection::receive_calls() const { return m_receive_calls; }
+
+/**
+ * @brief Number of frames handed out so far.
+ */
+std::uint64_t framed_connection::frames_received() const { return m_frames_received; }
+
+/**
+ * @brief Reject payloads larger than the frame limit.
+ */
+void framed_connection::check_payload_size(std::size_t size) const
+{
+  if (size > m_max_frame_size)
+  {
+    throw std::invalid_argument("Frame exceeds maximum frame size");
+  }
+}
+
+/**
+ * @brief Bytes (header included) needed to complete the oldest buffered frame.
+ *
+ * @return HEADER_SIZE while the header itself is incomplete.
+ * @throws std::system_error With std::errc::message_size for oversized frames.
+ */
+std::size_t framed_connection::pending_frame_size() const
+{
+  if (m_input.size() < HEADER_SIZE)
+  {
+    return HEADER_SIZE;
+  }
+
+  const std::size_t length = decode_length(m_input.data());
+  if (length > m_max_frame_size)
+  {
+    detail::throw_system_error(std::errc::message_size,
+                               "Frame exceeds maximum frame size");
+  }
+  return HEADER_SIZE + length;
+}
+
+} // namespace fb
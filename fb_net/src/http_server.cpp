@@ -0,0 +1,1055 @@
+#include <fb/http_server.h>
+#include <fb/tcp_reactor_connection.h>
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+
+constexpr std::string_view CONTINUE_RESPONSE = "HTTP/1.1 100 Continue\r\n\r\n";
+
+/// Pre-built status lines of the codes handlers commonly use
+struct status_entry
+{
+  int code;
+  std::string_view line;
+};
+
+constexpr status_entry STATUS_LINES[] = {
+    {200, "HTTP/1.1 200 OK\r\n"},
+    {201, "HTTP/1.1 201 Created\r\n"},
+    {202, "HTTP/1.1 202 Accepted\r\n"},
+    {204, "HTTP/1.1 204 No Content\r\n"},
+    {301, "HTTP/1.1 301 Moved Permanently\r\n"},
+    {302, "HTTP/1.1 302 Found\r\n"},
+    {304, "HTTP/1.1 304 Not Modified\r\n"},
+    {400, "HTTP/1.1 400 Bad Request\r\n"},
+    {401, "HTTP/1.1 401 Unauthorized\r\n"},
+    {403, "HTTP/1.1 403 Forbidden\r\n"},
+    {404, "HTTP/1.1 404 Not Found\r\n"},
+    {405, "HTTP/1.1 405 Method Not Allowed\r\n"},
+    {408, "HTTP/1.1 408 Request Timeout\r\n"},
+    {413, "HTTP/1.1 413 Content Too Large\r\n"},
+    {429, "HTTP/1.1 429 Too Many Requests\r\n"},
+    {431, "HTTP/1.1 431 Request Header Fields Too Large\r\n"},
+    {500, "HTTP/1.1 500 Internal Server Error\r\n"},
+    {501, "HTTP/1.1 501 Not Implemented\r\n"},
+    {503, "HTTP/1.1 503 Service Unavailable\r\n"},
+    {505, "HTTP/1.1 505 HTTP Version Not Supported\r\n"},
+};
+
+/**
+ * @brief Pre-built status line for a code, or an empty view if there is none.
+ */
+std::string_view status_line(int code)
+{
+  for (const auto &entry : STATUS_LINES)
+  {
+    if (entry.code == code)
+    {
+      return entry.line;
+    }
+  }
+  return {};
+}
+
+char lower(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool iequals(std::string_view a, std::string_view b)
+{
+  if (a.size() != b.size())
+  {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    if (lower(a[i]) != lower(b[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string_view trim(std::string_view text)
+{
+  while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+  {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+  {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+/**
+ * @brief Check a comma-separated header value for a token, ignoring case.
+ */
+bool has_token(std::string_view list, std::string_view token)
+{
+  while (!list.empty())
+  {
+    const std::size_t comma = list.find(',');
+    if (iequals(trim(list.substr(0, comma)), token))
+    {
+      return true;
+    }
+    if (comma == std::string_view::npos)
+    {
+      break;
+    }
+    list.remove_prefix(comma + 1);
+  }
+  return false;
+}
+
+void append_number(std::string &out, std::size_t value)
+{
+  char digits[24];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  out.append(digits, static_cast<std::size_t>(result.ptr - digits));
+}
+
+/**
+ * @brief "Date: ...\r\n" for the current second, rebuilt at most once a
+ * second per thread.
+ *
+ * Formatted by hand rather than with strftime() so the global locale
+ * cannot change the day and month names.
+ */
+std::string_view date_line()
+{
+  static constexpr const char *DAYS[]   = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+  static constexpr const char *MONTHS[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                           "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  thread_local std::time_t cached = -1;
+  thread_local char line[48];
+  thread_local std::size_t length = 0;
+
+  const std::time_t now = std::time(nullptr);
+  if (now != cached)
+  {
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    const int written = std::snprintf(
+        line, sizeof(line), "Date: %s, %02d %s %04d %02d:%02d:%02d GMT\r\n",
+        DAYS[utc.tm_wday % 7], utc.tm_mday, MONTHS[utc.tm_mon % 12],
+        utc.tm_year + 1900, utc.tm_hour, utc.tm_min, utc.tm_sec);
+    length = written > 0 ? static_cast<std::size_t>(written) : 0;
+    cached = now;
+  }
+  return {line, length};
+}
+
+} // namespace
+
+namespace fb
+{
+
+/**
+ * @brief Look up a header by name, ignoring case.
+ *
+ * @param name Field name.
+ * @return Value of the first matching header, or an empty view.
+ */
+std::string_view http_request::header(std::string_view name) const
+{
+  for (const auto &field : headers)
+  {
+    if (iequals(field.name, name))
+    {
+      return field.value;
+    }
+  }
+  return {};
+}
+
+/**
+ * @brief Create a "200 OK" response with an empty body.
+ */
+http_response::http_response() :
+  m_status(200),
+  m_keep_alive(true)
+{
+}
+
+/**
+ * @brief Set the status code.
+ *
+ * @param code Status code (100-999).
+ * @param reason Reason phrase; empty uses the standard phrase of common
+ * codes.
+ * @throws std::invalid_argument If code is out of range or reason contains
+ * CR or LF.
+ */
+void http_response::set_status(int code, std::string_view reason)
+{
+  if (code < 100 || code > 999)
+  {
+    throw std::invalid_argument("HTTP status code out of range");
+  }
+  if (reason.find_first_of("\r\n") != std::string_view::npos)
+  {
+    throw std::invalid_argument("HTTP reason phrase cannot contain line breaks");
+  }
+  m_status = code;
+  m_reason.assign(reason);
+}
+
+/**
+ * @brief Status code.
+ */
+int http_response::status() const { return m_status; }
+
+/**
+ * @brief Set the Content-Type header; empty omits it.
+ * @throws std::invalid_argument If type contains CR or LF.
+ */
+void http_response::set_content_type(std::string_view type)
+{
+  if (type.find_first_of("\r\n") != std::string_view::npos)
+  {
+    throw std::invalid_argument("HTTP header value cannot contain line breaks");
+  }
+  m_content_type.assign(type);
+}
+
+/**
+ * @brief Add a header line.
+ *
+ * Server, Date, Content-Length and Connection are written by the server and
+ * must not be added here.
+ *
+ * @throws std::invalid_argument If name is empty or contains ':' or
+ * whitespace, or either part contains CR or LF.
+ */
+void http_response::add_header(std::string_view name, std::string_view value)
+{
+  if (name.empty() || name.find_first_of(": \t\r\n") != std::string_view::npos ||
+      value.find_first_of("\r\n") != std::string_view::npos)
+  {
+    throw std::invalid_argument("Invalid HTTP header");
+  }
+  m_headers.append(name);
+  m_headers.append(": ");
+  m_headers.append(value);
+  m_headers.append("\r\n");
+}
+
+/**
+ * @brief Replace the body.
+ */
+void http_response::set_body(std::string_view body) { m_body.assign(body); }
+
+/**
+ * @brief Append to the body.
+ */
+void http_response::append_body(std::string_view data) { m_body.append(data); }
+
+/**
+ * @brief Body, for building it in place.
+ */
+std::string &http_response::body() { return m_body; }
+
+/**
+ * @brief Choose whether the connection stays open after this response.
+ *
+ * Keep-alive also requires the client to allow it.
+ */
+void http_response::set_keep_alive(bool keep_alive) { m_keep_alive = keep_alive; }
+
+/**
+ * @brief Check whether the response allows keep-alive.
+ */
+bool http_response::keep_alive() const { return m_keep_alive; }
+
+/**
+ * @brief Return to "200 OK" with no headers or body, keeping capacity.
+ */
+void http_response::reset()
+{
+  m_status = 200;
+  m_reason.clear();
+  m_content_type.clear();
+  m_headers.clear();
+  m_body.clear();
+  m_keep_alive = true;
+}
+
+/**
+ * @brief Reactor connection that parses pipelined requests in place.
+ *
+ * Bytes accumulate in m_input between m_begin and m_end. Every complete
+ * request in that range is answered in order, and the responses of one
+ * read go out with a single send_buffered().
+ */
+class http_server::connection : public tcp_reactor_connection
+{
+public:
+
+  connection(http_server &owner, tcp_client socket, const socket_address &address) :
+    tcp_reactor_connection(std::move(socket), address),
+    m_owner(owner),
+    m_input(std::min(DEFAULT_READ_SIZE, owner.m_max_header_size + owner.m_max_body_size)),
+    m_begin(0),
+    m_end(0),
+    m_scanned(0),
+    m_head_length(0),
+    m_closing(false),
+    m_continue_sent(false)
+  {
+  }
+
+  void on_open() override
+  {
+    // Responses are single writes; never wait for the previous one's ACK
+    if (client_address().family() != socket_address::UNIX_LOCAL)
+    {
+      socket().set_no_delay(true);
+    }
+  }
+
+  void on_readable() override;
+  void on_writable() override;
+
+private:
+
+  enum class parse_result
+  {
+    complete,
+    incomplete,
+    rejected
+  };
+
+  bool make_room();
+  void process();
+  parse_result parse(std::size_t &consumed, int &error);
+  int parse_head(const char *data, std::size_t length, std::size_t &body_length,
+                 bool &expect_continue);
+  void flush();
+
+  http_server &m_owner;
+  std::vector<char> m_input; ///< Receive buffer
+  std::size_t m_begin;       ///< First byte of the current request
+  std::size_t m_end;         ///< One past the last received byte
+  std::size_t m_scanned;     ///< Bytes of the current request searched for the blank line
+  std::size_t m_head_length; ///< Size of the current request's head once found (0 until then)
+  bool m_closing;            ///< Close once the queued output has drained
+  bool m_continue_sent;      ///< "100 Continue" sent for the current request
+  http_request m_request;    ///< Reused between requests
+  http_response m_response;  ///< Reused between requests
+  std::string m_output;      ///< Responses of the current read
+};
+
+/**
+ * @brief Read what is available and answer every complete request.
+ */
+void http_server::connection::on_readable()
+{
+  if (!make_room())
+  {
+    // Cannot happen: parse() rejects requests larger than the limits
+    close();
+    return;
+  }
+
+  int received = 0;
+  try
+  {
+    received = socket().receive_bytes(
+        m_input.data() + m_end,
+        static_cast<int>(std::min<std::size_t>(m_input.size() - m_end, INT_MAX)));
+  }
+  catch (const std::system_error &ex)
+  {
+    if (ex.code() == std::errc::resource_unavailable_try_again ||
+        ex.code() == std::errc::operation_would_block)
+    {
+      return;
+    }
+    throw;
+  }
+  if (received <= 0)
+  {
+    close();
+    return;
+  }
+  if (m_closing)
+  {
+    // Answered for the last time; discard anything sent after that request
+    return;
+  }
+
+  m_end += static_cast<std::size_t>(received);
+  process();
+}
+
+/**
+ * @brief Close once a final response has been flushed.
+ */
+void http_server::connection::on_writable()
+{
+  if (m_closing && buffered_output() == 0)
+  {
+    close();
+  }
+}
+
+/**
+ * @brief Ensure free space after m_end, compacting or growing the buffer.
+ *
+ * @return False if the buffer is full at its largest size.
+ */
+bool http_server::connection::make_room()
+{
+  if (m_end < m_input.size())
+  {
+    return true;
+  }
+  if (m_begin > 0)
+  {
+    std::memmove(m_input.data(), m_input.data() + m_begin, m_end - m_begin);
+    m_end -= m_begin;
+    m_begin = 0;
+    return true;
+  }
+  const std::size_t limit = m_owner.m_max_header_size + m_owner.m_max_body_size;
+  if (m_input.size() >= limit)
+  {
+    return false;
+  }
+  m_input.resize(std::min(limit, m_input.size() * 2));
+  return true;
+}
+
+/**
+ * @brief Answer the complete requests in the buffer, then send the replies.
+ */
+void http_server::connection::process()
+{
+  while (!m_closing)
+  {
+    std::size_t consumed = 0;
+    int error            = 0;
+    const parse_result result = parse(consumed, error);
+    if (result == parse_result::incomplete)
+    {
+      break;
+    }
+    if (result == parse_result::rejected)
+    {
+      m_owner.m_stats.add(REJECTED_REQUESTS);
+      m_owner.append_error(m_output, error);
+      m_closing = true;
+      break;
+    }
+
+    m_owner.m_stats.add(REQUESTS);
+    m_response.reset();
+    try
+    {
+      m_owner.m_handler(m_request, m_response);
+    }
+    catch (const std::exception &ex)
+    {
+      m_owner.m_stats.add(HANDLER_ERRORS);
+      if (m_owner.onException.has_slots())
+      {
+        m_owner.onException.emit(ex, "http_handler");
+      }
+      m_response.reset();
+      m_response.set_status(500);
+    }
+    m_closing = !m_request.keep_alive || !m_response.keep_alive();
+    m_owner.append_response(m_output, &m_request, m_response);
+
+    m_begin += consumed;
+    m_scanned       = 0;
+    m_head_length   = 0;
+    m_continue_sent = false;
+  }
+
+  if (m_begin == m_end)
+  {
+    m_begin = 0;
+    m_end   = 0;
+  }
+  flush();
+}
+
+/**
+ * @brief Send the queued responses; start closing after a final one.
+ */
+void http_server::connection::flush()
+{
+  if (!m_output.empty())
+  {
+    const bool queued = send_buffered(m_output.data(), m_output.size());
+    m_output.clear();
+    if (!queued)
+    {
+      // Client pipelines faster than it reads: beyond the backpressure limits
+      close();
+      return;
+    }
+  }
+  if (m_closing)
+  {
+    if (buffered_output() == 0)
+    {
+      close();
+    }
+    else
+    {
+      set_write_interest(true);
+    }
+  }
+}
+
+/**
+ * @brief Parse the request at m_begin into m_request.
+ *
+ * @param consumed Set to the request's size, body included.
+ * @param error Set to the status code to answer with when rejected.
+ * @return Whether a complete request, more bytes, or a rejection follows.
+ */
+http_server::connection::parse_result
+http_server::connection::parse(std::size_t &consumed, int &error)
+{
+  // Empty lines between pipelined requests are skipped (RFC 9112 2.2)
+  if (m_scanned == 0 && m_head_length == 0)
+  {
+    while (m_begin < m_end && (m_input[m_begin] == '\r' || m_input[m_begin] == '\n'))
+    {
+      ++m_begin;
+    }
+  }
+
+  const char *data      = m_input.data() + m_begin;
+  const std::size_t end = m_end - m_begin;
+
+  // Find the blank line ending the head, resuming where the last read stopped
+  std::size_t head_length = m_head_length;
+  std::size_t position    = m_scanned;
+  while (head_length == 0 && position < end)
+  {
+    const void *found = std::memchr(data + position, '\n', end - position);
+    if (found == nullptr)
+    {
+      position = end;
+      break;
+    }
+    const auto newline = static_cast<std::size_t>(static_cast<const char *>(found) - data);
+    if (newline + 1 < end && data[newline + 1] == '\n')
+    {
+      head_length = newline + 2;
+      break;
+    }
+    if (newline + 2 < end && data[newline + 1] == '\r' && data[newline + 2] == '\n')
+    {
+      head_length = newline + 3;
+      break;
+    }
+    if (newline + 2 >= end)
+    {
+      // The blank line may still be arriving
+      position = newline;
+      break;
+    }
+    position = newline + 1;
+  }
+
+  if (head_length == 0)
+  {
+    m_scanned = position;
+    if (end > m_owner.m_max_header_size)
+    {
+      error = 431;
+      return parse_result::rejected;
+    }
+    return parse_result::incomplete;
+  }
+  if (head_length > m_owner.m_max_header_size)
+  {
+    error = 431;
+    return parse_result::rejected;
+  }
+  m_head_length = head_length;
+
+  std::size_t body_length = 0;
+  bool expect_continue    = false;
+  error                   = parse_head(data, head_length, body_length, expect_continue);
+  if (error != 0)
+  {
+    return parse_result::rejected;
+  }
+
+  if (end - head_length < body_length)
+  {
+    if (expect_continue && !m_continue_sent)
+    {
+      m_output.append(CONTINUE_RESPONSE);
+      m_continue_sent = true;
+    }
+    return parse_result::incomplete;
+  }
+
+  m_request.body = std::string_view(data + head_length, body_length);
+  consumed       = head_length + body_length;
+  return parse_result::complete;
+}
+
+/**
+ * @brief Parse the request line and headers into m_request.
+ *
+ * @param data Start of the request.
+ * @param length Bytes up to and including the blank line.
+ * @param body_length Set from Content-Length.
+ * @param expect_continue Set if the client waits for "100 Continue".
+ * @return 0, or the status code to reject the request with.
+ */
+int http_server::connection::parse_head(const char *data, std::size_t length,
+                                        std::size_t &body_length, bool &expect_continue)
+{
+  std::string_view head(data, length);
+  auto next_line = [&head]() {
+    const std::size_t newline = head.find('\n');
+    std::string_view line     = head.substr(0, newline);
+    head.remove_prefix(newline + 1);
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.remove_suffix(1);
+    }
+    return line;
+  };
+
+  // Request line: method SP target SP version
+  const std::string_view request_line = next_line();
+  const std::size_t first             = request_line.find(' ');
+  const std::size_t second =
+      first == std::string_view::npos ? first : request_line.find(' ', first + 1);
+  if (first == 0 || second == std::string_view::npos || second == first + 1)
+  {
+    return 400;
+  }
+  const std::string_view version = request_line.substr(second + 1);
+  if (version.size() != 8 || version.compare(0, 5, "HTTP/") != 0)
+  {
+    return 400;
+  }
+  if (version[5] != '1' || version[6] != '.' || version[7] < '0' || version[7] > '9')
+  {
+    return 505;
+  }
+
+  http_request &request = m_request;
+  request.method        = request_line.substr(0, first);
+  request.target        = request_line.substr(first + 1, second - first - 1);
+  const std::size_t mark = request.target.find('?');
+  request.path          = request.target.substr(0, mark);
+  request.query         = mark == std::string_view::npos ? std::string_view()
+                                                         : request.target.substr(mark + 1);
+  request.version_minor = version[7] == '0' ? 0 : 1;
+  request.headers.clear();
+
+  // Header fields up to the blank line
+  bool has_length = false;
+  std::string_view connection_header;
+  for (std::string_view line = next_line(); !line.empty(); line = next_line())
+  {
+    const std::size_t colon = line.find(':');
+    if (colon == 0 || colon == std::string_view::npos ||
+        line.find_first_of(" \t") < colon)
+    {
+      // Also rejects obsolete line folding
+      return 400;
+    }
+    const http_header field{line.substr(0, colon), trim(line.substr(colon + 1))};
+    request.headers.push_back(field);
+
+    if (iequals(field.name, "Content-Length"))
+    {
+      std::size_t value = 0;
+      const auto result = std::from_chars(field.value.data(),
+                                          field.value.data() + field.value.size(), value);
+      if (field.value.empty() || result.ec != std::errc() ||
+          result.ptr != field.value.data() + field.value.size() ||
+          (has_length && value != body_length))
+      {
+        return result.ec == std::errc::result_out_of_range ? 413 : 400;
+      }
+      has_length  = true;
+      body_length = value;
+    }
+    else if (iequals(field.name, "Transfer-Encoding"))
+    {
+      return 501;
+    }
+    else if (iequals(field.name, "Connection"))
+    {
+      connection_header = field.value;
+    }
+    else if (iequals(field.name, "Expect"))
+    {
+      expect_continue = iequals(field.value, "100-continue");
+    }
+  }
+
+  if (body_length > m_owner.m_max_body_size)
+  {
+    return 413;
+  }
+  request.keep_alive = request.version_minor >= 1
+                           ? !has_token(connection_header, "close")
+                           : has_token(connection_header, "keep-alive");
+  return 0;
+}
+
+/**
+ * @brief Construct an unconfigured server; set a socket and a handler
+ * before start().
+ */
+http_server::http_server() :
+  m_max_header_size(DEFAULT_MAX_HEADER_SIZE),
+  m_max_body_size(DEFAULT_MAX_BODY_SIZE),
+  m_server_name("fb_net"),
+  m_server_line("Server: fb_net\r\n")
+{
+}
+
+/**
+ * @brief Construct a server ready to start().
+ *
+ * @param server_socket Bound, listening socket.
+ * @param handler Called for every request.
+ * @param event_loops Event-loop threads (0 selects the tcp_server default).
+ */
+http_server::http_server(fb::server_socket server_socket,
+                         request_handler handler,
+                         std::size_t event_loops) :
+  http_server()
+{
+  set_server_socket(std::move(server_socket));
+  set_handler(std::move(handler), event_loops);
+}
+
+/**
+ * @brief Destructor stops the server; connections use the handler.
+ */
+http_server::~http_server()
+{
+  try
+  {
+    if (m_server.is_running())
+    {
+      m_server.stop();
+    }
+  }
+  catch (...)
+  {
+    // Ignore errors during destruction
+  }
+}
+
+/**
+ * @brief Start accepting and serving connections.
+ *
+ * @throws std::runtime_error If no handler is set or the server is running.
+ * @throws std::logic_error If the server socket is closed.
+ */
+void http_server::start()
+{
+  if (!m_handler)
+  {
+    throw std::runtime_error("HTTP request handler is not set");
+  }
+  m_server.start();
+}
+
+/**
+ * @brief Stop the server and close every connection.
+ *
+ * @param timeout Passed to tcp_server::stop().
+ */
+void http_server::stop(const std::chrono::milliseconds &timeout)
+{
+  m_server.stop(timeout);
+}
+
+/**
+ * @brief Check whether the server is running.
+ */
+bool http_server::is_running() const { return m_server.is_running(); }
+
+/**
+ * @brief Set the listening socket.
+ *
+ * @throws std::runtime_error If the server is running.
+ */
+void http_server::set_server_socket(fb::server_socket server_socket)
+{
+  m_server.set_server_socket(std::move(server_socket));
+}
+
+/**
+ * @brief Set the request handler and the number of event loops.
+ *
+ * @param handler Called on an event-loop thread for every request.
+ * @param event_loops Event-loop threads (0 selects the tcp_server default).
+ * @throws std::runtime_error If the server is running.
+ */
+void http_server::set_handler(request_handler handler, std::size_t event_loops)
+{
+  m_server.set_reactor_factory(
+      [this](tcp_client socket, const socket_address &address) {
+        return std::make_unique<connection>(*this, std::move(socket), address);
+      },
+      event_loops);
+  m_handler = std::move(handler);
+}
+
+/**
+ * @brief Limit the size of a request line plus headers; larger requests
+ * get 431.
+ *
+ * @param size Limit in bytes (0 selects DEFAULT_MAX_HEADER_SIZE).
+ * @throws std::runtime_error If the server is running.
+ */
+void http_server::set_max_header_size(std::size_t size)
+{
+  if (m_server.is_running())
+  {
+    throw std::runtime_error("Cannot set max header size while server is running");
+  }
+  m_max_header_size = size == 0 ? DEFAULT_MAX_HEADER_SIZE : size;
+}
+
+/**
+ * @brief Limit the size of a request body; larger requests get 413.
+ *
+ * @param size Limit in bytes (0 rejects every body).
+ * @throws std::runtime_error If the server is running.
+ */
+void http_server::set_max_body_size(std::size_t size)
+{
+  if (m_server.is_running())
+  {
+    throw std::runtime_error("Cannot set max body size while server is running");
+  }
+  m_max_body_size = size;
+}
+
+/**
+ * @brief Set the Server header value; empty omits the header.
+ *
+ * @throws std::invalid_argument If name contains CR or LF.
+ * @throws std::runtime_error If the server is running.
+ */
+void http_server::set_server_name(const std::string &name)
+{
+  if (m_server.is_running())
+  {
+    throw std::runtime_error("Cannot set server name while server is running");
+  }
+  if (name.find_first_of("\r\n") != std::string::npos)
+  {
+    throw std::invalid_argument("HTTP header value cannot contain line breaks");
+  }
+  m_server_name = name;
+  m_server_line = name.empty() ? std::string() : "Server: " + name + "\r\n";
+}
+
+/**
+ * @brief Largest accepted request line plus headers.
+ */
+std::size_t http_server::max_header_size() const { return m_max_header_size; }
+
+/**
+ * @brief Largest accepted request body.
+ */
+std::size_t http_server::max_body_size() const { return m_max_body_size; }
+
+/**
+ * @brief Server header value.
+ */
+const std::string &http_server::server_name() const { return m_server_name; }
+
+/**
+ * @brief Underlying tcp_server, for transport settings and statistics.
+ */
+tcp_server &http_server::server() { return m_server; }
+
+/**
+ * @brief Underlying tcp_server.
+ */
+const tcp_server &http_server::server() const { return m_server; }
+
+/**
+ * @brief Requests passed to the handler.
+ */
+std::uint64_t http_server::total_requests() const { return m_stats.value(REQUESTS); }
+
+/**
+ * @brief Requests rejected by the parser (4xx/5xx without calling the handler).
+ */
+std::uint64_t http_server::rejected_requests() const
+{
+  return m_stats.value(REJECTED_REQUESTS);
+}
+
+/**
+ * @brief Handler calls that threw and were answered with 500.
+ */
+std::uint64_t http_server::handler_errors() const { return m_stats.value(HANDLER_ERRORS); }
+
+/**
+ * @brief Publish the request counters in a metrics registry.
+ *
+ * Connection metrics come from server().register_metrics().
+ *
+ * @param registry Registry to add the metrics to.
+ * @param prefix Start of every metric name, e.g. "admin_http".
+ * @return Handle that unregisters the metrics; destroy it before the server.
+ * @throws std::invalid_argument If a name is invalid or already registered.
+ */
+metrics_registration http_server::register_metrics(metrics_registry &registry,
+                                                   const std::string &prefix) const
+{
+  metrics_registration registration = registry.add_counter(
+      prefix + "_requests_total", "Requests handled",
+      [this]() { return total_requests(); });
+  registration.append(registry.add_counter(
+      prefix + "_rejected_requests_total", "Requests rejected before reaching the handler",
+      [this]() { return rejected_requests(); }));
+  registration.append(registry.add_counter(
+      prefix + "_handler_errors_total", "Handler calls that threw",
+      [this]() { return handler_errors(); }));
+  return registration;
+}
+
+/**
+ * @brief Serialize a response behind any already in @p out.
+ *
+ * @param out Output batch of the connection.
+ * @param request Request being answered, or null for parser rejections.
+ * @param response Response to write.
+ */
+void http_server::append_response(std::string &out, const http_request *request,
+                                  http_response &response)
+{
+  const int code = response.m_status;
+  const std::string_view line = response.m_reason.empty() ? status_line(code)
+                                                          : std::string_view();
+  if (!line.empty())
+  {
+    out.append(line);
+  }
+  else
+  {
+    out.append("HTTP/1.1 ");
+    append_number(out, static_cast<std::size_t>(code));
+    out.push_back(' ');
+    out.append(response.m_reason.empty() ? "Unknown" : response.m_reason);
+    out.append("\r\n");
+  }
+  out.append(m_server_line);
+  out.append(date_line());
+
+  if (!response.m_content_type.empty())
+  {
+    out.append("Content-Type: ");
+    out.append(response.m_content_type);
+    out.append("\r\n");
+  }
+  const bool bodiless = code < 200 || code == 204 || code == 304;
+  if (!bodiless)
+  {
+    out.append("Content-Length: ");
+    append_number(out, response.m_body.size());
+    out.append("\r\n");
+  }
+
+  const bool keep_alive = request != nullptr && request->keep_alive && response.m_keep_alive;
+  if (!keep_alive)
+  {
+    out.append("Connection: close\r\n");
+  }
+  else if (request->version_minor == 0)
+  {
+    out.append("Connection: keep-alive\r\n");
+  }
+  out.append(response.m_headers);
+  out.append("\r\n");
+
+  if (!bodiless && (request == nullptr || request->method != "HEAD"))
+  {
+    out.append(response.m_body);
+  }
+}
+
+/**
+ * @brief Serialize a final error response for a rejected request.
+ */
+void http_server::append_error(std::string &out, int code)
+{
+  http_response response;
+  response.set_status(code);
+  response.set_keep_alive(false);
+  append_response(out, nullptr, response);
+}
+
+/**
+ * @brief Answer GET /metrics (Prometheus text) and GET /metrics.json.
+ *
+ * Other methods on those paths get 405.
+ *
+ * @param request Request being handled.
+ * @param response Response to fill in.
+ * @param registry Registry to export.
+ * @return false, leaving @p response untouched, for any other path.
+ */
+bool serve_metrics(const http_request &request, http_response &response,
+                   const metrics_registry &registry)
+{
+  const bool json = request.path == "/metrics.json";
+  if (!json && request.path != "/metrics")
+  {
+    return false;
+  }
+  if (request.method != "GET")
+  {
+    response.set_status(405);
+    response.add_header("Allow", "GET");
+    return true;
+  }
+
+  if (json)
+  {
+    response.set_content_type("application/json");
+    response.body() = registry.to_json();
+  }
+  else
+  {
+    response.set_content_type("text/plain; version=0.0.4");
+    response.body() = registry.to_prometheus();
+  }
+  return true;
+}
+
+} // namespace fb
@@ -0,0 +1,784 @@
+#include <fb/io_ring.h>
+#include <fb/poll_set.h>
+#include <fb/detail/socket_error_utils.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace fb
+{
+
+/**
+ * @class fb::io_ring
+ * @brief Shared submission/completion ring for batched socket I/O.
+ *
+ * Each submission occupies an operation slot until its completion is reaped,
+ * which also bounds the number of operations in flight to the size of the
+ * completion queue so the kernel never has to drop completions.
+ */
+
+#ifdef __linux__
+
+/**
+ * @brief State kept for one submitted operation until it completes.
+ *
+ * recvmsg needs its message header, vector and address storage to outlive
+ * the submission, so they live here rather than on the caller's stack.
+ */
+struct io_ring::operation
+{
+  std::uint64_t user_data  = 0;
+  bool poll                = false;
+  udp_receive_entry *entry = nullptr;
+  struct msghdr message;
+  struct iovec vector;
+  struct sockaddr_storage address;
+};
+
+namespace
+{
+
+int ring_setup(unsigned entries, io_uring_params *params)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ring_enter(int fd, unsigned to_submit)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, 0U,
+                                    0U, nullptr, 0));
+}
+
+int ring_register(int fd, unsigned opcode, const void *arg, unsigned count)
+{
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+unsigned mode_to_poll_events(int mode)
+{
+  unsigned events = 0;
+  if (mode & poll_set::POLL_READ)
+  {
+    events |= POLLIN;
+  }
+  if (mode & poll_set::POLL_WRITE)
+  {
+    events |= POLLOUT;
+  }
+  if (mode & poll_set::POLL_ERROR)
+  {
+    events |= POLLERR | POLLHUP;
+  }
+  return events;
+}
+
+int poll_events_to_mode(int events)
+{
+  int mode = 0;
+  if (events & POLLIN)
+  {
+    mode |= poll_set::POLL_READ;
+  }
+  if (events & POLLOUT)
+  {
+    mode |= poll_set::POLL_WRITE;
+  }
+  if (events & (POLLERR | POLLHUP))
+  {
+    mode |= poll_set::POLL_ERROR;
+  }
+  return mode;
+}
+
+} // namespace
+
+/**
+ * @brief Create a ring and map its submission and completion queues.
+ *
+ * @param entries Submission queue size (rounded up to a power of two by the
+ *                kernel); the completion queue is twice as large.
+ * @throws std::invalid_argument If entries is zero.
+ * @throws std::system_error If io_uring is unavailable or mapping fails.
+ */
+io_ring::io_ring(unsigned entries) :
+  m_ring_fd(-1),
+  m_entries(0),
+  m_sq_ring(MAP_FAILED),
+  m_sq_ring_size(0),
+  m_cq_ring(MAP_FAILED),
+  m_cq_ring_size(0),
+  m_sqes(MAP_FAILED),
+  m_sqes_size(0),
+  m_sq_head(nullptr),
+  m_sq_tail(nullptr),
+  m_sq_mask(0),
+  m_sq_array(nullptr),
+  m_cq_head(nullptr),
+  m_cq_tail(nullptr),
+  m_cq_mask(0),
+  m_cqes(nullptr),
+  m_pending(0)
+{
+  if (entries == 0)
+  {
+    throw std::invalid_argument("io_ring requires at least one entry");
+  }
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+
+  m_ring_fd = ring_setup(entries, &params);
+  if (m_ring_fd < 0)
+  {
+    detail::throw_system_error(errno, "Failed to create io_uring instance");
+  }
+  m_entries = params.sq_entries;
+
+  m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  m_cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap)
+  {
+    m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+  }
+
+  m_sq_ring = ::mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQ_RING);
+  if (m_sq_ring == MAP_FAILED)
+  {
+    int error = errno;
+    release();
+    detail::throw_system_error(error, "Failed to map io_uring submission ring");
+  }
+
+  if (single_mmap)
+  {
+    m_cq_ring = m_sq_ring;
+  }
+  else
+  {
+    m_cq_ring = ::mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_CQ_RING);
+    if (m_cq_ring == MAP_FAILED)
+    {
+      int error = errno;
+      release();
+      detail::throw_system_error(error,
+                                 "Failed to map io_uring completion ring");
+    }
+  }
+
+  m_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  m_sqes = ::mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQES);
+  if (m_sqes == MAP_FAILED)
+  {
+    int error = errno;
+    release();
+    detail::throw_system_error(error, "Failed to map io_uring entries");
+  }
+
+  auto *sq = static_cast<char *>(m_sq_ring);
+  auto *cq = static_cast<char *>(m_cq_ring);
+  m_sq_head  = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+  m_sq_tail  = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+  m_sq_mask  = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+  m_sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+  m_cq_head  = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+  m_cq_tail  = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+  m_cq_mask  = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+  m_cqes     = cq + params.cq_off.cqes;
+
+  m_operations.resize(params.cq_entries);
+  m_free_slots.reserve(params.cq_entries);
+  for (std::uint32_t slot = params.cq_entries; slot > 0; --slot)
+  {
+    m_free_slots.push_back(slot - 1);
+  }
+}
+
+/**
+ * @brief Unmap the queues and close the ring; in-flight operations are
+ * cancelled by the kernel.
+ */
+io_ring::~io_ring() { release(); }
+
+/**
+ * @brief Check whether the running kernel provides io_uring.
+ *
+ * @return True if a ring could be created (e.g. not blocked by seccomp).
+ */
+bool io_ring::supported()
+{
+  static const bool available = []
+  {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int fd = ring_setup(1, &params);
+    if (fd < 0)
+    {
+      return false;
+    }
+    ::close(fd);
+    return true;
+  }();
+  return available;
+}
+
+/**
+ * @brief Register caller-owned buffers for submit_*_fixed() operations.
+ *
+ * Registration pins the pages once so fixed reads and writes skip the
+ * per-operation buffer mapping.
+ *
+ * @param buffers Buffers to register; must outlive the registration.
+ * @param count Number of buffers.
+ * @throws std::invalid_argument If a buffer is null or empty.
+ * @throws std::system_error If registration fails (e.g. already registered).
+ */
+void io_ring::register_buffers(const io_buffer *buffers, std::size_t count)
+{
+  if (count == 0 || !buffers)
+  {
+    throw std::invalid_argument("At least one buffer must be registered");
+  }
+
+  std::vector<struct iovec> vectors(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (!buffers[i].data || buffers[i].length == 0)
+    {
+      throw std::invalid_argument("Registered buffer must be non-empty");
+    }
+    vectors[i].iov_base = buffers[i].data;
+    vectors[i].iov_len  = buffers[i].length;
+  }
+
+  if (ring_register(m_ring_fd, IORING_REGISTER_BUFFERS, vectors.data(),
+                    static_cast<unsigned>(count)) < 0)
+  {
+    detail::throw_system_error(errno, "Failed to register io_uring buffers");
+  }
+  m_buffers.assign(buffers, buffers + count);
+}
+
+/**
+ * @brief Drop the registered buffers.
+ *
+ * @throws std::system_error If unregistration fails.
+ */
+void io_ring::unregister_buffers()
+{
+  if (m_buffers.empty())
+  {
+    return;
+  }
+  if (ring_register(m_ring_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0) < 0)
+  {
+    detail::throw_system_error(errno, "Failed to unregister io_uring buffers");
+  }
+  m_buffers.clear();
+}
+
+/**
+ * @brief Queue a one-shot readiness poll.
+ *
+ * The completion result holds the ready poll_set mode bits; submit again to
+ * keep watching the socket.
+ *
+ * @param socket Socket to watch.
+ * @param mode poll_set::POLL_READ / POLL_WRITE / POLL_ERROR combination.
+ * @param user_data Value returned in the completion.
+ */
+void io_ring::submit_poll(const socket_base &socket, int mode,
+                          std::uint64_t user_data)
+{
+  int fd = socket_fd(socket);
+  std::uint32_t slot = 0;
+  auto *sqe = static_cast<io_uring_sqe *>(next_sqe(slot, user_data));
+
+  m_operations[slot].poll = true;
+  sqe->opcode        = IORING_OP_POLL_ADD;
+  sqe->fd            = fd;
+  sqe->poll32_events = mode_to_poll_events(mode);
+}
+
+/**
+ * @brief Queue a receive into a caller buffer.
+ *
+ * @param socket Connected socket to read from.
+ * @param buffer Destination buffer.
+ * @param length Buffer capacity.
+ * @param user_data Value returned in the completion.
+ * @param flags recv() flags.
+ * @throws std::invalid_argument If buffer is null for a non-zero length.
+ */
+void io_ring::submit_receive(const socket_base &socket, void *buffer,
+                             std::size_t length, std::uint64_t user_data,
+                             int flags)
+{
+  if (!buffer && length > 0)
+  {
+    throw std::invalid_argument("Buffer cannot be null for non-zero length");
+  }
+
+  int fd = socket_fd(socket);
+  std::uint32_t slot = 0;
+  auto *sqe = static_cast<io_uring_sqe *>(next_sqe(slot, user_data));
+
+  sqe->opcode    = IORING_OP_RECV;
+  sqe->fd        = fd;
+  sqe->addr      = reinterpret_cast<std::uint64_t>(buffer);
+  sqe->len       = static_cast<std::uint32_t>(length);
+  sqe->msg_flags = static_cast<std::uint32_t>(flags);
+}
+
+/**
+ * @brief Queue a send from a caller buffer.
+ *
+ * A completion may report fewer bytes than requested; resubmit the rest.
+ *
+ * @param socket Connected socket to write to.
+ * @param buffer Source buffer.
+ * @param length Number of bytes to send.
+ * @param user_data Value returned in the completion.
+ * @param flags send() flags (MSG_NOSIGNAL is always added).
+ * @throws std::invalid_argument If buffer is null for a non-zero length.
+ */
+void io_ring::submit_send(const socket_base &socket, const void *buffer,
+                          std::size_t length, std::uint64_t user_data,
+                          int flags)
+{
+  if (!buffer && length > 0)
+  {
+    throw std::invalid_argument("Buffer cannot be null for non-zero length");
+  }
+
+  int fd = socket_fd(socket);
+  std::uint32_t slot = 0;
+  auto *sqe = static_cast<io_uring_sqe *>(next_sqe(slot, user_data));
+
+  sqe->opcode    = IORING_OP_SEND;
+  sqe->fd        = fd;
+  sqe->addr      = reinterpret_cast<std::uint64_t>(buffer);
+  sqe->len       = static_cast<std::uint32_t>(length);
+  sqe->msg_flags = static_cast<std::uint32_t>(flags | MSG_NOSIGNAL);
+}
+
+/**
+ * @brief Queue a receive into a registered buffer.
+ *
+ * @param socket Connected socket to read from.
+ * @param buffer_index Index into the buffers passed to register_buffers().
+ * @param length Bytes to read; at most the buffer's length.
+ * @param user_data Value returned in the completion.
+ * @throws std::invalid_argument If the index or length is out of range.
+ */
+void io_ring::submit_receive_fixed(const socket_base &socket,
+                                   std::size_t buffer_index,
+                                   std::size_t length, std::uint64_t user_data)
+{
+  if (buffer_index >= m_buffers.size() ||
+      length > m_buffers[buffer_index].length)
+  {
+    throw std::invalid_argument("Fixed buffer index or length out of range");
+  }
+
+  int fd = socket_fd(socket);
+  std::uint32_t slot = 0;
+  auto *sqe = static_cast<io_uring_sqe *>(next_sqe(slot, user_data));
+
+  sqe->opcode    = IORING_OP_READ_FIXED;
+  sqe->fd        = fd;
+  sqe->addr      = reinterpret_cast<std::uint64_t>(m_buffers[buffer_index].data);
+  sqe->len       = static_cast<std::uint32_t>(length);
+  sqe->buf_index = static_cast<std::uint16_t>(buffer_index);
+}
+
+/**
+ * @brief Queue a send from a registered buffer.
+ *
+ * @param socket Connected socket to write to.
+ * @param buffer_index Index into the buffers passed to register_buffers().
+ * @param length Bytes to send from the start of the buffer.
+ * @param user_data Value returned in the completion.
+ * @throws std::invalid_argument If the index or length is out of range.
+ */
+void io_ring::submit_send_fixed(const socket_base &socket,
+                                std::size_t buffer_index, std::size_t length,
+                                std::uint64_t user_data)
+{
+  if (buffer_index >= m_buffers.size() ||
+      length > m_buffers[buffer_index].length)
+  {
+    throw std::invalid_argument("Fixed buffer index or length out of range");
+  }
+
+  int fd = socket_fd(socket);
+  std::uint32_t slot = 0;
+  auto *sqe = static_cast<io_uring_sqe *>(next_sqe(slot, user_data));
+
+  sqe->opcode    = IORING_OP_WRITE_FIXED;
+  sqe->fd        = fd;
+  sqe->addr      = reinterpret_cast<std::uint64_t>(m_buffers[buffer_index].data);
+  sqe->len       = static_cast<std::uint32_t>(length);
+  sqe->buf_index = static_cast<std::uint16_t>(buffer_index);
+}
+
+/**
+ * @brief Queue an accept on a listening socket.
+ *
+ * The completion result is the new descriptor; wrap it in a tcp_client.
+ *
+ * @param listener Listening server socket.
+ * @param user_data Value returned in the completion.
+ */
+void io_ring::submit_accept(const socket_base &listener,
+                            std::uint64_t user_data)
+{
+  int fd = socket_fd(listener);
+  std::uint32_t slot = 0;
+  auto *sqe = static_cast<io_uring_sqe *>(next_sqe(slot, user_data));
+
+  sqe->opcode       = IORING_OP_ACCEPT;
+  sqe->fd           = fd;
+  sqe->accept_flags = SOCK_CLOEXEC;
+}
+
+/**
+ * @brief Queue a datagram receive (recvmsg) that also captures the sender.
+ *
+ * On completion, entry.length and entry.sender are filled in before the
+ * completion is returned by wait().
+ *
+ * @param socket Datagram socket to read from.
+ * @param entry Destination buffer and result fields.
+ * @param user_data Value returned in the completion.
+ * @param flags recvmsg() flags.
+ * @throws std::invalid_argument If the entry has no buffer.
+ */
+void io_ring::submit_receive_from(const socket_base &socket,
+                                  udp_receive_entry &entry,
+                                  std::uint64_t user_data, int flags)
+{
+  if (!entry.buffer || entry.capacity == 0)
+  {
+    throw std::invalid_argument("Receive entry requires a non-empty buffer");
+  }
+
+  int fd = socket_fd(socket);
+  std::uint32_t slot = 0;
+  auto *sqe = static_cast<io_uring_sqe *>(next_sqe(slot, user_data));
+
+  operation &op = m_operations[slot];
+  op.entry      = &entry;
+  std::memset(&op.message, 0, sizeof(op.message));
+  op.vector.iov_base      = entry.buffer;
+  op.vector.iov_len       = entry.capacity;
+  op.message.msg_name     = &op.address;
+  op.message.msg_namelen  = sizeof(op.address);
+  op.message.msg_iov      = &op.vector;
+  op.message.msg_iovlen   = 1;
+
+  sqe->opcode    = IORING_OP_RECVMSG;
+  sqe->fd        = fd;
+  sqe->addr      = reinterpret_cast<std::uint64_t>(&op.message);
+  sqe->len       = 1;
+  sqe->msg_flags = static_cast<std::uint32_t>(flags);
+}
+
+/**
+ * @brief Hand all queued operations to the kernel with one system call.
+ *
+ * @return Number of operations submitted.
+ * @throws std::system_error On io_uring_enter failure.
+ */
+std::size_t io_ring::submit()
+{
+  std::size_t submitted = 0;
+  while (m_pending > 0)
+  {
+    int result = ring_enter(m_ring_fd, static_cast<unsigned>(m_pending));
+    if (result < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      detail::throw_system_error(errno, "io_uring_enter failed");
+    }
+    if (result == 0)
+    {
+      break;
+    }
+    m_pending -= static_cast<std::size_t>(result);
+    submitted += static_cast<std::size_t>(result);
+  }
+  return submitted;
+}
+
+/**
+ * @brief Submit queued operations and collect completions.
+ *
+ * Waits on the ring descriptor only if no completion is already available,
+ * then drains every completion posted so far.
+ *
+ * @param completions Receives the completions (cleared first).
+ * @param timeout Maximum time to wait (negative = infinite, zero = no wait).
+ * @return Number of completions collected.
+ * @throws std::system_error On submission or wait failure.
+ */
+int io_ring::wait(std::vector<io_completion> &completions,
+                  const std::chrono::milliseconds &timeout)
+{
+  completions.clear();
+  submit();
+
+  unsigned head = *m_cq_head;
+  unsigned tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+  if (head == tail && timeout.count() != 0)
+  {
+    struct pollfd ring;
+    ring.fd      = m_ring_fd;
+    ring.events  = POLLIN;
+    ring.revents = 0;
+    int timeout_ms =
+        timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+    if (::poll(&ring, 1, timeout_ms) < 0 && errno != EINTR)
+    {
+      detail::throw_system_error(errno, "Failed to wait for io_uring");
+    }
+    tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+  }
+
+  auto *cqes = static_cast<io_uring_cqe *>(m_cqes);
+  for (; head != tail; ++head)
+  {
+    const io_uring_cqe &cqe = cqes[head & m_cq_mask];
+    auto slot               = static_cast<std::uint32_t>(cqe.user_data);
+    operation &op           = m_operations[slot];
+    int result              = cqe.res;
+
+    if (op.poll && result >= 0)
+    {
+      result = poll_events_to_mode(result);
+    }
+    else if (op.entry && result >= 0)
+    {
+      op.entry->length = static_cast<std::size_t>(result);
+      op.entry->sender = socket_address(
+          reinterpret_cast<sockaddr *>(&op.address), op.message.msg_namelen);
+    }
+
+    completions.emplace_back(op.user_data, result);
+    op.poll  = false;
+    op.entry = nullptr;
+    m_free_slots.push_back(slot);
+  }
+  __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+
+  return static_cast<int>(completions.size());
+}
+
+/**
+ * @brief Number of operations queued but not yet submitted.
+ */
+std::size_t io_ring::pending() const { return m_pending; }
+
+/**
+ * @brief Number of operations submitted or queued whose completion has not
+ * been collected.
+ */
+std::size_t io_ring::in_flight() const
+{
+  return m_operations.size() - m_free_slots.size();
+}
+
+/**
+ * @brief Submission queue size chosen by the kernel.
+ */
+unsigned io_ring::entries() const { return m_entries; }
+
+/**
+ * @brief Reserve an operation slot and the next submission queue entry.
+ *
+ * Flushes queued entries first if the submission queue is full.
+ *
+ * @param slot Receives the reserved operation slot.
+ * @param user_data Caller value stored with the operation.
+ * @return Zeroed submission entry tagged with the slot.
+ * @throws std::runtime_error If every completion slot is in flight.
+ */
+void *io_ring::next_sqe(std::uint32_t &slot, std::uint64_t user_data)
+{
+  if (m_free_slots.empty())
+  {
+    throw std::runtime_error("io_ring has too many operations in flight");
+  }
+
+  unsigned tail = *m_sq_tail;
+  if (tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_entries)
+  {
+    submit();
+  }
+
+  slot = m_free_slots.back();
+  m_free_slots.pop_back();
+  m_operations[slot].user_data = user_data;
+
+  unsigned index = tail & m_sq_mask;
+  auto *sqe      = static_cast<io_uring_sqe *>(m_sqes) + index;
+  std::memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data    = slot;
+  m_sq_array[index] = index;
+
+  // The entry is written by the caller before the next io_uring_enter(),
+  // which is what hands the published tail to the kernel.
+  __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+  ++m_pending;
+  return sqe;
+}
+
+/**
+ * @brief Resolve a socket's descriptor for submission.
+ *
+ * @throws std::invalid_argument If the socket is closed.
+ */
+socket_t io_ring::socket_fd(const socket_base &socket) const
+{
+  socket_t fd = socket.sockfd();
+  if (fd == INVALID_SOCKET_VALUE)
+  {
+    throw std::invalid_argument("Invalid socket file descriptor");
+  }
+  return fd;
+}
+
+/**
+ * @brief Unmap the queues and close the ring descriptor.
+ */
+void io_ring::release()
+{
+  if (m_sqes != MAP_FAILED)
+  {
+    ::munmap(m_sqes, m_sqes_size);
+    m_sqes = MAP_FAILED;
+  }
+  if (m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring)
+  {
+    ::munmap(m_cq_ring, m_cq_ring_size);
+  }
+  m_cq_ring = MAP_FAILED;
+  if (m_sq_ring != MAP_FAILED)
+  {
+    ::munmap(m_sq_ring, m_sq_ring_size);
+    m_sq_ring = MAP_FAILED;
+  }
+  if (m_ring_fd >= 0)
+  {
+    ::close(m_ring_fd);
+    m_ring_fd = -1;
+  }
+}
+
+#else
+
+struct io_ring::operation
+{
+};
+
+/**
+ * @brief io_uring is Linux-only; construction always fails elsewhere.
+ *
+ * @throws std::system_error With std::errc::function_not_supported.
+ */
+io_ring::io_ring(unsigned entries) :
+  m_ring_fd(-1),
+  m_entries(entries),
+  m_sq_ring(nullptr),
+  m_sq_ring_size(0),
+  m_cq_ring(nullptr),
+  m_cq_ring_size(0),
+  m_sqes(nullptr),
+  m_sqes_size(0),
+  m_sq_head(nullptr),
+  m_sq_tail(nullptr),
+  m_sq_mask(0),
+  m_sq_array(nullptr),
+  m_cq_head(nullptr),
+  m_cq_tail(nullptr),
+  m_cq_mask(0),
+  m_cqes(nullptr),
+  m_pending(0)
+{
+  detail::throw_system_error(std::errc::function_not_supported,
+                             "io_uring is not available on this platform");
+}
+
+/**
+ * @brief Nothing to release on platforms without io_uring.
+ */
+io_ring::~io_ring() = default;
+
+/**
+ * @brief io_uring is never available off Linux.
+ */
+bool io_ring::supported() { return false; }
+
+void io_ring::register_buffers(const io_buffer *, std::size_t) {}
+void io_ring::unregister_buffers() {}
+void io_ring::submit_poll(const socket_base &, int, std::uint64_t) {}
+void io_ring::submit_receive(const socket_base &, void *, std::size_t,
+                             std::uint64_t, int)
+{
+}
+void io_ring::submit_send(const socket_base &, const void *, std::size_t,
+                          std::uint64_t, int)
+{
+}
+void io_ring::submit_receive_fixed(const socket_base &, std::size_t,
+                                   std::size_t, std::uint64_t)
+{
+}
+void io_ring::submit_send_fixed(const socket_base &, std::size_t, std::size_t,
+                                std::uint64_t)
+{
+}
+void io_ring::submit_accept(const socket_base &, std::uint64_t) {}
+void io_ring::submit_receive_from(const socket_base &, udp_receive_entry &,
+                                  std::uint64_t, int)
+{
+}
+std::size_t io_ring::submit() { return 0; }
+int io_ring::wait(std::vector<io_completion> &completions,
+                  const std::chrono::milliseconds &)
+{
+  completions.clear();
+  return 0;
+}
+std::size_t io_ring::pending() const { return 0; }
+std::size_t io_ring::in_flight() const { return 0; }
+unsigned io_ring::entries() const { return m_entries; }
+void *io_ring::next_sqe(std::uint32_t &, std::uint64_t) { return nullptr; }
+socket_t io_ring::socket_fd(const socket_base &socket) const
+{
+  return socket.sockfd();
+}
+void io_ring::release() {}
+
+#endif
+
+} // namespace fb
@@ -0,0 +1,383 @@
+#include <fb/multicast_feed.h>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace fb
+{
+
+/**
+ * @brief Shared udp_handler performing sequence arbitration.
+ *
+ * Flow affinity routes every channel to one worker, so a channel_state is
+ * only ever touched by a single thread. Counters are relaxed atomics because
+ * several workers may serve different channels.
+ */
+class multicast_feed::arbiter : public udp_handler
+{
+public:
+
+  struct alignas(64) channel_state
+  {
+    std::uint64_t next = 0;          ///< Next expected sequence number
+    std::uint64_t gap_base = 0;      ///< First sequence covered by missing_mask
+    std::uint64_t missing_mask = 0;  ///< Bit i: gap_base + i not yet received
+    bool started = false;            ///< First message seen
+  };
+
+  arbiter(multicast_feed &feed, message_handler handler) :
+    m_feed(feed),
+    m_handler(std::move(handler)),
+    m_decoder(&multicast_feed::decode_sequence),
+    m_states(1)
+  {
+  }
+
+  void handle_packet(const void *buffer, std::size_t length,
+                     const socket_address &sender_address) override
+  {
+    (void)sender_address;
+
+    std::uint32_t channel  = 0;
+    std::uint64_t sequence = 0;
+    if (!m_decoder(buffer, length, channel, sequence) || channel >= m_states.size())
+    {
+      m_rejected.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    channel_state &state = m_states[channel];
+    if (sequence < state.next)
+    {
+      if (state.missing_mask != 0 && sequence >= state.gap_base &&
+          sequence - state.gap_base < RECOVERY_WINDOW)
+      {
+        const std::uint64_t bit = std::uint64_t{1} << (sequence - state.gap_base);
+        if ((state.missing_mask & bit) != 0)
+        {
+          state.missing_mask &= ~bit;
+          m_recovered.fetch_add(1, std::memory_order_relaxed);
+          deliver(channel, sequence, buffer, length, true);
+          return;
+        }
+      }
+      m_duplicates.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    if (state.started && sequence > state.next)
+    {
+      const std::uint64_t first = state.next;
+      const std::uint64_t count = sequence - first;
+      state.gap_base     = first;
+      state.missing_mask = count >= RECOVERY_WINDOW ? ~std::uint64_t{0}
+                                                    : (std::uint64_t{1} << count) - 1;
+      m_gaps.fetch_add(1, std::memory_order_relaxed);
+      m_missing.fetch_add(count, std::memory_order_relaxed);
+      if (m_feed.onGap.has_slots())
+      {
+        m_feed.onGap.emit(channel, first, count);
+      }
+    }
+
+    state.started = true;
+    state.next    = sequence + 1;
+    deliver(channel, sequence, buffer, length, false);
+  }
+
+  std::string handler_name() const override { return "multicast_feed"; }
+
+  std::uint32_t channel_of(const udp_server::PacketData &packet) const
+  {
+    std::uint32_t channel  = 0;
+    std::uint64_t sequence = 0;
+    if (!m_decoder(packet.buffer.data(), packet.buffer.size(), channel, sequence))
+    {
+      return 0;
+    }
+    return channel;
+  }
+
+  void set_decoder(sequence_decoder decoder)
+  {
+    m_decoder = decoder ? std::move(decoder)
+                        : sequence_decoder(&multicast_feed::decode_sequence);
+  }
+
+  void set_channels(std::size_t channels)
+  {
+    std::vector<channel_state>(channels).swap(m_states);
+  }
+
+  std::size_t channels() const { return m_states.size(); }
+
+  std::atomic<std::uint64_t> m_delivered{0};
+  std::atomic<std::uint64_t> m_duplicates{0};
+  std::atomic<std::uint64_t> m_gaps{0};
+  std::atomic<std::uint64_t> m_missing{0};
+  std::atomic<std::uint64_t> m_recovered{0};
+  std::atomic<std::uint64_t> m_rejected{0};
+
+private:
+
+  void deliver(std::uint32_t channel, std::uint64_t sequence,
+               const void *data, std::size_t length, bool recovered)
+  {
+    m_delivered.fetch_add(1, std::memory_order_relaxed);
+    if (m_handler)
+    {
+      m_handler(message{channel, sequence, data, length, recovered});
+    }
+  }
+
+  multicast_feed &m_feed;
+  message_handler m_handler;
+  sequence_decoder m_decoder;
+  std::vector<channel_state> m_states;
+};
+
+/**
+ * @class fb::multicast_feed
+ * @brief A/B arbitrated, gap-checked sequenced feed on top of udp_server.
+ */
+
+/**
+ * @brief Create a single-line feed.
+ *
+ * @param line_a Bound (and joined) socket of the feed; see open_line().
+ * @param handler Called for every message that wins arbitration.
+ */
+multicast_feed::multicast_feed(udp_socket line_a, message_handler handler) :
+  m_arbiter(std::make_shared<arbiter>(*this, std::move(handler))),
+  m_server(std::move(line_a), m_arbiter),
+  m_workers(1)
+{
+}
+
+/**
+ * @brief Create a feed arbitrating two redundant lines.
+ *
+ * The lines may use different groups and ports.
+ *
+ * @param line_a Bound socket of the A line.
+ * @param line_b Bound socket of the B line.
+ * @param handler Called for every message that wins arbitration.
+ * @throws std::invalid_argument If line_b is closed.
+ */
+multicast_feed::multicast_feed(udp_socket line_a, udp_socket line_b,
+                               message_handler handler) :
+  multicast_feed(std::move(line_a), std::move(handler))
+{
+  m_server.add_receive_socket(std::move(line_b));
+}
+
+/**
+ * @brief Stop the feed if it is running.
+ */
+multicast_feed::~multicast_feed()
+{
+  try
+  {
+    stop();
+  }
+  catch (...)
+  {
+    // Ignore exceptions in destructor
+  }
+}
+
+/**
+ * @brief Open a socket receiving a multicast group on any interface.
+ *
+ * @param group Group address; its port is the port bound.
+ * @return Bound socket that joined the group.
+ * @throws std::system_error If binding or joining fails.
+ */
+udp_socket multicast_feed::open_line(const socket_address &group)
+{
+  udp_socket socket(group.family());
+  socket.bind(socket_address(group.family(), group.port()), true);
+  socket.join_group(group);
+  return socket;
+}
+
+/**
+ * @brief Open a socket receiving a multicast group on one interface.
+ *
+ * @param group Group address; its port is the port bound.
+ * @param interface_address Local address of the interface to join on.
+ * @return Bound socket that joined the group.
+ * @throws std::system_error If binding or joining fails.
+ */
+udp_socket multicast_feed::open_line(const socket_address &group,
+                                     const socket_address &interface_address)
+{
+  udp_socket socket(group.family());
+  socket.bind(socket_address(group.family(), group.port()), true);
+  socket.join_group(group, interface_address);
+  return socket;
+}
+
+/**
+ * @brief Default decoder: 8-byte big-endian sequence number, channel 0.
+ *
+ * @return False if the datagram is shorter than 8 bytes.
+ */
+bool multicast_feed::decode_sequence(const void *data, std::size_t length,
+                                     std::uint32_t &channel, std::uint64_t &sequence)
+{
+  if (length < 8)
+  {
+    return false;
+  }
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    value = (value << 8) | bytes[i];
+  }
+  channel  = 0;
+  sequence = value;
+  return true;
+}
+
+/**
+ * @brief Replace the sequence decoder.
+ *
+ * The decoder runs twice per datagram: on the receiver thread to route it
+ * and on the worker to arbitrate it, so it should be cheap.
+ *
+ * @param decoder Decoder; nullptr restores decode_sequence().
+ * @throws std::runtime_error If the feed is running.
+ */
+void multicast_feed::set_decoder(sequence_decoder decoder)
+{
+  if (is_running())
+  {
+    throw std::runtime_error("Cannot change decoder while feed is running");
+  }
+  m_arbiter->set_decoder(std::move(decoder));
+}
+
+/**
+ * @brief Set the number of channels and the workers serving them.
+ *
+ * Channels are numbered 0 to channels - 1; datagrams for other channels are
+ * rejected. Channel c is handled by worker c % workers. Resets all
+ * sequence state.
+ *
+ * @param channels Number of channels.
+ * @param workers Worker threads (capped at the channel count).
+ * @throws std::invalid_argument If channels or workers is zero.
+ * @throws std::runtime_error If the feed is running.
+ */
+void multicast_feed::set_channels(std::size_t channels, std::size_t workers)
+{
+  if (is_running())
+  {
+    throw std::runtime_error("Cannot change channels while feed is running");
+  }
+  if (channels == 0 || workers == 0)
+  {
+    throw std::invalid_argument("Channel and worker counts must be positive");
+  }
+  m_arbiter->set_channels(channels);
+  m_workers = workers;
+}
+
+/**
+ * @brief Number of channels arbitrated.
+ */
+std::size_t multicast_feed::channels() const { return m_arbiter->channels(); }
+
+/**
+ * @brief Start receiving on all lines.
+ *
+ * @throws std::runtime_error If already running.
+ * @throws std::system_error If the server cannot start.
+ */
+void multicast_feed::start()
+{
+  arbiter *const feed_arbiter = m_arbiter.get();
+  m_server.set_flow_affinity(
+      std::min(m_workers, m_arbiter->channels()),
+      [feed_arbiter](const udp_server::PacketData &packet) -> std::uint64_t
+      {
+        return feed_arbiter->channel_of(packet);
+      });
+  m_server.start();
+}
+
+/**
+ * @brief Stop receiving; does nothing if not running.
+ */
+void multicast_feed::stop()
+{
+  if (m_server.is_running())
+  {
+    m_server.stop();
+  }
+}
+
+/**
+ * @brief Check whether the feed is receiving.
+ */
+bool multicast_feed::is_running() const { return m_server.is_running(); }
+
+/**
+ * @brief Underlying server, e.g. to tune batching or busy polling.
+ *
+ * Do not change its handler or flow affinity.
+ */
+udp_server &multicast_feed::server() { return m_server; }
+
+/**
+ * @brief Messages delivered to the handler (including recovered ones).
+ */
+std::uint64_t multicast_feed::delivered() const
+{
+  return m_arbiter->m_delivered.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Copies dropped because their sequence number was already seen.
+ */
+std::uint64_t multicast_feed::duplicates() const
+{
+  return m_arbiter->m_duplicates.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gaps detected (onGap emissions).
+ */
+std::uint64_t multicast_feed::gaps() const
+{
+  return m_arbiter->m_gaps.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sequence numbers reported missing by all gaps.
+ */
+std::uint64_t multicast_feed::missing() const
+{
+  return m_arbiter->m_missing.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Missing sequence numbers that later arrived and were delivered.
+ */
+std::uint64_t multicast_feed::recovered() const
+{
+  return m_arbiter->m_recovered.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Datagrams the decoder rejected or for unknown channels.
+ */
+std::uint64_t multicast_feed::rejected() const
+{
+  return m_arbiter->m_rejected.load(std::memory_order_relaxed);
+}
+
+} // namespace fb
@@ -0,0 +1,81 @@
+#include <fb/output_budget.h>
+
+namespace fb
+{
+
+/**
+ * @class fb::output_budget
+ * @brief Global cap on the bytes queued by the connections of one server.
+ */
+
+/**
+ * @brief Create an empty budget.
+ *
+ * @param limit Maximum bytes outstanding at once; 0 never refuses.
+ */
+output_budget::output_budget(std::size_t limit) :
+  m_used(0),
+  m_refused(0),
+  m_limit(limit)
+{
+}
+
+/**
+ * @brief Reserve bytes if they fit under the limit.
+ *
+ * @param bytes Number of bytes to reserve.
+ * @return True if reserved; false (and nothing reserved) otherwise.
+ */
+bool output_budget::try_acquire(std::size_t bytes) noexcept
+{
+  if (m_limit == 0)
+  {
+    m_used.fetch_add(bytes, std::memory_order_relaxed);
+    return true;
+  }
+
+  std::size_t current = m_used.load(std::memory_order_relaxed);
+  do
+  {
+    if (bytes > m_limit || current > m_limit - bytes)
+    {
+      m_refused.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!m_used.compare_exchange_weak(current, current + bytes,
+                                         std::memory_order_relaxed));
+  return true;
+}
+
+/**
+ * @brief Return bytes previously reserved with try_acquire().
+ *
+ * @param bytes Number of bytes to return.
+ */
+void output_budget::release(std::size_t bytes) noexcept
+{
+  m_used.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Bytes currently reserved.
+ */
+std::size_t output_budget::used() const noexcept
+{
+  return m_used.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Configured limit (0 for unlimited).
+ */
+std::size_t output_budget::limit() const noexcept { return m_limit; }
+
+/**
+ * @brief Number of try_acquire() calls that were refused.
+ */
+std::uint64_t output_budget::refused() const noexcept
+{
+  return m_refused.load(std::memory_order_relaxed);
+}
+
+} // namespace fb
@@ -1,5 +1,6 @@
 #include <fb/poll_set.h>
 #include <fb/detail/socket_error_utils.h>
+#include <fb/timer_source.h>
 #include <algorithm>
 #include <cstring>
 #include <stdexcept>
@@ -56,6 +57,7 @@ poll_set::~poll_set() { cleanup_polling(); }
  */
 poll_set::poll_set(poll_set &&other) noexcept :
   m_sockets(std::move(other.m_sockets)),
+  m_fd_slots(std::move(other.m_fd_slots)),
   m_events(std::move(other.m_events))
 {
 #ifdef __linux__
@@ -87,8 +89,9 @@ poll_set &poll_set::operator=(poll_set &&other) noexcept
   {
     cleanup_polling();
 
-    m_sockets = std::move(other.m_sockets);
-    m_events  = std::move(other.m_events);
+    m_sockets  = std::move(other.m_sockets);
+    m_fd_slots = std::move(other.m_fd_slots);
+    m_events   = std::move(other.m_events);
 
 #ifdef __linux__
     m_epoll_fd       = other.m_epoll_fd;
@@ -114,9 +117,10 @@ poll_set &poll_set::operator=(poll_set &&other) noexcept
  * @brief Add socket to poll set with specified mode
  * @param socket Socket to monitor
  * @param mode Polling mode (POLL_READ, POLL_WRITE, POLL_ERROR or combination)
+ * @param user_data Caller value returned in every SocketEvent for the socket
  * @throws std::system_error on error
  */
-void poll_set::add(const socket_base &socket, int mode)
+void poll_set::add(const socket_base &socket, int mode, void *user_data)
 {
   socket_t fd = get_socket_fd(socket);
   if (fd == -1)
@@ -124,18 +128,104 @@ void poll_set::add(const socket_base &socket, int mode)
     throw std::invalid_argument("Invalid socket file descriptor");
   }
 
-  auto it = m_sockets.find(fd);
-  if (it != m_sockets.end())
+  std::size_t slot = fd_slot(fd);
+  if (slot != NO_SLOT)
   {
-    // Socket already exists, update mode instead
-    update(socket, mode);
-    return;
+    if (m_sockets[slot].socket_ptr == &socket)
+    {
+      // Socket already exists, update mode instead
+      m_sockets[slot].user_data = user_data;
+      update(socket, mode);
+      return;
+    }
+
+    // The descriptor belongs to a socket that was closed without being
+    // removed and has since been reused by the kernel; closing it already
+    // dropped it from the OS set, so only the stale bookkeeping is left.
+    erase_slot(slot);
   }
 
   // Add new socket
-  // SocketInfo info(fd, const_cast<socket*>(&socket), mode);
-  SocketInfo info(fd, const_cast<class socket_base *>(&socket), mode);
-  m_sockets[fd] = info;
+  add_descriptor(fd, const_cast<class socket_base *>(&socket), mode, user_data);
+}
+
+/**
+ * @brief Watch an event_queue for cross-thread deliveries
+ *
+ * Registers the queue's notification descriptor for reading. Events for it
+ * carry a null socket_ptr and @p user_data; call queue.process_pending()
+ * when one is reported. A reactor can so wait on its sockets and on queued
+ * signal deliveries in a single poll().
+ *
+ * @param queue Queue owned by the polling thread
+ * @param user_data Caller value returned in every SocketEvent for the queue
+ * @throws std::invalid_argument If the platform offers no notification descriptor
+ * @throws std::system_error on error
+ */
+void poll_set::add(event_queue &queue, void *user_data)
+{
+  const int fd = queue.notification_fd();
+  if (fd < 0)
+  {
+    throw std::invalid_argument("event_queue has no notification descriptor");
+  }
+  add_notifier(static_cast<socket_t>(fd), user_data);
+}
+
+/**
+ * @brief Watch a timer_source for expirations
+ *
+ * Registers the timer's descriptor for reading. Events for it carry a null
+ * socket_ptr and @p user_data; call timer.read() when one is reported, so
+ * timeouts are handled on the polling thread next to the socket events.
+ *
+ * @param timer Timer owned by the polling thread
+ * @param user_data Caller value returned in every SocketEvent for the timer
+ * @throws std::invalid_argument If the timer has been moved from
+ * @throws std::system_error on error
+ */
+void poll_set::add(timer_source &timer, void *user_data)
+{
+  const int fd = timer.native_handle();
+  if (fd < 0)
+  {
+    throw std::invalid_argument("timer_source has no descriptor");
+  }
+  add_notifier(static_cast<socket_t>(fd), user_data);
+}
+
+/**
+ * @brief Register a socket-less descriptor, or update its user_data
+ * @param fd Descriptor that polls readable when there is work
+ * @param user_data Caller value echoed in SocketEvent
+ * @throws std::system_error on error
+ */
+void poll_set::add_notifier(socket_t fd, void *user_data)
+{
+  std::size_t slot = fd_slot(fd);
+  if (slot != NO_SLOT)
+  {
+    if (m_sockets[slot].socket_ptr == nullptr)
+    {
+      m_sockets[slot].user_data = user_data;
+      return;
+    }
+    erase_slot(slot);
+  }
+  add_descriptor(fd, nullptr, POLL_READ, user_data);
+}
+
+/**
+ * @brief Register a descriptor with the OS poller
+ * @param fd Descriptor to monitor
+ * @param socket Owning socket, nullptr for an event_queue or timer descriptor
+ * @param mode Polling mode
+ * @param user_data Caller value echoed in SocketEvent
+ * @throws std::system_error on error
+ */
+void poll_set::add_descriptor(socket_t fd, socket_base *socket, int mode, void *user_data)
+{
+  insert_socket(SocketInfo(fd, socket, mode, user_data));
 
 #ifdef __linux__
   struct epoll_event event;
@@ -144,8 +234,9 @@ void poll_set::add(const socket_base &socket, int mode)
 
   if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1)
   {
-    m_sockets.erase(fd);
-    detail::throw_system_error(errno, "Failed to add socket to epoll");
+    int error = errno;
+    erase_slot(m_sockets.size() - 1);
+    detail::throw_system_error(error, "Failed to add socket to epoll");
   }
 #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
     defined(__OpenBSD__)
@@ -162,29 +253,83 @@ void poll_set::add(const socket_base &socket, int mode)
  */
 void poll_set::remove(const socket_base &socket)
 {
-  auto it = find_socket(socket);
-  if (it == m_sockets.end())
+  std::size_t slot = find_socket(socket);
+  if (slot == NO_SLOT)
   {
     return; // Socket not in set
   }
+  remove_slot(slot);
+}
+
+/**
+ * @brief Stop watching an event_queue
+ * @param queue Queue passed to add()
+ * @throws std::system_error on error
+ */
+void poll_set::remove(event_queue &queue)
+{
+  const int fd = queue.notification_fd();
+  if (fd >= 0)
+  {
+    remove_notifier(static_cast<socket_t>(fd));
+  }
+}
+
+/**
+ * @brief Stop watching a timer_source
+ * @param timer Timer passed to add()
+ * @throws std::system_error on error
+ */
+void poll_set::remove(timer_source &timer)
+{
+  const int fd = timer.native_handle();
+  if (fd >= 0)
+  {
+    remove_notifier(static_cast<socket_t>(fd));
+  }
+}
 
+/**
+ * @brief Drop a socket-less descriptor added with add_notifier()
+ * @param fd Descriptor to drop
+ * @throws std::system_error on error
+ */
+void poll_set::remove_notifier(socket_t fd)
+{
+  std::size_t slot = fd_slot(fd);
+  if (slot != NO_SLOT && m_sockets[slot].socket_ptr == nullptr)
+  {
+    remove_slot(slot);
+  }
+}
+
+/**
+ * @brief Deregister a slot from the OS poller and drop it
+ * @param slot Index into m_sockets
+ * @throws std::system_error on error
+ */
+void poll_set::remove_slot(std::size_t slot)
+{
 #if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) || \
     defined(__NetBSD__) || defined(__OpenBSD__)
-  socket_t fd = it->first;
+  socket_t fd = m_sockets[slot].fd;
 #endif
 
 #ifdef __linux__
-  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == -1)
+  // EBADF/ENOENT mean the descriptor was already closed (which drops it from
+  // the epoll set); only the bookkeeping entry remains to be erased.
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == -1 &&
+      errno != EBADF && errno != ENOENT)
   {
     detail::throw_system_error(errno, "Failed to remove socket from epoll");
   }
 #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
     defined(__OpenBSD__)
-  int old_mode = it->second.mode;
+  int old_mode = m_sockets[slot].mode;
   remove_kevent(fd, old_mode);
 #endif
 
-  m_sockets.erase(it);
+  erase_slot(slot);
 
 #if !defined(__linux__) && !defined(__APPLE__) && !defined(__FreeBSD__) &&     \
     !defined(__NetBSD__) && !defined(__OpenBSD__)
@@ -200,21 +345,24 @@ void poll_set::remove(const socket_base &socket)
  */
 void poll_set::update(const socket_base &socket, int mode)
 {
-  auto it = find_socket(socket);
-  if (it == m_sockets.end())
+  std::size_t slot = find_socket(socket);
+  if (slot == NO_SLOT)
   {
     throw std::logic_error("Socket not in poll set");
   }
 
-  socket_t fd  = it->first;
-  int old_mode = it->second.mode;
+  SocketInfo &info = m_sockets[slot];
+  socket_t fd      = info.fd;
+  int old_mode     = info.mode;
 
-  if (old_mode == mode)
+  // Re-submitting an unchanged oneshot registration is how it is re-armed
+  if (old_mode == mode && !(mode & POLL_ONESHOT))
   {
     return; // No change needed
   }
 
-  it->second.mode = mode;
+  info.mode     = mode;
+  info.disarmed = false;
 
 #if defined(_WIN32)
   // On Windows, suppress unused variable warnings for platform-specific code
@@ -228,12 +376,14 @@ void poll_set::update(const socket_base &socket, int mode)
 
   if (epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, fd, &event) == -1)
   {
-    it->second.mode = old_mode; // Revert change
+    info.mode = old_mode; // Revert change
     detail::throw_system_error(errno, "Failed to update socket in epoll");
   }
 #elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
     defined(__OpenBSD__)
-  remove_kevent(fd, old_mode);
+  // EV_ADD modifies filters that are still present, so only the dropped ones
+  // need deleting; this also re-arms filters a oneshot event already removed.
+  remove_kevent(fd, old_mode & ~mode);
   add_kevent(fd, mode);
 #else
   rebuild_fd_sets();
@@ -247,7 +397,7 @@ void poll_set::update(const socket_base &socket, int mode)
  */
 bool poll_set::has(const socket_base &socket) const
 {
-  return find_socket(socket) != m_sockets.end();
+  return find_socket(socket) != NO_SLOT;
 }
 
 /**
@@ -257,8 +407,19 @@ bool poll_set::has(const socket_base &socket) const
  */
 int poll_set::get_mode(const socket_base &socket) const
 {
-  auto it = find_socket(socket);
-  return (it != m_sockets.end()) ? it->second.mode : 0;
+  std::size_t slot = find_socket(socket);
+  return (slot != NO_SLOT) ? m_sockets[slot].mode : 0;
+}
+
+/**
+ * @brief Get the user data registered for a socket
+ * @param socket Socket to query
+ * @return Value passed to add(), nullptr if socket not in set
+ */
+void *poll_set::get_user_data(const socket_base &socket) const
+{
+  std::size_t slot = find_socket(socket);
+  return (slot != NO_SLOT) ? m_sockets[slot].user_data : nullptr;
 }
 
 /**
@@ -267,6 +428,7 @@ int poll_set::get_mode(const socket_base &socket) const
 void poll_set::clear()
 {
   m_sockets.clear();
+  m_fd_slots.clear();
   m_events.clear();
 
 #ifdef __linux__
@@ -396,39 +558,109 @@ socket_t poll_set::get_socket_fd(const socket_base &socket) const
 }
 
 /**
- * @brief Find socket info by Socket pointer
- * @param socket Socket to find
- * @return Iterator to socket info, or end() if not found
+ * @brief Look up the slot registered for a descriptor
+ *
+ * On POSIX systems descriptors are small integers, so m_fd_slots is indexed
+ * by fd directly. Windows SOCKET handles are opaque and unbounded, so the
+ * select fallback (itself capped at FD_SETSIZE) scans the dense array.
+ *
+ * @param fd Descriptor to find
+ * @return Index into m_sockets, or NO_SLOT if not registered
  */
+std::size_t poll_set::fd_slot(socket_t fd) const
+{
+#ifdef _WIN32
+  for (std::size_t i = 0; i < m_sockets.size(); ++i)
+  {
+    if (m_sockets[i].fd == fd)
+    {
+      return i;
+    }
+  }
+  return NO_SLOT;
+#else
+  if (fd < 0)
+  {
+    return NO_SLOT;
+  }
+  auto index = static_cast<std::size_t>(fd);
+  if (index >= m_fd_slots.size() || m_fd_slots[index] == 0)
+  {
+    return NO_SLOT;
+  }
+  return m_fd_slots[index] - 1;
+#endif
+}
+
 /**
- * @brief Find socket info by Socket pointer
+ * @brief Find the slot registered for a socket object
+ *
+ * Resolves through the socket's current descriptor. A socket closed since
+ * registration no longer reports its fd, so it is matched by identity.
+ *
  * @param socket Socket to find
- * @return Iterator to socket info, or end() if not found
+ * @return Index into m_sockets, or NO_SLOT if not registered
  */
-std::map<socket_t, poll_set::SocketInfo>::iterator
-poll_set::find_socket(const socket_base &socket)
+std::size_t poll_set::find_socket(const socket_base &socket) const
 {
-  return std::find_if(m_sockets.begin(), m_sockets.end(),
-                      [&socket](const auto &pair)
-                      { return pair.second.socket_ptr == &socket; });
+  socket_t fd = get_socket_fd(socket);
+  if (fd != INVALID_SOCKET_VALUE)
+  {
+    std::size_t slot = fd_slot(fd);
+    return (slot != NO_SLOT && m_sockets[slot].socket_ptr == &socket)
+               ? slot
+               : NO_SLOT;
+  }
+
+  for (std::size_t i = 0; i < m_sockets.size(); ++i)
+  {
+    if (m_sockets[i].socket_ptr == &socket)
+    {
+      return i;
+    }
+  }
+  return NO_SLOT;
 }
 
 /**
- * @brief Find socket info by Socket pointer
- * @param socket Socket to find
- * @return Iterator to socket info, or end() if not found
+ * @brief Append a registration and index it by descriptor
+ * @param info Registration to store
  */
+void poll_set::insert_socket(const SocketInfo &info)
+{
+  m_sockets.push_back(info);
+
+#ifndef _WIN32
+  auto index = static_cast<std::size_t>(info.fd);
+  if (index >= m_fd_slots.size())
+  {
+    m_fd_slots.resize(std::max(index + 1, m_fd_slots.size() * 2), 0);
+  }
+  m_fd_slots[index] = m_sockets.size();
+#endif
+}
+
 /**
- * @brief Find socket info by socket pointer
- * @param socket Socket to find
- * @return Iterator to socket info, or end() if not found
+ * @brief Drop a registration, moving the last entry into its slot
+ * @param slot Index into m_sockets
  */
-std::map<socket_t, poll_set::SocketInfo>::const_iterator
-poll_set::find_socket(const socket_base &socket) const
+void poll_set::erase_slot(std::size_t slot)
 {
-  return std::find_if(m_sockets.begin(), m_sockets.end(),
-                      [&socket](const auto &pair)
-                      { return pair.second.socket_ptr == &socket; });
+  std::size_t last = m_sockets.size() - 1;
+
+#ifndef _WIN32
+  m_fd_slots[static_cast<std::size_t>(m_sockets[slot].fd)] = 0;
+  if (slot != last)
+  {
+    m_fd_slots[static_cast<std::size_t>(m_sockets[last].fd)] = slot + 1;
+  }
+#endif
+
+  if (slot != last)
+  {
+    m_sockets[slot] = m_sockets[last];
+  }
+  m_sockets.pop_back();
 }
 
 /**
@@ -510,14 +742,14 @@ int poll_set::poll_epoll(const std::chrono::milliseconds &timeout)
   m_events.clear();
   m_events.reserve(num_events);
 
-  for (int i = 0; i < num_events; ++i)
+  for (std::size_t i = 0; i < static_cast<std::size_t>(num_events); ++i)
   {
-    socket_t fd = m_epoll_events[i].data.fd;
-    auto it     = m_sockets.find(fd);
-    if (it != m_sockets.end())
+    std::size_t slot = fd_slot(m_epoll_events[i].data.fd);
+    if (slot != NO_SLOT)
     {
+      const SocketInfo &info = m_sockets[slot];
       int mode = epoll_events_to_mode(m_epoll_events[i].events);
-      m_events.emplace_back(it->second.socket_ptr, mode);
+      m_events.emplace_back(info.socket_ptr, mode, info.user_data);
     }
   }
 
@@ -530,9 +762,9 @@ int poll_set::poll_epoll(const std::chrono::milliseconds &timeout)
   return num_events;
 }
 
-int poll_set::epoll_mode_to_events(int mode) const
+uint32_t poll_set::epoll_mode_to_events(int mode) const
 {
-  int events = 0;
+  uint32_t events = 0;
   if (mode & POLL_READ)
   {
     events |= EPOLLIN;
@@ -545,6 +777,14 @@ int poll_set::epoll_mode_to_events(int mode) const
   {
     events |= EPOLLERR | EPOLLHUP;
   }
+  if (mode & POLL_EDGE)
+  {
+    events |= EPOLLET;
+  }
+  if (mode & POLL_ONESHOT)
+  {
+    events |= EPOLLONESHOT;
+  }
   return events;
 }
 
@@ -628,12 +868,40 @@ int poll_set::poll_kqueue(const std::chrono::milliseconds &timeout)
 
   for (int i = 0; i < num_events; ++i)
   {
-    socket_t fd = static_cast<socket_t>(m_kevent_events[i].ident);
-    auto it     = m_sockets.find(fd);
-    if (it != m_sockets.end())
+    // ENOENT comes from deleting a filter a oneshot event already removed
+    if ((m_kevent_events[i].flags & EV_ERROR) &&
+        m_kevent_events[i].data == ENOENT)
+    {
+      continue;
+    }
+
+    std::size_t slot =
+        fd_slot(static_cast<socket_t>(m_kevent_events[i].ident));
+    if (slot == NO_SLOT)
     {
-      int mode = kevent_to_mode(m_kevent_events[i]);
-      m_events.emplace_back(it->second.socket_ptr, mode);
+      continue;
+    }
+
+    // Read and write filters arrive as separate kevents; fold them into one
+    // SocketEvent so each socket is reported once, as with epoll.
+    SocketInfo &info = m_sockets[slot];
+    int mode         = kevent_to_mode(m_kevent_events[i]);
+    if (info.event_index != NO_SLOT)
+    {
+      m_events[info.event_index].mode |= mode;
+      continue;
+    }
+    info.event_index = m_events.size();
+    m_events.emplace_back(info.socket_ptr, mode, info.user_data);
+  }
+
+  for (int i = 0; i < num_events; ++i)
+  {
+    std::size_t slot =
+        fd_slot(static_cast<socket_t>(m_kevent_events[i].ident));
+    if (slot != NO_SLOT)
+    {
+      m_sockets[slot].event_index = NO_SLOT;
     }
   }
 
@@ -643,22 +911,32 @@ int poll_set::poll_kqueue(const std::chrono::milliseconds &timeout)
     m_kevent_events.resize(m_kevent_events.size() * 2);
   }
 
-  return num_events;
+  return static_cast<int>(m_events.size());
 }
 
 void poll_set::add_kevent(socket_t fd, int mode)
 {
+  unsigned short flags = EV_ADD | EV_ENABLE;
+  if (mode & POLL_EDGE)
+  {
+    flags |= EV_CLEAR;
+  }
+  if (mode & POLL_ONESHOT)
+  {
+    flags |= EV_ONESHOT;
+  }
+
   if (mode & POLL_READ)
   {
     struct kevent event;
-    EV_SET(&event, fd, EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, nullptr);
+    EV_SET(&event, fd, EVFILT_READ, flags, 0, 0, nullptr);
     m_kevent_list.push_back(event);
   }
 
   if (mode & POLL_WRITE)
   {
     struct kevent event;
-    EV_SET(&event, fd, EVFILT_WRITE, EV_ADD | EV_ENABLE, 0, 0, nullptr);
+    EV_SET(&event, fd, EVFILT_WRITE, flags, 0, 0, nullptr);
     m_kevent_list.push_back(event);
   }
 }
@@ -765,11 +1043,11 @@ int poll_set::poll_select(const std::chrono::milliseconds &timeout)
 
   m_events.clear();
 
-  for (const auto &pair : m_sockets)
+  bool disarmed_any = false;
+  for (SocketInfo &info : m_sockets)
   {
-    socket_t fd            = pair.first;
-    const SocketInfo &info = pair.second;
-    int mode               = 0;
+    socket_t fd = info.fd;
+    int mode    = 0;
 
     if (FD_ISSET(fd, &read_fds))
     {
@@ -786,10 +1064,22 @@ int poll_set::poll_select(const std::chrono::milliseconds &timeout)
 
     if (mode != 0)
     {
-      m_events.emplace_back(info.socket_ptr, mode);
+      m_events.emplace_back(info.socket_ptr, mode, info.user_data);
+      if (info.mode & POLL_ONESHOT)
+      {
+        info.disarmed = true;
+        disarmed_any  = true;
+      }
     }
   }
 
+  // select has no oneshot (or edge) support; oneshot is emulated by leaving
+  // fired sockets out of the fd sets until update() re-arms them.
+  if (disarmed_any)
+  {
+    rebuild_fd_sets();
+  }
+
   return static_cast<int>(m_events.size());
 }
 
@@ -800,10 +1090,15 @@ void poll_set::rebuild_fd_sets()
   FD_ZERO(&m_error_fds);
   m_max_fd = INVALID_SOCKET_VALUE;
 
-  for (const auto &pair : m_sockets)
+  for (const SocketInfo &info : m_sockets)
   {
-    socket_t fd = pair.first;
-    int mode    = pair.second.mode;
+    if (info.disarmed)
+    {
+      continue;
+    }
+
+    socket_t fd = info.fd;
+    int mode    = info.mode;
 
     if (mode & POLL_READ)
     {
@@ -0,0 +1,145 @@
+#include <fb/send_pacer.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+constexpr std::uint64_t NANOSECONDS_PER_SECOND = 1000000000ULL;
+
+} // namespace
+
+/**
+ * @brief Construct a disabled pacer; every datagram may leave at once.
+ */
+send_pacer::send_pacer() :
+  m_rate(0),
+  m_burst(0),
+  m_tolerance(0),
+  m_next()
+{
+}
+
+/**
+ * @brief Construct a pacer for a sustained rate.
+ *
+ * @param bytes_per_second Long-term limit (0 disables pacing).
+ * @param burst_bytes Bytes that may leave back to back after an idle period.
+ * @throws std::invalid_argument If pacing is enabled and burst_bytes is 0.
+ */
+send_pacer::send_pacer(std::uint64_t bytes_per_second, std::size_t burst_bytes) :
+  m_rate(bytes_per_second),
+  m_burst(burst_bytes),
+  m_tolerance(0),
+  m_next()
+{
+  if (m_rate > 0 && m_burst == 0)
+  {
+    throw std::invalid_argument("Pacing burst must be greater than zero");
+  }
+  m_tolerance = interval(m_burst);
+}
+
+/**
+ * @brief True if a rate is set.
+ */
+bool send_pacer::enabled() const
+{
+  return m_rate > 0;
+}
+
+/**
+ * @brief Sustained rate in bytes per second (0 if disabled).
+ */
+std::uint64_t send_pacer::rate() const
+{
+  return m_rate;
+}
+
+/**
+ * @brief Bucket depth in bytes.
+ */
+std::size_t send_pacer::burst() const
+{
+  return m_burst;
+}
+
+/**
+ * @brief Time to wait before a datagram of @p bytes conforms.
+ *
+ * A datagram conforms once the schedule, including its own transmission
+ * time, runs at most burst / rate ahead of @p now. One larger than the
+ * bucket waits until the bucket is full.
+ *
+ * @param bytes Datagram size.
+ * @param now Current time.
+ * @return Zero if the datagram may be sent now.
+ */
+std::chrono::nanoseconds send_pacer::delay(std::size_t bytes, clock::time_point now) const
+{
+  if (m_rate == 0)
+  {
+    return std::chrono::nanoseconds(0);
+  }
+  const auto length = interval(bytes);
+  const auto ready  = length < m_tolerance ? m_next + length - m_tolerance : m_next;
+  return ready > now ? std::chrono::duration_cast<std::chrono::nanoseconds>(ready - now)
+                     : std::chrono::nanoseconds(0);
+}
+
+/**
+ * @brief Account for a datagram and return its evenly spaced departure.
+ *
+ * @param bytes Datagram size.
+ * @param now Current time.
+ * @return Departure time, never earlier than @p now; equal to @p now when
+ * pacing is disabled.
+ */
+send_pacer::clock::time_point send_pacer::consume(std::size_t bytes, clock::time_point now)
+{
+  if (m_rate == 0)
+  {
+    return now;
+  }
+  const clock::time_point departure = std::max(now, m_next);
+  m_next = departure + interval(bytes);
+  return departure;
+}
+
+/**
+ * @brief Return the credit of a consumed datagram that was not sent.
+ *
+ * Refunds must come in reverse order of consume() to restore the exact
+ * schedule.
+ *
+ * @param bytes Size passed to consume().
+ */
+void send_pacer::refund(std::size_t bytes)
+{
+  if (m_rate > 0)
+  {
+    m_next -= interval(bytes);
+  }
+}
+
+/**
+ * @brief Transmission time of @p bytes at the configured rate, rounded up.
+ */
+std::chrono::nanoseconds send_pacer::interval(std::size_t bytes) const
+{
+  if (m_rate == 0)
+  {
+    return std::chrono::nanoseconds(0);
+  }
+  // Split the division so bytes * 1e9 cannot overflow
+  const std::uint64_t whole = bytes / m_rate;
+  const std::uint64_t rest  = bytes % m_rate;
+  const std::uint64_t nanoseconds =
+      whole * NANOSECONDS_PER_SECOND + (rest * NANOSECONDS_PER_SECOND + m_rate - 1) / m_rate;
+  return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(nanoseconds));
+}
+
+} // namespace fb
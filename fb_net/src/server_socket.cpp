@@ -1,7 +1,10 @@
 #include <fb/server_socket.h>
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <stdexcept>
 #include <system_error>
+#include <thread>
 #include <utility>
 
 #ifdef _WIN32
@@ -10,11 +13,109 @@
 #else
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 #endif
 
 namespace fb {
 
+#ifndef _WIN32
+namespace {
+
+/// Byte sent with the descriptor and echoed back as acknowledgement
+constexpr char HANDOFF_MARKER = 'L';
+
+/// Closes a raw descriptor on scope exit unless released
+struct fd_guard
+{
+  int fd;
+
+  explicit fd_guard(int descriptor) : fd(descriptor) {}
+  ~fd_guard()
+  {
+    if (fd >= 0)
+    {
+      ::close(fd);
+    }
+  }
+  fd_guard(const fd_guard &)            = delete;
+  fd_guard &operator=(const fd_guard &) = delete;
+
+  int release() noexcept
+  {
+    const int descriptor = fd;
+    fd                   = -1;
+    return descriptor;
+  }
+};
+
+/**
+ * @brief Build the address of a Unix domain socket path.
+ *
+ * @throws std::invalid_argument If the path is empty or too long.
+ */
+sockaddr_un unix_address(const std::string &path)
+{
+  sockaddr_un address{};
+  if (path.empty() || path.size() >= sizeof(address.sun_path))
+  {
+    throw std::invalid_argument("Invalid Unix socket path: " + path);
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  return address;
+}
+
+/**
+ * @brief Open a Unix domain stream socket.
+ *
+ * @throws std::system_error On failure.
+ */
+int open_unix_socket()
+{
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    socket_base::error("Failed to create Unix socket");
+  }
+  return fd;
+}
+
+/**
+ * @brief Wait until a descriptor is ready or the deadline passes.
+ *
+ * @throws std::system_error With errc::timed_out when the deadline passes.
+ */
+void wait_ready(int fd, short events, std::chrono::steady_clock::time_point deadline,
+                const char *what)
+{
+  while (true)
+  {
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0)
+    {
+      throw std::system_error(std::make_error_code(std::errc::timed_out), what);
+    }
+
+    pollfd entry{fd, events, 0};
+    const int ready = ::poll(&entry, 1, static_cast<int>(remaining.count()));
+    if (ready > 0)
+    {
+      return;
+    }
+    if (ready < 0 && errno != EINTR)
+    {
+      socket_base::error(what);
+    }
+  }
+}
+
+} // namespace
+#endif
+
 /**
  * @brief Default constructor creates an uninitialized TCP server socket
  */
@@ -103,6 +204,48 @@ server_socket &server_socket::operator=(server_socket &&other) noexcept
   return *this;
 }
 
+/**
+ * @brief Wrap an already listening descriptor
+ * @param sockfd Descriptor to take ownership of
+ */
+server_socket::server_socket(adopt_tag, socket_t sockfd) :
+  socket_base(sockfd),
+  m_backlog(DEFAULT_BACKLOG)
+{
+  set_connected(false);
+}
+
+/**
+ * @brief Take ownership of a listening socket created elsewhere
+ *
+ * Use this for descriptors inherited across exec() (e.g. passed by a
+ * supervisor) or received with receive_listener().
+ *
+ * @param sockfd Listening socket descriptor; owned by the result
+ * @return Server socket accepting on the descriptor
+ * @throws std::invalid_argument If the descriptor is not a listening socket
+ */
+server_socket server_socket::adopt(socket_t sockfd)
+{
+  if (sockfd == INVALID_SOCKET_VALUE)
+  {
+    throw std::invalid_argument("Invalid socket descriptor");
+  }
+
+#ifdef SO_ACCEPTCONN
+  int listening    = 0;
+  socklen_t length = sizeof(listening);
+  if (::getsockopt(sockfd, SOL_SOCKET, SO_ACCEPTCONN,
+                   reinterpret_cast<char *>(&listening), &length) != 0 ||
+      listening == 0)
+  {
+    throw std::invalid_argument("Descriptor is not a listening socket");
+  }
+#endif
+
+  return server_socket(adopt_tag{}, sockfd);
+}
+
 /**
  * @brief Bind server socket to local address
  * @param address Local address to bind to
@@ -205,7 +348,20 @@ server_socket::accept_connection(socket_address &client_address,
   }
 
   // Now accept should not block since we know a connection is available
-  return accept_connection(client_address);
+  try
+  {
+    return accept_connection(client_address);
+  }
+  catch (const std::system_error &ex)
+  {
+    // A non-blocking listener shared with another process lost the race
+    if (ex.code() == std::errc::resource_unavailable_try_again)
+    {
+      throw std::system_error(std::make_error_code(std::errc::timed_out),
+                              "Accept operation timed out");
+    }
+    throw;
+  }
 }
 
 /**
@@ -330,6 +486,186 @@ int server_socket::queue_size() const
   return -1;
 }
 
+/**
+ * @brief Pass the listening socket to another process
+ *
+ * Connects to the Unix socket a receiver opened with receive_listener() and
+ * sends the descriptor with SCM_RIGHTS. Both processes then share one
+ * listening socket and its accept queue, so no connection is refused while
+ * the sender winds down. The call returns once the receiver has
+ * acknowledged; this socket stays open until closed.
+ *
+ * @param unix_path Path the receiver is listening on (retried until it exists)
+ * @param timeout Maximum time to wait for the receiver
+ * @throws std::system_error On failure, errc::timed_out if no receiver answers
+ * @throws std::runtime_error On platforms without Unix domain sockets
+ */
+void server_socket::send_listener(const std::string &unix_path,
+                                  const std::chrono::milliseconds &timeout) const
+{
+  check_initialized();
+
+#ifdef _WIN32
+  (void)unix_path;
+  (void)timeout;
+  throw std::runtime_error("Listener hand-off requires Unix domain sockets");
+#else
+  const sockaddr_un address = unix_address(unix_path);
+  const auto deadline       = std::chrono::steady_clock::now() + timeout;
+
+  // The receiver may still be starting up
+  fd_guard channel(open_unix_socket());
+  while (::connect(channel.fd, reinterpret_cast<const sockaddr *>(&address),
+                   sizeof(address)) != 0)
+  {
+    const int code = errno;
+    if ((code != ENOENT && code != ECONNREFUSED) ||
+        std::chrono::steady_clock::now() >= deadline)
+    {
+      error(code, "Failed to connect to listener receiver " + unix_path);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ::close(channel.release());
+    channel.fd = open_unix_socket();
+  }
+
+  char marker = HANDOFF_MARKER;
+  iovec payload{&marker, 1};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+  msghdr message{};
+  message.msg_iov        = &payload;
+  message.msg_iovlen     = 1;
+  message.msg_control    = control;
+  message.msg_controllen = sizeof(control);
+
+  cmsghdr *header   = CMSG_FIRSTHDR(&message);
+  header->cmsg_level = SOL_SOCKET;
+  header->cmsg_type  = SCM_RIGHTS;
+  header->cmsg_len   = CMSG_LEN(sizeof(int));
+  const int listener = sockfd();
+  std::memcpy(CMSG_DATA(header), &listener, sizeof(int));
+
+  int flags = 0;
+#ifdef MSG_NOSIGNAL
+  flags = MSG_NOSIGNAL;
+#endif
+  if (::sendmsg(channel.fd, &message, flags) != 1)
+  {
+    error("Failed to send listener to " + unix_path);
+  }
+
+  wait_ready(channel.fd, POLLIN, deadline, "Listener hand-off was not acknowledged");
+  char ack = 0;
+  if (::recv(channel.fd, &ack, 1, 0) != 1 || ack != HANDOFF_MARKER)
+  {
+    throw std::runtime_error("Listener receiver closed without acknowledging");
+  }
+#endif
+}
+
+/**
+ * @brief Wait for another process to pass its listening socket
+ *
+ * Listens on @p unix_path (replacing a stale socket file), accepts one
+ * send_listener() call, acknowledges it and removes the path again.
+ *
+ * A listener shared this way is usually non-blocking (tcp_server switches
+ * it before handing it off); use the accept_connection() overloads with a
+ * timeout, which report a lost race as a timeout.
+ *
+ * @param unix_path Path to listen on
+ * @param timeout Maximum time to wait for the sender
+ * @return Server socket sharing the sender's listener
+ * @throws std::system_error On failure, errc::timed_out if nothing arrives
+ * @throws std::runtime_error On platforms without Unix domain sockets
+ */
+server_socket server_socket::receive_listener(const std::string &unix_path,
+                                              const std::chrono::milliseconds &timeout)
+{
+#ifdef _WIN32
+  (void)unix_path;
+  (void)timeout;
+  throw std::runtime_error("Listener hand-off requires Unix domain sockets");
+#else
+  const sockaddr_un address = unix_address(unix_path);
+  const auto deadline       = std::chrono::steady_clock::now() + timeout;
+
+  fd_guard rendezvous(open_unix_socket());
+  ::unlink(unix_path.c_str());
+  if (::bind(rendezvous.fd, reinterpret_cast<const sockaddr *>(&address),
+             sizeof(address)) != 0)
+  {
+    error("Failed to bind " + unix_path);
+  }
+
+  // Remove the path whichever way this returns
+  struct path_guard
+  {
+    const std::string &path;
+    ~path_guard() { ::unlink(path.c_str()); }
+  } unlink_on_exit{unix_path};
+
+  if (::listen(rendezvous.fd, 1) != 0)
+  {
+    error("Failed to listen on " + unix_path);
+  }
+
+  wait_ready(rendezvous.fd, POLLIN, deadline, "No listener was handed off");
+  fd_guard channel(::accept(rendezvous.fd, nullptr, nullptr));
+  if (channel.fd < 0)
+  {
+    error("Failed to accept listener sender");
+  }
+
+  char marker = 0;
+  iovec payload{&marker, 1};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+  msghdr message{};
+  message.msg_iov        = &payload;
+  message.msg_iovlen     = 1;
+  message.msg_control    = control;
+  message.msg_controllen = sizeof(control);
+
+  wait_ready(channel.fd, POLLIN, deadline, "No listener was handed off");
+  if (::recvmsg(channel.fd, &message, 0) != 1 || marker != HANDOFF_MARKER)
+  {
+    throw std::runtime_error("Malformed listener hand-off message");
+  }
+
+  int received = -1;
+  for (cmsghdr *header = CMSG_FIRSTHDR(&message); header;
+       header          = CMSG_NXTHDR(&message, header))
+  {
+    if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS)
+    {
+      std::memcpy(&received, CMSG_DATA(header), sizeof(int));
+    }
+  }
+  if (received < 0)
+  {
+    throw std::runtime_error("Listener hand-off carried no descriptor");
+  }
+
+  fd_guard listener(received);
+  server_socket result = adopt(listener.fd);
+  listener.release();
+
+  int flags = 0;
+#ifdef MSG_NOSIGNAL
+  flags = MSG_NOSIGNAL;
+#endif
+  // The sender may stop accepting as soon as it sees this
+  const char ack = HANDOFF_MARKER;
+  if (::send(channel.fd, &ack, 1, flags) != 1)
+  {
+    error("Failed to acknowledge listener hand-off");
+  }
+  return result;
+#endif
+}
+
 /**
  * @brief Initialize TCP server socket with specific address family
  * @param family Address family (IPv4 or IPv6)
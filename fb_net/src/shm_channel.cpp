@@ -0,0 +1,956 @@
+#include <fb/shm_channel.h>
+#include <fb/detail/atomic_utils.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+constexpr std::uint64_t CHANNEL_MAGIC   = 0x66625f73686d3031ull; // "fb_shm01"
+constexpr std::uint32_t CHANNEL_VERSION = 1;
+
+/// Wakeup sockets are Unix domain datagram sockets where those exist
+#ifdef _WIN32
+constexpr fb::socket_address::Family WAKEUP_FAMILY = fb::socket_address::IPv4;
+#else
+constexpr fb::socket_address::Family WAKEUP_FAMILY = fb::socket_address::UNIX_LOCAL;
+#endif
+
+std::size_t round_up(std::size_t value, std::size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+void validate_name(const std::string &name)
+{
+  if (name.empty() || name.size() > fb::shm_channel::MAX_NAME_LENGTH ||
+      name.find('/') != std::string::npos || name.find('\0') != std::string::npos)
+  {
+    throw std::invalid_argument("Invalid shared-memory channel name");
+  }
+}
+
+/**
+ * @brief Address of a channel's wakeup socket; abstract on Linux, so no
+ * file is left behind.
+ */
+fb::socket_address wakeup_address(const std::string &name)
+{
+#ifdef __linux__
+  return fb::socket_address(fb::socket_address::UNIX_LOCAL, "@fb_shm." + name);
+#elif defined(_WIN32)
+  (void)name;
+  return fb::socket_address();
+#else
+  return fb::socket_address(fb::socket_address::UNIX_LOCAL,
+                            "/tmp/fb_shm." + name + ".sock");
+#endif
+}
+
+[[noreturn]] void throw_timeout(const char *what)
+{
+  throw std::system_error(std::make_error_code(std::errc::timed_out), what);
+}
+
+} // namespace
+
+namespace fb
+{
+
+/**
+ * @brief Layout at the start of the mapping, shared by every process.
+ *
+ * The indices each get a cache line; the wakeup state shares one with the
+ * flags senders check on every send.
+ */
+struct shm_channel::shared_header
+{
+  std::atomic<std::uint64_t> magic;  ///< CHANNEL_MAGIC once initialised
+  std::uint32_t version;             ///< CHANNEL_VERSION
+  std::uint32_t single_producer;     ///< Created for one sender
+  std::uint64_t capacity;            ///< Slots in the ring (power of two)
+  std::uint64_t slot_size;           ///< Bytes per slot
+  std::uint64_t max_message_size;    ///< Largest payload
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint64_t> tail; ///< Next position senders claim
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint64_t> head; ///< Next position the receiver reads
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<std::uint32_t> waiting; ///< Receiver wants a wakeup
+  std::atomic<std::uint32_t> closed;    ///< Receiver closed the channel
+  std::atomic<std::uint32_t> producers; ///< Attached senders
+  std::atomic<std::uint64_t> wakeups;   ///< Wakeup datagrams sent
+};
+
+/**
+ * @brief Header of one message slot; the payload follows it.
+ */
+struct shm_channel::slot_header
+{
+  std::atomic<std::uint64_t> sequence; ///< position + 1 once published
+  std::uint64_t length;                ///< Payload bytes
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                  std::atomic<std::uint32_t>::is_always_lock_free,
+              "Shared-memory channels need address-free atomics");
+
+/**
+ * @brief Create a closed channel.
+ */
+shm_channel::shm_channel() :
+  m_header(nullptr),
+  m_slots(nullptr),
+  m_mapping_size(0),
+  m_mask(0),
+  m_slot_size(0),
+  m_receiver(false),
+  m_single_producer(false),
+  m_wakeups_seen(0),
+  m_wakeup(WAKEUP_FAMILY),
+  m_timeout(DEFAULT_TIMEOUT),
+  m_spin_count(DEFAULT_SPIN_COUNT)
+{
+}
+
+/**
+ * @brief Move constructor
+ */
+shm_channel::shm_channel(shm_channel &&other) noexcept :
+  m_header(std::exchange(other.m_header, nullptr)),
+  m_slots(std::exchange(other.m_slots, nullptr)),
+  m_mapping_size(std::exchange(other.m_mapping_size, 0)),
+  m_mask(other.m_mask),
+  m_slot_size(other.m_slot_size),
+  m_receiver(std::exchange(other.m_receiver, false)),
+  m_single_producer(other.m_single_producer),
+  m_wakeups_seen(other.m_wakeups_seen),
+  m_name(std::move(other.m_name)),
+  m_wakeup(std::move(other.m_wakeup)),
+  m_wakeup_address(std::move(other.m_wakeup_address)),
+  m_timeout(other.m_timeout),
+  m_spin_count(other.m_spin_count)
+{
+}
+
+/**
+ * @brief Move assignment operator; closes the channel held before.
+ */
+shm_channel &shm_channel::operator=(shm_channel &&other) noexcept
+{
+  if (this != &other)
+  {
+    try
+    {
+      close();
+    }
+    catch (...)
+    {
+      // Ignore cleanup errors
+    }
+    m_header          = std::exchange(other.m_header, nullptr);
+    m_slots           = std::exchange(other.m_slots, nullptr);
+    m_mapping_size    = std::exchange(other.m_mapping_size, 0);
+    m_mask            = other.m_mask;
+    m_slot_size       = other.m_slot_size;
+    m_receiver        = std::exchange(other.m_receiver, false);
+    m_single_producer = other.m_single_producer;
+    m_wakeups_seen    = other.m_wakeups_seen;
+    m_name            = std::move(other.m_name);
+    m_wakeup          = std::move(other.m_wakeup);
+    m_wakeup_address  = std::move(other.m_wakeup_address);
+    m_timeout         = other.m_timeout;
+    m_spin_count      = other.m_spin_count;
+  }
+  return *this;
+}
+
+/**
+ * @brief Destructor; closes the channel.
+ */
+shm_channel::~shm_channel()
+{
+  try
+  {
+    close();
+  }
+  catch (...)
+  {
+    // Ignore cleanup errors
+  }
+}
+
+/**
+ * @brief Create a channel as its receiving end.
+ *
+ * Replaces any channel of the same name left by a previous receiver. The
+ * channel is removed again when the receiver closes it.
+ *
+ * @param name Channel name: up to MAX_NAME_LENGTH characters, no '/'.
+ * @param capacity Messages the ring holds; rounded up to a power of two
+ * (at least 2).
+ * @param max_message_size Largest message senders may send.
+ * @param single_producer Allow only one attached sender, which then
+ * publishes without a compare-and-swap.
+ * @return The receiving end.
+ * @throws std::invalid_argument On a bad name or size.
+ * @throws std::system_error If the shared memory cannot be created.
+ * @throws std::runtime_error On platforms without POSIX shared memory.
+ */
+shm_channel shm_channel::create(const std::string &name,
+                                std::size_t capacity,
+                                std::size_t max_message_size,
+                                bool single_producer)
+{
+  validate_name(name);
+  if (capacity == 0 || capacity > (std::size_t{1} << 30))
+  {
+    throw std::invalid_argument("Channel capacity must be between 1 and 2^30");
+  }
+  if (max_message_size == 0 ||
+      max_message_size > static_cast<std::size_t>(std::numeric_limits<int>::max() / 2))
+  {
+    throw std::invalid_argument("Invalid maximum message size");
+  }
+
+#ifdef _WIN32
+  (void)single_producer;
+  throw std::runtime_error("Shared-memory channels require POSIX shared memory");
+#else
+  std::size_t slots = 2;
+  while (slots < capacity)
+  {
+    slots <<= 1;
+  }
+  const std::size_t slot_size =
+      round_up(sizeof(slot_header) + max_message_size, detail::CACHE_LINE_SIZE);
+  const std::size_t slots_offset =
+      round_up(sizeof(shared_header), detail::CACHE_LINE_SIZE);
+  if (slot_size > (std::numeric_limits<std::size_t>::max() - slots_offset) / slots)
+  {
+    throw std::invalid_argument("Channel too large");
+  }
+  const std::size_t size = slots_offset + slots * slot_size;
+
+  shm_channel channel;
+  channel.m_name            = name;
+  channel.m_receiver        = true;
+  channel.m_single_producer = single_producer;
+  channel.m_mask            = slots - 1;
+  channel.m_slot_size       = slot_size;
+  channel.m_wakeup_address  = wakeup_address(name);
+
+  // The wakeup socket exists before senders can find the channel
+  channel.m_wakeup = udp_socket(channel.m_wakeup_address);
+  channel.m_wakeup.set_blocking(false);
+
+  const std::string path = "/" + name;
+  ::shm_unlink(path.c_str());
+  const int fd = ::shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0)
+  {
+    socket_base::error("shm_open");
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    const int code = errno;
+    ::close(fd);
+    ::shm_unlink(path.c_str());
+    socket_base::error(code, "ftruncate");
+  }
+  void *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int map_error = errno;
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    ::shm_unlink(path.c_str());
+    socket_base::error(map_error, "mmap");
+  }
+  channel.m_mapping_size = size;
+  channel.m_header       = new (mapping) shared_header();
+  channel.m_slots        = static_cast<unsigned char *>(mapping) + slots_offset;
+
+  shared_header &header   = *channel.m_header;
+  header.version          = CHANNEL_VERSION;
+  header.single_producer  = single_producer ? 1u : 0u;
+  header.capacity         = slots;
+  header.slot_size        = slot_size;
+  header.max_message_size = max_message_size;
+  header.waiting.store(1, std::memory_order_relaxed); // Idle receivers start armed
+  for (std::size_t i = 0; i < slots; ++i)
+  {
+    new (&channel.slot(i)) slot_header();
+    channel.slot(i).sequence.store(i, std::memory_order_relaxed);
+  }
+  header.magic.store(CHANNEL_MAGIC, std::memory_order_release);
+  return channel;
+#endif
+}
+
+/**
+ * @brief Attach to a channel as a sending end.
+ *
+ * @param name Name the receiver passed to create().
+ * @return A sending end.
+ * @throws std::system_error If no such channel exists.
+ * @throws std::runtime_error If the channel is not a valid shm_channel.
+ * @throws std::logic_error If a single_producer channel already has a sender.
+ */
+shm_channel shm_channel::attach(const std::string &name)
+{
+  validate_name(name);
+
+#ifdef _WIN32
+  throw std::runtime_error("Shared-memory channels require POSIX shared memory");
+#else
+  const std::string path = "/" + name;
+  const int fd           = ::shm_open(path.c_str(), O_RDWR, 0);
+  if (fd < 0)
+  {
+    socket_base::error("shm_open");
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0)
+  {
+    const int code = errno;
+    ::close(fd);
+    socket_base::error(code, "fstat");
+  }
+  const auto size = static_cast<std::size_t>(info.st_size);
+  if (size < sizeof(shared_header))
+  {
+    ::close(fd);
+    throw std::runtime_error("Shared memory is not an initialised channel");
+  }
+  void *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const int map_error = errno;
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+  {
+    socket_base::error(map_error, "mmap");
+  }
+
+  // Only a registered sender is handed to a channel, whose close()
+  // unregisters it; until then failures unmap here
+  shared_header &header = *static_cast<shared_header *>(mapping);
+  const std::size_t slots_offset =
+      round_up(sizeof(shared_header), detail::CACHE_LINE_SIZE);
+  if (header.magic.load(std::memory_order_acquire) != CHANNEL_MAGIC ||
+      header.version != CHANNEL_VERSION ||
+      header.slot_size == 0 || header.capacity == 0 ||
+      slots_offset + header.capacity * header.slot_size != size)
+  {
+    ::munmap(mapping, size);
+    throw std::runtime_error("Shared memory is not an initialised channel");
+  }
+  if (header.closed.load(std::memory_order_acquire) != 0)
+  {
+    ::munmap(mapping, size);
+    throw std::system_error(std::make_error_code(std::errc::connection_refused),
+                            "Shared-memory channel is closed");
+  }
+  if (header.producers.fetch_add(1, std::memory_order_acq_rel) != 0 &&
+      header.single_producer != 0)
+  {
+    header.producers.fetch_sub(1, std::memory_order_acq_rel);
+    ::munmap(mapping, size);
+    throw std::logic_error("Single-producer channel already has a sender");
+  }
+
+  shm_channel channel;
+  channel.m_header          = &header;
+  channel.m_mapping_size    = size;
+  channel.m_name            = name;
+  channel.m_slots           = static_cast<unsigned char *>(mapping) + slots_offset;
+  channel.m_mask            = header.capacity - 1;
+  channel.m_slot_size       = header.slot_size;
+  channel.m_single_producer = header.single_producer != 0;
+  channel.m_wakeup_address  = wakeup_address(name);
+  channel.m_wakeup.set_blocking(false);
+  return channel;
+#endif
+}
+
+/**
+ * @brief Detach from the channel; the receiver also removes it.
+ *
+ * Senders still attached when the receiver closes get
+ * std::errc::connection_refused from their next send.
+ */
+void shm_channel::close()
+{
+  if (m_header == nullptr)
+  {
+    return;
+  }
+
+#ifndef _WIN32
+  if (m_receiver)
+  {
+    m_header->closed.store(1, std::memory_order_release);
+    ::shm_unlink(("/" + m_name).c_str());
+  }
+  else
+  {
+    m_header->producers.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  ::munmap(m_header, m_mapping_size);
+#endif
+
+  m_header       = nullptr;
+  m_slots        = nullptr;
+  m_mapping_size = 0;
+  m_wakeup.close();
+#if !defined(_WIN32) && !defined(__linux__)
+  if (m_receiver)
+  {
+    ::unlink(m_wakeup_address.path().c_str());
+  }
+#endif
+  m_receiver = false;
+}
+
+/**
+ * @brief Send one message, waiting up to get_timeout() for ring space.
+ *
+ * @param buffer Message bytes.
+ * @param length Message size; at most max_message_size().
+ * @return Number of bytes sent (always @p length).
+ * @throws std::system_error std::errc::message_size for oversized messages,
+ * std::errc::timed_out if the ring stays full, std::errc::connection_refused
+ * once the receiver has closed.
+ * @throws std::logic_error If this is not a sending end.
+ */
+int shm_channel::send(const void *buffer, std::size_t length)
+{
+  return send_with_timeout(buffer, length, m_timeout);
+}
+
+/**
+ * @brief Send a string as one message
+ * @param message Message to send
+ * @return Number of bytes sent
+ * @throws std::system_error, std::logic_error (see send())
+ */
+int shm_channel::send(const std::string &message)
+{
+  return send(message.data(), message.size());
+}
+
+/**
+ * @brief Send one message, waiting up to @p timeout for ring space.
+ *
+ * The wait spins, then yields the processor; receivers do not signal
+ * senders.
+ *
+ * @param buffer Message bytes.
+ * @param length Message size.
+ * @param timeout Longest wait while the ring is full.
+ * @return Number of bytes sent.
+ * @throws std::system_error, std::logic_error (see send())
+ */
+int shm_channel::send_with_timeout(const void *buffer,
+                                   std::size_t length,
+                                   const std::chrono::milliseconds &timeout)
+{
+  try
+  {
+    if (!try_send(buffer, length))
+    {
+      const auto deadline = std::chrono::steady_clock::now() + timeout;
+      detail::spin_wait spinner;
+      do
+      {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+          throw_timeout("Send timeout");
+        }
+        spinner.wait();
+      } while (!try_send(buffer, length));
+    }
+    return static_cast<int>(length);
+  }
+  catch (const std::system_error &ex)
+  {
+    if (ex.code() == std::make_error_code(std::errc::timed_out) &&
+        onTimeoutError.has_slots())
+    {
+      onTimeoutError.emit(ex.what());
+    }
+    if (onSendError.has_slots())
+    {
+      onSendError.emit(ex.what());
+    }
+    throw;
+  }
+}
+
+/**
+ * @brief Send one message if the ring has room.
+ *
+ * @param buffer Message bytes.
+ * @param length Message size.
+ * @return False (and nothing sent) if the ring is full.
+ * @throws std::system_error, std::logic_error (see send())
+ */
+bool shm_channel::try_send(const void *buffer, std::size_t length)
+{
+  require_sender();
+  validate_buffer(buffer, length);
+  if (length > max_message_size())
+  {
+    throw std::system_error(std::make_error_code(std::errc::message_size),
+                            "Message exceeds the channel's maximum size");
+  }
+  if (m_header->closed.load(std::memory_order_relaxed) != 0)
+  {
+    throw std::system_error(std::make_error_code(std::errc::connection_refused),
+                            "Shared-memory channel is closed");
+  }
+
+  if (!push(buffer, length))
+  {
+    return false;
+  }
+  if (onDataSent.has_slots())
+  {
+    onDataSent.emit(buffer, length);
+  }
+  return true;
+}
+
+/**
+ * @brief Receive one message, waiting as long as it takes.
+ *
+ * @param buffer Destination; a longer message is truncated to @p length.
+ * @param length Buffer size.
+ * @return Number of bytes stored.
+ * @throws std::logic_error If this is not the receiving end.
+ */
+int shm_channel::receive(void *buffer, std::size_t length)
+{
+  require_receiver();
+  validate_buffer(buffer, length);
+  while (!wait_readable(std::chrono::milliseconds(1000)))
+  {
+  }
+  return try_receive(buffer, length);
+}
+
+/**
+ * @brief Receive one message into a string
+ * @param message Receives the message
+ * @param max_length Longest message kept; longer ones are truncated
+ * @return Number of bytes received
+ * @throws std::logic_error If this is not the receiving end
+ */
+int shm_channel::receive(std::string &message, std::size_t max_length)
+{
+  message.resize(max_length);
+  const int received = receive(&message[0], max_length);
+  message.resize(static_cast<std::size_t>(received));
+  return received;
+}
+
+/**
+ * @brief Receive one message, waiting up to @p timeout.
+ *
+ * @param buffer Destination; a longer message is truncated.
+ * @param length Buffer size.
+ * @param timeout Longest wait.
+ * @return Number of bytes stored.
+ * @throws std::system_error std::errc::timed_out if nothing arrives.
+ * @throws std::logic_error If this is not the receiving end.
+ */
+int shm_channel::receive_with_timeout(void *buffer,
+                                      std::size_t length,
+                                      const std::chrono::milliseconds &timeout)
+{
+  require_receiver();
+  validate_buffer(buffer, length);
+  if (!wait_readable(timeout))
+  {
+    if (onTimeoutError.has_slots())
+    {
+      onTimeoutError.emit("Receive timeout");
+    }
+    throw_timeout("Receive timeout");
+  }
+  return try_receive(buffer, length);
+}
+
+/**
+ * @brief Receive one message if one is queued.
+ *
+ * Finding the ring empty arms wakeup_socket() for the next message.
+ *
+ * @param buffer Destination; a longer message is truncated.
+ * @param length Buffer size.
+ * @return Number of bytes stored, or -1 if the ring is empty.
+ * @throws std::logic_error If this is not the receiving end.
+ */
+int shm_channel::try_receive(void *buffer, std::size_t length)
+{
+  require_receiver();
+  validate_buffer(buffer, length);
+
+  int received = pop(buffer, length);
+  if (received < 0)
+  {
+    arm_wakeup();
+    received = pop(buffer, length);
+  }
+  if (received >= 0 && onDataReceived.has_slots())
+  {
+    onDataReceived.emit(buffer, static_cast<std::size_t>(received));
+  }
+  return received;
+}
+
+/**
+ * @brief Wait until a message is queued.
+ *
+ * @param timeout Longest wait; 0 only checks.
+ * @return True if a message can be received without waiting.
+ * @throws std::logic_error If this is not the receiving end.
+ */
+bool shm_channel::has_data_available(const std::chrono::milliseconds &timeout)
+{
+  require_receiver();
+  return wait_readable(timeout);
+}
+
+/**
+ * @brief Socket that becomes readable when messages arrive at an empty ring.
+ *
+ * For poll_set::add(); only the receiving end has one.
+ *
+ * @throws std::logic_error If this is not the receiving end.
+ */
+const socket_base &shm_channel::wakeup_socket() const
+{
+  require_receiver();
+  return m_wakeup;
+}
+
+/**
+ * @brief Set how long send() waits while the ring is full.
+ */
+void shm_channel::set_timeout(const std::chrono::milliseconds &timeout)
+{
+  m_timeout = timeout;
+}
+
+/**
+ * @brief Longest send() wait on a full ring.
+ */
+std::chrono::milliseconds shm_channel::get_timeout() const { return m_timeout; }
+
+/**
+ * @brief Set how often a waiting receiver checks the ring before parking.
+ *
+ * Spinning keeps the hop sub-microsecond when messages follow each other
+ * closely, at the price of a busy core while idle; 0 parks at once.
+ */
+void shm_channel::set_spin_count(std::size_t count) { m_spin_count = count; }
+
+/**
+ * @brief Ring checks made before parking.
+ */
+std::size_t shm_channel::get_spin_count() const { return m_spin_count; }
+
+/**
+ * @brief Check whether the channel is open.
+ */
+bool shm_channel::is_connected() const { return m_header != nullptr; }
+
+/**
+ * @brief Check whether the channel is closed.
+ */
+bool shm_channel::is_closed() const { return m_header == nullptr; }
+
+/**
+ * @brief Check whether this is the receiving end.
+ */
+bool shm_channel::is_receiver() const { return m_receiver; }
+
+/**
+ * @brief Channel name.
+ */
+const std::string &shm_channel::name() const { return m_name; }
+
+/**
+ * @brief Messages the ring holds (0 when closed).
+ */
+std::size_t shm_channel::capacity() const
+{
+  return m_header != nullptr ? m_mask + 1 : 0;
+}
+
+/**
+ * @brief Largest message the channel carries (0 when closed).
+ */
+std::size_t shm_channel::max_message_size() const
+{
+  return m_header != nullptr ? m_header->max_message_size : 0;
+}
+
+/**
+ * @brief Messages claimed by senders and not yet received.
+ */
+std::size_t shm_channel::pending() const
+{
+  if (m_header == nullptr)
+  {
+    return 0;
+  }
+  const std::uint64_t head = m_header->head.load(std::memory_order_relaxed);
+  const std::uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+  return tail > head ? tail - head : 0;
+}
+
+/**
+ * @brief Slot for a ring position.
+ */
+shm_channel::slot_header &shm_channel::slot(std::uint64_t position) const
+{
+  return *reinterpret_cast<slot_header *>(
+      m_slots + (position & m_mask) * m_slot_size);
+}
+
+/**
+ * @brief Claim a slot, copy the message in and publish it.
+ *
+ * @return False if the ring is full.
+ */
+bool shm_channel::push(const void *buffer, std::size_t length)
+{
+  shared_header &header  = *m_header;
+  std::uint64_t position = header.tail.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    const std::uint64_t sequence =
+        slot(position).sequence.load(std::memory_order_acquire);
+    const auto lag = static_cast<std::int64_t>(sequence - position);
+    if (lag == 0)
+    {
+      if (m_single_producer)
+      {
+        header.tail.store(position + 1, std::memory_order_relaxed);
+        break;
+      }
+      if (header.tail.compare_exchange_weak(position, position + 1,
+                                            std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (lag < 0)
+    {
+      return false;
+    }
+    else
+    {
+      position = header.tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot_header &target = slot(position);
+  target.length       = length;
+  if (length > 0)
+  {
+    std::memcpy(reinterpret_cast<unsigned char *>(&target + 1), buffer, length);
+  }
+  target.sequence.store(position + 1, std::memory_order_release);
+
+  // Pairs with the fence in arm_wakeup(): either the receiver sees this
+  // message when it re-checks, or this sees the receiver waiting
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header.waiting.load(std::memory_order_relaxed) != 0 &&
+      header.waiting.exchange(0, std::memory_order_relaxed) != 0)
+  {
+    ring_wakeup();
+  }
+  return true;
+}
+
+/**
+ * @brief Copy out the message at the head and release its slot.
+ *
+ * @return Bytes stored, or -1 if the ring is empty.
+ */
+int shm_channel::pop(void *buffer, std::size_t length)
+{
+  shared_header &header        = *m_header;
+  const std::uint64_t position = header.head.load(std::memory_order_relaxed);
+  slot_header &source          = slot(position);
+  if (source.sequence.load(std::memory_order_acquire) != position + 1)
+  {
+    return -1;
+  }
+
+  const std::size_t size =
+      std::min(source.length, length);
+  if (size > 0)
+  {
+    std::memcpy(buffer, reinterpret_cast<const unsigned char *>(&source + 1), size);
+  }
+  source.sequence.store(position + m_mask + 1, std::memory_order_release);
+  header.head.store(position + 1, std::memory_order_relaxed);
+  return static_cast<int>(size);
+}
+
+/**
+ * @brief Check whether the head slot holds a published message.
+ */
+bool shm_channel::ready() const
+{
+  const std::uint64_t position = m_header->head.load(std::memory_order_relaxed);
+  return slot(position).sequence.load(std::memory_order_acquire) == position + 1;
+}
+
+/**
+ * @brief Spin, then park on the wakeup socket, until a message is queued.
+ *
+ * @return True if a message is queued.
+ */
+bool shm_channel::wait_readable(const std::chrono::milliseconds &timeout)
+{
+  detail::spin_wait spinner;
+  for (std::size_t i = 0; i < m_spin_count; ++i)
+  {
+    if (ready())
+    {
+      return true;
+    }
+    spinner.wait();
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (;;)
+  {
+    arm_wakeup();
+    if (ready())
+    {
+      return true;
+    }
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0)
+    {
+      return false;
+    }
+    m_wakeup.poll(remaining, socket_base::SELECT_READ);
+  }
+}
+
+/**
+ * @brief Ask senders for a wakeup datagram, consuming those already read.
+ */
+void shm_channel::arm_wakeup()
+{
+  drain_wakeups();
+  if (m_header->waiting.load(std::memory_order_relaxed) == 0)
+  {
+    m_header->waiting.store(1, std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Send the receiver a wakeup datagram (sender side).
+ *
+ * The count goes up first so the receiver never misses a datagram it has
+ * to drain; a failed send takes it back.
+ */
+void shm_channel::ring_wakeup()
+{
+  m_header->wakeups.fetch_add(1, std::memory_order_relaxed);
+  try
+  {
+    const char byte = 0;
+    if (m_wakeup.send_to(&byte, 1, m_wakeup_address) == 1)
+    {
+      return;
+    }
+  }
+  catch (const std::system_error &)
+  {
+    // Receiver's queue full or socket gone; it is awake or closing anyway
+  }
+  m_header->wakeups.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Read the wakeup datagrams senders have sent, without blocking.
+ *
+ * Only makes system calls when the shared count says datagrams are due, so
+ * a receiver polling an empty ring stays in user space.
+ */
+void shm_channel::drain_wakeups()
+{
+  const std::uint64_t sent = m_header->wakeups.load(std::memory_order_relaxed);
+  char byte;
+  socket_address sender(WAKEUP_FAMILY);
+  while (m_wakeups_seen < sent && m_wakeup.available() > 0)
+  {
+    m_wakeup.receive_from(&byte, 1, sender);
+    ++m_wakeups_seen;
+  }
+}
+
+/**
+ * @brief Check that this end is open and attached as a sender
+ * @throws std::logic_error otherwise
+ */
+void shm_channel::require_sender() const
+{
+  if (m_header == nullptr)
+  {
+    throw std::logic_error("shm_channel is not open");
+  }
+  if (m_receiver)
+  {
+    throw std::logic_error("shm_channel receiving end cannot send");
+  }
+}
+
+/**
+ * @brief Check that this end is open and is the receiver
+ * @throws std::logic_error otherwise
+ */
+void shm_channel::require_receiver() const
+{
+  if (m_header == nullptr)
+  {
+    throw std::logic_error("shm_channel is not open");
+  }
+  if (!m_receiver)
+  {
+    throw std::logic_error("shm_channel sending end cannot receive");
+  }
+}
+
+/**
+ * @brief Validate buffer parameters
+ * @throws std::invalid_argument for a null buffer with a non-zero length
+ */
+void shm_channel::validate_buffer(const void *buffer, std::size_t length) const
+{
+  if (buffer == nullptr && length > 0)
+  {
+    throw std::invalid_argument("Buffer cannot be null");
+  }
+}
+
+} // namespace fb
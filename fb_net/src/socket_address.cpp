@@ -1,7 +1,8 @@
 #include <fb/socket_address.h>
 #include <algorithm>
+#include <charconv>
+#include <cstddef>
 #include <cstring>
-#include <sstream>
 #include <stdexcept>
 #include <system_error>
 #include <string>
@@ -45,11 +46,201 @@ std::string format_gai_error(std::string_view host, int error_code)
   return message;
 }
 
+/**
+ * @brief Parse a dotted-decimal IPv4 literal without allocating.
+ *
+ * Accepts exactly what inet_pton(AF_INET) accepts: four decimal octets
+ * without leading zeros.
+ */
+bool parse_ipv4_literal(std::string_view text, struct in_addr &out) noexcept
+{
+  unsigned char octets[4];
+  std::size_t pos = 0;
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i > 0)
+    {
+      if (pos >= text.size() || text[pos] != '.')
+      {
+        return false;
+      }
+      ++pos;
+    }
+
+    const std::size_t start = pos;
+    unsigned int value      = 0;
+    while (pos < text.size() && pos - start < 3 && text[pos] >= '0' &&
+           text[pos] <= '9')
+    {
+      value = value * 10 + static_cast<unsigned int>(text[pos] - '0');
+      ++pos;
+    }
+    const std::size_t digits = pos - start;
+    if (digits == 0 || value > 255 || (digits > 1 && text[start] == '0'))
+    {
+      return false;
+    }
+    octets[i] = static_cast<unsigned char>(value);
+  }
+  if (pos != text.size())
+  {
+    return false;
+  }
+
+  std::memcpy(&out, octets, sizeof(octets));
+  return true;
+}
+
+#ifdef AF_INET6
+/**
+ * @brief Parse a numeric IPv6 literal using a stack buffer.
+ */
+bool parse_ipv6_literal(std::string_view text, struct in6_addr &out) noexcept
+{
+  char buffer[INET6_ADDRSTRLEN];
+  if (text.empty() || text.size() >= sizeof(buffer))
+  {
+    return false;
+  }
+  std::memcpy(buffer, text.data(), text.size());
+  buffer[text.size()] = '\0';
+  return inet_pton(AF_INET6, buffer, &out) == 1;
+}
+#endif
+
+/**
+ * @brief Write an IPv4 address in dotted-decimal form.
+ * @return One past the last character written (at most 15).
+ */
+char *format_ipv4(const struct in_addr &addr, char *out) noexcept
+{
+  unsigned char octets[4];
+  std::memcpy(octets, &addr, sizeof(octets));
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i > 0)
+    {
+      *out++ = '.';
+    }
+    out = std::to_chars(out, out + 3, octets[i]).ptr;
+  }
+  return out;
+}
+
+/**
+ * @brief Parse a decimal port number.
+ * @return False unless @p text is entirely digits with a value up to 65535.
+ */
+bool parse_port_number(std::string_view text, std::uint16_t &port) noexcept
+{
+  unsigned int value = 0;
+  const char *end    = text.data() + text.size();
+  const auto result  = std::from_chars(text.data(), end, value);
+  if (text.empty() || result.ec != std::errc() || result.ptr != end ||
+      value > 65535)
+  {
+    return false;
+  }
+  port = static_cast<std::uint16_t>(value);
+  return true;
+}
+
+/**
+ * @brief Split "host:port" or "[host]:port" into its parts.
+ * @return nullptr on success, otherwise the reason the input is malformed.
+ */
+const char *split_host_and_port(std::string_view host_and_port,
+                                std::string_view &host,
+                                std::string_view &port) noexcept
+{
+  // Check for empty input to avoid UB on front()
+  if (host_and_port.empty())
+  {
+    return "Empty host:port string";
+  }
+
+  // Handle IPv6 addresses in brackets [host]:port
+  if (host_and_port.front() == '[')
+  {
+    auto bracket_pos = host_and_port.find(']');
+    if (bracket_pos == std::string_view::npos)
+    {
+      return "Invalid IPv6 address format";
+    }
+
+    host           = host_and_port.substr(1, bracket_pos - 1);
+
+    auto colon_pos = host_and_port.find(':', bracket_pos);
+    if (colon_pos == std::string_view::npos)
+    {
+      return "Missing port number";
+    }
+
+    port = host_and_port.substr(colon_pos + 1);
+  }
+  else
+  {
+    // IPv4 format host:port
+    auto colon_pos = host_and_port.rfind(':');
+    if (colon_pos == std::string_view::npos)
+    {
+      return "Missing port number";
+    }
+
+    host = host_and_port.substr(0, colon_pos);
+    port = host_and_port.substr(colon_pos + 1);
+  }
+  return nullptr;
+}
+
+#ifdef AF_UNIX
+/// Bytes of a sockaddr_un before the path; an address this short is unnamed
+constexpr socklen_t UNIX_PATH_OFFSET =
+    static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path));
+
+/**
+ * @brief Write a Unix domain address as its path ("@name" when abstract).
+ * @return One past the last character written (at most sizeof(sun_path)).
+ */
+char *format_unix(const struct sockaddr_un &addr, socklen_t length,
+                  char *out) noexcept
+{
+  if (length <= UNIX_PATH_OFFSET)
+  {
+    return out;
+  }
+
+  const std::size_t used = length - UNIX_PATH_OFFSET;
+  if (addr.sun_path[0] == '\0')
+  {
+    *out++ = '@';
+    std::memcpy(out, addr.sun_path + 1, used - 1);
+    return out + used - 1;
+  }
+
+  const std::size_t size = strnlen(addr.sun_path, used);
+  std::memcpy(out, addr.sun_path, size);
+  return out + size;
+}
+#endif
+
 } // namespace
 
 namespace fb
 {
 
+#ifdef AF_UNIX
+/**
+ * @brief Storage behind a named UNIX_LOCAL address.
+ */
+struct socket_address::unix_endpoint
+{
+  struct sockaddr_un addr; ///< Address handed to the socket calls
+  socklen_t length;        ///< Bytes of addr in use
+};
+
+#endif
+
 socket_address::socket_address() :
   m_family(AddressFamily::IPv4)
 {
@@ -68,6 +259,11 @@ socket_address::socket_address(Family family) :
   case AddressFamily::IPv6:
     init_ipv6();
     break;
+#endif
+#ifdef AF_UNIX
+  case AddressFamily::UNIX_LOCAL:
+    init_unix(std::string_view());
+    break;
 #endif
   default:
     throw std::invalid_argument("Unsupported address family");
@@ -185,12 +381,12 @@ socket_address::socket_address(Family family,
 socket_address::socket_address(std::string_view host_and_port) :
   m_family(AddressFamily::IPv4)
 {
-  std::string host;
+  std::string_view host;
   std::uint16_t port;
   parse_host_and_port(host_and_port, host, port);
 
   // Try IPv4 first
-  if (host.find(':') == std::string::npos)
+  if (host.find(':') == std::string_view::npos)
   {
     init_ipv4(host, port);
   }
@@ -205,10 +401,27 @@ socket_address::socket_address(std::string_view host_and_port) :
   }
 }
 
+/**
+ * @brief Create an address of a given family from its text form.
+ *
+ * @param family Address family.
+ * @param addr "host:port" for IP families; the socket path for UNIX_LOCAL,
+ * where a leading '@' names an abstract socket (Linux) and "" is unnamed.
+ * @throws std::invalid_argument If the text is malformed or a path is
+ * longer than MAX_PATH_LENGTH.
+ */
 socket_address::socket_address(Family family, std::string_view addr) :
   m_family(family)
 {
-  std::string host;
+#ifdef AF_UNIX
+  if (family == AddressFamily::UNIX_LOCAL)
+  {
+    init_unix(addr);
+    return;
+  }
+#endif
+
+  std::string_view host;
   std::uint16_t port;
   parse_host_and_port(addr, host, port);
 
@@ -230,17 +443,41 @@ socket_address::socket_address(Family family, std::string_view addr) :
 socket_address::socket_address(const socket_address &other) :
   m_family(other.m_family)
 {
-  std::memcpy(&m_addr, &other.m_addr, sizeof(m_addr));
+  std::memcpy(&m_addr, &other.m_addr, MAX_ADDRESS_LENGTH);
+#ifdef AF_UNIX
+  m_unix = other.m_unix;
+#endif
 }
 
 socket_address::socket_address(socket_address &&other) noexcept :
   m_family(other.m_family)
 {
-  std::memcpy(&m_addr, &other.m_addr, sizeof(m_addr));
+  std::memcpy(&m_addr, &other.m_addr, MAX_ADDRESS_LENGTH);
+#ifdef AF_UNIX
+  m_unix = std::move(other.m_unix);
+#endif
 }
 
+/**
+ * @brief Copy an address returned by accept(), recvfrom() and friends.
+ *
+ * A name shorter than its family field can only come from an unnamed Unix
+ * domain socket and yields an unnamed UNIX_LOCAL address.
+ *
+ * @throws std::invalid_argument If the family is unsupported or the length
+ * too short for it.
+ */
 socket_address::socket_address(const struct sockaddr *addr, socklen_t length)
 {
+#ifdef AF_UNIX
+  if (length < sizeof(addr->sa_family) ||
+      (addr->sa_family == AF_UNIX && length <= sizeof(struct sockaddr_un)))
+  {
+    m_family = AddressFamily::UNIX_LOCAL;
+    init_unix(reinterpret_cast<const struct sockaddr_un *>(addr), length);
+  }
+  else
+#endif
   if (addr->sa_family == AF_INET && length >= sizeof(struct sockaddr_in))
   {
     m_family = AddressFamily::IPv4;
@@ -264,7 +501,10 @@ socket_address &socket_address::operator=(const socket_address &other)
   if (this != &other)
   {
     m_family = other.m_family;
-    std::memcpy(&m_addr, &other.m_addr, sizeof(m_addr));
+#ifdef AF_UNIX
+    m_unix = other.m_unix;
+#endif
+    std::memcpy(&m_addr, &other.m_addr, MAX_ADDRESS_LENGTH);
   }
   return *this;
 }
@@ -274,7 +514,10 @@ socket_address &socket_address::operator=(socket_address &&other) noexcept
   if (this != &other)
   {
     m_family = other.m_family;
-    std::memcpy(&m_addr, &other.m_addr, sizeof(m_addr));
+#ifdef AF_UNIX
+    m_unix = std::move(other.m_unix);
+#endif
+    std::memcpy(&m_addr, &other.m_addr, MAX_ADDRESS_LENGTH);
   }
   return *this;
 }
@@ -286,13 +529,7 @@ std::string socket_address::host() const
   switch (m_family)
   {
   case AddressFamily::IPv4:
-  {
-    if (inet_ntop(AF_INET, &m_ipv4_addr.sin_addr, buffer, INET_ADDRSTRLEN))
-    {
-      return std::string(buffer);
-    }
-    break;
-  }
+    return std::string(buffer, format_ipv4(m_ipv4_addr.sin_addr, buffer));
 #ifdef AF_INET6
   case AddressFamily::IPv6:
   {
@@ -305,8 +542,8 @@ std::string socket_address::host() const
 #endif
 #ifdef AF_UNIX
   case AddressFamily::UNIX_LOCAL:
-    // UNIX_LOCAL sockets don't have a host address
-    return "localhost";
+    // Unix domain sockets have no host; the path identifies the endpoint
+    return path();
 #endif
   }
 
@@ -328,6 +565,27 @@ std::uint16_t socket_address::port() const
   }
 }
 
+/**
+ * @brief Path of a UNIX_LOCAL address ("@name" for abstract sockets, "" if
+ * unnamed); empty for IP addresses.
+ */
+std::string socket_address::path() const
+{
+#ifdef AF_UNIX
+  if (m_family == AddressFamily::UNIX_LOCAL)
+  {
+    if (!m_unix)
+    {
+      return std::string();
+    }
+    char buffer[MAX_STRING_LENGTH];
+    return std::string(buffer,
+                       format_unix(m_unix->addr, m_unix->length, buffer));
+  }
+#endif
+  return std::string();
+}
+
 socklen_t socket_address::length() const
 {
   switch (m_family)
@@ -337,39 +595,161 @@ socklen_t socket_address::length() const
 #ifdef AF_INET6
   case AddressFamily::IPv6:
     return sizeof(struct sockaddr_in6);
+#endif
+#ifdef AF_UNIX
+  case AddressFamily::UNIX_LOCAL:
+    return m_unix ? m_unix->length : UNIX_PATH_OFFSET;
 #endif
   default:
     return sizeof(struct sockaddr);
   }
 }
 
-const struct sockaddr *socket_address::addr() const { return &m_addr; }
+const struct sockaddr *socket_address::addr() const
+{
+#ifdef AF_UNIX
+  if (m_unix)
+  {
+    return reinterpret_cast<const struct sockaddr *>(&m_unix->addr);
+  }
+#endif
+  return &m_addr;
+}
 
 int socket_address::af() const { return static_cast<int>(m_family); }
 
 std::string socket_address::to_string() const
 {
-  std::ostringstream oss;
+  char buffer[MAX_STRING_LENGTH];
+  const auto result = to_chars(buffer, buffer + sizeof(buffer));
+  if (result.ec != std::errc())
+  {
+    throw std::runtime_error("Failed to convert address to string");
+  }
+  return std::string(buffer, result.ptr);
+}
+
+/**
+ * @brief Format the address as "host:port" ("[host]:port" for IPv6, the
+ * path for UNIX_LOCAL) into a caller-supplied buffer, without allocating.
+ *
+ * Like std::to_chars(), the output is not null-terminated. A buffer of
+ * MAX_STRING_LENGTH characters always suffices.
+ *
+ * @param first Start of the output buffer.
+ * @param last End of the output buffer.
+ * @return {end of output, errc()} on success; {last,
+ *         errc::value_too_large} if the buffer is too small.
+ */
+std::to_chars_result socket_address::to_chars(char *first,
+                                              char *last) const noexcept
+{
+  char buffer[MAX_STRING_LENGTH];
+  char *out = buffer;
 
   switch (m_family)
   {
   case AddressFamily::IPv4:
-    oss << host() << ":" << port();
+    out = format_ipv4(m_ipv4_addr.sin_addr, out);
     break;
+#ifdef AF_UNIX
+  case AddressFamily::UNIX_LOCAL:
+  {
+    if (m_unix)
+    {
+      out = format_unix(m_unix->addr, m_unix->length, out);
+    }
+    const auto length = static_cast<std::size_t>(out - buffer);
+    if (static_cast<std::size_t>(last - first) < length)
+    {
+      return {last, std::errc::value_too_large};
+    }
+    std::memcpy(first, buffer, length);
+    return {first + length, std::errc()};
+  }
+#endif
 #ifdef AF_INET6
   case AddressFamily::IPv6:
-    oss << "[" << host() << "]:" << port();
+    *out++ = '[';
+    if (!inet_ntop(AF_INET6, &m_ipv6_addr.sin6_addr, out, INET6_ADDRSTRLEN))
+    {
+      return {first, std::errc::invalid_argument};
+    }
+    out += std::strlen(out);
+    *out++ = ']';
     break;
 #endif
   default:
-    oss << "unknown:" << port();
+    std::memcpy(out, "unknown", 7);
+    out += 7;
   }
 
-  return oss.str();
+  *out++ = ':';
+  out    = std::to_chars(out, buffer + sizeof(buffer), port()).ptr;
+
+  const auto length = static_cast<std::size_t>(out - buffer);
+  if (static_cast<std::size_t>(last - first) < length)
+  {
+    return {last, std::errc::value_too_large};
+  }
+  std::memcpy(first, buffer, length);
+  return {first + length, std::errc()};
+}
+
+/**
+ * @brief Parse a numeric "host:port" or "[host]:port" literal.
+ *
+ * Unlike the constructors this never resolves names, never allocates and
+ * never throws, which makes it suitable for hot paths such as parsing
+ * addresses out of packets or configuration reloads.
+ *
+ * @param host_and_port Text to parse.
+ * @param address Receives the result; unchanged on failure.
+ * @return True if the text is a valid numeric IPv4 or IPv6 endpoint.
+ */
+bool socket_address::try_parse(std::string_view host_and_port,
+                               socket_address &address) noexcept
+{
+  std::string_view host;
+  std::string_view port_text;
+  std::uint16_t port = 0;
+  if (split_host_and_port(host_and_port, host, port_text) != nullptr ||
+      !parse_port_number(port_text, port))
+  {
+    return false;
+  }
+
+  socket_address parsed;
+  if (parse_ipv4_literal(host, parsed.m_ipv4_addr.sin_addr))
+  {
+    parsed.m_ipv4_addr.sin_port = htons(port);
+  }
+#ifdef AF_INET6
+  else if (host.find(':') != std::string_view::npos)
+  {
+    parsed.m_family = AddressFamily::IPv6;
+    parsed.init_ipv6();
+    if (!parse_ipv6_literal(host, parsed.m_ipv6_addr.sin6_addr))
+    {
+      return false;
+    }
+    parsed.m_ipv6_addr.sin6_port = htons(port);
+  }
+#endif
+  else
+  {
+    return false;
+  }
+
+  address = parsed;
+  return true;
 }
 
 socket_address::Family socket_address::family() const { return m_family; }
 
+/**
+ * @brief Order by family, then numeric address, then port.
+ */
 bool socket_address::operator<(const socket_address &other) const
 {
   if (m_family != other.m_family)
@@ -377,21 +757,23 @@ bool socket_address::operator<(const socket_address &other) const
     return static_cast<int>(m_family) < static_cast<int>(other.m_family);
   }
 
-  const std::string this_host  = host();
-  const std::string other_host = other.host();
-
-  if (this_host != other_host)
+  const int order = address_bytes().compare(other.address_bytes());
+  if (order != 0)
   {
-    return this_host < other_host;
+    return order < 0;
   }
 
   return port() < other.port();
 }
 
+/**
+ * @brief Compare family, address bytes and port (IPv6 scope and flow
+ * information are ignored).
+ */
 bool socket_address::operator==(const socket_address &other) const
 {
-  return m_family == other.m_family && host() == other.host() &&
-         port() == other.port();
+  return m_family == other.m_family &&
+         address_bytes() == other.address_bytes() && port() == other.port();
 }
 
 bool socket_address::operator!=(const socket_address &other) const
@@ -399,6 +781,58 @@ bool socket_address::operator!=(const socket_address &other) const
   return !(*this == other);
 }
 
+/**
+ * @brief Hash of the fields compared by operator==.
+ *
+ * FNV-1a over the family, address bytes and port, so padding and IPv6 flow
+ * labels never split equal addresses. Used by std::hash<socket_address>.
+ */
+std::size_t socket_address::hash() const noexcept
+{
+  std::uint64_t value = 14695981039346656037ull;
+  const auto mix = [&value](unsigned char byte)
+  { value = (value ^ byte) * 1099511628211ull; };
+
+  mix(static_cast<unsigned char>(af()));
+  for (char byte : address_bytes())
+  {
+    mix(static_cast<unsigned char>(byte));
+  }
+  const std::uint16_t port_number = port();
+  mix(static_cast<unsigned char>(port_number & 0xFFu));
+  mix(static_cast<unsigned char>(port_number >> 8));
+  return value;
+}
+
+/**
+ * @brief View of the raw network-order address bytes (the used part of the
+ * path for UNIX_LOCAL, empty for other families).
+ */
+std::string_view socket_address::address_bytes() const noexcept
+{
+  switch (m_family)
+  {
+  case AddressFamily::IPv4:
+    return std::string_view(
+        reinterpret_cast<const char *>(&m_ipv4_addr.sin_addr),
+        sizeof(m_ipv4_addr.sin_addr));
+#ifdef AF_INET6
+  case AddressFamily::IPv6:
+    return std::string_view(
+        reinterpret_cast<const char *>(&m_ipv6_addr.sin6_addr),
+        sizeof(m_ipv6_addr.sin6_addr));
+#endif
+#ifdef AF_UNIX
+  case AddressFamily::UNIX_LOCAL:
+    return m_unix ? std::string_view(m_unix->addr.sun_path,
+                                     m_unix->length - UNIX_PATH_OFFSET)
+                  : std::string_view();
+#endif
+  default:
+    return std::string_view();
+  }
+}
+
 void socket_address::init_ipv4()
 {
   std::memset(&m_ipv4_addr, 0, sizeof(m_ipv4_addr));
@@ -459,47 +893,89 @@ void socket_address::init_ipv6(const struct sockaddr_in6 *addr)
 }
 #endif
 
-void socket_address::parse_host_and_port(std::string_view host_and_port,
-                                         std::string &host,
-                                         std::uint16_t &port)
+#ifdef AF_UNIX
+void socket_address::init_unix(std::string_view path)
 {
-  // Check for empty input to avoid UB on front()
-  if (host_and_port.empty())
+  if (path.size() > MAX_PATH_LENGTH)
   {
-    throw std::invalid_argument("Empty host:port string");
+    throw std::invalid_argument("Unix socket path too long");
   }
 
-  // Handle IPv6 addresses in brackets [host]:port
-  if (host_and_port.front() == '[')
+  // An unnamed address needs no storage beyond its family
+  std::memset(&m_addr, 0, sizeof(m_addr));
+  m_addr.sa_family = AF_UNIX;
+  m_unix.reset();
+  if (path.empty())
   {
-    auto bracket_pos = host_and_port.find(']');
-    if (bracket_pos == std::string_view::npos)
-    {
-      throw std::invalid_argument("Invalid IPv6 address format");
-    }
-
-    host           = std::string(host_and_port.substr(1, bracket_pos - 1));
+    return;
+  }
 
-    auto colon_pos = host_and_port.find(':', bracket_pos);
-    if (colon_pos == std::string_view::npos)
-    {
-      throw std::invalid_argument("Missing port number");
-    }
+  auto endpoint = std::make_shared<unix_endpoint>();
+  std::memset(&endpoint->addr, 0, sizeof(endpoint->addr));
+  endpoint->addr.sun_family = AF_UNIX;
+  endpoint->length = UNIX_PATH_OFFSET + static_cast<socklen_t>(path.size());
 
-    port = parse_port(host_and_port.substr(colon_pos + 1));
+  if (path.front() == '@')
+  {
+#ifdef __linux__
+    // Abstract names are exactly as long as given, with no terminator
+    std::memcpy(endpoint->addr.sun_path + 1, path.data() + 1, path.size() - 1);
+#else
+    throw std::invalid_argument("Abstract Unix sockets require Linux");
+#endif
   }
   else
   {
-    // IPv4 format host:port
-    auto colon_pos = host_and_port.rfind(':');
-    if (colon_pos == std::string_view::npos)
+    if (path.find('\0') != std::string_view::npos)
     {
-      throw std::invalid_argument("Missing port number");
+      throw std::invalid_argument("Unix socket path contains a null character");
     }
+    std::memcpy(endpoint->addr.sun_path, path.data(), path.size());
+    ++endpoint->length;
+  }
+  m_unix = std::move(endpoint);
+}
 
-    host = std::string(host_and_port.substr(0, colon_pos));
-    port = parse_port(host_and_port.substr(colon_pos + 1));
+void socket_address::init_unix(const struct sockaddr_un *addr, socklen_t length)
+{
+  std::memset(&m_addr, 0, sizeof(m_addr));
+  m_addr.sa_family = AF_UNIX;
+  m_unix.reset();
+  if (length <= UNIX_PATH_OFFSET)
+  {
+    return;
+  }
+
+  auto endpoint          = std::make_shared<unix_endpoint>();
+  const std::size_t used = length - UNIX_PATH_OFFSET;
+  std::memset(&endpoint->addr, 0, sizeof(endpoint->addr));
+  endpoint->addr.sun_family = AF_UNIX;
+  std::memcpy(endpoint->addr.sun_path, addr->sun_path, used);
+  endpoint->length = length;
+
+  if (endpoint->addr.sun_path[0] != '\0')
+  {
+    // Kernels differ on whether the terminator is counted; store it when it
+    // fits so equal paths compare equal
+    const std::size_t size = strnlen(endpoint->addr.sun_path, used);
+    endpoint->length       = UNIX_PATH_OFFSET +
+                       static_cast<socklen_t>(
+                           size < sizeof(endpoint->addr.sun_path) ? size + 1 : size);
+  }
+  m_unix = std::move(endpoint);
+}
+#endif
+
+void socket_address::parse_host_and_port(std::string_view host_and_port,
+                                         std::string_view &host,
+                                         std::uint16_t &port)
+{
+  std::string_view port_text;
+  if (const char *error = split_host_and_port(host_and_port, host, port_text))
+  {
+    throw std::invalid_argument(error);
   }
+  port = parse_port(port_text);
 }
 
 std::uint16_t socket_address::parse_port(std::string_view port_str)
@@ -509,38 +985,39 @@ std::uint16_t socket_address::parse_port(std::string_view port_str)
     throw std::invalid_argument("Empty port string");
   }
 
-  try
+  std::uint16_t port = 0;
+  if (parse_port_number(port_str, port))
   {
-    int port_val = std::stoi(std::string(port_str));
-    if (port_val < 0 || port_val > 65535)
-    {
-      throw std::invalid_argument("Port number out of range");
-    }
-    return static_cast<std::uint16_t>(port_val);
+    return port;
   }
-  catch (const std::invalid_argument &)
+  if (std::all_of(port_str.begin(), port_str.end(),
+                  [](char c) { return c >= '0' && c <= '9'; }))
   {
-    // Try to resolve service name
-    struct servent *service =
-        getservbyname(std::string(port_str).c_str(), nullptr);
-    if (service)
-    {
-      return ntohs(service->s_port);
-    }
-    throw std::invalid_argument("Invalid port number or service name");
+    throw std::invalid_argument("Port number out of range");
   }
+
+  // Try to resolve service name
+  struct servent *service =
+      getservbyname(std::string(port_str).c_str(), nullptr);
+  if (service)
+  {
+    return ntohs(static_cast<std::uint16_t>(service->s_port));
+  }
+  throw std::invalid_argument("Invalid port number or service name");
 }
 
 std::uint32_t socket_address::resolve_host_ipv4(std::string_view host)
 {
-  std::uint32_t addr;
+  struct in_addr literal;
 
-  // Try to parse as dotted decimal first
-  if (inet_pton(AF_INET, std::string(host).c_str(), &addr) == 1)
+  // Numeric literals are parsed in place; only names need a lookup
+  if (parse_ipv4_literal(host, literal))
   {
-    return addr;
+    return literal.s_addr;
   }
 
+  std::uint32_t addr;
+
   // Try DNS resolution
   struct addrinfo hints   = {};
   hints.ai_family         = AF_INET;
@@ -566,7 +1043,7 @@ void socket_address::resolve_host_ipv6(std::string_view host,
                                        struct sockaddr_in6 &addr)
 {
   // Try to parse as IPv6 address first
-  if (inet_pton(AF_INET6, std::string(host).c_str(), &addr.sin6_addr) == 1)
+  if (parse_ipv6_literal(host, addr.sin6_addr))
   {
     return;
   }
@@ -594,7 +1071,16 @@ void socket_address::resolve_host_ipv6(std::string_view host,
 
 std::ostream &operator<<(std::ostream &ostr, const socket_address &address)
 {
-  ostr << address.to_string();
+  char buffer[socket_address::MAX_STRING_LENGTH];
+  const auto result = address.to_chars(buffer, buffer + sizeof(buffer));
+  if (result.ec == std::errc())
+  {
+    ostr.write(buffer, result.ptr - buffer);
+  }
+  else
+  {
+    ostr.setstate(std::ios_base::failbit);
+  }
   return ostr;
 }
 
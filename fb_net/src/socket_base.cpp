@@ -29,6 +29,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <unistd.h>
 #endif
@@ -36,6 +37,25 @@
 namespace
 {
 
+#ifndef _WIN32
+/**
+ * @brief Remove the socket file left behind at a Unix domain address.
+ *
+ * Only existing sockets are removed, so a mistyped path never deletes a
+ * regular file; abstract and unnamed addresses have no file.
+ */
+void unlink_stale_socket(const fb::socket_address &address)
+{
+  const std::string path = address.path();
+  struct stat info;
+  if (!path.empty() && path.front() != '@' &&
+      ::lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+  {
+    ::unlink(path.c_str());
+  }
+}
+#endif
+
 #ifdef _WIN32
 std::error_code make_error_code_from_native(int native_code)
 {
@@ -345,6 +365,10 @@ void socket_base::bind(const socket_address &address, bool reuse_address)
 
 /**
  * @brief Bind socket to local address with port reuse option
+ *
+ * For a UNIX_LOCAL path, reuse_address also removes a socket file left at
+ * the path (by a crashed or still running owner) so the bind can succeed.
+ *
  * @param address Local address to bind to
  * @param reuse_address Enable SO_REUSEADDR
  * @param reuse_port Enable SO_REUSEPORT
@@ -372,6 +396,13 @@ void socket_base::bind(const socket_address &address,
       set_reuse_port(true);
     }
 
+#ifndef _WIN32
+    if (reuse_address && address.family() == socket_address::UNIX_LOCAL)
+    {
+      unlink_stale_socket(address);
+    }
+#endif
+
     int result = ::bind(m_sockfd, address.addr(), address.length());
 
     if (result != 0)
@@ -1740,4 +1771,25 @@ void socket_base::set_connected(bool connected)
   m_is_connected = connected;
 }
 
+/**
+ * @brief Create two connected, unnamed Unix domain sockets
+ * @param type STREAM_SOCKET or DATAGRAM_SOCKET
+ * @param fds Receives the two descriptors; the caller owns them
+ * @throws std::system_error if socketpair() fails
+ * @throws std::runtime_error on platforms without socketpair()
+ */
+void socket_base::open_pair(Type type, socket_t (&fds)[2])
+{
+#ifdef _WIN32
+  (void)type;
+  (void)fds;
+  throw std::runtime_error("Socket pairs require Unix domain sockets");
+#else
+  if (::socketpair(AF_UNIX, static_cast<int>(type), 0, fds) != 0)
+  {
+    error("socketpair");
+  }
+#endif
+}
+
 } // namespace fb
@@ -18,7 +18,9 @@ socket_stream_buf::socket_stream_buf(tcp_client &socket,
                                      std::size_t buffer_size) :
   m_socket(socket),
   m_buffer_size(buffer_size),
+  m_input_buffer(nullptr),
   m_input_buffer_initialized(false),
+  m_output_buffer(nullptr),
   m_output_buffer_initialized(false)
 {
   if (m_buffer_size == 0)
@@ -28,7 +30,7 @@ socket_stream_buf::socket_stream_buf(tcp_client &socket,
 }
 
 /**
- * @brief Destructor - flushes any pending data
+ * @brief Destructor - flushes any pending data and returns the buffers
  */
 socket_stream_buf::~socket_stream_buf()
 {
@@ -40,6 +42,7 @@ socket_stream_buf::~socket_stream_buf()
   {
     // Destructor should not throw
   }
+  release_buffers();
 }
 
 /**
@@ -75,19 +78,121 @@ void socket_stream_buf::set_buffer_size(std::size_t size)
         "Cannot change buffer size when buffers contain data");
   }
 
+  // Buffers go back with the size they were acquired with
+  release_buffers();
   m_buffer_size = size;
+}
 
-  // Reset buffers if they were initialized
-  if (m_input_buffer_initialized)
+/**
+ * @brief Set the source of the input and output buffers
+ *
+ * Buffers are acquired lazily on first use, so changing the provider only
+ * affects buffers acquired afterwards; current (empty) buffers are released
+ * to the previous provider first.
+ *
+ * @param provider Shared buffer source, or nullptr to allocate per stream
+ * @throws std::logic_error if buffers still contain data
+ */
+void socket_stream_buf::set_buffer_provider(
+    std::shared_ptr<stream_buffer_provider> provider)
+{
+  if ((m_input_buffer_initialized && gptr() != egptr()) ||
+      (m_output_buffer_initialized && pptr() != pbase()))
   {
-    m_input_buffer_initialized = false;
-    setg(nullptr, nullptr, nullptr);
+    throw std::logic_error(
+        "Cannot change buffer provider when buffers contain data");
   }
-  if (m_output_buffer_initialized)
+
+  release_buffers();
+  m_provider = std::move(provider);
+}
+
+/**
+ * @brief Get the buffer provider
+ * @return Installed provider, or nullptr when buffers are allocated per stream
+ */
+const std::shared_ptr<stream_buffer_provider> &
+socket_stream_buf::buffer_provider() const
+{
+  return m_provider;
+}
+
+/**
+ * @brief View buffered input without consuming it
+ *
+ * Receives from the socket until at least @p min_size bytes are buffered,
+ * the peer closes the connection, or a receive fails or times out. The view
+ * may be shorter than @p min_size in the latter cases, and is empty at end
+ * of stream.
+ *
+ * @param min_size Minimum number of bytes wanted
+ * @return View of all buffered input, valid until the next input operation
+ * @throws std::invalid_argument if min_size exceeds the buffer size
+ */
+std::string_view socket_stream_buf::peek(std::size_t min_size)
+{
+  if (min_size > m_buffer_size)
   {
-    m_output_buffer_initialized = false;
-    setp(nullptr, nullptr);
+    throw std::invalid_argument("Peek size exceeds buffer size");
   }
+
+  init_input_buffer();
+  while (static_cast<std::size_t>(egptr() - gptr()) < min_size)
+  {
+    if (fill_input_buffer() <= 0)
+    {
+      break;
+    }
+  }
+  return std::string_view(gptr(), static_cast<std::size_t>(egptr() - gptr()));
+}
+
+/**
+ * @brief View the next line of buffered input without consuming it
+ *
+ * Receives from the socket until @p delimiter is buffered. Returns an empty
+ * view if the stream ends, a receive fails, or the buffer fills up first;
+ * peek() then shows whatever is left.
+ *
+ * @param delimiter Line terminator
+ * @return View of the line including the delimiter, valid until the next
+ *         input operation
+ */
+std::string_view socket_stream_buf::peek_line(char delimiter)
+{
+  init_input_buffer();
+
+  std::size_t scanned = 0;
+  for (;;)
+  {
+    const std::size_t available = static_cast<std::size_t>(egptr() - gptr());
+    const void *hit = std::memchr(gptr() + scanned, delimiter, available - scanned);
+    if (hit != nullptr)
+    {
+      return std::string_view(
+          gptr(), static_cast<std::size_t>(static_cast<const char *>(hit) - gptr()) + 1);
+    }
+
+    scanned = available;
+    if (available >= m_buffer_size || fill_input_buffer() <= 0)
+    {
+      return std::string_view();
+    }
+  }
+}
+
+/**
+ * @brief Discard buffered input returned by peek() or peek_line()
+ * @param count Number of bytes to skip
+ * @throws std::invalid_argument if fewer than count bytes are buffered
+ */
+void socket_stream_buf::consume(std::size_t count)
+{
+  if (count > static_cast<std::size_t>(egptr() - gptr()))
+  {
+    throw std::invalid_argument("Cannot consume more than the buffered input");
+  }
+  setg(eback(), gptr() + count, egptr());
 }
 
 /**
@@ -97,8 +202,8 @@ void socket_stream_buf::init_input_buffer()
 {
   if (!m_input_buffer_initialized)
   {
-    m_input_buffer = std::make_unique<char[]>(m_buffer_size);
-    setg(m_input_buffer.get(), m_input_buffer.get(), m_input_buffer.get());
+    m_input_buffer = acquire_buffer();
+    setg(m_input_buffer, m_input_buffer, m_input_buffer);
     m_input_buffer_initialized = true;
   }
 }
@@ -110,12 +215,61 @@ void socket_stream_buf::init_output_buffer()
 {
   if (!m_output_buffer_initialized)
   {
-    m_output_buffer = std::make_unique<char[]>(m_buffer_size);
-    setp(m_output_buffer.get(), m_output_buffer.get() + m_buffer_size);
+    m_output_buffer = acquire_buffer();
+    setp(m_output_buffer, m_output_buffer + m_buffer_size);
     m_output_buffer_initialized = true;
   }
 }
 
+/**
+ * @brief Return both buffers and reset the stream pointers
+ */
+void socket_stream_buf::release_buffers()
+{
+  if (m_input_buffer_initialized)
+  {
+    m_input_buffer_initialized = false;
+    setg(nullptr, nullptr, nullptr);
+  }
+  if (m_output_buffer_initialized)
+  {
+    m_output_buffer_initialized = false;
+    setp(nullptr, nullptr);
+  }
+  release_buffer(m_input_buffer);
+  release_buffer(m_output_buffer);
+}
+
+/**
+ * @brief Obtain a buffer of m_buffer_size bytes
+ * @return Buffer from the provider, or a private allocation
+ */
+char *socket_stream_buf::acquire_buffer()
+{
+  return m_provider ? m_provider->acquire(m_buffer_size)
+                    : new char[m_buffer_size];
+}
+
+/**
+ * @brief Give a buffer back to where it came from
+ * @param buffer Buffer to release; reset to nullptr
+ */
+void socket_stream_buf::release_buffer(char *&buffer)
+{
+  if (buffer != nullptr)
+  {
+    if (m_provider)
+    {
+      m_provider->release(buffer, m_buffer_size);
+    }
+    else
+    {
+      delete[] buffer;
+    }
+    buffer = nullptr;
+  }
+}
+
 std::streambuf::int_type socket_stream_buf::underflow()
 {
   // If we have data in buffer, return it
@@ -217,7 +371,7 @@ int socket_stream_buf::flush_output_buffer()
     if (bytes_sent == bytes_to_send)
     {
       // Reset output buffer pointers
-      setp(m_output_buffer.get(), m_output_buffer.get() + m_buffer_size);
+      setp(m_output_buffer, m_output_buffer + m_buffer_size);
       return static_cast<int>(bytes_sent);
     }
     else
@@ -232,8 +386,12 @@ int socket_stream_buf::flush_output_buffer()
 }
 
 /**
- * @brief Fill input buffer from socket
- * @return Number of bytes read, 0 on EOF, -1 on error
+ * @brief Append data from the socket to the input buffer
+ *
+ * Unread input is first moved to the front of the buffer so a single
+ * receive can use all remaining space.
+ *
+ * @return Number of bytes read, 0 on EOF or full buffer, -1 on error
  */
 int socket_stream_buf::fill_input_buffer()
 {
@@ -242,14 +400,26 @@ int socket_stream_buf::fill_input_buffer()
     return -1;
   }
 
+  const std::ptrdiff_t pending = egptr() - gptr();
+  const std::size_t unread = pending > 0 ? static_cast<std::size_t>(pending) : 0;
+  if (unread > 0 && gptr() != m_input_buffer)
+  {
+    std::memmove(m_input_buffer, gptr(), unread);
+  }
+  setg(m_input_buffer, m_input_buffer, m_input_buffer + unread);
+  if (unread >= m_buffer_size)
+  {
+    return 0;
+  }
+
   try
   {
-    int bytes_read = m_socket.receive_bytes(m_input_buffer.get(),
-                                            static_cast<int>(m_buffer_size));
+    int bytes_read = m_socket.receive_bytes(m_input_buffer + unread,
+                                            static_cast<int>(m_buffer_size - unread));
     if (bytes_read > 0)
     {
-      setg(m_input_buffer.get(), m_input_buffer.get(),
-           m_input_buffer.get() + bytes_read);
+      setg(m_input_buffer, m_input_buffer,
+           m_input_buffer + unread + static_cast<std::size_t>(bytes_read));
     }
     return bytes_read;
   }
@@ -404,6 +574,50 @@ void socket_stream::set_buffer_size(std::size_t size)
   }
 }
 
+/**
+ * @brief Set the source of the stream's I/O buffers
+ * @param provider Shared buffer source, or nullptr to allocate per stream
+ * @throws std::logic_error if buffered data remains
+ */
+void socket_stream::set_buffer_provider(
+    std::shared_ptr<stream_buffer_provider> provider)
+{
+  if (m_stream_buf)
+  {
+    flush();
+    m_stream_buf->set_buffer_provider(std::move(provider));
+  }
+}
+
+/**
+ * @brief View buffered input without consuming it
+ * @param min_size Minimum number of bytes wanted
+ * @return View valid until the next input operation
+ * @see socket_stream_buf::peek()
+ */
+std::string_view socket_stream::peek(std::size_t min_size)
+{
+  return m_stream_buf->peek(min_size);
+}
+
+/**
+ * @brief View the next line of input without consuming it
+ * @param delimiter Line terminator
+ * @return View including the delimiter, or empty if none arrived
+ * @see socket_stream_buf::peek_line()
+ */
+std::string_view socket_stream::peek_line(char delimiter)
+{
+  return m_stream_buf->peek_line(delimiter);
+}
+
+/**
+ * @brief Discard input returned by peek() or peek_line()
+ * @param count Number of bytes to skip
+ * @throws std::invalid_argument if fewer than count bytes are buffered
+ */
+void socket_stream::consume(std::size_t count) { m_stream_buf->consume(count); }
+
 /**
  * @brief Set TCP no delay option
  * @param flag Enable/disable no delay
@@ -0,0 +1,100 @@
+#include <fb/stream_buffer_pool.h>
+#include <stdexcept>
+
+namespace fb
+{
+
+/**
+ * @brief Create an empty pool.
+ *
+ * @param buffer_size Size of each pooled buffer.
+ * @param max_cached Maximum number of idle buffers kept for reuse.
+ * @throws std::invalid_argument If buffer_size is zero.
+ */
+stream_buffer_pool::stream_buffer_pool(std::size_t buffer_size,
+                                       std::size_t max_cached) :
+  m_buffer_size(buffer_size),
+  m_max_cached(max_cached)
+{
+  if (m_buffer_size == 0)
+  {
+    throw std::invalid_argument("Buffer size cannot be zero");
+  }
+  m_free.reserve(m_max_cached);
+}
+
+/**
+ * @brief Free all cached buffers.
+ *
+ * Buffers still borrowed by streams must be released before the pool is
+ * destroyed.
+ */
+stream_buffer_pool::~stream_buffer_pool() = default;
+
+/**
+ * @brief Borrow a buffer of at least @p size bytes.
+ *
+ * @param size Required size.
+ * @return Buffer to pass back to release() with the same size.
+ */
+char *stream_buffer_pool::acquire(std::size_t size)
+{
+  if (size > m_buffer_size)
+  {
+    return new char[size];
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_free.empty())
+    {
+      char *buffer = m_free.back().release();
+      m_free.pop_back();
+      return buffer;
+    }
+  }
+  return new char[m_buffer_size];
+}
+
+/**
+ * @brief Return a buffer obtained from acquire().
+ *
+ * @param buffer Buffer to return (nullptr is ignored).
+ * @param size Size originally passed to acquire().
+ */
+void stream_buffer_pool::release(char *buffer, std::size_t size) noexcept
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+
+  std::unique_ptr<char[]> owned(buffer);
+  if (size > m_buffer_size)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_free.size() < m_max_cached)
+  {
+    // Capacity was reserved up front, so this never allocates
+    m_free.push_back(std::move(owned));
+  }
+}
+
+/**
+ * @brief Size of the buffers held by the pool.
+ */
+std::size_t stream_buffer_pool::buffer_size() const { return m_buffer_size; }
+
+/**
+ * @brief Number of idle buffers ready for reuse.
+ */
+std::size_t stream_buffer_pool::cached_buffers() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_free.size();
+}
+
+} // namespace fb
@@ -1,22 +1,149 @@
 #include <fb/tcp_client.h>
+#include <fb/detail/socket_error_utils.h>
+#include <fb/dns_resolver.h>
 #include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstring>
 #include <stdexcept>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <mswsock.h>
+#include <io.h>
 #else
+#include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__)
+#include <sys/types.h>
+#endif
 #endif
 
 namespace fb
 {
 
+namespace
+{
+
+/// Segments handed to one sendmsg/recvmsg (WSASend/WSARecv) call; well under
+/// IOV_MAX and small enough for the vector array to live on the stack.
+constexpr std::size_t MAX_IO_SEGMENTS = 64;
+
+/**
+ * @brief Validate a segment array and return its total size.
+ *
+ * @throws std::invalid_argument If the array is null, a non-empty segment has
+ * no data, or the total does not fit the int byte counts used by tcp_client.
+ */
+template <typename Buffer>
+std::size_t total_segment_length(const Buffer *buffers, std::size_t count)
+{
+  if (!buffers)
+  {
+    throw std::invalid_argument("Buffers cannot be null for non-zero count");
+  }
+
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (!buffers[i].data && buffers[i].length > 0)
+    {
+      throw std::invalid_argument("Buffer cannot be null");
+    }
+    total += buffers[i].length;
+    if (total > static_cast<std::size_t>(INT_MAX))
+    {
+      throw std::invalid_argument("Total length exceeds INT_MAX");
+    }
+  }
+  return total;
+}
+
+/// Upper bound for one sendfile/TransmitFile call so counts fit every API.
+constexpr std::uint64_t MAX_FILE_CHUNK = 1ULL << 30;
+
+/**
+ * @brief Resolve the number of bytes to send from a file.
+ *
+ * @param file_size Size of the file.
+ * @param offset Start offset requested by the caller.
+ * @param length Requested length; 0 means "to end of file".
+ * @throws std::invalid_argument If the range lies outside the file.
+ */
+std::uint64_t file_range_length(std::uint64_t file_size, std::uint64_t offset,
+                                std::uint64_t length)
+{
+  if (offset > file_size)
+  {
+    throw std::invalid_argument("File offset is beyond end of file");
+  }
+  if (length == 0)
+  {
+    return file_size - offset;
+  }
+  if (length > file_size - offset)
+  {
+    throw std::invalid_argument("File range extends beyond end of file");
+  }
+  return length;
+}
+
+#ifndef _WIN32
+/**
+ * @brief Read/write fallback for platforms or files sendfile cannot handle.
+ *
+ * @return Number of bytes sent; short if the file shrank while sending.
+ */
+std::uint64_t copy_file_to_socket(tcp_client &client, int fd,
+                                  std::uint64_t offset, std::uint64_t length)
+{
+  constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+  std::vector<char> buffer(CHUNK_SIZE);
+  std::uint64_t total_sent = 0;
+
+  while (total_sent < length)
+  {
+    const auto chunk = static_cast<std::size_t>(
+        std::min<std::uint64_t>(CHUNK_SIZE, length - total_sent));
+    ssize_t bytes_read = ::pread(fd, buffer.data(), chunk,
+                                 static_cast<off_t>(offset + total_sent));
+    if (bytes_read < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      detail::throw_system_error(errno, "Failed to read file");
+    }
+    if (bytes_read == 0)
+    {
+      break;
+    }
+
+    int sent = client.send_bytes_all(buffer.data(), static_cast<int>(bytes_read));
+    total_sent += static_cast<std::uint64_t>(sent);
+    if (sent < bytes_read)
+    {
+      break;
+    }
+  }
+  return total_sent;
+}
+#endif
+
+} // namespace
+
 /**
  * @brief  Default constructor creates an uninitialized TCP socket
  */
@@ -72,11 +199,30 @@ tcp_client::tcp_client(socket_t sockfd) :
 {
 }
 
+/**
+ * @brief Create two connected, unnamed Unix domain stream sockets
+ *
+ * A same-host link between threads, or between a parent and a forked child,
+ * with no listener, address or loopback TCP stack in between; both ends offer
+ * the full tcp_client API except the TCP-only options such as set_no_delay().
+ *
+ * @return Both ends of the connection
+ * @throws std::system_error if socketpair() fails
+ * @throws std::runtime_error on platforms without socketpair()
+ */
+std::pair<tcp_client, tcp_client> tcp_client::socket_pair()
+{
+  socket_t fds[2];
+  open_pair(STREAM_SOCKET, fds);
+  return {tcp_client(fds[0]), tcp_client(fds[1])};
+}
+
 /**
  * @brief Move constructor
  */
 tcp_client::tcp_client(tcp_client &&other) noexcept :
-  socket_base(std::move(other))
+  socket_base(std::move(other)),
+  m_tls(std::move(other.m_tls))
 {
 }
 
@@ -86,6 +232,7 @@ tcp_client::tcp_client(tcp_client &&other) noexcept :
 tcp_client &tcp_client::operator=(tcp_client &&other) noexcept
 {
   socket_base::operator=(std::move(other));
+  m_tls = std::move(other.m_tls);
   return *this;
 }
 
@@ -145,6 +292,83 @@ void tcp_client::connect(const socket_address &address,
   }
 }
 
+/**
+ * @brief Connect to a host name, resolving it through the shared resolver
+ * @param host Host name or numeric address
+ * @param port Remote port
+ * @param timeout Timeout for each connection attempt
+ * @throws std::runtime_error if the host name cannot be resolved
+ * @throws std::system_error if no resolved address accepts the connection
+ */
+void tcp_client::connect(std::string_view host, std::uint16_t port,
+                         const std::chrono::milliseconds &timeout)
+{
+  connect(host, port, timeout, dns_resolver::shared());
+}
+
+/**
+ * @brief Connect to a host name, resolving it through @p resolver
+ *
+ * Reconnect loops pay for name resolution only once per cache lifetime.
+ * Each resolved address is tried in turn; a failed attempt closes the
+ * socket and opens a new one for the next address. If every address fails
+ * the host is invalidated in the resolver, so the next call re-resolves
+ * instead of retrying stale records.
+ *
+ * @param host Host name or numeric address
+ * @param port Remote port
+ * @param timeout Timeout for each connection attempt
+ * @param resolver Resolver (and cache) to use
+ * @throws std::runtime_error if the host name cannot be resolved
+ * @throws std::system_error if no resolved address accepts the connection
+ */
+void tcp_client::connect(std::string_view host, std::uint16_t port,
+                         const std::chrono::milliseconds &timeout,
+                         dns_resolver &resolver)
+{
+  const socket_address::Family family =
+      is_closed() ? socket_address::IPv4 : address().family();
+
+  try
+  {
+    const std::vector<socket_address> addresses =
+        resolver.resolve_all(host, port, family);
+    for (std::size_t i = 0; i < addresses.size(); ++i)
+    {
+      if (is_closed())
+      {
+        init_tcp_socket(family);
+      }
+      try
+      {
+        socket_base::connect(addresses[i], timeout);
+        if (onConnected.slot_count() > 0)
+        {
+          onConnected.emit(addresses[i]);
+        }
+        return;
+      }
+      catch (const std::system_error &)
+      {
+        close();
+        if (i + 1 == addresses.size())
+        {
+          resolver.invalidate(host);
+          throw;
+        }
+      }
+    }
+  }
+  catch (const std::exception &ex)
+  {
+    if (onConnectionError.slot_count() > 0)
+    {
+      onConnectionError.emit(ex.what());
+    }
+    throw;
+  }
+}
+
 /**
  * @brief Connect using non-blocking mode
  * @param address Remote address to connect to
@@ -211,6 +435,10 @@ int tcp_client::send_bytes(const void *buffer, int length, int flags)
   {
     return 0;
   }
+  if (m_tls && !m_tls->kernel_send())
+  {
+    return tls_send(buffer, length);
+  }
 
   int sent = ::send(sockfd(), static_cast<const char *>(buffer), length, flags);
   if (sent < 0)
@@ -257,6 +485,10 @@ int tcp_client::receive_bytes(void *buffer, int length, int flags)
   {
     return 0;
   }
+  if (m_tls)
+  {
+    return tls_receive(buffer, length);
+  }
 
   int received = ::recv(sockfd(), static_cast<char *>(buffer), length, flags);
   if (received < 0)
@@ -418,6 +650,458 @@ int tcp_client::send_bytes_all(const void *buffer, int length, int flags)
   return total_sent;
 }
 
+/**
+ * @brief Send several buffers with a single system call (gather write)
+ *
+ * Like send_bytes(), a single call may send fewer bytes than requested; at
+ * most 64 segments are passed to the kernel per call.
+ *
+ * @param buffers Segments to send, in order
+ * @param count Number of segments
+ * @param flags Send flags (default 0)
+ * @return Number of bytes actually sent
+ * @throws std::invalid_argument if the buffer parameters are invalid
+ * @throws std::system_error on send failure
+ */
+int tcp_client::send_vectored(const tcp_send_buffer *buffers, std::size_t count,
+                              int flags)
+{
+  check_initialized();
+  if (count == 0 || total_segment_length(buffers, count) == 0)
+  {
+    return 0;
+  }
+
+  return send_segments(buffers, std::min(count, MAX_IO_SEGMENTS), 0, flags);
+}
+
+/**
+ * @brief Send every byte of several buffers, resuming after partial writes
+ *
+ * Header, body and trailer can be sent in one system call without first
+ * being copied into a contiguous buffer.
+ *
+ * @param buffers Segments to send, in order
+ * @param count Number of segments
+ * @param flags Send flags (default 0)
+ * @return Number of bytes sent (equals the total length unless the socket
+ *         stops accepting data, e.g. a non-blocking socket would block)
+ * @throws std::invalid_argument if the buffer parameters are invalid
+ * @throws std::system_error on send failure
+ */
+int tcp_client::send_vectored_all(const tcp_send_buffer *buffers,
+                                  std::size_t count, int flags)
+{
+  check_initialized();
+  if (count == 0)
+  {
+    return 0;
+  }
+  const auto length =
+      static_cast<int>(total_segment_length(buffers, count));
+
+  int total_sent     = 0;
+  std::size_t index  = 0;
+  std::size_t offset = 0; // Bytes of buffers[index] already sent
+
+  while (total_sent < length)
+  {
+    while (buffers[index].length == offset)
+    {
+      ++index;
+      offset = 0;
+    }
+
+    int sent = send_segments(buffers + index,
+                             std::min(count - index, MAX_IO_SEGMENTS), offset,
+                             flags);
+    if (sent <= 0)
+    {
+      // Connection error or would block
+      break;
+    }
+    total_sent += sent;
+
+    auto remaining = static_cast<std::size_t>(sent);
+    while (remaining > 0)
+    {
+      std::size_t available = buffers[index].length - offset;
+      if (remaining < available)
+      {
+        offset += remaining;
+        break;
+      }
+      remaining -= available;
+      ++index;
+      offset = 0;
+    }
+  }
+
+  return total_sent;
+}
+
+/**
+ * @brief Receive into several buffers with a single system call (scatter read)
+ *
+ * Segments are filled in order; the call returns once any data is available,
+ * so later segments may be left untouched. Only the first 64 segments are
+ * used.
+ *
+ * @param buffers Destination segments, in order
+ * @param count Number of segments
+ * @param flags Receive flags (default 0)
+ * @return Number of bytes actually received, 0 if connection closed
+ * @throws std::invalid_argument if the buffer parameters are invalid
+ * @throws std::system_error on receive failure
+ */
+int tcp_client::receive_vectored(tcp_receive_buffer *buffers, std::size_t count,
+                                 int flags)
+{
+  check_initialized();
+  if (count == 0 || total_segment_length(buffers, count) == 0)
+  {
+    return 0;
+  }
+  count = std::min(count, MAX_IO_SEGMENTS);
+  if (m_tls)
+  {
+    // Records are decrypted one at a time; fill the first segment only
+    std::size_t first = 0;
+    while (buffers[first].length == 0)
+    {
+      ++first;
+    }
+    return tls_receive(buffers[first].data,
+                       static_cast<int>(std::min<std::size_t>(buffers[first].length, INT_MAX)));
+  }
+
+#ifdef _WIN32
+  WSABUF vectors[MAX_IO_SEGMENTS];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    vectors[i].buf = static_cast<char *>(buffers[i].data);
+    vectors[i].len = static_cast<ULONG>(buffers[i].length);
+  }
+  DWORD bytes    = 0;
+  DWORD wsaflags = static_cast<DWORD>(flags);
+  int received   = ::WSARecv(sockfd(), vectors, static_cast<DWORD>(count),
+                             &bytes, &wsaflags, nullptr, nullptr) == 0
+                       ? static_cast<int>(bytes)
+                       : -1;
+#else
+  struct iovec vectors[MAX_IO_SEGMENTS];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    vectors[i].iov_base = buffers[i].data;
+    vectors[i].iov_len  = buffers[i].length;
+  }
+  struct msghdr message;
+  std::memset(&message, 0, sizeof(message));
+  message.msg_iov    = vectors;
+  message.msg_iovlen = count;
+  int received = static_cast<int>(::recvmsg(sockfd(), &message, flags));
+#endif
+
+  if (received < 0)
+  {
+    // Emit error signal if listeners exist
+    if (onReceiveError.slot_count() > 0)
+    {
+      onReceiveError.emit("Failed to receive data");
+    }
+    error("Failed to receive data");
+  }
+  else if (received == 0)
+  {
+    // Connection closed by peer - update state and emit disconnected signal
+    set_connected(false);
+    if (onDisconnected.slot_count() > 0)
+    {
+      onDisconnected.emit();
+    }
+  }
+  else if (onDataReceived.slot_count() > 0)
+  {
+    // Report each filled segment separately; they are not contiguous
+    auto remaining = static_cast<std::size_t>(received);
+    for (std::size_t i = 0; i < count && remaining > 0; ++i)
+    {
+      std::size_t filled = std::min(remaining, buffers[i].length);
+      if (filled > 0)
+      {
+        onDataReceived.emit(buffers[i].data, filled);
+      }
+      remaining -= filled;
+    }
+  }
+  return received;
+}
+
+/**
+ * @brief Send a file's contents without copying them through user space
+ *
+ * Opens @p path read-only and forwards to the descriptor overload.
+ *
+ * @param path File to send
+ * @param offset First byte to send
+ * @param length Number of bytes to send (0 = to end of file)
+ * @return Number of bytes sent
+ * @throws std::invalid_argument if the range lies outside the file
+ * @throws std::system_error if the file cannot be opened or sending fails
+ */
+std::uint64_t tcp_client::send_file(const std::string &path,
+                                    std::uint64_t offset, std::uint64_t length)
+{
+  check_initialized();
+
+#ifdef _WIN32
+  int fd = ::_open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+  if (fd < 0)
+  {
+    detail::throw_system_error(errno, "Failed to open file: " + path);
+  }
+
+  try
+  {
+    std::uint64_t sent = send_file(fd, offset, length);
+#ifdef _WIN32
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+    return sent;
+  }
+  catch (...)
+  {
+#ifdef _WIN32
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+    throw;
+  }
+}
+
+/**
+ * @brief Send part of an open file without copying it through user space
+ *
+ * Uses sendfile() on Linux, macOS and FreeBSD and TransmitFile() on Windows,
+ * falling back to a pread/send loop elsewhere or when the kernel cannot
+ * splice the descriptor. The descriptor's file offset is not used or moved
+ * on POSIX systems. On Windows the bytes go out through TransmitFile, which
+ * sends from the file pointer, so the pointer is moved.
+ *
+ * @param file_descriptor Readable file descriptor (C runtime fd on Windows)
+ * @param offset First byte to send
+ * @param length Number of bytes to send (0 = to end of file)
+ * @return Number of bytes sent; short only if the file shrank while sending
+ * @throws std::invalid_argument if the range lies outside the file
+ * @throws std::system_error on file or send failure
+ */
+std::uint64_t tcp_client::send_file(int file_descriptor, std::uint64_t offset,
+                                    std::uint64_t length)
+{
+  check_initialized();
+  if (file_descriptor < 0)
+  {
+    throw std::invalid_argument("Invalid file descriptor");
+  }
+
+#ifdef _WIN32
+  HANDLE file = reinterpret_cast<HANDLE>(::_get_osfhandle(file_descriptor));
+  LARGE_INTEGER size;
+  if (file == INVALID_HANDLE_VALUE || !::GetFileSizeEx(file, &size))
+  {
+    detail::throw_system_error(static_cast<int>(::GetLastError()),
+                               "Failed to query file size");
+  }
+  length = file_range_length(static_cast<std::uint64_t>(size.QuadPart), offset,
+                             length);
+  if (m_tls)
+  {
+    throw std::logic_error("send_file() needs kernel TLS on TLS connections");
+  }
+
+  std::uint64_t total_sent = 0;
+  while (total_sent < length)
+  {
+    const auto chunk = static_cast<DWORD>(
+        std::min<std::uint64_t>(MAX_FILE_CHUNK, length - total_sent));
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(offset + total_sent);
+    if (!::SetFilePointerEx(file, position, nullptr, FILE_BEGIN))
+    {
+      detail::throw_system_error(static_cast<int>(::GetLastError()),
+                                 "Failed to seek file");
+    }
+    if (!::TransmitFile(sockfd(), file, chunk, 0, nullptr, nullptr, 0))
+    {
+      if (onSendError.slot_count() > 0)
+      {
+        onSendError.emit("Failed to send file");
+      }
+      error("Failed to send file");
+    }
+    total_sent += chunk;
+    if (onDataSent.slot_count() > 0)
+    {
+      onDataSent.emit(static_cast<size_t>(chunk));
+    }
+  }
+  return total_sent;
+#else
+  struct stat info;
+  if (::fstat(file_descriptor, &info) != 0)
+  {
+    detail::throw_system_error(errno, "Failed to query file size");
+  }
+  length = file_range_length(static_cast<std::uint64_t>(info.st_size), offset,
+                             length);
+  if (!S_ISREG(info.st_mode) || (m_tls && !m_tls->kernel_send()))
+  {
+    // User-space TLS must see the plaintext
+    return copy_file_to_socket(*this, file_descriptor, offset, length);
+  }
+
+  std::uint64_t total_sent = 0;
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)
+  while (total_sent < length)
+  {
+    const auto chunk = static_cast<std::size_t>(
+        std::min<std::uint64_t>(MAX_FILE_CHUNK, length - total_sent));
+    auto position    = static_cast<off_t>(offset + total_sent);
+#if defined(__linux__)
+    ssize_t sent = ::sendfile(sockfd(), file_descriptor, &position, chunk);
+#elif defined(__APPLE__)
+    off_t bytes = static_cast<off_t>(chunk);
+    ssize_t sent = ::sendfile(file_descriptor, sockfd(), position, &bytes,
+                              nullptr, 0) == 0 || bytes > 0
+                       ? static_cast<ssize_t>(bytes)
+                       : -1;
+#else
+    off_t bytes  = 0;
+    ssize_t sent = ::sendfile(file_descriptor, sockfd(), position, chunk,
+                              nullptr, &bytes, 0) == 0 || bytes > 0
+                       ? static_cast<ssize_t>(bytes)
+                       : -1;
+#endif
+    if (sent < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      if ((errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP) &&
+          total_sent == 0)
+      {
+        // The kernel cannot splice this descriptor pair
+        return copy_file_to_socket(*this, file_descriptor, offset, length);
+      }
+      if (onSendError.slot_count() > 0)
+      {
+        onSendError.emit("Failed to send file");
+      }
+      error("Failed to send file");
+    }
+    if (sent == 0)
+    {
+      break; // File shrank underneath us
+    }
+
+    total_sent += static_cast<std::uint64_t>(sent);
+    if (onDataSent.slot_count() > 0)
+    {
+      onDataSent.emit(static_cast<size_t>(sent));
+    }
+  }
+#else
+  total_sent = copy_file_to_socket(*this, file_descriptor, offset, length);
+#endif
+  return total_sent;
+#endif
+}
+
+/**
+ * @brief Issue one gathered send for up to MAX_IO_SEGMENTS segments
+ *
+ * @param buffers First segment to send
+ * @param count Number of segments (at most MAX_IO_SEGMENTS)
+ * @param offset Bytes of the first segment that were already sent
+ * @param flags Send flags
+ * @return Number of bytes sent
+ * @throws std::system_error on send failure
+ */
+int tcp_client::send_segments(const tcp_send_buffer *buffers,
+                              std::size_t count, std::size_t offset, int flags)
+{
+  if (m_tls && !m_tls->kernel_send())
+  {
+    // Gather into one record instead of one record per segment
+    char gathered[16 * 1024];
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < count && used < sizeof(gathered); ++i)
+    {
+      const std::size_t skip = (i == 0) ? offset : 0;
+      const std::size_t take = std::min(buffers[i].length - skip, sizeof(gathered) - used);
+      std::memcpy(gathered + used, static_cast<const char *>(buffers[i].data) + skip, take);
+      used += take;
+    }
+    return tls_send(gathered, static_cast<int>(used));
+  }
+
+#ifdef _WIN32
+  WSABUF vectors[MAX_IO_SEGMENTS];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::size_t skip = (i == 0) ? offset : 0;
+    vectors[i].buf =
+        const_cast<char *>(static_cast<const char *>(buffers[i].data) + skip);
+    vectors[i].len = static_cast<ULONG>(buffers[i].length - skip);
+  }
+  DWORD bytes = 0;
+  int sent    = ::WSASend(sockfd(), vectors, static_cast<DWORD>(count), &bytes,
+                          static_cast<DWORD>(flags), nullptr, nullptr) == 0
+                    ? static_cast<int>(bytes)
+                    : -1;
+#else
+  struct iovec vectors[MAX_IO_SEGMENTS];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::size_t skip    = (i == 0) ? offset : 0;
+    vectors[i].iov_base = const_cast<char *>(
+        static_cast<const char *>(buffers[i].data) + skip);
+    vectors[i].iov_len = buffers[i].length - skip;
+  }
+  struct msghdr message;
+  std::memset(&message, 0, sizeof(message));
+  message.msg_iov    = vectors;
+  message.msg_iovlen = count;
+  int sent           = static_cast<int>(::sendmsg(sockfd(), &message, flags));
+#endif
+
+  if (sent < 0)
+  {
+    // Emit error signal if listeners exist
+    if (onSendError.slot_count() > 0)
+    {
+      onSendError.emit("Failed to send data");
+    }
+    error("Failed to send data");
+  }
+  else if (sent > 0)
+  {
+    // Emit data sent signal if listeners exist
+    if (onDataSent.slot_count() > 0)
+    {
+      onDataSent.emit(static_cast<size_t>(sent));
+    }
+  }
+  return sent;
+}
+
 /**
  * @brief Gracefully shutdown the connection
  * @throws std::logic_error if the socket state is invalid
@@ -432,6 +1116,10 @@ void tcp_client::shutdown()
   {
     onShutdownInitiated.emit();
   }
+  if (m_tls)
+  {
+    m_tls->close_notify();
+  }
 
 #ifdef _WIN32
   int rc = ::shutdown(sockfd(), SD_BOTH);
@@ -506,6 +1194,56 @@ void tcp_client::send_urgent(unsigned char data)
   }
 }
 
+/**
+ * @brief Negotiate TLS on this connected socket.
+ *
+ * The handshake runs in user space through @p context. If the engine hands
+ * the record layer to kernel TLS, sends (including send_file() and
+ * send_vectored()) keep using the plain system calls and the kernel
+ * encrypts; otherwise they are encrypted by the engine. Receives always go
+ * through the engine; receive flags are ignored and receive_vectored() fills
+ * only its first segment.
+ *
+ * @param context TLS engine holding credentials and policy.
+ * @param role Side of the handshake to take.
+ * @param server_name Expected server host name (clients; SNI and
+ * certificate check).
+ * @throws std::logic_error If the socket is not connected, is non-blocking
+ * or already uses TLS.
+ * @throws std::system_error If the handshake fails (timed_out when the
+ * receive timeout expires first).
+ */
+void tcp_client::start_tls(tls_context &context, tls_role role,
+                           const std::string &server_name)
+{
+  check_initialized();
+  if (m_tls)
+  {
+    throw std::logic_error("TLS already started on this socket");
+  }
+  if (!get_blocking())
+  {
+    throw std::logic_error("TLS handshake needs a blocking socket");
+  }
+  m_tls = context.handshake(sockfd(), role, server_name);
+}
+
+/**
+ * @brief True once start_tls() has completed.
+ */
+bool tcp_client::secure() const
+{
+  return m_tls != nullptr;
+}
+
+/**
+ * @brief Negotiated TLS session, or nullptr for plain connections.
+ */
+const tls_session *tcp_client::tls() const
+{
+  return m_tls.get();
+}
+
 /**
  * @brief Set TCP no delay option (disable Nagle algorithm)
  * @param flag Enable/disable no delay
@@ -520,6 +1258,54 @@ void tcp_client::set_no_delay(bool flag) { socket_base::set_no_delay(flag); }
  */
 bool tcp_client::get_no_delay() { return socket_base::get_no_delay(); }
 
+/**
+ * @brief Cork or uncork the socket (write coalescing)
+ *
+ * While corked, the kernel holds back partial segments even with
+ * TCP_NODELAY set, so a burst of small sends leaves as full-sized packets.
+ * Uncorking transmits whatever is pending immediately. Uses TCP_CORK on
+ * Linux and TCP_NOPUSH on the BSDs and macOS; elsewhere corking re-enables
+ * Nagle's algorithm and uncorking sets TCP_NODELAY, which also pushes
+ * pending data.
+ *
+ * @param flag True to cork, false to uncork and flush
+ * @throws std::system_error on option failure
+ */
+void tcp_client::set_cork(bool flag)
+{
+  check_initialized();
+#if defined(TCP_CORK)
+  int value = flag ? 1 : 0;
+  set_option(IPPROTO_TCP, TCP_CORK, value);
+#elif defined(TCP_NOPUSH)
+  int value = flag ? 1 : 0;
+  set_option(IPPROTO_TCP, TCP_NOPUSH, value);
+#else
+  socket_base::set_no_delay(!flag);
+#endif
+}
+
+/**
+ * @brief Check whether the socket is corked
+ * @return True if partial segments are being held back
+ * @throws std::system_error on option failure
+ */
+bool tcp_client::get_cork()
+{
+  check_initialized();
+#if defined(TCP_CORK)
+  int value = 0;
+  get_option(IPPROTO_TCP, TCP_CORK, value);
+  return value != 0;
+#elif defined(TCP_NOPUSH)
+  int value = 0;
+  get_option(IPPROTO_TCP, TCP_NOPUSH, value);
+  return value != 0;
+#else
+  return !socket_base::get_no_delay();
+#endif
+}
+
 /**
  * @brief Set keep alive option
  * @param flag Enable/disable keep alive
@@ -545,6 +1331,11 @@ bool tcp_client::get_keep_alive() { return socket_base::get_keep_alive(); }
  */
 bool tcp_client::poll_read(const std::chrono::milliseconds &timeout)
 {
+  if (m_tls && m_tls->pending() > 0)
+  {
+    // Decrypted bytes are waiting in the TLS engine, not the socket
+    return true;
+  }
   return poll(timeout, socket_base::SELECT_READ);
 }
 
@@ -559,6 +1350,72 @@ bool tcp_client::poll_write(const std::chrono::milliseconds &timeout)
   return poll(timeout, socket_base::SELECT_WRITE);
 }
 
+/**
+ * @brief Send through the user-space TLS engine
+ * @param buffer Plaintext to send
+ * @param length Number of bytes (positive)
+ * @return Number of plaintext bytes taken
+ * @throws std::system_error on send failure
+ */
+int tcp_client::tls_send(const void *buffer, int length)
+{
+  int sent = 0;
+  try
+  {
+    sent = m_tls->write(buffer, length);
+  }
+  catch (const std::system_error &)
+  {
+    if (onSendError.slot_count() > 0)
+    {
+      onSendError.emit("Failed to send data");
+    }
+    throw;
+  }
+  if (onDataSent.slot_count() > 0)
+  {
+    onDataSent.emit(static_cast<size_t>(sent));
+  }
+  return sent;
+}
+
+/**
+ * @brief Receive through the TLS engine
+ * @param buffer Destination for plaintext
+ * @param length Capacity (positive)
+ * @return Number of bytes received, 0 if the peer closed
+ * @throws std::system_error on receive failure
+ */
+int tcp_client::tls_receive(void *buffer, int length)
+{
+  int received = 0;
+  try
+  {
+    received = m_tls->read(buffer, length);
+  }
+  catch (const std::system_error &)
+  {
+    if (onReceiveError.slot_count() > 0)
+    {
+      onReceiveError.emit("Failed to receive data");
+    }
+    throw;
+  }
+  if (received == 0)
+  {
+    set_connected(false);
+    if (onDisconnected.slot_count() > 0)
+    {
+      onDisconnected.emit();
+    }
+  }
+  else if (onDataReceived.slot_count() > 0)
+  {
+    onDataReceived.emit(buffer, static_cast<size_t>(received));
+  }
+  return received;
+}
+
 /**
  * @brief Initialize TCP socket with specific address family
  * @param family Address family (IPv4 or IPv6)
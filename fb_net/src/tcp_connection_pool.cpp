@@ -0,0 +1,457 @@
+#include <fb/tcp_connection_pool.h>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+namespace fb
+{
+
+/**
+ * @class fb::tcp_connection_lease
+ * @brief Move-only handle that returns a pooled connection on destruction.
+ */
+
+/**
+ * @brief Wrap a connection handed out by a pool.
+ *
+ * @param pool Owning pool.
+ * @param address Endpoint the connection is keyed by.
+ * @param client Connected socket.
+ * @param reused True if the socket came from the idle list.
+ */
+tcp_connection_lease::tcp_connection_lease(tcp_connection_pool *pool,
+                                           const socket_address &address,
+                                           tcp_client client,
+                                           bool reused) :
+  m_pool(pool),
+  m_address(address),
+  m_client(std::move(client)),
+  m_reused(reused),
+  m_invalid(false)
+{
+}
+
+/**
+ * @brief Return the connection to its pool.
+ */
+tcp_connection_lease::~tcp_connection_lease() { release(); }
+
+/**
+ * @brief Take over another lease; the source becomes empty.
+ */
+tcp_connection_lease::tcp_connection_lease(tcp_connection_lease &&other) noexcept :
+  m_pool(other.m_pool),
+  m_address(std::move(other.m_address)),
+  m_client(std::move(other.m_client)),
+  m_reused(other.m_reused),
+  m_invalid(other.m_invalid)
+{
+  other.m_pool = nullptr;
+}
+
+/**
+ * @brief Release the current connection, then take over another lease.
+ *
+ * @return Reference to this lease.
+ */
+tcp_connection_lease &
+tcp_connection_lease::operator=(tcp_connection_lease &&other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    m_pool       = other.m_pool;
+    m_address    = std::move(other.m_address);
+    m_client     = std::move(other.m_client);
+    m_reused     = other.m_reused;
+    m_invalid    = other.m_invalid;
+    other.m_pool = nullptr;
+  }
+  return *this;
+}
+
+/**
+ * @brief Leased connection.
+ *
+ * @throws std::logic_error If the lease is empty or already released.
+ */
+tcp_client &tcp_connection_lease::client()
+{
+  if (!m_pool)
+  {
+    throw std::logic_error("Connection lease is empty");
+  }
+  return m_client;
+}
+
+/**
+ * @brief Member access to the leased connection.
+ *
+ * @throws std::logic_error If the lease is empty or already released.
+ */
+tcp_client *tcp_connection_lease::operator->() { return &client(); }
+
+/**
+ * @brief Leased connection.
+ *
+ * @throws std::logic_error If the lease is empty or already released.
+ */
+tcp_client &tcp_connection_lease::operator*() { return client(); }
+
+/**
+ * @brief Endpoint the connection is keyed by.
+ */
+const socket_address &tcp_connection_lease::address() const
+{
+  return m_address;
+}
+
+/**
+ * @brief Check whether the connection was reused rather than newly opened.
+ */
+bool tcp_connection_lease::reused() const { return m_reused; }
+
+/**
+ * @brief Check whether the lease still holds a connection.
+ */
+tcp_connection_lease::operator bool() const { return m_pool != nullptr; }
+
+/**
+ * @brief Close the connection on release instead of returning it to the pool.
+ *
+ * Use after an I/O error, a timeout or a protocol violation that leaves the
+ * stream in an unknown state.
+ */
+void tcp_connection_lease::invalidate() { m_invalid = true; }
+
+/**
+ * @brief Return the connection to the pool now; the lease becomes empty.
+ */
+void tcp_connection_lease::release()
+{
+  if (!m_pool)
+  {
+    return;
+  }
+
+  tcp_connection_pool *pool = m_pool;
+  m_pool = nullptr;
+  pool->give_back(m_address, std::move(m_client), m_invalid);
+}
+
+/**
+ * @class fb::tcp_connection_pool
+ * @brief Endpoint-keyed keep-alive pool of connected TCP clients.
+ */
+
+/**
+ * @brief Create an empty pool.
+ *
+ * @param max_idle_per_address Idle connections kept per endpoint (0 keeps none).
+ * @param idle_timeout Idle age after which a connection is closed (0 disables).
+ * @param connect_timeout Timeout for establishing new connections.
+ * @throws std::invalid_argument If a timeout is negative or connect_timeout is zero.
+ */
+tcp_connection_pool::tcp_connection_pool(
+    std::size_t max_idle_per_address,
+    const std::chrono::milliseconds &idle_timeout,
+    const std::chrono::milliseconds &connect_timeout) :
+  m_max_idle(max_idle_per_address),
+  m_idle_timeout(idle_timeout),
+  m_connect_timeout(connect_timeout),
+  m_no_delay(false),
+  m_leased(0),
+  m_created(0),
+  m_reused(0)
+{
+  if (idle_timeout.count() < 0)
+  {
+    throw std::invalid_argument("Idle timeout must not be negative");
+  }
+  if (connect_timeout.count() <= 0)
+  {
+    throw std::invalid_argument("Connect timeout must be positive");
+  }
+}
+
+/**
+ * @brief Close all idle connections.
+ *
+ * Outstanding leases must have been released before the pool is destroyed.
+ */
+tcp_connection_pool::~tcp_connection_pool() { clear(); }
+
+/**
+ * @brief Lease a connection to an endpoint.
+ *
+ * Idle connections to @p address are tried most recently returned first;
+ * expired or unhealthy ones are closed. If none is usable a new connection
+ * is opened with the pool's connect timeout.
+ *
+ * @param address Remote endpoint.
+ * @return Lease holding a connected socket.
+ * @throws std::system_error If a new connection cannot be established.
+ */
+tcp_connection_lease tcp_connection_pool::acquire(const socket_address &address)
+{
+  for (;;)
+  {
+    tcp_client candidate(INVALID_SOCKET_VALUE);
+    health_check check;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_idle.find(address);
+      if (it == m_idle.end() || it->second.empty())
+      {
+        break;
+      }
+
+      idle_connection entry = std::move(it->second.back());
+      it->second.pop_back();
+      if (it->second.empty())
+      {
+        m_idle.erase(it);
+      }
+      if (m_idle_timeout.count() > 0 &&
+          std::chrono::steady_clock::now() - entry.since > m_idle_timeout)
+      {
+        continue; // Expired; closed when entry goes out of scope
+      }
+      candidate = std::move(entry.client);
+      check     = m_health_check;
+    }
+
+    if (is_healthy(candidate, check))
+    {
+      m_reused.fetch_add(1);
+      m_leased.fetch_add(1);
+      return tcp_connection_lease(this, address, std::move(candidate), true);
+    }
+  }
+
+  bool no_delay = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    no_delay = m_no_delay;
+  }
+
+  tcp_client client(address.family());
+  client.connect(address, m_connect_timeout);
+  // Nagle only applies to TCP, not to Unix domain stream sockets
+  if (no_delay && address.family() != socket_address::UNIX_LOCAL)
+  {
+    client.set_no_delay(true);
+  }
+
+  m_created.fetch_add(1);
+  m_leased.fetch_add(1);
+  return tcp_connection_lease(this, address, std::move(client), false);
+}
+
+/**
+ * @brief Install an additional check run before an idle connection is reused.
+ *
+ * The check runs after the built-in readability test, outside the pool lock.
+ * Returning false or throwing closes the connection and tries the next one.
+ *
+ * @param check Predicate on the idle connection (nullptr removes it).
+ */
+void tcp_connection_pool::set_health_check(health_check check)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_health_check = std::move(check);
+}
+
+/**
+ * @brief Enable TCP_NODELAY on connections opened from now on.
+ *
+ * @param flag True to disable Nagle's algorithm on new connections.
+ */
+void tcp_connection_pool::set_no_delay(bool flag)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_no_delay = flag;
+}
+
+/**
+ * @brief Close idle connections older than the idle timeout.
+ *
+ * acquire() skips expired connections anyway; call this periodically to
+ * release their descriptors sooner.
+ *
+ * @return Number of connections closed.
+ */
+std::size_t tcp_connection_pool::prune()
+{
+  std::vector<idle_connection> expired;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_idle_timeout.count() == 0)
+    {
+      return 0;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = m_idle.begin(); it != m_idle.end();)
+    {
+      auto &entries = it->second;
+      for (auto entry = entries.begin(); entry != entries.end();)
+      {
+        if (now - entry->since > m_idle_timeout)
+        {
+          expired.push_back(std::move(*entry));
+          entry = entries.erase(entry);
+        }
+        else
+        {
+          ++entry;
+        }
+      }
+      it = entries.empty() ? m_idle.erase(it) : std::next(it);
+    }
+  }
+  return expired.size();
+}
+
+/**
+ * @brief Close every idle connection.
+ */
+void tcp_connection_pool::clear()
+{
+  std::map<socket_address, std::vector<idle_connection>> idle;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    idle.swap(m_idle);
+  }
+}
+
+/**
+ * @brief Number of idle connections across all endpoints.
+ */
+std::size_t tcp_connection_pool::idle_connections() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::size_t count = 0;
+  for (const auto &entry : m_idle)
+  {
+    count += entry.second.size();
+  }
+  return count;
+}
+
+/**
+ * @brief Number of idle connections to one endpoint.
+ */
+std::size_t
+tcp_connection_pool::idle_connections(const socket_address &address) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_idle.find(address);
+  return it == m_idle.end() ? 0 : it->second.size();
+}
+
+/**
+ * @brief Number of connections currently leased out.
+ */
+std::size_t tcp_connection_pool::leased_connections() const
+{
+  return m_leased.load();
+}
+
+/**
+ * @brief Number of connections opened by acquire().
+ */
+std::uint64_t tcp_connection_pool::connections_created() const
+{
+  return m_created.load();
+}
+
+/**
+ * @brief Number of leases served from an idle connection.
+ */
+std::uint64_t tcp_connection_pool::connections_reused() const
+{
+  return m_reused.load();
+}
+
+/**
+ * @brief Idle connections kept per endpoint.
+ */
+std::size_t tcp_connection_pool::max_idle_per_address() const
+{
+  return m_max_idle;
+}
+
+/**
+ * @brief Idle age after which connections are closed (0 = never).
+ */
+std::chrono::milliseconds tcp_connection_pool::idle_timeout() const
+{
+  return m_idle_timeout;
+}
+
+/**
+ * @brief Timeout used when opening new connections.
+ */
+std::chrono::milliseconds tcp_connection_pool::connect_timeout() const
+{
+  return m_connect_timeout;
+}
+
+/**
+ * @brief Decide whether an idle connection can be reused.
+ *
+ * A readable idle connection has either been closed by the peer or holds
+ * unsolicited data; both make it unusable for a new request.
+ *
+ * @param client Idle connection.
+ * @param check Optional user check.
+ * @return True if the connection may be leased.
+ */
+bool tcp_connection_pool::is_healthy(tcp_client &client,
+                                     const health_check &check) const
+{
+  try
+  {
+    if (client.is_closed() || client.poll_read(std::chrono::milliseconds(0)))
+    {
+      return false;
+    }
+    return !check || check(client);
+  }
+  catch (const std::exception &)
+  {
+    return false;
+  }
+}
+
+/**
+ * @brief Accept a connection back from a lease.
+ *
+ * @param address Endpoint the connection is keyed by.
+ * @param client Returned socket; closed if invalid or the idle list is full.
+ * @param invalid True if the lease was invalidated.
+ */
+void tcp_connection_pool::give_back(const socket_address &address,
+                                    tcp_client client,
+                                    bool invalid)
+{
+  m_leased.fetch_sub(1);
+  if (invalid || client.is_closed())
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto &entries = m_idle[address];
+  if (entries.size() < m_max_idle)
+  {
+    entries.push_back({std::move(client), std::chrono::steady_clock::now()});
+  }
+  else if (entries.empty())
+  {
+    m_idle.erase(address);
+  }
+}
+
+} // namespace fb
@@ -0,0 +1,307 @@
+#include <fb/tcp_connector.h>
+#include <fb/detail/socket_error_utils.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace fb
+{
+
+/**
+ * @class fb::tcp_connector
+ * @brief Multiplexes non-blocking connects over a single poll_set.
+ */
+
+/**
+ * @brief Create a connector with no pending attempts.
+ */
+tcp_connector::tcp_connector() :
+  m_next_id(1)
+{
+}
+
+/**
+ * @brief Close all pending sockets without invoking their handlers.
+ */
+tcp_connector::~tcp_connector() = default;
+
+/**
+ * @brief Start a non-blocking connect.
+ *
+ * The attempt completes in a later run() or wait() call. Failures detected
+ * immediately (for example an unreachable network) are reported there too,
+ * so handlers never run inside connect().
+ *
+ * @param address Remote endpoint.
+ * @param timeout Time allowed for the connect to complete.
+ * @param handler Completion callback (may be nullptr when only signals are used).
+ * @return Id identifying the attempt in handlers, signals and cancel().
+ * @throws std::invalid_argument If timeout is not positive.
+ * @throws std::system_error If no socket can be created or registered.
+ */
+std::uint64_t tcp_connector::connect(const socket_address &address,
+                                     const std::chrono::milliseconds &timeout,
+                                     connect_handler handler)
+{
+  if (timeout.count() <= 0)
+  {
+    throw std::invalid_argument("Connect timeout must be positive");
+  }
+
+  auto op      = std::make_unique<attempt>();
+  op->id       = m_next_id++;
+  op->address  = address;
+  op->client   = tcp_client(address.family());
+  op->deadline = std::chrono::steady_clock::now() + timeout;
+  op->handler  = std::move(handler);
+
+  const std::uint64_t id = op->id;
+  try
+  {
+    op->client.connect_non_blocking(address);
+  }
+  catch (const std::system_error &ex)
+  {
+    op->error = ex.code();
+    m_failed.push_back(std::move(op));
+    return id;
+  }
+
+  // Events carry the id, not the attempt: a handler may cancel (and free)
+  // another attempt that is still further down the same event batch
+  m_poll_set.add(op->client, poll_set::POLL_WRITE | poll_set::POLL_ERROR,
+                 reinterpret_cast<void *>(static_cast<std::uintptr_t>(id)));
+  m_attempts.emplace(id, std::move(op));
+  return id;
+}
+
+/**
+ * @brief Wait up to @p timeout for connects to complete and report them.
+ *
+ * Returns early as soon as at least one attempt completed; the wait is also
+ * cut short by the nearest attempt deadline.
+ *
+ * @param timeout Maximum time to block.
+ * @return Number of attempts completed (successfully or not).
+ * @throws std::system_error If polling fails.
+ */
+std::size_t tcp_connector::run(const std::chrono::milliseconds &timeout)
+{
+  std::size_t completed = deliver_failed();
+  if (completed > 0 || m_attempts.empty())
+  {
+    return completed;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  auto nearest = now + timeout;
+  for (const auto &entry : m_attempts)
+  {
+    nearest = std::min(nearest, entry.second->deadline);
+  }
+  const auto wait = std::max(
+      std::chrono::milliseconds(0),
+      std::chrono::ceil<std::chrono::milliseconds>(nearest - now));
+
+  m_poll_set.poll(m_events, wait);
+  for (const auto &event : m_events)
+  {
+    const std::uint64_t id = reinterpret_cast<std::uintptr_t>(event.user_data);
+    auto it = m_attempts.find(id);
+    if (it == m_attempts.end())
+    {
+      continue; // Cancelled by an earlier handler in this batch
+    }
+    attempt *op = it->second.get();
+
+    int so_error = 0;
+    try
+    {
+      op->client.get_option(SOL_SOCKET, SO_ERROR, so_error);
+    }
+    catch (const std::system_error &ex)
+    {
+      so_error = ex.code().value();
+    }
+
+    std::error_code error;
+    if (so_error != 0)
+    {
+      error = detail::make_native_error_code(so_error);
+    }
+    else if ((event.mode & poll_set::POLL_ERROR) != 0)
+    {
+      error = std::make_error_code(std::errc::connection_refused);
+    }
+
+    auto owned = std::move(it->second);
+    m_attempts.erase(it);
+    completed += complete(std::move(owned), error);
+  }
+
+  return completed + expire(std::chrono::steady_clock::now());
+}
+
+/**
+ * @brief Run until every pending attempt has completed or @p timeout elapses.
+ *
+ * @param timeout Maximum total time to block.
+ * @return True if no attempts remain pending.
+ * @throws std::system_error If polling fails.
+ */
+bool tcp_connector::wait(const std::chrono::milliseconds &timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (pending() > 0)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline)
+    {
+      return false;
+    }
+    run(std::chrono::ceil<std::chrono::milliseconds>(deadline - now));
+  }
+  return true;
+}
+
+/**
+ * @brief Abort a pending attempt.
+ *
+ * The handler is invoked immediately with std::errc::operation_canceled.
+ *
+ * @param id Attempt id returned by connect().
+ * @return True if the attempt was pending.
+ */
+bool tcp_connector::cancel(std::uint64_t id)
+{
+  auto it = m_attempts.find(id);
+  if (it != m_attempts.end())
+  {
+    auto owned = std::move(it->second);
+    m_attempts.erase(it);
+    complete(std::move(owned), std::make_error_code(std::errc::operation_canceled));
+    return true;
+  }
+
+  auto failed = std::find_if(m_failed.begin(), m_failed.end(),
+                             [id](const std::unique_ptr<attempt> &op)
+                             { return op->id == id; });
+  if (failed != m_failed.end())
+  {
+    auto owned = std::move(*failed);
+    m_failed.erase(failed);
+    complete(std::move(owned), std::make_error_code(std::errc::operation_canceled));
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Abort every pending attempt, invoking each handler.
+ */
+void tcp_connector::cancel_all()
+{
+  while (!m_failed.empty() || !m_attempts.empty())
+  {
+    const std::uint64_t id = m_failed.empty() ? m_attempts.begin()->first
+                                              : m_failed.front()->id;
+    cancel(id);
+  }
+}
+
+/**
+ * @brief Number of attempts that have not completed yet.
+ */
+std::size_t tcp_connector::pending() const
+{
+  return m_attempts.size() + m_failed.size();
+}
+
+/**
+ * @brief Finish one attempt: unregister it, notify, and hand over the socket.
+ *
+ * @param op Attempt already removed from the pending containers.
+ * @param error Outcome (empty on success).
+ * @return Always 1, for accumulating completion counts.
+ */
+std::size_t tcp_connector::complete(std::unique_ptr<attempt> op,
+                                    const std::error_code &error)
+{
+  if (m_poll_set.has(op->client))
+  {
+    m_poll_set.remove(op->client);
+  }
+
+  if (!error)
+  {
+    op->client.set_blocking(true);
+    if (onConnected.slot_count() > 0)
+    {
+      onConnected.emit(op->id, op->address);
+    }
+  }
+  else
+  {
+    op->client.close();
+    if (onConnectFailed.slot_count() > 0)
+    {
+      onConnectFailed.emit(op->id, op->address, error.message());
+    }
+  }
+
+  if (op->handler)
+  {
+    op->handler(op->id, op->address, std::move(op->client), error);
+  }
+  return 1;
+}
+
+/**
+ * @brief Report attempts whose connect() call failed outright.
+ *
+ * @return Number of attempts reported.
+ */
+std::size_t tcp_connector::deliver_failed()
+{
+  std::vector<std::unique_ptr<attempt>> failed;
+  failed.swap(m_failed);
+
+  std::size_t completed = 0;
+  for (auto &op : failed)
+  {
+    const std::error_code error = op->error;
+    completed += complete(std::move(op), error);
+  }
+  return completed;
+}
+
+/**
+ * @brief Fail every attempt whose deadline has passed.
+ *
+ * @param now Current time.
+ * @return Number of attempts timed out.
+ */
+std::size_t tcp_connector::expire(const std::chrono::steady_clock::time_point &now)
+{
+  std::vector<std::unique_ptr<attempt>> expired;
+  for (auto it = m_attempts.begin(); it != m_attempts.end();)
+  {
+    if (it->second->deadline <= now)
+    {
+      expired.push_back(std::move(it->second));
+      it = m_attempts.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  std::size_t completed = 0;
+  for (auto &op : expired)
+  {
+    completed += complete(std::move(op), std::make_error_code(std::errc::timed_out));
+  }
+  return completed;
+}
+
+} // namespace fb
@@ -0,0 +1,419 @@
+#include <fb/tcp_reactor_connection.h>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#endif
+
+namespace fb
+{
+
+namespace
+{
+
+#if defined(MSG_NOSIGNAL)
+constexpr int BUFFERED_SEND_FLAGS = MSG_NOSIGNAL; // Report EPIPE instead of raising SIGPIPE
+#else
+constexpr int BUFFERED_SEND_FLAGS = 0;
+#endif
+
+} // namespace
+
+/**
+ * @class fb::tcp_reactor_connection
+ * @brief Callback-driven connection handler used by tcp_server reactor mode.
+ *
+ * The owning event loop registers the socket with its poll_set, dispatches
+ * readiness callbacks, and retires the connection once close() has been
+ * requested or the socket has been closed.
+ */
+
+/**
+ * @brief Wrap an accepted client socket.
+ *
+ * @param socket Connected client socket.
+ * @param client_address Remote endpoint associated with the socket.
+ * @throws std::invalid_argument If the supplied socket is already closed.
+ */
+tcp_reactor_connection::tcp_reactor_connection(
+    tcp_client socket,
+    const socket_address &client_address) :
+  m_socket(std::move(socket)),
+  m_client_address(client_address),
+  m_close_requested(false),
+  m_write_interest(false),
+  m_write_coalescing(false),
+  m_start_time(std::chrono::steady_clock::now()),
+  m_output_offset(0),
+  m_output_high(false),
+  m_refused_writes(0),
+  m_last_activity(0),
+  m_output_progress(0),
+  m_timer(timer_wheel::INVALID_TIMER)
+{
+  if (m_socket.is_closed())
+  {
+    throw std::invalid_argument(
+        "Invalid socket provided to tcp_reactor_connection");
+  }
+}
+
+/**
+ * @brief Return still-queued output to the server's budget.
+ */
+tcp_reactor_connection::~tcp_reactor_connection()
+{
+  if (m_budget)
+  {
+    m_budget->release(buffered_output());
+  }
+}
+
+/**
+ * @brief Hook invoked after the connection is registered with its event loop.
+ *
+ * The base implementation is a no-op.
+ */
+void tcp_reactor_connection::on_open()
+{
+  // Default implementation does nothing
+}
+
+/**
+ * @brief Hook invoked when the socket is writable.
+ *
+ * Only delivered while write interest is enabled. The base implementation
+ * clears write interest so an unhandled writable socket does not spin the
+ * event loop.
+ */
+void tcp_reactor_connection::on_writable() { m_write_interest = false; }
+
+/**
+ * @brief Hook invoked before the socket is closed.
+ *
+ * The base implementation is a no-op.
+ */
+void tcp_reactor_connection::on_close()
+{
+  // Default implementation does nothing
+}
+
+/**
+ * @brief Request that the event loop retire this connection.
+ *
+ * The socket is closed after the current callback returns.
+ */
+void tcp_reactor_connection::close() { m_close_requested = true; }
+
+/**
+ * @brief Check whether close() has been requested.
+ */
+bool tcp_reactor_connection::close_requested() const
+{
+  return m_close_requested;
+}
+
+/**
+ * @brief Enable or disable writable notifications.
+ *
+ * Enable after a partial write to be called back once the socket can accept
+ * more data; disable once the pending output has been flushed.
+ *
+ * @param flag True to receive on_writable() callbacks.
+ */
+void tcp_reactor_connection::set_write_interest(bool flag)
+{
+  m_write_interest = flag;
+}
+
+/**
+ * @brief Check whether writable notifications are enabled.
+ */
+bool tcp_reactor_connection::write_interest() const
+{
+  return m_write_interest;
+}
+
+/**
+ * @brief Coalesce writes made during one event-loop dispatch.
+ *
+ * When enabled, the event loop corks the socket before invoking on_open(),
+ * on_readable() or on_writable() and uncorks it once they return. Small
+ * sends made by the callbacks then leave as full segments at the end of the
+ * dispatch, even with TCP_NODELAY set. Costs two setsockopt() calls per
+ * dispatch.
+ *
+ * @param flag True to batch each dispatch's output.
+ */
+void tcp_reactor_connection::set_write_coalescing(bool flag)
+{
+  m_write_coalescing = flag;
+}
+
+/**
+ * @brief Check whether per-dispatch write coalescing is enabled.
+ */
+bool tcp_reactor_connection::write_coalescing() const
+{
+  return m_write_coalescing;
+}
+
+/**
+ * @brief Send bytes without blocking, queueing what the socket cannot take.
+ *
+ * Queued output is flushed by the event loop whenever the socket becomes
+ * writable, ahead of on_writable(). The write is refused as a whole, and
+ * nothing is sent, if queueing all of it could exceed the connection's
+ * max_buffered or the server's total_max_buffered, so a refused message can
+ * be dropped or retried without corrupting the stream. Call only from
+ * this connection's callbacks.
+ *
+ * @param buffer Bytes to send.
+ * @param length Number of bytes.
+ * @return True if the bytes were sent or queued, false if refused.
+ * @throws std::invalid_argument If buffer is null and length is not zero.
+ * @throws std::system_error If the socket fails.
+ */
+bool tcp_reactor_connection::send_buffered(const void *buffer,
+                                           std::size_t length)
+{
+  if (length == 0)
+  {
+    return true;
+  }
+  if (!buffer)
+  {
+    throw std::invalid_argument("Buffer cannot be null");
+  }
+
+  const std::size_t queued = buffered_output();
+  if (m_backpressure.max_buffered > 0 &&
+      length > m_backpressure.max_buffered - std::min(queued, m_backpressure.max_buffered))
+  {
+    ++m_refused_writes;
+    return false;
+  }
+  // Reserve the whole write up front; the part sent right away is returned
+  if (m_budget && !m_budget->try_acquire(length))
+  {
+    ++m_refused_writes;
+    return false;
+  }
+
+  const char *data = static_cast<const char *>(buffer);
+  std::size_t sent = 0;
+  try
+  {
+    if (queued == 0)
+    {
+      sent = write_some(data, length);
+    }
+  }
+  catch (...)
+  {
+    if (m_budget)
+    {
+      m_budget->release(length);
+    }
+    throw;
+  }
+  if (m_budget && sent > 0)
+  {
+    m_budget->release(sent);
+  }
+  if (sent == length)
+  {
+    return true;
+  }
+
+  if (m_output_offset > 0 && m_output_offset >= m_output.size() / 2)
+  {
+    m_output.erase(m_output.begin(),
+                   m_output.begin() + static_cast<std::ptrdiff_t>(m_output_offset));
+    m_output_offset = 0;
+  }
+  m_output.insert(m_output.end(), data + sent, data + length);
+
+  const std::size_t now_queued = buffered_output();
+  if (!m_output_high && m_backpressure.high_watermark > 0 &&
+      now_queued >= m_backpressure.high_watermark)
+  {
+    m_output_high = true;
+    if (onOutputHigh.has_slots())
+    {
+      onOutputHigh.emit(now_queued);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Bytes queued by send_buffered() that the socket has not taken yet.
+ */
+std::size_t tcp_reactor_connection::buffered_output() const
+{
+  return m_output.size() - m_output_offset;
+}
+
+/**
+ * @brief Number of send_buffered() calls refused by a limit.
+ */
+std::uint64_t tcp_reactor_connection::refused_writes() const
+{
+  return m_refused_writes;
+}
+
+/**
+ * @brief Override the limits that apply to this connection.
+ *
+ * The server installs its own policy before on_open(); call this from
+ * on_open() to give one connection different limits. total_max_buffered is
+ * ignored here.
+ *
+ * @param policy Per-connection limits.
+ * @throws std::invalid_argument If low_watermark exceeds high_watermark.
+ */
+void tcp_reactor_connection::set_backpressure(const backpressure_policy &policy)
+{
+  if (policy.high_watermark > 0 && policy.low_watermark > policy.high_watermark)
+  {
+    throw std::invalid_argument("Low watermark must not exceed high watermark");
+  }
+  m_backpressure = policy;
+}
+
+/**
+ * @brief Limits that apply to this connection.
+ */
+const backpressure_policy &tcp_reactor_connection::backpressure() const
+{
+  return m_backpressure;
+}
+
+/**
+ * @brief Whether the event loop should poll for writability.
+ */
+bool tcp_reactor_connection::wants_writable() const
+{
+  return m_write_interest || m_output_offset < m_output.size();
+}
+
+/**
+ * @brief Write as much queued output as the socket takes.
+ *
+ * Raises onOutputLow once the queue drains to the low watermark after
+ * onOutputHigh was raised.
+ *
+ * @throws std::system_error If the socket fails.
+ */
+void tcp_reactor_connection::flush_output()
+{
+  const std::size_t queued = buffered_output();
+  if (queued == 0)
+  {
+    return;
+  }
+
+  const std::size_t sent = write_some(m_output.data() + m_output_offset, queued);
+  if (m_budget)
+  {
+    m_budget->release(sent);
+  }
+  m_output_offset += sent;
+  if (m_output_offset == m_output.size())
+  {
+    m_output.clear();
+    m_output_offset = 0;
+  }
+
+  const std::size_t remaining = buffered_output();
+  if (m_output_high && remaining <= m_backpressure.low_watermark)
+  {
+    m_output_high = false;
+    if (onOutputLow.has_slots())
+    {
+      onOutputLow.emit(remaining);
+    }
+  }
+}
+
+/**
+ * @brief Send until the socket would block.
+ *
+ * @return Number of bytes the socket accepted.
+ * @throws std::system_error If the socket fails.
+ */
+std::size_t tcp_reactor_connection::write_some(const char *data,
+                                               std::size_t length)
+{
+  std::size_t sent = 0;
+  while (sent < length)
+  {
+    const int chunk = static_cast<int>(
+        std::min<std::size_t>(length - sent, static_cast<std::size_t>(INT_MAX)));
+    int written = 0;
+    try
+    {
+      written = m_socket.send_bytes(data + sent, chunk, BUFFERED_SEND_FLAGS);
+    }
+    catch (const std::system_error &ex)
+    {
+      if (ex.code() == std::errc::resource_unavailable_try_again)
+      {
+        break;
+      }
+      throw;
+    }
+    if (written <= 0)
+    {
+      break;
+    }
+    sent += static_cast<std::size_t>(written);
+  }
+  return sent;
+}
+
+/**
+ * @brief Access the underlying socket.
+ */
+tcp_client &tcp_reactor_connection::socket() { return m_socket; }
+
+/**
+ * @brief Access the underlying socket (const overload).
+ */
+const tcp_client &tcp_reactor_connection::socket() const { return m_socket; }
+
+/**
+ * @brief Remote endpoint of the connection.
+ */
+const socket_address &tcp_reactor_connection::client_address() const
+{
+  return m_client_address;
+}
+
+/**
+ * @brief Time elapsed since the connection object was created.
+ */
+std::chrono::steady_clock::duration tcp_reactor_connection::uptime() const
+{
+  return std::chrono::steady_clock::now() - m_start_time;
+}
+
+/**
+ * @brief Default exception handler for callback failures.
+ *
+ * Invoked by the event loop when a callback throws; the connection is closed
+ * afterwards. Override to add logging.
+ *
+ * @param ex Exception thrown by a callback.
+ */
+void tcp_reactor_connection::handle_exception(const std::exception &ex) noexcept
+{
+  static_cast<void>(ex);
+}
+
+} // namespace fb
@@ -1,12 +1,123 @@
 #include <fb/tcp_server.h>
+#include <fb/poll_set.h>
+#include <fb/timer_wheel.h>
+#include <fb/udp_socket.h>
 #include <algorithm>
 #include <chrono>
+#include <climits>
+#include <iterator>
+#include <limits>
 #include <stdexcept>
 #include <system_error>
+#include <unordered_map>
 
 namespace fb
 {
 
+namespace
+{
+
+int reactor_interest(bool wants_writable)
+{
+  return poll_set::POLL_READ | (wants_writable ? poll_set::POLL_WRITE : 0);
+}
+
+/// Cork a coalescing connection before its callbacks run.
+/// @return True if the socket was corked and must be uncorked afterwards.
+bool begin_write_coalescing(tcp_reactor_connection &connection) noexcept
+{
+  if (!connection.write_coalescing())
+  {
+    return false;
+  }
+  try
+  {
+    connection.socket().set_cork(true);
+    return true;
+  }
+  catch (const std::exception &)
+  {
+    return false; // Fall back to unbatched writes
+  }
+}
+
+/// Uncork after the callbacks, sending everything they wrote.
+void end_write_coalescing(tcp_reactor_connection &connection, bool corked) noexcept
+{
+  if (!corked || connection.socket().is_closed())
+  {
+    return;
+  }
+  try
+  {
+    connection.socket().set_cork(false);
+  }
+  catch (const std::exception &)
+  {
+    // Socket failed; the next callback observes the error
+  }
+}
+
+} // namespace
+
+/**
+ * @brief Per-thread state for reactor mode.
+ *
+ * Each loop owns a poll_set and the connections registered with it. The
+ * acceptor hands new connections over through `pending` and interrupts
+ * `poll()` by sending a byte to the loop's loopback wakeup socket. Idle and
+ * stalled-write deadlines of the loop's connections live in `timers`.
+ */
+struct tcp_server::reactor_loop
+{
+  poll_set poller;
+  timer_wheel timers;           ///< Timeout checks, one per connection
+  udp_socket wakeup_receiver;   ///< Loopback socket polled alongside clients
+  udp_socket wakeup_sender;     ///< Used by other threads to interrupt poll()
+  socket_address wakeup_address;
+  std::mutex pending_mutex;
+  std::vector<std::unique_ptr<tcp_reactor_connection>> pending;
+  std::unordered_map<const socket_base *,
+                     std::unique_ptr<tcp_reactor_connection>> connections;
+  std::thread thread;
+
+  explicit reactor_loop(const std::chrono::milliseconds &timer_resolution) :
+    timers(timer_resolution),
+    wakeup_receiver(socket_address("127.0.0.1", 0)),
+    wakeup_address(wakeup_receiver.address())
+  {
+    poller.add(wakeup_receiver, poll_set::POLL_READ);
+  }
+
+  void wake() noexcept
+  {
+    try
+    {
+      const char byte = 0;
+      wakeup_sender.send_to(&byte, 1, wakeup_address);
+    }
+    catch (...)
+    {
+      // The loop still re-checks its state on the next poll timeout
+    }
+  }
+};
+
+/**
+ * @brief One acceptor thread and the listening socket it serves.
+ *
+ * Shard 0 accepts on the configured server socket; additional shards own a
+ * SO_REUSEPORT listener bound to the same address. Accepted-connection
+ * counts are kept per shard and summed by total_connections().
+ */
+struct tcp_server::acceptor_shard
+{
+  std::unique_ptr<fb::server_socket> owned_socket; ///< Extra listener (shards > 0)
+  fb::server_socket *listener = nullptr;           ///< Socket this shard accepts on
+  std::thread thread;
+  alignas(64) std::atomic<std::uint64_t> accepted{0};
+};
+
 /**
  * @brief Construct an idle server with default limits.
  *
@@ -16,11 +127,23 @@ namespace fb
 tcp_server::tcp_server() :
   m_running(false),
   m_should_stop(false),
+  m_accepting(true),
+  m_event_loops(DEFAULT_EVENT_LOOPS),
+  m_next_loop(0),
+  m_reactor_connections(0),
+  m_timed_out_connections(0),
   m_max_threads(DEFAULT_MAX_THREADS),
   m_max_queued(DEFAULT_MAX_QUEUED),
   m_connection_timeout(DEFAULT_CONNECTION_TIMEOUT),
   m_idle_timeout(DEFAULT_IDLE_TIMEOUT),
+  m_use_lock_free_queue(false),
+  m_queue_spin_count(0),
+  m_acceptor_shards(DEFAULT_ACCEPTOR_SHARDS),
+  m_shard_backlog(0),
+  m_output_budget(std::make_shared<output_budget>()),
+  m_worker_serial(0),
   m_total_connections(0),
+  m_track_latency(false),
   m_has_socket(false),
   m_has_factory(false)
 {
@@ -46,11 +169,23 @@ tcp_server::tcp_server(fb::server_socket server_socket,
   m_connection_factory(std::move(connection_factory)),
   m_running(false),
   m_should_stop(false),
+  m_accepting(true),
+  m_event_loops(DEFAULT_EVENT_LOOPS),
+  m_next_loop(0),
+  m_reactor_connections(0),
+  m_timed_out_connections(0),
   m_max_threads(max_threads == 0 ? DEFAULT_MAX_THREADS : max_threads),
   m_max_queued(max_queued == 0 ? DEFAULT_MAX_QUEUED : max_queued),
   m_connection_timeout(DEFAULT_CONNECTION_TIMEOUT),
   m_idle_timeout(DEFAULT_IDLE_TIMEOUT),
+  m_use_lock_free_queue(false),
+  m_queue_spin_count(0),
+  m_acceptor_shards(DEFAULT_ACCEPTOR_SHARDS),
+  m_shard_backlog(0),
+  m_output_budget(std::make_shared<output_budget>()),
+  m_worker_serial(0),
   m_total_connections(0),
+  m_track_latency(false),
   m_has_socket(true),
   m_has_factory(true)
 {
@@ -63,23 +198,42 @@ tcp_server::tcp_server(fb::server_socket server_socket,
 tcp_server::tcp_server(tcp_server &&other) noexcept :
   m_server_socket(std::move(other.m_server_socket)),
   m_connection_factory(std::move(other.m_connection_factory)),
+  m_reactor_factory(std::move(other.m_reactor_factory)),
   m_running(other.m_running.load()),
   m_should_stop(other.m_should_stop.load()),
+  m_accepting(true),
+  m_event_loops(other.m_event_loops),
+  m_next_loop(0),
+  m_reactor_connections(0),
+  m_timed_out_connections(0),
   m_max_threads(other.m_max_threads),
   m_max_queued(other.m_max_queued),
   m_connection_timeout(other.m_connection_timeout),
   m_idle_timeout(other.m_idle_timeout),
-  m_total_connections(other.m_total_connections.load()),
+  m_use_lock_free_queue(other.m_use_lock_free_queue),
+  m_queue_spin_count(other.m_queue_spin_count),
+  m_acceptor_shards(other.m_acceptor_shards),
+  m_shard_backlog(other.m_shard_backlog),
+  m_pool_policy(other.m_pool_policy),
+  m_backpressure(other.m_backpressure),
+  m_output_budget(other.m_output_budget),
+  m_thread_configurator(std::move(other.m_thread_configurator)),
+  m_worker_serial(0),
+  m_total_connections(other.total_connections()),
   m_start_time(other.m_start_time),
+  m_track_latency(other.m_track_latency),
+  m_queue_latency(std::move(other.m_queue_latency)),
+  m_service_latency(std::move(other.m_service_latency)),
   m_has_socket(other.m_has_socket),
   m_has_factory(other.m_has_factory)
 {
   // Note: We cannot move threads, so the moved-from server loses its threads
   // This is acceptable as long as it wasn't running
-  other.m_running     = false;
-  other.m_should_stop = true;
-  other.m_has_socket  = false;
-  other.m_has_factory = false;
+  other.m_running       = false;
+  other.m_should_stop   = true;
+  other.m_track_latency = false;
+  other.m_has_socket    = false;
+  other.m_has_factory   = false;
 }
 
 /**
@@ -105,21 +259,37 @@ tcp_server &tcp_server::operator=(tcp_server &&other) noexcept
 
     m_server_socket      = std::move(other.m_server_socket);
     m_connection_factory = std::move(other.m_connection_factory);
+    m_reactor_factory    = std::move(other.m_reactor_factory);
+    m_event_loops        = other.m_event_loops;
     m_running            = other.m_running.load();
     m_should_stop        = other.m_should_stop.load();
     m_max_threads        = other.m_max_threads;
     m_max_queued         = other.m_max_queued;
     m_connection_timeout = other.m_connection_timeout;
     m_idle_timeout       = other.m_idle_timeout;
-    m_total_connections  = other.m_total_connections.load();
+    m_use_lock_free_queue = other.m_use_lock_free_queue;
+    m_queue_spin_count   = other.m_queue_spin_count;
+    m_acceptor_shards    = other.m_acceptor_shards;
+    m_shard_backlog      = other.m_shard_backlog;
+    m_pool_policy        = other.m_pool_policy;
+    m_backpressure       = other.m_backpressure;
+    m_output_budget      = other.m_output_budget;
+    m_thread_configurator = std::move(other.m_thread_configurator);
+    m_total_connections  = other.total_connections();
+    m_timed_out_connections = other.timed_out_connections();
+    m_acceptors.clear();
     m_start_time         = other.m_start_time;
+    m_track_latency      = other.m_track_latency;
+    m_queue_latency      = std::move(other.m_queue_latency);
+    m_service_latency    = std::move(other.m_service_latency);
     m_has_socket         = other.m_has_socket;
     m_has_factory        = other.m_has_factory;
 
-    other.m_running      = false;
-    other.m_should_stop  = true;
-    other.m_has_socket   = false;
-    other.m_has_factory  = false;
+    other.m_running       = false;
+    other.m_should_stop   = true;
+    other.m_track_latency = false;
+    other.m_has_socket    = false;
+    other.m_has_factory   = false;
   }
   return *this;
 }
@@ -158,21 +328,43 @@ void tcp_server::start()
 
   validate_configuration();
 
-  m_should_stop = false;
-  m_start_time  = std::chrono::steady_clock::now();
+  m_should_stop   = false;
+  m_accepting     = true;
+  m_worker_serial = 0;
+  m_start_time    = std::chrono::steady_clock::now();
 
   try
   {
     on_server_starting();
 
-    // Start acceptor thread
-    m_acceptor_thread = std::thread(&tcp_server::acceptor_thread_proc, this);
+    // Event loops must exist before the acceptor can hand connections over
+    if (is_reactor_mode())
+    {
+      start_reactor_loops();
+    }
+    else if (m_use_lock_free_queue)
+    {
+      m_lock_free_queue =
+          std::make_unique<mpmc_queue<std::unique_ptr<tcp_server_connection>>>(
+              m_max_queued, m_queue_spin_count);
+    }
+
+    // Bind any extra SO_REUSEPORT listeners, then start one acceptor each
+    open_acceptor_shards();
+    for (std::size_t i = 0; i < m_acceptors.size(); ++i)
+    {
+      m_acceptors[i]->thread = std::thread(&tcp_server::acceptor_thread_proc, this,
+                                           std::ref(*m_acceptors[i]), i);
+    }
 
-    // Start initial worker threads
-    std::lock_guard<std::mutex> lock(m_threads_mutex);
-    for (std::size_t i = 0; i < std::min(m_max_threads, std::size_t(4)); ++i)
+    // Start initial worker threads (reactor mode needs none)
+    if (!is_reactor_mode())
     {
-      m_worker_threads.emplace_back(&tcp_server::worker_thread_proc, this);
+      std::lock_guard<std::mutex> lock(m_threads_mutex);
+      for (std::size_t i = 0; i < min_worker_threads(); ++i)
+      {
+        m_worker_threads.emplace_back(&tcp_server::worker_thread_proc, this);
+      }
     }
 
     m_running = true;
@@ -186,10 +378,9 @@ void tcp_server::start()
   catch (...)
   {
     m_should_stop = true;
-    if (m_acceptor_thread.joinable())
-    {
-      m_acceptor_thread.join();
-    }
+    join_acceptors();
+    stop_reactor_loops();
+    m_lock_free_queue.reset();
     throw;
   }
 }
@@ -226,15 +417,31 @@ void tcp_server::stop(const std::chrono::milliseconds &timeout)
     {
       m_server_socket.close();
     }
+    for (auto &shard : m_acceptors)
+    {
+      if (shard->owned_socket && !shard->owned_socket->is_closed())
+      {
+        shard->owned_socket->close();
+      }
+    }
 
-    // Wake up all waiting worker threads
+    // Wake up all waiting worker threads and event loops
     m_queue_condition.notify_all();
+    if (m_lock_free_queue)
+    {
+      m_lock_free_queue->notify_all();
+    }
+    for (auto &loop : m_reactor_loops)
+    {
+      loop->wake();
+    }
 
     // Shutdown threads with timeout
     shutdown_threads(timeout);
 
     // Clean up remaining connections
     cleanup_connections();
+    m_lock_free_queue.reset();
 
     // Emit server stopped signal
     if (onServerStopped.slot_count() > 0)
@@ -254,6 +461,82 @@ void tcp_server::stop(const std::chrono::milliseconds &timeout)
   }
 }
 
+/**
+ * @brief Pass the listening socket to a successor process and stop accepting.
+ *
+ * The listener is switched to non-blocking mode (the flag is shared with
+ * the successor, so neither side can get stuck in accept() after losing a
+ * race) and sent with server_socket::send_listener(). Once the successor
+ * has acknowledged, the acceptor threads finish and this process's copy of
+ * the socket is closed. Connections already accepted keep being served;
+ * call drain() to wait for them and stop. Clients never see the port
+ * closed: connections arriving meanwhile wait in the shared accept queue.
+ *
+ * @param unix_path Unix socket path the successor passed to
+ * server_socket::receive_listener().
+ * @param timeout Maximum time to wait for the successor.
+ * @throws std::runtime_error If the server is not running.
+ * @throws std::logic_error If acceptor shards are configured.
+ * @throws std::system_error If the hand-off fails; the server keeps
+ * accepting.
+ */
+void tcp_server::hand_off_listener(const std::string &unix_path,
+                                   const std::chrono::milliseconds &timeout)
+{
+  if (!m_running.load())
+  {
+    throw std::runtime_error("tcp_server is not running");
+  }
+  if (m_acceptor_shards > 1)
+  {
+    throw std::logic_error(
+        "Listener hand-off does not support acceptor shards");
+  }
+
+  m_server_socket.set_blocking(false);
+  try
+  {
+    m_server_socket.send_listener(unix_path, timeout);
+  }
+  catch (...)
+  {
+    m_server_socket.set_blocking(true);
+    throw;
+  }
+
+  m_accepting = false;
+  join_acceptors();
+  m_server_socket.close();
+}
+
+/**
+ * @brief Wait for active connections to finish, then stop the server.
+ *
+ * Meant to follow hand_off_listener(), or any point after which no new
+ * connections should be taken on.
+ *
+ * @param timeout Maximum time to wait for active_connections() to reach
+ * zero; connections still open afterwards are stopped.
+ * @return True if every connection finished within the timeout.
+ * @throws std::runtime_error If the server is not running.
+ */
+bool tcp_server::drain(const std::chrono::milliseconds &timeout)
+{
+  if (!m_running.load())
+  {
+    throw std::runtime_error("tcp_server is not running");
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (active_connections() > 0 && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(DRAIN_POLL_INTERVAL);
+  }
+  const bool drained = active_connections() == 0;
+  stop();
+  return drained;
+}
+
 /**
  * @brief Query whether the server is actively running.
  *
@@ -296,6 +579,35 @@ void tcp_server::set_connection_factory(connection_factory factory)
   }
 
   m_connection_factory = std::move(factory);
+  m_reactor_factory    = nullptr;
+  m_has_factory        = true;
+}
+
+/**
+ * @brief Switch the server to reactor mode.
+ *
+ * Accepted sockets are made non-blocking and handed to one of `event_loops`
+ * threads, each multiplexing its connections through a `poll_set`. Replaces
+ * any factory installed with set_connection_factory().
+ *
+ * @param factory Callable that returns a `tcp_reactor_connection` for each
+ * accepted client.
+ * @param event_loops Number of event-loop threads (0 applies
+ * DEFAULT_EVENT_LOOPS).
+ * @throws std::runtime_error If called while the server is running.
+ */
+void tcp_server::set_reactor_factory(reactor_connection_factory factory,
+                                     std::size_t event_loops)
+{
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot set reactor factory while server is running");
+  }
+
+  m_reactor_factory    = std::move(factory);
+  m_connection_factory = nullptr;
+  m_event_loops        = event_loops == 0 ? DEFAULT_EVENT_LOOPS : event_loops;
   m_has_factory        = true;
 }
 
@@ -315,6 +627,32 @@ void tcp_server::set_max_threads(std::size_t max_threads)
   m_max_threads = max_threads == 0 ? DEFAULT_MAX_THREADS : max_threads;
 }
 
+/**
+ * @brief Configure how the worker pool grows and shrinks.
+ *
+ * @param policy Minimum pool size, growth triggers and idle retirement.
+ * @throws std::invalid_argument If queue_depth_per_thread is zero or a
+ * duration is negative.
+ * @throws std::runtime_error If called while the server is running.
+ */
+void tcp_server::set_worker_pool(const worker_pool_policy &policy)
+{
+  if (m_running.load())
+  {
+    throw std::runtime_error("Cannot set worker pool while server is running");
+  }
+  if (policy.queue_depth_per_thread == 0)
+  {
+    throw std::invalid_argument("Queue depth per thread must be positive");
+  }
+  if (policy.queue_wait_threshold.count() < 0 || policy.idle_timeout.count() < 0)
+  {
+    throw std::invalid_argument("Worker pool durations must not be negative");
+  }
+
+  m_pool_policy = policy;
+}
+
 /**
  * @brief Set the maximum number of pending connections waiting for a worker.
  *
@@ -334,8 +672,13 @@ void tcp_server::set_max_queued(std::size_t max_queued)
 /**
  * @brief Configure the per-connection I/O timeout.
  *
- * @param timeout Duration applied to each `tcp_server_connection` (0 disables
- * the timeout).
+ * Thread-per-connection handlers get it as their socket send and receive
+ * timeouts. Reactor connections are closed when output queued with
+ * send_buffered() makes no progress for this long; the deadline is kept in
+ * the event loop's timer wheel.
+ *
+ * @param timeout Duration applied to each connection (0 disables the
+ * timeout).
  * @throws std::runtime_error If called while the server is running.
  */
 void tcp_server::set_connection_timeout(
@@ -353,6 +696,12 @@ void tcp_server::set_connection_timeout(
 /**
  * @brief Configure automatic shutdown of idle connections.
  *
+ * Reactor connections that receive no readiness callback for this long are
+ * closed. Each event loop keeps the deadlines in a timer wheel, so arming,
+ * extending and expiring them is O(1) per connection. Thread-per-connection
+ * handlers block in their own I/O calls and rely on the connection timeout
+ * instead.
+ *
  * @param timeout Idle timeout; zero disables automatic disconnects.
  * @throws std::runtime_error If called while the server is running.
  */
@@ -367,140 +716,486 @@ void tcp_server::set_idle_timeout(const std::chrono::milliseconds &timeout)
 }
 
 /**
- * @brief Access the listening socket.
+ * @brief Hand accepted connections to workers through a lock-free ring
+ * instead of the mutex-protected queue.
  *
- * @return Reference to the configured `server_socket`.
- * @throws std::runtime_error If no socket has been configured yet.
+ * The ring holds max_queued connections (rounded up to a power of two);
+ * connections beyond that are dropped as in the default mode. Idle workers
+ * retry the ring @p spin_count times before parking. Ignored in reactor mode.
+ *
+ * @param enabled True to use the lock-free ring.
+ * @param spin_count Pop attempts before an idle worker parks (0 parks at once).
+ * @throws std::runtime_error If called while the server is running.
  */
-const fb::server_socket &tcp_server::server_socket() const
+void tcp_server::set_lock_free_queue(bool enabled, std::size_t spin_count)
 {
-  if (!m_has_socket)
+  if (m_running.load())
   {
-    throw std::runtime_error("No server socket is set");
+    throw std::runtime_error("Cannot change queue mode while server is running");
   }
-  return m_server_socket;
+
+  m_use_lock_free_queue = enabled;
+  m_queue_spin_count    = spin_count;
 }
 
 /**
- * @brief Get the number of connections currently being serviced.
- *
- * @return Count of active `tcp_server_connection` instances.
+ * @brief Check whether the lock-free handoff ring is enabled.
  */
-std::size_t tcp_server::active_connections() const
-{
-  std::lock_guard<std::mutex> lock(m_connections_mutex);
-  return m_active_connections.size();
-}
+bool tcp_server::lock_free_queue() const { return m_use_lock_free_queue; }
 
 /**
- * @brief Get the current number of worker threads.
+ * @brief Accept on several SO_REUSEPORT listeners sharing the server port.
  *
- * @return Size of the worker thread pool.
+ * On start() the server binds @p shards - 1 additional listening sockets to
+ * the server socket's address and runs one acceptor thread per socket, so
+ * the kernel spreads incoming connections across them. The server socket
+ * must have been bound with reuse_port enabled. The connection factory may
+ * then be invoked concurrently from several acceptor threads.
+ *
+ * @param shards Number of listening sockets (0 applies DEFAULT_ACCEPTOR_SHARDS).
+ * @param backlog Listen backlog for the extra sockets (0 uses the default).
+ * @throws std::runtime_error If called while the server is running.
  */
-std::size_t tcp_server::thread_count() const
+void tcp_server::set_acceptor_shards(std::size_t shards, int backlog)
 {
-  std::lock_guard<std::mutex> lock(m_threads_mutex);
-  return m_worker_threads.size();
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot set acceptor shards while server is running");
+  }
+
+  m_acceptor_shards = shards == 0 ? DEFAULT_ACCEPTOR_SHARDS : shards;
+  m_shard_backlog   = backlog;
 }
 
 /**
- * @brief Retrieve the cumulative number of accepted clients.
+ * @brief Record queue wait and service time histograms.
  *
- * @return Total clients accepted since the server started.
+ * In thread-per-connection mode each connection adds two samples when its
+ * handler returns: the time from accept to worker pickup and the time spent
+ * in run(). In reactor mode every readiness callback adds a service time
+ * sample (there is no queue). Read them with queue_latency() and
+ * service_latency(), or connect to onLatencyRecorded.
+ *
+ * @param enabled True to record latencies.
+ * @throws std::runtime_error If called while the server is running.
  */
-std::uint64_t tcp_server::total_connections() const
+void tcp_server::set_latency_tracking(bool enabled)
 {
-  return m_total_connections.load();
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot change latency tracking while server is running");
+  }
+
+  if (enabled && !m_queue_latency)
+  {
+    m_queue_latency   = std::make_unique<latency_histogram>();
+    m_service_latency = std::make_unique<latency_histogram>();
+  }
+  m_track_latency = enabled;
 }
 
 /**
- * @brief Report how many accepted connections are waiting for a worker.
+ * @brief Bound the output connections may buffer for slow clients.
  *
- * @return Pending connection count.
+ * Reactor connections receive the policy before on_open() and queue through
+ * send_buffered() within it; all of them share one total_max_buffered
+ * account. Thread-per-connection servers size each socket's kernel send
+ * buffer to max_buffered.
+ *
+ * @param policy Per-connection and server-wide limits.
+ * @throws std::invalid_argument If low_watermark exceeds high_watermark.
+ * @throws std::runtime_error If called while the server is running.
  */
-std::size_t tcp_server::queued_connections() const
+void tcp_server::set_backpressure(const backpressure_policy &policy)
 {
-  std::lock_guard<std::mutex> lock(m_queue_mutex);
-  return m_connection_queue.size();
+  if (m_running.load())
+  {
+    throw std::runtime_error("Cannot set backpressure while server is running");
+  }
+  if (policy.high_watermark > 0 && policy.low_watermark > policy.high_watermark)
+  {
+    throw std::invalid_argument("Low watermark must not exceed high watermark");
+  }
+
+  m_backpressure  = policy;
+  m_output_budget = std::make_shared<output_budget>(policy.total_max_buffered);
 }
 
 /**
- * @brief Measure how long the server has been running.
+ * @brief Set the callback that configures each server thread as it starts.
  *
- * @return Duration since `start()` was called, or zero if not running.
+ * Acceptor, event-loop and worker threads call @p configurator before doing
+ * any work and apply the returned thread_config, e.g. to keep them on
+ * dedicated cores. A config that cannot be applied is reported through
+ * handle_exception() and the thread runs on unconfigured.
+ *
+ * @param configurator Callback run on each new thread; empty disables.
+ * @throws std::runtime_error If called while the server is running.
  */
-std::chrono::steady_clock::duration tcp_server::uptime() const
+void tcp_server::set_thread_configurator(thread_configurator configurator)
 {
-  if (!m_running.load())
+  if (m_running.load())
   {
-    return std::chrono::steady_clock::duration::zero();
+    throw std::runtime_error(
+        "Cannot set thread configurator while server is running");
   }
-  return std::chrono::steady_clock::now() - m_start_time;
+
+  m_thread_configurator = std::move(configurator);
 }
 
 /**
- * @brief Default exception handling hook for subclasses.
- *
- * @param ex Exception that was thrown.
- * @param context String describing where the exception occurred.
- *
- * The base implementation is intentionally minimal; override to provide logging
- * or alerts.
+ * @brief Check whether latency tracking is enabled.
  */
-void tcp_server::handle_exception(const std::exception &ex,
-                                  const std::string &context) noexcept
+bool tcp_server::latency_tracking() const { return m_track_latency; }
+
+/**
+ * @brief Current worker pool sizing policy.
+ */
+const worker_pool_policy &tcp_server::worker_pool() const
 {
-  static_cast<void>(ex);
-  static_cast<void>(context);
-  // Default implementation: In production, this would log the exception
-  // For now, we just continue operation
-  // LOG_ERROR("tcp_server exception in " << context << ": " << ex.what());
+  return m_pool_policy;
 }
 
 /**
- * @brief Hook invoked immediately before worker threads are launched.
- *
- * Override to perform initialization tasks. The base implementation is a no-op.
+ * @brief Current outbound buffering limits.
  */
-void tcp_server::on_server_starting()
+const backpressure_policy &tcp_server::backpressure() const
 {
-  // Default implementation does nothing
+  return m_backpressure;
 }
 
 /**
- * @brief Hook invoked after `stop()` has been requested but before resources
- * are released.
- *
- * Override to perform cleanup tasks. The base implementation is a no-op.
+ * @brief Bytes currently queued by all reactor connections.
  */
-void tcp_server::on_server_stopping()
+std::size_t tcp_server::buffered_output() const
 {
-  // Default implementation does nothing
+  return m_output_budget->used();
 }
 
 /**
- * @brief Main loop for the acceptor thread responsible for admitting new
- * clients.
+ * @brief Writes refused because total_max_buffered was exhausted.
+ *
+ * Writes refused by a connection's own max_buffered are counted by
+ * tcp_reactor_connection::refused_writes().
  */
-void tcp_server::acceptor_thread_proc()
+std::uint64_t tcp_server::refused_writes() const
 {
-  while (!m_should_stop.load())
-  {
-    try
-    {
-      socket_address client_address;
+  return m_output_budget->refused();
+}
 
-      // Accept connection with timeout to allow checking stop condition
-      tcp_client client_socket = m_server_socket.accept_connection(
-          client_address, std::chrono::milliseconds(1000));
+/**
+ * @brief Number of listening sockets (and acceptor threads) used.
+ */
+std::size_t tcp_server::acceptor_shards() const { return m_acceptor_shards; }
 
-      if (m_should_stop.load())
-      {
-        break;
-      }
+/**
+ * @brief Connections admitted by one acceptor shard during the current run.
+ *
+ * @param shard Shard index (0 is the configured server socket).
+ * @return Accepted count, or 0 if the shard does not exist.
+ */
+std::uint64_t tcp_server::shard_connections(std::size_t shard) const
+{
+  std::lock_guard<std::mutex> lock(m_threads_mutex);
+  if (shard >= m_acceptors.size())
+  {
+    return 0;
+  }
+  return m_acceptors[shard]->accepted.load();
+}
 
-      // Create connection handler
-      auto connection =
+/**
+ * @brief Access the listening socket.
+ *
+ * @return Reference to the configured `server_socket`.
+ * @throws std::runtime_error If no socket has been configured yet.
+ */
+const fb::server_socket &tcp_server::server_socket() const
+{
+  if (!m_has_socket)
+  {
+    throw std::runtime_error("No server socket is set");
+  }
+  return m_server_socket;
+}
+
+/**
+ * @brief Get the number of connections currently being serviced.
+ *
+ * @return Count of active `tcp_server_connection` instances.
+ */
+std::size_t tcp_server::active_connections() const
+{
+  std::lock_guard<std::mutex> lock(m_connections_mutex);
+  return m_active_connections.size() + m_reactor_connections.load();
+}
+
+/**
+ * @brief Get the current number of worker threads.
+ *
+ * @return Size of the worker thread pool.
+ */
+std::size_t tcp_server::thread_count() const
+{
+  std::lock_guard<std::mutex> lock(m_threads_mutex);
+  return m_worker_threads.size();
+}
+
+/**
+ * @brief Get the number of reactor event-loop threads.
+ *
+ * @return Configured loop count in reactor mode, zero otherwise.
+ */
+std::size_t tcp_server::event_loop_count() const
+{
+  return is_reactor_mode() ? m_event_loops : 0;
+}
+
+/**
+ * @brief Check whether connections are served by event loops.
+ *
+ * @return True if a reactor factory is installed.
+ */
+bool tcp_server::is_reactor_mode() const
+{
+  return static_cast<bool>(m_reactor_factory);
+}
+
+/**
+ * @brief Reactor connections closed by the idle or connection timeout.
+ */
+std::uint64_t tcp_server::timed_out_connections() const
+{
+  return m_timed_out_connections.load();
+}
+
+/**
+ * @brief Retrieve the cumulative number of accepted clients.
+ *
+ * @return Total clients accepted since the server started.
+ */
+std::uint64_t tcp_server::total_connections() const
+{
+  std::uint64_t total = m_total_connections.load();
+
+  std::lock_guard<std::mutex> lock(m_threads_mutex);
+  for (const auto &shard : m_acceptors)
+  {
+    total += shard->accepted.load();
+  }
+  return total;
+}
+
+/**
+ * @brief Report how many accepted connections are waiting for a worker.
+ *
+ * @return Pending connection count.
+ */
+std::size_t tcp_server::queued_connections() const
+{
+  if (m_lock_free_queue)
+  {
+    return m_lock_free_queue->size_approx();
+  }
+
+  std::lock_guard<std::mutex> lock(m_queue_mutex);
+  return m_connection_queue.size();
+}
+
+/**
+ * @brief Distribution of accept-to-worker queue wait times.
+ *
+ * @return Snapshot of recorded samples; empty unless latency tracking is on.
+ */
+latency_snapshot tcp_server::queue_latency() const
+{
+  return m_queue_latency ? m_queue_latency->snapshot() : latency_snapshot();
+}
+
+/**
+ * @brief Distribution of connection (or reactor callback) service times.
+ *
+ * @return Snapshot of recorded samples; empty unless latency tracking is on.
+ */
+latency_snapshot tcp_server::service_latency() const
+{
+  return m_service_latency ? m_service_latency->snapshot()
+                           : latency_snapshot();
+}
+
+/**
+ * @brief Discard recorded queue wait and service time samples.
+ */
+void tcp_server::reset_latency_statistics()
+{
+  if (m_queue_latency)
+  {
+    m_queue_latency->reset();
+    m_service_latency->reset();
+  }
+}
+
+/**
+ * @brief Publish connection counters, buffered output and latencies in a
+ * metrics registry.
+ *
+ * Every metric is read from the existing statistics when the registry is
+ * exported; accepting and serving connections does no extra work. The
+ * latency summaries stay empty unless latency tracking is enabled.
+ *
+ * @param registry Registry to add the metrics to
+ * @param prefix Start of every metric name, e.g. "order_gateway"
+ * @return Handle that unregisters the metrics; destroy it before the server
+ * @throws std::invalid_argument if a name is invalid or already registered
+ */
+metrics_registration tcp_server::register_metrics(metrics_registry& registry,
+                                                  const std::string& prefix) const
+{
+  metrics_registration registration = registry.add_counter(
+      prefix + "_connections_total", "Connections accepted",
+      [this]() { return total_connections(); });
+  registration.append(registry.add_counter(
+      prefix + "_connections_timed_out_total", "Connections closed by the idle or connection timeout",
+      [this]() { return timed_out_connections(); }));
+  registration.append(registry.add_gauge(
+      prefix + "_active_connections", "Connections currently open",
+      [this]() { return static_cast<std::int64_t>(active_connections()); }));
+  registration.append(registry.add_gauge(
+      prefix + "_buffered_output_bytes", "Bytes queued for sending across all connections",
+      [this]() { return static_cast<std::int64_t>(buffered_output()); }));
+  registration.append(registry.add_counter(
+      prefix + "_refused_writes_total", "Writes refused by the output budget",
+      [this]() { return refused_writes(); }));
+  registration.append(registry.add_histogram(
+      prefix + "_queue_latency_seconds", "Time connections or events waited for a worker",
+      [this]() { return queue_latency(); }));
+  registration.append(registry.add_histogram(
+      prefix + "_service_latency_seconds", "Time handlers took per connection or event",
+      [this]() { return service_latency(); }));
+  return registration;
+}
+
+/**
+ * @brief Measure how long the server has been running.
+ *
+ * @return Duration since `start()` was called, or zero if not running.
+ */
+std::chrono::steady_clock::duration tcp_server::uptime() const
+{
+  if (!m_running.load())
+  {
+    return std::chrono::steady_clock::duration::zero();
+  }
+  return std::chrono::steady_clock::now() - m_start_time;
+}
+
+/**
+ * @brief Default exception handling hook for subclasses.
+ *
+ * @param ex Exception that was thrown.
+ * @param context String describing where the exception occurred.
+ *
+ * The base implementation is intentionally minimal; override to provide logging
+ * or alerts.
+ */
+void tcp_server::handle_exception(const std::exception &ex,
+                                  const std::string &context) noexcept
+{
+  static_cast<void>(ex);
+  static_cast<void>(context);
+  // Default implementation: In production, this would log the exception
+  // For now, we just continue operation
+  // LOG_ERROR("tcp_server exception in " << context << ": " << ex.what());
+}
+
+/**
+ * @brief Hook invoked immediately before worker threads are launched.
+ *
+ * Override to perform initialization tasks. The base implementation is a no-op.
+ */
+void tcp_server::on_server_starting()
+{
+  // Default implementation does nothing
+}
+
+/**
+ * @brief Hook invoked after `stop()` has been requested but before resources
+ * are released.
+ *
+ * Override to perform cleanup tasks. The base implementation is a no-op.
+ */
+void tcp_server::on_server_stopping()
+{
+  // Default implementation does nothing
+}
+
+/**
+ * @brief Apply the configurator's settings to the calling server thread.
+ *
+ * Failures are reported and otherwise ignored: a thread that cannot be
+ * pinned still serves connections.
+ *
+ * @param role Kind of thread calling.
+ * @param index Number of the thread within its role.
+ */
+void tcp_server::configure_thread(thread_role role, std::size_t index) noexcept
+{
+  if (!m_thread_configurator)
+  {
+    return;
+  }
+  try
+  {
+    apply_thread_config(m_thread_configurator(role, index));
+  }
+  catch (const std::exception &ex)
+  {
+    if (onException.has_slots())
+    {
+      onException.emit(ex, "thread_config");
+    }
+    handle_exception(ex, "thread_config");
+  }
+}
+
+/**
+ * @brief Main loop for the acceptor thread responsible for admitting new
+ * clients.
+ *
+ * @param shard Acceptor shard owning the listening socket and its counter.
+ * @param index Shard number, passed to the thread configurator.
+ */
+void tcp_server::acceptor_thread_proc(acceptor_shard &shard, std::size_t index)
+{
+  configure_thread(thread_role::acceptor, index);
+  fb::server_socket &listener = *shard.listener;
+
+  while (!m_should_stop.load() && m_accepting.load())
+  {
+    try
+    {
+      socket_address client_address;
+
+      // Accept connection with timeout to allow checking stop condition
+      tcp_client client_socket = listener.accept_connection(
+          client_address, std::chrono::milliseconds(1000));
+
+      if (m_should_stop.load())
+      {
+        break;
+      }
+
+      if (is_reactor_mode())
+      {
+        dispatch_to_reactor(std::move(client_socket), client_address,
+                            shard.accepted);
+        continue;
+      }
+
+      // Create connection handler
+      auto connection =
           m_connection_factory(std::move(client_socket), client_address);
       if (!connection)
       {
@@ -508,6 +1203,16 @@ void tcp_server::acceptor_thread_proc()
       }
 
       // Queue connection for processing
+      if (m_lock_free_queue)
+      {
+        if (m_lock_free_queue->size_approx() >= m_max_queued ||
+            !m_lock_free_queue->try_push(std::move(connection)))
+        {
+          // Queue is full, drop connection
+          continue;
+        }
+      }
+      else
       {
         std::lock_guard<std::mutex> lock(m_queue_mutex);
         if (m_connection_queue.size() >= m_max_queued)
@@ -519,10 +1224,13 @@ void tcp_server::acceptor_thread_proc()
       }
 
       // Notify worker threads and possibly add more threads
-      m_queue_condition.notify_one();
+      if (!m_lock_free_queue)
+      {
+        m_queue_condition.notify_one();
+      }
       add_worker_thread_if_needed();
 
-      m_total_connections.fetch_add(1);
+      shard.accepted.fetch_add(1);
     }
     catch (const std::system_error &ex)
     {
@@ -532,7 +1240,7 @@ void tcp_server::acceptor_thread_proc()
         continue;
       }
       handle_exception(ex, "acceptor_thread");
-      if (m_server_socket.is_closed())
+      if (listener.is_closed())
       {
         break;
       }
@@ -541,7 +1249,7 @@ void tcp_server::acceptor_thread_proc()
     catch (const std::exception &ex)
     {
       handle_exception(ex, "acceptor_thread");
-      if (m_server_socket.is_closed())
+      if (listener.is_closed())
       {
         break; // Server socket is closed, stop accepting
       }
@@ -551,18 +1259,35 @@ void tcp_server::acceptor_thread_proc()
 
 /**
  * @brief Worker loop that pulls connections from the queue and processes them.
+ *
+ * A worker idle for the policy's idle_timeout retires while the pool is
+ * above its minimum size.
  */
 void tcp_server::worker_thread_proc()
 {
+  configure_thread(thread_role::worker, m_worker_serial.fetch_add(1));
+  const auto idle_timeout = m_pool_policy.idle_timeout;
+  const auto wait_timeout =
+      idle_timeout.count() > 0
+          ? std::min<std::chrono::milliseconds>(idle_timeout, std::chrono::seconds(1))
+          : std::chrono::milliseconds(std::chrono::seconds(1));
+  auto idle_since = std::chrono::steady_clock::now();
+
   while (!m_should_stop.load())
   {
     std::unique_ptr<tcp_server_connection> connection;
 
     // Wait for connection to process
+    if (m_lock_free_queue)
+    {
+      m_lock_free_queue->wait_pop(connection, wait_timeout,
+                                  [this] { return m_should_stop.load(); });
+    }
+    else
     {
       std::unique_lock<std::mutex> lock(m_queue_mutex);
       m_queue_condition.wait_for(
-          lock, std::chrono::seconds(1), [this]
+          lock, wait_timeout, [this]
           { return !m_connection_queue.empty() || m_should_stop.load(); });
 
       if (m_should_stop.load())
@@ -570,20 +1295,423 @@ void tcp_server::worker_thread_proc()
         break;
       }
 
-      if (m_connection_queue.empty())
+      if (!m_connection_queue.empty())
       {
-        continue;
+        connection = std::move(m_connection_queue.front());
+        m_connection_queue.pop();
+      }
+    }
+
+    if (!connection)
+    {
+      if (retire_idle_worker(idle_since))
+      {
+        return;
       }
+      continue;
+    }
 
-      connection = std::move(m_connection_queue.front());
-      m_connection_queue.pop();
+    // The connection's clock starts on accept, so its age is the queue wait
+    const auto threshold = m_pool_policy.queue_wait_threshold;
+    if (threshold.count() > 0 && connection->uptime() > threshold)
+    {
+      add_worker_thread_if_needed(true);
     }
 
-    if (connection)
+    process_connection(std::move(connection));
+    idle_since = std::chrono::steady_clock::now();
+  }
+}
+
+/**
+ * @brief Hand an accepted socket to the next event loop (round-robin).
+ *
+ * @param client_socket Newly accepted socket.
+ * @param client_address Remote endpoint of the socket.
+ * @param accepted Counter of the acceptor shard to credit.
+ * @return True if the connection was queued, false if the factory declined it
+ * or the loop's handoff queue is full.
+ */
+bool tcp_server::dispatch_to_reactor(tcp_client client_socket,
+                                     const socket_address &client_address,
+                                     std::atomic<std::uint64_t> &accepted)
+{
+  client_socket.set_blocking(false);
+
+  auto connection =
+      m_reactor_factory(std::move(client_socket), client_address);
+  if (!connection)
+  {
+    return false;
+  }
+
+  reactor_loop &loop =
+      *m_reactor_loops[m_next_loop.fetch_add(1) % m_reactor_loops.size()];
+
+  {
+    std::lock_guard<std::mutex> lock(loop.pending_mutex);
+    if (loop.pending.size() >= m_max_queued)
     {
-      process_connection(std::move(connection));
+      return false;
     }
+    loop.pending.push_back(std::move(connection));
+  }
+  accepted.fetch_add(1);
+  loop.wake();
+
+  if (onConnectionAccepted.slot_count() > 0)
+  {
+    onConnectionAccepted.emit(client_address);
   }
+  return true;
+}
+
+/**
+ * @brief Event-loop body: poll, dispatch readiness, adopt new connections.
+ *
+ * @param loop Loop state owned by this thread.
+ * @param index Loop number, passed to the thread configurator.
+ */
+void tcp_server::reactor_thread_proc(reactor_loop &loop, std::size_t index)
+{
+  configure_thread(thread_role::reactor, index);
+  std::vector<std::unique_ptr<tcp_reactor_connection>> adopted;
+  char drain[16];
+
+  while (!m_should_stop.load())
+  {
+    try
+    {
+      // Wake at least once per tick while deadlines are pending
+      loop.poller.poll(loop.timers.empty() ? std::chrono::milliseconds(1000)
+                                           : loop.timers.resolution());
+
+      for (const auto &event : loop.poller.events())
+      {
+        if (event.socket_ptr == &loop.wakeup_receiver)
+        {
+          socket_address sender;
+          loop.wakeup_receiver.receive_from(drain, sizeof(drain), sender);
+          continue;
+        }
+
+        if (event.user_data != nullptr)
+        {
+          reactor_dispatch_event(
+              loop, *static_cast<tcp_reactor_connection *>(event.user_data),
+              event.mode);
+        }
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(loop.pending_mutex);
+        adopted.swap(loop.pending);
+      }
+      for (auto &connection : adopted)
+      {
+        reactor_register(loop, std::move(connection));
+      }
+      adopted.clear();
+
+      loop.timers.advance(std::chrono::steady_clock::now());
+    }
+    catch (const std::exception &ex)
+    {
+      handle_exception(ex, "reactor_thread");
+    }
+  }
+
+  while (!loop.connections.empty())
+  {
+    reactor_retire(loop, *loop.connections.begin()->second);
+  }
+
+  std::lock_guard<std::mutex> lock(loop.pending_mutex);
+  loop.pending.clear();
+}
+
+/**
+ * @brief Register a handed-over connection with the loop's poll_set.
+ *
+ * @param loop Owning event loop.
+ * @param connection Connection created by the reactor factory.
+ */
+void tcp_server::reactor_register(
+    reactor_loop &loop,
+    std::unique_ptr<tcp_reactor_connection> connection)
+{
+  tcp_reactor_connection &ref = *connection;
+  ref.m_backpressure    = m_backpressure;
+  ref.m_budget          = m_output_budget;
+  ref.m_last_activity   = loop.timers.current_tick();
+  ref.m_output_progress = ref.m_last_activity;
+
+  loop.poller.add(ref.socket(), reactor_interest(ref.wants_writable()), &ref);
+  loop.connections.emplace(&ref.socket(), std::move(connection));
+  m_reactor_connections.fetch_add(1);
+  if (m_idle_timeout.count() > 0 || m_connection_timeout.count() > 0)
+  {
+    reactor_check_timeout(loop, ref);
+  }
+
+  const bool had_write_interest = ref.wants_writable();
+  const bool corked = begin_write_coalescing(ref);
+  try
+  {
+    ref.on_open();
+  }
+  catch (const std::exception &ex)
+  {
+    ref.handle_exception(ex);
+    ref.close();
+  }
+  end_write_coalescing(ref, corked);
+  reactor_apply_state(loop, ref, had_write_interest);
+}
+
+/**
+ * @brief Deliver readiness callbacks for one polled event.
+ *
+ * Error/hang-up conditions are reported through on_readable() so the handler
+ * observes EOF or the pending socket error from its next receive call.
+ *
+ * @param loop Owning event loop.
+ * @param connection Connection the event belongs to.
+ * @param mode poll_set mode flags reported for the socket.
+ */
+void tcp_server::reactor_dispatch_event(reactor_loop &loop,
+                                        tcp_reactor_connection &connection,
+                                        int mode)
+{
+  const bool had_write_interest = connection.wants_writable();
+  const bool track_latency      = m_track_latency;
+  const std::size_t queued      = connection.buffered_output();
+  connection.m_last_activity    = loop.timers.current_tick();
+  if (queued == 0)
+  {
+    connection.m_output_progress = connection.m_last_activity;
+  }
+  std::chrono::steady_clock::time_point started;
+  if (track_latency)
+  {
+    started = std::chrono::steady_clock::now();
+  }
+  const bool corked = begin_write_coalescing(connection);
+  try
+  {
+    if (mode & (poll_set::POLL_READ | poll_set::POLL_ERROR))
+    {
+      connection.on_readable();
+    }
+    if ((mode & poll_set::POLL_WRITE) && !connection.close_requested())
+    {
+      // Queued output goes first so on_writable() appends behind it
+      connection.flush_output();
+      if (connection.buffered_output() < queued)
+      {
+        connection.m_output_progress = connection.m_last_activity;
+      }
+      if (connection.write_interest())
+      {
+        connection.on_writable();
+      }
+    }
+    if ((mode & poll_set::POLL_ERROR) && !(mode & poll_set::POLL_READ))
+    {
+      // Error without pending data: nothing further will ever be delivered
+      connection.close();
+    }
+  }
+  catch (const std::exception &ex)
+  {
+    connection.handle_exception(ex);
+    connection.close();
+  }
+  end_write_coalescing(connection, corked);
+  if (track_latency)
+  {
+    record_latency(false, std::chrono::steady_clock::duration::zero(),
+                   std::chrono::steady_clock::now() - started);
+  }
+  reactor_apply_state(loop, connection, had_write_interest);
+}
+
+/**
+ * @brief Reconcile poll registration with the state left by a callback.
+ *
+ * @param loop Owning event loop.
+ * @param connection Connection whose callback just returned.
+ * @param had_write_interest Write interest before the callback ran.
+ */
+void tcp_server::reactor_apply_state(reactor_loop &loop,
+                                     tcp_reactor_connection &connection,
+                                     bool had_write_interest)
+{
+  if (connection.close_requested() || connection.socket().is_closed())
+  {
+    reactor_retire(loop, connection);
+    return;
+  }
+
+  if (connection.wants_writable() != had_write_interest)
+  {
+    loop.poller.update(connection.socket(),
+                       reactor_interest(connection.wants_writable()));
+  }
+}
+
+/**
+ * @brief Unregister, close, and destroy a reactor connection.
+ *
+ * @param loop Owning event loop.
+ * @param connection Connection to retire; invalid after this call.
+ */
+void tcp_server::reactor_retire(reactor_loop &loop,
+                                tcp_reactor_connection &connection)
+{
+  const socket_base *key = &connection.socket();
+  socket_address client_address = connection.client_address();
+  loop.timers.cancel(connection.m_timer);
+
+  try
+  {
+    loop.poller.remove(connection.socket());
+  }
+  catch (const std::exception &ex)
+  {
+    handle_exception(ex, "reactor_retire");
+  }
+
+  try
+  {
+    connection.on_close();
+    if (!connection.socket().is_closed())
+    {
+      connection.socket().close();
+    }
+  }
+  catch (...)
+  {
+    // Ignore exceptions during cleanup
+  }
+
+  loop.connections.erase(key);
+  m_reactor_connections.fetch_sub(1);
+
+  if (onConnectionClosed.slot_count() > 0)
+  {
+    onConnectionClosed.emit(client_address);
+  }
+}
+
+/**
+ * @brief Timer callback: close a connection past a deadline or re-arm.
+ *
+ * Activity only pushes deadlines later, so callbacks just stamp the
+ * connection and the single armed timer is moved here, lazily, when it
+ * fires early. A connection times out when no readiness callback ran for
+ * the idle timeout, or when queued output made no progress for the
+ * connection timeout.
+ *
+ * @param loop Owning event loop.
+ * @param connection Connection to check; retired if it timed out.
+ */
+void tcp_server::reactor_check_timeout(reactor_loop &loop,
+                                       tcp_reactor_connection &connection)
+{
+  connection.m_timer     = timer_wheel::INVALID_TIMER;
+  const std::uint64_t now = loop.timers.current_tick();
+
+  std::uint64_t deadline = std::numeric_limits<std::uint64_t>::max();
+  if (m_idle_timeout.count() > 0)
+  {
+    deadline = connection.m_last_activity + loop.timers.ticks_for(m_idle_timeout);
+  }
+  if (m_connection_timeout.count() > 0)
+  {
+    const std::uint64_t ticks = loop.timers.ticks_for(m_connection_timeout);
+    deadline = std::min(deadline, connection.buffered_output() > 0
+                                      ? connection.m_output_progress + ticks
+                                      : now + ticks);
+  }
+
+  if (deadline <= now)
+  {
+    m_timed_out_connections.fetch_add(1);
+    connection.close();
+    reactor_retire(loop, connection);
+    return;
+  }
+
+  tcp_reactor_connection *target = &connection;
+  connection.m_timer = loop.timers.schedule(
+      deadline - now,
+      [this, &loop, target]() { reactor_check_timeout(loop, *target); });
+}
+
+/**
+ * @brief Tick length for the event loops' timer wheels.
+ *
+ * A sixteenth of the shortest configured timeout, between 1 and 100 ms,
+ * so deadlines fire at most about 6% late.
+ */
+std::chrono::milliseconds tcp_server::reactor_timer_resolution() const
+{
+  std::chrono::milliseconds shortest(0);
+  for (const auto &timeout : {m_idle_timeout, m_connection_timeout})
+  {
+    if (timeout.count() > 0 && (shortest.count() == 0 || timeout < shortest))
+    {
+      shortest = timeout;
+    }
+  }
+  if (shortest.count() == 0)
+  {
+    return std::chrono::milliseconds(100);
+  }
+  return std::clamp(shortest / 16, std::chrono::milliseconds(1),
+                    std::chrono::milliseconds(100));
+}
+
+/**
+ * @brief Create and launch the configured number of event loops.
+ */
+void tcp_server::start_reactor_loops()
+{
+  m_reactor_loops.clear();
+  m_next_loop = 0;
+
+  for (std::size_t i = 0; i < m_event_loops; ++i)
+  {
+    m_reactor_loops.push_back(
+        std::make_unique<reactor_loop>(reactor_timer_resolution()));
+  }
+  for (std::size_t i = 0; i < m_reactor_loops.size(); ++i)
+  {
+    m_reactor_loops[i]->thread = std::thread(&tcp_server::reactor_thread_proc, this,
+                                             std::ref(*m_reactor_loops[i]), i);
+  }
+}
+
+/**
+ * @brief Wake and join all event loops, then release their state.
+ *
+ * Expects m_should_stop to be set already.
+ */
+void tcp_server::stop_reactor_loops()
+{
+  for (auto &loop : m_reactor_loops)
+  {
+    loop->wake();
+  }
+  for (auto &loop : m_reactor_loops)
+  {
+    if (loop->thread.joinable())
+    {
+      loop->thread.join();
+    }
+  }
+  m_reactor_loops.clear();
 }
 
 /**
@@ -594,6 +1722,16 @@ void tcp_server::worker_thread_proc()
 void tcp_server::process_connection(
     std::unique_ptr<tcp_server_connection> connection)
 {
+  const bool track_latency = m_track_latency;
+  std::chrono::steady_clock::duration queue_wait{};
+  std::chrono::steady_clock::time_point started;
+  if (track_latency)
+  {
+    // The connection's clock starts when the factory creates it on accept
+    queue_wait = connection->uptime();
+    started    = std::chrono::steady_clock::now();
+  }
+
   try
   {
     // Set connection timeout if configured
@@ -601,6 +1739,11 @@ void tcp_server::process_connection(
     {
       connection->set_timeout(m_connection_timeout);
     }
+    if (m_backpressure.max_buffered > 0)
+    {
+      connection->socket().set_send_buffer_size(static_cast<int>(
+          std::min<std::size_t>(m_backpressure.max_buffered, INT_MAX)));
+    }
 
     // Add to active connections for tracking
     std::shared_ptr<tcp_server_connection> shared_connection(
@@ -618,10 +1761,37 @@ void tcp_server::process_connection(
     handle_exception(ex, "process_connection");
   }
 
+  if (track_latency)
+  {
+    record_latency(true, queue_wait, std::chrono::steady_clock::now() - started);
+  }
+
   // Cleanup finished connections periodically
   cleanup_connections();
 }
 
+/**
+ * @brief Add one queue wait / service time pair to the latency histograms.
+ *
+ * @param queued False for reactor callbacks, which only have a service time.
+ * @param queue_wait Time from accept to worker pickup (zero if not queued).
+ * @param service_time Time spent in the connection handler.
+ */
+void tcp_server::record_latency(bool queued,
+                                std::chrono::steady_clock::duration queue_wait,
+                                std::chrono::steady_clock::duration service_time)
+{
+  if (queued)
+  {
+    m_queue_latency->record(queue_wait);
+  }
+  m_service_latency->record(service_time);
+  if (onLatencyRecorded.slot_count() > 0)
+  {
+    onLatencyRecorded.emit(queue_wait, service_time);
+  }
+}
+
 /**
  * @brief Remove completed or disconnected connections from the active list.
  */
@@ -637,19 +1807,103 @@ void tcp_server::cleanup_connections()
 }
 
 /**
- * @brief Grow the worker pool when the backlog exceeds current capacity.
+ * @brief Spawn an additional worker when the queue pressure increases.
+ *
+ * Workers that retired since the last call are joined here, outside the
+ * locks, so their threads do not accumulate.
+ *
+ * @param queue_wait_exceeded True when a worker dequeued a connection older
+ * than the policy's queue_wait_threshold.
+ */
+void tcp_server::add_worker_thread_if_needed(bool queue_wait_exceeded)
+{
+  std::vector<std::thread> retired;
+  {
+    // Acquire both mutexes deadlock-free; the lock-free ring needs only one
+    std::unique_lock<std::mutex> threads_lock(m_threads_mutex, std::defer_lock);
+    std::unique_lock<std::mutex> queue_lock(m_queue_mutex, std::defer_lock);
+    if (m_lock_free_queue)
+    {
+      threads_lock.lock();
+    }
+    else
+    {
+      std::lock(threads_lock, queue_lock);
+    }
+
+    retired.swap(m_retired_threads);
+
+    const std::size_t backlog = m_lock_free_queue
+                                    ? m_lock_free_queue->size_approx()
+                                    : m_connection_queue.size();
+    const std::size_t workers = m_worker_threads.size();
+
+    // Add thread if the queue is backing up and we haven't reached max threads
+    const bool pressure =
+        backlog > workers * m_pool_policy.queue_depth_per_thread ||
+        (queue_wait_exceeded && backlog > 0);
+    if (pressure && workers < m_max_threads && !m_should_stop.load())
+    {
+      m_worker_threads.emplace_back(&tcp_server::worker_thread_proc, this);
+    }
+  }
+
+  for (auto &thread : retired)
+  {
+    if (thread.joinable())
+    {
+      thread.join();
+    }
+  }
+}
+
+/**
+ * @brief Retire the calling worker if it has been idle long enough.
+ *
+ * The worker's thread object moves to the retired list, to be joined by the
+ * next add_worker_thread_if_needed() or by shutdown_threads().
+ *
+ * @param idle_since When the calling worker last finished a connection.
+ * @return True if the caller must exit its loop.
  */
-void tcp_server::add_worker_thread_if_needed()
+bool tcp_server::retire_idle_worker(
+    const std::chrono::steady_clock::time_point &idle_since)
 {
-  // Use scoped_lock for deadlock-safe acquisition of multiple mutexes
-  std::scoped_lock lock(m_threads_mutex, m_queue_mutex);
+  const auto idle_timeout = m_pool_policy.idle_timeout;
+  if (idle_timeout.count() == 0 ||
+      std::chrono::steady_clock::now() - idle_since < idle_timeout)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_threads_mutex);
+  if (m_should_stop.load() || m_worker_threads.size() <= min_worker_threads())
+  {
+    return false;
+  }
 
-  // Add thread if queue is getting full and we haven't reached max threads
-  if (m_connection_queue.size() > m_worker_threads.size() &&
-      m_worker_threads.size() < m_max_threads)
+  const auto self = std::this_thread::get_id();
+  auto it = std::find_if(m_worker_threads.begin(), m_worker_threads.end(),
+                         [self](const std::thread &thread)
+                         { return thread.get_id() == self; });
+  if (it == m_worker_threads.end())
   {
-    m_worker_threads.emplace_back(&tcp_server::worker_thread_proc, this);
+    return false;
   }
+  m_retired_threads.push_back(std::move(*it));
+  m_worker_threads.erase(it);
+  return true;
+}
+
+/**
+ * @brief Number of workers started with the server and kept when idle.
+ */
+std::size_t tcp_server::min_worker_threads() const
+{
+  const std::size_t min_threads = m_pool_policy.min_threads == 0
+                                      ? DEFAULT_MIN_THREADS
+                                      : m_pool_policy.min_threads;
+  return std::min(min_threads, m_max_threads);
 }
 
 /**
@@ -670,7 +1924,7 @@ void tcp_server::validate_configuration() const
     throw std::logic_error("Server socket is closed or invalid");
   }
 
-  if (!m_connection_factory)
+  if (!m_connection_factory && !m_reactor_factory)
   {
     throw std::runtime_error("Connection factory is not set");
   }
@@ -698,30 +1952,94 @@ void tcp_server::shutdown_threads(const std::chrono::milliseconds &timeout)
     }
   }
 
-  // Join acceptor thread
-  if (m_acceptor_thread.joinable())
-  {
-    m_acceptor_thread.join();
-  }
+  // Join acceptor threads
+  join_acceptors();
+
+  // Join event loops; each retires its remaining connections on exit
+  stop_reactor_loops();
 
   // Join worker threads - always join to prevent use-after-free from detached
-  // threads accessing destroyed server object
+  // threads accessing destroyed server object. Join outside the lock: a
+  // worker may be retiring and waiting for it.
+  std::vector<std::thread> workers;
   {
     std::lock_guard<std::mutex> lock(m_threads_mutex);
-    for (auto &thread : m_worker_threads)
+    workers.swap(m_worker_threads);
+    std::move(m_retired_threads.begin(), m_retired_threads.end(),
+              std::back_inserter(workers));
+    m_retired_threads.clear();
+  }
+  for (auto &thread : workers)
+  {
+    if (thread.joinable())
     {
-      if (thread.joinable())
-      {
-        thread.join();
-      }
+      thread.join();
     }
-    m_worker_threads.clear();
   }
 
   // Remove any completed connections after threads have exited
   cleanup_connections();
 }
 
+/**
+ * @brief Create the acceptor shards for the next run.
+ *
+ * Counts from the previous run are folded into m_total_connections first.
+ *
+ * @throws std::logic_error If sharding is requested but the server socket
+ * was bound without reuse_port.
+ * @throws std::system_error If an extra listener cannot be bound.
+ */
+void tcp_server::open_acceptor_shards()
+{
+  std::vector<std::unique_ptr<acceptor_shard>> shards;
+
+  auto primary      = std::make_unique<acceptor_shard>();
+  primary->listener = &m_server_socket;
+  shards.push_back(std::move(primary));
+
+  if (m_acceptor_shards > 1)
+  {
+    if (!m_server_socket.get_reuse_port())
+    {
+      throw std::logic_error(
+          "Acceptor shards require a server socket bound with reuse_port");
+    }
+
+    const socket_address address = m_server_socket.address();
+    for (std::size_t i = 1; i < m_acceptor_shards; ++i)
+    {
+      auto shard          = std::make_unique<acceptor_shard>();
+      shard->owned_socket = std::make_unique<fb::server_socket>(address.family());
+      shard->owned_socket->bind(address, false, true);
+      shard->owned_socket->listen(m_shard_backlog);
+      shard->listener = shard->owned_socket.get();
+      shards.push_back(std::move(shard));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_threads_mutex);
+  for (const auto &shard : m_acceptors)
+  {
+    m_total_connections.fetch_add(shard->accepted.load());
+  }
+  m_acceptors = std::move(shards);
+}
+
+/**
+ * @brief Join all acceptor threads; shards and their counters are kept.
+ */
+void tcp_server::join_acceptors()
+{
+  for (auto &shard : m_acceptors)
+  {
+    if (shard->thread.joinable())
+    {
+      shard->thread.join();
+    }
+  }
+}
+
 /**
  * @brief Check whether both a listening socket and factory have been provided.
  *
@@ -1,10 +1,30 @@
 #include <fb/tcp_server_connection.h>
+#include <algorithm>
 #include <chrono>
+#include <climits>
 #include <stdexcept>
+#include <system_error>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#endif
 
 namespace fb
 {
 
+namespace
+{
+
+#if defined(MSG_DONTWAIT) && defined(MSG_NOSIGNAL)
+constexpr int BOUNDED_SEND_FLAGS = MSG_DONTWAIT | MSG_NOSIGNAL;
+#elif defined(MSG_DONTWAIT)
+constexpr int BOUNDED_SEND_FLAGS = MSG_DONTWAIT;
+#else
+constexpr int BOUNDED_SEND_FLAGS = 0;
+#endif
+
+} // namespace
+
 /**
  * @class fb::tcp_server_connection
  * @brief Base wrapper for a single accepted TCP client connection.
@@ -250,6 +270,20 @@ void tcp_server_connection::set_no_delay(bool flag)
   m_socket.set_no_delay(flag);
 }
 
+/**
+ * @brief Cork or uncork the connection socket.
+ *
+ * Cork before writing a burst of small responses and uncork afterwards to
+ * send them in as few segments as possible (see tcp_client::set_cork()).
+ *
+ * @param flag True to hold back partial segments, false to flush them.
+ */
+void tcp_server_connection::set_cork(bool flag)
+{
+  validate_socket();
+  m_socket.set_cork(flag);
+}
+
 /**
  * @brief Enable or disable TCP keepalive probes.
  *
@@ -261,6 +295,72 @@ void tcp_server_connection::set_keep_alive(bool flag)
   m_socket.set_keep_alive(flag);
 }
 
+/**
+ * @brief Send bytes, giving up once a deadline for the whole buffer passes.
+ *
+ * send_bytes_all() can hold the worker for as long as a slow client keeps
+ * reading a few bytes at a time; this waits for writability at most until
+ * the deadline and sends without blocking. On timeout part of the buffer may
+ * have been sent, so the stream is no longer framed and the connection
+ * should be closed.
+ *
+ * @param buffer Bytes to send.
+ * @param length Number of bytes.
+ * @param timeout Time allowed for the whole buffer.
+ * @return True if everything was sent, false if the deadline passed.
+ * @throws std::invalid_argument If buffer is null and length is not zero.
+ * @throws std::logic_error If the socket is closed.
+ * @throws std::system_error If the socket fails.
+ */
+bool tcp_server_connection::send_within(const void *buffer, std::size_t length,
+                                        const std::chrono::milliseconds &timeout)
+{
+  validate_socket();
+  if (length == 0)
+  {
+    return true;
+  }
+  if (!buffer)
+  {
+    throw std::invalid_argument("Buffer cannot be null");
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  const char *data    = static_cast<const char *>(buffer);
+  std::size_t sent    = 0;
+  while (sent < length)
+  {
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0 || !m_socket.poll_write(remaining))
+    {
+      return false;
+    }
+
+    const int chunk = static_cast<int>(
+        std::min<std::size_t>(length - sent, static_cast<std::size_t>(INT_MAX)));
+    int written = 0;
+    try
+    {
+      written = m_socket.send_bytes(data + sent, chunk, BOUNDED_SEND_FLAGS);
+    }
+    catch (const std::system_error &ex)
+    {
+      if (ex.code() == std::errc::resource_unavailable_try_again)
+      {
+        continue;
+      }
+      throw;
+    }
+    if (written <= 0)
+    {
+      return false;
+    }
+    sent += static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
 /**
  * @brief Default exception handler for connection logic.
  *
@@ -0,0 +1,90 @@
+#include <fb/thread_config.h>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace fb
+{
+
+/**
+ * @brief Apply a thread_config to the calling thread.
+ *
+ * Settings are applied in order (CPUs, name, priority) and the first failure
+ * stops. CPU sets are only supported on Linux and names on Linux and macOS;
+ * elsewhere those fields are ignored. SCHED_FIFO usually needs
+ * CAP_SYS_NICE or a matching RLIMIT_RTPRIO.
+ *
+ * @param config Settings to apply; empty fields are left alone.
+ * @throws std::invalid_argument For a CPU outside the supported range or a
+ * priority outside the SCHED_FIFO range.
+ * @throws std::system_error If the system rejects a setting.
+ */
+void apply_thread_config(const thread_config &config)
+{
+#ifdef __linux__
+  if (!config.cpus.empty())
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int cpu : config.cpus)
+    {
+      if (cpu < 0 || cpu >= CPU_SETSIZE)
+      {
+        throw std::invalid_argument("CPU index out of range");
+      }
+      CPU_SET(static_cast<std::size_t>(cpu), &set);
+    }
+    const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0)
+    {
+      throw std::system_error(rc, std::system_category(), "pthread_setaffinity_np");
+    }
+  }
+
+  if (!config.name.empty())
+  {
+    // The kernel keeps 15 characters plus the terminator
+    const std::string name = config.name.substr(0, 15);
+    const int rc           = pthread_setname_np(pthread_self(), name.c_str());
+    if (rc != 0)
+    {
+      throw std::system_error(rc, std::system_category(), "pthread_setname_np");
+    }
+  }
+#elif defined(__APPLE__)
+  if (!config.name.empty())
+  {
+    const int rc = pthread_setname_np(config.name.c_str());
+    if (rc != 0)
+    {
+      throw std::system_error(rc, std::system_category(), "pthread_setname_np");
+    }
+  }
+#endif
+
+#ifndef _WIN32
+  if (config.realtime_priority != 0)
+  {
+    if (config.realtime_priority < sched_get_priority_min(SCHED_FIFO) ||
+        config.realtime_priority > sched_get_priority_max(SCHED_FIFO))
+    {
+      throw std::invalid_argument("Priority outside the SCHED_FIFO range");
+    }
+    sched_param param{};
+    param.sched_priority = config.realtime_priority;
+    const int rc         = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (rc != 0)
+    {
+      throw std::system_error(rc, std::system_category(), "pthread_setschedparam");
+    }
+  }
+#else
+  (void)config;
+#endif
+}
+
+} // namespace fb
@@ -0,0 +1,349 @@
+#include <fb/timer_source.h>
+#include <fb/detail/socket_error_utils.h>
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
+    defined(__OpenBSD__)
+#include <fcntl.h>
+#include <sys/event.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace fb
+{
+
+/**
+ * @class fb::timer_source
+ * @brief Pollable kernel timer for single-threaded reactors.
+ */
+
+namespace
+{
+
+#ifdef __linux__
+
+struct timespec to_timespec(const std::chrono::nanoseconds &duration)
+{
+  struct timespec value;
+  value.tv_sec  = duration.count() / 1000000000;
+  value.tv_nsec = duration.count() % 1000000000;
+  return value;
+}
+
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
+    defined(__OpenBSD__)
+
+constexpr uintptr_t TIMER_IDENT = 1;
+
+#endif
+
+} // namespace
+
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) ||        \
+    defined(__NetBSD__) || defined(__OpenBSD__)
+
+/**
+ * @brief Create a disarmed timer.
+ *
+ * @throws std::system_error If the kernel object cannot be created.
+ */
+timer_source::timer_source() :
+  m_fd(-1),
+  m_active(false),
+  m_rearm(false),
+  m_interval(0)
+{
+#ifdef __linux__
+  m_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (m_fd == -1)
+  {
+    detail::throw_system_error(errno, "Failed to create timerfd");
+  }
+#else
+  m_fd = ::kqueue();
+  if (m_fd == -1)
+  {
+    detail::throw_system_error(errno, "Failed to create timer kqueue");
+  }
+  ::fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+#endif
+}
+
+#else
+
+/**
+ * @brief Timer descriptors need timerfd or kqueue; construction fails elsewhere.
+ *
+ * @throws std::system_error With std::errc::function_not_supported.
+ */
+timer_source::timer_source() :
+  m_fd(-1),
+  m_active(false),
+  m_rearm(false),
+  m_interval(0)
+{
+  detail::throw_system_error(std::errc::function_not_supported,
+                             "timer_source is not available on this platform");
+}
+
+#endif
+
+/**
+ * @brief Take over another source's timer, leaving it closed.
+ */
+timer_source::timer_source(timer_source &&other) noexcept :
+  m_fd(std::exchange(other.m_fd, -1)),
+  m_active(std::exchange(other.m_active, false)),
+  m_rearm(std::exchange(other.m_rearm, false)),
+  m_interval(std::exchange(other.m_interval, std::chrono::nanoseconds::zero()))
+{
+}
+
+/**
+ * @brief Close this timer and take over another's.
+ *
+ * @return Reference to this instance.
+ */
+timer_source &timer_source::operator=(timer_source &&other) noexcept
+{
+  if (this != &other)
+  {
+    close();
+    m_fd       = std::exchange(other.m_fd, -1);
+    m_active   = std::exchange(other.m_active, false);
+    m_rearm    = std::exchange(other.m_rearm, false);
+    m_interval = std::exchange(other.m_interval, std::chrono::nanoseconds::zero());
+  }
+  return *this;
+}
+
+/**
+ * @brief Close the timer. Remove it from any poll_set first.
+ */
+timer_source::~timer_source() { close(); }
+
+/**
+ * @brief Arm the timer, replacing any earlier setting.
+ *
+ * Pending expirations of the earlier setting are discarded.
+ *
+ * @param delay Time until the first expiration; zero expires at once.
+ * @param interval Period of later expirations; zero for a one-shot timer.
+ * @throws std::invalid_argument If delay or interval is negative.
+ * @throws std::system_error If the kernel rejects the setting.
+ */
+void timer_source::start(const std::chrono::nanoseconds &delay,
+                         const std::chrono::nanoseconds &interval)
+{
+  if (delay < std::chrono::nanoseconds::zero() || interval < std::chrono::nanoseconds::zero())
+  {
+    throw std::invalid_argument("Timer delay and interval must not be negative");
+  }
+
+  // A zero delay would disarm a timerfd
+  const std::chrono::nanoseconds first = (std::max)(delay, std::chrono::nanoseconds(1));
+  stop();
+  arm(first, interval);
+  m_interval = interval;
+  m_active   = true;
+}
+
+/**
+ * @brief Disarm the timer and discard pending expirations.
+ *
+ * @throws std::system_error If the kernel rejects the change.
+ */
+void timer_source::stop()
+{
+  if (m_fd == -1)
+  {
+    return;
+  }
+
+#ifdef __linux__
+  struct itimerspec spec = {};
+  if (::timerfd_settime(m_fd, 0, &spec, nullptr) == -1)
+  {
+    detail::throw_system_error(errno, "Failed to disarm timerfd");
+  }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
+    defined(__OpenBSD__)
+  struct kevent change;
+  EV_SET(&change, TIMER_IDENT, EVFILT_TIMER, EV_DELETE, 0, 0, nullptr);
+  // A one-shot timer that fired is already gone
+  if (::kevent(m_fd, &change, 1, nullptr, 0, nullptr) == -1 && errno != ENOENT)
+  {
+    detail::throw_system_error(errno, "Failed to disarm timer");
+  }
+#endif
+  m_active = false;
+  m_rearm  = false;
+}
+
+/**
+ * @brief Collect the expirations since the last read().
+ *
+ * Never blocks. Makes the source unreadable until it expires again; a
+ * one-shot timer becomes inactive once its expiration is read.
+ *
+ * @return Number of expirations, 0 if none.
+ * @throws std::system_error On error.
+ */
+std::uint64_t timer_source::read()
+{
+  if (m_fd == -1)
+  {
+    return 0;
+  }
+
+  std::uint64_t expirations = 0;
+#ifdef __linux__
+  if (::read(m_fd, &expirations, sizeof(expirations)) != static_cast<ssize_t>(sizeof(expirations)))
+  {
+    if (errno == EAGAIN || errno == EINTR
+#if EAGAIN != EWOULDBLOCK
+        || errno == EWOULDBLOCK
+#endif
+    )
+    {
+      return 0;
+    }
+    detail::throw_system_error(errno, "Failed to read timerfd");
+  }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
+    defined(__OpenBSD__)
+  struct kevent event;
+  const struct timespec no_wait = {0, 0};
+  const int count               = ::kevent(m_fd, nullptr, 0, &event, 1, &no_wait);
+  if (count <= 0)
+  {
+    if (count == 0 || errno == EINTR)
+    {
+      return 0;
+    }
+    detail::throw_system_error(errno, "Failed to read timer");
+  }
+  expirations = static_cast<std::uint64_t>(event.data);
+
+  if (m_rearm)
+  {
+    // The first delay was a one-shot; the interval runs from now
+    m_rearm = false;
+    arm(m_interval, m_interval);
+    return expirations;
+  }
+#endif
+
+  if (m_interval == std::chrono::nanoseconds::zero())
+  {
+    m_active = false;
+  }
+  return expirations;
+}
+
+/**
+ * @brief Whether the timer is armed and has expirations still to come.
+ */
+bool timer_source::is_active() const noexcept { return m_active; }
+
+/**
+ * @brief Period of the timer, zero for one-shot.
+ */
+std::chrono::nanoseconds timer_source::interval() const noexcept { return m_interval; }
+
+/**
+ * @brief Descriptor that becomes readable on expiration (for poll_set).
+ */
+int timer_source::native_handle() const noexcept { return m_fd; }
+
+/**
+ * @brief Whether timer sources can be created on this platform.
+ */
+bool timer_source::supported() noexcept
+{
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) ||        \
+    defined(__NetBSD__) || defined(__OpenBSD__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Release the kernel object.
+ */
+void timer_source::close() noexcept
+{
+  if (m_fd != -1)
+  {
+#if defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) ||        \
+    defined(__NetBSD__) || defined(__OpenBSD__)
+    ::close(m_fd);
+#endif
+    m_fd = -1;
+  }
+  m_active = false;
+  m_rearm  = false;
+}
+
+/**
+ * @brief Program the kernel timer.
+ *
+ * @param delay Time until the first expiration, positive.
+ * @param interval Period afterwards, zero for one-shot.
+ * @throws std::system_error If the kernel rejects the setting.
+ */
+void timer_source::arm(const std::chrono::nanoseconds &delay,
+                       const std::chrono::nanoseconds &interval)
+{
+#ifdef __linux__
+  struct itimerspec spec;
+  spec.it_value    = to_timespec(delay);
+  spec.it_interval = to_timespec(interval);
+  if (::timerfd_settime(m_fd, 0, &spec, nullptr) == -1)
+  {
+    detail::throw_system_error(errno, "Failed to arm timerfd");
+  }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
+    defined(__OpenBSD__)
+  // EVFILT_TIMER has a single period: a first delay that differs from the
+  // interval is armed as a one-shot, and read() arms the interval after it
+  const bool repeating = interval != std::chrono::nanoseconds::zero() && interval == delay;
+  m_rearm              = interval != std::chrono::nanoseconds::zero() && interval != delay;
+
+  unsigned short flags = EV_ADD | EV_ENABLE;
+  if (!repeating)
+  {
+    flags |= EV_ONESHOT;
+  }
+
+#ifdef NOTE_NSECONDS
+  const unsigned int unit = NOTE_NSECONDS;
+  const intptr_t amount   = static_cast<intptr_t>(delay.count());
+#else
+  const unsigned int unit = 0; // Milliseconds, rounded up
+  const intptr_t amount   = static_cast<intptr_t>((delay.count() + 999999) / 1000000);
+#endif
+
+  struct kevent change;
+  EV_SET(&change, TIMER_IDENT, EVFILT_TIMER, flags, unit, amount, nullptr);
+  if (::kevent(m_fd, &change, 1, nullptr, 0, nullptr) == -1)
+  {
+    detail::throw_system_error(errno, "Failed to arm timer");
+  }
+#else
+  (void)delay;
+  (void)interval;
+#endif
+}
+
+} // namespace fb
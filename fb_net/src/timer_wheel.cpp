@@ -0,0 +1,317 @@
+#include <fb/timer_wheel.h>
+#include <stdexcept>
+#include <utility>
+
+namespace fb
+{
+
+/**
+ * @class fb::timer_wheel
+ * @brief Hashed hierarchical timer wheel for large numbers of deadlines.
+ */
+
+/**
+ * @brief Create an empty wheel whose tick 0 is now.
+ *
+ * @param resolution Duration of one tick.
+ * @throws std::invalid_argument If resolution is not positive.
+ */
+timer_wheel::timer_wheel(const std::chrono::milliseconds &resolution) :
+  m_free(NIL),
+  m_armed(0),
+  m_tick(0),
+  m_resolution(resolution),
+  m_origin(std::chrono::steady_clock::now())
+{
+  if (resolution.count() <= 0)
+  {
+    throw std::invalid_argument("Timer wheel resolution must be positive");
+  }
+  m_heads.fill(NIL);
+}
+
+/**
+ * @brief Arm a timer a number of ticks after the current tick.
+ *
+ * @param ticks Ticks until expiry; 0 is treated as 1 (the next tick).
+ * @param cb Function run on expiry.
+ * @return Id accepted by cancel(); never INVALID_TIMER.
+ * @throws std::invalid_argument If cb is empty.
+ * @throws std::length_error If 2^32 - 1 timers are already armed.
+ */
+timer_wheel::timer_id timer_wheel::schedule(std::uint64_t ticks, callback cb)
+{
+  if (!cb)
+  {
+    throw std::invalid_argument("Timer callback cannot be empty");
+  }
+
+  std::uint32_t index = m_free;
+  if (index != NIL)
+  {
+    m_free = m_nodes[index].next;
+  }
+  else
+  {
+    if (m_nodes.size() >= NIL)
+    {
+      throw std::length_error("Too many timers");
+    }
+    index = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+  }
+
+  node &n  = m_nodes[index];
+  n.expiry = m_tick + (ticks == 0 ? 1 : ticks);
+  n.cb     = std::move(cb);
+  file(index);
+  ++m_armed;
+  return (static_cast<timer_id>(n.generation) << 32) | (index + std::uint64_t{1});
+}
+
+/**
+ * @brief Arm a timer after a duration, rounded up to whole ticks.
+ *
+ * The delay counts from the last tick processed, so it is measured from
+ * the most recent advance().
+ *
+ * @param delay Time until expiry.
+ * @param cb Function run on expiry.
+ * @return Id accepted by cancel().
+ * @throws std::invalid_argument If cb is empty.
+ */
+timer_wheel::timer_id
+timer_wheel::schedule_after(const std::chrono::milliseconds &delay, callback cb)
+{
+  return schedule(ticks_for(delay), std::move(cb));
+}
+
+/**
+ * @brief Disarm a timer.
+ *
+ * @param id Id returned by schedule().
+ * @return True if the timer was armed; false if it already fired, was
+ * cancelled, or the id is INVALID_TIMER.
+ */
+bool timer_wheel::cancel(timer_id id) noexcept
+{
+  const std::uint64_t slot_index = id & 0xFFFFFFFFu;
+  if (slot_index == 0 || slot_index > m_nodes.size())
+  {
+    return false;
+  }
+  const auto index = static_cast<std::uint32_t>(slot_index - 1);
+  const node &n    = m_nodes[index];
+  if (!n.armed || n.generation != static_cast<std::uint32_t>(id >> 32))
+  {
+    return false;
+  }
+  unlink(index);
+  release(index);
+  return true;
+}
+
+/**
+ * @brief Advance the wheel and run the timers that expire.
+ *
+ * An empty wheel skips ahead without visiting slots.
+ *
+ * @param ticks Number of ticks to advance.
+ * @return Number of callbacks run.
+ */
+std::size_t timer_wheel::tick(std::uint64_t ticks)
+{
+  std::size_t fired = 0;
+  for (std::uint64_t i = 0; i < ticks; ++i)
+  {
+    if (m_armed == 0)
+    {
+      m_tick += ticks - i;
+      break;
+    }
+
+    ++m_tick;
+    for (std::size_t level = 1; level < LEVELS; ++level)
+    {
+      if ((m_tick & ((std::uint64_t{1} << (SLOT_BITS * level)) - 1)) != 0)
+      {
+        break;
+      }
+      cascade(level);
+    }
+    fired += expire_current();
+  }
+  return fired;
+}
+
+/**
+ * @brief Advance to the tick containing a point in time.
+ *
+ * @param now Current time, usually std::chrono::steady_clock::now().
+ * @return Number of callbacks run.
+ */
+std::size_t timer_wheel::advance(std::chrono::steady_clock::time_point now)
+{
+  if (now <= m_origin)
+  {
+    return 0;
+  }
+  const auto target = static_cast<std::uint64_t>((now - m_origin) / m_resolution);
+  return target > m_tick ? tick(target - m_tick) : 0;
+}
+
+/**
+ * @brief Convert a duration to whole ticks, rounding up.
+ *
+ * @return At least 1.
+ */
+std::uint64_t timer_wheel::ticks_for(const std::chrono::milliseconds &duration) const
+{
+  if (duration <= m_resolution)
+  {
+    return 1;
+  }
+  return static_cast<std::uint64_t>((duration.count() + m_resolution.count() - 1) /
+                                    m_resolution.count());
+}
+
+/**
+ * @brief Last tick processed.
+ */
+std::uint64_t timer_wheel::current_tick() const noexcept { return m_tick; }
+
+/**
+ * @brief Duration of one tick.
+ */
+std::chrono::milliseconds timer_wheel::resolution() const noexcept
+{
+  return m_resolution;
+}
+
+/**
+ * @brief Number of armed timers.
+ */
+std::size_t timer_wheel::size() const noexcept { return m_armed; }
+
+/**
+ * @brief Check whether no timer is armed.
+ */
+bool timer_wheel::empty() const noexcept { return m_armed == 0; }
+
+/**
+ * @brief Link a node into the slot matching its expiry.
+ *
+ * Expiries beyond the top level's range are parked as far out as that level
+ * reaches and re-filed when their slot cascades.
+ */
+void timer_wheel::file(std::uint32_t index)
+{
+  static constexpr std::uint64_t MAX_DELTA =
+      (std::uint64_t{1} << (SLOT_BITS * LEVELS)) - 1;
+
+  node &n              = m_nodes[index];
+  std::uint64_t delta  = n.expiry - m_tick;
+  std::uint64_t placed = n.expiry;
+  if (delta > MAX_DELTA)
+  {
+    delta  = MAX_DELTA;
+    placed = m_tick + MAX_DELTA;
+  }
+
+  std::size_t level = 0;
+  while (level + 1 < LEVELS && delta >= (std::uint64_t{1} << (SLOT_BITS * (level + 1))))
+  {
+    ++level;
+  }
+
+  const auto slot = static_cast<std::uint16_t>(
+      level * SLOTS + ((placed >> (SLOT_BITS * level)) & SLOT_MASK));
+  n.slot  = slot;
+  n.armed = true;
+  n.prev  = NIL;
+  n.next  = m_heads[slot];
+  if (n.next != NIL)
+  {
+    m_nodes[n.next].prev = index;
+  }
+  m_heads[slot] = index;
+}
+
+/**
+ * @brief Remove an armed node from its slot list.
+ */
+void timer_wheel::unlink(std::uint32_t index) noexcept
+{
+  node &n = m_nodes[index];
+  if (n.prev == NIL)
+  {
+    m_heads[n.slot] = n.next;
+  }
+  else
+  {
+    m_nodes[n.prev].next = n.next;
+  }
+  if (n.next != NIL)
+  {
+    m_nodes[n.next].prev = n.prev;
+  }
+  n.armed = false;
+}
+
+/**
+ * @brief Return an unlinked node to the free list.
+ */
+void timer_wheel::release(std::uint32_t index) noexcept
+{
+  node &n = m_nodes[index];
+  n.cb    = nullptr;
+  ++n.generation;
+  n.next = m_free;
+  m_free = index;
+  --m_armed;
+}
+
+/**
+ * @brief Re-file the timers of a level's current slot into finer levels.
+ *
+ * @param level Level whose slot for the current tick is due.
+ */
+void timer_wheel::cascade(std::size_t level)
+{
+  const std::size_t slot =
+      level * SLOTS + ((m_tick >> (SLOT_BITS * level)) & SLOT_MASK);
+  std::uint32_t index = m_heads[slot];
+  m_heads[slot]       = NIL;
+  while (index != NIL)
+  {
+    const std::uint32_t next = m_nodes[index].next;
+    file(index);
+    index = next;
+  }
+}
+
+/**
+ * @brief Run every timer in the finest level's current slot.
+ *
+ * Each node is released before its callback runs, so the callback may
+ * re-arm or cancel freely.
+ *
+ * @return Number of callbacks run.
+ */
+std::size_t timer_wheel::expire_current()
+{
+  const std::size_t slot = m_tick & SLOT_MASK;
+  std::size_t fired      = 0;
+  while (m_heads[slot] != NIL)
+  {
+    const std::uint32_t index = m_heads[slot];
+    unlink(index);
+    callback cb = std::move(m_nodes[index].cb);
+    release(index);
+    ++fired;
+    cb();
+  }
+  return fired;
+}
+
+} // namespace fb
@@ -0,0 +1,334 @@
+#include <fb/tls.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef FB_NET_HAS_OPENSSL
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#endif
+
+namespace fb
+{
+
+#ifdef FB_NET_HAS_OPENSSL
+
+namespace
+{
+
+/**
+ * @brief Oldest OpenSSL error queued by this thread, as text.
+ */
+std::string openssl_error()
+{
+  const unsigned long code = ERR_get_error();
+  ERR_clear_error();
+  if (code == 0)
+  {
+    return "unknown error";
+  }
+  char text[256];
+  ERR_error_string_n(code, text, sizeof(text));
+  return text;
+}
+
+/**
+ * @brief Throw for a failed SSL call according to SSL_get_error().
+ *
+ * @param ssl Connection the call was made on.
+ * @param result Return value of the call.
+ * @param what Message prefix.
+ * @param would_block Error reported when a blocking socket timed out or a
+ * non-blocking one would block.
+ */
+[[noreturn]] void throw_ssl_error(SSL *ssl, int result, const char *what,
+                                  std::errc would_block)
+{
+  const int saved_errno = errno;
+  switch (SSL_get_error(ssl, result))
+  {
+  case SSL_ERROR_WANT_READ:
+  case SSL_ERROR_WANT_WRITE:
+    ERR_clear_error();
+    throw std::system_error(std::make_error_code(would_block), what);
+  case SSL_ERROR_SYSCALL:
+    if (ERR_peek_error() == 0 && saved_errno != 0)
+    {
+      throw std::system_error(saved_errno, std::system_category(), what);
+    }
+    break;
+  default:
+    break;
+  }
+  throw std::system_error(std::make_error_code(std::errc::protocol_error),
+                          std::string(what) + ": " + openssl_error());
+}
+
+/**
+ * @brief tls_session over an OpenSSL connection.
+ *
+ * OpenSSL 3 enables kTLS itself when SSL_OP_ENABLE_KTLS is set and the
+ * kernel accepts the negotiated cipher; the BIO then reports which
+ * directions were offloaded.
+ */
+class openssl_session : public tls_session
+{
+public:
+
+  explicit openssl_session(SSL *ssl) :
+    m_ssl(ssl)
+  {
+  }
+
+  openssl_session(const openssl_session &)            = delete;
+  openssl_session &operator=(const openssl_session &) = delete;
+
+  ~openssl_session() override
+  {
+    SSL_free(m_ssl);
+  }
+
+  bool kernel_send() const override
+  {
+    return BIO_get_ktls_send(SSL_get_wbio(m_ssl));
+  }
+
+  bool kernel_receive() const override
+  {
+    return BIO_get_ktls_recv(SSL_get_rbio(m_ssl));
+  }
+
+  int write(const void *buffer, int length) override
+  {
+    ERR_clear_error();
+    const int written = SSL_write(m_ssl, buffer, length);
+    if (written <= 0)
+    {
+      throw_ssl_error(m_ssl, written, "Failed to send data",
+                      std::errc::resource_unavailable_try_again);
+    }
+    return written;
+  }
+
+  int read(void *buffer, int length) override
+  {
+    ERR_clear_error();
+    const int received = SSL_read(m_ssl, buffer, length);
+    if (received <= 0)
+    {
+      if (SSL_get_error(m_ssl, received) == SSL_ERROR_ZERO_RETURN)
+      {
+        return 0;
+      }
+      throw_ssl_error(m_ssl, received, "Failed to receive data",
+                      std::errc::resource_unavailable_try_again);
+    }
+    return received;
+  }
+
+  int pending() const override
+  {
+    return SSL_pending(m_ssl);
+  }
+
+  void close_notify() noexcept override
+  {
+    ERR_clear_error();
+    SSL_shutdown(m_ssl);
+    ERR_clear_error();
+  }
+
+  std::string protocol() const override
+  {
+    return SSL_get_version(m_ssl);
+  }
+
+  std::string cipher() const override
+  {
+    const char *name = SSL_get_cipher_name(m_ssl);
+    return name ? name : "";
+  }
+
+private:
+
+  SSL *m_ssl; ///< Owned connection; the descriptor is not
+};
+
+/**
+ * @brief tls_context over an OpenSSL SSL_CTX.
+ */
+class openssl_context : public tls_context
+{
+public:
+
+  openssl_context(tls_role role, const openssl_tls_options &options) :
+    m_role(role),
+    m_verify_peer(options.verify_peer),
+    m_ctx(SSL_CTX_new(role == tls_role::server ? TLS_server_method() : TLS_client_method()))
+  {
+    if (!m_ctx)
+    {
+      throw std::runtime_error("SSL_CTX_new failed: " + openssl_error());
+    }
+    try
+    {
+      configure(options);
+    }
+    catch (...)
+    {
+      SSL_CTX_free(m_ctx);
+      throw;
+    }
+  }
+
+  openssl_context(const openssl_context &)            = delete;
+  openssl_context &operator=(const openssl_context &) = delete;
+
+  ~openssl_context() override
+  {
+    SSL_CTX_free(m_ctx);
+  }
+
+  std::unique_ptr<tls_session> handshake(socket_t fd, tls_role role,
+                                         const std::string &server_name) override
+  {
+    if (role != m_role)
+    {
+      throw std::logic_error("TLS context was created for the other role");
+    }
+
+    SSL *ssl = SSL_new(m_ctx);
+    if (!ssl)
+    {
+      throw std::runtime_error("SSL_new failed: " + openssl_error());
+    }
+    // The session owns ssl from here on
+    auto session = std::make_unique<openssl_session>(ssl);
+
+    // SSL_set_fd() uses a socket BIO that leaves the descriptor open
+    if (SSL_set_fd(ssl, fd) != 1)
+    {
+      throw std::runtime_error("SSL_set_fd failed: " + openssl_error());
+    }
+
+    ERR_clear_error();
+    int result;
+    if (role == tls_role::client)
+    {
+      if (!server_name.empty())
+      {
+        // SSL_set_tlsext_host_name() expands to an old-style cast to void*
+        SSL_ctrl(ssl, SSL_CTRL_SET_TLSEXT_HOSTNAME, TLSEXT_NAMETYPE_host_name,
+                 static_cast<void *>(const_cast<char *>(server_name.c_str())));
+        if (m_verify_peer && SSL_set1_host(ssl, server_name.c_str()) != 1)
+        {
+          throw std::runtime_error("SSL_set1_host failed: " + openssl_error());
+        }
+      }
+      result = SSL_connect(ssl);
+    }
+    else
+    {
+      result = SSL_accept(ssl);
+    }
+    if (result != 1)
+    {
+      throw_ssl_error(ssl, result, "TLS handshake failed", std::errc::timed_out);
+    }
+    return session;
+  }
+
+private:
+
+  void configure(const openssl_tls_options &options)
+  {
+    SSL_CTX_set_min_proto_version(m_ctx, TLS1_2_VERSION);
+    SSL_CTX_set_mode(m_ctx, SSL_MODE_ENABLE_PARTIAL_WRITE |
+                                SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+    SSL_CTX_set_options(m_ctx, SSL_OP_IGNORE_UNEXPECTED_EOF);
+    if (options.kernel_offload)
+    {
+      SSL_CTX_set_options(m_ctx, SSL_OP_ENABLE_KTLS);
+    }
+
+    if (!options.certificate_file.empty())
+    {
+      if (SSL_CTX_use_certificate_chain_file(m_ctx, options.certificate_file.c_str()) != 1)
+      {
+        throw std::invalid_argument("Cannot load TLS certificate " +
+                                    options.certificate_file + ": " + openssl_error());
+      }
+      const std::string &key =
+          options.private_key_file.empty() ? options.certificate_file : options.private_key_file;
+      if (SSL_CTX_use_PrivateKey_file(m_ctx, key.c_str(), SSL_FILETYPE_PEM) != 1 ||
+          SSL_CTX_check_private_key(m_ctx) != 1)
+      {
+        throw std::invalid_argument("Cannot load TLS private key " + key + ": " +
+                                    openssl_error());
+      }
+    }
+    else if (m_role == tls_role::server)
+    {
+      throw std::invalid_argument("A TLS server needs a certificate");
+    }
+
+    const bool verify = m_role == tls_role::client ? options.verify_peer
+                                                    : options.require_client_certificate;
+    if (verify)
+    {
+      const int loaded = options.ca_file.empty()
+                             ? SSL_CTX_set_default_verify_paths(m_ctx)
+                             : SSL_CTX_load_verify_locations(m_ctx, options.ca_file.c_str(),
+                                                             nullptr);
+      if (loaded != 1)
+      {
+        throw std::invalid_argument("Cannot load TLS trust anchors: " + openssl_error());
+      }
+      SSL_CTX_set_verify(m_ctx,
+                         m_role == tls_role::client
+                             ? SSL_VERIFY_PEER
+                             : SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+                         nullptr);
+    }
+  }
+
+  tls_role m_role;    ///< Side every handshake takes
+  bool m_verify_peer; ///< Clients check the server name
+  SSL_CTX *m_ctx;     ///< Shared credentials and settings
+};
+
+} // namespace
+
+#endif // FB_NET_HAS_OPENSSL
+
+/**
+ * @brief Create a TLS context backed by OpenSSL.
+ *
+ * Handshakes run in user space. With options.kernel_offload, OpenSSL then
+ * installs the session keys into kernel TLS when the kernel supports the
+ * negotiated cipher (Linux 4.13+ with the tls module for TX, 4.17+ for RX),
+ * so tcp_client's sendfile() and gathered sends stay zero-copy on the
+ * encrypted connection. Otherwise records are processed in user space.
+ *
+ * @param role Side the context's connections take.
+ * @param options Credentials and verification policy.
+ * @return Context to pass to tcp_client::start_tls().
+ * @throws std::invalid_argument If credentials or trust anchors cannot be
+ * loaded, or a server has no certificate.
+ * @throws std::logic_error If fb_net was built without OpenSSL.
+ */
+std::shared_ptr<tls_context> make_openssl_tls_context(tls_role role,
+                                                      const openssl_tls_options &options)
+{
+#ifdef FB_NET_HAS_OPENSSL
+  return std::make_shared<openssl_context>(role, options);
+#else
+  (void)role;
+  (void)options;
+  throw std::logic_error("fb_net was built without OpenSSL");
+#endif
+}
+
+} // namespace fb
@@ -3,15 +3,25 @@
 #include <fb/udp_socket.h>
 #include <stdexcept>
 #include <system_error>
+#include <thread>
 
 namespace fb {
 
+namespace
+{
+
+/// Waits shorter than this yield instead of sleeping
+constexpr auto PACING_SPIN_THRESHOLD = std::chrono::microseconds(100);
+
+} // namespace
+
 /**
  * @brief Default constructor creates unconnected UDP client
  */
 udp_client::udp_client() :
   m_is_connected(false),
-  m_timeout(DEFAULT_TIMEOUT)
+  m_timeout(DEFAULT_TIMEOUT),
+  m_kernel_pacing(false)
 {
   init_client(socket_address::Family::IPv4);
 }
@@ -22,7 +32,8 @@ udp_client::udp_client() :
  */
 udp_client::udp_client(socket_address::Family family) :
   m_is_connected(false),
-  m_timeout(DEFAULT_TIMEOUT)
+  m_timeout(DEFAULT_TIMEOUT),
+  m_kernel_pacing(false)
 {
   init_client(family);
 }
@@ -36,7 +47,8 @@ udp_client::udp_client(socket_address::Family family) :
 udp_client::udp_client(const socket_address & local_address, bool reuse_address) :
   m_socket(local_address, reuse_address),
   m_is_connected(false),
-  m_timeout(DEFAULT_TIMEOUT)
+  m_timeout(DEFAULT_TIMEOUT),
+  m_kernel_pacing(false)
 {
 }
 
@@ -48,13 +60,16 @@ udp_client::udp_client(const socket_address & local_address, bool reuse_address)
  */
 udp_client::udp_client(const socket_address & remote_address, const socket_address & local_address) :
   m_is_connected(false),
-  m_timeout(DEFAULT_TIMEOUT)
+  m_timeout(DEFAULT_TIMEOUT),
+  m_kernel_pacing(false)
 {
   // Initialize socket with appropriate family
   init_client(remote_address.family());
 
-  // Bind to local address if provided and not default
-  if (local_address.port() != 0 || !local_address.host().empty())
+  // Bind to local address if provided and not default. A UNIX_LOCAL client
+  // needs its own path to receive replies; other families must match
+  if (local_address.family() == remote_address.family() &&
+      (local_address.port() != 0 || !local_address.host().empty()))
   {
     m_socket.bind(local_address, true);
   }
@@ -70,9 +85,14 @@ udp_client::udp_client(udp_client && other) noexcept :
   m_socket(std::move(other.m_socket)),
   m_is_connected(other.m_is_connected),
   m_remote_address(std::move(other.m_remote_address)),
-  m_timeout(other.m_timeout)
+  m_timeout(other.m_timeout),
+  m_pacer(other.m_pacer),
+  m_kernel_pacing(other.m_kernel_pacing),
+  m_paced_batch(std::move(other.m_paced_batch))
 {
-  other.m_is_connected = false;
+  other.m_is_connected  = false;
+  other.m_pacer         = send_pacer();
+  other.m_kernel_pacing = false;
 }
 
 /**
@@ -86,8 +106,13 @@ udp_client & udp_client::operator=(udp_client && other) noexcept
     m_is_connected       = other.m_is_connected;
     m_remote_address     = std::move(other.m_remote_address);
     m_timeout            = other.m_timeout;
+    m_pacer              = other.m_pacer;
+    m_kernel_pacing      = other.m_kernel_pacing;
+    m_paced_batch        = std::move(other.m_paced_batch);
 
-    other.m_is_connected = false;
+    other.m_is_connected  = false;
+    other.m_pacer         = send_pacer();
+    other.m_kernel_pacing = false;
   }
   return *this;
 }
@@ -181,7 +206,8 @@ int udp_client::send(const void * buffer, std::size_t length)
 
   try
   {
-    int sent = m_socket.send_bytes(buffer, static_cast<int>(length));
+    int sent = m_pacer.enabled() ? paced_send(buffer, length, nullptr)
+                                 : m_socket.send_bytes(buffer, static_cast<int>(length));
     if (sent > 0)
     {
       if (onDataSent.slot_count() > 0)
@@ -297,7 +323,8 @@ int udp_client::send_to(const void * buffer, std::size_t length, const socket_ad
 
   try
   {
-    int sent = m_socket.send_to(buffer, static_cast<int>(length), address);
+    int sent = m_pacer.enabled() ? paced_send(buffer, length, &address)
+                                 : m_socket.send_to(buffer, static_cast<int>(length), address);
     if (sent > 0)
     {
       if (onDataSent.slot_count() > 0)
@@ -329,6 +356,45 @@ int udp_client::send_to(const std::string & message, const socket_address & addr
   return send_to(message.data(), message.size(), address);
 }
 
+/**
+ * @brief Send several datagrams in as few system calls as possible
+ *
+ * Forwards to udp_socket::send_batch(). onDataSent is emitted for every
+ * datagram that was handed to the kernel. With pacing, the batch is split
+ * into runs that fit the bucket, waiting in between.
+ *
+ * @param entries Array of datagrams (payload and destination)
+ * @param count Number of entries
+ * @return Number of datagrams sent
+ * @throws std::system_error
+ */
+int udp_client::send_batch(const udp_send_entry * entries, std::size_t count)
+{
+  validate_socket();
+
+  try
+  {
+    int sent = m_pacer.enabled() ? paced_send_batch(entries, count)
+                                 : m_socket.send_batch(entries, count);
+    if (onDataSent.slot_count() > 0)
+    {
+      for (int i = 0; i < sent; ++i)
+      {
+        onDataSent.emit(entries[i].buffer, entries[i].length);
+      }
+    }
+    return sent;
+  }
+  catch (const std::exception & ex)
+  {
+    if (onSendError.slot_count() > 0)
+    {
+      onSendError.emit(ex.what());
+    }
+    throw;
+  }
+}
+
 /**
  * @brief Receive data from any source
  * @param buffer Pointer to receive buffer
@@ -627,6 +693,91 @@ int udp_client::get_send_buffer_size()
   return m_socket.get_send_buffer_size();
 }
 
+/**
+ * @brief Limit the send rate with a token bucket
+ *
+ * Every send call waits inline until its datagram fits the bucket, so up
+ * to @p burst_bytes leave back to back after an idle period and the long-term
+ * rate never exceeds @p bytes_per_second. With @p kernel_pacing the socket
+ * also enables SO_TXTIME and each datagram carries its evenly spaced
+ * departure time; an fq qdisc on the egress interface then releases them at
+ * exactly that spacing while the caller only waits once it is a full burst
+ * ahead. Other qdiscs ignore the times, which leaves the user-space bucket
+ * as the limit. Where SO_TXTIME is unavailable the call silently falls back
+ * to user-space pacing; kernel_pacing() reports which is active.
+ *
+ * @param bytes_per_second Payload bytes per second (0 disables pacing)
+ * @param burst_bytes Bucket depth (0 selects DEFAULT_PACING_BURST); make it
+ * at least the largest datagram
+ * @param kernel_pacing Prefer SO_TXTIME departure times
+ * @throws std::system_error
+ */
+void udp_client::set_pacing(std::uint64_t bytes_per_second,
+                            std::size_t burst_bytes, bool kernel_pacing)
+{
+  validate_socket();
+
+  send_pacer pacer(bytes_per_second,
+                   burst_bytes == 0 ? DEFAULT_PACING_BURST : burst_bytes);
+  bool use_kernel = false;
+  if (pacer.enabled() && kernel_pacing)
+  {
+    try
+    {
+      m_socket.set_transmit_time(true);
+      use_kernel = true;
+    }
+    catch (const std::system_error &)
+    {
+      // No SO_TXTIME here: the user-space bucket does all the pacing
+    }
+  }
+  if (!use_kernel && m_socket.get_transmit_time())
+  {
+    m_socket.set_transmit_time(false);
+  }
+
+  m_pacer         = pacer;
+  m_kernel_pacing = use_kernel;
+}
+
+/**
+ * @brief Get the pacing rate in bytes per second (0 when unpaced)
+ */
+std::uint64_t udp_client::pacing_rate() const
+{
+  return m_pacer.rate();
+}
+
+/**
+ * @brief Get the pacing bucket depth in bytes (0 when unpaced)
+ */
+std::size_t udp_client::pacing_burst() const
+{
+  return m_pacer.enabled() ? m_pacer.burst() : 0;
+}
+
+/**
+ * @brief Whether sends carry SO_TXTIME departure times
+ */
+bool udp_client::kernel_pacing() const
+{
+  return m_kernel_pacing;
+}
+
+/**
+ * @brief Time a send of @p length bytes would wait for the pacer
+ *
+ * Lets one thread serving several paced clients pick one that can send now.
+ *
+ * @param length Datagram size
+ * @return Zero if the datagram may be sent without waiting
+ */
+std::chrono::nanoseconds udp_client::pacing_delay(std::size_t length) const
+{
+  return m_pacer.delay(length, send_pacer::clock::now());
+}
+
 /**
  * @brief Check if client is connected to a specific address
  * @return True if connected
@@ -751,4 +902,140 @@ void udp_client::init_client(socket_address::Family family)
   m_socket.set_receive_timeout(m_timeout);
 }
 
+/**
+ * @brief Block until the pacer admits a datagram
+ * @param length Datagram size
+ *
+ * Sleeps for all but the last stretch of the wait, then yields, so short
+ * gaps are not stretched to the scheduler's sleep granularity.
+ */
+void udp_client::wait_for_pacer(std::size_t length) const
+{
+  for (;;)
+  {
+    const auto wait = m_pacer.delay(length, send_pacer::clock::now());
+    if (wait.count() == 0)
+    {
+      return;
+    }
+    if (wait > PACING_SPIN_THRESHOLD)
+    {
+      std::this_thread::sleep_for(wait - PACING_SPIN_THRESHOLD);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+/**
+ * @brief Send one datagram once the pacer admits it
+ * @param buffer Payload
+ * @param length Payload size
+ * @param destination Target, or nullptr for the connected peer
+ * @return Number of bytes sent
+ * @throws std::system_error
+ */
+int udp_client::paced_send(const void *buffer, std::size_t length,
+                           const socket_address *destination)
+{
+  wait_for_pacer(length);
+  const auto departure = m_pacer.consume(length, send_pacer::clock::now());
+
+  try
+  {
+    if (m_kernel_pacing)
+    {
+      udp_send_entry entry;
+      entry.buffer      = buffer;
+      entry.length      = length;
+      entry.destination = destination ? *destination : m_remote_address;
+      entry.send_time   = departure.time_since_epoch();
+      return m_socket.send_batch(&entry, 1) == 1 ? static_cast<int>(length) : 0;
+    }
+    return destination
+               ? m_socket.send_to(buffer, static_cast<int>(length), *destination)
+               : m_socket.send_bytes(buffer, static_cast<int>(length));
+  }
+  catch (...)
+  {
+    m_pacer.refund(length);
+    throw;
+  }
+}
+
+/**
+ * @brief Send a batch in runs the pacer admits, one sendmmsg() per run
+ * @param entries Datagrams to send
+ * @param count Number of entries
+ * @return Number of datagrams sent
+ * @throws std::system_error if nothing could be sent
+ */
+int udp_client::paced_send_batch(const udp_send_entry *entries, std::size_t count)
+{
+  if (count == 0)
+  {
+    return 0;
+  }
+  if (!entries)
+  {
+    throw std::invalid_argument("Entries cannot be null for non-zero count");
+  }
+
+  std::size_t done = 0;
+  while (done < count)
+  {
+    wait_for_pacer(entries[done].length);
+    const auto now = send_pacer::clock::now();
+
+    // Everything that conforms now goes out in one call
+    std::size_t run = 0;
+    if (m_kernel_pacing)
+    {
+      m_paced_batch.clear();
+    }
+    while (done + run < count && (run == 0 || m_pacer.delay(entries[done + run].length, now).count() == 0))
+    {
+      const udp_send_entry &entry = entries[done + run];
+      const auto departure        = m_pacer.consume(entry.length, now);
+      if (m_kernel_pacing)
+      {
+        m_paced_batch.push_back(entry);
+        m_paced_batch.back().send_time = departure.time_since_epoch();
+      }
+      ++run;
+    }
+
+    std::size_t sent = 0;
+    try
+    {
+      sent = static_cast<std::size_t>(
+          m_socket.send_batch(m_kernel_pacing ? m_paced_batch.data() : entries + done, run));
+    }
+    catch (...)
+    {
+      for (std::size_t i = run; i > 0; --i)
+      {
+        m_pacer.refund(entries[done + i - 1].length);
+      }
+      if (done > 0)
+      {
+        break;
+      }
+      throw;
+    }
+    for (std::size_t i = run; i > sent; --i)
+    {
+      m_pacer.refund(entries[done + i - 1].length);
+    }
+    done += sent;
+    if (sent < run)
+    {
+      break;
+    }
+  }
+  return static_cast<int>(done);
+}
+
 } // namespace fb
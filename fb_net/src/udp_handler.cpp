@@ -6,6 +6,20 @@
 namespace fb
 {
 
+namespace
+{
+
+/// Timestamps of the packet being processed on this thread, if any
+thread_local const udp_timestamp *t_packet_timestamp = nullptr;
+
+/// steady_clock time as stored in the statistics shards
+std::uint64_t clock_ticks(std::chrono::steady_clock::time_point time) noexcept
+{
+  return static_cast<std::uint64_t>(time.time_since_epoch().count());
+}
+
+} // namespace
+
 /**
  * @class fb::udp_handler
  * @brief Base class for processing individual UDP datagrams.
@@ -19,12 +33,9 @@ namespace fb
  * @brief Construct a handler and initialise statistics.
  */
 udp_handler::udp_handler() :
-  m_packets_processed(0),
-  m_bytes_processed(0),
-  m_error_count(0),
-  m_creation_time(std::chrono::steady_clock::now()),
-  m_last_packet_time_rep(m_creation_time.time_since_epoch().count())
+  m_creation_time(std::chrono::steady_clock::now())
 {
+  m_statistics.store(LAST_PACKET_TIME, clock_ticks(m_creation_time));
 }
 
 /**
@@ -111,6 +122,72 @@ bool udp_handler::process_packet(const void *buffer,
   }
 }
 
+/**
+ * @brief Process a packet and expose its receive timestamps to the handler.
+ *
+ * @param buffer Packet payload.
+ * @param length Payload length in bytes.
+ * @param sender_address Source endpoint of the packet.
+ * @param timestamp Kernel receive timestamps of the packet.
+ * @return True if the packet was accepted and processed successfully.
+ *
+ * Runs the same pipeline as the overload without timestamps; while it runs,
+ * `packet_timestamp()` returns @p timestamp on the calling thread, so shared
+ * handlers invoked from several workers each see their own packet's stamps.
+ */
+bool udp_handler::process_packet(const void *buffer,
+                                 std::size_t length,
+                                 const socket_address &sender_address,
+                                 const udp_timestamp &timestamp) noexcept
+{
+  const udp_timestamp *previous = t_packet_timestamp;
+  t_packet_timestamp            = &timestamp;
+  bool success = process_packet(buffer, length, sender_address);
+  t_packet_timestamp = previous;
+  return success;
+}
+
+/**
+ * @brief Process a burst of packets in one call.
+ *
+ * @param packets Packets in arrival order.
+ * @param count Number of packets.
+ * @return Number of packets processed successfully.
+ *
+ * The default runs each packet through `process_packet()`. Override it to
+ * decode a burst at once or to take downstream locks once per batch; an
+ * override bypasses the per-packet pipeline and should report its work
+ * through `record_batch()`. Exceptions thrown by an override count every
+ * packet of the batch as dropped.
+ */
+std::size_t udp_handler::handle_batch(const packet_view *packets, std::size_t count)
+{
+  std::size_t processed = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const packet_view &packet = packets[i];
+    if (process_packet(packet.buffer, packet.length, *packet.sender, *packet.timestamp))
+    {
+      ++processed;
+    }
+  }
+  return processed;
+}
+
+/**
+ * @brief Receive timestamps of the packet currently being processed.
+ *
+ * @return Timestamps passed to `process_packet()` on this thread; all zero
+ *         outside processing or when the packet was not timestamped.
+ *
+ * Intended for use from `handle_packet()` and the packet hooks.
+ */
+const udp_timestamp &udp_handler::packet_timestamp() noexcept
+{
+  static const udp_timestamp none;
+  return t_packet_timestamp ? *t_packet_timestamp : none;
+}
+
 /**
  * @brief Return a human-readable handler name.
  *
@@ -151,7 +228,7 @@ bool udp_handler::can_handle_address(const socket_address &sender_address) const
  */
 std::uint64_t udp_handler::packets_processed() const
 {
-  return m_packets_processed.load(std::memory_order_relaxed);
+  return m_statistics.value(PACKETS_PROCESSED);
 }
 
 /**
@@ -159,7 +236,7 @@ std::uint64_t udp_handler::packets_processed() const
  */
 std::uint64_t udp_handler::bytes_processed() const
 {
-  return m_bytes_processed.load(std::memory_order_relaxed);
+  return m_statistics.value(BYTES_PROCESSED);
 }
 
 /**
@@ -167,7 +244,33 @@ std::uint64_t udp_handler::bytes_processed() const
  */
 std::uint64_t udp_handler::error_count() const
 {
-  return m_error_count.load(std::memory_order_relaxed);
+  return m_statistics.value(ERROR_COUNT);
+}
+
+/**
+ * @brief Publish the packet, byte and error counters in a metrics registry.
+ *
+ * The registry reads the same sharded counters as the getters, and only when
+ * it is exported, so packet processing is unchanged.
+ *
+ * @param registry Registry to add the metrics to
+ * @param prefix Start of every metric name, e.g. "md_handler"
+ * @return Handle that unregisters the metrics; destroy it before the handler
+ * @throws std::invalid_argument if a name is invalid or already registered
+ */
+metrics_registration udp_handler::register_metrics(metrics_registry & registry,
+                                                   const std::string & prefix) const
+{
+  metrics_registration registration = registry.add_counter(
+      prefix + "_packets_processed_total", "Packets processed by the handler",
+      [this]() { return packets_processed(); });
+  registration.append(registry.add_counter(
+      prefix + "_bytes_processed_total", "Bytes processed by the handler",
+      [this]() { return bytes_processed(); }));
+  registration.append(registry.add_counter(
+      prefix + "_errors_total", "Packets the handler failed to process",
+      [this]() { return error_count(); }));
+  return registration;
 }
 
 /**
@@ -183,22 +286,39 @@ std::chrono::steady_clock::time_point udp_handler::creation_time() const
  */
 std::chrono::steady_clock::time_point udp_handler::last_packet_time() const
 {
-  auto rep = m_last_packet_time_rep.load(std::memory_order_relaxed);
+  const auto rep = static_cast<std::chrono::steady_clock::rep>(
+      m_statistics.max(LAST_PACKET_TIME));
   return std::chrono::steady_clock::time_point(
       std::chrono::steady_clock::duration(rep));
 }
 
+/**
+ * @brief Account for a batch handled by a `handle_batch()` override.
+ *
+ * @param processed Packets processed successfully.
+ * @param bytes Payload bytes of the processed packets.
+ * @param errors Packets rejected or failed.
+ */
+void udp_handler::record_batch(std::size_t processed,
+                               std::size_t bytes,
+                               std::size_t errors) noexcept
+{
+  m_statistics.add(PACKETS_PROCESSED, processed);
+  m_statistics.add(BYTES_PROCESSED, bytes);
+  m_statistics.add(ERROR_COUNT, errors);
+  m_statistics.set(LAST_PACKET_TIME, clock_ticks(std::chrono::steady_clock::now()));
+}
+
 /**
  * @brief Reset tracked statistics back to zero.
  */
 void udp_handler::reset_statistics()
 {
-  m_packets_processed.store(0, std::memory_order_relaxed);
-  m_bytes_processed.store(0, std::memory_order_relaxed);
-  m_error_count.store(0, std::memory_order_relaxed);
+  m_statistics.store(PACKETS_PROCESSED, 0);
+  m_statistics.store(BYTES_PROCESSED, 0);
+  m_statistics.store(ERROR_COUNT, 0);
   m_creation_time = std::chrono::steady_clock::now();
-  m_last_packet_time_rep.store(m_creation_time.time_since_epoch().count(),
-                               std::memory_order_relaxed);
+  m_statistics.store(LAST_PACKET_TIME, clock_ticks(m_creation_time));
 }
 
 /**
@@ -287,17 +407,15 @@ void udp_handler::update_statistics(std::size_t length, bool success)
 {
   if (success)
   {
-    m_packets_processed.fetch_add(1, std::memory_order_relaxed);
-    m_bytes_processed.fetch_add(length, std::memory_order_relaxed);
+    m_statistics.add(PACKETS_PROCESSED);
+    m_statistics.add(BYTES_PROCESSED, length);
   }
   else
   {
-    m_error_count.fetch_add(1, std::memory_order_relaxed);
+    m_statistics.add(ERROR_COUNT);
   }
 
-  auto now = std::chrono::steady_clock::now();
-  m_last_packet_time_rep.store(now.time_since_epoch().count(),
-                               std::memory_order_relaxed);
+  m_statistics.set(LAST_PACKET_TIME, clock_ticks(std::chrono::steady_clock::now()));
 }
 
 } // namespace fb
@@ -1,12 +1,50 @@
 #include <fb/udp_server.h>
+#include <fb/profiler.h>
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <stdexcept>
 #include <system_error>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace fb
 {
 
+namespace
+{
+
+/**
+ * @brief Best-effort pin of the calling thread to one CPU.
+ *
+ * Only implemented on Linux; elsewhere this is a no-op.
+ *
+ * @param cpu Zero-based CPU index (wrapped to the available CPU count).
+ */
+void pin_current_thread(std::size_t cpu)
+{
+#ifdef __linux__
+  const unsigned int cpus = std::thread::hardware_concurrency();
+  if (cpus == 0)
+  {
+    return;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % cpus, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)cpu;
+#endif
+}
+
+} // namespace
+
 /**
  * @class fb::udp_server
  * @brief Multi-threaded UDP server with worker-based packet processing.
@@ -29,19 +67,35 @@ udp_server::udp_server() :
   m_max_queued(DEFAULT_MAX_QUEUED),
   m_packet_buffer_size(DEFAULT_PACKET_BUFFER_SIZE),
   m_packet_timeout(DEFAULT_PACKET_TIMEOUT),
-  m_total_packets(0),
-  m_processed_packets(0),
-  m_dropped_packets(0),
+  m_receive_batch_size(DEFAULT_RECEIVE_BATCH_SIZE),
+  m_packet_pool_size(DEFAULT_PACKET_POOL_SIZE),
+  m_use_lock_free_queue(false),
+  m_queue_spin_count(0),
+  m_receiver_shards(DEFAULT_RECEIVER_SHARDS),
+  m_pin_receivers(false),
+  m_busy_poll_budget(0),
+  m_busy_poll_cpu(-1),
+  m_flow_workers(0),
+  m_handler_cache_size(DEFAULT_HANDLER_CACHE_SIZE),
+  m_worker_serial(0),
+  m_handler_instances(0),
+  m_track_latency(false),
+  m_statistics_interval(0),
+  m_next_statistics(0),
+  m_published_total(0),
+  m_published_processed(0),
+  m_published_dropped(0),
+  m_published_queued(0),
   m_has_socket(false),
   m_has_handler(false)
 {
 }
 
 /**
- * @brief Construct a server that creates a handler per packet.
+ * @brief Construct a server that builds handlers with a factory.
  *
  * @param server_socket Bound socket used to receive datagrams.
- * @param handler_factory Factory invoked for each received packet.
+ * @param handler_factory Factory invoked when a worker needs a new handler.
  * @param max_threads Maximum worker threads (0 selects DEFAULT_MAX_THREADS).
  * @param max_queued Maximum queued packets (0 selects DEFAULT_MAX_QUEUED).
  */
@@ -57,9 +111,25 @@ udp_server::udp_server(udp_socket server_socket,
   m_max_queued(max_queued == 0 ? DEFAULT_MAX_QUEUED : max_queued),
   m_packet_buffer_size(DEFAULT_PACKET_BUFFER_SIZE),
   m_packet_timeout(DEFAULT_PACKET_TIMEOUT),
-  m_total_packets(0),
-  m_processed_packets(0),
-  m_dropped_packets(0),
+  m_receive_batch_size(DEFAULT_RECEIVE_BATCH_SIZE),
+  m_packet_pool_size(DEFAULT_PACKET_POOL_SIZE),
+  m_use_lock_free_queue(false),
+  m_queue_spin_count(0),
+  m_receiver_shards(DEFAULT_RECEIVER_SHARDS),
+  m_pin_receivers(false),
+  m_busy_poll_budget(0),
+  m_busy_poll_cpu(-1),
+  m_flow_workers(0),
+  m_handler_cache_size(DEFAULT_HANDLER_CACHE_SIZE),
+  m_worker_serial(0),
+  m_handler_instances(0),
+  m_track_latency(false),
+  m_statistics_interval(0),
+  m_next_statistics(0),
+  m_published_total(0),
+  m_published_processed(0),
+  m_published_dropped(0),
+  m_published_queued(0),
   m_has_socket(true),
   m_has_handler(true)
 {
@@ -86,9 +156,25 @@ udp_server::udp_server(udp_socket server_socket,
   m_max_queued(max_queued == 0 ? DEFAULT_MAX_QUEUED : max_queued),
   m_packet_buffer_size(DEFAULT_PACKET_BUFFER_SIZE),
   m_packet_timeout(DEFAULT_PACKET_TIMEOUT),
-  m_total_packets(0),
-  m_processed_packets(0),
-  m_dropped_packets(0),
+  m_receive_batch_size(DEFAULT_RECEIVE_BATCH_SIZE),
+  m_packet_pool_size(DEFAULT_PACKET_POOL_SIZE),
+  m_use_lock_free_queue(false),
+  m_queue_spin_count(0),
+  m_receiver_shards(DEFAULT_RECEIVER_SHARDS),
+  m_pin_receivers(false),
+  m_busy_poll_budget(0),
+  m_busy_poll_cpu(-1),
+  m_flow_workers(0),
+  m_handler_cache_size(DEFAULT_HANDLER_CACHE_SIZE),
+  m_worker_serial(0),
+  m_handler_instances(0),
+  m_track_latency(false),
+  m_statistics_interval(0),
+  m_next_statistics(0),
+  m_published_total(0),
+  m_published_processed(0),
+  m_published_dropped(0),
+  m_published_queued(0),
   m_has_socket(true),
   m_has_handler(true)
 {
@@ -106,22 +192,50 @@ udp_server::udp_server(udp_server &&other) noexcept :
   m_handler_factory(std::move(other.m_handler_factory)),
   m_running(other.m_running.load()),
   m_should_stop(other.m_should_stop.load()),
+  m_extra_sockets(std::move(other.m_extra_sockets)),
+  m_packet_allocator(other.m_packet_allocator),
   m_max_threads(other.m_max_threads),
   m_max_queued(other.m_max_queued),
   m_packet_buffer_size(other.m_packet_buffer_size),
   m_packet_timeout(other.m_packet_timeout),
-  m_total_packets(other.m_total_packets.load()),
-  m_processed_packets(other.m_processed_packets.load()),
-  m_dropped_packets(other.m_dropped_packets.load()),
+  m_receive_batch_size(other.m_receive_batch_size),
+  m_packet_pool_size(other.m_packet_pool_size),
+  m_use_lock_free_queue(other.m_use_lock_free_queue),
+  m_queue_spin_count(other.m_queue_spin_count),
+  m_receiver_shards(other.m_receiver_shards),
+  m_pin_receivers(other.m_pin_receivers),
+  m_busy_poll_budget(other.m_busy_poll_budget),
+  m_busy_poll_cpu(other.m_busy_poll_cpu),
+  m_pool_policy(other.m_pool_policy),
+  m_flow_workers(other.m_flow_workers),
+  m_flow_key(std::move(other.m_flow_key)),
+  m_handler_cache_size(other.m_handler_cache_size),
+  m_thread_configurator(std::move(other.m_thread_configurator)),
+  m_worker_serial(0),
+  m_handler_instances(other.m_handler_instances.load()),
   m_start_time(other.m_start_time),
+  m_track_latency(other.m_track_latency),
+  m_queue_latency(std::move(other.m_queue_latency)),
+  m_service_latency(std::move(other.m_service_latency)),
+  m_statistics_interval(other.m_statistics_interval),
+  m_next_statistics(0),
+  m_published_total(other.m_published_total),
+  m_published_processed(other.m_published_processed),
+  m_published_dropped(other.m_published_dropped),
+  m_published_queued(other.m_published_queued),
   m_has_socket(other.m_has_socket),
   m_has_handler(other.m_has_handler)
 {
+  m_packets.store(TOTAL_PACKETS, other.m_packets.value(TOTAL_PACKETS));
+  m_packets.store(PROCESSED_PACKETS, other.m_packets.value(PROCESSED_PACKETS));
+  m_packets.store(DROPPED_PACKETS, other.m_packets.value(DROPPED_PACKETS));
+
   // Note: We cannot move threads, so the moved-from server loses its threads
-  other.m_running     = false;
-  other.m_should_stop = true;
-  other.m_has_socket  = false;
-  other.m_has_handler = false;
+  other.m_running       = false;
+  other.m_should_stop   = true;
+  other.m_track_latency = false;
+  other.m_has_socket    = false;
+  other.m_has_handler   = false;
 }
 
 /**
@@ -154,20 +268,45 @@ udp_server &udp_server::operator=(udp_server &&other) noexcept
     m_shared_handler     = std::move(other.m_shared_handler);
     m_running            = other.m_running.load();
     m_should_stop        = other.m_should_stop.load();
+    m_extra_sockets      = std::move(other.m_extra_sockets);
+    m_packet_allocator   = other.m_packet_allocator;
     m_max_threads        = other.m_max_threads;
     m_max_queued         = other.m_max_queued;
     m_packet_buffer_size = other.m_packet_buffer_size;
     m_packet_timeout     = other.m_packet_timeout;
-    m_total_packets      = other.m_total_packets.load();
-    m_processed_packets  = other.m_processed_packets.load();
-    m_dropped_packets    = other.m_dropped_packets.load();
+    m_receive_batch_size = other.m_receive_batch_size;
+    m_packet_pool_size   = other.m_packet_pool_size;
+    m_use_lock_free_queue = other.m_use_lock_free_queue;
+    m_queue_spin_count   = other.m_queue_spin_count;
+    m_receiver_shards    = other.m_receiver_shards;
+    m_pin_receivers      = other.m_pin_receivers;
+    m_busy_poll_budget   = other.m_busy_poll_budget;
+    m_busy_poll_cpu      = other.m_busy_poll_cpu;
+    m_pool_policy        = other.m_pool_policy;
+    m_flow_workers       = other.m_flow_workers;
+    m_flow_key           = std::move(other.m_flow_key);
+    m_handler_cache_size = other.m_handler_cache_size;
+    m_thread_configurator = std::move(other.m_thread_configurator);
+    m_packets.store(TOTAL_PACKETS, other.m_packets.value(TOTAL_PACKETS));
+    m_packets.store(PROCESSED_PACKETS, other.m_packets.value(PROCESSED_PACKETS));
+    m_packets.store(DROPPED_PACKETS, other.m_packets.value(DROPPED_PACKETS));
+    m_handler_instances  = other.m_handler_instances.load();
     m_start_time         = other.m_start_time;
+    m_track_latency      = other.m_track_latency;
+    m_queue_latency      = std::move(other.m_queue_latency);
+    m_service_latency    = std::move(other.m_service_latency);
+    m_statistics_interval = other.m_statistics_interval;
+    m_published_total     = other.m_published_total;
+    m_published_processed = other.m_published_processed;
+    m_published_dropped   = other.m_published_dropped;
+    m_published_queued    = other.m_published_queued;
     m_has_socket         = other.m_has_socket;
     m_has_handler        = other.m_has_handler;
 
-    other.m_running      = false;
-    other.m_should_stop  = true;
-    other.m_has_socket   = false;
+    other.m_running       = false;
+    other.m_should_stop   = true;
+    other.m_track_latency = false;
+    other.m_has_socket    = false;
     other.m_has_handler  = false;
   }
   return *this;
@@ -206,21 +345,74 @@ void udp_server::start()
 
   validate_configuration();
 
-  m_should_stop = false;
-  m_start_time  = std::chrono::steady_clock::now();
+  m_should_stop   = false;
+  m_worker_serial = 0;
+  m_start_time    = std::chrono::steady_clock::now();
+
+  m_published_total     = m_packets.value(TOTAL_PACKETS);
+  m_published_processed = m_packets.value(PROCESSED_PACKETS);
+  m_published_dropped   = m_packets.value(DROPPED_PACKETS);
+  m_published_queued    = 0;
+  m_next_statistics.store((m_start_time + m_statistics_interval).time_since_epoch().count(),
+                          std::memory_order_relaxed);
+
+  {
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    m_packet_pool.reserve(m_packet_pool_size);
+  }
+
+  if (m_flow_workers > 0)
+  {
+    // The queue limit is split evenly across the per-worker rings
+    const std::size_t capacity =
+        (m_max_queued + m_flow_workers - 1) / m_flow_workers;
+    m_flow_queues.clear();
+    for (std::size_t i = 0; i < m_flow_workers; ++i)
+    {
+      m_flow_queues.push_back(
+          std::make_unique<mpmc_queue<packet_ptr>>(
+              capacity, m_queue_spin_count));
+    }
+  }
+  else if (m_use_lock_free_queue)
+  {
+    m_lock_free_queue =
+        std::make_unique<mpmc_queue<packet_ptr>>(
+            m_max_queued, m_queue_spin_count);
+  }
 
   try
   {
     on_server_starting();
 
-    // Start receiver thread
-    m_receiver_thread = std::thread(&udp_server::receiver_thread_proc, this);
+    // Extra shard sockets must be bound before any receiver runs
+    open_shard_sockets();
+
+    // Start one receiver thread per socket
+    m_receiver_threads.emplace_back(&udp_server::receiver_thread_proc, this,
+                                    std::ref(m_server_socket), 0);
+    for (std::size_t i = 0; i < m_shard_sockets.size(); ++i)
+    {
+      m_receiver_threads.emplace_back(&udp_server::receiver_thread_proc, this,
+                                      std::ref(m_shard_sockets[i]), i + 1);
+    }
+    for (std::size_t i = 0; i < m_extra_sockets.size(); ++i)
+    {
+      m_receiver_threads.emplace_back(&udp_server::receiver_thread_proc, this,
+                                      std::ref(m_extra_sockets[i]),
+                                      m_shard_sockets.size() + i + 1);
+    }
 
     // Start initial worker threads (emit signals outside lock)
     std::vector<std::size_t> created_counts;
     {
       std::lock_guard<std::mutex> lock(m_threads_mutex);
-      for (std::size_t i = 0; i < std::min(m_max_threads, std::size_t(2)); ++i)
+      for (std::size_t i = 0; i < m_flow_queues.size(); ++i)
+      {
+        m_worker_threads.emplace_back(&udp_server::flow_worker_proc, this, i);
+        created_counts.push_back(m_worker_threads.size());
+      }
+      for (std::size_t i = 0; m_flow_queues.empty() && i < min_worker_threads(); ++i)
       {
         m_worker_threads.emplace_back(&udp_server::worker_thread_proc, this);
         created_counts.push_back(m_worker_threads.size());
@@ -244,10 +436,17 @@ void udp_server::start()
   catch (...)
   {
     m_should_stop = true;
-    if (m_receiver_thread.joinable())
+    for (auto &thread : m_receiver_threads)
     {
-      m_receiver_thread.join();
+      if (thread.joinable())
+      {
+        thread.join();
+      }
     }
+    m_receiver_threads.clear();
+    m_shard_sockets.clear();
+    m_lock_free_queue.reset();
+    m_flow_queues.clear();
     throw;
   }
 }
@@ -282,13 +481,38 @@ void udp_server::stop(const std::chrono::milliseconds &timeout)
     {
       m_server_socket.close();
     }
+    for (auto &socket : m_shard_sockets)
+    {
+      if (!socket.is_closed())
+      {
+        socket.close();
+      }
+    }
+    for (auto &socket : m_extra_sockets)
+    {
+      if (!socket.is_closed())
+      {
+        socket.close();
+      }
+    }
 
     // Wake up all waiting worker threads
     m_queue_condition.notify_all();
+    if (m_lock_free_queue)
+    {
+      m_lock_free_queue->notify_all();
+    }
+    for (auto &queue : m_flow_queues)
+    {
+      queue->notify_all();
+    }
 
     // Shutdown threads with timeout
     shutdown_threads(timeout);
 
+    // Deliver the counters accumulated since the last interval
+    publish_statistics(true);
+
     // Clear any remaining packets
     {
       std::lock_guard<std::mutex> lock(m_queue_mutex);
@@ -297,6 +521,8 @@ void udp_server::stop(const std::chrono::milliseconds &timeout)
         m_packet_queue.pop();
       }
     }
+    m_lock_free_queue.reset();
+    m_flow_queues.clear();
 
     // Emit stopped signal
     if (onServerStopped.slot_count() > 0) {
@@ -339,9 +565,12 @@ void udp_server::set_server_socket(udp_socket server_socket)
 }
 
 /**
- * @brief Install the factory used to create per-packet handlers.
+ * @brief Install the factory used to create packet handlers.
+ *
+ * Built handlers are reused by their worker; see set_handler_cache_size().
  *
- * @param factory Function returning a new `udp_handler` for each packet.
+ * @param factory Function returning a new `udp_handler`, or null to drop
+ * the packet that triggered the call.
  * @throws std::runtime_error If the server is already running.
  */
 void udp_server::set_handler_factory(HandlerFactory factory)
@@ -392,6 +621,32 @@ void udp_server::set_max_threads(std::size_t max_threads)
   m_max_threads = max_threads == 0 ? DEFAULT_MAX_THREADS : max_threads;
 }
 
+/**
+ * @brief Configure how the worker pool grows and shrinks.
+ *
+ * @param policy Minimum pool size, growth triggers and idle retirement.
+ * @throws std::invalid_argument If queue_depth_per_thread is zero or a
+ * duration is negative.
+ * @throws std::runtime_error If the server is already running.
+ */
+void udp_server::set_worker_pool(const worker_pool_policy &policy)
+{
+  if (m_running.load())
+  {
+    throw std::runtime_error("Cannot set worker pool while server is running");
+  }
+  if (policy.queue_depth_per_thread == 0)
+  {
+    throw std::invalid_argument("Queue depth per thread must be positive");
+  }
+  if (policy.queue_wait_threshold.count() < 0 || policy.idle_timeout.count() < 0)
+  {
+    throw std::invalid_argument("Worker pool durations must not be negative");
+  }
+
+  m_pool_policy = policy;
+}
+
 /**
  * @brief Configure the maximum backlog of queued packets.
  *
@@ -443,211 +698,755 @@ void udp_server::set_packet_timeout(const std::chrono::milliseconds &timeout)
 }
 
 /**
- * @brief Access the configured server socket.
+ * @brief Configure how many datagrams the receiver collects per system call.
  *
- * @return Reference to the listening `udp_socket`.
- * @throws std::runtime_error If no socket has been configured.
+ * With a size greater than one the receiver thread uses
+ * udp_socket::receive_batch() to drain up to @p size datagrams per wake-up
+ * into pre-allocated buffers and queues them under a single lock. Workers
+ * likewise take up to @p size queued packets at once and pass them to
+ * udp_handler::handle_batch().
+ *
+ * @param size Datagrams per receive call (0 selects DEFAULT_RECEIVE_BATCH_SIZE,
+ *             values above MAX_RECEIVE_BATCH_SIZE are clamped).
+ * @throws std::runtime_error If the server is already running.
  */
-const udp_socket &udp_server::server_socket() const
+void udp_server::set_receive_batch_size(std::size_t size)
 {
-  if (!m_has_socket)
+  if (m_running.load())
   {
-    throw std::runtime_error("No server socket is set");
+    throw std::runtime_error(
+        "Cannot set receive batch size while server is running");
   }
-  return m_server_socket;
+
+  m_receive_batch_size = size == 0 ? DEFAULT_RECEIVE_BATCH_SIZE
+                                   : std::min(size, MAX_RECEIVE_BATCH_SIZE);
 }
 
 /**
- * @brief Report the number of worker threads currently running.
+ * @brief Configure how many factory-built handlers each worker reuses.
  *
- * @return Worker thread count.
+ * With a handler factory, every worker keeps up to this many handlers and
+ * hands a packet to the first one whose can_handle_address() accepts the
+ * sender, so handlers are built once per worker rather than once per
+ * packet and their statistics accumulate. Handlers reused this way see
+ * packets from one worker at a time but must not assume a single sender
+ * unless can_handle_address() enforces it. Shared handlers are unaffected.
+ *
+ * @param size Handlers kept per worker (0 builds one per packet).
+ * @throws std::runtime_error If the server is already running.
  */
-std::size_t udp_server::thread_count() const
+void udp_server::set_handler_cache_size(std::size_t size)
 {
-  std::lock_guard<std::mutex> lock(m_threads_mutex);
-  return m_worker_threads.size();
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot set handler cache size while server is running");
+  }
+
+  m_handler_cache_size = size;
 }
 
 /**
- * @brief Total number of packets received since the server started.
+ * @brief Set the callback that configures each server thread as it starts.
+ *
+ * Receiver and worker threads (flow workers included) call
+ * @p configurator before doing any work and apply the returned
+ * thread_config. It is applied after any pinning requested through
+ * set_receiver_shards() or set_busy_poll(), so its CPU set wins. A config
+ * that cannot be applied is reported through handle_exception() and the
+ * thread runs on unconfigured.
+ *
+ * @param configurator Callback run on each new thread; empty disables.
+ * @throws std::runtime_error If the server is already running.
  */
-std::uint64_t udp_server::total_packets() const
+void udp_server::set_thread_configurator(thread_configurator configurator)
 {
-  return m_total_packets.load();
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot set thread configurator while server is running");
+  }
+
+  m_thread_configurator = std::move(configurator);
 }
 
 /**
- * @brief Total number of packets processed successfully.
+ * @brief Configure how many packet buffers are kept for reuse.
+ *
+ * Packets are taken from the pool when a datagram is queued and returned
+ * once the handler has finished, so steady-state receive performs no heap
+ * allocation. Each pooled buffer retains up to the configured packet
+ * buffer size of capacity.
+ *
+ * @param size Maximum number of idle packets retained (0 disables pooling).
+ * @throws std::runtime_error If the server is already running.
  */
-std::uint64_t udp_server::processed_packets() const
+void udp_server::set_packet_pool_size(std::size_t size)
 {
-  return m_processed_packets.load();
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot set packet pool size while server is running");
+  }
+
+  m_packet_pool_size = size;
+
+  std::lock_guard<std::mutex> lock(m_pool_mutex);
+  if (m_packet_pool.size() > m_packet_pool_size)
+  {
+    m_packet_pool.resize(m_packet_pool_size);
+  }
 }
 
 /**
- * @brief Total number of packets dropped (queue overflow, timeout, etc.).
+ * @brief Allocate new packets from an object pool instead of the heap.
+ *
+ * Applies to packets the recycling pool (set_packet_pool_size()) cannot
+ * supply: all of them when recycling is disabled, and those of bursts
+ * beyond the recycled count otherwise. Blocks are freed back to the pool
+ * from the worker threads. The pool may be shared by several servers.
+ *
+ * @param pool Pool to allocate from; nullptr allocates on the heap again.
+ * @throws std::runtime_error If the server is already running.
  */
-std::uint64_t udp_server::dropped_packets() const
+void udp_server::set_packet_allocator(std::shared_ptr<packet_pool> pool)
 {
-  return m_dropped_packets.load();
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot set packet allocator while server is running");
+  }
+
+  // Recycled packets may come from the previous pool; free them while it is alive
+  std::lock_guard<std::mutex> lock(m_pool_mutex);
+  m_packet_pool.clear();
+  m_packet_allocator = std::move(pool);
 }
 
 /**
- * @brief Number of packets waiting in the processing queue.
+ * @brief Hand packets to workers through a lock-free ring instead of the
+ * mutex-protected queue.
  *
- * @return Current queue depth.
+ * The ring holds max_queued packets (rounded up to a power of two); excess
+ * packets are dropped and counted exactly as in the default mode. Idle
+ * workers retry the ring @p spin_count times before parking, which trades
+ * CPU for lower wake-up latency. Queued packet expiry is then enforced when
+ * a worker dequeues the packet rather than by sweeping the queue.
+ *
+ * @param enabled True to use the lock-free ring.
+ * @param spin_count Pop attempts before an idle worker parks (0 parks at once).
+ * @throws std::runtime_error If the server is already running.
  */
-std::size_t udp_server::queued_packets() const
+void udp_server::set_lock_free_queue(bool enabled, std::size_t spin_count)
 {
-  std::lock_guard<std::mutex> lock(m_queue_mutex);
-  return m_packet_queue.size();
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot change queue mode while server is running");
+  }
+
+  m_use_lock_free_queue = enabled;
+  m_queue_spin_count    = spin_count;
 }
 
 /**
- * @brief Duration the server has been running.
+ * @brief Dispatch each flow to a fixed worker so its packets stay in order.
  *
- * @return Elapsed time since `start()`, or zero if not running.
+ * On start() the server runs @p workers worker threads, each draining its own
+ * lock-free ring, and routes every packet by its flow key modulo the worker
+ * count. All packets of one flow are therefore handled sequentially on the
+ * same thread, so handlers can keep per-flow state without locking. The
+ * default key hashes the sender's address and port; @p key_extractor can
+ * instead derive it from the payload, e.g. an instrument or session id.
+ *
+ * The pool is fixed: set_max_threads(), set_worker_pool() and
+ * set_lock_free_queue() do not apply while flow affinity is enabled.
+ * max_queued is split evenly across the rings. A key extractor that throws
+ * drops the packet and reports the exception via handle_exception().
+ *
+ * @param workers Number of flow workers (0 restores the shared queue).
+ * @param key_extractor Flow key of a packet (nullptr hashes the sender).
+ * @throws std::runtime_error If the server is already running.
  */
-std::chrono::steady_clock::duration udp_server::uptime() const
+void udp_server::set_flow_affinity(std::size_t workers,
+                                   FlowKeyExtractor key_extractor)
 {
-  if (!m_running.load())
+  if (m_running.load())
   {
-    return std::chrono::steady_clock::duration::zero();
+    throw std::runtime_error(
+        "Cannot change flow affinity while server is running");
   }
-  return std::chrono::steady_clock::now() - m_start_time;
+
+  m_flow_workers = workers;
+  m_flow_key     = std::move(key_extractor);
 }
 
 /**
- * @brief Default exception handler for server operations.
+ * @brief Number of flow-affine workers (0 when packets share one queue).
+ */
+std::size_t udp_server::flow_workers() const { return m_flow_workers; }
+
+/**
+ * @brief Check whether the lock-free handoff ring is enabled.
+ */
+bool udp_server::lock_free_queue() const { return m_use_lock_free_queue; }
+
+/**
+ * @brief Spread reception across several sockets sharing the server port.
  *
- * @param ex Exception encountered.
- * @param context Label describing where the exception was raised.
+ * On start() the server opens @p shards - 1 additional sockets bound to the
+ * server socket's address with SO_REUSEPORT, and runs one receiver thread
+ * per socket so the kernel distributes flows across them. The server socket
+ * itself must have been bound with reuse_port enabled, otherwise start()
+ * throws std::logic_error.
  *
- * The base implementation is intentionally quiet; override to log or alert.
+ * @param shards Number of receiving sockets (0 selects DEFAULT_RECEIVER_SHARDS).
+ * @param pin_to_cpus Pin receiver thread i to CPU i (Linux only).
+ * @throws std::runtime_error If the server is already running.
  */
-void udp_server::handle_exception(const std::exception &ex,
-                                  const std::string &context) noexcept
+void udp_server::set_receiver_shards(std::size_t shards, bool pin_to_cpus)
 {
-  // Default implementation: In production, this would log the exception
-  // For now, we just continue operation
-  // LOG_ERROR("udp_server exception in " << context << ": " << ex.what());
-  (void)ex;      // Avoid unused parameter warning
-  (void)context; // Avoid unused parameter warning
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot set receiver shards while server is running");
+  }
+
+  m_receiver_shards = shards == 0 ? DEFAULT_RECEIVER_SHARDS : shards;
+  m_pin_receivers   = pin_to_cpus;
 }
 
 /**
- * @brief Hook invoked before worker threads are launched.
+ * @brief Number of receiving sockets (and receiver threads) used.
+ */
+std::size_t udp_server::receiver_shards() const { return m_receiver_shards; }
+
+/**
+ * @brief Receive from an additional, independently bound socket.
  *
- * Override to perform initialisation tasks. The base implementation is a no-op.
+ * Datagrams from @p socket enter the same queues (and flow routing) as
+ * those from the server socket, on a receiver thread of their own. Use it
+ * to serve several ports or multicast groups with one worker pool, e.g.
+ * the A and B lines of a redundant feed. The socket is closed by stop().
+ *
+ * @param socket Bound socket.
+ * @throws std::invalid_argument If the socket is closed.
+ * @throws std::runtime_error If the server is already running.
  */
-void udp_server::on_server_starting()
+void udp_server::add_receive_socket(udp_socket socket)
 {
-  // Default implementation does nothing
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot add receive sockets while server is running");
+  }
+  if (socket.is_closed())
+  {
+    throw std::invalid_argument("Receive socket must be open");
+  }
+  m_extra_sockets.push_back(std::move(socket));
 }
 
 /**
- * @brief Hook invoked after a stop has been requested.
+ * @brief Number of sockets added with add_receive_socket().
+ */
+std::size_t udp_server::receive_sockets() const { return m_extra_sockets.size(); }
+
+/**
+ * @brief Spin on the receive sockets instead of sleeping in poll().
  *
- * Override to perform cleanup tasks. The base implementation is a no-op.
+ * With a non-zero @p spin_budget each receiver thread polls its socket
+ * without blocking for up to that long after the last datagram before it
+ * falls back to the normal blocking wait, and SO_BUSY_POLL is requested on
+ * the socket so the kernel spins on the NIC queue too (best effort: without
+ * CAP_NET_ADMIN the failure is reported through handle_exception() and only
+ * the user-space spin remains). A receiver thread burns a full core while
+ * traffic flows, so pair this with @p cpu to give it a dedicated one.
+ *
+ * @param spin_budget Non-blocking poll time before blocking; zero disables.
+ * @param cpu First CPU to pin receiver threads to (shard i runs on
+ *            cpu + i; Linux only), or -1 to leave placement to the scheduler
+ *            or to set_receiver_shards().
+ * @throws std::invalid_argument If spin_budget is negative.
+ * @throws std::runtime_error If the server is already running.
  */
-void udp_server::on_server_stopping()
+void udp_server::set_busy_poll(const std::chrono::microseconds &spin_budget,
+                               int cpu)
 {
-  // Default implementation does nothing
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot change busy polling while server is running");
+  }
+  if (spin_budget.count() < 0)
+  {
+    throw std::invalid_argument("Busy poll spin budget cannot be negative");
+  }
+
+  m_busy_poll_budget = spin_budget;
+  m_busy_poll_cpu    = cpu;
 }
 
 /**
- * @brief Main loop for the receiver thread.
+ * @brief Current busy-poll spin budget (zero when disabled).
+ */
+std::chrono::microseconds udp_server::busy_poll() const
+{
+  return m_busy_poll_budget;
+}
+
+/**
+ * @brief Record per-packet queue wait and handler service time.
  *
- * Accepts datagrams, enqueues them, and triggers worker wake-ups while
- * honouring stop requests and queue limits.
+ * When enabled, each packet a handler processes adds two samples: the time
+ * from its copy into the queue (PacketData::received_time) to worker pickup,
+ * and the time spent in the handler. Read them with queue_latency() and
+ * service_latency(), or connect to onLatencyRecorded. Tracking costs two
+ * clock reads and a few relaxed atomic adds per packet.
+ *
+ * @param enabled True to record latencies.
+ * @throws std::runtime_error If the server is already running.
  */
-void udp_server::receiver_thread_proc()
+void udp_server::set_latency_tracking(bool enabled)
 {
-  std::vector<std::uint8_t> buffer(m_packet_buffer_size);
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot change latency tracking while server is running");
+  }
 
-  while (!m_should_stop.load())
+  if (enabled && !m_queue_latency)
   {
-    try
-    {
-      socket_address sender_address;
+    m_queue_latency   = std::make_unique<latency_histogram>();
+    m_service_latency = std::make_unique<latency_histogram>();
+  }
+  m_track_latency = enabled;
+}
 
-      // Poll for readability so we can check stop condition without
-      // mutating socket timeouts configured by the caller.
-      if (!m_server_socket.poll_read(std::chrono::milliseconds(1000)))
-      {
-        continue;
-      }
+/**
+ * @brief Check whether latency tracking is enabled.
+ */
+bool udp_server::latency_tracking() const { return m_track_latency; }
 
-      int received = m_server_socket.receive_from(
-          buffer.data(), static_cast<int>(buffer.size()), sender_address);
+/**
+ * @brief Aggregate the packet counter signals instead of emitting per packet.
+ *
+ * By default onTotalPacketsChanged, onProcessedPacketsChanged,
+ * onDroppedPacketsChanged and onQueuedPacketsChanged fire for every packet
+ * or batch. With a non-zero interval they are emitted at most once per
+ * interval, from a receiver thread, and only when the value changed since
+ * the previous publication; a final publication happens in stop(). The
+ * per-packet path then costs nothing beyond the counter updates.
+ * onPacketReceived and onLatencyRecorded are not affected.
+ *
+ * @param interval Publication interval; 0 restores per-packet emission.
+ * @throws std::invalid_argument If interval is negative.
+ * @throws std::runtime_error If the server is already running.
+ */
+void udp_server::set_statistics_interval(const std::chrono::milliseconds &interval)
+{
+  if (m_running.load())
+  {
+    throw std::runtime_error(
+        "Cannot change statistics interval while server is running");
+  }
+  if (interval.count() < 0)
+  {
+    throw std::invalid_argument("Statistics interval cannot be negative");
+  }
+  m_statistics_interval = interval;
+}
 
-      if (m_should_stop.load())
-      {
-        break;
-      }
+/**
+ * @brief Interval at which counter signals are aggregated (0 = per packet).
+ */
+std::chrono::milliseconds udp_server::statistics_interval() const
+{
+  return m_statistics_interval;
+}
 
-      if (received > 0)
-      {
-        // Increment total_packets for ALL received packets (including dropped ones)
-        auto total_count = m_total_packets.fetch_add(1) + 1;
+/**
+ * @brief Current worker pool sizing policy.
+ */
+const worker_pool_policy &udp_server::worker_pool() const
+{
+  return m_pool_policy;
+}
 
-        // Emit packet received signal (outside any locks)
-        if (onPacketReceived.slot_count() > 0) {
-          onPacketReceived.emit(buffer.data(), static_cast<std::size_t>(received), sender_address);
-        }
-        if (onTotalPacketsChanged.slot_count() > 0) {
-          onTotalPacketsChanged.emit(total_count);
-        }
+/**
+ * @brief Number of datagrams the receiver collects per system call.
+ */
+std::size_t udp_server::receive_batch_size() const
+{
+  return m_receive_batch_size;
+}
 
-        // Create packet data
-        auto packet_data = std::make_unique<PacketData>(
-            buffer.data(), static_cast<std::size_t>(received), sender_address);
+/**
+ * @brief Factory-built handlers each worker keeps for reuse.
+ */
+std::size_t udp_server::handler_cache_size() const
+{
+  return m_handler_cache_size;
+}
 
-        // Queue packet for processing - signals emitted outside lock to avoid deadlock
-        bool packet_dropped = false;
-        std::size_t queue_size = 0;
-        {
-          std::lock_guard<std::mutex> lock(m_queue_mutex);
-          if (m_packet_queue.size() >= m_max_queued)
-          {
-            // Queue is full, drop packet
-            m_dropped_packets.fetch_add(1);
-            packet_dropped = true;
-          }
-          else
-          {
-            m_packet_queue.push(std::move(packet_data));
-            queue_size = m_packet_queue.size();
-          }
-        }
+/**
+ * @brief Number of handlers the factory has built since construction.
+ */
+std::uint64_t udp_server::handler_instances() const
+{
+  return m_handler_instances.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Maximum number of idle packets retained for reuse.
+ */
+std::size_t udp_server::packet_pool_size() const { return m_packet_pool_size; }
+
+/**
+ * @brief Pool new packets are allocated from, or nullptr for the heap.
+ */
+std::shared_ptr<udp_server::packet_pool> udp_server::packet_allocator() const
+{
+  return m_packet_allocator;
+}
+
+/**
+ * @brief Number of idle packets currently held in the pool.
+ */
+std::size_t udp_server::pooled_packets() const
+{
+  std::lock_guard<std::mutex> lock(m_pool_mutex);
+  return m_packet_pool.size();
+}
+
+/**
+ * @brief Access the configured server socket.
+ *
+ * @return Reference to the listening `udp_socket`.
+ * @throws std::runtime_error If no socket has been configured.
+ */
+const udp_socket &udp_server::server_socket() const
+{
+  if (!m_has_socket)
+  {
+    throw std::runtime_error("No server socket is set");
+  }
+  return m_server_socket;
+}
+
+/**
+ * @brief Report the number of worker threads currently running.
+ *
+ * @return Worker thread count.
+ */
+std::size_t udp_server::thread_count() const
+{
+  std::lock_guard<std::mutex> lock(m_threads_mutex);
+  return m_worker_threads.size();
+}
+
+/**
+ * @brief Total number of packets received since the server started.
+ */
+std::uint64_t udp_server::total_packets() const
+{
+  return m_packets.value(TOTAL_PACKETS);
+}
+
+/**
+ * @brief Total number of packets processed successfully.
+ */
+std::uint64_t udp_server::processed_packets() const
+{
+  return m_packets.value(PROCESSED_PACKETS);
+}
+
+/**
+ * @brief Total number of packets dropped (queue overflow, timeout, etc.).
+ */
+std::uint64_t udp_server::dropped_packets() const
+{
+  return m_packets.value(DROPPED_PACKETS);
+}
+
+/**
+ * @brief Number of packets waiting in the processing queue.
+ *
+ * @return Current queue depth.
+ */
+std::size_t udp_server::queued_packets() const
+{
+  if (!m_flow_queues.empty())
+  {
+    std::size_t queued = 0;
+    for (const auto &queue : m_flow_queues)
+    {
+      queued += queue->size_approx();
+    }
+    return queued;
+  }
+
+  if (m_lock_free_queue)
+  {
+    return m_lock_free_queue->size_approx();
+  }
+
+  std::lock_guard<std::mutex> lock(m_queue_mutex);
+  return m_packet_queue.size();
+}
+
+/**
+ * @brief Distribution of queue wait (enqueue to worker pickup) times.
+ *
+ * @return Snapshot of recorded samples; empty unless latency tracking is on.
+ */
+latency_snapshot udp_server::queue_latency() const
+{
+  return m_queue_latency ? m_queue_latency->snapshot() : latency_snapshot();
+}
+
+/**
+ * @brief Distribution of handler service times.
+ *
+ * @return Snapshot of recorded samples; empty unless latency tracking is on.
+ */
+latency_snapshot udp_server::service_latency() const
+{
+  return m_service_latency ? m_service_latency->snapshot()
+                           : latency_snapshot();
+}
+
+/**
+ * @brief Discard recorded queue wait and service time samples.
+ */
+void udp_server::reset_latency_statistics()
+{
+  if (m_queue_latency)
+  {
+    m_queue_latency->reset();
+    m_service_latency->reset();
+  }
+}
+
+/**
+ * @brief Duration the server has been running.
+ *
+ * @return Elapsed time since `start()`, or zero if not running.
+ */
+std::chrono::steady_clock::duration udp_server::uptime() const
+{
+  if (!m_running.load())
+  {
+    return std::chrono::steady_clock::duration::zero();
+  }
+  return std::chrono::steady_clock::now() - m_start_time;
+}
+
+/**
+ * @brief Publish packet counters, queue depth and latencies in a metrics
+ * registry.
+ *
+ * Every metric is read from the existing statistics when the registry is
+ * exported; the receive and worker paths do no extra work. The latency
+ * summaries stay empty unless latency tracking is enabled.
+ *
+ * @param registry Registry to add the metrics to
+ * @param prefix Start of every metric name, e.g. "md_server"
+ * @return Handle that unregisters the metrics; destroy it before the server
+ * @throws std::invalid_argument if a name is invalid or already registered
+ */
+metrics_registration udp_server::register_metrics(metrics_registry& registry,
+                                                  const std::string& prefix) const
+{
+  metrics_registration registration = registry.add_counter(
+      prefix + "_packets_received_total", "Packets received",
+      [this]() { return total_packets(); });
+  registration.append(registry.add_counter(
+      prefix + "_packets_processed_total", "Packets handed to a handler",
+      [this]() { return processed_packets(); }));
+  registration.append(registry.add_counter(
+      prefix + "_packets_dropped_total", "Packets dropped (queue full or expired)",
+      [this]() { return dropped_packets(); }));
+  registration.append(registry.add_gauge(
+      prefix + "_queued_packets", "Packets waiting for a worker",
+      [this]() { return static_cast<std::int64_t>(queued_packets()); }));
+  registration.append(registry.add_histogram(
+      prefix + "_queue_latency_seconds", "Time packets waited for a worker",
+      [this]() { return queue_latency(); }));
+  registration.append(registry.add_histogram(
+      prefix + "_service_latency_seconds", "Time handlers took per packet",
+      [this]() { return service_latency(); }));
+  return registration;
+}
+
+/**
+ * @brief Default exception handler for server operations.
+ *
+ * @param ex Exception encountered.
+ * @param context Label describing where the exception was raised.
+ *
+ * The base implementation is intentionally quiet; override to log or alert.
+ */
+void udp_server::handle_exception(const std::exception &ex,
+                                  const std::string &context) noexcept
+{
+  // Default implementation: In production, this would log the exception
+  // For now, we just continue operation
+  // LOG_ERROR("udp_server exception in " << context << ": " << ex.what());
+  (void)ex;      // Avoid unused parameter warning
+  (void)context; // Avoid unused parameter warning
+}
 
-        // Emit signals outside the lock to prevent re-entrancy deadlock
-        if (packet_dropped)
+/**
+ * @brief Hook invoked before worker threads are launched.
+ *
+ * Override to perform initialisation tasks. The base implementation is a no-op.
+ */
+void udp_server::on_server_starting()
+{
+  // Default implementation does nothing
+}
+
+/**
+ * @brief Hook invoked after a stop has been requested.
+ *
+ * Override to perform cleanup tasks. The base implementation is a no-op.
+ */
+void udp_server::on_server_stopping()
+{
+  // Default implementation does nothing
+}
+
+/**
+ * @brief Main loop for the receiver thread.
+ *
+ * Accepts datagrams, enqueues them, and triggers worker wake-ups while
+ * honouring stop requests and queue limits. When a receive batch size above
+ * one is configured, each wake-up drains up to that many datagrams. In
+ * busy-poll mode the thread is pinned (if requested) and spins on the socket
+ * before blocking; see set_busy_poll().
+ *
+ * @param socket Socket served by this thread (server socket or a shard).
+ * @param shard Index of the socket, used for optional CPU pinning.
+ */
+void udp_server::receiver_thread_proc(udp_socket &socket, std::size_t shard)
+{
+  if (m_busy_poll_cpu >= 0)
+  {
+    pin_current_thread(static_cast<std::size_t>(m_busy_poll_cpu) + shard);
+  }
+  else if (m_pin_receivers)
+  {
+    pin_current_thread(shard);
+  }
+  configure_thread(thread_role::receiver, shard);
+
+  if (m_busy_poll_budget.count() > 0)
+  {
+    try
+    {
+      socket.set_busy_poll(std::min(m_busy_poll_budget, SOCKET_BUSY_POLL));
+    }
+    catch (const std::system_error &ex)
+    {
+      handle_exception(ex, "busy_poll");
+    }
+  }
+
+  const std::size_t batch_size = m_receive_batch_size;
+
+  std::vector<std::vector<std::uint8_t>> buffers(
+      batch_size, std::vector<std::uint8_t>(m_packet_buffer_size));
+  std::vector<udp_receive_entry> entries(batch_size);
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    entries[i].buffer   = buffers[i].data();
+    entries[i].capacity = buffers[i].size();
+  }
+
+  std::vector<packet_ptr> batch;
+  batch.reserve(batch_size);
+
+  const bool per_packet_statistics = m_statistics_interval.count() == 0;
+
+  while (!m_should_stop.load())
+  {
+    try
+    {
+      if (!per_packet_statistics)
+      {
+        publish_statistics();
+      }
+
+      // Poll for readability so we can check stop condition without
+      // mutating socket timeouts configured by the caller.
+      if (!wait_readable(socket))
+      {
+        continue;
+      }
+
+      int received = 0;
+      if (batch_size > 1)
+      {
+        received = socket.receive_batch(entries.data(), batch_size);
+      }
+      else
+      {
+        int bytes = socket.receive_from(
+            entries[0].buffer, static_cast<int>(entries[0].capacity),
+            entries[0].sender, entries[0].timestamp);
+        entries[0].length = bytes > 0 ? static_cast<std::size_t>(bytes) : 0;
+        received          = 1;
+      }
+
+      if (m_should_stop.load())
+      {
+        break;
+      }
+
+      for (int i = 0; i < received; ++i)
+      {
+        const udp_receive_entry &entry = entries[static_cast<std::size_t>(i)];
+        if (entry.length == 0)
         {
-          if (onDroppedPacketsChanged.slot_count() > 0) {
-            onDroppedPacketsChanged.emit(m_dropped_packets.load());
-          }
           continue;
         }
 
-        if (onQueuedPacketsChanged.slot_count() > 0) {
-          onQueuedPacketsChanged.emit(queue_size);
+        // Increment total_packets for ALL received packets (including dropped ones)
+        m_packets.add(TOTAL_PACKETS);
+
+        // Emit packet received signal (outside any locks)
+        if (onPacketReceived.has_slots()) {
+          onPacketReceived.emit(entry.buffer, entry.length, entry.sender);
+        }
+        if (onTimestampedPacketReceived.has_slots()) {
+          onTimestampedPacketReceived.emit(entry.buffer, entry.length,
+                                           entry.sender, entry.timestamp);
+        }
+        if (per_packet_statistics && onTotalPacketsChanged.has_slots()) {
+          onTotalPacketsChanged.emit(m_packets.value(TOTAL_PACKETS));
         }
 
-        // Notify worker threads and possibly add more threads
-        m_queue_condition.notify_one();
-        add_worker_thread_if_needed();
+        batch.push_back(
+            acquire_packet(entry.buffer, entry.length, entry.sender,
+                           entry.timestamp));
+      }
+
+      if (!batch.empty())
+      {
+        enqueue_packets(batch);
       }
     }
     catch (const std::system_error &ex)
     {
+      batch.clear();
       if (ex.code() == std::make_error_code(std::errc::timed_out))
       {
         // Timeout during receive is normal, continue loop
         continue;
       }
       handle_exception(ex, "receiver_thread");
-      if (m_server_socket.is_closed())
+      if (socket.is_closed())
       {
         break;
       }
@@ -655,29 +1454,310 @@ void udp_server::receiver_thread_proc()
     }
     catch (const std::exception &ex)
     {
-      handle_exception(ex, "receiver_thread");
-      if (m_server_socket.is_closed())
-      {
-        break; // Server socket is closed, stop receiving
-      }
+      batch.clear();
+      handle_exception(ex, "receiver_thread");
+      if (socket.is_closed())
+      {
+        break; // Server socket is closed, stop receiving
+      }
+    }
+  }
+}
+
+/**
+ * @brief Wait until a receiver socket has a datagram queued.
+ *
+ * In busy-poll mode the socket is first polled without blocking for the
+ * configured spin budget; after that (or when busy polling is off) the
+ * thread blocks for up to a second so stop requests are still noticed.
+ *
+ * @param socket Socket served by the calling receiver thread.
+ * @return True if the socket is readable.
+ */
+bool udp_server::wait_readable(udp_socket &socket)
+{
+  if (m_busy_poll_budget.count() > 0)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + m_busy_poll_budget;
+    do
+    {
+      if (socket.poll_read(std::chrono::milliseconds(0)))
+      {
+        return true;
+      }
+    } while (!m_should_stop.load(std::memory_order_relaxed) &&
+             std::chrono::steady_clock::now() < deadline);
+  }
+
+  // Wake up often enough to publish aggregated statistics while idle
+  auto timeout = std::chrono::milliseconds(1000);
+  if (m_statistics_interval.count() > 0)
+  {
+    timeout = std::min(timeout, m_statistics_interval);
+  }
+  return socket.poll_read(timeout);
+}
+
+/**
+ * @brief Emit the counter signals whose value changed, if an interval is due.
+ *
+ * Several receiver shards may call this concurrently; the one that advances
+ * m_next_statistics publishes, the others return.
+ *
+ * @param force Publish now even if the interval has not elapsed.
+ */
+void udp_server::publish_statistics(bool force)
+{
+  if (m_statistics_interval.count() == 0)
+  {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  std::int64_t due = m_next_statistics.load(std::memory_order_relaxed);
+  if (!force && now.time_since_epoch().count() < due)
+  {
+    return;
+  }
+  const std::int64_t next = (now + m_statistics_interval).time_since_epoch().count();
+  if (!m_next_statistics.compare_exchange_strong(due, next, std::memory_order_acq_rel))
+  {
+    return;
+  }
+
+  const std::uint64_t total = m_packets.value(TOTAL_PACKETS);
+  if (total != m_published_total)
+  {
+    m_published_total = total;
+    if (onTotalPacketsChanged.has_slots()) {
+      onTotalPacketsChanged.emit(total);
+    }
+  }
+  const std::uint64_t processed = m_packets.value(PROCESSED_PACKETS);
+  if (processed != m_published_processed)
+  {
+    m_published_processed = processed;
+    if (onProcessedPacketsChanged.has_slots()) {
+      onProcessedPacketsChanged.emit(processed);
+    }
+  }
+  const std::uint64_t dropped = m_packets.value(DROPPED_PACKETS);
+  if (dropped != m_published_dropped)
+  {
+    m_published_dropped = dropped;
+    if (onDroppedPacketsChanged.has_slots()) {
+      onDroppedPacketsChanged.emit(dropped);
+    }
+  }
+  const std::size_t queued = queued_packets();
+  if (queued != m_published_queued)
+  {
+    m_published_queued = queued;
+    if (onQueuedPacketsChanged.has_slots()) {
+      onQueuedPacketsChanged.emit(queued);
+    }
+  }
+}
+
+/**
+ * @brief Queue a batch of received packets and wake workers.
+ *
+ * The whole batch is pushed under one acquisition of the queue mutex;
+ * packets that do not fit within max_queued are dropped. The batch is
+ * left empty on return.
+ *
+ * @param batch Packets collected by the receiver thread.
+ */
+void udp_server::enqueue_packets(std::vector<packet_ptr> &batch)
+{
+  if (!m_flow_queues.empty())
+  {
+    enqueue_flow_packets(batch);
+    return;
+  }
+
+  // Queue packets for processing - signals emitted outside lock to avoid deadlock
+  std::size_t queued     = 0;
+  std::size_t dropped    = 0;
+  std::size_t queue_size = 0;
+  if (m_lock_free_queue)
+  {
+    for (auto &packet_data : batch)
+    {
+      if (m_lock_free_queue->size_approx() >= m_max_queued ||
+          !m_lock_free_queue->try_push(std::move(packet_data)))
+      {
+        ++dropped;
+      }
+      else
+      {
+        ++queued;
+      }
+    }
+    if (dropped > 0)
+    {
+      m_packets.add(DROPPED_PACKETS, dropped);
+    }
+    queue_size = m_lock_free_queue->size_approx();
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    for (auto &packet_data : batch)
+    {
+      if (m_packet_queue.size() >= m_max_queued)
+      {
+        // Queue is full, drop packet (recycled below, outside the lock)
+        ++dropped;
+      }
+      else
+      {
+        m_packet_queue.push(std::move(packet_data));
+        ++queued;
+      }
+    }
+    if (dropped > 0)
+    {
+      m_packets.add(DROPPED_PACKETS, dropped);
+    }
+    queue_size = m_packet_queue.size();
+  }
+  for (auto &packet_data : batch)
+  {
+    release_packet(std::move(packet_data));
+  }
+  batch.clear();
+
+  // Emit signals outside the lock to prevent re-entrancy deadlock
+  if (dropped > 0)
+  {
+    if (m_statistics_interval.count() == 0 && onDroppedPacketsChanged.has_slots()) {
+      onDroppedPacketsChanged.emit(m_packets.value(DROPPED_PACKETS));
+    }
+  }
+
+  if (queued == 0)
+  {
+    return;
+  }
+
+  if (m_statistics_interval.count() == 0 && onQueuedPacketsChanged.has_slots()) {
+    onQueuedPacketsChanged.emit(queue_size);
+  }
+
+  // Notify worker threads (the lock-free ring wakes parked workers itself)
+  // and possibly add more threads
+  if (!m_lock_free_queue)
+  {
+    if (queued == 1)
+    {
+      m_queue_condition.notify_one();
+    }
+    else
+    {
+      m_queue_condition.notify_all();
+    }
+  }
+  add_worker_thread_if_needed();
+}
+
+/**
+ * @brief Route a batch of packets to the rings of their flow workers.
+ *
+ * @param batch Packets to queue; emptied on return.
+ */
+void udp_server::enqueue_flow_packets(
+    std::vector<packet_ptr> &batch)
+{
+  const std::size_t workers = m_flow_queues.size();
+  const std::size_t limit   = (m_max_queued + workers - 1) / workers;
+  std::size_t queued  = 0;
+  std::size_t dropped = 0;
+
+  for (auto &packet_data : batch)
+  {
+    std::uint64_t key = 0;
+    try
+    {
+      key = m_flow_key ? m_flow_key(*packet_data)
+                       : packet_data->sender_address.hash();
+    }
+    catch (const std::exception &ex)
+    {
+      handle_exception(ex, "flow_key");
+      ++dropped;
+      continue;
+    }
+
+    auto &queue = *m_flow_queues[key % workers];
+    if (queue.size_approx() >= limit ||
+        !queue.try_push(std::move(packet_data)))
+    {
+      ++dropped;
+    }
+    else
+    {
+      ++queued;
+    }
+  }
+  if (dropped > 0)
+  {
+    m_packets.add(DROPPED_PACKETS, dropped);
+  }
+  for (auto &packet_data : batch)
+  {
+    release_packet(std::move(packet_data));
+  }
+  batch.clear();
+
+  // Each ring wakes its parked worker itself
+  if (dropped > 0)
+  {
+    if (m_statistics_interval.count() == 0 && onDroppedPacketsChanged.has_slots()) {
+      onDroppedPacketsChanged.emit(m_packets.value(DROPPED_PACKETS));
+    }
+  }
+  if (queued > 0)
+  {
+    if (m_statistics_interval.count() == 0 && onQueuedPacketsChanged.has_slots()) {
+      onQueuedPacketsChanged.emit(queued_packets());
     }
   }
 }
 
 /**
  * @brief Worker loop that drains the packet queue.
+ *
+ * A worker idle for the policy's idle_timeout retires while the pool is
+ * above its minimum size.
  */
 void udp_server::worker_thread_proc()
 {
+  configure_thread(thread_role::worker, m_worker_serial.fetch_add(1));
+  const auto idle_timeout = m_pool_policy.idle_timeout;
+  const auto wait_timeout =
+      idle_timeout.count() > 0
+          ? std::min<std::chrono::milliseconds>(idle_timeout, std::chrono::seconds(1))
+          : std::chrono::milliseconds(std::chrono::seconds(1));
+  auto idle_since = std::chrono::steady_clock::now();
+  const std::size_t batch_limit = m_receive_batch_size;
+  worker_state state;
+
   while (!m_should_stop.load())
   {
-    std::unique_ptr<PacketData> packet_data;
+    packet_ptr packet_data;
 
     // Wait for packet to process
+    if (m_lock_free_queue)
+    {
+      m_lock_free_queue->wait_pop(packet_data, wait_timeout,
+                                  [this] { return m_should_stop.load(); });
+    }
+    else
     {
       std::unique_lock<std::mutex> lock(m_queue_mutex);
       m_queue_condition.wait_for(
-          lock, std::chrono::seconds(1),
+          lock, wait_timeout,
           [this] { return !m_packet_queue.empty() || m_should_stop.load(); });
 
       if (m_should_stop.load())
@@ -685,83 +1765,257 @@ void udp_server::worker_thread_proc()
         break;
       }
 
-      if (m_packet_queue.empty())
+      if (!m_packet_queue.empty())
       {
-        continue;
+        packet_data = std::move(m_packet_queue.front());
+        m_packet_queue.pop();
+      }
+
+      // Take the rest of a burst while holding the lock anyway
+      while (packet_data && state.batch.size() + 1 < batch_limit && !m_packet_queue.empty())
+      {
+        state.batch.push_back(std::move(m_packet_queue.front()));
+        m_packet_queue.pop();
+      }
+    }
+
+    if (!packet_data)
+    {
+      if (retire_idle_worker(idle_since))
+      {
+        return;
       }
+      continue;
+    }
 
-      packet_data = std::move(m_packet_queue.front());
-      m_packet_queue.pop();
+    // A packet that sat in the queue too long means the pool is too small
+    const auto threshold = m_pool_policy.queue_wait_threshold;
+    if (threshold.count() > 0 &&
+        std::chrono::steady_clock::now() - packet_data->received_time > threshold)
+    {
+      add_worker_thread_if_needed(true);
     }
 
-    if (packet_data)
+    if (m_lock_free_queue)
     {
-      process_packet(std::move(packet_data));
+      packet_ptr next;
+      while (state.batch.size() + 1 < batch_limit && m_lock_free_queue->try_pop(next))
+      {
+        state.batch.push_back(std::move(next));
+      }
     }
+    process_taken(std::move(packet_data), state);
+    idle_since = std::chrono::steady_clock::now();
 
     // Cleanup expired packets periodically
     cleanup_expired_packets();
   }
 }
 
+/**
+ * @brief Apply the configurator's settings to the calling server thread.
+ *
+ * Failures are reported and otherwise ignored: a thread that cannot be
+ * pinned still serves packets.
+ *
+ * @param role Kind of thread calling.
+ * @param index Number of the thread within its role.
+ */
+void udp_server::configure_thread(thread_role role, std::size_t index) noexcept
+{
+  if (!m_thread_configurator)
+  {
+    return;
+  }
+  try
+  {
+    apply_thread_config(m_thread_configurator(role, index));
+  }
+  catch (const std::exception &ex)
+  {
+    if (onException.slot_count() > 0)
+    {
+      onException.emit(ex, "thread_config");
+    }
+    handle_exception(ex, "thread_config");
+  }
+}
+
+/**
+ * @brief Worker loop that drains one flow-affinity ring.
+ *
+ * @param index Ring owned by this worker.
+ */
+void udp_server::flow_worker_proc(std::size_t index)
+{
+  configure_thread(thread_role::worker, m_worker_serial.fetch_add(1));
+  auto &queue = *m_flow_queues[index];
+  const std::size_t batch_limit = m_receive_batch_size;
+  worker_state state;
+  while (!m_should_stop.load())
+  {
+    packet_ptr packet_data;
+    if (!queue.wait_pop(packet_data, std::chrono::seconds(1),
+                        [this] { return m_should_stop.load(); }))
+    {
+      continue;
+    }
+
+    packet_ptr next;
+    while (state.batch.size() + 1 < batch_limit && queue.try_pop(next))
+    {
+      state.batch.push_back(std::move(next));
+    }
+    process_taken(std::move(packet_data), state);
+  }
+}
+
+/**
+ * @brief Process and recycle the packets a worker has just dequeued.
+ *
+ * @param first Packet the worker waited for.
+ * @param state Worker state; its batch holds any packets taken after
+ * @p first and is left empty.
+ */
+void udp_server::process_taken(packet_ptr first, worker_state &state)
+{
+  if (state.batch.empty())
+  {
+    process_packet(*first, state.handlers);
+    release_packet(std::move(first));
+    return;
+  }
+
+  state.batch.insert(state.batch.begin(), std::move(first));
+  process_batch(state);
+  for (auto &packet : state.batch)
+  {
+    release_packet(std::move(packet));
+  }
+  state.batch.clear();
+}
+
+/**
+ * @brief Find or build the factory handler for a packet.
+ *
+ * The first cached handler whose can_handle_address() accepts the sender
+ * is reused, and the factory only runs on a miss. New handlers are cached
+ * while there is room, otherwise they are returned through @p uncached and
+ * serve the caller's packets alone.
+ *
+ * @param packet_data Packet to route.
+ * @param handlers Handlers owned by the calling worker.
+ * @param uncached Receives a handler that did not fit in the cache.
+ * @return Handler to use, or nullptr if the factory declined the packet.
+ */
+udp_handler *udp_server::select_handler(const PacketData &packet_data,
+                                        handler_cache &handlers,
+                                        std::unique_ptr<udp_handler> &uncached)
+{
+  for (const auto &cached : handlers)
+  {
+    if (cached->can_handle_address(packet_data.sender_address))
+    {
+      return cached.get();
+    }
+  }
+
+  uncached = m_handler_factory(packet_data);
+  if (!uncached)
+  {
+    return nullptr;
+  }
+  m_handler_instances.fetch_add(1, std::memory_order_relaxed);
+  udp_handler *handler = uncached.get();
+  if (handlers.size() < m_handler_cache_size)
+  {
+    handlers.push_back(std::move(uncached));
+  }
+  return handler;
+}
+
 /**
  * @brief Process a single queued packet through a handler.
  *
- * @param packet_data Packet removed from the queue.
+ * Factory-built handlers come from the worker's cache; see select_handler().
+ *
+ * @param packet_data Packet removed from the queue; recycled by the caller.
+ * @param handlers Handlers owned by the calling worker.
  */
-void udp_server::process_packet(std::unique_ptr<PacketData> packet_data)
+void udp_server::process_packet(const PacketData &packet_data, handler_cache &handlers)
 {
+  FB_PROFILE_ZONE("udp_server::process_packet");
+
   try
   {
     // Check if packet has expired
     if (m_packet_timeout.count() > 0)
     {
-      auto age = std::chrono::steady_clock::now() - packet_data->received_time;
+      auto age = std::chrono::steady_clock::now() - packet_data.received_time;
       if (age > m_packet_timeout)
       {
-        m_dropped_packets.fetch_add(1);
+        m_packets.add(DROPPED_PACKETS);
         return;
       }
     }
 
     bool success = false;
+    const bool track_latency = m_track_latency;
+    std::chrono::steady_clock::time_point picked_up;
+    if (track_latency)
+    {
+      picked_up = std::chrono::steady_clock::now();
+    }
 
     // Use shared handler if available, otherwise create new handler
     if (m_shared_handler)
     {
-      success = m_shared_handler->process_packet(packet_data->buffer.data(),
-                                                 packet_data->buffer.size(),
-                                                 packet_data->sender_address);
+      success = m_shared_handler->process_packet(packet_data.buffer.data(),
+                                                 packet_data.buffer.size(),
+                                                 packet_data.sender_address,
+                                                 packet_data.kernel_timestamp);
     }
     else
     {
-      // Create handler for this packet
-      auto handler = m_handler_factory(*packet_data);
+      std::unique_ptr<udp_handler> uncached;
+      udp_handler *handler = select_handler(packet_data, handlers, uncached);
       if (!handler)
       {
         // Factory returned null, skip this packet
-        m_dropped_packets.fetch_add(1);
+        m_packets.add(DROPPED_PACKETS);
         return;
       }
 
       // Process the packet
-      success = handler->process_packet(packet_data->buffer.data(),
-                                        packet_data->buffer.size(),
-                                        packet_data->sender_address);
+      success = handler->process_packet(packet_data.buffer.data(),
+                                        packet_data.buffer.size(),
+                                        packet_data.sender_address,
+                                        packet_data.kernel_timestamp);
+    }
+
+    if (track_latency)
+    {
+      const auto queue_wait   = picked_up - packet_data.received_time;
+      const auto service_time = std::chrono::steady_clock::now() - picked_up;
+      m_queue_latency->record(queue_wait);
+      m_service_latency->record(service_time);
+      if (onLatencyRecorded.has_slots()) {
+        onLatencyRecorded.emit(queue_wait, service_time);
+      }
     }
 
     if (success)
     {
-      auto processed_count = m_processed_packets.fetch_add(1) + 1;
-      if (onProcessedPacketsChanged.slot_count() > 0) {
-        onProcessedPacketsChanged.emit(processed_count);
+      m_packets.add(PROCESSED_PACKETS);
+      if (m_statistics_interval.count() == 0 && onProcessedPacketsChanged.has_slots()) {
+        onProcessedPacketsChanged.emit(m_packets.value(PROCESSED_PACKETS));
       }
     }
     else
     {
-      auto dropped_count = m_dropped_packets.fetch_add(1) + 1;
-      if (onDroppedPacketsChanged.slot_count() > 0) {
-        onDroppedPacketsChanged.emit(dropped_count);
+      m_packets.add(DROPPED_PACKETS);
+      if (m_statistics_interval.count() == 0 && onDroppedPacketsChanged.has_slots()) {
+        onDroppedPacketsChanged.emit(m_packets.value(DROPPED_PACKETS));
       }
     }
   }
@@ -771,9 +2025,121 @@ void udp_server::process_packet(std::unique_ptr<PacketData> packet_data)
       onException.emit(ex, "process_packet");
     }
     handle_exception(ex, "process_packet");
-    auto dropped_count = m_dropped_packets.fetch_add(1) + 1;
-    if (onDroppedPacketsChanged.slot_count() > 0) {
-      onDroppedPacketsChanged.emit(dropped_count);
+    m_packets.add(DROPPED_PACKETS);
+    if (m_statistics_interval.count() == 0 && onDroppedPacketsChanged.has_slots()) {
+      onDroppedPacketsChanged.emit(m_packets.value(DROPPED_PACKETS));
+    }
+  }
+}
+
+/**
+ * @brief Process the packets a worker took from its queue in one go.
+ *
+ * Expired packets are dropped first. The rest are split into runs of
+ * consecutive packets one handler accepts, and each run goes to
+ * udp_handler::handle_batch() in a single call. With latency tracking, each
+ * packet of a run is charged an equal share of the run's service time.
+ *
+ * @param state Calling worker's handlers and batch; the batch is recycled
+ * by the caller.
+ */
+void udp_server::process_batch(worker_state &state)
+{
+  const bool track_latency = m_track_latency;
+  const auto picked_up     = std::chrono::steady_clock::now();
+  std::uint64_t processed  = 0;
+  std::uint64_t dropped    = 0;
+
+  auto &live = state.live;
+  live.clear();
+  for (const auto &packet : state.batch)
+  {
+    if (m_packet_timeout.count() > 0 && picked_up - packet->received_time > m_packet_timeout)
+    {
+      ++dropped;
+      continue;
+    }
+    live.push_back(packet.get());
+  }
+
+  std::size_t begin = 0;
+  while (begin < live.size())
+  {
+    std::size_t end = begin + 1;
+    try
+    {
+      std::unique_ptr<udp_handler> uncached;
+      udp_handler *handler = m_shared_handler
+                                 ? m_shared_handler.get()
+                                 : select_handler(*live[begin], state.handlers, uncached);
+      if (!handler)
+      {
+        ++dropped;
+        begin = end;
+        continue;
+      }
+
+      // A shared handler takes the whole burst; cached ones their senders
+      while (end < live.size() &&
+             (m_shared_handler || handler->can_handle_address(live[end]->sender_address)))
+      {
+        ++end;
+      }
+
+      auto &views = state.views;
+      views.clear();
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        const PacketData &packet = *live[i];
+        views.push_back({packet.buffer.data(), packet.buffer.size(),
+                         &packet.sender_address, &packet.kernel_timestamp});
+      }
+
+      const auto run_start = std::chrono::steady_clock::now();
+      const std::size_t ok = std::min(handler->handle_batch(views.data(), views.size()),
+                                      views.size());
+      processed += ok;
+      dropped += views.size() - ok;
+
+      if (track_latency)
+      {
+        const auto service_time =
+            (std::chrono::steady_clock::now() - run_start) /
+            static_cast<std::chrono::steady_clock::rep>(views.size());
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          const auto queue_wait = picked_up - live[i]->received_time;
+          m_queue_latency->record(queue_wait);
+          m_service_latency->record(service_time);
+          if (onLatencyRecorded.has_slots()) {
+            onLatencyRecorded.emit(queue_wait, service_time);
+          }
+        }
+      }
+    }
+    catch (const std::exception &ex)
+    {
+      if (onException.slot_count() > 0) {
+        onException.emit(ex, "process_batch");
+      }
+      handle_exception(ex, "process_batch");
+      dropped += end - begin;
+    }
+    begin = end;
+  }
+
+  if (processed > 0)
+  {
+    m_packets.add(PROCESSED_PACKETS, processed);
+    if (m_statistics_interval.count() == 0 && onProcessedPacketsChanged.has_slots()) {
+      onProcessedPacketsChanged.emit(m_packets.value(PROCESSED_PACKETS));
+    }
+  }
+  if (dropped > 0)
+  {
+    m_packets.add(DROPPED_PACKETS, dropped);
+    if (m_statistics_interval.count() == 0 && onDroppedPacketsChanged.has_slots()) {
+      onDroppedPacketsChanged.emit(m_packets.value(DROPPED_PACKETS));
     }
   }
 }
@@ -783,46 +2149,142 @@ void udp_server::process_packet(std::unique_ptr<PacketData> packet_data)
  */
 void udp_server::cleanup_expired_packets()
 {
-  if (m_packet_timeout.count() == 0)
+  if (m_packet_timeout.count() == 0 || m_lock_free_queue)
   {
-    return; // No timeout configured
+    return; // No timeout configured, or expiry is checked on dequeue
   }
 
-  std::lock_guard<std::mutex> lock(m_queue_mutex);
-  auto now = std::chrono::steady_clock::now();
+  std::vector<packet_ptr> expired;
+  {
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    auto now = std::chrono::steady_clock::now();
+
+    while (!m_packet_queue.empty())
+    {
+      auto &front_packet = m_packet_queue.front();
+      auto age           = now - front_packet->received_time;
+
+      if (age > m_packet_timeout)
+      {
+        expired.push_back(std::move(front_packet));
+        m_packet_queue.pop();
+        m_packets.add(DROPPED_PACKETS);
+      }
+      else
+      {
+        break; // Packets are ordered by arrival time
+      }
+    }
+  }
 
-  while (!m_packet_queue.empty())
+  for (auto &packet_data : expired)
   {
-    auto &front_packet = m_packet_queue.front();
-    auto age           = now - front_packet->received_time;
+    release_packet(std::move(packet_data));
+  }
+}
 
-    if (age > m_packet_timeout)
+/**
+ * @brief Obtain a packet for a received datagram, reusing a pooled one.
+ *
+ * @param data Datagram payload.
+ * @param length Payload size in bytes.
+ * @param sender Source address.
+ * @param timestamp Socket receive timestamps (zero when not enabled).
+ * @return Packet holding a copy of the payload.
+ */
+udp_server::packet_ptr
+udp_server::acquire_packet(const void *data,
+                           std::size_t length,
+                           const socket_address &sender,
+                           const udp_timestamp &timestamp)
+{
+  packet_ptr packet_data;
+  if (m_packet_pool_size > 0)
+  {
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    if (!m_packet_pool.empty())
     {
-      m_packet_queue.pop();
-      m_dropped_packets.fetch_add(1);
+      packet_data = std::move(m_packet_pool.back());
+      m_packet_pool.pop_back();
     }
-    else
+  }
+
+  if (!packet_data)
+  {
+    packet_data = m_packet_allocator ? m_packet_allocator->make() : packet_ptr(new PacketData());
+    if (m_packet_pool_size > 0)
     {
-      break; // Packets are ordered by arrival time
+      packet_data->buffer.reserve(std::max(length, m_packet_buffer_size));
     }
   }
+
+  packet_data->assign(data, length, sender, timestamp);
+  return packet_data;
+}
+
+/**
+ * @brief Return a finished packet to the pool.
+ *
+ * Packets beyond the configured pool size are freed.
+ *
+ * @param packet_data Packet no longer referenced by the queue or a handler.
+ */
+void udp_server::release_packet(packet_ptr packet_data)
+{
+  if (!packet_data || m_packet_pool_size == 0)
+  {
+    return;
+  }
+
+  packet_data->buffer.clear();
+
+  std::lock_guard<std::mutex> lock(m_pool_mutex);
+  if (m_packet_pool.size() < m_packet_pool_size)
+  {
+    m_packet_pool.push_back(std::move(packet_data));
+  }
 }
 
 /**
  * @brief Spawn an additional worker when the queue pressure increases.
+ *
+ * Workers that retired since the last call are joined here, outside the
+ * locks, so their threads do not accumulate.
+ *
+ * @param queue_wait_exceeded True when a worker dequeued a packet older than
+ * the policy's queue_wait_threshold.
  */
-void udp_server::add_worker_thread_if_needed()
+void udp_server::add_worker_thread_if_needed(bool queue_wait_exceeded)
 {
   bool thread_added = false;
   std::size_t thread_count = 0;
+  std::vector<std::thread> retired;
 
-  // Use scoped_lock for deadlock-safe acquisition of multiple mutexes
+  // Acquire both mutexes deadlock-free; the lock-free ring needs only one
   {
-    std::scoped_lock lock(m_threads_mutex, m_queue_mutex);
+    std::unique_lock<std::mutex> threads_lock(m_threads_mutex, std::defer_lock);
+    std::unique_lock<std::mutex> queue_lock(m_queue_mutex, std::defer_lock);
+    if (m_lock_free_queue)
+    {
+      threads_lock.lock();
+    }
+    else
+    {
+      std::lock(threads_lock, queue_lock);
+    }
+
+    retired.swap(m_retired_threads);
 
-    // Add thread if queue is getting full and we haven't reached max threads
-    if (m_packet_queue.size() > m_worker_threads.size() &&
-        m_worker_threads.size() < m_max_threads)
+    const std::size_t backlog = m_lock_free_queue
+                                    ? m_lock_free_queue->size_approx()
+                                    : m_packet_queue.size();
+    const std::size_t workers = m_worker_threads.size();
+
+    // Add thread if the queue is backing up and we haven't reached max threads
+    const bool pressure =
+        backlog > workers * m_pool_policy.queue_depth_per_thread ||
+        (queue_wait_exceeded && backlog > 0);
+    if (pressure && workers < m_max_threads && !m_should_stop.load())
     {
       m_worker_threads.emplace_back(&udp_server::worker_thread_proc, this);
       thread_added = true;
@@ -830,6 +2292,14 @@ void udp_server::add_worker_thread_if_needed()
     }
   }
 
+  for (auto &thread : retired)
+  {
+    if (thread.joinable())
+    {
+      thread.join();
+    }
+  }
+
   // Emit signals outside the lock to prevent re-entrancy deadlock
   if (thread_added)
   {
@@ -842,6 +2312,66 @@ void udp_server::add_worker_thread_if_needed()
   }
 }
 
+/**
+ * @brief Retire the calling worker if it has been idle long enough.
+ *
+ * The worker's thread object moves to the retired list, to be joined by the
+ * next add_worker_thread_if_needed() or by shutdown_threads().
+ *
+ * @param idle_since When the calling worker last finished a packet.
+ * @return True if the caller must exit its loop.
+ */
+bool udp_server::retire_idle_worker(
+    const std::chrono::steady_clock::time_point &idle_since)
+{
+  const auto idle_timeout = m_pool_policy.idle_timeout;
+  if (idle_timeout.count() == 0 ||
+      std::chrono::steady_clock::now() - idle_since < idle_timeout)
+  {
+    return false;
+  }
+
+  std::size_t thread_count = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_threads_mutex);
+    if (m_should_stop.load() || m_worker_threads.size() <= min_worker_threads())
+    {
+      return false;
+    }
+
+    const auto self = std::this_thread::get_id();
+    auto it = std::find_if(m_worker_threads.begin(), m_worker_threads.end(),
+                           [self](const std::thread &thread)
+                           { return thread.get_id() == self; });
+    if (it == m_worker_threads.end())
+    {
+      return false;
+    }
+    m_retired_threads.push_back(std::move(*it));
+    m_worker_threads.erase(it);
+    thread_count = m_worker_threads.size();
+  }
+
+  if (onWorkerThreadDestroyed.slot_count() > 0) {
+    onWorkerThreadDestroyed.emit(thread_count);
+  }
+  if (onActiveThreadsChanged.slot_count() > 0) {
+    onActiveThreadsChanged.emit(thread_count);
+  }
+  return true;
+}
+
+/**
+ * @brief Number of workers started with the server and kept when idle.
+ */
+std::size_t udp_server::min_worker_threads() const
+{
+  const std::size_t min_threads = m_pool_policy.min_threads == 0
+                                      ? DEFAULT_MIN_THREADS
+                                      : m_pool_policy.min_threads;
+  return std::min(min_threads, m_max_threads);
+}
+
 /**
  * @brief Ensure the server is ready to start.
  *
@@ -875,24 +2405,72 @@ void udp_server::shutdown_threads(const std::chrono::milliseconds &timeout)
 {
   (void)timeout; // Timeout used to signal urgency, but we always join to avoid use-after-free
 
-  // Join receiver thread
-  if (m_receiver_thread.joinable())
+  // Join receiver threads and release shard sockets
+  for (auto &thread : m_receiver_threads)
   {
-    m_receiver_thread.join();
+    if (thread.joinable())
+    {
+      thread.join();
+    }
   }
+  m_receiver_threads.clear();
+  m_shard_sockets.clear();
 
   // Join worker threads - always join to prevent use-after-free from detached
-  // threads accessing destroyed server object
+  // threads accessing destroyed server object. Join outside the lock: a
+  // worker may be retiring and waiting for it.
+  std::vector<std::thread> workers;
   {
     std::lock_guard<std::mutex> lock(m_threads_mutex);
-    for (auto &thread : m_worker_threads)
+    workers.swap(m_worker_threads);
+    std::move(m_retired_threads.begin(), m_retired_threads.end(),
+              std::back_inserter(workers));
+    m_retired_threads.clear();
+  }
+  for (auto &thread : workers)
+  {
+    if (thread.joinable())
     {
-      if (thread.joinable())
-      {
-        thread.join();
-      }
+      thread.join();
+    }
+  }
+}
+
+/**
+ * @brief Open the additional SO_REUSEPORT sockets for sharded reception.
+ *
+ * Shards are bound without SO_REUSEADDR: for UDP that option alone permits
+ * duplicate binds, which would silently starve all but one socket. Shards
+ * inherit the server socket's receive timestamp mode.
+ *
+ * @throws std::logic_error If the server socket lacks SO_REUSEPORT.
+ * @throws std::system_error If a shard socket cannot be bound.
+ */
+void udp_server::open_shard_sockets()
+{
+  m_shard_sockets.clear();
+  if (m_receiver_shards <= 1)
+  {
+    return;
+  }
+
+  if (!m_server_socket.get_reuse_port())
+  {
+    throw std::logic_error(
+        "Sharded receivers require a server socket bound with reuse_port");
+  }
+
+  const socket_address address = m_server_socket.address();
+  m_shard_sockets.reserve(m_receiver_shards - 1);
+  for (std::size_t i = 1; i < m_receiver_shards; ++i)
+  {
+    udp_socket shard(address.family());
+    shard.bind(address, false, true);
+    if (m_server_socket.get_receive_timestamps() != udp_socket::TIMESTAMP_NONE)
+    {
+      shard.set_receive_timestamps(m_server_socket.get_receive_timestamps());
     }
-    m_worker_threads.clear();
+    m_shard_sockets.push_back(std::move(shard));
   }
 }
 
@@ -1,6 +1,9 @@
 #include <fb/udp_socket.h>
+#include <fb/detail/socket_error_utils.h>
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 
@@ -11,18 +14,96 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+#ifdef __linux__
+#include <linux/net_tstamp.h>
+#include <time.h>
 #endif
 
 namespace fb
 {
 
+#ifndef _WIN32
+namespace
+{
+
+/// Control buffer size for one datagram's timestamp messages
+constexpr std::size_t TIMESTAMP_CONTROL_SIZE = 128;
+
+#ifdef __linux__
+/// Control buffer size for one datagram's SCM_TXTIME message
+constexpr std::size_t TXTIME_CONTROL_SIZE = CMSG_SPACE(sizeof(std::uint64_t));
+#endif
+
+/**
+ * @brief Convert a timespec to nanoseconds since its clock's epoch.
+ */
+std::chrono::nanoseconds to_nanoseconds(const timespec &ts)
+{
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+/**
+ * @brief Extract receive timestamps from a received message's control data.
+ * @param message Message header filled in by recvmsg()/recvmmsg()
+ * @param timestamp Receives the timestamps; zeroed if none were attached
+ */
+void parse_timestamps(msghdr &message, udp_timestamp &timestamp)
+{
+  timestamp = udp_timestamp();
+  if (message.msg_controllen == 0)
+  {
+    return;
+  }
+
+  for (cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&message, cmsg))
+  {
+    if (cmsg->cmsg_level != SOL_SOCKET)
+    {
+      continue;
+    }
+
+#ifdef __linux__
+    if (cmsg->cmsg_type == SCM_TIMESTAMPING)
+    {
+      // [0] software, [1] deprecated, [2] raw hardware
+      timespec stamps[3];
+      std::memcpy(stamps, CMSG_DATA(cmsg), sizeof(stamps));
+      timestamp.hardware = to_nanoseconds(stamps[2]);
+    }
+    else if (cmsg->cmsg_type == SCM_TIMESTAMPNS)
+    {
+      timespec stamp;
+      std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+      timestamp.software = to_nanoseconds(stamp);
+    }
+#elif defined(SCM_TIMESTAMP)
+    if (cmsg->cmsg_type == SCM_TIMESTAMP)
+    {
+      timeval stamp;
+      std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+      timestamp.software = std::chrono::seconds(stamp.tv_sec) +
+                           std::chrono::microseconds(stamp.tv_usec);
+    }
+#endif
+  }
+}
+
+} // namespace
+#endif
+
 /**
  * @brief Default constructor creates an uninitialized UDP socket.
  * @sa init_udp_socket
  */
 udp_socket::udp_socket() :
   socket_base(),
-  m_is_connected(false)
+  m_is_connected(false),
+  m_timestamp_mode(TIMESTAMP_NONE),
+  m_transmit_time(false)
 {
   init_udp_socket(socket_address::IPv4);
 }
@@ -33,7 +114,9 @@ udp_socket::udp_socket() :
  */
 udp_socket::udp_socket(socket_address::Family family) :
   socket_base(),
-  m_is_connected(false)
+  m_is_connected(false),
+  m_timestamp_mode(TIMESTAMP_NONE),
+  m_transmit_time(false)
 {
   init_udp_socket(family);
 }
@@ -46,7 +129,9 @@ udp_socket::udp_socket(socket_address::Family family) :
  */
 udp_socket::udp_socket(const socket_address &address, bool reuse_address) :
   socket_base(),
-  m_is_connected(false)
+  m_is_connected(false),
+  m_timestamp_mode(TIMESTAMP_NONE),
+  m_transmit_time(false)
 {
   init_udp_socket(address.family());
   bind(address, reuse_address);
@@ -58,18 +143,45 @@ udp_socket::udp_socket(const socket_address &address, bool reuse_address) :
  */
 udp_socket::udp_socket(socket_t sockfd) :
   socket_base(sockfd),
-  m_is_connected(false)
+  m_is_connected(false),
+  m_timestamp_mode(TIMESTAMP_NONE),
+  m_transmit_time(false)
 {
 }
 
+/**
+ * @brief Create two connected, unnamed Unix domain datagram sockets
+ *
+ * Each end sends to the other with send_bytes() and receives with
+ * receive_bytes(); message boundaries are kept and nothing is dropped, as the
+ * sender blocks while the receiver's queue is full.
+ *
+ * @return Both ends of the pair
+ * @throws std::system_error if socketpair() fails
+ * @throws std::runtime_error on platforms without socketpair()
+ */
+std::pair<udp_socket, udp_socket> udp_socket::socket_pair()
+{
+  socket_t fds[2];
+  open_pair(DATAGRAM_SOCKET, fds);
+  std::pair<udp_socket, udp_socket> sockets{udp_socket(fds[0]), udp_socket(fds[1])};
+  sockets.first.m_is_connected  = true;
+  sockets.second.m_is_connected = true;
+  return sockets;
+}
+
 /**
  * @brief Move constructor
  */
 udp_socket::udp_socket(udp_socket &&other) noexcept :
   socket_base(std::move(other)),
-  m_is_connected(other.m_is_connected)
+  m_is_connected(other.m_is_connected),
+  m_timestamp_mode(other.m_timestamp_mode),
+  m_transmit_time(other.m_transmit_time)
 {
-  other.m_is_connected = false;
+  other.m_is_connected   = false;
+  other.m_timestamp_mode = TIMESTAMP_NONE;
+  other.m_transmit_time  = false;
 }
 
 /**
@@ -78,8 +190,12 @@ udp_socket::udp_socket(udp_socket &&other) noexcept :
 udp_socket &udp_socket::operator=(udp_socket &&other) noexcept
 {
   socket_base::operator=(std::move(other));
-  m_is_connected       = other.m_is_connected;
-  other.m_is_connected = false;
+  m_is_connected         = other.m_is_connected;
+  m_timestamp_mode       = other.m_timestamp_mode;
+  m_transmit_time        = other.m_transmit_time;
+  other.m_is_connected   = false;
+  other.m_timestamp_mode = TIMESTAMP_NONE;
+  other.m_transmit_time  = false;
   return *this;
 }
 
@@ -157,6 +273,74 @@ int udp_socket::receive_from(void *buffer,
   return received;
 }
 
+/**
+ * @brief Receive datagram together with its kernel receive timestamps
+ *
+ * Timestamps are only attached once set_receive_timestamps() has enabled
+ * them; otherwise (and on Windows) @p timestamp is zeroed and the call
+ * behaves like the plain receive_from().
+ *
+ * @param buffer Pointer to receive buffer
+ * @param length Size of receive buffer
+ * @param address Output parameter for sender address
+ * @param timestamp Output parameter for the receive timestamps
+ * @param flags Receive flags (default 0)
+ * @return Number of bytes received
+ * @throws std::system_error
+ */
+int udp_socket::receive_from(void *buffer,
+                             int length,
+                             socket_address &address,
+                             udp_timestamp &timestamp,
+                             int flags)
+{
+  timestamp = udp_timestamp();
+
+#ifdef _WIN32
+  return receive_from(buffer, length, address, flags);
+#else
+  if (m_timestamp_mode == TIMESTAMP_NONE)
+  {
+    return receive_from(buffer, length, address, flags);
+  }
+
+  check_initialized();
+  validate_buffer(buffer, length);
+
+  if (length == 0)
+  {
+    return 0;
+  }
+
+  sockaddr_storage addr_storage;
+  iovec vector;
+  vector.iov_base = buffer;
+  vector.iov_len  = static_cast<std::size_t>(length);
+
+  alignas(cmsghdr) char control[TIMESTAMP_CONTROL_SIZE];
+  msghdr message;
+  std::memset(&message, 0, sizeof(message));
+  message.msg_name       = &addr_storage;
+  message.msg_namelen    = sizeof(addr_storage);
+  message.msg_iov        = &vector;
+  message.msg_iovlen     = 1;
+  message.msg_control    = control;
+  message.msg_controllen = sizeof(control);
+
+  ssize_t received = ::recvmsg(sockfd(), &message, flags);
+  if (received < 0)
+  {
+    error("Failed to receive datagram");
+  }
+
+  address = socket_address(reinterpret_cast<sockaddr *>(&addr_storage),
+                           message.msg_namelen);
+  parse_timestamps(message, timestamp);
+
+  return static_cast<int>(received);
+#endif
+}
+
 /**
  * @brief Send string datagram to specific address
  * @param message String to send
@@ -204,6 +388,232 @@ int udp_socket::receive_from(std::string &message,
   return received;
 }
 
+/**
+ * @brief Receive several datagrams with as few system calls as possible
+ *
+ * Blocks (subject to the socket's blocking mode and receive timeout) until
+ * at least one datagram is available, then collects whatever further
+ * datagrams are already queued, up to @p count. On Linux this maps to
+ * recvmmsg() with MSG_WAITFORONE; other platforms fall back to a loop of
+ * recvfrom() calls that stops when no more data is pending.
+ *
+ * Datagrams larger than an entry's capacity are truncated. When receive
+ * timestamps are enabled each entry's timestamp is filled in as well.
+ *
+ * @param entries Array of receive slots; length and sender are filled in
+ * @param count Number of slots in @p entries
+ * @param flags Receive flags applied to every datagram (default 0)
+ * @return Number of entries filled (0 only when @p count is 0)
+ * @throws std::invalid_argument if entries is null or a slot has no buffer
+ * @throws std::system_error
+ */
+int udp_socket::receive_batch(udp_receive_entry *entries,
+                              std::size_t count,
+                              int flags)
+{
+  check_initialized();
+
+  if (count == 0)
+  {
+    return 0;
+  }
+  if (!entries)
+  {
+    throw std::invalid_argument("Entries cannot be null for non-zero count");
+  }
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (!entries[i].buffer || entries[i].capacity == 0)
+    {
+      throw std::invalid_argument("Batch entry requires a non-empty buffer");
+    }
+  }
+
+#ifdef __linux__
+  constexpr std::size_t MAX_BATCH = 64;
+  const std::size_t batch = std::min(count, MAX_BATCH);
+
+  mmsghdr messages[MAX_BATCH];
+  iovec vectors[MAX_BATCH];
+  sockaddr_storage addresses[MAX_BATCH];
+  std::memset(messages, 0, sizeof(mmsghdr) * batch);
+
+  // Control space is only needed (and only costs a copy) with timestamps on
+  const bool timestamps = m_timestamp_mode != TIMESTAMP_NONE;
+  alignas(cmsghdr) char control[MAX_BATCH][TIMESTAMP_CONTROL_SIZE];
+
+  for (std::size_t i = 0; i < batch; ++i)
+  {
+    vectors[i].iov_base                = entries[i].buffer;
+    vectors[i].iov_len                 = entries[i].capacity;
+    messages[i].msg_hdr.msg_name       = &addresses[i];
+    messages[i].msg_hdr.msg_namelen    = sizeof(sockaddr_storage);
+    messages[i].msg_hdr.msg_iov        = &vectors[i];
+    messages[i].msg_hdr.msg_iovlen     = 1;
+    if (timestamps)
+    {
+      messages[i].msg_hdr.msg_control    = control[i];
+      messages[i].msg_hdr.msg_controllen = TIMESTAMP_CONTROL_SIZE;
+    }
+  }
+
+  int received = ::recvmmsg(sockfd(), messages, static_cast<unsigned int>(batch),
+                            flags | MSG_WAITFORONE, nullptr);
+  if (received < 0)
+  {
+    error("Failed to receive datagram batch");
+  }
+
+  for (int i = 0; i < received; ++i)
+  {
+    entries[i].length = messages[i].msg_len;
+    entries[i].sender = socket_address(
+        reinterpret_cast<sockaddr *>(&addresses[i]),
+        messages[i].msg_hdr.msg_namelen);
+    parse_timestamps(messages[i].msg_hdr, entries[i].timestamp);
+  }
+
+  return received;
+#else
+  int received = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (i > 0 && !poll(std::chrono::milliseconds(0), SELECT_READ))
+    {
+      break;
+    }
+
+    const int capacity = static_cast<int>(
+        std::min<std::size_t>(entries[i].capacity, max_datagram_size()));
+    int bytes = receive_from(entries[i].buffer, capacity, entries[i].sender,
+                             entries[i].timestamp, flags);
+    entries[i].length = static_cast<std::size_t>(bytes);
+    ++received;
+  }
+
+  return received;
+#endif
+}
+
+/**
+ * @brief Send several datagrams with as few system calls as possible
+ *
+ * On Linux the entries are handed to sendmmsg() in chunks of up to 64
+ * messages; other platforms fall back to one sendto() per entry. Sending
+ * stops at the first failure: if nothing was sent the error is raised,
+ * otherwise the number of datagrams already sent is returned so the caller
+ * can retry the remainder.
+ *
+ * @param entries Array of datagrams to send
+ * @param count Number of entries in @p entries
+ * @param flags Send flags applied to every datagram (default 0)
+ * @return Number of datagrams sent
+ * @throws std::invalid_argument if entries is null or an entry is invalid
+ * @throws std::system_error if the first datagram cannot be sent
+ */
+int udp_socket::send_batch(const udp_send_entry *entries,
+                           std::size_t count,
+                           int flags)
+{
+  check_initialized();
+
+  if (count == 0)
+  {
+    return 0;
+  }
+  if (!entries)
+  {
+    throw std::invalid_argument("Entries cannot be null for non-zero count");
+  }
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (entries[i].length > static_cast<std::size_t>(max_datagram_size()))
+    {
+      throw std::length_error("Datagram size exceeds maximum allowed size");
+    }
+    if (!entries[i].buffer && entries[i].length > 0)
+    {
+      throw std::invalid_argument("Buffer cannot be null for non-zero length");
+    }
+  }
+
+  std::size_t sent = 0;
+
+#ifdef __linux__
+  constexpr std::size_t MAX_BATCH = 64;
+
+  mmsghdr messages[MAX_BATCH];
+  iovec vectors[MAX_BATCH];
+  alignas(cmsghdr) char control[MAX_BATCH][TXTIME_CONTROL_SIZE];
+
+  while (sent < count)
+  {
+    const std::size_t batch = std::min(count - sent, MAX_BATCH);
+    std::memset(messages, 0, sizeof(mmsghdr) * batch);
+
+    for (std::size_t i = 0; i < batch; ++i)
+    {
+      const udp_send_entry &entry = entries[sent + i];
+      vectors[i].iov_base             = const_cast<void *>(entry.buffer);
+      vectors[i].iov_len              = entry.length;
+      messages[i].msg_hdr.msg_name    =
+          const_cast<sockaddr *>(entry.destination.addr());
+      messages[i].msg_hdr.msg_namelen = entry.destination.length();
+      messages[i].msg_hdr.msg_iov     = &vectors[i];
+      messages[i].msg_hdr.msg_iovlen  = 1;
+      if (m_transmit_time && entry.send_time.count() > 0)
+      {
+        // SCM_TXTIME: the qdisc (fq or etf) holds the datagram until then
+        messages[i].msg_hdr.msg_control    = control[i];
+        messages[i].msg_hdr.msg_controllen = sizeof(control[i]);
+        cmsghdr *cmsg   = CMSG_FIRSTHDR(&messages[i].msg_hdr);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_TXTIME;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(std::uint64_t));
+        const auto when  = static_cast<std::uint64_t>(entry.send_time.count());
+        std::memcpy(CMSG_DATA(cmsg), &when, sizeof(when));
+      }
+    }
+
+    int result = ::sendmmsg(sockfd(), messages,
+                            static_cast<unsigned int>(batch), flags);
+    if (result < 0)
+    {
+      if (sent == 0)
+      {
+        error("Failed to send datagram batch");
+      }
+      break;
+    }
+
+    sent += static_cast<std::size_t>(result);
+    if (static_cast<std::size_t>(result) < batch)
+    {
+      break;
+    }
+  }
+#else
+  for (; sent < count; ++sent)
+  {
+    const udp_send_entry &entry = entries[sent];
+    int result = ::sendto(sockfd(), static_cast<const char *>(entry.buffer),
+                          static_cast<int>(entry.length), flags,
+                          entry.destination.addr(),
+                          entry.destination.length());
+    if (result < 0)
+    {
+      if (sent == 0)
+      {
+        error("Failed to send datagram batch");
+      }
+      break;
+    }
+  }
+#endif
+
+  return static_cast<int>(sent);
+}
+
 /**
  * @brief Connect UDP socket to remote address (sets default destination)
  * @param address Remote address to connect to
@@ -501,6 +911,168 @@ bool udp_socket::get_multicast_loopback()
 #endif
 }
 
+/**
+ * @brief Enable kernel receive timestamps for incoming datagrams
+ *
+ * Linux uses SO_TIMESTAMPNS for software stamps and adds SO_TIMESTAMPING
+ * for hardware stamps; hardware stamps additionally require timestamping to be
+ * enabled on the NIC (SIOCSHWTSTAMP, e.g. via hwstamp_ctl) and are zero
+ * otherwise. Other POSIX systems provide microsecond software stamps through
+ * SO_TIMESTAMP only.
+ *
+ * @param mode Timestamp source, or TIMESTAMP_NONE to disable
+ * @throws std::system_error, with std::errc::function_not_supported on Windows
+ */
+void udp_socket::set_receive_timestamps(TimestampMode mode)
+{
+  check_initialized();
+
+#ifdef _WIN32
+  if (mode != TIMESTAMP_NONE)
+  {
+    detail::throw_system_error(std::errc::function_not_supported,
+                               "Receive timestamps are not supported");
+  }
+#elif defined(__linux__)
+  // The software stamp always comes from SO_TIMESTAMPNS: unlike the
+  // SO_TIMESTAMPING software stamp it falls back to the time of the receive
+  // call for packets that entered the stack before stamping was enabled.
+  int nanoseconds = mode != TIMESTAMP_NONE ? 1 : 0;
+  int timestamping = 0;
+  if (mode == TIMESTAMP_HARDWARE)
+  {
+    timestamping = SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+  }
+
+  if (::setsockopt(sockfd(), SOL_SOCKET, SO_TIMESTAMPING, &timestamping,
+                   sizeof(timestamping)) != 0 ||
+      ::setsockopt(sockfd(), SOL_SOCKET, SO_TIMESTAMPNS, &nanoseconds,
+                   sizeof(nanoseconds)) != 0)
+  {
+    error("Failed to set receive timestamps");
+  }
+#else
+  int value = mode != TIMESTAMP_NONE ? 1 : 0;
+  if (::setsockopt(sockfd(), SOL_SOCKET, SO_TIMESTAMP, &value,
+                   sizeof(value)) != 0)
+  {
+    error("Failed to set receive timestamps");
+  }
+#endif
+
+  m_timestamp_mode = mode;
+}
+
+/**
+ * @brief Get the receive timestamp mode set by set_receive_timestamps()
+ * @return Current timestamp mode (TIMESTAMP_NONE by default)
+ */
+udp_socket::TimestampMode udp_socket::get_receive_timestamps() const
+{
+  return m_timestamp_mode;
+}
+
+/**
+ * @brief Let receives on this socket busy-poll the device queue (SO_BUSY_POLL)
+ *
+ * While a receive or poll finds no data the kernel spins on the NIC receive
+ * queue for up to @p budget instead of sleeping until the interrupt, cutting
+ * wake-up latency at the cost of CPU. Raising the value above the
+ * net.core.busy_read sysctl requires CAP_NET_ADMIN.
+ *
+ * @param budget Busy-poll time per call; zero disables
+ * @throws std::invalid_argument if budget is negative
+ * @throws std::system_error, with std::errc::function_not_supported outside Linux
+ */
+void udp_socket::set_busy_poll(const std::chrono::microseconds &budget)
+{
+  check_initialized();
+  if (budget.count() < 0)
+  {
+    throw std::invalid_argument("Busy poll budget cannot be negative");
+  }
+
+#ifdef SO_BUSY_POLL
+  int value = static_cast<int>(std::min<std::chrono::microseconds::rep>(
+      budget.count(), std::numeric_limits<int>::max()));
+  if (::setsockopt(sockfd(), SOL_SOCKET, SO_BUSY_POLL, &value,
+                   sizeof(value)) != 0)
+  {
+    error("Failed to set busy poll");
+  }
+#else
+  detail::throw_system_error(std::errc::function_not_supported,
+                             "Busy polling is not supported");
+#endif
+}
+
+/**
+ * @brief Let send_batch() schedule datagrams for a future departure (SO_TXTIME)
+ *
+ * Once enabled, entries with a non-zero udp_send_entry::send_time carry it
+ * to the kernel, and the fq (or etf) qdisc on the egress interface releases
+ * each datagram at that steady-clock time instead of right away. Other
+ * qdiscs ignore the time and send immediately.
+ *
+ * @param flag Enable or disable
+ * @throws std::system_error, with std::errc::function_not_supported outside
+ * Linux or on kernels without SO_TXTIME
+ */
+void udp_socket::set_transmit_time(bool flag)
+{
+  check_initialized();
+
+#if defined(__linux__) && defined(SO_TXTIME)
+  // CLOCK_MONOTONIC is the clock behind std::chrono::steady_clock
+  sock_txtime config{};
+  config.clockid = CLOCK_MONOTONIC;
+  config.flags   = 0;
+  if (flag && ::setsockopt(sockfd(), SOL_SOCKET, SO_TXTIME, &config,
+                           sizeof(config)) != 0)
+  {
+    error("Failed to enable transmit time");
+  }
+  m_transmit_time = flag;
+#else
+  if (flag)
+  {
+    detail::throw_system_error(std::errc::function_not_supported,
+                               "Transmit time is not supported");
+  }
+  m_transmit_time = false;
+#endif
+}
+
+/**
+ * @brief Whether set_transmit_time() is enabled
+ */
+bool udp_socket::get_transmit_time() const
+{
+  return m_transmit_time;
+}
+
+/**
+ * @brief Get the SO_BUSY_POLL budget
+ * @return Busy-poll time per call (zero when disabled or unsupported)
+ * @throws std::system_error
+ */
+std::chrono::microseconds udp_socket::get_busy_poll()
+{
+  check_initialized();
+
+#ifdef SO_BUSY_POLL
+  int value = 0;
+  socklen_t len = sizeof(value);
+  if (::getsockopt(sockfd(), SOL_SOCKET, SO_BUSY_POLL, &value, &len) != 0)
+  {
+    error("Failed to get busy poll");
+  }
+  return std::chrono::microseconds(value);
+#else
+  return std::chrono::microseconds(0);
+#endif
+}
+
 /**
  * @brief Join multicast group
  * @param group_address Multicast group address
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <fb/async_socket.h>
+#include <fb/tcp_client.h>
+#include <fb/udp_socket.h>
+#include <fb/fb_signal.hpp>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if FB_SIGNAL_HAS_COROUTINES
+
+using namespace fb;
+
+namespace {
+
+detached_task echo_once(async_reactor& reactor, tcp_client& client, int& echoed)
+{
+    char buffer[64];
+    const int received = co_await async_receive(reactor, client, buffer, static_cast<int>(sizeof(buffer)));
+    echoed = co_await async_send_all(reactor, client, buffer, received);
+}
+
+detached_task read_all(async_reactor& reactor, tcp_client& client, std::string& out, bool& closed)
+{
+    char buffer[4096];
+    for (;;)
+    {
+        const int received = co_await async_receive(reactor, client, buffer, static_cast<int>(sizeof(buffer)));
+        if (received == 0)
+        {
+            closed = true;
+            co_return;
+        }
+        out.append(buffer, static_cast<std::size_t>(received));
+    }
+}
+
+detached_task write_all(async_reactor& reactor, tcp_client& client, const std::string& data, int& sent)
+{
+    sent = co_await async_send_all(reactor, client, data.data(), static_cast<int>(data.size()));
+    client.shutdown_send();
+}
+
+detached_task receive_datagram(async_reactor& reactor, udp_socket& socket, std::string& out,
+                               socket_address& sender)
+{
+    char buffer[256];
+    const int received = co_await async_receive_from(reactor, socket, buffer, static_cast<int>(sizeof(buffer)), sender);
+    out.assign(buffer, static_cast<std::size_t>(received));
+}
+
+detached_task await_failure(async_reactor& reactor, tcp_client& client, std::string& error)
+{
+    try
+    {
+        char buffer[16];
+        co_await async_receive(reactor, client, buffer, -1);
+    }
+    catch (const std::invalid_argument& ex)
+    {
+        error = ex.what();
+    }
+}
+
+detached_task await_signal(fb::signal<int>& sig, event_queue& queue, int& value, std::thread::id& resumed_on)
+{
+    value = co_await sig.next(queue);
+    resumed_on = std::this_thread::get_id();
+}
+
+} // namespace
+
+TEST(AsyncSocketTest, ReceiveSuspendsUntilDataArrives)
+{
+    auto ends = tcp_client::socket_pair();
+    async_reactor reactor;
+    int echoed = -1;
+
+    echo_once(reactor, ends.first, echoed);
+    EXPECT_EQ(reactor.waiting(), 1u);
+    EXPECT_EQ(reactor.run_once(std::chrono::milliseconds(0)), 0u);
+
+    ASSERT_EQ(ends.second.send_bytes("ping", 4), 4);
+    reactor.run();
+    EXPECT_EQ(echoed, 4);
+    EXPECT_EQ(reactor.waiting(), 0u);
+
+    char reply[4] = {};
+    ASSERT_EQ(ends.second.receive_bytes(reply, 4), 4);
+    EXPECT_EQ(std::memcmp(reply, "ping", 4), 0);
+}
+
+TEST(AsyncSocketTest, LargeTransferInterleavesSenderAndReceiver)
+{
+    auto ends = tcp_client::socket_pair();
+    async_reactor reactor;
+
+    // Far more than the socket buffers hold: both sides must suspend
+    const std::string data(4 * 1024 * 1024, 'x');
+    std::string received;
+    bool closed = false;
+    int sent    = 0;
+
+    read_all(reactor, ends.second, received, closed);
+    write_all(reactor, ends.first, data, sent);
+    reactor.run();
+
+    EXPECT_EQ(sent, static_cast<int>(data.size()));
+    EXPECT_TRUE(closed);
+    EXPECT_EQ(received.size(), data.size());
+    EXPECT_EQ(received, data);
+}
+
+TEST(AsyncSocketTest, UdpReceiveFrom)
+{
+    udp_socket receiver(socket_address("127.0.0.1", 0));
+    udp_socket sender(socket_address::Family::IPv4);
+    async_reactor reactor;
+
+    std::string message;
+    socket_address from;
+    receive_datagram(reactor, receiver, message, from);
+    EXPECT_EQ(reactor.waiting(), 1u);
+
+    sender.send_to("hello", 5, receiver.address());
+    reactor.run();
+    EXPECT_EQ(message, "hello");
+}
+
+TEST(AsyncSocketTest, ErrorsAreRethrownInTheCoroutine)
+{
+    auto ends = tcp_client::socket_pair();
+    async_reactor reactor;
+    std::string error;
+
+    await_failure(reactor, ends.first, error);
+    EXPECT_FALSE(error.empty());
+    EXPECT_EQ(reactor.waiting(), 0u);
+}
+
+TEST(AsyncSocketTest, SignalOnQueueResumesOnReactorThread)
+{
+    async_reactor reactor;
+    event_queue queue;
+    reactor.add(queue);
+
+    fb::signal<int> sig;
+    int value = 0;
+    std::thread::id resumed_on;
+    await_signal(sig, queue, value, resumed_on);
+
+    std::thread emitter([&sig]() { sig.emit(7); });
+    emitter.join();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (value == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        reactor.run_once(std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(value, 7);
+    EXPECT_EQ(resumed_on, std::this_thread::get_id());
+    reactor.remove(queue);
+}
+
+#endif
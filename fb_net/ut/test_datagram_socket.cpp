@@ -5,6 +5,7 @@
 #include <limits>
 #include <system_error>
 #include <thread>
+#include <vector>
 
 using namespace fb;
 
@@ -166,6 +167,167 @@ TEST_F(udp_socketTest, LoopbackMultiplePackets) {
     }
 }
 
+TEST_F(udp_socketTest, ReceiveBatch) {
+    udp_socket socket(socket_address::Family::IPv4);
+    socket.bind(socket_address("127.0.0.1", 0));
+    socket_address addr = socket.address();
+
+    const std::size_t num_packets = 6;
+    for (std::size_t i = 0; i < num_packets; ++i) {
+        socket.send_to("Batch " + std::to_string(i), addr);
+    }
+
+    std::vector<std::vector<char>> buffers(8, std::vector<char>(64));
+    std::vector<udp_receive_entry> entries(buffers.size());
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        entries[i].buffer = buffers[i].data();
+        entries[i].capacity = buffers[i].size();
+    }
+
+    socket.set_receive_timeout(std::chrono::seconds(2));
+    std::size_t total = 0;
+    while (total < num_packets) {
+        int count = socket.receive_batch(entries.data() + total, entries.size() - total);
+        ASSERT_GT(count, 0);
+        total += static_cast<std::size_t>(count);
+    }
+
+    ASSERT_EQ(total, num_packets);
+    for (std::size_t i = 0; i < num_packets; ++i) {
+        std::string received(static_cast<const char*>(entries[i].buffer), entries[i].length);
+        EXPECT_EQ(received, "Batch " + std::to_string(i));
+        EXPECT_EQ(entries[i].sender.port(), addr.port());
+    }
+}
+
+TEST_F(udp_socketTest, ReceiveBatchRejectsInvalidEntries) {
+    udp_socket socket(socket_address::Family::IPv4);
+    socket.bind(socket_address("127.0.0.1", 0));
+
+    EXPECT_EQ(socket.receive_batch(nullptr, 0), 0);
+    EXPECT_THROW(socket.receive_batch(nullptr, 4), std::invalid_argument);
+
+    udp_receive_entry entry;
+    EXPECT_THROW(socket.receive_batch(&entry, 1), std::invalid_argument);
+}
+
+#ifndef _WIN32
+TEST_F(udp_socketTest, ReceiveTimestamps) {
+    udp_socket socket(socket_address::Family::IPv4);
+    socket.bind(socket_address("127.0.0.1", 0));
+    socket.set_receive_timeout(std::chrono::seconds(2));
+    socket_address addr = socket.address();
+
+    EXPECT_EQ(socket.get_receive_timestamps(), udp_socket::TIMESTAMP_NONE);
+    socket.set_receive_timestamps(udp_socket::TIMESTAMP_SOFTWARE);
+    EXPECT_EQ(socket.get_receive_timestamps(), udp_socket::TIMESTAMP_SOFTWARE);
+
+    const auto before = std::chrono::system_clock::now().time_since_epoch();
+    socket.send_to("stamped", addr);
+
+    char buffer[64];
+    socket_address from;
+    udp_timestamp timestamp;
+    int bytes = socket.receive_from(buffer, sizeof(buffer), from, timestamp);
+    const auto after = std::chrono::system_clock::now().time_since_epoch();
+
+    EXPECT_EQ(std::string(buffer, static_cast<std::size_t>(bytes)), "stamped");
+    ASSERT_TRUE(timestamp.has_software());
+    EXPECT_FALSE(timestamp.has_hardware());
+    EXPECT_GE(timestamp.software + std::chrono::milliseconds(1), before);
+    EXPECT_LE(timestamp.software, after + std::chrono::milliseconds(1));
+
+    // Batched receive fills the per-entry timestamp as well
+    socket.send_to("one", addr);
+    socket.send_to("two", addr);
+    std::vector<std::vector<char>> buffers(2, std::vector<char>(64));
+    udp_receive_entry entries[2];
+    for (std::size_t i = 0; i < 2; ++i) {
+        entries[i].buffer = buffers[i].data();
+        entries[i].capacity = buffers[i].size();
+    }
+    std::size_t total = 0;
+    while (total < 2) {
+        int count = socket.receive_batch(entries + total, 2 - total);
+        ASSERT_GT(count, 0);
+        total += static_cast<std::size_t>(count);
+    }
+    EXPECT_TRUE(entries[0].timestamp.has_software());
+    EXPECT_TRUE(entries[1].timestamp.has_software());
+
+#ifdef __linux__
+    // The software stamp is still reported without NIC support
+    socket.set_receive_timestamps(udp_socket::TIMESTAMP_HARDWARE);
+    socket.send_to("hardware", addr);
+    socket.receive_from(buffer, sizeof(buffer), from, timestamp);
+    EXPECT_TRUE(timestamp.has_software());
+#endif
+
+    socket.set_receive_timestamps(udp_socket::TIMESTAMP_NONE);
+    socket.send_to("plain", addr);
+    socket.receive_from(buffer, sizeof(buffer), from, timestamp);
+    EXPECT_FALSE(timestamp.has_software());
+}
+#endif
+
+TEST_F(udp_socketTest, BusyPoll) {
+    udp_socket socket(socket_address::Family::IPv4);
+    EXPECT_THROW(socket.set_busy_poll(std::chrono::microseconds(-1)), std::invalid_argument);
+
+#ifdef __linux__
+    try {
+        socket.set_busy_poll(std::chrono::microseconds(50));
+    } catch (const std::system_error& ex) {
+        GTEST_SKIP() << "SO_BUSY_POLL not permitted: " << ex.what();
+    }
+    EXPECT_EQ(socket.get_busy_poll(), std::chrono::microseconds(50));
+    socket.set_busy_poll(std::chrono::microseconds(0));
+    EXPECT_EQ(socket.get_busy_poll(), std::chrono::microseconds(0));
+#else
+    EXPECT_THROW(socket.set_busy_poll(std::chrono::microseconds(50)), std::system_error);
+#endif
+}
+
+TEST_F(udp_socketTest, SendBatchFanOut) {
+    udp_socket sender(socket_address::Family::IPv4);
+    const std::size_t num_peers = 4;
+    std::vector<udp_socket> peers;
+    for (std::size_t i = 0; i < num_peers; ++i) {
+        peers.emplace_back(socket_address::Family::IPv4);
+        peers.back().bind(socket_address("127.0.0.1", 0));
+        peers.back().set_receive_timeout(std::chrono::seconds(2));
+    }
+
+    const std::string update = "price update";
+    std::vector<udp_send_entry> entries(num_peers);
+    for (std::size_t i = 0; i < num_peers; ++i) {
+        entries[i].buffer = update.data();
+        entries[i].length = update.size();
+        entries[i].destination = peers[i].address();
+    }
+
+    EXPECT_EQ(sender.send_batch(entries.data(), entries.size()), static_cast<int>(num_peers));
+
+    for (auto& peer : peers) {
+        std::string received;
+        socket_address from;
+        peer.receive_from(received, 1024, from);
+        EXPECT_EQ(received, update);
+    }
+}
+
+TEST_F(udp_socketTest, SendBatchRejectsInvalidEntries) {
+    udp_socket sender(socket_address::Family::IPv4);
+
+    EXPECT_EQ(sender.send_batch(nullptr, 0), 0);
+    EXPECT_THROW(sender.send_batch(nullptr, 2), std::invalid_argument);
+
+    udp_send_entry entry;
+    entry.length = 8;
+    entry.destination = socket_address("127.0.0.1", 9);
+    EXPECT_THROW(sender.send_batch(&entry, 1), std::invalid_argument);
+}
+
 TEST_F(udp_socketTest, MoveSemantics) {
     udp_socket socket1(socket_address::Family::IPv4);
     socket1.bind(socket_address("127.0.0.1", 0));
@@ -205,3 +367,49 @@ TEST_F(udp_socketTest, IPv6) {
         GTEST_SKIP() << "IPv6 not available on this system";
     }
 }
+
+#ifndef _WIN32
+TEST_F(udp_socketTest, SocketPairKeepsMessageBoundaries) {
+    auto ends = udp_socket::socket_pair();
+    ASSERT_TRUE(ends.first.is_connected());
+
+    ASSERT_EQ(ends.first.send_bytes("one", 3), 3);
+    ASSERT_EQ(ends.first.send_bytes("three", 5), 5);
+
+    char buffer[16];
+    EXPECT_EQ(ends.second.receive_bytes(buffer, sizeof(buffer)), 3);
+    EXPECT_EQ(ends.second.receive_bytes(buffer, sizeof(buffer)), 5);
+    EXPECT_EQ(std::string(buffer, 5), "three");
+}
+
+TEST_F(udp_socketTest, UnixDomainDatagrams) {
+    const std::string stamp =
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    const socket_address server_address(socket_address::UNIX_LOCAL,
+                                        "/tmp/fb_net_dgram_server_" + stamp + ".sock");
+    const socket_address client_address(socket_address::UNIX_LOCAL,
+                                        "/tmp/fb_net_dgram_client_" + stamp + ".sock");
+
+    udp_socket server(server_address);
+    udp_socket client(client_address);
+    udp_socket anonymous(socket_address::UNIX_LOCAL);
+
+    ASSERT_EQ(client.send_to("named", 5, server_address), 5);
+    ASSERT_EQ(anonymous.send_to("unnamed", 7, server_address), 7);
+
+    char buffer[16];
+    socket_address sender;
+    ASSERT_EQ(server.receive_from(buffer, sizeof(buffer), sender), 5);
+    EXPECT_EQ(sender, client_address);
+    ASSERT_EQ(server.receive_from(buffer, sizeof(buffer), sender), 7);
+    EXPECT_EQ(sender, socket_address(socket_address::UNIX_LOCAL));
+
+    // Named senders can be answered
+    ASSERT_EQ(server.send_to("reply", 5, client_address), 5);
+    ASSERT_EQ(client.receive_from(buffer, sizeof(buffer), sender), 5);
+    EXPECT_EQ(sender, server_address);
+
+    ::unlink(server_address.path().c_str());
+    ::unlink(client_address.path().c_str());
+}
+#endif
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <fb/dns_resolver.h>
+#include <fb/server_socket.h>
+#include <fb/tcp_client.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+class DnsResolverTest : public ::testing::Test
+{
+protected:
+    // Fake name service: "bad.host" fails, everything else is loopback
+    dns_resolver::lookup_function counting_lookup()
+    {
+        return [this](const std::string& host, socket_address::Family) {
+            ++lookups;
+            if (host == "bad.host") {
+                throw std::runtime_error("Failed to resolve hostname: " + host);
+            }
+            return std::vector<socket_address>{socket_address("127.0.0.1", 0)};
+        };
+    }
+
+    // Poll until the condition holds or two seconds pass
+    template <typename Predicate>
+    static bool wait_for(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    std::atomic<int> lookups{0};
+};
+
+TEST_F(DnsResolverTest, CachesLookups) {
+    dns_resolver resolver;
+    resolver.set_lookup(counting_lookup());
+
+    const socket_address first = resolver.resolve("service.test", 8080);
+    EXPECT_EQ(first.host(), "127.0.0.1");
+    EXPECT_EQ(first.port(), 8080);
+
+    // Same name, different port: answered from the cache
+    const socket_address second = resolver.resolve("service.test", 9090);
+    EXPECT_EQ(second.port(), 9090);
+    EXPECT_EQ(lookups.load(), 1);
+    EXPECT_EQ(resolver.cache_misses(), 1u);
+    EXPECT_EQ(resolver.cache_hits(), 1u);
+    EXPECT_EQ(resolver.cached_hosts(), 1u);
+
+    resolver.invalidate("service.test");
+    EXPECT_EQ(resolver.cached_hosts(), 0u);
+    resolver.resolve("service.test", 8080);
+    EXPECT_EQ(lookups.load(), 2);
+}
+
+TEST_F(DnsResolverTest, NegativeCaching) {
+    dns_resolver resolver(std::chrono::seconds(60), std::chrono::milliseconds(50));
+    resolver.set_lookup(counting_lookup());
+
+    EXPECT_THROW(resolver.resolve("bad.host", 80), std::runtime_error);
+    EXPECT_THROW(resolver.resolve("bad.host", 80), std::runtime_error);
+    EXPECT_EQ(lookups.load(), 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    EXPECT_THROW(resolver.resolve("bad.host", 80), std::runtime_error);
+    EXPECT_EQ(lookups.load(), 2);
+}
+
+TEST_F(DnsResolverTest, RefreshesUsedEntriesAhead) {
+    dns_resolver resolver(std::chrono::milliseconds(100));
+    resolver.set_lookup(counting_lookup());
+
+    resolver.resolve("hot.test", 80);
+    resolver.resolve("hot.test", 80);   // Marks the entry as used
+    resolver.resolve("cold.test", 80);  // Never used again
+
+    ASSERT_TRUE(wait_for([&]() { return resolver.refreshes() >= 1; }));
+
+    // The hot entry was refreshed in the background: no caller-side miss
+    const auto misses = resolver.cache_misses();
+    resolver.resolve("hot.test", 80);
+    EXPECT_EQ(resolver.cache_misses(), misses);
+
+    // The cold entry expired and was evicted
+    ASSERT_TRUE(wait_for([&]() { return resolver.cached_hosts() == 1; }));
+}
+
+TEST_F(DnsResolverTest, ResolveAsync) {
+    dns_resolver resolver;
+    resolver.set_lookup(counting_lookup());
+
+    auto first = resolver.resolve_async("async.test", 7000);
+    auto second = resolver.resolve_async("async.test", 7001);
+    EXPECT_EQ(first.get().port(), 7000);
+    EXPECT_EQ(second.get().port(), 7001);
+
+    // Cache hit completes immediately
+    auto cached = resolver.resolve_async("async.test", 7002);
+    EXPECT_EQ(cached.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(cached.get().port(), 7002);
+    EXPECT_LE(lookups.load(), 2);
+
+    auto failed = resolver.resolve_async("bad.host", 7000);
+    EXPECT_THROW(failed.get(), std::runtime_error);
+
+    resolver.prefetch("warm.test");
+    ASSERT_TRUE(wait_for([&]() { return resolver.cached_hosts() == 3; }));
+}
+
+TEST_F(DnsResolverTest, SystemLookupNumericHost) {
+    const auto addresses = dns_resolver::system_lookup("127.0.0.1", socket_address::IPv4);
+    ASSERT_EQ(addresses.size(), 1u);
+    EXPECT_EQ(addresses.front().host(), "127.0.0.1");
+    EXPECT_EQ(addresses.front().port(), 0);
+}
+
+TEST_F(DnsResolverTest, TcpClientReconnectUsesCache) {
+    server_socket listener(socket_address::Family::IPv4);
+    listener.bind(socket_address("127.0.0.1", 0));
+    listener.listen();
+    const std::uint16_t port = listener.address().port();
+
+    dns_resolver resolver;
+    resolver.set_lookup(counting_lookup());
+
+    for (int i = 0; i < 3; ++i) {
+        tcp_client client(socket_address::IPv4);
+        client.connect("service.test", port, std::chrono::seconds(2), resolver);
+        EXPECT_TRUE(client.is_connected());
+        tcp_client peer = listener.accept_connection(std::chrono::seconds(2));
+    }
+    EXPECT_EQ(lookups.load(), 1);
+    EXPECT_EQ(resolver.cache_hits(), 2u);
+
+    EXPECT_THROW(tcp_client().connect("bad.host", port, std::chrono::seconds(2), resolver),
+                 std::runtime_error);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <fb/framed_connection.h>
+#include <fb/server_socket.h>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+class FramedConnectionTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        listener = server_socket(socket_address::Family::IPv4);
+        listener.bind(socket_address("127.0.0.1", 0));
+        listener.listen();
+
+        client = tcp_client(listener.address(), std::chrono::seconds(2));
+        peer = listener.accept_connection(std::chrono::seconds(2));
+        client.set_receive_timeout(std::chrono::seconds(2));
+        peer.set_receive_timeout(std::chrono::seconds(2));
+    }
+
+    static std::string encode(const std::string& payload)
+    {
+        const auto length = payload.size();
+        std::string frame;
+        frame.push_back(static_cast<char>((length >> 24) & 0xFF));
+        frame.push_back(static_cast<char>((length >> 16) & 0xFF));
+        frame.push_back(static_cast<char>((length >> 8) & 0xFF));
+        frame.push_back(static_cast<char>(length & 0xFF));
+        return frame + payload;
+    }
+
+    server_socket listener;
+    tcp_client client{INVALID_SOCKET_VALUE};
+    tcp_client peer{INVALID_SOCKET_VALUE};
+};
+
+TEST_F(FramedConnectionTest, BatchesFramesPerReceive) {
+    const int count = 200;
+    std::string wire;
+    for (int i = 0; i < count; ++i) {
+        wire += encode("message " + std::to_string(i));
+    }
+    peer.send_bytes_all(wire.data(), static_cast<int>(wire.size()));
+
+    framed_connection framed(client);
+    std::vector<std::string> frames;
+    while (frames.size() < static_cast<std::size_t>(count)) {
+        framed.receive_frames([&](std::string_view frame) {
+            frames.emplace_back(frame);
+        });
+        ASSERT_FALSE(framed.eof());
+    }
+
+    ASSERT_EQ(frames.size(), static_cast<std::size_t>(count));
+    EXPECT_EQ(frames.front(), "message 0");
+    EXPECT_EQ(frames.back(), "message 199");
+    EXPECT_EQ(framed.frames_received(), static_cast<std::uint64_t>(count));
+    EXPECT_LT(framed.receive_calls(), static_cast<std::uint64_t>(count / 10));
+}
+
+TEST_F(FramedConnectionTest, ReassemblesSplitFrames) {
+    const std::string payload(1000, 'x');
+    const std::string wire = encode(payload) + encode("");
+
+    std::thread writer([&]() {
+        // Dribble the bytes out so header and body arrive in pieces
+        for (std::size_t offset = 0; offset < wire.size(); offset += 300) {
+            const auto chunk = std::min<std::size_t>(300, wire.size() - offset);
+            peer.send_bytes_all(wire.data() + offset, static_cast<int>(chunk));
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        peer.shutdown_send();
+    });
+
+    // Start with a buffer smaller than the frame so it has to grow
+    framed_connection framed(client, 64);
+    std::string_view frame;
+    ASSERT_TRUE(framed.read_frame(frame));
+    EXPECT_EQ(frame, payload);
+    EXPECT_GE(framed.buffer_capacity(), payload.size() + framed_connection::HEADER_SIZE);
+
+    ASSERT_TRUE(framed.read_frame(frame));
+    EXPECT_TRUE(frame.empty());
+
+    EXPECT_FALSE(framed.read_frame(frame));
+    EXPECT_TRUE(framed.eof());
+    writer.join();
+}
+
+TEST_F(FramedConnectionTest, FramesAcrossTheWrapPoint) {
+    // Odd-sized frames through a small buffer keep landing across its end
+    const int count = 100;
+    std::string wire;
+    for (int i = 0; i < count; ++i) {
+        wire += encode(std::string(97 + static_cast<std::size_t>(i), static_cast<char>('a' + i % 26)));
+    }
+    std::thread writer([&]() {
+        peer.send_bytes_all(wire.data(), static_cast<int>(wire.size()));
+        peer.shutdown_send();
+    });
+
+    framed_connection framed(client, 64);
+    const std::size_t capacity = framed.buffer_capacity();
+    std::string_view frame;
+    for (int i = 0; i < count; ++i) {
+        ASSERT_TRUE(framed.read_frame(frame));
+        ASSERT_EQ(frame, std::string(97 + static_cast<std::size_t>(i), static_cast<char>('a' + i % 26)));
+    }
+    EXPECT_FALSE(framed.read_frame(frame));
+    EXPECT_EQ(framed.buffer_capacity(), capacity);
+    writer.join();
+}
+
+TEST_F(FramedConnectionTest, SendAndQueueFrames) {
+    framed_connection sender(client);
+    framed_connection receiver(peer);
+
+    sender.send_frame("first");
+    sender.queue_frame("second");
+    sender.queue_frame("");
+    EXPECT_EQ(sender.queued_bytes(), 2 * framed_connection::HEADER_SIZE + 6);
+    sender.send_frame("third");  // Goes out after the queued frames
+    EXPECT_EQ(sender.queued_bytes(), 0u);
+
+    std::vector<std::string> frames;
+    std::string_view frame;
+    while (frames.size() < 4 && receiver.read_frame(frame)) {
+        frames.emplace_back(frame);
+    }
+    EXPECT_EQ(frames, (std::vector<std::string>{"first", "second", "", "third"}));
+}
+
+TEST_F(FramedConnectionTest, RejectsOversizedFrames) {
+    framed_connection framed(client, 64, 16);
+    EXPECT_THROW(framed.send_frame(std::string(17, 'x')), std::invalid_argument);
+    EXPECT_THROW(framed.queue_frame(std::string(17, 'x')), std::invalid_argument);
+
+    const std::string wire = encode(std::string(32, 'y'));
+    peer.send_bytes_all(wire.data(), static_cast<int>(wire.size()));
+
+    std::string_view frame;
+    try {
+        framed.read_frame(frame);
+        FAIL() << "Expected std::system_error";
+    } catch (const std::system_error& ex) {
+        EXPECT_EQ(ex.code(), std::make_error_code(std::errc::message_size));
+    }
+}
+
+TEST_F(FramedConnectionTest, PeerClosesInsideFrame) {
+    const std::string wire = encode("truncated").substr(0, 7);
+    peer.send_bytes_all(wire.data(), static_cast<int>(wire.size()));
+    peer.shutdown_send();
+
+    framed_connection framed(client);
+    std::string_view frame;
+    EXPECT_THROW(framed.read_frame(frame), std::system_error);
+    EXPECT_TRUE(framed.eof());
+}
+
+TEST_F(FramedConnectionTest, InvalidConstruction) {
+    EXPECT_THROW(framed_connection(client, framed_connection::HEADER_SIZE - 1),
+                 std::invalid_argument);
+    EXPECT_THROW(framed_connection(client, 64, 0), std::invalid_argument);
+}
@@ -0,0 +1,339 @@
+#include <gtest/gtest.h>
+#include <fb/http_server.h>
+#include <fb/tcp_client.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+class HTTPServerTest : public ::testing::Test
+{
+protected:
+    struct reply
+    {
+        int status = 0;
+        std::string head;
+        std::string body;
+    };
+
+    void start(http_server::request_handler handler)
+    {
+        server_socket listener(socket_address::Family::IPv4);
+        listener.bind(socket_address("127.0.0.1", 0));
+        listener.listen();
+        address = listener.address();
+        server.set_server_socket(std::move(listener));
+        server.set_handler(std::move(handler), 2);
+        server.start();
+    }
+
+    tcp_client connect()
+    {
+        tcp_client client(socket_address::Family::IPv4);
+        client.connect(address, std::chrono::seconds(2));
+        client.set_receive_timeout(std::chrono::seconds(2));
+        return client;
+    }
+
+    // Read until @p count complete responses have arrived
+    static std::vector<reply> read_responses(tcp_client& client, std::size_t count)
+    {
+        std::vector<reply> responses;
+        std::string data;
+        char buffer[4096];
+        while (responses.size() < count) {
+            const std::size_t head_end = data.find("\r\n\r\n");
+            if (head_end != std::string::npos) {
+                reply r;
+                r.head = data.substr(0, head_end + 4);
+                r.status = std::stoi(r.head.substr(9, 3));
+                std::size_t length = 0;
+                const std::size_t field = r.head.find("Content-Length: ");
+                if (field != std::string::npos) {
+                    length = std::stoul(r.head.substr(field + 16));
+                }
+                if (data.size() >= head_end + 4 + length) {
+                    r.body = data.substr(head_end + 4, length);
+                    data.erase(0, head_end + 4 + length);
+                    responses.push_back(r);
+                    continue;
+                }
+            }
+            const int n = client.receive_bytes(buffer, sizeof(buffer));
+            if (n <= 0) {
+                break;
+            }
+            data.append(buffer, static_cast<std::size_t>(n));
+        }
+        return responses;
+    }
+
+    // True once the server has closed the connection
+    static bool closed_by_server(tcp_client& client)
+    {
+        char byte;
+        try {
+            return client.receive_bytes(&byte, 1) == 0;
+        } catch (const std::system_error&) {
+            return true;
+        }
+    }
+
+    static void echo_path(const http_request& request, http_response& response)
+    {
+        response.set_content_type("text/plain");
+        response.set_body(request.path);
+    }
+
+    http_server server;
+    socket_address address;
+};
+
+TEST_F(HTTPServerTest, ServesGetWithStandardHeaders) {
+    start(echo_path);
+    tcp_client client = connect();
+
+    client.send("GET /metrics HTTP/1.1\r\nHost: test\r\n\r\n");
+    const auto responses = read_responses(client, 1);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].status, 200);
+    EXPECT_EQ(responses[0].body, "/metrics");
+    EXPECT_EQ(responses[0].head.rfind("HTTP/1.1 200 OK\r\n", 0), 0u);
+    EXPECT_NE(responses[0].head.find("\r\nServer: fb_net\r\n"), std::string::npos);
+    EXPECT_NE(responses[0].head.find("\r\nDate: "), std::string::npos);
+    EXPECT_NE(responses[0].head.find("\r\nContent-Type: text/plain\r\n"), std::string::npos);
+    EXPECT_EQ(responses[0].head.find("Connection:"), std::string::npos);
+    EXPECT_EQ(server.total_requests(), 1u);
+}
+
+TEST_F(HTTPServerTest, PipelinedRequestsAreAnsweredInOrder) {
+    start(echo_path);
+    tcp_client client = connect();
+
+    std::string batch;
+    for (int i = 0; i < 20; ++i) {
+        batch += "GET /r" + std::to_string(i) + " HTTP/1.1\r\nHost: test\r\n\r\n";
+    }
+    client.send(batch);
+
+    const auto responses = read_responses(client, 20);
+    ASSERT_EQ(responses.size(), 20u);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(responses[static_cast<std::size_t>(i)].body, "/r" + std::to_string(i));
+    }
+
+    // The connection is still usable afterwards
+    client.send("GET /again HTTP/1.1\r\n\r\n");
+    const auto again = read_responses(client, 1);
+    ASSERT_EQ(again.size(), 1u);
+    EXPECT_EQ(again[0].body, "/again");
+}
+
+TEST_F(HTTPServerTest, RequestSplitAcrossReads) {
+    start([](const http_request& request, http_response& response) {
+        response.set_body(std::string(request.method) + " " + std::string(request.body));
+    });
+    tcp_client client = connect();
+
+    const std::string request =
+        "POST /submit HTTP/1.1\r\nContent-Length: 11\r\n\r\nhello world";
+    for (char c : request) {
+        client.send(std::string(1, c));
+    }
+    const auto responses = read_responses(client, 1);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].body, "POST hello world");
+}
+
+TEST_F(HTTPServerTest, ExpectContinueIsAcknowledged) {
+    start([](const http_request& request, http_response& response) {
+        response.set_body(request.body);
+    });
+    tcp_client client = connect();
+
+    client.send("PUT /x HTTP/1.1\r\nContent-Length: 4\r\nExpect: 100-continue\r\n\r\n");
+    char buffer[64];
+    const int n = client.receive_bytes(buffer, sizeof(buffer));
+    ASSERT_GT(n, 0);
+    EXPECT_EQ(std::string(buffer, static_cast<std::size_t>(n)), "HTTP/1.1 100 Continue\r\n\r\n");
+
+    client.send("data");
+    const auto responses = read_responses(client, 1);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].body, "data");
+}
+
+TEST_F(HTTPServerTest, ParsesTargetAndHeaders) {
+    start([](const http_request& request, http_response& response) {
+        response.set_body(std::string(request.path) + "|" + std::string(request.query) + "|" +
+                          std::string(request.header("x-probe")) + "|" +
+                          std::to_string(request.headers.size()));
+        response.add_header("X-Reply", "yes");
+    });
+    tcp_client client = connect();
+
+    client.send("GET /stats?view=all HTTP/1.1\r\nX-Probe:  value \r\nHost: t\r\n\r\n");
+    const auto responses = read_responses(client, 1);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].body, "/stats|view=all|value|2");
+    EXPECT_NE(responses[0].head.find("\r\nX-Reply: yes\r\n"), std::string::npos);
+}
+
+TEST_F(HTTPServerTest, ConnectionCloseAndHttp10) {
+    start(echo_path);
+
+    tcp_client closing = connect();
+    closing.send("GET /a HTTP/1.1\r\nConnection: close\r\n\r\n");
+    auto responses = read_responses(closing, 1);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_NE(responses[0].head.find("\r\nConnection: close\r\n"), std::string::npos);
+    EXPECT_TRUE(closed_by_server(closing));
+
+    tcp_client legacy = connect();
+    legacy.send("GET /b HTTP/1.0\r\n\r\n");
+    responses = read_responses(legacy, 1);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].body, "/b");
+    EXPECT_TRUE(closed_by_server(legacy));
+
+    tcp_client persistent = connect();
+    persistent.send("GET /c HTTP/1.0\r\nConnection: keep-alive\r\n\r\nGET /d HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+    responses = read_responses(persistent, 2);
+    ASSERT_EQ(responses.size(), 2u);
+    EXPECT_NE(responses[0].head.find("\r\nConnection: keep-alive\r\n"), std::string::npos);
+    EXPECT_EQ(responses[1].body, "/d");
+}
+
+TEST_F(HTTPServerTest, HeadOmitsBody) {
+    start([](const http_request&, http_response& response) {
+        response.set_body("0123456789");
+    });
+    tcp_client client = connect();
+
+    client.send("HEAD / HTTP/1.1\r\n\r\nGET / HTTP/1.1\r\n\r\n");
+    char buffer[4096];
+    std::string data;
+    while (data.find("0123456789") == std::string::npos) {
+        const int n = client.receive_bytes(buffer, sizeof(buffer));
+        ASSERT_GT(n, 0);
+        data.append(buffer, static_cast<std::size_t>(n));
+    }
+    // Two heads with Content-Length 10, one body
+    const std::size_t second = data.find("HTTP/1.1", 1);
+    ASSERT_NE(second, std::string::npos);
+    EXPECT_NE(data.substr(0, second).find("Content-Length: 10\r\n\r\n"), std::string::npos);
+    EXPECT_EQ(data.substr(0, second).find("0123456789"), std::string::npos);
+}
+
+TEST_F(HTTPServerTest, RejectsMalformedAndOversizedRequests) {
+    server.set_max_header_size(256);
+    server.set_max_body_size(16);
+    std::atomic<int> handled{0};
+    start([&](const http_request&, http_response&) { ++handled; });
+
+    const std::pair<std::string, int> cases[] = {
+        {"NONSENSE\r\n\r\n", 400},
+        {"GET / HTTP/2.0\r\n\r\n", 505},
+        {"GET / HTTP/1.1\r\nBad Header: x\r\n\r\n", 400},
+        {"GET / HTTP/1.1\r\nX-Big: " + std::string(300, 'a') + "\r\n\r\n", 431},
+        {"POST / HTTP/1.1\r\nContent-Length: 17\r\n\r\n", 413},
+        {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n", 501},
+        {"POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\nab", 400},
+    };
+    for (const auto& [request, status] : cases) {
+        tcp_client client = connect();
+        client.send(request);
+        const auto responses = read_responses(client, 1);
+        ASSERT_EQ(responses.size(), 1u) << request;
+        EXPECT_EQ(responses[0].status, status) << request;
+        EXPECT_NE(responses[0].head.find("Connection: close"), std::string::npos);
+        EXPECT_TRUE(closed_by_server(client));
+    }
+    EXPECT_EQ(handled.load(), 0);
+    EXPECT_EQ(server.rejected_requests(), std::size(cases));
+}
+
+TEST_F(HTTPServerTest, HandlerExceptionBecomes500) {
+    std::atomic<int> reported{0};
+    server.onException.connect([&](const std::exception&, const std::string& context) {
+        if (context == "http_handler") {
+            ++reported;
+        }
+    });
+    start([](const http_request& request, http_response& response) {
+        if (request.path == "/fail") {
+            response.set_body("partial");
+            throw std::runtime_error("boom");
+        }
+        response.set_body("fine");
+    });
+    tcp_client client = connect();
+
+    client.send("GET /fail HTTP/1.1\r\n\r\nGET /ok HTTP/1.1\r\n\r\n");
+    const auto responses = read_responses(client, 2);
+    ASSERT_EQ(responses.size(), 2u);
+    EXPECT_EQ(responses[0].status, 500);
+    EXPECT_TRUE(responses[0].body.empty());
+    EXPECT_EQ(responses[1].body, "fine");
+    EXPECT_EQ(server.handler_errors(), 1u);
+    EXPECT_EQ(reported.load(), 1);
+}
+
+TEST_F(HTTPServerTest, ConfigurationRules) {
+    EXPECT_THROW(server.start(), std::runtime_error);
+    EXPECT_THROW(server.set_server_name("bad\r\nname"), std::invalid_argument);
+
+    http_response response;
+    EXPECT_THROW(response.set_status(42), std::invalid_argument);
+    EXPECT_THROW(response.add_header("Bad Name", "x"), std::invalid_argument);
+    EXPECT_THROW(response.add_header("X-Ok", "line\r\nbreak"), std::invalid_argument);
+
+    server.set_server_name("");
+    start(echo_path);
+    EXPECT_THROW(server.set_max_body_size(1), std::runtime_error);
+
+    tcp_client client = connect();
+    client.send("GET / HTTP/1.1\r\n\r\n");
+    const auto responses = read_responses(client, 1);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].head.find("Server:"), std::string::npos);
+}
+
+TEST_F(HTTPServerTest, ServesMetricsRegistry) {
+    metrics_registry registry;
+    registry.counter("orders_total", "Orders seen").add(3);
+    const auto registration = server.register_metrics(registry, "admin_http");
+
+    start([&registry](const http_request& request, http_response& response) {
+        if (!serve_metrics(request, response, registry)) {
+            response.set_status(404);
+        }
+    });
+    tcp_client client = connect();
+
+    client.send("GET /metrics HTTP/1.1\r\n\r\n"
+                "GET /metrics.json HTTP/1.1\r\n\r\n"
+                "POST /metrics HTTP/1.1\r\nContent-Length: 0\r\n\r\n"
+                "GET /other HTTP/1.1\r\n\r\n");
+    const auto responses = read_responses(client, 4);
+    ASSERT_EQ(responses.size(), 4u);
+
+    EXPECT_EQ(responses[0].status, 200);
+    EXPECT_NE(responses[0].head.find("Content-Type: text/plain; version=0.0.4"), std::string::npos);
+    EXPECT_NE(responses[0].body.find("# TYPE orders_total counter\norders_total 3\n"), std::string::npos);
+    EXPECT_NE(responses[0].body.find("# TYPE admin_http_requests_total counter\n"), std::string::npos);
+
+    EXPECT_EQ(responses[1].status, 200);
+    EXPECT_NE(responses[1].head.find("Content-Type: application/json"), std::string::npos);
+    EXPECT_NE(responses[1].body.find("\"orders_total\":{\"type\":\"counter\",\"help\":\"Orders seen\",\"value\":3}"),
+              std::string::npos);
+
+    EXPECT_EQ(responses[2].status, 405);
+    EXPECT_NE(responses[2].head.find("\r\nAllow: GET\r\n"), std::string::npos);
+    EXPECT_EQ(responses[3].status, 404);
+    server.stop();
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <fb/io_ring.h>
+#include <fb/poll_set.h>
+#include <fb/server_socket.h>
+#include <fb/tcp_client.h>
+#include <fb/udp_socket.h>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+#ifdef __linux__
+
+class IoRingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {
+        if (!io_ring::supported()) {
+            GTEST_SKIP() << "io_uring not available";
+        }
+    }
+    void TearDown() override {}
+
+    // Collect completions until `count` have arrived or the deadline passes.
+    static std::vector<io_completion> collect(io_ring& ring, size_t count) {
+        std::vector<io_completion> all;
+        std::vector<io_completion> batch;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (all.size() < count && std::chrono::steady_clock::now() < deadline) {
+            ring.wait(batch, std::chrono::milliseconds(100));
+            all.insert(all.end(), batch.begin(), batch.end());
+        }
+        return all;
+    }
+};
+
+TEST_F(IoRingTest, ConstructionAndTimeout) {
+    io_ring ring(8);
+    EXPECT_GE(ring.entries(), 8u);
+    EXPECT_EQ(ring.pending(), 0u);
+    EXPECT_EQ(ring.in_flight(), 0u);
+
+    std::vector<io_completion> completions;
+    EXPECT_EQ(ring.wait(completions, std::chrono::milliseconds(10)), 0);
+    EXPECT_TRUE(completions.empty());
+
+    EXPECT_THROW(io_ring(0), std::invalid_argument);
+}
+
+TEST_F(IoRingTest, BatchedDatagramReceive) {
+    udp_socket receiver(socket_address::Family::IPv4);
+    receiver.bind(socket_address("127.0.0.1", 0));
+    udp_socket sender(socket_address::Family::IPv4);
+    sender.bind(socket_address("127.0.0.1", 0));
+
+    io_ring ring;
+    char buffers[4][64];
+    udp_receive_entry entries[4];
+    for (int i = 0; i < 4; ++i) {
+        entries[i].buffer = buffers[i];
+        entries[i].capacity = sizeof(buffers[i]);
+        ring.submit_receive_from(receiver, entries[i], static_cast<uint64_t>(i));
+    }
+    EXPECT_EQ(ring.pending(), 4u);
+    EXPECT_EQ(ring.submit(), 4u);
+    EXPECT_EQ(ring.in_flight(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        sender.send_to("msg" + std::to_string(i), receiver.address());
+    }
+
+    auto completions = collect(ring, 4);
+    ASSERT_EQ(completions.size(), 4u);
+    EXPECT_EQ(ring.in_flight(), 0u);
+
+    int total = 0;
+    for (const auto& completion : completions) {
+        ASSERT_LT(completion.user_data, 4u);
+        const auto& entry = entries[completion.user_data];
+        EXPECT_EQ(completion.result, 4);
+        EXPECT_EQ(entry.length, 4u);
+        EXPECT_EQ(std::string(static_cast<char*>(entry.buffer), 3), "msg");
+        EXPECT_EQ(entry.sender.port(), sender.address().port());
+        total += completion.result;
+    }
+    EXPECT_EQ(total, 16);
+}
+
+TEST_F(IoRingTest, AcceptSendReceive) {
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0), true);
+    server.listen();
+
+    io_ring ring;
+    ring.submit_accept(server, 1);
+    ring.submit();
+
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server.address(), std::chrono::seconds(2));
+
+    auto accepted = collect(ring, 1);
+    ASSERT_EQ(accepted.size(), 1u);
+    EXPECT_EQ(accepted[0].user_data, 1u);
+    ASSERT_GE(accepted[0].result, 0);
+    tcp_client peer(accepted[0].result);
+
+    const char message[] = "hello";
+    char received[16] = {};
+    ring.submit_send(client, message, 5, 2);
+    ring.submit_receive(peer, received, sizeof(received), 3);
+
+    auto completions = collect(ring, 2);
+    ASSERT_EQ(completions.size(), 2u);
+    for (const auto& completion : completions) {
+        EXPECT_EQ(completion.result, 5);
+    }
+    EXPECT_EQ(std::string(received, 5), "hello");
+}
+
+TEST_F(IoRingTest, PollReportsReadiness) {
+    udp_socket receiver(socket_address::Family::IPv4);
+    receiver.bind(socket_address("127.0.0.1", 0));
+    udp_socket sender(socket_address::Family::IPv4);
+
+    io_ring ring;
+    ring.submit_poll(receiver, poll_set::POLL_READ, 7);
+
+    std::vector<io_completion> completions;
+    EXPECT_EQ(ring.wait(completions, std::chrono::milliseconds(50)), 0);
+
+    sender.send_to("x", receiver.address());
+    completions = collect(ring, 1);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].user_data, 7u);
+    EXPECT_EQ(completions[0].result, poll_set::POLL_READ);
+}
+
+TEST_F(IoRingTest, FixedBuffers) {
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0), true);
+    server.listen();
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server.address(), std::chrono::seconds(2));
+    socket_address peer_address;
+    tcp_client peer = server.accept_connection(peer_address);
+
+    std::vector<char> out(32, 'a');
+    std::vector<char> in(32, 0);
+    io_buffer buffers[2] = {{out.data(), out.size()}, {in.data(), in.size()}};
+
+    io_ring ring;
+    try {
+        ring.register_buffers(buffers, 2);
+    } catch (const std::system_error& ex) {
+        GTEST_SKIP() << "buffer registration unavailable: " << ex.what();
+    }
+
+    ring.submit_send_fixed(client, 0, 32, 10);
+    ring.submit_receive_fixed(peer, 1, 32, 11);
+    auto completions = collect(ring, 2);
+    ASSERT_EQ(completions.size(), 2u);
+    for (const auto& completion : completions) {
+        EXPECT_EQ(completion.result, 32);
+    }
+    EXPECT_EQ(in, out);
+
+    EXPECT_THROW(ring.submit_send_fixed(client, 2, 1, 12), std::invalid_argument);
+    EXPECT_THROW(ring.submit_receive_fixed(peer, 1, 33, 13), std::invalid_argument);
+    ring.unregister_buffers();
+    EXPECT_THROW(ring.submit_send_fixed(client, 0, 1, 14), std::invalid_argument);
+}
+
+TEST_F(IoRingTest, ErrorsReportedAsNegativeErrno) {
+    udp_socket receiver(socket_address::Family::IPv4);
+    receiver.bind(socket_address("127.0.0.1", 0));
+
+    io_ring ring;
+    char buffer[8];
+    ring.submit_receive(receiver, buffer, sizeof(buffer), 5, MSG_DONTWAIT);
+    auto completions = collect(ring, 1);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].result, -EAGAIN);
+
+    udp_receive_entry empty;
+    EXPECT_THROW(ring.submit_receive_from(receiver, empty, 6), std::invalid_argument);
+}
+
+#else
+
+TEST(IoRingTest, UnsupportedPlatform) {
+    EXPECT_FALSE(io_ring::supported());
+    EXPECT_THROW(io_ring ring, std::system_error);
+}
+
+#endif
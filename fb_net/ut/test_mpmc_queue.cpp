@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <fb/mpmc_queue.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+class MpmcQueueTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(MpmcQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    mpmc_queue<int> queue(100);
+    EXPECT_EQ(queue.capacity(), 128u);
+    EXPECT_TRUE(queue.empty_approx());
+    EXPECT_EQ(mpmc_queue<int>(1).capacity(), 2u);
+
+    EXPECT_THROW(mpmc_queue<int>(0), std::invalid_argument);
+}
+
+TEST_F(MpmcQueueTest, FifoOrderAndFullQueue) {
+    mpmc_queue<int> queue(4);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(99));
+    EXPECT_EQ(queue.size_approx(), 4u);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST_F(MpmcQueueTest, FailedPushLeavesItemIntact) {
+    mpmc_queue<std::unique_ptr<int>> queue(2);
+
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(1)));
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(3)));
+
+    auto item = std::make_unique<int>(2);
+    EXPECT_FALSE(queue.try_push(std::move(item)));
+    ASSERT_NE(item, nullptr);
+    EXPECT_EQ(*item, 2);
+}
+
+TEST_F(MpmcQueueTest, WaitPopWakesParkedConsumer) {
+    mpmc_queue<int> queue(8);
+    std::atomic<int> received{-1};
+
+    std::thread consumer([&]() {
+        int value = 0;
+        if (queue.wait_pop(value, std::chrono::milliseconds(5000), [] { return false; })) {
+            received = value;
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(queue.try_push(42));
+    consumer.join();
+
+    EXPECT_EQ(received.load(), 42);
+}
+
+TEST_F(MpmcQueueTest, WaitPopHonoursStopPredicate) {
+    mpmc_queue<int> queue(8, 100);
+    std::atomic<bool> stop{false};
+    std::atomic<bool> result{true};
+
+    std::thread consumer([&]() {
+        int value = 0;
+        result = queue.wait_pop(value, std::chrono::milliseconds(5000),
+                                [&] { return stop.load(); });
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stop = true;
+    queue.notify_all();
+    consumer.join();
+
+    EXPECT_FALSE(result.load());
+}
+
+TEST_F(MpmcQueueTest, ConcurrentProducersAndConsumers) {
+    mpmc_queue<int> queue(64, 32);
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 5000;
+
+    std::atomic<long long> sum{0};
+    std::atomic<int> consumed{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            int value = 0;
+            while (!done.load() || !queue.empty_approx()) {
+                if (queue.wait_pop(value, std::chrono::milliseconds(10), [&] { return done.load(); })) {
+                    sum += value;
+                    consumed++;
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p < producers; ++p) {
+        producer_threads.emplace_back([&]() {
+            for (int i = 1; i <= per_producer; ++i) {
+                while (!queue.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : producer_threads) {
+        thread.join();
+    }
+    while (consumed.load() < producers * per_producer) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    done = true;
+    queue.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const long long expected = static_cast<long long>(producers) * per_producer * (per_producer + 1) / 2;
+    EXPECT_EQ(consumed.load(), producers * per_producer);
+    EXPECT_EQ(sum.load(), expected);
+}
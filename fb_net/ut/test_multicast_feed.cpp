@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <fb/multicast_feed.h>
+#include <fb/udp_socket.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace fb;
+
+// The lines are unicast loopback sockets: arbitration only depends on the
+// sequence numbers, not on how the datagrams were addressed.
+class MulticastFeedTest : public ::testing::Test
+{
+protected:
+    static udp_socket open_loopback_line()
+    {
+        udp_socket socket(socket_address::Family::IPv4);
+        socket.bind(socket_address("127.0.0.1", 0));
+        return socket;
+    }
+
+    static std::string encode(std::uint64_t sequence, const std::string& payload = "tick")
+    {
+        std::string datagram(8, '\0');
+        for (int i = 7; i >= 0; --i) {
+            datagram[static_cast<std::size_t>(i)] = static_cast<char>(sequence & 0xFF);
+            sequence >>= 8;
+        }
+        return datagram + payload;
+    }
+
+    void send(const socket_address& line, std::uint64_t sequence)
+    {
+        const std::string datagram = encode(sequence);
+        sender.send_to(datagram.data(), static_cast<int>(datagram.size()), line);
+    }
+
+    template <typename Predicate>
+    static bool wait_for(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        return true;
+    }
+
+    udp_socket sender{socket_address::Family::IPv4};
+    std::mutex mutex;
+    std::vector<std::uint64_t> sequences;
+    std::vector<bool> recovered;
+
+    multicast_feed::message_handler recorder()
+    {
+        return [this](const multicast_feed::message& msg) {
+            std::lock_guard<std::mutex> lock(mutex);
+            sequences.push_back(msg.sequence);
+            recovered.push_back(msg.recovered);
+        };
+    }
+};
+
+TEST_F(MulticastFeedTest, FirstCopyWins) {
+    udp_socket line_a = open_loopback_line();
+    udp_socket line_b = open_loopback_line();
+    const socket_address address_a = line_a.address();
+    const socket_address address_b = line_b.address();
+
+    multicast_feed feed(std::move(line_a), std::move(line_b), recorder());
+    feed.start();
+
+    const std::uint64_t count = 100;
+    for (std::uint64_t seq = 1; seq <= count; ++seq) {
+        send(address_a, seq);
+        send(address_b, seq);
+    }
+
+    ASSERT_TRUE(wait_for([&]() { return feed.delivered() + feed.duplicates() == 2 * count; }));
+    feed.stop();
+
+    EXPECT_EQ(feed.delivered(), count);
+    EXPECT_EQ(feed.duplicates(), count);
+    EXPECT_EQ(feed.gaps(), 0u);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(sequences.size(), count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        EXPECT_EQ(sequences[i], i + 1);
+    }
+}
+
+TEST_F(MulticastFeedTest, GapReportedAndRecoveredFromOtherLine) {
+    udp_socket line_a = open_loopback_line();
+    udp_socket line_b = open_loopback_line();
+    const socket_address address_a = line_a.address();
+    const socket_address address_b = line_b.address();
+
+    multicast_feed feed(std::move(line_a), std::move(line_b), recorder());
+    std::vector<std::tuple<std::uint32_t, std::uint64_t, std::uint64_t>> gaps;
+    feed.onGap.connect([&](std::uint32_t channel, std::uint64_t first, std::uint64_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        gaps.emplace_back(channel, first, count);
+    });
+    feed.start();
+
+    // Line A loses 4 and 5
+    for (std::uint64_t seq : std::vector<std::uint64_t>{1, 2, 3, 6, 7}) {
+        send(address_a, seq);
+    }
+    ASSERT_TRUE(wait_for([&]() { return feed.delivered() == 5; }));
+
+    // Line B, running behind, still has them
+    for (std::uint64_t seq : std::vector<std::uint64_t>{4, 5, 6}) {
+        send(address_b, seq);
+    }
+    ASSERT_TRUE(wait_for([&]() { return feed.delivered() + feed.duplicates() == 8; }));
+    feed.stop();
+
+    EXPECT_EQ(feed.gaps(), 1u);
+    EXPECT_EQ(feed.missing(), 2u);
+    EXPECT_EQ(feed.recovered(), 2u);
+    EXPECT_EQ(feed.duplicates(), 1u);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(gaps.size(), 1u);
+    EXPECT_EQ(gaps[0], std::make_tuple(0u, std::uint64_t{4}, std::uint64_t{2}));
+    EXPECT_EQ(sequences, (std::vector<std::uint64_t>{1, 2, 3, 6, 7, 4, 5}));
+    EXPECT_EQ(recovered, (std::vector<bool>{false, false, false, false, false, true, true}));
+}
+
+TEST_F(MulticastFeedTest, ChannelsWithCustomDecoder) {
+    udp_socket line_a = open_loopback_line();
+    const socket_address address_a = line_a.address();
+
+    std::atomic<int> per_channel[4] = {};
+    multicast_feed feed(std::move(line_a), [&](const multicast_feed::message& msg) {
+        ++per_channel[msg.channel];
+    });
+
+    // Datagram: 1 byte channel, then the default 8-byte sequence
+    feed.set_decoder([](const void* data, std::size_t length,
+                        std::uint32_t& channel, std::uint64_t& sequence) {
+        if (length < 9) {
+            return false;
+        }
+        std::uint32_t ignored = 0;
+        channel = static_cast<const unsigned char*>(data)[0];
+        return multicast_feed::decode_sequence(static_cast<const char*>(data) + 1,
+                                               length - 1, ignored, sequence);
+    });
+    feed.set_channels(4, 2);
+    EXPECT_EQ(feed.channels(), 4u);
+    feed.start();
+    EXPECT_EQ(feed.server().flow_workers(), 2u);
+    EXPECT_THROW(feed.set_channels(8), std::runtime_error);
+
+    for (std::uint64_t seq = 1; seq <= 10; ++seq) {
+        for (char channel = 0; channel < 5; ++channel) {
+            const std::string datagram = std::string(1, channel) + encode(seq);
+            sender.send_to(datagram.data(), static_cast<int>(datagram.size()), address_a);
+        }
+    }
+    sender.send_to("x", 1, address_a);
+
+    ASSERT_TRUE(wait_for([&]() { return feed.delivered() + feed.rejected() == 51; }));
+    feed.stop();
+
+    EXPECT_EQ(feed.delivered(), 40u);
+    EXPECT_EQ(feed.rejected(), 11u);  // Channel 4 and the short datagram
+    EXPECT_EQ(feed.gaps(), 0u);
+    for (auto& count : per_channel) {
+        EXPECT_EQ(count.load(), 10);
+    }
+}
+
+TEST_F(MulticastFeedTest, InvalidConfiguration) {
+    multicast_feed feed(open_loopback_line(), nullptr);
+    EXPECT_THROW(feed.set_channels(0), std::invalid_argument);
+    EXPECT_THROW(feed.set_channels(1, 0), std::invalid_argument);
+    EXPECT_THROW(multicast_feed(open_loopback_line(), udp_socket(INVALID_SOCKET_VALUE), nullptr),
+                 std::invalid_argument);
+
+    std::uint32_t channel = 0;
+    std::uint64_t sequence = 0;
+    EXPECT_FALSE(multicast_feed::decode_sequence("short", 5, channel, sequence));
+}
+
+TEST_F(MulticastFeedTest, OpenLineJoinsGroup) {
+    try {
+        udp_socket line = multicast_feed::open_line(socket_address("239.255.0.1", 0));
+        EXPECT_FALSE(line.is_closed());
+    } catch (const std::system_error& ex) {
+        GTEST_SKIP() << "Multicast unavailable: " << ex.what();
+    }
+}
@@ -5,6 +5,8 @@
 #include <fb/udp_socket.h>
 #include <thread>
 #include <chrono>
+#include <memory>
+#include <vector>
 
 using namespace fb;
 
@@ -217,6 +219,149 @@ TEST_F(PollSetTest, PollWithEventVector) {
     client_thread.join();
 }
 
+TEST_F(PollSetTest, ManySocketsAddUpdateRemove) {
+    poll_set poller;
+    std::vector<std::unique_ptr<udp_socket>> sockets;
+    for (int i = 0; i < 64; ++i) {
+        sockets.push_back(std::make_unique<udp_socket>(socket_address::Family::IPv4));
+        poller.add(*sockets.back(), poll_set::POLL_READ);
+    }
+    EXPECT_EQ(poller.count(), 64u);
+
+    // Remove every other socket so remaining entries get compacted.
+    for (size_t i = 0; i < sockets.size(); i += 2) {
+        poller.remove(*sockets[i]);
+    }
+    EXPECT_EQ(poller.count(), 32u);
+
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        EXPECT_EQ(poller.has(*sockets[i]), i % 2 == 1);
+        if (i % 2 == 1) {
+            poller.update(*sockets[i], poll_set::POLL_WRITE);
+        }
+    }
+
+    // Unconnected UDP sockets are always writable.
+    int result = poller.poll(std::chrono::milliseconds(1000));
+    EXPECT_EQ(result, 32);
+    for (const auto& event : poller.events()) {
+        EXPECT_TRUE(event.mode & poll_set::POLL_WRITE);
+        EXPECT_EQ(poller.get_mode(*event.socket_ptr), poll_set::POLL_WRITE);
+    }
+}
+
+TEST_F(PollSetTest, RemoveClosedSocket) {
+    poll_set poller;
+    udp_socket socket1(socket_address::Family::IPv4);
+    udp_socket socket2(socket_address::Family::IPv4);
+    poller.add(socket1, poll_set::POLL_READ);
+    poller.add(socket2, poll_set::POLL_READ);
+
+    socket1.close();
+    EXPECT_TRUE(poller.has(socket1));
+    poller.remove(socket1);
+    EXPECT_FALSE(poller.has(socket1));
+    EXPECT_TRUE(poller.has(socket2));
+    EXPECT_EQ(poller.count(), 1u);
+}
+
+TEST_F(PollSetTest, AddAfterStaleDescriptor) {
+    poll_set poller;
+    udp_socket stale(socket_address::Family::IPv4);
+    poller.add(stale, poll_set::POLL_READ);
+
+    // Close without removing; the kernel typically hands the same
+    // descriptor to the next socket.
+    stale.close();
+    udp_socket fresh(socket_address::Family::IPv4);
+    EXPECT_NO_THROW(poller.add(fresh, poll_set::POLL_WRITE));
+    EXPECT_TRUE(poller.has(fresh));
+    EXPECT_EQ(poller.get_mode(fresh), poll_set::POLL_WRITE);
+
+    poller.remove(stale);
+    EXPECT_FALSE(poller.has(stale));
+    EXPECT_TRUE(poller.has(fresh));
+    EXPECT_EQ(poller.count(), 1u);
+}
+
+TEST_F(PollSetTest, EdgeTriggeredReportsOnlyNewData) {
+    if (!poll_set::efficient_polling()) {
+        GTEST_SKIP() << "select fallback is level-triggered";
+    }
+
+    udp_socket receiver(socket_address::Family::IPv4);
+    receiver.bind(socket_address("127.0.0.1", 0));
+    udp_socket sender(socket_address::Family::IPv4);
+
+    poll_set poller;
+    poller.add(receiver, poll_set::POLL_READ | poll_set::POLL_EDGE);
+    EXPECT_EQ(poller.get_mode(receiver), poll_set::POLL_READ | poll_set::POLL_EDGE);
+
+    sender.send_to("one", receiver.address());
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(1000)), 1);
+
+    // The datagram is still queued, but no new readiness edge occurred.
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(50)), 0);
+
+    sender.send_to("two", receiver.address());
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(1000)), 1);
+}
+
+TEST_F(PollSetTest, OneshotDisarmsUntilUpdated) {
+    udp_socket receiver(socket_address::Family::IPv4);
+    receiver.bind(socket_address("127.0.0.1", 0));
+    udp_socket sender(socket_address::Family::IPv4);
+
+    poll_set poller;
+    const int mode = poll_set::POLL_READ | poll_set::POLL_ONESHOT;
+    poller.add(receiver, mode);
+
+    sender.send_to("data", receiver.address());
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(1000)), 1);
+
+    // Still readable, but disarmed after the first event.
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(50)), 0);
+    EXPECT_TRUE(poller.has(receiver));
+    EXPECT_EQ(poller.get_mode(receiver), mode);
+
+    // Re-submitting the same mode re-arms the registration.
+    poller.update(receiver, mode);
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(1000)), 1);
+    EXPECT_EQ(poller.events()[0].socket_ptr, &receiver);
+}
+
+TEST_F(PollSetTest, UserDataReturnedWithEvents) {
+    udp_socket first(socket_address::Family::IPv4);
+    udp_socket second(socket_address::Family::IPv4);
+    int first_token = 1;
+    int second_token = 2;
+
+    poll_set poller;
+    poller.add(first, poll_set::POLL_WRITE, &first_token);
+    poller.add(second, poll_set::POLL_WRITE, &second_token);
+    EXPECT_EQ(poller.get_user_data(first), &first_token);
+
+    // update() keeps the registered data
+    poller.update(second, poll_set::POLL_READ | poll_set::POLL_WRITE);
+    EXPECT_EQ(poller.get_user_data(second), &second_token);
+
+    ASSERT_EQ(poller.poll(std::chrono::milliseconds(1000)), 2);
+    for (const auto& event : poller.events()) {
+        if (event.socket_ptr == &first) {
+            EXPECT_EQ(event.user_data, &first_token);
+        } else {
+            EXPECT_EQ(event.socket_ptr, &second);
+            EXPECT_EQ(event.user_data, &second_token);
+        }
+    }
+
+    // Re-adding replaces the data; unregistered sockets report none
+    poller.add(first, poll_set::POLL_WRITE, &second_token);
+    EXPECT_EQ(poller.get_user_data(first), &second_token);
+    poller.remove(first);
+    EXPECT_EQ(poller.get_user_data(first), nullptr);
+}
+
 TEST_F(PollSetTest, MoveSemantics) {
     poll_set poller1;
     tcp_client socket(socket_address::Family::IPv4);
@@ -274,3 +419,57 @@ TEST_F(PollSetTest, ClearEvents) {
 
     client_thread.join();
 }
+
+#ifndef _WIN32
+TEST_F(PollSetTest, SocketPairReadiness) {
+    auto ends = tcp_client::socket_pair();
+
+    poll_set poller;
+    poller.add(ends.second, poll_set::POLL_READ);
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(0)), 0);
+
+    ends.first.send("x");
+    ASSERT_EQ(poller.poll(std::chrono::seconds(1)), 1);
+    EXPECT_EQ(poller.events()[0].mode & poll_set::POLL_READ, poll_set::POLL_READ);
+}
+#endif
+
+#ifndef _WIN32
+TEST_F(PollSetTest, EventQueueWakesReactor) {
+    event_queue queue;
+    udp_socket socket(socket_address::Family::IPv4);
+    socket.bind(socket_address("127.0.0.1", 0));
+    int queue_token = 1;
+
+    poll_set poller;
+    poller.add(socket, poll_set::POLL_READ);
+    poller.add(queue, &queue_token);
+    EXPECT_EQ(poller.count(), 2u);
+
+    // The descriptor starts readable; the first drain resets it
+    ASSERT_EQ(poller.poll(std::chrono::milliseconds(0)), 1);
+    EXPECT_EQ(poller.events()[0].socket_ptr, nullptr);
+    queue.process_pending();
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(0)), 0);
+
+    int delivered = 0;
+    std::thread producer([&queue, &delivered]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.enqueue([&delivered]() { ++delivered; });
+    });
+
+    ASSERT_EQ(poller.poll(std::chrono::seconds(2)), 1);
+    const SocketEvent& event = poller.events()[0];
+    EXPECT_EQ(event.socket_ptr, nullptr);
+    EXPECT_EQ(event.user_data, &queue_token);
+    EXPECT_EQ(event.mode & poll_set::POLL_READ, poll_set::POLL_READ);
+    producer.join();
+
+    EXPECT_EQ(queue.process_pending(), 1u);
+    EXPECT_EQ(delivered, 1);
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(0)), 0);
+
+    poller.remove(queue);
+    EXPECT_EQ(poller.count(), 1u);
+}
+#endif
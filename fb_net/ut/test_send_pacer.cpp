@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <fb/send_pacer.h>
+#include <fb/udp_client.h>
+#include <fb/udp_socket.h>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace fb;
+
+class SendPacerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        receiver = udp_socket(socket_address::Family::IPv4);
+        receiver.bind(socket_address("127.0.0.1", 0));
+        receiver.set_receive_timeout(std::chrono::seconds(2));
+        receiver.set_receive_buffer_size(1 << 20);
+    }
+
+    // Drain @p expected datagrams of @p length bytes from the receiver
+    int drain(int expected, std::size_t length)
+    {
+        std::vector<char> buffer(length + 1);
+        socket_address sender;
+        int received = 0;
+        try {
+            while (received < expected) {
+                const int size = receiver.receive_from(buffer.data(), static_cast<int>(buffer.size()), sender);
+                EXPECT_EQ(static_cast<std::size_t>(size), length);
+                ++received;
+            }
+        } catch (const std::system_error&) {
+        }
+        return received;
+    }
+
+    udp_socket receiver;
+};
+
+TEST_F(SendPacerTest, DisabledNeverWaits) {
+    send_pacer pacer;
+    const auto now = send_pacer::clock::now();
+    EXPECT_FALSE(pacer.enabled());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(pacer.consume(65000, now), now);
+    }
+    EXPECT_EQ(pacer.delay(65000, now).count(), 0);
+
+    EXPECT_FALSE(send_pacer(0, 0).enabled());
+    EXPECT_THROW(send_pacer(1000, 0), std::invalid_argument);
+}
+
+TEST_F(SendPacerTest, BurstThenEvenSpacing) {
+    using std::chrono::milliseconds;
+    // 1000 bytes per second with room for three 100-byte datagrams
+    send_pacer pacer(1000, 300);
+    const auto start = send_pacer::clock::now();
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(pacer.delay(100, start).count(), 0);
+        EXPECT_EQ(pacer.consume(100, start), start + milliseconds(100 * i));
+    }
+    // The bucket is empty: the fourth waits for one datagram's worth of refill
+    EXPECT_EQ(pacer.delay(100, start), milliseconds(100));
+    EXPECT_EQ(pacer.delay(100, start + milliseconds(100)).count(), 0);
+    EXPECT_EQ(pacer.consume(100, start + milliseconds(100)), start + milliseconds(300));
+
+    // After an idle period the bucket is full again, but no fuller
+    const auto later = start + std::chrono::seconds(10);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(pacer.delay(100, later).count(), 0);
+        pacer.consume(100, later);
+    }
+    EXPECT_GT(pacer.delay(100, later).count(), 0);
+}
+
+TEST_F(SendPacerTest, OversizedDatagramWaitsForFullBucket) {
+    send_pacer pacer(1000, 300);
+    const auto start = send_pacer::clock::now();
+    EXPECT_EQ(pacer.delay(1000, start).count(), 0);
+    pacer.consume(1000, start);
+    EXPECT_EQ(pacer.delay(1000, start), std::chrono::seconds(1));
+}
+
+TEST_F(SendPacerTest, RefundRestoresSchedule) {
+    send_pacer pacer(1000, 100);
+    const auto start = send_pacer::clock::now();
+    pacer.consume(100, start);
+    const auto blocked = pacer.delay(100, start);
+    EXPECT_GT(blocked.count(), 0);
+
+    pacer.consume(100, start);
+    pacer.refund(100);
+    EXPECT_EQ(pacer.delay(100, start), blocked);
+    pacer.refund(100);
+    EXPECT_EQ(pacer.delay(100, start).count(), 0);
+}
+
+TEST_F(SendPacerTest, PacedSendHoldsRate) {
+    for (bool kernel : {false, true}) {
+        udp_client client(socket_address::Family::IPv4);
+        client.connect(receiver.address());
+        // 50 datagrams of 1000 bytes at 200 KB/s, of which 2 may burst: ~0.24 s
+        client.set_pacing(200000, 2000, kernel);
+        EXPECT_EQ(client.pacing_rate(), 200000u);
+        EXPECT_EQ(client.pacing_burst(), 2000u);
+        if (!kernel) {
+            EXPECT_FALSE(client.kernel_pacing());
+        }
+
+        const std::string payload(1000, 'p');
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 50; ++i) {
+            EXPECT_EQ(client.send(payload), 1000);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_GE(elapsed, std::chrono::milliseconds(230)) << "kernel pacing " << kernel;
+        EXPECT_LT(elapsed, std::chrono::seconds(2)) << "kernel pacing " << kernel;
+
+        EXPECT_EQ(drain(50, payload.size()), 50) << "kernel pacing " << kernel;
+    }
+}
+
+TEST_F(SendPacerTest, PacedSendBatchSplitsIntoRuns) {
+    udp_client client(socket_address::Family::IPv4);
+    client.set_pacing(100000, 5000, false);
+
+    const std::string payload(1000, 'b');
+    std::vector<udp_send_entry> entries(20, udp_send_entry{payload.data(), payload.size(), receiver.address()});
+    // The first 5 fit the bucket; the other 15 need 150 ms of refill
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(client.send_batch(entries.data(), entries.size()), 20);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(140));
+    EXPECT_GT(client.pacing_delay(1000).count(), 0);
+
+    EXPECT_EQ(drain(20, payload.size()), 20);
+}
+
+TEST_F(SendPacerTest, DisablePacing) {
+    udp_client client(socket_address::Family::IPv4);
+    client.set_pacing(1000, 1000);
+    client.set_pacing(0);
+    EXPECT_EQ(client.pacing_rate(), 0u);
+    EXPECT_EQ(client.pacing_burst(), 0u);
+    EXPECT_FALSE(client.kernel_pacing());
+    EXPECT_FALSE(client.socket().get_transmit_time());
+
+    const std::string payload(1000, 'u');
+    for (int i = 0; i < 10; ++i) {
+        client.send_to(payload, receiver.address());
+    }
+    EXPECT_EQ(client.pacing_delay(1000).count(), 0);
+    EXPECT_EQ(drain(10, payload.size()), 10);
+}
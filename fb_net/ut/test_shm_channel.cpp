@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+#include <fb/shm_channel.h>
+#include <fb/poll_set.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+#ifndef _WIN32
+
+class ShmChannelTest : public ::testing::Test
+{
+protected:
+    static std::string unique_name()
+    {
+        static std::atomic<int> counter{0};
+        return "fb_net_test_" +
+               std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+               "_" + std::to_string(counter.fetch_add(1));
+    }
+
+    const std::string name = unique_name();
+};
+
+TEST_F(ShmChannelTest, SendAndReceiveRoundTrip) {
+    shm_channel receiver = shm_channel::create(name, 8, 64);
+    EXPECT_TRUE(receiver.is_receiver());
+    EXPECT_EQ(receiver.capacity(), 8u);
+    EXPECT_EQ(receiver.max_message_size(), 64u);
+
+    shm_channel sender = shm_channel::attach(name);
+    EXPECT_FALSE(sender.is_receiver());
+    EXPECT_EQ(sender.capacity(), 8u);
+
+    EXPECT_EQ(sender.send("hello"), 5);
+    EXPECT_EQ(sender.send(std::string()), 0);
+    EXPECT_EQ(receiver.pending(), 2u);
+
+    std::string message;
+    EXPECT_EQ(receiver.receive(message), 5);
+    EXPECT_EQ(message, "hello");
+    EXPECT_EQ(receiver.receive(message), 0);
+    EXPECT_TRUE(message.empty());
+
+    char buffer[16];
+    EXPECT_EQ(receiver.try_receive(buffer, sizeof(buffer)), -1);
+}
+
+TEST_F(ShmChannelTest, LongMessagesAreTruncated) {
+    shm_channel receiver = shm_channel::create(name, 4, 64);
+    shm_channel sender   = shm_channel::attach(name);
+
+    sender.send("0123456789");
+    char buffer[4];
+    EXPECT_EQ(receiver.receive(buffer, sizeof(buffer)), 4);
+    EXPECT_EQ(std::memcmp(buffer, "0123", 4), 0);
+    EXPECT_EQ(receiver.pending(), 0u);
+}
+
+TEST_F(ShmChannelTest, FullRingRejectsAndTimesOut) {
+    shm_channel receiver = shm_channel::create(name, 2, 16);
+    shm_channel sender   = shm_channel::attach(name);
+
+    EXPECT_TRUE(sender.try_send("a", 1));
+    EXPECT_TRUE(sender.try_send("b", 1));
+    EXPECT_FALSE(sender.try_send("c", 1));
+
+    bool timed_out = false;
+    sender.onTimeoutError.connect([&](const std::string&) { timed_out = true; });
+    try {
+        sender.send_with_timeout("c", 1, std::chrono::milliseconds(20));
+        FAIL() << "Expected a timeout";
+    } catch (const std::system_error& ex) {
+        EXPECT_EQ(ex.code(), std::make_error_code(std::errc::timed_out));
+    }
+    EXPECT_TRUE(timed_out);
+
+    char byte;
+    EXPECT_EQ(receiver.try_receive(&byte, 1), 1);
+    EXPECT_EQ(byte, 'a');
+    EXPECT_TRUE(sender.try_send("c", 1));
+}
+
+TEST_F(ShmChannelTest, ReceiveTimesOutWhenEmpty) {
+    shm_channel receiver = shm_channel::create(name);
+    receiver.set_spin_count(0);
+
+    char buffer[8];
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(receiver.receive_with_timeout(buffer, sizeof(buffer), std::chrono::milliseconds(50)),
+                 std::system_error);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+    EXPECT_FALSE(receiver.has_data_available());
+}
+
+TEST_F(ShmChannelTest, BlockedReceiverIsWoken) {
+    shm_channel receiver = shm_channel::create(name);
+    receiver.set_spin_count(0);
+    shm_channel sender = shm_channel::attach(name);
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        sender.send("wake");
+    });
+
+    std::string message(16, '\0');
+    const int received = receiver.receive_with_timeout(&message[0], message.size(),
+                                                       std::chrono::seconds(5));
+    producer.join();
+    ASSERT_EQ(received, 4);
+    EXPECT_EQ(message.substr(0, 4), "wake");
+}
+
+TEST_F(ShmChannelTest, WakeupSocketWorksWithPollSet) {
+    shm_channel receiver = shm_channel::create(name);
+    shm_channel sender   = shm_channel::attach(name);
+
+    poll_set poller;
+    poller.add(receiver.wakeup_socket(), poll_set::POLL_READ);
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(0)), 0);
+
+    sender.send("first");
+    sender.send("second");
+    ASSERT_EQ(poller.poll(std::chrono::seconds(1)), 1);
+
+    char buffer[16];
+    int messages = 0;
+    while (receiver.try_receive(buffer, sizeof(buffer)) >= 0) {
+        ++messages;
+    }
+    EXPECT_EQ(messages, 2);
+
+    // Draining re-armed the wakeup: the datagram was consumed and the next
+    // message sends a new one
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(0)), 0);
+    sender.send("third");
+    EXPECT_EQ(poller.poll(std::chrono::seconds(1)), 1);
+}
+
+TEST_F(ShmChannelTest, ManyProducersDeliverEverything) {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 2000;
+    shm_channel receiver = shm_channel::create(name, 64, 16);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([this, p] {
+            shm_channel sender = shm_channel::attach(name);
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                const std::string message = std::to_string(p) + ":" + std::to_string(i);
+                sender.send(message);
+            }
+        });
+    }
+
+    std::vector<int> next(PRODUCERS, 0);
+    std::string message;
+    bool in_order = true;
+    for (int i = 0; i < PRODUCERS * PER_PRODUCER; ++i) {
+        receiver.receive(message, 16);
+        const auto colon = message.find(':');
+        const int p = std::stoi(message.substr(0, colon));
+        const int n = std::stoi(message.substr(colon + 1));
+        in_order = in_order && n == next[static_cast<std::size_t>(p)];
+        next[static_cast<std::size_t>(p)] = n + 1;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(in_order);
+    for (int count : next) {
+        EXPECT_EQ(count, PER_PRODUCER);
+    }
+    EXPECT_EQ(receiver.pending(), 0u);
+}
+
+TEST_F(ShmChannelTest, SingleProducerAllowsOneSender) {
+    shm_channel receiver = shm_channel::create(name, 16, 32, true);
+    shm_channel sender   = shm_channel::attach(name);
+    EXPECT_THROW(shm_channel::attach(name), std::logic_error);
+
+    sender.send("only");
+    std::string message;
+    EXPECT_EQ(receiver.receive(message), 4);
+    EXPECT_EQ(message, "only");
+
+    // The slot frees up when the sender detaches
+    sender.close();
+    shm_channel replacement = shm_channel::attach(name);
+    EXPECT_TRUE(replacement.is_connected());
+}
+
+TEST_F(ShmChannelTest, RejectsInvalidUse) {
+    EXPECT_THROW(shm_channel::create(""), std::invalid_argument);
+    EXPECT_THROW(shm_channel::create("a/b"), std::invalid_argument);
+    EXPECT_THROW(shm_channel::create(std::string(shm_channel::MAX_NAME_LENGTH + 1, 'x')),
+                 std::invalid_argument);
+    EXPECT_THROW(shm_channel::create(name, 0), std::invalid_argument);
+    EXPECT_THROW(shm_channel::create(name, 8, 0), std::invalid_argument);
+    EXPECT_THROW(shm_channel::attach(name), std::system_error);
+
+    shm_channel receiver = shm_channel::create(name, 8, 8);
+    shm_channel sender   = shm_channel::attach(name);
+
+    try {
+        sender.send("more than eight");
+        FAIL() << "Expected message_size";
+    } catch (const std::system_error& ex) {
+        EXPECT_EQ(ex.code(), std::make_error_code(std::errc::message_size));
+    }
+
+    char byte;
+    EXPECT_THROW(receiver.send("x"), std::logic_error);
+    EXPECT_THROW(sender.try_receive(&byte, 1), std::logic_error);
+    EXPECT_THROW(sender.wakeup_socket(), std::logic_error);
+
+    shm_channel closed;
+    EXPECT_TRUE(closed.is_closed());
+    EXPECT_THROW(closed.send("x"), std::logic_error);
+}
+
+TEST_F(ShmChannelTest, ClosingReceiverRefusesSenders) {
+    shm_channel receiver = shm_channel::create(name);
+    shm_channel sender   = shm_channel::attach(name);
+
+    receiver.close();
+    EXPECT_TRUE(receiver.is_closed());
+    try {
+        sender.send("late");
+        FAIL() << "Expected connection_refused";
+    } catch (const std::system_error& ex) {
+        EXPECT_EQ(ex.code(), std::make_error_code(std::errc::connection_refused));
+    }
+    EXPECT_THROW(shm_channel::attach(name), std::system_error);
+}
+
+TEST_F(ShmChannelTest, MovedChannelKeepsWorking) {
+    shm_channel receiver = shm_channel::create(name);
+    shm_channel sender   = shm_channel::attach(name);
+
+    shm_channel moved(std::move(receiver));
+    EXPECT_TRUE(receiver.is_closed());
+    sender.send("moved");
+
+    std::string message;
+    EXPECT_EQ(moved.receive(message), 5);
+    EXPECT_EQ(message, "moved");
+}
+
+#endif
@@ -14,7 +14,9 @@
 #include <fb/fb_net.h>
 #include <atomic>
 #include <chrono>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace fb;
 
@@ -157,6 +159,31 @@ TEST_F(UDPClientSignalTest, UDPClientSignalAggregation) {
     EXPECT_EQ(total_bytes_received, 0);
 }
 
+TEST_F(UDPClientSignalTest, SendBatchEmitsDataSentPerDatagram) {
+    udp_socket receiver(socket_address::Family::IPv4);
+    receiver.bind(socket_address("127.0.0.1", 0));
+
+    udp_client client;
+    std::atomic<int> sent_signals(0);
+    std::atomic<std::size_t> total_bytes_sent(0);
+    client.onDataSent.connect([&](const void*, std::size_t len) {
+        sent_signals++;
+        total_bytes_sent += len;
+    });
+
+    const std::string payload = "tick";
+    std::vector<udp_send_entry> entries(3);
+    for (auto& entry : entries) {
+        entry.buffer = payload.data();
+        entry.length = payload.size();
+        entry.destination = receiver.address();
+    }
+
+    EXPECT_EQ(client.send_batch(entries.data(), entries.size()), 3);
+    EXPECT_EQ(sent_signals.load(), 3);
+    EXPECT_EQ(total_bytes_sent.load(), 3 * payload.size());
+}
+
 // ============================================================================
 // TCP Server Signal Tests
 // ============================================================================
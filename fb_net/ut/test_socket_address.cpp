@@ -5,7 +5,11 @@
 
 #include <gtest/gtest.h>
 #include <fb/socket_address.h>
+#include <set>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
 
 using namespace fb;
 
@@ -122,3 +126,127 @@ TEST_F(socket_address_Test, PortRange)
     // Test port 0 (any port)
     EXPECT_NO_THROW(socket_address("127.0.0.1", 0));
 }
+
+TEST_F(socket_address_Test, ToCharsWritesCallerBuffer)
+{
+    char buffer[socket_address::MAX_STRING_LENGTH];
+
+    socket_address v4("192.168.10.200", 65535);
+    auto result = v4.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), "192.168.10.200:65535");
+    EXPECT_EQ(v4.to_string(), "192.168.10.200:65535");
+    EXPECT_EQ(socket_address("0.0.0.0", 0).to_string(), "0.0.0.0:0");
+
+    socket_address v6("2001:db8::1", 443);
+    result = v6.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string(buffer, result.ptr), "[2001:db8::1]:443");
+
+    // Longest possible form fits MAX_STRING_LENGTH exactly
+    socket_address longest("ffff:ffff:ffff:ffff:ffff:ffff:255.255.255.255", 65535);
+    result = longest.to_chars(buffer, buffer + sizeof(buffer));
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_LE(static_cast<std::size_t>(result.ptr - buffer),
+              static_cast<std::size_t>(socket_address::MAX_STRING_LENGTH));
+
+    result = v4.to_chars(buffer, buffer + 5);
+    EXPECT_EQ(result.ec, std::errc::value_too_large);
+
+    std::ostringstream out;
+    out << v6;
+    EXPECT_EQ(out.str(), "[2001:db8::1]:443");
+}
+
+TEST_F(socket_address_Test, TryParseNumericLiterals)
+{
+    socket_address address;
+    ASSERT_TRUE(socket_address::try_parse("10.1.2.3:8080", address));
+    EXPECT_EQ(address, socket_address("10.1.2.3", 8080));
+
+    ASSERT_TRUE(socket_address::try_parse("[::1]:53", address));
+    EXPECT_EQ(address.family(), socket_address::Family::IPv6);
+    EXPECT_EQ(address.port(), 53);
+    EXPECT_EQ(address.host(), "::1");
+
+    const socket_address before = address;
+    EXPECT_FALSE(socket_address::try_parse("localhost:80", address));
+    EXPECT_FALSE(socket_address::try_parse("10.1.2.3", address));
+    EXPECT_FALSE(socket_address::try_parse("10.1.2.3:http", address));
+    EXPECT_FALSE(socket_address::try_parse("10.1.2.3:65536", address));
+    EXPECT_FALSE(socket_address::try_parse("10.1.2.256:80", address));
+    EXPECT_FALSE(socket_address::try_parse("10.01.2.3:80", address));
+    EXPECT_FALSE(socket_address::try_parse("10.1.2:80", address));
+    EXPECT_FALSE(socket_address::try_parse("[::1:80", address));
+    EXPECT_FALSE(socket_address::try_parse("", address));
+    EXPECT_EQ(address, before);
+
+    // Constructors take the same fast path for literals
+    EXPECT_EQ(socket_address("10.1.2.3:8080"), socket_address("10.1.2.3", 8080));
+    EXPECT_THROW(socket_address("10.1.2.3:70000"), std::invalid_argument);
+}
+
+TEST_F(socket_address_Test, HashAndOrdering)
+{
+    std::unordered_map<socket_address, int> flows;
+    flows[socket_address("10.0.0.1", 5000)] = 1;
+    flows[socket_address("10.0.0.1", 5001)] = 2;
+    flows[socket_address("::1", 5000)] = 3;
+    flows[socket_address("10.0.0.1:5000")] += 10;
+
+    EXPECT_EQ(flows.size(), 3u);
+    EXPECT_EQ(flows[socket_address("10.0.0.1", 5000)], 11);
+    EXPECT_EQ(std::hash<socket_address>{}(socket_address("10.0.0.1", 5000)),
+              socket_address("10.0.0.1", 5000).hash());
+    EXPECT_NE(socket_address("10.0.0.1", 5000).hash(),
+              socket_address("10.0.0.1", 5001).hash());
+
+    // Ordering is numeric, not textual
+    EXPECT_TRUE(socket_address("9.0.0.1", 80) < socket_address("10.0.0.1", 80));
+    std::set<socket_address> ordered{socket_address("10.0.0.2", 1),
+                                     socket_address("10.0.0.1", 2),
+                                     socket_address("10.0.0.1", 1)};
+    EXPECT_EQ(ordered.begin()->to_string(), "10.0.0.1:1");
+    EXPECT_EQ(ordered.rbegin()->to_string(), "10.0.0.2:1");
+}
+
+#ifndef _WIN32
+TEST_F(socket_address_Test, UnixLocalPaths)
+{
+    socket_address path(socket_address::UNIX_LOCAL, "/tmp/feed.sock");
+    EXPECT_EQ(path.family(), socket_address::UNIX_LOCAL);
+    EXPECT_EQ(path.af(), AF_UNIX);
+    EXPECT_EQ(path.path(), "/tmp/feed.sock");
+    EXPECT_EQ(path.host(), "/tmp/feed.sock");
+    EXPECT_EQ(path.to_string(), "/tmp/feed.sock");
+    EXPECT_EQ(path.port(), 0);
+    EXPECT_EQ(path.addr()->sa_family, AF_UNIX);
+
+    // Copies share the path and compare, hash and round-trip through sockaddr
+    socket_address copy = path;
+    EXPECT_EQ(copy, path);
+    EXPECT_EQ(copy.hash(), path.hash());
+    EXPECT_EQ(socket_address(path.addr(), path.length()), path);
+    EXPECT_NE(path, socket_address(socket_address::UNIX_LOCAL, "/tmp/feed2.sock"));
+    EXPECT_TRUE(path < socket_address(socket_address::UNIX_LOCAL, "/tmp/feed2.sock"));
+
+    socket_address unnamed(socket_address::UNIX_LOCAL);
+    EXPECT_EQ(unnamed.path(), "");
+    EXPECT_EQ(unnamed, socket_address(socket_address::UNIX_LOCAL, ""));
+    EXPECT_EQ(socket_address(unnamed.addr(), 0), unnamed);
+
+#ifdef __linux__
+    socket_address abstract(socket_address::UNIX_LOCAL, "@feed");
+    EXPECT_EQ(abstract.to_string(), "@feed");
+    EXPECT_NE(abstract, socket_address(socket_address::UNIX_LOCAL, "feed"));
+    EXPECT_EQ(socket_address(abstract.addr(), abstract.length()), abstract);
+#endif
+
+    const std::string longest(socket_address::MAX_PATH_LENGTH, 'p');
+    EXPECT_EQ(socket_address(socket_address::UNIX_LOCAL, longest).path(), longest);
+    EXPECT_THROW(socket_address(socket_address::UNIX_LOCAL, longest + "p"),
+                 std::invalid_argument);
+    EXPECT_THROW(socket_address(socket_address::UNIX_LOCAL, std::uint16_t(80)),
+                 std::invalid_argument);
+}
+#endif
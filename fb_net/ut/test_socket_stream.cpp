@@ -3,7 +3,9 @@
 #include <fb/server_socket.h>
 #include <chrono>
 #include <cstring>
+#include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <thread>
 
 using namespace fb;
@@ -263,3 +265,132 @@ TEST_F(socket_streamTest, MultipleWrites) {
 
     server_thread.join();
 }
+
+TEST_F(socket_streamTest, PeekLineAndConsume) {
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0));
+    server.listen();
+    socket_address server_addr = server.address();
+
+    std::thread server_thread([&server]() {
+        try {
+            tcp_client client = server.accept_connection(std::chrono::seconds(2));
+            // Split a line across two sends so peek_line() has to refill
+            client.send("SET a 1\nGET ");
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            client.send("a\ntail");
+        } catch (...) {}
+    });
+
+    socket_stream stream(server_addr, std::chrono::seconds(2));
+    stream.set_receive_timeout(std::chrono::seconds(2));
+
+    auto line = stream.peek_line();
+    EXPECT_EQ(line, "SET a 1\n");
+    stream.consume(line.size());
+
+    line = stream.peek_line();
+    EXPECT_EQ(line, "GET a\n");
+    stream.consume(line.size());
+
+    // The istream interface continues from where consume() left off
+    std::string rest;
+    stream >> rest;
+    EXPECT_EQ(rest, "tail");
+
+    EXPECT_TRUE(stream.peek_line().empty());
+    EXPECT_THROW(stream.consume(1), std::invalid_argument);
+
+    server_thread.join();
+}
+
+TEST_F(socket_streamTest, PeekWaitsForMinimumSize) {
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0));
+    server.listen();
+    socket_address server_addr = server.address();
+
+    std::thread server_thread([&server]() {
+        try {
+            tcp_client client = server.accept_connection(std::chrono::seconds(2));
+            client.send("abc");
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            client.send("defgh");
+        } catch (...) {}
+    });
+
+    socket_stream stream(server_addr, std::chrono::seconds(2), 16);
+
+    EXPECT_THROW(stream.peek(17), std::invalid_argument);
+
+    stream.consume(0);
+    auto view = stream.peek(2);
+    ASSERT_GE(view.size(), 2u);
+    EXPECT_EQ(view.substr(0, 2), "ab");
+    stream.consume(1);
+
+    view = stream.peek(7);
+    EXPECT_EQ(view, "bcdefgh");
+
+    char c = 0;
+    stream.get(c);
+    EXPECT_EQ(c, 'b');
+
+    server_thread.join();
+}
+
+TEST_F(socket_streamTest, SharedBufferPool) {
+    auto pool = std::make_shared<stream_buffer_pool>(1024, 4);
+    EXPECT_EQ(pool->buffer_size(), 1024u);
+    EXPECT_THROW(stream_buffer_pool(0), std::invalid_argument);
+
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0));
+    server.listen();
+    socket_address server_addr = server.address();
+
+    std::thread server_thread([&server]() {
+        try {
+            for (int i = 0; i < 2; ++i) {
+                tcp_client client = server.accept_connection(std::chrono::seconds(2));
+                std::string data;
+                client.receive(data, 64);
+                client.send(data);
+            }
+        } catch (...) {}
+    });
+
+    for (int i = 0; i < 2; ++i) {
+        socket_stream stream(server_addr, std::chrono::seconds(2), 1024);
+        stream.set_buffer_provider(pool);
+        EXPECT_EQ(stream.rdbuf()->buffer_provider(), pool);
+
+        stream << "ping\n" << std::flush;
+        EXPECT_EQ(stream.peek_line(), "ping\n");
+
+        // Both buffers are borrowed while the stream is in use
+        EXPECT_EQ(pool->cached_buffers(), 0u);
+    }
+
+    // Input and output buffers went back to the pool and were reused
+    EXPECT_EQ(pool->cached_buffers(), 2u);
+
+    server_thread.join();
+}
+
+TEST_F(socket_streamTest, BufferPoolCapsCache) {
+    stream_buffer_pool pool(64, 1);
+
+    char* first = pool.acquire(64);
+    char* second = pool.acquire(32);
+    char* large = pool.acquire(128);
+    pool.release(first, 64);
+    pool.release(second, 32);
+    pool.release(large, 128);
+    pool.release(nullptr, 64);
+    EXPECT_EQ(pool.cached_buffers(), 1u);
+
+    EXPECT_EQ(pool.acquire(64), first);
+    EXPECT_EQ(pool.cached_buffers(), 0u);
+    pool.release(first, 64);
+}
@@ -9,9 +9,12 @@
 #include <atomic>
 #include <chrono>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <limits>
 #include <system_error>
 #include <thread>
+#include <vector>
 
 using namespace fb;
 
@@ -203,6 +206,124 @@ TEST_F(tcp_clientTest, SendReceiveBytes)
     server_thread->join();
 }
 
+TEST_F(tcp_clientTest, VectoredSendReceive)
+{
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0));
+    server.listen();
+
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server.address(), std::chrono::seconds(2));
+    socket_address peer_address;
+    tcp_client peer = server.accept_connection(peer_address);
+
+    const std::string header = "HDR:";
+    const std::string body = "payload";
+    const std::string trailer = ";END";
+    const tcp_send_buffer segments[] = {
+        {header.data(), header.size()},
+        {nullptr, 0},
+        {body.data(), body.size()},
+        {trailer.data(), trailer.size()}
+    };
+    EXPECT_EQ(client.send_vectored_all(segments, 4), 15);
+
+    char first[6] = {};
+    char second[32] = {};
+    tcp_receive_buffer targets[] = {{first, sizeof(first)}, {second, sizeof(second)}};
+    ASSERT_TRUE(peer.poll_read(std::chrono::seconds(2)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    int received = peer.receive_vectored(targets, 2);
+    ASSERT_EQ(received, 15);
+    EXPECT_EQ(std::string(first, 6), "HDR:pa");
+    EXPECT_EQ(std::string(second, 9), "yload;END");
+
+    EXPECT_EQ(client.send_vectored(segments, 0), 0);
+    const tcp_send_buffer invalid[] = {{nullptr, 4}};
+    EXPECT_THROW(client.send_vectored(invalid, 1), std::invalid_argument);
+    EXPECT_THROW(client.send_vectored_all(nullptr, 1), std::invalid_argument);
+    EXPECT_THROW(peer.receive_vectored(nullptr, 1), std::invalid_argument);
+}
+
+TEST_F(tcp_clientTest, VectoredSendAllHandlesPartialWrites)
+{
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0));
+    server.listen();
+
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server.address(), std::chrono::seconds(2));
+    socket_address peer_address;
+    tcp_client peer = server.accept_connection(peer_address);
+
+    // More segments than one sendmsg call takes, and more bytes than the
+    // socket buffers hold, so the send has to resume mid-segment.
+    const std::size_t segment_count = 200;
+    const std::size_t segment_size = 8192;
+    std::vector<std::vector<char>> payload(segment_count);
+    std::vector<tcp_send_buffer> segments(segment_count);
+    for (std::size_t i = 0; i < segment_count; ++i) {
+        payload[i].assign(segment_size, static_cast<char>('a' + i % 26));
+        segments[i] = {payload[i].data(), payload[i].size()};
+    }
+    const std::size_t total = segment_count * segment_size;
+
+    std::vector<char> received(total);
+    std::thread reader([&]() {
+        peer.receive_bytes_exact(received.data(), static_cast<int>(total));
+    });
+
+    EXPECT_EQ(client.send_vectored_all(segments.data(), segment_count), static_cast<int>(total));
+    reader.join();
+
+    for (std::size_t i = 0; i < segment_count; ++i) {
+        ASSERT_EQ(received[i * segment_size], static_cast<char>('a' + i % 26));
+        ASSERT_EQ(received[i * segment_size + segment_size - 1], static_cast<char>('a' + i % 26));
+    }
+}
+
+TEST_F(tcp_clientTest, SendFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "fb_net_send_file_test.bin";
+    std::string contents;
+    for (int i = 0; i < 100000; ++i) {
+        contents.push_back(static_cast<char>('a' + i % 26));
+    }
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0));
+    server.listen();
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server.address(), std::chrono::seconds(2));
+    socket_address peer_address;
+    tcp_client peer = server.accept_connection(peer_address);
+
+    const std::size_t tail_offset = 1000;
+    const std::size_t tail_length = 5000;
+    std::string received(contents.size() + tail_length, '\0');
+    std::thread reader([&]() {
+        peer.receive_bytes_exact(received.data(), static_cast<int>(received.size()));
+    });
+
+    EXPECT_EQ(client.send_file(path.string()), contents.size());
+    EXPECT_EQ(client.send_file(path.string(), tail_offset, tail_length), tail_length);
+    reader.join();
+
+    EXPECT_EQ(received.substr(0, contents.size()), contents);
+    EXPECT_EQ(received.substr(contents.size()), contents.substr(tail_offset, tail_length));
+
+    EXPECT_THROW(client.send_file(path.string(), contents.size() + 1), std::invalid_argument);
+    EXPECT_THROW(client.send_file(path.string(), 10, contents.size()), std::invalid_argument);
+    EXPECT_THROW(client.send_file((path.string() + ".missing")), std::system_error);
+    EXPECT_THROW(client.send_file(-1), std::invalid_argument);
+
+    std::filesystem::remove(path);
+}
+
 TEST_F(tcp_clientTest, MoveSemantics)
 {
     tcp_client socket1(socket_address::Family::IPv4);
@@ -272,3 +393,84 @@ TEST_F(tcp_clientTest, ReceiveTimeout)
     server_running = false;
     server_thread->join();
 }
+
+TEST_F(tcp_clientTest, CorkHoldsBackSmallSends)
+{
+    server_socket server(socket_address::Family::IPv4);
+    server.bind(socket_address("127.0.0.1", 0));
+    server.listen();
+
+    tcp_client client(server.address(), std::chrono::seconds(2));
+    tcp_client peer = server.accept_connection(std::chrono::seconds(2));
+
+    client.set_no_delay(true);
+    client.set_cork(true);
+    EXPECT_TRUE(client.get_cork());
+
+    for (char c : std::string("coalesced")) {
+        client.send_bytes(&c, 1);
+    }
+#if defined(__linux__)
+    // TCP_CORK keeps the partial segment queued until uncorked
+    EXPECT_FALSE(peer.poll_read(std::chrono::milliseconds(50)));
+#endif
+
+    client.set_cork(false);
+    EXPECT_FALSE(client.get_cork());
+
+    std::string received;
+    char buffer[64];
+    peer.set_receive_timeout(std::chrono::seconds(2));
+    while (received.size() < 9) {
+        int n = peer.receive_bytes(buffer, sizeof(buffer));
+        ASSERT_GT(n, 0);
+        received.append(buffer, static_cast<std::size_t>(n));
+    }
+    EXPECT_EQ(received, "coalesced");
+}
+
+#ifndef _WIN32
+TEST_F(tcp_clientTest, SocketPairExchangesData)
+{
+    auto ends = tcp_client::socket_pair();
+    EXPECT_TRUE(ends.first.is_connected());
+    EXPECT_EQ(ends.first.peer_address().family(), socket_address::UNIX_LOCAL);
+
+    ASSERT_EQ(ends.first.send("ping"), 4);
+    std::string received;
+    ASSERT_EQ(ends.second.receive(received, 16), 4);
+    EXPECT_EQ(received, "ping");
+
+    ends.first.close();
+    char byte;
+    EXPECT_EQ(ends.second.receive_bytes(&byte, 1), 0);
+}
+
+TEST_F(tcp_clientTest, UnixDomainListener)
+{
+    const std::string path = "/tmp/fb_net_stream_" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".sock";
+    const socket_address address(socket_address::UNIX_LOCAL, path);
+
+    server_socket server(address, 8);
+    EXPECT_EQ(server.address(), address);
+
+    // Rebinding with reuse_address replaces the socket file left behind
+    server.close();
+    server_socket rebound(address, 8);
+
+    tcp_client client(address, std::chrono::seconds(2));
+    socket_address peer;
+    tcp_client accepted = rebound.accept_connection(peer);
+    EXPECT_EQ(peer.family(), socket_address::UNIX_LOCAL);
+    EXPECT_EQ(client.peer_address().path(), path);
+
+    ASSERT_EQ(client.send("local"), 5);
+    std::string received;
+    ASSERT_EQ(accepted.receive(received, 16), 5);
+    EXPECT_EQ(received, "local");
+
+    rebound.close();
+    ::unlink(path.c_str());
+}
+#endif
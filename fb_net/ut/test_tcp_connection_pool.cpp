@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <fb/tcp_connection_pool.h>
+#include <fb/tcp_server.h>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+using namespace fb;
+
+namespace {
+
+// Echoes every message until the client disconnects
+class PoolEchoConnection : public tcp_server_connection
+{
+public:
+    PoolEchoConnection(tcp_client socket, const socket_address& addr)
+        : tcp_server_connection(std::move(socket), addr)
+    {}
+
+    void run() override
+    {
+        try {
+            socket().set_receive_timeout(std::chrono::milliseconds(100));
+            while (!stop_requested()) {
+                std::string data;
+                try {
+                    if (socket().receive(data, 1024) <= 0) {
+                        break;
+                    }
+                    socket().send(data);
+                } catch (const std::system_error& ex) {
+                    if (ex.code() == std::make_error_code(std::errc::timed_out)) {
+                        continue;
+                    }
+                    throw;
+                }
+            }
+        } catch (const std::exception&) {
+        }
+    }
+};
+
+// Closes each connection as soon as it is accepted
+class ClosingConnection : public tcp_server_connection
+{
+public:
+    ClosingConnection(tcp_client socket, const socket_address& addr)
+        : tcp_server_connection(std::move(socket), addr)
+    {}
+
+    void run() override {}
+};
+
+template <typename Connection>
+std::unique_ptr<tcp_server> start_server(socket_address& address)
+{
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    address = server_sock.address();
+    server_sock.listen();
+
+    auto server = std::make_unique<tcp_server>(
+        std::move(server_sock),
+        [](tcp_client socket, const socket_address& addr) {
+            return std::make_unique<Connection>(std::move(socket), addr);
+        });
+    server->start();
+    return server;
+}
+
+std::string round_trip(tcp_client& client, const std::string& message)
+{
+    client.set_receive_timeout(std::chrono::seconds(2));
+    client.send(message);
+    std::string reply;
+    client.receive(reply, 1024);
+    return reply;
+}
+
+} // namespace
+
+class TcpConnectionPoolTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        server = start_server<PoolEchoConnection>(address);
+    }
+
+    void TearDown() override
+    {
+        server->stop();
+    }
+
+    socket_address address;
+    std::unique_ptr<tcp_server> server;
+};
+
+TEST_F(TcpConnectionPoolTest, ReusesReturnedConnection) {
+    tcp_connection_pool pool;
+
+    {
+        auto lease = pool.acquire(address);
+        EXPECT_FALSE(lease.reused());
+        EXPECT_EQ(pool.leased_connections(), 1u);
+        EXPECT_EQ(round_trip(*lease, "first"), "first");
+    }
+    EXPECT_EQ(pool.leased_connections(), 0u);
+    EXPECT_EQ(pool.idle_connections(address), 1u);
+
+    auto lease = pool.acquire(address);
+    EXPECT_TRUE(lease.reused());
+    EXPECT_EQ(round_trip(lease.client(), "second"), "second");
+    EXPECT_EQ(pool.connections_created(), 1u);
+    EXPECT_EQ(pool.connections_reused(), 1u);
+    EXPECT_EQ(pool.idle_connections(), 0u);
+}
+
+TEST_F(TcpConnectionPoolTest, ConcurrentLeasesAndIdleLimit) {
+    tcp_connection_pool pool(1);
+
+    auto first = pool.acquire(address);
+    auto second = pool.acquire(address);
+    EXPECT_EQ(pool.connections_created(), 2u);
+    EXPECT_EQ(pool.leased_connections(), 2u);
+
+    first.release();
+    EXPECT_FALSE(first);
+    second.release();
+    EXPECT_EQ(pool.idle_connections(address), 1u);
+    EXPECT_THROW(first.client(), std::logic_error);
+}
+
+TEST_F(TcpConnectionPoolTest, InvalidatedLeaseIsClosed) {
+    tcp_connection_pool pool;
+
+    auto lease = pool.acquire(address);
+    lease.invalidate();
+    lease.release();
+    EXPECT_EQ(pool.idle_connections(), 0u);
+
+    auto next = pool.acquire(address);
+    EXPECT_FALSE(next.reused());
+    EXPECT_EQ(pool.connections_created(), 2u);
+}
+
+TEST_F(TcpConnectionPoolTest, DiscardsConnectionClosedByPeer) {
+    socket_address closing_address;
+    auto closing_server = start_server<ClosingConnection>(closing_address);
+    tcp_connection_pool pool;
+
+    pool.acquire(closing_address).release();
+    EXPECT_EQ(pool.idle_connections(closing_address), 1u);
+
+    // Let the server's FIN arrive
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto lease = pool.acquire(closing_address);
+    EXPECT_FALSE(lease.reused());
+    EXPECT_EQ(pool.connections_created(), 2u);
+
+    lease.invalidate();
+    lease.release();
+    closing_server->stop();
+}
+
+TEST_F(TcpConnectionPoolTest, IdleTimeoutAndPrune) {
+    tcp_connection_pool pool(4, std::chrono::milliseconds(50));
+
+    pool.acquire(address).release();
+    EXPECT_EQ(pool.idle_connections(), 1u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(pool.prune(), 1u);
+    EXPECT_EQ(pool.idle_connections(), 0u);
+
+    pool.acquire(address).release();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto lease = pool.acquire(address);
+    EXPECT_FALSE(lease.reused());
+}
+
+TEST_F(TcpConnectionPoolTest, HealthCheckRejectsConnection) {
+    tcp_connection_pool pool;
+    int checks = 0;
+    pool.set_health_check([&checks](tcp_client&) {
+        ++checks;
+        return false;
+    });
+
+    pool.acquire(address).release();
+    auto lease = pool.acquire(address);
+    EXPECT_FALSE(lease.reused());
+    EXPECT_EQ(checks, 1);
+    EXPECT_EQ(pool.connections_created(), 2u);
+}
+
+TEST_F(TcpConnectionPoolTest, InvalidConfiguration) {
+    EXPECT_THROW(tcp_connection_pool(1, std::chrono::milliseconds(-1)), std::invalid_argument);
+    EXPECT_THROW(tcp_connection_pool(1, std::chrono::milliseconds(0), std::chrono::milliseconds(0)),
+                 std::invalid_argument);
+
+    tcp_connection_lease empty;
+    EXPECT_FALSE(empty);
+    EXPECT_THROW(empty.client(), std::logic_error);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <fb/tcp_connector.h>
+#include <fb/server_socket.h>
+#include <chrono>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace fb;
+
+class TcpConnectorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        listener = server_socket(socket_address::Family::IPv4);
+        listener.bind(socket_address("127.0.0.1", 0));
+        listener.listen(256);
+        address = listener.address();
+    }
+
+    // A port on loopback with nothing listening
+    static socket_address closed_port()
+    {
+        server_socket probe(socket_address::Family::IPv4);
+        probe.bind(socket_address("127.0.0.1", 0));
+        return probe.address();
+    }
+
+    server_socket listener;
+    socket_address address;
+};
+
+TEST_F(TcpConnectorTest, ConnectsManyInParallel) {
+    tcp_connector connector;
+    const int count = 64;
+
+    std::vector<tcp_client> clients;
+    int failures = 0;
+    for (int i = 0; i < count; ++i) {
+        connector.connect(address, std::chrono::seconds(2),
+                          [&](std::uint64_t, const socket_address&, tcp_client client,
+                              const std::error_code& error) {
+                              if (error) {
+                                  ++failures;
+                              } else {
+                                  clients.push_back(std::move(client));
+                              }
+                          });
+    }
+    EXPECT_EQ(connector.pending(), static_cast<std::size_t>(count));
+
+    EXPECT_TRUE(connector.wait(std::chrono::seconds(5)));
+    EXPECT_EQ(connector.pending(), 0u);
+    EXPECT_EQ(failures, 0);
+    ASSERT_EQ(clients.size(), static_cast<std::size_t>(count));
+
+    // Completed sockets are connected and back in blocking mode
+    EXPECT_TRUE(clients.front().get_blocking());
+    tcp_client accepted = listener.accept_connection();
+    clients.front().send("ping");
+    std::string reply;
+    accepted.set_receive_timeout(std::chrono::seconds(2));
+    accepted.receive(reply, 16);
+    EXPECT_EQ(reply, "ping");
+}
+
+TEST_F(TcpConnectorTest, ReportsRefusedConnect) {
+    tcp_connector connector;
+    const socket_address target = closed_port();
+
+    std::error_code result;
+    std::uint64_t failed_id = 0;
+    std::string failure_text;
+    connector.onConnectFailed.connect([&](std::uint64_t id, const socket_address&, const std::string& reason) {
+        failed_id = id;
+        failure_text = reason;
+    });
+
+    const auto id = connector.connect(target, std::chrono::seconds(2),
+                                      [&](std::uint64_t, const socket_address&, tcp_client client,
+                                          const std::error_code& error) {
+                                          result = error;
+                                          EXPECT_TRUE(client.is_closed());
+                                      });
+
+    EXPECT_TRUE(connector.wait(std::chrono::seconds(3)));
+    EXPECT_EQ(result, std::make_error_code(std::errc::connection_refused));
+    EXPECT_EQ(failed_id, id);
+    EXPECT_FALSE(failure_text.empty());
+}
+
+TEST_F(TcpConnectorTest, SignalsSuccess) {
+    tcp_connector connector;
+    std::map<std::uint64_t, socket_address> connected;
+    connector.onConnected.connect([&](std::uint64_t id, const socket_address& addr) {
+        connected.emplace(id, addr);
+    });
+
+    const auto first = connector.connect(address, std::chrono::seconds(2));
+    const auto second = connector.connect(address, std::chrono::seconds(2));
+    EXPECT_NE(first, second);
+
+    EXPECT_TRUE(connector.wait(std::chrono::seconds(3)));
+    EXPECT_EQ(connected.size(), 2u);
+    EXPECT_EQ(connected.count(first), 1u);
+    EXPECT_EQ(connected[second], address);
+}
+
+TEST_F(TcpConnectorTest, CancelInvokesHandler) {
+    tcp_connector connector;
+    std::vector<std::error_code> results;
+    auto handler = [&](std::uint64_t, const socket_address&, tcp_client, const std::error_code& error) {
+        results.push_back(error);
+    };
+
+    const auto id = connector.connect(address, std::chrono::seconds(2), handler);
+    connector.connect(address, std::chrono::seconds(2), handler);
+
+    EXPECT_TRUE(connector.cancel(id));
+    EXPECT_FALSE(connector.cancel(id));
+    connector.cancel_all();
+
+    EXPECT_EQ(connector.pending(), 0u);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0], std::make_error_code(std::errc::operation_canceled));
+    EXPECT_EQ(results[1], std::make_error_code(std::errc::operation_canceled));
+}
+
+TEST_F(TcpConnectorTest, RejectsInvalidTimeout) {
+    tcp_connector connector;
+    EXPECT_THROW(connector.connect(address, std::chrono::milliseconds(0)), std::invalid_argument);
+    EXPECT_EQ(connector.run(std::chrono::milliseconds(10)), 0u);
+}
@@ -1,10 +1,15 @@
 #include <gtest/gtest.h>
 #include <fb/tcp_server.h>
 #include <fb/tcp_client.h>
+#include <algorithm>
 #include <system_error>
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
 
 using namespace fb;
 
@@ -69,12 +74,159 @@ public:
 
 std::atomic<int> CounterConnection::active_count{0};
 
+// Non-blocking echo handler for reactor mode
+class ReactorEchoConnection : public tcp_reactor_connection
+{
+public:
+    ReactorEchoConnection(tcp_client socket, const socket_address& addr)
+        : tcp_reactor_connection(std::move(socket), addr)
+    {}
+
+    void on_readable() override
+    {
+        char buffer[1024];
+        int received = socket().receive_bytes(buffer, sizeof(buffer));
+        if (received <= 0) {
+            close();
+            return;
+        }
+        socket().send_bytes_all(buffer, received);
+    }
+};
+
+// Reactor handler that answers with one small send per byte received
+class ReactorChattyConnection : public tcp_reactor_connection
+{
+public:
+    ReactorChattyConnection(tcp_client socket, const socket_address& addr)
+        : tcp_reactor_connection(std::move(socket), addr)
+    {
+        set_write_coalescing(true);
+    }
+
+    void on_open() override
+    {
+        socket().set_no_delay(true);
+    }
+
+    void on_readable() override
+    {
+        char buffer[64];
+        int received = socket().receive_bytes(buffer, sizeof(buffer));
+        if (received <= 0) {
+            close();
+            return;
+        }
+        for (int i = 0; i < received; ++i) {
+            socket().send_bytes_all(&buffer[i], 1);
+        }
+    }
+};
+
+// Reactor handler that queues output for a client that is not reading yet
+class ReactorFloodConnection : public tcp_reactor_connection
+{
+public:
+    static std::atomic<std::size_t> accepted_bytes;
+    static std::atomic<int> refused;
+    static std::atomic<int> highs;
+    static std::atomic<int> lows;
+
+    ReactorFloodConnection(tcp_client socket, const socket_address& addr)
+        : tcp_reactor_connection(std::move(socket), addr)
+    {
+        onOutputHigh.connect([](std::size_t) { ++highs; });
+        onOutputLow.connect([](std::size_t) { ++lows; });
+    }
+
+    void on_open() override
+    {
+        socket().set_send_buffer_size(16 * 1024);
+        const std::string chunk(16 * 1024, 'x');
+        // Far more than the socket buffer: the budget must refuse some of it
+        for (int i = 0; i < 1024; ++i) {
+            if (!send_buffered(chunk.data(), chunk.size())) {
+                ++refused;
+                return;
+            }
+            accepted_bytes += chunk.size();
+        }
+    }
+
+    void on_readable() override
+    {
+        char buffer[64];
+        if (socket().receive_bytes(buffer, sizeof(buffer)) <= 0) {
+            close();
+        }
+    }
+};
+
+std::atomic<std::size_t> ReactorFloodConnection::accepted_bytes{0};
+std::atomic<int> ReactorFloodConnection::refused{0};
+std::atomic<int> ReactorFloodConnection::highs{0};
+std::atomic<int> ReactorFloodConnection::lows{0};
+
+// Connection that sends more than a non-reading client can take
+class SlowConsumerConnection : public tcp_server_connection
+{
+public:
+    static std::atomic<int> timed_out;
+
+    SlowConsumerConnection(tcp_client socket, const socket_address& addr)
+        : tcp_server_connection(std::move(socket), addr)
+    {}
+
+    void run() override
+    {
+        const std::vector<char> payload(16 * 1024 * 1024, 'x');
+        if (!send_within(payload.data(), payload.size(), std::chrono::milliseconds(100))) {
+            ++timed_out;
+        }
+    }
+};
+
+std::atomic<int> SlowConsumerConnection::timed_out{0};
+
 class TCPServerTest : public ::testing::Test
 {
 protected:
     void SetUp() override
     {
         CounterConnection::active_count = 0;
+        ReactorFloodConnection::accepted_bytes = 0;
+        ReactorFloodConnection::refused = 0;
+        ReactorFloodConnection::highs = 0;
+        ReactorFloodConnection::lows = 0;
+        SlowConsumerConnection::timed_out = 0;
+    }
+
+    // Poll until the condition holds or two seconds pass
+    template <typename Predicate>
+    static bool wait_for(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    static std::size_t drain(tcp_client& client, std::size_t expected)
+    {
+        std::size_t received = 0;
+        std::vector<char> buffer(64 * 1024);
+        while (received < expected) {
+            const int n = client.receive_bytes(buffer.data(), static_cast<int>(buffer.size()));
+            if (n <= 0) {
+                break;
+            }
+            received += static_cast<std::size_t>(n);
+        }
+        return received;
     }
 
     void TearDown() override {}
@@ -218,6 +370,49 @@ TEST_F(TCPServerTest, MaxThreads) {
     server.stop();
 }
 
+TEST_F(TCPServerTest, WorkerPoolGrowsAndRetiresIdleThreads) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    auto factory = [](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<CounterConnection>(std::move(socket), addr);
+    };
+
+    tcp_server server(std::move(server_sock), factory, 4);
+    worker_pool_policy policy;
+    policy.min_threads = 1;
+    policy.idle_timeout = std::chrono::milliseconds(100);
+    server.set_worker_pool(policy);
+    server.start();
+    EXPECT_EQ(server.thread_count(), 1u);
+
+    std::vector<std::unique_ptr<tcp_client>> clients;
+    for (int i = 0; i < 6; ++i) {
+        auto client = std::make_unique<tcp_client>(socket_address::Family::IPv4);
+        client->connect(server_addr, std::chrono::seconds(2));
+        clients.push_back(std::move(client));
+    }
+
+    std::size_t peak = 0;
+    for (int i = 0; i < 50 && peak < 2; ++i) {
+        peak = std::max(peak, server.thread_count());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GT(peak, 1u);
+    EXPECT_LE(server.thread_count(), 4u);
+
+    // Surplus workers retire once idle, but never below min_threads
+    for (int i = 0; i < 150 && server.thread_count() > 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(server.thread_count(), 1u);
+
+    clients.clear();
+    server.stop();
+}
+
 TEST_F(TCPServerTest, CurrentConnections) {
     server_socket server_sock(socket_address::Family::IPv4);
     server_sock.bind(socket_address("127.0.0.1", 0));
@@ -281,6 +476,72 @@ TEST_F(TCPServerTest, TotalConnections) {
     server.stop();
 }
 
+TEST_F(TCPServerTest, LatencyTracking) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    auto factory = [](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<CounterConnection>(std::move(socket), addr);
+    };
+
+    tcp_server server(std::move(server_sock), factory);
+    server.set_latency_tracking(true);
+    EXPECT_TRUE(server.latency_tracking());
+    server.start();
+
+    for (int i = 0; i < 3; ++i) {
+        tcp_client client(socket_address::Family::IPv4);
+        client.connect(server_addr, std::chrono::seconds(2));
+    }
+
+    for (int i = 0; i < 100 && server.service_latency().count < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    latency_snapshot service = server.service_latency();
+    EXPECT_EQ(server.queue_latency().count, 3u);
+    EXPECT_EQ(service.count, 3u);
+    // CounterConnection::run() sleeps for 200 ms
+    EXPECT_GE(service.min, std::chrono::milliseconds(200));
+
+    server.stop();
+}
+
+TEST_F(TCPServerTest, ReactorLatencyTracking) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    tcp_server server;
+    server.set_server_socket(std::move(server_sock));
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorEchoConnection>(std::move(socket), addr);
+    }, 1);
+    server.set_latency_tracking(true);
+    server.start();
+
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server_addr, std::chrono::seconds(2));
+    client.set_receive_timeout(std::chrono::seconds(2));
+    client.send("ping");
+    std::string response;
+    client.receive(response, 1024);
+    EXPECT_EQ(response, "ping");
+
+    // The sample is recorded once the callback that echoed has returned
+    for (int i = 0; i < 50 && server.service_latency().count == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GE(server.service_latency().count, 1u);
+    EXPECT_EQ(server.queue_latency().count, 0u);
+
+    client.close();
+    server.stop();
+}
+
 TEST_F(TCPServerTest, MoveSemantics) {
     server_socket server_sock1(socket_address::Family::IPv4);
     server_sock1.bind(socket_address("127.0.0.1", 0));
@@ -400,3 +661,584 @@ TEST_F(TCPServerTest, MoveStoppedServer) {
     server2.stop();
     EXPECT_FALSE(server2.is_running());
 }
+
+TEST_F(TCPServerTest, ReactorModeEcho) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    tcp_server server;
+    server.set_server_socket(std::move(server_sock));
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorEchoConnection>(std::move(socket), addr);
+    }, 2);
+
+    EXPECT_TRUE(server.is_reactor_mode());
+    server.start();
+    EXPECT_EQ(server.event_loop_count(), 2u);
+    EXPECT_EQ(server.thread_count(), 0u);
+
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server_addr, std::chrono::seconds(2));
+    client.set_receive_timeout(std::chrono::seconds(2));
+
+    std::string test_message = "Hello, reactor!";
+    client.send(test_message);
+
+    std::string response;
+    client.receive(response, 1024);
+    EXPECT_EQ(response, test_message);
+
+    client.close();
+    server.stop();
+    EXPECT_EQ(server.active_connections(), 0u);
+}
+
+TEST_F(TCPServerTest, ThreadConfiguratorSeesEveryRole) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    tcp_server server;
+    server.set_server_socket(std::move(server_sock));
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorEchoConnection>(std::move(socket), addr);
+    }, 2);
+
+    std::mutex mutex;
+    std::set<std::pair<thread_role, std::size_t>> configured;
+    server.set_thread_configurator([&](thread_role role, std::size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        configured.emplace(role, index);
+        thread_config config;
+        config.name = "fb-tcp-" + std::to_string(index);
+        return config;
+    });
+    server.start();
+    EXPECT_THROW(server.set_thread_configurator(nullptr), std::runtime_error);
+
+    // Threads configure themselves before serving: an echo proves the
+    // acceptor and a loop are past that point
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server_addr, std::chrono::seconds(2));
+    client.set_receive_timeout(std::chrono::seconds(2));
+    client.send("ping");
+    std::string response;
+    client.receive(response, 1024);
+    EXPECT_EQ(response, "ping");
+
+    EXPECT_TRUE(wait_for([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return configured.size() == 3;
+    }));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(configured.count({thread_role::acceptor, 0}), 1u);
+        EXPECT_EQ(configured.count({thread_role::reactor, 0}), 1u);
+        EXPECT_EQ(configured.count({thread_role::reactor, 1}), 1u);
+    }
+
+    client.close();
+    server.stop();
+}
+
+TEST_F(TCPServerTest, ReactorWriteCoalescing) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    tcp_server server;
+    server.set_server_socket(std::move(server_sock));
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorChattyConnection>(std::move(socket), addr);
+    }, 1);
+    server.start();
+
+    tcp_client client(socket_address::Family::IPv4);
+    client.connect(server_addr, std::chrono::seconds(2));
+    client.set_receive_timeout(std::chrono::seconds(2));
+
+    const std::string message = "batched reply";
+    client.send(message);
+
+    // The per-byte sends leave the server corked and are flushed together
+    std::string response;
+    int receives = 0;
+    while (response.size() < message.size()) {
+        std::string chunk;
+        ASSERT_GT(client.receive(chunk, 1024), 0);
+        response += chunk;
+        ++receives;
+    }
+    EXPECT_EQ(response, message);
+#if defined(__linux__)
+    EXPECT_EQ(receives, 1);
+#endif
+
+    client.close();
+    server.stop();
+}
+
+TEST_F(TCPServerTest, ReactorModeManyConnectionsFewThreads) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen(128);
+
+    tcp_server server;
+    server.set_server_socket(std::move(server_sock));
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorEchoConnection>(std::move(socket), addr);
+    }, 2);
+    server.start();
+
+    // Far more concurrent sessions than event-loop threads
+    const std::size_t num_clients = 32;
+    std::vector<std::unique_ptr<tcp_client>> clients;
+    for (std::size_t i = 0; i < num_clients; ++i) {
+        auto client = std::make_unique<tcp_client>(socket_address::Family::IPv4);
+        client->connect(server_addr, std::chrono::seconds(2));
+        client->set_receive_timeout(std::chrono::seconds(2));
+        clients.push_back(std::move(client));
+    }
+
+    for (std::size_t i = 0; i < num_clients; ++i) {
+        std::string message = "Client " + std::to_string(i);
+        clients[i]->send(message);
+        std::string response;
+        clients[i]->receive(response, 1024);
+        EXPECT_EQ(response, message);
+    }
+
+    EXPECT_EQ(server.active_connections(), num_clients);
+    EXPECT_EQ(server.total_connections(), static_cast<std::uint64_t>(num_clients));
+
+    // Closing clients lets the loops retire their connections
+    clients.clear();
+    for (int i = 0; i < 100 && server.active_connections() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(server.active_connections(), 0u);
+
+    server.stop();
+}
+
+TEST_F(TCPServerTest, ReactorFactoryReplacesConnectionFactory) {
+    tcp_server server;
+    server.set_connection_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<EchoConnection>(std::move(socket), addr);
+    });
+    EXPECT_FALSE(server.is_reactor_mode());
+    EXPECT_EQ(server.event_loop_count(), 0u);
+
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorEchoConnection>(std::move(socket), addr);
+    });
+    EXPECT_TRUE(server.is_reactor_mode());
+    EXPECT_GT(server.event_loop_count(), 0u);
+}
+
+TEST_F(TCPServerTest, LockFreeQueueMultipleClients) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    auto factory = [](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<EchoConnection>(std::move(socket), addr);
+    };
+
+    tcp_server server(std::move(server_sock), factory);
+    server.set_lock_free_queue(true, 64);
+    EXPECT_TRUE(server.lock_free_queue());
+    server.start();
+
+    EXPECT_THROW(server.set_lock_free_queue(false), std::runtime_error);
+
+    const int num_clients = 8;
+    std::vector<std::thread> client_threads;
+    for (int i = 0; i < num_clients; ++i) {
+        client_threads.emplace_back([server_addr, i]() {
+            try {
+                tcp_client client(socket_address::Family::IPv4);
+                client.connect(server_addr, std::chrono::seconds(2));
+
+                std::string message = "Client " + std::to_string(i);
+                client.send(message);
+
+                std::string response;
+                client.receive(response, 1024);
+
+                EXPECT_EQ(response, message);
+            } catch (const std::exception& ex) {
+                ADD_FAILURE() << "Client " << i << " failed: " << ex.what();
+            }
+        });
+    }
+
+    for (auto& thread : client_threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(server.total_connections(), static_cast<std::uint64_t>(num_clients));
+    server.stop();
+}
+
+TEST_F(TCPServerTest, AcceptorShards) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0), true, true);
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    auto factory = [](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<EchoConnection>(std::move(socket), addr);
+    };
+
+    tcp_server server(std::move(server_sock), factory);
+    server.set_acceptor_shards(3);
+    EXPECT_EQ(server.acceptor_shards(), 3u);
+    server.start();
+
+    const int num_clients = 24;
+    std::vector<std::thread> client_threads;
+    for (int i = 0; i < num_clients; ++i) {
+        client_threads.emplace_back([server_addr, i]() {
+            try {
+                tcp_client client(socket_address::Family::IPv4);
+                client.connect(server_addr, std::chrono::seconds(2));
+
+                std::string message = "Client " + std::to_string(i);
+                client.send(message);
+
+                std::string response;
+                client.receive(response, 1024);
+
+                EXPECT_EQ(response, message);
+            } catch (const std::exception& ex) {
+                ADD_FAILURE() << "Client " << i << " failed: " << ex.what();
+            }
+        });
+    }
+
+    for (auto& thread : client_threads) {
+        thread.join();
+    }
+
+    std::uint64_t shard_sum = 0;
+    for (std::size_t i = 0; i < server.acceptor_shards(); ++i) {
+        shard_sum += server.shard_connections(i);
+    }
+    EXPECT_EQ(shard_sum, static_cast<std::uint64_t>(num_clients));
+    EXPECT_EQ(server.total_connections(), static_cast<std::uint64_t>(num_clients));
+
+    server.stop();
+
+    // Counters survive stop()
+    EXPECT_EQ(server.total_connections(), static_cast<std::uint64_t>(num_clients));
+}
+
+TEST_F(TCPServerTest, AcceptorShardsRequireReusePort) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    server_sock.listen();
+
+    tcp_server server(std::move(server_sock), [](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<EchoConnection>(std::move(socket), addr);
+    });
+    server.set_acceptor_shards(2);
+
+    EXPECT_THROW(server.start(), std::logic_error);
+    EXPECT_FALSE(server.is_running());
+}
+
+TEST_F(TCPServerTest, ReactorBackpressurePerConnection) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    tcp_server server;
+    server.set_server_socket(std::move(server_sock));
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorFloodConnection>(std::move(socket), addr);
+    }, 1);
+
+    backpressure_policy policy;
+    policy.max_buffered   = 256 * 1024;
+    policy.high_watermark = 128 * 1024;
+    policy.low_watermark  = 32 * 1024;
+    server.set_backpressure(policy);
+    server.start();
+
+    tcp_client client(socket_address::Family::IPv4);
+    client.set_receive_buffer_size(16 * 1024);
+    client.connect(server_addr, std::chrono::seconds(2));
+    client.set_receive_timeout(std::chrono::seconds(2));
+
+    ASSERT_TRUE(wait_for([]() { return ReactorFloodConnection::refused.load() == 1; }));
+    EXPECT_EQ(ReactorFloodConnection::highs.load(), 1);
+    EXPECT_GT(server.buffered_output(), 0u);
+    EXPECT_LE(server.buffered_output(), policy.max_buffered);
+    EXPECT_EQ(server.refused_writes(), 0u);  // Refused by the connection's own limit
+
+    // Everything accepted arrives intact once the client reads
+    const std::size_t expected = ReactorFloodConnection::accepted_bytes.load();
+    EXPECT_EQ(drain(client, expected), expected);
+    ASSERT_TRUE(wait_for([&]() { return server.buffered_output() == 0; }));
+    EXPECT_EQ(ReactorFloodConnection::lows.load(), 1);
+
+    client.close();
+    server.stop();
+}
+
+TEST_F(TCPServerTest, ReactorBackpressureGlobalBudget) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    tcp_server server;
+    server.set_server_socket(std::move(server_sock));
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorFloodConnection>(std::move(socket), addr);
+    }, 2);
+
+    backpressure_policy policy;
+    policy.total_max_buffered = 512 * 1024;
+    server.set_backpressure(policy);
+    server.start();
+
+    std::vector<std::unique_ptr<tcp_client>> clients;
+    for (int i = 0; i < 4; ++i) {
+        auto client = std::make_unique<tcp_client>(socket_address::Family::IPv4);
+        client->set_receive_buffer_size(16 * 1024);
+        client->connect(server_addr, std::chrono::seconds(2));
+        clients.push_back(std::move(client));
+    }
+
+    // The slow clients share one budget instead of growing without bound
+    ASSERT_TRUE(wait_for([]() { return ReactorFloodConnection::refused.load() == 4; }));
+    EXPECT_LE(server.buffered_output(), policy.total_max_buffered);
+    EXPECT_EQ(server.refused_writes(), 4u);
+
+    // Closing the clients returns their queued bytes to the budget
+    clients.clear();
+    ASSERT_TRUE(wait_for([&]() { return server.active_connections() == 0; }));
+    EXPECT_EQ(server.buffered_output(), 0u);
+
+    server.stop();
+}
+
+TEST_F(TCPServerTest, BackpressureValidation) {
+    tcp_server server;
+    backpressure_policy policy;
+    policy.high_watermark = 1024;
+    policy.low_watermark  = 2048;
+    EXPECT_THROW(server.set_backpressure(policy), std::invalid_argument);
+
+    policy.low_watermark = 512;
+    server.set_backpressure(policy);
+    EXPECT_EQ(server.backpressure().high_watermark, 1024u);
+    EXPECT_EQ(server.buffered_output(), 0u);
+
+    output_budget budget(100);
+    EXPECT_TRUE(budget.try_acquire(60));
+    EXPECT_FALSE(budget.try_acquire(41));
+    EXPECT_TRUE(budget.try_acquire(40));
+    budget.release(100);
+    EXPECT_EQ(budget.used(), 0u);
+    EXPECT_EQ(budget.refused(), 1u);
+}
+
+TEST_F(TCPServerTest, SendWithinBoundsSlowConsumer) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    tcp_server server(std::move(server_sock), [](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<SlowConsumerConnection>(std::move(socket), addr);
+    });
+    backpressure_policy policy;
+    policy.max_buffered = 16 * 1024;
+    server.set_backpressure(policy);
+    server.start();
+
+    tcp_client client(socket_address::Family::IPv4);
+    client.set_receive_buffer_size(16 * 1024);
+    client.connect(server_addr, std::chrono::seconds(2));
+
+    // The worker gives up on the client that never reads
+    EXPECT_TRUE(wait_for([]() { return SlowConsumerConnection::timed_out.load() == 1; }));
+
+    client.close();
+    server.stop();
+}
+
+TEST_F(TCPServerTest, ReactorIdleTimeout) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    tcp_server server;
+    server.set_server_socket(std::move(server_sock));
+    server.set_reactor_factory([](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<ReactorEchoConnection>(std::move(socket), addr);
+    }, 1);
+    server.set_idle_timeout(std::chrono::milliseconds(200));
+    server.start();
+
+    tcp_client idle(socket_address::Family::IPv4);
+    idle.connect(server_addr, std::chrono::seconds(2));
+    tcp_client busy(socket_address::Family::IPv4);
+    busy.connect(server_addr, std::chrono::seconds(2));
+    busy.set_receive_timeout(std::chrono::seconds(2));
+
+    // Keep one client active past the idle timeout
+    for (int i = 0; i < 8; ++i) {
+        busy.send("ping");
+        std::string response;
+        busy.receive(response, 1024);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    ASSERT_TRUE(wait_for([&]() { return server.timed_out_connections() == 1; }));
+    EXPECT_EQ(server.active_connections(), 1u);
+
+    // The idle client sees the server close its side
+    idle.set_receive_timeout(std::chrono::seconds(2));
+    char byte = 0;
+    EXPECT_EQ(idle.receive_bytes(&byte, 1), 0);
+
+    busy.close();
+    server.stop();
+}
+
+#ifndef _WIN32
+// Echo handler that stays open while its client is idle
+class PatientEchoConnection : public tcp_server_connection
+{
+public:
+    PatientEchoConnection(tcp_client socket, const socket_address& addr)
+        : tcp_server_connection(std::move(socket), addr)
+    {}
+
+    void run() override
+    {
+        char buffer[1024];
+        while (!stop_requested()) {
+            if (!socket().poll(std::chrono::milliseconds(50), socket_base::SELECT_READ)) {
+                continue;
+            }
+            const int received = socket().receive_bytes(buffer, sizeof(buffer));
+            if (received <= 0) {
+                break;
+            }
+            socket().send_bytes_all(buffer, received);
+        }
+    }
+};
+
+TEST_F(TCPServerTest, ListenerHandOffKeepsServing) {
+    server_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+    server_sock.listen();
+
+    std::atomic<int> old_accepts(0);
+    std::atomic<int> new_accepts(0);
+    auto counting_factory = [](std::atomic<int>& accepts) {
+        return [&accepts](tcp_client socket, const socket_address& addr) {
+            accepts++;
+            return std::make_unique<PatientEchoConnection>(std::move(socket), addr);
+        };
+    };
+
+    tcp_server old_server(std::move(server_sock), counting_factory(old_accepts));
+    old_server.start();
+
+    tcp_client existing(socket_address::Family::IPv4);
+    existing.connect(server_addr, std::chrono::seconds(2));
+    existing.set_receive_timeout(std::chrono::seconds(2));
+    ASSERT_TRUE(wait_for([&]() { return old_server.active_connections() == 1; }));
+
+    // The successor waits on the rendezvous path while the old server sends
+    const std::string path = "/tmp/fb_net_handoff_" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".sock";
+    server_socket received;
+    std::thread successor([&]() {
+        received = server_socket::receive_listener(path, std::chrono::seconds(5));
+    });
+    old_server.hand_off_listener(path);
+    successor.join();
+    EXPECT_TRUE(old_server.server_socket().is_closed());
+    EXPECT_EQ(received.address().port(), server_addr.port());
+
+    tcp_server new_server(std::move(received), counting_factory(new_accepts));
+    new_server.start();
+
+    // New clients reach the successor on the same port
+    tcp_client fresh(socket_address::Family::IPv4);
+    fresh.connect(server_addr, std::chrono::seconds(2));
+    fresh.set_receive_timeout(std::chrono::seconds(2));
+    fresh.send("new");
+    std::string response;
+    fresh.receive(response, 1024);
+    EXPECT_EQ(response, "new");
+    EXPECT_EQ(new_accepts.load(), 1);
+    EXPECT_EQ(old_accepts.load(), 1);
+
+    // The existing connection is still served by the old server
+    existing.send("old");
+    response.clear();
+    existing.receive(response, 1024);
+    EXPECT_EQ(response, "old");
+
+    existing.close();
+    EXPECT_TRUE(old_server.drain(std::chrono::seconds(2)));
+    EXPECT_FALSE(old_server.is_running());
+
+    fresh.close();
+    new_server.stop();
+}
+
+TEST_F(TCPServerTest, ListenerHandOffValidation) {
+    tcp_server server;
+    EXPECT_THROW(server.hand_off_listener("/tmp/unused.sock"), std::runtime_error);
+    EXPECT_THROW(server.drain(std::chrono::milliseconds(10)), std::runtime_error);
+
+    EXPECT_THROW(server_socket::adopt(INVALID_SOCKET_VALUE), std::invalid_argument);
+
+    EXPECT_THROW(server_socket::receive_listener("/tmp/fb_net_no_sender.sock",
+                                                 std::chrono::milliseconds(50)),
+                 std::system_error);
+}
+#endif
+
+#ifndef _WIN32
+TEST_F(TCPServerTest, UnixDomainServer) {
+    const std::string path = "/tmp/fb_net_server_" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".sock";
+    const socket_address address(socket_address::UNIX_LOCAL, path);
+
+    auto factory = [](tcp_client socket, const socket_address& addr) {
+        return std::make_unique<EchoConnection>(std::move(socket), addr);
+    };
+    tcp_server server(server_socket(address), factory);
+    server.start();
+
+    tcp_client client(address, std::chrono::seconds(2));
+    client.send("over unix");
+    std::string response;
+    client.receive(response, 1024);
+    EXPECT_EQ(response, "over unix");
+
+    client.close();
+    server.stop();
+    ::unlink(path.c_str());
+}
+#endif
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <fb/timer_source.h>
+#include <fb/poll_set.h>
+#include <fb/udp_socket.h>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+using namespace fb;
+
+class TimerSourceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!timer_source::supported())
+        {
+            GTEST_SKIP() << "timer_source is not available on this platform";
+        }
+    }
+    void TearDown() override {}
+};
+
+TEST_F(TimerSourceTest, StartsDisarmed) {
+    timer_source timer;
+    EXPECT_FALSE(timer.is_active());
+    EXPECT_GE(timer.native_handle(), 0);
+    EXPECT_EQ(timer.interval(), std::chrono::nanoseconds::zero());
+    EXPECT_EQ(timer.read(), 0u);
+}
+
+TEST_F(TimerSourceTest, OneShotReportedByPoll) {
+    timer_source timer;
+    int timer_token = 1;
+
+    poll_set poller;
+    poller.add(timer, &timer_token);
+    EXPECT_EQ(poller.count(), 1u);
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(0)), 0);
+
+    const auto started = std::chrono::steady_clock::now();
+    timer.start(std::chrono::milliseconds(20));
+    EXPECT_TRUE(timer.is_active());
+
+    ASSERT_EQ(poller.poll(std::chrono::seconds(2)), 1);
+    EXPECT_GE(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(19));
+    const SocketEvent& event = poller.events()[0];
+    EXPECT_EQ(event.socket_ptr, nullptr);
+    EXPECT_EQ(event.user_data, &timer_token);
+    EXPECT_EQ(event.mode & poll_set::POLL_READ, poll_set::POLL_READ);
+
+    // Reading resets readiness and ends a one-shot timer
+    EXPECT_EQ(timer.read(), 1u);
+    EXPECT_FALSE(timer.is_active());
+    EXPECT_EQ(timer.read(), 0u);
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(50)), 0);
+
+    poller.remove(timer);
+    EXPECT_TRUE(poller.empty());
+}
+
+TEST_F(TimerSourceTest, ZeroDelayExpiresAtOnce) {
+    timer_source timer;
+    poll_set poller;
+    poller.add(timer);
+
+    timer.start(std::chrono::nanoseconds::zero());
+    ASSERT_EQ(poller.poll(std::chrono::seconds(1)), 1);
+    EXPECT_EQ(timer.read(), 1u);
+}
+
+TEST_F(TimerSourceTest, RepeatingTimerCountsExpirations) {
+    timer_source timer;
+    timer.start(std::chrono::milliseconds(5), std::chrono::milliseconds(5));
+    EXPECT_EQ(timer.interval(), std::chrono::milliseconds(5));
+
+    // Expirations between reads are counted, not queued
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    const std::uint64_t expirations = timer.read();
+    EXPECT_GE(expirations, 5u);
+    EXPECT_LE(expirations, 13u);
+    EXPECT_TRUE(timer.is_active());
+
+    poll_set poller;
+    poller.add(timer);
+    ASSERT_EQ(poller.poll(std::chrono::seconds(1)), 1);
+    EXPECT_GE(timer.read(), 1u);
+}
+
+TEST_F(TimerSourceTest, FirstDelayDiffersFromInterval) {
+    timer_source timer;
+    poll_set poller;
+    poller.add(timer);
+
+    timer.start(std::chrono::milliseconds(1), std::chrono::milliseconds(20));
+    ASSERT_EQ(poller.poll(std::chrono::seconds(1)), 1);
+    EXPECT_EQ(timer.read(), 1u);
+
+    const auto first = std::chrono::steady_clock::now();
+    ASSERT_EQ(poller.poll(std::chrono::seconds(1)), 1);
+    EXPECT_GE(std::chrono::steady_clock::now() - first, std::chrono::milliseconds(10));
+    EXPECT_GE(timer.read(), 1u);
+    EXPECT_TRUE(timer.is_active());
+}
+
+TEST_F(TimerSourceTest, StopDiscardsPendingExpirations) {
+    timer_source timer;
+    poll_set poller;
+    poller.add(timer);
+
+    timer.start(std::chrono::milliseconds(1), std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    timer.stop();
+    EXPECT_FALSE(timer.is_active());
+    EXPECT_EQ(poller.poll(std::chrono::milliseconds(30)), 0);
+    EXPECT_EQ(timer.read(), 0u);
+
+    // Restarting replaces the setting
+    timer.start(std::chrono::milliseconds(1));
+    ASSERT_EQ(poller.poll(std::chrono::seconds(1)), 1);
+    EXPECT_EQ(timer.read(), 1u);
+}
+
+TEST_F(TimerSourceTest, SocketAndTimerInOnePoll) {
+    udp_socket receiver(socket_address::Family::IPv4);
+    receiver.bind(socket_address("127.0.0.1", 0));
+    timer_source timeout;
+    int timer_token = 7;
+
+    poll_set poller;
+    poller.add(receiver, poll_set::POLL_READ);
+    poller.add(timeout, &timer_token);
+    EXPECT_EQ(poller.count(), 2u);
+
+    timeout.start(std::chrono::milliseconds(10));
+    udp_socket sender(socket_address::Family::IPv4);
+    sender.send_to("ping", receiver.address());
+
+    bool got_packet = false;
+    bool got_timeout = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while ((!got_packet || !got_timeout) && std::chrono::steady_clock::now() < deadline) {
+        poller.poll(std::chrono::milliseconds(100));
+        for (const auto& event : poller.events()) {
+            if (event.socket_ptr == nullptr) {
+                EXPECT_EQ(event.user_data, &timer_token);
+                EXPECT_EQ(timeout.read(), 1u);
+                got_timeout = true;
+            } else {
+                EXPECT_EQ(event.socket_ptr, &receiver);
+                char buffer[16];
+                socket_address from;
+                EXPECT_EQ(receiver.receive_from(buffer, sizeof(buffer), from), 4);
+                got_packet = true;
+            }
+        }
+    }
+    EXPECT_TRUE(got_packet);
+    EXPECT_TRUE(got_timeout);
+}
+
+TEST_F(TimerSourceTest, MoveSemantics) {
+    timer_source first;
+    const int handle = first.native_handle();
+    first.start(std::chrono::seconds(10), std::chrono::seconds(10));
+
+    timer_source second(std::move(first));
+    EXPECT_EQ(second.native_handle(), handle);
+    EXPECT_TRUE(second.is_active());
+    EXPECT_EQ(second.interval(), std::chrono::seconds(10));
+    EXPECT_EQ(first.native_handle(), -1);
+    EXPECT_FALSE(first.is_active());
+    EXPECT_EQ(first.read(), 0u);
+
+    timer_source third;
+    third = std::move(second);
+    EXPECT_EQ(third.native_handle(), handle);
+    EXPECT_TRUE(third.is_active());
+
+    // A moved-from source cannot be polled
+    poll_set poller;
+    EXPECT_THROW(poller.add(second), std::invalid_argument);
+}
+
+TEST_F(TimerSourceTest, NegativeDurationsThrow) {
+    timer_source timer;
+    EXPECT_THROW(timer.start(std::chrono::milliseconds(-1)), std::invalid_argument);
+    EXPECT_THROW(timer.start(std::chrono::milliseconds(1), std::chrono::milliseconds(-1)),
+                 std::invalid_argument);
+    EXPECT_FALSE(timer.is_active());
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <fb/timer_wheel.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+using namespace fb;
+
+class TimerWheelTest : public ::testing::Test
+{
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(TimerWheelTest, FiresOnExactTickAcrossLevels) {
+    timer_wheel wheel(std::chrono::milliseconds(1));
+    const std::vector<std::uint64_t> delays{1, 2, 63, 64, 65, 127, 4095, 4096, 4097,
+                                            262143, 262144, 300001, 16777216, 16777300};
+    std::vector<std::uint64_t> fired_at(delays.size(), 0);
+    for (std::size_t i = 0; i < delays.size(); ++i) {
+        wheel.schedule(delays[i], [&, i]() { fired_at[i] = wheel.current_tick(); });
+    }
+    EXPECT_EQ(wheel.size(), delays.size());
+
+    std::size_t fired = 0;
+    while (!wheel.empty()) {
+        fired += wheel.tick();
+    }
+    EXPECT_EQ(fired, delays.size());
+    EXPECT_EQ(fired_at, delays);
+}
+
+TEST_F(TimerWheelTest, UnalignedStart) {
+    timer_wheel wheel(std::chrono::milliseconds(1));
+    wheel.schedule(1, []() {});
+    wheel.tick(4000);  // Now at tick 4000, close to a level-1 wrap
+
+    std::vector<std::uint64_t> fired_at;
+    for (std::uint64_t delay : std::vector<std::uint64_t>{50, 96, 100, 5000}) {
+        wheel.schedule(delay, [&]() { fired_at.push_back(wheel.current_tick()); });
+    }
+    while (!wheel.empty()) {
+        wheel.tick();
+    }
+    EXPECT_EQ(fired_at, (std::vector<std::uint64_t>{4050, 4096, 4100, 9000}));
+}
+
+TEST_F(TimerWheelTest, Cancel) {
+    timer_wheel wheel(std::chrono::milliseconds(1));
+    int fired = 0;
+    const auto kept = wheel.schedule(10, [&]() { ++fired; });
+    const auto cancelled = wheel.schedule(10, [&]() { fired += 100; });
+    const auto far = wheel.schedule(100000, [&]() { fired += 1000; });
+
+    EXPECT_TRUE(wheel.cancel(cancelled));
+    EXPECT_FALSE(wheel.cancel(cancelled));
+    EXPECT_TRUE(wheel.cancel(far));
+    EXPECT_FALSE(wheel.cancel(timer_wheel::INVALID_TIMER));
+    EXPECT_EQ(wheel.size(), 1u);
+
+    EXPECT_EQ(wheel.tick(10), 1u);
+    EXPECT_EQ(fired, 1);
+    EXPECT_FALSE(wheel.cancel(kept));  // Already fired
+
+    // The freed slot is reused; the stale id must not cancel the new timer
+    const auto reused = wheel.schedule(5, [&]() { ++fired; });
+    EXPECT_FALSE(wheel.cancel(kept));
+    EXPECT_EQ(wheel.tick(5), 1u);
+    EXPECT_EQ(fired, 2);
+    EXPECT_FALSE(wheel.cancel(reused));
+}
+
+TEST_F(TimerWheelTest, CallbacksMayRescheduleAndCancel) {
+    timer_wheel wheel(std::chrono::milliseconds(1));
+    int periodic = 0;
+    std::function<void()> rearm = [&]() {
+        if (++periodic < 5) {
+            wheel.schedule(3, rearm);
+        }
+    };
+    wheel.schedule(3, rearm);
+
+    // A callback cancelling a later timer
+    bool victim_fired = false;
+    const auto victim = wheel.schedule(8, [&]() { victim_fired = true; });
+    wheel.schedule(7, [&]() { EXPECT_TRUE(wheel.cancel(victim)); });
+
+    wheel.tick(20);
+    EXPECT_EQ(periodic, 5);
+    EXPECT_FALSE(victim_fired);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST_F(TimerWheelTest, AdvanceUsesWallClock) {
+    timer_wheel wheel(std::chrono::milliseconds(10));
+    EXPECT_EQ(wheel.ticks_for(std::chrono::milliseconds(0)), 1u);
+    EXPECT_EQ(wheel.ticks_for(std::chrono::milliseconds(25)), 3u);
+
+    bool fired = false;
+    wheel.schedule_after(std::chrono::milliseconds(30), [&]() { fired = true; });
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(wheel.advance(start + std::chrono::milliseconds(15)), 0u);
+    EXPECT_FALSE(fired);
+    EXPECT_EQ(wheel.advance(start + std::chrono::milliseconds(40)), 1u);
+    EXPECT_TRUE(fired);
+
+    // An empty wheel jumps straight to the target tick
+    wheel.advance(start + std::chrono::hours(24));
+    EXPECT_GE(wheel.current_tick(), 8640000u);
+}
+
+TEST_F(TimerWheelTest, InvalidArguments) {
+    EXPECT_THROW(timer_wheel(std::chrono::milliseconds(0)), std::invalid_argument);
+    timer_wheel wheel;
+    EXPECT_THROW(wheel.schedule(1, nullptr), std::invalid_argument);
+}
@@ -1,14 +1,23 @@
 #include <gtest/gtest.h>
 #include <fb/udp_server.h>
 #include <fb/udp_client.h>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 #include <system_error>
 #include <thread>
 #include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 using namespace fb;
 
 // Simple echo handler for testing
@@ -45,6 +54,18 @@ public:
 
 std::atomic<int> CounterHandler::packet_count{0};
 
+// Handler that holds its worker long enough for a backlog to build up
+class SlowHandler : public udp_handler
+{
+public:
+    void handle_packet(const void* buffer, std::size_t length,
+                      const socket_address& sender_address) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CounterHandler::packet_count++;
+    }
+};
+
 class UDPServerTest : public ::testing::Test
 {
 protected:
@@ -226,6 +247,723 @@ TEST_F(UDPServerTest, ConcurrentClients) {
     server.stop();
 }
 
+TEST_F(UDPServerTest, BatchedReceive) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<CounterHandler>();
+
+    udp_server server(std::move(server_sock), handler);
+    server.set_receive_batch_size(16);
+    EXPECT_EQ(server.receive_batch_size(), 16u);
+    server.start();
+
+    const int num_packets = 50;
+    udp_client client;
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+    }
+
+    for (int i = 0; i < 50 && CounterHandler::packet_count.load() < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(CounterHandler::packet_count.load(), num_packets);
+    EXPECT_EQ(server.total_packets(), static_cast<std::uint64_t>(num_packets));
+
+    EXPECT_THROW(server.set_receive_batch_size(4), std::runtime_error);
+
+    server.stop();
+}
+
+TEST_F(UDPServerTest, BatchHandlerReceivesBursts) {
+    class BurstHandler : public udp_handler
+    {
+    public:
+        std::atomic<std::size_t> packets{0};
+        std::atomic<std::size_t> largest{0};
+        std::atomic<bool> held{false};
+
+        // Hold the first call so the rest of the burst queues up
+        void hold_once()
+        {
+            if (!held.exchange(true)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+        }
+
+        void handle_packet(const void*, std::size_t,
+                           const socket_address&) override
+        {
+            hold_once();
+            packets++;
+        }
+
+        std::size_t handle_batch(const packet_view* batch, std::size_t count) override
+        {
+            hold_once();
+            std::size_t bytes = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                bytes += batch[i].length;
+            }
+            packets += count;
+            largest = std::max(largest.load(), count);
+            record_batch(count, bytes, 0);
+            return count;
+        }
+    };
+
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<BurstHandler>();
+    udp_server server(std::move(server_sock), handler);
+    server.set_receive_batch_size(16);
+    server.set_flow_affinity(1);
+    server.start();
+
+    const std::size_t num_packets = 40;
+    udp_client client;
+    for (std::size_t i = 0; i < num_packets; ++i) {
+        client.send_to("burst", server_addr);
+    }
+    for (int i = 0; i < 100 && handler->packets.load() < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    server.stop();
+
+    // Bursts bypass handle_packet() but still show up in the statistics
+    EXPECT_EQ(handler->packets.load(), num_packets);
+    EXPECT_EQ(server.processed_packets(), static_cast<std::uint64_t>(num_packets));
+    EXPECT_EQ(handler->packets_processed(), static_cast<std::uint64_t>(num_packets));
+    EXPECT_GT(handler->largest.load(), 1u);
+    EXPECT_LE(handler->largest.load(), 16u);
+}
+
+#ifndef _WIN32
+TEST_F(UDPServerTest, ReceiveTimestampsReachHandler) {
+    class TimestampHandler : public udp_handler
+    {
+    public:
+        std::atomic<int> stamped{0};
+
+        void handle_packet(const void*, std::size_t,
+                           const socket_address&) override
+        {
+            if (packet_timestamp().has_software()) {
+                stamped++;
+            }
+        }
+    };
+
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    server_sock.set_receive_timestamps(udp_socket::TIMESTAMP_SOFTWARE);
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<TimestampHandler>();
+    udp_server server(std::move(server_sock), handler);
+
+    std::atomic<int> signalled{0};
+    server.onTimestampedPacketReceived.connect(
+        [&](const void*, std::size_t, const socket_address&, const udp_timestamp& timestamp) {
+            if (timestamp.has_software()) {
+                signalled++;
+            }
+        });
+    server.start();
+
+    const int num_packets = 5;
+    udp_client client;
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+    }
+
+    for (int i = 0; i < 50 && handler->stamped.load() < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(handler->stamped.load(), num_packets);
+    EXPECT_EQ(signalled.load(), num_packets);
+
+    server.stop();
+}
+#endif
+
+TEST_F(UDPServerTest, BusyPollReceive) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<CounterHandler>();
+
+    udp_server server(std::move(server_sock), handler);
+    EXPECT_EQ(server.busy_poll(), std::chrono::microseconds(0));
+    EXPECT_THROW(server.set_busy_poll(std::chrono::microseconds(-1)), std::invalid_argument);
+    server.set_busy_poll(std::chrono::microseconds(2000), 0);
+    EXPECT_EQ(server.busy_poll(), std::chrono::microseconds(2000));
+    server.start();
+
+    const int num_packets = 20;
+    udp_client client;
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+
+    for (int i = 0; i < 50 && CounterHandler::packet_count.load() < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(CounterHandler::packet_count.load(), num_packets);
+    EXPECT_THROW(server.set_busy_poll(std::chrono::microseconds(0)), std::runtime_error);
+
+    server.stop();
+}
+
+TEST_F(UDPServerTest, LatencyTracking) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<CounterHandler>();
+
+    udp_server server(std::move(server_sock), handler);
+    EXPECT_FALSE(server.latency_tracking());
+    EXPECT_EQ(server.queue_latency().count, 0u);
+    server.set_latency_tracking(true);
+
+    std::atomic<int> signalled{0};
+    server.onLatencyRecorded.connect([&](std::chrono::nanoseconds, std::chrono::nanoseconds) {
+        signalled++;
+    });
+    server.start();
+
+    const int num_packets = 10;
+    udp_client client;
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+    }
+
+    for (int i = 0; i < 50 && server.service_latency().count < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    latency_snapshot queue = server.queue_latency();
+    latency_snapshot service = server.service_latency();
+    EXPECT_EQ(queue.count, static_cast<std::uint64_t>(num_packets));
+    EXPECT_EQ(service.count, static_cast<std::uint64_t>(num_packets));
+    EXPECT_GT(queue.max.count(), 0);
+    EXPECT_LE(service.p50, service.max);
+    EXPECT_EQ(signalled.load(), num_packets);
+    EXPECT_THROW(server.set_latency_tracking(false), std::runtime_error);
+
+    server.reset_latency_statistics();
+    EXPECT_EQ(server.queue_latency().count, 0u);
+
+    server.stop();
+}
+
+TEST_F(UDPServerTest, WorkerPoolPolicyValidation) {
+    udp_server server;
+    EXPECT_EQ(server.worker_pool().min_threads, 0u);
+    EXPECT_EQ(server.worker_pool().queue_depth_per_thread, 1u);
+
+    worker_pool_policy policy;
+    policy.queue_depth_per_thread = 0;
+    EXPECT_THROW(server.set_worker_pool(policy), std::invalid_argument);
+
+    policy.queue_depth_per_thread = 4;
+    policy.idle_timeout = std::chrono::milliseconds(-1);
+    EXPECT_THROW(server.set_worker_pool(policy), std::invalid_argument);
+
+    policy.idle_timeout = std::chrono::milliseconds(500);
+    server.set_worker_pool(policy);
+    EXPECT_EQ(server.worker_pool().queue_depth_per_thread, 4u);
+    EXPECT_EQ(server.worker_pool().idle_timeout, std::chrono::milliseconds(500));
+}
+
+TEST_F(UDPServerTest, WorkerPoolGrowsAndRetiresIdleThreads) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    udp_server server(std::move(server_sock), std::make_shared<SlowHandler>(), 6);
+    worker_pool_policy policy;
+    policy.min_threads = 1;
+    policy.idle_timeout = std::chrono::milliseconds(100);
+    server.set_worker_pool(policy);
+
+    std::atomic<std::size_t> peak{0};
+    std::atomic<int> destroyed{0};
+    server.onWorkerThreadCreated.connect([&](std::size_t count) {
+        if (count > peak.load()) {
+            peak = count;
+        }
+    });
+    server.onWorkerThreadDestroyed.connect([&](std::size_t) { destroyed++; });
+    server.start();
+    EXPECT_EQ(server.thread_count(), 1u);
+
+    const int num_packets = 60;
+    udp_client client;
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+    }
+
+    for (int i = 0; i < 100 && CounterHandler::packet_count.load() < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(CounterHandler::packet_count.load(), num_packets);
+    EXPECT_GT(peak.load(), 1u);
+    EXPECT_LE(peak.load(), 6u);
+
+    // Surplus workers retire once idle, but never below min_threads
+    for (int i = 0; i < 100 && server.thread_count() > 1; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(server.thread_count(), 1u);
+    EXPECT_EQ(static_cast<std::size_t>(destroyed.load()), peak.load() - 1);
+
+    // The pool grows again for the next burst
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+    }
+    for (int i = 0; i < 100 && CounterHandler::packet_count.load() < 2 * num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_EQ(CounterHandler::packet_count.load(), 2 * num_packets);
+
+    server.stop();
+    EXPECT_EQ(server.thread_count(), 0u);
+}
+
+// Records which thread handled each packet, keyed by the payload's flow tag
+class FlowRecorder : public udp_handler
+{
+public:
+    std::mutex mutex;
+    std::map<std::string, std::set<std::thread::id>> threads;
+    std::map<std::string, std::vector<int>> sequences;
+    std::map<std::uint16_t, std::set<std::thread::id>> sender_threads;
+    std::atomic<int> handled{0};
+
+    void handle_packet(const void* buffer, std::size_t length,
+                      const socket_address& sender_address) override
+    {
+        const std::string payload(static_cast<const char*>(buffer), length);
+        const auto colon = payload.find(':');
+        const std::string flow = payload.substr(0, colon);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads[flow].insert(std::this_thread::get_id());
+            sender_threads[sender_address.port()].insert(std::this_thread::get_id());
+            if (colon != std::string::npos) {
+                sequences[flow].push_back(std::stoi(payload.substr(colon + 1)));
+            }
+        }
+        handled++;
+    }
+};
+
+TEST_F(UDPServerTest, FlowAffinityByPayloadKey) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<FlowRecorder>();
+    udp_server server(std::move(server_sock), handler);
+    server.set_flow_affinity(4, [](const udp_server::PacketData& packet) -> std::uint64_t {
+        const auto* begin = reinterpret_cast<const char*>(packet.buffer.data());
+        const auto* end = begin + packet.buffer.size();
+        return std::hash<std::string>()(std::string(begin, std::find(begin, end, ':')));
+    });
+    EXPECT_EQ(server.flow_workers(), 4u);
+    server.start();
+    EXPECT_EQ(server.thread_count(), 4u);
+    EXPECT_THROW(server.set_flow_affinity(2), std::runtime_error);
+
+    const int flows = 8;
+    const int per_flow = 50;
+    udp_client client;
+    for (int seq = 0; seq < per_flow; ++seq) {
+        for (int flow = 0; flow < flows; ++flow) {
+            client.send_to("flow" + std::to_string(flow) + ":" + std::to_string(seq), server_addr);
+        }
+    }
+
+    for (int i = 0; i < 100 && handler->handled.load() < flows * per_flow; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    server.stop();
+
+    std::lock_guard<std::mutex> lock(handler->mutex);
+    ASSERT_EQ(handler->threads.size(), static_cast<std::size_t>(flows));
+    for (const auto& entry : handler->threads) {
+        EXPECT_EQ(entry.second.size(), 1u) << entry.first;
+        const auto& seqs = handler->sequences[entry.first];
+        EXPECT_TRUE(std::is_sorted(seqs.begin(), seqs.end())) << entry.first;
+    }
+}
+
+TEST_F(UDPServerTest, FlowAffinityBySender) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<FlowRecorder>();
+    udp_server server(std::move(server_sock), handler);
+    server.set_flow_affinity(3);
+    server.start();
+
+    std::vector<std::unique_ptr<udp_client>> clients;
+    for (int i = 0; i < 4; ++i) {
+        clients.push_back(std::make_unique<udp_client>());
+    }
+    const int per_sender = 30;
+    for (int seq = 0; seq < per_sender; ++seq) {
+        for (auto& client : clients) {
+            client->send_to("sender:" + std::to_string(seq), server_addr);
+        }
+    }
+
+    const int total = per_sender * static_cast<int>(clients.size());
+    for (int i = 0; i < 100 && handler->handled.load() < total; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    server.stop();
+
+    EXPECT_EQ(handler->handled.load(), total);
+    std::lock_guard<std::mutex> lock(handler->mutex);
+    EXPECT_EQ(handler->sender_threads.size(), clients.size());
+    for (const auto& entry : handler->sender_threads) {
+        EXPECT_EQ(entry.second.size(), 1u) << entry.first;
+    }
+}
+
+TEST_F(UDPServerTest, ReceiveBatchSizeDefaults) {
+    udp_server server;
+    EXPECT_EQ(server.receive_batch_size(), 1u);
+
+    server.set_receive_batch_size(0);
+    EXPECT_EQ(server.receive_batch_size(), 1u);
+
+    server.set_receive_batch_size(100000);
+    EXPECT_EQ(server.receive_batch_size(), 1024u);
+}
+
+TEST_F(UDPServerTest, PacketPoolRecyclesPackets) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<CounterHandler>();
+
+    udp_server server(std::move(server_sock), handler);
+    server.set_packet_pool_size(8);
+    EXPECT_EQ(server.packet_pool_size(), 8u);
+    server.start();
+
+    const int num_packets = 40;
+    udp_client client;
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+    }
+
+    for (int i = 0; i < 50 && CounterHandler::packet_count.load() < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(CounterHandler::packet_count.load(), num_packets);
+    EXPECT_GT(server.pooled_packets(), 0u);
+    EXPECT_LE(server.pooled_packets(), 8u);
+
+    server.stop();
+}
+
+TEST_F(UDPServerTest, PacketPoolDisabled) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<CounterHandler>();
+
+    udp_server server(std::move(server_sock), handler);
+    server.set_packet_pool_size(0);
+    server.start();
+
+    udp_client client;
+    for (int i = 0; i < 5; ++i) {
+        client.send_to("test", server_addr);
+    }
+
+    for (int i = 0; i < 50 && CounterHandler::packet_count.load() < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(CounterHandler::packet_count.load(), 5);
+    EXPECT_EQ(server.pooled_packets(), 0u);
+
+    server.stop();
+}
+
+TEST_F(UDPServerTest, PacketAllocatorSuppliesPackets) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<CounterHandler>();
+    auto packets = std::make_shared<udp_server::packet_pool>(16);
+
+    udp_server server(std::move(server_sock), handler);
+    EXPECT_EQ(server.packet_allocator(), nullptr);
+    server.set_packet_pool_size(0);
+    server.set_packet_allocator(packets);
+    EXPECT_EQ(server.packet_allocator(), packets);
+    server.start();
+
+    const int num_packets = 40;
+    udp_client client;
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+    }
+
+    for (int i = 0; i < 50 && CounterHandler::packet_count.load() < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(CounterHandler::packet_count.load(), num_packets);
+    EXPECT_GE(packets->blocks().capacity(), 16u);
+    EXPECT_THROW(server.set_packet_allocator(nullptr), std::runtime_error);
+
+    server.stop();
+    server.set_packet_allocator(nullptr);
+}
+
+TEST_F(UDPServerTest, LockFreeQueue) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<CounterHandler>();
+
+    udp_server server(std::move(server_sock), handler);
+    server.set_lock_free_queue(true, 64);
+    server.set_receive_batch_size(8);
+    EXPECT_TRUE(server.lock_free_queue());
+    server.start();
+
+    const int num_packets = 100;
+    udp_client client;
+    for (int i = 0; i < num_packets; ++i) {
+        client.send_to("Packet " + std::to_string(i), server_addr);
+    }
+
+    for (int i = 0; i < 50 && CounterHandler::packet_count.load() < num_packets; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(CounterHandler::packet_count.load(), num_packets);
+    EXPECT_EQ(server.queued_packets(), 0u);
+
+    server.stop();
+}
+
+TEST_F(UDPServerTest, LockFreeQueueDropsWhenFull) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    std::atomic<bool> release{false};
+    class BlockingHandler : public udp_handler
+    {
+    public:
+        explicit BlockingHandler(std::atomic<bool>& flag) : m_flag(flag) {}
+        void handle_packet(const void*, std::size_t, const socket_address&) override
+        {
+            while (!m_flag.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    private:
+        std::atomic<bool>& m_flag;
+    };
+
+    udp_server server(std::move(server_sock), std::make_shared<BlockingHandler>(release), 1, 4);
+    server.set_lock_free_queue(true);
+    server.start();
+
+    udp_client client;
+    for (int i = 0; i < 20; ++i) {
+        client.send_to("x", server_addr);
+    }
+
+    for (int i = 0; i < 50 && server.total_packets() < 20; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(server.total_packets(), 20u);
+    EXPECT_GT(server.dropped_packets(), 0u);
+    EXPECT_LE(server.queued_packets(), 4u);
+
+    release = true;
+    server.stop();
+}
+
+TEST_F(UDPServerTest, ShardedReceivers) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0), true, true);
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<CounterHandler>();
+
+    udp_server server(std::move(server_sock), handler);
+    server.set_receiver_shards(3, true);
+    EXPECT_EQ(server.receiver_shards(), 3u);
+    server.start();
+
+    // Distinct source ports so the kernel can hash flows onto different shards
+    const int num_clients = 12;
+    const int packets_per_client = 5;
+    for (int i = 0; i < num_clients; ++i) {
+        udp_client client;
+        for (int j = 0; j < packets_per_client; ++j) {
+            client.send_to("Shard packet", server_addr);
+        }
+    }
+
+    const int expected = num_clients * packets_per_client;
+    for (int i = 0; i < 50 && CounterHandler::packet_count.load() < expected; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(CounterHandler::packet_count.load(), expected);
+    EXPECT_EQ(server.total_packets(), static_cast<std::uint64_t>(expected));
+
+    server.stop();
+}
+
+TEST_F(UDPServerTest, ShardedReceiversRequireReusePort) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+
+    udp_server server(std::move(server_sock), std::make_shared<CounterHandler>());
+    server.set_receiver_shards(2);
+
+    EXPECT_THROW(server.start(), std::logic_error);
+    EXPECT_FALSE(server.is_running());
+}
+
+// Records the name of the worker thread that handles each packet
+class ThreadNameRecorder : public udp_handler
+{
+public:
+    std::mutex mutex;
+    std::set<std::string> names;
+
+    void handle_packet(const void* buffer, std::size_t length,
+                      const socket_address& sender_address) override
+    {
+        char name[16] = {};
+#ifdef __linux__
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+#endif
+        std::lock_guard<std::mutex> lock(mutex);
+        names.insert(name);
+        CounterHandler::packet_count++;
+    }
+};
+
+TEST_F(UDPServerTest, ThreadConfiguratorRunsOnEveryThread) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    auto handler = std::make_shared<ThreadNameRecorder>();
+    udp_server server(std::move(server_sock), handler, 2);
+    server.set_worker_pool([] {
+        worker_pool_policy policy;
+        policy.min_threads = 2;
+        return policy;
+    }());
+
+    std::mutex mutex;
+    std::set<std::pair<thread_role, std::size_t>> configured;
+    server.set_thread_configurator([&](thread_role role, std::size_t index) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            configured.emplace(role, index);
+        }
+        thread_config config;
+        config.name = (role == thread_role::worker ? "fb-work-" : "fb-recv-") +
+                      std::to_string(index);
+        return config;
+    });
+
+    std::atomic<int> failures{0};
+    server.onException.connect([&](const std::exception&, const std::string& context) {
+        if (context == "thread_config") {
+            failures++;
+        }
+    });
+
+    server.start();
+    EXPECT_THROW(server.set_thread_configurator(nullptr), std::runtime_error);
+
+    udp_client client;
+    for (int i = 0; i < 20; ++i) {
+        client.send_to("name?", server_addr);
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (CounterHandler::packet_count.load() < 20 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    server.stop();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(configured.count({thread_role::receiver, 0}), 1u);
+    EXPECT_EQ(configured.count({thread_role::worker, 0}), 1u);
+    EXPECT_EQ(configured.count({thread_role::worker, 1}), 1u);
+    ASSERT_EQ(CounterHandler::packet_count.load(), 20);
+#ifdef __linux__
+    for (const auto& name : handler->names) {
+        EXPECT_EQ(name.rfind("fb-work-", 0), 0u) << name;
+    }
+#endif
+}
+
+TEST_F(UDPServerTest, ThreadConfigValidation) {
+    thread_config config;
+    config.cpus = {-1};
+    EXPECT_THROW(apply_thread_config(config), std::invalid_argument);
+    EXPECT_NO_THROW(apply_thread_config(thread_config()));
+
+#ifdef __linux__
+    // Pin a scratch thread to the last CPU this process may use
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    std::size_t last = CPU_SETSIZE - 1;
+    while (last > 0 && !CPU_ISSET(last, &allowed)) {
+        --last;
+    }
+    const int cpu = static_cast<int>(last);
+    int ran_on = -1;
+    std::string name(16, '\0');
+    std::thread([&] {
+        thread_config pinned;
+        pinned.cpus = {cpu};
+        pinned.name = "fb-pinned-thread-long-name";
+        apply_thread_config(pinned);
+        ran_on = sched_getcpu();
+        pthread_getname_np(pthread_self(), &name[0], name.size());
+    }).join();
+    EXPECT_EQ(ran_on, cpu);
+    EXPECT_STREQ(name.c_str(), "fb-pinned-threa");
+#endif
+}
+
 TEST_F(UDPServerTest, MaxThreads) {
     udp_socket server_sock(socket_address::Family::IPv4);
     server_sock.bind(socket_address("127.0.0.1", 0));
@@ -266,6 +1004,47 @@ TEST_F(UDPServerTest, TotalPackets) {
     server.stop();
 }
 
+TEST_F(UDPServerTest, AggregatedStatisticsSignals) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    udp_server server(std::move(server_sock), std::make_shared<CounterHandler>());
+    EXPECT_THROW(server.set_statistics_interval(std::chrono::milliseconds(-1)),
+                 std::invalid_argument);
+    server.set_statistics_interval(std::chrono::milliseconds(50));
+    EXPECT_EQ(server.statistics_interval(), std::chrono::milliseconds(50));
+
+    std::atomic<int> total_emits{0};
+    std::atomic<int> processed_emits{0};
+    std::atomic<std::size_t> last_processed{0};
+    server.onTotalPacketsChanged.connect([&](std::size_t) { ++total_emits; });
+    server.onProcessedPacketsChanged.connect([&](std::size_t processed) {
+        ++processed_emits;
+        last_processed = processed;
+    });
+    server.start();
+
+    const int count = 200;
+    udp_client client;
+    for (int i = 0; i < count; ++i) {
+        client.send_to("test", server_addr);
+    }
+
+    for (int i = 0; i < 200 && CounterHandler::packet_count.load() < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_THROW(server.set_statistics_interval(std::chrono::milliseconds(0)),
+                 std::runtime_error);
+    server.stop();
+
+    // The final publication in stop() reports the complete count
+    EXPECT_EQ(last_processed.load(), server.processed_packets());
+    EXPECT_GT(total_emits.load(), 0);
+    EXPECT_LT(total_emits.load(), count / 4);
+    EXPECT_LT(processed_emits.load(), count / 4);
+}
+
 TEST_F(UDPServerTest, MoveSemantics) {
     udp_socket server_sock1(socket_address::Family::IPv4);
     server_sock1.bind(socket_address("127.0.0.1", 0));
@@ -298,6 +1077,7 @@ TEST_F(UDPServerTest, HandlerFactory) {
     socket_address server_addr = server_sock.address();
 
     udp_server server(std::move(server_sock), std::make_shared<CounterHandler>());
+    server.set_handler_cache_size(0);
 
     // Factory creates new handler for each packet
     auto factory = [&server](const udp_server::PacketData& packet) {
@@ -322,6 +1102,67 @@ TEST_F(UDPServerTest, HandlerFactory) {
     server.stop();
 }
 
+// Handler that only serves the sender port it was built for
+class PortHandler : public udp_handler
+{
+public:
+    explicit PortHandler(std::uint16_t port) : m_port(port) {}
+
+    bool can_handle_address(const socket_address& sender_address) const override
+    {
+        return sender_address.port() == m_port;
+    }
+
+    void handle_packet(const void* buffer, std::size_t length,
+                      const socket_address& sender_address) override
+    {
+        CounterHandler::packet_count++;
+    }
+
+private:
+    std::uint16_t m_port;
+};
+
+TEST_F(UDPServerTest, HandlerFactoryReusesHandlersPerWorker) {
+    udp_socket server_sock(socket_address::Family::IPv4);
+    server_sock.bind(socket_address("127.0.0.1", 0));
+    socket_address server_addr = server_sock.address();
+
+    std::atomic<int> factory_calls(0);
+    auto factory = [&factory_calls](const udp_server::PacketData& packet) {
+        factory_calls++;
+        return std::make_unique<PortHandler>(packet.sender_address.port());
+    };
+
+    const std::size_t max_threads = 2;
+    udp_server server(std::move(server_sock), factory, max_threads);
+    EXPECT_EQ(server.handler_cache_size(), 8u);
+    server.start();
+    EXPECT_THROW(server.set_handler_cache_size(1), std::runtime_error);
+
+    // Two senders: each worker needs at most one handler per sender
+    udp_client first;
+    udp_client second;
+    const int per_client = 50;
+    for (int i = 0; i < per_client; ++i) {
+        first.send_to("a", server_addr);
+        second.send_to("b", server_addr);
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (CounterHandler::packet_count.load() < 2 * per_client &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    server.stop();
+
+    EXPECT_EQ(CounterHandler::packet_count.load(), 2 * per_client);
+    EXPECT_EQ(server.processed_packets(), static_cast<std::uint64_t>(2 * per_client));
+    EXPECT_EQ(server.handler_instances(), static_cast<std::uint64_t>(factory_calls.load()));
+    EXPECT_GE(factory_calls.load(), 2);
+    EXPECT_LE(factory_calls.load(), static_cast<int>(2 * max_threads));
+}
+
 TEST_F(UDPServerTest, GracefulShutdown) {
     udp_socket server_sock(socket_address::Family::IPv4);
     server_sock.bind(socket_address("127.0.0.1", 0));
@@ -1,10 +1,14 @@
 /// @file fb_signal_bench.cpp
 /// @brief Standardized benchmark suite for signal/slot library comparison
-/// @note Multi-threaded scenarios for fair performance evaluation
+/// @note Multi-threaded scenarios for fair performance evaluation. Run with
+///       --format=json to get one JSON object per result line for comparison
+///       across builds.
 
 
 #include <fb/event_queue.hpp>
+#include <fb/keyed_signal.hpp>
 #include <fb/signal.hpp>
+#include <fb/static_signal.hpp>
 
 #include <algorithm>
 #include <atomic>
@@ -13,7 +17,10 @@
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -22,19 +29,38 @@ using clock_type = std::chrono::steady_clock;
 using ns_duration = std::chrono::nanoseconds;
 
 constexpr std::size_t WARMUP_ITERS = 10000;
-constexpr std::size_t BENCH_ITERS = 1000000;
-constexpr std::size_t SAMPLE_COUNT = 1000;
+constexpr std::size_t SAMPLE_COUNT = 10000;
 
 // ============================================================================
-// Timing utilities
+// Results and reporting
 // ============================================================================
 
+enum class output_format { table, json };
+
+struct options {
+  output_format format = output_format::table;
+  std::string filter;
+  std::size_t scale = 10;   ///< Iteration multiplier; --quick sets 1
+  unsigned max_threads = 0; ///< Top of the contention curves; 0 = all cores
+};
+
 struct stats {
+  std::size_t samples;
   double min_ns;
   double max_ns;
   double mean_ns;
-  double median_ns;
+  double p50_ns;
   double p99_ns;
+  double p999_ns;
+
+  /// @brief Nearest-rank percentile of sorted @p samples
+  static double percentile(const std::vector<double> &samples, double fraction) {
+    std::size_t idx = static_cast<std::size_t>(
+        static_cast<double>(samples.size()) * fraction);
+    if (idx >= samples.size())
+      idx = samples.size() - 1;
+    return samples[idx];
+  }
 
   static stats compute(std::vector<double> &samples) {
     stats s{};
@@ -42,25 +68,103 @@ struct stats {
       return s;
 
     std::sort(samples.begin(), samples.end());
+    s.samples = samples.size();
     s.min_ns = samples.front();
     s.max_ns = samples.back();
     s.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) /
                 static_cast<double>(samples.size());
-
-    std::size_t mid = samples.size() / 2;
-    s.median_ns = (samples.size() % 2 == 0)
-                      ? (samples[mid - 1] + samples[mid]) / 2.0
-                      : samples[mid];
-
-    std::size_t p99_idx = static_cast<std::size_t>(samples.size() * 0.99);
-    if (p99_idx >= samples.size())
-      p99_idx = samples.size() - 1;
-    s.p99_ns = samples[p99_idx];
+    s.p50_ns = percentile(samples, 0.50);
+    s.p99_ns = percentile(samples, 0.99);
+    s.p999_ns = percentile(samples, 0.999);
 
     return s;
   }
 };
 
+struct result {
+  std::string benchmark;
+  std::string variant;
+  stats timing;
+  std::vector<std::pair<std::string, double>> extra; ///< E.g. throughput
+};
+
+std::string format_number(double value) {
+  std::ostringstream out;
+  if (value == static_cast<double>(static_cast<std::int64_t>(value)))
+    out << static_cast<std::int64_t>(value);
+  else
+    out << std::fixed << std::setprecision(2) << value;
+  return out.str();
+}
+
+void report(const options &opts, const result &r) {
+  const std::vector<std::pair<std::string, double>> metrics = {
+      {"samples", static_cast<double>(r.timing.samples)},
+      {"min_ns", r.timing.min_ns},
+      {"mean_ns", r.timing.mean_ns},
+      {"p50_ns", r.timing.p50_ns},
+      {"p99_ns", r.timing.p99_ns},
+      {"p999_ns", r.timing.p999_ns},
+      {"max_ns", r.timing.max_ns}};
+
+  if (opts.format == output_format::json) {
+    std::cout << "{\"benchmark\":\"" << r.benchmark << "\",\"variant\":\""
+              << r.variant << "\"";
+    for (const auto &metric : metrics)
+      std::cout << ",\"" << metric.first << "\":" << format_number(metric.second);
+    for (const auto &metric : r.extra)
+      std::cout << ",\"" << metric.first << "\":" << format_number(metric.second);
+    std::cout << "}\n";
+  } else {
+    std::cout << std::left << std::setw(24) << r.benchmark << std::setw(28)
+              << r.variant << std::fixed << std::setprecision(1)
+              << " p50: " << std::setw(8) << r.timing.p50_ns
+              << " p99: " << std::setw(8) << r.timing.p99_ns
+              << " p999: " << std::setw(8) << r.timing.p999_ns
+              << " mean: " << std::setw(8) << r.timing.mean_ns << " ns";
+    for (const auto &metric : r.extra)
+      std::cout << "  " << metric.first << '=' << format_number(metric.second);
+    std::cout << '\n';
+  }
+  std::cout.flush();
+}
+
+void report(const options &opts, const char *benchmark,
+            const std::string &variant, const stats &s) {
+  report(opts, result{benchmark, variant, s, {}});
+}
+
+void section(const options &opts, const char *title) {
+  if (opts.format == output_format::table)
+    std::cout << "\n--- " << title << " ---\n";
+}
+
+bool selected(const options &opts, const std::string &name) {
+  return opts.filter.empty() || name.find(opts.filter) != std::string::npos;
+}
+
+/// @brief 1, 2, 4, ... up to the thread limit, which is always included
+std::vector<int> thread_counts(const options &opts) {
+  unsigned limit = opts.max_threads;
+  if (limit == 0)
+    limit = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<int> counts;
+  for (unsigned n = 1; n < limit; n *= 2)
+    counts.push_back(static_cast<int>(n));
+  counts.push_back(static_cast<int>(limit));
+  return counts;
+}
+
+double elapsed_ns(clock_type::time_point start, clock_type::time_point end) {
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// ============================================================================
+// Timing utilities
+// ============================================================================
+
+/// @brief Per-operation times of @p samples batches of @p ops_per_sample calls
 template <typename Fn>
 stats benchmark_latency(Fn &&fn, std::size_t warmup, std::size_t samples,
                         std::size_t ops_per_sample) {
@@ -78,36 +182,33 @@ stats benchmark_latency(Fn &&fn, std::size_t warmup, std::size_t samples,
       fn();
     auto end = clock_type::now();
 
-    double ns = std::chrono::duration<double, std::nano>(end - start).count();
-    timings.push_back(ns / static_cast<double>(ops_per_sample));
+    timings.push_back(elapsed_ns(start, end) /
+                      static_cast<double>(ops_per_sample));
   }
 
   return stats::compute(timings);
 }
 
-void print_result(const char *name, const stats &s) {
-  std::cout << std::left << std::setw(40) << name << " median: " << std::setw(8)
-            << std::fixed << std::setprecision(1) << s.median_ns << " ns"
-            << "  mean: " << std::setw(8) << s.mean_ns << " ns"
-            << "  p99: " << std::setw(8) << s.p99_ns << " ns\n";
+std::size_t sample_count(const options &opts) {
+  return SAMPLE_COUNT * opts.scale / 10;
 }
 
 // ============================================================================
-// Benchmark implementations  
+// Benchmark implementations
 // ============================================================================
 
-void bench_emit_1_slot() {
+void bench_emit_1_slot(const options &opts) {
   fb::signal<int> sig;
   volatile int sink = 0;
 
   auto conn = sig.connect([&sink](int v) { sink += v; });
 
-  auto s =
-      benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS, SAMPLE_COUNT, 1000);
-  print_result("emit_1_slot (direct)", s);
+  auto s = benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS,
+                             sample_count(opts), 100);
+  report(opts, "emit", "1_slot", s);
 }
 
-void bench_emit_10_slots() {
+void bench_emit_10_slots(const options &opts) {
   fb::signal<int> sig;
   volatile int sink = 0;
 
@@ -116,12 +217,12 @@ void bench_emit_10_slots() {
     conns.push_back(sig.connect([&sink](int v) { sink += v; }));
   }
 
-  auto s =
-      benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS, SAMPLE_COUNT, 1000);
-  print_result("emit_10_slots (direct)", s);
+  auto s = benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS,
+                             sample_count(opts), 100);
+  report(opts, "emit", "10_slots", s);
 }
 
-void bench_emit_100_slots() {
+void bench_emit_100_slots(const options &opts) {
   fb::signal<int> sig;
   volatile int sink = 0;
 
@@ -130,51 +231,142 @@ void bench_emit_100_slots() {
     conns.push_back(sig.connect([&sink](int v) { sink += v; }));
   }
 
-  auto s =
-      benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS, SAMPLE_COUNT, 100);
-  print_result("emit_100_slots (direct)", s);
+  auto s = benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS,
+                             sample_count(opts), 10);
+  report(opts, "emit", "100_slots", s);
 }
 
-void bench_concurrent_emit(int num_threads) {
+void bench_emit_10_filtered_slots(const options &opts) {
   fb::signal<int> sig;
-  std::atomic<int64_t> sink{0};
+  volatile int sink = 0;
 
-  auto conn = sig.connect(
-      [&sink](int v) { sink.fetch_add(v, std::memory_order_relaxed); });
+  // Each slot accepts one key, like per-symbol subscribers
+  std::vector<fb::connection> conns;
+  for (int i = 0; i < 10; ++i) {
+    conns.push_back(sig.connect_filtered([&sink](int v) { sink += v; },
+                                         [i](const int &key) { return key == i; }));
+  }
 
-  constexpr std::size_t ITERS_PER_THREAD = 100000;
-  std::atomic<bool> go{false};
+  auto s = benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS,
+                             sample_count(opts), 100);
+  report(opts, "emit_filtered", "10_slots", s);
+}
+
+void bench_emit_keyed_100_keys(const options &opts) {
+  fb::keyed_signal<int, int> sig;
+  volatile int sink = 0;
+
+  std::vector<fb::connection> conns;
+  for (int i = 0; i < 100; ++i) {
+    conns.push_back(sig.connect(i, [&sink](int v) { sink += v; }));
+  }
+
+  auto s = benchmark_latency([&] { sig.emit(42, 1); }, WARMUP_ITERS,
+                             sample_count(opts), 100);
+  report(opts, "keyed_emit", "1_of_100_keys", s);
+}
+
+void bench_emit_filtered_100_keys(const options &opts) {
+  fb::signal<int, int> sig;
+  volatile int sink = 0;
+
+  // The broadcast equivalent of bench_emit_keyed_100_keys
+  std::vector<fb::connection> conns;
+  for (int i = 0; i < 100; ++i) {
+    conns.push_back(sig.connect_filtered([&sink](int, int v) { sink += v; },
+                                         [i](const int &key, const int &) { return key == i; }));
+  }
+
+  auto s = benchmark_latency([&] { sig.emit(42, 1); }, WARMUP_ITERS,
+                             sample_count(opts), 10);
+  report(opts, "filtered_emit", "1_of_100_keys", s);
+}
+
+void bench_static_emit_1_slot(const options &opts) {
+  fb::static_signal<1, int> sig;
+  volatile int sink = 0;
+
+  sig.connect([&sink](int v) { sink += v; });
+
+  auto s = benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS,
+                             sample_count(opts), 100);
+  report(opts, "static_emit", "1_slot", s);
+}
+
+void bench_static_emit_10_slots(const options &opts) {
+  fb::static_signal<10, int> sig;
+  volatile int sink = 0;
+
+  for (int i = 0; i < 10; ++i) {
+    sig.connect([&sink](int v) { sink += v; });
+  }
+
+  auto s = benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS,
+                             sample_count(opts), 100);
+  report(opts, "static_emit", "10_slots", s);
+}
 
+thread_local int64_t tl_sink = 0;
+
+/// @brief Runs @p body(thread) on @p num_threads threads started together
+///
+/// Each thread times batches of @p batch operations; the result holds every
+/// thread's batches plus the aggregate throughput.
+template <typename Body>
+result run_contended(const char *benchmark, const std::string &variant,
+                     int num_threads, std::size_t batches, std::size_t batch,
+                     Body &&body) {
+  std::atomic<bool> go{false};
   std::vector<std::thread> threads;
-  std::vector<double> thread_times(num_threads);
+  std::vector<std::vector<double>> thread_samples(
+      static_cast<std::size_t>(num_threads));
 
   for (int t = 0; t < num_threads; ++t) {
     threads.emplace_back([&, t]() {
+      std::vector<double> &samples = thread_samples[static_cast<std::size_t>(t)];
+      samples.reserve(batches);
       while (!go.load(std::memory_order_acquire)) {
       }
 
-      auto start = clock_type::now();
-      for (std::size_t i = 0; i < ITERS_PER_THREAD; ++i) {
-        sig.emit(1);
+      for (std::size_t b = 0; b < batches; ++b) {
+        auto start = clock_type::now();
+        for (std::size_t i = 0; i < batch; ++i)
+          body(t);
+        auto end = clock_type::now();
+        samples.push_back(elapsed_ns(start, end) / static_cast<double>(batch));
       }
-      auto end = clock_type::now();
-      thread_times[t] =
-          std::chrono::duration<double, std::nano>(end - start).count() /
-          ITERS_PER_THREAD;
     });
   }
 
+  auto start = clock_type::now();
   go.store(true, std::memory_order_release);
   for (auto &t : threads)
     t.join();
+  const double wall_ns = elapsed_ns(start, clock_type::now());
+
+  std::vector<double> all;
+  for (const auto &samples : thread_samples)
+    all.insert(all.end(), samples.begin(), samples.end());
+
+  const double total_ops = static_cast<double>(num_threads) *
+                           static_cast<double>(batches * batch);
+  return result{benchmark, variant, stats::compute(all),
+                {{"threads", num_threads}, {"mops", total_ops * 1e3 / wall_ns}}};
+}
+
+void bench_concurrent_emit(const options &opts, int num_threads) {
+  fb::signal<int> sig;
+
+  // Per-thread sink: only the signal's own shared state is measured
+  auto conn = sig.connect([](int v) { tl_sink += v; });
 
-  auto s = stats::compute(thread_times);
-  std::string name =
-      "concurrent_emit_" + std::to_string(num_threads) + "_threads";
-  print_result(name.c_str(), s);
+  const std::string variant = std::to_string(num_threads) + "_threads";
+  report(opts, run_contended("concurrent_emit", variant, num_threads,
+                             100 * opts.scale, 100,
+                             [&sig](int) { sig.emit(1); }));
 }
 
-void bench_emit_with_churn() {
+void bench_emit_with_churn(const options &opts) {
   fb::signal<int> sig;
   std::atomic<int64_t> sink{0};
   std::atomic<bool> running{true};
@@ -193,37 +385,58 @@ void bench_emit_with_churn() {
   });
 
   // Benchmark emit under churn
-  auto s =
-      benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS, SAMPLE_COUNT, 100);
+  auto s = benchmark_latency([&] { sig.emit(1); }, WARMUP_ITERS,
+                             sample_count(opts), 10);
 
   running.store(false);
   churn_thread.join();
 
-  print_result("emit_with_connection_churn", s);
+  report(opts, "emit_with_churn", "1_stable_slot", s);
+}
+
+void bench_connect_disconnect(const options &opts) {
+  fb::signal<int> sig;
+  volatile int sink = 0;
+
+  auto s = benchmark_latency(
+      [&] {
+        auto c = sig.connect([&sink](int v) { sink += v; });
+        c.disconnect();
+      },
+      1000, sample_count(opts), 10);
+
+  report(opts, "connect_disconnect", "cycle", s);
 }
 
-void bench_connect_disconnect() {
+void bench_connect_disconnect_large(const options &opts, int existing) {
   fb::signal<int> sig;
   volatile int sink = 0;
 
+  // Per-order style churn next to many long-lived, mixed-priority slots
+  std::vector<fb::connection> conns;
+  for (int i = 0; i < existing; ++i) {
+    conns.push_back(sig.connect([&sink](int v) { sink += v; },
+                                i % 2 ? fb::priority::high : fb::priority::low));
+  }
+
   auto s = benchmark_latency(
       [&] {
         auto c = sig.connect([&sink](int v) { sink += v; });
         c.disconnect();
       },
-      1000, SAMPLE_COUNT, 100);
+      100, sample_count(opts) / 10, 1);
 
-  print_result("connect_disconnect_cycle", s);
+  report(opts, "connect_disconnect", std::to_string(existing) + "_slots", s);
 }
 
-void bench_bulk_connect() {
+void bench_bulk_connect(const options &opts) {
   constexpr int BULK_SIZE = 1000;
   volatile int sink = 0;
 
   std::vector<double> timings;
-  timings.reserve(100);
+  timings.reserve(10 * opts.scale);
 
-  for (int trial = 0; trial < 100; ++trial) {
+  for (std::size_t trial = 0; trial < 10 * opts.scale; ++trial) {
     fb::signal<int> sig;
     std::vector<fb::connection> conns;
     conns.reserve(BULK_SIZE);
@@ -234,22 +447,21 @@ void bench_bulk_connect() {
     }
     auto end = clock_type::now();
 
-    double ns = std::chrono::duration<double, std::nano>(end - start).count() /
-                BULK_SIZE;
-    timings.push_back(ns);
+    timings.push_back(elapsed_ns(start, end) / BULK_SIZE);
   }
 
   auto s = stats::compute(timings);
-  print_result("bulk_connect_1000 (per connection)", s);
+  report(opts, "bulk_connect", "1000 (per connection)", s);
 }
 
-void bench_queued_emit() {
+void bench_queued_emit(const options &opts, fb::delivery_policy policy,
+                       const char *variant) {
   fb::signal<int> sig;
   fb::event_queue queue;
   volatile int sink = 0;
 
   auto conn = sig.connect([&sink](int v) { sink += v; },
-                          fb::delivery_policy::queued, queue);
+                          policy, queue);
 
   // Warmup and drain
   for (std::size_t i = 0; i < WARMUP_ITERS; ++i)
@@ -258,45 +470,187 @@ void bench_queued_emit() {
 
   // Benchmark enqueue time only
   std::vector<double> timings;
-  timings.reserve(SAMPLE_COUNT);
+  timings.reserve(sample_count(opts));
 
-  for (std::size_t s = 0; s < SAMPLE_COUNT; ++s) {
+  for (std::size_t s = 0; s < sample_count(opts); ++s) {
     auto start = clock_type::now();
     for (int i = 0; i < 100; ++i)
       sig.emit(1);
     auto end = clock_type::now();
 
-    double ns =
-        std::chrono::duration<double, std::nano>(end - start).count() / 100;
-    timings.push_back(ns);
+    timings.push_back(elapsed_ns(start, end) / 100);
     queue.process_pending();
   }
 
   auto st = stats::compute(timings);
-  print_result("queued_emit_enqueue", st);
+  report(opts, "queued_emit", variant, st);
+}
+
+void bench_queue_producers(const options &opts, fb::queue_mode mode,
+                           int num_threads, const char *label) {
+  fb::event_queue queue(mode);
+  std::atomic<int> done{0};
+  result r;
+
+  std::thread producers([&]() {
+    // Retry on full so every thread enqueues the same amount
+    r = run_contended("enqueue", std::string(label) + "_" +
+                          std::to_string(num_threads) + "_producers",
+                      num_threads, 100 * opts.scale, 100, [&queue](int) {
+                        while (!queue.enqueue([]() { tl_sink += 1; })) {
+                          std::this_thread::yield();
+                        }
+                      });
+    done.store(1, std::memory_order_release);
+  });
+
+  while (done.load(std::memory_order_acquire) == 0) {
+    if (queue.process_pending() == 0)
+      std::this_thread::yield();
+  }
+  producers.join();
+  queue.process_pending();
+
+  report(opts, r);
+}
+
+/// @brief Emit-to-slot latency of a queued slot on another thread
+///
+/// One event in flight at a time, so each sample is a delivery, not time
+/// spent behind a backlog. The consumer polls process_pending() or sleeps
+/// in wait_and_process() (adds the futex wake-up). Both sides yield while
+/// idle, so "spin" stays meaningful with fewer cores than threads.
+void bench_cross_thread_latency(const options &opts, bool blocking) {
+  fb::signal<clock_type::time_point> sig;
+  fb::event_queue queue;
+  const std::size_t events = 10000 * opts.scale;
+  std::vector<double> latencies;
+  latencies.reserve(events);
+  std::atomic<std::size_t> delivered{0};
+  std::atomic<bool> running{true};
+
+  auto conn = sig.connect(
+      [&](clock_type::time_point sent) {
+        latencies.push_back(elapsed_ns(sent, clock_type::now()));
+        delivered.fetch_add(1, std::memory_order_release);
+      },
+      fb::delivery_policy::queued, queue);
+
+  std::thread consumer([&]() {
+    while (running.load(std::memory_order_acquire)) {
+      if (blocking)
+        queue.wait_and_process(std::chrono::milliseconds(10));
+      else if (queue.process_pending() == 0)
+        std::this_thread::yield();
+    }
+  });
+
+  const std::size_t warmup = events / 10;
+  for (std::size_t i = 0; i < warmup + events; ++i) {
+    if (i == warmup) {
+      latencies.clear();
+    }
+    sig.emit(clock_type::now());
+    while (delivered.load(std::memory_order_acquire) <= i) {
+      std::this_thread::yield();
+    }
+  }
+
+  running.store(false, std::memory_order_release);
+  consumer.join();
+
+  auto s = stats::compute(latencies);
+  report(opts, "cross_thread_latency", blocking ? "wait" : "spin", s);
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+void usage() {
+  std::cout << "usage: fb_signal_bench [--format=table|json] [--quick] "
+               "[--filter=<substring>] [--threads=<max>]\n";
+}
+
+template <typename Fn>
+void run(const options &opts, const std::string &name, Fn &&fn) {
+  if (selected(opts, name))
+    fn();
 }
 
 } // namespace
 
-int main() {
-  std::cout << "=== FooBar Benchmark Results ===\n\n";
-  std::cout << "--- Hot Path Emission ---\n";
-  bench_emit_1_slot();
-  bench_emit_10_slots();
-  bench_emit_100_slots();
+int main(int argc, char **argv) {
+  options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--format=json")
+      opts.format = output_format::json;
+    else if (arg == "--format=table")
+      opts.format = output_format::table;
+    else if (arg == "--quick")
+      opts.scale = 1;
+    else if (arg.rfind("--filter=", 0) == 0)
+      opts.filter = arg.substr(9);
+    else if (arg.rfind("--threads=", 0) == 0)
+      opts.max_threads = static_cast<unsigned>(std::stoul(arg.substr(10)));
+    else {
+      usage();
+      return arg == "--help" ? 0 : 2;
+    }
+  }
+
+  const bool table = opts.format == output_format::table;
+  if (table)
+    std::cout << "=== FooBar Benchmark Results ===\n";
 
-  std::cout << "\n--- Multi-Threaded Contention ---\n";
-  bench_concurrent_emit(4);
-  bench_concurrent_emit(8);
-  bench_emit_with_churn();
+  section(opts, "Hot Path Emission");
+  run(opts, "emit", [&]() {
+    bench_emit_1_slot(opts);
+    bench_emit_10_slots(opts);
+    bench_emit_100_slots(opts);
+  });
+  run(opts, "emit_filtered", [&]() { bench_emit_10_filtered_slots(opts); });
+  run(opts, "keyed_emit", [&]() { bench_emit_keyed_100_keys(opts); });
+  run(opts, "filtered_emit", [&]() { bench_emit_filtered_100_keys(opts); });
+  run(opts, "static_emit", [&]() {
+    bench_static_emit_1_slot(opts);
+    bench_static_emit_10_slots(opts);
+  });
 
-  std::cout << "\n--- Connection Management (Cold Path) ---\n";
-  bench_connect_disconnect();
-  bench_bulk_connect();
+  section(opts, "Multi-Threaded Contention");
+  for (int threads : thread_counts(opts))
+    run(opts, "concurrent_emit", [&]() { bench_concurrent_emit(opts, threads); });
+  run(opts, "emit_with_churn", [&]() { bench_emit_with_churn(opts); });
+
+  section(opts, "Connection Management (Cold Path)");
+  run(opts, "connect_disconnect", [&]() {
+    bench_connect_disconnect(opts);
+    bench_connect_disconnect_large(opts, 1000);
+    bench_connect_disconnect_large(opts, 10000);
+  });
+  run(opts, "bulk_connect", [&]() { bench_bulk_connect(opts); });
 
-  std::cout << "\n--- Queued Delivery ---\n";
-  bench_queued_emit();
+  section(opts, "Queued Delivery");
+  run(opts, "queued_emit", [&]() {
+    bench_queued_emit(opts, fb::delivery_policy::queued, "queued");
+    bench_queued_emit(opts, fb::delivery_policy::queued_latest,
+                      "queued_latest");
+  });
+  for (int threads : thread_counts(opts)) {
+    run(opts, "enqueue", [&]() {
+      bench_queue_producers(opts, fb::queue_mode::shared_ring, threads,
+                            "shared_ring");
+      bench_queue_producers(opts, fb::queue_mode::producer_lanes, threads,
+                            "producer_lanes");
+    });
+  }
+  run(opts, "cross_thread_latency", [&]() {
+    bench_cross_thread_latency(opts, false);
+    bench_cross_thread_latency(opts, true);
+  });
 
-  std::cout << "\n=== Benchmark Complete ===\n";
+  if (table)
+    std::cout << "\n=== Benchmark Complete ===\n";
   return 0;
 }
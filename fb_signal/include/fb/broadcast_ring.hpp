@@ -0,0 +1,384 @@
+#pragma once
+
+/// @file broadcast_ring.hpp
+/// @brief Multi-consumer broadcast ring fed by a signal
+///
+/// For one high-rate signal read by many consumer threads. Instead of one
+/// queued copy per subscriber (delivery_policy::queued), each emission is
+/// written once into a ring, and every consumer thread reads it at its own
+/// cursor (disruptor style):
+/// - Producer cost is O(1) whatever the number of consumers: claim a
+///   sequence, write one cell, publish it
+/// - Producers never wait for consumers; a consumer that falls a full
+///   ring behind is detected at its next read, skips to the oldest event
+///   still in the ring and counts the events it lost
+/// - Several producer threads may publish concurrently
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "connection.hpp"
+#include "detail/atomic_utils.hpp"
+#include "signal.hpp"
+
+namespace fb
+{
+namespace detail
+{
+
+/// @brief One ring record and its sequence, on its own cache lines
+///
+/// The sequence doubles as a seqlock: readers copy the record and keep it
+/// only if the sequence did not change. The record is held in atomic
+/// words, so copying it while a producer overwrites it is not a data race.
+template <typename T>
+struct alignas(CACHE_LINE_SIZE) broadcast_cell
+{
+  static constexpr std::size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  /// 0: never written; 2s+1: sequence s being written; 2s+2: s complete
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<uint64_t> words[WORDS];
+
+  static constexpr uint64_t writing(uint64_t s) noexcept
+  {
+    return 2 * s + 1;
+  }
+
+  static constexpr uint64_t complete(uint64_t s) noexcept
+  {
+    return 2 * s + 2;
+  }
+
+  /// Release stores: no word store moves before the claim of the cell
+  void store(const T &value) noexcept
+  {
+    uint64_t buffer[WORDS] = {};
+    std::memcpy(buffer, &value, sizeof(T));
+    for (std::size_t i = 0; i < WORDS; ++i)
+    {
+      words[i].store(buffer[i], std::memory_order_release);
+    }
+  }
+
+  /// Acquire loads: the sequence recheck cannot move before them
+  void load(T &value) const noexcept
+  {
+    uint64_t buffer[WORDS];
+    for (std::size_t i = 0; i < WORDS; ++i)
+    {
+      buffer[i] = words[i].load(std::memory_order_acquire);
+    }
+    std::memcpy(&value, buffer, sizeof(T));
+  }
+};
+
+/// @brief Producer side of a ring over storage it does not own
+///
+/// The head and the cells live in a broadcast_ring or in shared memory
+/// (shm_signal_channel); this holds pointers to them and the algorithm.
+template <typename T>
+struct broadcast_view
+{
+  using cell_type = broadcast_cell<T>;
+
+  std::atomic<uint64_t> *head; ///< Next sequence to claim
+  cell_type *cells;
+  std::size_t mask; ///< Capacity - 1, capacity a power of two
+
+  cell_type &cell_at(uint64_t sequence) const noexcept
+  {
+    return cells[sequence & mask];
+  }
+
+  std::size_t capacity() const noexcept
+  {
+    return mask + 1;
+  }
+
+  uint64_t published() const noexcept
+  {
+    return head->load(std::memory_order_acquire);
+  }
+
+  /// @brief Oldest sequence producers may not have overwritten yet
+  uint64_t oldest() const noexcept
+  {
+    const uint64_t claimed = published();
+    return claimed > capacity() ? claimed - capacity() : 0;
+  }
+
+  /// @param order Of the store completing the write; seq_cst when the
+  ///        caller then checks for sleeping readers
+  void publish(const T &value, std::memory_order order = std::memory_order_release) const noexcept
+  {
+    const uint64_t sequence = head->fetch_add(1, std::memory_order_relaxed);
+    cell_type &slot         = cell_at(sequence);
+
+    spin_wait waiter;
+    uint64_t seen = slot.sequence.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      if (seen >= cell_type::complete(sequence))
+      {
+        return; // A later lap already took the cell: lost for every reader
+      }
+      if ((seen & 1) != 0)
+      {
+        waiter.wait(); // An earlier lap's write still in progress
+        seen = slot.sequence.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (slot.sequence.compare_exchange_weak(seen, cell_type::writing(sequence),
+                                              std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+
+    slot.store(value);
+    slot.sequence.store(cell_type::complete(sequence), order);
+  }
+
+  static std::size_t round_capacity(std::size_t capacity) noexcept
+  {
+    std::size_t rounded = 2;
+    while (rounded < capacity)
+    {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+};
+
+} // namespace detail
+
+/// @brief Consumer cursor into a broadcast_ring or shm_signal_channel
+///
+/// Each consumer thread owns one. Not thread-safe itself: one thread reads
+/// through a reader. The ring must outlive its readers.
+template <typename T>
+class broadcast_reader
+{
+  using cell_type = detail::broadcast_cell<T>;
+
+public:
+  /// @brief Reader starting at sequence @p start of @p view
+  broadcast_reader(const detail::broadcast_view<T> &view, uint64_t start) noexcept :
+    m_view(view),
+    m_next(start)
+  {
+  }
+
+  /// @brief Copy the next event into @p out
+  /// @return false if no new event is published yet
+  bool try_read(T &out) noexcept
+  {
+    for (;;)
+    {
+      const cell_type &slot = m_view.cell_at(m_next);
+      const uint64_t ready  = cell_type::complete(m_next);
+      const uint64_t seen   = slot.sequence.load(std::memory_order_acquire);
+      if (seen < ready)
+      {
+        return false; // Not yet published, or still being written
+      }
+      if (seen == ready)
+      {
+        slot.load(out);
+        if (slot.sequence.load(std::memory_order_relaxed) == ready)
+        {
+          ++m_next;
+          return true;
+        }
+      }
+      // Overwritten by a later lap, before or while reading
+      catch_up();
+    }
+  }
+
+  /// @brief Invoke @p handler(const T &) for each new event
+  /// @return Number of events handled
+  template <typename Handler>
+  std::size_t poll(Handler &&handler,
+                   std::size_t max_events = std::numeric_limits<std::size_t>::max())
+  {
+    std::size_t handled = 0;
+    T value{};
+    while (handled < max_events && try_read(value))
+    {
+      handler(static_cast<const T &>(value));
+      ++handled;
+    }
+    return handled;
+  }
+
+  /// @brief True if an event is ready or the reader was lapped
+  ///
+  /// seq_cst: a reader about to sleep announces itself, then rechecks.
+  bool has_pending() const noexcept
+  {
+    const cell_type &slot = m_view.cell_at(m_next);
+    return slot.sequence.load(std::memory_order_seq_cst) >= cell_type::complete(m_next);
+  }
+
+  /// @brief Events overwritten before this reader got to them
+  uint64_t lost() const noexcept
+  {
+    return m_lost;
+  }
+
+  /// @brief Events claimed by producers but not read yet
+  ///
+  /// At or beyond capacity() the reader is being lapped and will lose
+  /// events at its next read.
+  uint64_t lag() const noexcept
+  {
+    const uint64_t head = m_view.published();
+    return head > m_next ? head - m_next : 0;
+  }
+
+  /// @brief Sequence number of the next event this reader returns
+  uint64_t position() const noexcept
+  {
+    return m_next;
+  }
+
+private:
+  /// @brief Skip to the oldest event the producers have not overwritten
+  void catch_up() noexcept
+  {
+    const uint64_t oldest = m_view.oldest();
+    if (oldest > m_next)
+    {
+      m_lost += oldest - m_next;
+      m_next = oldest;
+    }
+    else
+    {
+      // Raced with the wrap: the cell already holds a newer sequence
+      ++m_lost;
+      ++m_next;
+    }
+  }
+
+  detail::broadcast_view<T> m_view;
+  uint64_t m_next;
+  uint64_t m_lost = 0;
+};
+
+/// @brief Fixed-capacity ring every reader sees in full
+///
+/// @tparam T Event record; trivially copyable and default constructible,
+///           ideally a few cache lines at most (a quote, a fill, a tick)
+///
+/// A slow reader never blocks the producer and never sees a torn record.
+///
+/// Example:
+/// @code
+/// fb::signal<const quote &> on_quote;
+/// fb::broadcast_ring<quote> quotes(4096);
+/// auto bridge = fb::connect_broadcast(on_quote, quotes);
+///
+/// // Each consumer thread
+/// auto reader = quotes.subscribe();
+/// reader.poll([](const quote &q) { price(q); });
+/// if (reader.lost() > 0) { resync(); }  // Fell behind the producer
+/// @endcode
+template <typename T>
+class broadcast_ring
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "broadcast_ring copies records while they may be overwritten: T must be "
+                "trivially copyable");
+  static_assert(std::is_default_constructible_v<T>,
+                "broadcast_ring readers copy into a T: T must be default constructible");
+
+public:
+  using value_type = T;
+  using reader     = broadcast_reader<T>;
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+  /// @param capacity Events kept for slow readers, rounded up to a power
+  ///        of two (at least 2)
+  explicit broadcast_ring(std::size_t capacity = DEFAULT_CAPACITY) :
+    m_cells(new detail::broadcast_cell<T>[detail::broadcast_view<T>::round_capacity(capacity)]),
+    m_view{&m_head, m_cells.get(), detail::broadcast_view<T>::round_capacity(capacity) - 1}
+  {
+  }
+
+  broadcast_ring(const broadcast_ring &)            = delete;
+  broadcast_ring &operator=(const broadcast_ring &) = delete;
+
+  /// @brief Write @p value for every reader - O(1), never waits for readers
+  ///
+  /// Safe from several threads at once. Only a producer lapping another,
+  /// stalled producer on the same cell waits, for that one write.
+  void publish(const T &value) noexcept
+  {
+    m_view.publish(value);
+  }
+
+  /// @brief Reader starting at the next event published
+  reader subscribe() const noexcept
+  {
+    return reader(m_view, m_view.published());
+  }
+
+  /// @brief Reader starting at the oldest event still in the ring
+  reader subscribe_from_oldest() const noexcept
+  {
+    return reader(m_view, m_view.oldest());
+  }
+
+  /// @brief Sequence numbers claimed so far (published or being written)
+  uint64_t published() const noexcept
+  {
+    return m_view.published();
+  }
+
+  std::size_t capacity() const noexcept
+  {
+    return m_view.capacity();
+  }
+
+private:
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<uint64_t> m_head{0}; ///< Next sequence to claim
+  const std::unique_ptr<detail::broadcast_cell<T>[]> m_cells;
+  const detail::broadcast_view<T> m_view;
+};
+
+/// @brief Connect a slot that publishes each emission of @p sig into @p ring
+///
+/// The emitting thread pays one ring write however many readers there
+/// are. The record is built from the arguments: copied if the signal
+/// carries a T, otherwise T(args...) or T{args...}.
+///
+/// @tparam Ring broadcast_ring<T>, or anything with value_type and
+///         publish(const value_type &) such as shm_signal_channel<T>
+/// @return Connection of the bridging slot; disconnect it to stop feeding
+///         the ring, which must outlive it
+template <typename Ring, typename... Args>
+connection connect_broadcast(signal<Args...> &sig, Ring &ring, priority prio = priority::normal)
+{
+  using T = typename Ring::value_type;
+  return sig.connect([&ring](Args... args)
+  {
+    if constexpr (std::is_constructible_v<T, Args...>)
+    {
+      ring.publish(T(args...));
+    }
+    else
+    {
+      ring.publish(T{args...});
+    }
+  }, prio);
+}
+
+} // namespace fb
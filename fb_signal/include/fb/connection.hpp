@@ -19,6 +19,7 @@ namespace fb {
 
 // Forward declarations
 template <typename... Args> class signal;
+template <typename Key, typename... Args> class keyed_signal;
 
 /// @brief Lightweight connection handle
 ///
@@ -70,6 +71,7 @@ public:
 
 private:
   template <typename... Args> friend class signal;
+  template <typename Key, typename... Args> friend class keyed_signal;
 
   template <typename... Args>
   explicit connection(std::shared_ptr<slot_entry<Args...>> slot)
@@ -0,0 +1,204 @@
+#pragma once
+
+/// @file coroutine.hpp
+/// @brief C++20 coroutine support: co_await the next emission of a signal
+///
+/// Everything below is compiled only when the including translation unit
+/// enables coroutines (C++20); FB_SIGNAL_HAS_COROUTINES tells which. The
+/// rest of fb_signal stays C++17.
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define FB_SIGNAL_HAS_COROUTINES 1
+#else
+#define FB_SIGNAL_HAS_COROUTINES 0
+#endif
+
+#if FB_SIGNAL_HAS_COROUTINES
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "connection.hpp"
+#include "slot.hpp"
+
+namespace fb
+{
+
+class event_queue;
+
+template <typename... Args>
+class signal;
+
+/// @brief Coroutine return type for fire-and-forget coroutines
+///
+/// The coroutine starts running immediately and frees its frame when it
+/// finishes; nothing waits for it. An exception escaping the body calls
+/// std::terminate.
+///
+/// Example:
+/// @code
+/// fb::detached_task log_prices(fb::signal<double> &on_price)
+/// {
+///   for (;;)
+///   {
+///     const double price = co_await on_price.next();
+///     record(price);
+///   }
+/// }
+/// @endcode
+struct detached_task
+{
+  struct promise_type
+  {
+    detached_task get_return_object() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never initial_suspend() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never final_suspend() noexcept
+    {
+      return {};
+    }
+
+    void return_void() noexcept
+    {
+    }
+
+    void unhandled_exception() noexcept
+    {
+      std::terminate();
+    }
+  };
+};
+
+/// @brief Awaitable for the next emission of a signal, see signal::next()
+///
+/// co_await yields the emitted arguments: nothing for signal<>, the value
+/// for one argument, a std::tuple for several. Arguments are copied, so
+/// they must be copyable.
+///
+/// The awaiting coroutine connects a one-shot slot and suspends. It is
+/// resumed inside the emitting thread's emit() (next()), or by the queue's
+/// owner thread processing its events (next(queue)). Destroying a coroutine
+/// suspended here disconnects the slot; do not do so while another thread
+/// may be emitting.
+template <typename... Args>
+class next_emission
+{
+public:
+  using value_type = std::conditional_t<
+      sizeof...(Args) == 0, void,
+      std::conditional_t<sizeof...(Args) == 1,
+                         std::decay_t<std::tuple_element_t<0, std::tuple<Args..., void>>>,
+                         std::tuple<std::decay_t<Args>...>>>;
+
+  static_assert((std::is_copy_constructible_v<std::decay_t<Args>> && ...),
+                "co_await on a signal copies its arguments: they must be copyable");
+
+  next_emission(signal<Args...> &sig, event_queue *queue) noexcept :
+    m_signal(&sig),
+    m_queue(queue)
+  {
+  }
+
+  next_emission(next_emission &&) noexcept            = default;
+  next_emission &operator=(next_emission &&) noexcept = default;
+  next_emission(const next_emission &)                = delete;
+  next_emission &operator=(const next_emission &)     = delete;
+
+  ~next_emission()
+  {
+    if (m_state)
+    {
+      // A suspended coroutine being destroyed: no emission may resume it
+      m_state->fired.store(true, std::memory_order_seq_cst);
+    }
+    m_connection.disconnect();
+  }
+
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+  /// @return false to continue at once (emitted during the suspension)
+  bool await_suspend(std::coroutine_handle<> handle)
+  {
+    m_state         = std::make_shared<state>();
+    m_state->handle = handle;
+
+    auto slot = [captured = m_state](Args... args)
+    {
+      if (captured->fired.exchange(true, std::memory_order_acq_rel))
+      {
+        return;
+      }
+      captured->values.emplace(args...);
+      captured->arrive();
+    };
+
+    if (m_queue != nullptr)
+    {
+      m_connection = m_signal->connect(std::move(slot), delivery_policy::queued, *m_queue);
+    }
+    else
+    {
+      m_connection = m_signal->connect(std::move(slot));
+    }
+
+    // Whoever arrives second resumes: the slot may already have run
+    const std::shared_ptr<state> pending = m_state;
+    return pending->arrivals.fetch_add(1, std::memory_order_acq_rel) == 0;
+  }
+
+  value_type await_resume()
+  {
+    m_connection.disconnect();
+    const std::shared_ptr<state> done = std::move(m_state);
+    if constexpr (sizeof...(Args) == 1)
+    {
+      return std::move(std::get<0>(*done->values));
+    }
+    else if constexpr (sizeof...(Args) > 1)
+    {
+      return std::move(*done->values);
+    }
+  }
+
+private:
+  /// @brief Shared by the awaiter and its slot, which may outlive it
+  struct state
+  {
+    std::coroutine_handle<> handle;
+    std::optional<std::tuple<std::decay_t<Args>...>> values;
+    std::atomic<bool> fired{false};   ///< One emission wins
+    std::atomic<int> arrivals{0};     ///< Slot run and suspension done
+
+    void arrive()
+    {
+      if (arrivals.fetch_add(1, std::memory_order_acq_rel) == 1)
+      {
+        handle.resume();
+      }
+    }
+  };
+
+  signal<Args...> *m_signal;
+  event_queue *m_queue;
+  std::shared_ptr<state> m_state;
+  connection m_connection;
+};
+
+} // namespace fb
+
+#endif // FB_SIGNAL_HAS_COROUTINES
@@ -72,41 +72,158 @@ private:
   uint32_t m_count = 0;
 };
 
-/// @brief Epoch counter for deferred reclamation
-/// Used to safely delete slots that may still be referenced by ongoing
-/// emissions
-class epoch_counter
+/// @brief Epoch-based reclamation for read-mostly shared data (RCU style)
+///
+/// Readers announce the global epoch in a per-thread record for the
+/// duration of a critical section; entering and leaving are a few loads
+/// and stores to that thread's own cache line, with no shared counter, no
+/// lock and no retry loop. Writers publish a new version, call advance()
+/// and free the old version once synchronized() reports that every reader
+/// that could still hold it has left.
+///
+/// One domain serves the whole process. A thread's first critical section
+/// registers it; records are pooled and reused when threads exit, so the
+/// registry only grows to the peak number of concurrent reader threads.
+class epoch_domain
 {
 public:
   using epoch_t = uint64_t;
 
-  /// Get current global epoch
-  epoch_t current() const noexcept
+  /// Process-wide domain
+  static epoch_domain &instance() noexcept
   {
-    return m_global_epoch.load(std::memory_order_acquire);
+    static epoch_domain domain;
+    return domain;
   }
 
-  /// Advance global epoch (called after connection changes)
-  epoch_t advance() noexcept
+  /// Start a read-side critical section (nestable, wait-free)
+  ///
+  /// Data published before the call cannot be reclaimed until leave().
+  void enter() noexcept
+  {
+    thread_record &record = local();
+    if (record.depth++ == 0)
+    {
+      // seq_cst pairs with the writer's publish/advance/scan: either the
+      // writer sees this announcement or this reader sees its new version
+      record.epoch.store(m_epoch.load(std::memory_order_seq_cst),
+                         std::memory_order_seq_cst);
+    }
+  }
+
+  /// End the innermost read-side critical section
+  void leave() noexcept
   {
-    return m_global_epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+    thread_record &record = local();
+    if (--record.depth == 0)
+    {
+      record.epoch.store(0, std::memory_order_release);
+    }
   }
 
-  /// Enter critical section (emission start)
-  epoch_t enter() noexcept
+  /// Advance the epoch after publishing a new version
+  /// @return Tag for the replaced version, to pass to synchronized()
+  epoch_t advance() noexcept
   {
-    return m_global_epoch.load(std::memory_order_acquire);
+    return m_epoch.fetch_add(1, std::memory_order_seq_cst);
   }
 
-  /// Leave critical section (emission end)
-  void leave(epoch_t) noexcept
+  /// True once no reader can still see a version retired with @p tag
+  bool synchronized(epoch_t tag) const noexcept
   {
-    // No-op in simplified implementation
-    // Full implementation would track per-thread epochs
+    for (const thread_record *record = m_records.load(std::memory_order_acquire);
+         record != nullptr; record = record->next)
+    {
+      const epoch_t announced = record->epoch.load(std::memory_order_seq_cst);
+      if (announced != 0 && announced <= tag)
+      {
+        return false;
+      }
+    }
+    return true;
   }
 
+  /// @brief RAII read-side critical section
+  class guard
+  {
+  public:
+    guard() noexcept
+    {
+      instance().enter();
+    }
+
+    ~guard()
+    {
+      instance().leave();
+    }
+
+    guard(const guard &) = delete;
+    guard &operator=(const guard &) = delete;
+  };
+
 private:
-  std::atomic<epoch_t> m_global_epoch{0};
+  struct alignas(CACHE_LINE_SIZE) thread_record
+  {
+    std::atomic<epoch_t> epoch{0};     ///< Announced epoch, 0 when quiescent
+    std::atomic<bool> in_use{true};    ///< Owned by a live thread
+    uint32_t depth = 0;                ///< Nesting level (owner thread only)
+    thread_record *next = nullptr;     ///< Immutable once published
+  };
+
+  /// Binds a pooled record to the calling thread for its lifetime
+  struct thread_registration
+  {
+    thread_record *record;
+
+    thread_registration() noexcept
+        : record(instance().acquire_record())
+    {
+    }
+
+    ~thread_registration()
+    {
+      record->epoch.store(0, std::memory_order_release);
+      record->depth = 0;
+      record->in_use.store(false, std::memory_order_release);
+    }
+  };
+
+  epoch_domain() = default;
+
+  thread_record &local() noexcept
+  {
+    static thread_local thread_registration registration;
+    return *registration.record;
+  }
+
+  /// Reuse a record released by an exited thread, or publish a new one
+  thread_record *acquire_record() noexcept
+  {
+    for (thread_record *record = m_records.load(std::memory_order_acquire);
+         record != nullptr; record = record->next)
+    {
+      bool expected = false;
+      if (!record->in_use.load(std::memory_order_relaxed) &&
+          record->in_use.compare_exchange_strong(expected, true,
+                                                 std::memory_order_acquire))
+      {
+        return record;
+      }
+    }
+
+    // Records are never freed: writers may be scanning them at any time
+    auto *record = new thread_record;
+    record->next = m_records.load(std::memory_order_relaxed);
+    while (!m_records.compare_exchange_weak(record->next, record,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed))
+    {
+    }
+    return record;
+  }
+
+  std::atomic<epoch_t> m_epoch{1};                 ///< Global epoch (0 marks a quiescent record)
+  std::atomic<thread_record *> m_records{nullptr}; ///< Registry of reader records
 };
 
 } // namespace detail
@@ -0,0 +1,90 @@
+#pragma once
+
+/// @file detail/futex.hpp
+/// @brief Wait on and wake a 32-bit atomic word (Linux futex)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace fb
+{
+namespace detail
+{
+
+/// Longest sleep of the portable fallback before it rechecks the word
+constexpr std::chrono::microseconds FUTEX_FALLBACK_SLEEP{100};
+
+/// @brief Sleep while @p word holds @p expected, at most @p timeout
+///
+/// May return early (spuriously, on a signal, or on a change of the word);
+/// callers recheck their condition. A negative timeout waits until woken.
+/// Without futex support this sleeps briefly and returns.
+///
+/// With @p process_shared the word may live in memory mapped by several
+/// processes (shm_signal_channel); otherwise only threads of this process
+/// wake it.
+inline void futex_wait(std::atomic<uint32_t> &word, uint32_t expected,
+                       std::chrono::nanoseconds timeout, bool process_shared = false) noexcept
+{
+#ifdef __linux__
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                "futex word must be a plain 32-bit integer");
+  struct timespec relative;
+  struct timespec *relative_ptr = nullptr;
+  if (timeout.count() >= 0)
+  {
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    relative.tv_sec    = seconds.count();
+    relative.tv_nsec   = (timeout - seconds).count();
+    relative_ptr       = &relative;
+  }
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word),
+          process_shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, expected, relative_ptr, nullptr, 0);
+#else
+  (void)process_shared;
+  if (word.load(std::memory_order_acquire) == expected)
+  {
+    const std::chrono::nanoseconds nap = FUTEX_FALLBACK_SLEEP;
+    std::this_thread::sleep_for(timeout.count() >= 0 && timeout < nap ? timeout : nap);
+  }
+#endif
+}
+
+/// @brief Wake one thread sleeping in futex_wait() on @p word
+inline void futex_wake_one(std::atomic<uint32_t> &word) noexcept
+{
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, 1,
+          nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+/// @brief Wake every thread sleeping in futex_wait() on @p word
+///
+/// @p process_shared must match the waiters' futex_wait() calls.
+inline void futex_wake_all(std::atomic<uint32_t> &word, bool process_shared = false) noexcept
+{
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word),
+          process_shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, std::numeric_limits<int>::max(),
+          nullptr, nullptr, 0);
+#else
+  (void)word;
+  (void)process_shared;
+#endif
+}
+
+} // namespace detail
+} // namespace fb
@@ -0,0 +1,126 @@
+#pragma once
+
+/// @file detail/latest_mailbox.hpp
+/// @brief Lock-free "latest value wins" hand-off for coalesced queued delivery
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace fb
+{
+namespace detail
+{
+
+/// @brief Holds the newest argument set of one slot until its consumer runs
+///
+/// Producers (emitting threads) store arguments into one of a few inline
+/// buffers and publish its index; a newer publish frees the older value
+/// unread. At most one delivery event per mailbox is outstanding, so a
+/// burst of emissions costs the consumer one invocation.
+///
+/// Every operation is a bounded number of atomic steps. A producer that
+/// finds every buffer busy drops its value: that only happens while other
+/// emissions are being published concurrently, and those carry a value at
+/// least as recent.
+template <typename... Ts>
+class latest_mailbox
+{
+public:
+  /// Buffers: one being read, one published, the rest for concurrent writers
+  static constexpr std::size_t BUFFERS = 4;
+
+  latest_mailbox() = default;
+
+  latest_mailbox(const latest_mailbox &) = delete;
+  latest_mailbox &operator=(const latest_mailbox &) = delete;
+
+  /// @brief Store the newest arguments
+  /// @return true if the caller must enqueue a delivery event (and call
+  /// cancel() if that fails)
+  template <typename... Us>
+  bool publish(Us &&...values)
+  {
+    for (std::size_t i = 0; i < BUFFERS; ++i)
+    {
+      bool expected = false;
+      if (m_busy[i].load(std::memory_order_relaxed) ||
+          !m_busy[i].compare_exchange_strong(expected, true,
+                                             std::memory_order_acquire))
+      {
+        continue;
+      }
+
+      m_values[i].emplace(std::forward<Us>(values)...);
+      const int previous =
+          m_latest.exchange(static_cast<int>(i), std::memory_order_seq_cst);
+      if (previous >= 0)
+      {
+        // Nobody read it; removing it from m_latest made it ours
+        release(static_cast<std::size_t>(previous));
+        m_coalesced.fetch_add(1, std::memory_order_relaxed);
+      }
+      // A pending event not yet started sees this value; seq_cst orders
+      // the load after the exchange above, against deliver()'s store
+      if (m_pending.load(std::memory_order_seq_cst))
+      {
+        return false;
+      }
+      return !m_pending.exchange(true, std::memory_order_seq_cst);
+    }
+    m_coalesced.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /// @brief Undo publish()'s request after the delivery event was dropped
+  ///
+  /// The value stays; the next publish() asks for a new event.
+  void cancel() noexcept
+  {
+    m_pending.store(false, std::memory_order_seq_cst);
+  }
+
+  /// @brief Consumer side: pass the newest arguments to @p func
+  /// @return true if there was a value
+  template <typename F>
+  bool deliver(F &&func)
+  {
+    // Cleared first: a publish after this point requests another event
+    m_pending.store(false, std::memory_order_seq_cst);
+    const int index = m_latest.exchange(-1, std::memory_order_seq_cst);
+    if (index < 0)
+    {
+      return false;
+    }
+    const auto slot = static_cast<std::size_t>(index);
+    std::apply(std::forward<F>(func), std::move(*m_values[slot]));
+    release(slot);
+    return true;
+  }
+
+  /// @brief Number of values replaced before their consumer ran
+  uint64_t coalesced_count() const noexcept
+  {
+    return m_coalesced.load(std::memory_order_relaxed);
+  }
+
+private:
+  void release(std::size_t index) noexcept
+  {
+    m_values[index].reset();
+    m_busy[index].store(false, std::memory_order_release);
+  }
+
+  std::array<std::optional<std::tuple<Ts...>>, BUFFERS> m_values{};
+  std::array<std::atomic<bool>, BUFFERS> m_busy{}; ///< Buffer owned by a writer, m_latest or the reader
+  std::atomic<int> m_latest{-1};                   ///< Newest published buffer, -1 if none
+  std::atomic<bool> m_pending{false};              ///< A delivery event is queued
+  std::atomic<uint64_t> m_coalesced{0};
+};
+
+} // namespace detail
+} // namespace fb
@@ -0,0 +1,180 @@
+#pragma once
+
+/// @file detail/payload_pool.hpp
+/// @brief Recycled fixed-size blocks for shared queued-delivery payloads
+///
+/// Payloads are allocated on emitting threads and freed on consumer
+/// threads, so a plain thread-local free list would only ever grow on the
+/// consumer. Freed blocks go to a shared lock-free stack instead; an
+/// allocating thread takes the whole stack into its own cache at once.
+/// Push and take-all are immune to ABA, so no tagged pointers are needed.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace fb
+{
+namespace detail
+{
+
+/// @brief Pool of blocks of one size and alignment
+template <std::size_t Size, std::size_t Align>
+class block_pool
+{
+  struct free_block
+  {
+    free_block *next;
+  };
+
+public:
+  static constexpr std::size_t BLOCK_SIZE  = std::max(Size, sizeof(free_block));
+  static constexpr std::size_t BLOCK_ALIGN = std::max(Align, alignof(free_block));
+
+  /// Pooled blocks beyond this are returned to the allocator
+  static constexpr std::size_t MAX_POOLED = 4096;
+
+  static block_pool &instance() noexcept
+  {
+    static block_pool pool;
+    return pool;
+  }
+
+  ~block_pool()
+  {
+    release_all(m_returned.exchange(nullptr, std::memory_order_acquire));
+  }
+
+  void *allocate()
+  {
+    thread_cache &cache = local_cache();
+    if (cache.head == nullptr)
+    {
+      cache.head = m_returned.exchange(nullptr, std::memory_order_acquire);
+    }
+    if (cache.head == nullptr)
+    {
+      return ::operator new(BLOCK_SIZE, std::align_val_t{BLOCK_ALIGN});
+    }
+    free_block *block = cache.head;
+    cache.head        = block->next;
+    m_pooled.fetch_sub(1, std::memory_order_relaxed);
+    return block;
+  }
+
+  void deallocate(void *memory) noexcept
+  {
+    if (m_pooled.load(std::memory_order_relaxed) >= MAX_POOLED)
+    {
+      ::operator delete(memory, std::align_val_t{BLOCK_ALIGN});
+      return;
+    }
+    m_pooled.fetch_add(1, std::memory_order_relaxed);
+    push(::new (memory) free_block{nullptr});
+  }
+
+  /// @brief Blocks waiting for reuse, shared or in thread caches (approximate)
+  std::size_t pooled() const noexcept
+  {
+    return m_pooled.load(std::memory_order_relaxed);
+  }
+
+private:
+  /// @brief Blocks taken by one thread; handed back when it exits
+  struct thread_cache
+  {
+    free_block *head = nullptr;
+
+    ~thread_cache()
+    {
+      while (head != nullptr)
+      {
+        free_block *block = head;
+        head              = block->next;
+        instance().push(block);
+      }
+    }
+  };
+
+  block_pool() = default;
+
+  static thread_cache &local_cache() noexcept
+  {
+    static thread_local thread_cache cache;
+    return cache;
+  }
+
+  void push(free_block *block) noexcept
+  {
+    block->next = m_returned.load(std::memory_order_relaxed);
+    while (!m_returned.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                             std::memory_order_relaxed))
+    {
+    }
+  }
+
+  static void release_all(free_block *head) noexcept
+  {
+    while (head != nullptr)
+    {
+      free_block *next = head->next;
+      ::operator delete(head, std::align_val_t{BLOCK_ALIGN});
+      head = next;
+    }
+  }
+
+  std::atomic<free_block *> m_returned{nullptr}; ///< Freed blocks, any thread
+  std::atomic<std::size_t> m_pooled{0};
+};
+
+/// @brief Allocator drawing single objects from block_pool
+///
+/// For std::allocate_shared: the control block and the payload come from
+/// the pool in one block.
+template <typename T>
+struct pool_allocator
+{
+  using value_type = T;
+
+  pool_allocator() noexcept = default;
+
+  template <typename U>
+  pool_allocator(const pool_allocator<U> &) noexcept
+  {
+  }
+
+  T *allocate(std::size_t count)
+  {
+    if (count == 1)
+    {
+      return static_cast<T *>(block_pool<sizeof(T), alignof(T)>::instance().allocate());
+    }
+    return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+  }
+
+  void deallocate(T *memory, std::size_t count) noexcept
+  {
+    if (count == 1)
+    {
+      block_pool<sizeof(T), alignof(T)>::instance().deallocate(memory);
+      return;
+    }
+    ::operator delete(memory, std::align_val_t{alignof(T)});
+  }
+
+  template <typename U>
+  bool operator==(const pool_allocator<U> &) const noexcept
+  {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const pool_allocator<U> &) const noexcept
+  {
+    return false;
+  }
+};
+
+} // namespace detail
+} // namespace fb
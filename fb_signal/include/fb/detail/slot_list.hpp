@@ -5,17 +5,25 @@
 ///
 /// Uses copy-on-write for thread safety with O(1) disconnect.
 /// Key properties:
-/// - Connect: Filters inactive slots (automatic cleanup)
+/// - Emit: Wait-free snapshot; an epoch announcement in a per-thread
+///   record, no shared reference count and no hidden lock
+/// - Layout: Each version keeps a contiguous slot_dispatch array for
+///   emission next to the shared_ptrs that own the slots
+/// - Connect: O(n) single pass over the sorted list that filters inactive
+///   slots (automatic cleanup) and inserts the new slot in place
 /// - Disconnect: O(1) atomic flag flip
 /// - Memory: Auto-cleanup when inactive ratio exceeds threshold
+/// - Size: O(1) via an active-slot counter maintained on connect/disconnect
 
 #include <algorithm>
 #include <atomic>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <vector>
 
 #include "../slot.hpp"
+#include "atomic_utils.hpp"
 
 namespace fb {
 namespace detail {
@@ -26,13 +34,64 @@ public:
   using slot_type = slot_entry<Args...>;
   using slot_ptr = std::shared_ptr<slot_type>;
   using container_type = std::vector<slot_ptr>;
-  using snapshot_type = std::shared_ptr<const container_type>;
+  using dispatch_type = slot_dispatch<Args...>;
+
+  /// @brief One immutable version of the list
+  struct version {
+    container_type slots;                ///< Owners, in emission order
+    std::vector<dispatch_type> dispatch; ///< slots[i]'s hot fields at [i]
+  };
+
+  /// @brief Read-side view of the slot list
+  ///
+  /// Holds an epoch_domain critical section, so the version it points to
+  /// is not freed until the snapshot goes out of scope. Taking one is
+  /// wait-free and touches only the calling thread's epoch record.
+  class snapshot_type {
+  public:
+    explicit snapshot_type(const slot_list &list) noexcept
+        : m_version(list.m_slots.load(std::memory_order_seq_cst)) {}
+
+    snapshot_type(const snapshot_type &) = delete;
+    snapshot_type &operator=(const snapshot_type &) = delete;
+
+    const container_type &operator*() const noexcept {
+      return m_version->slots;
+    }
+    const container_type *operator->() const noexcept {
+      return &m_version->slots;
+    }
+
+    /// @brief Contiguous emission array, parallel to the slots
+    const std::vector<dispatch_type> &dispatch() const noexcept {
+      return m_version->dispatch;
+    }
+
+  private:
+    epoch_domain::guard m_section; ///< Entered before the pointer is loaded
+    const version *m_version;
+  };
 
   /// Maximum ratio of inactive to total slots before cleanup triggers
   static constexpr double CLEANUP_THRESHOLD = 0.5; // 50% dead triggers cleanup
 
-  slot_list()
-      : m_slots(std::make_shared<container_type>()), m_inactive_count(0) {}
+  /// @param resource Memory for the slot entries; nullptr for the heap.
+  ///                 Must outlive every slot and connection of the list.
+  explicit slot_list(std::pmr::memory_resource *resource = nullptr)
+      : m_slots(new version()),
+        m_active(std::make_shared<std::atomic<std::size_t>>(0)),
+        m_inactive_count(0), m_resource(resource) {}
+
+  slot_list(const slot_list &) = delete;
+  slot_list &operator=(const slot_list &) = delete;
+
+  /// @brief Frees every version; no emission may be in progress
+  ~slot_list() {
+    delete m_slots.load(std::memory_order_relaxed);
+    for (const auto &entry : m_retired) {
+      delete entry.slots;
+    }
+  }
 
   /// @brief Add a new slot
   template <typename F>
@@ -40,38 +99,21 @@ public:
                delivery_policy policy = delivery_policy::direct,
                event_queue *queue = nullptr) {
     auto slot =
-        std::make_shared<slot_type>(std::forward<F>(func), prio, policy, queue);
+        m_resource != nullptr
+            ? std::allocate_shared<slot_type>(
+                  std::pmr::polymorphic_allocator<slot_type>(m_resource),
+                  std::forward<F>(func), prio, policy, queue)
+            : std::make_shared<slot_type>(std::forward<F>(func), prio, policy,
+                                          queue);
+    slot->track_active(m_active);
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    auto current = get_snapshot_internal();
-
-    // Create new container filtering inactive slots (cleanup during add)
-    auto new_slots = std::make_shared<container_type>();
-    new_slots->reserve(current->size() + 1);
-
-    for (const auto &existing : *current) {
-      if (existing && existing->is_active()) {
-        new_slots->push_back(existing);
-      }
-    }
-
-    new_slots->push_back(slot);
-
-    // Sort by priority (higher first), then by ID (earlier first)
-    std::stable_sort(new_slots->begin(), new_slots->end(),
-                     [](const slot_ptr &a, const slot_ptr &b) {
-                       const int32_t pa =
-                           static_cast<int32_t>(a->get_priority());
-                       const int32_t pb =
-                           static_cast<int32_t>(b->get_priority());
-                       if (pa != pb) {
-                         return pa > pb;
-                       }
-                       return a->id() < b->id();
-                     });
-
-    std::atomic_store_explicit(&m_slots, new_slots, std::memory_order_release);
+    // One pass over the sorted current version: drops inactive slots
+    // (cleanup during add) and inserts the new one in place, no re-sort
+    auto next = compact(*current_internal(), &slot);
+    m_active->fetch_add(1, std::memory_order_release);
+    publish(std::move(next));
     m_inactive_count.store(0, std::memory_order_relaxed); // Reset after cleanup
     return slot;
   }
@@ -79,71 +121,62 @@ public:
   /// @brief Deactivate a slot by ID - O(1)
   /// Triggers cleanup if inactive ratio exceeds threshold
   bool remove(typename slot_type::id_type id) {
-    auto snapshot = get_snapshot();
-    for (const auto &slot : *snapshot) {
-      if (slot && slot->id() == id) {
-        slot->deactivate(); // O(1) atomic operation
-
-        // Track inactive count for threshold-based cleanup
-        const auto inactive =
-            m_inactive_count.fetch_add(1, std::memory_order_relaxed) + 1;
-        const auto total = snapshot->size();
-
-        // Auto-cleanup if inactive ratio exceeds threshold
-        if (total > 0 &&
-            static_cast<double>(inactive) / total > CLEANUP_THRESHOLD) {
-          cleanup_internal();
+    bool found = false;
+    bool over_threshold = false;
+    {
+      const snapshot_type snapshot = get_snapshot();
+      for (const auto &slot : *snapshot) {
+        if (slot && slot->id() == id) {
+          slot->deactivate(); // O(1) atomic operation
+
+          // Track inactive count for threshold-based cleanup
+          const auto inactive =
+              m_inactive_count.fetch_add(1, std::memory_order_relaxed) + 1;
+          const auto total = snapshot->size();
+          over_threshold =
+              total > 0 &&
+              static_cast<double>(inactive) / total > CLEANUP_THRESHOLD;
+          found = true;
+          break;
         }
-        return true;
       }
     }
-    return false;
+
+    // Auto-cleanup if inactive ratio exceeds threshold, outside the read
+    // section so the replaced container can be freed right away
+    if (over_threshold) {
+      cleanup_internal();
+    }
+    return found;
   }
 
   /// @brief Remove all slots
   void clear() {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    auto current = get_snapshot_internal();
-    for (const auto &slot : *current) {
+    const container_type &current = current_internal()->slots;
+    for (const auto &slot : current) {
       if (slot) {
         slot->deactivate();
       }
     }
 
-    std::atomic_store_explicit(&m_slots, std::make_shared<container_type>(),
-                               std::memory_order_release);
+    publish(std::make_unique<version>());
     m_inactive_count.store(0, std::memory_order_relaxed);
   }
 
-  /// @brief Get atomic snapshot (lock-free)
-  snapshot_type get_snapshot() const noexcept {
-    return std::atomic_load_explicit(&m_slots, std::memory_order_acquire);
-  }
+  /// @brief Get a snapshot of the current slots (wait-free)
+  snapshot_type get_snapshot() const noexcept { return snapshot_type(*this); }
 
+  /// @brief Number of active slots - O(1), no snapshot taken
   std::size_t size() const noexcept {
-    auto snapshot = get_snapshot();
-    std::size_t count = 0;
-    for (const auto &slot : *snapshot) {
-      if (slot && slot->is_active()) {
-        ++count;
-      }
-    }
-    return count;
+    return m_active->load(std::memory_order_acquire);
   }
 
-  bool empty() const noexcept {
-    auto snapshot = get_snapshot();
-    for (const auto &slot : *snapshot) {
-      if (slot && slot->is_active()) {
-        return false;
-      }
-    }
-    return true;
-  }
+  bool empty() const noexcept { return size() == 0; }
 
   slot_ptr find(typename slot_type::id_type id) const {
-    auto snapshot = get_snapshot();
+    const snapshot_type snapshot = get_snapshot();
     for (const auto &slot : *snapshot) {
       if (slot && slot->id() == id && slot->is_active()) {
         return slot;
@@ -159,42 +192,108 @@ private:
   void cleanup_internal() {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    auto current = get_snapshot_internal();
-
-    // Count active slots
-    std::size_t active_count = 0;
-    for (const auto &slot : *current) {
-      if (slot && slot->is_active()) {
-        ++active_count;
-      }
-    }
+    const version &current = *current_internal();
 
     // Skip if all active
-    if (active_count == current->size()) {
+    const bool all_active =
+        std::all_of(current.slots.begin(), current.slots.end(),
+                    [](const slot_ptr &slot) { return slot->is_active(); });
+    if (all_active) {
       m_inactive_count.store(0, std::memory_order_relaxed);
+      reclaim();
       return;
     }
 
-    auto new_slots = std::make_shared<container_type>();
-    new_slots->reserve(active_count);
+    publish(compact(current, nullptr));
+    m_inactive_count.store(0, std::memory_order_relaxed);
+  }
 
-    for (const auto &slot : *current) {
-      if (slot && slot->is_active()) {
-        new_slots->push_back(slot);
+  /// @brief True if @p a is emitted before @p b: higher priority first,
+  /// then earlier connection
+  static bool emitted_before(const slot_type &a, const slot_type &b) noexcept {
+    const int32_t pa = static_cast<int32_t>(a.get_priority());
+    const int32_t pb = static_cast<int32_t>(b.get_priority());
+    if (pa != pb) {
+      return pa > pb;
+    }
+    return a.id() < b.id();
+  }
+
+  /// @brief Copy of @p current without its inactive slots, plus @p inserted
+  /// (if not null) at its place in emission order
+  ///
+  /// O(n) in one pass: @p current is already in emission order and its
+  /// dispatch entries are reused rather than rebuilt from the slots.
+  static std::unique_ptr<version> compact(const version &current,
+                                          const slot_ptr *inserted) {
+    auto next = std::make_unique<version>();
+    const std::size_t capacity = current.slots.size() + (inserted ? 1 : 0);
+    next->slots.reserve(capacity);
+    next->dispatch.reserve(capacity);
+
+    bool placed = inserted == nullptr;
+    for (std::size_t i = 0; i < current.slots.size(); ++i) {
+      const slot_ptr &existing = current.slots[i];
+      if (!placed && emitted_before(**inserted, *existing)) {
+        next->slots.push_back(*inserted);
+        next->dispatch.push_back((*inserted)->dispatch());
+        placed = true;
+      }
+      if (existing->is_active()) {
+        next->slots.push_back(existing);
+        next->dispatch.push_back(current.dispatch[i]);
       }
     }
+    if (!placed) {
+      next->slots.push_back(*inserted);
+      next->dispatch.push_back((*inserted)->dispatch());
+    }
+    return next;
+  }
 
-    std::atomic_store_explicit(&m_slots, new_slots, std::memory_order_release);
-    m_inactive_count.store(0, std::memory_order_relaxed);
+  /// @brief Current version; only valid with m_mutex held
+  const version *current_internal() const {
+    return m_slots.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Swap in a new version and retire the old one (m_mutex held)
+  ///
+  /// The old version is freed once no emission that might have loaded it
+  /// is still running. Without concurrent emissions that is immediately;
+  /// otherwise it waits for a later publish or the destructor.
+  void publish(std::unique_ptr<version> next) {
+    const version *old =
+        m_slots.exchange(next.release(), std::memory_order_seq_cst);
+    m_retired.push_back({old, epoch_domain::instance().advance()});
+    reclaim();
   }
 
-  snapshot_type get_snapshot_internal() const {
-    return std::atomic_load_explicit(&m_slots, std::memory_order_acquire);
+  /// @brief Free retired versions no emission can still see (m_mutex held)
+  void reclaim() {
+    const auto &domain = epoch_domain::instance();
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                   [&domain](const retired_slots &entry) {
+                                     if (!domain.synchronized(entry.epoch)) {
+                                       return false;
+                                     }
+                                     delete entry.slots;
+                                     return true;
+                                   }),
+                    m_retired.end());
   }
 
-  std::shared_ptr<container_type> m_slots;
+  /// @brief Replaced version awaiting reclamation
+  struct retired_slots {
+    const version *slots;
+    epoch_domain::epoch_t epoch; ///< Epoch it was replaced in
+  };
+
+  std::atomic<const version *> m_slots; ///< Current version, owned
+  std::shared_ptr<std::atomic<std::size_t>> m_active; ///< Active slots, shared with each slot
   mutable std::mutex m_mutex;
   std::atomic<std::size_t> m_inactive_count;
+  std::vector<retired_slots> m_retired; ///< Guarded by m_mutex
+  std::pmr::memory_resource *m_resource; ///< Slot entries, nullptr = heap
 };
 
 } // namespace detail
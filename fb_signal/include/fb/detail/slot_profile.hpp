@@ -0,0 +1,190 @@
+#pragma once
+
+/// @file detail/slot_profile.hpp
+/// @brief Opt-in per-slot invocation timing (FB_SIGNAL_PROFILING)
+///
+/// Compiled out unless FB_SIGNAL_PROFILING is defined to 1 for every
+/// translation unit (CMake option FB_SIGNAL_PROFILING). Disabled, the
+/// timer below is an empty object and emission is unchanged.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef FB_SIGNAL_PROFILING
+#define FB_SIGNAL_PROFILING 0
+#endif
+
+namespace fb
+{
+
+/// @brief Timing of one slot, see signal::slot_timings()
+struct slot_timing
+{
+  uint64_t connection_id = 0;
+  uint64_t calls         = 0;       ///< Invocations, direct and queued
+  std::chrono::nanoseconds total{}; ///< Cumulative time in the slot
+  std::chrono::nanoseconds max{};
+  std::chrono::nanoseconds p99{};   ///< Upper bound, within 1/SUB_BUCKETS of an octave
+};
+
+namespace detail
+{
+
+/// @brief Invocation count and duration histogram of one slot
+///
+/// Durations go into log-linear buckets: SUB_BUCKETS per power of two of
+/// nanoseconds, so a percentile is exact to about 19%. Every update is a
+/// relaxed atomic add; emitting threads never wait for each other.
+class slot_profile
+{
+public:
+  static constexpr std::size_t SUB_BUCKETS = 4;
+  static constexpr std::size_t OCTAVES     = 48; ///< Up to 2^48 ns (three days)
+  static constexpr std::size_t BUCKETS     = OCTAVES * SUB_BUCKETS;
+
+  void record(std::chrono::nanoseconds duration) noexcept
+  {
+    const uint64_t ns = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+    m_calls.fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(ns, std::memory_order_relaxed);
+    m_buckets[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (ns > max && !m_max.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  /// @brief Copy the counters into @p timing
+  void read(slot_timing &timing) const noexcept
+  {
+    timing.calls = m_calls.load(std::memory_order_relaxed);
+    timing.total = std::chrono::nanoseconds(m_total.load(std::memory_order_relaxed));
+    timing.max   = std::chrono::nanoseconds(m_max.load(std::memory_order_relaxed));
+    timing.p99   = std::chrono::nanoseconds(percentile(99, 100));
+  }
+
+  void reset() noexcept
+  {
+    m_calls.store(0, std::memory_order_relaxed);
+    m_total.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+    for (auto &bucket : m_buckets)
+    {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  /// @brief Bucket of @p ns: octave of its highest bit, then the next two bits
+  static std::size_t bucket_of(uint64_t ns) noexcept
+  {
+    if (ns < SUB_BUCKETS)
+    {
+      const std::size_t bucket = ns;
+      return bucket;
+    }
+    unsigned octave = 63;
+    while ((ns >> octave) == 0)
+    {
+      --octave;
+    }
+    // ns >= 4, so octave >= 2 and the shift keeps the two bits below the top
+    const uint64_t sub       = (ns >> (octave - 2)) & (SUB_BUCKETS - 1);
+    const std::size_t bucket = (octave - 1) * SUB_BUCKETS + sub;
+    return bucket < BUCKETS ? bucket : BUCKETS - 1;
+  }
+
+  /// @brief Largest duration bucket @p bucket holds
+  static uint64_t upper_bound_of(std::size_t bucket) noexcept
+  {
+    if (bucket < SUB_BUCKETS)
+    {
+      return bucket;
+    }
+    const std::size_t octave = bucket / SUB_BUCKETS + 1;
+    const uint64_t sub       = bucket % SUB_BUCKETS;
+    return ((SUB_BUCKETS + sub + 1) << (octave - 2)) - 1;
+  }
+
+  /// @brief Smallest bucket bound covering @p numerator / @p denominator of the calls
+  uint64_t percentile(uint64_t numerator, uint64_t denominator) const noexcept
+  {
+    std::array<uint64_t, BUCKETS> counts{};
+    uint64_t calls = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+      counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+      calls += counts[i];
+    }
+    if (calls == 0)
+    {
+      return 0;
+    }
+
+    const uint64_t rank = (calls * numerator + denominator - 1) / denominator;
+    uint64_t seen       = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+      seen += counts[i];
+      if (seen >= rank)
+      {
+        const uint64_t max = m_max.load(std::memory_order_relaxed);
+        const uint64_t bound = upper_bound_of(i);
+        return bound < max ? bound : max;
+      }
+    }
+    return m_max.load(std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> m_calls{0};
+  std::atomic<uint64_t> m_total{0};
+  std::atomic<uint64_t> m_max{0};
+  std::array<std::atomic<uint64_t>, BUCKETS> m_buckets{};
+};
+
+#if FB_SIGNAL_PROFILING
+
+/// @brief Times one slot invocation into its profile
+class slot_timer
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit slot_timer(slot_profile *profile) noexcept :
+    m_profile(profile),
+    m_start(clock::now())
+  {
+  }
+
+  ~slot_timer()
+  {
+    m_profile->record(clock::now() - m_start);
+  }
+
+  slot_timer(const slot_timer &)            = delete;
+  slot_timer &operator=(const slot_timer &) = delete;
+
+private:
+  slot_profile *m_profile;
+  clock::time_point m_start;
+};
+
+#else
+
+/// @brief Profiling disabled: nothing is timed
+class slot_timer
+{
+public:
+  explicit slot_timer(slot_profile *) noexcept
+  {
+  }
+};
+
+#endif
+
+} // namespace detail
+} // namespace fb
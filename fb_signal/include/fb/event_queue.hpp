@@ -7,10 +7,13 @@
 /// Multiple producer threads can enqueue events; a single consumer thread
 /// processes them in FIFO order.
 ///
-/// Uses small-buffer optimization to avoid heap allocation on the hot path.
+/// Events are stored inline in a byte ring, sized to each callable, so the
+/// hot path never allocates.
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -18,161 +21,349 @@
 #include <thread>
 #include <type_traits>
 
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "detail/atomic_utils.hpp"
+#include "detail/futex.hpp"
 
 namespace fb
 {
 
-/// @brief Queue overflow policy
+/// @brief What enqueue() does when the ring (or the producer's lane) is full
 enum class overflow_policy
 {
-  drop_newest ///< Discard new events when queue is full (default, lock-free
-              ///< safe)
+  drop_newest,     ///< Discard the new event (default, lock-free safe)
+  block,           ///< Wait for the consumer to free space, up to a timeout
+  spill,           ///< Keep the event in an unbounded heap-allocated list
+  overwrite_oldest ///< Discard the oldest queued event to make room
 };
 
-namespace detail
+/// @brief How producers share an event_queue
+enum class queue_mode
 {
+  shared_ring,   ///< One multi-producer ring, strict FIFO (default)
+  producer_lanes ///< One single-producer ring per thread, FIFO per producer
+};
 
-/// @brief Size of inline storage for events (fits most lambdas with captures)
-constexpr std::size_t EVENT_SBO_SIZE = 128;
+namespace detail
+{
 
-/// @brief Fixed-size type-erased event with small-buffer optimization
+/// @brief Lock-free MPSC ring of variable-length callable records
+///
+/// Records are stored back to back in one byte array, each a 16-byte
+/// header followed by the callable rounded up to alignof(max_align_t):
+/// a lambda capturing a shared_ptr and an int takes 48 bytes where a
+/// fixed-size slot would take the largest supported callable.
+///
+/// Producers claim space with a CAS on the tail; a record that would
+/// straddle the end of the array is preceded by a padding record filling
+/// the rest of the array, so every record is contiguous. The consumer
+/// invokes records in place, zeroes their bytes to keep stale data from
+/// looking like a committed header, then releases the space.
 ///
-/// Stores the callable inline if it fits, avoiding heap allocation.
-/// This is critical for maintaining zero-allocation on the hot path.
-class alignas(std::max_align_t) event
+/// Head and tail pack a record count (high 32 bits) with a byte offset
+/// (low 32 bits), so size_approx() needs no additional counter.
+///
+/// The capacity is chosen at construction and rounded up to a power of
+/// two. The array is page aligned, and rings of HUGE_PAGE_SIZE or more are
+/// aligned to it and offered to transparent huge pages (Linux), so a large
+/// ring takes a few TLB entries instead of hundreds.
+///
+/// With @p SingleProducer the tail is advanced with a plain store instead
+/// of a CAS; only one thread at a time may then call try_push().
+template <bool SingleProducer = false>
+class byte_ring
 {
 public:
-  using invoke_fn  = void (*)(void *);
-  using destroy_fn = void (*)(void *);
-  using move_fn    = void (*)(void *, void *);
+  /// Alignment of every record and of the callable in it
+  static constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
 
-  event() noexcept = default;
+  /// Smallest capacity; smaller requests are rounded up to it
+  static constexpr std::size_t MIN_CAPACITY = 64 * 1024;
 
-  ~event()
-  {
-    destroy();
-  }
+  /// Largest capacity: offsets are 32-bit
+  static constexpr std::size_t MAX_CAPACITY = std::size_t{1} << 31;
+
+  /// Largest callable a record may hold: with the padding a wrap may need,
+  /// a record of up to half the capacity always fits an empty ring
+  static constexpr std::size_t MAX_PAYLOAD_SIZE = MIN_CAPACITY / 2 - ALIGNMENT;
+
+  static constexpr std::size_t PAGE_SIZE      = 4096;
+  static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
 
-  event(event &&other) noexcept :
-    m_invoke(other.m_invoke),
-    m_destroy(other.m_destroy),
-    m_move(other.m_move)
+  /// @brief Capacity a ring constructed with @p capacity gets: the next
+  /// power of two within [MIN_CAPACITY, MAX_CAPACITY]
+  static constexpr std::size_t round_capacity(std::size_t capacity) noexcept
   {
-    if (other.m_invoke)
+    std::size_t rounded = MIN_CAPACITY;
+    while (rounded < capacity && rounded < MAX_CAPACITY)
     {
-      m_move(m_storage, other.m_storage);
-      other.clear();
+      rounded <<= 1;
     }
+    return rounded;
   }
 
-  event &operator=(event &&other) noexcept
+  /// @param capacity Bytes of record storage, see round_capacity()
+  explicit byte_ring(std::size_t capacity) :
+    m_capacity(static_cast<uint32_t>(round_capacity(capacity))),
+    m_mask(m_capacity - 1),
+    m_storage(allocate(m_capacity))
   {
-    if (this != &other)
+  }
+
+  ~byte_ring()
+  {
+    // Destroy what was never processed (no producer may still be running)
+    while (pop(false))
     {
-      destroy();
-      m_invoke  = other.m_invoke;
-      m_destroy = other.m_destroy;
-      m_move    = other.m_move;
-      if (other.m_invoke)
-      {
-        m_move(m_storage, other.m_storage);
-        other.clear();
-      }
     }
-    return *this;
+    ::operator delete(m_storage, std::align_val_t(alignment_for(m_capacity)));
   }
 
-  // Non-copyable
-  event(const event &)            = delete;
-  event &operator=(const event &) = delete;
+  byte_ring(const byte_ring &)            = delete;
+  byte_ring &operator=(const byte_ring &) = delete;
 
-  /// @brief Store a callable in the event
-  ///
-  /// Uses small-buffer optimization: if the callable fits in EVENT_SBO_SIZE
-  /// bytes and is nothrow move constructible, it's stored inline.
-  /// Otherwise, compilation fails (we don't fall back to heap allocation
-  /// to maintain the zero-allocation guarantee).
+  /// @brief Construct a callable in the ring (lock-free, multi-producer safe)
+  /// @return true if stored, false if the ring was full
   template <typename F>
-  void store(F &&func)
+  bool try_push(F &&func)
   {
     using DecayedF = std::decay_t<F>;
 
-    static_assert(sizeof(DecayedF) <= EVENT_SBO_SIZE,
-                  "Callable too large for event SBO. Reduce capture size or "
-                  "use smaller types. Maximum size is EVENT_SBO_SIZE bytes.");
+    static_assert(sizeof(DecayedF) <= MAX_PAYLOAD_SIZE,
+                  "Callable too large for the event queue. Reduce capture "
+                  "size; the maximum is event_queue::MAX_CALLABLE_SIZE bytes.");
 
-    static_assert(alignof(DecayedF) <= alignof(std::max_align_t),
+    static_assert(alignof(DecayedF) <= ALIGNMENT,
                   "Callable alignment exceeds max_align_t");
 
-    static_assert(std::is_nothrow_move_constructible_v<DecayedF>,
-                  "Callable must be nothrow move constructible for lock-free operation");
+    constexpr uint32_t length =
+        static_cast<uint32_t>(sizeof(header) + round_up(sizeof(DecayedF)));
 
-    destroy();
+    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    uint32_t position = 0;
+    uint32_t padding  = 0;
 
-    new (m_storage) DecayedF(std::forward<F>(func));
+    for (;;)
+    {
+      const uint64_t head   = m_head.load(std::memory_order_acquire);
+      const uint32_t offset = offset_of(tail);
+
+      position = offset & m_mask;
+      padding  = (m_capacity - position < length) ? m_capacity - position : 0;
 
-    m_invoke = [](void *storage)
+      const uint32_t used = offset - offset_of(head);
+      if (used + padding + length > m_capacity)
+      {
+        return false;
+      }
+
+      const uint64_t next_tail = pack(count_of(tail) + 1, offset + padding + length);
+      // seq_cst: a waiting consumer announces itself, then rechecks the
+      // tail; the producer advances the tail, then checks for a waiter
+      if constexpr (SingleProducer)
+      {
+        m_tail.store(next_tail, std::memory_order_seq_cst);
+        break;
+      }
+      else if (m_tail.compare_exchange_weak(tail, next_tail,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_relaxed))
+      {
+        break;
+      }
+      // CAS failed, tail was updated, retry with new value
+    }
+
+    if (padding != 0)
     {
-      auto *callable = reinterpret_cast<DecayedF *>(storage);
-      (*callable)();
-    };
+      header *filler  = header_at(position);
+      filler->handler = nullptr;
+      filler->length.store(padding, std::memory_order_release);
+      position = 0;
+    }
 
-    m_destroy = [](void *storage)
+    header *record = header_at(position);
+    new (payload_of(record)) DecayedF(std::forward<F>(func));
+    record->handler = [](void *storage, bool run)
     {
       auto *callable = reinterpret_cast<DecayedF *>(storage);
+      if (run)
+      {
+        (*callable)();
+      }
       callable->~DecayedF();
     };
+    record->length.store(length, std::memory_order_release);
+    return true;
+  }
 
-    m_move = [](void *dst, void *src)
-    {
-      auto *src_ptr = reinterpret_cast<DecayedF *>(src);
-      new (dst) DecayedF(std::move(*src_ptr));
-      src_ptr->~DecayedF();
-    };
+  /// @brief Invoke and destroy the oldest record (single consumer only)
+  /// @return true if a record was processed, false if the ring was empty
+  bool try_invoke()
+  {
+    return pop(true);
   }
 
-  /// @brief Invoke the stored callable
-  void invoke()
+  /// @brief Destroy the oldest record without invoking it
+  ///
+  /// Takes the consumer's role: callers exclude try_invoke() themselves.
+  /// @return true if a record was discarded, false if the ring was empty
+  bool discard_oldest()
   {
-    if (m_invoke)
-    {
-      m_invoke(m_storage);
-    }
+    return pop(false);
+  }
+
+  /// @brief Get approximate number of stored records
+  std::size_t size_approx() const noexcept
+  {
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    const uint32_t count = count_of(tail) - count_of(head);
+    return count;
   }
 
-  /// @brief Check if event contains a callable
-  bool valid() const noexcept
+  /// @brief Check if ring is approximately empty
+  bool empty_approx() const noexcept
   {
-    return m_invoke != nullptr;
+    return size_approx() == 0;
   }
 
-  explicit operator bool() const noexcept
+  /// @brief Bytes of record storage
+  std::size_t capacity() const noexcept
   {
-    return valid();
+    return m_capacity;
+  }
+
+  /// @brief True if a record has been claimed but not yet consumed
+  ///
+  /// Sequentially consistent with try_push(), for the consumer's check
+  /// after announcing that it is about to sleep.
+  bool has_pending() const noexcept
+  {
+    return offset_of(m_head.load(std::memory_order_relaxed)) !=
+           offset_of(m_tail.load(std::memory_order_seq_cst));
   }
 
 private:
-  void destroy()
+  using handler_fn = void (*)(void *, bool);
+
+  /// @brief Record header; length is 0 until the producer commits it
+  struct alignas(std::max_align_t) header
+  {
+    std::atomic<uint32_t> length;
+    handler_fn handler;
+  };
+
+  static_assert(sizeof(header) == ALIGNMENT,
+                "Record header must occupy one alignment unit");
+
+  static constexpr std::size_t alignment_for(std::size_t capacity) noexcept
   {
-    if (m_destroy)
+    return capacity >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : PAGE_SIZE;
+  }
+
+  /// @brief Zeroed storage: a zero length marks an uncommitted record
+  static unsigned char *allocate(std::size_t capacity)
+  {
+    void *storage = ::operator new(capacity, std::align_val_t(alignment_for(capacity)));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (capacity >= HUGE_PAGE_SIZE)
     {
-      m_destroy(m_storage);
-      clear();
+      // Before the first touch, so the memset below faults in huge pages
+      ::madvise(storage, capacity, MADV_HUGEPAGE);
     }
+#endif
+    std::memset(storage, 0, capacity);
+    return static_cast<unsigned char *>(storage);
+  }
+
+  static constexpr std::size_t round_up(std::size_t size) noexcept
+  {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  static constexpr uint64_t pack(uint32_t count, uint32_t offset) noexcept
+  {
+    return (static_cast<uint64_t>(count) << 32) | offset;
+  }
+
+  static constexpr uint32_t count_of(uint64_t index) noexcept
+  {
+    return static_cast<uint32_t>(index >> 32);
   }
 
-  void clear() noexcept
+  static constexpr uint32_t offset_of(uint64_t index) noexcept
   {
-    m_invoke  = nullptr;
-    m_destroy = nullptr;
-    m_move    = nullptr;
+    return static_cast<uint32_t>(index);
   }
 
-  alignas(std::max_align_t) char m_storage[EVENT_SBO_SIZE]{};
-  invoke_fn m_invoke   = nullptr;
-  destroy_fn m_destroy = nullptr;
-  move_fn m_move       = nullptr;
+  header *header_at(uint32_t position) noexcept
+  {
+    return reinterpret_cast<header *>(m_storage + position);
+  }
+
+  static void *payload_of(header *record) noexcept
+  {
+    return record + 1;
+  }
+
+  /// @brief Consume the oldest record, invoking it if @p run
+  bool pop(bool run)
+  {
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+      const uint64_t tail = m_tail.load(std::memory_order_seq_cst);
+      if (offset_of(head) == offset_of(tail))
+      {
+        return false;
+      }
+
+      // Wait for the record to be committed (producer may still be writing)
+      const uint32_t position = offset_of(head) & m_mask;
+      header *record          = header_at(position);
+      uint32_t length         = 0;
+      spin_wait waiter;
+      while ((length = record->length.load(std::memory_order_acquire)) == 0)
+      {
+        waiter.wait();
+      }
+
+      const handler_fn handler = record->handler;
+      if (handler != nullptr)
+      {
+        handler(payload_of(record), run);
+      }
+
+      std::memset(m_storage + position, 0, length);
+      const uint32_t processed = handler != nullptr ? 1 : 0;
+      head = pack(count_of(head) + processed, offset_of(head) + length);
+      m_head.store(head, std::memory_order_release);
+
+      if (processed != 0)
+      {
+        return true;
+      }
+      // Padding record: the real one starts at offset 0
+    }
+  }
+
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_head{0};
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_tail{0};
+
+  // Read-only after construction; shares a line with neither index
+  alignas(CACHE_LINE_SIZE) const uint32_t m_capacity;
+  const uint32_t m_mask;
+  unsigned char *const m_storage;
 };
 
 /// @brief Lock-free MPSC ring buffer
@@ -292,11 +483,36 @@ private:
 /// event_queue instance. Producer threads call enqueue(); the owning
 /// thread calls process_pending() to invoke queued events.
 ///
-/// **Zero-allocation guarantee:** Uses small-buffer optimization to store
-/// events inline. Callables must fit within EVENT_SBO_SIZE (128 bytes)
-/// to maintain the zero-allocation property on the hot path.
+/// **Zero-allocation guarantee:** Callables are constructed directly in a
+/// fixed byte ring, each taking a 16-byte header plus its own size rounded
+/// up to 16 bytes. Callables up to MAX_CALLABLE_SIZE bytes are accepted.
+///
+/// Default capacity: 256 KiB, e.g. 4096 events of 48 bytes of captures.
+/// The capacity may be chosen per queue at construction (rounded up to a
+/// power of two, at least MIN_CAPACITY): a market-data consumer can take a
+/// 4 MiB ring backed by huge pages while control threads keep small ones.
 ///
-/// Default capacity: 4096 events (power-of-two for efficient indexing)
+/// **Producer lanes:** Constructed with queue_mode::producer_lanes, every
+/// producer thread gets its own single-producer ring (LANE_CAPACITY bytes
+/// unless a capacity is given), allocated on its first enqueue(). Producers then share no
+/// cache line and perform no read-modify-write operations;
+/// process_pending() drains the lanes round-robin. Events from one thread
+/// stay in order, events from different threads may interleave
+/// differently than they were enqueued.
+///
+/// **Overflow:** what enqueue() does when the event does not fit is chosen
+/// at construction (overflow_policy). Only that slow path differs; an
+/// enqueue() that fits costs the same under every policy.
+/// - drop_newest: return false and count the event in dropped_count()
+/// - block: wait up to the block timeout for process_pending() to free
+///   space, then drop. The owner thread never waits on itself and drops
+///   at once.
+/// - spill: allocate the event on the heap and keep it in an overflow
+///   list, processed before newer ring events so FIFO order holds. Never
+///   drops, but allocates for as long as the consumer lags.
+/// - overwrite_oldest: discard the oldest event of the full ring (counted
+///   in overwritten_count()); newer, more relevant events survive. A
+///   handler enqueueing into its own full queue drops instead.
 ///
 /// Example:
 /// @code
@@ -316,85 +532,642 @@ private:
 class event_queue
 {
 public:
-  /// Default queue capacity (4096 events)
-  static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+  /// Default queue capacity in bytes (a power of two)
+  static constexpr std::size_t DEFAULT_CAPACITY = 256 * 1024;
+
+  /// Default capacity of each producer lane in bytes (producer_lanes mode)
+  static constexpr std::size_t LANE_CAPACITY = 64 * 1024;
+
+  /// Smallest ring or lane capacity in bytes
+  static constexpr std::size_t MIN_CAPACITY = detail::byte_ring<>::MIN_CAPACITY;
 
   /// Maximum size for inline callable storage (bytes)
-  static constexpr std::size_t MAX_CALLABLE_SIZE = detail::EVENT_SBO_SIZE;
+  static constexpr std::size_t MAX_CALLABLE_SIZE = detail::byte_ring<>::MAX_PAYLOAD_SIZE;
+
+  /// Events taken from one lane before moving to the next
+  static constexpr std::size_t LANE_BATCH = 32;
+
+  /// Longest wait of an enqueue() under overflow_policy::block by default
+  static constexpr std::chrono::milliseconds DEFAULT_BLOCK_TIMEOUT{10};
 
   /// @brief Create an event queue for the current thread
-  event_queue() :
-    m_owner_thread(std::this_thread::get_id())
+  /// @param mode How producers share the queue
+  /// @param overflow What enqueue() does when the event does not fit
+  /// @param block_timeout Longest wait of enqueue() under overflow_policy::block
+  explicit event_queue(queue_mode mode                      = queue_mode::shared_ring,
+                       overflow_policy overflow             = overflow_policy::drop_newest,
+                       std::chrono::nanoseconds block_timeout = DEFAULT_BLOCK_TIMEOUT) :
+    event_queue(mode == queue_mode::producer_lanes ? LANE_CAPACITY : DEFAULT_CAPACITY,
+                mode, overflow, block_timeout)
+  {
+  }
+
+  /// @brief Create an event queue of a given capacity for the current thread
+  /// @param capacity Bytes of the shared ring, or of each lane in
+  /// producer_lanes mode; rounded up to a power of two, at least MIN_CAPACITY
+  explicit event_queue(std::size_t capacity,
+                       queue_mode mode                      = queue_mode::shared_ring,
+                       overflow_policy overflow             = overflow_policy::drop_newest,
+                       std::chrono::nanoseconds block_timeout = DEFAULT_BLOCK_TIMEOUT) :
+    m_queue(mode == queue_mode::producer_lanes ? MIN_CAPACITY : capacity),
+    m_owner_thread(std::this_thread::get_id()),
+    m_mode(mode),
+    m_overflow(overflow),
+    m_block_timeout(block_timeout),
+    m_lane_capacity(detail::byte_ring<true>::round_capacity(capacity)),
+    m_id(next_id())
   {
   }
 
+  ~event_queue()
+  {
+    close_notification();
+
+    // Spilled events that were never processed, newest first
+    destroy_spilled(m_spill_batch);
+    destroy_spilled(m_spill.load(std::memory_order_acquire));
+
+    producer_lane *lane = m_lanes.load(std::memory_order_acquire);
+    while (lane != nullptr)
+    {
+      producer_lane *next = lane->next;
+      delete lane;
+      lane = next;
+    }
+  }
+
+  event_queue(const event_queue &)            = delete;
+  event_queue &operator=(const event_queue &) = delete;
+
   /// @brief Enqueue an event for later processing (lock-free, zero-allocation)
   ///
   /// Can be called from any thread. The callable will be invoked later
   /// when the owning thread calls process_pending().
   ///
   /// @param func Callable to invoke (must fit in MAX_CALLABLE_SIZE bytes)
-  /// @return true if enqueued, false if queue was full
+  /// @return true if enqueued, false if the event was dropped (see
+  /// overflow_policy)
   ///
-  /// @note This operation performs NO heap allocation. The callable is
-  /// stored inline using small-buffer optimization.
+  /// @note This operation performs NO heap allocation, except for the lane
+  /// of a thread's first enqueue() in producer_lanes mode and for events
+  /// spilled under overflow_policy::spill. The callable is constructed in
+  /// place in a byte ring.
   template <typename F>
   bool enqueue(F &&func)
   {
-    detail::event evt;
-    evt.store(std::forward<F>(func));
+    static_assert(sizeof(std::decay_t<F>) <= MAX_CALLABLE_SIZE,
+                  "Callable too large for the event queue. Reduce capture "
+                  "size; the maximum is event_queue::MAX_CALLABLE_SIZE bytes.");
+
+    // While events are spilled, newer ones queue behind them
+    if (m_overflow == overflow_policy::spill &&
+        m_spill.load(std::memory_order_relaxed) != nullptr)
+    {
+      spill(std::forward<F>(func));
+      notify_consumer();
+      return true;
+    }
 
-    bool success = m_queue.try_enqueue(std::move(evt));
-    if (!success)
+    // try_push() leaves func untouched when it fails, so it may be retried
+    if (!try_push(std::forward<F>(func)) && !enqueue_overflow(std::forward<F>(func)))
     {
       m_dropped_count.fetch_add(1, std::memory_order_relaxed);
+      return false;
     }
-    return success;
+    notify_consumer();
+    return true;
   }
 
   /// @brief Process all pending events (single-threaded, called by owner)
   ///
-  /// Invokes all queued events in FIFO order. Should only be called
-  /// from the thread that owns this queue.
+  /// Invokes all queued events in FIFO order (per producer thread in
+  /// producer_lanes mode). Should only be called from the thread that
+  /// owns this queue.
   ///
   /// @return Number of events processed
   std::size_t process_pending()
   {
+    return process_pending(static_cast<std::size_t>(-1));
+  }
+
+  /// @brief Process up to max_events pending events
+  /// @param max_events Maximum number of events to process
+  /// @return Number of events actually processed
+  std::size_t process_pending(std::size_t max_events)
+  {
+    if (m_notify_read_fd >= 0)
+    {
+      // Reset before draining: later enqueues signal the descriptor again
+      consume_notification();
+      m_fd_signaled.store(false, std::memory_order_seq_cst);
+    }
+
+    const bool exclusive = m_overflow == overflow_policy::overwrite_oldest;
+    if (exclusive)
+    {
+      lock_consumer();
+    }
+
     std::size_t count = 0;
-    detail::event evt;
+    for (;;)
+    {
+      // Spilled events are older than anything still in the rings
+      const std::size_t processed = run_spilled(max_events - count) +
+                                    drain(max_events - count);
+      count += processed;
+      if (count == max_events)
+      {
+        break;
+      }
+      if (m_spill.load(std::memory_order_acquire) != nullptr && !rings_pending())
+      {
+        take_spilled();
+      }
+      else if (processed == 0)
+      {
+        break;
+      }
+    }
 
-    while (m_queue.try_dequeue(evt))
+    if (exclusive)
     {
-      if (evt)
+      unlock_consumer();
+    }
+    if (count != 0 && m_overflow == overflow_policy::block)
+    {
+      wake_blocked_producers();
+    }
+
+    if (count == max_events && m_notify_write_fd.load(std::memory_order_relaxed) >= 0 &&
+        has_pending())
+    {
+      // Stopped early: keep the descriptor readable for the rest
+      signal_notification();
+    }
+    return count;
+  }
+
+  /// @brief Wait for events and process them (called by owner)
+  ///
+  /// Processes what is pending; if nothing is, spins briefly, then sleeps
+  /// on a futex until an enqueue() wakes it or @p timeout expires. The
+  /// spin length adapts: it doubles while events keep arriving during the
+  /// spin and halves when the spin ends in a sleep.
+  ///
+  /// @param timeout Longest wait; negative waits until an event arrives
+  /// @return Number of events processed (0 on timeout)
+  std::size_t wait_and_process(std::chrono::nanoseconds timeout)
+  {
+    std::size_t count = process_pending();
+    if (count != 0)
+    {
+      return count;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const bool bounded = timeout.count() >= 0;
+    const clock::time_point deadline = bounded ? clock::now() + timeout : clock::time_point();
+
+    detail::spin_wait waiter;
+    for (uint32_t i = 0; i < m_spin_limit; ++i)
+    {
+      waiter.wait();
+      if (has_pending())
       {
-        evt.invoke();
+        m_spin_limit = std::min(m_spin_limit * 2, MAX_SPIN);
+        return process_pending();
       }
-      ++count;
+    }
+    m_spin_limit = std::max(m_spin_limit / 2, MIN_SPIN);
+
+    for (;;)
+    {
+      std::chrono::nanoseconds remaining(-1);
+      if (bounded)
+      {
+        const clock::time_point now = clock::now();
+        if (now >= deadline)
+        {
+          break;
+        }
+        remaining = deadline - now;
+      }
+
+      // Announce, then recheck: an enqueue() after the recheck sees the flag
+      const uint32_t sequence = m_wake_sequence.load(std::memory_order_acquire);
+      m_waiting.store(true, std::memory_order_seq_cst);
+      if (has_pending())
+      {
+        m_waiting.store(false, std::memory_order_relaxed);
+        break;
+      }
+      detail::futex_wait(m_wake_sequence, sequence, remaining);
+      m_waiting.store(false, std::memory_order_relaxed);
+      if (has_pending())
+      {
+        break;
+      }
+    }
+
+    return process_pending();
+  }
+
+  /// @brief Descriptor that becomes readable when events are enqueued
+  ///
+  /// Register it for reading in a poll loop (see fb::poll_set) and call
+  /// process_pending() when it is readable; process_pending() resets it,
+  /// which costs it one non-blocking read() once a descriptor exists.
+  /// Created on first call, owned by the queue. Call from the owner thread.
+  ///
+  /// @return eventfd (Linux) or pipe read end (other POSIX); -1 where
+  /// unsupported or if the descriptor could not be created
+  int notification_fd()
+  {
+    if (m_notify_read_fd < 0)
+    {
+      open_notification();
+    }
+    return m_notify_read_fd;
+  }
+
+private:
+  /// Bounds of the adaptive spin in wait_and_process() (spin_wait steps)
+  static constexpr uint32_t MIN_SPIN = 16;
+  static constexpr uint32_t MAX_SPIN = 256;
+
+  /// @brief Heap-allocated event of overflow_policy::spill
+  struct spill_node
+  {
+    spill_node *next = nullptr;
+    void (*handler)(spill_node *, bool run) = nullptr; ///< Invokes if run, then deletes
+  };
+
+  template <typename F>
+  struct spill_item final : spill_node
+  {
+    explicit spill_item(F &&callable) :
+      func(std::forward<F>(callable))
+    {
+      handler = [](spill_node *node, bool run)
+      {
+        auto *item = static_cast<spill_item *>(node);
+        if (run)
+        {
+          item->func();
+        }
+        delete item;
+      };
     }
 
+    std::decay_t<F> func;
+  };
+
+  /// @brief Construct the callable in the shared ring or the caller's lane
+  template <typename F>
+  bool try_push(F &&func)
+  {
+    return m_mode == queue_mode::producer_lanes
+               ? current_lane().ring.try_push(std::forward<F>(func))
+               : m_queue.try_push(std::forward<F>(func));
+  }
+
+  /// @brief Slow path of enqueue(): the event did not fit
+  /// @return true if the policy stored the event after all
+  template <typename F>
+  bool enqueue_overflow(F &&func)
+  {
+    switch (m_overflow)
+    {
+    case overflow_policy::drop_newest:
+      return false;
+    case overflow_policy::block:
+      return push_blocking(std::forward<F>(func));
+    case overflow_policy::spill:
+      spill(std::forward<F>(func));
+      return true;
+    case overflow_policy::overwrite_oldest:
+      return push_overwriting(std::forward<F>(func));
+    }
+    return false;
+  }
+
+  /// @brief Retry until process_pending() frees space or the timeout expires
+  template <typename F>
+  bool push_blocking(F &&func)
+  {
+    // The consumer cannot free space while its own handler waits
+    if (is_owner_thread())
+    {
+      return false;
+    }
+    m_blocked_count.fetch_add(1, std::memory_order_relaxed);
+
+    using clock = std::chrono::steady_clock;
+    const clock::time_point deadline = clock::now() + m_block_timeout;
+
+    // Announce, then recheck: either the sequence load sees the space
+    // freed by process_pending(), or process_pending() sees the counter
+    m_blocked_producers.fetch_add(1, std::memory_order_seq_cst);
+    bool stored = false;
+    for (;;)
+    {
+      const uint32_t sequence = m_space_sequence.load(std::memory_order_seq_cst);
+      if (try_push(std::forward<F>(func)))
+      {
+        stored = true;
+        break;
+      }
+      const clock::time_point now = clock::now();
+      if (now >= deadline)
+      {
+        break;
+      }
+      detail::futex_wait(m_space_sequence, sequence, deadline - now);
+    }
+    m_blocked_producers.fetch_sub(1, std::memory_order_relaxed);
+    return stored;
+  }
+
+  /// @brief Wake producers waiting in push_blocking() (consumer side)
+  void wake_blocked_producers() noexcept
+  {
+    m_space_sequence.fetch_add(1, std::memory_order_seq_cst);
+    if (m_blocked_producers.load(std::memory_order_seq_cst) != 0)
+    {
+      detail::futex_wake_all(m_space_sequence);
+    }
+  }
+
+  /// @brief Move the callable to the heap and push it on the spill list
+  template <typename F>
+  void spill(F &&func)
+  {
+    spill_node *node = new spill_item<F>(std::forward<F>(func));
+    node->next       = m_spill.load(std::memory_order_relaxed);
+    // seq_cst: ordered against the consumer's has_pending() like try_push()
+    while (!m_spill.compare_exchange_weak(node->next, node,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+    {
+    }
+
+    m_spilled_count.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t depth = m_spill_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::size_t high = m_spill_high_water.load(std::memory_order_relaxed);
+    while (depth > high &&
+           !m_spill_high_water.compare_exchange_weak(high, depth,
+                                                     std::memory_order_relaxed))
+    {
+    }
+  }
+
+  /// @brief Take the spill list as an oldest-first batch (consumer side)
+  void take_spilled() noexcept
+  {
+    spill_node *node = m_spill.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr)
+    {
+      spill_node *next = node->next;
+      node->next       = m_spill_batch;
+      m_spill_batch    = node;
+      node             = next;
+    }
+  }
+
+  /// @brief Invoke up to @p max_events events of the taken batch
+  std::size_t run_spilled(std::size_t max_events)
+  {
+    std::size_t count = 0;
+    while (count < max_events && m_spill_batch != nullptr)
+    {
+      // Unlinked first: the handler may enqueue (and spill) again
+      spill_node *node = m_spill_batch;
+      m_spill_batch    = node->next;
+      m_spill_depth.fetch_sub(1, std::memory_order_relaxed);
+      node->handler(node, true);
+      ++count;
+    }
     return count;
   }
 
-  /// @brief Process up to max_events pending events
-  /// @param max_events Maximum number of events to process
-  /// @return Number of events actually processed
-  std::size_t process_pending(std::size_t max_events)
+  static void destroy_spilled(spill_node *node) noexcept
+  {
+    while (node != nullptr)
+    {
+      spill_node *next = node->next;
+      node->handler(node, false);
+      node = next;
+    }
+  }
+
+  /// @brief Make room by discarding the oldest event of the full ring
+  template <typename F>
+  bool push_overwriting(F &&func)
+  {
+    // A handler of this queue: process_pending() holds the consumer role
+    if (is_owner_thread() && m_in_drain)
+    {
+      return false;
+    }
+
+    detail::spin_wait waiter;
+    for (;;)
+    {
+      if (m_consumer_lock.exchange(true, std::memory_order_acquire))
+      {
+        // The consumer is draining; space is about to appear
+        waiter.wait();
+      }
+      else
+      {
+        const bool discarded = m_mode == queue_mode::producer_lanes
+                                   ? current_lane().ring.discard_oldest()
+                                   : m_queue.discard_oldest();
+        m_consumer_lock.store(false, std::memory_order_release);
+        if (discarded)
+        {
+          m_overwritten_count.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      if (try_push(std::forward<F>(func)))
+      {
+        return true;
+      }
+    }
+  }
+
+  /// @brief Take the consumer role from producers in push_overwriting()
+  void lock_consumer() noexcept
+  {
+    detail::spin_wait waiter;
+    while (m_consumer_lock.exchange(true, std::memory_order_acquire))
+    {
+      waiter.wait();
+    }
+    m_in_drain = true;
+  }
+
+  void unlock_consumer() noexcept
+  {
+    m_in_drain = false;
+    m_consumer_lock.store(false, std::memory_order_release);
+  }
+
+  /// @brief Invoke up to @p max_events events
+  std::size_t drain(std::size_t max_events)
   {
     std::size_t count = 0;
-    detail::event evt;
 
-    while (count < max_events && m_queue.try_dequeue(evt))
+    if (m_mode == queue_mode::shared_ring)
     {
-      if (evt)
+      while (count < max_events && m_queue.try_invoke())
       {
-        evt.invoke();
+        ++count;
+      }
+      return count;
+    }
+
+    // Round-robin: up to LANE_BATCH events per lane per pass
+    bool progress = true;
+    while (progress && count < max_events)
+    {
+      progress = false;
+      for (producer_lane *lane = m_lanes.load(std::memory_order_seq_cst);
+           lane != nullptr && count < max_events; lane = lane->next)
+      {
+        for (std::size_t taken = 0;
+             taken < LANE_BATCH && count < max_events && lane->ring.try_invoke();
+             ++taken)
+        {
+          ++count;
+          progress = true;
+        }
       }
-      ++count;
     }
 
     return count;
   }
 
+  /// @brief True if any event is queued (ordered against enqueue())
+  bool has_pending() const noexcept
+  {
+    return rings_pending() || m_spill_batch != nullptr ||
+           m_spill.load(std::memory_order_seq_cst) != nullptr;
+  }
+
+  /// @brief True if the shared ring or a lane holds an event
+  bool rings_pending() const noexcept
+  {
+    if (m_queue.has_pending())
+    {
+      return true;
+    }
+    for (const producer_lane *lane = m_lanes.load(std::memory_order_seq_cst);
+         lane != nullptr; lane = lane->next)
+    {
+      if (lane->ring.has_pending())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief Wake a consumer sleeping in wait_and_process() or on the fd
+  void notify_consumer() noexcept
+  {
+    if (m_waiting.load(std::memory_order_seq_cst))
+    {
+      m_wake_sequence.fetch_add(1, std::memory_order_release);
+      detail::futex_wake_one(m_wake_sequence);
+    }
+    if (m_notify_write_fd.load(std::memory_order_seq_cst) >= 0 &&
+        !m_fd_signaled.load(std::memory_order_seq_cst))
+    {
+      signal_notification();
+    }
+  }
+
+  /// @brief Make the descriptor readable unless it already is
+  void signal_notification() noexcept
+  {
+    if (m_fd_signaled.exchange(true, std::memory_order_seq_cst))
+    {
+      return;
+    }
+#if defined(__linux__)
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t written =
+        ::write(m_notify_write_fd.load(std::memory_order_relaxed), &one, sizeof(one));
+#elif defined(__unix__) || defined(__APPLE__)
+    const char one = 1;
+    [[maybe_unused]] const ssize_t written =
+        ::write(m_notify_write_fd.load(std::memory_order_relaxed), &one, sizeof(one));
+#endif
+  }
+
+  /// @brief Reset the descriptor to not readable
+  void consume_notification() noexcept
+  {
+#if defined(__linux__)
+    uint64_t value = 0;
+    [[maybe_unused]] const ssize_t got = ::read(m_notify_read_fd, &value, sizeof(value));
+#elif defined(__unix__) || defined(__APPLE__)
+    char buffer[64];
+    while (::read(m_notify_read_fd, buffer, sizeof(buffer)) > 0)
+    {
+    }
+#endif
+  }
+
+  void open_notification() noexcept
+  {
+    int read_fd  = -1;
+    int write_fd = -1;
+#if defined(__linux__)
+    read_fd  = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    write_fd = read_fd;
+#elif defined(__unix__) || defined(__APPLE__)
+    int fds[2];
+    if (::pipe(fds) == 0)
+    {
+      for (int fd : fds)
+      {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+      }
+      read_fd  = fds[0];
+      write_fd = fds[1];
+    }
+#endif
+    if (read_fd < 0)
+    {
+      return;
+    }
+
+    // Start readable: producers that have not seen the descriptor yet may
+    // already have enqueued, and the first process_pending() finds them
+    m_notify_read_fd = read_fd;
+    m_notify_write_fd.store(write_fd, std::memory_order_seq_cst);
+    signal_notification();
+  }
+
+  void close_notification() noexcept
+  {
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    const int write_fd = m_notify_write_fd.load(std::memory_order_relaxed);
+    if (write_fd >= 0 && write_fd != m_notify_read_fd)
+    {
+      ::close(write_fd);
+    }
+    if (m_notify_read_fd >= 0)
+    {
+      ::close(m_notify_read_fd);
+    }
+#endif
+  }
+
+public:
   /// @brief Check if this thread is the queue owner
   bool is_owner_thread() const noexcept
   {
@@ -404,13 +1177,20 @@ public:
   /// @brief Get approximate pending event count
   std::size_t pending_count() const noexcept
   {
-    return m_queue.size_approx();
+    std::size_t count = m_queue.size_approx() +
+                        m_spill_depth.load(std::memory_order_relaxed);
+    for (const producer_lane *lane = m_lanes.load(std::memory_order_acquire);
+         lane != nullptr; lane = lane->next)
+    {
+      count += lane->ring.size_approx();
+    }
+    return count;
   }
 
   /// @brief Check if queue is approximately empty
   bool empty() const noexcept
   {
-    return m_queue.empty_approx();
+    return pending_count() == 0;
   }
 
   /// @brief Get number of dropped events due to overflow
@@ -419,16 +1199,154 @@ public:
     return m_dropped_count.load(std::memory_order_relaxed);
   }
 
+  /// @brief Get number of queued events discarded by overflow_policy::overwrite_oldest
+  uint64_t overwritten_count() const noexcept
+  {
+    return m_overwritten_count.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Get number of events stored in the spill list (overflow_policy::spill)
+  uint64_t spilled_count() const noexcept
+  {
+    return m_spilled_count.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Get largest number of events the spill list held at once
+  std::size_t spill_high_water() const noexcept
+  {
+    return m_spill_high_water.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Get number of enqueue() calls that waited for space (overflow_policy::block)
+  ///
+  /// Those that timed out are also counted in dropped_count().
+  uint64_t blocked_count() const noexcept
+  {
+    return m_blocked_count.load(std::memory_order_relaxed);
+  }
+
   /// @brief Get the owner thread ID
   std::thread::id owner_thread() const noexcept
   {
     return m_owner_thread;
   }
 
+  /// @brief Get the producer mode chosen at construction
+  queue_mode mode() const noexcept
+  {
+    return m_mode;
+  }
+
+  /// @brief Get the overflow policy chosen at construction
+  overflow_policy overflow() const noexcept
+  {
+    return m_overflow;
+  }
+
+  /// @brief Get the capacity in bytes of the shared ring, or of each lane
+  /// in producer_lanes mode (after rounding)
+  std::size_t capacity() const noexcept
+  {
+    return m_mode == queue_mode::producer_lanes ? m_lane_capacity : m_queue.capacity();
+  }
+
 private:
-  detail::ring_buffer<detail::event, DEFAULT_CAPACITY> m_queue;
+  /// @brief Single-producer ring owned by one producer thread
+  struct producer_lane
+  {
+    producer_lane(std::thread::id id, std::size_t capacity) :
+      ring(capacity),
+      producer(id)
+    {
+    }
+
+    detail::byte_ring<true> ring;
+    std::thread::id producer;
+    producer_lane *next = nullptr;
+  };
+
+  static uint64_t next_id() noexcept
+  {
+    static std::atomic<uint64_t> s_next_id{1};
+    return s_next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// @brief Find or create the calling thread's lane
+  ///
+  /// A one-entry thread-local cache, keyed by queue ID so a queue
+  /// reallocated at the same address never hits a stale entry, makes the
+  /// common case a compare. Lanes are only added, never removed, until the
+  /// queue is destroyed; a thread reusing the ID of an exited thread takes
+  /// over its lane.
+  producer_lane &current_lane()
+  {
+    struct lane_cache
+    {
+      uint64_t queue_id   = 0;
+      producer_lane *lane = nullptr;
+    };
+    thread_local lane_cache tl_cache;
+
+    if (tl_cache.queue_id == m_id)
+    {
+      return *tl_cache.lane;
+    }
+
+    const auto self     = std::this_thread::get_id();
+    producer_lane *head = m_lanes.load(std::memory_order_acquire);
+    producer_lane *lane = head;
+    while (lane != nullptr && lane->producer != self)
+    {
+      lane = lane->next;
+    }
+
+    if (lane == nullptr)
+    {
+      lane       = new producer_lane(self, m_lane_capacity);
+      lane->next = head;
+      // seq_cst: the lane is found by a consumer rechecking before it sleeps
+      while (!m_lanes.compare_exchange_weak(lane->next, lane,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_acquire))
+      {
+      }
+    }
+
+    tl_cache.queue_id = m_id;
+    tl_cache.lane     = lane;
+    return *lane;
+  }
+
+  detail::byte_ring<> m_queue;
   std::thread::id m_owner_thread;
+  queue_mode m_mode;
+  overflow_policy m_overflow;
+  std::chrono::nanoseconds m_block_timeout;
+  std::size_t m_lane_capacity; ///< Capacity of each lane (producer_lanes)
+  uint64_t m_id; ///< Unique per queue, tags the producer lane cache
+  std::atomic<producer_lane *> m_lanes{nullptr};
   std::atomic<uint64_t> m_dropped_count{0};
+
+  // Overflow slow paths: touched only once an event did not fit
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<spill_node *> m_spill{nullptr}; ///< Newest first
+  spill_node *m_spill_batch = nullptr;          ///< Taken by the consumer, oldest first
+  std::atomic<std::size_t> m_spill_depth{0};    ///< Events in m_spill and m_spill_batch
+  std::atomic<std::size_t> m_spill_high_water{0};
+  std::atomic<uint64_t> m_spilled_count{0};
+  std::atomic<uint64_t> m_overwritten_count{0};
+  std::atomic<uint64_t> m_blocked_count{0};
+  std::atomic<uint32_t> m_blocked_producers{0}; ///< Producers in push_blocking()
+  std::atomic<uint32_t> m_space_sequence{0};    ///< Futex word of blocked producers
+  std::atomic<bool> m_consumer_lock{false};     ///< Consumer role (overwrite_oldest only)
+  bool m_in_drain = false;                      ///< Owner is in process_pending()
+
+  // Consumer wake-up: written by the owner, read by every enqueue()
+  alignas(detail::CACHE_LINE_SIZE) std::atomic<bool> m_waiting{false}; ///< Owner sleeps in wait_and_process()
+  std::atomic<uint32_t> m_wake_sequence{0};  ///< Futex word
+  std::atomic<bool> m_fd_signaled{false};    ///< Descriptor readable, not yet consumed
+  std::atomic<int> m_notify_write_fd{-1};    ///< -1 until notification_fd()
+  int m_notify_read_fd  = -1;
+  uint32_t m_spin_limit = MIN_SPIN;          ///< Adaptive spin of wait_and_process()
 };
 
 /// @brief Get the thread-local event queue for the current thread
@@ -6,5 +6,8 @@
 /// Include this single header to access the complete fb_signals library.
 
 #include "signal.hpp"
+#include "keyed_signal.hpp"
+#include "broadcast_ring.hpp"
+#include "static_signal.hpp"
 #include "connection.hpp"
 #include "event_queue.hpp"
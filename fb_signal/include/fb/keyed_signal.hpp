@@ -0,0 +1,436 @@
+#pragma once
+
+/// @file keyed_signal.hpp
+/// @brief Signal that routes each emission to the slots of one key
+///
+/// keyed_signal<Key, Args...> replaces one broadcast signal whose slots
+/// each filter on a key (symbol, session, channel):
+/// - emit(key, args...) invokes only the slots connected to that key
+/// - Lookup is one probe sequence in a flat open-addressing table
+/// - Same copy-on-write versions, epoch reclamation and O(1) deferred
+///   disconnect as fb::signal
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "connection.hpp"
+#include "detail/atomic_utils.hpp"
+#include "slot.hpp"
+
+namespace fb
+{
+
+/// @brief Signal whose slots subscribe to a key
+///
+/// Emission hashes the key, probes a power-of-two table of keys and walks
+/// the contiguous dispatch entries of that key only, so its cost depends
+/// on the slots of the key, not on the total number of slots.
+///
+/// **Differences from fb::signal:**
+/// - Every slot is connected to exactly one key
+/// - Direct delivery only; priorities order the slots of one key
+/// - Key must be copyable, default constructible, equality comparable and
+///   hashable with std::hash<Key>
+///
+/// **Thread safety:** as for fb::signal. emit() is wait-free: an epoch
+/// announcement, one load and the probe. connect() rebuilds the table
+/// under a mutex; disconnect flips a flag and the slot is dropped by the
+/// next rebuild (connect() or cleanup()).
+///
+/// Example:
+/// @code
+/// fb::keyed_signal<uint32_t, const quote &> on_quote;
+/// auto conn = on_quote.connect(symbol_id, [](const quote &q) { price(q); });
+/// on_quote.emit(q.symbol_id, q); // Only that symbol's subscribers run
+/// @endcode
+template <typename Key, typename... Args>
+class keyed_signal
+{
+public:
+  using key_type  = Key;
+  using slot_type = slot_entry<Args...>;
+
+  static_assert(std::is_default_constructible_v<Key> && std::is_copy_constructible_v<Key>,
+                "keyed_signal keys must be default constructible and copyable");
+
+  keyed_signal() :
+    keyed_signal(nullptr)
+  {
+  }
+
+  /// @brief Construct a signal allocating its slot entries from @p resource
+  ///
+  /// @param resource Memory resource for slot entries; nullptr for the heap.
+  ///                 Must outlive the signal and every connection made to it.
+  explicit keyed_signal(std::pmr::memory_resource *resource) :
+    m_version(new version()),
+    m_active(std::make_shared<std::atomic<std::size_t>>(0)),
+    m_resource(resource)
+  {
+  }
+
+  /// @brief Non-copyable and non-movable, like fb::signal
+  keyed_signal(const keyed_signal &)            = delete;
+  keyed_signal &operator=(const keyed_signal &) = delete;
+  keyed_signal(keyed_signal &&)                 = delete;
+  keyed_signal &operator=(keyed_signal &&)      = delete;
+
+  /// @brief Disconnects all slots; no emission may be in progress
+  ~keyed_signal()
+  {
+    disconnect_all();
+    delete m_version.load(std::memory_order_relaxed);
+    for (const auto &entry : m_retired)
+    {
+      delete entry.replaced;
+    }
+  }
+
+  // =========================================================================
+  // Connection Methods
+  // =========================================================================
+
+  /// @brief Connect a callable to the emissions of @p key
+  ///
+  /// @param key Key the slot subscribes to
+  /// @param func Callable invocable with the signal's argument types
+  /// @param prio Priority among the slots of @p key (higher = invoked earlier)
+  /// @return Connection handle for managing the connection
+  ///
+  /// @note Cold path: allocates and rebuilds the key table, O(slots).
+  template <typename F>
+  connection connect(const Key &key, F &&func, priority prio = priority::normal)
+  {
+    static_assert(std::is_invocable_v<std::decay_t<F>, Args...>,
+                  "Callable must be invocable with signal argument types");
+
+    auto slot = m_resource != nullptr
+                    ? std::allocate_shared<slot_type>(std::pmr::polymorphic_allocator<slot_type>(m_resource),
+                                                      std::forward<F>(func), prio)
+                    : std::make_shared<slot_type>(std::forward<F>(func), prio);
+    slot->track_active(m_active);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_active->fetch_add(1, std::memory_order_release);
+    rebuild(&key, slot);
+    return connection(slot);
+  }
+
+  /// @brief Connect a member function to the emissions of @p key
+  template <typename T, typename Ret>
+  connection connect(const Key &key, T *obj, Ret (T::*member_func)(Args...),
+                     priority prio = priority::normal)
+  {
+    return connect(
+        key,
+        [obj, member_func](Args... args)
+        {
+          (obj->*member_func)(std::forward<Args>(args)...);
+        },
+        prio);
+  }
+
+  /// @brief Connect a const member function to the emissions of @p key
+  template <typename T, typename Ret>
+  connection connect(const Key &key, const T *obj, Ret (T::*member_func)(Args...) const,
+                     priority prio = priority::normal)
+  {
+    return connect(
+        key,
+        [obj, member_func](Args... args)
+        {
+          (obj->*member_func)(std::forward<Args>(args)...);
+        },
+        prio);
+  }
+
+  // =========================================================================
+  // Emission Methods
+  // =========================================================================
+
+  /// @brief Invoke the connected, unblocked slots of @p key
+  ///
+  /// Wait-free and allocation-free. Slots may connect, disconnect or emit
+  /// again; a slot connected during the emission may or may not run.
+  void emit(const Key &key, Args... args) const
+  {
+    const detail::epoch_domain::guard section;
+    const version *current = m_version.load(std::memory_order_seq_cst);
+
+    const bucket *found = current->find(key);
+    if (found == nullptr)
+    {
+      return;
+    }
+
+    // Same argument policy as fb::signal::emit()
+    constexpr bool all_copyable_values =
+        ((std::is_copy_constructible_v<std::decay_t<Args>> &&
+          !std::is_reference_v<Args>) && ...);
+
+    const dispatch_type *entries = current->dispatch.data() + found->first;
+    for (uint32_t i = 0; i < found->count; ++i)
+    {
+      const dispatch_type &entry = entries[i];
+      if (!entry.deliverable())
+      {
+        continue;
+      }
+      if constexpr (all_copyable_values)
+      {
+        entry.invoke(entry.target, args...);
+      }
+      else
+      {
+        entry.invoke(entry.target, std::forward<Args>(args)...);
+      }
+    }
+  }
+
+  /// @brief Emit using function call syntax
+  void operator()(const Key &key, Args... args) const
+  {
+    emit(key, args...);
+  }
+
+  // =========================================================================
+  // Connection Management
+  // =========================================================================
+
+  /// @brief Disconnect all slots of every key
+  void disconnect_all()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &entry : current_internal()->owners)
+    {
+      entry.slot->deactivate();
+    }
+    publish(std::make_unique<version>());
+  }
+
+  /// @brief Number of connected slots over all keys - O(1)
+  std::size_t slot_count() const noexcept
+  {
+    return m_active->load(std::memory_order_acquire);
+  }
+
+  bool empty() const noexcept
+  {
+    return slot_count() == 0;
+  }
+
+  /// @brief True if emit(@p key, ...) could invoke anything
+  bool has_slots(const Key &key) const noexcept
+  {
+    const detail::epoch_domain::guard section;
+    const version *current = m_version.load(std::memory_order_seq_cst);
+    const bucket *found    = current->find(key);
+    if (found == nullptr)
+    {
+      return false;
+    }
+    const dispatch_type *entries = current->dispatch.data() + found->first;
+    for (uint32_t i = 0; i < found->count; ++i)
+    {
+      if (entries[i].deliverable())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief Drop disconnected slots and keys left without slots
+  ///
+  /// Not required for correctness: connect() does the same.
+  void cleanup()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    rebuild(nullptr, nullptr);
+  }
+
+private:
+  using slot_ptr      = std::shared_ptr<slot_type>;
+  using dispatch_type = detail::slot_dispatch<Args...>;
+
+  /// @brief Table entry: the dispatch range of one key
+  struct bucket
+  {
+    Key key{};
+    uint32_t first = 0; ///< Index of the key's first dispatch entry
+    uint32_t count = 0; ///< 0 marks an empty bucket
+  };
+
+  struct owner
+  {
+    Key key;
+    slot_ptr slot;
+  };
+
+  /// @brief One immutable version of the table
+  struct version
+  {
+    std::vector<bucket> table;           ///< Power-of-two size, at most half full
+    unsigned shift = 64;                 ///< 64 - log2(table.size())
+    std::vector<dispatch_type> dispatch; ///< Grouped by key, priority order
+    std::vector<owner> owners;           ///< owners[i] owns dispatch[i]
+
+    const bucket *find(const Key &key) const noexcept
+    {
+      if (table.empty())
+      {
+        return nullptr;
+      }
+      const std::size_t mask = table.size() - 1;
+      for (std::size_t i = slot_of(key, shift);; i = (i + 1) & mask)
+      {
+        const bucket &candidate = table[i];
+        if (candidate.count == 0)
+        {
+          return nullptr;
+        }
+        if (candidate.key == key)
+        {
+          return &candidate;
+        }
+      }
+    }
+  };
+
+  /// @brief Replaced version awaiting reclamation
+  struct retired_version
+  {
+    const version *replaced;
+    detail::epoch_domain::epoch_t epoch; ///< Epoch it was replaced in
+  };
+
+  /// @brief Home bucket of @p key (Fibonacci hashing spreads std::hash's
+  /// identity hash of integers over the table)
+  static std::size_t slot_of(const Key &key, unsigned shift) noexcept
+  {
+    const uint64_t hash  = std::hash<Key>{}(key);
+    const uint64_t mixed = hash * 0x9E3779B97F4A7C15ull;
+    const std::size_t index = shift >= 64 ? 0 : mixed >> shift;
+    return index;
+  }
+
+  /// @brief Current version; only valid with m_mutex held
+  const version *current_internal() const noexcept
+  {
+    return m_version.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Publish a version of the active slots, plus @p added (m_mutex held)
+  void rebuild(const Key *key, const slot_ptr &added)
+  {
+    // Group by key, keeping the order of first appearance of each key
+    std::unordered_map<Key, std::vector<slot_ptr>> groups;
+    std::vector<Key> order;
+    auto append = [&groups, &order](const Key &owner_key, const slot_ptr &slot)
+    {
+      auto &group = groups[owner_key];
+      if (group.empty())
+      {
+        order.push_back(owner_key);
+      }
+      group.push_back(slot);
+    };
+
+    for (const auto &existing : current_internal()->owners)
+    {
+      if (existing.slot->is_active())
+      {
+        append(existing.key, existing.slot);
+      }
+    }
+    if (added)
+    {
+      append(*key, added);
+    }
+
+    auto next = std::make_unique<version>();
+    std::size_t table_size = 1;
+    unsigned bits          = 0;
+    while (table_size < order.size() * 2)
+    {
+      table_size <<= 1;
+      ++bits;
+    }
+    if (!order.empty())
+    {
+      next->table.resize(table_size);
+      next->shift = 64 - bits;
+    }
+
+    const std::size_t mask = table_size - 1;
+    for (const Key &group_key : order)
+    {
+      auto &group = groups[group_key];
+      // Higher priority first, then earlier connection first
+      std::stable_sort(group.begin(), group.end(),
+                       [](const slot_ptr &a, const slot_ptr &b)
+                       {
+                         const auto pa = static_cast<int32_t>(a->get_priority());
+                         const auto pb = static_cast<int32_t>(b->get_priority());
+                         return pa != pb ? pa > pb : a->id() < b->id();
+                       });
+
+      std::size_t index = slot_of(group_key, next->shift);
+      while (next->table[index].count != 0)
+      {
+        index = (index + 1) & mask;
+      }
+      bucket &entry = next->table[index];
+      entry.key     = group_key;
+      entry.first   = static_cast<uint32_t>(next->dispatch.size());
+      entry.count   = static_cast<uint32_t>(group.size());
+
+      for (const auto &slot : group)
+      {
+        next->dispatch.push_back(slot->dispatch());
+        next->owners.push_back({group_key, slot});
+      }
+    }
+
+    publish(std::move(next));
+  }
+
+  /// @brief Swap in @p next and retire the current version (m_mutex held)
+  void publish(std::unique_ptr<version> next)
+  {
+    const version *old = m_version.exchange(next.release(), std::memory_order_seq_cst);
+    m_retired.push_back({old, detail::epoch_domain::instance().advance()});
+
+    // Free what no emission can still see
+    const auto &domain = detail::epoch_domain::instance();
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                   [&domain](const retired_version &entry)
+                                   {
+                                     if (!domain.synchronized(entry.epoch))
+                                     {
+                                       return false;
+                                     }
+                                     delete entry.replaced;
+                                     return true;
+                                   }),
+                    m_retired.end());
+  }
+
+  std::atomic<const version *> m_version; ///< Current version, owned
+  std::shared_ptr<std::atomic<std::size_t>> m_active; ///< Active slots, shared with each slot
+  std::mutex m_mutex;                     ///< Serializes rebuilds
+  std::vector<retired_version> m_retired; ///< Guarded by m_mutex
+  std::pmr::memory_resource *m_resource;  ///< Slot entries, nullptr = heap
+};
+
+} // namespace fb
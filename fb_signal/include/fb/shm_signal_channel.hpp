@@ -0,0 +1,424 @@
+#pragma once
+
+/// @file shm_signal_channel.hpp
+/// @brief Broadcast ring in POSIX shared memory, for signals across processes
+///
+/// Connects an fb::signal in one process to slots in others on the same
+/// host, without a socket or serialization: the publishing process writes
+/// each emission into a broadcast ring in a named shared-memory segment,
+/// and each subscribing process reads it at its own cursor. Records must
+/// be trivially copyable (no pointers into the publisher's memory).
+///
+/// Compiled only on POSIX systems; FB_SIGNAL_HAS_SHM tells which.
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FB_SIGNAL_HAS_SHM 1
+#else
+#define FB_SIGNAL_HAS_SHM 0
+#endif
+
+#if FB_SIGNAL_HAS_SHM
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "broadcast_ring.hpp"
+#include "detail/atomic_utils.hpp"
+#include "detail/futex.hpp"
+
+namespace fb
+{
+namespace detail
+{
+
+/// @brief Start of a shm_signal_channel segment; the ring cells follow it
+struct shm_signal_channel_header
+{
+  static constexpr uint64_t MAGIC   = 0x6662'7368'6d63'6831; // "fbshmch1"
+  static constexpr uint32_t VERSION = 1;
+
+  std::atomic<uint64_t> magic{0}; ///< Stored last by the creator
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t capacity;
+  uint64_t segment_size;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head{0}; ///< Next sequence to claim
+  alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> wake_sequence{0};
+  std::atomic<uint32_t> sleepers{0}; ///< Readers in shm_signal_channel::wait()
+};
+
+} // namespace detail
+
+/// @brief Named broadcast ring shared between processes
+///
+/// The publishing process create()s the channel and publishes into it,
+/// directly or through connect_broadcast(); subscribing processes open()
+/// it by name and read through readers, as with broadcast_ring. Readers
+/// either poll or sleep in wait(), which a publish wakes through a
+/// process-shared futex in the segment.
+///
+/// Errors are reported by is_open() / error() (an errno value), not by
+/// exceptions.
+///
+/// Example:
+/// @code
+/// // Feed handler process
+/// auto channel = fb::shm_signal_channel<quote>::create("quotes", 65536);
+/// auto bridge  = fb::connect_broadcast(on_quote, channel);
+///
+/// // Strategy process
+/// auto channel = fb::shm_signal_channel<quote>::open("quotes");
+/// if (!channel.is_open()) { retry_later(channel.error()); }
+/// fb::signal<const quote &> on_quote;
+/// on_quote.connect(price);
+/// auto reader = channel.subscribe();
+/// for (;;)
+/// {
+///   channel.wait(reader, std::chrono::milliseconds(100));
+///   reader.poll(on_quote); // Emits the local signal per record
+/// }
+/// @endcode
+///
+/// @note A publisher that dies mid-write leaves readers waiting at that
+/// record; a restarted publisher create()s a fresh segment, which readers
+/// must open() again.
+template <typename T>
+class shm_signal_channel
+{
+  static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                "shm_signal_channel records cross process boundaries: T must be "
+                "trivially copyable and default constructible");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                    std::atomic<uint32_t>::is_always_lock_free,
+                "shm_signal_channel needs address-free (lock-free) atomics");
+
+  using header_type = detail::shm_signal_channel_header;
+  using cell_type   = detail::broadcast_cell<T>;
+
+public:
+  using value_type = T;
+  using reader     = broadcast_reader<T>;
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+  /// @brief Create the segment @p name, replacing any left by an earlier run
+  ///
+  /// The creating channel unlinks the name when destroyed; processes that
+  /// still have it open keep their mapping.
+  ///
+  /// @param capacity Records kept for slow readers, rounded up to a power
+  ///        of two
+  static shm_signal_channel create(const std::string &name,
+                                   std::size_t capacity = DEFAULT_CAPACITY)
+  {
+    shm_signal_channel channel(shm_path(name));
+    const std::size_t cells = detail::broadcast_view<T>::round_capacity(capacity);
+    const std::size_t size  = cells_offset() + cells * sizeof(cell_type);
+
+    ::shm_unlink(channel.m_name.c_str());
+    const int fd = ::shm_open(channel.m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+      channel.m_error = errno;
+      return channel;
+    }
+    channel.m_owner = true;
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0 || !channel.map(fd, size))
+    {
+      channel.m_error = errno;
+      ::close(fd);
+      return channel;
+    }
+    ::close(fd);
+
+    header_type *header  = new (channel.m_base) header_type();
+    header->version      = header_type::VERSION;
+    header->record_size  = static_cast<uint32_t>(sizeof(T));
+    header->capacity     = cells;
+    header->segment_size = size;
+    unsigned char *first = static_cast<unsigned char *>(channel.m_base) + cells_offset();
+    for (std::size_t i = 0; i < cells; ++i)
+    {
+      new (first + i * sizeof(cell_type)) cell_type();
+    }
+    channel.attach(header);
+    header->magic.store(header_type::MAGIC, std::memory_order_release);
+    return channel;
+  }
+
+  /// @brief Open the segment @p name created by another channel
+  ///
+  /// Fails with ENOENT if it does not exist, EAGAIN if its creator has not
+  /// finished setting it up, EINVAL if it holds another record type.
+  static shm_signal_channel open(const std::string &name)
+  {
+    shm_signal_channel channel(shm_path(name));
+    const int fd = ::shm_open(channel.m_name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+      channel.m_error = errno;
+      return channel;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+      channel.m_error = errno;
+      ::close(fd);
+      return channel;
+    }
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    if (size < cells_offset())
+    {
+      channel.m_error = size == 0 ? EAGAIN : EINVAL;
+      ::close(fd);
+      return channel;
+    }
+    if (!channel.map(fd, size))
+    {
+      channel.m_error = errno;
+      ::close(fd);
+      return channel;
+    }
+    ::close(fd);
+
+    header_type *header = static_cast<header_type *>(channel.m_base);
+    if (header->magic.load(std::memory_order_acquire) != header_type::MAGIC)
+    {
+      channel.m_error = EAGAIN;
+      channel.unmap();
+      return channel;
+    }
+    const uint64_t capacity = header->capacity;
+    if (header->version != header_type::VERSION || header->record_size != sizeof(T) ||
+        header->segment_size != size || capacity < 2 || (capacity & (capacity - 1)) != 0 ||
+        cells_offset() + capacity * sizeof(cell_type) != size)
+    {
+      channel.m_error = EINVAL;
+      channel.unmap();
+      return channel;
+    }
+    channel.attach(header);
+    return channel;
+  }
+
+  shm_signal_channel(shm_signal_channel &&other) noexcept :
+    m_name(std::move(other.m_name)),
+    m_base(std::exchange(other.m_base, nullptr)),
+    m_size(std::exchange(other.m_size, 0)),
+    m_header(std::exchange(other.m_header, nullptr)),
+    m_view(other.m_view),
+    m_error(other.m_error),
+    m_owner(std::exchange(other.m_owner, false))
+  {
+  }
+
+  shm_signal_channel &operator=(shm_signal_channel &&other) noexcept
+  {
+    if (this != &other)
+    {
+      close();
+      m_name   = std::move(other.m_name);
+      m_base   = std::exchange(other.m_base, nullptr);
+      m_size   = std::exchange(other.m_size, 0);
+      m_header = std::exchange(other.m_header, nullptr);
+      m_view   = other.m_view;
+      m_error  = other.m_error;
+      m_owner  = std::exchange(other.m_owner, false);
+    }
+    return *this;
+  }
+
+  shm_signal_channel(const shm_signal_channel &)            = delete;
+  shm_signal_channel &operator=(const shm_signal_channel &) = delete;
+
+  /// @brief Unmaps the segment; the creator also unlinks its name
+  ~shm_signal_channel()
+  {
+    close();
+  }
+
+  /// @brief True if the segment is mapped and usable
+  bool is_open() const noexcept
+  {
+    return m_header != nullptr;
+  }
+
+  /// @brief errno of the failed create() / open(), 0 if none
+  int error() const noexcept
+  {
+    return m_error;
+  }
+
+  /// @brief Shared-memory object name, with its leading '/'
+  const std::string &name() const noexcept
+  {
+    return m_name;
+  }
+
+  /// @brief Write @p value for every reader in every process
+  ///
+  /// O(1) and never waits for readers, as broadcast_ring::publish(); a
+  /// reader sleeping in wait() costs one futex wake-up.
+  void publish(const T &value) noexcept
+  {
+    m_view.publish(value, std::memory_order_seq_cst);
+    // seq_cst: a reader announces itself in sleepers, then rechecks
+    if (m_header->sleepers.load(std::memory_order_seq_cst) != 0)
+    {
+      m_header->wake_sequence.fetch_add(1, std::memory_order_release);
+      detail::futex_wake_all(m_header->wake_sequence, true);
+    }
+  }
+
+  /// @brief Reader starting at the next record published
+  reader subscribe() const noexcept
+  {
+    return reader(m_view, m_view.published());
+  }
+
+  /// @brief Reader starting at the oldest record still in the ring
+  reader subscribe_from_oldest() const noexcept
+  {
+    return reader(m_view, m_view.oldest());
+  }
+
+  /// @brief Sleep until @p r has a record to read, at most @p timeout
+  ///
+  /// A negative timeout waits until a record arrives.
+  /// @return true if a record is ready (or @p r was lapped)
+  bool wait(const reader &r, std::chrono::nanoseconds timeout) const noexcept
+  {
+    using clock = std::chrono::steady_clock;
+    const bool bounded = timeout.count() >= 0;
+    const clock::time_point deadline = bounded ? clock::now() + timeout : clock::time_point();
+
+    for (;;)
+    {
+      if (r.has_pending())
+      {
+        return true;
+      }
+      std::chrono::nanoseconds remaining(-1);
+      if (bounded)
+      {
+        const clock::time_point now = clock::now();
+        if (now >= deadline)
+        {
+          return false;
+        }
+        remaining = deadline - now;
+      }
+
+      // Announce, then recheck: a publish() after the recheck sees us
+      const uint32_t sequence = m_header->wake_sequence.load(std::memory_order_acquire);
+      m_header->sleepers.fetch_add(1, std::memory_order_seq_cst);
+      if (!r.has_pending())
+      {
+        detail::futex_wait(m_header->wake_sequence, sequence, remaining, true);
+      }
+      m_header->sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  /// @brief Sequence numbers claimed so far
+  uint64_t published() const noexcept
+  {
+    return m_view.published();
+  }
+
+  std::size_t capacity() const noexcept
+  {
+    return m_view.capacity();
+  }
+
+  /// @brief Remove the segment @p name; open channels keep their mapping
+  static bool unlink(const std::string &name) noexcept
+  {
+    return ::shm_unlink(shm_path(name).c_str()) == 0;
+  }
+
+private:
+  explicit shm_signal_channel(std::string name) :
+    m_name(std::move(name))
+  {
+  }
+
+  static std::string shm_path(const std::string &name)
+  {
+    return !name.empty() && name[0] == '/' ? name : "/" + name;
+  }
+
+  static constexpr std::size_t cells_offset() noexcept
+  {
+    return (sizeof(header_type) + alignof(cell_type) - 1) / alignof(cell_type) *
+           alignof(cell_type);
+  }
+
+  bool map(int fd, std::size_t size) noexcept
+  {
+    void *base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+    {
+      return false;
+    }
+    m_base = base;
+    m_size = size;
+    return true;
+  }
+
+  void attach(header_type *header) noexcept
+  {
+    m_header = header;
+    m_view   = detail::broadcast_view<T>{
+        &header->head,
+        reinterpret_cast<cell_type *>(static_cast<unsigned char *>(m_base) + cells_offset()),
+        header->capacity - 1};
+  }
+
+  void unmap() noexcept
+  {
+    if (m_base != nullptr)
+    {
+      ::munmap(m_base, m_size);
+    }
+    m_base   = nullptr;
+    m_size   = 0;
+    m_header = nullptr;
+  }
+
+  void close() noexcept
+  {
+    unmap();
+    if (m_owner)
+    {
+      ::shm_unlink(m_name.c_str());
+      m_owner = false;
+    }
+  }
+
+  std::string m_name;
+  void *m_base           = nullptr;
+  std::size_t m_size     = 0;
+  header_type *m_header  = nullptr;
+  detail::broadcast_view<T> m_view{nullptr, nullptr, 0};
+  int m_error            = 0;
+  bool m_owner           = false; ///< Created the segment: unlinks it
+};
+
+} // namespace fb
+
+#endif // FB_SIGNAL_HAS_SHM
@@ -12,17 +12,32 @@
 /// - Queued delivery for cross-thread communication
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "connection.hpp"
+#include "coroutine.hpp"
+#include "detail/futex.hpp"
+#include "detail/payload_pool.hpp"
 #include "detail/slot_list.hpp"
 #include "event_queue.hpp"
 #include "slot.hpp"
 
+// Trace zones come from fb_core, which defines FB_PROFILING for its users
+#if defined(FB_PROFILING) && FB_PROFILING
+#include <fb/profiler.h>
+#define FB_SIGNAL_PROFILE_ZONE(name) FB_PROFILE_ZONE(name)
+#else
+#define FB_SIGNAL_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
+
 namespace fb
 {
 
@@ -65,6 +80,18 @@ public:
 
   signal() = default;
 
+  /// @brief Construct a signal allocating its slot entries from @p resource
+  ///
+  /// Lets connect() draw from a pool or arena (e.g. fb::pool_resource)
+  /// instead of the heap. The resource must outlive the signal and every
+  /// connection made to it.
+  ///
+  /// @param resource Memory resource for slot entries; nullptr for the heap
+  explicit signal(std::pmr::memory_resource *resource)
+      : m_slots(resource)
+  {
+  }
+
   /// @brief Signals are non-copyable and non-movable
   ///
   /// The internal mutex-protected slot list prevents move semantics.
@@ -112,7 +139,7 @@ public:
   /// @brief Connect a callable with a specific delivery policy
   ///
   /// @param func The callable to connect
-  /// @param policy Delivery policy (direct, queued, or automatic)
+  /// @param policy Delivery policy (direct, queued, automatic or queued_latest)
   /// @param queue Target event queue for queued/automatic delivery
   /// @param prio Priority level (higher = invoked earlier)
   /// @return Connection handle for managing the connection
@@ -120,6 +147,9 @@ public:
   /// @note For queued delivery, arguments must be copyable.
   /// @note For automatic delivery, direct is used if emitting thread
   ///       matches the queue's owner thread.
+  /// @note For queued_latest delivery, emissions made before the queue
+  ///       processes the slot's event collapse into one invocation with
+  ///       the newest arguments.
   template <typename F>
   connection connect(F &&func,
                      delivery_policy policy,
@@ -188,20 +218,28 @@ public:
   ///
   /// The slot will only be invoked if the filter returns true.
   ///
+  /// The predicate is stored by value next to the callable in one slot, so
+  /// a lambda filter is called directly: no std::function, no extra
+  /// indirect call, and no allocation while both fit detail::SBO_SIZE. A
+  /// filter_type (std::function) is still accepted, at its usual cost, and
+  /// a mutable filter keeps its state between emissions.
+  ///
   /// @param func The callable to connect
-  /// @param filter Predicate that determines whether to invoke
+  /// @param filter Predicate invocable as filter(const Args&...) -> bool
   /// @param prio Priority level
   /// @return Connection handle
-  ///
-  /// @note Filtering adds overhead to each emission. Use sparingly.
-  template <typename F>
-  connection connect_filtered(F &&func, filter_type filter,
+  template <typename F, typename Filter>
+  connection connect_filtered(F &&func, Filter &&filter,
                               priority prio = priority::normal)
   {
+    static_assert(std::is_invocable_r_v<bool, std::decay_t<Filter> &, const Args &...>,
+                  "Filter must be invocable with const references to the "
+                  "signal argument types and return bool");
+
     auto wrapper = [f = std::forward<F>(func),
-                    filt = std::move(filter)](Args... args)
+                    filt = std::forward<Filter>(filter)](Args... args) mutable
     {
-      if (filt(args...))
+      if (filt(std::as_const(args)...))
       {
         f(std::forward<Args>(args)...);
       }
@@ -233,32 +271,40 @@ public:
   /// be invoked in the current emission (implementation-defined).
   void emit(Args... args) const
   {
-    // Take atomic snapshot (single load, lock-free)
-    auto snapshot = m_slots.get_snapshot();
+    FB_SIGNAL_PROFILE_ZONE("signal::emit");
+
+    // Take snapshot (wait-free: an epoch announcement and one load)
+    const auto snapshot = m_slots.get_snapshot();
+    const auto &dispatch = snapshot.dispatch();
 
     // Current thread ID for automatic delivery policy
     const auto current_thread = std::this_thread::get_id();
 
-    // Invoke each active, non-blocked slot
-    for (const auto &slot : *snapshot)
+    // Shared-payload mode: built by the first queued slot, then shared
+    payload_ptr payload;
+
+    // Walk the contiguous dispatch array; the owning slot is only needed
+    // to keep a queued invocation alive
+    for (std::size_t i = 0; i < dispatch.size(); ++i)
     {
-      if (!slot->is_active() || slot->is_blocked())
+      const auto &entry = dispatch[i];
+      if (!entry.deliverable())
       {
         continue;
       }
 
-      const auto policy = slot->get_delivery_policy();
-      auto *queue = slot->get_target_queue();
+      auto *queue = entry.queue;
 
       bool use_direct = false;
 
-      switch (policy)
+      switch (entry.policy)
       {
         case delivery_policy::direct:
           use_direct = true;
           break;
 
         case delivery_policy::queued:
+        case delivery_policy::queued_latest:
           use_direct = (queue == nullptr);
           break;
 
@@ -289,13 +335,15 @@ public:
             ((std::is_copy_constructible_v<std::decay_t<Args>> &&
               !std::is_reference_v<Args>) && ...);
 
+        // Compiled out unless FB_SIGNAL_PROFILING
+        const detail::slot_timer timer(entry.profile());
         if constexpr (all_copyable_values)
         {
-          slot->invoke_unchecked(args...);
+          entry.invoke(entry.target, args...);
         }
         else
         {
-          slot->invoke_unchecked(std::forward<Args>(args)...);
+          entry.invoke(entry.target, std::forward<Args>(args)...);
         }
       }
       else if (queue != nullptr)
@@ -304,12 +352,19 @@ public:
         // Only enabled when all argument types are copyable
         if constexpr ((std::is_copy_constructible_v<std::decay_t<Args>> && ...))
         {
-          enqueue_invocation(*queue, slot, args...);
+          if (entry.policy == delivery_policy::queued_latest)
+          {
+            enqueue_latest(*queue, (*snapshot)[i], args...);
+          }
+          else
+          {
+            enqueue_queued(*queue, (*snapshot)[i], payload, args...);
+          }
         }
         else
         {
           // Fallback to direct delivery for non-copyable types
-          slot->invoke_unchecked(std::forward<Args>(args)...);
+          entry.invoke(entry.target, std::forward<Args>(args)...);
         }
       }
     }
@@ -321,6 +376,65 @@ public:
     emit(args...);
   }
 
+  /// @brief Emit with direct slots invoked concurrently on an executor
+  ///
+  /// For heavy fan-out where slots are slow and independent. Slots of one
+  /// priority run concurrently; a lower priority band starts only once
+  /// every slot of the band above it has returned. Returns when all
+  /// slots have run.
+  ///
+  /// Slots with queued, queued_latest or automatic delivery to another
+  /// thread are posted to their queue as by emit(); the rest run on
+  /// @p executor. Arguments are copied once into the emission and shared,
+  /// read-only, by the concurrent slots: they must be copyable, and
+  /// non-const reference arguments are rejected.
+  ///
+  /// @param executor Anything with submit(F) running the nullary callable
+  /// F on some thread, e.g. a thread pool. Waiting from one of its
+  /// threads needs another thread free to run the slots.
+  /// @param args Arguments to pass to each slot
+  ///
+  /// @note Cold-path cost: allocates the shared emission state.
+  template <typename Executor>
+  void emit_parallel(Executor &executor, Args... args) const
+  {
+    auto state = start_parallel(executor, args...);
+    if (state)
+    {
+      state->wait();
+    }
+  }
+
+  /// @brief As emit_parallel(), without waiting for the slots to finish
+  template <typename Executor>
+  void emit_parallel_async(Executor &executor, Args... args) const
+  {
+    start_parallel(executor, args...);
+  }
+
+#if FB_SIGNAL_HAS_COROUTINES
+  /// @brief Awaitable for the next emission (C++20)
+  ///
+  /// `co_await sig.next()` suspends the coroutine until the signal is next
+  /// emitted and yields its arguments. The coroutine resumes inside that
+  /// emit(), on the emitting thread.
+  ///
+  /// @note Cold path: connects (and later disconnects) a one-shot slot.
+  next_emission<Args...> next()
+  {
+    return next_emission<Args...>(*this, nullptr);
+  }
+
+  /// @brief Awaitable for the next emission, resumed by @p queue's owner
+  ///
+  /// The coroutine resumes when the owner thread processes @p queue, as
+  /// for a delivery_policy::queued slot.
+  next_emission<Args...> next(event_queue &queue)
+  {
+    return next_emission<Args...>(*this, &queue);
+  }
+#endif
+
   // =========================================================================
   // Connection Management
   // =========================================================================
@@ -332,6 +446,8 @@ public:
   }
 
   /// @brief Get the number of connected slots
+  ///
+  /// O(1): reads a counter updated on connect and disconnect.
   std::size_t slot_count() const noexcept
   {
     return m_slots.size();
@@ -343,6 +459,18 @@ public:
     return m_slots.empty();
   }
 
+  /// @brief Hot-path guard: true if emit() could invoke anything
+  ///
+  /// A single atomic load, unlike emit() which takes a snapshot of the slot
+  /// list. Use it to skip building arguments nobody will receive:
+  /// @code
+  /// if (on_packet.has_slots()) { on_packet.emit(data, size); }
+  /// @endcode
+  bool has_slots() const noexcept
+  {
+    return !m_slots.empty();
+  }
+
   /// @brief Explicitly block a specific connection by ID
   void block(uint64_t connection_id)
   {
@@ -370,7 +498,225 @@ public:
     m_slots.cleanup();
   }
 
+  // =========================================================================
+  // Queued Delivery Options
+  // =========================================================================
+
+  /// @brief Share one copy of the arguments between queued slots
+  ///
+  /// By default every queued slot's event holds its own copy of the
+  /// arguments. With shared payloads on, an emission copies them once,
+  /// into a pooled reference-counted block that the events of all its
+  /// queued slots share, whatever queue each slot is on. Slots receive
+  /// the shared copy as const lvalues.
+  ///
+  /// Worth it for large arguments passed by const reference (a
+  /// `const std::vector<T> &` fanned out to N queued subscribers makes one
+  /// copy instead of N). Slots taking their parameters by value still copy
+  /// them when invoked. queued_latest slots are unaffected, and so are
+  /// signals with rvalue or non-const reference parameters, which keep
+  /// one copy per slot.
+  void set_shared_payload(bool enabled) noexcept
+  {
+    m_shared_payload.store(enabled, std::memory_order_relaxed);
+  }
+
+  bool shared_payload() const noexcept
+  {
+    return m_shared_payload.load(std::memory_order_relaxed);
+  }
+
+  // =========================================================================
+  // Profiling
+  // =========================================================================
+
+  /// True if slot invocations are timed (FB_SIGNAL_PROFILING=1)
+  static constexpr bool profiling_enabled = FB_SIGNAL_PROFILING != 0;
+
+  /// @brief Invocation count and durations of each connected slot
+  ///
+  /// Covers direct invocations and queued deliveries (timed on the
+  /// consumer thread), in dispatch order. Empty unless profiling_enabled.
+  std::vector<slot_timing> slot_timings() const
+  {
+    std::vector<slot_timing> timings;
+    if constexpr (profiling_enabled)
+    {
+      const auto snapshot = m_slots.get_snapshot();
+      timings.reserve(snapshot->size());
+      for (const auto &slot : *snapshot)
+      {
+        if (slot && slot->is_active())
+        {
+          slot_timing timing;
+          timing.connection_id = slot->id();
+          slot->profile()->read(timing);
+          timings.push_back(timing);
+        }
+      }
+    }
+    return timings;
+  }
+
+  /// @brief Zero the timings of every connected slot
+  void reset_slot_timings()
+  {
+    if constexpr (profiling_enabled)
+    {
+      const auto snapshot = m_slots.get_snapshot();
+      for (const auto &slot : *snapshot)
+      {
+        if (slot)
+        {
+          slot->profile()->reset();
+        }
+      }
+    }
+  }
+
 private:
+  /// @brief Shared state of one emit_parallel()
+  template <typename Executor>
+  struct parallel_emission
+  {
+    parallel_emission(Executor &exec, Args... values) :
+      executor(exec),
+      args(values...)
+    {
+    }
+
+    Executor &executor;
+    std::tuple<std::decay_t<Args>...> args;
+    std::vector<std::shared_ptr<slot_type>> slots; ///< In dispatch order
+    std::vector<std::size_t> band_ends;            ///< End of each priority band in slots
+    std::atomic<std::size_t> remaining{0};         ///< Slots of the running band still running
+    std::atomic<uint32_t> finished{0};             ///< Futex word, 1 once the last band is done
+
+    /// @brief Submit the slots of band @p band
+    static void launch(const std::shared_ptr<parallel_emission> &self, std::size_t band)
+    {
+      const std::size_t begin = band == 0 ? 0 : self->band_ends[band - 1];
+      const std::size_t end   = self->band_ends[band];
+      self->remaining.store(end - begin, std::memory_order_relaxed);
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        self->executor.submit([self, band, i]()
+        {
+          self->run(i);
+          if (self->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+          {
+            self->band_done(self, band);
+          }
+        });
+      }
+    }
+
+    void run(std::size_t index) const
+    {
+      const auto &slot = slots[index];
+      if (slot->is_active() && !slot->is_blocked())
+      {
+        std::apply([&slot](const auto &...a)
+        {
+          slot->invoke_unchecked(a...);
+        }, args);
+      }
+    }
+
+    /// @brief Start the next band or signal completion
+    void band_done(const std::shared_ptr<parallel_emission> &self, std::size_t band)
+    {
+      if (band + 1 < band_ends.size())
+      {
+        launch(self, band + 1);
+        return;
+      }
+      finished.store(1, std::memory_order_release);
+      detail::futex_wake_all(finished);
+    }
+
+    void wait()
+    {
+      while (finished.load(std::memory_order_acquire) == 0)
+      {
+        detail::futex_wait(finished, 0, std::chrono::nanoseconds(-1));
+      }
+    }
+  };
+
+  /// @brief Post queued slots, then submit the first band of direct ones
+  /// @return The emission state, or nullptr if no slot runs on the executor
+  template <typename Executor>
+  std::shared_ptr<parallel_emission<Executor>> start_parallel(Executor &executor,
+                                                              Args... args) const
+  {
+    static_assert(((std::is_copy_constructible_v<std::decay_t<Args>> &&
+                    (!std::is_reference_v<Args> ||
+                     std::is_const_v<std::remove_reference_t<Args>>)) && ...),
+                  "emit_parallel() shares its arguments between threads: "
+                  "use copyable values or const references");
+
+    using state_type = parallel_emission<Executor>;
+    std::shared_ptr<state_type> state;
+
+    const auto snapshot        = m_slots.get_snapshot();
+    const auto &dispatch       = snapshot.dispatch();
+    const auto current_thread  = std::this_thread::get_id();
+    bool have_band             = false;
+    priority band_priority     = priority::normal;
+    payload_ptr payload;
+
+    for (std::size_t i = 0; i < dispatch.size(); ++i)
+    {
+      const auto &entry = dispatch[i];
+      if (!entry.deliverable())
+      {
+        continue;
+      }
+
+      auto *queue = entry.queue;
+      const bool posted =
+          queue != nullptr &&
+          (entry.policy == delivery_policy::queued ||
+           entry.policy == delivery_policy::queued_latest ||
+           (entry.policy == delivery_policy::automatic &&
+            current_thread != queue->owner_thread()));
+      if (posted)
+      {
+        if (entry.policy == delivery_policy::queued_latest)
+        {
+          enqueue_latest(*queue, (*snapshot)[i], args...);
+        }
+        else
+        {
+          enqueue_queued(*queue, (*snapshot)[i], payload, args...);
+        }
+        continue;
+      }
+
+      if (!state)
+      {
+        state = std::make_shared<state_type>(executor, args...);
+      }
+      // The snapshot is in priority order: a new priority starts a band
+      const priority slot_priority = (*snapshot)[i]->get_priority();
+      if (have_band && slot_priority != band_priority)
+      {
+        state->band_ends.push_back(state->slots.size());
+      }
+      have_band     = true;
+      band_priority = slot_priority;
+      state->slots.push_back((*snapshot)[i]);
+    }
+
+    if (state)
+    {
+      state->band_ends.push_back(state->slots.size());
+      state_type::launch(state, 0);
+    }
+    return state;
+  }
+
   /// @brief Helper to enqueue a slot invocation for cross-thread delivery
   ///
   /// Captures arguments by value to ensure thread-safe access from the
@@ -395,10 +741,91 @@ private:
     });
   }
 
+  /// @brief Arguments of one emission shared by its queued events
+  using payload_type = std::tuple<std::decay_t<Args>...>;
+  using payload_ptr  = std::shared_ptr<const payload_type>;
+
+  /// @brief A shared payload hands slots const lvalues: only by-value and
+  /// const-reference parameters can take them
+  static constexpr bool payload_shareable =
+      ((!std::is_reference_v<Args> ||
+        (std::is_lvalue_reference_v<Args> && std::is_const_v<std::remove_reference_t<Args>>)) &&
+       ...);
+
+  /// @brief Enqueue a queued slot, sharing @p payload in shared-payload mode
+  ///
+  /// @p payload is created by the first call of an emission that needs it.
+  template <typename... CapturedArgs>
+  void enqueue_queued(event_queue &queue,
+                      const std::shared_ptr<slot_type> &slot,
+                      payload_ptr &payload,
+                      const CapturedArgs &...args) const
+  {
+    if constexpr (payload_shareable)
+    {
+      if (m_shared_payload.load(std::memory_order_relaxed))
+      {
+        if (!payload)
+        {
+          payload = std::allocate_shared<payload_type>(
+              detail::pool_allocator<payload_type>(), args...);
+        }
+        queue.enqueue([slot_copy = slot, shared = payload]()
+        {
+          if (slot_copy->is_active() && !slot_copy->is_blocked())
+          {
+            std::apply([&slot_copy](const auto &...a)
+            {
+              slot_copy->invoke_unchecked(a...);
+            }, *shared);
+          }
+        });
+        return;
+      }
+    }
+    enqueue_invocation(queue, slot, args...);
+  }
+
+  /// @brief Helper to post the newest arguments of a queued_latest slot
+  ///
+  /// The arguments replace any the slot's mailbox still holds; an event is
+  /// enqueued only if none is already pending, so a burst of emissions is
+  /// delivered as one invocation with the last arguments.
+  template <typename... CapturedArgs>
+  static void enqueue_latest(event_queue &queue,
+                             const std::shared_ptr<slot_type> &slot,
+                             const CapturedArgs &...args)
+  {
+    auto *mailbox = slot->mailbox();
+    if (!mailbox->publish(args...))
+    {
+      return;
+    }
+
+    const bool enqueued = queue.enqueue([slot_copy = slot]()
+    {
+      slot_copy->mailbox()->deliver([&slot_copy](auto &&...a)
+      {
+        if (slot_copy->is_active() && !slot_copy->is_blocked())
+        {
+          slot_copy->invoke_unchecked(std::forward<decltype(a)>(a)...);
+        }
+      });
+    });
+    if (!enqueued)
+    {
+      // Queue full: the value waits in the mailbox for the next emission
+      mailbox->cancel();
+    }
+  }
+
   detail::slot_list<Args...> m_slots;
+  std::atomic<bool> m_shared_payload{false}; ///< See set_shared_payload()
 };
 
 /// @brief Type alias for signals with no arguments
 using signal_void = signal<>;
 
 } // namespace fb
+
+#undef FB_SIGNAL_PROFILE_ZONE
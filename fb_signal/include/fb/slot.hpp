@@ -7,6 +7,7 @@
 /// ~6 captured pointers) while supporting arbitrary callable types.
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -14,7 +15,10 @@
 #include <type_traits>
 #include <utility>
 
+#include "detail/atomic_utils.hpp"
 #include "detail/function_traits.hpp"
+#include "detail/latest_mailbox.hpp"
+#include "detail/slot_profile.hpp"
 
 namespace fb
 {
@@ -33,8 +37,9 @@ enum class priority : int32_t
 enum class delivery_policy
 {
   direct,   ///< Invoke immediately in emitting thread
-  queued,   ///< Defer invocation to receiver's thread
-  automatic ///< Direct if same thread, queued otherwise
+  queued,        ///< Defer invocation to receiver's thread
+  automatic,     ///< Direct if same thread, queued otherwise
+  queued_latest  ///< Queued, coalesced: only the newest arguments are delivered
 };
 
 // Forward declaration
@@ -191,6 +196,18 @@ public:
     return m_invoke != nullptr;
   }
 
+  /// @brief Type-erased entry point, called as invoker()(target(), args...)
+  invoke_fn invoker() const noexcept
+  {
+    return m_invoke;
+  }
+
+  /// @brief Storage argument for invoker()
+  void *target() const noexcept
+  {
+    return const_cast<void *>(static_cast<const void *>(m_storage));
+  }
+
 private:
   void destroy()
   {
@@ -210,6 +227,43 @@ private:
   bool m_is_heap = false;
 };
 
+/// @brief Emission-time view of one slot, stored contiguously in the
+/// signal's snapshot array
+///
+/// Everything immutable that emit() needs sits here, so the only per-slot
+/// indirection left is the state byte, which shares a cache line with the
+/// callable's inline storage.
+template <typename... Args>
+struct slot_dispatch
+{
+  using invoke_fn = typename callable_storage<Args...>::invoke_fn;
+
+  invoke_fn invoke;               ///< Callable entry point
+  void *target;                   ///< Callable storage passed to invoke
+  const std::atomic<uint8_t> *state; ///< Slot state, 0 when deliverable
+  delivery_policy policy;
+  event_queue *queue;             ///< Target queue for queued/automatic delivery
+#if FB_SIGNAL_PROFILING
+  slot_profile *timing;           ///< Destination of slot_timer
+#endif
+
+  /// @brief True if the slot is connected and not blocked
+  bool deliverable() const noexcept
+  {
+    return state->load(std::memory_order_acquire) == 0;
+  }
+
+  /// @brief Profile to time direct invocations into (nullptr if disabled)
+  slot_profile *profile() const noexcept
+  {
+#if FB_SIGNAL_PROFILING
+    return timing;
+#else
+    return nullptr;
+#endif
+  }
+};
+
 } // namespace detail
 
 /// @brief Slot entry containing callable and metadata
@@ -220,11 +274,15 @@ private:
 /// - Active/blocked state flags
 /// - Unique connection ID
 /// - Delivery policy and target queue for cross-thread delivery
+///
+/// Cache-line aligned with the state first, so a check-and-invoke during
+/// emission usually touches a single line of the slot.
 template <typename... Args>
-class slot_entry
+class alignas(detail::CACHE_LINE_SIZE) slot_entry
 {
 public:
   using id_type = uint64_t;
+  using mailbox_type = detail::latest_mailbox<std::decay_t<Args>...>;
 
   slot_entry() = default;
 
@@ -239,6 +297,13 @@ public:
       , m_target_queue(queue)
   {
     m_callable.store(std::forward<F>(func));
+    if (policy == delivery_policy::queued_latest)
+    {
+      m_mailbox = std::make_unique<mailbox_type>();
+    }
+#if FB_SIGNAL_PROFILING
+    m_profile = std::make_unique<detail::slot_profile>();
+#endif
   }
 
   /// @brief Invoke the slot if active and not blocked
@@ -253,37 +318,54 @@ public:
   /// @brief Invoke unconditionally (for internal use)
   void invoke_unchecked(Args... args) const
   {
+    const detail::slot_timer timer(profile());
     m_callable.invoke(std::forward<Args>(args)...);
   }
 
   /// @brief Check if slot is active (not disconnected)
   bool is_active() const noexcept
   {
-    return m_active.load(std::memory_order_acquire);
+    return (m_state.load(std::memory_order_acquire) & DISCONNECTED) == 0;
   }
 
   /// @brief Check if slot is temporarily blocked
   bool is_blocked() const noexcept
   {
-    return m_blocked.load(std::memory_order_acquire);
+    return (m_state.load(std::memory_order_acquire) & BLOCKED) != 0;
   }
 
   /// @brief Mark slot as disconnected
+  ///
+  /// Only the first call decrements the owning list's active counter, so
+  /// disconnecting through several handles is safe.
   void deactivate() noexcept
   {
-    m_active.store(false, std::memory_order_release);
+    const uint8_t previous = m_state.fetch_or(DISCONNECTED, std::memory_order_acq_rel);
+    if ((previous & DISCONNECTED) == 0 && m_active_counter)
+    {
+      m_active_counter->fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  /// @brief Attach the owning list's active-slot counter
+  ///
+  /// Shared ownership keeps the counter valid for connections that outlive
+  /// the signal. Must be called before the slot is published.
+  void track_active(std::shared_ptr<std::atomic<std::size_t>> counter) noexcept
+  {
+    m_active_counter = std::move(counter);
   }
 
   /// @brief Block slot temporarily
   void block() noexcept
   {
-    m_blocked.store(true, std::memory_order_release);
+    m_state.fetch_or(BLOCKED, std::memory_order_release);
   }
 
   /// @brief Unblock slot
   void unblock() noexcept
   {
-    m_blocked.store(false, std::memory_order_release);
+    m_state.fetch_and(static_cast<uint8_t>(~BLOCKED), std::memory_order_release);
   }
 
   /// @brief Get slot priority
@@ -316,20 +398,55 @@ public:
     return m_target_queue;
   }
 
+  /// @brief Pending arguments of a queued_latest slot (nullptr otherwise)
+  mailbox_type *mailbox() const noexcept
+  {
+    return m_mailbox.get();
+  }
+
+  /// @brief Invocation timing (nullptr unless FB_SIGNAL_PROFILING)
+  detail::slot_profile *profile() const noexcept
+  {
+#if FB_SIGNAL_PROFILING
+    return m_profile.get();
+#else
+    return nullptr;
+#endif
+  }
+
+  /// @brief Build the entry emit() iterates over
+  detail::slot_dispatch<Args...> dispatch() const noexcept
+  {
+#if FB_SIGNAL_PROFILING
+    return {m_callable.invoker(), m_callable.target(), &m_state,
+            m_delivery_policy, m_target_queue, m_profile.get()};
+#else
+    return {m_callable.invoker(), m_callable.target(), &m_state,
+            m_delivery_policy, m_target_queue};
+#endif
+  }
+
 private:
+  static constexpr uint8_t DISCONNECTED = 1; ///< State bit set by deactivate()
+  static constexpr uint8_t BLOCKED = 2;      ///< State bit set by block()
+
   static id_type generate_id() noexcept
   {
     static std::atomic<id_type> s_next_id{1};
     return s_next_id.fetch_add(1, std::memory_order_relaxed);
   }
 
+  std::atomic<uint8_t> m_state{0}; ///< DISCONNECTED | BLOCKED bits
   detail::callable_storage<Args...> m_callable;
   priority m_priority = priority::normal;
   id_type m_id = 0;
-  std::atomic<bool> m_active{true};
-  std::atomic<bool> m_blocked{false};
   delivery_policy m_delivery_policy = delivery_policy::direct;
   event_queue *m_target_queue = nullptr;
+  std::shared_ptr<std::atomic<std::size_t>> m_active_counter;
+  std::unique_ptr<mailbox_type> m_mailbox; ///< Only for queued_latest
+#if FB_SIGNAL_PROFILING
+  std::unique_ptr<detail::slot_profile> m_profile;
+#endif
 };
 
 } // namespace fb
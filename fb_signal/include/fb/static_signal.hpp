@@ -0,0 +1,347 @@
+#pragma once
+
+/// @file static_signal.hpp
+/// @brief Fixed-capacity signal with inline slot storage
+///
+/// static_signal<N, Args...> keeps up to N slots in an inline array:
+/// - No heap allocation, no reference counting, no copy-on-write
+/// - emit() is a constant-trip-count loop over the array
+/// - connect() fails (returns an invalid handle) once N slots are in use
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "detail/atomic_utils.hpp"
+#include "slot.hpp"
+
+namespace fb
+{
+
+template <std::size_t N, typename... Args>
+class static_signal;
+
+/// @brief Handle to a slot of a static_signal
+///
+/// A plain (signal, index, generation) triple: copying it costs nothing
+/// and a stale handle never affects a slot that was reused. The handle
+/// must not outlive its signal.
+template <std::size_t N, typename... Args>
+class static_connection
+{
+public:
+  static_connection() noexcept = default;
+
+  /// @brief True if connect() succeeded (the slot may since be disconnected)
+  bool valid() const noexcept
+  {
+    return m_signal != nullptr;
+  }
+
+  bool connected() const noexcept
+  {
+    return m_signal && m_signal->slot_connected(m_index, m_generation);
+  }
+
+  void disconnect() noexcept
+  {
+    if (m_signal)
+    {
+      m_signal->disconnect_slot(m_index, m_generation);
+    }
+  }
+
+  void block() noexcept
+  {
+    if (m_signal)
+    {
+      m_signal->set_blocked(m_index, m_generation, true);
+    }
+  }
+
+  void unblock() noexcept
+  {
+    if (m_signal)
+    {
+      m_signal->set_blocked(m_index, m_generation, false);
+    }
+  }
+
+  bool blocked() const noexcept
+  {
+    return m_signal && m_signal->slot_blocked(m_index, m_generation);
+  }
+
+private:
+  friend class static_signal<N, Args...>;
+
+  static_connection(static_signal<N, Args...> *owner, std::size_t index,
+                    uint32_t generation) noexcept
+      : m_signal(owner)
+      , m_index(index)
+      , m_generation(generation)
+  {
+  }
+
+  static_signal<N, Args...> *m_signal = nullptr;
+  std::size_t m_index = 0;
+  uint32_t m_generation = 0;
+};
+
+/// @brief Signal with a compile-time bound on its number of slots
+///
+/// For hot-path signals with a small, known set of subscribers. Slots live
+/// in an inline array, so emission walks N fixed entries with no pointer
+/// chasing and the optimizer can unroll the loop.
+///
+/// **Differences from fb::signal:**
+/// - At most N slots; connect() returns an invalid handle when full
+/// - Callables must fit the inline buffer (detail::SBO_SIZE bytes)
+/// - Direct delivery only, invoked in slot order (a freed slot is reused,
+///   so that is not always connection order); no priorities or filters
+/// - A slot disconnected while an emission may still be running it is
+///   reused only once that emission has finished
+///
+/// **Thread safety:** as for fb::signal. emit() is wait-free; connect,
+/// disconnect, block and unblock take a mutex and never block emission.
+///
+/// Example:
+/// @code
+/// fb::static_signal<2, std::uint64_t> on_tick;
+/// auto conn = on_tick.connect([](std::uint64_t now) { schedule(now); });
+/// on_tick.emit(clock_tick());
+/// @endcode
+template <std::size_t N, typename... Args>
+class static_signal
+{
+public:
+  static_assert(N > 0, "static_signal needs at least one slot");
+
+  using connection_type = static_connection<N, Args...>;
+
+  /// Maximum number of connected slots
+  static constexpr std::size_t CAPACITY = N;
+
+  static_signal() = default;
+
+  /// @brief Non-copyable and non-movable: handles point into the signal
+  static_signal(const static_signal &) = delete;
+  static_signal &operator=(const static_signal &) = delete;
+  static_signal(static_signal &&) = delete;
+  static_signal &operator=(static_signal &&) = delete;
+
+  ~static_signal() = default;
+
+  // =========================================================================
+  // Connection Methods
+  // =========================================================================
+
+  /// @brief Connect a callable
+  ///
+  /// @param func Callable invocable with the signal's argument types
+  /// @return Handle; invalid if all N slots are in use
+  template <typename F>
+  connection_type connect(F &&func)
+  {
+    using callable_type = std::decay_t<F>;
+    static_assert(std::is_invocable_v<callable_type, Args...>,
+                  "Callable must be invocable with signal argument types");
+    static_assert(detail::fits_in_sbo_v<callable_type, detail::SBO_SIZE>,
+                  "static_signal callables must fit the inline buffer");
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto &domain = detail::epoch_domain::instance();
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      slot &entry = m_slots[i];
+      if (entry.state.load(std::memory_order_relaxed) != 0 ||
+          (entry.retired != 0 && !domain.synchronized(entry.retired)))
+      {
+        continue;
+      }
+
+      // Any emission that saw the previous callable has finished
+      entry.callable.store(std::forward<F>(func));
+      entry.retired = 0;
+      ++entry.generation;
+      entry.state.store(ACTIVE, std::memory_order_release);
+      m_count.fetch_add(1, std::memory_order_relaxed);
+      return connection_type(this, i, entry.generation);
+    }
+    return connection_type();
+  }
+
+  /// @brief Connect a member function
+  template <typename T, typename Ret>
+  connection_type connect(T *obj, Ret (T::*member_func)(Args...))
+  {
+    return connect([obj, member_func](Args... args)
+                   { (obj->*member_func)(std::forward<Args>(args)...); });
+  }
+
+  /// @brief Connect a const member function
+  template <typename T, typename Ret>
+  connection_type connect(const T *obj, Ret (T::*member_func)(Args...) const)
+  {
+    return connect([obj, member_func](Args... args)
+                   { (obj->*member_func)(std::forward<Args>(args)...); });
+  }
+
+  // =========================================================================
+  // Emission Methods
+  // =========================================================================
+
+  /// @brief Invoke every connected, unblocked slot
+  ///
+  /// Wait-free and allocation-free: an epoch announcement, then one state
+  /// load per array entry. Slots may connect, disconnect or emit again.
+  void emit(Args... args) const
+  {
+    const detail::epoch_domain::guard section;
+
+    // Same argument policy as fb::signal::emit()
+    constexpr bool all_copyable_values =
+        ((std::is_copy_constructible_v<std::decay_t<Args>> &&
+          !std::is_reference_v<Args>) && ...);
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      const slot &entry = m_slots[i];
+      if (entry.state.load(std::memory_order_acquire) != ACTIVE)
+      {
+        continue;
+      }
+      if constexpr (all_copyable_values)
+      {
+        entry.callable.invoke(args...);
+      }
+      else
+      {
+        entry.callable.invoke(std::forward<Args>(args)...);
+      }
+    }
+  }
+
+  /// @brief Emit using function call syntax
+  void operator()(Args... args) const
+  {
+    emit(args...);
+  }
+
+  // =========================================================================
+  // Connection Management
+  // =========================================================================
+
+  /// @brief Disconnect all slots
+  void disconnect_all() noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      retire(m_slots[i]);
+    }
+  }
+
+  /// @brief Number of connected slots - O(1)
+  std::size_t slot_count() const noexcept
+  {
+    return m_count.load(std::memory_order_relaxed);
+  }
+
+  bool empty() const noexcept
+  {
+    return slot_count() == 0;
+  }
+
+  /// @brief Hot-path guard: true if emit() could invoke anything
+  bool has_slots() const noexcept
+  {
+    return !empty();
+  }
+
+  /// @brief True if every slot is connected
+  bool full() const noexcept
+  {
+    return slot_count() == N;
+  }
+
+private:
+  friend class static_connection<N, Args...>;
+
+  static constexpr uint8_t ACTIVE = 1;  ///< Connected
+  static constexpr uint8_t BLOCKED = 2; ///< Connected but blocked
+
+  struct slot
+  {
+    std::atomic<uint8_t> state{0};     ///< 0 (free), ACTIVE or ACTIVE | BLOCKED
+    uint32_t generation = 0;           ///< Bumped on every connect (m_mutex)
+    detail::epoch_domain::epoch_t retired = 0; ///< Epoch of the last disconnect (m_mutex)
+    detail::callable_storage<Args...> callable;
+  };
+
+  /// @brief Disconnect a slot (m_mutex held)
+  ///
+  /// The callable stays in place until a later connect() finds that no
+  /// emission started before the disconnect is still running.
+  void retire(slot &entry) noexcept
+  {
+    if (entry.state.load(std::memory_order_relaxed) == 0)
+    {
+      return;
+    }
+    // seq_cst pairs with emit()'s epoch announcement
+    entry.state.store(0, std::memory_order_seq_cst);
+    entry.retired = detail::epoch_domain::instance().advance();
+    m_count.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /// @brief True if @p index still holds the connection of @p generation
+  bool owns(std::size_t index, uint32_t generation) const noexcept
+  {
+    return m_slots[index].generation == generation &&
+           m_slots[index].state.load(std::memory_order_relaxed) != 0;
+  }
+
+  bool slot_connected(std::size_t index, uint32_t generation) const noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return owns(index, generation);
+  }
+
+  bool slot_blocked(std::size_t index, uint32_t generation) const noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return owns(index, generation) &&
+           (m_slots[index].state.load(std::memory_order_relaxed) & BLOCKED) != 0;
+  }
+
+  void disconnect_slot(std::size_t index, uint32_t generation) noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (owns(index, generation))
+    {
+      retire(m_slots[index]);
+    }
+  }
+
+  void set_blocked(std::size_t index, uint32_t generation, bool flag) noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (owns(index, generation))
+    {
+      m_slots[index].state.store(static_cast<uint8_t>(flag ? ACTIVE | BLOCKED : ACTIVE),
+                                 std::memory_order_release);
+    }
+  }
+
+  std::array<slot, N> m_slots{};
+  std::atomic<std::size_t> m_count{0};
+  mutable std::mutex m_mutex; ///< Serializes connect, disconnect and block
+};
+
+} // namespace fb
@@ -0,0 +1,244 @@
+/// @file broadcast_ring_test.cpp
+/// @brief Unit tests for broadcast_ring and the signal bridge
+
+#include <fb/broadcast_ring.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace fb {
+namespace test {
+
+namespace {
+
+struct tick {
+  uint32_t producer;
+  uint32_t sequence;
+  uint64_t check; ///< Derived from the other fields to detect torn reads
+};
+
+tick make_tick(uint32_t producer, uint32_t sequence) {
+  return tick{producer, sequence, (uint64_t{producer} << 32) ^ (sequence * 2654435761u)};
+}
+
+bool consistent(const tick &t) {
+  return t.check == make_tick(t.producer, t.sequence).check;
+}
+
+} // namespace
+
+// ============================================================================
+// Single-Thread Tests
+// ============================================================================
+
+TEST(BroadcastRingTest, Capacity_RoundedToPowerOfTwo) {
+  EXPECT_EQ(1024u, broadcast_ring<int>().capacity());
+  EXPECT_EQ(8u, broadcast_ring<int>(5).capacity());
+  EXPECT_EQ(2u, broadcast_ring<int>(0).capacity());
+}
+
+TEST(BroadcastRingTest, EveryReaderSeesEveryEvent) {
+  broadcast_ring<int> ring(16);
+  auto first = ring.subscribe();
+  auto second = ring.subscribe();
+
+  int value = 0;
+  EXPECT_FALSE(first.try_read(value));
+
+  for (int i = 0; i < 10; ++i) {
+    ring.publish(i);
+  }
+
+  std::vector<int> seen;
+  EXPECT_EQ(10u, first.poll([&seen](const int &v) { seen.push_back(v); }));
+  EXPECT_EQ(10u, seen.size());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, seen[static_cast<std::size_t>(i)]);
+  }
+
+  // The second cursor is independent of the first
+  EXPECT_EQ(10u, second.lag());
+  ASSERT_TRUE(second.try_read(value));
+  EXPECT_EQ(0, value);
+  EXPECT_EQ(9u, second.poll([](const int &) {}));
+  EXPECT_EQ(0u, first.lost());
+  EXPECT_EQ(0u, second.lost());
+}
+
+TEST(BroadcastRingTest, SubscribeStartsAtNextEvent) {
+  broadcast_ring<int> ring(8);
+  ring.publish(1);
+  ring.publish(2);
+
+  auto late = ring.subscribe();
+  auto replay = ring.subscribe_from_oldest();
+  ring.publish(3);
+
+  int value = 0;
+  ASSERT_TRUE(late.try_read(value));
+  EXPECT_EQ(3, value);
+  EXPECT_FALSE(late.try_read(value));
+
+  EXPECT_EQ(3u, replay.poll([](const int &) {}));
+}
+
+TEST(BroadcastRingTest, SlowReader_SkipsToOldestAndCountsLoss) {
+  broadcast_ring<int> ring(8);
+  auto slow = ring.subscribe();
+
+  for (int i = 0; i < 20; ++i) {
+    ring.publish(i);
+  }
+  EXPECT_EQ(20u, slow.lag());
+
+  std::vector<int> seen;
+  slow.poll([&seen](const int &v) { seen.push_back(v); });
+
+  EXPECT_EQ(12u, slow.lost());
+  ASSERT_EQ(8u, seen.size());
+  EXPECT_EQ(12, seen.front());
+  EXPECT_EQ(19, seen.back());
+  EXPECT_EQ(20u, slow.position());
+  EXPECT_EQ(0u, slow.lag());
+}
+
+TEST(BroadcastRingTest, PollHonoursMaxEvents) {
+  broadcast_ring<int> ring(8);
+  auto reader = ring.subscribe();
+  for (int i = 0; i < 5; ++i) {
+    ring.publish(i);
+  }
+  EXPECT_EQ(2u, reader.poll([](const int &) {}, 2));
+  EXPECT_EQ(3u, reader.lag());
+}
+
+// ============================================================================
+// Signal Bridge Tests
+// ============================================================================
+
+TEST(BroadcastRingTest, ConnectBroadcast_PublishesEachEmission) {
+  signal<const tick &> on_tick;
+  broadcast_ring<tick> ring(64);
+  auto reader = ring.subscribe();
+
+  auto bridge = connect_broadcast(on_tick, ring);
+  on_tick.emit(make_tick(1, 1));
+  on_tick.emit(make_tick(1, 2));
+  bridge.disconnect();
+  on_tick.emit(make_tick(1, 3));
+
+  std::vector<uint32_t> sequences;
+  reader.poll([&sequences](const tick &t) {
+    EXPECT_TRUE(consistent(t));
+    sequences.push_back(t.sequence);
+  });
+  EXPECT_EQ(std::vector<uint32_t>({1, 2}), sequences);
+}
+
+TEST(BroadcastRingTest, ConnectBroadcast_BuildsRecordFromArguments) {
+  struct fill {
+    int quantity;
+    double price;
+  };
+  signal<int, double> on_fill;
+  broadcast_ring<fill> ring(8);
+  auto reader = ring.subscribe();
+
+  scoped_connection bridge = connect_broadcast(on_fill, ring);
+  on_fill.emit(100, 9.5);
+
+  fill received{};
+  ASSERT_TRUE(reader.try_read(received));
+  EXPECT_EQ(100, received.quantity);
+  EXPECT_DOUBLE_EQ(9.5, received.price);
+}
+
+// ============================================================================
+// Multi-Thread Tests
+// ============================================================================
+
+TEST(BroadcastRingTest, ConcurrentProducersAndReaders_NoLossWhenRingIsLarge) {
+  constexpr uint32_t PRODUCERS = 2;
+  constexpr uint32_t EVENTS = 20000;
+  broadcast_ring<tick> ring(1 << 16); // Holds everything: no reader can lose
+
+  std::vector<broadcast_ring<tick>::reader> readers;
+  for (int i = 0; i < 3; ++i) {
+    readers.push_back(ring.subscribe());
+  }
+
+  std::atomic<int> errors{0};
+  std::vector<std::thread> consumers;
+  for (auto &reader : readers) {
+    consumers.emplace_back([&reader, &errors]() {
+      uint32_t next[PRODUCERS] = {};
+      uint32_t received = 0;
+      while (received < PRODUCERS * EVENTS) {
+        received += static_cast<uint32_t>(reader.poll([&](const tick &t) {
+          // Torn or reordered records would break these
+          if (!consistent(t) || t.producer >= PRODUCERS || t.sequence != next[t.producer]) {
+            errors.fetch_add(1);
+            return;
+          }
+          ++next[t.producer];
+        }));
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < PRODUCERS; ++p) {
+    producers.emplace_back([&ring, p]() {
+      for (uint32_t i = 0; i < EVENTS; ++i) {
+        ring.publish(make_tick(p, i));
+      }
+    });
+  }
+
+  for (auto &t : producers) {
+    t.join();
+  }
+  for (auto &t : consumers) {
+    t.join();
+  }
+  EXPECT_EQ(0, errors.load());
+  for (const auto &reader : readers) {
+    EXPECT_EQ(0u, reader.lost());
+  }
+}
+
+TEST(BroadcastRingTest, LappedReader_NeverSeesTornRecords) {
+  broadcast_ring<tick> ring(4);
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  uint64_t read = 0;
+  auto reader = ring.subscribe();
+
+  std::thread consumer([&]() {
+    while (!done.load(std::memory_order_acquire)) {
+      read += reader.poll([&torn](const tick &t) {
+        if (!consistent(t)) {
+          torn.fetch_add(1);
+        }
+      });
+    }
+  });
+
+  for (uint32_t i = 0; i < 200000; ++i) {
+    ring.publish(make_tick(i & 1, i));
+  }
+  done.store(true, std::memory_order_release);
+  consumer.join();
+  read += reader.poll([](const tick &) {});
+
+  EXPECT_EQ(0, torn.load());
+  EXPECT_EQ(200000u, read + reader.lost());
+}
+
+} // namespace test
+} // namespace fb
@@ -0,0 +1,119 @@
+/// @file coroutine_test.cpp
+/// @brief Unit tests for co_await on signals (built as C++20)
+
+#include <fb/signal.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <tuple>
+
+namespace fb {
+namespace test {
+
+static_assert(FB_SIGNAL_HAS_COROUTINES, "coroutine tests need a C++20 build");
+
+// ============================================================================
+// co_await signal.next() Tests
+// ============================================================================
+
+detached_task await_values(signal<int> &sig, int count, int &sum, bool &done) {
+  for (int i = 0; i < count; ++i) {
+    sum += co_await sig.next();
+  }
+  done = true;
+}
+
+TEST(CoroutineTest, Next_ResumesWithEmittedValue) {
+  signal<int> sig;
+  int sum = 0;
+  bool done = false;
+
+  await_values(sig, 3, sum, done);
+  EXPECT_EQ(1u, sig.slot_count());
+  EXPECT_EQ(0, sum);
+
+  sig.emit(1);
+  sig.emit(2);
+  EXPECT_FALSE(done);
+  sig.emit(4);
+  EXPECT_TRUE(done);
+  EXPECT_EQ(7, sum);
+
+  // The one-shot slot is gone; later emissions reach nobody
+  EXPECT_EQ(0u, sig.slot_count());
+  sig.emit(8);
+  EXPECT_EQ(7, sum);
+}
+
+detached_task await_pair(signal<int, const std::string &> &sig,
+                         std::tuple<int, std::string> &out) {
+  out = co_await sig.next();
+}
+
+detached_task await_void(signal<> &sig, int &wakeups) {
+  co_await sig.next();
+  ++wakeups;
+  co_await sig.next();
+  ++wakeups;
+}
+
+TEST(CoroutineTest, Next_TupleAndVoidSignals) {
+  signal<int, const std::string &> pair_sig;
+  std::tuple<int, std::string> out;
+  await_pair(pair_sig, out);
+  pair_sig.emit(3, "three");
+  EXPECT_EQ(3, std::get<0>(out));
+  EXPECT_EQ("three", std::get<1>(out));
+
+  signal<> void_sig;
+  int wakeups = 0;
+  await_void(void_sig, wakeups);
+  void_sig.emit();
+  EXPECT_EQ(1, wakeups);
+  void_sig.emit();
+  EXPECT_EQ(2, wakeups);
+}
+
+TEST(CoroutineTest, Next_OtherSlotsStillRun) {
+  signal<int> sig;
+  int direct = 0;
+  auto conn = sig.connect([&direct](int value) { direct += value; });
+
+  int sum = 0;
+  bool done = false;
+  await_values(sig, 1, sum, done);
+  sig.emit(5);
+  sig.emit(6);
+
+  EXPECT_TRUE(done);
+  EXPECT_EQ(5, sum);
+  EXPECT_EQ(11, direct);
+}
+
+detached_task await_on_queue(signal<int> &sig, event_queue &queue, int &value,
+                             std::thread::id &resumed_on) {
+  value = co_await sig.next(queue);
+  resumed_on = std::this_thread::get_id();
+}
+
+TEST(CoroutineTest, NextOnQueue_ResumesOnQueueOwner) {
+  signal<int> sig;
+  event_queue queue;
+  int value = 0;
+  std::thread::id resumed_on;
+
+  await_on_queue(sig, queue, value, resumed_on);
+  std::thread emitter([&sig]() { sig.emit(42); });
+  emitter.join();
+
+  // Emitted elsewhere, resumed here by the owner's processing
+  EXPECT_EQ(0, value);
+  EXPECT_EQ(1u, queue.process_pending());
+  EXPECT_EQ(42, value);
+  EXPECT_EQ(std::this_thread::get_id(), resumed_on);
+}
+
+} // namespace test
+} // namespace fb
@@ -0,0 +1,158 @@
+/// @file keyed_signal_test.cpp
+/// @brief Unit tests for the key-routed keyed_signal
+
+#include <fb/keyed_signal.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fb {
+namespace test {
+
+// ============================================================================
+// Routing Tests
+// ============================================================================
+
+TEST(KeyedSignalTest, Emit_InvokesOnlySlotsOfKey) {
+  keyed_signal<int, int> sig;
+  std::vector<int> calls;
+
+  auto a = sig.connect(1, [&calls](int value) { calls.push_back(100 + value); });
+  auto b = sig.connect(2, [&calls](int value) { calls.push_back(200 + value); });
+  auto c = sig.connect(1, [&calls](int value) { calls.push_back(300 + value); });
+  EXPECT_EQ(3u, sig.slot_count());
+  EXPECT_TRUE(sig.has_slots(1));
+  EXPECT_FALSE(sig.has_slots(3));
+
+  sig.emit(1, 5);
+  sig(2, 6);
+  sig.emit(3, 7); // No subscribers
+  EXPECT_EQ(calls, std::vector<int>({105, 305, 206}));
+}
+
+TEST(KeyedSignalTest, Priority_OrdersSlotsOfKey) {
+  keyed_signal<std::string> sig;
+  std::vector<int> calls;
+
+  sig.connect("quote", [&calls]() { calls.push_back(1); }, priority::low);
+  sig.connect("quote", [&calls]() { calls.push_back(2); }, priority::high);
+  sig.connect("trade", [&calls]() { calls.push_back(3); }, priority::highest);
+  sig.connect("quote", [&calls]() { calls.push_back(4); });
+
+  sig.emit("quote");
+  EXPECT_EQ(calls, std::vector<int>({2, 4, 1}));
+}
+
+TEST(KeyedSignalTest, DisconnectAndBlock) {
+  keyed_signal<int, int> sig;
+  int total = 0;
+  auto conn = sig.connect(7, [&total](int value) { total += value; });
+
+  conn.block();
+  sig.emit(7, 1);
+  EXPECT_EQ(0, total);
+  EXPECT_FALSE(sig.has_slots(7));
+
+  conn.unblock();
+  sig.emit(7, 2);
+  EXPECT_EQ(2, total);
+
+  conn.disconnect();
+  EXPECT_EQ(0u, sig.slot_count());
+  sig.emit(7, 3);
+  EXPECT_EQ(2, total);
+
+  // The key comes back with a new subscriber
+  sig.cleanup();
+  sig.connect(7, [&total](int value) { total += value * 10; });
+  sig.emit(7, 4);
+  EXPECT_EQ(42, total);
+}
+
+TEST(KeyedSignalTest, ManyKeys_EachReachesOwnSlot) {
+  keyed_signal<uint32_t, uint32_t> sig;
+  const uint32_t keys = 1000;
+  std::vector<uint32_t> received(keys, 0);
+
+  std::vector<connection> conns;
+  for (uint32_t key = 0; key < keys; ++key) {
+    conns.push_back(sig.connect(key * 7919u, [&received, key](uint32_t value) {
+      received[key] += value;
+    }));
+  }
+  for (uint32_t key = 0; key < keys; ++key) {
+    sig.emit(key * 7919u, key + 1);
+  }
+  for (uint32_t key = 0; key < keys; ++key) {
+    EXPECT_EQ(key + 1, received[key]);
+  }
+  EXPECT_FALSE(sig.has_slots(1));
+
+  for (uint32_t key = 0; key < keys; key += 2) {
+    conns[key].disconnect();
+  }
+  sig.cleanup();
+  EXPECT_EQ(keys / 2, sig.slot_count());
+  sig.emit(0, 1);
+  sig.emit(7919u, 1);
+  EXPECT_EQ(1u, received[0]);
+  EXPECT_EQ(3u, received[1]);
+}
+
+TEST(KeyedSignalTest, Destructor_DisconnectsSlots) {
+  auto token = std::make_shared<int>(0);
+  connection conn;
+  {
+    keyed_signal<int> sig;
+    conn = sig.connect(1, [token]() {});
+    EXPECT_EQ(2, token.use_count());
+  }
+  EXPECT_FALSE(conn.connected());
+}
+
+// ============================================================================
+// Concurrency Tests
+// ============================================================================
+
+TEST(KeyedSignalTest, ConcurrentEmitAndChurn) {
+  keyed_signal<int, int> sig;
+  std::atomic<int> calls{0};
+  std::atomic<bool> run{true};
+  sig.connect(0, [&calls](int) { calls.fetch_add(1, std::memory_order_relaxed); });
+
+  std::vector<std::thread> emitters;
+  for (int t = 0; t < 3; ++t) {
+    emitters.emplace_back([&]() {
+      while (run.load(std::memory_order_relaxed)) {
+        sig.emit(0, 1);
+        sig.emit(1, 1);
+      }
+    });
+  }
+
+  while (calls.load() == 0) {
+    std::this_thread::yield();
+  }
+
+  auto token = std::make_shared<std::string>("payload");
+  for (int i = 0; i < 500; ++i) {
+    auto conn = sig.connect(i % 4, [token](int) {
+      EXPECT_EQ(*token, "payload");
+    });
+    conn.disconnect();
+  }
+
+  run.store(false);
+  for (auto &thread : emitters) {
+    thread.join();
+  }
+  EXPECT_EQ(1u, sig.slot_count());
+}
+
+} // namespace test
+} // namespace fb
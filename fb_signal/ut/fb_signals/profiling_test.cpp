@@ -0,0 +1,93 @@
+/// @file profiling_test.cpp
+/// @brief Unit tests for per-slot timing (built with FB_SIGNAL_PROFILING=1)
+
+#include <fb/signal.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace fb {
+namespace test {
+
+// ============================================================================
+// Slot Timing Tests
+// ============================================================================
+
+TEST(ProfilingTest, Enabled) {
+  EXPECT_TRUE(signal<int>::profiling_enabled);
+  EXPECT_TRUE(signal<int>().slot_timings().empty());
+}
+
+TEST(ProfilingTest, SlotTimings_FindSlowSlot) {
+  signal<int> sig;
+  int total = 0;
+  auto fast = sig.connect([&total](int value) { total += value; });
+  auto slow = sig.connect([](int) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  });
+
+  for (int i = 0; i < 5; ++i) {
+    sig.emit(i);
+  }
+  EXPECT_EQ(10, total);
+
+  const std::vector<slot_timing> timings = sig.slot_timings();
+  ASSERT_EQ(2u, timings.size());
+  EXPECT_EQ(fast.id(), timings[0].connection_id);
+  EXPECT_EQ(slow.id(), timings[1].connection_id);
+
+  for (const auto &timing : timings) {
+    EXPECT_EQ(5u, timing.calls);
+    EXPECT_LE(timing.p99, timing.max);
+    EXPECT_LE(timing.max, timing.total);
+  }
+  EXPECT_GE(timings[1].total, std::chrono::milliseconds(10));
+  EXPECT_GE(timings[1].p99, std::chrono::milliseconds(1));
+  EXPECT_LT(timings[0].p99, timings[1].p99);
+}
+
+TEST(ProfilingTest, SlotTimings_CountQueuedDelivery) {
+  signal<int> sig;
+  event_queue queue;
+  int received = 0;
+  auto conn = sig.connect([&received](int value) { received += value; },
+                          delivery_policy::queued, queue);
+
+  sig.emit(3);
+  sig.emit(4);
+  ASSERT_EQ(1u, sig.slot_timings().size());
+  EXPECT_EQ(0u, sig.slot_timings()[0].calls);
+
+  EXPECT_EQ(2u, queue.process_pending());
+  EXPECT_EQ(7, received);
+  EXPECT_EQ(2u, sig.slot_timings()[0].calls);
+  EXPECT_EQ(conn.id(), sig.slot_timings()[0].connection_id);
+}
+
+TEST(ProfilingTest, ResetAndDisconnect) {
+  signal<> sig;
+  auto first = sig.connect([]() {});
+  auto second = sig.connect([]() {});
+  sig.emit();
+  sig.emit();
+
+  sig.reset_slot_timings();
+  for (const auto &timing : sig.slot_timings()) {
+    EXPECT_EQ(0u, timing.calls);
+    EXPECT_EQ(0, timing.total.count());
+    EXPECT_EQ(0, timing.p99.count());
+  }
+
+  first.disconnect();
+  sig.emit();
+  const auto timings = sig.slot_timings();
+  ASSERT_EQ(1u, timings.size());
+  EXPECT_EQ(second.id(), timings[0].connection_id);
+  EXPECT_EQ(1u, timings[0].calls);
+}
+
+} // namespace test
+} // namespace fb
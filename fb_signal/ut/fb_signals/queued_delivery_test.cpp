@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -432,6 +433,148 @@ TEST(QueuedDeliveryTest, ProcessPending_MaxEvents)
   EXPECT_EQ(10, count.load());
 }
 
+// ============================================================================
+// Coalesced (queued_latest) Delivery Tests
+// ============================================================================
+
+TEST(QueuedLatestTest, Burst_DeliversNewestValueOnce)
+{
+  signal<int> sig;
+  event_queue queue;
+  std::vector<int> received;
+
+  sig.connect(
+      [&received](int value)
+      {
+        received.push_back(value);
+      },
+      delivery_policy::queued_latest,
+      queue);
+
+  for (int i = 0; i < 10000; ++i)
+  {
+    sig.emit(i);
+  }
+
+  EXPECT_EQ(1u, queue.process_pending());
+  ASSERT_EQ(1u, received.size());
+  EXPECT_EQ(9999, received[0]);
+
+  // Once delivered, the next emission queues a new event
+  sig.emit(42);
+  EXPECT_EQ(1u, queue.process_pending());
+  EXPECT_EQ(std::vector<int>({9999, 42}), received);
+  EXPECT_EQ(0u, queue.process_pending());
+}
+
+TEST(QueuedLatestTest, MixedWithQueued_OnlyLatestSlotCoalesces)
+{
+  signal<const std::string &> sig;
+  event_queue queue;
+  std::vector<std::string> every;
+  std::vector<std::string> latest;
+
+  sig.connect(
+      [&every](const std::string &value)
+      {
+        every.push_back(value);
+      },
+      delivery_policy::queued,
+      queue);
+  sig.connect(
+      [&latest](const std::string &value)
+      {
+        latest.push_back(value);
+      },
+      delivery_policy::queued_latest,
+      queue);
+
+  sig.emit("a");
+  sig.emit("b");
+  sig.emit("c");
+  queue.process_pending();
+
+  EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), every);
+  EXPECT_EQ(std::vector<std::string>({"c"}), latest);
+}
+
+TEST(QueuedLatestTest, BlockBeforeProcessing_DropsPendingValue)
+{
+  signal<int> sig;
+  event_queue queue;
+  std::vector<int> received;
+
+  auto conn = sig.connect(
+      [&received](int value)
+      {
+        received.push_back(value);
+      },
+      delivery_policy::queued_latest,
+      queue);
+
+  sig.emit(1);
+  conn.block();
+  queue.process_pending();
+  EXPECT_TRUE(received.empty());
+
+  conn.unblock();
+  sig.emit(2);
+  queue.process_pending();
+  EXPECT_EQ(std::vector<int>({2}), received);
+}
+
+TEST(QueuedLatestTest, MultipleProducers_FinalValueDelivered)
+{
+  signal<int> sig;
+  event_queue queue;
+  std::atomic<int> calls{0};
+  std::atomic<int> last{0};
+  constexpr int num_producers = 4;
+  constexpr int emissions = 5000;
+
+  sig.connect(
+      [&](int value)
+      {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        last.store(value, std::memory_order_relaxed);
+      },
+      delivery_policy::queued_latest,
+      queue);
+
+  std::atomic<int> done{0};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < num_producers; ++p)
+  {
+    producers.emplace_back([&]()
+    {
+      for (int i = 1; i <= emissions; ++i)
+      {
+        sig.emit(i);
+      }
+      done.fetch_add(1, std::memory_order_release);
+    });
+  }
+
+  while (done.load(std::memory_order_acquire) < num_producers)
+  {
+    queue.process_pending();
+    std::this_thread::yield();
+  }
+  for (auto &producer : producers)
+  {
+    producer.join();
+  }
+  queue.process_pending();
+
+  EXPECT_GE(calls.load(), 1);
+  EXPECT_LE(calls.load(), num_producers * emissions);
+
+  // A value published after all producers finished is never lost
+  sig.emit(-1);
+  EXPECT_EQ(1u, queue.process_pending());
+  EXPECT_EQ(-1, last.load());
+}
+
 // ============================================================================
 // Priority with Queued Delivery
 // ============================================================================
@@ -480,5 +623,149 @@ TEST(QueuedDeliveryTest, PriorityOrdering_Preserved)
   EXPECT_EQ(1, order[2]);  // low
 }
 
+// ============================================================================
+// Shared Payload Tests
+// ============================================================================
+
+namespace {
+
+/// Counts copies and destructions of queued arguments
+struct counted_payload
+{
+  static int copies;
+  static int destroyed;
+
+  std::vector<int> values{1, 2, 3};
+
+  counted_payload() = default;
+  counted_payload(const counted_payload &other) : values(other.values)
+  {
+    ++copies;
+  }
+  ~counted_payload()
+  {
+    ++destroyed;
+  }
+};
+
+int counted_payload::copies    = 0;
+int counted_payload::destroyed = 0;
+
+} // namespace
+
+TEST(QueuedDeliveryTest, SharedPayload_OneCopyPerEmission)
+{
+  signal<const counted_payload &> sig;
+  event_queue first_queue;
+  event_queue second_queue;
+  std::vector<const counted_payload *> seen;
+
+  auto record = [&seen](const counted_payload &payload)
+  {
+    EXPECT_EQ(3u, payload.values.size());
+    seen.push_back(&payload);
+  };
+  sig.connect(record, delivery_policy::queued, first_queue);
+  sig.connect(record, delivery_policy::queued, first_queue);
+  sig.connect(record, delivery_policy::queued, second_queue);
+
+  const counted_payload source;
+
+  // Default: at least one copy per queued slot
+  EXPECT_FALSE(sig.shared_payload());
+  counted_payload::copies = 0;
+  sig.emit(source);
+  EXPECT_GE(counted_payload::copies, 3);
+  first_queue.process_pending();
+  second_queue.process_pending();
+  ASSERT_EQ(3u, seen.size());
+
+  // Shared: one copy, seen by every slot on every queue
+  sig.set_shared_payload(true);
+  seen.clear();
+  counted_payload::copies    = 0;
+  counted_payload::destroyed = 0;
+  sig.emit(source);
+  EXPECT_EQ(1, counted_payload::copies);
+
+  EXPECT_EQ(2u, first_queue.process_pending());
+  EXPECT_EQ(0, counted_payload::destroyed);
+  EXPECT_EQ(1u, second_queue.process_pending());
+  EXPECT_EQ(1, counted_payload::destroyed);
+
+  ASSERT_EQ(3u, seen.size());
+  EXPECT_EQ(seen[0], seen[1]);
+  EXPECT_EQ(seen[0], seen[2]);
+  EXPECT_NE(&source, seen[0]);
+}
+
+TEST(QueuedDeliveryTest, SharedPayload_DirectSlotsAndValueArgs)
+{
+  signal<int, const std::string &> sig;
+  sig.set_shared_payload(true);
+  event_queue queue;
+  std::vector<std::string> received;
+
+  sig.connect([&received](int id, const std::string &text)
+              {
+                received.push_back("direct " + std::to_string(id) + " " + text);
+              });
+  sig.connect([&received](int id, std::string text)
+              {
+                received.push_back("queued " + std::to_string(id) + " " + text);
+              },
+              delivery_policy::queued, queue);
+
+  std::string text = "tick";
+  sig.emit(1, text);
+  text = "changed";
+  sig.emit(2, text);
+  queue.process_pending();
+
+  ASSERT_EQ(4u, received.size());
+  EXPECT_EQ("direct 1 tick", received[0]);
+  EXPECT_EQ("direct 2 changed", received[1]);
+  EXPECT_EQ("queued 1 tick", received[2]);
+  EXPECT_EQ("queued 2 changed", received[3]);
+}
+
+TEST(QueuedDeliveryTest, SharedPayload_ProducerConsumer)
+{
+  signal<const std::vector<int> &> sig;
+  sig.set_shared_payload(true);
+  event_queue consumer_queue;
+  std::atomic<long> total{0};
+  std::atomic<bool> producer_done{false};
+
+  sig.connect(
+      [&total](const std::vector<int> &values)
+      {
+        total.fetch_add(values.back(), std::memory_order_relaxed);
+      },
+      delivery_policy::queued,
+      consumer_queue);
+
+  // Payloads allocated by the producer are freed by the consumer
+  std::thread producer([&]()
+  {
+    const std::vector<int> values(64, 1);
+    for (int i = 0; i < 2000; ++i)
+    {
+      sig.emit(values);
+    }
+    producer_done.store(true, std::memory_order_release);
+  });
+
+  while (!producer_done.load(std::memory_order_acquire) ||
+         !consumer_queue.empty())
+  {
+    consumer_queue.process_pending();
+    std::this_thread::yield();
+  }
+
+  producer.join();
+  EXPECT_EQ(2000, total.load());
+}
+
 } // namespace test
 } // namespace fb
@@ -0,0 +1,203 @@
+/// @file shm_signal_channel_test.cpp
+/// @brief Unit tests for the shared-memory broadcast channel
+
+#include <fb/shm_signal_channel.hpp>
+
+#include <gtest/gtest.h>
+
+#if FB_SIGNAL_HAS_SHM
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace fb {
+namespace test {
+
+namespace {
+
+struct quote {
+  uint32_t symbol;
+  uint32_t sequence;
+  double price;
+};
+
+/// Segment name unique to this test process
+std::string channel_name(const char *test) {
+  return "/fb_signal_test_" + std::string(test) + "_" + std::to_string(::getpid());
+}
+
+} // namespace
+
+// ============================================================================
+// Open and Create Tests
+// ============================================================================
+
+TEST(ShmSignalChannelTest, OpenMissingSegment_Fails) {
+  auto channel = shm_signal_channel<quote>::open(channel_name("missing"));
+  EXPECT_FALSE(channel.is_open());
+  EXPECT_EQ(ENOENT, channel.error());
+}
+
+TEST(ShmSignalChannelTest, OpenWithOtherRecordType_Fails) {
+  auto creator = shm_signal_channel<quote>::create(channel_name("mismatch"), 16);
+  ASSERT_TRUE(creator.is_open()) << creator.error();
+
+  auto other = shm_signal_channel<uint64_t>::open(channel_name("mismatch"));
+  EXPECT_FALSE(other.is_open());
+  EXPECT_EQ(EINVAL, other.error());
+}
+
+TEST(ShmSignalChannelTest, CreatorUnlinksOnDestruction) {
+  const std::string name = channel_name("unlink");
+  {
+    auto creator = shm_signal_channel<quote>::create(name, 16);
+    ASSERT_TRUE(creator.is_open()) << creator.error();
+    EXPECT_EQ(16u, creator.capacity());
+    EXPECT_TRUE(shm_signal_channel<quote>::open(name).is_open());
+  }
+  EXPECT_EQ(ENOENT, shm_signal_channel<quote>::open(name).error());
+}
+
+// ============================================================================
+// Delivery Tests
+// ============================================================================
+
+TEST(ShmSignalChannelTest, SeparateMappings_ShareRecords) {
+  const std::string name = channel_name("mappings");
+  auto publisher = shm_signal_channel<quote>::create(name, 8);
+  ASSERT_TRUE(publisher.is_open()) << publisher.error();
+  auto subscriber = shm_signal_channel<quote>::open(name);
+  ASSERT_TRUE(subscriber.is_open()) << subscriber.error();
+
+  auto reader = subscriber.subscribe();
+  for (uint32_t i = 0; i < 12; ++i) {
+    publisher.publish(quote{7, i, 100.0 + i});
+  }
+
+  // Capacity 8: the first 4 records were overwritten before being read
+  std::vector<uint32_t> sequences;
+  reader.poll([&sequences](const quote &q) {
+    EXPECT_EQ(7u, q.symbol);
+    EXPECT_DOUBLE_EQ(100.0 + q.sequence, q.price);
+    sequences.push_back(q.sequence);
+  });
+  EXPECT_EQ(4u, reader.lost());
+  ASSERT_EQ(8u, sequences.size());
+  EXPECT_EQ(4u, sequences.front());
+  EXPECT_EQ(11u, sequences.back());
+}
+
+TEST(ShmSignalChannelTest, SignalOnBothSides) {
+  const std::string name = channel_name("signals");
+  auto publisher = shm_signal_channel<quote>::create(name, 64);
+  ASSERT_TRUE(publisher.is_open()) << publisher.error();
+  auto subscriber = shm_signal_channel<quote>::open(name);
+  ASSERT_TRUE(subscriber.is_open()) << subscriber.error();
+
+  signal<const quote &> on_quote_sent;
+  auto bridge = connect_broadcast(on_quote_sent, publisher);
+
+  signal<const quote &> on_quote_received;
+  std::vector<uint32_t> received;
+  on_quote_received.connect([&received](const quote &q) { received.push_back(q.sequence); });
+
+  auto reader = subscriber.subscribe();
+  on_quote_sent.emit(quote{1, 10, 1.5});
+  on_quote_sent.emit(quote{1, 11, 1.5});
+
+  EXPECT_EQ(2u, reader.poll(on_quote_received));
+  EXPECT_EQ(std::vector<uint32_t>({10, 11}), received);
+}
+
+TEST(ShmSignalChannelTest, Wait_TimesOutAndWakesOnPublish) {
+  const std::string name = channel_name("wait");
+  auto publisher = shm_signal_channel<quote>::create(name, 64);
+  ASSERT_TRUE(publisher.is_open()) << publisher.error();
+  auto subscriber = shm_signal_channel<quote>::open(name);
+  ASSERT_TRUE(subscriber.is_open()) << subscriber.error();
+  auto reader = subscriber.subscribe();
+
+  EXPECT_FALSE(subscriber.wait(reader, std::chrono::milliseconds(5)));
+
+  std::thread producer([&publisher]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    publisher.publish(quote{2, 1, 3.0});
+  });
+  EXPECT_TRUE(subscriber.wait(reader, std::chrono::seconds(5)));
+  producer.join();
+
+  quote received{};
+  ASSERT_TRUE(reader.try_read(received));
+  EXPECT_EQ(2u, received.symbol);
+}
+
+// ============================================================================
+// Cross-Process Tests
+// ============================================================================
+
+TEST(ShmSignalChannelTest, ChildProcess_ReceivesEveryRecord) {
+  constexpr uint32_t RECORDS = 5000;
+  const std::string name = channel_name("fork");
+  auto publisher = shm_signal_channel<quote>::create(name, 8192);
+  ASSERT_TRUE(publisher.is_open()) << publisher.error();
+
+  int ready[2];
+  ASSERT_EQ(0, ::pipe(ready));
+
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // Subscriber process: exit code 0 only if every record arrived intact
+    ::close(ready[0]);
+    auto channel = shm_signal_channel<quote>::open(name);
+    if (!channel.is_open()) {
+      ::_exit(2);
+    }
+    auto reader = channel.subscribe();
+    const char byte = 1;
+    if (::write(ready[1], &byte, 1) != 1) {
+      ::_exit(3);
+    }
+
+    uint32_t expected = 0;
+    bool intact = true;
+    while (expected < RECORDS) {
+      if (!channel.wait(reader, std::chrono::seconds(5))) {
+        ::_exit(4);
+      }
+      reader.poll([&](const quote &q) {
+        intact = intact && q.sequence == expected && q.price == 0.5 * q.sequence;
+        ++expected;
+      });
+    }
+    ::_exit(intact && reader.lost() == 0 ? 0 : 5);
+  }
+
+  ::close(ready[1]);
+  char byte = 0;
+  ASSERT_EQ(1, ::read(ready[0], &byte, 1));
+  ::close(ready[0]);
+
+  signal<const quote &> on_quote;
+  auto bridge = connect_broadcast(on_quote, publisher);
+  for (uint32_t i = 0; i < RECORDS; ++i) {
+    on_quote.emit(quote{3, i, 0.5 * i});
+  }
+
+  int status = 0;
+  ASSERT_EQ(child, ::waitpid(child, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+}
+
+} // namespace test
+} // namespace fb
+
+#endif // FB_SIGNAL_HAS_SHM
@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <cstddef>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -139,6 +141,35 @@ TEST(SignalTest, Priority_SamePriority_ConnectionOrder) {
   EXPECT_EQ(3, order[2]);
 }
 
+TEST(SignalTest, Priority_InsertedInPlaceAmongDisconnectedSlots) {
+  signal<int> sig;
+  std::vector<int> order;
+  std::vector<connection> conns;
+
+  const priority levels[] = {priority::low, priority::high, priority::normal};
+  for (int i = 0; i < 30; ++i) {
+    conns.push_back(sig.connect([&order, i](int) { order.push_back(i); },
+                                levels[i % 3]));
+    // Every third connection is dropped again before the next connect
+    if (i % 3 == 2) {
+      conns[static_cast<std::size_t>(i - 1)].disconnect();
+    }
+  }
+
+  sig.emit(0);
+
+  // Survivors: priority high (i % 3 == 1) is always dropped
+  std::vector<int> expected;
+  for (int i = 2; i < 30; i += 3) {
+    expected.push_back(i); // normal
+  }
+  for (int i = 0; i < 30; i += 3) {
+    expected.push_back(i); // low
+  }
+  EXPECT_EQ(expected, order);
+  EXPECT_EQ(20u, sig.slot_count());
+}
+
 // ============================================================================
 // Disconnect Tests
 // ============================================================================
@@ -180,6 +211,51 @@ TEST(SignalTest, Cleanup_RemovesDeactivatedSlots) {
   EXPECT_EQ(2u, sig.slot_count());
 }
 
+TEST(SignalTest, HasSlots_TracksConnectAndDisconnect) {
+  signal<int> sig;
+  EXPECT_FALSE(sig.has_slots());
+
+  auto conn1 = sig.connect([](int) {});
+  auto conn2 = sig.connect([](int) {});
+  EXPECT_TRUE(sig.has_slots());
+  EXPECT_EQ(2u, sig.slot_count());
+
+  // Counted immediately, without cleanup; repeated disconnects count once
+  conn1.disconnect();
+  conn1.disconnect();
+  EXPECT_EQ(1u, sig.slot_count());
+
+  {
+    scoped_connection scoped = sig.connect([](int) {});
+    EXPECT_EQ(2u, sig.slot_count());
+  }
+  EXPECT_EQ(1u, sig.slot_count());
+
+  conn2.block();
+  EXPECT_TRUE(sig.has_slots()); // Blocked slots stay connected
+
+  conn2.disconnect();
+  EXPECT_FALSE(sig.has_slots());
+  EXPECT_TRUE(sig.empty());
+
+  sig.connect([](int) {});
+  sig.connect([](int) {});
+  sig.disconnect_all();
+  EXPECT_EQ(0u, sig.slot_count());
+}
+
+TEST(SignalTest, HasSlots_ConnectionOutlivesSignal) {
+  connection conn;
+  {
+    signal<int> sig;
+    conn = sig.connect([](int) {});
+    EXPECT_TRUE(sig.has_slots());
+  }
+  // Disconnecting after the signal is gone must not touch freed memory
+  conn.disconnect();
+  EXPECT_FALSE(conn.connected());
+}
+
 // ============================================================================
 // Filter Tests
 // ============================================================================
@@ -217,6 +293,83 @@ TEST(SignalTest, ConnectFiltered_FilterRejects_SlotNotInvoked) {
   EXPECT_EQ(2, call_count);
 }
 
+TEST(SignalTest, ConnectFiltered_CapturingLambdaFilter) {
+  signal<int, double> sig;
+  const int wanted = 7;
+  double last_price = 0.0;
+  int calls = 0;
+
+  sig.connect_filtered(
+      [&last_price, &calls](int, double price) {
+        last_price = price;
+        ++calls;
+      },
+      [wanted](const int &symbol, const double &) { return symbol == wanted; });
+
+  sig.emit(3, 1.5);
+  sig.emit(7, 2.5);
+  sig.emit(8, 3.5);
+  EXPECT_EQ(1, calls);
+  EXPECT_DOUBLE_EQ(2.5, last_price);
+}
+
+TEST(SignalTest, ConnectFiltered_StdFunctionFilter) {
+  signal<int> sig;
+  int received = 0;
+  signal<int>::filter_type filter = [](const int &value) { return value < 0; };
+
+  sig.connect_filtered([&received](int value) { received = value; }, filter);
+  sig.emit(4);
+  EXPECT_EQ(0, received);
+  sig.emit(-4);
+  EXPECT_EQ(-4, received);
+  EXPECT_TRUE(static_cast<bool>(filter)); // Copied, not moved from
+}
+
+TEST(SignalTest, ConnectFiltered_MutableFilterKeepsState) {
+  signal<int> sig;
+  std::vector<int> received;
+
+  // Throttle: pass every third emission
+  sig.connect_filtered([&received](int value) { received.push_back(value); },
+                       [n = 0](const int &) mutable { return ++n % 3 == 0; });
+
+  for (int i = 1; i <= 7; ++i) {
+    sig.emit(i);
+  }
+  EXPECT_EQ((std::vector<int>{3, 6}), received);
+}
+
+// ============================================================================
+// Dispatch Array Tests
+// ============================================================================
+
+TEST(SignalTest, StateChanges_SeenThroughRebuiltDispatchArrays) {
+  signal<int> sig;
+  std::vector<int> calls;
+
+  auto first = sig.connect([&calls](int) { calls.push_back(1); });
+  // Each connect rebuilds the dispatch array; the first slot's entry must
+  // still follow its state
+  auto second = sig.connect([&calls](int) { calls.push_back(2); });
+  char padding[128] = {};
+  auto heap = sig.connect([&calls, padding](int) {
+    calls.push_back(3 + padding[0]);
+  });
+
+  first.block();
+  sig.emit(0);
+  EXPECT_EQ(calls, std::vector<int>({2, 3}));
+
+  first.unblock();
+  heap.disconnect();
+  calls.clear();
+  sig.emit(0);
+  EXPECT_EQ(calls, std::vector<int>({1, 2}));
+
+  EXPECT_EQ(alignof(slot_entry<int>), detail::CACHE_LINE_SIZE);
+}
+
 // ============================================================================
 // Large Argument Tests
 // ============================================================================
@@ -393,5 +546,58 @@ TEST(SignalTest, MultipleSlots_LargeString_AllReceiveFullContent) {
   EXPECT_EQ(10000u, received_sizes[2]);
 }
 
+// ============================================================================
+// Slot Memory
+// ============================================================================
+
+namespace {
+
+/// @brief Heap-backed resource counting what is drawn from it
+class counting_resource : public std::pmr::memory_resource {
+public:
+  std::size_t live = 0;
+  std::size_t total = 0;
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++live;
+    ++total;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *memory, std::size_t bytes,
+                     std::size_t alignment) override {
+    --live;
+    std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+} // namespace
+
+TEST(SignalTest, MemoryResource_SlotEntriesComeFromIt) {
+  counting_resource resource;
+  {
+    signal<int> sig(&resource);
+    int sum = 0;
+    auto first = sig.connect([&sum](int v) { sum += v; });
+    sig.connect([&sum](int v) { sum += 2 * v; });
+    EXPECT_EQ(2u, resource.live);
+
+    sig.emit(1);
+    EXPECT_EQ(3, sum);
+
+    first.disconnect();
+    sig.emit(1);
+    EXPECT_EQ(5, sum);
+  }
+  EXPECT_EQ(2u, resource.total);
+  EXPECT_EQ(0u, resource.live);
+}
+
 } // namespace test
 } // namespace fb
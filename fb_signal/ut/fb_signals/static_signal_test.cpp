@@ -0,0 +1,168 @@
+/// @file static_signal_test.cpp
+/// @brief Unit tests for the fixed-capacity static_signal
+
+#include <fb/static_signal.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fb {
+namespace test {
+
+// ============================================================================
+// Basic Tests
+// ============================================================================
+
+TEST(StaticSignalTest, Connect_InvokesInSlotOrder) {
+  static_signal<4, int> sig;
+  std::vector<int> calls;
+
+  EXPECT_TRUE(sig.empty());
+  auto first = sig.connect([&calls](int value) { calls.push_back(value); });
+  auto second = sig.connect([&calls](int value) { calls.push_back(value * 10); });
+  EXPECT_TRUE(first.valid());
+  EXPECT_TRUE(second.valid());
+  EXPECT_EQ(2u, sig.slot_count());
+
+  sig.emit(3);
+  sig(4);
+  EXPECT_EQ(calls, std::vector<int>({3, 30, 4, 40}));
+}
+
+TEST(StaticSignalTest, Connect_FullSignal_ReturnsInvalidHandle) {
+  static_signal<2, int> sig;
+  auto a = sig.connect([](int) {});
+  auto b = sig.connect([](int) {});
+  EXPECT_TRUE(sig.full());
+
+  auto c = sig.connect([](int) {});
+  EXPECT_FALSE(c.valid());
+  EXPECT_FALSE(c.connected());
+  c.disconnect(); // No-op on an invalid handle
+
+  a.disconnect();
+  EXPECT_FALSE(sig.full());
+  auto d = sig.connect([](int) {});
+  EXPECT_TRUE(d.valid());
+  EXPECT_TRUE(b.connected());
+}
+
+TEST(StaticSignalTest, BlockUnblockDisconnect) {
+  static_signal<2, int> sig;
+  int count = 0;
+  auto conn = sig.connect([&count](int) { ++count; });
+
+  conn.block();
+  EXPECT_TRUE(conn.blocked());
+  sig.emit(0);
+  EXPECT_EQ(0, count);
+
+  conn.unblock();
+  sig.emit(0);
+  EXPECT_EQ(1, count);
+
+  conn.disconnect();
+  EXPECT_FALSE(conn.connected());
+  EXPECT_TRUE(sig.empty());
+  sig.emit(0);
+  EXPECT_EQ(1, count);
+}
+
+TEST(StaticSignalTest, StaleHandle_DoesNotAffectReusedSlot) {
+  static_signal<1, int> sig;
+  int count = 0;
+
+  auto old_conn = sig.connect([](int) {});
+  old_conn.disconnect();
+  auto new_conn = sig.connect([&count](int) { ++count; });
+  ASSERT_TRUE(new_conn.valid());
+
+  old_conn.disconnect();
+  old_conn.block();
+  EXPECT_FALSE(old_conn.connected());
+  EXPECT_TRUE(new_conn.connected());
+  sig.emit(0);
+  EXPECT_EQ(1, count);
+}
+
+TEST(StaticSignalTest, MemberFunction_Works) {
+  struct counter {
+    int total = 0;
+    void add(int value) { total += value; }
+  };
+  counter target;
+  static_signal<1, int> sig;
+  sig.connect(&target, &counter::add);
+  sig.emit(5);
+  sig.emit(6);
+  EXPECT_EQ(11, target.total);
+}
+
+TEST(StaticSignalTest, MoveOnlyArgument_Works) {
+  static_signal<1, std::unique_ptr<int>> sig;
+  int received = 0;
+  sig.connect([&received](std::unique_ptr<int> value) { received = *value; });
+  sig.emit(std::make_unique<int>(7));
+  EXPECT_EQ(7, received);
+}
+
+// ============================================================================
+// Reentrancy and Concurrency Tests
+// ============================================================================
+
+TEST(StaticSignalTest, DisconnectDuringEmission_DefersSlotReuse) {
+  static_signal<1, int> sig;
+  auto token = std::make_shared<int>(0);
+  static_connection<1, int> self;
+  bool reconnected = true;
+
+  self = sig.connect([&, token](int) {
+    self.disconnect();
+    // The running callable still occupies the only slot
+    reconnected = sig.connect([](int) {}).valid();
+  });
+  sig.emit(0);
+  EXPECT_FALSE(reconnected);
+
+  // Once the emission is over the slot can be reused, destroying the old callable
+  EXPECT_TRUE(sig.connect([](int) {}).valid());
+  EXPECT_EQ(1, token.use_count());
+}
+
+TEST(StaticSignalTest, ConcurrentEmitAndChurn) {
+  static_signal<4, int> sig;
+  std::atomic<int> calls{0};
+  std::atomic<bool> run{true};
+  sig.connect([&calls](int) { calls.fetch_add(1, std::memory_order_relaxed); });
+
+  std::vector<std::thread> emitters;
+  for (int t = 0; t < 3; ++t) {
+    emitters.emplace_back([&]() {
+      while (run.load(std::memory_order_relaxed)) {
+        sig.emit(1);
+      }
+    });
+  }
+
+  auto token = std::make_shared<std::string>("payload");
+  for (int i = 0; i < 2000; ++i) {
+    auto conn = sig.connect([token](int) {
+      EXPECT_EQ(*token, "payload");
+    });
+    conn.disconnect();
+  }
+
+  run.store(false);
+  for (auto &thread : emitters) {
+    thread.join();
+  }
+  EXPECT_EQ(1u, sig.slot_count());
+}
+
+} // namespace test
+} // namespace fb
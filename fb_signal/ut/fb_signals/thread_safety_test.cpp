@@ -6,8 +6,14 @@
 
 #include <gtest/gtest.h>
 
+#include <poll.h>
+
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -195,6 +201,70 @@ TEST(ThreadSafetyTest, ConcurrentConnectDisconnect) {
   EXPECT_GT(connect_count.load(), 0);
 }
 
+// ============================================================================
+// Snapshot Reclamation Tests
+// ============================================================================
+
+TEST(ThreadSafetyTest, ChurnWhileEmitting_ReclaimsReplacedLists) {
+  signal<int> sig;
+  auto token = std::make_shared<int>(0);
+  std::atomic<bool> run{true};
+  std::atomic<int> calls{0};
+
+  sig.connect([token, &calls](int) { calls.fetch_add(1); });
+
+  std::vector<std::thread> emitters;
+  for (int t = 0; t < 4; ++t) {
+    emitters.emplace_back([&]() {
+      while (run.load(std::memory_order_relaxed)) {
+        sig.emit(1);
+      }
+    });
+  }
+
+  while (calls.load() == 0) {
+    std::this_thread::yield();
+  }
+
+  // Every connect and disconnect replaces the list the emitters iterate
+  for (int i = 0; i < 2000; ++i) {
+    auto conn = sig.connect([token](int) {});
+    conn.disconnect();
+  }
+
+  run.store(false);
+  for (auto &thread : emitters) {
+    thread.join();
+  }
+
+  // With no emission in flight, every retired list and slot is freed
+  sig.disconnect_all();
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST(ThreadSafetyTest, ModifyFromSlot_KeepsSnapshotAlive) {
+  signal<int> sig;
+  auto token = std::make_shared<int>(0);
+  std::vector<int> order;
+
+  sig.connect([&](int) {
+    order.push_back(1);
+    // Replaces the list this emission is iterating
+    sig.disconnect_all();
+    sig.connect([token, &order](int) { order.push_back(3); });
+  });
+  sig.connect([&order](int) { order.push_back(2); });
+
+  sig.emit(0);
+  EXPECT_EQ(order, std::vector<int>({1}));
+
+  sig.emit(0);
+  EXPECT_EQ(order, std::vector<int>({1, 3}));
+
+  sig.disconnect_all();
+  EXPECT_EQ(token.use_count(), 1);
+}
+
 // ============================================================================
 // Event Queue Tests
 // ============================================================================
@@ -273,6 +343,438 @@ TEST(EventQueueTest, ProcessPending_MaxEvents) {
   EXPECT_EQ(10, count);
 }
 
+TEST(EventQueueTest, LargeCallable_StoredInline) {
+  event_queue queue;
+  std::array<char, 4096> payload{};
+  payload.fill('x');
+  payload.back() = 'y';
+  std::size_t seen = 0;
+
+  ASSERT_TRUE(queue.enqueue([payload, &seen]() {
+    seen = static_cast<std::size_t>(payload.back() == 'y') + payload.size();
+  }));
+  queue.process_pending();
+  EXPECT_EQ(4097u, seen);
+}
+
+TEST(EventQueueTest, MixedSizes_WrapAroundKeepsFifo) {
+  event_queue queue;
+  std::vector<int> order;
+  int next = 0;
+
+  // Many laps of the ring with records of different sizes
+  for (int round = 0; round < 64; ++round) {
+    std::vector<int> expected;
+    for (int i = 0; i < 100; ++i, ++next) {
+      if (i % 3 == 0) {
+        std::array<char, 1000> pad{};
+        pad[0] = 1;
+        ASSERT_TRUE(queue.enqueue(
+            [&order, pad, n = next]() { order.push_back(n * pad[0]); }));
+      } else {
+        ASSERT_TRUE(queue.enqueue([&order, n = next]() { order.push_back(n); }));
+      }
+      expected.push_back(next);
+    }
+    EXPECT_EQ(100u, queue.pending_count());
+    order.clear();
+    EXPECT_EQ(100u, queue.process_pending());
+    ASSERT_EQ(expected, order);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(EventQueueTest, Full_DropsUntilSpaceIsReleased) {
+  event_queue queue;
+  std::array<char, 1024> pad{};
+  int accepted = 0;
+  int count = 0;
+
+  while (queue.enqueue([pad, &count]() { count += 1 + pad[0]; })) {
+    ++accepted;
+  }
+  EXPECT_EQ(1u, queue.dropped_count());
+  EXPECT_GT(accepted, 200);
+  EXPECT_LE(static_cast<std::size_t>(accepted) * sizeof(pad),
+            event_queue::DEFAULT_CAPACITY);
+
+  EXPECT_EQ(static_cast<std::size_t>(accepted), queue.process_pending());
+  EXPECT_EQ(accepted, count);
+  EXPECT_TRUE(queue.enqueue([]() {}));
+}
+
+TEST(EventQueueTest, RuntimeCapacity_RoundedToPowerOfTwo) {
+  EXPECT_EQ(event_queue::DEFAULT_CAPACITY, event_queue().capacity());
+  EXPECT_EQ(event_queue::LANE_CAPACITY, event_queue(queue_mode::producer_lanes).capacity());
+  EXPECT_EQ(event_queue::MIN_CAPACITY, event_queue(std::size_t{1000}).capacity());
+  EXPECT_EQ(std::size_t{256 * 1024},
+            event_queue(std::size_t{128 * 1024 + 1}, queue_mode::producer_lanes).capacity());
+
+  std::array<char, 1024> pad{};
+  for (std::size_t requested : {std::size_t{100 * 1024}, std::size_t{3 * 1024 * 1024}}) {
+    for (queue_mode mode : {queue_mode::shared_ring, queue_mode::producer_lanes}) {
+      event_queue queue(requested, mode);
+      const std::size_t capacity = queue.capacity();
+      EXPECT_GE(capacity, requested);
+      EXPECT_EQ(0u, capacity & (capacity - 1));
+
+      std::size_t accepted = 0;
+      while (queue.enqueue([pad]() {})) {
+        ++accepted;
+      }
+      // Each record: 16-byte header plus the 1024-byte capture
+      EXPECT_LE(accepted * (16 + sizeof(pad)), capacity);
+      EXPECT_GT(accepted * (16 + sizeof(pad)) * 2, capacity);
+      EXPECT_EQ(accepted, queue.process_pending());
+    }
+  }
+}
+
+TEST(EventQueueTest, Destructor_DestroysUnprocessedEvents) {
+  auto token = std::make_shared<int>(0);
+  {
+    event_queue queue;
+    queue.enqueue([token]() {});
+    queue.enqueue([token]() {});
+    EXPECT_EQ(3, token.use_count());
+  }
+  EXPECT_EQ(1, token.use_count());
+}
+
+TEST(EventQueueTest, MultiProducer_VariableSizes_ConcurrentConsumer) {
+  event_queue queue;
+  constexpr int NUM_PRODUCERS = 3;
+  constexpr int EVENTS_PER_PRODUCER = 20000;
+  std::atomic<int> accepted{0};
+  std::atomic<int> done{0};
+  long long sum = 0;
+  std::atomic<long long> expected{0};
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < NUM_PRODUCERS; ++p) {
+    producers.emplace_back([&, p]() {
+      for (int i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+        const long long value = i + 1;
+        bool ok = false;
+        if ((i + p) % 4 == 0) {
+          std::array<long long, 40> blob{};
+          blob[39] = value;
+          ok = queue.enqueue([&sum, blob]() { sum += blob[39]; });
+        } else {
+          ok = queue.enqueue([&sum, value]() { sum += value; });
+        }
+        if (ok) {
+          accepted.fetch_add(1, std::memory_order_relaxed);
+          expected.fetch_add(value, std::memory_order_relaxed);
+        }
+      }
+      done.fetch_add(1, std::memory_order_release);
+    });
+  }
+
+  std::size_t processed = 0;
+  while (done.load(std::memory_order_acquire) < NUM_PRODUCERS) {
+    processed += queue.process_pending();
+  }
+  for (auto &t : producers) {
+    t.join();
+  }
+  processed += queue.process_pending();
+
+  EXPECT_EQ(static_cast<std::size_t>(accepted.load()), processed);
+  EXPECT_EQ(expected.load(), sum);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(EventQueueTest, ProducerLanes_PerProducerFifo) {
+  event_queue queue(queue_mode::producer_lanes);
+  EXPECT_EQ(queue_mode::producer_lanes, queue.mode());
+
+  constexpr int NUM_PRODUCERS = 4;
+  constexpr int EVENTS_PER_PRODUCER = 20000;
+  std::vector<std::vector<int>> received(NUM_PRODUCERS);
+  std::atomic<int> accepted{0};
+  std::atomic<int> done{0};
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < NUM_PRODUCERS; ++p) {
+    producers.emplace_back([&, p]() {
+      for (int i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+        if (queue.enqueue([&received, p, i]() { received[p].push_back(i); })) {
+          accepted.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      done.fetch_add(1, std::memory_order_release);
+    });
+  }
+
+  std::size_t processed = 0;
+  while (done.load(std::memory_order_acquire) < NUM_PRODUCERS) {
+    processed += queue.process_pending();
+  }
+  for (auto &t : producers) {
+    t.join();
+  }
+  processed += queue.process_pending();
+
+  EXPECT_EQ(static_cast<std::size_t>(accepted.load()), processed);
+  EXPECT_EQ(static_cast<uint64_t>(NUM_PRODUCERS * EVENTS_PER_PRODUCER - accepted.load()),
+            queue.dropped_count());
+  for (const auto &events : received) {
+    for (std::size_t i = 1; i < events.size(); ++i) {
+      ASSERT_LT(events[i - 1], events[i]);
+    }
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(EventQueueTest, ProducerLanes_DrainedRoundRobin) {
+  event_queue queue(queue_mode::producer_lanes);
+  std::vector<int> order;
+
+  // Fill two lanes, then drain them from this thread. Both producers stay
+  // alive until both are done, so they cannot share a reused thread ID.
+  std::atomic<int> filled{0};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < 2; ++p) {
+    producers.emplace_back([&queue, &order, &filled, p]() {
+      for (int i = 0; i < 100; ++i) {
+        queue.enqueue([&order, p]() { order.push_back(p); });
+      }
+      filled.fetch_add(1);
+      while (filled.load() < 2) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (auto &t : producers) {
+    t.join();
+  }
+  EXPECT_EQ(200u, queue.pending_count());
+
+  // The first pass takes at most LANE_BATCH events from each lane
+  EXPECT_EQ(2 * event_queue::LANE_BATCH, queue.process_pending(2 * event_queue::LANE_BATCH));
+  EXPECT_EQ(event_queue::LANE_BATCH,
+            static_cast<std::size_t>(std::count(order.begin(), order.end(), 0)));
+
+  EXPECT_EQ(200u - 2 * event_queue::LANE_BATCH, queue.process_pending());
+  EXPECT_EQ(100, std::count(order.begin(), order.end(), 1));
+}
+
+TEST(EventQueueTest, ProducerLanes_SignalDelivery) {
+  signal<int> sig;
+  event_queue queue(queue_mode::producer_lanes);
+  std::atomic<int> sum{0};
+
+  sig.connect([&sum](int value) { sum.fetch_add(value, std::memory_order_relaxed); },
+              delivery_policy::queued, queue);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < 3; ++p) {
+    producers.emplace_back([&sig]() {
+      for (int i = 1; i <= 100; ++i) {
+        sig.emit(i);
+      }
+    });
+  }
+  for (auto &t : producers) {
+    t.join();
+  }
+  EXPECT_EQ(300u, queue.process_pending());
+  EXPECT_EQ(3 * 5050, sum.load());
+}
+
+TEST(EventQueueTest, WaitAndProcess_TimesOutWhenIdle) {
+  event_queue queue;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(0u, queue.wait_and_process(std::chrono::milliseconds(20)));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(15));
+}
+
+TEST(EventQueueTest, WaitAndProcess_WakesOnEnqueue) {
+  for (queue_mode mode : {queue_mode::shared_ring, queue_mode::producer_lanes}) {
+    event_queue queue(mode);
+    int value = 0;
+
+    std::thread producer([&queue, &value]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      queue.enqueue([&value]() { value = 7; });
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t processed = 0;
+    while (processed == 0) {
+      processed = queue.wait_and_process(std::chrono::seconds(5));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    producer.join();
+    EXPECT_EQ(1u, processed);
+    EXPECT_EQ(7, value);
+  }
+}
+
+TEST(EventQueueTest, NotificationFd_ReadableWhilePending) {
+  event_queue queue;
+  const int fd = queue.notification_fd();
+  ASSERT_GE(fd, 0);
+  EXPECT_EQ(fd, queue.notification_fd());
+
+  auto readable = [fd]() {
+    pollfd entry{fd, POLLIN, 0};
+    return ::poll(&entry, 1, 0) == 1 && (entry.revents & POLLIN) != 0;
+  };
+
+  // Starts readable, so events enqueued before registration are not missed
+  EXPECT_TRUE(readable());
+  EXPECT_EQ(0u, queue.process_pending());
+  EXPECT_FALSE(readable());
+
+  int count = 0;
+  std::thread([&queue, &count]() {
+    for (int i = 0; i < 5; ++i) {
+      queue.enqueue([&count]() { ++count; });
+    }
+  }).join();
+  EXPECT_TRUE(readable());
+
+  // A partial drain leaves the descriptor readable for the rest
+  EXPECT_EQ(2u, queue.process_pending(2));
+  EXPECT_TRUE(readable());
+  EXPECT_EQ(3u, queue.process_pending());
+  EXPECT_FALSE(readable());
+  EXPECT_EQ(5, count);
+}
+
+TEST(EventQueueTest, OverflowBlock_WaitsForConsumer) {
+  event_queue queue(queue_mode::shared_ring, overflow_policy::block,
+                    std::chrono::seconds(5));
+  EXPECT_EQ(overflow_policy::block, queue.overflow());
+  std::array<char, 1024> pad{};
+  int count = 0;
+
+  // The owner cannot wait on itself: it drops at once
+  while (queue.enqueue([pad, &count]() { count += 1 + pad[0]; })) {
+  }
+  EXPECT_EQ(1u, queue.dropped_count());
+  EXPECT_EQ(0u, queue.blocked_count());
+  const std::size_t accepted = queue.pending_count();
+
+  std::atomic<bool> stored{false};
+  std::thread producer([&]() {
+    stored = queue.enqueue([pad, &count]() { count += 1 + pad[0]; });
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(stored.load());
+
+  EXPECT_EQ(accepted, queue.process_pending());
+  producer.join();
+  EXPECT_TRUE(stored.load());
+  EXPECT_EQ(1u, queue.blocked_count());
+  EXPECT_EQ(1u, queue.dropped_count());
+  EXPECT_EQ(1u, queue.process_pending());
+  EXPECT_EQ(static_cast<int>(accepted) + 1, count);
+}
+
+TEST(EventQueueTest, OverflowBlock_DropsOnTimeout) {
+  event_queue queue(queue_mode::shared_ring, overflow_policy::block,
+                    std::chrono::milliseconds(10));
+  std::array<char, 1024> pad{};
+  while (queue.enqueue([pad]() {})) {
+  }
+
+  std::thread([&queue, pad]() {
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.enqueue([pad]() {}));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(8));
+  }).join();
+  EXPECT_EQ(1u, queue.blocked_count());
+  EXPECT_EQ(2u, queue.dropped_count());
+}
+
+TEST(EventQueueTest, OverflowSpill_NeverDropsAndKeepsFifo) {
+  for (queue_mode mode : {queue_mode::shared_ring, queue_mode::producer_lanes}) {
+    event_queue queue(mode, overflow_policy::spill);
+    std::array<char, 1024> pad{};
+    std::vector<int> order;
+
+    const int total = 600; // More than either ring holds
+    for (int i = 0; i < total; ++i) {
+      EXPECT_TRUE(queue.enqueue([pad, i, &order]() { order.push_back(i + pad[0]); }));
+    }
+    EXPECT_EQ(0u, queue.dropped_count());
+    EXPECT_GT(queue.spilled_count(), 0u);
+    EXPECT_EQ(queue.spilled_count(), queue.spill_high_water());
+    EXPECT_EQ(static_cast<std::size_t>(total), queue.pending_count());
+
+    // Partial drains keep the order across the ring and the spill list
+    EXPECT_EQ(100u, queue.process_pending(100));
+    EXPECT_EQ(static_cast<std::size_t>(total - 100), queue.process_pending());
+    ASSERT_EQ(static_cast<std::size_t>(total), order.size());
+    for (int i = 0; i < total; ++i) {
+      EXPECT_EQ(i, order[static_cast<std::size_t>(i)]);
+    }
+
+    // With the backlog gone, events use the ring again
+    const uint64_t spilled = queue.spilled_count();
+    EXPECT_TRUE(queue.enqueue([]() {}));
+    EXPECT_EQ(spilled, queue.spilled_count());
+    EXPECT_EQ(1u, queue.process_pending());
+  }
+}
+
+TEST(EventQueueTest, OverflowSpill_DestructorDestroysSpilledEvents) {
+  auto token = std::make_shared<int>(0);
+  {
+    event_queue queue(queue_mode::shared_ring, overflow_policy::spill);
+    std::array<char, 1024> pad{};
+    while (queue.spilled_count() < 3) {
+      queue.enqueue([pad, token]() {});
+    }
+    EXPECT_GT(token.use_count(), 3);
+  }
+  EXPECT_EQ(1, token.use_count());
+}
+
+TEST(EventQueueTest, OverflowOverwrite_KeepsNewestEvents) {
+  for (queue_mode mode : {queue_mode::shared_ring, queue_mode::producer_lanes}) {
+    event_queue queue(mode, overflow_policy::overwrite_oldest);
+    std::array<char, 1024> pad{};
+    std::vector<int> order;
+
+    const int total = 600;
+    for (int i = 0; i < total; ++i) {
+      EXPECT_TRUE(queue.enqueue([pad, i, &order]() { order.push_back(i + pad[0]); }));
+    }
+    EXPECT_EQ(0u, queue.dropped_count());
+    const std::size_t kept = queue.pending_count();
+    EXPECT_EQ(static_cast<uint64_t>(total) - kept, queue.overwritten_count());
+
+    EXPECT_EQ(kept, queue.process_pending());
+    ASSERT_EQ(kept, order.size());
+    for (std::size_t i = 0; i < kept; ++i) {
+      EXPECT_EQ(static_cast<int>(static_cast<std::size_t>(total) - kept + i), order[i]);
+    }
+  }
+}
+
+TEST(EventQueueTest, OverflowOverwrite_HandlerDropsInsteadOfOverwriting) {
+  event_queue queue(queue_mode::shared_ring, overflow_policy::overwrite_oldest);
+  std::array<char, 1024> pad{};
+  int accepted = 0;
+
+  // Filling its own queue from a handler: nothing to overwrite but itself
+  queue.enqueue([&queue, &accepted, pad]() {
+    while (queue.enqueue([pad]() {})) {
+      ++accepted;
+    }
+  });
+  EXPECT_EQ(1u, queue.process_pending(1));
+  EXPECT_GT(accepted, 200);
+  EXPECT_EQ(1u, queue.dropped_count());
+  EXPECT_EQ(0u, queue.overwritten_count());
+  EXPECT_EQ(static_cast<std::size_t>(accepted), queue.process_pending());
+}
+
 TEST(EventQueueTest, ThreadLocalQueue_Access) {
   auto &queue1 = thread_event_queue();
   auto &queue2 = thread_event_queue();
@@ -331,5 +833,156 @@ TEST(ThreadSafetyTest, BlockUnblock_WhileEmitting) {
   EXPECT_GT(call_count.load(), 0);
 }
 
+// ============================================================================
+// Parallel Emission Tests
+// ============================================================================
+
+/// Runs every task on a thread of its own, joined on destruction
+class thread_per_task_executor {
+public:
+  ~thread_per_task_executor() { join(); }
+
+  template <typename F>
+  void submit(F &&task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads.emplace_back(std::forward<F>(task));
+  }
+
+  void join() {
+    // Tasks may submit more tasks (the next priority band) while joining
+    for (;;) {
+      std::vector<std::thread> threads;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        threads.swap(m_threads);
+      }
+      if (threads.empty()) {
+        return;
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<std::thread> m_threads;
+};
+
+/// Runs each task on the submitting thread
+struct inline_executor {
+  template <typename F>
+  void submit(F &&task) { task(); }
+};
+
+TEST(ThreadSafetyTest, EmitParallel_SlotsOfOneBandRunConcurrently) {
+  signal<int> sig;
+  constexpr int NUM_SLOTS = 4;
+  std::atomic<int> inside{0};
+  std::atomic<int> overlapped{0};
+  std::atomic<int> total{0};
+
+  std::vector<scoped_connection> conns;
+  for (int i = 0; i < NUM_SLOTS; ++i) {
+    conns.emplace_back(sig.connect([&](int value) {
+      inside.fetch_add(1);
+      // Every slot waits until all of them are running at once
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (inside.load() < NUM_SLOTS && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+      }
+      if (inside.load() == NUM_SLOTS) {
+        overlapped.fetch_add(1);
+      }
+      total.fetch_add(value);
+    }));
+  }
+
+  thread_per_task_executor executor;
+  sig.emit_parallel(executor, 5);
+
+  // emit_parallel() returned after every slot
+  EXPECT_EQ(NUM_SLOTS * 5, total.load());
+  EXPECT_EQ(NUM_SLOTS, overlapped.load());
+}
+
+TEST(ThreadSafetyTest, EmitParallel_PriorityBandsRunInOrder) {
+  signal<> sig;
+  std::atomic<int> high_done{0};
+  std::atomic<int> normal_done{0};
+  std::atomic<int> order_errors{0};
+
+  auto low = sig.connect([&]() {
+    if (high_done.load() != 2 || normal_done.load() != 2) {
+      order_errors.fetch_add(1);
+    }
+  }, priority::low);
+  auto normal_a = sig.connect([&]() {
+    if (high_done.load() != 2) {
+      order_errors.fetch_add(1);
+    }
+    normal_done.fetch_add(1);
+  });
+  auto high_a = sig.connect([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    high_done.fetch_add(1);
+  }, priority::high);
+  auto normal_b = sig.connect([&]() {
+    if (high_done.load() != 2) {
+      order_errors.fetch_add(1);
+    }
+    normal_done.fetch_add(1);
+  });
+  auto high_b = sig.connect([&]() { high_done.fetch_add(1); }, priority::high);
+
+  thread_per_task_executor executor;
+  for (int i = 0; i < 20; ++i) {
+    high_done = 0;
+    normal_done = 0;
+    sig.emit_parallel(executor);
+  }
+  EXPECT_EQ(0, order_errors.load());
+}
+
+TEST(ThreadSafetyTest, EmitParallel_InlineExecutorMatchesEmitOrder) {
+  signal<int> sig;
+  std::vector<int> order;
+  auto a = sig.connect([&order](int) { order.push_back(1); });
+  auto b = sig.connect([&order](int) { order.push_back(0); }, priority::high);
+  auto c = sig.connect([&order](int) { order.push_back(2); });
+  auto blocked = sig.connect([&order](int) { order.push_back(9); });
+  blocked.block();
+
+  inline_executor executor;
+  sig.emit_parallel(executor, 1);
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), order);
+
+  // No slots: returns without touching the executor
+  signal<int> empty;
+  empty.emit_parallel(executor, 1);
+}
+
+TEST(ThreadSafetyTest, EmitParallel_QueuedSlotsArePosted) {
+  signal<int> sig;
+  event_queue queue;
+  std::atomic<int> direct{0};
+  int queued = 0;
+
+  auto direct_conn = sig.connect([&direct](int value) { direct.fetch_add(value); });
+  auto queued_conn = sig.connect([&queued](int value) { queued += value; },
+                                 delivery_policy::queued, queue);
+
+  thread_per_task_executor executor;
+  sig.emit_parallel_async(executor, 3);
+  executor.join();
+  EXPECT_EQ(3, direct.load());
+
+  // The queued slot waits for its queue, on this thread
+  EXPECT_EQ(0, queued);
+  EXPECT_EQ(1u, queue.process_pending());
+  EXPECT_EQ(3, queued);
+}
+
 } // namespace test
 } // namespace fb
@@ -0,0 +1,42 @@
+/// @file allocation_counter.cpp
+/// @brief Replacement global operator new and delete that count allocations
+/// @note Kept out of the benchmark translation unit so that the replacements
+///       are never inlined next to the new-expressions they serve.
+
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<std::uint64_t> g_allocations{0};
+
+} // namespace
+
+std::uint64_t allocation_count() noexcept
+{
+  return g_allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
@@ -0,0 +1,9 @@
+/// @file allocation_counter.h
+/// @brief Count of global operator new calls, for allocs_per_op
+
+#pragma once
+
+#include <cstdint>
+
+/// @brief Number of operator new calls since the program started
+std::uint64_t allocation_count() noexcept;
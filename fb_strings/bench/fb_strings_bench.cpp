@@ -0,0 +1,660 @@
+/// @file fb_strings_bench.cpp
+/// @brief Micro-benchmarks for fb_strings against the standard library
+/// @note Reports nanoseconds per operation, heap allocations per operation
+///       and, for byte-oriented kernels, GB/s. Run with --format=json to get
+///       one JSON object per result line for comparison across builds.
+
+#include "allocation_counter.h"
+
+#include <fb/encoding.h>
+#include <fb/format.h>
+#include <fb/simd_search.h>
+#include <fb/string_builder.h>
+#include <fb/string_hash.h>
+#include <fb/string_iterators.h>
+#include <fb/string_list.h>
+#include <fb/string_random.h>
+#include <fb/string_utils.h>
+#include <fb/utf8_utils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+namespace
+{
+
+using clock_type = std::chrono::steady_clock;
+
+// ============================================================================
+// Results and reporting
+// ============================================================================
+
+enum class output_format
+{
+  table,
+  json
+};
+
+struct options
+{
+  output_format format = output_format::table;
+  std::string   filter;
+  std::size_t   scale = 10; ///< Sample multiplier; --quick sets 1
+};
+
+struct stats
+{
+  std::size_t samples;
+  double      min_ns;
+  double      max_ns;
+  double      mean_ns;
+  double      p50_ns;
+  double      p99_ns;
+
+  /// @brief Nearest-rank percentile of sorted @p samples
+  static double percentile(const std::vector<double>& samples, double fraction)
+  {
+    std::size_t idx = static_cast<std::size_t>(static_cast<double>(samples.size()) * fraction);
+    return samples[std::min(idx, samples.size() - 1)];
+  }
+
+  static stats compute(std::vector<double>& samples)
+  {
+    stats s{};
+    if (samples.empty())
+    {
+      return s;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    s.samples = samples.size();
+    s.min_ns  = samples.front();
+    s.max_ns  = samples.back();
+    s.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+    s.p50_ns  = percentile(samples, 0.50);
+    s.p99_ns  = percentile(samples, 0.99);
+    return s;
+  }
+};
+
+struct result
+{
+  std::string                                 benchmark;
+  std::string                                 variant;
+  stats                                       timing;
+  std::vector<std::pair<std::string, double>> extra; ///< allocs_per_op, gb_per_s
+};
+
+std::string format_number(double value)
+{
+  std::ostringstream out;
+  if (value == static_cast<double>(static_cast<std::int64_t>(value)))
+  {
+    out << static_cast<std::int64_t>(value);
+  }
+  else
+  {
+    out << std::fixed << std::setprecision(3) << value;
+  }
+  return out.str();
+}
+
+void report(const options& opts, const result& r)
+{
+  if (opts.format == output_format::json)
+  {
+    const std::vector<std::pair<std::string, double>> metrics = {{"samples", static_cast<double>(r.timing.samples)},
+                                                                 {"min_ns", r.timing.min_ns},
+                                                                 {"mean_ns", r.timing.mean_ns},
+                                                                 {"p50_ns", r.timing.p50_ns},
+                                                                 {"p99_ns", r.timing.p99_ns},
+                                                                 {"max_ns", r.timing.max_ns}};
+    std::cout << "{\"benchmark\":\"" << r.benchmark << "\",\"variant\":\"" << r.variant << "\"";
+    for (const auto& metric : metrics)
+    {
+      std::cout << ",\"" << metric.first << "\":" << format_number(metric.second);
+    }
+    for (const auto& metric : r.extra)
+    {
+      std::cout << ",\"" << metric.first << "\":" << format_number(metric.second);
+    }
+    std::cout << "}\n";
+  }
+  else
+  {
+    std::cout << std::left << std::setw(18) << r.benchmark << std::setw(30) << r.variant << std::right << std::fixed
+              << std::setprecision(1) << " p50: " << std::setw(10) << r.timing.p50_ns << " p99: " << std::setw(10)
+              << r.timing.p99_ns << " ns";
+    for (const auto& metric : r.extra)
+    {
+      std::cout << "  " << metric.first << '=' << format_number(metric.second);
+    }
+    std::cout << '\n';
+  }
+  std::cout.flush();
+}
+
+void section(const options& opts, const char* title)
+{
+  if (opts.format == output_format::table)
+  {
+    std::cout << "\n--- " << title << " ---\n";
+  }
+}
+
+bool selected(const options& opts, const std::string& name)
+{
+  return opts.filter.empty() || name.find(opts.filter) != std::string::npos;
+}
+
+double elapsed_ns(clock_type::time_point start, clock_type::time_point end)
+{
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// ============================================================================
+// Timing utilities
+// ============================================================================
+
+/// Results land here so the compiler cannot drop the work
+volatile std::size_t g_sink = 0;
+
+void consume(std::size_t value)
+{
+  g_sink = g_sink + value;
+}
+
+struct workload
+{
+  std::size_t ops_per_sample = 1000; ///< Calls per timed batch
+  std::size_t samples        = 200;  ///< Batches at the default scale
+  std::size_t bytes_per_op   = 0;    ///< Input bytes per call; non-zero adds gb_per_s
+};
+
+/// @brief Time @p fn and report ns/op, allocations/op and GB/s
+template <typename Fn>
+void measure(const options& opts, const char* benchmark, const std::string& variant, workload load, Fn&& fn)
+{
+  const std::size_t samples = std::max<std::size_t>(1, load.samples * opts.scale / 10);
+  for (std::size_t i = 0; i < load.ops_per_sample; ++i)
+  {
+    fn();
+  }
+
+  std::vector<double> timings;
+  timings.reserve(samples);
+  const std::uint64_t allocations = allocation_count();
+  for (std::size_t s = 0; s < samples; ++s)
+  {
+    const auto start = clock_type::now();
+    for (std::size_t i = 0; i < load.ops_per_sample; ++i)
+    {
+      fn();
+    }
+    const auto end = clock_type::now();
+    timings.push_back(elapsed_ns(start, end) / static_cast<double>(load.ops_per_sample));
+  }
+  const std::uint64_t allocated = allocation_count() - allocations;
+  const double        ops       = static_cast<double>(samples * load.ops_per_sample);
+
+  result r{benchmark, variant, stats::compute(timings), {}};
+  r.extra.emplace_back("allocs_per_op", static_cast<double>(allocated) / ops);
+  if (load.bytes_per_op != 0)
+  {
+    r.extra.emplace_back("gb_per_s", static_cast<double>(load.bytes_per_op) / r.timing.p50_ns);
+  }
+  report(opts, r);
+}
+
+/// Reproducible text of @p size bytes from @p charset
+std::string make_text(std::size_t size, std::string_view charset, std::uint64_t seed)
+{
+  fb::wyrand engine(seed);
+  return fb::random_string(engine, size, charset);
+}
+
+const std::string_view ALPHANUMERIC = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+/// One comma-separated line of 20 fields, like a fill or quote record
+std::string make_csv_line()
+{
+  fb::wyrand  engine(20);
+  std::string line;
+  for (int field = 0; field < 20; ++field)
+  {
+    line += field == 0 ? "" : ",";
+    line += fb::random_string(engine, 3 + static_cast<std::size_t>(field % 7), ALPHANUMERIC);
+  }
+  return line;
+}
+
+// ============================================================================
+// Formatting
+// ============================================================================
+
+void bench_format(const options& opts)
+{
+  const std::string symbol = "EURUSD";
+  const long long   qty    = 1000000;
+  const double      price  = 1.08423;
+  const workload    load{10000, 200, 0};
+
+  measure(opts, "format", "fb::format", load, [&] { consume(fb::format("{} {} {:.5f}", symbol, qty, price).size()); });
+  measure(opts, "format", "fb::format compiled", load,
+          [&] { consume(fb::format(FB_FORMAT_STRING("{} {} {:.5f}"), symbol, qty, price).size()); });
+  measure(opts, "format", "fb::format_to buffer", load,
+          [&]
+          {
+            char buffer[64];
+            consume(static_cast<std::size_t>(fb::format_to(buffer, "{} {} {:.5f}", symbol, qty, price) - buffer));
+          });
+  measure(opts, "format", "snprintf buffer", load,
+          [&]
+          {
+            char buffer[64];
+            consume(static_cast<std::size_t>(
+              std::snprintf(buffer, sizeof(buffer), "%s %lld %.5f", symbol.c_str(), qty, price)));
+          });
+  measure(opts, "format", "snprintf std::string", load,
+          [&]
+          {
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%s %lld %.5f", symbol.c_str(), qty, price);
+            consume(std::string(buffer).size());
+          });
+#if defined(__cpp_lib_format)
+  measure(opts, "format", "std::format", load, [&] { consume(std::format("{} {} {:.5f}", symbol, qty, price).size()); });
+#endif
+  measure(opts, "format", "std::ostringstream", load,
+          [&]
+          {
+            std::ostringstream out;
+            out << symbol << ' ' << qty << ' ' << std::fixed << std::setprecision(5) << price;
+            consume(out.str().size());
+          });
+}
+
+// ============================================================================
+// Splitting
+// ============================================================================
+
+void bench_split(const options& opts)
+{
+  const std::string line = make_csv_line();
+  const workload    load{2000, 200, line.size()};
+
+  measure(opts, "split", "split", load, [&] { consume(fb::split(line, ',').size()); });
+  measure(opts, "split", "split_view", load, [&] { consume(fb::split_view(line, ',').size()); });
+  std::vector<std::string_view> fields;
+  measure(opts, "split", "split_view reused vector", load,
+          [&]
+          {
+            fb::split_view(line, ',', fields);
+            consume(fields.size());
+          });
+  measure(opts, "split", "std::getline", load,
+          [&]
+          {
+            std::istringstream       in(line);
+            std::vector<std::string> parts;
+            for (std::string part; std::getline(in, part, ',');)
+            {
+              parts.push_back(std::move(part));
+            }
+            consume(parts.size());
+          });
+}
+
+// ============================================================================
+// Hashing
+// ============================================================================
+
+void bench_hash(const options& opts)
+{
+  for (std::size_t length : {8, 16, 32, 64, 256, 1024, 4096, 65536})
+  {
+    const std::string key    = make_text(length, ALPHANUMERIC, length);
+    std::string       suffix = "/";
+    suffix += std::to_string(length);
+    const workload    load{std::max<std::size_t>(16, 262144 / length), 200, length};
+
+    measure(opts, "hash", "xxh3_64" + suffix, load, [&] { consume(fb::hash_xxh3_64(key)); });
+    measure(opts, "hash", "fnv1a_64" + suffix, load, [&] { consume(fb::hash_fnv1a_64(key)); });
+    measure(opts, "hash", "crc32" + suffix, load, [&] { consume(fb::crc32(key)); });
+    measure(opts, "hash", "crc32c" + suffix, load, [&] { consume(fb::crc32c(key)); });
+    measure(opts, "hash", "std::hash" + suffix, load, [&] { consume(std::hash<std::string_view>{}(key)); });
+  }
+}
+
+// ============================================================================
+// UTF-8
+// ============================================================================
+
+void bench_utf8(const options& opts)
+{
+  constexpr std::size_t SIZE = 1 << 20;
+
+  const std::string ascii = make_text(SIZE, ALPHANUMERIC, 1);
+  std::string       mixed;
+  while (mixed.size() < SIZE)
+  {
+    mixed += "price \xE2\x82\xAC" "12 \xC3\xA9t\xC3\xA9 \xE6\x9D\xB1\xE4\xBA\xAC \xF0\x9F\x93\x88 ";
+  }
+  const workload load{4, 100, SIZE};
+
+  measure(opts, "utf8", "is_valid_utf8 ascii", load, [&] { consume(fb::is_valid_utf8(ascii)); });
+  measure(opts, "utf8", "is_valid_utf8 mixed", {4, 100, mixed.size()}, [&] { consume(fb::is_valid_utf8(mixed)); });
+  measure(opts, "utf8", "utf8_length ascii", load, [&] { consume(fb::utf8_length(ascii)); });
+  measure(opts, "utf8", "utf8_length mixed", {4, 100, mixed.size()}, [&] { consume(fb::utf8_length(mixed)); });
+}
+
+// ============================================================================
+// Text scanning
+// ============================================================================
+
+void bench_text(const options& opts)
+{
+  constexpr std::size_t SIZE = 1 << 20;
+
+  // Log-like lines: short words, single spaces, CRLF endings
+  fb::wyrand  engine(90);
+  std::string text;
+  while (text.size() < SIZE)
+  {
+    for (int word = 0; word < 12; ++word)
+    {
+      text += fb::random_string(engine, 1 + engine() % 9, ALPHANUMERIC);
+      text += word == 11 ? "\r\n" : " ";
+    }
+  }
+  const workload load{4, 100, text.size()};
+
+  // Each kernel set in turn, so the table shows the gain over scalar
+  const fb::simd::isa original = fb::simd::active_isa();
+  for (fb::simd::isa target : {fb::simd::isa::scalar, fb::simd::isa::sse2, fb::simd::isa::avx2, fb::simd::isa::neon})
+  {
+    if (!fb::simd::select_isa(target))
+    {
+      continue;
+    }
+    const std::string suffix = std::string(" ") + fb::simd::isa_name(target);
+    measure(opts, "text", "word_count" + suffix, load, [&] { consume(fb::word_count(text)); });
+    measure(opts, "text", "line_count" + suffix, load, [&] { consume(fb::line_count(text)); });
+    std::vector<std::string_view> words;
+    measure(opts, "text", "split_whitespace_view reused vector" + suffix, load,
+            [&]
+            {
+              fb::split_whitespace_view(text, words);
+              consume(words.size());
+            });
+    measure(opts, "text", "word_iterator" + suffix, load,
+            [&]
+            {
+              std::size_t count = 0;
+              for (fb::word_iterator it(text); it.has_next(); it.next())
+              {
+                ++count;
+              }
+              consume(count);
+            });
+  }
+  fb::simd::select_isa(original);
+}
+
+// ============================================================================
+// String building
+// ============================================================================
+
+void bench_builder(const options& opts)
+{
+  const std::vector<std::string> pieces = {"8=FIX.4.4", "|35=D", "|49=SENDER", "|56=TARGET", "|55=EURUSD", "|54=1"};
+  const workload                 load{5000, 200, 0};
+
+  measure(opts, "builder", "string_builder pieces", load,
+          [&]
+          {
+            fb::string_builder sb;
+            for (const auto& piece : pieces)
+            {
+              sb.append(piece);
+            }
+            consume(sb.size());
+          });
+  fb::string_builder reused;
+  measure(opts, "builder", "string_builder pieces reused", load,
+          [&]
+          {
+            reused.clear();
+            for (const auto& piece : pieces)
+            {
+              reused.append(piece);
+            }
+            consume(reused.size());
+          });
+  measure(opts, "builder", "std::string pieces", load,
+          [&]
+          {
+            std::string str;
+            for (const auto& piece : pieces)
+            {
+              str += piece;
+            }
+            consume(str.size());
+          });
+  measure(opts, "builder", "string_builder numbers reused", load,
+          [&]
+          {
+            reused.clear();
+            for (int i = 0; i < 8; ++i)
+            {
+              reused.append_int(static_cast<std::int64_t>(i) * 1234567).append(',').append_double(i * 0.25, 2);
+            }
+            consume(reused.size());
+          });
+  measure(opts, "builder", "std::ostringstream numbers", load,
+          [&]
+          {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(2);
+            for (int i = 0; i < 8; ++i)
+            {
+              out << static_cast<std::int64_t>(i) * 1234567 << ',' << i * 0.25;
+            }
+            consume(out.str().size());
+          });
+  measure(opts, "builder", "append_format reused", load,
+          [&]
+          {
+            reused.clear();
+            reused.append_format("{}|{}|{:.2f}", pieces[4], 1000000, 1.25);
+            consume(reused.size());
+          });
+}
+
+// ============================================================================
+// string_list
+// ============================================================================
+
+void bench_string_list(const options& opts)
+{
+  constexpr std::size_t COUNT = 100000;
+
+  fb::wyrand               engine(7);
+  std::vector<std::string> strings;
+  strings.reserve(COUNT);
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    strings.push_back(fb::random_string(engine, 4 + i % 12, ALPHANUMERIC));
+  }
+  const fb::string_list source(strings);
+  const workload        load{1, 20, 0};
+
+  measure(opts, "string_list", "sort 100k", load,
+          [&]
+          {
+            fb::string_list list = source;
+            consume(list.sort().size());
+          });
+  measure(opts, "string_list", "sort_natural 100k", load,
+          [&]
+          {
+            fb::string_list list = source;
+            consume(list.sort_natural().size());
+          });
+  measure(opts, "string_list", "std::sort 100k", load,
+          [&]
+          {
+            std::vector<std::string> copy = strings;
+            std::sort(copy.begin(), copy.end());
+            consume(copy.size());
+          });
+  measure(opts, "string_list", "filter_starts_with 100k", load,
+          [&] { consume(source.filter_starts_with("A").size()); });
+  measure(opts, "string_list", "filter predicate 100k", load,
+          [&] { consume(source.filter([](const std::string& s) { return s.size() > 10; }).size()); });
+  measure(opts, "string_list", "view().filter().count() 100k", load,
+          [&] { consume(source.view().filter_starts_with("A").count()); });
+}
+
+// ============================================================================
+// Escaping, parsing and cleanup
+// ============================================================================
+
+void bench_escape(const options& opts)
+{
+  const std::string message = "{\"note\":\"order \\\"A\\\" filled\",\n\"venue\":\"<XNAS>\"} and some plain text after it";
+  const workload    load{5000, 200, message.size()};
+
+  measure(opts, "escape", "json_escape", load, [&] { consume(fb::json_escape(message).size()); });
+  std::vector<char> buffer(fb::json_escaped_max_size(message.size()));
+  measure(opts, "escape", "json_escape buffer", load, [&] { consume(fb::json_escape(message, buffer.data())); });
+  measure(opts, "escape", "html_escape", load, [&] { consume(fb::html_escape(message).size()); });
+}
+
+void bench_parse(const options& opts)
+{
+  const std::string number = "12345.678901";
+  measure(opts, "parse", "fb::to_double", {10000, 200, number.size()},
+          [&] { consume(static_cast<std::size_t>(fb::to_double(number).value_or(0))); });
+  measure(opts, "parse", "std::strtod", {10000, 200, number.size()},
+          [&] { consume(static_cast<std::size_t>(std::strtod(number.c_str(), nullptr))); });
+}
+
+void bench_cleanup(const options& opts)
+{
+  const std::string line = "   \"EURUSD\",   \"XNAS\"  ,\t 1.0842,  \"BUY\"   order  entry  text   ";
+  measure(opts, "cleanup", "copying", {5000, 200, line.size()},
+          [&] { consume(fb::remove_all(fb::normalize_whitespace(fb::trim(line)), '"').size()); });
+  std::string work;
+  measure(opts, "cleanup", "in place", {5000, 200, line.size()},
+          [&]
+          {
+            work = line;
+            fb::trim_inplace(work);
+            fb::normalize_whitespace_inplace(work);
+            fb::remove_all_inplace(work, '"');
+            consume(work.size());
+          });
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+void usage()
+{
+  std::cout << "usage: fb_strings_bench [--format=table|json] [--quick] [--filter=<substring>]\n";
+}
+
+template <typename Fn>
+void run(const options& opts, const std::string& name, Fn&& fn)
+{
+  if (selected(opts, name))
+  {
+    fn();
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  options opts;
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--format=json")
+    {
+      opts.format = output_format::json;
+    }
+    else if (arg == "--format=table")
+    {
+      opts.format = output_format::table;
+    }
+    else if (arg == "--quick")
+    {
+      opts.scale = 1;
+    }
+    else if (arg.rfind("--filter=", 0) == 0)
+    {
+      opts.filter = arg.substr(9);
+    }
+    else
+    {
+      usage();
+      return arg == "--help" ? 0 : 2;
+    }
+  }
+
+  const bool table = opts.format == output_format::table;
+  if (table)
+  {
+    std::cout << "=== fb_strings Benchmark Results ===\n";
+  }
+
+  section(opts, "Formatting");
+  run(opts, "format", [&] { bench_format(opts); });
+  section(opts, "Splitting");
+  run(opts, "split", [&] { bench_split(opts); });
+  section(opts, "Hashing");
+  run(opts, "hash", [&] { bench_hash(opts); });
+  section(opts, "UTF-8");
+  run(opts, "utf8", [&] { bench_utf8(opts); });
+  section(opts, "Text Scanning");
+  run(opts, "text", [&] { bench_text(opts); });
+  section(opts, "String Building");
+  run(opts, "builder", [&] { bench_builder(opts); });
+  section(opts, "string_list");
+  run(opts, "string_list", [&] { bench_string_list(opts); });
+  section(opts, "Escaping, Parsing and Cleanup");
+  run(opts, "escape", [&] { bench_escape(opts); });
+  run(opts, "parse", [&] { bench_parse(opts); });
+  run(opts, "cleanup", [&] { bench_cleanup(opts); });
+
+  if (table)
+  {
+    std::cout << "\n=== Benchmark Complete ===\n";
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+/// @file edit_distance.h
+/// @brief Internal Levenshtein kernels shared by string_utils and string_list
+///
+/// Queries of up to 64 characters run Myers' bit-parallel algorithm, one
+/// machine word per text character. Longer ones fall back to a dynamic
+/// programming row, restricted to Ukkonen's diagonal band when a bound is
+/// given. Bounded calls stop as soon as the bound cannot be met.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace fb
+{
+namespace detail
+{
+
+/// @brief No bound: compute the exact distance
+constexpr std::size_t UNBOUNDED_DISTANCE = std::numeric_limits<std::size_t>::max() - 1;
+
+/**
+ * @brief Levenshtein distance from one query to many texts
+ *
+ * The match table for the bit-parallel kernel is built once, so matching
+ * a query against a list costs one pass over each text. The query must
+ * outlive the object.
+ */
+class edit_distance_query
+{
+public:
+  explicit edit_distance_query(std::string_view query) noexcept;
+
+  /// @return The distance to @p text, or max_distance + 1 if it is larger
+  std::size_t distance(std::string_view text, std::size_t max_distance = UNBOUNDED_DISTANCE) const noexcept;
+
+private:
+  /// Bits of m_query positions holding each byte value
+  std::array<std::uint64_t, 256> m_match{};
+  std::string_view m_query;
+};
+
+/// @return The distance between @p a and @p b, or max_distance + 1 if it is larger
+std::size_t edit_distance(std::string_view a,
+                          std::string_view b,
+                          std::size_t max_distance = UNBOUNDED_DISTANCE);
+
+} // namespace detail
+} // namespace fb
@@ -0,0 +1,133 @@
+/// @file number_chars.h
+/// @brief Internal number-to-characters conversions shared by fb_strings
+///
+/// Thin wrappers over std::to_chars: locale-independent, no allocation,
+/// and shortest round-trip output for floating point. Standard libraries
+/// without floating-point std::to_chars fall back to snprintf.
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define FB_STRINGS_HAS_FLOAT_TO_CHARS 1
+#else
+#define FB_STRINGS_HAS_FLOAT_TO_CHARS 0
+#endif
+
+namespace fb
+{
+namespace detail
+{
+
+/// @brief Notation of float_to_chars()
+enum class float_notation
+{
+  shortest,   ///< Fewest digits that read back to the same value
+  fixed,      ///< printf %f
+  scientific, ///< printf %e
+  general     ///< printf %g
+};
+
+/// @brief Characters fixed notation may need besides the precision digits:
+///        sign, integer digits of the largest double, decimal point
+constexpr std::size_t FIXED_FLOAT_CHARS = 1 + std::numeric_limits<double>::max_exponent10 + 2;
+
+/// @brief Convert an integer in @p base (2-36)
+/// @return End of the characters written, nullptr if they do not fit
+template<typename T>
+char* integer_to_chars(char* first, char* last, T value, int base = 10, bool uppercase = false)
+{
+  auto [end, ec] = std::to_chars(first, last, value, base);
+  if (ec != std::errc())
+  {
+    return nullptr;
+  }
+  if (uppercase && base > 10)
+  {
+    for (char* it = first; it != end; ++it)
+    {
+      if (*it >= 'a' && *it <= 'z')
+      {
+        *it = static_cast<char>(*it - 'a' + 'A');
+      }
+    }
+  }
+  return end;
+}
+
+/// @brief Convert a float or double, as printf would in the C locale
+/// @param precision Ignored for float_notation::shortest; printf's
+///        default of 6 if negative
+/// @return End of the characters written, nullptr if they do not fit
+template<typename T>
+char* float_to_chars(char* first, char* last, T value, float_notation notation, int precision = 6)
+{
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                "float_to_chars converts float or double");
+  if (precision < 0)
+  {
+    precision = 6;
+  }
+
+#if FB_STRINGS_HAS_FLOAT_TO_CHARS
+  std::to_chars_result result{};
+  switch (notation)
+  {
+  case float_notation::shortest:
+    result = std::to_chars(first, last, value);
+    break;
+  case float_notation::fixed:
+    result = std::to_chars(first, last, value, std::chars_format::fixed, precision);
+    break;
+  case float_notation::scientific:
+    result = std::to_chars(first, last, value, std::chars_format::scientific, precision);
+    break;
+  case float_notation::general:
+    result = std::to_chars(first, last, value, std::chars_format::general, precision);
+    break;
+  }
+  return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+  const auto size = static_cast<std::size_t>(last - first);
+  auto print      = [&](const char* format, int digits) -> char* {
+    int length = std::snprintf(first, size, format, digits, static_cast<double>(value));
+    return length >= 0 && static_cast<std::size_t>(length) < size ? first + length : nullptr;
+  };
+
+  switch (notation)
+  {
+  case float_notation::shortest:
+    // Fewest significant digits that parse back to the same value
+    for (int digits = 1; digits < std::numeric_limits<T>::max_digits10; ++digits)
+    {
+      char* end = print("%.*g", digits);
+      if (end == nullptr)
+      {
+        return nullptr;
+      }
+      if (static_cast<T>(std::strtod(first, nullptr)) == value)
+      {
+        return end;
+      }
+    }
+    return print("%.*g", std::numeric_limits<T>::max_digits10);
+  case float_notation::fixed:
+    return print("%.*f", precision);
+  case float_notation::scientific:
+    return print("%.*e", precision);
+  case float_notation::general:
+    return print("%.*g", precision);
+  }
+  return nullptr;
+#endif
+}
+
+} // namespace detail
+} // namespace fb
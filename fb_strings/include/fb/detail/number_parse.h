@@ -0,0 +1,355 @@
+/// @file number_parse.h
+/// @brief Internal characters-to-number conversions shared by fb_strings
+///
+/// Locale-independent and allocation-free. Decimal integers take eight
+/// digits per step with SWAR arithmetic on a 64-bit word. Floating point
+/// takes Clinger's exact fast path when the digits and the power of ten
+/// both fit the significand, and std::from_chars (Eisel-Lemire in current
+/// standard libraries) otherwise.
+
+#pragma once
+
+#include <fb/detail/number_chars.h>
+
+#include <cctype>
+#include <cfloat>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define FB_STRINGS_SWAR_DIGITS 1
+#elif defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define FB_STRINGS_SWAR_DIGITS 1
+#else
+#define FB_STRINGS_SWAR_DIGITS 0
+#endif
+
+namespace fb
+{
+namespace detail
+{
+
+// ============================================================================
+// Decimal Digits
+// ============================================================================
+
+#if FB_STRINGS_SWAR_DIGITS
+
+/// @brief Load 8 characters, the first one in the low byte
+inline std::uint64_t load_eight_chars(const char* chars) noexcept
+{
+  std::uint64_t word = 0;
+  std::memcpy(&word, chars, sizeof(word));
+  return word;
+}
+
+/// @brief Whether all 8 characters of @p word are '0'-'9'
+inline bool is_eight_digits(std::uint64_t word) noexcept
+{
+  // High nibbles must be 3, and adding 6 must not carry a low nibble past 9
+  return ((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+         0x3333333333333333;
+}
+
+/// @brief Value of 8 decimal digits: pairs, then quads, then all 8, with 3 multiplies
+inline std::uint32_t parse_eight_digits(std::uint64_t word) noexcept
+{
+  word -= 0x3030303030303030;
+  word = (word * 10) + (word >> 8);
+  word = (((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+          (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+         32;
+  return static_cast<std::uint32_t>(word);
+}
+
+#endif // FB_STRINGS_SWAR_DIGITS
+
+/**
+ * @brief Parse a run of decimal digits, nothing else
+ * @return The value, or std::nullopt if @p digits is empty, holds a
+ *         non-digit or exceeds 2^64 - 1
+ */
+inline std::optional<std::uint64_t> parse_decimal_digits(std::string_view digits) noexcept
+{
+  if (digits.empty())
+  {
+    return std::nullopt;
+  }
+
+  const char* p   = digits.data();
+  const char* end = p + digits.size();
+  while (p != end && *p == '0')
+  {
+    ++p;
+  }
+
+  // 2^64 - 1 has 20 digits; longer runs overflow, shorter ones cannot
+  const auto significant = static_cast<std::size_t>(end - p);
+  if (significant > 20)
+  {
+    return std::nullopt;
+  }
+  const char first = significant > 0 ? *p : '0';
+
+  std::uint64_t value = 0;
+#if FB_STRINGS_SWAR_DIGITS
+  while (end - p >= 8)
+  {
+    const std::uint64_t word = load_eight_chars(p);
+    if (!is_eight_digits(word))
+    {
+      return std::nullopt;
+    }
+    value = value * 100000000 + parse_eight_digits(word);
+    p += 8;
+  }
+#endif
+  for (; p != end; ++p)
+  {
+    const auto digit = static_cast<unsigned>(*p - '0');
+    if (digit > 9)
+    {
+      return std::nullopt;
+    }
+    value = value * 10 + digit;
+  }
+
+  // A 20-digit value fits only below 2 * 10^19, and a wrapped one ends up below 10^19
+  if (significant == 20 && (first != '1' || value < 10000000000000000000ULL))
+  {
+    return std::nullopt;
+  }
+  return value;
+}
+
+/**
+ * @brief Parse an optionally signed decimal integer filling all of @p str
+ *
+ * Accepts a leading '+', and a leading '-' for signed types only.
+ */
+template <typename T>
+std::optional<T> parse_integer(std::string_view str) noexcept
+{
+  static_assert(std::is_integral_v<T>, "parse_integer parses integers");
+
+  bool negative = false;
+  if (!str.empty() && (str.front() == '+' || str.front() == '-'))
+  {
+    negative = str.front() == '-';
+    str.remove_prefix(1);
+    if (negative && std::is_unsigned_v<T>)
+    {
+      return std::nullopt;
+    }
+  }
+
+  const std::optional<std::uint64_t> magnitude = parse_decimal_digits(str);
+  if (!magnitude)
+  {
+    return std::nullopt;
+  }
+
+  using unsigned_type     = std::make_unsigned_t<T>;
+  const std::uint64_t max = std::numeric_limits<T>::max();
+  if (!negative)
+  {
+    return *magnitude <= max ? std::optional<T>(static_cast<T>(*magnitude)) : std::nullopt;
+  }
+  if (*magnitude > max + 1)
+  {
+    return std::nullopt;
+  }
+  // Two's complement negation in the unsigned type reaches the minimum without overflow
+  return static_cast<T>(static_cast<unsigned_type>(0 - static_cast<unsigned_type>(*magnitude)));
+}
+
+// ============================================================================
+// Floating Point
+// ============================================================================
+
+/// @brief Exact powers of ten for Clinger's fast path: 10^22 is the largest a double holds exactly
+template <typename T>
+struct exact_powers
+{
+};
+
+template <>
+struct exact_powers<double>
+{
+  static constexpr int MAX_EXPONENT           = 22;
+  static constexpr std::uint64_t MAX_MANTISSA = std::uint64_t{1} << 53;
+  static constexpr double VALUES[]            = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+template <>
+struct exact_powers<float>
+{
+  static constexpr int MAX_EXPONENT           = 10;
+  static constexpr std::uint64_t MAX_MANTISSA = std::uint64_t{1} << 24;
+  static constexpr float VALUES[]             = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+/**
+ * @brief Clinger's fast path for plain decimals such as "-123.4567" or "1.5e10"
+ *
+ * When the digits form an integer below 2^53 (2^24 for float) and the
+ * decimal exponent is at most 22 (10) in magnitude, both operands are
+ * exact and one IEEE multiply or divide rounds correctly.
+ *
+ * @return std::nullopt when the fast path does not apply, and for input
+ *         it does not recognize; the caller falls back to from_chars()
+ */
+template <typename T>
+std::optional<T> parse_float_fast(std::string_view str) noexcept
+{
+#if FLT_EVAL_METHOD == 0
+  const char* p   = str.data();
+  const char* end = p + str.size();
+  const bool negative = p != end && *p == '-';
+  if (p != end && (*p == '-' || *p == '+'))
+  {
+    ++p;
+  }
+
+  std::uint64_t mantissa = 0;
+  int digits             = 0;
+  int exponent           = 0;
+  auto take_digits       = [&](bool fraction) {
+    for (; p != end && static_cast<unsigned>(*p - '0') <= 9; ++p)
+    {
+      if (mantissa != 0 || *p != '0')
+      {
+        ++digits;
+      }
+      mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+      exponent -= fraction ? 1 : 0;
+      if (digits > 19)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const char* integer_start = p;
+  if (!take_digits(false))
+  {
+    return std::nullopt;
+  }
+  bool any_digits = p != integer_start;
+  if (p != end && *p == '.')
+  {
+    ++p;
+    const char* fraction_start = p;
+    if (!take_digits(true))
+    {
+      return std::nullopt;
+    }
+    any_digits = any_digits || p != fraction_start;
+  }
+  if (!any_digits)
+  {
+    return std::nullopt;
+  }
+
+  if (p != end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    const bool negative_exponent = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+'))
+    {
+      ++p;
+    }
+    const char* exponent_start = p;
+    int written                = 0;
+    for (; p != end && static_cast<unsigned>(*p - '0') <= 9 && written < 1000; ++p)
+    {
+      written = written * 10 + (*p - '0');
+    }
+    if (p == exponent_start || p != end)
+    {
+      return std::nullopt;
+    }
+    exponent += negative_exponent ? -written : written;
+  }
+  if (p != end || mantissa > exact_powers<T>::MAX_MANTISSA || exponent < -exact_powers<T>::MAX_EXPONENT ||
+      exponent > exact_powers<T>::MAX_EXPONENT)
+  {
+    return std::nullopt;
+  }
+
+  T value = static_cast<T>(mantissa);
+  value   = exponent < 0 ? value / exact_powers<T>::VALUES[-exponent] : value * exact_powers<T>::VALUES[exponent];
+  return negative ? -value : value;
+#else
+  // Excess precision (x87) would round twice
+  (void)str;
+  return std::nullopt;
+#endif
+}
+
+/**
+ * @brief Parse a float or double filling all of @p str
+ *
+ * Accepts what strtod() accepts in the "C" locale: an optional sign,
+ * decimal or "0x" hexadecimal digits, an exponent, "inf" and "nan".
+ * Values outside the type's range are an error.
+ */
+template <typename T>
+std::optional<T> parse_float(std::string_view str)
+{
+  if (const std::optional<T> fast = parse_float_fast<T>(str))
+  {
+    return fast;
+  }
+
+#if FB_STRINGS_HAS_FLOAT_TO_CHARS
+  // from_chars takes neither a '+' nor a "0x" prefix
+  const bool negative = !str.empty() && str.front() == '-';
+  std::string_view body = str;
+  if (!body.empty() && (body.front() == '+' || body.front() == '-'))
+  {
+    body.remove_prefix(1);
+  }
+  std::chars_format format = std::chars_format::general;
+  if (body.size() >= 2 && body[0] == '0' && (body[1] == 'x' || body[1] == 'X'))
+  {
+    body.remove_prefix(2);
+    format = std::chars_format::hex;
+  }
+  if (body.empty() || body.front() == '+' || body.front() == '-')
+  {
+    return std::nullopt;
+  }
+
+  T value{};
+  const auto [ptr, ec] = std::from_chars(body.data(), body.data() + body.size(), value, format);
+  if (ec != std::errc() || ptr != body.data() + body.size())
+  {
+    return std::nullopt;
+  }
+  return negative ? -value : value;
+#else
+  // Without floating-point from_chars, strtod reads the decimal point of the global locale
+  const std::string copy(str);
+  char* end     = nullptr;
+  const T value = std::is_same_v<T, float> ? std::strtof(copy.c_str(), &end) : std::strtod(copy.c_str(), &end);
+  if (copy.empty() || end != copy.c_str() + copy.size() || std::isspace(static_cast<unsigned char>(copy[0])))
+  {
+    return std::nullopt;
+  }
+  return value;
+#endif
+}
+
+} // namespace detail
+} // namespace fb
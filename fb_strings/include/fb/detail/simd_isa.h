@@ -0,0 +1,24 @@
+/// @file simd_isa.h
+/// @brief Internal instruction-set detection shared by the vectorized kernels
+///
+/// Defines FB_SIMD_SSE2, FB_SIMD_AVX2 or FB_SIMD_NEON and includes the
+/// matching intrinsics. AVX2 kernels are compiled per function with
+/// FB_TARGET_AVX2 and only called after simd::active_isa() reports avx2.
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FB_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__)
+// GCC and Clang compile AVX2 kernels per function and check the CPU at run
+// time; other compilers keep to the SSE2 baseline
+#define FB_SIMD_AVX2 1
+#define FB_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FB_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
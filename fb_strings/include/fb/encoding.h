@@ -0,0 +1,320 @@
+/// @file encoding.h
+/// @brief Hex, Base64 and percent encoding and JSON / HTML escaping into caller buffers,
+///        one-shot or streaming
+///
+/// to_hex(), to_base64(), url_encode(), json_escape() and html_escape() in
+/// string_utils.h return a new std::string per call. The functions here
+/// write into a buffer the caller owns, sized with the *_size() helpers, or
+/// append to an existing string or format_sink, and the encoder and decoder
+/// classes take a large payload in chunks of any size, so a multi-megabyte
+/// snapshot can be encoded straight into an output buffer or socket.
+///
+/// Features:
+/// - Encoders and decoders for every option of the string functions:
+///   upper- or lowercase hex, standard or URL-safe Base64 alphabet, with or
+///   without padding
+/// - Base64 decoding skips ASCII whitespace, so MIME-style line breaks are
+///   accepted, and rejects anything after the padding
+/// - AVX2 Base64 kernels (24 bytes per step) and SSE2 / AVX2 hex kernels,
+///   picked with the simd_search.h dispatch; scalar loops elsewhere
+/// - Escaping finds the next byte to escape with a vectorized scan and
+///   copies each clean run with one memcpy, so text with nothing to escape
+///   costs little more than a copy
+///
+/// Thread Safety:
+/// - The functions are thread-safe
+/// - An encoder or decoder object is NOT thread-safe
+///
+/// Example:
+/// @code
+/// std::string out(fb::base64_encoded_size(snapshot.size()), '\0');
+/// out.resize(fb::base64_encode(snapshot, out.data()));
+///
+/// fb::base64_encoder encoder;
+/// std::string body = "{\"snapshot\":\"";
+/// while (auto chunk = reader.next())
+/// {
+///   encoder.update(*chunk, body);
+/// }
+/// encoder.finish(body);
+/// body += "\"}";
+///
+/// fb::string_builder json;
+/// json.append("{\"symbol\":\"").append_json_escaped(symbol).append("\"}");
+/// @endcode
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace fb
+{
+
+class format_sink;
+
+/// @brief Characters for Base64 values 62 and 63
+enum class base64_alphabet
+{
+  standard, ///< '+' and '/' (RFC 4648 section 4)
+  url       ///< '-' and '_' (RFC 4648 section 5), safe in URLs and file names
+};
+
+// ============================================================================
+// Buffer Sizes
+// ============================================================================
+
+/// @brief Characters hex_encode() writes for @p size bytes
+constexpr std::size_t hex_encoded_size(std::size_t size) noexcept
+{
+  return size * 2;
+}
+
+/// @brief Characters base64_encode() writes for @p size bytes
+constexpr std::size_t base64_encoded_size(std::size_t size, bool padding = true) noexcept
+{
+  return padding ? (size + 2) / 3 * 4 : size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+}
+
+/// @brief Bytes base64_decode() may write for @p size characters
+constexpr std::size_t base64_decoded_max_size(std::size_t size) noexcept
+{
+  return (size + 3) / 4 * 3;
+}
+
+/// @brief Characters percent_encode() may write for @p size bytes
+constexpr std::size_t percent_encoded_max_size(std::size_t size) noexcept
+{
+  return size * 3;
+}
+
+/// @brief Characters json_escape() may write for @p size bytes: "\u001f" is 6
+constexpr std::size_t json_escaped_max_size(std::size_t size) noexcept
+{
+  return size * 6;
+}
+
+/// @brief Characters html_escape() may write for @p size bytes: "&quot;" is 6
+constexpr std::size_t html_escaped_max_size(std::size_t size) noexcept
+{
+  return size * 6;
+}
+
+// ============================================================================
+// One-Shot Encoding
+// ============================================================================
+
+/**
+ * @brief Write @p data as hex digits
+ * @param out At least hex_encoded_size(data.size()) characters
+ * @return Characters written
+ */
+std::size_t hex_encode(std::string_view data, char* out, bool uppercase = false) noexcept;
+
+/**
+ * @brief Decode hex digits of either case; no "0x" prefix (see from_hex())
+ * @param out At least hex.size() / 2 bytes
+ * @return Bytes written, or std::nullopt on an odd length or a non-hex character
+ */
+std::optional<std::size_t> hex_decode(std::string_view hex, char* out) noexcept;
+
+/**
+ * @brief Write @p data as Base64
+ * @param out At least base64_encoded_size(data.size(), padding) characters
+ * @return Characters written
+ */
+std::size_t base64_encode(std::string_view data,
+                          char* out,
+                          base64_alphabet alphabet = base64_alphabet::standard,
+                          bool padding = true) noexcept;
+
+/**
+ * @brief Decode Base64, skipping whitespace
+ *
+ * With @p padding the input must be padded to a multiple of 4 characters;
+ * without it, '=' is rejected and a final group of 2 or 3 characters is
+ * accepted.
+ *
+ * @param out At least base64_decoded_max_size(base64.size()) bytes
+ * @return Bytes written, or std::nullopt on invalid input
+ */
+std::optional<std::size_t> base64_decode(std::string_view base64,
+                                         char* out,
+                                         base64_alphabet alphabet = base64_alphabet::standard,
+                                         bool padding = true) noexcept;
+
+/**
+ * @brief Percent-encode every byte except A-Z a-z 0-9 - _ . ~, like url_encode()
+ * @param out At least percent_encoded_max_size(str.size()) characters
+ * @return Characters written
+ */
+std::size_t percent_encode(std::string_view str, char* out) noexcept;
+
+/**
+ * @brief Decode %XX escapes and '+' as a space, like url_decode()
+ * @param out At least str.size() bytes
+ * @return Bytes written, or std::nullopt on a malformed escape
+ */
+std::optional<std::size_t> percent_decode(std::string_view str, char* out) noexcept;
+
+/// @brief to_base64() with a choice of alphabet and padding
+std::string to_base64(std::string_view data, base64_alphabet alphabet, bool padding = true);
+
+/// @brief from_base64() with a choice of alphabet and padding
+std::optional<std::string> from_base64(std::string_view base64, base64_alphabet alphabet, bool padding = true);
+
+// ============================================================================
+// Escaping
+// ============================================================================
+
+/**
+ * @brief Escape @p str for a JSON string value, like json_escape(str)
+ *
+ * '"' and '\\' get a backslash, \b \f \n \r \t their short forms and
+ * other control characters below 0x20 a \u00XX escape. Other bytes,
+ * UTF-8 included, are copied as they are. No quotes are added.
+ *
+ * @param out At least json_escaped_max_size(str.size()) characters
+ * @return Characters written
+ */
+std::size_t json_escape(std::string_view str, char* out) noexcept;
+
+/**
+ * @brief Replace & < > " ' with HTML entities, like html_escape(str)
+ * @param out At least html_escaped_max_size(str.size()) characters
+ * @return Characters written
+ */
+std::size_t html_escape(std::string_view str, char* out) noexcept;
+
+/// @brief Append json_escape(str) to @p out without a temporary string
+void append_json_escaped(std::string& out, std::string_view str);
+
+/// @brief Write json_escape(str) to @p out, such as inside a formatter
+void append_json_escaped(format_sink& out, std::string_view str);
+
+/// @brief Append html_escape(str) to @p out without a temporary string
+void append_html_escaped(std::string& out, std::string_view str);
+
+/// @brief Write html_escape(str) to @p out, such as inside a formatter
+void append_html_escaped(format_sink& out, std::string_view str);
+
+// ============================================================================
+// Streaming Encoders
+// ============================================================================
+
+/**
+ * @brief Base64 encoder taking its input in chunks
+ *
+ * Up to 2 bytes of a chunk wait for the next one; finish() writes them and
+ * the padding. The output is the same as base64_encode() of the
+ * concatenated chunks. After finish() the encoder starts over.
+ */
+class base64_encoder
+{
+public:
+  explicit base64_encoder(base64_alphabet alphabet = base64_alphabet::standard, bool padding = true) noexcept;
+
+  /**
+   * @param out At least base64_encoded_size(chunk.size()) characters
+   * @return Characters written
+   */
+  std::size_t update(std::string_view chunk, char* out) noexcept;
+
+  /// @brief Append the encoding of @p chunk to @p out
+  void update(std::string_view chunk, std::string& out);
+
+  /**
+   * @param out At least 4 characters
+   * @return Characters written
+   */
+  std::size_t finish(char* out) noexcept;
+
+  /// @brief Append the end of the encoding to @p out
+  void finish(std::string& out);
+
+private:
+  base64_alphabet m_alphabet;
+  bool            m_padding;
+  unsigned char   m_pending[2] = {};
+  std::size_t     m_pending_size = 0;
+};
+
+/**
+ * @brief Base64 decoder taking its input in chunks
+ *
+ * Chunks may split the input anywhere. Once update() or finish() has
+ * reported invalid input, every later call does too. After a successful
+ * finish() the decoder starts over.
+ */
+class base64_decoder
+{
+public:
+  explicit base64_decoder(base64_alphabet alphabet = base64_alphabet::standard, bool padding = true) noexcept;
+
+  /**
+   * @param out At least base64_decoded_max_size(chunk.size()) + 3 bytes; the
+   *            extra 3 hold a group started in an earlier chunk
+   * @return Bytes written, or std::nullopt on invalid input
+   */
+  std::optional<std::size_t> update(std::string_view chunk, char* out) noexcept;
+
+  /// @brief Append the bytes decoded from @p chunk to @p out
+  /// @return false on invalid input
+  bool update(std::string_view chunk, std::string& out);
+
+  /**
+   * @brief Check that the input ended on a complete group
+   * @param out At least 2 bytes, written by an unpadded final group
+   * @return Bytes written, or std::nullopt if the input was invalid or cut short
+   */
+  std::optional<std::size_t> finish(char* out) noexcept;
+
+  /// @brief Append the end of the decoding to @p out
+  /// @return false if the input was invalid or cut short
+  bool finish(std::string& out);
+
+private:
+  base64_alphabet m_alphabet;
+  bool            m_padding;
+  bool            m_done   = false; ///< Padding complete; only whitespace may follow
+  bool            m_failed = false;
+  unsigned        m_count  = 0;     ///< Values of the current group so far
+  unsigned        m_pad    = 0;     ///< '=' characters seen
+  std::uint32_t   m_bits   = 0;
+};
+
+/**
+ * @brief Hex decoder taking its input in chunks
+ *
+ * A chunk may end between the two digits of a byte. Once update() or
+ * finish() has reported invalid input, every later call does too. After a
+ * successful finish() the decoder starts over.
+ */
+class hex_decoder
+{
+public:
+  hex_decoder() noexcept = default;
+
+  /**
+   * @param out At least (chunk.size() + 1) / 2 bytes
+   * @return Bytes written, or std::nullopt on a non-hex character
+   */
+  std::optional<std::size_t> update(std::string_view chunk, char* out) noexcept;
+
+  /// @brief Append the bytes decoded from @p chunk to @p out
+  /// @return false on a non-hex character
+  bool update(std::string_view chunk, std::string& out);
+
+  /// @brief Check that the input ended on a whole byte
+  /// @return false if the input was invalid or had an odd length
+  bool finish() noexcept;
+
+private:
+  int  m_high   = -1; ///< First digit of a byte split across chunks
+  bool m_failed = false;
+};
+
+} // namespace fb
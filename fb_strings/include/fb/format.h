@@ -1,10 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <charconv>
 #include <cmath>
 #include <cstdint>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <sstream>
 #include <stdexcept>
@@ -47,7 +49,60 @@ struct format_spec
  * @param spec Format specification (everything after the colon)
  * @return Parsed format_spec
  */
-format_spec parse_format_spec(std::string_view spec);
+constexpr format_spec parse_format_spec(std::string_view spec);
+
+// ============================================================================
+// Format Output
+// ============================================================================
+
+/**
+ * @brief Type-erased character output that formatters write into
+ *
+ * Wraps a destination (a std::string, an output iterator, a bounded
+ * buffer, a counter) behind one write function, so formatting appends
+ * straight to the destination instead of building temporary strings.
+ * Also counts every character written.
+ */
+class format_sink
+{
+public:
+  using value_type = char; ///< Allows std::back_inserter(sink)
+  using write_fn = void (*)(void* context, const char* data, size_t size);
+
+  format_sink(void* context, write_fn write) noexcept
+    : m_context(context)
+    , m_write(write)
+  {
+  }
+
+  /// @brief Sink that appends to @p out
+  explicit format_sink(std::string& out) noexcept;
+
+  format_sink(const format_sink&)            = delete;
+  format_sink& operator=(const format_sink&) = delete;
+
+  void append(std::string_view str)
+  {
+    if (!str.empty())
+    {
+      m_write(m_context, str.data(), str.size());
+      m_size += str.size();
+    }
+  }
+
+  /// @brief Append @p count copies of @p ch
+  void append(size_t count, char ch);
+
+  void push_back(char ch) { append(std::string_view(&ch, 1)); }
+
+  /// @brief Characters written so far
+  size_t size() const noexcept { return m_size; }
+
+private:
+  void* m_context;
+  write_fn m_write;
+  size_t m_size = 0;
+};
 
 // ============================================================================
 // Formatter Specializations
@@ -63,6 +118,7 @@ struct formatter<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T,
 
   void parse(std::string_view spec);
   std::string format(T value) const;
+  void format(T value, format_sink& out) const;
 };
 
 /**
@@ -76,6 +132,7 @@ struct formatter<bool>
 
   void parse(std::string_view spec);
   std::string format(bool value) const;
+  void format(bool value, format_sink& out) const;
 };
 
 /**
@@ -88,6 +145,7 @@ struct formatter<T, std::enable_if_t<std::is_floating_point_v<T>>>
 
   void parse(std::string_view spec);
   std::string format(T value) const;
+  void format(T value, format_sink& out) const;
 };
 
 /**
@@ -100,6 +158,7 @@ struct formatter<const char*>
 
   void parse(std::string_view spec);
   std::string format(const char* value) const;
+  void format(const char* value, format_sink& out) const;
 };
 
 /**
@@ -112,6 +171,7 @@ struct formatter<char*>
 
   void parse(std::string_view spec);
   std::string format(char* value) const;
+  void format(char* value, format_sink& out) const;
 };
 
 /**
@@ -124,6 +184,7 @@ struct formatter<std::string>
 
   void parse(std::string_view spec);
   std::string format(const std::string& value) const;
+  void format(const std::string& value, format_sink& out) const;
 };
 
 /**
@@ -136,6 +197,7 @@ struct formatter<std::string_view>
 
   void parse(std::string_view spec);
   std::string format(std::string_view value) const;
+  void format(std::string_view value, format_sink& out) const;
 };
 
 /**
@@ -148,6 +210,7 @@ struct formatter<char>
 
   void parse(std::string_view spec);
   std::string format(char value) const;
+  void format(char value, format_sink& out) const;
 };
 
 /**
@@ -160,6 +223,7 @@ struct formatter<T*, std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, char>
 
   void parse(std::string_view spec);
   std::string format(T* value) const;
+  void format(T* value, format_sink& out) const;
 };
 
 /**
@@ -172,6 +236,7 @@ struct formatter<std::nullptr_t>
 
   void parse(std::string_view spec);
   std::string format(std::nullptr_t value) const;
+  void format(std::nullptr_t value, format_sink& out) const;
 };
 
 // ============================================================================
@@ -192,11 +257,11 @@ public:
   template<typename T>
   explicit format_arg(const T& value);
 
-  std::string format(const format_spec& spec) const;
+  void format(const format_spec& spec, format_sink& out) const;
   bool is_valid() const noexcept { return m_format_fn != nullptr; }
 
 private:
-  using format_fn = std::string (*)(const void*, const format_spec&);
+  using format_fn = void (*)(const void*, const format_spec&, format_sink&);
   const void* m_value   = nullptr;
   format_fn m_format_fn = nullptr;
 };
@@ -234,11 +299,96 @@ private:
   size_t m_size            = 0;
 };
 
+template<typename... Args>
+format_args_store<Args...> make_format_args(const Args&... args)
+{
+  return format_args_store<Args...>(args...);
+}
+
+/**
+ * @brief One piece of a format string: literal text or a replacement field
+ */
+struct format_segment
+{
+  std::string_view literal; ///< Text to copy, escapes resolved (empty for fields)
+  bool is_field    = false;
+  size_t arg_index = 0;
+  format_spec spec;
+};
+
+/**
+ * @brief Parse the segment of @p fmt starting at @p pos
+ *
+ * Advances @p pos past the segment and @p auto_index past each {} field.
+ *
+ * @throws std::invalid_argument if the format string is invalid
+ */
+constexpr format_segment next_format_segment(std::string_view fmt,
+                                             size_t& pos,
+                                             size_t& auto_index);
+
+/**
+ * @brief Segment count and arguments needed by a format string
+ */
+struct format_string_info
+{
+  size_t segments  = 0;
+  size_t arg_count = 0; ///< Highest argument index used, plus one
+};
+
+constexpr format_string_info analyze_format_string(std::string_view fmt);
+
+template<size_t N>
+constexpr std::array<format_segment, N> parse_format_segments(std::string_view fmt);
+
 /**
  * @brief Core format implementation
  */
 std::string vformat(std::string_view fmt, format_args args);
 
+/**
+ * @brief Core format implementation writing into @p out
+ */
+void vformat_to(format_sink& out, std::string_view fmt, format_args args);
+
+/**
+ * @brief Core implementation for pre-parsed segments
+ */
+void vformat_to(format_sink& out,
+                const format_segment* segments,
+                size_t count,
+                format_args args);
+
+/**
+ * @brief Output iterator and character limit of format_to_n()
+ */
+template<typename OutputIt>
+struct bounded_output
+{
+  OutputIt out;
+  size_t remaining;
+};
+
+template<typename OutputIt>
+void write_to_iterator(void* context, const char* data, size_t size)
+{
+  OutputIt& it = *static_cast<OutputIt*>(context);
+  it           = std::copy(data, data + size, it);
+}
+
+template<typename OutputIt>
+void write_to_bounded(void* context, const char* data, size_t size)
+{
+  auto& target = *static_cast<bounded_output<OutputIt>*>(context);
+  size_t count = size < target.remaining ? size : target.remaining;
+  target.out   = std::copy(data, data + count, target.out);
+  target.remaining -= count;
+}
+
+inline void write_nothing(void*, const char*, size_t)
+{
+}
+
 } // namespace detail
 
 // ============================================================================
@@ -285,8 +435,189 @@ std::string vformat(std::string_view fmt, format_args args);
 template<typename... Args>
 std::string format(std::string_view fmt, const Args&... args)
 {
-  detail::format_args_store<Args...> store(args...);
-  return detail::vformat(fmt, detail::format_args(store));
+  return detail::vformat(fmt, detail::make_format_args(args...));
+}
+
+/**
+ * @brief Format into an output iterator
+ *
+ * Same syntax and errors as format(), but the characters are written
+ * straight to @p out: no result string and no per-argument temporaries,
+ * so formatting into a caller-owned buffer does not allocate. On error
+ * the output written so far is left in place.
+ *
+ * @param out Output iterator accepting char
+ * @return Iterator past the last character written
+ *
+ * @example
+ *   char buffer[64];
+ *   char* end = format_to(buffer, "{}:{}", host, port);
+ *   format_to(std::back_inserter(log_line), "[{:>5}] ", level);
+ */
+template<typename OutputIt, typename... Args>
+OutputIt format_to(OutputIt out, std::string_view fmt, const Args&... args)
+{
+  format_sink sink(&out, detail::write_to_iterator<OutputIt>);
+  detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+  return out;
+}
+
+/**
+ * @brief Result of format_to_n()
+ */
+template<typename OutputIt>
+struct format_to_n_result
+{
+  OutputIt out; ///< Iterator past the last character written
+  size_t size;  ///< Length of the whole formatted output, untruncated
+};
+
+/**
+ * @brief Format into an output iterator, writing at most @p n characters
+ *
+ * The output is truncated to @p n characters; size in the result is the
+ * length the whole output would have had, so size > n means truncation.
+ *
+ * @example
+ *   char buffer[32];
+ *   auto result = format_to_n(buffer, sizeof(buffer) - 1, "{} {}", a, b);
+ *   *result.out = '\0';
+ */
+template<typename OutputIt, typename... Args>
+format_to_n_result<OutputIt>
+format_to_n(OutputIt out, size_t n, std::string_view fmt, const Args&... args)
+{
+  detail::bounded_output<OutputIt> bounded{out, n};
+  format_sink sink(&bounded, detail::write_to_bounded<OutputIt>);
+  detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+  return {bounded.out, sink.size()};
+}
+
+/**
+ * @brief Number of characters format() would produce, without writing them
+ *
+ * @example
+ *   buffer.resize(formatted_size("{:08x}", id));
+ */
+template<typename... Args>
+size_t formatted_size(std::string_view fmt, const Args&... args)
+{
+  format_sink sink(nullptr, detail::write_nothing);
+  detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+  return sink.size();
+}
+
+// ============================================================================
+// Compile-Time Format Strings
+// ============================================================================
+
+/**
+ * @brief Format string parsed and validated at compile time
+ *
+ * Created with FB_FORMAT_STRING. The segment list and every format_spec
+ * are computed by the compiler, so formatting only copies the literal
+ * segments and converts the arguments. An invalid format string, or one
+ * using more arguments than the call passes, fails to compile.
+ *
+ * @tparam Source Type with a static constexpr value() returning the string
+ */
+template<typename Source>
+struct compiled_format
+{
+  static constexpr std::string_view source = Source::value();
+  static constexpr detail::format_string_info info =
+      detail::analyze_format_string(source);
+  static constexpr std::array<detail::format_segment, info.segments> segments =
+      detail::parse_format_segments<info.segments>(source);
+};
+
+namespace detail
+{
+
+template<typename Source>
+constexpr compiled_format<Source> make_compiled_format(Source)
+{
+  return {};
+}
+
+template<typename Source, typename... Args>
+void vformat_to(format_sink& out,
+                compiled_format<Source>,
+                const format_args_store<Args...>& store)
+{
+  static_assert(compiled_format<Source>::info.arg_count <= sizeof...(Args),
+                "format string refers to more arguments than were passed");
+  const auto& segments = compiled_format<Source>::segments;
+  vformat_to(out, segments.data(), segments.size(), format_args(store));
+}
+
+} // namespace detail
+
+/**
+ * @brief Compile-time checked format string literal
+ *
+ * @example
+ *   format(FB_FORMAT_STRING("{:>8} {:.2f}"), name, price);
+ *   format(FB_FORMAT_STRING("{:"), 1);   // error: does not compile
+ *   format(FB_FORMAT_STRING("{} {}"), 1); // error: too few arguments
+ */
+#define FB_FORMAT_STRING(str)                                                  \
+  ::fb::detail::make_compiled_format([] {                                      \
+    struct fb_format_source                                                    \
+    {                                                                          \
+      static constexpr ::std::string_view value() { return str; }              \
+    };                                                                         \
+    return fb_format_source{};                                                 \
+  }())
+
+/**
+ * @brief format() with a compile-time parsed format string
+ */
+template<typename Source, typename... Args>
+std::string format(compiled_format<Source> fmt, const Args&... args)
+{
+  std::string result;
+  result.reserve(fmt.source.size() * 2);
+  format_sink sink(result);
+  detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+  return result;
+}
+
+/**
+ * @brief format_to() with a compile-time parsed format string
+ */
+template<typename OutputIt, typename Source, typename... Args>
+OutputIt format_to(OutputIt out, compiled_format<Source> fmt, const Args&... args)
+{
+  format_sink sink(&out, detail::write_to_iterator<OutputIt>);
+  detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+  return out;
+}
+
+/**
+ * @brief format_to_n() with a compile-time parsed format string
+ */
+template<typename OutputIt, typename Source, typename... Args>
+format_to_n_result<OutputIt> format_to_n(OutputIt out,
+                                         size_t n,
+                                         compiled_format<Source> fmt,
+                                         const Args&... args)
+{
+  detail::bounded_output<OutputIt> bounded{out, n};
+  format_sink sink(&bounded, detail::write_to_bounded<OutputIt>);
+  detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+  return {bounded.out, sink.size()};
+}
+
+/**
+ * @brief formatted_size() with a compile-time parsed format string
+ */
+template<typename Source, typename... Args>
+size_t formatted_size(compiled_format<Source> fmt, const Args&... args)
+{
+  format_sink sink(nullptr, detail::write_nothing);
+  detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+  return sink.size();
 }
 
 /**
@@ -312,6 +643,87 @@ std::optional<std::string> try_format(std::string_view fmt, const Args&... args)
   }
 }
 
+// ============================================================================
+// Format Specification Parsing
+// ============================================================================
+
+constexpr format_spec parse_format_spec(std::string_view spec)
+{
+  format_spec result;
+
+  if (spec.empty())
+  {
+    return result;
+  }
+
+  size_t pos = 0;
+
+  // Check for fill and alignment
+  // If the second character is an alignment character, the first is fill
+  if (spec.size() >= 2 &&
+      (spec[1] == '<' || spec[1] == '>' || spec[1] == '^'))
+  {
+    result.fill  = spec[0];
+    result.align = spec[1];
+    pos          = 2;
+  }
+  else if (!spec.empty() &&
+           (spec[0] == '<' || spec[0] == '>' || spec[0] == '^'))
+  {
+    result.align = spec[0];
+    pos          = 1;
+  }
+
+  // Sign
+  if (pos < spec.size() &&
+      (spec[pos] == '+' || spec[pos] == '-' || spec[pos] == ' '))
+  {
+    result.sign = spec[pos];
+    ++pos;
+  }
+
+  // Alternate form (#)
+  if (pos < spec.size() && spec[pos] == '#')
+  {
+    result.alt_form = true;
+    ++pos;
+  }
+
+  // Zero padding
+  if (pos < spec.size() && spec[pos] == '0')
+  {
+    result.zero_pad = true;
+    ++pos;
+  }
+
+  // Width
+  while (pos < spec.size() && spec[pos] >= '0' && spec[pos] <= '9')
+  {
+    result.width = result.width * 10 + (spec[pos] - '0');
+    ++pos;
+  }
+
+  // Precision
+  if (pos < spec.size() && spec[pos] == '.')
+  {
+    ++pos;
+    result.precision = 0;
+    while (pos < spec.size() && spec[pos] >= '0' && spec[pos] <= '9')
+    {
+      result.precision = result.precision * 10 + (spec[pos] - '0');
+      ++pos;
+    }
+  }
+
+  // Type
+  if (pos < spec.size())
+  {
+    result.type = spec[pos];
+  }
+
+  return result;
+}
+
 // ============================================================================
 // Implementation Details
 // ============================================================================
@@ -319,6 +731,126 @@ std::optional<std::string> try_format(std::string_view fmt, const Args&... args)
 namespace detail
 {
 
+constexpr format_segment next_format_segment(std::string_view fmt,
+                                             size_t& pos,
+                                             size_t& auto_index)
+{
+  format_segment segment;
+
+  // Find next '{' or '}'
+  size_t open         = fmt.find('{', pos);
+  size_t close_escape = fmt.find('}', pos);
+
+  // Handle '}}' that appears before any '{'
+  if (close_escape != std::string_view::npos &&
+      (open == std::string_view::npos || close_escape < open))
+  {
+    // Check for escaped '}}': keep the text and one '}'
+    if (close_escape + 1 < fmt.size() && fmt[close_escape + 1] == '}')
+    {
+      segment.literal = fmt.substr(pos, close_escape + 1 - pos);
+      pos             = close_escape + 2;
+      return segment;
+    }
+    throw std::invalid_argument("unmatched '}' in format string");
+  }
+
+  if (open == std::string_view::npos)
+  {
+    segment.literal = fmt.substr(pos);
+    pos             = fmt.size();
+    return segment;
+  }
+
+  // Text before '{'
+  if (open > pos)
+  {
+    segment.literal = fmt.substr(pos, open - pos);
+    pos             = open;
+    return segment;
+  }
+
+  // Check for escaped '{{'
+  if (open + 1 < fmt.size() && fmt[open + 1] == '{')
+  {
+    segment.literal = fmt.substr(open, 1);
+    pos             = open + 2;
+    return segment;
+  }
+
+  // Find closing '}'
+  size_t close = fmt.find('}', open);
+  if (close == std::string_view::npos)
+  {
+    throw std::invalid_argument("unmatched '{' in format string");
+  }
+
+  // Parse replacement field: [index][:spec]
+  std::string_view field = fmt.substr(open + 1, close - open - 1);
+  std::string_view index_part = field;
+  std::string_view spec;
+
+  size_t colon = field.find(':');
+  if (colon != std::string_view::npos)
+  {
+    index_part = field.substr(0, colon);
+    spec       = field.substr(colon + 1);
+  }
+
+  if (index_part.empty())
+  {
+    segment.arg_index = auto_index++;
+  }
+  else
+  {
+    for (char ch : index_part)
+    {
+      if (ch < '0' || ch > '9')
+      {
+        throw std::invalid_argument(colon != std::string_view::npos
+                                        ? "invalid format field index"
+                                        : "invalid format field");
+      }
+      segment.arg_index = segment.arg_index * 10 + static_cast<size_t>(ch - '0');
+    }
+  }
+
+  segment.is_field = true;
+  segment.spec     = parse_format_spec(spec);
+  pos              = close + 1;
+  return segment;
+}
+
+constexpr format_string_info analyze_format_string(std::string_view fmt)
+{
+  format_string_info info;
+  size_t pos        = 0;
+  size_t auto_index = 0;
+  while (pos < fmt.size())
+  {
+    format_segment segment = next_format_segment(fmt, pos, auto_index);
+    if (segment.is_field && segment.arg_index >= info.arg_count)
+    {
+      info.arg_count = segment.arg_index + 1;
+    }
+    ++info.segments;
+  }
+  return info;
+}
+
+template<size_t N>
+constexpr std::array<format_segment, N> parse_format_segments(std::string_view fmt)
+{
+  std::array<format_segment, N> segments{};
+  size_t pos        = 0;
+  size_t auto_index = 0;
+  for (size_t i = 0; i < N; ++i)
+  {
+    segments[i] = next_format_segment(fmt, pos, auto_index);
+  }
+  return segments;
+}
+
 // Helper to decay char arrays to const char*
 template<typename T>
 struct format_type_helper
@@ -341,22 +873,53 @@ struct format_type_helper<const char[N]>
 template<typename T>
 using format_type = typename format_type_helper<std::remove_cv_t<T>>::type;
 
+// Formatters may provide format(value, format_sink&) to write in place;
+// those with only std::string format(value) have the result appended
+template<typename Formatter, typename T, typename = void>
+struct has_sink_format : std::false_type
+{
+};
+
+template<typename Formatter, typename T>
+struct has_sink_format<
+    Formatter,
+    T,
+    std::void_t<decltype(std::declval<const Formatter&>().format(
+        std::declval<const T&>(), std::declval<format_sink&>()))>>
+  : std::true_type
+{
+};
+
+template<typename Formatter, typename T>
+void write_formatted(const Formatter& fmt, const T& value, format_sink& out)
+{
+  if constexpr (has_sink_format<Formatter, T>::value)
+  {
+    fmt.format(value, out);
+  }
+  else
+  {
+    out.append(fmt.format(value));
+  }
+}
+
 template<typename T>
 format_arg::format_arg(const T& value)
   : m_value(&value)
-  , m_format_fn([](const void* ptr, const format_spec& spec) -> std::string {
+  , m_format_fn([](const void* ptr, const format_spec& spec, format_sink& out) {
       using actual_type = format_type<T>;
       formatter<actual_type> fmt;
       fmt.m_spec = spec;
       if constexpr (std::is_array_v<T>)
       {
         // For char arrays, treat as const char*
-        return fmt.format(static_cast<const char*>(
-            static_cast<const void*>(ptr)));
+        write_formatted(fmt,
+                        static_cast<const char*>(ptr),
+                        out);
       }
       else
       {
-        return fmt.format(*static_cast<const T*>(ptr));
+        write_formatted(fmt, *static_cast<const T*>(ptr), out);
       }
     })
 {
@@ -0,0 +1,526 @@
+/// @file frozen_string_map.h
+/// @brief Immutable string-keyed maps on a minimal perfect hash
+///
+/// For key sets fixed at startup (FIX tag names, venue codes, currency
+/// codes) a minimal perfect hash gives every key its own slot in a table of
+/// exactly as many slots as keys. A lookup hashes the key once, reads one
+/// displacement, and compares against the single candidate: no probing and
+/// no chains, whether the key is present or not.
+///
+/// Two flavours share the construction:
+/// - frozen_string_map<T>: built at run time from a string_list (each key
+///   maps to its index) or from key/value pairs; hashes with XXH3
+/// - constexpr_string_map<T, N>: built at compile time from literal pairs
+///   by make_constexpr_string_map(); hashes with FNV-1a, which is constexpr
+///
+/// Construction is hash-and-displace: keys are spread over n/2 + 1 buckets,
+/// and each bucket, largest first, searches for a seed that sends all of
+/// its keys to free slots. Buckets with one key store their slot directly.
+///
+/// Thread Safety:
+/// - Immutable after construction; concurrent lookups are safe
+///
+/// Example:
+/// @code
+/// constexpr auto venues = fb::make_constexpr_string_map<int>({{"XNAS", 1}, {"XNYS", 2}, {"XLON", 3}});
+/// static_assert(*venues.find("XNYS") == 2);
+///
+/// const fb::frozen_string_map<std::uint32_t> tags(fb::string_list{"BeginString", "MsgType", "SenderCompID"});
+/// if (const std::uint32_t* id = tags.find(name))
+/// {
+///   // ...
+/// }
+/// @endcode
+
+#pragma once
+
+#include <fb/packed_string_list.h>
+#include <fb/string_hash.h>
+#include <fb/string_list.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace fb
+{
+
+namespace detail
+{
+
+/// Same value as hash_fnv1a_64(), usable in constant expressions
+constexpr std::uint64_t constexpr_fnv1a_64(std::string_view str) noexcept
+{
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : str)
+  {
+    hash ^= static_cast<std::uint8_t>(c);
+    hash *= 0x00000100000001B3ULL;
+  }
+  return hash;
+}
+
+constexpr std::size_t mph_bucket_count(std::size_t keys) noexcept
+{
+  return keys / 2 + 1;
+}
+
+/// Map @p x uniformly onto [0, n) without a division
+constexpr std::size_t mph_reduce(std::uint32_t x, std::size_t n) noexcept
+{
+  return static_cast<std::size_t>((static_cast<std::uint64_t>(x) * n) >> 32);
+}
+
+/// murmur3 finalizer: every input bit affects every output bit
+constexpr std::uint64_t mph_finalize(std::uint64_t hash) noexcept
+{
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/// Rehash @p hash with a bucket seed
+constexpr std::uint64_t mph_mix(std::uint64_t hash, std::uint32_t seed) noexcept
+{
+  return mph_finalize(hash + (static_cast<std::uint64_t>(seed) + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+/// Finalized first: FNV-1a leaves the high bits of short keys poorly mixed
+constexpr std::size_t mph_bucket(std::uint64_t hash, std::size_t buckets) noexcept
+{
+  return mph_reduce(static_cast<std::uint32_t>(mph_finalize(hash) >> 32), buckets);
+}
+
+/// Slot of a key with @p hash; a negative displacement is -(slot + 1)
+constexpr std::size_t mph_slot(std::uint64_t hash,
+                               const std::int32_t* displacements,
+                               std::size_t buckets,
+                               std::size_t keys) noexcept
+{
+  const std::int32_t d = displacements[mph_bucket(hash, buckets)];
+  if (d < 0)
+  {
+    return static_cast<std::size_t>(-(d + 1));
+  }
+  return mph_reduce(static_cast<std::uint32_t>(mph_mix(hash, static_cast<std::uint32_t>(d))), keys);
+}
+
+/// Caller-provided arrays for mph_build(), so that it needs no allocation
+struct mph_scratch
+{
+  std::uint32_t* bucket_start; ///< buckets + 1 entries
+  std::uint32_t* order;        ///< keys entries: key indices grouped by bucket
+  std::uint32_t* candidate;    ///< keys entries
+  bool*          used;         ///< keys entries, all false
+};
+
+/**
+ * @brief Build a minimal perfect hash over @p keys hashes
+ * @param displacements Output, mph_bucket_count(keys) entries
+ * @param slots Output, the slot of every key
+ * @return false if two keys have the same hash (typically duplicate keys)
+ */
+constexpr bool mph_build(const std::uint64_t* hashes,
+                         std::size_t keys,
+                         std::int32_t* displacements,
+                         std::uint32_t* slots,
+                         mph_scratch scratch)
+{
+  const std::size_t buckets = mph_bucket_count(keys);
+
+  // Group the keys by bucket (counting sort)
+  for (std::size_t b = 0; b <= buckets; ++b)
+  {
+    scratch.bucket_start[b] = 0;
+  }
+  for (std::size_t i = 0; i < keys; ++i)
+  {
+    ++scratch.bucket_start[mph_bucket(hashes[i], buckets) + 1];
+  }
+  std::size_t largest = 0;
+  for (std::size_t b = 0; b < buckets; ++b)
+  {
+    largest = std::max<std::size_t>(largest, scratch.bucket_start[b + 1]);
+    scratch.bucket_start[b + 1] += scratch.bucket_start[b];
+  }
+  for (std::size_t i = 0; i < keys; ++i)
+  {
+    scratch.order[scratch.bucket_start[mph_bucket(hashes[i], buckets)]++] = static_cast<std::uint32_t>(i);
+  }
+  for (std::size_t b = buckets; b > 0; --b)
+  {
+    scratch.bucket_start[b] = scratch.bucket_start[b - 1];
+  }
+  scratch.bucket_start[0] = 0;
+
+  // Keys with equal hashes can never be separated
+  for (std::size_t b = 0; b < buckets; ++b)
+  {
+    for (std::size_t i = scratch.bucket_start[b]; i < scratch.bucket_start[b + 1]; ++i)
+    {
+      for (std::size_t j = i + 1; j < scratch.bucket_start[b + 1]; ++j)
+      {
+        if (hashes[scratch.order[i]] == hashes[scratch.order[j]])
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  // Largest buckets first, while most slots are free
+  std::size_t next_free = 0;
+  for (std::size_t size = largest; size > 0; --size)
+  {
+    for (std::size_t b = 0; b < buckets; ++b)
+    {
+      const std::size_t first = scratch.bucket_start[b];
+      if (scratch.bucket_start[b + 1] - first != size)
+      {
+        continue;
+      }
+
+      if (size == 1)
+      {
+        while (scratch.used[next_free])
+        {
+          ++next_free;
+        }
+        scratch.used[next_free]     = true;
+        slots[scratch.order[first]] = static_cast<std::uint32_t>(next_free);
+        displacements[b]            = -static_cast<std::int32_t>(next_free) - 1;
+        continue;
+      }
+
+      for (std::uint32_t seed = 0;; ++seed)
+      {
+        std::size_t placed = 0;
+        for (; placed < size; ++placed)
+        {
+          const std::uint64_t mixed = mph_mix(hashes[scratch.order[first + placed]], seed);
+          const auto slot = static_cast<std::uint32_t>(mph_reduce(static_cast<std::uint32_t>(mixed), keys));
+          bool       taken = scratch.used[slot];
+          for (std::size_t k = 0; k < placed && !taken; ++k)
+          {
+            taken = scratch.candidate[k] == slot;
+          }
+          if (taken)
+          {
+            break;
+          }
+          scratch.candidate[placed] = slot;
+        }
+        if (placed == size)
+        {
+          for (std::size_t k = 0; k < size; ++k)
+          {
+            scratch.used[scratch.candidate[k]] = true;
+            slots[scratch.order[first + k]]    = scratch.candidate[k];
+          }
+          displacements[b] = static_cast<std::int32_t>(seed);
+          break;
+        }
+      }
+    }
+  }
+
+  // Empty buckets are never reached by a present key; any value will do
+  for (std::size_t b = 0; b < buckets; ++b)
+  {
+    if (scratch.bucket_start[b + 1] == scratch.bucket_start[b])
+    {
+      displacements[b] = 0;
+    }
+  }
+  return true;
+}
+
+} // namespace detail
+
+// ============================================================================
+// Runtime Map
+// ============================================================================
+
+/// @brief Immutable map from strings to T, built at run time
+template<typename T>
+class frozen_string_map
+{
+public:
+  using key_type    = std::string_view;
+  using mapped_type = T;
+  using size_type   = std::size_t;
+
+  frozen_string_map() = default;
+
+  /// @throws std::invalid_argument on duplicate keys
+  frozen_string_map(std::initializer_list<std::pair<std::string_view, T>> init)
+    : frozen_string_map(init.begin(), init.end())
+  {
+  }
+
+  /// @brief Map keys[i] to i
+  /// @throws std::invalid_argument on duplicate keys
+  explicit frozen_string_map(const string_list& keys)
+  {
+    std::vector<std::string_view> views(keys.begin(), keys.end());
+    std::vector<T>                values;
+    values.reserve(keys.size());
+    for (size_type i = 0; i < keys.size(); ++i)
+    {
+      values.push_back(static_cast<T>(i));
+    }
+    build(views, std::move(values));
+  }
+
+  /// @brief Build from a range of key/value pairs
+  /// @throws std::invalid_argument on duplicate keys
+  template<typename InputIt>
+  frozen_string_map(InputIt first, InputIt last)
+  {
+    std::vector<std::string_view> views;
+    std::vector<T>                values;
+    for (; first != last; ++first)
+    {
+      views.push_back(std::string_view(first->first));
+      values.push_back(first->second);
+    }
+    build(views, std::move(values));
+  }
+
+  /// @brief Value of @p key, nullptr if absent
+  [[nodiscard]] const T* find(std::string_view key) const noexcept
+  {
+    if (m_values.empty())
+    {
+      return nullptr;
+    }
+    const std::uint64_t hash = hash_xxh3_64(key, m_seed);
+    const std::size_t   slot = detail::mph_slot(hash, m_displacements.data(), m_displacements.size(), m_values.size());
+    return m_keys[slot] == key ? &m_values[slot] : nullptr;
+  }
+
+  [[nodiscard]] bool contains(std::string_view key) const noexcept
+  {
+    return find(key) != nullptr;
+  }
+
+  /// @throws std::out_of_range if @p key is absent
+  [[nodiscard]] const T& at(std::string_view key) const
+  {
+    const T* value = find(key);
+    if (value == nullptr)
+    {
+      throw std::out_of_range("frozen_string_map::at: key not found");
+    }
+    return *value;
+  }
+
+  [[nodiscard]] size_type size() const noexcept
+  {
+    return m_values.size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_values.empty();
+  }
+
+  /// @brief Keys, in slot order
+  [[nodiscard]] const packed_string_list& keys() const noexcept
+  {
+    return m_keys;
+  }
+
+private:
+  void build(const std::vector<std::string_view>& keys, std::vector<T> values)
+  {
+    const size_type n = keys.size();
+    if (n > static_cast<size_type>(std::numeric_limits<std::int32_t>::max()))
+    {
+      throw std::length_error("frozen_string_map: too many keys");
+    }
+
+    std::vector<std::uint64_t> hashes(n);
+    std::vector<std::uint32_t> slots(n);
+    std::vector<std::uint32_t> bucket_start(detail::mph_bucket_count(n) + 1);
+    std::vector<std::uint32_t> order(n);
+    std::vector<std::uint32_t> candidate(n);
+    std::unique_ptr<bool[]>    used;
+    m_displacements.assign(detail::mph_bucket_count(n), 0);
+
+    // A failure is either a duplicate key or a 64-bit collision; only the
+    // latter goes away with another seed
+    for (bool checked = false;; ++m_seed)
+    {
+      for (size_type i = 0; i < n; ++i)
+      {
+        hashes[i] = hash_xxh3_64(keys[i], m_seed);
+      }
+      used = std::make_unique<bool[]>(n);
+      const detail::mph_scratch scratch{bucket_start.data(), order.data(), candidate.data(), used.get()};
+      if (detail::mph_build(hashes.data(), n, m_displacements.data(), slots.data(), scratch))
+      {
+        break;
+      }
+      if (!checked)
+      {
+        std::vector<std::string_view> sorted(keys);
+        std::sort(sorted.begin(), sorted.end());
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+        {
+          throw std::invalid_argument("frozen_string_map: duplicate key");
+        }
+        checked = true;
+      }
+    }
+
+    std::vector<std::uint32_t> key_at(n);
+    for (size_type i = 0; i < n; ++i)
+    {
+      key_at[slots[i]] = static_cast<std::uint32_t>(i);
+    }
+    size_type bytes = 0;
+    for (std::string_view key : keys)
+    {
+      bytes += key.size();
+    }
+    m_keys.reserve(n, bytes);
+    m_values.reserve(n);
+    for (size_type s = 0; s < n; ++s)
+    {
+      m_keys.push_back(keys[key_at[s]]);
+      m_values.push_back(std::move(values[key_at[s]]));
+    }
+  }
+
+  std::uint64_t             m_seed = 0;
+  std::vector<std::int32_t> m_displacements;
+  packed_string_list        m_keys;   ///< Key of each slot
+  std::vector<T>            m_values; ///< Value of each slot
+};
+
+// ============================================================================
+// Compile-Time Map
+// ============================================================================
+
+/// @brief Immutable map from N string literals to T, built by
+///        make_constexpr_string_map()
+///
+/// Lookups are constexpr too, and work the same at run time. Keys are
+/// std::string_view and must outlive the map, as literals do.
+template<typename T, std::size_t N>
+class constexpr_string_map
+{
+public:
+  using key_type    = std::string_view;
+  using mapped_type = T;
+  using size_type   = std::size_t;
+
+  /// @brief Value of @p key, nullptr if absent
+  [[nodiscard]] constexpr const T* find(std::string_view key) const noexcept
+  {
+    if (N == 0)
+    {
+      return nullptr;
+    }
+    const std::uint64_t hash = detail::constexpr_fnv1a_64(key);
+    const std::size_t   slot = detail::mph_slot(hash, m_displacements.data(), BUCKETS, N);
+    return m_keys[slot] == key ? &m_values[slot] : nullptr;
+  }
+
+  [[nodiscard]] constexpr bool contains(std::string_view key) const noexcept
+  {
+    return find(key) != nullptr;
+  }
+
+  /// @throws std::out_of_range if @p key is absent
+  [[nodiscard]] constexpr const T& at(std::string_view key) const
+  {
+    const T* value = find(key);
+    if (value == nullptr)
+    {
+      throw std::out_of_range("constexpr_string_map::at: key not found");
+    }
+    return *value;
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept
+  {
+    return N;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept
+  {
+    return N == 0;
+  }
+
+  /// @brief Keys, in slot order
+  [[nodiscard]] constexpr const std::array<std::string_view, N>& keys() const noexcept
+  {
+    return m_keys;
+  }
+
+private:
+  static constexpr std::size_t BUCKETS = detail::mph_bucket_count(N);
+
+  template<typename U, std::size_t M>
+  friend constexpr constexpr_string_map<U, M>
+  make_constexpr_string_map(const std::pair<std::string_view, U> (&entries)[M]);
+
+  std::array<std::int32_t, BUCKETS> m_displacements{};
+  std::array<std::string_view, N>   m_keys{};
+  std::array<T, N>                  m_values{};
+};
+
+/**
+ * @brief Build a constexpr_string_map from literal key/value pairs
+ *
+ * Duplicate keys make constant evaluation fail (std::invalid_argument at
+ * run time).
+ *
+ * @code
+ * constexpr auto sides = fb::make_constexpr_string_map<char>({{"BUY", '1'}, {"SELL", '2'}});
+ * @endcode
+ */
+template<typename T, std::size_t N>
+constexpr constexpr_string_map<T, N> make_constexpr_string_map(const std::pair<std::string_view, T> (&entries)[N])
+{
+  constexpr std::size_t buckets = detail::mph_bucket_count(N);
+
+  std::array<std::uint64_t, N>           hashes{};
+  std::array<std::uint32_t, N>           slots{};
+  std::array<std::uint32_t, buckets + 1> bucket_start{};
+  std::array<std::uint32_t, N>           order{};
+  std::array<std::uint32_t, N>           candidate{};
+  std::array<bool, N>                    used{};
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    hashes[i] = detail::constexpr_fnv1a_64(entries[i].first);
+  }
+
+  constexpr_string_map<T, N> map;
+  const detail::mph_scratch  scratch{bucket_start.data(), order.data(), candidate.data(), used.data()};
+  if (!detail::mph_build(hashes.data(), N, map.m_displacements.data(), slots.data(), scratch))
+  {
+    throw std::invalid_argument("make_constexpr_string_map: duplicate key");
+  }
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    map.m_keys[slots[i]]   = entries[i].first;
+    map.m_values[slots[i]] = entries[i].second;
+  }
+  return map;
+}
+
+} // namespace fb
@@ -0,0 +1,210 @@
+/// @file inline_string_builder.h
+/// @brief Fixed-capacity string builder backed by an inline buffer
+///
+/// string_builder allocates as soon as its content outgrows the small
+/// string buffer. An inline_string_builder<N> writes into a char[N] that
+/// lives inside the object, usually on the stack, so formatting a log line
+/// or a wire message performs no allocation at all while it fits. What
+/// happens on overflow is a policy:
+///
+/// - inline_overflow::spill copies the content to a heap buffer and goes on
+///   there, so nothing is lost
+/// - inline_overflow::truncate keeps the first N bytes, drops the rest and
+///   sets truncated(); it never allocates
+///
+/// Features:
+/// - The append*, operator<< and append_format API of string_builder
+/// - view() and a NUL-terminated c_str() without copying
+/// - The formatting code is compiled once, in inline_string_builder_base;
+///   the template only adds the storage
+///
+/// Thread Safety:
+/// - inline_string_builder is NOT thread-safe
+///
+/// Example:
+/// @code
+/// fb::inline_string_builder<256> line;
+/// line.append_format("{} {}@{:.2f}", side, symbol, price) << " qty=" << quantity;
+/// write(fd, line.view().data(), line.size());
+///
+/// fb::inline_string_builder<64, fb::inline_overflow::truncate> tag;
+/// tag << user_supplied;  // At most 64 bytes, never allocates
+/// @endcode
+
+#pragma once
+
+#include "format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace fb {
+
+/// @brief What an inline_string_builder does with content past its capacity
+enum class inline_overflow
+{
+  spill,   ///< Move to a heap buffer and keep everything
+  truncate ///< Keep what fits, drop the rest
+};
+
+/**
+ * @brief Formatting logic of inline_string_builder, independent of the capacity
+ *
+ * Not constructible on its own; takes the inline storage of the derived
+ * builder. Functions written against inline_string_builder_base& accept a
+ * builder of any capacity.
+ */
+class inline_string_builder_base
+{
+public:
+  // Holds a pointer into the derived object's storage
+  inline_string_builder_base(const inline_string_builder_base&)            = delete;
+  inline_string_builder_base& operator=(const inline_string_builder_base&) = delete;
+
+  // ============================================================================
+  //  Append Operations
+  // ============================================================================
+
+  inline_string_builder_base& append(std::string_view str);
+  inline_string_builder_base& append(const char* str);
+  inline_string_builder_base& append(char c);
+  inline_string_builder_base& append(char c, std::size_t count);
+  inline_string_builder_base& append_line(std::string_view str = "");
+
+  inline_string_builder_base& append_int(std::int32_t value);
+  inline_string_builder_base& append_int(std::int64_t value);
+  inline_string_builder_base& append_uint(std::uint32_t value);
+  inline_string_builder_base& append_uint(std::uint64_t value);
+  inline_string_builder_base& append_double(double value, int precision = 6);
+  inline_string_builder_base& append_bool(bool value);
+
+  /// @brief Append @p str escaped for a JSON string value, as json_escape() does
+  inline_string_builder_base& append_json_escaped(std::string_view str);
+
+  /// @brief Append @p str with & < > " ' replaced by entities, as html_escape() does
+  inline_string_builder_base& append_html_escaped(std::string_view str);
+
+  // ============================================================================
+  // Stream Operators
+  // ============================================================================
+
+  inline_string_builder_base& operator<<(std::string_view str);
+  inline_string_builder_base& operator<<(char c);
+  inline_string_builder_base& operator<<(const char* str);
+  inline_string_builder_base& operator<<(std::int32_t value);
+  inline_string_builder_base& operator<<(std::int64_t value);
+  inline_string_builder_base& operator<<(std::uint32_t value);
+  inline_string_builder_base& operator<<(std::uint64_t value);
+  inline_string_builder_base& operator<<(double value);
+  inline_string_builder_base& operator<<(bool value);
+
+  // ============================================================================
+  // Output Methods
+  // ============================================================================
+
+  [[nodiscard]] std::string to_string() const;
+  [[nodiscard]] std::string_view view() const noexcept;
+
+  /// @brief The content, NUL-terminated
+  [[nodiscard]] const char* c_str() const noexcept;
+
+  // ============================================================================
+  // Management Methods
+  // ============================================================================
+
+  /// @brief Clear the content and the truncated() flag; a heap buffer is kept
+  inline_string_builder_base& clear() noexcept;
+
+  [[nodiscard]] std::size_t size() const noexcept;
+  [[nodiscard]] std::size_t capacity() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+
+  /// @brief Whether the content moved to the heap (spill policy only)
+  [[nodiscard]] bool spilled() const noexcept;
+
+  /// @brief Whether content was dropped since the last clear() (truncate policy only)
+  [[nodiscard]] bool truncated() const noexcept;
+
+  /** @brief Append a formatted string
+   *
+   * Uses the fb::format system, writing straight into the buffer.
+   *
+   * @tparam Args Types of format arguments
+   * @param fmt Format string
+   * @param args Format arguments
+   * @return Reference to this builder for chaining
+   */
+  template <typename... Args>
+  inline_string_builder_base& append_format(std::string_view fmt, Args&&... args)
+  {
+    format_sink sink(this, &write_to);
+    detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+    return *this;
+  }
+
+  /** @brief Append a string formatted with a FB_FORMAT_STRING format */
+  template <typename Source, typename... Args>
+  inline_string_builder_base& append_format(compiled_format<Source> fmt, Args&&... args)
+  {
+    format_sink sink(this, &write_to);
+    detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+    return *this;
+  }
+
+protected:
+  /// @param storage capacity + 1 bytes, the last one for the terminator
+  inline_string_builder_base(char* storage, std::size_t capacity, inline_overflow policy) noexcept;
+  ~inline_string_builder_base() = default;
+
+private:
+  static void write_to(void* builder, const char* data, std::size_t size);
+
+  /// Every append ends here: copy inline, spill or truncate
+  void write(const char* data, std::size_t size);
+
+  char*           m_storage;
+  std::size_t     m_size = 0;
+  std::size_t     m_capacity;
+  inline_overflow m_policy;
+  bool            m_spilled   = false;
+  bool            m_truncated = false;
+  std::string     m_heap; ///< Content once spilled
+};
+
+/**
+ * @brief String builder writing into an inline char[N]
+ *
+ * @tparam N Bytes that fit without allocating
+ * @tparam Policy What to do with content past N bytes
+ */
+template <std::size_t N, inline_overflow Policy = inline_overflow::spill>
+class inline_string_builder : public inline_string_builder_base
+{
+public:
+  static_assert(N > 0, "inline_string_builder needs a nonzero capacity");
+
+  inline_string_builder() noexcept
+    : inline_string_builder_base(m_buffer, N, Policy)
+  {
+    m_buffer[0] = '\0';
+  }
+
+  explicit inline_string_builder(std::string_view initial)
+    : inline_string_builder()
+  {
+    append(initial);
+  }
+
+  /// @brief Bytes that fit without allocating or truncating
+  static constexpr std::size_t inline_capacity() noexcept
+  {
+    return N;
+  }
+
+private:
+  char m_buffer[N + 1]; ///< Left uninitialized past the content
+};
+
+} // namespace fb
@@ -0,0 +1,149 @@
+/// @file multi_pattern.h
+/// @brief Aho-Corasick matcher for searching many needles in one pass
+///
+/// fb::contains(), replace_all() and remove_all() take one needle per call,
+/// so applying 200 redaction patterns to a line means 200 passes over it. A
+/// multi_pattern compiles all the needles into one automaton and then
+/// searches, or replaces, every needle in a single pass over the input,
+/// whatever the number of needles.
+///
+/// Matches are leftmost-longest and never overlap: of the needles found at
+/// the leftmost position, the longest wins, and the search resumes after
+/// it. This is what replace_all() does for a single needle.
+///
+/// Features:
+/// - Dense automaton over byte classes: one table lookup per input byte
+/// - When the needles start with at most 8 distinct bytes, the text between
+///   candidate positions is skipped with the vectorized simd::find_any()
+/// - Empty needles never match; duplicate needles report the first index
+///
+/// Thread Safety:
+/// - Immutable after construction; concurrent searches are safe
+///
+/// Example:
+/// @code
+/// const fb::multi_pattern secrets{"password=", "token=", "ssn="};
+/// if (secrets.contains_any(line))
+/// {
+///   line = secrets.replace_many(line, "[REDACTED]");
+/// }
+/// @endcode
+
+#pragma once
+
+#include <fb/packed_string_list.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fb
+{
+
+class string_list;
+
+class multi_pattern
+{
+public:
+  /// @brief One occurrence of a needle
+  struct match
+  {
+    std::size_t position; ///< Offset in the searched text
+    std::size_t length;   ///< Length of the needle
+    std::size_t pattern;  ///< Index of the needle, in construction order
+
+    bool operator==(const match& other) const noexcept
+    {
+      return position == other.position && length == other.length && pattern == other.pattern;
+    }
+  };
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  multi_pattern();
+  multi_pattern(std::initializer_list<std::string_view> needles);
+  explicit multi_pattern(const string_list& needles);
+
+  /// @brief Compile a range of anything convertible to std::string_view
+  template<typename InputIt>
+  multi_pattern(InputIt first, InputIt last);
+
+  // ========================================================================
+  // Search
+  // ========================================================================
+
+  /// @brief Leftmost-longest match starting at or after @p pos
+  [[nodiscard]] std::optional<match> find_any(std::string_view text, std::size_t pos = 0) const noexcept;
+
+  /// @brief Whether any needle occurs in @p text; stops at the first one
+  [[nodiscard]] bool contains_any(std::string_view text) const noexcept;
+
+  /// @brief Every non-overlapping leftmost-longest match, in order
+  [[nodiscard]] std::vector<match> find_all(std::string_view text) const;
+
+  /// @brief Number of non-overlapping matches
+  [[nodiscard]] std::size_t count(std::string_view text) const noexcept;
+
+  // ========================================================================
+  // Replacement
+  // ========================================================================
+
+  /// @brief Replace every match with @p replacement ("" removes them)
+  [[nodiscard]] std::string replace_many(std::string_view text, std::string_view replacement) const;
+
+  /// @brief Replace a match of needle i with replacements[i]
+  /// @throws std::invalid_argument unless there is one replacement per needle
+  [[nodiscard]] std::string replace_many(std::string_view text,
+                                         const std::vector<std::string_view>& replacements) const;
+
+  // ========================================================================
+  // Patterns
+  // ========================================================================
+
+  /// @brief Number of needles, including empty ones
+  [[nodiscard]] std::size_t size() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] std::string_view pattern(std::size_t index) const noexcept;
+
+  /// @brief Number of automaton states
+  [[nodiscard]] std::size_t state_count() const noexcept;
+
+private:
+  void compile();
+
+  template<typename Emit>
+  void for_each_match(std::string_view text, Emit&& emit) const;
+
+  packed_string_list m_patterns;
+
+  // Dense automaton: m_transitions[state * m_classes + m_byte_class[byte]]
+  std::uint8_t               m_byte_class[256] = {};
+  std::size_t                m_classes         = 1;
+  std::vector<std::int32_t>  m_transitions;
+  std::vector<std::uint32_t> m_depth;          ///< Length of the string a state stands for
+  std::vector<std::int32_t>  m_output;         ///< Longest needle ending here, or -1
+  std::vector<std::uint32_t> m_output_length;
+  std::string                m_first_bytes;    ///< Prefilter set, empty when too large
+};
+
+// ============================================================================
+// Template Implementations
+// ============================================================================
+
+template<typename InputIt>
+multi_pattern::multi_pattern(InputIt first, InputIt last)
+{
+  for (; first != last; ++first)
+  {
+    m_patterns.push_back(std::string_view(*first));
+  }
+  compile();
+}
+
+} // namespace fb
@@ -0,0 +1,382 @@
+/// @file packed_string_list.h
+/// @brief A string_list variant storing every string in one arena buffer
+///
+/// packed_string_list keeps the characters of all its elements back to back
+/// in a single buffer, plus an 8-byte offset/length entry per element. A
+/// million short tokens cost two allocations instead of a million, less
+/// than half the memory of std::vector<std::string>, and sort(), contains()
+/// and join() walk contiguous memory.
+///
+/// Elements are exposed as std::string_view. They cannot be modified in
+/// place: the list grows with push_back(), and reordering operations such as
+/// sort() or reverse() only move entries, never characters.
+///
+/// Features:
+/// - from_split() and from_lines() copy the input once and index it
+/// - The read-only and list operations of string_list
+/// - Conversion to and from string_list
+///
+/// Limits:
+/// - At most 4 GiB of characters per list (std::length_error beyond)
+/// - Views are invalidated by push_back(), compact() and shrink_to_fit()
+///
+/// Thread Safety:
+/// - packed_string_list is NOT thread-safe
+/// - Concurrent reads of a list nobody modifies are safe
+///
+/// Example:
+/// @code
+/// auto symbols = fb::packed_string_list::from_lines(universe_file);
+/// symbols.remove_empty().sort().unique();
+/// bool listed = symbols.contains("EURUSD");
+/// @endcode
+
+#pragma once
+
+#include <fb/string_pipeline.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fb
+{
+
+class string_list;
+
+class packed_string_list
+{
+  /// Position of one element in m_bytes
+  struct entry
+  {
+    std::uint32_t offset;
+    std::uint32_t length;
+  };
+
+public:
+  // ========================================================================
+  // Type Definitions
+  // ========================================================================
+
+  using value_type      = std::string_view;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference       = std::string_view;
+  using const_reference = std::string_view;
+
+  /// @brief Random-access iterator yielding std::string_view by value
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = std::string_view;
+    using pointer           = void;
+
+    const_iterator() = default;
+
+    std::string_view operator*() const noexcept
+    {
+      return std::string_view(m_bytes + m_entry->offset, m_entry->length);
+    }
+
+    std::string_view operator[](difference_type n) const noexcept
+    {
+      return *(*this + n);
+    }
+
+    const_iterator& operator++() noexcept
+    {
+      ++m_entry;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept
+    {
+      const_iterator previous = *this;
+      ++m_entry;
+      return previous;
+    }
+
+    const_iterator& operator--() noexcept
+    {
+      --m_entry;
+      return *this;
+    }
+
+    const_iterator operator--(int) noexcept
+    {
+      const_iterator previous = *this;
+      --m_entry;
+      return previous;
+    }
+
+    const_iterator& operator+=(difference_type n) noexcept
+    {
+      m_entry += n;
+      return *this;
+    }
+
+    const_iterator& operator-=(difference_type n) noexcept
+    {
+      m_entry -= n;
+      return *this;
+    }
+
+    friend const_iterator operator+(const_iterator it, difference_type n) noexcept
+    {
+      return it += n;
+    }
+
+    friend const_iterator operator+(difference_type n, const_iterator it) noexcept
+    {
+      return it += n;
+    }
+
+    friend const_iterator operator-(const_iterator it, difference_type n) noexcept
+    {
+      return it -= n;
+    }
+
+    friend difference_type operator-(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_entry - b.m_entry;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_entry == b.m_entry;
+    }
+
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_entry != b.m_entry;
+    }
+
+    friend bool operator<(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_entry < b.m_entry;
+    }
+
+    friend bool operator>(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_entry > b.m_entry;
+    }
+
+    friend bool operator<=(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_entry <= b.m_entry;
+    }
+
+    friend bool operator>=(const const_iterator& a, const const_iterator& b) noexcept
+    {
+      return a.m_entry >= b.m_entry;
+    }
+
+  private:
+    friend class packed_string_list;
+
+    const_iterator(const entry* position, const char* bytes) noexcept
+      : m_entry(position)
+      , m_bytes(bytes)
+    {
+    }
+
+    const entry* m_entry = nullptr;
+    const char*  m_bytes = nullptr;
+  };
+
+  using iterator               = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator       = const_reverse_iterator;
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  packed_string_list() = default;
+  packed_string_list(std::initializer_list<std::string_view> init);
+  explicit packed_string_list(const string_list& list);
+  explicit packed_string_list(const std::vector<std::string>& vec);
+
+  template<typename InputIt>
+  packed_string_list(InputIt first, InputIt last);
+
+  // ========================================================================
+  // Factory Methods
+  // ========================================================================
+
+  // Copy the input into the arena once and index the parts in place; the
+  // delimiters stay in the arena until compact()
+
+  static packed_string_list from_split(std::string_view str,
+                                       char delimiter,
+                                       bool keep_empty = true);
+
+  static packed_string_list from_split(std::string_view str,
+                                       std::string_view delimiter,
+                                       bool keep_empty = true);
+
+  static packed_string_list from_lines(std::string_view str, bool keep_empty = true);
+
+  // ========================================================================
+  // Element Access
+  // ========================================================================
+
+  [[nodiscard]] std::string_view at(size_type index) const;
+  [[nodiscard]] std::string_view operator[](size_type index) const noexcept;
+  [[nodiscard]] std::string_view front() const noexcept;
+  [[nodiscard]] std::string_view back() const noexcept;
+
+  // ========================================================================
+  // Iterators
+  // ========================================================================
+
+  const_iterator begin() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator end() const noexcept;
+  const_iterator cend() const noexcept;
+
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator crbegin() const noexcept;
+  const_reverse_iterator rend() const noexcept;
+  const_reverse_iterator crend() const noexcept;
+
+  // ========================================================================
+  // Capacity
+  // ========================================================================
+
+  [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] size_type size() const noexcept;
+
+  /// @brief Characters in the arena, including any no element refers to
+  [[nodiscard]] size_type bytes() const noexcept;
+
+  /// @brief Reserve room for @p count elements and @p bytes characters
+  void reserve(size_type count, size_type bytes = 0);
+
+  /// @brief compact(), then release unused capacity
+  void shrink_to_fit();
+
+  // ========================================================================
+  // Modifiers
+  // ========================================================================
+
+  void clear() noexcept;
+
+  /// @brief Append a copy of @p value; it may point into this list
+  void push_back(std::string_view value);
+  void pop_back() noexcept;
+  void swap(packed_string_list& other) noexcept;
+
+  /// @brief Rewrite the arena in element order, dropping characters no
+  ///        element refers to (delimiters, removed or duplicate elements)
+  void compact();
+
+  // ========================================================================
+  // String List Operations
+  // ========================================================================
+
+  [[nodiscard]] std::string join(std::string_view delimiter) const;
+  [[nodiscard]] std::string join(char delimiter) const;
+  [[nodiscard]] std::string join() const;
+
+  [[nodiscard]] packed_string_list filter(std::function<bool(std::string_view)> predicate) const;
+  [[nodiscard]] packed_string_list filter_containing(std::string_view substr) const;
+  [[nodiscard]] packed_string_list filter_starts_with(std::string_view prefix) const;
+  [[nodiscard]] packed_string_list filter_ends_with(std::string_view suffix) const;
+
+  /// @brief Lazy pipeline over this list; see string_pipeline.h
+  [[nodiscard]] string_pipeline<packed_string_list> view() const noexcept;
+
+  // ========================================================================
+  // Search Operations
+  // ========================================================================
+
+  [[nodiscard]] bool contains(std::string_view str) const noexcept;
+  [[nodiscard]] bool contains_ignore_case(std::string_view str) const noexcept;
+  [[nodiscard]] std::optional<size_type> index_of(std::string_view str) const noexcept;
+  [[nodiscard]] std::optional<size_type> last_index_of(std::string_view str) const noexcept;
+  [[nodiscard]] size_type count(std::string_view str) const noexcept;
+
+  // ========================================================================
+  // Sorting and Ordering
+  // ========================================================================
+
+  packed_string_list& sort();
+  packed_string_list& sort(std::function<bool(std::string_view, std::string_view)> comp);
+  packed_string_list& sort_ignore_case();
+  packed_string_list& sort_natural();
+  packed_string_list& reverse();
+  packed_string_list& unique();
+
+  // ========================================================================
+  // Utility Operations
+  // ========================================================================
+
+  packed_string_list& remove_empty();
+  packed_string_list& remove_duplicates();
+
+  [[nodiscard]] packed_string_list take(size_type n) const;
+  [[nodiscard]] packed_string_list skip(size_type n) const;
+  [[nodiscard]] packed_string_list take_last(size_type n) const;
+  [[nodiscard]] packed_string_list slice(size_type start, size_type end) const;
+
+  // ========================================================================
+  // Conversion
+  // ========================================================================
+
+  [[nodiscard]] string_list to_string_list() const;
+  [[nodiscard]] std::vector<std::string_view> to_views() const;
+
+  // ========================================================================
+  // Operators
+  // ========================================================================
+
+  bool operator==(const packed_string_list& other) const noexcept;
+  bool operator!=(const packed_string_list& other) const noexcept;
+
+private:
+  std::string_view view(const entry& e) const noexcept
+  {
+    return std::string_view(m_bytes.data() + e.offset, e.length);
+  }
+
+  /// Index the parts of @p source, already copied to the start of m_bytes
+  void index_parts(std::string_view source, const std::vector<std::string_view>& parts);
+
+  /// New list holding copies of entries [first, last)
+  packed_string_list copy_range(const entry* first, const entry* last) const;
+
+  std::string        m_bytes;
+  std::vector<entry> m_entries;
+};
+
+// ============================================================================
+// Template Implementations
+// ============================================================================
+
+/// Lazy pipeline over this list
+inline string_pipeline<packed_string_list> packed_string_list::view() const noexcept
+{
+  return string_pipeline<packed_string_list>(*this);
+}
+
+/// Construct from a range of anything convertible to std::string_view
+template<typename InputIt>
+packed_string_list::packed_string_list(InputIt first, InputIt last)
+{
+  for (; first != last; ++first)
+  {
+    push_back(std::string_view(*first));
+  }
+}
+
+} // namespace fb
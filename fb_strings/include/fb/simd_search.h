@@ -0,0 +1,195 @@
+/// @file simd_search.h
+/// @brief Vectorized byte and substring search and UTF-8 validation kernels with runtime dispatch
+///
+/// Building blocks behind split_any, find_any, is_ascii, is_valid_utf8,
+/// contains, count, replace_all, json_escape, html_escape, the ASCII case
+/// conversions, word_count, split_whitespace and the string iterators. Each kernel has SSE2, AVX2 and
+/// NEON versions and a scalar fallback; the best one the CPU supports is
+/// picked on first use (AVX2 when available on x86-64, SSE2 otherwise,
+/// NEON on AArch64).
+///
+/// Finding a single character is left to memchr, which the C library
+/// already vectorizes.
+///
+/// Thread Safety:
+/// - All kernels are thread-safe
+/// - select_isa() is meant for tests and benchmarks
+///
+/// Example:
+/// @code
+/// std::string_view message = "35=D\x01" "55=ABC\x01";
+/// std::size_t end = fb::simd::find_any(message, "\x01|");  // 4
+/// std::size_t tag = fb::simd::find(message, "55=");        // 5
+/// bool plain      = fb::simd::is_ascii(message);           // true
+/// std::size_t n   = fb::simd::count_words(" a bc\td ");    // 3
+/// @endcode
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace fb
+{
+namespace simd
+{
+
+/// @brief Instruction set of a kernel implementation
+enum class isa
+{
+  scalar,
+  sse2,
+  avx2,
+  neon
+};
+
+/**
+ * @brief Find the first character of @p str, from @p pos, that is in @p set
+ *
+ * Same result as std::string_view::find_first_of. Sets of up to 8
+ * characters are matched 16 or 32 bytes at a time; larger sets use a
+ * lookup table.
+ *
+ * @return Index of the character, or std::string_view::npos
+ */
+std::size_t find_any(std::string_view str, std::string_view set, std::size_t pos = 0) noexcept;
+
+/**
+ * @brief Find the first occurrence of @p needle in @p str, from @p pos
+ *
+ * Same result as std::string_view::find. Each block of candidate positions
+ * is filtered by comparing the needle's first and last bytes 16 or 32
+ * positions at a time, so a common first byte, such as the quote in
+ * "\",\"" inside a CSV blob, does not force a comparison at every
+ * occurrence; only positions where both bytes match are compared in full.
+ *
+ * @return Index of the occurrence, or std::string_view::npos
+ */
+std::size_t find(std::string_view str, std::string_view needle, std::size_t pos = 0) noexcept;
+
+/**
+ * @brief Find the first byte of @p str, from @p pos, that a JSON string
+ *        must escape: '"', '\\' or a control character below 0x20
+ *
+ * The control characters are a range, which find_any() would need a
+ * 34-character set for; this kernel checks the range with one compare.
+ *
+ * @return Index of the byte, or std::string_view::npos
+ */
+std::size_t find_json_escape(std::string_view str, std::size_t pos = 0) noexcept;
+
+/// @brief Bit k of each mask describes byte k of a block of up to 64 bytes
+struct block_masks
+{
+  std::uint64_t whitespace;      ///< ' ', \t, \n, \v, \f or \r
+  std::uint64_t line_feed;       ///< \n
+  std::uint64_t carriage_return; ///< \r
+};
+
+/// Bytes classified by one classify() call
+inline constexpr std::size_t MASK_BLOCK = 64;
+
+/// @brief Index of the lowest set bit of @p mask, for walking block_masks
+/// @pre mask != 0
+inline unsigned lowest_bit(std::uint64_t mask) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index = 0;
+  _BitScanForward64(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+/**
+ * @brief Classify the first min(@p size, 64) bytes at @p data
+ *
+ * The kernel for whitespace and line scanning: parsers can walk their
+ * input 64 bytes at a time and find word or line boundaries with bit
+ * operations on the masks instead of testing each byte. Bytes past
+ * @p size count as spaces, so ~whitespace marks exactly the non-blank
+ * bytes of a short block.
+ */
+block_masks classify(const char* data, std::size_t size) noexcept;
+
+/**
+ * @brief Find the first whitespace byte (' ', \t, \n, \v, \f, \r) of
+ *        @p str, from @p pos
+ * @return Index of the byte, or std::string_view::npos
+ */
+std::size_t find_whitespace(std::string_view str, std::size_t pos = 0) noexcept;
+
+/**
+ * @brief Find the first byte of @p str, from @p pos, that is not whitespace
+ * @return Index of the byte, or std::string_view::npos
+ */
+std::size_t find_non_whitespace(std::string_view str, std::size_t pos = 0) noexcept;
+
+/// @brief Number of whitespace-separated words in @p str
+std::size_t count_words(std::string_view str) noexcept;
+
+/**
+ * @brief Number of lines of @p str ending at \n, \r or \r\n
+ *
+ * A final line without a line ending counts; a final line ending does not
+ * start another line, so "a\nb" and "a\nb\n" both have 2 lines and ""
+ * has none.
+ */
+std::size_t count_lines(std::string_view str) noexcept;
+
+/**
+ * @brief Check that every byte of @p str is below 128
+ */
+bool is_ascii(std::string_view str) noexcept;
+
+/**
+ * @brief Check that @p str is well-formed UTF-8
+ *
+ * Rejects overlong forms, surrogates (U+D800-U+DFFF), code points past
+ * U+10FFFF and truncated sequences. The AVX2 and NEON kernels classify
+ * whole blocks with nibble lookup tables; the scalar and SSE2 kernels skip
+ * ASCII runs 8 or 16 bytes at a time and decode the rest.
+ */
+bool is_valid_utf8(std::string_view str) noexcept;
+
+/**
+ * @brief Replace every @p from byte in [data, data + size) with @p to
+ */
+void replace(char* data, std::size_t size, char from, char to) noexcept;
+
+/// @brief Convert A-Z to a-z in [data, data + size); other bytes are kept
+void to_lower(char* data, std::size_t size) noexcept;
+
+/// @brief Convert a-z to A-Z in [data, data + size); other bytes are kept
+void to_upper(char* data, std::size_t size) noexcept;
+
+/// @brief Swap the case of ASCII letters in [data, data + size)
+void swap_case(char* data, std::size_t size) noexcept;
+
+/// @brief Compare @p a and @p b with ASCII letters folded to lowercase
+bool equals_ignore_case(std::string_view a, std::string_view b) noexcept;
+
+/// @brief Instruction set of the kernels in use
+isa active_isa() noexcept;
+
+/**
+ * @brief Use the kernels of @p target instead of the best available
+ *
+ * For tests and benchmarks. Not synchronized with calls running on other
+ * threads, which may still use the previous kernels.
+ *
+ * @return false, with nothing changed, if the CPU or build lacks @p target
+ */
+bool select_isa(isa target) noexcept;
+
+/// @brief "scalar", "sse2", "avx2" or "neon"
+const char* isa_name(isa target) noexcept;
+
+} // namespace simd
+} // namespace fb
@@ -0,0 +1,214 @@
+/// @file stream_readers.h
+/// @brief Chunked line, word and token readers over streams and file descriptors
+///
+/// The readers of string_iterators.h need the whole input in memory. These
+/// read it through a refillable buffer instead, so a multi-GB log or a
+/// socket is scanned in constant memory.
+///
+/// Features:
+/// - Sources: any std::istream (files, fb::socket_stream), a POSIX file
+///   descriptor, or a read callback
+/// - The same SIMD delimiter search as line_iterator and token_iterator
+/// - Lines and tokens are std::string_view into the buffer: when one
+///   straddles two chunks, only its bytes already read are moved to the
+///   front of the buffer before the next read
+/// - The buffer grows only for a line or token longer than itself
+///
+/// Thread Safety:
+/// - Readers are NOT thread-safe
+/// - A view returned by next() is valid until the next call to has_next()
+///   or next() on the same reader
+///
+/// Example:
+/// @code
+/// std::ifstream log("/var/log/orders.log", std::ios::binary);
+/// fb::line_reader lines(log);
+/// while (lines.has_next())
+/// {
+///   std::string_view line = lines.next();
+///   // process line...
+/// }
+///
+/// fb::token_reader fields(fb::byte_source::from_fd(STDIN_FILENO), ",");
+/// @endcode
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace fb
+{
+
+// ============================================================================
+// byte_source
+// ============================================================================
+
+/// @brief Where a reader gets its bytes: a callback and its context
+class byte_source
+{
+public:
+  /// Reads up to @p size bytes, blocking until at least one is available;
+  /// returns 0 only at the end of the input
+  using read_fn = std::size_t (*)(void* context, char* buffer, std::size_t size);
+
+  byte_source(void* context, read_fn read) noexcept
+      : m_context(context)
+      , m_read(read)
+  {
+  }
+
+  /// @brief Read from @p in, which must outlive the source
+  ///
+  /// Implicit, so a reader can be built straight from a stream. Returns what
+  /// the stream buffer has as soon as it has anything: a socket stream
+  /// delivers a line without waiting for a full chunk.
+  byte_source(std::istream& in) noexcept;
+
+  /**
+   * @brief Read from a POSIX file descriptor, which the caller keeps open
+   * @note Reads throw std::system_error when read() fails
+   */
+  static byte_source from_fd(int fd) noexcept;
+
+  std::size_t read(char* buffer, std::size_t size)
+  {
+    return m_read(m_context, buffer, size);
+  }
+
+private:
+  void*   m_context;
+  read_fn m_read;
+};
+
+/// Buffer size readers start with
+inline constexpr std::size_t READER_CHUNK_SIZE = 64 * 1024;
+
+namespace detail
+{
+
+/// @brief Refillable buffer shared by the readers
+class read_buffer
+{
+public:
+  read_buffer(byte_source source, std::size_t chunk_size);
+
+  /// @brief The bytes read but not consumed yet
+  [[nodiscard]] std::string_view data() const noexcept
+  {
+    return {m_data.get() + m_begin, m_end - m_begin};
+  }
+
+  void consume(std::size_t count) noexcept
+  {
+    m_begin += count;
+  }
+
+  /**
+   * @brief Read more bytes after data()
+   *
+   * The unread bytes are kept but may move: views into data() taken
+   * before the call are invalid after it.
+   *
+   * @return false at the end of the input
+   */
+  bool fill();
+
+private:
+  byte_source             m_source;
+  std::unique_ptr<char[]> m_data;
+  std::size_t             m_capacity;
+  std::size_t             m_begin = 0;
+  std::size_t             m_end   = 0;
+  bool                    m_eof   = false;
+};
+
+} // namespace detail
+
+// ============================================================================
+// line_reader
+// ============================================================================
+
+/// @brief Lines of a stream, like std::getline() without the copies
+///
+/// Lines end at \n, \r or \r\n, which are not part of the line. Unlike
+/// line_iterator, a final line ending does not produce an empty last line.
+class line_reader
+{
+public:
+  explicit line_reader(byte_source source, std::size_t chunk_size = READER_CHUNK_SIZE);
+
+  /// @brief Whether another line follows; may read from the source
+  [[nodiscard]] bool has_next();
+
+  /// @brief The next line, or an empty view when there is none
+  std::string_view next();
+
+private:
+  bool advance();
+
+  detail::read_buffer m_buffer;
+  std::string_view    m_current;
+  std::size_t         m_scanned = 0;     ///< Bytes of data() known not to end a line
+  bool                m_ready   = false; ///< m_current holds the next line
+  bool                m_skip_lf = false; ///< The last line ended at a \r at the end of the data
+};
+
+// ============================================================================
+// word_reader
+// ============================================================================
+
+/// @brief Whitespace-separated words of a stream, like word_iterator
+class word_reader
+{
+public:
+  explicit word_reader(byte_source source, std::size_t chunk_size = READER_CHUNK_SIZE);
+
+  /// @brief Whether another word follows; may read from the source
+  [[nodiscard]] bool has_next();
+
+  /// @brief The next word, or an empty view when there is none
+  std::string_view next();
+
+private:
+  bool advance();
+
+  detail::read_buffer m_buffer;
+  std::string_view    m_current;
+  std::size_t         m_scanned = 0; ///< 0 before the word start is found
+  bool                m_ready   = false;
+};
+
+// ============================================================================
+// token_reader
+// ============================================================================
+
+/// @brief Tokens of a stream split on any of a set of characters, like
+/// token_iterator: empty tokens between delimiters are returned
+class token_reader
+{
+public:
+  token_reader(byte_source source, std::string_view delimiters, std::size_t chunk_size = READER_CHUNK_SIZE);
+
+  /// @brief Whether another token follows; may read from the source
+  [[nodiscard]] bool has_next();
+
+  /// @brief The next token, or an empty view when there is none
+  std::string_view next();
+
+private:
+  bool advance();
+
+  detail::read_buffer m_buffer;
+  std::string         m_delimiters;
+  std::string_view    m_current;
+  std::size_t         m_scanned   = 0;
+  bool                m_ready     = false;
+  bool                m_delimited = false; ///< A delimiter was seen, so the input has a last token
+  bool                m_finished  = false;
+};
+
+} // namespace fb
@@ -8,9 +8,13 @@
 /// - Pre-allocation to avoid repeated reallocations
 /// - Method chaining for fluent API
 /// - Append operations for strings, characters, and numeric types
+/// - JSON and HTML escaping straight into the buffer
 /// - Insert, remove, and replace operations
 /// - Formatted string appending
 /// - Stream-style operators for convenience
+/// - Pluggable allocator: pmr_string_builder allocates from a
+///   std::pmr::memory_resource, such as a per-thread monotonic arena
+/// - release() moves the buffer out without copying
 ///
 /// Thread Safety:
 /// - string_builder is NOT thread-safe
@@ -26,6 +30,12 @@
 ///   .append("Count: ")
 ///   .append_int(42);
 /// std::string result = sb.to_string();
+///
+/// // One arena per thread, one builder per message
+/// std::pmr::monotonic_buffer_resource arena(64 * 1024);
+/// fb::pmr_string_builder message(&arena);
+/// message.append("8=FIX.4.4\x01");
+/// std::pmr::string wire = message.release();
 /// @endcode
 
 #pragma once
@@ -34,6 +44,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -46,63 +58,79 @@ namespace fb {
  * Provides optimized string construction by managing a single buffer
  * that grows as needed. All append operations return a reference to
  * the builder for method chaining.
+ *
+ * The buffer is a std::basic_string using @p Allocator. The member
+ * functions are compiled into the library for std::allocator<char>
+ * (string_builder) and std::pmr::polymorphic_allocator<char>
+ * (pmr_string_builder); any other allocation strategy can be plugged in as
+ * a std::pmr::memory_resource.
  */
-class string_builder
+template <typename Allocator = std::allocator<char>>
+class basic_string_builder
 {
 public:
+  using allocator_type = Allocator;
+  using string_type    = std::basic_string<char, std::char_traits<char>, Allocator>;
 
-  string_builder() = default;
-  explicit string_builder(std::size_t initial_capacity);
-  explicit string_builder(std::string_view initial);
+  basic_string_builder() = default;
+  explicit basic_string_builder(const Allocator& alloc);
+  explicit basic_string_builder(std::size_t initial_capacity, const Allocator& alloc = Allocator());
+  explicit basic_string_builder(std::string_view initial, const Allocator& alloc = Allocator());
 
-  ~string_builder() = default;
+  ~basic_string_builder() = default;
 
   // Non-copyable but moveable
-  string_builder(const string_builder&)            = delete;
-  string_builder& operator=(const string_builder&) = delete;
-  string_builder(string_builder&&) noexcept        = default;
-  string_builder& operator=(string_builder&&) noexcept = default;
+  basic_string_builder(const basic_string_builder&)            = delete;
+  basic_string_builder& operator=(const basic_string_builder&) = delete;
+  basic_string_builder(basic_string_builder&&) noexcept        = default;
+  basic_string_builder& operator=(basic_string_builder&&)      = default;
 
   // ============================================================================
   //  Append Operations
   // ============================================================================
 
-  string_builder& append(std::string_view str);
-  string_builder& append(const char* str);
-  string_builder& append(char c);
-  string_builder& append(char c, std::size_t count);
-  string_builder& append_line(std::string_view str = "");
+  basic_string_builder& append(std::string_view str);
+  basic_string_builder& append(const char* str);
+  basic_string_builder& append(char c);
+  basic_string_builder& append(char c, std::size_t count);
+  basic_string_builder& append_line(std::string_view str = "");
+
+  basic_string_builder& append_int(std::int32_t value);
+  basic_string_builder& append_int(std::int64_t value);
+  basic_string_builder& append_uint(std::uint32_t value);
+  basic_string_builder& append_uint(std::uint64_t value);
+  basic_string_builder& append_double(double value, int precision = 6);
+  basic_string_builder& append_bool(bool value);
 
-  string_builder& append_int(std::int32_t value);
-  string_builder& append_int(std::int64_t value);
-  string_builder& append_uint(std::uint32_t value);
-  string_builder& append_uint(std::uint64_t value);
-  string_builder& append_double(double value, int precision = 6);
-  string_builder& append_bool(bool value);
+  /// @brief Append @p str escaped for a JSON string value, as json_escape() does
+  basic_string_builder& append_json_escaped(std::string_view str);
+
+  /// @brief Append @p str with & < > " ' replaced by entities, as html_escape() does
+  basic_string_builder& append_html_escaped(std::string_view str);
 
 
   // ============================================================================
   // Modification Operations
   // ============================================================================
 
-  string_builder& insert(std::size_t pos, std::string_view str);
-  string_builder& remove(std::size_t pos, std::size_t count = std::string::npos);
-  string_builder& replace(std::string_view from, std::string_view to);
-  string_builder& replace_all(std::string_view from, std::string_view to);
+  basic_string_builder& insert(std::size_t pos, std::string_view str);
+  basic_string_builder& remove(std::size_t pos, std::size_t count = std::string::npos);
+  basic_string_builder& replace(std::string_view from, std::string_view to);
+  basic_string_builder& replace_all(std::string_view from, std::string_view to);
 
   // ============================================================================
   // Stream Operators
   // ============================================================================
 
-  string_builder& operator<<(std::string_view str);
-  string_builder& operator<<(char c);
-  string_builder& operator<<(const char* str);
-  string_builder& operator<<(std::int32_t value);
-  string_builder& operator<<(std::int64_t value);
-  string_builder& operator<<(std::uint32_t value);
-  string_builder& operator<<(std::uint64_t value);
-  string_builder& operator<<(double value);
-  string_builder& operator<<(bool value);
+  basic_string_builder& operator<<(std::string_view str);
+  basic_string_builder& operator<<(char c);
+  basic_string_builder& operator<<(const char* str);
+  basic_string_builder& operator<<(std::int32_t value);
+  basic_string_builder& operator<<(std::int64_t value);
+  basic_string_builder& operator<<(std::uint32_t value);
+  basic_string_builder& operator<<(std::uint64_t value);
+  basic_string_builder& operator<<(double value);
+  basic_string_builder& operator<<(bool value);
 
   // ============================================================================
   // Output Methods
@@ -111,21 +139,30 @@ public:
   [[nodiscard]] std::string to_string() const;
   [[nodiscard]] std::string_view view() const noexcept;
 
+  /// @brief Move the buffer out without copying; the builder is left empty
+  [[nodiscard]] string_type release() noexcept;
+
   // ============================================================================
   // Management Methods
   // ============================================================================
 
-  string_builder& clear() noexcept;
+  basic_string_builder& clear() noexcept;
+
+  /// @brief Clear, and reserve the capacity release() took with the buffer
+  basic_string_builder& reset();
+
   void reserve(std::size_t capacity);
   [[nodiscard]] std::size_t size() const noexcept;
   [[nodiscard]] std::size_t capacity() const noexcept;
   [[nodiscard]] bool empty() const noexcept;
+  [[nodiscard]] allocator_type get_allocator() const noexcept;
 
 
 
   /** @brief Append a formatted string
    *
-   * Uses the fb::format system to format the string.
+   * Uses the fb::format system, writing straight into the buffer: no
+   * temporary string is built for the result or for each argument.
    *
    * @tparam Args Types of format arguments
    * @param fmt Format string
@@ -133,15 +170,40 @@ public:
    * @return Reference to this builder for chaining
    */
   template <typename... Args>
-  string_builder& append_format(std::string_view fmt, Args&&... args)
+  basic_string_builder& append_format(std::string_view fmt, Args&&... args)
   {
-    m_buffer.append(format(fmt, std::forward<Args>(args)...));
+    format_sink sink(&m_buffer, &append_to_buffer);
+    detail::vformat_to(sink, fmt, detail::make_format_args(args...));
+    return *this;
+  }
+
+  /** @brief Append a string formatted with a FB_FORMAT_STRING format */
+  template <typename Source, typename... Args>
+  basic_string_builder& append_format(compiled_format<Source> fmt, Args&&... args)
+  {
+    format_sink sink(&m_buffer, &append_to_buffer);
+    detail::vformat_to(sink, fmt, detail::make_format_args(args...));
     return *this;
   }
 
 
 private:
-  std::string m_buffer; ///< Internal buffer for string construction
+  static void append_to_buffer(void* buffer, const char* data, std::size_t size)
+  {
+    static_cast<string_type*>(buffer)->append(data, size);
+  }
+
+  string_type m_buffer;          ///< Internal buffer for string construction
+  std::size_t m_released = 0;    ///< Capacity of the buffer release() took
 };
 
+extern template class basic_string_builder<std::allocator<char>>;
+extern template class basic_string_builder<std::pmr::polymorphic_allocator<char>>;
+
+/// @brief Builder on the global allocator
+using string_builder = basic_string_builder<>;
+
+/// @brief Builder allocating from a std::pmr::memory_resource
+using pmr_string_builder = basic_string_builder<std::pmr::polymorphic_allocator<char>>;
+
 } // namespace fb
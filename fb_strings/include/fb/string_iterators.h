@@ -35,7 +35,11 @@
 
 #pragma once
 
+#include <fb/simd_search.h>
+
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 namespace fb
@@ -80,28 +84,18 @@ public:
     }
 
     std::size_t start = m_pos;
-    std::size_t end   = m_pos;
 
     // Find line ending
-    while (end < m_str.size())
+    std::size_t end = simd::find_any(m_str, "\r\n", start);
+    if (end != std::string_view::npos)
     {
-      char c = m_str[end];
-      if (c == '\n')
-      {
-        m_pos = end + 1;
-        return m_str.substr(start, end - start);
-      }
-      if (c == '\r')
+      m_pos = end + 1;
+      // Check for \r\n
+      if (m_str[end] == '\r' && m_pos < m_str.size() && m_str[m_pos] == '\n')
       {
-        m_pos = end + 1;
-        // Check for \r\n
-        if (m_pos < m_str.size() && m_str[m_pos] == '\n')
-        {
-          ++m_pos;
-        }
-        return m_str.substr(start, end - start);
+        ++m_pos;
       }
-      ++end;
+      return m_str.substr(start, end - start);
     }
 
     // Last line (no trailing newline)
@@ -129,7 +123,9 @@ private:
 /// @brief Zero-copy iterator over whitespace-separated words
 ///
 /// Splits on any whitespace character (space, tab, newline, etc.).
-/// Consecutive whitespace is treated as a single separator.
+/// Consecutive whitespace is treated as a single separator. The
+/// whitespace mask of 64 bytes is computed at a time and kept, so
+/// finding the next word boundary is usually a bit scan.
 class word_iterator
 {
 public:
@@ -140,6 +136,7 @@ public:
       , m_pos(0)
       , m_original(str)
   {
+    load_block(0);
     skip_whitespace();
   }
 
@@ -164,10 +161,7 @@ public:
     std::size_t start = m_pos;
 
     // Find end of word
-    while (m_pos < m_str.size() && !is_whitespace(m_str[m_pos]))
-    {
-      ++m_pos;
-    }
+    m_pos = scan(start, true);
 
     std::string_view result = m_str.substr(start, m_pos - start);
 
@@ -182,26 +176,47 @@ public:
   {
     m_str = m_original;
     m_pos = 0;
+    load_block(0);
     skip_whitespace();
   }
 
 private:
   void skip_whitespace() noexcept
   {
-    while (m_pos < m_str.size() && is_whitespace(m_str[m_pos]))
-    {
-      ++m_pos;
-    }
+    m_pos = scan(m_pos, false);
   }
 
-  static constexpr bool is_whitespace(char c) noexcept
+  void load_block(std::size_t pos) noexcept
   {
-    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    m_block = pos;
+    m_blank = simd::classify(m_str.data() + pos, m_str.size() - pos).whitespace;
   }
 
-  std::string_view m_str;      ///< Current view
-  std::size_t      m_pos;      ///< Current position
-  std::string_view m_original; ///< Original string for reset
+  /// First index from @p pos that is whitespace, or not, or m_str.size()
+  std::size_t scan(std::size_t pos, bool whitespace) noexcept
+  {
+    while (pos < m_str.size())
+    {
+      if (pos - m_block >= simd::MASK_BLOCK)
+      {
+        load_block(pos);
+      }
+      // Bytes past the end classify as whitespace
+      const std::uint64_t hits = (whitespace ? m_blank : ~m_blank) >> (pos - m_block);
+      if (hits != 0)
+      {
+        return std::min(pos + simd::lowest_bit(hits), m_str.size());
+      }
+      pos = m_block + simd::MASK_BLOCK;
+    }
+    return m_str.size();
+  }
+
+  std::string_view m_str;       ///< Current view
+  std::size_t      m_pos;       ///< Current position
+  std::string_view m_original;  ///< Original string for reset
+  std::size_t      m_block = 0; ///< Offset of the block m_blank describes
+  std::uint64_t    m_blank = 0; ///< Whitespace mask of the block
 };
 
 // ============================================================================
@@ -252,9 +267,10 @@ public:
     std::size_t start = m_pos;
 
     // Find delimiter
-    while (m_pos < m_str.size() && !is_delimiter(m_str[m_pos]))
+    m_pos = simd::find_any(m_str, m_delimiters, start);
+    if (m_pos == std::string_view::npos)
     {
-      ++m_pos;
+      m_pos = m_str.size();
     }
 
     std::string_view result = m_str.substr(start, m_pos - start);
@@ -280,11 +296,6 @@ public:
   }
 
 private:
-  bool is_delimiter(char c) const noexcept
-  {
-    return m_delimiters.find(c) != std::string_view::npos;
-  }
-
   std::string_view m_str;        ///< Current view
   std::string_view m_delimiters; ///< Delimiter characters
   std::size_t      m_pos;        ///< Current position
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <fb/string_pipeline.h>
+
 #include <algorithm>
 #include <functional>
 #include <initializer_list>
@@ -181,6 +183,15 @@ public:
   [[nodiscard]] string_list filter_matching(const std::string& pattern) const;
   [[nodiscard]] string_list filter_matching(const std::regex& regex) const;
 
+  /// @brief Elements within @p max_distance edits of @p query; see fuzzy_match()
+  [[nodiscard]] string_list filter_fuzzy(std::string_view query, size_t max_distance) const;
+
+  /// @brief Lazy pipeline over this list; see string_pipeline.h
+  ///
+  /// Fuses filter and transform steps into one pass without intermediate
+  /// lists: `list.view().filter_starts_with("#").join("\n")`
+  [[nodiscard]] string_pipeline<string_list> view() const noexcept;
+
   // ========================================================================
   // Search Operations
   // ========================================================================
@@ -258,6 +269,12 @@ string_list::string_list(InputIt first, InputIt last)
 {
 }
 
+/// Lazy pipeline over this list
+inline string_pipeline<string_list> string_list::view() const noexcept
+{
+  return string_pipeline<string_list>(*this);
+}
+
 /// Construct element in place at end
 template<typename... Args>
 string_list::reference string_list::emplace_back(Args&&... args)
@@ -0,0 +1,180 @@
+/// @file string_pattern.h
+/// @brief Compiled glob and regex patterns matched by a DFA, and an LRU cache
+///
+/// A compiled_pattern is built once and then matches any number of strings
+/// in one pass over their bytes, with one table lookup per byte and no
+/// backtracking. Typical uses are symbol subscriptions ("EUR*") and log
+/// filters applied to every message.
+///
+/// Two syntaxes:
+/// - Globs, with the matches_pattern() rules: '*' is any sequence, '?' is
+///   exactly one byte, and the whole string must match
+/// - Regular expressions, with std::regex_search() semantics: a match
+///   anywhere in the string. The DFA supports literals, '.', classes such
+///   as [a-z] and [^0-9], \d \w \s and their negations, groups, '|', the
+///   quantifiers * + ? {n} {n,} {n,m} (lazy forms included), and the
+///   anchors ^ and $. Other syntax (backreferences, lookahead, word
+///   boundaries, ...) falls back to std::regex with the same results
+///
+/// pattern_cache keeps recently used patterns compiled, so code that only
+/// has the pattern text, such as string_list::filter_matching(), compiles
+/// each pattern once.
+///
+/// Thread Safety:
+/// - compiled_pattern::matches() is const and thread-safe
+/// - pattern_cache is internally synchronized
+///
+/// Example:
+/// @code
+/// auto subscription = fb::compiled_pattern::glob("EUR*");
+/// bool wanted       = subscription.matches("EURUSD");  // true
+///
+/// auto errors = fb::default_pattern_cache().regex("(ERROR|FATAL) [0-9]+");
+/// bool alert  = errors->matches(log_line);
+/// @endcode
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace fb
+{
+
+/// @brief Glob or regular expression compiled for repeated matching
+class compiled_pattern
+{
+public:
+  /**
+   * @brief Compile a glob pattern
+   * @param pattern '*' and '?' wildcards, everything else literal
+   * @param case_sensitive false to fold ASCII case, as matches_pattern() does
+   */
+  [[nodiscard]] static compiled_pattern glob(std::string_view pattern, bool case_sensitive = true);
+
+  /**
+   * @brief Compile an ECMAScript regular expression
+   * @param pattern Regular expression, as std::regex would take it
+   * @throws std::regex_error if the pattern is invalid
+   */
+  [[nodiscard]] static compiled_pattern regex(std::string_view pattern);
+
+  /**
+   * @brief Match @p str against the pattern
+   *
+   * Globs must match the whole string; regular expressions match if found
+   * anywhere, like std::regex_search().
+   */
+  [[nodiscard]] bool matches(std::string_view str) const;
+
+  /// @brief Text the pattern was compiled from
+  [[nodiscard]] const std::string& pattern() const noexcept
+  {
+    return m_pattern;
+  }
+
+  /// @brief Whether matching uses the DFA rather than a fallback
+  [[nodiscard]] bool is_dfa() const noexcept
+  {
+    return m_engine == engine::dfa;
+  }
+
+  /// @brief Number of DFA states, 0 with a fallback
+  [[nodiscard]] std::size_t state_count() const noexcept
+  {
+    return m_accept.size();
+  }
+
+private:
+  /// Fallbacks: patterns beyond the DFA's syntax or size limits
+  enum class engine : std::uint8_t
+  {
+    dfa,
+    matches_pattern, ///< fb::matches_pattern(), for very long globs
+    std_regex
+  };
+
+  compiled_pattern() = default;
+
+  friend struct pattern_compiler;
+
+  std::string m_pattern;
+  engine      m_engine         = engine::dfa;
+  bool        m_case_sensitive = true;
+
+  // DFA over byte classes: m_transitions[state * m_classes + class]
+  std::uint8_t                m_byte_class[256] = {};
+  std::size_t                 m_classes         = 0;
+  std::vector<std::int32_t>   m_transitions;
+  std::vector<std::uint8_t>   m_accept;        ///< A match ends here
+  std::vector<std::uint8_t>   m_accept_at_end; ///< A match ends here if the input does
+  std::int32_t                m_start  = 0;
+  std::int32_t                m_dead   = -1;    ///< State no input leads out of, if any
+  bool                        m_search = false; ///< Regex: a match may start anywhere
+
+  std::shared_ptr<const std::regex> m_regex;
+};
+
+/// @brief Thread-safe LRU cache of compiled patterns
+///
+/// Returns shared pointers, so patterns still in use survive eviction.
+class pattern_cache
+{
+public:
+  explicit pattern_cache(std::size_t capacity = 128);
+
+  pattern_cache(const pattern_cache&)            = delete;
+  pattern_cache& operator=(const pattern_cache&) = delete;
+
+  /// @brief compiled_pattern::glob(), compiled on first use
+  [[nodiscard]] std::shared_ptr<const compiled_pattern> glob(std::string_view pattern, bool case_sensitive = true);
+
+  /// @brief compiled_pattern::regex(), compiled on first use
+  /// @throws std::regex_error if the pattern is invalid; nothing is cached
+  [[nodiscard]] std::shared_ptr<const compiled_pattern> regex(std::string_view pattern);
+
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] std::size_t capacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+  void clear();
+
+private:
+  /// Index into m_index: case-sensitive glob, case-insensitive glob, regex
+  enum kind : std::size_t
+  {
+    GLOB,
+    GLOB_IGNORE_CASE,
+    REGEX,
+    KINDS
+  };
+
+  struct entry
+  {
+    std::string                             pattern;
+    kind                                    type;
+    std::shared_ptr<const compiled_pattern> compiled;
+  };
+
+  std::shared_ptr<const compiled_pattern> get(std::string_view pattern, kind type);
+
+  std::size_t        m_capacity;
+  mutable std::mutex m_mutex;
+  std::list<entry>   m_entries; ///< Most recently used first
+  std::unordered_map<std::string_view, std::list<entry>::iterator> m_index[KINDS]; ///< Keys view entry::pattern
+};
+
+/// @brief Process-wide cache used by string_list::filter_matching()
+pattern_cache& default_pattern_cache();
+
+} // namespace fb
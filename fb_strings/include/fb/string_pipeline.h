@@ -0,0 +1,238 @@
+/// @file string_pipeline.h
+/// @brief Lazy, fused filter and transform pipelines over string lists
+///
+/// string_list::filter() and friends return a new list at every step. A
+/// pipeline instead records the steps and runs them together when a
+/// terminal operation (join, count, for_each, to) asks for the result: each
+/// element goes through every stage in turn, in a single pass, with no
+/// intermediate list. Stages are template parameters rather than
+/// std::function, so the compiler can inline the predicates.
+///
+/// Elements enter the pipeline as std::string_view. A transform may return
+/// std::string_view (e.g. a substring of its input) or std::string; the
+/// following stages see whatever it returns.
+///
+/// Lifetime:
+/// - The source list must outlive the pipeline and must not change while a
+///   terminal operation runs
+/// - Predicates and transforms are stored by value; the filter_* helpers
+///   keep their own copy of the pattern
+///
+/// Thread Safety:
+/// - A pipeline is immutable; running it from several threads is as safe
+///   as reading the source list from several threads
+///
+/// Example:
+/// @code
+/// std::string report = lines.view()
+///                          .filter_starts_with("#")
+///                          .filter_containing(symbol)
+///                          .transform([](std::string_view line) { return line.substr(1); })
+///                          .join("\n");
+/// @endcode
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace fb
+{
+
+namespace detail
+{
+
+/// First stage: passes every element on unchanged
+struct pass_stage
+{
+  template<typename T, typename Sink>
+  void operator()(T&& value, Sink& sink) const
+  {
+    sink(std::forward<T>(value));
+  }
+};
+
+/// Passes on the elements for which predicate returns true
+template<typename Inner, typename Predicate>
+struct filter_stage
+{
+  Inner     inner;
+  Predicate predicate;
+
+  template<typename T, typename Sink>
+  void operator()(T&& value, Sink& sink) const
+  {
+    auto next = [this, &sink](auto&& element) {
+      if (std::invoke(predicate, std::as_const(element)))
+      {
+        sink(std::forward<decltype(element)>(element));
+      }
+    };
+    inner(std::forward<T>(value), next);
+  }
+};
+
+/// Passes on the result of function for every element
+template<typename Inner, typename Function>
+struct transform_stage
+{
+  Inner    inner;
+  Function function;
+
+  template<typename T, typename Sink>
+  void operator()(T&& value, Sink& sink) const
+  {
+    auto next = [this, &sink](auto&& element) {
+      sink(std::invoke(function, std::forward<decltype(element)>(element)));
+    };
+    inner(std::forward<T>(value), next);
+  }
+};
+
+} // namespace detail
+
+/// @brief Lazy pipeline of filter and transform stages over a string list
+///
+/// Obtained from string_list::view() or packed_string_list::view(). Every
+/// filter() or transform() call returns a new, longer pipeline; nothing
+/// runs until a terminal operation.
+template<typename Source, typename Stage = detail::pass_stage>
+class string_pipeline
+{
+public:
+  explicit string_pipeline(const Source& source, Stage stage = Stage())
+    : m_source(&source)
+    , m_stage(std::move(stage))
+  {
+  }
+
+  // ========================================================================
+  // Stages
+  // ========================================================================
+
+  /// @brief Keep the elements for which @p predicate returns true
+  template<typename Predicate>
+  [[nodiscard]] auto filter(Predicate predicate) const
+  {
+    using next_stage = detail::filter_stage<Stage, Predicate>;
+    return string_pipeline<Source, next_stage>(*m_source, next_stage{m_stage, std::move(predicate)});
+  }
+
+  /// @brief Replace each element by the result of @p function
+  template<typename Function>
+  [[nodiscard]] auto transform(Function function) const
+  {
+    using next_stage = detail::transform_stage<Stage, Function>;
+    return string_pipeline<Source, next_stage>(*m_source, next_stage{m_stage, std::move(function)});
+  }
+
+  [[nodiscard]] auto filter_containing(std::string_view substr) const
+  {
+    return filter([pattern = std::string(substr)](std::string_view element) {
+      return element.find(pattern) != std::string_view::npos;
+    });
+  }
+
+  [[nodiscard]] auto filter_starts_with(std::string_view prefix) const
+  {
+    return filter([pattern = std::string(prefix)](std::string_view element) {
+      return element.size() >= pattern.size() && element.compare(0, pattern.size(), pattern) == 0;
+    });
+  }
+
+  [[nodiscard]] auto filter_ends_with(std::string_view suffix) const
+  {
+    return filter([pattern = std::string(suffix)](std::string_view element) {
+      return element.size() >= pattern.size() &&
+             element.compare(element.size() - pattern.size(), pattern.size(), pattern) == 0;
+    });
+  }
+
+  [[nodiscard]] auto filter_non_empty() const
+  {
+    return filter([](std::string_view element) { return !element.empty(); });
+  }
+
+  // ========================================================================
+  // Terminal Operations
+  // ========================================================================
+
+  /// @brief Call @p function with every resulting element
+  template<typename Function>
+  void for_each(Function&& function) const
+  {
+    auto sink = [&function](auto&& element) { function(std::forward<decltype(element)>(element)); };
+    run(sink);
+  }
+
+  /// @brief Number of resulting elements
+  [[nodiscard]] std::size_t count() const
+  {
+    std::size_t total = 0;
+    auto        sink  = [&total](auto&&) { ++total; };
+    run(sink);
+    return total;
+  }
+
+  /// @brief Join the resulting elements with a delimiter
+  [[nodiscard]] std::string join(std::string_view delimiter) const
+  {
+    std::string result;
+    bool        first = true;
+    auto        sink  = [&](auto&& element) {
+      if (!first)
+      {
+        result.append(delimiter);
+      }
+      first = false;
+      result.append(std::string_view(element));
+    };
+    run(sink);
+    return result;
+  }
+
+  [[nodiscard]] std::string join(char delimiter) const
+  {
+    return join(std::string_view(&delimiter, 1));
+  }
+
+  [[nodiscard]] std::string join() const
+  {
+    return join(std::string_view());
+  }
+
+  /// @brief Collect the resulting elements into a new container
+  ///
+  /// Works with string_list, packed_string_list and std::vector<std::string>.
+  /// Elements are pushed as Container::value_type; a container of
+  /// std::string_view only stays valid without transforms returning
+  /// std::string.
+  template<typename Container>
+  [[nodiscard]] Container to() const
+  {
+    Container result;
+    auto      sink = [&result](auto&& element) {
+      result.push_back(typename Container::value_type(std::forward<decltype(element)>(element)));
+    };
+    run(sink);
+    return result;
+  }
+
+private:
+  template<typename Sink>
+  void run(Sink& sink) const
+  {
+    for (const auto& element : *m_source)
+    {
+      m_stage(std::string_view(element), sink);
+    }
+  }
+
+  const Source* m_source;
+  Stage         m_stage;
+};
+
+} // namespace fb
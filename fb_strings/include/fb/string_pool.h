@@ -0,0 +1,170 @@
+/// @file string_pool.h
+/// @brief Thread-safe string interning with stable views and integer handles
+///
+/// A feed or a CSV file repeats the same few thousand venue codes,
+/// currencies, symbols and side flags millions of times. A string_pool
+/// keeps one copy of each distinct string in arena chunks and hands out a
+/// 32-bit handle for it, so equal strings get equal handles and comparing
+/// two fields is an integer compare.
+///
+/// Features:
+/// - intern() returns a dense handle: 0, 1, 2... in interning order
+/// - view() turns a handle back into its string without locking
+/// - intern_view() returns a std::string_view that stays valid, and points
+///   to the same characters for equal strings, until the pool is destroyed
+/// - Strings are copied into arena chunks of up to 64 KiB: no allocation per string
+///
+/// Limits:
+/// - At most 2^32 - 2^10 distinct strings (std::length_error beyond)
+/// - Strings are never removed; a pool lives as long as its handles are used
+///
+/// Thread Safety:
+/// - All member functions are thread-safe
+/// - intern() and find() lock one of 64 shards, picked by the string's hash,
+///   so threads interning different strings rarely wait for each other
+/// - view() takes no lock; the handle must have reached the calling thread
+///   through the usual synchronization (a queue, a mutex, the thread that
+///   interned it)
+///
+/// Example:
+/// @code
+/// fb::string_pool venues;
+/// const fb::string_pool::handle xnas = venues.intern("XNAS");
+///
+/// for (const auto& row : fills)
+/// {
+///   if (venues.intern(row.venue) == xnas)  // Integer compare from here on
+///   {
+///     ...
+///   }
+/// }
+/// std::string_view name = venues.view(xnas);  // "XNAS"
+/// @endcode
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace fb
+{
+
+class string_pool
+{
+public:
+  using handle    = std::uint32_t;
+  using size_type = std::size_t;
+
+  string_pool();
+  ~string_pool();
+
+  string_pool(const string_pool&)            = delete;
+  string_pool& operator=(const string_pool&) = delete;
+
+  // ========================================================================
+  // Interning
+  // ========================================================================
+
+  /**
+   * @brief Handle of @p str, adding a copy of it on first sight
+   * @throw std::length_error if the pool already holds the maximum number of strings
+   */
+  handle intern(std::string_view str);
+
+  /// @brief The pooled copy of @p str: equal strings give the same characters
+  std::string_view intern_view(std::string_view str);
+
+  /// @brief Handle of @p str if it was interned, without adding it
+  [[nodiscard]] std::optional<handle> find(std::string_view str) const;
+
+  // ========================================================================
+  // Access
+  // ========================================================================
+
+  /**
+   * @brief The string of @p h, valid until the pool is destroyed
+   * @pre @p h was returned by intern() of this pool
+   */
+  [[nodiscard]] std::string_view view(handle h) const noexcept
+  {
+    const location at = locate(h);
+    return m_segments[at.segment].load(std::memory_order_acquire)[at.offset];
+  }
+
+  /// @brief Number of distinct strings interned so far
+  [[nodiscard]] size_type size() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+
+  /// @brief Bytes of arena chunks holding the characters
+  [[nodiscard]] size_type arena_bytes() const;
+
+private:
+  /// view() storage: segment k holds 2^(FIRST_SEGMENT_BITS + k) entries, so the
+  /// segments never move and a lookup needs no lock
+  static constexpr unsigned  FIRST_SEGMENT_BITS = 10;
+  static constexpr size_type SEGMENT_COUNT      = 32 - FIRST_SEGMENT_BITS;
+
+  static constexpr unsigned  SHARD_BITS  = 6;
+  static constexpr size_type SHARD_COUNT = size_type{1} << SHARD_BITS;
+
+  struct location
+  {
+    std::uint32_t segment;
+    std::uint32_t offset;
+  };
+
+  static location locate(handle h) noexcept
+  {
+    const std::uint64_t position = std::uint64_t{h} + (std::uint64_t{1} << FIRST_SEGMENT_BITS);
+    unsigned            top      = 63;
+    while ((position >> top) == 0)
+    {
+      --top;
+    }
+    return {top - FIRST_SEGMENT_BITS, static_cast<std::uint32_t>(position - (std::uint64_t{1} << top))};
+  }
+
+  /// One bucket: handle + 1 (0 when empty) and the high bits of its hash
+  struct slot
+  {
+    std::uint32_t handle_plus_one;
+    std::uint32_t tag;
+  };
+
+  /// Strings whose hash selects this shard: their table and characters
+  struct alignas(64) shard
+  {
+    mutable std::mutex                   mutex;
+    std::vector<slot>                    slots;
+    size_type                            count = 0;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    size_type                            arena_bytes = 0;
+    char*                                free_begin  = nullptr;
+    size_type                            free_size   = 0;
+  };
+
+  /// Slot holding @p str in @p owner, or the empty slot where it belongs
+  size_type probe(const shard& owner, std::uint64_t hash, std::string_view str) const noexcept;
+
+  /// Double the table of @p owner once it is half full
+  void grow(shard& owner) const;
+
+  /// Copy @p str into the arena of @p owner
+  static std::string_view store(shard& owner, std::string_view str);
+
+  /// Give @p str the next handle and make it visible to view()
+  handle publish(std::string_view str);
+
+  std::array<shard, SHARD_COUNT>                            m_shards;
+  std::array<std::atomic<std::string_view*>, SEGMENT_COUNT> m_segments{};
+  std::atomic<std::uint32_t>                                m_size{0};
+};
+
+} // namespace fb
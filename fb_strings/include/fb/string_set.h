@@ -0,0 +1,138 @@
+/// @file string_set.h
+/// @brief Frozen hash set of strings for O(1) membership tests
+///
+/// string_list::contains() and index_of() scan the whole list. A string_set
+/// is built once from a list, then answers the same queries with one XXH3
+/// hash and, typically, one string comparison, which suits allow-lists and
+/// deny-lists checked on every order.
+///
+/// The set is immutable: build a new one when the list changes. Its
+/// elements are the distinct strings of the source, kept in first-occurrence
+/// order in a packed_string_list.
+///
+/// Features:
+/// - contains(), contains_ignore_case() (ASCII) and index_of() in O(1)
+/// - index_of() reports the position in the source list, like
+///   string_list::index_of()
+/// - Open addressing with linear probing, at most half full
+///
+/// Thread Safety:
+/// - Immutable after construction; concurrent lookups are safe
+///
+/// Example:
+/// @code
+/// const fb::string_set allowed(fb::string_list::from_lines(allow_list_file));
+/// if (!allowed.contains(order.symbol))
+/// {
+///   reject(order);
+/// }
+/// @endcode
+
+#pragma once
+
+#include <fb/packed_string_list.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace fb
+{
+
+class string_list;
+
+class string_set
+{
+public:
+  using value_type     = std::string_view;
+  using size_type      = std::size_t;
+  using const_iterator = packed_string_list::const_iterator;
+  using iterator       = const_iterator;
+
+  // ========================================================================
+  // Construction
+  // ========================================================================
+
+  string_set() = default;
+  string_set(std::initializer_list<std::string_view> init);
+  explicit string_set(const string_list& list);
+  explicit string_set(const packed_string_list& list);
+
+  /// @brief Build from a range of anything convertible to std::string_view
+  template<typename InputIt>
+  string_set(InputIt first, InputIt last);
+
+  // ========================================================================
+  // Lookup
+  // ========================================================================
+
+  [[nodiscard]] bool contains(std::string_view str) const noexcept;
+
+  /// @brief Whether an element equals @p str ignoring ASCII case
+  [[nodiscard]] bool contains_ignore_case(std::string_view str) const noexcept;
+
+  /// @brief Position of the first occurrence of @p str in the source
+  [[nodiscard]] std::optional<size_type> index_of(std::string_view str) const noexcept;
+
+  // ========================================================================
+  // Elements
+  // ========================================================================
+
+  /// @brief Number of distinct elements
+  [[nodiscard]] size_type size() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+
+  /// @brief Distinct elements in first-occurrence order
+  [[nodiscard]] const packed_string_list& elements() const noexcept;
+
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+private:
+  /// One bucket: element + 1 (0 when empty) and the high bits of its hash
+  struct slot
+  {
+    std::uint32_t element;
+    std::uint32_t tag;
+  };
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  void reserve(size_type count);
+
+  /// Count @p value as the next source element and add it unless present
+  void insert(std::string_view value);
+
+  /// Rebuild both tables with room for @p count elements
+  void rehash(size_type count);
+
+  /// Enter element @p e into both tables
+  void place(size_type e);
+
+  /// Element index of @p str, or npos
+  size_type find(std::string_view str) const noexcept;
+
+  packed_string_list     m_elements;
+  std::vector<size_type> m_positions; ///< Source index of each element
+  size_type              m_source_size = 0;
+  std::vector<slot>      m_slots;     ///< Exact hashes
+  std::vector<slot>      m_folded;    ///< ASCII-lowercased hashes
+};
+
+// ============================================================================
+// Template Implementations
+// ============================================================================
+
+template<typename InputIt>
+string_set::string_set(InputIt first, InputIt last)
+{
+  for (; first != last; ++first)
+  {
+    insert(std::string_view(*first));
+  }
+}
+
+} // namespace fb
@@ -4,6 +4,7 @@
 #include <cctype>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -61,6 +62,49 @@ std::string trim_left(std::string_view str, std::string_view chars);
  */
 std::string trim_right(std::string_view str, std::string_view chars);
 
+/**
+ * @brief trim() without copying: a view into @p str
+ * @param str Input string
+ * @return The part of @p str between leading and trailing whitespace
+ */
+std::string_view trim_view(std::string_view str) noexcept;
+
+/// @brief trim_left() without copying: a view into @p str
+std::string_view trim_left_view(std::string_view str) noexcept;
+
+/// @brief trim_right() without copying: a view into @p str
+std::string_view trim_right_view(std::string_view str) noexcept;
+
+/// @brief trim(str, chars) without copying: a view into @p str
+std::string_view trim_view(std::string_view str, std::string_view chars) noexcept;
+
+/// @brief trim_left(str, chars) without copying: a view into @p str
+std::string_view trim_left_view(std::string_view str, std::string_view chars) noexcept;
+
+/// @brief trim_right(str, chars) without copying: a view into @p str
+std::string_view trim_right_view(std::string_view str, std::string_view chars) noexcept;
+
+/**
+ * @brief Remove leading and trailing whitespace in place
+ * @param str String to trim
+ */
+void trim_inplace(std::string& str);
+
+/// @brief Remove leading whitespace in place
+void trim_left_inplace(std::string& str);
+
+/// @brief Remove trailing whitespace in place
+void trim_right_inplace(std::string& str);
+
+/// @brief Remove leading and trailing occurrences of @p chars in place
+void trim_inplace(std::string& str, std::string_view chars);
+
+/// @brief Remove leading occurrences of @p chars in place
+void trim_left_inplace(std::string& str, std::string_view chars);
+
+/// @brief Remove trailing occurrences of @p chars in place
+void trim_right_inplace(std::string& str, std::string_view chars);
+
 // ============================================================================
 // Case Conversion (ASCII-only)
 // ============================================================================
@@ -79,6 +123,18 @@ std::string to_upper(std::string_view str);
  */
 std::string to_lower(std::string_view str);
 
+/**
+ * @brief Convert string to uppercase in place (ASCII-only: a-z to A-Z)
+ * @param str String to convert
+ */
+void to_upper_inplace(std::string& str);
+
+/**
+ * @brief Convert string to lowercase in place (ASCII-only: A-Z to a-z)
+ * @param str String to convert
+ */
+void to_lower_inplace(std::string& str);
+
 /**
  * @brief Capitalize first character, lowercase the rest (ASCII-only)
  * @param str Input string
@@ -100,6 +156,12 @@ std::string title_case(std::string_view str);
  */
 std::string swap_case(std::string_view str);
 
+/**
+ * @brief Swap case of all characters in place (ASCII-only)
+ * @param str String to convert
+ */
+void swap_case_inplace(std::string& str);
+
 // ============================================================================
 // Prefix/Suffix Operations
 // ============================================================================
@@ -264,6 +326,26 @@ std::string replace(std::string_view str, char from, char to);
  */
 std::string replace_all(std::string_view str, char from, char to);
 
+/**
+ * @brief Replace all occurrences of a substring in place
+ *
+ * Does not allocate when @p to is no longer than @p from. A longer @p to
+ * builds the result once at its final size.
+ *
+ * @param str String to modify
+ * @param from Substring to find; must not point into @p str
+ * @param to Replacement string; must not point into @p str
+ */
+void replace_all_inplace(std::string& str, std::string_view from, std::string_view to);
+
+/**
+ * @brief Replace all occurrences of a character in place
+ * @param str String to modify
+ * @param from Character to find
+ * @param to Replacement character
+ */
+void replace_all_inplace(std::string& str, char from, char to);
+
 // ============================================================================
 // Removal
 // ============================================================================
@@ -300,6 +382,20 @@ std::string remove(std::string_view str, char ch);
  */
 std::string remove_all(std::string_view str, char ch);
 
+/**
+ * @brief Remove all occurrences of a substring in place, without allocating
+ * @param str String to modify
+ * @param substr Substring to remove; must not point into @p str
+ */
+void remove_all_inplace(std::string& str, std::string_view substr);
+
+/**
+ * @brief Remove all occurrences of a character in place, without allocating
+ * @param str String to modify
+ * @param ch Character to remove
+ */
+void remove_all_inplace(std::string& str, char ch);
+
 // ============================================================================
 // Splitting and Joining
 // ============================================================================
@@ -381,6 +477,108 @@ std::string join(const std::vector<std::string>& parts,
  */
 std::string join(const std::vector<std::string>& parts, char delimiter);
 
+// ============================================================================
+// Zero-Copy Splitting
+// ============================================================================
+//
+// Same parts as the split functions above, as views into the input: no
+// allocation per part. The input must outlive the views. The overloads
+// taking `out` clear it and refill it, reusing its capacity, so splitting
+// in a loop with one vector does not allocate once it has grown.
+
+/**
+ * @brief split() by a character delimiter, into views
+ * @param str Input string
+ * @param delimiter Character to split on
+ * @param out Cleared, then filled with the parts
+ * @param keep_empty Whether to keep empty parts (default: true)
+ */
+void split_view(std::string_view str,
+                char delimiter,
+                std::vector<std::string_view>& out,
+                bool keep_empty = true);
+
+/**
+ * @brief split() by a string delimiter, into views
+ * @param str Input string
+ * @param delimiter String to split on
+ * @param out Cleared, then filled with the parts
+ * @param keep_empty Whether to keep empty parts (default: true)
+ */
+void split_view(std::string_view str,
+                std::string_view delimiter,
+                std::vector<std::string_view>& out,
+                bool keep_empty = true);
+
+/**
+ * @brief split_any() into views
+ * @param str Input string
+ * @param delimiters Set of delimiter characters
+ * @param out Cleared, then filled with the parts
+ * @param keep_empty Whether to keep empty parts (default: false)
+ */
+void split_any_view(std::string_view str,
+                    std::string_view delimiters,
+                    std::vector<std::string_view>& out,
+                    bool keep_empty = false);
+
+/**
+ * @brief split_lines() into views
+ * @param str Input string
+ * @param out Cleared, then filled with the lines
+ * @param keep_empty Whether to keep empty lines (default: true)
+ */
+void split_lines_view(std::string_view str,
+                      std::vector<std::string_view>& out,
+                      bool keep_empty = true);
+
+/**
+ * @brief split_whitespace() into views
+ * @param str Input string
+ * @param out Cleared, then filled with the tokens
+ */
+void split_whitespace_view(std::string_view str,
+                           std::vector<std::string_view>& out);
+
+/**
+ * @brief split_n() into views
+ * @param str Input string
+ * @param delimiter Character to split on
+ * @param max_parts Maximum number of parts (0 = unlimited)
+ * @param out Cleared, then filled with the parts
+ */
+void split_n_view(std::string_view str,
+                  char delimiter,
+                  size_t max_parts,
+                  std::vector<std::string_view>& out);
+
+/// @brief split_view() returning a new vector
+std::vector<std::string_view> split_view(std::string_view str,
+                                         char delimiter,
+                                         bool keep_empty = true);
+
+/// @brief split_view() returning a new vector
+std::vector<std::string_view> split_view(std::string_view str,
+                                         std::string_view delimiter,
+                                         bool keep_empty = true);
+
+/// @brief split_any_view() returning a new vector
+std::vector<std::string_view> split_any_view(std::string_view str,
+                                             std::string_view delimiters,
+                                             bool keep_empty = false);
+
+/// @brief split_lines_view() returning a new vector
+std::vector<std::string_view> split_lines_view(std::string_view str,
+                                               bool keep_empty = true);
+
+/// @brief split_whitespace_view() returning a new vector
+std::vector<std::string_view> split_whitespace_view(std::string_view str);
+
+/// @brief split_n_view() returning a new vector
+std::vector<std::string_view> split_n_view(std::string_view str,
+                                           char delimiter,
+                                           size_t max_parts);
+
 // ============================================================================
 // Substring Extraction
 // ============================================================================
@@ -595,6 +793,11 @@ bool is_identifier(std::string_view str);
 // ============================================================================
 // Number Parsing (returns std::optional for safe error handling)
 // ============================================================================
+//
+// All parsers ignore surrounding whitespace, accept exactly the number and
+// nothing after it, and never consult the locale. Decimal integers are read
+// eight digits at a time; doubles take an exact fast path for up to 19
+// digits and small exponents, and std::from_chars otherwise.
 
 /**
  * @brief Parse string as integer
@@ -640,7 +843,7 @@ std::optional<unsigned long> to_ulong(std::string_view str);
 std::optional<unsigned long long> to_ullong(std::string_view str);
 
 /**
- * @brief Parse string as float
+ * @brief Parse string as float, with the syntax of to_double()
  * @param str Input string
  * @return Parsed float or std::nullopt on failure
  */
@@ -648,11 +851,41 @@ std::optional<float> to_float(std::string_view str);
 
 /**
  * @brief Parse string as double
+ *
+ * Accepts the strtod() syntax of the "C" locale: optional sign, decimal or
+ * "0x" hexadecimal digits, exponent, "inf" and "nan". The result is
+ * correctly rounded. A value outside the range of double is an error.
+ *
  * @param str Input string
  * @return Parsed double or std::nullopt on failure
  */
 std::optional<double> to_double(std::string_view str);
 
+namespace detail
+{
+/// @brief Backend of to_decimal(): the value of @p str times 10^scale
+std::optional<std::int64_t> parse_decimal(std::string_view str, int scale) noexcept;
+} // namespace detail
+
+/**
+ * @brief Parse a decimal number as a fixed-point integer
+ *
+ * to_decimal<4>("187.5") is 1875000. The result is exact: there is no
+ * binary floating point in between, and digits past @p Scale must be
+ * zeros. Accepts an optional sign, and "5.", ".5" but no exponent.
+ *
+ * @tparam Scale Decimal places of the result, 0 to 18
+ * @param str Input string
+ * @return Value times 10^Scale, or std::nullopt on invalid input, lost
+ *         digits or overflow of int64_t
+ */
+template <int Scale>
+std::optional<std::int64_t> to_decimal(std::string_view str) noexcept
+{
+  static_assert(Scale >= 0 && Scale <= 18, "to_decimal scale must be 0 to 18");
+  return detail::parse_decimal(str, Scale);
+}
+
 // ============================================================================
 // Number to String Conversion
 // ============================================================================
@@ -835,6 +1068,19 @@ std::string squeeze(std::string_view str);
  */
 std::string squeeze(std::string_view str, char ch);
 
+/**
+ * @brief Remove consecutive duplicate characters in place
+ * @param str String to modify
+ */
+void squeeze_inplace(std::string& str);
+
+/**
+ * @brief Reduce runs of a specific character to one, in place
+ * @param str String to modify
+ * @param ch Character to squeeze
+ */
+void squeeze_inplace(std::string& str, char ch);
+
 /**
  * @brief Normalize whitespace (collapse consecutive whitespace to single space)
  * @param str Input string
@@ -842,6 +1088,12 @@ std::string squeeze(std::string_view str, char ch);
  */
 std::string normalize_whitespace(std::string_view str);
 
+/**
+ * @brief Normalize whitespace in place
+ * @param str String to modify
+ */
+void normalize_whitespace_inplace(std::string& str);
+
 /**
  * @brief Wrap text at specified width
  * @param str Input string
@@ -886,12 +1138,32 @@ std::string common_suffix(std::string_view a, std::string_view b);
 
 /**
  * @brief Calculate Levenshtein distance between two strings
+ *
+ * Strings of up to 64 characters, after dropping a common prefix and
+ * suffix, use Myers' bit-parallel algorithm: one pass over the longer
+ * string, without a DP matrix.
+ *
  * @param a First string
  * @param b Second string
  * @return Edit distance
  */
 size_t levenshtein_distance(std::string_view a, std::string_view b);
 
+/**
+ * @brief Calculate Levenshtein distance, giving up past a bound
+ *
+ * Stops as soon as the distance must exceed @p max_distance, and only
+ * computes the diagonal band the bound allows (Ukkonen) for strings
+ * longer than 64 characters. Strings whose lengths differ by more than
+ * the bound cost nothing.
+ *
+ * @param a First string
+ * @param b Second string
+ * @param max_distance Largest distance of interest
+ * @return Edit distance, or max_distance + 1 if it is larger
+ */
+size_t levenshtein_distance(std::string_view a, std::string_view b, size_t max_distance);
+
 // ============================================================================
 // Case Style Conversions
 // ============================================================================
@@ -914,6 +1186,16 @@ size_t levenshtein_distance(std::string_view a, std::string_view b);
  */
 std::string to_snake_case(std::string_view str);
 
+/**
+ * @brief Convert to snake_case in place
+ *
+ * Rewrites the buffer of @p str unless a camelCase boundary makes the
+ * text longer ("helloWorld"), in which case it is rebuilt once.
+ *
+ * @param str String to convert
+ */
+void to_snake_case_inplace(std::string& str);
+
 /**
  * @brief Convert string to camelCase
  *
@@ -1039,7 +1321,9 @@ double similarity(std::string_view a, std::string_view b);
 /**
  * @brief Check if string matches another within a maximum edit distance
  *
- * Uses Levenshtein distance for comparison.
+ * Uses the bounded levenshtein_distance(), so most mismatches are
+ * rejected after a few characters. To match one pattern against many
+ * strings, string_list::filter_fuzzy() prepares it once.
  *
  * @param str String to check
  * @param target Target string to match against
@@ -1064,6 +1348,17 @@ bool fuzzy_match(std::string_view str,
  */
 size_t word_count(std::string_view str);
 
+/**
+ * @brief Count lines in a string
+ *
+ * Lines end at \n, \r or \r\n. A final line ending does not start
+ * another line: "a\nb" and "a\nb\n" both have 2 lines, "" has none.
+ *
+ * @param str Input string
+ * @return Number of lines, as line_reader reads them
+ */
+size_t line_count(std::string_view str);
+
 /**
  * @brief Expand tabs to spaces
  *
@@ -1073,6 +1368,17 @@ size_t word_count(std::string_view str);
  */
 std::string expand_tabs(std::string_view str, size_t tab_width = 4);
 
+/**
+ * @brief Expand tabs to spaces in place
+ *
+ * Leaves a string without tabs untouched; otherwise the text grows and is
+ * rebuilt once at its final size.
+ *
+ * @param str String to modify
+ * @param tab_width Number of spaces per tab (default: 4)
+ */
+void expand_tabs_inplace(std::string& str, size_t tab_width = 4);
+
 /**
  * @brief Normalize line endings to a single style
  *
@@ -1085,6 +1391,17 @@ std::string expand_tabs(std::string_view str, size_t tab_width = 4);
 std::string normalize_line_endings(std::string_view str,
                                    std::string_view ending = "\n");
 
+/**
+ * @brief Normalize line endings in place
+ *
+ * A one-character @p ending never lengthens the text and rewrites it
+ * without allocating. A longer one grows the buffer at most once.
+ *
+ * @param str String to modify
+ * @param ending Line ending to use (default: "\n"); must not point into @p str
+ */
+void normalize_line_endings_inplace(std::string& str, std::string_view ending = "\n");
+
 /**
  * @brief Check if string is a palindrome
  *
@@ -8,6 +8,7 @@
 /// - Code point counting and indexing
 /// - UTF-8 aware substring operations
 /// - Validation and sanitization
+/// - utf8_indexed_view for repeated random access by code point
 ///
 /// Thread Safety:
 /// - All functions are thread-safe (pure functions)
@@ -34,6 +35,7 @@
 #include <cstddef>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace fb
 {
@@ -115,4 +117,80 @@ namespace fb
 /// @return Code point index, or string::npos if offset invalid
 [[nodiscard]] std::size_t utf8_codepoint_index(std::string_view str, std::size_t byte_offset) noexcept;
 
+// ============================================================================
+// Indexed View
+// ============================================================================
+
+/**
+ * @brief UTF-8 string view with a sparse code point to byte offset index
+ *
+ * The free functions above walk from the start of the string on every
+ * call, so a loop over code point positions is quadratic. This view walks
+ * the string once and records the byte offset of every STRIDE-th code
+ * point; a lookup then walks at most STRIDE - 1 code points from the
+ * nearest checkpoint. Pure-ASCII strings need no index at all.
+ *
+ * Code points are counted exactly as by the free functions (an invalid or
+ * truncated sequence counts as one code point per byte), and the free
+ * function overloads taking a utf8_indexed_view return the same results.
+ *
+ * The viewed string must outlive the view and stay unchanged.
+ *
+ * @code
+ * fb::utf8_indexed_view text(document);
+ * for (std::size_t i = 0; i < text.length(); ++i) {
+ *     std::string_view cp = text.at(i);  // No rescan from the start
+ * }
+ * @endcode
+ */
+class utf8_indexed_view
+{
+public:
+  /// @brief Code points between two checkpoints of the index
+  static constexpr std::size_t STRIDE = 64;
+
+  utf8_indexed_view() noexcept = default;
+  explicit utf8_indexed_view(std::string_view str);
+
+  /// @brief The viewed bytes
+  [[nodiscard]] std::string_view str() const noexcept { return m_str; }
+
+  /// @brief Length in code points
+  [[nodiscard]] std::size_t length() const noexcept { return m_length; }
+
+  /// @brief true if every code point is a single byte
+  [[nodiscard]] bool is_ascii() const noexcept { return m_length == m_str.size(); }
+
+  /// @brief Byte offset of a code point index, string::npos if past length()
+  [[nodiscard]] std::size_t byte_offset(std::size_t codepoint_index) const noexcept;
+
+  /// @brief Code points that start before @p byte_offset, string::npos if
+  ///        past the end
+  [[nodiscard]] std::size_t codepoint_index(std::size_t byte_offset) const noexcept;
+
+  /// @brief Code point at @p index, empty if out of range
+  [[nodiscard]] std::string_view at(std::size_t index) const noexcept;
+
+  /// @brief Up to @p count code points from @p pos, empty if pos is out of range
+  [[nodiscard]] std::string_view substr(std::size_t pos, std::size_t count = std::string::npos) const noexcept;
+
+private:
+  std::string_view         m_str;
+  std::size_t              m_length = 0;
+  std::vector<std::size_t> m_checkpoints; ///< Byte offset of code point k * STRIDE
+};
+
+/// @name utf8_indexed_view overloads
+/// Same results as the std::string_view versions, without the rescan.
+/// @{
+[[nodiscard]] std::size_t utf8_length(const utf8_indexed_view& str) noexcept;
+[[nodiscard]] std::string utf8_at(const utf8_indexed_view& str, std::size_t index);
+[[nodiscard]] std::string utf8_left(const utf8_indexed_view& str, std::size_t n);
+[[nodiscard]] std::string utf8_right(const utf8_indexed_view& str, std::size_t n);
+[[nodiscard]] std::string utf8_mid(const utf8_indexed_view& str, std::size_t pos,
+                                    std::size_t count = std::string::npos);
+[[nodiscard]] std::size_t utf8_byte_offset(const utf8_indexed_view& str, std::size_t codepoint_index) noexcept;
+[[nodiscard]] std::size_t utf8_codepoint_index(const utf8_indexed_view& str, std::size_t byte_offset) noexcept;
+/// @}
+
 } // namespace fb
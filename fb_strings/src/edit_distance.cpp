@@ -0,0 +1,212 @@
+/// @file edit_distance.cpp
+/// @brief Bit-parallel and banded Levenshtein distance
+
+#include <fb/detail/edit_distance.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace fb
+{
+namespace detail
+{
+
+namespace
+{
+
+constexpr std::size_t WORD_BITS = 64;
+
+/**
+ * Myers' bit-parallel distance, in Hyyrö's formulation for whole strings.
+ * Bit i of the vertical delta vectors holds D[i+1][j] - D[i][j] for the
+ * current text column j; each text character updates all rows with a
+ * handful of word operations. score tracks the last row, D[m][j].
+ */
+std::size_t myers_distance(const std::array<std::uint64_t, 256>& match,
+                           std::size_t query_size,
+                           std::string_view text,
+                           std::size_t max_distance) noexcept
+{
+  const std::uint64_t last_row = std::uint64_t{1} << (query_size - 1);
+  std::uint64_t plus_vertical  = ~std::uint64_t{0};
+  std::uint64_t minus_vertical = 0;
+  std::size_t score            = query_size;
+
+  for (std::size_t j = 0; j < text.size(); ++j)
+  {
+    const std::uint64_t equal = match[static_cast<unsigned char>(text[j])];
+    const std::uint64_t xv    = equal | minus_vertical;
+    const std::uint64_t xh    = (((equal & plus_vertical) + plus_vertical) ^ plus_vertical) | equal;
+    std::uint64_t plus_horizontal  = minus_vertical | ~(xh | plus_vertical);
+    std::uint64_t minus_horizontal = plus_vertical & xh;
+
+    if (plus_horizontal & last_row)
+    {
+      ++score;
+    }
+    else if (minus_horizontal & last_row)
+    {
+      --score;
+    }
+
+    // Each remaining text character lowers the distance by at most one
+    if (score > max_distance && score - max_distance > text.size() - j - 1)
+    {
+      return max_distance + 1;
+    }
+
+    // Row 0 is D[0][j] = j: its horizontal delta is always +1
+    plus_horizontal  = (plus_horizontal << 1) | 1;
+    minus_horizontal = minus_horizontal << 1;
+    plus_vertical    = minus_horizontal | ~(xv | plus_horizontal);
+    minus_vertical   = plus_horizontal & xv;
+  }
+  return std::min(score, max_distance + 1);
+}
+
+/// Full dynamic programming over one row
+std::size_t row_distance(std::string_view a, std::string_view b)
+{
+  std::vector<std::size_t> row(b.size() + 1);
+  for (std::size_t j = 0; j <= b.size(); ++j)
+  {
+    row[j] = j;
+  }
+  for (std::size_t i = 1; i <= a.size(); ++i)
+  {
+    std::size_t diagonal = row[0];
+    row[0]               = i;
+    for (std::size_t j = 1; j <= b.size(); ++j)
+    {
+      const std::size_t up = row[j];
+      row[j] = std::min({up + 1, row[j - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1)});
+      diagonal = up;
+    }
+  }
+  return row[b.size()];
+}
+
+/**
+ * Ukkonen's cutoff: a path with at most max_distance edits never leaves
+ * the diagonals |i - j| <= max_distance, so each row only computes those
+ * cells, and a row whose minimum exceeds the bound ends the search.
+ */
+std::size_t banded_distance(std::string_view a, std::string_view b, std::size_t max_distance)
+{
+  const std::size_t limit = max_distance + 1;
+  std::vector<std::size_t> row(b.size() + 1);
+  for (std::size_t j = 0; j <= b.size(); ++j)
+  {
+    row[j] = std::min(j, limit);
+  }
+
+  for (std::size_t i = 1; i <= a.size(); ++i)
+  {
+    const std::size_t first = i > max_distance ? i - max_distance : 1;
+    const std::size_t last  = std::min(b.size(), i + max_distance);
+    if (first > last)
+    {
+      return limit;
+    }
+
+    // Cells left of the band hold the limit, except column 0, D[i][0] = i
+    std::size_t diagonal = row[first - 1];
+    row[first - 1]       = first == 1 ? std::min(i, limit) : limit;
+    std::size_t row_min  = row[first - 1];
+    for (std::size_t j = first; j <= last; ++j)
+    {
+      const std::size_t up = row[j];
+      row[j] = std::min({up + 1, row[j - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1), limit});
+      diagonal = up;
+      row_min  = std::min(row_min, row[j]);
+    }
+    if (row_min >= limit)
+    {
+      return limit;
+    }
+  }
+  return row[b.size()];
+}
+
+} // namespace
+
+// ============================================================================
+// edit_distance_query
+// ============================================================================
+
+edit_distance_query::edit_distance_query(std::string_view query) noexcept
+  : m_query(query)
+{
+  if (query.size() <= WORD_BITS)
+  {
+    for (std::size_t i = 0; i < query.size(); ++i)
+    {
+      m_match[static_cast<unsigned char>(query[i])] |= std::uint64_t{1} << i;
+    }
+  }
+}
+
+std::size_t edit_distance_query::distance(std::string_view text, std::size_t max_distance) const noexcept
+{
+  const std::size_t length_difference =
+      text.size() > m_query.size() ? text.size() - m_query.size() : m_query.size() - text.size();
+  if (length_difference > max_distance)
+  {
+    return max_distance + 1;
+  }
+  if (m_query.empty() || text.empty())
+  {
+    return length_difference;
+  }
+  if (m_query.size() <= WORD_BITS)
+  {
+    return myers_distance(m_match, m_query.size(), text, max_distance);
+  }
+  return edit_distance(m_query, text, max_distance);
+}
+
+// ============================================================================
+// edit_distance
+// ============================================================================
+
+std::size_t edit_distance(std::string_view a, std::string_view b, std::size_t max_distance)
+{
+  // Common ends never change the distance: drop them first
+  std::size_t prefix = 0;
+  while (prefix < a.size() && prefix < b.size() && a[prefix] == b[prefix])
+  {
+    ++prefix;
+  }
+  a.remove_prefix(prefix);
+  b.remove_prefix(prefix);
+  while (!a.empty() && !b.empty() && a.back() == b.back())
+  {
+    a.remove_suffix(1);
+    b.remove_suffix(1);
+  }
+
+  if (a.size() > b.size())
+  {
+    std::swap(a, b);
+  }
+  if (b.size() - a.size() > max_distance)
+  {
+    return max_distance + 1;
+  }
+  if (a.empty())
+  {
+    return b.size();
+  }
+  if (a.size() <= WORD_BITS)
+  {
+    return edit_distance_query(a).distance(b, max_distance);
+  }
+  if (max_distance < b.size())
+  {
+    return banded_distance(a, b, max_distance);
+  }
+  return row_distance(a, b);
+}
+
+} // namespace detail
+} // namespace fb
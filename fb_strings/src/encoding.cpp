@@ -0,0 +1,1046 @@
+/// @file encoding.cpp
+/// @brief Hex, Base64 and percent encoders and decoders, with SSE2 and AVX2 kernels,
+///        and JSON / HTML escaping
+
+#include <fb/encoding.h>
+#include <fb/format.h>
+#include <fb/simd_search.h>
+
+#include <fb/detail/simd_isa.h>
+
+#include <array>
+#include <cstring>
+
+namespace fb
+{
+
+namespace
+{
+
+// ============================================================================
+// Tables
+// ============================================================================
+
+constexpr char HEX_LOWER[] = "0123456789abcdef";
+constexpr char HEX_UPPER[] = "0123456789ABCDEF";
+
+constexpr char BASE64_STANDARD[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char BASE64_URL[]      = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Base64 decode table entries besides the values 0-63; all negative, so
+// the OR of four entries is negative unless all four are values
+constexpr std::int8_t B64_INVALID    = -1;
+constexpr std::int8_t B64_WHITESPACE = -2;
+constexpr std::int8_t B64_PAD        = -3;
+
+using base64_table = std::array<std::int8_t, 256>;
+
+constexpr base64_table make_base64_table(const char* chars)
+{
+  base64_table table{};
+  for (auto& entry : table)
+  {
+    entry = B64_INVALID;
+  }
+  for (int value = 0; value < 64; ++value)
+  {
+    table[static_cast<unsigned char>(chars[value])] = static_cast<std::int8_t>(value);
+  }
+  for (unsigned char ch : {' ', '\t', '\n', '\r', '\f', '\v'})
+  {
+    table[ch] = B64_WHITESPACE;
+  }
+  table['='] = B64_PAD;
+  return table;
+}
+
+constexpr base64_table BASE64_STANDARD_TABLE = make_base64_table(BASE64_STANDARD);
+constexpr base64_table BASE64_URL_TABLE      = make_base64_table(BASE64_URL);
+
+const char* base64_chars(base64_alphabet alphabet) noexcept
+{
+  return alphabet == base64_alphabet::url ? BASE64_URL : BASE64_STANDARD;
+}
+
+const base64_table& base64_values(base64_alphabet alphabet) noexcept
+{
+  return alphabet == base64_alphabet::url ? BASE64_URL_TABLE : BASE64_STANDARD_TABLE;
+}
+
+constexpr std::array<std::int8_t, 256> make_hex_table()
+{
+  std::array<std::int8_t, 256> table{};
+  for (int ch = 0; ch < 256; ++ch)
+  {
+    table[static_cast<std::size_t>(ch)] = static_cast<std::int8_t>(ch >= '0' && ch <= '9'   ? ch - '0'
+                                                                   : ch >= 'a' && ch <= 'f' ? ch - 'a' + 10
+                                                                   : ch >= 'A' && ch <= 'F' ? ch - 'A' + 10
+                                                                                            : -1);
+  }
+  return table;
+}
+
+constexpr std::array<std::int8_t, 256> HEX_VALUES = make_hex_table();
+
+/// @return 0-15, or -1 for a non-hex character
+int hex_value(unsigned char ch) noexcept
+{
+  return HEX_VALUES[ch];
+}
+
+/// Unreserved characters of RFC 3986, left as they are by percent_encode()
+constexpr std::array<bool, 256> make_unreserved_table()
+{
+  std::array<bool, 256> table{};
+  for (int ch = 0; ch < 256; ++ch)
+  {
+    table[static_cast<std::size_t>(ch)] = (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') ||
+                                          (ch >= '0' && ch <= '9') || ch == '-' || ch == '_' || ch == '.' ||
+                                          ch == '~';
+  }
+  return table;
+}
+
+constexpr std::array<bool, 256> UNRESERVED = make_unreserved_table();
+
+const unsigned char* bytes(std::string_view str) noexcept
+{
+  return reinterpret_cast<const unsigned char*>(str.data());
+}
+
+[[maybe_unused]] bool use_sse2() noexcept
+{
+  const simd::isa active = simd::active_isa();
+  return active == simd::isa::sse2 || active == simd::isa::avx2;
+}
+
+[[maybe_unused]] bool use_avx2() noexcept
+{
+  return simd::active_isa() == simd::isa::avx2;
+}
+
+// ============================================================================
+// SSE2 Kernels
+// ============================================================================
+
+#if FB_SIMD_SSE2
+
+/// Hex digits of nibbles 0-15; @p letter_offset turns 10-15 into a-f or A-F
+__m128i hex_digits_sse2(__m128i nibbles, __m128i letter_offset) noexcept
+{
+  __m128i letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+  return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), _mm_and_si128(letters, letter_offset));
+}
+
+/// @return Bytes encoded, a multiple of 16
+std::size_t hex_encode_sse2(const unsigned char* in, std::size_t size, char* out, bool uppercase) noexcept
+{
+  constexpr std::size_t BLOCK = 16;
+  const __m128i low_nibble    = _mm_set1_epi8(0x0F);
+  const __m128i letter_offset = _mm_set1_epi8(uppercase ? 'A' - '0' - 10 : 'a' - '0' - 10);
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i high  = hex_digits_sse2(_mm_and_si128(_mm_srli_epi16(block, 4), low_nibble), letter_offset);
+    __m128i low   = hex_digits_sse2(_mm_and_si128(block, low_nibble), letter_offset);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + BLOCK), _mm_unpackhi_epi8(high, low));
+  }
+  return i;
+}
+
+/// Values of 16 hex digits; false if any byte is not one
+bool hex_values_sse2(__m128i chars, __m128i& values) noexcept
+{
+  __m128i digit     = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  __m128i is_digit  = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+  __m128i letter    = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+  values            = _mm_or_si128(_mm_and_si128(is_digit, digit),
+                                   _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+  return _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) == 0xFFFF;
+}
+
+/// Pairs of digit values to bytes, in 16-bit lanes: first digit high
+__m128i hex_pairs_sse2(__m128i values) noexcept
+{
+  return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(values, 8));
+}
+
+/// @return Characters decoded, a multiple of 32; stops before a block with a non-hex character
+std::size_t hex_decode_sse2(const char* in, std::size_t size, char* out) noexcept
+{
+  constexpr std::size_t BLOCK = 32;
+  std::size_t i               = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m128i first;
+    __m128i second;
+    if (!hex_values_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), first) ||
+        !hex_values_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)), second))
+    {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2),
+                     _mm_packus_epi16(hex_pairs_sse2(first), hex_pairs_sse2(second)));
+  }
+  return i;
+}
+
+#endif // FB_SIMD_SSE2
+
+// ============================================================================
+// AVX2 Kernels
+// ============================================================================
+
+#if FB_SIMD_AVX2
+
+FB_TARGET_AVX2 __m256i hex_digits_avx2(__m256i nibbles, __m256i letter_offset)
+{
+  __m256i letters = _mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+  return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), _mm256_and_si256(letters, letter_offset));
+}
+
+/// @return Bytes encoded, a multiple of 32
+FB_TARGET_AVX2 std::size_t hex_encode_avx2(const unsigned char* in, std::size_t size, char* out, bool uppercase)
+{
+  constexpr std::size_t BLOCK = 32;
+  const __m256i low_nibble    = _mm256_set1_epi8(0x0F);
+  const __m256i letter_offset = _mm256_set1_epi8(uppercase ? 'A' - '0' - 10 : 'a' - '0' - 10);
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    __m256i high  = hex_digits_avx2(_mm256_and_si256(_mm256_srli_epi16(block, 4), low_nibble), letter_offset);
+    __m256i low   = hex_digits_avx2(_mm256_and_si256(block, low_nibble), letter_offset);
+
+    // Unpacking works within 128-bit lanes: bytes 0-7 and 16-23, then 8-15 and 24-31
+    __m256i first  = _mm256_unpacklo_epi8(high, low);
+    __m256i second = _mm256_unpackhi_epi8(high, low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + BLOCK),
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return i;
+}
+
+FB_TARGET_AVX2 bool hex_values_avx2(__m256i chars, __m256i& values)
+{
+  __m256i digit     = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+  __m256i is_digit  = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+  __m256i letter    = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+  values            = _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                                      _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+  return _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) == -1;
+}
+
+FB_TARGET_AVX2 __m256i hex_pairs_avx2(__m256i values)
+{
+  return _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(values, _mm256_set1_epi16(0x00FF)), 4),
+                         _mm256_srli_epi16(values, 8));
+}
+
+/// @return Characters decoded, a multiple of 64; stops before a block with a non-hex character
+FB_TARGET_AVX2 std::size_t hex_decode_avx2(const char* in, std::size_t size, char* out)
+{
+  constexpr std::size_t BLOCK = 64;
+  std::size_t i               = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m256i first;
+    __m256i second;
+    if (!hex_values_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), first) ||
+        !hex_values_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32)), second))
+    {
+      break;
+    }
+    // Packing works within 128-bit lanes: put the quarters back in order
+    __m256i packed = _mm256_packus_epi16(hex_pairs_avx2(first), hex_pairs_avx2(second));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+  }
+  return i;
+}
+
+/// Select @p value where @p mask is set
+FB_TARGET_AVX2 __m256i select_avx2(__m256i mask, __m256i value, __m256i otherwise)
+{
+  return _mm256_blendv_epi8(otherwise, value, mask);
+}
+
+/**
+ * Base64 encoding 24 bytes at a time (Muła and Lemire): each 128-bit lane
+ * spreads 12 input bytes over 16 bytes, splits every 3 bytes into four
+ * 6-bit values with two multiplies, then adds the offset that maps each
+ * value's range to its characters.
+ *
+ * @return Bytes encoded, a multiple of 24; reads 4 bytes past them
+ */
+FB_TARGET_AVX2 std::size_t base64_encode_avx2(const unsigned char* in, std::size_t size, char* out, const char* chars)
+{
+  constexpr std::size_t BLOCK = 24;
+  const __m256i spread        = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const __m256i offset_62     = _mm256_set1_epi8(static_cast<char>(chars[62] - 62));
+  const __m256i offset_63     = _mm256_set1_epi8(static_cast<char>(chars[63] - 63));
+
+  std::size_t i = 0;
+  for (; i + BLOCK + 4 <= size; i += BLOCK)
+  {
+    __m128i low_lane  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i high_lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+    __m256i input     = _mm256_shuffle_epi8(
+        _mm256_inserti128_si256(_mm256_castsi128_si256(low_lane), high_lane, 1), spread);
+
+    __m256i ac     = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)),
+                                        _mm256_set1_epi32(0x04000040));
+    __m256i bd     = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)),
+                                        _mm256_set1_epi32(0x01000010));
+    __m256i values = _mm256_or_si256(ac, bd);
+
+    __m256i offset = _mm256_set1_epi8('A');
+    offset = select_avx2(_mm256_cmpgt_epi8(values, _mm256_set1_epi8(25)), _mm256_set1_epi8('a' - 26), offset);
+    offset = select_avx2(_mm256_cmpgt_epi8(values, _mm256_set1_epi8(51)), _mm256_set1_epi8('0' - 52), offset);
+    offset = select_avx2(_mm256_cmpeq_epi8(values, _mm256_set1_epi8(62)), offset_62, offset);
+    offset = select_avx2(_mm256_cmpeq_epi8(values, _mm256_set1_epi8(63)), offset_63, offset);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 3 * 4), _mm256_add_epi8(values, offset));
+  }
+  return i;
+}
+
+/// Whether every byte of @p chars is in [first, last], as a mask
+FB_TARGET_AVX2 __m256i in_range_avx2(__m256i chars, char first, char last)
+{
+  return _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8(static_cast<char>(first - 1))),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(last + 1)), chars));
+}
+
+/**
+ * Base64 decoding 32 characters at a time: range compares map characters
+ * to values (bytes of 128 and up compare as negative and fail), two
+ * multiply-adds join four 6-bit values into 3 bytes, and a shuffle and a
+ * permute pack the 24 bytes together.
+ *
+ * @return Characters decoded, a multiple of 32; stops before a block with
+ *         anything but alphabet characters
+ */
+FB_TARGET_AVX2 std::size_t base64_decode_avx2(const unsigned char* in, std::size_t size, char* out, const char* chars)
+{
+  constexpr std::size_t BLOCK = 32;
+  const __m256i char_62       = _mm256_set1_epi8(chars[62]);
+  const __m256i char_63       = _mm256_set1_epi8(chars[63]);
+  const __m256i pack_lanes    = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m256i block    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    __m256i is_upper = in_range_avx2(block, 'A', 'Z');
+    __m256i is_lower = in_range_avx2(block, 'a', 'z');
+    __m256i is_digit = in_range_avx2(block, '0', '9');
+    __m256i is_62    = _mm256_cmpeq_epi8(block, char_62);
+    __m256i is_63    = _mm256_cmpeq_epi8(block, char_63);
+    __m256i valid    = _mm256_or_si256(_mm256_or_si256(is_upper, is_lower), _mm256_or_si256(is_digit, is_62));
+    if (_mm256_movemask_epi8(_mm256_or_si256(valid, is_63)) != -1)
+    {
+      break;
+    }
+
+    __m256i offset = _mm256_and_si256(is_upper, _mm256_set1_epi8(-'A'));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(is_lower, _mm256_set1_epi8(26 - 'a')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(is_digit, _mm256_set1_epi8(52 - '0')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(is_62, _mm256_set1_epi8(static_cast<char>(62 - chars[62]))));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(is_63, _mm256_set1_epi8(static_cast<char>(63 - chars[63]))));
+    __m256i values = _mm256_add_epi8(block, offset);
+
+    // a b c d -> 00aaaaaa bbbbbbbb... : (a << 6 | b) and (c << 6 | d), then (ab << 12 | cd)
+    __m256i pairs   = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    __m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    __m256i packed  = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(triples, pack_lanes),
+                                                  _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+    char* target = out + i / 4 * 3;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm256_castsi256_si128(packed));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(target + 16), _mm256_extracti128_si256(packed, 1));
+  }
+  return i;
+}
+
+#endif // FB_SIMD_AVX2
+
+// ============================================================================
+// Bulk Loops
+// ============================================================================
+
+/// Encode whole groups of 3 bytes
+/// @return Bytes encoded, a multiple of 3
+std::size_t base64_encode_groups(const unsigned char* in, std::size_t size, char* out, const char* chars) noexcept
+{
+  std::size_t i = 0;
+#if FB_SIMD_AVX2
+  if (use_avx2())
+  {
+    i = base64_encode_avx2(in, size, out, chars);
+  }
+#endif
+  for (; i + 3 <= size; i += 3)
+  {
+    const std::uint32_t triple = static_cast<std::uint32_t>(in[i]) << 16 |
+                                 static_cast<std::uint32_t>(in[i + 1]) << 8 | in[i + 2];
+    char* target = out + i / 3 * 4;
+    target[0]    = chars[triple >> 18];
+    target[1]    = chars[(triple >> 12) & 0x3F];
+    target[2]    = chars[(triple >> 6) & 0x3F];
+    target[3]    = chars[triple & 0x3F];
+  }
+  return i;
+}
+
+/// Encode the last 1 or 2 bytes
+/// @return Characters written
+std::size_t base64_encode_tail(const unsigned char* in, std::size_t size, char* out, const char* chars,
+                               bool padding) noexcept
+{
+  if (size == 0)
+  {
+    return 0;
+  }
+  const std::uint32_t pair = static_cast<std::uint32_t>(in[0]) << 16 |
+                             (size > 1 ? static_cast<std::uint32_t>(in[1]) << 8 : 0);
+  out[0]            = chars[pair >> 18];
+  out[1]            = chars[(pair >> 12) & 0x3F];
+  std::size_t count = 2;
+  if (size > 1)
+  {
+    out[count++] = chars[(pair >> 6) & 0x3F];
+  }
+  if (padding)
+  {
+    while (count < 4)
+    {
+      out[count++] = '=';
+    }
+  }
+  return count;
+}
+
+/// Decode whole groups of 4 alphabet characters
+/// @return Characters decoded, a multiple of 4; stops before a group with
+///         whitespace, padding or an invalid character
+std::size_t base64_decode_groups(const unsigned char* in, std::size_t size, char* out,
+                                 base64_alphabet alphabet) noexcept
+{
+  std::size_t i = 0;
+#if FB_SIMD_AVX2
+  if (use_avx2())
+  {
+    i = base64_decode_avx2(in, size, out, base64_chars(alphabet));
+  }
+#endif
+  const base64_table& table = base64_values(alphabet);
+  for (; i + 4 <= size; i += 4)
+  {
+    const std::int8_t a = table[in[i]];
+    const std::int8_t b = table[in[i + 1]];
+    const std::int8_t c = table[in[i + 2]];
+    const std::int8_t d = table[in[i + 3]];
+    if ((a | b | c | d) < 0)
+    {
+      break;
+    }
+    const std::uint32_t triple = static_cast<std::uint32_t>(a) << 18 | static_cast<std::uint32_t>(b) << 12 |
+                                 static_cast<std::uint32_t>(c) << 6 | static_cast<std::uint32_t>(d);
+    char* target = out + i / 4 * 3;
+    target[0]    = static_cast<char>(triple >> 16);
+    target[1]    = static_cast<char>(triple >> 8);
+    target[2]    = static_cast<char>(triple);
+  }
+  return i;
+}
+
+/// @return Characters decoded; stops before the first byte with a non-hex character
+std::size_t hex_decode_pairs(const char* in, std::size_t size, char* out) noexcept
+{
+  std::size_t i = 0;
+#if FB_SIMD_AVX2
+  if (use_avx2())
+  {
+    i = hex_decode_avx2(in, size, out);
+  }
+#endif
+#if FB_SIMD_SSE2
+  if (use_sse2())
+  {
+    i += hex_decode_sse2(in + i, size - i, out + i / 2);
+  }
+#endif
+  for (; i + 2 <= size; i += 2)
+  {
+    const int high = hex_value(static_cast<unsigned char>(in[i]));
+    const int low  = hex_value(static_cast<unsigned char>(in[i + 1]));
+    if (high < 0 || low < 0)
+    {
+      break;
+    }
+    out[i / 2] = static_cast<char>(high << 4 | low);
+  }
+  return i;
+}
+
+// ============================================================================
+// Escaping
+// ============================================================================
+
+// Destinations for escape_json() and escape_html(); clean runs reach them
+// as one append each
+struct buffer_output
+{
+  char* target;
+
+  void append(const char* data, std::size_t size) noexcept
+  {
+    std::memcpy(target, data, size);
+    target += size;
+  }
+};
+
+struct string_output
+{
+  std::string& out;
+
+  void append(const char* data, std::size_t size) { out.append(data, size); }
+};
+
+struct sink_output
+{
+  format_sink& out;
+
+  void append(const char* data, std::size_t size) { out.append(std::string_view(data, size)); }
+};
+
+/// Write the escape for a byte simd::find_json_escape() stopped at
+/// @return Characters written, at most 6
+std::size_t json_escape_sequence(unsigned char ch, char* sequence) noexcept
+{
+  sequence[0] = '\\';
+  switch (ch)
+  {
+  case '"': sequence[1] = '"'; return 2;
+  case '\\': sequence[1] = '\\'; return 2;
+  case '\b': sequence[1] = 'b'; return 2;
+  case '\f': sequence[1] = 'f'; return 2;
+  case '\n': sequence[1] = 'n'; return 2;
+  case '\r': sequence[1] = 'r'; return 2;
+  case '\t': sequence[1] = 't'; return 2;
+  default:
+    std::memcpy(sequence + 1, "u00", 3);
+    sequence[4] = HEX_LOWER[ch >> 4];
+    sequence[5] = HEX_LOWER[ch & 0x0F];
+    return 6;
+  }
+}
+
+template <typename Output>
+void escape_json(std::string_view str, Output& out)
+{
+  std::size_t i = 0;
+  while (i < str.size())
+  {
+    // Copy the run up to the next byte to escape in one go
+    std::size_t next = simd::find_json_escape(str, i);
+    if (next == std::string_view::npos)
+    {
+      next = str.size();
+    }
+    out.append(str.data() + i, next - i);
+    if (next == str.size())
+    {
+      break;
+    }
+
+    char sequence[6];
+    out.append(sequence, json_escape_sequence(static_cast<unsigned char>(str[next]), sequence));
+    i = next + 1;
+  }
+}
+
+constexpr std::string_view HTML_SPECIAL = "&<>\"'";
+
+std::string_view html_entity(char ch) noexcept
+{
+  switch (ch)
+  {
+  case '&': return "&amp;";
+  case '<': return "&lt;";
+  case '>': return "&gt;";
+  case '"': return "&quot;";
+  default: return "&#39;";
+  }
+}
+
+template <typename Output>
+void escape_html(std::string_view str, Output& out)
+{
+  std::size_t i = 0;
+  while (i < str.size())
+  {
+    std::size_t next = simd::find_any(str, HTML_SPECIAL, i);
+    if (next == std::string_view::npos)
+    {
+      next = str.size();
+    }
+    out.append(str.data() + i, next - i);
+    if (next == str.size())
+    {
+      break;
+    }
+
+    const std::string_view entity = html_entity(str[next]);
+    out.append(entity.data(), entity.size());
+    i = next + 1;
+  }
+}
+
+} // namespace
+
+// ============================================================================
+// One-Shot Encoding
+// ============================================================================
+
+std::size_t hex_encode(std::string_view data, char* out, bool uppercase) noexcept
+{
+  const unsigned char* in = bytes(data);
+  std::size_t i           = 0;
+#if FB_SIMD_AVX2
+  if (use_avx2())
+  {
+    i = hex_encode_avx2(in, data.size(), out, uppercase);
+  }
+#endif
+#if FB_SIMD_SSE2
+  if (use_sse2())
+  {
+    i += hex_encode_sse2(in + i, data.size() - i, out + 2 * i, uppercase);
+  }
+#endif
+  const char* digits = uppercase ? HEX_UPPER : HEX_LOWER;
+  for (; i < data.size(); ++i)
+  {
+    out[2 * i]     = digits[in[i] >> 4];
+    out[2 * i + 1] = digits[in[i] & 0x0F];
+  }
+  return hex_encoded_size(data.size());
+}
+
+std::optional<std::size_t> hex_decode(std::string_view hex, char* out) noexcept
+{
+  if (hex.size() % 2 != 0 || hex_decode_pairs(hex.data(), hex.size(), out) != hex.size())
+  {
+    return std::nullopt;
+  }
+  return hex.size() / 2;
+}
+
+std::size_t base64_encode(std::string_view data, char* out, base64_alphabet alphabet, bool padding) noexcept
+{
+  const char* chars     = base64_chars(alphabet);
+  const std::size_t end = base64_encode_groups(bytes(data), data.size(), out, chars);
+  return end / 3 * 4 + base64_encode_tail(bytes(data) + end, data.size() - end, out + end / 3 * 4, chars, padding);
+}
+
+std::optional<std::size_t> base64_decode(std::string_view base64,
+                                         char* out,
+                                         base64_alphabet alphabet,
+                                         bool padding) noexcept
+{
+  base64_decoder decoder(alphabet, padding);
+  const std::optional<std::size_t> body = decoder.update(base64, out);
+  if (!body)
+  {
+    return std::nullopt;
+  }
+  const std::optional<std::size_t> tail = decoder.finish(out + *body);
+  if (!tail)
+  {
+    return std::nullopt;
+  }
+  return *body + *tail;
+}
+
+std::size_t percent_encode(std::string_view str, char* out) noexcept
+{
+  char* target = out;
+  for (unsigned char ch : str)
+  {
+    if (UNRESERVED[ch])
+    {
+      *target++ = static_cast<char>(ch);
+    }
+    else
+    {
+      target[0] = '%';
+      target[1] = HEX_UPPER[ch >> 4];
+      target[2] = HEX_UPPER[ch & 0x0F];
+      target += 3;
+    }
+  }
+  return static_cast<std::size_t>(target - out);
+}
+
+std::optional<std::size_t> percent_decode(std::string_view str, char* out) noexcept
+{
+  char* target  = out;
+  std::size_t i = 0;
+  while (i < str.size())
+  {
+    // Copy the run up to the next escape in one go
+    std::size_t next = simd::find_any(str, "%+", i);
+    if (next == std::string_view::npos)
+    {
+      next = str.size();
+    }
+    std::memcpy(target, str.data() + i, next - i);
+    target += next - i;
+    if (next == str.size())
+    {
+      break;
+    }
+
+    if (str[next] == '+')
+    {
+      *target++ = ' ';
+      i         = next + 1;
+      continue;
+    }
+    if (str.size() - next < 3)
+    {
+      return std::nullopt;
+    }
+    const int high = hex_value(static_cast<unsigned char>(str[next + 1]));
+    const int low  = hex_value(static_cast<unsigned char>(str[next + 2]));
+    if (high < 0 || low < 0)
+    {
+      return std::nullopt;
+    }
+    *target++ = static_cast<char>(high << 4 | low);
+    i         = next + 3;
+  }
+  return static_cast<std::size_t>(target - out);
+}
+
+std::size_t json_escape(std::string_view str, char* out) noexcept
+{
+  buffer_output output{out};
+  escape_json(str, output);
+  return static_cast<std::size_t>(output.target - out);
+}
+
+std::size_t html_escape(std::string_view str, char* out) noexcept
+{
+  buffer_output output{out};
+  escape_html(str, output);
+  return static_cast<std::size_t>(output.target - out);
+}
+
+void append_json_escaped(std::string& out, std::string_view str)
+{
+  string_output output{out};
+  escape_json(str, output);
+}
+
+void append_json_escaped(format_sink& out, std::string_view str)
+{
+  sink_output output{out};
+  escape_json(str, output);
+}
+
+void append_html_escaped(std::string& out, std::string_view str)
+{
+  string_output output{out};
+  escape_html(str, output);
+}
+
+void append_html_escaped(format_sink& out, std::string_view str)
+{
+  sink_output output{out};
+  escape_html(str, output);
+}
+
+std::string to_base64(std::string_view data, base64_alphabet alphabet, bool padding)
+{
+  std::string result(base64_encoded_size(data.size(), padding), '\0');
+  base64_encode(data, result.data(), alphabet, padding);
+  return result;
+}
+
+std::optional<std::string> from_base64(std::string_view base64, base64_alphabet alphabet, bool padding)
+{
+  std::string result(base64_decoded_max_size(base64.size()), '\0');
+  const std::optional<std::size_t> size = base64_decode(base64, result.data(), alphabet, padding);
+  if (!size)
+  {
+    return std::nullopt;
+  }
+  result.resize(*size);
+  return result;
+}
+
+// ============================================================================
+// base64_encoder
+// ============================================================================
+
+base64_encoder::base64_encoder(base64_alphabet alphabet, bool padding) noexcept
+  : m_alphabet(alphabet)
+  , m_padding(padding)
+{
+}
+
+std::size_t base64_encoder::update(std::string_view chunk, char* out) noexcept
+{
+  const char* chars = base64_chars(m_alphabet);
+  std::size_t written = 0;
+  if (m_pending_size > 0)
+  {
+    // Complete the group left over from the previous chunk
+    unsigned char group[3] = {m_pending[0], m_pending[1], 0};
+    while (m_pending_size < 3 && !chunk.empty())
+    {
+      group[m_pending_size++] = static_cast<unsigned char>(chunk.front());
+      chunk.remove_prefix(1);
+    }
+    if (m_pending_size < 3)
+    {
+      m_pending[0] = group[0];
+      m_pending[1] = group[1];
+      return 0;
+    }
+    written        = base64_encode_groups(group, 3, out, chars) / 3 * 4;
+    m_pending_size = 0;
+  }
+
+  const std::size_t end = base64_encode_groups(bytes(chunk), chunk.size(), out + written, chars);
+  written += end / 3 * 4;
+  for (std::size_t i = end; i < chunk.size(); ++i)
+  {
+    m_pending[m_pending_size++] = static_cast<unsigned char>(chunk[i]);
+  }
+  return written;
+}
+
+void base64_encoder::update(std::string_view chunk, std::string& out)
+{
+  const std::size_t old_size = out.size();
+  out.resize(old_size + base64_encoded_size(chunk.size()));
+  out.resize(old_size + update(chunk, out.data() + old_size));
+}
+
+std::size_t base64_encoder::finish(char* out) noexcept
+{
+  const std::size_t written = base64_encode_tail(m_pending, m_pending_size, out, base64_chars(m_alphabet), m_padding);
+  m_pending_size            = 0;
+  return written;
+}
+
+void base64_encoder::finish(std::string& out)
+{
+  char tail[4];
+  out.append(tail, finish(tail));
+}
+
+// ============================================================================
+// base64_decoder
+// ============================================================================
+
+base64_decoder::base64_decoder(base64_alphabet alphabet, bool padding) noexcept
+  : m_alphabet(alphabet)
+  , m_padding(padding)
+{
+}
+
+std::optional<std::size_t> base64_decoder::update(std::string_view chunk, char* out) noexcept
+{
+  if (m_failed)
+  {
+    return std::nullopt;
+  }
+
+  const base64_table& table = base64_values(m_alphabet);
+  const unsigned char* in   = bytes(chunk);
+  char* target              = out;
+  std::size_t i             = 0;
+  while (i < chunk.size())
+  {
+    if (m_count == 0 && m_pad == 0 && !m_done)
+    {
+      const std::size_t decoded = base64_decode_groups(in + i, chunk.size() - i, target, m_alphabet);
+      i += decoded;
+      target += decoded / 4 * 3;
+      if (i == chunk.size())
+      {
+        break;
+      }
+    }
+
+    const std::int8_t value = table[in[i++]];
+    if (value == B64_WHITESPACE)
+    {
+      continue;
+    }
+    if (value == B64_PAD && m_padding && !m_done && m_count >= 2)
+    {
+      // The first '=' settles how many bytes the group holds
+      if (++m_pad == 1)
+      {
+        *target++ = static_cast<char>(m_bits >> (m_count == 2 ? 4 : 10));
+        if (m_count == 3)
+        {
+          *target++ = static_cast<char>(m_bits >> 2);
+        }
+      }
+      m_done = m_count + m_pad == 4;
+      continue;
+    }
+    if (value < 0 || m_pad > 0 || m_done)
+    {
+      m_failed = true;
+      return std::nullopt;
+    }
+
+    m_bits = m_bits << 6 | static_cast<std::uint32_t>(value);
+    if (++m_count == 4)
+    {
+      target[0] = static_cast<char>(m_bits >> 16);
+      target[1] = static_cast<char>(m_bits >> 8);
+      target[2] = static_cast<char>(m_bits);
+      target += 3;
+      m_count = 0;
+      m_bits  = 0;
+    }
+  }
+  return static_cast<std::size_t>(target - out);
+}
+
+bool base64_decoder::update(std::string_view chunk, std::string& out)
+{
+  const std::size_t old_size = out.size();
+  out.resize(old_size + base64_decoded_max_size(chunk.size()) + 3);
+  const std::optional<std::size_t> written = update(chunk, out.data() + old_size);
+  out.resize(old_size + written.value_or(0));
+  return written.has_value();
+}
+
+std::optional<std::size_t> base64_decoder::finish(char* out) noexcept
+{
+  std::optional<std::size_t> written;
+  if (m_failed)
+  {
+    written = std::nullopt;
+  }
+  else if (m_padding)
+  {
+    if (m_done || m_count == 0)
+    {
+      written = 0;
+    }
+  }
+  else if (m_count != 1)
+  {
+    // An unpadded group of 2 or 3 values holds 1 or 2 bytes
+    written = 0;
+    if (m_count >= 2)
+    {
+      out[0]  = static_cast<char>(m_bits >> (m_count == 2 ? 4 : 10));
+      written = 1;
+    }
+    if (m_count == 3)
+    {
+      out[1]  = static_cast<char>(m_bits >> 2);
+      written = 2;
+    }
+  }
+
+  if (!written)
+  {
+    m_failed = true;
+    return std::nullopt;
+  }
+  m_done  = false;
+  m_count = 0;
+  m_pad   = 0;
+  m_bits  = 0;
+  return written;
+}
+
+bool base64_decoder::finish(std::string& out)
+{
+  char tail[2];
+  const std::optional<std::size_t> written = finish(tail);
+  if (!written)
+  {
+    return false;
+  }
+  out.append(tail, *written);
+  return true;
+}
+
+// ============================================================================
+// hex_decoder
+// ============================================================================
+
+std::optional<std::size_t> hex_decoder::update(std::string_view chunk, char* out) noexcept
+{
+  if (m_failed)
+  {
+    return std::nullopt;
+  }
+
+  char* target = out;
+  if (m_high >= 0 && !chunk.empty())
+  {
+    const int low = hex_value(static_cast<unsigned char>(chunk.front()));
+    if (low < 0)
+    {
+      m_failed = true;
+      return std::nullopt;
+    }
+    *target++ = static_cast<char>(m_high << 4 | low);
+    m_high    = -1;
+    chunk.remove_prefix(1);
+  }
+
+  const std::size_t decoded = hex_decode_pairs(chunk.data(), chunk.size(), target);
+  target += decoded / 2;
+  if (decoded < chunk.size())
+  {
+    m_high = hex_value(static_cast<unsigned char>(chunk[decoded]));
+    if (decoded + 1 < chunk.size() || m_high < 0)
+    {
+      m_failed = true;
+      return std::nullopt;
+    }
+  }
+  return static_cast<std::size_t>(target - out);
+}
+
+bool hex_decoder::update(std::string_view chunk, std::string& out)
+{
+  const std::size_t old_size = out.size();
+  out.resize(old_size + (chunk.size() + 1) / 2);
+  const std::optional<std::size_t> written = update(chunk, out.data() + old_size);
+  out.resize(old_size + written.value_or(0));
+  return written.has_value();
+}
+
+bool hex_decoder::finish() noexcept
+{
+  const bool complete = !m_failed && m_high < 0;
+  m_failed            = !complete;
+  m_high              = -1;
+  return complete;
+}
+
+} // namespace fb
@@ -1,155 +1,92 @@
 #include <fb/format.h>
 
+#include <fb/detail/number_chars.h>
+
 #include <algorithm>
 #include <cmath>
-#include <cstdio>
 #include <cstring>
-#include <iomanip>
-#include <sstream>
 #include <stdexcept>
 
 namespace fb
 {
 
 // ============================================================================
-// Format Specification Parsing
+// Helper Functions
 // ============================================================================
 
-format_spec parse_format_spec(std::string_view spec)
+namespace
 {
-  format_spec result;
-
-  if (spec.empty())
-  {
-    return result;
-  }
-
-  size_t pos = 0;
-
-  // Check for fill and alignment
-  // If the second character is an alignment character, the first is fill
-  if (spec.size() >= 2 &&
-      (spec[1] == '<' || spec[1] == '>' || spec[1] == '^'))
-  {
-    result.fill  = spec[0];
-    result.align = spec[1];
-    pos          = 2;
-  }
-  else if (!spec.empty() &&
-           (spec[0] == '<' || spec[0] == '>' || spec[0] == '^'))
-  {
-    result.align = spec[0];
-    pos          = 1;
-  }
-
-  // Sign
-  if (pos < spec.size() &&
-      (spec[pos] == '+' || spec[pos] == '-' || spec[pos] == ' '))
-  {
-    result.sign = spec[pos];
-    ++pos;
-  }
-
-  // Alternate form (#)
-  if (pos < spec.size() && spec[pos] == '#')
-  {
-    result.alt_form = true;
-    ++pos;
-  }
-
-  // Zero padding
-  if (pos < spec.size() && spec[pos] == '0')
-  {
-    result.zero_pad = true;
-    ++pos;
-  }
-
-  // Width
-  while (pos < spec.size() && spec[pos] >= '0' && spec[pos] <= '9')
-  {
-    result.width = result.width * 10 + (spec[pos] - '0');
-    ++pos;
-  }
 
-  // Precision
-  if (pos < spec.size() && spec[pos] == '.')
-  {
-    ++pos;
-    result.precision = 0;
-    while (pos < spec.size() && spec[pos] >= '0' && spec[pos] <= '9')
-    {
-      result.precision = result.precision * 10 + (spec[pos] - '0');
-      ++pos;
-    }
-  }
-
-  // Type
-  if (pos < spec.size())
+std::string_view truncate(std::string_view str, const format_spec& spec)
+{
+  if (spec.precision >= 0 && static_cast<size_t>(spec.precision) < str.size())
   {
-    result.type = spec[pos];
+    return str.substr(0, static_cast<size_t>(spec.precision));
   }
-
-  return result;
+  return str;
 }
 
-// ============================================================================
-// Helper Functions
-// ============================================================================
-
-namespace
-{
-
-std::string apply_alignment(std::string_view str,
-                            const format_spec& spec)
+// Writes content of length @p size, padded to spec.width with spec.fill.
+// @p write_content appends the content itself.
+template<typename WriteContent>
+void write_aligned(format_sink& out,
+                   size_t size,
+                   const format_spec& spec,
+                   char default_align,
+                   WriteContent&& write_content)
 {
-  if (spec.width <= 0 || str.size() >= static_cast<size_t>(spec.width))
+  if (spec.width <= 0 || size >= static_cast<size_t>(spec.width))
   {
-    return std::string(str);
+    write_content();
+    return;
   }
 
-  size_t padding = static_cast<size_t>(spec.width) - str.size();
-  std::string result;
-  result.reserve(static_cast<size_t>(spec.width));
+  size_t padding = static_cast<size_t>(spec.width) - size;
 
   char align = spec.align;
   if (align == '\0')
   {
-    align = '<'; // Default to left for strings
+    align = default_align;
   }
 
   switch (align)
   {
-  case '<': // Left align
-    result.append(str);
-    result.append(padding, spec.fill);
-    break;
   case '>': // Right align
-    result.append(padding, spec.fill);
-    result.append(str);
+    out.append(padding, spec.fill);
+    write_content();
     break;
   case '^': // Center align
   {
     size_t left_pad  = padding / 2;
     size_t right_pad = padding - left_pad;
-    result.append(left_pad, spec.fill);
-    result.append(str);
-    result.append(right_pad, spec.fill);
+    out.append(left_pad, spec.fill);
+    write_content();
+    out.append(right_pad, spec.fill);
     break;
   }
+  default: // Left align
+    write_content();
+    out.append(padding, spec.fill);
+    break;
   }
-
-  return result;
 }
 
-std::string format_integer_impl(long long value,
-                                const format_spec& spec,
-                                bool is_unsigned)
+void write_aligned(format_sink& out,
+                   std::string_view str,
+                   const format_spec& spec,
+                   char default_align = '<')
 {
-  std::string result;
+  write_aligned(out, str.size(), spec, default_align, [&] { out.append(str); });
+}
 
-  int base      = 10;
+void write_integer(format_sink& out,
+                   long long value,
+                   const format_spec& spec,
+                   bool is_unsigned)
+{
+  unsigned base  = 10;
   bool uppercase = false;
-  std::string prefix;
+  std::string_view prefix;
 
   switch (spec.type)
   {
@@ -195,11 +132,12 @@ std::string format_integer_impl(long long value,
   }
 
   // Handle sign
-  std::string sign_str;
+  unsigned long long abs_val = static_cast<unsigned long long>(value);
+  std::string_view sign_str;
   if (!is_unsigned && value < 0)
   {
     sign_str = "-";
-    value    = -value;
+    abs_val  = 0 - abs_val;
   }
   else if (spec.sign == '+')
   {
@@ -210,137 +148,180 @@ std::string format_integer_impl(long long value,
     sign_str = " ";
   }
 
-  // Convert to string
-  unsigned long long abs_val = static_cast<unsigned long long>(value);
-  if (abs_val == 0)
-  {
-    result = "0";
-  }
-  else
-  {
-    while (abs_val > 0)
-    {
-      int digit = static_cast<int>(abs_val % static_cast<unsigned long long>(base));
-      if (digit < 10)
-      {
-        result.push_back(static_cast<char>('0' + digit));
-      }
-      else
-      {
-        result.push_back(static_cast<char>((uppercase ? 'A' : 'a') + digit - 10));
-      }
-      abs_val /= static_cast<unsigned long long>(base);
-    }
-    std::reverse(result.begin(), result.end());
-  }
+  // 64 digits covers base 2
+  char digits[64];
+  char* end = detail::integer_to_chars(digits,
+                                       digits + sizeof(digits),
+                                       abs_val,
+                                       static_cast<int>(base),
+                                       uppercase);
+  std::string_view number(digits, static_cast<size_t>(end - digits));
 
-  // Apply zero padding
-  if (spec.zero_pad && spec.width > 0)
+  // Zero padding goes between the sign/prefix and the digits
+  size_t content_size = sign_str.size() + prefix.size() + number.size();
+  size_t zeros        = 0;
+  if (spec.zero_pad && spec.width > 0 &&
+      content_size < static_cast<size_t>(spec.width))
   {
-    int content_width = static_cast<int>(sign_str.size() + prefix.size() + result.size());
-    if (content_width < spec.width)
-    {
-      result = std::string(static_cast<size_t>(spec.width - content_width), '0') + result;
-    }
+    zeros        = static_cast<size_t>(spec.width) - content_size;
+    content_size = static_cast<size_t>(spec.width);
   }
 
-  result = sign_str + prefix + result;
-
-  // Apply alignment (use right align by default for numbers)
-  char align = spec.align;
-  if (align == '\0')
-  {
-    align = '>';
-  }
-  format_spec align_spec = spec;
-  align_spec.align       = align;
-  return apply_alignment(result, align_spec);
+  // Numbers are right-aligned by default
+  write_aligned(out, content_size, spec, '>', [&] {
+    out.append(sign_str);
+    out.append(prefix);
+    out.append(zeros, '0');
+    out.append(number);
+  });
 }
 
-std::string format_float_impl(double value, const format_spec& spec)
+template<typename T>
+void write_float(format_sink& out, T value, const format_spec& spec)
 {
-  std::ostringstream oss;
-
   // Handle special values
   if (std::isnan(value))
   {
-    return apply_alignment("nan", spec);
+    write_aligned(out, "nan", spec);
+    return;
   }
   if (std::isinf(value))
   {
-    return apply_alignment(value < 0 ? "-inf" : "inf", spec);
-  }
-
-  // Sign handling
-  if (value >= 0 || std::signbit(value) == false)
-  {
-    if (spec.sign == '+')
-    {
-      oss << '+';
-    }
-    else if (spec.sign == ' ')
-    {
-      oss << ' ';
-    }
+    write_aligned(out, value < 0 ? "-inf" : "inf", spec);
+    return;
   }
 
-  // Precision
-  int precision = spec.precision >= 0 ? spec.precision : 6;
-
-  // Format type
+  // Without type or precision: shortest output that reads back the same
+  auto notation  = detail::float_notation::shortest;
+  bool uppercase = false;
   switch (spec.type)
   {
-  case 'e':
-    oss << std::scientific << std::setprecision(precision) << value;
-    break;
   case 'E':
-    oss << std::scientific << std::uppercase << std::setprecision(precision)
-        << value;
+    uppercase = true;
+    [[fallthrough]];
+  case 'e':
+    notation = detail::float_notation::scientific;
     break;
   case 'f':
   case 'F':
-    oss << std::fixed << std::setprecision(precision) << value;
-    break;
-  case 'g':
-    oss << std::setprecision(precision) << value;
+    notation = detail::float_notation::fixed;
     break;
   case 'G':
-    oss << std::uppercase << std::setprecision(precision) << value;
+    uppercase = true;
+    [[fallthrough]];
+  case 'g':
+    notation = detail::float_notation::general;
     break;
   default:
-    oss << std::setprecision(precision) << value;
+    if (spec.precision >= 0)
+    {
+      notation = detail::float_notation::general;
+    }
     break;
   }
 
-  std::string result = oss.str();
+  // Precision
+  int precision = spec.precision >= 0 ? spec.precision : 6;
 
-  // Apply zero padding
-  if (spec.zero_pad && spec.width > 0 &&
-      static_cast<int>(result.size()) < spec.width)
+  // Sign handling
+  char buffer[128];
+  size_t sign_size = 0;
+  if (value >= 0 || std::signbit(value) == false)
   {
-    size_t insert_pos = 0;
-    if (!result.empty() && (result[0] == '-' || result[0] == '+' || result[0] == ' '))
+    if (spec.sign == '+' || spec.sign == ' ')
     {
-      insert_pos = 1;
+      buffer[0] = spec.sign;
+      sign_size = 1;
     }
-    result.insert(insert_pos,
-                  static_cast<size_t>(spec.width) - result.size(),
-                  '0');
   }
 
-  // Apply alignment
-  char align = spec.align;
-  if (align == '\0')
+  // Large values in fixed notation or long precisions need the heap
+  std::string overflow;
+  char* first = buffer;
+  char* end   = detail::float_to_chars(buffer + sign_size,
+                                     buffer + sizeof(buffer),
+                                     value,
+                                     notation,
+                                     precision);
+  if (end == nullptr)
+  {
+    overflow.resize(sign_size + detail::FIXED_FLOAT_CHARS +
+                    static_cast<size_t>(precision));
+    overflow.replace(0, sign_size, buffer, sign_size);
+    first = &overflow[0];
+    end   = detail::float_to_chars(first + sign_size,
+                                 first + overflow.size(),
+                                 value,
+                                 notation,
+                                 precision);
+    if (end == nullptr)
+    {
+      throw std::invalid_argument("floating-point conversion failed");
+    }
+  }
+  if (uppercase)
+  {
+    std::replace(first, end, 'e', 'E');
+  }
+  std::string_view result(first, static_cast<size_t>(end - first));
+
+  // Zero padding goes after a leading sign
+  size_t zeros = 0;
+  if (spec.zero_pad && spec.width > 0 &&
+      result.size() < static_cast<size_t>(spec.width))
+  {
+    zeros = static_cast<size_t>(spec.width) - result.size();
+  }
+  size_t sign_end = 0;
+  if (!result.empty() &&
+      (result[0] == '-' || result[0] == '+' || result[0] == ' '))
   {
-    align = '>';
+    sign_end = 1;
   }
-  format_spec align_spec = spec;
-  align_spec.align       = align;
-  return apply_alignment(result, align_spec);
+
+  write_aligned(out, result.size() + zeros, spec, '>', [&] {
+    out.append(result.substr(0, sign_end));
+    out.append(zeros, '0');
+    out.append(result.substr(sign_end));
+  });
+}
+
+// Formats through @p fmt into a new string
+template<typename Formatter, typename T>
+std::string format_to_string(const Formatter& fmt, const T& value)
+{
+  std::string result;
+  format_sink sink(result);
+  fmt.format(value, sink);
+  return result;
 }
 
 } // namespace
 
+// ============================================================================
+// Format Output
+// ============================================================================
+
+format_sink::format_sink(std::string& out) noexcept
+  : m_context(&out)
+  , m_write([](void* context, const char* data, size_t size) {
+      static_cast<std::string*>(context)->append(data, size);
+    })
+{
+}
+
+void format_sink::append(size_t count, char ch)
+{
+  char chunk[64];
+  std::memset(chunk, ch, std::min(count, sizeof(chunk)));
+  while (count > 0)
+  {
+    size_t size = std::min(count, sizeof(chunk));
+    append(std::string_view(chunk, size));
+    count -= size;
+  }
+}
+
 // ============================================================================
 // Formatter Implementations
 // ============================================================================
@@ -357,9 +338,15 @@ template<typename T>
 std::string formatter<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>::format(
     T value) const
 {
-  return format_integer_impl(static_cast<long long>(value),
-                             m_spec,
-                             std::is_unsigned_v<T>);
+  return format_to_string(*this, value);
+}
+
+template<typename T>
+void formatter<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>::format(
+    T value,
+    format_sink& out) const
+{
+  write_integer(out, static_cast<long long>(value), m_spec, std::is_unsigned_v<T>);
 }
 
 // Explicit instantiations for integer types
@@ -382,15 +369,21 @@ void formatter<bool>::parse(std::string_view spec)
 }
 
 std::string formatter<bool>::format(bool value) const
+{
+  return format_to_string(*this, value);
+}
+
+void formatter<bool>::format(bool value, format_sink& out) const
 {
   // Check type in format() since m_spec may be set directly without calling parse()
   bool as_number = (m_spec.type == 'd' || m_spec.type == 'b' ||
                     m_spec.type == 'o' || m_spec.type == 'x' || m_spec.type == 'X');
   if (as_number)
   {
-    return format_integer_impl(value ? 1 : 0, m_spec, true);
+    write_integer(out, value ? 1 : 0, m_spec, true);
+    return;
   }
-  return apply_alignment(value ? "true" : "false", m_spec);
+  write_aligned(out, value ? "true" : "false", m_spec);
 }
 
 // Float formatter
@@ -406,7 +399,17 @@ std::string
 formatter<T, std::enable_if_t<std::is_floating_point_v<T>>>::format(
     T value) const
 {
-  return format_float_impl(static_cast<double>(value), m_spec);
+  return format_to_string(*this, value);
+}
+
+template<typename T>
+void formatter<T, std::enable_if_t<std::is_floating_point_v<T>>>::format(
+    T value,
+    format_sink& out) const
+{
+  // float keeps its own shortest representation; long double is printed as double
+  using converted = std::conditional_t<std::is_same_v<T, float>, float, double>;
+  write_float(out, static_cast<converted>(value), m_spec);
 }
 
 // Explicit instantiations for floating-point types
@@ -421,17 +424,18 @@ void formatter<const char*>::parse(std::string_view spec)
 }
 
 std::string formatter<const char*>::format(const char* value) const
+{
+  return format_to_string(*this, value);
+}
+
+void formatter<const char*>::format(const char* value, format_sink& out) const
 {
   if (value == nullptr)
   {
-    return apply_alignment("(null)", m_spec);
-  }
-  std::string_view sv(value);
-  if (m_spec.precision >= 0 && static_cast<size_t>(m_spec.precision) < sv.size())
-  {
-    sv = sv.substr(0, static_cast<size_t>(m_spec.precision));
+    write_aligned(out, "(null)", m_spec);
+    return;
   }
-  return apply_alignment(sv, m_spec);
+  write_aligned(out, truncate(value, m_spec), m_spec);
 }
 
 // char* formatter
@@ -441,17 +445,18 @@ void formatter<char*>::parse(std::string_view spec)
 }
 
 std::string formatter<char*>::format(char* value) const
+{
+  return format_to_string(*this, value);
+}
+
+void formatter<char*>::format(char* value, format_sink& out) const
 {
   if (value == nullptr)
   {
-    return apply_alignment("(null)", m_spec);
-  }
-  std::string_view sv(value);
-  if (m_spec.precision >= 0 && static_cast<size_t>(m_spec.precision) < sv.size())
-  {
-    sv = sv.substr(0, static_cast<size_t>(m_spec.precision));
+    write_aligned(out, "(null)", m_spec);
+    return;
   }
-  return apply_alignment(sv, m_spec);
+  write_aligned(out, truncate(value, m_spec), m_spec);
 }
 
 // std::string formatter
@@ -462,12 +467,13 @@ void formatter<std::string>::parse(std::string_view spec)
 
 std::string formatter<std::string>::format(const std::string& value) const
 {
-  std::string_view sv = value;
-  if (m_spec.precision >= 0 && static_cast<size_t>(m_spec.precision) < sv.size())
-  {
-    sv = sv.substr(0, static_cast<size_t>(m_spec.precision));
-  }
-  return apply_alignment(sv, m_spec);
+  return format_to_string(*this, value);
+}
+
+void formatter<std::string>::format(const std::string& value,
+                                    format_sink& out) const
+{
+  write_aligned(out, truncate(value, m_spec), m_spec);
 }
 
 // std::string_view formatter
@@ -478,12 +484,13 @@ void formatter<std::string_view>::parse(std::string_view spec)
 
 std::string formatter<std::string_view>::format(std::string_view value) const
 {
-  std::string_view sv = value;
-  if (m_spec.precision >= 0 && static_cast<size_t>(m_spec.precision) < sv.size())
-  {
-    sv = sv.substr(0, static_cast<size_t>(m_spec.precision));
-  }
-  return apply_alignment(sv, m_spec);
+  return format_to_string(*this, value);
+}
+
+void formatter<std::string_view>::format(std::string_view value,
+                                         format_sink& out) const
+{
+  write_aligned(out, truncate(value, m_spec), m_spec);
 }
 
 // char formatter
@@ -493,13 +500,19 @@ void formatter<char>::parse(std::string_view spec)
 }
 
 std::string formatter<char>::format(char value) const
+{
+  return format_to_string(*this, value);
+}
+
+void formatter<char>::format(char value, format_sink& out) const
 {
   if (m_spec.type == 'd' || m_spec.type == 'x' || m_spec.type == 'X' ||
       m_spec.type == 'o' || m_spec.type == 'b' || m_spec.type == 'B')
   {
-    return format_integer_impl(static_cast<int>(value), m_spec, false);
+    write_integer(out, static_cast<int>(value), m_spec, false);
+    return;
   }
-  return apply_alignment(std::string_view(&value, 1), m_spec);
+  write_aligned(out, std::string_view(&value, 1), m_spec);
 }
 
 // Pointer formatter
@@ -513,17 +526,29 @@ void formatter<T*, std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, char>>>
 template<typename T>
 std::string formatter<T*, std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, char>>>::format(
     T* value) const
+{
+  return format_to_string(*this, value);
+}
+
+template<typename T>
+void formatter<T*, std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, char>>>::format(
+    T* value,
+    format_sink& out) const
 {
   if (value == nullptr)
   {
-    return apply_alignment("(nil)", m_spec);
+    write_aligned(out, "(nil)", m_spec);
+    return;
   }
 
   format_spec ptr_spec = m_spec;
   ptr_spec.alt_form    = true;
   ptr_spec.type        = 'x';
 
-  return format_integer_impl(reinterpret_cast<uintptr_t>(value), ptr_spec, true);
+  write_integer(out,
+                static_cast<long long>(reinterpret_cast<uintptr_t>(value)),
+                ptr_spec,
+                true);
 }
 
 // Explicit instantiation for void*
@@ -536,9 +561,14 @@ void formatter<std::nullptr_t>::parse(std::string_view spec)
   m_spec = parse_format_spec(spec);
 }
 
-std::string formatter<std::nullptr_t>::format(std::nullptr_t) const
+std::string formatter<std::nullptr_t>::format(std::nullptr_t value) const
+{
+  return format_to_string(*this, value);
+}
+
+void formatter<std::nullptr_t>::format(std::nullptr_t, format_sink& out) const
 {
-  return apply_alignment("(nil)", m_spec);
+  write_aligned(out, "(nil)", m_spec);
 }
 
 // ============================================================================
@@ -548,13 +578,13 @@ std::string formatter<std::nullptr_t>::format(std::nullptr_t) const
 namespace detail
 {
 
-std::string format_arg::format(const format_spec& spec) const
+void format_arg::format(const format_spec& spec, format_sink& out) const
 {
   if (!m_format_fn || !m_value)
   {
     throw std::invalid_argument("invalid format argument");
   }
-  return m_format_fn(m_value, spec);
+  m_format_fn(m_value, spec, out);
 }
 
 const format_arg& format_args::get(size_t index) const
@@ -574,129 +604,47 @@ std::string vformat(std::string_view fmt, format_args args)
 {
   std::string result;
   result.reserve(fmt.size() * 2);
+  format_sink sink(result);
+  vformat_to(sink, fmt, args);
+  return result;
+}
 
+void vformat_to(format_sink& out, std::string_view fmt, format_args args)
+{
   size_t auto_index = 0;
   size_t pos        = 0;
 
   while (pos < fmt.size())
   {
-    // Find next '{' or '}'
-    size_t open         = fmt.find('{', pos);
-    size_t close_escape = fmt.find('}', pos);
-
-    // Handle '}}' that appears before any '{'
-    if (close_escape != std::string_view::npos &&
-        (open == std::string_view::npos || close_escape < open))
-    {
-      // Append text before '}'
-      result.append(fmt.substr(pos, close_escape - pos));
-
-      // Check for escaped '}}'
-      if (close_escape + 1 < fmt.size() && fmt[close_escape + 1] == '}')
-      {
-        result.push_back('}');
-        pos = close_escape + 2;
-        continue;
-      }
-      else
-      {
-        throw std::invalid_argument("unmatched '}' in format string");
-      }
-    }
-
-    if (open == std::string_view::npos)
-    {
-      result.append(fmt.substr(pos));
-      break;
-    }
-
-    // Append text before '{'
-    result.append(fmt.substr(pos, open - pos));
-
-    // Check for escaped '{{'
-    if (open + 1 < fmt.size() && fmt[open + 1] == '{')
+    format_segment segment = next_format_segment(fmt, pos, auto_index);
+    if (segment.is_field)
     {
-      result.push_back('{');
-      pos = open + 2;
-      continue;
+      args.get(segment.arg_index).format(segment.spec, out);
     }
-
-    // Find closing '}'
-    size_t close = fmt.find('}', open);
-    if (close == std::string_view::npos)
+    else
     {
-      throw std::invalid_argument("unmatched '{' in format string");
+      out.append(segment.literal);
     }
+  }
+}
 
-    // Parse replacement field
-    std::string_view field = fmt.substr(open + 1, close - open - 1);
-
-    // Parse index and format spec
-    size_t arg_index = 0;
-    std::string_view spec;
-
-    size_t colon = field.find(':');
-    if (colon != std::string_view::npos)
+void vformat_to(format_sink& out,
+                const format_segment* segments,
+                size_t count,
+                format_args args)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    const format_segment& segment = segments[i];
+    if (segment.is_field)
     {
-      std::string_view index_part = field.substr(0, colon);
-      spec                        = field.substr(colon + 1);
-
-      if (index_part.empty())
-      {
-        arg_index = auto_index++;
-      }
-      else
-      {
-        for (char ch : index_part)
-        {
-          if (ch < '0' || ch > '9')
-          {
-            throw std::invalid_argument("invalid format field index");
-          }
-          arg_index = arg_index * 10 + static_cast<size_t>(ch - '0');
-        }
-      }
+      args.get(segment.arg_index).format(segment.spec, out);
     }
     else
     {
-      if (field.empty())
-      {
-        arg_index = auto_index++;
-      }
-      else
-      {
-        bool is_number = true;
-        for (char ch : field)
-        {
-          if (ch < '0' || ch > '9')
-          {
-            is_number = false;
-            break;
-          }
-        }
-        if (is_number)
-        {
-          for (char ch : field)
-          {
-            arg_index = arg_index * 10 + static_cast<size_t>(ch - '0');
-          }
-        }
-        else
-        {
-          throw std::invalid_argument("invalid format field");
-        }
-      }
+      out.append(segment.literal);
     }
-
-    // Get argument and format
-    const format_arg& arg       = args.get(arg_index);
-    format_spec parsed_spec     = parse_format_spec(spec);
-    result.append(arg.format(parsed_spec));
-
-    pos = close + 1;
   }
-
-  return result;
 }
 
 } // namespace detail
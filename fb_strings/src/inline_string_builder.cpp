@@ -0,0 +1,425 @@
+/// @file inline_string_builder.cpp
+/// @brief Implementation of the inline-buffer string builder
+
+#include "fb/inline_string_builder.h"
+#include "fb/encoding.h"
+
+#include <fb/detail/number_chars.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace fb
+{
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+/**
+ * @brief Bind the builder to the derived object's storage
+ * @param storage Inline buffer of capacity + 1 bytes
+ * @param capacity Bytes that fit before the overflow policy applies
+ * @param policy What to do with content past the capacity
+ */
+inline_string_builder_base::inline_string_builder_base(char* storage,
+                                                       std::size_t capacity,
+                                                       inline_overflow policy) noexcept
+  : m_storage(storage)
+  , m_capacity(capacity)
+  , m_policy(policy)
+{
+}
+
+// ============================================================================
+// Buffer Management
+// ============================================================================
+
+void inline_string_builder_base::write_to(void* builder, const char* data, std::size_t size)
+{
+  static_cast<inline_string_builder_base*>(builder)->write(data, size);
+}
+
+/**
+ * @brief Append raw bytes, applying the overflow policy
+ * @param data Bytes to append
+ * @param size Number of bytes
+ */
+void inline_string_builder_base::write(const char* data, std::size_t size)
+{
+  if (size == 0)
+  {
+    return;
+  }
+  if (m_spilled)
+  {
+    m_heap.append(data, size);
+    return;
+  }
+
+  if (size > m_capacity - m_size)
+  {
+    if (m_policy == inline_overflow::truncate)
+    {
+      m_truncated = true;
+      size        = m_capacity - m_size;
+    }
+    else
+    {
+      // Move everything to the heap, with room to keep growing
+      m_heap.reserve(std::max(2 * m_capacity, m_size + size));
+      m_heap.assign(m_storage, m_size);
+      m_heap.append(data, size);
+      m_spilled = true;
+      return;
+    }
+  }
+
+  std::memcpy(m_storage + m_size, data, size);
+  m_size += size;
+  m_storage[m_size] = '\0';
+}
+
+// ============================================================================
+// String Append Operations
+// ============================================================================
+
+/**
+ * @brief Append a string view
+ * @param str String to append
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append(std::string_view str)
+{
+  write(str.data(), str.size());
+  return *this;
+}
+
+/**
+ * @brief Append a C-string
+ * @param str C-string to append (nullptr appends nothing)
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append(const char* str)
+{
+  if (str != nullptr)
+  {
+    write(str, std::strlen(str));
+  }
+  return *this;
+}
+
+/**
+ * @brief Append a single character
+ * @param c Character to append
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append(char c)
+{
+  write(&c, 1);
+  return *this;
+}
+
+/**
+ * @brief Append a character repeated count times
+ * @param c Character to append
+ * @param count Number of times to repeat
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append(char c, std::size_t count)
+{
+  char chunk[64];
+  std::memset(chunk, c, std::min(count, sizeof(chunk)));
+  while (count > 0)
+  {
+    const std::size_t size = std::min(count, sizeof(chunk));
+    write(chunk, size);
+    count -= size;
+  }
+  return *this;
+}
+
+/**
+ * @brief Append a string followed by a newline
+ * @param str String to append (default: empty string)
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_line(std::string_view str)
+{
+  write(str.data(), str.size());
+  return append('\n');
+}
+
+// ============================================================================
+// Numeric Append Operations
+// ============================================================================
+
+/**
+ * @brief Append a 32-bit signed integer
+ * @param value Integer value to append
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_int(std::int32_t value)
+{
+  char buffer[12]; // -2147483648 is 11 chars + null
+  auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  if (ec == std::errc())
+  {
+    write(buffer, static_cast<std::size_t>(ptr - buffer));
+  }
+  return *this;
+}
+
+/**
+ * @brief Append a 64-bit signed integer
+ * @param value Integer value to append
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_int(std::int64_t value)
+{
+  char buffer[21]; // -9223372036854775808 is 20 chars + null
+  auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  if (ec == std::errc())
+  {
+    write(buffer, static_cast<std::size_t>(ptr - buffer));
+  }
+  return *this;
+}
+
+/**
+ * @brief Append a 32-bit unsigned integer
+ * @param value Integer value to append
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_uint(std::uint32_t value)
+{
+  char buffer[11]; // 4294967295 is 10 chars + null
+  auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  if (ec == std::errc())
+  {
+    write(buffer, static_cast<std::size_t>(ptr - buffer));
+  }
+  return *this;
+}
+
+/**
+ * @brief Append a 64-bit unsigned integer
+ * @param value Integer value to append
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_uint(std::uint64_t value)
+{
+  char buffer[21]; // 18446744073709551615 is 20 chars + null
+  auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  if (ec == std::errc())
+  {
+    write(buffer, static_cast<std::size_t>(ptr - buffer));
+  }
+  return *this;
+}
+
+/**
+ * @brief Append a double-precision floating point value
+ * @param value Floating point value to append
+ * @param precision Number of decimal places (default: 6)
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_double(double value, int precision)
+{
+  char buffer[64];
+  char* end = detail::float_to_chars(
+      buffer, buffer + sizeof(buffer), value, detail::float_notation::fixed, precision);
+  if (end != nullptr)
+  {
+    write(buffer, static_cast<std::size_t>(end - buffer));
+    return *this;
+  }
+
+  // Past the stack buffer: values around 1e40 and up with long precisions
+  std::string wide(detail::FIXED_FLOAT_CHARS + static_cast<std::size_t>(precision < 0 ? 6 : precision), '\0');
+  end = detail::float_to_chars(
+      wide.data(), wide.data() + wide.size(), value, detail::float_notation::fixed, precision);
+  if (end != nullptr)
+  {
+    write(wide.data(), static_cast<std::size_t>(end - wide.data()));
+  }
+  return *this;
+}
+
+/**
+ * @brief Append a boolean value as "true" or "false"
+ * @param value Boolean value to append
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_bool(bool value)
+{
+  return append(value ? std::string_view("true") : std::string_view("false"));
+}
+
+/**
+ * @brief Append a string escaped for a JSON string value
+ * @param str Text to escape; no quotes are added
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_json_escaped(std::string_view str)
+{
+  format_sink sink(this, &write_to);
+  fb::append_json_escaped(sink, str);
+  return *this;
+}
+
+/**
+ * @brief Append a string with HTML special characters replaced by entities
+ * @param str Text to escape
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::append_html_escaped(std::string_view str)
+{
+  format_sink sink(this, &write_to);
+  fb::append_html_escaped(sink, str);
+  return *this;
+}
+
+// ============================================================================
+// Stream Operators
+// ============================================================================
+
+inline_string_builder_base& inline_string_builder_base::operator<<(std::string_view str)
+{
+  return append(str);
+}
+
+inline_string_builder_base& inline_string_builder_base::operator<<(char c)
+{
+  return append(c);
+}
+
+inline_string_builder_base& inline_string_builder_base::operator<<(const char* str)
+{
+  return append(str);
+}
+
+inline_string_builder_base& inline_string_builder_base::operator<<(std::int32_t value)
+{
+  return append_int(value);
+}
+
+inline_string_builder_base& inline_string_builder_base::operator<<(std::int64_t value)
+{
+  return append_int(value);
+}
+
+inline_string_builder_base& inline_string_builder_base::operator<<(std::uint32_t value)
+{
+  return append_uint(value);
+}
+
+inline_string_builder_base& inline_string_builder_base::operator<<(std::uint64_t value)
+{
+  return append_uint(value);
+}
+
+inline_string_builder_base& inline_string_builder_base::operator<<(double value)
+{
+  return append_double(value);
+}
+
+inline_string_builder_base& inline_string_builder_base::operator<<(bool value)
+{
+  return append_bool(value);
+}
+
+// ============================================================================
+// Output Methods
+// ============================================================================
+
+/**
+ * @brief Convert builder contents to string
+ * @return String copy of the contents
+ */
+std::string inline_string_builder_base::to_string() const
+{
+  return std::string(view());
+}
+
+/**
+ * @brief Get a view of the builder contents
+ *
+ * The view is invalidated by any subsequent append operations
+ * or when the builder is destroyed.
+ *
+ * @return String view of the contents
+ */
+std::string_view inline_string_builder_base::view() const noexcept
+{
+  return m_spilled ? std::string_view(m_heap) : std::string_view(m_storage, m_size);
+}
+
+/**
+ * @brief Get the contents as a C string
+ * @return NUL-terminated contents, valid like view()
+ */
+const char* inline_string_builder_base::c_str() const noexcept
+{
+  return m_spilled ? m_heap.c_str() : m_storage;
+}
+
+// ============================================================================
+// Management Methods
+// ============================================================================
+
+/**
+ * @brief Clear the builder contents
+ *
+ * After a spill the heap buffer, and its capacity, stay in use.
+ *
+ * @return Reference to this builder for chaining
+ */
+inline_string_builder_base& inline_string_builder_base::clear() noexcept
+{
+  m_heap.clear();
+  m_size       = 0;
+  m_truncated  = false;
+  m_storage[0] = '\0';
+  return *this;
+}
+
+/**
+ * @brief Get current content size
+ * @return Number of bytes in the builder
+ */
+std::size_t inline_string_builder_base::size() const noexcept
+{
+  return m_spilled ? m_heap.size() : m_size;
+}
+
+/**
+ * @brief Get current capacity
+ * @return Inline capacity, or the heap buffer's once spilled
+ */
+std::size_t inline_string_builder_base::capacity() const noexcept
+{
+  return m_spilled ? m_heap.capacity() : m_capacity;
+}
+
+/**
+ * @brief Check if builder is empty
+ * @return true if the builder contains no content
+ */
+bool inline_string_builder_base::empty() const noexcept
+{
+  return size() == 0;
+}
+
+bool inline_string_builder_base::spilled() const noexcept
+{
+  return m_spilled;
+}
+
+bool inline_string_builder_base::truncated() const noexcept
+{
+  return m_truncated;
+}
+
+} // namespace fb
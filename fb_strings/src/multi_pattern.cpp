@@ -0,0 +1,331 @@
+/// @file multi_pattern.cpp
+/// @brief Aho-Corasick automaton construction and leftmost-longest search
+
+#include <fb/multi_pattern.h>
+#include <fb/simd_search.h>
+#include <fb/string_list.h>
+
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+/// Larger first-byte sets are not vectorized by simd::find_any()
+constexpr std::size_t MAX_PREFILTER_BYTES = 8;
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+multi_pattern::multi_pattern()
+{
+  compile();
+}
+
+multi_pattern::multi_pattern(std::initializer_list<std::string_view> needles)
+  : m_patterns(needles)
+{
+  compile();
+}
+
+multi_pattern::multi_pattern(const string_list& needles)
+  : m_patterns(needles)
+{
+  compile();
+}
+
+void multi_pattern::compile()
+{
+  // Bytes that occur in no needle share one class
+  bool present[256] = {};
+  bool first[256]   = {};
+  for (std::string_view needle : m_patterns)
+  {
+    for (unsigned char c : needle)
+    {
+      present[c] = true;
+    }
+    if (!needle.empty())
+    {
+      first[static_cast<unsigned char>(needle.front())] = true;
+    }
+  }
+  std::size_t classes = 0;
+  for (unsigned b = 0; b < 256; ++b)
+  {
+    if (present[b])
+    {
+      m_byte_class[b] = static_cast<std::uint8_t>(classes++);
+    }
+  }
+  if (classes < 256)
+  {
+    for (unsigned b = 0; b < 256; ++b)
+    {
+      if (!present[b])
+      {
+        m_byte_class[b] = static_cast<std::uint8_t>(classes);
+      }
+    }
+    ++classes;
+  }
+  m_classes = classes;
+
+  // Trie of the needles; -1 marks a missing edge
+  m_transitions.assign(m_classes, -1);
+  m_depth.assign(1, 0);
+  m_output.assign(1, -1);
+  m_output_length.assign(1, 0);
+  for (std::size_t p = 0; p < m_patterns.size(); ++p)
+  {
+    const std::string_view needle = m_patterns[p];
+    if (needle.empty())
+    {
+      continue;
+    }
+    std::size_t state = 0;
+    for (unsigned char c : needle)
+    {
+      const std::size_t edge = state * m_classes + m_byte_class[c];
+      if (m_transitions[edge] < 0)
+      {
+        m_transitions[edge] = static_cast<std::int32_t>(m_depth.size());
+        m_transitions.resize(m_transitions.size() + m_classes, -1);
+        m_depth.push_back(m_depth[state] + 1);
+        m_output.push_back(-1);
+        m_output_length.push_back(0);
+      }
+      state = static_cast<std::size_t>(m_transitions[edge]);
+    }
+    if (m_output[state] < 0)
+    {
+      m_output[state]        = static_cast<std::int32_t>(p);
+      m_output_length[state] = static_cast<std::uint32_t>(needle.size());
+    }
+  }
+
+  // Breadth-first: point missing edges where the failure link's edge goes,
+  // and inherit the longest needle that is a suffix of each state
+  std::vector<std::int32_t> fail(m_depth.size(), 0);
+  std::vector<std::int32_t> queue;
+  queue.reserve(m_depth.size());
+  for (std::size_t cls = 0; cls < m_classes; ++cls)
+  {
+    std::int32_t& next = m_transitions[cls];
+    if (next < 0)
+    {
+      next = 0;
+    }
+    else
+    {
+      queue.push_back(next);
+    }
+  }
+  for (std::size_t head = 0; head < queue.size(); ++head)
+  {
+    const auto        state = static_cast<std::size_t>(queue[head]);
+    const std::size_t link  = static_cast<std::size_t>(fail[state]);
+    for (std::size_t cls = 0; cls < m_classes; ++cls)
+    {
+      const std::int32_t fallback = m_transitions[link * m_classes + cls];
+      std::int32_t&      next     = m_transitions[state * m_classes + cls];
+      if (next < 0)
+      {
+        next = fallback;
+        continue;
+      }
+      const auto child = static_cast<std::size_t>(next);
+      fail[child]      = fallback;
+      if (m_output[child] < 0)
+      {
+        m_output[child]        = m_output[static_cast<std::size_t>(fallback)];
+        m_output_length[child] = m_output_length[static_cast<std::size_t>(fallback)];
+      }
+      queue.push_back(next);
+    }
+  }
+
+  m_first_bytes.clear();
+  for (unsigned b = 0; b < 256; ++b)
+  {
+    if (first[b])
+    {
+      m_first_bytes.push_back(static_cast<char>(b));
+    }
+  }
+  if (m_first_bytes.size() > MAX_PREFILTER_BYTES)
+  {
+    m_first_bytes.clear();
+  }
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+std::optional<multi_pattern::match> multi_pattern::find_any(std::string_view text, std::size_t pos) const noexcept
+{
+  const std::int32_t*  table = m_transitions.data();
+  const auto*          data  = reinterpret_cast<const unsigned char*>(text.data());
+  const bool           skip  = !m_first_bytes.empty();
+  std::size_t          state = 0;
+  std::optional<match> best;
+  if (m_depth.size() == 1)
+  {
+    return best; // No non-empty needles
+  }
+
+  for (std::size_t i = pos; i < text.size(); ++i)
+  {
+    // From the root only a first byte leads anywhere
+    if (state == 0 && skip)
+    {
+      i = simd::find_any(text, m_first_bytes, i);
+      if (i == std::string_view::npos)
+      {
+        break;
+      }
+    }
+    state = static_cast<std::size_t>(table[state * m_classes + m_byte_class[data[i]]]);
+
+    // A needle starting at or before the best match would still be in the
+    // automaton's state; once none is, the best match is final
+    const std::size_t end = i + 1;
+    if (best && m_depth[state] < end - best->position)
+    {
+      return best;
+    }
+    if (m_output[state] >= 0)
+    {
+      const std::size_t length = m_output_length[state];
+      if (!best || end - length <= best->position)
+      {
+        best = match{end - length, length, static_cast<std::size_t>(m_output[state])};
+      }
+    }
+  }
+  return best;
+}
+
+bool multi_pattern::contains_any(std::string_view text) const noexcept
+{
+  const std::int32_t* table = m_transitions.data();
+  const auto*         data  = reinterpret_cast<const unsigned char*>(text.data());
+  const bool          skip  = !m_first_bytes.empty();
+  std::size_t         state = 0;
+  if (m_depth.size() == 1)
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < text.size(); ++i)
+  {
+    if (state == 0 && skip)
+    {
+      i = simd::find_any(text, m_first_bytes, i);
+      if (i == std::string_view::npos)
+      {
+        return false;
+      }
+    }
+    state = static_cast<std::size_t>(table[state * m_classes + m_byte_class[data[i]]]);
+    if (m_output[state] >= 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+template<typename Emit>
+void multi_pattern::for_each_match(std::string_view text, Emit&& emit) const
+{
+  std::size_t pos = 0;
+  while (auto found = find_any(text, pos))
+  {
+    emit(*found);
+    pos = found->position + found->length;
+  }
+}
+
+std::vector<multi_pattern::match> multi_pattern::find_all(std::string_view text) const
+{
+  std::vector<match> matches;
+  for_each_match(text, [&matches](const match& m) { matches.push_back(m); });
+  return matches;
+}
+
+std::size_t multi_pattern::count(std::string_view text) const noexcept
+{
+  std::size_t total = 0;
+  for_each_match(text, [&total](const match&) { ++total; });
+  return total;
+}
+
+// ============================================================================
+// Replacement
+// ============================================================================
+
+std::string multi_pattern::replace_many(std::string_view text, std::string_view replacement) const
+{
+  std::string result;
+  result.reserve(text.size());
+  std::size_t copied = 0;
+  for_each_match(text, [&](const match& m) {
+    result.append(text.substr(copied, m.position - copied));
+    result.append(replacement);
+    copied = m.position + m.length;
+  });
+  result.append(text.substr(copied));
+  return result;
+}
+
+std::string multi_pattern::replace_many(std::string_view text,
+                                        const std::vector<std::string_view>& replacements) const
+{
+  if (replacements.size() != m_patterns.size())
+  {
+    throw std::invalid_argument("multi_pattern::replace_many: one replacement per needle required");
+  }
+  std::string result;
+  result.reserve(text.size());
+  std::size_t copied = 0;
+  for_each_match(text, [&](const match& m) {
+    result.append(text.substr(copied, m.position - copied));
+    result.append(replacements[m.pattern]);
+    copied = m.position + m.length;
+  });
+  result.append(text.substr(copied));
+  return result;
+}
+
+// ============================================================================
+// Patterns
+// ============================================================================
+
+std::size_t multi_pattern::size() const noexcept
+{
+  return m_patterns.size();
+}
+
+bool multi_pattern::empty() const noexcept
+{
+  return m_patterns.empty();
+}
+
+std::string_view multi_pattern::pattern(std::size_t index) const noexcept
+{
+  return m_patterns[index];
+}
+
+std::size_t multi_pattern::state_count() const noexcept
+{
+  return m_depth.size();
+}
+
+} // namespace fb
@@ -0,0 +1,614 @@
+#include <fb/packed_string_list.h>
+#include <fb/string_hash.h>
+#include <fb/string_list.h>
+#include <fb/string_utils.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace fb
+{
+
+namespace
+{
+
+/// Largest arena the 32-bit entry offsets can address
+constexpr std::size_t MAX_BYTES = std::numeric_limits<std::uint32_t>::max();
+
+void check_arena_size(std::size_t bytes)
+{
+  if (bytes > MAX_BYTES)
+  {
+    throw std::length_error("packed_string_list: more than 4 GiB of characters");
+  }
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+/// Construct from initializer list
+packed_string_list::packed_string_list(std::initializer_list<std::string_view> init)
+{
+  size_type total = 0;
+  for (std::string_view s : init)
+  {
+    total += s.size();
+  }
+  reserve(init.size(), total);
+  for (std::string_view s : init)
+  {
+    push_back(s);
+  }
+}
+
+/// Construct from a string_list
+packed_string_list::packed_string_list(const string_list& list)
+  : packed_string_list(list.to_vector())
+{
+}
+
+/// Construct from vector
+packed_string_list::packed_string_list(const std::vector<std::string>& vec)
+{
+  size_type total = 0;
+  for (const auto& s : vec)
+  {
+    total += s.size();
+  }
+  reserve(vec.size(), total);
+  for (const auto& s : vec)
+  {
+    push_back(s);
+  }
+}
+
+// ============================================================================
+// Factory Methods
+// ============================================================================
+
+void packed_string_list::index_parts(std::string_view source, const std::vector<std::string_view>& parts)
+{
+  m_entries.reserve(parts.size());
+  for (std::string_view part : parts)
+  {
+    // Empty parts need not point into the source
+    const auto offset = part.empty() ? 0 : static_cast<std::uint32_t>(part.data() - source.data());
+    m_entries.push_back(entry{offset, static_cast<std::uint32_t>(part.size())});
+  }
+}
+
+/**
+ * @brief Create packed_string_list by splitting a string
+ * @param str String to split
+ * @param delimiter Character to split on
+ * @param keep_empty Keep empty parts (default: true)
+ * @return New packed_string_list, same elements as string_list::from_split()
+ */
+packed_string_list packed_string_list::from_split(std::string_view str,
+                                                  char             delimiter,
+                                                  bool             keep_empty)
+{
+  check_arena_size(str.size());
+  packed_string_list result;
+  result.m_bytes.assign(str.data(), str.size());
+  result.index_parts(str, fb::split_view(str, delimiter, keep_empty));
+  return result;
+}
+
+/**
+ * @brief Create packed_string_list by splitting a string
+ * @param str String to split
+ * @param delimiter String to split on
+ * @param keep_empty Keep empty parts (default: true)
+ * @return New packed_string_list, same elements as string_list::from_split()
+ */
+packed_string_list packed_string_list::from_split(std::string_view str,
+                                                  std::string_view delimiter,
+                                                  bool             keep_empty)
+{
+  check_arena_size(str.size());
+  packed_string_list result;
+  result.m_bytes.assign(str.data(), str.size());
+  result.index_parts(str, fb::split_view(str, delimiter, keep_empty));
+  return result;
+}
+
+/**
+ * @brief Create packed_string_list from lines of text
+ * @param str Multi-line string
+ * @param keep_empty Keep empty lines (default: true)
+ * @return New packed_string_list, same elements as string_list::from_lines()
+ */
+packed_string_list packed_string_list::from_lines(std::string_view str, bool keep_empty)
+{
+  check_arena_size(str.size());
+  packed_string_list            result;
+  std::vector<std::string_view> lines;
+  fb::split_lines_view(str, lines, keep_empty);
+  result.m_bytes.assign(str.data(), str.size());
+  result.index_parts(str, lines);
+  return result;
+}
+
+// ============================================================================
+// Element Access
+// ============================================================================
+
+/// Access element at index (bounds-checked)
+std::string_view packed_string_list::at(size_type index) const
+{
+  return view(m_entries.at(index));
+}
+
+/// Access element at index (unchecked)
+std::string_view packed_string_list::operator[](size_type index) const noexcept
+{
+  return view(m_entries[index]);
+}
+
+std::string_view packed_string_list::front() const noexcept
+{
+  return view(m_entries.front());
+}
+
+std::string_view packed_string_list::back() const noexcept
+{
+  return view(m_entries.back());
+}
+
+// ============================================================================
+// Iterators
+// ============================================================================
+
+packed_string_list::const_iterator packed_string_list::begin() const noexcept
+{
+  return const_iterator(m_entries.data(), m_bytes.data());
+}
+
+packed_string_list::const_iterator packed_string_list::cbegin() const noexcept
+{
+  return begin();
+}
+
+packed_string_list::const_iterator packed_string_list::end() const noexcept
+{
+  return const_iterator(m_entries.data() + m_entries.size(), m_bytes.data());
+}
+
+packed_string_list::const_iterator packed_string_list::cend() const noexcept
+{
+  return end();
+}
+
+packed_string_list::const_reverse_iterator packed_string_list::rbegin() const noexcept
+{
+  return const_reverse_iterator(end());
+}
+
+packed_string_list::const_reverse_iterator packed_string_list::crbegin() const noexcept
+{
+  return rbegin();
+}
+
+packed_string_list::const_reverse_iterator packed_string_list::rend() const noexcept
+{
+  return const_reverse_iterator(begin());
+}
+
+packed_string_list::const_reverse_iterator packed_string_list::crend() const noexcept
+{
+  return rend();
+}
+
+// ============================================================================
+// Capacity
+// ============================================================================
+
+bool packed_string_list::empty() const noexcept
+{
+  return m_entries.empty();
+}
+
+packed_string_list::size_type packed_string_list::size() const noexcept
+{
+  return m_entries.size();
+}
+
+packed_string_list::size_type packed_string_list::bytes() const noexcept
+{
+  return m_bytes.size();
+}
+
+void packed_string_list::reserve(size_type count, size_type bytes)
+{
+  m_entries.reserve(count);
+  m_bytes.reserve(std::min(bytes, MAX_BYTES));
+}
+
+void packed_string_list::shrink_to_fit()
+{
+  compact();
+  m_bytes.shrink_to_fit();
+  m_entries.shrink_to_fit();
+}
+
+// ============================================================================
+// Modifiers
+// ============================================================================
+
+void packed_string_list::clear() noexcept
+{
+  m_bytes.clear();
+  m_entries.clear();
+}
+
+/**
+ * @brief Append a copy of a string
+ * @param value String to append; may be an element of this list
+ * @throws std::length_error if the arena would exceed 4 GiB
+ */
+void packed_string_list::push_back(std::string_view value)
+{
+  check_arena_size(m_bytes.size() + value.size());
+  const auto offset = static_cast<std::uint32_t>(m_bytes.size());
+  // std::string::append copes with value pointing into m_bytes
+  m_bytes.append(value.data(), value.size());
+  m_entries.push_back(entry{offset, static_cast<std::uint32_t>(value.size())});
+}
+
+void packed_string_list::pop_back() noexcept
+{
+  const entry last = m_entries.back();
+  m_entries.pop_back();
+  // Reclaim the characters when they are the newest in the arena
+  if (last.length > 0 && last.offset + last.length == m_bytes.size())
+  {
+    m_bytes.resize(last.offset);
+  }
+}
+
+void packed_string_list::swap(packed_string_list& other) noexcept
+{
+  m_bytes.swap(other.m_bytes);
+  m_entries.swap(other.m_entries);
+}
+
+void packed_string_list::compact()
+{
+  std::string packed;
+  size_type   total = 0;
+  for (const entry& e : m_entries)
+  {
+    total += e.length;
+  }
+  packed.reserve(total);
+  for (entry& e : m_entries)
+  {
+    const auto offset = static_cast<std::uint32_t>(packed.size());
+    packed.append(m_bytes, e.offset, e.length);
+    e.offset = offset;
+  }
+  m_bytes.swap(packed);
+}
+
+// ============================================================================
+// String List Operations
+// ============================================================================
+
+/**
+ * @brief Join all strings with a delimiter
+ * @param delimiter String to insert between elements
+ * @return Joined string
+ */
+std::string packed_string_list::join(std::string_view delimiter) const
+{
+  std::string result;
+  if (m_entries.empty())
+  {
+    return result;
+  }
+  size_type total = delimiter.size() * (m_entries.size() - 1);
+  for (const entry& e : m_entries)
+  {
+    total += e.length;
+  }
+  result.reserve(total);
+  result.append(view(m_entries.front()));
+  for (auto it = m_entries.begin() + 1; it != m_entries.end(); ++it)
+  {
+    result.append(delimiter);
+    result.append(view(*it));
+  }
+  return result;
+}
+
+/**
+ * @brief Join all strings with a character delimiter
+ * @param delimiter Character to insert between elements
+ * @return Joined string
+ */
+std::string packed_string_list::join(char delimiter) const
+{
+  return join(std::string_view(&delimiter, 1));
+}
+
+/**
+ * @brief Join all strings with no delimiter
+ * @return Concatenated string
+ */
+std::string packed_string_list::join() const
+{
+  return join(std::string_view());
+}
+
+/**
+ * @brief Filter elements by predicate
+ * @param predicate Function returning true for elements to keep
+ * @return New list holding only the kept characters
+ */
+packed_string_list packed_string_list::filter(std::function<bool(std::string_view)> predicate) const
+{
+  packed_string_list result;
+  for (const entry& e : m_entries)
+  {
+    if (predicate(view(e)))
+    {
+      result.push_back(view(e));
+    }
+  }
+  return result;
+}
+
+packed_string_list packed_string_list::filter_containing(std::string_view substr) const
+{
+  return filter([substr](std::string_view s) { return s.find(substr) != std::string_view::npos; });
+}
+
+packed_string_list packed_string_list::filter_starts_with(std::string_view prefix) const
+{
+  return filter([prefix](std::string_view s) { return fb::starts_with(s, prefix); });
+}
+
+packed_string_list packed_string_list::filter_ends_with(std::string_view suffix) const
+{
+  return filter([suffix](std::string_view s) { return fb::ends_with(s, suffix); });
+}
+
+// ============================================================================
+// Search Operations
+// ============================================================================
+
+bool packed_string_list::contains(std::string_view str) const noexcept
+{
+  return index_of(str).has_value();
+}
+
+bool packed_string_list::contains_ignore_case(std::string_view str) const noexcept
+{
+  return std::any_of(m_entries.begin(), m_entries.end(), [this, str](const entry& e) {
+    return e.length == str.size() && fb::equals_ignore_case(view(e), str);
+  });
+}
+
+std::optional<packed_string_list::size_type>
+packed_string_list::index_of(std::string_view str) const noexcept
+{
+  // Compare lengths first: most entries are rejected without touching the arena
+  for (size_type i = 0; i < m_entries.size(); ++i)
+  {
+    if (m_entries[i].length == str.size() && view(m_entries[i]) == str)
+    {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<packed_string_list::size_type>
+packed_string_list::last_index_of(std::string_view str) const noexcept
+{
+  for (size_type i = m_entries.size(); i > 0; --i)
+  {
+    if (m_entries[i - 1].length == str.size() && view(m_entries[i - 1]) == str)
+    {
+      return i - 1;
+    }
+  }
+  return std::nullopt;
+}
+
+packed_string_list::size_type packed_string_list::count(std::string_view str) const noexcept
+{
+  return static_cast<size_type>(std::count_if(m_entries.begin(), m_entries.end(), [this, str](const entry& e) {
+    return e.length == str.size() && view(e) == str;
+  }));
+}
+
+// ============================================================================
+// Sorting and Ordering
+// ============================================================================
+
+// Sorting moves the 8-byte entries only; the characters stay in place
+
+packed_string_list& packed_string_list::sort()
+{
+  std::sort(m_entries.begin(), m_entries.end(), [this](const entry& a, const entry& b) {
+    return view(a) < view(b);
+  });
+  return *this;
+}
+
+packed_string_list& packed_string_list::sort(std::function<bool(std::string_view, std::string_view)> comp)
+{
+  std::sort(m_entries.begin(), m_entries.end(), [this, &comp](const entry& a, const entry& b) {
+    return comp(view(a), view(b));
+  });
+  return *this;
+}
+
+packed_string_list& packed_string_list::sort_ignore_case()
+{
+  std::sort(m_entries.begin(), m_entries.end(), [this](const entry& a, const entry& b) {
+    return fb::compare_ignore_case(view(a), view(b)) < 0;
+  });
+  return *this;
+}
+
+packed_string_list& packed_string_list::sort_natural()
+{
+  std::sort(m_entries.begin(), m_entries.end(), [this](const entry& a, const entry& b) {
+    return fb::natural_compare(view(a), view(b)) < 0;
+  });
+  return *this;
+}
+
+packed_string_list& packed_string_list::reverse()
+{
+  std::reverse(m_entries.begin(), m_entries.end());
+  return *this;
+}
+
+/**
+ * @brief Remove consecutive duplicates
+ * @return Reference to this
+ */
+packed_string_list& packed_string_list::unique()
+{
+  auto it = std::unique(m_entries.begin(), m_entries.end(), [this](const entry& a, const entry& b) {
+    return view(a) == view(b);
+  });
+  m_entries.erase(it, m_entries.end());
+  return *this;
+}
+
+// ============================================================================
+// Utility Operations
+// ============================================================================
+
+packed_string_list& packed_string_list::remove_empty()
+{
+  m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [](const entry& e) { return e.length == 0; }),
+                  m_entries.end());
+  return *this;
+}
+
+/**
+ * @brief Remove all duplicates, keeping first occurrence
+ * @return Reference to this
+ */
+packed_string_list& packed_string_list::remove_duplicates()
+{
+  // The views stay valid: the arena is not touched while entries are removed
+  std::unordered_set<std::string_view, xxh3_hash> seen;
+  seen.reserve(m_entries.size());
+  m_entries.erase(std::remove_if(m_entries.begin(),
+                                 m_entries.end(),
+                                 [this, &seen](const entry& e) { return !seen.insert(view(e)).second; }),
+                  m_entries.end());
+  return *this;
+}
+
+packed_string_list packed_string_list::copy_range(const entry* first, const entry* last) const
+{
+  packed_string_list result;
+  size_type          total = 0;
+  for (const entry* e = first; e != last; ++e)
+  {
+    total += e->length;
+  }
+  result.reserve(static_cast<size_type>(last - first), total);
+  for (const entry* e = first; e != last; ++e)
+  {
+    result.push_back(view(*e));
+  }
+  return result;
+}
+
+/**
+ * @brief Take first n elements
+ * @param n Number of elements
+ * @return New list with the first n elements
+ */
+packed_string_list packed_string_list::take(size_type n) const
+{
+  return copy_range(m_entries.data(), m_entries.data() + std::min(n, m_entries.size()));
+}
+
+/**
+ * @brief Skip first n elements
+ * @param n Number of elements to skip
+ * @return New list without the first n elements
+ */
+packed_string_list packed_string_list::skip(size_type n) const
+{
+  return copy_range(m_entries.data() + std::min(n, m_entries.size()), m_entries.data() + m_entries.size());
+}
+
+/**
+ * @brief Take last n elements
+ * @param n Number of elements
+ * @return New list with the last n elements
+ */
+packed_string_list packed_string_list::take_last(size_type n) const
+{
+  return copy_range(m_entries.data() + m_entries.size() - std::min(n, m_entries.size()),
+                    m_entries.data() + m_entries.size());
+}
+
+/**
+ * @brief Get slice of list
+ * @param start Start index
+ * @param end End index (exclusive)
+ * @return New list with elements [start, end)
+ */
+packed_string_list packed_string_list::slice(size_type start, size_type end) const
+{
+  end = std::min(end, m_entries.size());
+  if (start >= end)
+  {
+    return packed_string_list();
+  }
+  return copy_range(m_entries.data() + start, m_entries.data() + end);
+}
+
+// ============================================================================
+// Conversion
+// ============================================================================
+
+string_list packed_string_list::to_string_list() const
+{
+  string_list result;
+  result.reserve(m_entries.size());
+  for (const entry& e : m_entries)
+  {
+    result.emplace_back(view(e));
+  }
+  return result;
+}
+
+/// Views into this list, valid until it is modified
+std::vector<std::string_view> packed_string_list::to_views() const
+{
+  return std::vector<std::string_view>(begin(), end());
+}
+
+// ============================================================================
+// Operators
+// ============================================================================
+
+bool packed_string_list::operator==(const packed_string_list& other) const noexcept
+{
+  return m_entries.size() == other.m_entries.size() && std::equal(begin(), end(), other.begin());
+}
+
+bool packed_string_list::operator!=(const packed_string_list& other) const noexcept
+{
+  return !(*this == other);
+}
+
+} // namespace fb
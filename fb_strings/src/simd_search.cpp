@@ -0,0 +1,1686 @@
+/// @file simd_search.cpp
+/// @brief SSE2, AVX2, NEON and scalar byte search and UTF-8 validation kernels
+
+#include <fb/simd_search.h>
+
+#include <fb/detail/simd_isa.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace fb
+{
+namespace simd
+{
+
+namespace
+{
+
+/// Sets up to this size are compared one broadcast byte at a time
+constexpr std::size_t MAX_SIMD_SET = 8;
+
+struct kernels
+{
+  isa id;
+  /// @return Offset of the first byte in the set, or size
+  std::size_t (*find_any)(const char* data, std::size_t size, const char* set, std::size_t set_size);
+  /// @return Offset of the first occurrence of the needle, or size
+  /// @pre needle_size >= 2 and size >= needle_size
+  std::size_t (*find)(const char* data, std::size_t size, const char* needle, std::size_t needle_size);
+  /// @return Offset of the first quote, backslash or control character, or size
+  std::size_t (*find_json_escape)(const char* data, std::size_t size);
+  bool (*is_ascii)(const char* data, std::size_t size);
+  void (*replace)(char* data, std::size_t size, char from, char to);
+  bool (*is_valid_utf8)(const char* data, std::size_t size);
+  void (*to_lower)(char* data, std::size_t size);
+  void (*to_upper)(char* data, std::size_t size);
+  void (*swap_case)(char* data, std::size_t size);
+  bool (*equals_ignore_case)(const char* a, const char* b, std::size_t size);
+  /// @pre 64 readable bytes at block
+  block_masks (*classify)(const char* block);
+};
+
+[[maybe_unused]] unsigned trailing_zeros(std::uint64_t mask) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index = 0;
+  _BitScanForward64(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+unsigned popcount(std::uint64_t mask) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  return static_cast<unsigned>(__popcnt64(mask));
+#else
+  return static_cast<unsigned>(__builtin_popcountll(mask));
+#endif
+}
+
+// ============================================================================
+// Scalar Kernels
+// ============================================================================
+
+std::size_t find_byte(const char* data, std::size_t size, char ch) noexcept
+{
+  const void* hit = std::memchr(data, ch, size);
+  return hit != nullptr ? static_cast<std::size_t>(static_cast<const char*>(hit) - data) : size;
+}
+
+bool in_set(char ch, const char* set, std::size_t set_size) noexcept
+{
+  for (std::size_t i = 0; i < set_size; ++i)
+  {
+    if (set[i] == ch)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::size_t find_any_scalar(const char* data, std::size_t size, const char* set, std::size_t set_size)
+{
+  if (set_size == 1)
+  {
+    return find_byte(data, size, set[0]);
+  }
+
+  if (set_size <= MAX_SIMD_SET)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      if (in_set(data[i], set, set_size))
+      {
+        return i;
+      }
+    }
+    return size;
+  }
+
+  std::array<bool, 256> table{};
+  for (std::size_t i = 0; i < set_size; ++i)
+  {
+    table[static_cast<unsigned char>(set[i])] = true;
+  }
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    if (table[static_cast<unsigned char>(data[i])])
+    {
+      return i;
+    }
+  }
+  return size;
+}
+
+/// Whether the needle occurs at @p candidate, whose first and last bytes
+/// are already known to match
+bool matches_inner(const char* candidate, const char* needle, std::size_t needle_size) noexcept
+{
+  return std::memcmp(candidate + 1, needle + 1, needle_size - 2) == 0;
+}
+
+/// First candidate i + k, for bit k of @p mask, at which the whole needle
+/// occurs, or npos
+[[maybe_unused]] std::size_t verify_candidates(const char*   data,
+                                               std::size_t   i,
+                                               std::uint64_t mask,
+                                               const char*   needle,
+                                               std::size_t   needle_size) noexcept
+{
+  for (; mask != 0; mask &= mask - 1)
+  {
+    std::size_t candidate = i + trailing_zeros(mask);
+    if (matches_inner(data + candidate, needle, needle_size))
+    {
+      return candidate;
+    }
+  }
+  return std::string_view::npos;
+}
+
+std::size_t find_scalar(const char* data, std::size_t size, const char* needle, std::size_t needle_size)
+{
+  const std::size_t candidates = size - needle_size + 1;
+  const char        last       = needle[needle_size - 1];
+  for (std::size_t i = 0; i < candidates; ++i)
+  {
+    i = i + find_byte(data + i, candidates - i, needle[0]);
+    if (i == candidates)
+    {
+      break;
+    }
+    if (data[i + needle_size - 1] == last && matches_inner(data + i, needle, needle_size))
+    {
+      return i;
+    }
+  }
+  return size;
+}
+
+bool needs_json_escape(char ch) noexcept
+{
+  return ch == '"' || ch == '\\' || static_cast<unsigned char>(ch) < 0x20;
+}
+
+std::size_t find_json_escape_scalar(const char* data, std::size_t size)
+{
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    if (needs_json_escape(data[i]))
+    {
+      return i;
+    }
+  }
+  return size;
+}
+
+bool is_ascii_scalar(const char* data, std::size_t size)
+{
+  // Eight bytes at a time
+  std::uint64_t bits = 0;
+  std::size_t i      = 0;
+  for (; i + sizeof(bits) <= size; i += sizeof(bits))
+  {
+    std::uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    bits |= word;
+  }
+  for (; i < size; ++i)
+  {
+    bits |= static_cast<unsigned char>(data[i]);
+  }
+  return (bits & 0x8080808080808080ULL) == 0;
+}
+
+void replace_scalar(char* data, std::size_t size, char from, char to)
+{
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    if (data[i] == from)
+    {
+      data[i] = to;
+    }
+  }
+}
+
+/// @return Index of the first non-ASCII byte at or after @p i, 8 bytes at a time
+std::size_t skip_ascii_scalar(const unsigned char* data, std::size_t size, std::size_t i) noexcept
+{
+  for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+  {
+    std::uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    if ((word & 0x8080808080808080ULL) != 0)
+    {
+      break;
+    }
+  }
+  while (i < size && data[i] < 0x80)
+  {
+    ++i;
+  }
+  return i;
+}
+
+/// @brief Checks the well-formed byte sequences of Unicode table 3-7, which
+///        rule out overlong forms, surrogates and code points past U+10FFFF
+/// @param skip_ascii Called at each ASCII byte to jump over the ASCII run
+template<typename SkipAscii>
+bool is_valid_utf8_with(const char* chars, std::size_t size, SkipAscii skip_ascii)
+{
+  const auto* data = reinterpret_cast<const unsigned char*>(chars);
+  std::size_t i    = 0;
+  while (i < size)
+  {
+    unsigned char lead = data[i];
+    if (lead < 0x80)
+    {
+      i = skip_ascii(data, size, i);
+      continue;
+    }
+
+    std::size_t length = 0;
+    unsigned char low  = 0x80; // Allowed range of the second byte
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+      length = 2;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+      length = 3;
+      low    = lead == 0xE0 ? 0xA0 : low;
+      high   = lead == 0xED ? 0x9F : high;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+      length = 4;
+      low    = lead == 0xF0 ? 0x90 : low;
+      high   = lead == 0xF4 ? 0x8F : high;
+    }
+    else
+    {
+      return false;
+    }
+
+    if (size - i < length || data[i + 1] < low || data[i + 1] > high)
+    {
+      return false;
+    }
+    for (std::size_t k = 2; k < length; ++k)
+    {
+      if ((data[i + k] & 0xC0) != 0x80)
+      {
+        return false;
+      }
+    }
+    i += length;
+  }
+  return true;
+}
+
+bool is_valid_utf8_scalar(const char* data, std::size_t size)
+{
+  return is_valid_utf8_with(data, size, skip_ascii_scalar);
+}
+
+/// @brief Which letters a case conversion flips, by bit 0x20
+enum class case_op
+{
+  lower, ///< A-Z
+  upper, ///< a-z
+  swap   ///< A-Z and a-z
+};
+
+template<case_op Op>
+constexpr char convert_case_byte(char ch) noexcept
+{
+  const unsigned byte  = static_cast<unsigned char>(ch);
+  const unsigned first = Op == case_op::lower ? 'A' : 'a';
+  const unsigned key   = Op == case_op::swap ? byte | 0x20u : byte;
+  return key - first < 26u ? static_cast<char>(byte ^ 0x20u) : ch;
+}
+
+template<case_op Op>
+void convert_case_scalar(char* data, std::size_t size)
+{
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    data[i] = convert_case_byte<Op>(data[i]);
+  }
+}
+
+bool equals_ignore_case_scalar(const char* a, const char* b, std::size_t size)
+{
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    if (convert_case_byte<case_op::lower>(a[i]) != convert_case_byte<case_op::lower>(b[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// ' ' or \t, \n, \v, \f, \r, the control characters 9 to 13
+constexpr bool is_space(char ch) noexcept
+{
+  return ch == ' ' || static_cast<unsigned char>(ch - '\t') <= '\r' - '\t';
+}
+
+/// Bit 0: whitespace, bit 1: \n, bit 2: \r
+constexpr std::array<std::uint8_t, 256> make_byte_classes()
+{
+  std::array<std::uint8_t, 256> classes{};
+  for (unsigned ch = 0; ch < 256; ++ch)
+  {
+    classes[ch] = static_cast<std::uint8_t>((is_space(static_cast<char>(ch)) ? 1 : 0) | (ch == '\n' ? 2 : 0) |
+                                            (ch == '\r' ? 4 : 0));
+  }
+  return classes;
+}
+
+constexpr std::array<std::uint8_t, 256> BYTE_CLASSES = make_byte_classes();
+
+block_masks classify_scalar(const char* block)
+{
+  block_masks masks{};
+  for (unsigned k = 0; k < MASK_BLOCK; ++k)
+  {
+    const std::uint64_t classes = BYTE_CLASSES[static_cast<unsigned char>(block[k])];
+    masks.whitespace |= (classes & 1) << k;
+    masks.line_feed |= ((classes >> 1) & 1) << k;
+    masks.carriage_return |= (classes >> 2) << k;
+  }
+  return masks;
+}
+
+constexpr kernels SCALAR_KERNELS = {isa::scalar,
+                                    find_any_scalar,
+                                    find_scalar,
+                                    find_json_escape_scalar,
+                                    is_ascii_scalar,
+                                    replace_scalar,
+                                    is_valid_utf8_scalar,
+                                    convert_case_scalar<case_op::lower>,
+                                    convert_case_scalar<case_op::upper>,
+                                    convert_case_scalar<case_op::swap>,
+                                    equals_ignore_case_scalar,
+                                    classify_scalar};
+
+// ============================================================================
+// SSE2 Kernels
+// ============================================================================
+
+#if FB_SIMD_SSE2
+
+template<std::size_t N>
+std::size_t find_any_sse2_n(const char* data, std::size_t size, const char* set)
+{
+  constexpr std::size_t BLOCK = 16;
+  if (size < BLOCK)
+  {
+    return find_any_scalar(data, size, set, N);
+  }
+
+  __m128i needles[N];
+  for (std::size_t k = 0; k < N; ++k)
+  {
+    needles[k] = _mm_set1_epi8(set[k]);
+  }
+
+  auto scan = [&needles](const char* block_data) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block_data));
+    __m128i hits  = _mm_cmpeq_epi8(block, needles[0]);
+    for (std::size_t k = 1; k < N; ++k)
+    {
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, needles[k]));
+    }
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+  };
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    if (std::uint32_t mask = scan(data + i))
+    {
+      return i + trailing_zeros(mask);
+    }
+  }
+
+  // Overlapping last block: the bytes before i are known not to match
+  if (i < size)
+  {
+    if (std::uint32_t mask = scan(data + size - BLOCK))
+    {
+      return size - BLOCK + trailing_zeros(mask);
+    }
+  }
+  return size;
+}
+
+std::size_t find_any_sse2(const char* data, std::size_t size, const char* set, std::size_t set_size)
+{
+  switch (set_size)
+  {
+  case 1: return find_byte(data, size, set[0]);
+  case 2: return find_any_sse2_n<2>(data, size, set);
+  case 3: return find_any_sse2_n<3>(data, size, set);
+  case 4: return find_any_sse2_n<4>(data, size, set);
+  case 5: return find_any_sse2_n<5>(data, size, set);
+  case 6: return find_any_sse2_n<6>(data, size, set);
+  case 7: return find_any_sse2_n<7>(data, size, set);
+  case 8: return find_any_sse2_n<8>(data, size, set);
+  default: return find_any_scalar(data, size, set, set_size);
+  }
+}
+
+// The substring kernels compare a broadcast first and last byte of the
+// needle with the blocks at each candidate position and the one
+// needle_size - 1 bytes further on; only candidates where both match are
+// compared in full
+
+std::size_t find_sse2(const char* data, std::size_t size, const char* needle, std::size_t needle_size)
+{
+  constexpr std::size_t BLOCK = 16;
+  const std::size_t candidates = size - needle_size + 1;
+  if (candidates < BLOCK)
+  {
+    return find_scalar(data, size, needle, needle_size);
+  }
+
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last  = _mm_set1_epi8(needle[needle_size - 1]);
+
+  auto scan = [&](std::size_t i) {
+    __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i block_last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + needle_size - 1));
+    auto    mask        = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+    return mask != 0 ? verify_candidates(data, i, mask, needle, needle_size) : std::string_view::npos;
+  };
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= candidates; i += BLOCK)
+  {
+    if (std::size_t found = scan(i); found != std::string_view::npos)
+    {
+      return found;
+    }
+  }
+
+  // Overlapping last block: the candidates before i are known not to match
+  std::size_t found = i < candidates ? scan(candidates - BLOCK) : std::string_view::npos;
+  return found != std::string_view::npos ? found : size;
+}
+
+/// Quote, backslash or unsigned byte <= 0x1F
+std::uint32_t json_escape_mask_sse2(__m128i block) noexcept
+{
+  __m128i hits = _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(0x1F)), block);
+  hits         = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8('"')));
+  hits         = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8('\\')));
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+}
+
+std::size_t find_json_escape_sse2(const char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  if (size < BLOCK)
+  {
+    return find_json_escape_scalar(data, size);
+  }
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    if (std::uint32_t mask = json_escape_mask_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))))
+    {
+      return i + trailing_zeros(mask);
+    }
+  }
+
+  // Overlapping last block: the bytes before i are known not to match
+  if (i < size)
+  {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + size - BLOCK));
+    if (std::uint32_t mask = json_escape_mask_sse2(block))
+    {
+      return size - BLOCK + trailing_zeros(mask);
+    }
+  }
+  return size;
+}
+
+bool is_ascii_sse2(const char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  __m128i bits  = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 4 * BLOCK <= size; i += 4 * BLOCK)
+  {
+    const __m128i* blocks = reinterpret_cast<const __m128i*>(data + i);
+    bits = _mm_or_si128(bits,
+                        _mm_or_si128(_mm_or_si128(_mm_loadu_si128(blocks), _mm_loadu_si128(blocks + 1)),
+                                     _mm_or_si128(_mm_loadu_si128(blocks + 2), _mm_loadu_si128(blocks + 3))));
+  }
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    bits = _mm_or_si128(bits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+  }
+  return _mm_movemask_epi8(bits) == 0 && is_ascii_scalar(data + i, size - i);
+}
+
+void replace_sse2(char* data, std::size_t size, char from, char to)
+{
+  constexpr std::size_t BLOCK = 16;
+  const __m128i match       = _mm_set1_epi8(from);
+  const __m128i replacement = _mm_set1_epi8(to);
+  std::size_t i             = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m128i* block_data = reinterpret_cast<__m128i*>(data + i);
+    __m128i block      = _mm_loadu_si128(block_data);
+    __m128i hits       = _mm_cmpeq_epi8(block, match);
+    block = _mm_or_si128(_mm_andnot_si128(hits, block), _mm_and_si128(hits, replacement));
+    _mm_storeu_si128(block_data, block);
+  }
+  replace_scalar(data + i, size - i, from, to);
+}
+
+/// @return Index of the first non-ASCII byte at or after @p i, 16 bytes at a time
+std::size_t skip_ascii_sse2(const unsigned char* data, std::size_t size, std::size_t i) noexcept
+{
+  constexpr std::size_t BLOCK = 16;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))) != 0)
+    {
+      break;
+    }
+  }
+  return skip_ascii_scalar(data, size, i);
+}
+
+bool is_valid_utf8_sse2(const char* data, std::size_t size)
+{
+  // The table lookups of the AVX2 and NEON kernels need PSHUFB, which SSE2
+  // lacks: this kernel only skips ASCII runs 16 bytes at a time
+  return is_valid_utf8_with(data, size, skip_ascii_sse2);
+}
+
+/// Bytes of @p block in [first, first + 26), as 0xFF
+__m128i letters_sse2(__m128i block, char first) noexcept
+{
+  // Shift the range down to the bottom of the signed bytes
+  __m128i shifted = _mm_add_epi8(block, _mm_set1_epi8(static_cast<char>(-128 - first)));
+  return _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 26));
+}
+
+template<case_op Op>
+__m128i convert_case_sse2(__m128i block) noexcept
+{
+  __m128i letters = Op == case_op::lower   ? letters_sse2(block, 'A')
+                    : Op == case_op::upper ? letters_sse2(block, 'a')
+                                           : letters_sse2(_mm_or_si128(block, _mm_set1_epi8(0x20)), 'a');
+  return _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+}
+
+template<case_op Op>
+void convert_case_sse2(char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  std::size_t i               = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m128i* block_data = reinterpret_cast<__m128i*>(data + i);
+    _mm_storeu_si128(block_data, convert_case_sse2<Op>(_mm_loadu_si128(block_data)));
+  }
+  convert_case_scalar<Op>(data + i, size - i);
+}
+
+bool equals_ignore_case_sse2(const char* a, const char* b, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  std::size_t i               = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m128i lower_a = convert_case_sse2<case_op::lower>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+    __m128i lower_b = convert_case_sse2<case_op::lower>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(lower_a, lower_b)) != 0xFFFF)
+    {
+      return false;
+    }
+  }
+  return equals_ignore_case_scalar(a + i, b + i, size - i);
+}
+
+/// Each 16-byte quarter sets 16 bits of the masks
+block_masks classify_sse2(const char* block)
+{
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab   = _mm_set1_epi8('\t');
+  const __m128i span  = _mm_set1_epi8('\r' - '\t');
+  const __m128i lf    = _mm_set1_epi8('\n');
+  const __m128i cr    = _mm_set1_epi8('\r');
+
+  block_masks masks{};
+  for (unsigned k = 0; k < MASK_BLOCK / 16; ++k)
+  {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * k));
+    // bytes - '\t' <= span, unsigned: the saturating difference is zero
+    __m128i controls = _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8(bytes, tab), span), _mm_setzero_si128());
+    __m128i blank    = _mm_or_si128(controls, _mm_cmpeq_epi8(bytes, space));
+    auto    shift    = 16 * k;
+    masks.whitespace |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(blank))} << shift;
+    masks.line_feed |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, lf)))}
+                       << shift;
+    masks.carriage_return |=
+        std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, cr)))} << shift;
+  }
+  return masks;
+}
+
+constexpr kernels SSE2_KERNELS = {isa::sse2,
+                                  find_any_sse2,
+                                  find_sse2,
+                                  find_json_escape_sse2,
+                                  is_ascii_sse2,
+                                  replace_sse2,
+                                  is_valid_utf8_sse2,
+                                  convert_case_sse2<case_op::lower>,
+                                  convert_case_sse2<case_op::upper>,
+                                  convert_case_sse2<case_op::swap>,
+                                  equals_ignore_case_sse2,
+                                  classify_sse2};
+
+#endif // FB_SIMD_SSE2
+
+// ============================================================================
+// UTF-8 Validation Tables
+// ============================================================================
+
+// The AVX2 and NEON validators classify every byte pair with three 16-entry
+// lookups (high nibble of the previous byte, its low nibble, high nibble of
+// the current byte); a nonzero AND of the three is an error. The bits that
+// 3- and 4-byte sequences must set in bytes 3 and 4 are checked separately.
+// Each lookup table is indexed by a nibble; bits name the error they catch.
+
+#if FB_SIMD_AVX2 || FB_SIMD_NEON
+
+constexpr std::uint8_t TOO_SHORT      = 1 << 0; // 11______ 0_______ or 11______ 11______
+constexpr std::uint8_t TOO_LONG       = 1 << 1; // 0_______ 10______
+constexpr std::uint8_t OVERLONG_3     = 1 << 2; // 11100000 100_____
+constexpr std::uint8_t TOO_LARGE      = 1 << 3; // 11110100 1001____, 11110100 101_____, 11110101+
+constexpr std::uint8_t SURROGATE      = 1 << 4; // 11101101 101_____
+constexpr std::uint8_t OVERLONG_2     = 1 << 5; // 1100000_ 10______
+constexpr std::uint8_t TOO_LARGE_1000 = 1 << 6; // 11110101+ 1000____
+constexpr std::uint8_t OVERLONG_4     = 1 << 6; // 11110000 1000____
+constexpr std::uint8_t TWO_CONTS      = 1 << 7; // 10______ 10______
+constexpr std::uint8_t CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+alignas(16) constexpr std::uint8_t BYTE_1_HIGH[16] = {
+    // 0_______: ASCII
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    // 10______: continuation
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    // 1100____, 1101____: 2-byte lead
+    TOO_SHORT | OVERLONG_2, TOO_SHORT,
+    // 1110____: 3-byte lead
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    // 1111____: 4-byte lead
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4};
+
+alignas(16) constexpr std::uint8_t BYTE_1_LOW[16] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, // ____0000
+    CARRY | OVERLONG_2,                           // ____0001
+    CARRY,                                        // ____0010
+    CARRY,                                        // ____0011
+    CARRY | TOO_LARGE,                            // ____0100
+    CARRY | TOO_LARGE | TOO_LARGE_1000,           // ____0101
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, // ____1101
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000};
+
+alignas(16) constexpr std::uint8_t BYTE_2_HIGH[16] = {
+    // 0_______: ASCII
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    // 1000____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    // 1001____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    // 101_____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    // 11______: lead
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT};
+
+#endif // FB_SIMD_AVX2 || FB_SIMD_NEON
+
+// ============================================================================
+// AVX2 Kernels
+// ============================================================================
+
+#if FB_SIMD_AVX2
+
+template<std::size_t N>
+FB_TARGET_AVX2 std::uint32_t scan_avx2(const char* block_data, const __m256i* needles)
+{
+  __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_data));
+  __m256i hits  = _mm256_cmpeq_epi8(block, needles[0]);
+  for (std::size_t k = 1; k < N; ++k)
+  {
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, needles[k]));
+  }
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+template<std::size_t N>
+FB_TARGET_AVX2 std::size_t find_any_avx2_n(const char* data, std::size_t size, const char* set)
+{
+  constexpr std::size_t BLOCK = 32;
+  if (size < BLOCK)
+  {
+    return find_any_sse2_n<N>(data, size, set);
+  }
+
+  __m256i needles[N];
+  for (std::size_t k = 0; k < N; ++k)
+  {
+    needles[k] = _mm256_set1_epi8(set[k]);
+  }
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    if (std::uint32_t mask = scan_avx2<N>(data + i, needles))
+    {
+      return i + trailing_zeros(mask);
+    }
+  }
+
+  // Overlapping last block: the bytes before i are known not to match
+  if (i < size)
+  {
+    if (std::uint32_t mask = scan_avx2<N>(data + size - BLOCK, needles))
+    {
+      return size - BLOCK + trailing_zeros(mask);
+    }
+  }
+  return size;
+}
+
+FB_TARGET_AVX2 std::size_t find_any_avx2(const char* data,
+                                         std::size_t size,
+                                         const char* set,
+                                         std::size_t set_size)
+{
+  switch (set_size)
+  {
+  case 1: return find_byte(data, size, set[0]);
+  case 2: return find_any_avx2_n<2>(data, size, set);
+  case 3: return find_any_avx2_n<3>(data, size, set);
+  case 4: return find_any_avx2_n<4>(data, size, set);
+  case 5: return find_any_avx2_n<5>(data, size, set);
+  case 6: return find_any_avx2_n<6>(data, size, set);
+  case 7: return find_any_avx2_n<7>(data, size, set);
+  case 8: return find_any_avx2_n<8>(data, size, set);
+  default: return find_any_scalar(data, size, set, set_size);
+  }
+}
+
+/// Bit k is set when the needle's first and last bytes match at candidate i + k
+FB_TARGET_AVX2 std::uint32_t candidates_avx2(const char* data, std::size_t i, std::size_t last_offset, __m256i first,
+                                             __m256i last)
+{
+  __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+  __m256i block_last  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + last_offset));
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(
+      _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+}
+
+FB_TARGET_AVX2 std::size_t find_avx2(const char* data, std::size_t size, const char* needle, std::size_t needle_size)
+{
+  constexpr std::size_t BLOCK = 32;
+  const std::size_t candidates  = size - needle_size + 1;
+  const std::size_t last_offset = needle_size - 1;
+  if (candidates < BLOCK)
+  {
+    return find_sse2(data, size, needle, needle_size);
+  }
+
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last  = _mm256_set1_epi8(needle[last_offset]);
+
+  // Two blocks per iteration keep the loop at memchr speed when candidates
+  // are rare
+  std::size_t i = 0;
+  for (; i + 2 * BLOCK <= candidates; i += 2 * BLOCK)
+  {
+    std::uint64_t mask = candidates_avx2(data, i, last_offset, first, last) |
+                         std::uint64_t{candidates_avx2(data, i + BLOCK, last_offset, first, last)} << BLOCK;
+    if (mask != 0)
+    {
+      if (std::size_t found = verify_candidates(data, i, mask, needle, needle_size); found != std::string_view::npos)
+      {
+        return found;
+      }
+    }
+  }
+
+  // Up to two more blocks, the last one overlapping: the candidates before
+  // i are known not to match
+  while (i < candidates)
+  {
+    i = std::min(i, candidates - BLOCK);
+    if (std::uint32_t mask = candidates_avx2(data, i, last_offset, first, last))
+    {
+      if (std::size_t found = verify_candidates(data, i, mask, needle, needle_size); found != std::string_view::npos)
+      {
+        return found;
+      }
+    }
+    i += BLOCK;
+  }
+  return size;
+}
+
+FB_TARGET_AVX2 std::uint32_t json_escape_mask_avx2(const char* block_data)
+{
+  const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_data));
+  __m256i hits        = _mm256_cmpeq_epi8(_mm256_min_epu8(block, _mm256_set1_epi8(0x1F)), block);
+  hits                = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('"')));
+  hits                = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\\')));
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+FB_TARGET_AVX2 std::size_t find_json_escape_avx2(const char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 32;
+  if (size < BLOCK)
+  {
+    return find_json_escape_sse2(data, size);
+  }
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    if (std::uint32_t mask = json_escape_mask_avx2(data + i))
+    {
+      return i + trailing_zeros(mask);
+    }
+  }
+
+  // Overlapping last block: the bytes before i are known not to match
+  if (i < size)
+  {
+    if (std::uint32_t mask = json_escape_mask_avx2(data + size - BLOCK))
+    {
+      return size - BLOCK + trailing_zeros(mask);
+    }
+  }
+  return size;
+}
+
+FB_TARGET_AVX2 bool is_ascii_avx2(const char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 32;
+  __m256i bits  = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 4 * BLOCK <= size; i += 4 * BLOCK)
+  {
+    const __m256i* blocks = reinterpret_cast<const __m256i*>(data + i);
+    bits = _mm256_or_si256(
+        bits,
+        _mm256_or_si256(_mm256_or_si256(_mm256_loadu_si256(blocks), _mm256_loadu_si256(blocks + 1)),
+                        _mm256_or_si256(_mm256_loadu_si256(blocks + 2), _mm256_loadu_si256(blocks + 3))));
+  }
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    bits = _mm256_or_si256(bits, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+  }
+  return _mm256_movemask_epi8(bits) == 0 && is_ascii_sse2(data + i, size - i);
+}
+
+FB_TARGET_AVX2 void replace_avx2(char* data, std::size_t size, char from, char to)
+{
+  constexpr std::size_t BLOCK = 32;
+  const __m256i match       = _mm256_set1_epi8(from);
+  const __m256i replacement = _mm256_set1_epi8(to);
+  std::size_t i             = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m256i* block_data = reinterpret_cast<__m256i*>(data + i);
+    __m256i block      = _mm256_loadu_si256(block_data);
+    __m256i hits       = _mm256_cmpeq_epi8(block, match);
+    _mm256_storeu_si256(block_data, _mm256_blendv_epi8(block, replacement, hits));
+  }
+  replace_sse2(data + i, size - i, from, to);
+}
+
+/// @brief Running state of is_valid_utf8_avx2()
+struct utf8_state_avx2
+{
+  __m256i error;
+  __m256i previous;   ///< Previous block
+  __m256i incomplete; ///< Lead bytes at the end of the previous block
+};
+
+/// Bytes of @p input shifted N places later, the gap filled from @p previous
+template<int N>
+FB_TARGET_AVX2 __m256i shift_in_avx2(__m256i input, __m256i previous)
+{
+  return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+}
+
+FB_TARGET_AVX2 __m256i lookup_nibble_avx2(const std::uint8_t* table, __m256i nibbles)
+{
+  __m256i entries = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+  return _mm256_shuffle_epi8(entries, nibbles);
+}
+
+FB_TARGET_AVX2 void check_utf8_block_avx2(__m256i input, utf8_state_avx2& state)
+{
+  if (_mm256_movemask_epi8(input) == 0)
+  {
+    // ASCII: only a sequence left open by the previous block can fail
+    state.error      = _mm256_or_si256(state.error, state.incomplete);
+    state.previous   = input;
+    state.incomplete = _mm256_setzero_si256();
+    return;
+  }
+
+  const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+  __m256i prev1 = shift_in_avx2<1>(input, state.previous);
+  __m256i special = _mm256_and_si256(
+      _mm256_and_si256(
+          lookup_nibble_avx2(BYTE_1_HIGH, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)),
+          lookup_nibble_avx2(BYTE_1_LOW, _mm256_and_si256(prev1, low_nibble))),
+      lookup_nibble_avx2(BYTE_2_HIGH, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)));
+
+  // Third and fourth bytes of 3- and 4-byte sequences must be continuations
+  __m256i third  = _mm256_subs_epu8(shift_in_avx2<2>(input, state.previous), _mm256_set1_epi8(0xE0 - 0x80));
+  __m256i fourth = _mm256_subs_epu8(shift_in_avx2<3>(input, state.previous), _mm256_set1_epi8(0xF0 - 0x80));
+  __m256i must_continue =
+      _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+  state.error = _mm256_or_si256(state.error, _mm256_xor_si256(must_continue, special));
+
+  // A lead byte in the last three positions needs bytes of the next block
+  const __m256i max_complete = _mm256_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+  state.incomplete = _mm256_subs_epu8(input, max_complete);
+  state.previous   = input;
+}
+
+FB_TARGET_AVX2 bool is_valid_utf8_avx2(const char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 32;
+  utf8_state_avx2 state{_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    check_utf8_block_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), state);
+  }
+  if (i < size)
+  {
+    // Zero padding is ASCII, so a truncated sequence shows up as an error
+    alignas(32) char tail[BLOCK] = {};
+    std::memcpy(tail, data + i, size - i);
+    check_utf8_block_avx2(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)), state);
+  }
+
+  __m256i error = _mm256_or_si256(state.error, state.incomplete);
+  return _mm256_testz_si256(error, error) != 0;
+}
+
+/// Bytes of @p block in [first, first + 26), as 0xFF
+FB_TARGET_AVX2 __m256i letters_avx2(__m256i block, char first)
+{
+  // Shift the range down to the bottom of the signed bytes
+  __m256i shifted = _mm256_add_epi8(block, _mm256_set1_epi8(static_cast<char>(-128 - first)));
+  return _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+}
+
+template<case_op Op>
+FB_TARGET_AVX2 __m256i convert_case_avx2(__m256i block)
+{
+  __m256i letters = Op == case_op::lower   ? letters_avx2(block, 'A')
+                    : Op == case_op::upper ? letters_avx2(block, 'a')
+                                           : letters_avx2(_mm256_or_si256(block, _mm256_set1_epi8(0x20)), 'a');
+  return _mm256_xor_si256(block, _mm256_and_si256(letters, _mm256_set1_epi8(0x20)));
+}
+
+template<case_op Op>
+FB_TARGET_AVX2 void convert_case_avx2(char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 32;
+  std::size_t i               = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m256i* block_data = reinterpret_cast<__m256i*>(data + i);
+    _mm256_storeu_si256(block_data, convert_case_avx2<Op>(_mm256_loadu_si256(block_data)));
+  }
+  convert_case_sse2<Op>(data + i, size - i);
+}
+
+FB_TARGET_AVX2 bool equals_ignore_case_avx2(const char* a, const char* b, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 32;
+  std::size_t i               = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    __m256i lower_a =
+        convert_case_avx2<case_op::lower>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+    __m256i lower_b =
+        convert_case_avx2<case_op::lower>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+    if (static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lower_a, lower_b))) != 0xFFFFFFFFu)
+    {
+      return false;
+    }
+  }
+  return equals_ignore_case_sse2(a + i, b + i, size - i);
+}
+
+FB_TARGET_AVX2 block_masks classify_avx2(const char* block)
+{
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i tab   = _mm256_set1_epi8('\t');
+  const __m256i span  = _mm256_set1_epi8('\r' - '\t');
+  const __m256i lf    = _mm256_set1_epi8('\n');
+  const __m256i cr    = _mm256_set1_epi8('\r');
+
+  block_masks masks{};
+  for (unsigned k = 0; k < MASK_BLOCK / 32; ++k)
+  {
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * k));
+    __m256i controls =
+        _mm256_cmpeq_epi8(_mm256_subs_epu8(_mm256_sub_epi8(bytes, tab), span), _mm256_setzero_si256());
+    __m256i blank = _mm256_or_si256(controls, _mm256_cmpeq_epi8(bytes, space));
+    auto    shift = 32 * k;
+    masks.whitespace |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(blank))} << shift;
+    masks.line_feed |=
+        std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, lf)))} << shift;
+    masks.carriage_return |=
+        std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, cr)))} << shift;
+  }
+  return masks;
+}
+
+constexpr kernels AVX2_KERNELS = {isa::avx2,
+                                  find_any_avx2,
+                                  find_avx2,
+                                  find_json_escape_avx2,
+                                  is_ascii_avx2,
+                                  replace_avx2,
+                                  is_valid_utf8_avx2,
+                                  convert_case_avx2<case_op::lower>,
+                                  convert_case_avx2<case_op::upper>,
+                                  convert_case_avx2<case_op::swap>,
+                                  equals_ignore_case_avx2,
+                                  classify_avx2};
+
+#endif // FB_SIMD_AVX2
+
+// ============================================================================
+// NEON Kernels
+// ============================================================================
+
+#if FB_SIMD_NEON
+
+/// 4 bits per byte of @p hits: nonzero nibbles mark matching bytes
+std::uint64_t nibble_mask(uint8x16_t hits) noexcept
+{
+  uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(hits), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+template<std::size_t N>
+std::size_t find_any_neon_n(const char* data, std::size_t size, const char* set)
+{
+  constexpr std::size_t BLOCK = 16;
+  if (size < BLOCK)
+  {
+    return find_any_scalar(data, size, set, N);
+  }
+
+  uint8x16_t needles[N];
+  for (std::size_t k = 0; k < N; ++k)
+  {
+    needles[k] = vdupq_n_u8(static_cast<std::uint8_t>(set[k]));
+  }
+
+  auto scan = [&needles](const char* block_data) {
+    uint8x16_t block = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block_data));
+    uint8x16_t hits  = vceqq_u8(block, needles[0]);
+    for (std::size_t k = 1; k < N; ++k)
+    {
+      hits = vorrq_u8(hits, vceqq_u8(block, needles[k]));
+    }
+    return nibble_mask(hits);
+  };
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    if (std::uint64_t mask = scan(data + i))
+    {
+      return i + trailing_zeros(mask) / 4;
+    }
+  }
+
+  // Overlapping last block: the bytes before i are known not to match
+  if (i < size)
+  {
+    if (std::uint64_t mask = scan(data + size - BLOCK))
+    {
+      return size - BLOCK + trailing_zeros(mask) / 4;
+    }
+  }
+  return size;
+}
+
+std::size_t find_any_neon(const char* data, std::size_t size, const char* set, std::size_t set_size)
+{
+  switch (set_size)
+  {
+  case 1: return find_byte(data, size, set[0]);
+  case 2: return find_any_neon_n<2>(data, size, set);
+  case 3: return find_any_neon_n<3>(data, size, set);
+  case 4: return find_any_neon_n<4>(data, size, set);
+  case 5: return find_any_neon_n<5>(data, size, set);
+  case 6: return find_any_neon_n<6>(data, size, set);
+  case 7: return find_any_neon_n<7>(data, size, set);
+  case 8: return find_any_neon_n<8>(data, size, set);
+  default: return find_any_scalar(data, size, set, set_size);
+  }
+}
+
+std::size_t find_neon(const char* data, std::size_t size, const char* needle, std::size_t needle_size)
+{
+  constexpr std::size_t BLOCK = 16;
+  const std::size_t candidates = size - needle_size + 1;
+  if (candidates < BLOCK)
+  {
+    return find_scalar(data, size, needle, needle_size);
+  }
+
+  const uint8x16_t first = vdupq_n_u8(static_cast<std::uint8_t>(needle[0]));
+  const uint8x16_t last  = vdupq_n_u8(static_cast<std::uint8_t>(needle[needle_size - 1]));
+
+  auto scan = [&](std::size_t i) {
+    uint8x16_t block_first = vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i));
+    uint8x16_t block_last  = vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i + needle_size - 1));
+    std::uint64_t mask = nibble_mask(vandq_u8(vceqq_u8(block_first, first), vceqq_u8(block_last, last)));
+    while (mask != 0)
+    {
+      std::size_t offset = trailing_zeros(mask) / 4;
+      if (matches_inner(data + i + offset, needle, needle_size))
+      {
+        return i + offset;
+      }
+      mask &= ~(std::uint64_t{0xF} << (offset * 4));
+    }
+    return size;
+  };
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= candidates; i += BLOCK)
+  {
+    if (std::size_t found = scan(i); found != size)
+    {
+      return found;
+    }
+  }
+
+  // Overlapping last block: the candidates before i are known not to match
+  return i < candidates ? scan(candidates - BLOCK) : size;
+}
+
+std::uint64_t json_escape_mask_neon(const char* block_data) noexcept
+{
+  const uint8x16_t block = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block_data));
+  uint8x16_t hits        = vcltq_u8(block, vdupq_n_u8(0x20));
+  hits                   = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8('"')));
+  hits                   = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8('\\')));
+  return nibble_mask(hits);
+}
+
+std::size_t find_json_escape_neon(const char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  if (size < BLOCK)
+  {
+    return find_json_escape_scalar(data, size);
+  }
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    if (std::uint64_t mask = json_escape_mask_neon(data + i))
+    {
+      return i + trailing_zeros(mask) / 4;
+    }
+  }
+
+  // Overlapping last block: the bytes before i are known not to match
+  if (i < size)
+  {
+    if (std::uint64_t mask = json_escape_mask_neon(data + size - BLOCK))
+    {
+      return size - BLOCK + trailing_zeros(mask) / 4;
+    }
+  }
+  return size;
+}
+
+bool is_ascii_neon(const char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  uint8x16_t bits = vdupq_n_u8(0);
+  std::size_t i   = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    bits = vorrq_u8(bits, vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i)));
+  }
+  return vmaxvq_u8(bits) < 0x80 && is_ascii_scalar(data + i, size - i);
+}
+
+void replace_neon(char* data, std::size_t size, char from, char to)
+{
+  constexpr std::size_t BLOCK = 16;
+  const uint8x16_t match       = vdupq_n_u8(static_cast<std::uint8_t>(from));
+  const uint8x16_t replacement = vdupq_n_u8(static_cast<std::uint8_t>(to));
+  std::size_t i                = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    std::uint8_t* block_data = reinterpret_cast<std::uint8_t*>(data + i);
+    uint8x16_t block         = vld1q_u8(block_data);
+    vst1q_u8(block_data, vbslq_u8(vceqq_u8(block, match), replacement, block));
+  }
+  replace_scalar(data + i, size - i, from, to);
+}
+
+/// @brief Running state of is_valid_utf8_neon()
+struct utf8_state_neon
+{
+  uint8x16_t error;
+  uint8x16_t previous;   ///< Previous block
+  uint8x16_t incomplete; ///< Lead bytes at the end of the previous block
+};
+
+void check_utf8_block_neon(uint8x16_t input, utf8_state_neon& state) noexcept
+{
+  if (vmaxvq_u8(input) < 0x80)
+  {
+    // ASCII: only a sequence left open by the previous block can fail
+    state.error      = vorrq_u8(state.error, state.incomplete);
+    state.previous   = input;
+    state.incomplete = vdupq_n_u8(0);
+    return;
+  }
+
+  const uint8x16_t low_nibble = vdupq_n_u8(0x0F);
+  uint8x16_t prev1   = vextq_u8(state.previous, input, 15);
+  uint8x16_t special = vandq_u8(vandq_u8(vqtbl1q_u8(vld1q_u8(BYTE_1_HIGH), vshrq_n_u8(prev1, 4)),
+                                         vqtbl1q_u8(vld1q_u8(BYTE_1_LOW), vandq_u8(prev1, low_nibble))),
+                                vqtbl1q_u8(vld1q_u8(BYTE_2_HIGH), vshrq_n_u8(input, 4)));
+
+  // Third and fourth bytes of 3- and 4-byte sequences must be continuations
+  uint8x16_t third  = vqsubq_u8(vextq_u8(state.previous, input, 14), vdupq_n_u8(0xE0 - 0x80));
+  uint8x16_t fourth = vqsubq_u8(vextq_u8(state.previous, input, 13), vdupq_n_u8(0xF0 - 0x80));
+  uint8x16_t must_continue = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+  state.error = vorrq_u8(state.error, veorq_u8(must_continue, special));
+
+  // A lead byte in the last three positions needs bytes of the next block
+  alignas(16) static constexpr std::uint8_t MAX_COMPLETE[16] = {
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+  state.incomplete = vqsubq_u8(input, vld1q_u8(MAX_COMPLETE));
+  state.previous   = input;
+}
+
+bool is_valid_utf8_neon(const char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  utf8_state_neon state{vdupq_n_u8(0), vdupq_n_u8(0), vdupq_n_u8(0)};
+
+  std::size_t i = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    check_utf8_block_neon(vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i)), state);
+  }
+  if (i < size)
+  {
+    // Zero padding is ASCII, so a truncated sequence shows up as an error
+    std::uint8_t tail[BLOCK] = {};
+    std::memcpy(tail, data + i, size - i);
+    check_utf8_block_neon(vld1q_u8(tail), state);
+  }
+
+  return vmaxvq_u8(vorrq_u8(state.error, state.incomplete)) == 0;
+}
+
+template<case_op Op>
+uint8x16_t convert_case_neon(uint8x16_t block) noexcept
+{
+  uint8x16_t letters = Op == case_op::lower ? vsubq_u8(block, vdupq_n_u8('A'))
+                       : Op == case_op::upper
+                           ? vsubq_u8(block, vdupq_n_u8('a'))
+                           : vsubq_u8(vorrq_u8(block, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  letters = vcltq_u8(letters, vdupq_n_u8(26));
+  return veorq_u8(block, vandq_u8(letters, vdupq_n_u8(0x20)));
+}
+
+template<case_op Op>
+void convert_case_neon(char* data, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  std::size_t i               = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    std::uint8_t* block_data = reinterpret_cast<std::uint8_t*>(data + i);
+    vst1q_u8(block_data, convert_case_neon<Op>(vld1q_u8(block_data)));
+  }
+  convert_case_scalar<Op>(data + i, size - i);
+}
+
+bool equals_ignore_case_neon(const char* a, const char* b, std::size_t size)
+{
+  constexpr std::size_t BLOCK = 16;
+  std::size_t i               = 0;
+  for (; i + BLOCK <= size; i += BLOCK)
+  {
+    uint8x16_t lower_a = convert_case_neon<case_op::lower>(vld1q_u8(reinterpret_cast<const std::uint8_t*>(a + i)));
+    uint8x16_t lower_b = convert_case_neon<case_op::lower>(vld1q_u8(reinterpret_cast<const std::uint8_t*>(b + i)));
+    if (vminvq_u8(vceqq_u8(lower_a, lower_b)) == 0)
+    {
+      return false;
+    }
+  }
+  return equals_ignore_case_scalar(a + i, b + i, size - i);
+}
+
+alignas(16) constexpr std::uint8_t BIT_WEIGHTS[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+
+/// One bit per byte of four comparison results, @p q0 in the low bits
+std::uint64_t bitmask_neon(uint8x16_t q0, uint8x16_t q1, uint8x16_t q2, uint8x16_t q3) noexcept
+{
+  // Pairwise adds of the weighted bytes gather each 8 bytes into one
+  const uint8x16_t weights = vld1q_u8(BIT_WEIGHTS);
+  uint8x16_t       sum01   = vpaddq_u8(vandq_u8(q0, weights), vandq_u8(q1, weights));
+  uint8x16_t       sum23   = vpaddq_u8(vandq_u8(q2, weights), vandq_u8(q3, weights));
+  uint8x16_t       sum     = vpaddq_u8(sum01, sum23);
+  sum                      = vpaddq_u8(sum, sum);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+
+block_masks classify_neon(const char* block)
+{
+  uint8x16_t blank[4];
+  uint8x16_t lf[4];
+  uint8x16_t cr[4];
+  for (unsigned k = 0; k < 4; ++k)
+  {
+    uint8x16_t bytes    = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block + 16 * k));
+    uint8x16_t controls = vcleq_u8(vsubq_u8(bytes, vdupq_n_u8('\t')), vdupq_n_u8('\r' - '\t'));
+    blank[k]            = vorrq_u8(controls, vceqq_u8(bytes, vdupq_n_u8(' ')));
+    lf[k]               = vceqq_u8(bytes, vdupq_n_u8('\n'));
+    cr[k]               = vceqq_u8(bytes, vdupq_n_u8('\r'));
+  }
+  return {bitmask_neon(blank[0], blank[1], blank[2], blank[3]),
+          bitmask_neon(lf[0], lf[1], lf[2], lf[3]),
+          bitmask_neon(cr[0], cr[1], cr[2], cr[3])};
+}
+
+constexpr kernels NEON_KERNELS = {isa::neon,
+                                  find_any_neon,
+                                  find_neon,
+                                  find_json_escape_neon,
+                                  is_ascii_neon,
+                                  replace_neon,
+                                  is_valid_utf8_neon,
+                                  convert_case_neon<case_op::lower>,
+                                  convert_case_neon<case_op::upper>,
+                                  convert_case_neon<case_op::swap>,
+                                  equals_ignore_case_neon,
+                                  classify_neon};
+
+#endif // FB_SIMD_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+/// @return Kernels for @p target, nullptr if this CPU or build lacks them
+const kernels* kernels_for(isa target) noexcept
+{
+  switch (target)
+  {
+  case isa::scalar:
+    return &SCALAR_KERNELS;
+  case isa::sse2:
+#if FB_SIMD_SSE2
+    return &SSE2_KERNELS;
+#else
+    return nullptr;
+#endif
+  case isa::avx2:
+#if FB_SIMD_AVX2
+    return __builtin_cpu_supports("avx2") ? &AVX2_KERNELS : nullptr;
+#else
+    return nullptr;
+#endif
+  case isa::neon:
+#if FB_SIMD_NEON
+    return &NEON_KERNELS;
+#else
+    return nullptr;
+#endif
+  }
+  return nullptr;
+}
+
+const kernels* best_kernels() noexcept
+{
+  for (isa target : {isa::avx2, isa::neon, isa::sse2})
+  {
+    if (const kernels* found = kernels_for(target))
+    {
+      return found;
+    }
+  }
+  return &SCALAR_KERNELS;
+}
+
+std::atomic<const kernels*> g_active{nullptr};
+
+const kernels& active() noexcept
+{
+  const kernels* current = g_active.load(std::memory_order_acquire);
+  if (current == nullptr)
+  {
+    // Racing first calls all store the same table
+    current = best_kernels();
+    g_active.store(current, std::memory_order_release);
+  }
+  return *current;
+}
+
+// ============================================================================
+// Block Scans
+// ============================================================================
+
+/// Bits 0 to size - 1
+std::uint64_t low_bits(std::size_t size) noexcept
+{
+  return size >= MASK_BLOCK ? ~std::uint64_t{0} : (std::uint64_t{1} << size) - 1;
+}
+
+block_masks classify_with(const kernels& active_kernels, const char* data, std::size_t size) noexcept
+{
+  if (size >= MASK_BLOCK)
+  {
+    return active_kernels.classify(data);
+  }
+  char padded[MASK_BLOCK];
+  std::memset(padded, ' ', sizeof(padded));
+  if (size != 0)
+  {
+    std::memcpy(padded, data, size);
+  }
+  return active_kernels.classify(padded);
+}
+
+/// First index from @p pos whose bit is set in select(masks, valid_bits)
+template<typename Select>
+std::size_t find_in_blocks(std::string_view str, std::size_t pos, Select select) noexcept
+{
+  const kernels& active_kernels = active();
+  for (std::size_t i = pos; i < str.size(); i += MASK_BLOCK)
+  {
+    const std::size_t   size = std::min(MASK_BLOCK, str.size() - i);
+    const std::uint64_t hits = select(classify_with(active_kernels, str.data() + i, size), low_bits(size));
+    if (hits != 0)
+    {
+      return i + trailing_zeros(hits);
+    }
+  }
+  return std::string_view::npos;
+}
+
+} // namespace
+
+// ============================================================================
+// Public Interface
+// ============================================================================
+
+std::size_t find_any(std::string_view str, std::string_view set, std::size_t pos) noexcept
+{
+  if (pos >= str.size() || set.empty())
+  {
+    return std::string_view::npos;
+  }
+  std::size_t offset = active().find_any(str.data() + pos, str.size() - pos, set.data(), set.size());
+  return pos + offset < str.size() ? pos + offset : std::string_view::npos;
+}
+
+std::size_t find(std::string_view str, std::string_view needle, std::size_t pos) noexcept
+{
+  if (pos > str.size() || needle.size() > str.size() - pos)
+  {
+    return std::string_view::npos;
+  }
+  if (needle.size() < 2)
+  {
+    return needle.empty() ? pos : str.find(needle[0], pos);
+  }
+  std::size_t offset = active().find(str.data() + pos, str.size() - pos, needle.data(), needle.size());
+  return offset < str.size() - pos ? pos + offset : std::string_view::npos;
+}
+
+std::size_t find_json_escape(std::string_view str, std::size_t pos) noexcept
+{
+  if (pos >= str.size())
+  {
+    return std::string_view::npos;
+  }
+  std::size_t offset = active().find_json_escape(str.data() + pos, str.size() - pos);
+  return pos + offset < str.size() ? pos + offset : std::string_view::npos;
+}
+
+block_masks classify(const char* data, std::size_t size) noexcept
+{
+  return classify_with(active(), data, size);
+}
+
+std::size_t find_whitespace(std::string_view str, std::size_t pos) noexcept
+{
+  return find_in_blocks(str, pos, [](const block_masks& masks, std::uint64_t valid) { return masks.whitespace & valid; });
+}
+
+std::size_t find_non_whitespace(std::string_view str, std::size_t pos) noexcept
+{
+  return find_in_blocks(str, pos, [](const block_masks& masks, std::uint64_t) { return ~masks.whitespace; });
+}
+
+std::size_t count_words(std::string_view str) noexcept
+{
+  // A word starts at each non-blank byte that follows a blank one;
+  // before_block holds bit 0 when the byte before the block is blank
+  const kernels& active_kernels = active();
+  std::size_t    count          = 0;
+  std::uint64_t  before_block   = 1;
+  for (std::size_t i = 0; i < str.size(); i += MASK_BLOCK)
+  {
+    const std::uint64_t blank = classify_with(active_kernels, str.data() + i, str.size() - i).whitespace;
+    count += popcount(~blank & ((blank << 1) | before_block));
+    before_block = blank >> 63;
+  }
+  return count;
+}
+
+std::size_t count_lines(std::string_view str) noexcept
+{
+  // Every \n and \r ends a line, except a \r followed by \n;
+  // cr_before_block holds bit 0 when the byte before the block is \r
+  const kernels& active_kernels  = active();
+  std::size_t    endings         = 0;
+  std::uint64_t  cr_before_block = 0;
+  for (std::size_t i = 0; i < str.size(); i += MASK_BLOCK)
+  {
+    const block_masks masks = classify_with(active_kernels, str.data() + i, str.size() - i);
+    const std::uint64_t cr_lf = masks.line_feed & ((masks.carriage_return << 1) | cr_before_block);
+    endings += popcount(masks.line_feed | masks.carriage_return) - popcount(cr_lf);
+    cr_before_block = masks.carriage_return >> 63;
+  }
+  const bool unterminated = !str.empty() && str.back() != '\n' && str.back() != '\r';
+  return endings + (unterminated ? 1 : 0);
+}
+
+bool is_ascii(std::string_view str) noexcept
+{
+  return active().is_ascii(str.data(), str.size());
+}
+
+bool is_valid_utf8(std::string_view str) noexcept
+{
+  return active().is_valid_utf8(str.data(), str.size());
+}
+
+void to_lower(char* data, std::size_t size) noexcept
+{
+  active().to_lower(data, size);
+}
+
+void to_upper(char* data, std::size_t size) noexcept
+{
+  active().to_upper(data, size);
+}
+
+void swap_case(char* data, std::size_t size) noexcept
+{
+  active().swap_case(data, size);
+}
+
+bool equals_ignore_case(std::string_view a, std::string_view b) noexcept
+{
+  return a.size() == b.size() && active().equals_ignore_case(a.data(), b.data(), a.size());
+}
+
+void replace(char* data, std::size_t size, char from, char to) noexcept
+{
+  if (from != to)
+  {
+    active().replace(data, size, from, to);
+  }
+}
+
+isa active_isa() noexcept
+{
+  return active().id;
+}
+
+bool select_isa(isa target) noexcept
+{
+  const kernels* selected = kernels_for(target);
+  if (selected == nullptr)
+  {
+    return false;
+  }
+  g_active.store(selected, std::memory_order_release);
+  return true;
+}
+
+const char* isa_name(isa target) noexcept
+{
+  switch (target)
+  {
+  case isa::scalar: return "scalar";
+  case isa::sse2: return "sse2";
+  case isa::avx2: return "avx2";
+  case isa::neon: return "neon";
+  }
+  return "unknown";
+}
+
+} // namespace simd
+} // namespace fb
@@ -0,0 +1,350 @@
+/// @file stream_readers.cpp
+/// @brief Implementation of the chunked stream readers
+
+#include <fb/stream_readers.h>
+#include <fb/simd_search.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fb
+{
+
+namespace
+{
+
+constexpr std::string_view LINE_ENDINGS = "\r\n";
+constexpr std::string_view WHITESPACE   = " \t\n\r\v\f";
+
+constexpr bool is_whitespace(char ch) noexcept
+{
+  return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' || ch == '\f';
+}
+
+std::size_t read_stream(void* context, char* buffer, std::size_t size)
+{
+  auto&           in  = *static_cast<std::istream*>(context);
+  std::streambuf* buf = in.rdbuf();
+
+  // sgetc() waits for the first byte; in_avail() then counts what the stream
+  // buffer holds without another blocking read
+  if (buf == nullptr || std::istream::traits_type::eq_int_type(buf->sgetc(), std::istream::traits_type::eof()))
+  {
+    in.setstate(std::ios::eofbit);
+    return 0;
+  }
+  const std::streamsize available = std::max<std::streamsize>(1, buf->in_avail());
+  const std::streamsize wanted    = std::min(available, static_cast<std::streamsize>(size));
+  return static_cast<std::size_t>(buf->sgetn(buffer, wanted));
+}
+
+std::size_t read_fd(void* context, char* buffer, std::size_t size)
+{
+  // The descriptor travels in the context pointer itself
+  const int fd = static_cast<int>(reinterpret_cast<std::intptr_t>(context));
+  for (;;)
+  {
+#if defined(_WIN32)
+    const int count = ::_read(fd, buffer, static_cast<unsigned>(std::min<std::size_t>(size, 1u << 30)));
+#else
+    const ssize_t count = ::read(fd, buffer, size);
+#endif
+    if (count >= 0)
+    {
+      return static_cast<std::size_t>(count);
+    }
+    if (errno != EINTR)
+    {
+      throw std::system_error(errno, std::generic_category(), "byte_source: read failed");
+    }
+  }
+}
+
+} // namespace
+
+// ============================================================================
+// byte_source
+// ============================================================================
+
+byte_source::byte_source(std::istream& in) noexcept
+    : m_context(&in)
+    , m_read(&read_stream)
+{
+}
+
+byte_source byte_source::from_fd(int fd) noexcept
+{
+  return byte_source(reinterpret_cast<void*>(static_cast<std::intptr_t>(fd)), &read_fd);
+}
+
+// ============================================================================
+// read_buffer
+// ============================================================================
+
+namespace detail
+{
+
+read_buffer::read_buffer(byte_source source, std::size_t chunk_size)
+    : m_source(source)
+    , m_data(std::make_unique<char[]>(std::max<std::size_t>(chunk_size, 1)))
+    , m_capacity(std::max<std::size_t>(chunk_size, 1))
+{
+}
+
+bool read_buffer::fill()
+{
+  if (m_eof)
+  {
+    return false;
+  }
+
+  // Keep only the unread bytes, at the front; grow when they fill the buffer
+  const std::size_t unread = m_end - m_begin;
+  if (unread == m_capacity)
+  {
+    auto grown = std::make_unique<char[]>(m_capacity * 2);
+    std::memcpy(grown.get(), m_data.get() + m_begin, unread);
+    m_data = std::move(grown);
+    m_capacity *= 2;
+  }
+  else if (m_begin != 0)
+  {
+    std::memmove(m_data.get(), m_data.get() + m_begin, unread);
+  }
+  m_begin = 0;
+  m_end   = unread;
+
+  const std::size_t count = m_source.read(m_data.get() + m_end, m_capacity - m_end);
+  if (count == 0)
+  {
+    m_eof = true;
+    return false;
+  }
+  m_end += count;
+  return true;
+}
+
+} // namespace detail
+
+// ============================================================================
+// line_reader
+// ============================================================================
+
+line_reader::line_reader(byte_source source, std::size_t chunk_size)
+    : m_buffer(source, chunk_size)
+{
+}
+
+bool line_reader::has_next()
+{
+  if (!m_ready)
+  {
+    m_ready = advance();
+  }
+  return m_ready;
+}
+
+std::string_view line_reader::next()
+{
+  if (!has_next())
+  {
+    return {};
+  }
+  m_ready = false;
+  return m_current;
+}
+
+bool line_reader::advance()
+{
+  for (;;)
+  {
+    const std::string_view data = m_buffer.data();
+
+    // A \r that ended the previous line may be the first half of a \r\n
+    if (m_skip_lf)
+    {
+      if (data.empty())
+      {
+        if (!m_buffer.fill())
+        {
+          return false;
+        }
+        continue;
+      }
+      m_skip_lf = false;
+      if (data[0] == '\n')
+      {
+        m_buffer.consume(1);
+        continue;
+      }
+    }
+
+    const std::size_t end = simd::find_any(data, LINE_ENDINGS, m_scanned);
+    if (end != std::string_view::npos)
+    {
+      m_current = data.substr(0, end);
+      m_scanned = 0;
+      if (data[end] == '\r' && end + 1 == data.size())
+      {
+        m_skip_lf = true;
+      }
+      m_buffer.consume(end + ((data[end] == '\r' && end + 1 < data.size() && data[end + 1] == '\n') ? 2 : 1));
+      return true;
+    }
+
+    m_scanned = data.size();
+    if (!m_buffer.fill())
+    {
+      // Last line, without a line ending; fill() moved it to the front
+      m_scanned = 0;
+      m_current = m_buffer.data();
+      m_buffer.consume(m_current.size());
+      return !m_current.empty();
+    }
+  }
+}
+
+// ============================================================================
+// word_reader
+// ============================================================================
+
+word_reader::word_reader(byte_source source, std::size_t chunk_size)
+    : m_buffer(source, chunk_size)
+{
+}
+
+bool word_reader::has_next()
+{
+  if (!m_ready)
+  {
+    m_ready = advance();
+  }
+  return m_ready;
+}
+
+std::string_view word_reader::next()
+{
+  if (!has_next())
+  {
+    return {};
+  }
+  m_ready = false;
+  return m_current;
+}
+
+bool word_reader::advance()
+{
+  for (;;)
+  {
+    std::string_view data = m_buffer.data();
+    if (m_scanned == 0)
+    {
+      std::size_t skip = 0;
+      while (skip < data.size() && is_whitespace(data[skip]))
+      {
+        ++skip;
+      }
+      m_buffer.consume(skip);
+      data.remove_prefix(skip);
+      if (data.empty())
+      {
+        if (!m_buffer.fill())
+        {
+          return false;
+        }
+        continue;
+      }
+      m_scanned = 1;
+    }
+
+    const std::size_t end = simd::find_any(data, WHITESPACE, m_scanned);
+    if (end != std::string_view::npos)
+    {
+      m_current = data.substr(0, end);
+      m_scanned = 0;
+      m_buffer.consume(end + 1);
+      return true;
+    }
+
+    m_scanned = data.size();
+    if (!m_buffer.fill())
+    {
+      m_current = m_buffer.data();
+      m_scanned = 0;
+      m_buffer.consume(m_current.size());
+      return true;
+    }
+  }
+}
+
+// ============================================================================
+// token_reader
+// ============================================================================
+
+token_reader::token_reader(byte_source source, std::string_view delimiters, std::size_t chunk_size)
+    : m_buffer(source, chunk_size)
+    , m_delimiters(delimiters)
+{
+}
+
+bool token_reader::has_next()
+{
+  if (!m_ready)
+  {
+    m_ready = advance();
+  }
+  return m_ready;
+}
+
+std::string_view token_reader::next()
+{
+  if (!has_next())
+  {
+    return {};
+  }
+  m_ready = false;
+  return m_current;
+}
+
+bool token_reader::advance()
+{
+  if (m_finished)
+  {
+    return false;
+  }
+  for (;;)
+  {
+    const std::string_view data = m_buffer.data();
+    const std::size_t      end  = simd::find_any(data, m_delimiters, m_scanned);
+    if (end != std::string_view::npos)
+    {
+      m_current   = data.substr(0, end);
+      m_scanned   = 0;
+      m_delimited = true;
+      m_buffer.consume(end + 1);
+      return true;
+    }
+
+    m_scanned = data.size();
+    if (!m_buffer.fill())
+    {
+      // The last token, empty after a final delimiter; none for empty input
+      m_finished = true;
+      m_current  = m_buffer.data();
+      m_buffer.consume(m_current.size());
+      return !m_current.empty() || m_delimited;
+    }
+  }
+}
+
+} // namespace fb
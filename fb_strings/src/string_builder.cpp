@@ -2,9 +2,12 @@
 /// @brief Implementation of the string_builder class
 
 #include "fb/string_builder.h"
+#include "fb/encoding.h"
+#include "fb/simd_search.h"
+
+#include <fb/detail/number_chars.h>
 
 #include <charconv>
-#include <cstdio>
 #include <limits>
 
 namespace fb
@@ -14,11 +17,24 @@ namespace fb
 // Constructors
 // ============================================================================
 
+/**
+ * @brief Empty builder allocating with @p alloc
+ * @param alloc Allocator of the buffer
+ */
+template <typename Allocator>
+basic_string_builder<Allocator>::basic_string_builder(const Allocator& alloc) :
+  m_buffer(alloc)
+{
+}
+
 /**
  * @brief Constructor with initial capacity
  * @param initial_capacity Number of bytes to pre-allocate
+ * @param alloc Allocator of the buffer
  */
-string_builder::string_builder(std::size_t initial_capacity)
+template <typename Allocator>
+basic_string_builder<Allocator>::basic_string_builder(std::size_t initial_capacity, const Allocator& alloc) :
+  m_buffer(alloc)
 {
   m_buffer.reserve(initial_capacity);
 }
@@ -26,9 +42,11 @@ string_builder::string_builder(std::size_t initial_capacity)
 /**
  * @brief Constructor with initial content
  * @param initial Initial string content
+ * @param alloc Allocator of the buffer
  */
-string_builder::string_builder(std::string_view initial) :
-  m_buffer(initial)
+template <typename Allocator>
+basic_string_builder<Allocator>::basic_string_builder(std::string_view initial, const Allocator& alloc) :
+  m_buffer(initial, alloc)
 {
 }
 
@@ -42,7 +60,8 @@ string_builder::string_builder(std::string_view initial) :
  * @param str String to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append(std::string_view str)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append(std::string_view str)
 {
   m_buffer.append(str);
   return *this;
@@ -54,7 +73,8 @@ string_builder& string_builder::append(std::string_view str)
  * @param str C-string to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append(const char* str)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append(const char* str)
 {
   if (str != nullptr)
   {
@@ -69,7 +89,8 @@ string_builder& string_builder::append(const char* str)
  * @param c Character to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append(char c)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append(char c)
 {
   m_buffer.push_back(c);
   return *this;
@@ -81,7 +102,8 @@ string_builder& string_builder::append(char c)
  * @param count Number of times to repeat
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append(char c, std::size_t count)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append(char c, std::size_t count)
 {
   m_buffer.append(count, c);
   return *this;
@@ -92,7 +114,8 @@ string_builder& string_builder::append(char c, std::size_t count)
  * @param str String to append (default: empty string)
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append_line(std::string_view str)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_line(std::string_view str)
 {
   m_buffer.append(str);
   m_buffer.push_back('\n');
@@ -109,7 +132,8 @@ string_builder& string_builder::append_line(std::string_view str)
  * @param value Integer value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append_int(std::int32_t value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_int(std::int32_t value)
 {
   // Use std::to_chars for efficient conversion
   char buffer[12]; // -2147483648 is 11 chars + null
@@ -126,7 +150,8 @@ string_builder& string_builder::append_int(std::int32_t value)
  * @param value value Integer value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append_int(std::int64_t value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_int(std::int64_t value)
 {
   char buffer[21]; // -9223372036854775808 is 20 chars + null
   auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
@@ -142,7 +167,8 @@ string_builder& string_builder::append_int(std::int64_t value)
  * @param value Integer value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append_uint(std::uint32_t value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_uint(std::uint32_t value)
 {
   char buffer[11]; // 4294967295 is 10 chars + null
   auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
@@ -158,7 +184,8 @@ string_builder& string_builder::append_uint(std::uint32_t value)
  * @param value Integer value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append_uint(std::uint64_t value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_uint(std::uint64_t value)
 {
   char buffer[21]; // 18446744073709551615 is 20 chars + null
   auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
@@ -175,16 +202,27 @@ string_builder& string_builder::append_uint(std::uint64_t value)
  * @param precision Number of decimal places (default: 6)
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append_double(double value, int precision)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_double(double value, int precision)
 {
-  // Use snprintf for floating point formatting with precision control
-  // Maximum double representation: -1.7976931348623157e+308 plus precision digits
+  // std::to_chars in fixed notation; values past 1e40 or so with long
+  // precisions do not fit the stack buffer and are converted in place
   char buffer[64];
-  int  len = std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
-  if (len > 0 && static_cast<std::size_t>(len) < sizeof(buffer))
+  char* end = detail::float_to_chars(
+      buffer, buffer + sizeof(buffer), value, detail::float_notation::fixed, precision);
+  if (end != nullptr)
   {
-    m_buffer.append(buffer, static_cast<std::size_t>(len));
+    m_buffer.append(buffer, static_cast<std::size_t>(end - buffer));
+    return *this;
   }
+
+  const std::size_t old_size = m_buffer.size();
+  m_buffer.resize(old_size + detail::FIXED_FLOAT_CHARS +
+                  static_cast<std::size_t>(precision < 0 ? 6 : precision));
+  char* first = &m_buffer[old_size];
+  end         = detail::float_to_chars(
+      first, first + (m_buffer.size() - old_size), value, detail::float_notation::fixed, precision);
+  m_buffer.resize(end != nullptr ? old_size + static_cast<std::size_t>(end - first) : old_size);
   return *this;
 }
 
@@ -193,12 +231,43 @@ string_builder& string_builder::append_double(double value, int precision)
  * @param value Boolean value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::append_bool(bool value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_bool(bool value)
 {
   m_buffer.append(value ? "true" : "false");
   return *this;
 }
 
+/**
+ * @brief Append a string escaped for a JSON string value
+ *
+ * Runs without special characters are appended whole, so no temporary
+ * escaped copy is built.
+ *
+ * @param str Text to escape; no quotes are added
+ * @return Reference to this builder for chaining
+ */
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_json_escaped(std::string_view str)
+{
+  format_sink sink(&m_buffer, &append_to_buffer);
+  fb::append_json_escaped(sink, str);
+  return *this;
+}
+
+/**
+ * @brief Append a string with HTML special characters replaced by entities
+ * @param str Text to escape
+ * @return Reference to this builder for chaining
+ */
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::append_html_escaped(std::string_view str)
+{
+  format_sink sink(&m_buffer, &append_to_buffer);
+  fb::append_html_escaped(sink, str);
+  return *this;
+}
+
 // ============================================================================
 // Modification Operations
 // ============================================================================
@@ -209,7 +278,8 @@ string_builder& string_builder::append_bool(bool value)
  * @param str String to insert
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::insert(std::size_t pos, std::string_view str)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::insert(std::size_t pos, std::string_view str)
 {
   if (pos > m_buffer.size())
   {
@@ -225,7 +295,8 @@ string_builder& string_builder::insert(std::size_t pos, std::string_view str)
  * @param count Number of characters to remove (default: all remaining)
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::remove(std::size_t pos, std::size_t count)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::remove(std::size_t pos, std::size_t count)
 {
   if (pos < m_buffer.size())
   {
@@ -240,14 +311,15 @@ string_builder& string_builder::remove(std::size_t pos, std::size_t count)
  * @param to Replacement string
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::replace(std::string_view from, std::string_view to)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::replace(std::string_view from, std::string_view to)
 {
   if (from.empty())
   {
     return *this;
   }
 
-  std::size_t pos = m_buffer.find(from);
+  std::size_t pos = simd::find(m_buffer, from);
   if (pos != std::string::npos)
   {
     m_buffer.replace(pos, from.size(), to);
@@ -261,19 +333,33 @@ string_builder& string_builder::replace(std::string_view from, std::string_view
  * @param to Replacement string
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::replace_all(std::string_view from, std::string_view to)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::replace_all(std::string_view from, std::string_view to)
 {
   if (from.empty())
   {
     return *this;
   }
 
-  std::size_t pos = 0;
-  while ((pos = m_buffer.find(from, pos)) != std::string::npos)
+  std::size_t pos = simd::find(m_buffer, from);
+  if (pos == std::string::npos)
   {
-    m_buffer.replace(pos, from.size(), to);
-    pos += to.size();
+    return *this;
   }
+
+  // Rebuild in one pass, keeping the reserved capacity; replacing in place
+  // would shift the tail once per match
+  string_type result(m_buffer.get_allocator());
+  result.reserve(m_buffer.capacity());
+  std::size_t copied = 0;
+  for (; pos != std::string::npos; pos = simd::find(m_buffer, from, copied))
+  {
+    result.append(m_buffer, copied, pos - copied);
+    result.append(to);
+    copied = pos + from.size();
+  }
+  result.append(m_buffer, copied, std::string::npos);
+  m_buffer.swap(result);
   return *this;
 }
 
@@ -286,7 +372,8 @@ string_builder& string_builder::replace_all(std::string_view from, std::string_v
  * @param str String to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(std::string_view str)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(std::string_view str)
 {
   return append(str);
 }
@@ -296,7 +383,8 @@ string_builder& string_builder::operator<<(std::string_view str)
  * @param c Character to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(char c)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(char c)
 {
   return append(c);
 }
@@ -306,7 +394,8 @@ string_builder& string_builder::operator<<(char c)
  * @param str C-string to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(const char* str)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(const char* str)
 {
   return append(str);
 }
@@ -316,7 +405,8 @@ string_builder& string_builder::operator<<(const char* str)
  * @param value Integer value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(std::int32_t value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(std::int32_t value)
 {
   return append_int(value);
 }
@@ -326,7 +416,8 @@ string_builder& string_builder::operator<<(std::int32_t value)
  * @param value Integer value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(std::int64_t value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(std::int64_t value)
 {
   return append_int(value);
 }
@@ -336,7 +427,8 @@ string_builder& string_builder::operator<<(std::int64_t value)
  * @param value Integer value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(std::uint32_t value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(std::uint32_t value)
 {
   return append_uint(value);
 }
@@ -346,7 +438,8 @@ string_builder& string_builder::operator<<(std::uint32_t value)
  * @param value Integer value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(std::uint64_t value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(std::uint64_t value)
 {
   return append_uint(value);
 }
@@ -356,7 +449,8 @@ string_builder& string_builder::operator<<(std::uint64_t value)
  * @param value Double value to append
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(double value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(double value)
 {
   return append_double(value);
 }
@@ -366,7 +460,8 @@ string_builder& string_builder::operator<<(double value)
  * @param value Boolean value to append as "true" or "false"
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::operator<<(bool value)
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::operator<<(bool value)
 {
   return append_bool(value);
 }
@@ -379,9 +474,10 @@ string_builder& string_builder::operator<<(bool value)
  * @brief Convert builder contents to string
  * @return String copy of the buffer contents
  */
-std::string string_builder::to_string() const
+template <typename Allocator>
+std::string basic_string_builder<Allocator>::to_string() const
 {
-  return m_buffer;
+  return std::string(m_buffer.data(), m_buffer.size());
 }
 
 /**
@@ -392,11 +488,29 @@ std::string string_builder::to_string() const
  *
  * @return String view of the buffer contents
  */
-std::string_view string_builder::view() const noexcept
+template <typename Allocator>
+std::string_view basic_string_builder<Allocator>::view() const noexcept
 {
   return m_buffer;
 }
 
+/**
+ * @brief Move the buffer out of the builder
+ *
+ * No characters are copied. The builder is left empty and without a
+ * buffer; reset() reserves a new one of the released capacity.
+ *
+ * @return The built string, using the builder's allocator
+ */
+template <typename Allocator>
+typename basic_string_builder<Allocator>::string_type basic_string_builder<Allocator>::release() noexcept
+{
+  m_released = m_buffer.capacity();
+  string_type released(std::move(m_buffer));
+  m_buffer.clear();
+  return released;
+}
+
 // ============================================================================
 // Management Methods
 // ============================================================================
@@ -408,17 +522,40 @@ std::string_view string_builder::view() const noexcept
  *
  * @return Reference to this builder for chaining
  */
-string_builder& string_builder::clear() noexcept
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::clear() noexcept
 {
   m_buffer.clear();
   return *this;
 }
 
+/**
+ * @brief Clear the builder for the next string
+ *
+ * Like clear(), but after release() also reserves the capacity that the
+ * released buffer had, so a builder reused per message allocates once per
+ * message and never regrows. With an arena allocator that allocation is a
+ * pointer bump.
+ *
+ * @return Reference to this builder for chaining
+ */
+template <typename Allocator>
+basic_string_builder<Allocator>& basic_string_builder<Allocator>::reset()
+{
+  m_buffer.clear();
+  if (m_buffer.capacity() < m_released)
+  {
+    m_buffer.reserve(m_released);
+  }
+  return *this;
+}
+
 /**
  * @brief Reserve capacity for future appends
  * @param capacity Minimum capacity to reserve
  */
-void string_builder::reserve(std::size_t capacity)
+template <typename Allocator>
+void basic_string_builder<Allocator>::reserve(std::size_t capacity)
 {
   m_buffer.reserve(capacity);
 }
@@ -427,7 +564,8 @@ void string_builder::reserve(std::size_t capacity)
  * @brief Get current content size
  * @return Number of bytes in the buffer
  */
-std::size_t string_builder::size() const noexcept
+template <typename Allocator>
+std::size_t basic_string_builder<Allocator>::size() const noexcept
 {
   return m_buffer.size();
 }
@@ -436,7 +574,8 @@ std::size_t string_builder::size() const noexcept
  * @brief Get current capacity
  * @return Number of bytes allocated
  */
-std::size_t string_builder::capacity() const noexcept
+template <typename Allocator>
+std::size_t basic_string_builder<Allocator>::capacity() const noexcept
 {
   return m_buffer.capacity();
 }
@@ -445,9 +584,27 @@ std::size_t string_builder::capacity() const noexcept
  * @brief Check if builder is empty
  * @return true if the buffer contains no content
  */
-bool string_builder::empty() const noexcept
+template <typename Allocator>
+bool basic_string_builder<Allocator>::empty() const noexcept
 {
   return m_buffer.empty();
 }
 
+/**
+ * @brief Get the allocator of the buffer
+ * @return Copy of the allocator
+ */
+template <typename Allocator>
+typename basic_string_builder<Allocator>::allocator_type basic_string_builder<Allocator>::get_allocator() const noexcept
+{
+  return m_buffer.get_allocator();
+}
+
+// ============================================================================
+// Explicit Instantiations
+// ============================================================================
+
+template class basic_string_builder<std::allocator<char>>;
+template class basic_string_builder<std::pmr::polymorphic_allocator<char>>;
+
 } // namespace fb
@@ -2,8 +2,27 @@
 /// @brief Implementation of non-cryptographic string hash functions
 
 #include "fb/string_hash.h"
+#include "fb/simd_search.h"
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// Compiled per function and checked at run time, as in simd_search.cpp
+#define FB_CRC_SSE42 1
+#include <nmmintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+#define FB_CRC_ARMV8 1
+#include <arm_acle.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
 
 namespace fb
 {
@@ -24,15 +43,19 @@ constexpr std::uint64_t FNV1A_64_PRIME  = 0x00000100000001B3ULL;
 constexpr std::uint64_t FNV1A_64_OFFSET = 0xcbf29ce484222325ULL;
 
 // ============================================================================
-// CRC-32 Lookup Table (IEEE 802.3 polynomial: 0xEDB88320)
+// CRC Lookup Tables
 // ============================================================================
 
-// Pre-computed CRC-32 lookup table
-constexpr std::array<std::uint32_t, 256> make_crc_table()
-{
-  std::array<std::uint32_t, 256> table{};
-  constexpr std::uint32_t        polynomial = 0xEDB88320;
+constexpr std::uint32_t CRC32_POLYNOMIAL  = 0xEDB88320; // IEEE 802.3, reflected
+constexpr std::uint32_t CRC32C_POLYNOMIAL = 0x82F63B78; // Castagnoli, reflected
+
+using crc_tables = std::array<std::array<std::uint32_t, 256>, 8>;
 
+// tables[0] is the classic byte-at-a-time table; tables[k] advances a byte
+// through k further zero bytes, so eight bytes are folded in one step
+constexpr crc_tables make_crc_tables(std::uint32_t polynomial)
+{
+  crc_tables tables{};
   for (std::uint32_t i = 0; i < 256; ++i)
   {
     std::uint32_t crc = i;
@@ -47,25 +70,498 @@ constexpr std::array<std::uint32_t, 256> make_crc_table()
         crc >>= 1;
       }
     }
-    table[i] = crc;
+    tables[0][i] = crc;
+  }
+  for (std::size_t k = 1; k < tables.size(); ++k)
+  {
+    for (std::size_t i = 0; i < 256; ++i)
+    {
+      const std::uint32_t previous = tables[k - 1][i];
+      tables[k][i]                 = (previous >> 8) ^ tables[0][previous & 0xFF];
+    }
   }
-  return table;
+  return tables;
+}
+
+constexpr crc_tables CRC32_TABLES  = make_crc_tables(CRC32_POLYNOMIAL);
+constexpr crc_tables CRC32C_TABLES = make_crc_tables(CRC32C_POLYNOMIAL);
+
+// ============================================================================
+// XXH3 Primitives
+// ============================================================================
+
+constexpr std::uint64_t XXH_PRIME32_1 = 0x9E3779B1U;
+constexpr std::uint64_t XXH_PRIME32_2 = 0x85EBCA77U;
+constexpr std::uint64_t XXH_PRIME32_3 = 0xC2B2AE3DU;
+constexpr std::uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+constexpr std::uint64_t XXH_PRIME_MX1 = 0x165667919E3779F9ULL;
+constexpr std::uint64_t XXH_PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+constexpr std::size_t STRIPE_LEN            = 64;
+constexpr std::size_t SECRET_CONSUME_RATE   = 8;
+constexpr std::size_t SECRET_SIZE           = xxh3_64_hasher::SECRET_SIZE;
+constexpr std::size_t SECRET_SIZE_MIN       = 136;
+constexpr std::size_t STRIPES_PER_BLOCK     = (SECRET_SIZE - STRIPE_LEN) / SECRET_CONSUME_RATE;
+constexpr std::size_t BLOCK_LEN             = STRIPE_LEN * STRIPES_PER_BLOCK;
+constexpr std::size_t SECRET_LASTACC_START  = 7;
+constexpr std::size_t SECRET_MERGEACCS_START = 11;
+constexpr std::size_t MIDSIZE_MAX           = 240;
+constexpr std::size_t MIDSIZE_STARTOFFSET   = 3;
+constexpr std::size_t MIDSIZE_LASTOFFSET    = 17;
+
+/// Default secret of the reference implementation
+alignas(64) constexpr unsigned char XXH3_SECRET[SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+constexpr std::uint32_t swap32(std::uint32_t x) noexcept
+{
+  return ((x << 24) & 0xff000000U) | ((x << 8) & 0x00ff0000U) | ((x >> 8) & 0x0000ff00U) |
+         ((x >> 24) & 0x000000ffU);
+}
+
+constexpr std::uint64_t swap64(std::uint64_t x) noexcept
+{
+  return (static_cast<std::uint64_t>(swap32(static_cast<std::uint32_t>(x))) << 32) |
+         swap32(static_cast<std::uint32_t>(x >> 32));
+}
+
+constexpr std::uint64_t rotl64(std::uint64_t x, int r) noexcept
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+std::uint32_t read32(const unsigned char* p) noexcept
+{
+  std::uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = swap32(v);
+#endif
+  return v;
+}
+
+std::uint64_t read64(const unsigned char* p) noexcept
+{
+  std::uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = swap64(v);
+#endif
+  return v;
+}
+
+void write64(unsigned char* p, std::uint64_t v) noexcept
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = swap64(v);
+#endif
+  std::memcpy(p, &v, sizeof(v));
+}
+
+/// Low and high halves of the 128-bit product, XORed
+std::uint64_t mul128_fold64(std::uint64_t lhs, std::uint64_t rhs) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+  __extension__ using uint128 = unsigned __int128;
+  uint128 product = static_cast<uint128>(lhs) * rhs;
+  return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  std::uint64_t high = 0;
+  std::uint64_t low  = _umul128(lhs, rhs, &high);
+  return low ^ high;
+#else
+  const std::uint64_t lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+  const std::uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+  const std::uint64_t lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+  const std::uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+  const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  const std::uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+  const std::uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+  return lower ^ upper;
+#endif
 }
 
-constexpr auto CRC_TABLE = make_crc_table();
+constexpr std::uint64_t xxh64_avalanche(std::uint64_t h) noexcept
+{
+  h ^= h >> 33;
+  h *= XXH_PRIME64_2;
+  h ^= h >> 29;
+  h *= XXH_PRIME64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+constexpr std::uint64_t xxh3_avalanche(std::uint64_t h) noexcept
+{
+  h ^= h >> 37;
+  h *= XXH_PRIME_MX1;
+  h ^= h >> 32;
+  return h;
+}
+
+constexpr std::uint64_t rrmxmx(std::uint64_t h, std::uint64_t length) noexcept
+{
+  h ^= rotl64(h, 49) ^ rotl64(h, 24);
+  h *= XXH_PRIME_MX2;
+  h ^= (h >> 35) + length;
+  h *= XXH_PRIME_MX2;
+  h ^= h >> 28;
+  return h;
+}
 
 // ============================================================================
-// Helper Functions
+// XXH3 Short Inputs (up to 240 bytes)
 // ============================================================================
 
-/// @brief Convert ASCII character to lowercase
-constexpr char to_lower_ascii(char c) noexcept
+std::uint64_t xxh3_len_1to3(const unsigned char* input, std::size_t length, std::uint64_t seed) noexcept
+{
+  const std::uint32_t combined = (static_cast<std::uint32_t>(input[0]) << 16) |
+                                 (static_cast<std::uint32_t>(input[length >> 1]) << 24) |
+                                 static_cast<std::uint32_t>(input[length - 1]) |
+                                 (static_cast<std::uint32_t>(length) << 8);
+  const std::uint64_t bitflip = (read32(XXH3_SECRET) ^ read32(XXH3_SECRET + 4)) + seed;
+  return xxh64_avalanche(combined ^ bitflip);
+}
+
+std::uint64_t xxh3_len_4to8(const unsigned char* input, std::size_t length, std::uint64_t seed) noexcept
+{
+  seed ^= static_cast<std::uint64_t>(swap32(static_cast<std::uint32_t>(seed))) << 32;
+  const std::uint64_t bitflip = (read64(XXH3_SECRET + 8) ^ read64(XXH3_SECRET + 16)) - seed;
+  const std::uint64_t value   = read32(input + length - 4) + (static_cast<std::uint64_t>(read32(input)) << 32);
+  return rrmxmx(value ^ bitflip, length);
+}
+
+std::uint64_t xxh3_len_9to16(const unsigned char* input, std::size_t length, std::uint64_t seed) noexcept
+{
+  const std::uint64_t bitflip1 = (read64(XXH3_SECRET + 24) ^ read64(XXH3_SECRET + 32)) + seed;
+  const std::uint64_t bitflip2 = (read64(XXH3_SECRET + 40) ^ read64(XXH3_SECRET + 48)) - seed;
+  const std::uint64_t low      = read64(input) ^ bitflip1;
+  const std::uint64_t high     = read64(input + length - 8) ^ bitflip2;
+  return xxh3_avalanche(length + swap64(low) + high + mul128_fold64(low, high));
+}
+
+std::uint64_t mix16(const unsigned char* input, const unsigned char* secret, std::uint64_t seed) noexcept
+{
+  return mul128_fold64(read64(input) ^ (read64(secret) + seed), read64(input + 8) ^ (read64(secret + 8) - seed));
+}
+
+std::uint64_t xxh3_len_17to128(const unsigned char* input, std::size_t length, std::uint64_t seed) noexcept
+{
+  const unsigned char* secret = XXH3_SECRET;
+  std::uint64_t acc           = length * XXH_PRIME64_1;
+  if (length > 32)
+  {
+    if (length > 64)
+    {
+      if (length > 96)
+      {
+        acc += mix16(input + 48, secret + 96, seed);
+        acc += mix16(input + length - 64, secret + 112, seed);
+      }
+      acc += mix16(input + 32, secret + 64, seed);
+      acc += mix16(input + length - 48, secret + 80, seed);
+    }
+    acc += mix16(input + 16, secret + 32, seed);
+    acc += mix16(input + length - 32, secret + 48, seed);
+  }
+  acc += mix16(input, secret, seed);
+  acc += mix16(input + length - 16, secret + 16, seed);
+  return xxh3_avalanche(acc);
+}
+
+std::uint64_t xxh3_len_129to240(const unsigned char* input, std::size_t length, std::uint64_t seed) noexcept
 {
-  if (c >= 'A' && c <= 'Z')
+  const unsigned char* secret = XXH3_SECRET;
+  std::uint64_t acc           = length * XXH_PRIME64_1;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    acc += mix16(input + 16 * i, secret + 16 * i, seed);
+  }
+  acc = xxh3_avalanche(acc);
+
+  const std::size_t rounds = length / 16;
+  for (std::size_t i = 8; i < rounds; ++i)
   {
-    return static_cast<char>(c + ('a' - 'A'));
+    acc += mix16(input + 16 * i, secret + 16 * (i - 8) + MIDSIZE_STARTOFFSET, seed);
   }
-  return c;
+  acc += mix16(input + length - 16, secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET, seed);
+  return xxh3_avalanche(acc);
+}
+
+std::uint64_t xxh3_short(const unsigned char* input, std::size_t length, std::uint64_t seed) noexcept
+{
+  if (length <= 16)
+  {
+    if (length > 8)
+    {
+      return xxh3_len_9to16(input, length, seed);
+    }
+    if (length >= 4)
+    {
+      return xxh3_len_4to8(input, length, seed);
+    }
+    if (length > 0)
+    {
+      return xxh3_len_1to3(input, length, seed);
+    }
+    return xxh64_avalanche(seed ^ read64(XXH3_SECRET + 56) ^ read64(XXH3_SECRET + 64));
+  }
+  if (length <= 128)
+  {
+    return xxh3_len_17to128(input, length, seed);
+  }
+  return xxh3_len_129to240(input, length, seed);
+}
+
+// ============================================================================
+// XXH3 Long Inputs
+// ============================================================================
+
+// Eight 64-bit lanes per 64-byte stripe; the lane loops are left for the
+// compiler to vectorize
+
+using xxh3_acc = std::uint64_t[8];
+
+constexpr std::uint64_t XXH3_INIT_ACC[8] = {XXH_PRIME32_3, XXH_PRIME64_1, XXH_PRIME64_2, XXH_PRIME64_3,
+                                            XXH_PRIME64_4, XXH_PRIME32_2, XXH_PRIME64_5, XXH_PRIME32_1};
+
+void accumulate_stripe(xxh3_acc& acc, const unsigned char* input, const unsigned char* secret) noexcept
+{
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    const std::uint64_t value = read64(input + 8 * i);
+    const std::uint64_t key   = value ^ read64(secret + 8 * i);
+    acc[i ^ 1] += value;
+    acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+  }
+}
+
+void accumulate(xxh3_acc& acc, const unsigned char* input, const unsigned char* secret, std::size_t stripes) noexcept
+{
+  for (std::size_t n = 0; n < stripes; ++n)
+  {
+    accumulate_stripe(acc, input + n * STRIPE_LEN, secret + n * SECRET_CONSUME_RATE);
+  }
+}
+
+void scramble(xxh3_acc& acc, const unsigned char* secret) noexcept
+{
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    std::uint64_t a = acc[i];
+    a ^= a >> 47;
+    a ^= read64(secret + 8 * i);
+    acc[i] = a * XXH_PRIME32_1;
+  }
+}
+
+std::uint64_t merge_accumulators(const xxh3_acc& acc, const unsigned char* secret, std::uint64_t start) noexcept
+{
+  std::uint64_t result = start;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    result += mul128_fold64(acc[2 * i] ^ read64(secret + 16 * i), acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+  }
+  return xxh3_avalanche(result);
+}
+
+/// The default secret with @p seed added to and subtracted from its halves
+void derive_secret(unsigned char* secret, std::uint64_t seed) noexcept
+{
+  for (std::size_t i = 0; i < SECRET_SIZE / 16; ++i)
+  {
+    write64(secret + 16 * i, read64(XXH3_SECRET + 16 * i) + seed);
+    write64(secret + 16 * i + 8, read64(XXH3_SECRET + 16 * i + 8) - seed);
+  }
+}
+
+std::uint64_t finalize_long(const xxh3_acc& acc, const unsigned char* secret, std::uint64_t length) noexcept
+{
+  return merge_accumulators(acc, secret + SECRET_MERGEACCS_START, length * XXH_PRIME64_1);
+}
+
+std::uint64_t xxh3_long(const unsigned char* input, std::size_t length, const unsigned char* secret) noexcept
+{
+  xxh3_acc acc;
+  std::memcpy(acc, XXH3_INIT_ACC, sizeof(acc));
+
+  const std::size_t blocks = (length - 1) / BLOCK_LEN;
+  for (std::size_t n = 0; n < blocks; ++n)
+  {
+    accumulate(acc, input + n * BLOCK_LEN, secret, STRIPES_PER_BLOCK);
+    scramble(acc, secret + SECRET_SIZE - STRIPE_LEN);
+  }
+
+  // Last partial block, then the last stripe, which may overlap it
+  const std::size_t stripes = ((length - 1) - BLOCK_LEN * blocks) / STRIPE_LEN;
+  accumulate(acc, input + blocks * BLOCK_LEN, secret, stripes);
+  accumulate_stripe(acc, input + length - STRIPE_LEN, secret + SECRET_SIZE - STRIPE_LEN - SECRET_LASTACC_START);
+
+  return finalize_long(acc, secret, length);
+}
+
+// ============================================================================
+// CRC Kernels
+// ============================================================================
+
+// Kernels take and return the CRC register, without the initial and final
+// inversion
+
+using crc_kernel = std::uint32_t (*)(std::uint32_t crc, const unsigned char* data, std::size_t length);
+
+std::uint32_t crc_slice_by_8(const crc_tables& tables,
+                             std::uint32_t     crc,
+                             const unsigned char* data,
+                             std::size_t       length) noexcept
+{
+  for (; length >= 8; data += 8, length -= 8)
+  {
+    const std::uint32_t low  = crc ^ read32(data);
+    const std::uint32_t high = read32(data + 4);
+    crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^
+          tables[4][low >> 24] ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^
+          tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+  }
+  for (; length > 0; ++data, --length)
+  {
+    crc = (crc >> 8) ^ tables[0][(crc ^ *data) & 0xFF];
+  }
+  return crc;
+}
+
+std::uint32_t crc32_software(std::uint32_t crc, const unsigned char* data, std::size_t length)
+{
+  return crc_slice_by_8(CRC32_TABLES, crc, data, length);
+}
+
+std::uint32_t crc32c_software(std::uint32_t crc, const unsigned char* data, std::size_t length)
+{
+  return crc_slice_by_8(CRC32C_TABLES, crc, data, length);
+}
+
+#if FB_CRC_SSE42
+
+// The SSE4.2 crc32 instruction implements the Castagnoli polynomial only
+__attribute__((target("sse4.2"))) std::uint32_t crc32c_sse42(std::uint32_t        crc,
+                                                             const unsigned char* data,
+                                                             std::size_t          length)
+{
+#if defined(__x86_64__)
+  std::uint64_t wide = crc;
+  for (; length >= 8; data += 8, length -= 8)
+  {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    wide = _mm_crc32_u64(wide, word);
+  }
+  crc = static_cast<std::uint32_t>(wide);
+#endif
+  for (; length >= 4; data += 4, length -= 4)
+  {
+    std::uint32_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc = _mm_crc32_u32(crc, word);
+  }
+  for (; length > 0; ++data, --length)
+  {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+  return crc;
+}
+
+#endif // FB_CRC_SSE42
+
+#if FB_CRC_ARMV8
+
+// ARMv8 has instructions for both polynomials
+template<bool Castagnoli>
+__attribute__((target("+crc"))) std::uint32_t crc_armv8(std::uint32_t        crc,
+                                                        const unsigned char* data,
+                                                        std::size_t          length)
+{
+  for (; length >= 8; data += 8, length -= 8)
+  {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc = Castagnoli ? __crc32cd(crc, word) : __crc32d(crc, word);
+  }
+  for (; length > 0; ++data, --length)
+  {
+    crc = Castagnoli ? __crc32cb(crc, *data) : __crc32b(crc, *data);
+  }
+  return crc;
+}
+
+bool has_armv8_crc() noexcept
+{
+#if defined(__ARM_FEATURE_CRC32) || defined(__APPLE__)
+  return true;
+#elif defined(__linux__) && defined(HWCAP_CRC32)
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+  return false;
+#endif
+}
+
+#endif // FB_CRC_ARMV8
+
+crc_kernel select_crc32() noexcept
+{
+#if FB_CRC_ARMV8
+  if (has_armv8_crc())
+  {
+    return crc_armv8<false>;
+  }
+#endif
+  return crc32_software;
+}
+
+crc_kernel select_crc32c() noexcept
+{
+#if FB_CRC_SSE42
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse4.2"))
+  {
+    return crc32c_sse42;
+  }
+#elif FB_CRC_ARMV8
+  if (has_armv8_crc())
+  {
+    return crc_armv8<true>;
+  }
+#endif
+  return crc32c_software;
+}
+
+// Selected on first use, so checksums computed from static initializers in
+// other translation units are safe
+
+crc_kernel crc32_kernel() noexcept
+{
+  static const crc_kernel kernel = select_crc32();
+  return kernel;
+}
+
+crc_kernel crc32c_kernel() noexcept
+{
+  static const crc_kernel kernel = select_crc32c();
+  return kernel;
 }
 
 } // namespace
@@ -125,10 +621,19 @@ std::uint32_t hash_case_insensitive(std::string_view str) noexcept
 {
   std::uint32_t hash = FNV1A_32_OFFSET;
 
-  for (char c : str)
+  // Lowercase a chunk at a time with the vector kernel, so the FNV-1a loop
+  // below is the same as hash_fnv1a_32()
+  char chunk[256];
+  for (std::size_t pos = 0; pos < str.size(); pos += sizeof(chunk))
   {
-    hash ^= static_cast<std::uint8_t>(to_lower_ascii(c));
-    hash *= FNV1A_32_PRIME;
+    std::size_t size = std::min(sizeof(chunk), str.size() - pos);
+    std::memcpy(chunk, str.data() + pos, size);
+    simd::to_lower(chunk, size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      hash ^= static_cast<std::uint8_t>(chunk[i]);
+      hash *= FNV1A_32_PRIME;
+    }
   }
 
   return hash;
@@ -145,16 +650,174 @@ std::uint32_t crc32(std::string_view str) noexcept
 
 std::uint32_t crc32(const void* data, std::size_t length) noexcept
 {
-  const auto*   bytes = static_cast<const std::uint8_t*>(data);
-  std::uint32_t crc   = 0xFFFFFFFF;
+  return crc32_update(0, data, length);
+}
+
+std::uint32_t crc32_update(std::uint32_t crc, std::string_view str) noexcept
+{
+  return crc32_update(crc, str.data(), str.size());
+}
+
+std::uint32_t crc32_update(std::uint32_t crc, const void* data, std::size_t length) noexcept
+{
+  return ~crc32_kernel()(~crc, static_cast<const unsigned char*>(data), length);
+}
+
+// ============================================================================
+// CRC-32C
+// ============================================================================
+
+std::uint32_t crc32c(std::string_view str) noexcept
+{
+  return crc32c_update(0, str.data(), str.size());
+}
+
+std::uint32_t crc32c(const void* data, std::size_t length) noexcept
+{
+  return crc32c_update(0, data, length);
+}
+
+std::uint32_t crc32c_update(std::uint32_t crc, std::string_view str) noexcept
+{
+  return crc32c_update(crc, str.data(), str.size());
+}
+
+std::uint32_t crc32c_update(std::uint32_t crc, const void* data, std::size_t length) noexcept
+{
+  return ~crc32c_kernel()(~crc, static_cast<const unsigned char*>(data), length);
+}
+
+bool crc32c_is_hardware() noexcept
+{
+  return crc32c_kernel() != crc32c_software;
+}
+
+// ============================================================================
+// XXH3
+// ============================================================================
+
+std::uint64_t hash_xxh3_64(std::string_view str, std::uint64_t seed) noexcept
+{
+  return hash_xxh3_64(str.data(), str.size(), seed);
+}
 
-  for (std::size_t i = 0; i < length; ++i)
+std::uint64_t hash_xxh3_64(const void* data, std::size_t length, std::uint64_t seed) noexcept
+{
+  const auto* input = static_cast<const unsigned char*>(data);
+  if (length <= MIDSIZE_MAX)
+  {
+    return xxh3_short(input, length, seed);
+  }
+  if (seed == 0)
   {
-    std::uint8_t index = static_cast<std::uint8_t>(crc ^ bytes[i]);
-    crc                = (crc >> 8) ^ CRC_TABLE[index];
+    return xxh3_long(input, length, XXH3_SECRET);
   }
+  alignas(64) unsigned char secret[SECRET_SIZE];
+  derive_secret(secret, seed);
+  return xxh3_long(input, length, secret);
+}
 
-  return crc ^ 0xFFFFFFFF;
+xxh3_64_hasher::xxh3_64_hasher(std::uint64_t seed) noexcept
+{
+  reset(seed);
+}
+
+void xxh3_64_hasher::reset(std::uint64_t seed) noexcept
+{
+  std::memcpy(m_acc, XXH3_INIT_ACC, sizeof(m_acc));
+  derive_secret(m_secret, seed);
+  m_buffered         = 0;
+  m_stripes_in_block = 0;
+  m_total_length     = 0;
+  m_seed             = seed;
+}
+
+void xxh3_64_hasher::consume_stripes(const unsigned char* data, std::size_t stripes) noexcept
+{
+  // Same stripe and scramble sequence as xxh3_long(); stripes never
+  // exceeds one block
+  if (STRIPES_PER_BLOCK - m_stripes_in_block <= stripes)
+  {
+    const std::size_t to_block_end = STRIPES_PER_BLOCK - m_stripes_in_block;
+    accumulate(m_acc, data, m_secret + m_stripes_in_block * SECRET_CONSUME_RATE, to_block_end);
+    scramble(m_acc, m_secret + SECRET_SIZE - STRIPE_LEN);
+    accumulate(m_acc, data + to_block_end * STRIPE_LEN, m_secret, stripes - to_block_end);
+    m_stripes_in_block = stripes - to_block_end;
+  }
+  else
+  {
+    accumulate(m_acc, data, m_secret + m_stripes_in_block * SECRET_CONSUME_RATE, stripes);
+    m_stripes_in_block += stripes;
+  }
+}
+
+xxh3_64_hasher& xxh3_64_hasher::update(const void* data, std::size_t length) noexcept
+{
+  const auto* input = static_cast<const unsigned char*>(data);
+  m_total_length += length;
+
+  // Input is only consumed once more follows it, so the buffer always
+  // holds the tail that digest() treats specially
+  if (length <= BUFFER_SIZE - m_buffered)
+  {
+    std::memcpy(m_buffer + m_buffered, input, length);
+    m_buffered += length;
+    return *this;
+  }
+
+  if (m_buffered > 0)
+  {
+    const std::size_t fill = BUFFER_SIZE - m_buffered;
+    std::memcpy(m_buffer + m_buffered, input, fill);
+    input += fill;
+    length -= fill;
+    consume_stripes(m_buffer, BUFFER_SIZE / STRIPE_LEN);
+    m_buffered = 0;
+  }
+
+  if (length > BUFFER_SIZE)
+  {
+    // Straight from the input; keep the last stripe for digest()
+    do
+    {
+      consume_stripes(input, BUFFER_SIZE / STRIPE_LEN);
+      input += BUFFER_SIZE;
+      length -= BUFFER_SIZE;
+    } while (length > BUFFER_SIZE);
+    std::memcpy(m_buffer + BUFFER_SIZE - STRIPE_LEN, input - STRIPE_LEN, STRIPE_LEN);
+  }
+
+  std::memcpy(m_buffer, input, length);
+  m_buffered = length;
+  return *this;
+}
+
+std::uint64_t xxh3_64_hasher::digest() const noexcept
+{
+  if (m_total_length <= MIDSIZE_MAX)
+  {
+    return xxh3_short(m_buffer, static_cast<std::size_t>(m_total_length), m_seed);
+  }
+
+  // Finish on a copy so digest() leaves the state untouched
+  xxh3_64_hasher tail(*this);
+  const unsigned char* last_stripe = nullptr;
+  unsigned char joined[STRIPE_LEN];
+  if (m_buffered >= STRIPE_LEN)
+  {
+    tail.consume_stripes(tail.m_buffer, (m_buffered - 1) / STRIPE_LEN);
+    last_stripe = tail.m_buffer + m_buffered - STRIPE_LEN;
+  }
+  else
+  {
+    // The last stripe starts in previously consumed input
+    const std::size_t earlier = STRIPE_LEN - m_buffered;
+    std::memcpy(joined, m_buffer + BUFFER_SIZE - earlier, earlier);
+    std::memcpy(joined + earlier, m_buffer, m_buffered);
+    last_stripe = joined;
+  }
+  accumulate_stripe(tail.m_acc, last_stripe, m_secret + SECRET_SIZE - STRIPE_LEN - SECRET_LASTACC_START);
+  return finalize_long(tail.m_acc, m_secret, m_total_length);
 }
 
 } // namespace fb
@@ -1,6 +1,9 @@
 #include <fb/string_list.h>
+#include <fb/string_pattern.h>
 #include <fb/string_utils.h>
 
+#include <fb/detail/edit_distance.h>
+
 #include <algorithm>
 #include <random>
 #include <unordered_set>
@@ -433,13 +436,15 @@ string_list string_list::filter_ends_with(std::string_view suffix) const
 
 /**
  * @brief Filter elements matching a regex pattern
- * @param pattern Regex pattern
+ * @param pattern Regex pattern, compiled once and kept in default_pattern_cache()
  * @return New filtered string_list
  */
 string_list string_list::filter_matching(const std::string& pattern) const
 {
-  std::regex regex(pattern);
-  return filter_matching(regex);
+  const auto compiled = default_pattern_cache().regex(pattern);
+  return filter([&compiled](const std::string& s) {
+    return compiled->matches(s);
+  });
 }
 
 /**
@@ -454,6 +459,32 @@ string_list string_list::filter_matching(const std::regex& regex) const
   });
 }
 
+/**
+ * @brief Filter elements within an edit distance of a query
+ *
+ * Builds the query's bit-parallel match table once and checks every
+ * element against it with an early exit, instead of running a full
+ * fuzzy_match() per element.
+ *
+ * @param query String to match against
+ * @param max_distance Maximum allowed Levenshtein distance
+ * @return New filtered string_list
+ */
+string_list string_list::filter_fuzzy(std::string_view query, size_t max_distance) const
+{
+  const detail::edit_distance_query prepared(query);
+  const size_t bound = std::min(max_distance, detail::UNBOUNDED_DISTANCE);
+  string_list result;
+  for (const auto& s : m_data)
+  {
+    if (prepared.distance(s, bound) <= bound)
+    {
+      result.m_data.push_back(s);
+    }
+  }
+  return result;
+}
+
 // ============================================================================
 // Search Operations
 // ============================================================================
@@ -660,7 +691,7 @@ string_list& string_list::to_lower_all()
 {
   for (auto& s : m_data)
   {
-    s = fb::to_lower(s);
+    fb::to_lower_inplace(s);
   }
   return *this;
 }
@@ -673,7 +704,7 @@ string_list& string_list::to_upper_all()
 {
   for (auto& s : m_data)
   {
-    s = fb::to_upper(s);
+    fb::to_upper_inplace(s);
   }
   return *this;
 }
@@ -0,0 +1,963 @@
+/// @file string_pattern.cpp
+/// @brief Glob and regex subset compiler (parser, Thompson NFA, subset DFA)
+
+#include <fb/string_pattern.h>
+#include <fb/string_utils.h>
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <unordered_map>
+
+namespace fb
+{
+
+namespace
+{
+
+/// Larger NFAs come from long patterns or big {n,m} counts
+constexpr std::size_t MAX_NFA_STATES = 4096;
+
+/// Caps the table at MAX_DFA_STATES * 256 entries; beyond it, fall back
+constexpr std::size_t MAX_DFA_STATES = 1024;
+
+/// Largest count accepted in {n}, {n,} and {n,m}
+constexpr int MAX_REPEAT = 1000;
+
+constexpr int UNBOUNDED = -1;
+
+using byte_set = std::bitset<256>;
+
+/// Thrown for syntax or sizes the DFA does not handle
+struct unsupported
+{
+};
+
+// ============================================================================
+// Syntax Tree
+// ============================================================================
+
+struct node
+{
+  enum class kind
+  {
+    bytes,     ///< One byte out of a set
+    sequence,  ///< Children one after the other
+    either,    ///< Any one of the children
+    repeat,    ///< The only child, min to max times
+    at_start,  ///< ^
+    at_end     ///< $
+  };
+
+  kind              type;
+  byte_set          set;
+  std::vector<node> children;
+  int               min = 0;
+  int               max = 0;
+};
+
+node bytes_node(const byte_set& set)
+{
+  node n{node::kind::bytes, set, {}};
+  return n;
+}
+
+node repeat_node(node child, int min, int max)
+{
+  node n{node::kind::repeat, {}, {}};
+  n.children.push_back(std::move(child));
+  n.min = min;
+  n.max = max;
+  return n;
+}
+
+byte_set any_byte()
+{
+  return byte_set().set();
+}
+
+byte_set byte_range(unsigned first, unsigned last)
+{
+  byte_set set;
+  for (unsigned c = first; c <= last; ++c)
+  {
+    set.set(c);
+  }
+  return set;
+}
+
+byte_set single_byte(char c)
+{
+  byte_set set;
+  set.set(static_cast<unsigned char>(c));
+  return set;
+}
+
+byte_set ascii_case_variants(char c)
+{
+  byte_set set = single_byte(c);
+  if (c >= 'a' && c <= 'z')
+  {
+    set |= single_byte(static_cast<char>(c - 'a' + 'A'));
+  }
+  else if (c >= 'A' && c <= 'Z')
+  {
+    set |= single_byte(static_cast<char>(c - 'A' + 'a'));
+  }
+  return set;
+}
+
+// ECMAScript classes over char, as std::regex applies them in the C locale
+
+byte_set digit_bytes()
+{
+  return byte_range('0', '9');
+}
+
+byte_set word_bytes()
+{
+  return byte_range('a', 'z') | byte_range('A', 'Z') | digit_bytes() | single_byte('_');
+}
+
+byte_set space_bytes()
+{
+  return byte_range('\t', '\r') | single_byte(' ');
+}
+
+// ============================================================================
+// Glob Parser
+// ============================================================================
+
+node parse_glob(std::string_view pattern, bool case_sensitive)
+{
+  node glob{node::kind::sequence, {}, {}};
+  for (char c : pattern)
+  {
+    if (c == '*')
+    {
+      // Runs of '*' match the same as one
+      if (glob.children.empty() || glob.children.back().type != node::kind::repeat)
+      {
+        glob.children.push_back(repeat_node(bytes_node(any_byte()), 0, UNBOUNDED));
+      }
+    }
+    else if (c == '?')
+    {
+      glob.children.push_back(bytes_node(any_byte()));
+    }
+    else
+    {
+      glob.children.push_back(bytes_node(case_sensitive ? single_byte(c) : ascii_case_variants(c)));
+    }
+  }
+  return glob;
+}
+
+// ============================================================================
+// Regex Parser
+// ============================================================================
+
+/// Recursive descent over the ECMAScript subset; throws unsupported for
+/// anything else, including invalid patterns, which std::regex then reports
+class regex_parser
+{
+public:
+  explicit regex_parser(std::string_view pattern)
+    : m_pattern(pattern)
+  {
+  }
+
+  node parse()
+  {
+    node root = alternation();
+    if (!at_end())
+    {
+      throw unsupported{}; // Unbalanced ')'
+    }
+    return root;
+  }
+
+private:
+  bool at_end() const noexcept
+  {
+    return m_pos >= m_pattern.size();
+  }
+
+  char peek() const noexcept
+  {
+    return m_pattern[m_pos];
+  }
+
+  char next()
+  {
+    if (at_end())
+    {
+      throw unsupported{};
+    }
+    return m_pattern[m_pos++];
+  }
+
+  node alternation()
+  {
+    node first = sequence();
+    if (at_end() || peek() != '|')
+    {
+      return first;
+    }
+    node either{node::kind::either, {}, {}};
+    either.children.push_back(std::move(first));
+    while (!at_end() && peek() == '|')
+    {
+      ++m_pos;
+      either.children.push_back(sequence());
+    }
+    return either;
+  }
+
+  node sequence()
+  {
+    node seq{node::kind::sequence, {}, {}};
+    while (!at_end() && peek() != '|' && peek() != ')')
+    {
+      seq.children.push_back(quantified(atom()));
+    }
+    return seq;
+  }
+
+  node quantified(node item)
+  {
+    if (at_end())
+    {
+      return item;
+    }
+    int min = 0;
+    int max = 0;
+    switch (peek())
+    {
+    case '*':
+      min = 0;
+      max = UNBOUNDED;
+      ++m_pos;
+      break;
+    case '+':
+      min = 1;
+      max = UNBOUNDED;
+      ++m_pos;
+      break;
+    case '?':
+      min = 0;
+      max = 1;
+      ++m_pos;
+      break;
+    case '{':
+      ++m_pos;
+      braces(min, max);
+      break;
+    default:
+      return item;
+    }
+    if (item.type == node::kind::at_start || item.type == node::kind::at_end)
+    {
+      throw unsupported{};
+    }
+    // Lazy quantifiers change which match is found, not whether one is
+    if (!at_end() && peek() == '?')
+    {
+      ++m_pos;
+    }
+    if (!at_end() && (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{'))
+    {
+      throw unsupported{};
+    }
+    return repeat_node(std::move(item), min, max);
+  }
+
+  int number()
+  {
+    if (at_end() || peek() < '0' || peek() > '9')
+    {
+      throw unsupported{};
+    }
+    int value = 0;
+    while (!at_end() && peek() >= '0' && peek() <= '9')
+    {
+      value = value * 10 + (next() - '0');
+      if (value > MAX_REPEAT)
+      {
+        throw unsupported{};
+      }
+    }
+    return value;
+  }
+
+  void braces(int& min, int& max)
+  {
+    min = number();
+    max = min;
+    if (!at_end() && peek() == ',')
+    {
+      ++m_pos;
+      max = (!at_end() && peek() == '}') ? UNBOUNDED : number();
+    }
+    if (next() != '}' || (max != UNBOUNDED && max < min))
+    {
+      throw unsupported{};
+    }
+  }
+
+  node atom()
+  {
+    const char c = next();
+    switch (c)
+    {
+    case '(':
+    {
+      if (!at_end() && peek() == '?')
+      {
+        // Only non-capturing groups; lookahead is not regular
+        ++m_pos;
+        if (next() != ':')
+        {
+          throw unsupported{};
+        }
+      }
+      node inner = alternation();
+      if (next() != ')')
+      {
+        throw unsupported{};
+      }
+      return inner;
+    }
+    case '[':
+      return bytes_node(bracket());
+    case '.':
+      return bytes_node(any_byte() & ~(single_byte('\n') | single_byte('\r')));
+    case '^':
+      return node{node::kind::at_start, {}, {}};
+    case '$':
+      return node{node::kind::at_end, {}, {}};
+    case '\\':
+    {
+      byte_set set;
+      int      value = escape(set);
+      return bytes_node(value < 0 ? set : single_byte(static_cast<char>(value)));
+    }
+    case '*':
+    case '+':
+    case '?':
+    case '{':
+    case '}':
+    case ']':
+      throw unsupported{};
+    default:
+      return bytes_node(single_byte(c));
+    }
+  }
+
+  /// After a backslash: the byte it stands for, or -1 with @p set filled
+  /// for a class escape
+  int escape(byte_set& set)
+  {
+    const char c = next();
+    switch (c)
+    {
+    case 'd':
+      set = digit_bytes();
+      return -1;
+    case 'D':
+      set = ~digit_bytes();
+      return -1;
+    case 'w':
+      set = word_bytes();
+      return -1;
+    case 'W':
+      set = ~word_bytes();
+      return -1;
+    case 's':
+      set = space_bytes();
+      return -1;
+    case 'S':
+      set = ~space_bytes();
+      return -1;
+    case 't':
+      return '\t';
+    case 'n':
+      return '\n';
+    case 'r':
+      return '\r';
+    case 'f':
+      return '\f';
+    case 'v':
+      return '\v';
+    default:
+      // \b, backreferences, \x, \u, \c and the like
+      if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+      {
+        throw unsupported{};
+      }
+      return static_cast<unsigned char>(c);
+    }
+  }
+
+  /// One member of a bracket expression, as escape() returns it
+  int bracket_member(byte_set& set)
+  {
+    const char c = next();
+    if (c == '\\')
+    {
+      return escape(set);
+    }
+    if (c == '[' && !at_end() && (peek() == ':' || peek() == '=' || peek() == '.'))
+    {
+      throw unsupported{}; // POSIX classes
+    }
+    return static_cast<unsigned char>(c);
+  }
+
+  byte_set bracket()
+  {
+    const bool negate = !at_end() && peek() == '^';
+    if (negate)
+    {
+      ++m_pos;
+    }
+    if (!at_end() && peek() == ']')
+    {
+      throw unsupported{}; // [] and [^]
+    }
+
+    byte_set set;
+    while (next() != ']')
+    {
+      --m_pos;
+      byte_set   member_set;
+      const int  first    = bracket_member(member_set);
+      const bool is_range = m_pos + 1 < m_pattern.size() && peek() == '-' && m_pattern[m_pos + 1] != ']';
+      if (is_range)
+      {
+        ++m_pos;
+        byte_set  last_set;
+        const int last = bracket_member(last_set);
+        // Ranges over bytes above 127 depend on char signedness in std::regex,
+        // and class escapes cannot end a range
+        if (first < 0 || last < first || last > 127)
+        {
+          throw unsupported{};
+        }
+        set |= byte_range(static_cast<unsigned>(first), static_cast<unsigned>(last));
+      }
+      else if (first >= 0)
+      {
+        set.set(static_cast<unsigned>(first));
+      }
+      else
+      {
+        set |= member_set;
+      }
+    }
+    return negate ? ~set : set;
+  }
+
+  std::string_view m_pattern;
+  std::size_t      m_pos = 0;
+};
+
+// ============================================================================
+// NFA
+// ============================================================================
+
+struct nfa_state
+{
+  enum class kind : std::uint8_t
+  {
+    bytes,    ///< Consume one byte of sets[set], go to out
+    split,    ///< Go to out and out1
+    at_start, ///< Go to out at the start of the input
+    at_end,   ///< Go to out at the end of the input
+    match
+  };
+
+  kind         type;
+  std::int32_t set;
+  std::int32_t out;
+  std::int32_t out1;
+};
+
+class nfa
+{
+public:
+  explicit nfa(const node& root)
+  {
+    const std::int32_t match = add(nfa_state{nfa_state::kind::match, -1, -1, -1});
+    m_start                  = emit(root, match);
+  }
+
+  std::int32_t start() const noexcept
+  {
+    return m_start;
+  }
+
+  const std::vector<nfa_state>& states() const noexcept
+  {
+    return m_states;
+  }
+
+  const std::vector<byte_set>& sets() const noexcept
+  {
+    return m_sets;
+  }
+
+private:
+  std::int32_t add(const nfa_state& state)
+  {
+    if (m_states.size() >= MAX_NFA_STATES)
+    {
+      throw unsupported{};
+    }
+    m_states.push_back(state);
+    return static_cast<std::int32_t>(m_states.size() - 1);
+  }
+
+  std::int32_t set_index(const byte_set& set)
+  {
+    auto [it, inserted] = m_set_index.emplace(set, static_cast<std::int32_t>(m_sets.size()));
+    if (inserted)
+    {
+      m_sets.push_back(set);
+    }
+    return it->second;
+  }
+
+  // Built back to front: each call returns the entry state of a fragment
+  // that continues to next
+  std::int32_t emit(const node& n, std::int32_t next)
+  {
+    switch (n.type)
+    {
+    case node::kind::bytes:
+      return add(nfa_state{nfa_state::kind::bytes, set_index(n.set), next, -1});
+    case node::kind::sequence:
+      for (auto it = n.children.rbegin(); it != n.children.rend(); ++it)
+      {
+        next = emit(*it, next);
+      }
+      return next;
+    case node::kind::either:
+    {
+      std::int32_t entry = emit(n.children.back(), next);
+      for (std::size_t i = n.children.size() - 1; i-- > 0;)
+      {
+        const std::int32_t branch = emit(n.children[i], next);
+        entry                     = add(nfa_state{nfa_state::kind::split, -1, branch, entry});
+      }
+      return entry;
+    }
+    case node::kind::repeat:
+    {
+      const node&  child = n.children.front();
+      std::int32_t tail  = next;
+      if (n.max == UNBOUNDED)
+      {
+        const std::int32_t loop = add(nfa_state{nfa_state::kind::split, -1, -1, next});
+        const std::int32_t body = emit(child, loop);
+        m_states[static_cast<std::size_t>(loop)].out = body;
+        tail                                          = loop;
+      }
+      else
+      {
+        for (int i = n.min; i < n.max; ++i)
+        {
+          const std::int32_t body = emit(child, tail);
+          tail                    = add(nfa_state{nfa_state::kind::split, -1, body, next});
+        }
+      }
+      for (int i = 0; i < n.min; ++i)
+      {
+        tail = emit(child, tail);
+      }
+      return tail;
+    }
+    case node::kind::at_start:
+      return add(nfa_state{nfa_state::kind::at_start, -1, next, -1});
+    case node::kind::at_end:
+      return add(nfa_state{nfa_state::kind::at_end, -1, next, -1});
+    }
+    return next;
+  }
+
+  std::vector<nfa_state>                      m_states;
+  std::vector<byte_set>                       m_sets;
+  std::unordered_map<byte_set, std::int32_t> m_set_index;
+  std::int32_t                                m_start = 0;
+};
+
+} // namespace
+
+// ============================================================================
+// DFA Construction
+// ============================================================================
+
+/// Subset construction over byte classes, done eagerly so that matching
+/// never modifies the pattern
+struct pattern_compiler
+{
+  /// DFA states are sets of NFA states: the byte-consuming ones, the $
+  /// assertions waiting for the end, and the match state. The start state
+  /// carries this marker so it stays distinct from later, equal sets
+  static constexpr std::int32_t START_MARKER = -1;
+
+  pattern_compiler(const nfa& automaton, bool search)
+    : m_nfa(automaton)
+    , m_search(search)
+    , m_seen(automaton.states().size(), 0)
+  {
+  }
+
+  void build(compiled_pattern& result)
+  {
+    classify_bytes(result);
+
+    std::vector<std::int32_t> start;
+    closure(m_nfa.start(), true, false, start);
+    if (m_search)
+    {
+      closure(m_nfa.start(), false, false, m_restart);
+      finish(m_restart);
+    }
+    start.push_back(START_MARKER);
+    result.m_start = intern(finish(start));
+
+    std::vector<std::int32_t> target;
+    for (std::size_t index = 0; index < m_keys.size(); ++index)
+    {
+      const std::vector<std::int32_t> source = m_keys[index];
+      for (std::size_t cls = 0; cls < result.m_classes; ++cls)
+      {
+        const unsigned byte = m_representative[cls];
+        target.clear();
+        for (std::int32_t s : source)
+        {
+          if (s == START_MARKER)
+          {
+            continue;
+          }
+          const nfa_state& state = m_nfa.states()[static_cast<std::size_t>(s)];
+          if (state.type == nfa_state::kind::bytes && m_nfa.sets()[static_cast<std::size_t>(state.set)].test(byte))
+          {
+            closure(state.out, false, false, target);
+          }
+        }
+        if (m_search)
+        {
+          target.insert(target.end(), m_restart.begin(), m_restart.end());
+        }
+        m_transitions.push_back(intern(finish(target)));
+      }
+    }
+
+    result.m_transitions = std::move(m_transitions);
+    result.m_accept.clear();
+    result.m_accept_at_end.clear();
+    for (const auto& key : m_keys)
+    {
+      result.m_accept.push_back(accepts(key, false) ? 1 : 0);
+      result.m_accept_at_end.push_back(accepts(key, true) ? 1 : 0);
+    }
+    const auto dead = m_ids.find(std::vector<std::int32_t>());
+    result.m_dead   = dead == m_ids.end() ? -1 : dead->second;
+    result.m_search = m_search;
+  }
+
+private:
+  /// Bytes no set tells apart share a class, which keeps the table small
+  void classify_bytes(compiled_pattern& result)
+  {
+    std::vector<std::size_t> cls(256, 0);
+    std::size_t              classes = 1;
+    for (const byte_set& set : m_nfa.sets())
+    {
+      std::map<std::pair<std::size_t, bool>, std::size_t> split;
+      for (unsigned b = 0; b < 256; ++b)
+      {
+        split.emplace(std::make_pair(cls[b], set.test(b)), split.size());
+      }
+      for (unsigned b = 0; b < 256; ++b)
+      {
+        cls[b] = split[std::make_pair(cls[b], set.test(b))];
+      }
+      classes = split.size();
+    }
+
+    m_representative.assign(classes, 0);
+    for (unsigned b = 256; b-- > 0;)
+    {
+      result.m_byte_class[b]  = static_cast<std::uint8_t>(cls[b]);
+      m_representative[cls[b]] = b;
+    }
+    result.m_classes = classes;
+  }
+
+  /// Add the states reachable from @p from without consuming input
+  void closure(std::int32_t from, bool at_start, bool at_end, std::vector<std::int32_t>& out)
+  {
+    std::vector<std::int32_t> stack{from};
+    std::vector<std::int32_t> visited;
+    while (!stack.empty())
+    {
+      const std::int32_t s = stack.back();
+      stack.pop_back();
+      if (m_seen[static_cast<std::size_t>(s)])
+      {
+        continue;
+      }
+      m_seen[static_cast<std::size_t>(s)] = 1;
+      visited.push_back(s);
+
+      const nfa_state& state = m_nfa.states()[static_cast<std::size_t>(s)];
+      switch (state.type)
+      {
+      case nfa_state::kind::split:
+        stack.push_back(state.out1);
+        stack.push_back(state.out);
+        break;
+      case nfa_state::kind::at_start:
+        if (at_start)
+        {
+          stack.push_back(state.out);
+        }
+        break;
+      case nfa_state::kind::at_end:
+        if (at_end)
+        {
+          stack.push_back(state.out);
+        }
+        else
+        {
+          out.push_back(s);
+        }
+        break;
+      case nfa_state::kind::bytes:
+      case nfa_state::kind::match:
+        out.push_back(s);
+        break;
+      }
+    }
+    for (std::int32_t s : visited)
+    {
+      m_seen[static_cast<std::size_t>(s)] = 0;
+    }
+  }
+
+  static std::vector<std::int32_t>& finish(std::vector<std::int32_t>& key)
+  {
+    std::sort(key.begin(), key.end());
+    key.erase(std::unique(key.begin(), key.end()), key.end());
+    return key;
+  }
+
+  std::int32_t intern(const std::vector<std::int32_t>& key)
+  {
+    auto it = m_ids.find(key);
+    if (it != m_ids.end())
+    {
+      return it->second;
+    }
+    if (m_keys.size() >= MAX_DFA_STATES)
+    {
+      throw unsupported{};
+    }
+    const auto id = static_cast<std::int32_t>(m_keys.size());
+    m_ids.emplace(key, id);
+    m_keys.push_back(key);
+    return id;
+  }
+
+  /// Whether the set reaches the match state, at the end of the input if
+  /// @p at_end; ^ can still pass there only in the start state
+  bool accepts(const std::vector<std::int32_t>& key, bool at_end)
+  {
+    const bool                is_start = !key.empty() && key.front() == START_MARKER;
+    std::vector<std::int32_t> reached;
+    for (std::int32_t s : key)
+    {
+      if (s == START_MARKER)
+      {
+        continue;
+      }
+      const nfa_state& state = m_nfa.states()[static_cast<std::size_t>(s)];
+      if (state.type == nfa_state::kind::match)
+      {
+        return true;
+      }
+      if (at_end && state.type == nfa_state::kind::at_end)
+      {
+        closure(state.out, is_start, true, reached);
+      }
+    }
+    return std::any_of(reached.begin(), reached.end(), [this](std::int32_t s) {
+      return m_nfa.states()[static_cast<std::size_t>(s)].type == nfa_state::kind::match;
+    });
+  }
+
+  const nfa&                                        m_nfa;
+  bool                                              m_search;
+  std::vector<std::uint8_t>                         m_seen;
+  std::vector<unsigned>                             m_representative;
+  std::vector<std::int32_t>                         m_restart;
+  std::map<std::vector<std::int32_t>, std::int32_t> m_ids;
+  std::vector<std::vector<std::int32_t>>            m_keys;
+  std::vector<std::int32_t>                         m_transitions;
+};
+
+// ============================================================================
+// Compiled Pattern
+// ============================================================================
+
+compiled_pattern compiled_pattern::glob(std::string_view pattern, bool case_sensitive)
+{
+  compiled_pattern result;
+  result.m_pattern        = std::string(pattern);
+  result.m_case_sensitive = case_sensitive;
+  try
+  {
+    nfa automaton(parse_glob(pattern, case_sensitive));
+    pattern_compiler(automaton, false).build(result);
+  }
+  catch (const unsupported&)
+  {
+    result.m_engine = engine::matches_pattern;
+    result.m_transitions.clear();
+    result.m_accept.clear();
+    result.m_accept_at_end.clear();
+  }
+  return result;
+}
+
+compiled_pattern compiled_pattern::regex(std::string_view pattern)
+{
+  compiled_pattern result;
+  result.m_pattern = std::string(pattern);
+  try
+  {
+    nfa automaton(regex_parser(pattern).parse());
+    pattern_compiler(automaton, true).build(result);
+  }
+  catch (const unsupported&)
+  {
+    result.m_engine = engine::std_regex;
+    result.m_regex  = std::make_shared<const std::regex>(result.m_pattern);
+    result.m_transitions.clear();
+    result.m_accept.clear();
+    result.m_accept_at_end.clear();
+  }
+  return result;
+}
+
+bool compiled_pattern::matches(std::string_view str) const
+{
+  switch (m_engine)
+  {
+  case engine::matches_pattern:
+    return matches_pattern(str, m_pattern, m_case_sensitive);
+  case engine::std_regex:
+    return std::regex_search(str.data(), str.data() + str.size(), *m_regex);
+  case engine::dfa:
+    break;
+  }
+
+  const std::int32_t* transitions = m_transitions.data();
+  std::int32_t        state       = m_start;
+  for (unsigned char c : str)
+  {
+    if (m_search && m_accept[static_cast<std::size_t>(state)])
+    {
+      return true;
+    }
+    state = transitions[static_cast<std::size_t>(state) * m_classes + m_byte_class[c]];
+    if (state == m_dead)
+    {
+      return false;
+    }
+  }
+  return m_accept_at_end[static_cast<std::size_t>(state)] != 0;
+}
+
+// ============================================================================
+// Pattern Cache
+// ============================================================================
+
+pattern_cache::pattern_cache(std::size_t capacity)
+  : m_capacity(capacity)
+{
+}
+
+std::shared_ptr<const compiled_pattern> pattern_cache::glob(std::string_view pattern, bool case_sensitive)
+{
+  return get(pattern, case_sensitive ? GLOB : GLOB_IGNORE_CASE);
+}
+
+std::shared_ptr<const compiled_pattern> pattern_cache::regex(std::string_view pattern)
+{
+  return get(pattern, REGEX);
+}
+
+std::shared_ptr<const compiled_pattern> pattern_cache::get(std::string_view pattern, kind type)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto                        it = m_index[type].find(pattern);
+    if (it != m_index[type].end())
+    {
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      return it->second->compiled;
+    }
+  }
+
+  // Compile without the lock; another thread may do the same meanwhile
+  auto compiled = std::make_shared<const compiled_pattern>(
+      type == REGEX ? compiled_pattern::regex(pattern) : compiled_pattern::glob(pattern, type == GLOB));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_capacity == 0)
+  {
+    return compiled;
+  }
+  auto it = m_index[type].find(pattern);
+  if (it != m_index[type].end())
+  {
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->compiled;
+  }
+  m_entries.push_front(entry{std::string(pattern), type, compiled});
+  m_index[type].emplace(m_entries.front().pattern, m_entries.begin());
+  while (m_entries.size() > m_capacity)
+  {
+    m_index[m_entries.back().type].erase(m_entries.back().pattern);
+    m_entries.pop_back();
+  }
+  return compiled;
+}
+
+std::size_t pattern_cache::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+void pattern_cache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& index : m_index)
+  {
+    index.clear();
+  }
+  m_entries.clear();
+}
+
+pattern_cache& default_pattern_cache()
+{
+  static pattern_cache cache;
+  return cache;
+}
+
+} // namespace fb
@@ -0,0 +1,220 @@
+/// @file string_pool.cpp
+/// @brief Implementation of the sharded string interning pool
+
+#include <fb/string_pool.h>
+#include <fb/string_hash.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace fb
+{
+
+namespace
+{
+
+constexpr std::size_t MIN_SLOTS = 16;
+
+/// Arena chunks double from the first size up to the last; strings longer
+/// than a quarter of the last size get a block of their own
+constexpr std::size_t FIRST_CHUNK_SIZE = 1024;
+constexpr std::size_t CHUNK_SIZE       = 64 * 1024;
+
+std::uint32_t tag_of(std::uint64_t hash) noexcept
+{
+  return static_cast<std::uint32_t>(hash >> 16);
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+string_pool::string_pool() = default;
+
+string_pool::~string_pool()
+{
+  for (auto& segment : m_segments)
+  {
+    delete[] segment.load(std::memory_order_relaxed);
+  }
+}
+
+// ============================================================================
+// Interning
+// ============================================================================
+
+string_pool::handle string_pool::intern(std::string_view str)
+{
+  const std::uint64_t hash  = hash_xxh3_64(str);
+  shard&              owner = m_shards[hash >> (64 - SHARD_BITS)];
+
+  std::lock_guard<std::mutex> lock(owner.mutex);
+  if (!owner.slots.empty())
+  {
+    const slot found = owner.slots[probe(owner, hash, str)];
+    if (found.handle_plus_one != 0)
+    {
+      return found.handle_plus_one - 1;
+    }
+  }
+  if ((owner.count + 1) * 2 > owner.slots.size())
+  {
+    grow(owner);
+  }
+
+  const handle h = publish(store(owner, str));
+  owner.slots[probe(owner, hash, str)] = slot{h + 1, tag_of(hash)};
+  ++owner.count;
+  return h;
+}
+
+std::string_view string_pool::intern_view(std::string_view str)
+{
+  return view(intern(str));
+}
+
+std::optional<string_pool::handle> string_pool::find(std::string_view str) const
+{
+  const std::uint64_t hash  = hash_xxh3_64(str);
+  const shard&        owner = m_shards[hash >> (64 - SHARD_BITS)];
+
+  std::lock_guard<std::mutex> lock(owner.mutex);
+  if (owner.slots.empty())
+  {
+    return std::nullopt;
+  }
+  const slot found = owner.slots[probe(owner, hash, str)];
+  if (found.handle_plus_one == 0)
+  {
+    return std::nullopt;
+  }
+  return found.handle_plus_one - 1;
+}
+
+string_pool::size_type string_pool::probe(const shard& owner, std::uint64_t hash, std::string_view str) const noexcept
+{
+  const size_type mask = owner.slots.size() - 1;
+  size_type       i    = static_cast<size_type>(hash) & mask;
+  for (; owner.slots[i].handle_plus_one != 0; i = (i + 1) & mask)
+  {
+    if (owner.slots[i].tag == tag_of(hash) && view(owner.slots[i].handle_plus_one - 1) == str)
+    {
+      break;
+    }
+  }
+  return i;
+}
+
+void string_pool::grow(shard& owner) const
+{
+  std::vector<slot> slots(std::max(MIN_SLOTS, owner.slots.size() * 2), slot{0, 0});
+  const size_type   mask = slots.size() - 1;
+  for (const slot& s : owner.slots)
+  {
+    if (s.handle_plus_one == 0)
+    {
+      continue;
+    }
+    size_type i = static_cast<size_type>(hash_xxh3_64(view(s.handle_plus_one - 1))) & mask;
+    while (slots[i].handle_plus_one != 0)
+    {
+      i = (i + 1) & mask;
+    }
+    slots[i] = s;
+  }
+  owner.slots.swap(slots);
+}
+
+std::string_view string_pool::store(shard& owner, std::string_view str)
+{
+  if (str.empty())
+  {
+    return {};
+  }
+  if (str.size() > CHUNK_SIZE / 4)
+  {
+    owner.chunks.push_back(std::make_unique<char[]>(str.size()));
+    owner.arena_bytes += str.size();
+    std::memcpy(owner.chunks.back().get(), str.data(), str.size());
+    return {owner.chunks.back().get(), str.size()};
+  }
+  if (owner.free_size < str.size())
+  {
+    const size_type size = std::max(str.size(), std::clamp(owner.arena_bytes, FIRST_CHUNK_SIZE, CHUNK_SIZE));
+    owner.chunks.push_back(std::make_unique<char[]>(size));
+    owner.arena_bytes += size;
+    owner.free_begin = owner.chunks.back().get();
+    owner.free_size  = size;
+  }
+
+  char* copy = owner.free_begin;
+  std::memcpy(copy, str.data(), str.size());
+  owner.free_begin += str.size();
+  owner.free_size -= str.size();
+  return {copy, str.size()};
+}
+
+string_pool::handle string_pool::publish(std::string_view str)
+{
+  constexpr std::uint32_t MAX_SIZE = ~std::uint32_t{0} - ((std::uint32_t{1} << FIRST_SEGMENT_BITS) - 1);
+
+  std::uint32_t h = m_size.load(std::memory_order_relaxed);
+  do
+  {
+    if (h == MAX_SIZE)
+    {
+      throw std::length_error("string_pool: too many strings");
+    }
+  } while (!m_size.compare_exchange_weak(h, h + 1, std::memory_order_relaxed));
+
+  // Shards racing for the same new segment: one allocation wins, the others are dropped
+  const location                  at      = locate(h);
+  std::atomic<std::string_view*>& segment = m_segments[at.segment];
+  std::string_view*               entries = segment.load(std::memory_order_acquire);
+  if (entries == nullptr)
+  {
+    auto* fresh = new std::string_view[std::size_t{1} << (FIRST_SEGMENT_BITS + at.segment)];
+    if (segment.compare_exchange_strong(entries, fresh, std::memory_order_acq_rel))
+    {
+      entries = fresh;
+    }
+    else
+    {
+      delete[] fresh;
+    }
+  }
+
+  // Readers learn h through the shard mutex or from this thread, both after this store
+  entries[at.offset] = str;
+  return h;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+string_pool::size_type string_pool::size() const noexcept
+{
+  return m_size.load(std::memory_order_relaxed);
+}
+
+bool string_pool::empty() const noexcept
+{
+  return size() == 0;
+}
+
+string_pool::size_type string_pool::arena_bytes() const
+{
+  size_type bytes = 0;
+  for (const shard& owner : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    bytes += owner.arena_bytes;
+  }
+  return bytes;
+}
+
+} // namespace fb
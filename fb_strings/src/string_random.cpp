@@ -3,8 +3,8 @@
 
 #include "fb/string_random.h"
 
+#include <chrono>
 #include <random>
-#include <stdexcept>
 
 namespace fb
 {
@@ -16,13 +16,50 @@ namespace
 // Thread-Local Random Engine
 // ============================================================================
 
-/// @brief Get thread-local random engine
-std::mt19937_64& get_random_engine()
+std::uint64_t random_device_seed()
 {
-  thread_local std::mt19937_64 engine{std::random_device{}()};
+  std::random_device device;
+  return static_cast<std::uint64_t>(device()) << 32 | device();
+}
+
+/// @brief Get thread-local random engine, seeded from std::random_device
+xoshiro256pp& get_random_engine()
+{
+  thread_local xoshiro256pp engine{random_device_seed()};
   return engine;
 }
 
+/// @brief Get thread-local generator behind uuid_v7() and ulid()
+unique_id_generator& get_id_generator()
+{
+  thread_local unique_id_generator generator;
+  return generator;
+}
+
+std::uint64_t unix_time_ms() noexcept
+{
+  const auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch).count());
+}
+
+constexpr std::uint64_t bit_mask(unsigned bits) noexcept
+{
+  return bits >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+}
+
+/// Unix milliseconds fill the first 48 bits of both formats
+constexpr unsigned TIMESTAMP_BITS = 48;
+
+/// UUID v7 random bits: 12 of rand_a, 62 of rand_b
+constexpr unsigned UUID_RAND_A_BITS = 12;
+constexpr unsigned UUID_RAND_B_BITS = 62;
+
+/// ULID random bits: 80, split 16:64
+constexpr unsigned ULID_HIGH_BITS = 16;
+constexpr unsigned ULID_LOW_BITS  = 64;
+
+constexpr char CROCKFORD_BASE32[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
 // ============================================================================
 // Character Sets
 // ============================================================================
@@ -34,10 +71,6 @@ constexpr std::string_view CHARSET_ALPHABETIC = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcde
 
 constexpr std::string_view CHARSET_NUMERIC = "0123456789";
 
-constexpr std::string_view CHARSET_HEX_LOWER = "0123456789abcdef";
-
-constexpr std::string_view CHARSET_HEX_UPPER = "0123456789ABCDEF";
-
 } // namespace
 
 // ============================================================================
@@ -46,28 +79,7 @@ constexpr std::string_view CHARSET_HEX_UPPER = "0123456789ABCDEF";
 
 std::string random_string(std::size_t length, std::string_view charset)
 {
-  if (charset.empty())
-  {
-    throw std::invalid_argument("charset must not be empty");
-  }
-
-  if (length == 0)
-  {
-    return {};
-  }
-
-  std::string                             result;
-  result.reserve(length);
-
-  auto& engine = get_random_engine();
-  std::uniform_int_distribution<std::size_t> dist(0, charset.size() - 1);
-
-  for (std::size_t i = 0; i < length; ++i)
-  {
-    result.push_back(charset[dist(engine)]);
-  }
-
-  return result;
+  return random_string(get_random_engine(), length, charset);
 }
 
 std::string random_alphanumeric(std::size_t length)
@@ -87,51 +99,165 @@ std::string random_numeric(std::size_t length)
 
 std::string random_hex(std::size_t length, bool uppercase)
 {
-  return random_string(length, uppercase ? CHARSET_HEX_UPPER : CHARSET_HEX_LOWER);
+  return random_hex(get_random_engine(), length, uppercase);
+}
+
+void random_hex(char* out, std::size_t length, bool uppercase)
+{
+  random_hex(get_random_engine(), out, length, uppercase);
 }
 
 std::string random_uuid()
 {
-  // UUID format: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx
-  // Total: 36 characters (32 hex + 4 hyphens)
-  // Version 4 = bits 12-15 of time_hi_and_version set to 0100
-  // Variant = bits 6-7 of clock_seq_hi_and_reserved set to 10
+  return random_uuid(get_random_engine());
+}
+
+void random_uuid(char* out)
+{
+  random_uuid(get_random_engine(), out);
+}
 
-  auto& engine = get_random_engine();
-  std::uniform_int_distribution<std::uint32_t> dist(0, 15);
+void seed_random(std::uint64_t seed) noexcept
+{
+  get_random_engine().seed(seed);
+}
 
-  std::string uuid;
-  uuid.reserve(36);
+// ============================================================================
+// Time-Ordered IDs
+// ============================================================================
 
-  constexpr char hex_chars[] = "0123456789abcdef";
+unique_id_generator::unique_id_generator()
+  : m_engine(random_device_seed())
+{
+}
+
+unique_id_generator::unique_id_generator(std::uint64_t seed) noexcept
+  : m_engine(seed)
+{
+}
 
-  // Generate 32 random hex digits with proper version and variant bits
-  for (int i = 0; i < 36; ++i)
+void unique_id_generator::advance(sequence& last, std::uint64_t unix_ms, unsigned high_bits, unsigned low_bits) noexcept
+{
+  unix_ms &= bit_mask(TIMESTAMP_BITS);
+  if (unix_ms > last.unix_ms)
   {
-    if (i == 8 || i == 13 || i == 18 || i == 23)
-    {
-      // Insert hyphens at positions 8, 13, 18, 23
-      uuid.push_back('-');
-    }
-    else if (i == 14)
+    last.unix_ms = unix_ms;
+    last.high    = m_engine() & bit_mask(high_bits);
+    last.low     = m_engine() & bit_mask(low_bits);
+    return;
+  }
+
+  // Same millisecond, or the clock stepped back: count up from the last ID,
+  // carrying into the timestamp once the random bits run out
+  last.low = (last.low + 1) & bit_mask(low_bits);
+  if (last.low == 0)
+  {
+    last.high = (last.high + 1) & bit_mask(high_bits);
+    if (last.high == 0)
     {
-      // Version 4: position 14 (index in hex chars is 14, after 8-xxxx- which is position 12-13)
-      // The 13th hex digit (0-indexed) should be '4'
-      uuid.push_back('4');
+      ++last.unix_ms;
     }
-    else if (i == 19)
+  }
+}
+
+void unique_id_generator::uuid_v7(char* out)
+{
+  uuid_v7(out, unix_time_ms());
+}
+
+void unique_id_generator::uuid_v7(char* out, std::uint64_t unix_ms) noexcept
+{
+  advance(m_uuid, unix_ms, UUID_RAND_A_BITS, UUID_RAND_B_BITS);
+  // unix_ts_ms (48) | ver 0111 (4) | rand_a (12) ; var 10 (2) | rand_b (62)
+  const std::uint64_t high = m_uuid.unix_ms << 16 | 0x7000 | m_uuid.high;
+  const std::uint64_t low  = std::uint64_t{0x2} << 62 | m_uuid.low;
+  detail::format_uuid(high, low, out);
+}
+
+void unique_id_generator::ulid(char* out)
+{
+  ulid(out, unix_time_ms());
+}
+
+void unique_id_generator::ulid(char* out, std::uint64_t unix_ms) noexcept
+{
+  advance(m_ulid, unix_ms, ULID_HIGH_BITS, ULID_LOW_BITS);
+  // 128 bits as 26 base32 digits, the first holding only 3 bits: 10 for the
+  // timestamp, then 16 for the random bits
+  const std::uint64_t time = m_ulid.unix_ms;
+  for (int i = 9; i >= 0; --i)
+  {
+    out[9 - i] = CROCKFORD_BASE32[(time >> (5 * i)) & 0x1F];
+  }
+  // Random bits as high:low = 16:64, read 5 at a time from the top
+  for (int i = 15; i >= 0; --i)
+  {
+    const unsigned shift = static_cast<unsigned>(5 * i);
+    std::uint64_t digit  = 0;
+    if (shift >= 64)
     {
-      // Variant: position 19, must be 8, 9, a, or b (binary 10xx)
-      // The 17th hex digit (0-indexed) should be 8-b
-      uuid.push_back(hex_chars[8 + (dist(engine) & 0x3)]);
+      digit = m_ulid.high >> (shift - 64);
     }
     else
     {
-      uuid.push_back(hex_chars[dist(engine)]);
+      digit = m_ulid.low >> shift;
+      if (shift > 59)
+      {
+        digit |= m_ulid.high << (64 - shift);
+      }
     }
+    out[10 + (15 - i)] = CROCKFORD_BASE32[digit & 0x1F];
   }
+}
 
-  return uuid;
+std::string uuid_v7()
+{
+  std::string result(UUID_LENGTH, '\0');
+  uuid_v7(result.data());
+  return result;
 }
 
+void uuid_v7(char* out)
+{
+  get_id_generator().uuid_v7(out);
+}
+
+std::string ulid()
+{
+  std::string result(ULID_LENGTH, '\0');
+  ulid(result.data());
+  return result;
+}
+
+void ulid(char* out)
+{
+  get_id_generator().ulid(out);
+}
+
+// ============================================================================
+// UUID Formatting
+// ============================================================================
+
+namespace detail
+{
+
+void format_uuid(std::uint64_t high, std::uint64_t low, char* out) noexcept
+{
+  // UUID format: xxxxxxxx-xxxx-Mxxx-Nxxx-xxxxxxxxxxxx, M the version, N the variant
+  constexpr char hex_chars[] = "0123456789abcdef";
+  // Where the hex pair of each of the 16 bytes starts
+  constexpr std::uint8_t PAIR_OFFSETS[16] = {0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+
+  for (std::size_t byte = 0; byte < 16; ++byte)
+  {
+    const std::uint64_t word  = byte < 8 ? high : low;
+    const unsigned      value = static_cast<unsigned>(word >> (56 - 8 * (byte % 8))) & 0xFF;
+    out[PAIR_OFFSETS[byte]]     = hex_chars[value >> 4];
+    out[PAIR_OFFSETS[byte] + 1] = hex_chars[value & 0x0F];
+  }
+  out[8] = out[13] = out[18] = out[23] = '-';
+}
+
+} // namespace detail
+
 } // namespace fb
@@ -0,0 +1,241 @@
+/// @file string_set.cpp
+/// @brief Implementation of the frozen string hash set
+
+#include <fb/string_set.h>
+#include <fb/string_hash.h>
+#include <fb/string_list.h>
+#include <fb/string_utils.h>
+
+#include <algorithm>
+
+namespace fb
+{
+
+namespace
+{
+
+constexpr std::size_t MIN_SLOTS = 16;
+
+/// Queries up to this long are lowercased in one stack buffer
+constexpr std::size_t FOLD_CHUNK = 256;
+
+constexpr char to_ascii_lower(char ch) noexcept
+{
+  return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+/// hash_xxh3_64() of the ASCII-lowercased string, without allocating
+std::uint64_t hash_folded(std::string_view str) noexcept
+{
+  char buffer[FOLD_CHUNK];
+  if (str.size() <= FOLD_CHUNK)
+  {
+    std::transform(str.begin(), str.end(), buffer, to_ascii_lower);
+    return hash_xxh3_64(buffer, str.size(), 0);
+  }
+
+  xxh3_64_hasher hasher;
+  while (!str.empty())
+  {
+    const std::size_t n = std::min(str.size(), FOLD_CHUNK);
+    std::transform(str.begin(), str.begin() + static_cast<std::ptrdiff_t>(n), buffer, to_ascii_lower);
+    hasher.update(buffer, n);
+    str.remove_prefix(n);
+  }
+  return hasher.digest();
+}
+
+std::uint32_t tag_of(std::uint64_t hash) noexcept
+{
+  return static_cast<std::uint32_t>(hash >> 32);
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+string_set::string_set(std::initializer_list<std::string_view> init)
+{
+  reserve(init.size());
+  for (std::string_view s : init)
+  {
+    insert(s);
+  }
+}
+
+string_set::string_set(const string_list& list)
+{
+  reserve(list.size());
+  for (const std::string& s : list)
+  {
+    insert(s);
+  }
+}
+
+string_set::string_set(const packed_string_list& list)
+{
+  reserve(list.size());
+  for (std::string_view s : list)
+  {
+    insert(s);
+  }
+}
+
+void string_set::reserve(size_type count)
+{
+  if (count * 2 > m_slots.size())
+  {
+    rehash(count);
+  }
+}
+
+void string_set::insert(std::string_view value)
+{
+  const size_type position = m_source_size++;
+  if (find(value) != npos)
+  {
+    return;
+  }
+
+  m_elements.push_back(value);
+  m_positions.push_back(position);
+  if (m_elements.size() * 2 > m_slots.size())
+  {
+    rehash(m_elements.size());
+  }
+  else
+  {
+    place(m_elements.size() - 1);
+  }
+}
+
+void string_set::rehash(size_type count)
+{
+  size_type capacity = MIN_SLOTS;
+  while (capacity < count * 2)
+  {
+    capacity *= 2;
+  }
+
+  m_slots.assign(capacity, slot{0, 0});
+  m_folded.assign(capacity, slot{0, 0});
+  for (size_type e = 0; e < m_elements.size(); ++e)
+  {
+    place(e);
+  }
+}
+
+void string_set::place(size_type e)
+{
+  const std::string_view value   = m_elements[e];
+  const auto             element = static_cast<std::uint32_t>(e + 1);
+  const size_type        mask    = m_slots.size() - 1;
+
+  const std::uint64_t hash = hash_xxh3_64(value);
+  size_type           i    = static_cast<size_type>(hash) & mask;
+  while (m_slots[i].element != 0)
+  {
+    i = (i + 1) & mask;
+  }
+  m_slots[i] = slot{element, tag_of(hash)};
+
+  // The folded table keeps one element per case-insensitive key
+  const std::uint64_t folded = hash_folded(value);
+  size_type           j      = static_cast<size_type>(folded) & mask;
+  for (; m_folded[j].element != 0; j = (j + 1) & mask)
+  {
+    if (m_folded[j].tag == tag_of(folded) && equals_ignore_case(m_elements[m_folded[j].element - 1], value))
+    {
+      return;
+    }
+  }
+  m_folded[j] = slot{element, tag_of(folded)};
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+string_set::size_type string_set::find(std::string_view str) const noexcept
+{
+  if (m_slots.empty())
+  {
+    return npos;
+  }
+  const std::uint64_t hash = hash_xxh3_64(str);
+  const size_type     mask = m_slots.size() - 1;
+  for (size_type i = static_cast<size_type>(hash) & mask; m_slots[i].element != 0; i = (i + 1) & mask)
+  {
+    if (m_slots[i].tag == tag_of(hash) && m_elements[m_slots[i].element - 1] == str)
+    {
+      return m_slots[i].element - 1;
+    }
+  }
+  return npos;
+}
+
+bool string_set::contains(std::string_view str) const noexcept
+{
+  return find(str) != npos;
+}
+
+bool string_set::contains_ignore_case(std::string_view str) const noexcept
+{
+  if (m_folded.empty())
+  {
+    return false;
+  }
+  const std::uint64_t folded = hash_folded(str);
+  const size_type     mask   = m_folded.size() - 1;
+  for (size_type i = static_cast<size_type>(folded) & mask; m_folded[i].element != 0; i = (i + 1) & mask)
+  {
+    if (m_folded[i].tag == tag_of(folded) && equals_ignore_case(m_elements[m_folded[i].element - 1], str))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<string_set::size_type> string_set::index_of(std::string_view str) const noexcept
+{
+  const size_type element = find(str);
+  if (element == npos)
+  {
+    return std::nullopt;
+  }
+  return m_positions[element];
+}
+
+// ============================================================================
+// Elements
+// ============================================================================
+
+string_set::size_type string_set::size() const noexcept
+{
+  return m_elements.size();
+}
+
+bool string_set::empty() const noexcept
+{
+  return m_elements.empty();
+}
+
+const packed_string_list& string_set::elements() const noexcept
+{
+  return m_elements;
+}
+
+string_set::const_iterator string_set::begin() const noexcept
+{
+  return m_elements.begin();
+}
+
+string_set::const_iterator string_set::end() const noexcept
+{
+  return m_elements.end();
+}
+
+} // namespace fb
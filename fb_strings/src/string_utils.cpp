@@ -1,14 +1,20 @@
 #include <fb/string_utils.h>
+#include <fb/encoding.h>
+#include <fb/simd_search.h>
+
+#include <fb/detail/edit_distance.h>
+#include <fb/detail/number_chars.h>
+#include <fb/detail/number_parse.h>
 
 #include <algorithm>
 #include <array>
 #include <cctype>
 #include <charconv>
+#include <cstdint>
 #include <cstdlib>
-#include <iomanip>
+#include <cstring>
 #include <limits>
 #include <numeric>
-#include <sstream>
 
 namespace fb
 {
@@ -79,116 +85,114 @@ constexpr int hex_value(char ch) noexcept
   return -1;
 }
 
-constexpr char hex_char(int value, bool uppercase) noexcept
-{
-  if (value < 10)
-  {
-    return static_cast<char>('0' + value);
-  }
-  return static_cast<char>((uppercase ? 'A' : 'a') + value - 10);
-}
-
-// Base64 encoding table
-constexpr std::string_view BASE64_CHARS =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-constexpr int base64_index(char ch) noexcept
-{
-  if (ch >= 'A' && ch <= 'Z')
-  {
-    return ch - 'A';
-  }
-  if (ch >= 'a' && ch <= 'z')
-  {
-    return ch - 'a' + 26;
-  }
-  if (ch >= '0' && ch <= '9')
-  {
-    return ch - '0' + 52;
-  }
-  if (ch == '+')
-  {
-    return 62;
-  }
-  if (ch == '/')
-  {
-    return 63;
-  }
-  return -1;
-}
-
 } // namespace
 
 // ============================================================================
 // Trimming Functions
 // ============================================================================
 
-std::string trim(std::string_view str)
+std::string_view trim_view(std::string_view str) noexcept
 {
-  size_t start = 0;
-  size_t end   = str.size();
-
-  while (start < end && is_whitespace(str[start]))
-  {
-    ++start;
-  }
-  while (end > start && is_whitespace(str[end - 1]))
-  {
-    --end;
-  }
-
-  return std::string(str.substr(start, end - start));
+  return trim_left_view(trim_right_view(str));
 }
 
-std::string trim_left(std::string_view str)
+std::string_view trim_left_view(std::string_view str) noexcept
 {
   size_t start = 0;
   while (start < str.size() && is_whitespace(str[start]))
   {
     ++start;
   }
-  return std::string(str.substr(start));
+  return str.substr(start);
 }
 
-std::string trim_right(std::string_view str)
+std::string_view trim_right_view(std::string_view str) noexcept
 {
   size_t end = str.size();
   while (end > 0 && is_whitespace(str[end - 1]))
   {
     --end;
   }
-  return std::string(str.substr(0, end));
+  return str.substr(0, end);
+}
+
+std::string_view trim_view(std::string_view str, std::string_view chars) noexcept
+{
+  return trim_left_view(trim_right_view(str, chars), chars);
+}
+
+std::string_view trim_left_view(std::string_view str, std::string_view chars) noexcept
+{
+  const size_t start = str.find_first_not_of(chars);
+  return start == std::string_view::npos ? std::string_view() : str.substr(start);
+}
+
+std::string_view trim_right_view(std::string_view str, std::string_view chars) noexcept
+{
+  const size_t end = str.find_last_not_of(chars);
+  return end == std::string_view::npos ? std::string_view() : str.substr(0, end + 1);
+}
+
+std::string trim(std::string_view str)
+{
+  return std::string(trim_view(str));
+}
+
+std::string trim_left(std::string_view str)
+{
+  return std::string(trim_left_view(str));
+}
+
+std::string trim_right(std::string_view str)
+{
+  return std::string(trim_right_view(str));
 }
 
 std::string trim(std::string_view str, std::string_view chars)
 {
-  size_t start = str.find_first_not_of(chars);
-  if (start == std::string_view::npos)
-  {
-    return std::string();
-  }
-  size_t end = str.find_last_not_of(chars);
-  return std::string(str.substr(start, end - start + 1));
+  return std::string(trim_view(str, chars));
 }
 
 std::string trim_left(std::string_view str, std::string_view chars)
 {
-  size_t start = str.find_first_not_of(chars);
-  if (start == std::string_view::npos)
-  {
-    return std::string();
-  }
-  return std::string(str.substr(start));
+  return std::string(trim_left_view(str, chars));
 }
 
 std::string trim_right(std::string_view str, std::string_view chars)
 {
-  size_t end = str.find_last_not_of(chars);
-  if (end == std::string_view::npos)
-  {
-    return std::string();
-  }
-  return std::string(str.substr(0, end + 1));
+  return std::string(trim_right_view(str, chars));
+}
+
+void trim_inplace(std::string& str)
+{
+  trim_right_inplace(str);
+  trim_left_inplace(str);
+}
+
+void trim_left_inplace(std::string& str)
+{
+  str.erase(0, str.size() - trim_left_view(str).size());
+}
+
+void trim_right_inplace(std::string& str)
+{
+  str.resize(trim_right_view(str).size());
+}
+
+void trim_inplace(std::string& str, std::string_view chars)
+{
+  trim_right_inplace(str, chars);
+  trim_left_inplace(str, chars);
+}
+
+void trim_left_inplace(std::string& str, std::string_view chars)
+{
+  str.erase(0, str.size() - trim_left_view(str, chars).size());
+}
+
+void trim_right_inplace(std::string& str, std::string_view chars)
+{
+  str.resize(trim_right_view(str, chars).size());
 }
 
 // ============================================================================
@@ -197,26 +201,28 @@ std::string trim_right(std::string_view str, std::string_view chars)
 
 std::string to_upper(std::string_view str)
 {
-  std::string result;
-  result.reserve(str.size());
-  for (char ch : str)
-  {
-    result.push_back(to_ascii_upper(ch));
-  }
+  std::string result(str);
+  to_upper_inplace(result);
   return result;
 }
 
 std::string to_lower(std::string_view str)
 {
-  std::string result;
-  result.reserve(str.size());
-  for (char ch : str)
-  {
-    result.push_back(to_ascii_lower(ch));
-  }
+  std::string result(str);
+  to_lower_inplace(result);
   return result;
 }
 
+void to_upper_inplace(std::string& str)
+{
+  simd::to_upper(str.data(), str.size());
+}
+
+void to_lower_inplace(std::string& str)
+{
+  simd::to_lower(str.data(), str.size());
+}
+
 std::string capitalize(std::string_view str)
 {
   if (str.empty())
@@ -260,26 +266,16 @@ std::string title_case(std::string_view str)
 
 std::string swap_case(std::string_view str)
 {
-  std::string result;
-  result.reserve(str.size());
-  for (char ch : str)
-  {
-    if (is_ascii_upper(ch))
-    {
-      result.push_back(to_ascii_lower(ch));
-    }
-    else if (is_ascii_lower(ch))
-    {
-      result.push_back(to_ascii_upper(ch));
-    }
-    else
-    {
-      result.push_back(ch);
-    }
-  }
+  std::string result(str);
+  swap_case_inplace(result);
   return result;
 }
 
+void swap_case_inplace(std::string& str)
+{
+  simd::swap_case(str.data(), str.size());
+}
+
 // ============================================================================
 // Prefix/Suffix Operations
 // ============================================================================
@@ -362,7 +358,7 @@ std::string ensure_suffix(std::string_view str, std::string_view suffix)
 
 bool contains(std::string_view str, std::string_view substr)
 {
-  return str.find(substr) != std::string_view::npos;
+  return simd::find(str, substr) != std::string_view::npos;
 }
 
 bool contains(std::string_view str, char ch)
@@ -378,7 +374,7 @@ size_t count(std::string_view str, std::string_view substr)
   }
   size_t count = 0;
   size_t pos   = 0;
-  while ((pos = str.find(substr, pos)) != std::string_view::npos)
+  while ((pos = simd::find(str, substr, pos)) != std::string_view::npos)
   {
     ++count;
     pos += substr.size();
@@ -393,7 +389,7 @@ size_t count(std::string_view str, char ch)
 
 size_t find_any(std::string_view str, std::string_view chars)
 {
-  return str.find_first_of(chars);
+  return simd::find_any(str, chars);
 }
 
 size_t find_any_last(std::string_view str, std::string_view chars)
@@ -413,7 +409,7 @@ std::string replace(std::string_view str,
   {
     return std::string(str);
   }
-  size_t pos = str.find(from);
+  size_t pos = simd::find(str, from);
   if (pos == std::string_view::npos)
   {
     return std::string(str);
@@ -438,7 +434,7 @@ std::string replace_all(std::string_view str,
   result.reserve(str.size());
   size_t pos      = 0;
   size_t last_pos = 0;
-  while ((pos = str.find(from, last_pos)) != std::string_view::npos)
+  while ((pos = simd::find(str, from, last_pos)) != std::string_view::npos)
   {
     result.append(str.substr(last_pos, pos - last_pos));
     result.append(to);
@@ -465,14 +461,50 @@ std::string replace(std::string_view str, char from, char to)
 std::string replace_all(std::string_view str, char from, char to)
 {
   std::string result(str);
-  for (char& ch : result)
+  simd::replace(result.data(), result.size(), from, to);
+  return result;
+}
+
+void replace_all_inplace(std::string& str, std::string_view from, std::string_view to)
+{
+  if (from.empty())
   {
-    if (ch == from)
+    return;
+  }
+  size_t pos = simd::find(str, from, 0);
+  if (pos == std::string_view::npos)
+  {
+    return;
+  }
+  if (to.size() > from.size())
+  {
+    str = replace_all(str, from, to);
+    return;
+  }
+
+  // The text shifts left: writes stay behind the next search position
+  char*  data = str.data();
+  size_t out  = pos;
+  size_t in   = pos;
+  while (pos != std::string_view::npos)
+  {
+    std::memmove(data + out, data + in, pos - in);
+    out += pos - in;
+    if (!to.empty())
     {
-      ch = to;
+      std::memcpy(data + out, to.data(), to.size());
+      out += to.size();
     }
+    in  = pos + from.size();
+    pos = simd::find(str, from, in);
   }
-  return result;
+  std::memmove(data + out, data + in, str.size() - in);
+  str.resize(out + str.size() - in);
+}
+
+void replace_all_inplace(std::string& str, char from, char to)
+{
+  simd::replace(str.data(), str.size(), from, to);
 }
 
 // ============================================================================
@@ -512,25 +544,57 @@ std::string remove_all(std::string_view str, char ch)
 {
   std::string result;
   result.reserve(str.size());
-  for (char c : str)
+  // Copy the runs between occurrences
+  size_t start = 0;
+  size_t pos   = 0;
+  while ((pos = str.find(ch, start)) != std::string_view::npos)
   {
-    if (c != ch)
-    {
-      result.push_back(c);
-    }
+    result.append(str.data() + start, pos - start);
+    start = pos + 1;
   }
+  result.append(str.data() + start, str.size() - start);
   return result;
 }
 
+void remove_all_inplace(std::string& str, std::string_view substr)
+{
+  replace_all_inplace(str, substr, std::string_view());
+}
+
+void remove_all_inplace(std::string& str, char ch)
+{
+  size_t pos = str.find(ch);
+  if (pos == std::string::npos)
+  {
+    return;
+  }
+
+  char*  data = str.data();
+  size_t out  = pos;
+  size_t in   = pos + 1;
+  while ((pos = str.find(ch, in)) != std::string::npos)
+  {
+    std::memmove(data + out, data + in, pos - in);
+    out += pos - in;
+    in = pos + 1;
+  }
+  std::memmove(data + out, data + in, str.size() - in);
+  str.resize(out + str.size() - in);
+}
+
 // ============================================================================
 // Splitting and Joining
 // ============================================================================
 
-std::vector<std::string> split(std::string_view str,
-                               char delimiter,
-                               bool keep_empty)
+namespace
+{
+
+// Each splitter passes its parts, in order, to emit(std::string_view);
+// the std::string and std::string_view variants share them
+
+template<typename Emit>
+void split_parts(std::string_view str, char delimiter, bool keep_empty, Emit&& emit)
 {
-  std::vector<std::string> result;
   size_t start = 0;
   size_t pos   = 0;
 
@@ -538,86 +602,81 @@ std::vector<std::string> split(std::string_view str,
   {
     if (keep_empty || pos > start)
     {
-      result.emplace_back(str.substr(start, pos - start));
+      emit(str.substr(start, pos - start));
     }
     start = pos + 1;
   }
 
   if (keep_empty || start < str.size())
   {
-    result.emplace_back(str.substr(start));
+    emit(str.substr(start));
   }
-
-  return result;
 }
 
-std::vector<std::string> split(std::string_view str,
-                               std::string_view delimiter,
-                               bool keep_empty)
+template<typename Emit>
+void split_parts(std::string_view str,
+                 std::string_view delimiter,
+                 bool keep_empty,
+                 Emit&& emit)
 {
-  std::vector<std::string> result;
-
   if (delimiter.empty())
   {
-    result.emplace_back(str);
-    return result;
+    emit(str);
+    return;
   }
 
   size_t start = 0;
   size_t pos   = 0;
 
-  while ((pos = str.find(delimiter, start)) != std::string_view::npos)
+  while ((pos = simd::find(str, delimiter, start)) != std::string_view::npos)
   {
     if (keep_empty || pos > start)
     {
-      result.emplace_back(str.substr(start, pos - start));
+      emit(str.substr(start, pos - start));
     }
     start = pos + delimiter.size();
   }
 
   if (keep_empty || start < str.size())
   {
-    result.emplace_back(str.substr(start));
+    emit(str.substr(start));
   }
-
-  return result;
 }
 
-std::vector<std::string> split_any(std::string_view str,
-                                   std::string_view delimiters,
-                                   bool keep_empty)
+template<typename Emit>
+void split_any_parts(std::string_view str,
+                     std::string_view delimiters,
+                     bool keep_empty,
+                     Emit&& emit)
 {
-  std::vector<std::string> result;
   size_t start = 0;
   size_t pos   = 0;
 
-  while ((pos = str.find_first_of(delimiters, start)) != std::string_view::npos)
+  while ((pos = simd::find_any(str, delimiters, start)) != std::string_view::npos)
   {
     if (keep_empty || pos > start)
     {
-      result.emplace_back(str.substr(start, pos - start));
+      emit(str.substr(start, pos - start));
     }
     start = pos + 1;
   }
 
   if (keep_empty || start < str.size())
   {
-    result.emplace_back(str.substr(start));
+    emit(str.substr(start));
   }
-
-  return result;
 }
 
-std::vector<std::string> split_lines(std::string_view str, bool keep_empty)
+template<typename Emit>
+void split_lines_parts(std::string_view str, bool keep_empty, Emit&& emit)
 {
-  std::vector<std::string> result;
   size_t start = 0;
   size_t pos   = 0;
 
   while (pos < str.size())
   {
     // Find next line ending
-    size_t line_end = str.find_first_of("\r\n", pos);
+    size_t line_end = simd::find_any(str, "\r\n", pos);
     if (line_end == std::string_view::npos)
     {
       line_end = str.size();
@@ -625,7 +684,7 @@ std::vector<std::string> split_lines(std::string_view str, bool keep_empty)
 
     if (keep_empty || line_end > start)
     {
-      result.emplace_back(str.substr(start, line_end - start));
+      emit(str.substr(start, line_end - start));
     }
 
     // Skip line ending(s)
@@ -652,105 +711,272 @@ std::vector<std::string> split_lines(std::string_view str, bool keep_empty)
   if (keep_empty && start == str.size() && !str.empty() &&
       (str.back() == '\n' || str.back() == '\r'))
   {
-    result.emplace_back();
+    emit(std::string_view());
   }
-
-  return result;
 }
 
-std::vector<std::string> split_whitespace(std::string_view str)
+template<typename Emit>
+void split_whitespace_parts(std::string_view str, Emit&& emit)
 {
-  std::vector<std::string> result;
-  size_t start = 0;
-  size_t pos   = 0;
+  // Each set bit of boundaries starts or ends a word, alternately;
+  // word_before_block holds bit 0 when the byte before the block is in a word
+  std::uint64_t word_before_block = 0;
+  size_t        start             = 0;
+  bool          in_word           = false;
 
-  while (pos < str.size())
+  for (size_t i = 0; i < str.size(); i += simd::MASK_BLOCK)
   {
-    // Skip whitespace
-    while (pos < str.size() && is_whitespace(str[pos]))
-    {
-      ++pos;
-    }
-    start = pos;
-
-    // Find end of token
-    while (pos < str.size() && !is_whitespace(str[pos]))
-    {
-      ++pos;
-    }
+    const std::uint64_t words      = ~simd::classify(str.data() + i, str.size() - i).whitespace;
+    std::uint64_t       boundaries = words ^ ((words << 1) | word_before_block);
+    word_before_block              = words >> 63;
 
-    if (pos > start)
+    for (; boundaries != 0; boundaries &= boundaries - 1)
     {
-      result.emplace_back(str.substr(start, pos - start));
+      const size_t pos = i + simd::lowest_bit(boundaries);
+      if (in_word)
+      {
+        emit(str.substr(start, pos - start));
+      }
+      start   = pos;
+      in_word = !in_word;
     }
   }
 
-  return result;
-}
-
-std::vector<std::string> split_n(std::string_view str,
-                                 char delimiter,
-                                 size_t max_parts)
-{
-  if (max_parts == 0)
+  if (in_word)
   {
-    return split(str, delimiter, true);
+    emit(str.substr(start));
   }
+}
 
-  std::vector<std::string> result;
-  result.reserve(max_parts);
+/// @pre max_parts > 0
+template<typename Emit>
+void split_n_parts(std::string_view str, char delimiter, size_t max_parts, Emit&& emit)
+{
+  size_t parts = 0;
   size_t start = 0;
   size_t pos   = 0;
 
   while ((pos = str.find(delimiter, start)) != std::string_view::npos &&
-         result.size() < max_parts - 1)
+         parts < max_parts - 1)
   {
-    result.emplace_back(str.substr(start, pos - start));
+    emit(str.substr(start, pos - start));
+    ++parts;
     start = pos + 1;
   }
 
-  result.emplace_back(str.substr(start));
-  return result;
+  emit(str.substr(start));
 }
 
-std::string join(const std::vector<std::string>& parts,
-                 std::string_view delimiter)
+template<typename String>
+auto append_to(std::vector<String>& out)
 {
-  if (parts.empty())
-  {
-    return std::string();
-  }
-
-  size_t total_size = 0;
-  for (const auto& part : parts)
-  {
-    total_size += part.size();
-  }
-  total_size += delimiter.size() * (parts.size() - 1);
-
-  std::string result;
-  result.reserve(total_size);
+  return [&out](std::string_view part) { out.emplace_back(part); };
+}
 
-  result.append(parts[0]);
-  for (size_t i = 1; i < parts.size(); ++i)
-  {
-    result.append(delimiter);
-    result.append(parts[i]);
-  }
+} // namespace
 
+std::vector<std::string> split(std::string_view str,
+                               char delimiter,
+                               bool keep_empty)
+{
+  std::vector<std::string> result;
+  split_parts(str, delimiter, keep_empty, append_to(result));
   return result;
 }
 
-std::string join(const std::vector<std::string>& parts, char delimiter)
+std::vector<std::string> split(std::string_view str,
+                               std::string_view delimiter,
+                               bool keep_empty)
 {
-  return join(parts, std::string_view(&delimiter, 1));
+  std::vector<std::string> result;
+  split_parts(str, delimiter, keep_empty, append_to(result));
+  return result;
 }
 
-// ============================================================================
-// Substring Extraction
-// ============================================================================
-
-std::string left(std::string_view str, size_t n)
+std::vector<std::string> split_any(std::string_view str,
+                                   std::string_view delimiters,
+                                   bool keep_empty)
+{
+  std::vector<std::string> result;
+  split_any_parts(str, delimiters, keep_empty, append_to(result));
+  return result;
+}
+
+std::vector<std::string> split_lines(std::string_view str, bool keep_empty)
+{
+  std::vector<std::string> result;
+  split_lines_parts(str, keep_empty, append_to(result));
+  return result;
+}
+
+std::vector<std::string> split_whitespace(std::string_view str)
+{
+  std::vector<std::string> result;
+  split_whitespace_parts(str, append_to(result));
+  return result;
+}
+
+std::vector<std::string> split_n(std::string_view str,
+                                 char delimiter,
+                                 size_t max_parts)
+{
+  if (max_parts == 0)
+  {
+    return split(str, delimiter, true);
+  }
+
+  std::vector<std::string> result;
+  result.reserve(max_parts);
+  split_n_parts(str, delimiter, max_parts, append_to(result));
+  return result;
+}
+
+void split_view(std::string_view str,
+                char delimiter,
+                std::vector<std::string_view>& out,
+                bool keep_empty)
+{
+  out.clear();
+  split_parts(str, delimiter, keep_empty, append_to(out));
+}
+
+void split_view(std::string_view str,
+                std::string_view delimiter,
+                std::vector<std::string_view>& out,
+                bool keep_empty)
+{
+  out.clear();
+  split_parts(str, delimiter, keep_empty, append_to(out));
+}
+
+void split_any_view(std::string_view str,
+                    std::string_view delimiters,
+                    std::vector<std::string_view>& out,
+                    bool keep_empty)
+{
+  out.clear();
+  split_any_parts(str, delimiters, keep_empty, append_to(out));
+}
+
+void split_lines_view(std::string_view str,
+                      std::vector<std::string_view>& out,
+                      bool keep_empty)
+{
+  out.clear();
+  split_lines_parts(str, keep_empty, append_to(out));
+}
+
+void split_whitespace_view(std::string_view str,
+                           std::vector<std::string_view>& out)
+{
+  out.clear();
+  split_whitespace_parts(str, append_to(out));
+}
+
+void split_n_view(std::string_view str,
+                  char delimiter,
+                  size_t max_parts,
+                  std::vector<std::string_view>& out)
+{
+  if (max_parts == 0)
+  {
+    split_view(str, delimiter, out, true);
+    return;
+  }
+
+  out.clear();
+  split_n_parts(str, delimiter, max_parts, append_to(out));
+}
+
+std::vector<std::string_view> split_view(std::string_view str,
+                                         char delimiter,
+                                         bool keep_empty)
+{
+  std::vector<std::string_view> result;
+  split_view(str, delimiter, result, keep_empty);
+  return result;
+}
+
+std::vector<std::string_view> split_view(std::string_view str,
+                                         std::string_view delimiter,
+                                         bool keep_empty)
+{
+  std::vector<std::string_view> result;
+  split_view(str, delimiter, result, keep_empty);
+  return result;
+}
+
+std::vector<std::string_view> split_any_view(std::string_view str,
+                                             std::string_view delimiters,
+                                             bool keep_empty)
+{
+  std::vector<std::string_view> result;
+  split_any_view(str, delimiters, result, keep_empty);
+  return result;
+}
+
+std::vector<std::string_view> split_lines_view(std::string_view str,
+                                               bool keep_empty)
+{
+  std::vector<std::string_view> result;
+  split_lines_view(str, result, keep_empty);
+  return result;
+}
+
+std::vector<std::string_view> split_whitespace_view(std::string_view str)
+{
+  std::vector<std::string_view> result;
+  split_whitespace_view(str, result);
+  return result;
+}
+
+std::vector<std::string_view> split_n_view(std::string_view str,
+                                           char delimiter,
+                                           size_t max_parts)
+{
+  std::vector<std::string_view> result;
+  split_n_view(str, delimiter, max_parts, result);
+  return result;
+}
+
+std::string join(const std::vector<std::string>& parts,
+                 std::string_view delimiter)
+{
+  if (parts.empty())
+  {
+    return std::string();
+  }
+
+  size_t total_size = 0;
+  for (const auto& part : parts)
+  {
+    total_size += part.size();
+  }
+  total_size += delimiter.size() * (parts.size() - 1);
+
+  std::string result;
+  result.reserve(total_size);
+
+  result.append(parts[0]);
+  for (size_t i = 1; i < parts.size(); ++i)
+  {
+    result.append(delimiter);
+    result.append(parts[i]);
+  }
+
+  return result;
+}
+
+std::string join(const std::vector<std::string>& parts, char delimiter)
+{
+  return join(parts, std::string_view(&delimiter, 1));
+}
+
+// ============================================================================
+// Substring Extraction
+// ============================================================================
+
+std::string left(std::string_view str, size_t n)
 {
   return std::string(str.substr(0, std::min(n, str.size())));
 }
@@ -1082,9 +1308,7 @@ bool is_octal(std::string_view str, bool allow_prefix)
 
 bool is_ascii(std::string_view str)
 {
-  return std::all_of(str.begin(), str.end(), [](char ch) {
-    return static_cast<unsigned char>(ch) < 128;
-  });
+  return simd::is_ascii(str);
 }
 
 bool is_printable(std::string_view str)
@@ -1147,48 +1371,27 @@ bool is_identifier(std::string_view str)
 // Number Parsing
 // ============================================================================
 
-std::optional<int> to_int(std::string_view str)
+namespace
 {
-  if (str.empty())
-  {
-    return std::nullopt;
-  }
-
-  // Trim whitespace
-  std::string_view trimmed = str;
-  while (!trimmed.empty() && is_whitespace(trimmed.front()))
-  {
-    trimmed.remove_prefix(1);
-  }
-  while (!trimmed.empty() && is_whitespace(trimmed.back()))
-  {
-    trimmed.remove_suffix(1);
-  }
 
-  if (trimmed.empty())
+std::string_view trim_number(std::string_view str) noexcept
+{
+  while (!str.empty() && is_whitespace(str.front()))
   {
-    return std::nullopt;
+    str.remove_prefix(1);
   }
-
-  // Skip '+' sign (std::from_chars doesn't accept it)
-  if (trimmed.front() == '+')
+  while (!str.empty() && is_whitespace(str.back()))
   {
-    trimmed.remove_prefix(1);
-    if (trimmed.empty())
-    {
-      return std::nullopt;
-    }
+    str.remove_suffix(1);
   }
+  return str;
+}
 
-  int result = 0;
-  auto [ptr, ec] =
-      std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), result);
+} // namespace
 
-  if (ec == std::errc{} && ptr == trimmed.data() + trimmed.size())
-  {
-    return result;
-  }
-  return std::nullopt;
+std::optional<int> to_int(std::string_view str)
+{
+  return detail::parse_integer<int>(trim_number(str));
 }
 
 std::optional<int> to_int(std::string_view str, int base)
@@ -1284,214 +1487,100 @@ std::optional<int> to_int(std::string_view str, int base)
 
 std::optional<long> to_long(std::string_view str)
 {
-  if (str.empty())
-  {
-    return std::nullopt;
-  }
-
-  std::string_view trimmed = str;
-  while (!trimmed.empty() && is_whitespace(trimmed.front()))
-  {
-    trimmed.remove_prefix(1);
-  }
-  while (!trimmed.empty() && is_whitespace(trimmed.back()))
-  {
-    trimmed.remove_suffix(1);
-  }
-
-  if (trimmed.empty())
-  {
-    return std::nullopt;
-  }
-
-  long result = 0;
-  auto [ptr, ec] =
-      std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), result);
-
-  if (ec == std::errc{} && ptr == trimmed.data() + trimmed.size())
-  {
-    return result;
-  }
-  return std::nullopt;
+  return detail::parse_integer<long>(trim_number(str));
 }
 
 std::optional<long long> to_llong(std::string_view str)
 {
-  if (str.empty())
-  {
-    return std::nullopt;
-  }
-
-  std::string_view trimmed = str;
-  while (!trimmed.empty() && is_whitespace(trimmed.front()))
-  {
-    trimmed.remove_prefix(1);
-  }
-  while (!trimmed.empty() && is_whitespace(trimmed.back()))
-  {
-    trimmed.remove_suffix(1);
-  }
-
-  if (trimmed.empty())
-  {
-    return std::nullopt;
-  }
-
-  long long result = 0;
-  auto [ptr, ec] =
-      std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), result);
-
-  if (ec == std::errc{} && ptr == trimmed.data() + trimmed.size())
-  {
-    return result;
-  }
-  return std::nullopt;
+  return detail::parse_integer<long long>(trim_number(str));
 }
 
 std::optional<unsigned long> to_ulong(std::string_view str)
 {
-  if (str.empty())
-  {
-    return std::nullopt;
-  }
-
-  std::string_view trimmed = str;
-  while (!trimmed.empty() && is_whitespace(trimmed.front()))
-  {
-    trimmed.remove_prefix(1);
-  }
-  while (!trimmed.empty() && is_whitespace(trimmed.back()))
-  {
-    trimmed.remove_suffix(1);
-  }
-
-  if (trimmed.empty())
-  {
-    return std::nullopt;
-  }
-
-  // Reject negative numbers
-  if (trimmed[0] == '-')
-  {
-    return std::nullopt;
-  }
-
-  unsigned long result = 0;
-  auto [ptr, ec] =
-      std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), result);
-
-  if (ec == std::errc{} && ptr == trimmed.data() + trimmed.size())
-  {
-    return result;
-  }
-  return std::nullopt;
+  return detail::parse_integer<unsigned long>(trim_number(str));
 }
 
 std::optional<unsigned long long> to_ullong(std::string_view str)
 {
-  if (str.empty())
-  {
-    return std::nullopt;
-  }
-
-  std::string_view trimmed = str;
-  while (!trimmed.empty() && is_whitespace(trimmed.front()))
-  {
-    trimmed.remove_prefix(1);
-  }
-  while (!trimmed.empty() && is_whitespace(trimmed.back()))
-  {
-    trimmed.remove_suffix(1);
-  }
-
-  if (trimmed.empty())
-  {
-    return std::nullopt;
-  }
-
-  // Reject negative numbers
-  if (trimmed[0] == '-')
-  {
-    return std::nullopt;
-  }
-
-  unsigned long long result = 0;
-  auto [ptr, ec] =
-      std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), result);
-
-  if (ec == std::errc{} && ptr == trimmed.data() + trimmed.size())
-  {
-    return result;
-  }
-  return std::nullopt;
+  return detail::parse_integer<unsigned long long>(trim_number(str));
 }
 
 std::optional<float> to_float(std::string_view str)
 {
-  if (str.empty())
-  {
-    return std::nullopt;
-  }
+  return detail::parse_float<float>(trim_number(str));
+}
 
-  std::string_view trimmed = str;
-  while (!trimmed.empty() && is_whitespace(trimmed.front()))
-  {
-    trimmed.remove_prefix(1);
-  }
-  while (!trimmed.empty() && is_whitespace(trimmed.back()))
+std::optional<double> to_double(std::string_view str)
+{
+  return detail::parse_float<double>(trim_number(str));
+}
+
+std::optional<std::int64_t> detail::parse_decimal(std::string_view str, int scale) noexcept
+{
+  str = trim_number(str);
+  bool negative = false;
+  if (!str.empty() && (str.front() == '+' || str.front() == '-'))
   {
-    trimmed.remove_suffix(1);
+    negative = str.front() == '-';
+    str.remove_prefix(1);
   }
 
-  if (trimmed.empty())
+  const std::size_t point       = str.find('.');
+  const std::string_view whole  = str.substr(0, point);
+  std::string_view fraction     = point == std::string_view::npos ? std::string_view() : str.substr(point + 1);
+  if (whole.empty() && fraction.empty())
   {
     return std::nullopt;
   }
 
-  // Use std::from_chars if available for floats (C++17 doesn't guarantee it)
-  // Fall back to strtof for compatibility
-  std::string temp_str(trimmed);
-  char* end       = nullptr;
-  float result    = std::strtof(temp_str.c_str(), &end);
-
-  if (end == temp_str.c_str() + temp_str.size())
+  // Digits past the scale must be zeros: the value has to be exact
+  const auto scale_digits = static_cast<std::size_t>(scale);
+  if (fraction.size() > scale_digits)
   {
-    return result;
+    if (fraction.substr(scale_digits).find_first_not_of('0') != std::string_view::npos)
+    {
+      return std::nullopt;
+    }
+    fraction = fraction.substr(0, scale_digits);
   }
-  return std::nullopt;
-}
 
-std::optional<double> to_double(std::string_view str)
-{
-  if (str.empty())
+  std::uint64_t integer_part = 0;
+  if (!whole.empty())
   {
-    return std::nullopt;
+    const std::optional<std::uint64_t> parsed = detail::parse_decimal_digits(whole);
+    if (!parsed)
+    {
+      return std::nullopt;
+    }
+    integer_part = *parsed;
   }
-
-  std::string_view trimmed = str;
-  while (!trimmed.empty() && is_whitespace(trimmed.front()))
+  std::uint64_t fraction_part = 0;
+  if (!fraction.empty())
   {
-    trimmed.remove_prefix(1);
+    const std::optional<std::uint64_t> parsed = detail::parse_decimal_digits(fraction);
+    if (!parsed)
+    {
+      return std::nullopt;
+    }
+    fraction_part = *parsed;
   }
-  while (!trimmed.empty() && is_whitespace(trimmed.back()))
+  for (std::size_t i = fraction.size(); i < scale_digits; ++i)
   {
-    trimmed.remove_suffix(1);
+    fraction_part *= 10;
   }
 
-  if (trimmed.empty())
+  std::uint64_t unit = 1;
+  for (int i = 0; i < scale; ++i)
   {
-    return std::nullopt;
+    unit *= 10;
   }
-
-  std::string temp_str(trimmed);
-  char* end       = nullptr;
-  double result   = std::strtod(temp_str.c_str(), &end);
-
-  if (end == temp_str.c_str() + temp_str.size())
+  const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + (negative ? 1 : 0);
+  if (integer_part > (limit - fraction_part) / unit)
   {
-    return result;
+    return std::nullopt;
   }
-  return std::nullopt;
+  const std::uint64_t magnitude = integer_part * unit + fraction_part;
+  return static_cast<std::int64_t>(negative ? 0 - magnitude : magnitude);
 }
 
 // ============================================================================
@@ -1510,39 +1599,10 @@ std::string from_int(int value, int base, bool uppercase)
     return std::string();
   }
 
-  if (value == 0)
-  {
-    return "0";
-  }
-
-  bool negative = value < 0;
-  unsigned int abs_value =
-      negative ? static_cast<unsigned int>(-static_cast<long>(value))
-               : static_cast<unsigned int>(value);
-
-  std::string result;
-  while (abs_value > 0)
-  {
-    int digit = static_cast<int>(abs_value % static_cast<unsigned int>(base));
-    if (digit < 10)
-    {
-      result.push_back(static_cast<char>('0' + digit));
-    }
-    else
-    {
-      result.push_back(
-          static_cast<char>((uppercase ? 'A' : 'a') + digit - 10));
-    }
-    abs_value /= static_cast<unsigned int>(base);
-  }
-
-  if (negative)
-  {
-    result.push_back('-');
-  }
-
-  std::reverse(result.begin(), result.end());
-  return result;
+  // 32 binary digits and a sign
+  char buffer[33];
+  char* end = detail::integer_to_chars(buffer, buffer + sizeof(buffer), value, base, uppercase);
+  return std::string(buffer, end);
 }
 
 std::string from_long(long value)
@@ -1550,267 +1610,104 @@ std::string from_long(long value)
   return std::to_string(value);
 }
 
-std::string from_double(double value, int precision)
-{
-  std::ostringstream oss;
-  oss << std::setprecision(precision) << value;
-  return oss.str();
-}
-
-std::string from_double_fixed(double value, int precision)
-{
-  std::ostringstream oss;
-  oss << std::fixed << std::setprecision(precision) << value;
-  return oss.str();
-}
-
-std::string from_double_scientific(double value, int precision)
+namespace
 {
-  std::ostringstream oss;
-  oss << std::scientific << std::setprecision(precision) << value;
-  return oss.str();
-}
-
-// ============================================================================
-// Encoding and Decoding
-// ============================================================================
 
-std::string to_hex(std::string_view data, bool uppercase)
+std::string float_to_string(double value, detail::float_notation notation, int precision)
 {
-  std::string result;
-  result.reserve(data.size() * 2);
-  for (unsigned char ch : data)
+  char buffer[64];
+  if (char* end = detail::float_to_chars(buffer, buffer + sizeof(buffer), value, notation, precision))
   {
-    result.push_back(hex_char(ch >> 4, uppercase));
-    result.push_back(hex_char(ch & 0x0F, uppercase));
+    return std::string(buffer, end);
   }
+
+  // Fixed notation of large values, or long precisions
+  std::string result(detail::FIXED_FLOAT_CHARS + static_cast<std::size_t>(precision < 0 ? 6 : precision),
+                     '\0');
+  char* first = &result[0];
+  char* end   = detail::float_to_chars(first, first + result.size(), value, notation, precision);
+  result.resize(end != nullptr ? static_cast<std::size_t>(end - first) : 0);
   return result;
 }
 
-std::optional<std::string> from_hex(std::string_view hex)
-{
-  std::string_view input = hex;
-
-  // Skip 0x prefix
-  if (input.size() >= 2 && input[0] == '0' &&
-      (input[1] == 'x' || input[1] == 'X'))
-  {
-    input = input.substr(2);
-  }
-
-  if (input.size() % 2 != 0)
-  {
-    return std::nullopt;
-  }
-
-  std::string result;
-  result.reserve(input.size() / 2);
-
-  for (size_t i = 0; i < input.size(); i += 2)
-  {
-    int high = hex_value(input[i]);
-    int low  = hex_value(input[i + 1]);
-    if (high < 0 || low < 0)
-    {
-      return std::nullopt;
-    }
-    result.push_back(static_cast<char>((high << 4) | low));
-  }
+} // namespace
 
-  return result;
+std::string from_double(double value, int precision)
+{
+  return float_to_string(value, detail::float_notation::general, precision);
 }
 
-std::string to_base64(std::string_view data)
+std::string from_double_fixed(double value, int precision)
 {
-  std::string result;
-  result.reserve((data.size() + 2) / 3 * 4);
-
-  size_t i = 0;
-  while (i + 2 < data.size())
-  {
-    uint32_t triple =
-        (static_cast<unsigned char>(data[i]) << 16) |
-        (static_cast<unsigned char>(data[i + 1]) << 8) |
-        static_cast<unsigned char>(data[i + 2]);
-
-    result.push_back(BASE64_CHARS[(triple >> 18) & 0x3F]);
-    result.push_back(BASE64_CHARS[(triple >> 12) & 0x3F]);
-    result.push_back(BASE64_CHARS[(triple >> 6) & 0x3F]);
-    result.push_back(BASE64_CHARS[triple & 0x3F]);
-    i += 3;
-  }
-
-  if (i < data.size())
-  {
-    uint32_t triple = static_cast<unsigned char>(data[i]) << 16;
-    if (i + 1 < data.size())
-    {
-      triple |= static_cast<unsigned char>(data[i + 1]) << 8;
-    }
-
-    result.push_back(BASE64_CHARS[(triple >> 18) & 0x3F]);
-    result.push_back(BASE64_CHARS[(triple >> 12) & 0x3F]);
-
-    if (i + 1 < data.size())
-    {
-      result.push_back(BASE64_CHARS[(triple >> 6) & 0x3F]);
-    }
-    else
-    {
-      result.push_back('=');
-    }
-    result.push_back('=');
-  }
+  return float_to_string(value, detail::float_notation::fixed, precision);
+}
 
-  return result;
+std::string from_double_scientific(double value, int precision)
+{
+  return float_to_string(value, detail::float_notation::scientific, precision);
 }
 
-std::optional<std::string> from_base64(std::string_view base64)
+// ============================================================================
+// Encoding and Decoding
+// ============================================================================
+
+std::string to_hex(std::string_view data, bool uppercase)
 {
-  if (base64.empty())
-  {
-    return std::string();
-  }
+  std::string result(hex_encoded_size(data.size()), '\0');
+  hex_encode(data, result.data(), uppercase);
+  return result;
+}
 
-  // Remove whitespace and validate length
-  std::string clean;
-  clean.reserve(base64.size());
-  for (char ch : base64)
+std::optional<std::string> from_hex(std::string_view hex)
+{
+  // Skip 0x prefix
+  if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X'))
   {
-    if (!is_whitespace(ch))
-    {
-      clean.push_back(ch);
-    }
+    hex.remove_prefix(2);
   }
 
-  if (clean.size() % 4 != 0)
+  std::string result(hex.size() / 2, '\0');
+  if (!hex_decode(hex, result.data()))
   {
     return std::nullopt;
   }
-
-  std::string result;
-  result.reserve(clean.size() / 4 * 3);
-
-  for (size_t i = 0; i < clean.size(); i += 4)
-  {
-    int v0 = base64_index(clean[i]);
-    int v1 = base64_index(clean[i + 1]);
-    int v2 = clean[i + 2] == '=' ? 0 : base64_index(clean[i + 2]);
-    int v3 = clean[i + 3] == '=' ? 0 : base64_index(clean[i + 3]);
-
-    if (v0 < 0 || v1 < 0 || (clean[i + 2] != '=' && v2 < 0) ||
-        (clean[i + 3] != '=' && v3 < 0))
-    {
-      return std::nullopt;
-    }
-
-    uint32_t triple = (static_cast<uint32_t>(v0) << 18) |
-                      (static_cast<uint32_t>(v1) << 12) |
-                      (static_cast<uint32_t>(v2) << 6) |
-                      static_cast<uint32_t>(v3);
-
-    result.push_back(static_cast<char>((triple >> 16) & 0xFF));
-    if (clean[i + 2] != '=')
-    {
-      result.push_back(static_cast<char>((triple >> 8) & 0xFF));
-    }
-    if (clean[i + 3] != '=')
-    {
-      result.push_back(static_cast<char>(triple & 0xFF));
-    }
-  }
-
   return result;
 }
 
-std::string url_encode(std::string_view str)
+std::string to_base64(std::string_view data)
 {
-  std::string result;
-  result.reserve(str.size() * 3); // Worst case
+  return to_base64(data, base64_alphabet::standard);
+}
 
-  for (unsigned char ch : str)
-  {
-    if (is_ascii_alpha(static_cast<char>(ch)) || is_ascii_digit(static_cast<char>(ch)) ||
-        ch == '-' || ch == '_' || ch == '.' || ch == '~')
-    {
-      result.push_back(static_cast<char>(ch));
-    }
-    else
-    {
-      result.push_back('%');
-      result.push_back(hex_char(ch >> 4, true));
-      result.push_back(hex_char(ch & 0x0F, true));
-    }
-  }
+std::optional<std::string> from_base64(std::string_view base64)
+{
+  return from_base64(base64, base64_alphabet::standard);
+}
 
+std::string url_encode(std::string_view str)
+{
+  std::string result(percent_encoded_max_size(str.size()), '\0');
+  result.resize(percent_encode(str, result.data()));
   return result;
 }
 
 std::optional<std::string> url_decode(std::string_view str)
 {
-  std::string result;
-  result.reserve(str.size());
-
-  for (size_t i = 0; i < str.size(); ++i)
+  std::string result(str.size(), '\0');
+  const std::optional<std::size_t> size = percent_decode(str, result.data());
+  if (!size)
   {
-    if (str[i] == '%')
-    {
-      if (i + 2 >= str.size())
-      {
-        return std::nullopt;
-      }
-      int high = hex_value(str[i + 1]);
-      int low  = hex_value(str[i + 2]);
-      if (high < 0 || low < 0)
-      {
-        return std::nullopt;
-      }
-      result.push_back(static_cast<char>((high << 4) | low));
-      i += 2;
-    }
-    else if (str[i] == '+')
-    {
-      result.push_back(' ');
-    }
-    else
-    {
-      result.push_back(str[i]);
-    }
+    return std::nullopt;
   }
-
+  result.resize(*size);
   return result;
 }
 
 std::string html_escape(std::string_view str)
 {
   std::string result;
-  result.reserve(str.size() * 2);
-
-  for (char ch : str)
-  {
-    switch (ch)
-    {
-    case '&':
-      result.append("&amp;");
-      break;
-    case '<':
-      result.append("&lt;");
-      break;
-    case '>':
-      result.append("&gt;");
-      break;
-    case '"':
-      result.append("&quot;");
-      break;
-    case '\'':
-      result.append("&#39;");
-      break;
-    default:
-      result.push_back(ch);
-      break;
-    }
-  }
-
+  result.reserve(str.size());
+  append_html_escaped(result, str);
   return result;
 }
 
@@ -1870,48 +1767,8 @@ std::string html_unescape(std::string_view str)
 std::string json_escape(std::string_view str)
 {
   std::string result;
-  result.reserve(str.size() * 2);
-
-  for (unsigned char ch : str)
-  {
-    switch (ch)
-    {
-    case '"':
-      result.append("\\\"");
-      break;
-    case '\\':
-      result.append("\\\\");
-      break;
-    case '\b':
-      result.append("\\b");
-      break;
-    case '\f':
-      result.append("\\f");
-      break;
-    case '\n':
-      result.append("\\n");
-      break;
-    case '\r':
-      result.append("\\r");
-      break;
-    case '\t':
-      result.append("\\t");
-      break;
-    default:
-      if (ch < 0x20)
-      {
-        result.append("\\u00");
-        result.push_back(hex_char(ch >> 4, false));
-        result.push_back(hex_char(ch & 0x0F, false));
-      }
-      else
-      {
-        result.push_back(static_cast<char>(ch));
-      }
-      break;
-    }
-  }
-
+  result.reserve(str.size());
+  append_json_escaped(result, str);
   return result;
 }
 
@@ -2031,18 +1888,7 @@ int compare_ignore_case(std::string_view a, std::string_view b)
 
 bool equals_ignore_case(std::string_view a, std::string_view b)
 {
-  if (a.size() != b.size())
-  {
-    return false;
-  }
-  for (size_t i = 0; i < a.size(); ++i)
-  {
-    if (to_ascii_lower(a[i]) != to_ascii_lower(b[i]))
-    {
-      return false;
-    }
-  }
-  return true;
+  return simd::equals_ignore_case(a, b);
 }
 
 int natural_compare(std::string_view a, std::string_view b)
@@ -2137,74 +1983,85 @@ std::string reverse(std::string_view str)
 
 std::string squeeze(std::string_view str)
 {
-  if (str.empty())
+  std::string result(str);
+  squeeze_inplace(result);
+  return result;
+}
+
+std::string squeeze(std::string_view str, char ch)
+{
+  std::string result(str);
+  squeeze_inplace(result, ch);
+  return result;
+}
+
+void squeeze_inplace(std::string& str)
+{
+  if (str.size() < 2)
   {
-    return std::string();
+    return;
   }
-  std::string result;
-  result.reserve(str.size());
-  result.push_back(str[0]);
+  // str[out - 1] is the last character kept, equal to the last one read
+  size_t out = 1;
   for (size_t i = 1; i < str.size(); ++i)
   {
-    if (str[i] != str[i - 1])
+    if (str[i] != str[out - 1])
     {
-      result.push_back(str[i]);
+      str[out++] = str[i];
     }
   }
-  return result;
+  str.resize(out);
 }
 
-std::string squeeze(std::string_view str, char ch)
+void squeeze_inplace(std::string& str, char ch)
 {
-  if (str.empty())
+  if (str.size() < 2)
   {
-    return std::string();
+    return;
   }
-  std::string result;
-  result.reserve(str.size());
-  result.push_back(str[0]);
+  size_t out = 1;
   for (size_t i = 1; i < str.size(); ++i)
   {
-    if (str[i] != ch || str[i - 1] != ch)
+    if (str[i] != ch || str[out - 1] != ch)
     {
-      result.push_back(str[i]);
+      str[out++] = str[i];
     }
   }
-  return result;
+  str.resize(out);
 }
 
 std::string normalize_whitespace(std::string_view str)
 {
-  std::string result;
-  result.reserve(str.size());
-  bool in_whitespace = false;
-  bool started       = false;
+  std::string result(str);
+  normalize_whitespace_inplace(result);
+  return result;
+}
 
-  for (char ch : str)
+void normalize_whitespace_inplace(std::string& str)
+{
+  size_t out           = 0;
+  bool   in_whitespace = false;
+
+  for (size_t i = 0; i < str.size(); ++i)
   {
-    if (is_whitespace(ch))
+    if (!is_whitespace(str[i]))
     {
-      if (started && !in_whitespace)
-      {
-        result.push_back(' ');
-        in_whitespace = true;
-      }
+      str[out++]    = str[i];
+      in_whitespace = false;
     }
-    else
+    else if (out > 0 && !in_whitespace)
     {
-      result.push_back(ch);
-      in_whitespace = false;
-      started       = true;
+      str[out++]    = ' ';
+      in_whitespace = true;
     }
   }
 
   // Remove trailing space
-  if (!result.empty() && result.back() == ' ')
+  if (in_whitespace)
   {
-    result.pop_back();
+    --out;
   }
-
-  return result;
+  str.resize(out);
 }
 
 std::string word_wrap(std::string_view str, size_t width, bool break_words)
@@ -2400,35 +2257,12 @@ std::string common_suffix(std::string_view a, std::string_view b)
 
 size_t levenshtein_distance(std::string_view a, std::string_view b)
 {
-  if (a.empty())
-  {
-    return b.size();
-  }
-  if (b.empty())
-  {
-    return a.size();
-  }
-
-  std::vector<size_t> prev(b.size() + 1);
-  std::vector<size_t> curr(b.size() + 1);
-
-  for (size_t j = 0; j <= b.size(); ++j)
-  {
-    prev[j] = j;
-  }
-
-  for (size_t i = 1; i <= a.size(); ++i)
-  {
-    curr[0] = i;
-    for (size_t j = 1; j <= b.size(); ++j)
-    {
-      size_t cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
-      curr[j] = std::min({prev[j] + 1, curr[j - 1] + 1, prev[j - 1] + cost});
-    }
-    std::swap(prev, curr);
-  }
+  return detail::edit_distance(a, b);
+}
 
-  return prev[b.size()];
+size_t levenshtein_distance(std::string_view a, std::string_view b, size_t max_distance)
+{
+  return detail::edit_distance(a, b, std::min(max_distance, detail::UNBOUNDED_DISTANCE));
 }
 
 // ============================================================================
@@ -2438,53 +2272,51 @@ size_t levenshtein_distance(std::string_view a, std::string_view b)
 namespace
 {
 
-// Helper to split string into words for case conversion
-std::vector<std::string> split_into_words(std::string_view str)
+/// Calls @p emit with each word of @p str, for case conversion. Words are
+/// split at ' ', '_' and '-', and at camelCase boundaries.
+template <typename Emit>
+void for_each_word(std::string_view str, Emit&& emit)
 {
-  std::vector<std::string> words;
-  std::string              current_word;
-
+  size_t start = 0;
   for (size_t i = 0; i < str.size(); ++i)
   {
-    char ch = str[i];
+    const char ch = str[i];
 
     // Separators: space, underscore, hyphen
     if (ch == ' ' || ch == '_' || ch == '-')
     {
-      if (!current_word.empty())
+      if (i > start)
       {
-        words.push_back(std::move(current_word));
-        current_word.clear();
+        emit(str.substr(start, i - start));
       }
+      start = i + 1;
       continue;
     }
 
-    // Check for camelCase/PascalCase boundary
-    if (is_ascii_upper(ch))
+    // A lowercase letter followed by an uppercase one ends a word, and so
+    // does an uppercase run followed by lowercase (HTTPServer -> HTTP, Server)
+    if (is_ascii_upper(ch) && i > start)
     {
-      // If we have accumulated lowercase letters, this is a word boundary
-      if (!current_word.empty() && is_ascii_lower(current_word.back()))
+      const char last = str[i - 1];
+      if (is_ascii_lower(last) ||
+          (is_ascii_upper(last) && i + 1 < str.size() && is_ascii_lower(str[i + 1])))
       {
-        words.push_back(std::move(current_word));
-        current_word.clear();
-      }
-      // Check for consecutive uppercase followed by lowercase (e.g., HTTPServer -> HTTP, Server)
-      else if (!current_word.empty() && is_ascii_upper(current_word.back()) && i + 1 < str.size() &&
-               is_ascii_lower(str[i + 1]))
-      {
-        words.push_back(std::move(current_word));
-        current_word.clear();
+        emit(str.substr(start, i - start));
+        start = i;
       }
     }
-
-    current_word.push_back(ch);
   }
 
-  if (!current_word.empty())
+  if (str.size() > start)
   {
-    words.push_back(std::move(current_word));
+    emit(str.substr(start));
   }
+}
 
+std::vector<std::string_view> split_into_words(std::string_view str)
+{
+  std::vector<std::string_view> words;
+  for_each_word(str, [&words](std::string_view word) { words.push_back(word); });
   return words;
 }
 
@@ -2492,27 +2324,61 @@ std::vector<std::string> split_into_words(std::string_view str)
 
 std::string to_snake_case(std::string_view str)
 {
-  auto words = split_into_words(str);
-  if (words.empty())
-  {
-    return std::string();
-  }
-
   std::string result;
-  for (size_t i = 0; i < words.size(); ++i)
-  {
-    if (i > 0)
-    {
-      result.push_back('_');
-    }
-    for (char ch : words[i])
-    {
-      result.push_back(to_ascii_lower(ch));
-    }
-  }
+  result.reserve(str.size() + str.size() / 4);
+  for_each_word(str,
+                [&result](std::string_view word)
+                {
+                  if (!result.empty())
+                  {
+                    result.push_back('_');
+                  }
+                  for (char ch : word)
+                  {
+                    result.push_back(to_ascii_lower(ch));
+                  }
+                });
   return result;
 }
 
+void to_snake_case_inplace(std::string& str)
+{
+  // Each word is written at or before where it was read, unless a camelCase
+  // boundary adds a separator that the input did not have
+  size_t out  = 0;
+  bool   fits = true;
+  for_each_word(str,
+                [&](std::string_view word)
+                {
+                  out += out > 0 ? 1 : 0;
+                  fits = fits && out <= static_cast<size_t>(word.data() - str.data());
+                  out += word.size();
+                });
+  if (!fits)
+  {
+    str = to_snake_case(str);
+    return;
+  }
+
+  // The walker only looks at characters from the current word on, all at or
+  // after the write position
+  char* data = str.data();
+  out        = 0;
+  for_each_word(str,
+                [&](std::string_view word)
+                {
+                  if (out > 0)
+                  {
+                    data[out++] = '_';
+                  }
+                  for (char ch : word)
+                  {
+                    data[out++] = to_ascii_lower(ch);
+                  }
+                });
+  str.resize(out);
+}
+
 std::string to_camel_case(std::string_view str)
 {
   auto words = split_into_words(str);
@@ -2733,7 +2599,7 @@ bool fuzzy_match(std::string_view str,
                  std::string_view target,
                  size_t max_distance)
 {
-  return levenshtein_distance(str, target) <= max_distance;
+  return levenshtein_distance(str, target, max_distance) <= max_distance;
 }
 
 // ============================================================================
@@ -2742,23 +2608,12 @@ bool fuzzy_match(std::string_view str,
 
 size_t word_count(std::string_view str)
 {
-  size_t count        = 0;
-  bool   in_word      = false;
-
-  for (char ch : str)
-  {
-    if (is_whitespace(ch))
-    {
-      in_word = false;
-    }
-    else if (!in_word)
-    {
-      ++count;
-      in_word = true;
-    }
-  }
+  return simd::count_words(str);
+}
 
-  return count;
+size_t line_count(std::string_view str)
+{
+  return simd::count_lines(str);
 }
 
 std::string expand_tabs(std::string_view str, size_t tab_width)
@@ -2795,6 +2650,18 @@ std::string expand_tabs(std::string_view str, size_t tab_width)
   return result;
 }
 
+void expand_tabs_inplace(std::string& str, size_t tab_width)
+{
+  if (tab_width == 0)
+  {
+    remove_all_inplace(str, '\t');
+  }
+  else if (str.find('\t') != std::string::npos)
+  {
+    str = expand_tabs(str, tab_width);
+  }
+}
+
 std::string normalize_line_endings(std::string_view str, std::string_view ending)
 {
   std::string result;
@@ -2824,6 +2691,75 @@ std::string normalize_line_endings(std::string_view str, std::string_view ending
   return result;
 }
 
+void normalize_line_endings_inplace(std::string& str, std::string_view ending)
+{
+  char*        data = str.data();
+  const size_t size = str.size();
+
+  // A line break is CRLF, CR or LF: it never gets longer with one character,
+  // so the text is rewritten front to back
+  if (ending.size() <= 1)
+  {
+    size_t out = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+      if (data[i] == '\r' || data[i] == '\n')
+      {
+        if (data[i] == '\r' && i + 1 < size && data[i + 1] == '\n')
+        {
+          ++i;
+        }
+        if (!ending.empty())
+        {
+          data[out++] = ending[0];
+        }
+      }
+      else
+      {
+        data[out++] = data[i];
+      }
+    }
+    str.resize(out);
+    return;
+  }
+
+  // A longer ending never makes a line break shorter: grow once, then fill
+  // back to front so the writes stay behind the unread text
+  size_t grown = size;
+  for (size_t i = 0; i < size; ++i)
+  {
+    if (data[i] == '\r' && i + 1 < size && data[i + 1] == '\n')
+    {
+      grown += ending.size() - 2;
+      ++i;
+    }
+    else if (data[i] == '\r' || data[i] == '\n')
+    {
+      grown += ending.size() - 1;
+    }
+  }
+
+  str.resize(grown);
+  data       = str.data();
+  size_t in  = size;
+  size_t out = grown;
+  while (in > 0)
+  {
+    const char ch = data[in - 1];
+    if (ch == '\n' || ch == '\r')
+    {
+      in -= (ch == '\n' && in >= 2 && data[in - 2] == '\r') ? 2 : 1;
+      out -= ending.size();
+      std::memcpy(data + out, ending.data(), ending.size());
+    }
+    else
+    {
+      data[--out] = ch;
+      --in;
+    }
+  }
+}
+
 bool is_palindrome(std::string_view str)
 {
   // Extract only alphanumeric characters in lowercase
@@ -2,6 +2,9 @@
 /// @brief Implementation of UTF-8 string manipulation utilities
 
 #include "fb/utf8_utils.h"
+#include "fb/simd_search.h"
+
+#include <algorithm>
 
 namespace fb
 {
@@ -110,6 +113,15 @@ bool is_valid_codepoint_sequence(const unsigned char* bytes, std::size_t length)
   return true;
 }
 
+/// @brief Byte offset of the code point after the one starting at @p i
+///
+/// An invalid or truncated sequence advances by one byte.
+std::size_t next_codepoint(std::string_view str, std::size_t i) noexcept
+{
+  auto cp_len = codepoint_byte_length(static_cast<unsigned char>(str[i]));
+  return cp_len == 0 || i + cp_len > str.size() ? i + 1 : i + cp_len;
+}
+
 } // namespace
 
 // ============================================================================
@@ -123,18 +135,8 @@ std::size_t utf8_length(std::string_view str) noexcept
 
   while (i < str.size())
   {
-    auto first_byte = static_cast<unsigned char>(str[i]);
-    auto cp_len     = codepoint_byte_length(first_byte);
-
-    if (cp_len == 0 || i + cp_len > str.size())
-    {
-      // Invalid or truncated sequence - count as 1
-      ++i;
-    }
-    else
-    {
-      i += cp_len;
-    }
+    // Invalid or truncated sequence - count as 1
+    i = next_codepoint(str, i);
     ++count;
   }
 
@@ -172,17 +174,7 @@ std::size_t utf8_byte_offset(std::string_view str, std::size_t codepoint_index)
 
   while (i < str.size() && cp_count < codepoint_index)
   {
-    auto first_byte = static_cast<unsigned char>(str[i]);
-    auto cp_len     = codepoint_byte_length(first_byte);
-
-    if (cp_len == 0 || i + cp_len > str.size())
-    {
-      ++i; // Skip invalid byte
-    }
-    else
-    {
-      i += cp_len;
-    }
+    i = next_codepoint(str, i);
     ++cp_count;
   }
 
@@ -206,17 +198,7 @@ std::size_t utf8_codepoint_index(std::string_view str, std::size_t byte_offset)
 
   while (i < byte_offset && i < str.size())
   {
-    auto first_byte = static_cast<unsigned char>(str[i]);
-    auto cp_len     = codepoint_byte_length(first_byte);
-
-    if (cp_len == 0 || i + cp_len > str.size())
-    {
-      ++i;
-    }
-    else
-    {
-      i += cp_len;
-    }
+    i = next_codepoint(str, i);
     ++cp_count;
   }
 
@@ -278,35 +260,7 @@ std::string utf8_mid(std::string_view str, std::size_t pos, std::size_t count)
 
 bool is_valid_utf8(std::string_view str) noexcept
 {
-  std::size_t i = 0;
-
-  while (i < str.size())
-  {
-    auto first_byte = static_cast<unsigned char>(str[i]);
-    auto cp_len     = codepoint_byte_length(first_byte);
-
-    if (cp_len == 0)
-    {
-      // Invalid leading byte
-      return false;
-    }
-
-    if (i + cp_len > str.size())
-    {
-      // Truncated sequence
-      return false;
-    }
-
-    // Validate the complete sequence
-    if (!is_valid_codepoint_sequence(reinterpret_cast<const unsigned char*>(str.data() + i), cp_len))
-    {
-      return false;
-    }
-
-    i += cp_len;
-  }
-
-  return true;
+  return simd::is_valid_utf8(str);
 }
 
 std::string sanitize_utf8(std::string_view str, char replacement)
@@ -361,4 +315,140 @@ std::string sanitize_utf8(std::string_view str, char replacement)
   return result;
 }
 
+// ============================================================================
+// Indexed View
+// ============================================================================
+
+utf8_indexed_view::utf8_indexed_view(std::string_view str)
+    : m_str(str)
+{
+  if (simd::is_ascii(str))
+  {
+    // Byte offsets are code point indices
+    m_length = str.size();
+    return;
+  }
+
+  m_checkpoints.reserve(str.size() / STRIDE + 1);
+  std::size_t i = 0;
+  while (i < str.size())
+  {
+    if (m_length % STRIDE == 0)
+    {
+      m_checkpoints.push_back(i);
+    }
+    i = next_codepoint(str, i);
+    ++m_length;
+  }
+  if (m_length % STRIDE == 0)
+  {
+    m_checkpoints.push_back(i);
+  }
+}
+
+std::size_t utf8_indexed_view::byte_offset(std::size_t codepoint_index) const noexcept
+{
+  if (codepoint_index > m_length)
+  {
+    return std::string::npos;
+  }
+  if (is_ascii())
+  {
+    return codepoint_index;
+  }
+
+  std::size_t i = m_checkpoints[codepoint_index / STRIDE];
+  for (std::size_t n = codepoint_index % STRIDE; n > 0; --n)
+  {
+    i = next_codepoint(m_str, i);
+  }
+  return i;
+}
+
+std::size_t utf8_indexed_view::codepoint_index(std::size_t byte_offset) const noexcept
+{
+  if (byte_offset > m_str.size())
+  {
+    return std::string::npos;
+  }
+  if (is_ascii())
+  {
+    return byte_offset;
+  }
+
+  // Last checkpoint at or before byte_offset; the first one is always 0
+  auto checkpoint = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), byte_offset) - 1;
+  std::size_t count = static_cast<std::size_t>(checkpoint - m_checkpoints.begin()) * STRIDE;
+  std::size_t i     = *checkpoint;
+  while (i < byte_offset && i < m_str.size())
+  {
+    i = next_codepoint(m_str, i);
+    ++count;
+  }
+  return count;
+}
+
+std::string_view utf8_indexed_view::at(std::size_t index) const noexcept
+{
+  if (index >= m_length)
+  {
+    return {};
+  }
+  std::size_t start = byte_offset(index);
+  return m_str.substr(start, next_codepoint(m_str, start) - start);
+}
+
+std::string_view utf8_indexed_view::substr(std::size_t pos, std::size_t count) const noexcept
+{
+  std::size_t start = byte_offset(pos);
+  if (start == std::string::npos)
+  {
+    return {};
+  }
+  if (count >= m_length - pos)
+  {
+    return m_str.substr(start);
+  }
+  return m_str.substr(start, byte_offset(pos + count) - start);
+}
+
+std::size_t utf8_length(const utf8_indexed_view& str) noexcept
+{
+  return str.length();
+}
+
+std::string utf8_at(const utf8_indexed_view& str, std::size_t index)
+{
+  return std::string(str.at(index));
+}
+
+std::string utf8_left(const utf8_indexed_view& str, std::size_t n)
+{
+  return std::string(str.substr(0, n));
+}
+
+std::string utf8_right(const utf8_indexed_view& str, std::size_t n)
+{
+  if (n >= str.length())
+  {
+    return std::string(str.str());
+  }
+  return std::string(str.substr(str.length() - n));
+}
+
+std::string utf8_mid(const utf8_indexed_view& str, std::size_t pos, std::size_t count)
+{
+  return std::string(str.substr(pos, count));
+}
+
+std::size_t utf8_byte_offset(const utf8_indexed_view& str, std::size_t codepoint_index) noexcept
+{
+  return str.byte_offset(codepoint_index);
+}
+
+std::size_t utf8_codepoint_index(const utf8_indexed_view& str, std::size_t byte_offset) noexcept
+{
+  return str.codepoint_index(byte_offset);
+}
+
 } // namespace fb
@@ -84,11 +84,16 @@ void run_benchmark(const std::string& name,
   // Benchmark fb::split
   double fb_time = benchmark([&]() { fb::split(test_str, ','); }, iterations);
 
+  // Benchmark fb::split_view into a reused vector
+  std::vector<std::string_view> views;
+  double view_time = benchmark([&]() { fb::split_view(test_str, ',', views); }, iterations);
+
   // Benchmark naive split
   double naive_time = benchmark([&]() { naive_split(test_str, ','); }, iterations);
 
   std::cout << std::fixed << std::setprecision(4);
   std::cout << "  fb::split:    " << std::setw(10) << fb_time << " ms/iter\n";
+  std::cout << "  split_view:   " << std::setw(10) << view_time << " ms/iter\n";
   std::cout << "  naive_split:  " << std::setw(10) << naive_time << " ms/iter\n";
   std::cout << "  Speedup:      " << std::setw(10) << (naive_time / fb_time)
             << "x\n";
@@ -0,0 +1,524 @@
+/// @file test_encoding.cpp
+/// @brief Unit tests for the buffer and streaming encoders
+
+#include <gtest/gtest.h>
+
+#include "fb/encoding.h"
+#include "fb/format.h"
+#include "fb/simd_search.h"
+#include "fb/string_utils.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fb::test
+{
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+/// Bit-by-bit Base64 encoding, independent of the kernels
+std::string reference_base64(std::string_view data, base64_alphabet alphabet, bool padding)
+{
+  const std::string chars = std::string("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789") +
+                            (alphabet == base64_alphabet::url ? "-_" : "+/");
+  std::string result;
+  std::uint32_t bits = 0;
+  int count          = 0;
+  for (unsigned char byte : data)
+  {
+    bits = bits << 8 | byte;
+    count += 8;
+    while (count >= 6)
+    {
+      count -= 6;
+      result.push_back(chars[(bits >> count) & 0x3F]);
+    }
+  }
+  if (count > 0)
+  {
+    result.push_back(chars[(bits << (6 - count)) & 0x3F]);
+  }
+  while (padding && result.size() % 4 != 0)
+  {
+    result.push_back('=');
+  }
+  return result;
+}
+
+/// Byte-by-byte JSON escaping, independent of the scan kernels
+std::string reference_json_escape(std::string_view str)
+{
+  std::string result;
+  for (unsigned char ch : str)
+  {
+    switch (ch)
+    {
+    case '"': result += "\\\""; break;
+    case '\\': result += "\\\\"; break;
+    case '\b': result += "\\b"; break;
+    case '\f': result += "\\f"; break;
+    case '\n': result += "\\n"; break;
+    case '\r': result += "\\r"; break;
+    case '\t': result += "\\t"; break;
+    default:
+      if (ch < 0x20)
+      {
+        char escape[8];
+        std::snprintf(escape, sizeof(escape), "\\u%04x", ch);
+        result += escape;
+      }
+      else
+      {
+        result.push_back(static_cast<char>(ch));
+      }
+    }
+  }
+  return result;
+}
+
+/// Mostly plain text with a special character now and then, like real payloads
+std::string random_text(std::mt19937& rng, std::size_t size, std::string_view specials)
+{
+  std::uniform_int_distribution<int> printable(0x20, 0x7E);
+  std::uniform_int_distribution<int> roll(0, 15);
+  std::uniform_int_distribution<std::size_t> pick(0, specials.size() - 1);
+  std::string result(size, '\0');
+  for (char& ch : result)
+  {
+    ch = roll(rng) == 0 ? specials[pick(rng)] : static_cast<char>(printable(rng));
+  }
+  return result;
+}
+
+std::string random_bytes(std::mt19937& rng, std::size_t size)
+{
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::string result(size, '\0');
+  for (char& ch : result)
+  {
+    ch = static_cast<char>(byte(rng));
+  }
+  return result;
+}
+
+/// Split @p str into chunks of random sizes, empty ones included
+std::vector<std::string_view> random_chunks(std::mt19937& rng, std::string_view str)
+{
+  std::uniform_int_distribution<std::size_t> size(0, 40);
+  std::vector<std::string_view> result;
+  while (!str.empty())
+  {
+    std::string_view chunk = str.substr(0, size(rng));
+    result.push_back(chunk);
+    str.remove_prefix(chunk.size());
+  }
+  return result;
+}
+
+/// Runs each test body once per available instruction set
+class EncodingTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_original = simd::active_isa();
+    for (simd::isa target : {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2, simd::isa::neon})
+    {
+      if (simd::select_isa(target))
+      {
+        m_isas.push_back(target);
+      }
+    }
+    simd::select_isa(m_original);
+  }
+
+  void TearDown() override
+  {
+    simd::select_isa(m_original);
+  }
+
+  template<typename Body>
+  void for_each_isa(Body&& body)
+  {
+    for (simd::isa target : m_isas)
+    {
+      ASSERT_TRUE(simd::select_isa(target));
+      SCOPED_TRACE(simd::isa_name(target));
+      body();
+    }
+  }
+
+  simd::isa m_original = simd::isa::scalar;
+  std::vector<simd::isa> m_isas;
+};
+
+// ============================================================================
+// Hex Tests
+// ============================================================================
+
+TEST_F(EncodingTest, HexEncode_MatchesReference)
+{
+  std::mt19937 rng(42);
+  const std::string data = random_bytes(rng, 300);
+  for_each_isa([&data] {
+    for (std::size_t size = 0; size <= data.size(); ++size)
+    {
+      std::string_view input(data.data(), size);
+      std::string expected;
+      std::string expected_upper;
+      for (unsigned char byte : input)
+      {
+        expected += "0123456789abcdef"[byte >> 4];
+        expected += "0123456789abcdef"[byte & 0x0F];
+        expected_upper += "0123456789ABCDEF"[byte >> 4];
+        expected_upper += "0123456789ABCDEF"[byte & 0x0F];
+      }
+
+      std::string out(hex_encoded_size(size), '\0');
+      ASSERT_EQ(hex_encode(input, out.data()), out.size());
+      ASSERT_EQ(out, expected) << "size " << size;
+      hex_encode(input, out.data(), true);
+      ASSERT_EQ(out, expected_upper) << "size " << size;
+
+      std::string decoded(size, '\0');
+      ASSERT_EQ(hex_decode(expected_upper, decoded.data()), size);
+      ASSERT_EQ(decoded, input);
+    }
+  });
+}
+
+TEST_F(EncodingTest, HexDecode_InvalidAtEveryPosition)
+{
+  const std::string valid = to_hex(std::string(100, '\x5a'));
+  for_each_isa([&valid] {
+    char out[100];
+    ASSERT_EQ(hex_decode(valid, out), 100u);
+    for (std::size_t i = 0; i < valid.size(); ++i)
+    {
+      for (char bad : {'g', 'G', '/', ':', '@', '`', ' ', '\x80', '\xc6'})
+      {
+        std::string input = valid;
+        input[i]          = bad;
+        ASSERT_FALSE(hex_decode(input, out)) << "position " << i << " char " << int(bad);
+      }
+    }
+    EXPECT_FALSE(hex_decode("abc", out));
+    EXPECT_FALSE(hex_decode("0x41", out));
+  });
+}
+
+TEST_F(EncodingTest, HexDecoder_SplitDigits)
+{
+  std::mt19937 rng(7);
+  const std::string data = random_bytes(rng, 500);
+  const std::string hex  = to_hex(data);
+  for_each_isa([&] {
+    for (int round = 0; round < 20; ++round)
+    {
+      hex_decoder decoder;
+      std::string out;
+      for (std::string_view chunk : random_chunks(rng, hex))
+      {
+        ASSERT_TRUE(decoder.update(chunk, out));
+      }
+      ASSERT_TRUE(decoder.finish());
+      ASSERT_EQ(out, data);
+    }
+  });
+}
+
+TEST_F(EncodingTest, HexDecoder_Failures)
+{
+  hex_decoder decoder;
+  std::string out;
+  EXPECT_TRUE(decoder.update("41", out));
+  EXPECT_TRUE(decoder.finish());
+  EXPECT_EQ(out, "A");
+
+  // finish() starts over
+  EXPECT_TRUE(decoder.update("4", out));
+  EXPECT_FALSE(decoder.finish());
+  EXPECT_FALSE(decoder.update("41", out));
+
+  hex_decoder other;
+  EXPECT_FALSE(other.update("4x", out));
+  EXPECT_FALSE(other.update("41", out));
+  EXPECT_FALSE(other.finish());
+  EXPECT_EQ(out, "A");
+}
+
+// ============================================================================
+// Base64 Tests
+// ============================================================================
+
+TEST_F(EncodingTest, Base64_KnownValues)
+{
+  for_each_isa([] {
+    EXPECT_EQ(to_base64("", base64_alphabet::standard), "");
+    EXPECT_EQ(to_base64("f", base64_alphabet::standard), "Zg==");
+    EXPECT_EQ(to_base64("fo", base64_alphabet::standard), "Zm8=");
+    EXPECT_EQ(to_base64("foo", base64_alphabet::standard), "Zm9v");
+    EXPECT_EQ(to_base64("foobar", base64_alphabet::standard), "Zm9vYmFy");
+    EXPECT_EQ(to_base64("fo", base64_alphabet::standard, false), "Zm8");
+    EXPECT_EQ(to_base64("\xfb\xff", base64_alphabet::standard), "+/8=");
+    EXPECT_EQ(to_base64("\xfb\xff", base64_alphabet::url), "-_8=");
+
+    EXPECT_EQ(from_base64("Zm8=", base64_alphabet::standard), "fo");
+    EXPECT_EQ(from_base64("Zm8", base64_alphabet::standard, false), "fo");
+    EXPECT_EQ(from_base64("-_8=", base64_alphabet::url), "\xfb\xff");
+    EXPECT_FALSE(from_base64("+/8=", base64_alphabet::url));
+    EXPECT_FALSE(from_base64("-_8=", base64_alphabet::standard));
+  });
+}
+
+TEST_F(EncodingTest, Base64_RoundTripAllSizes)
+{
+  std::mt19937 rng(1);
+  const std::string data = random_bytes(rng, 400);
+  for_each_isa([&data] {
+    for (base64_alphabet alphabet : {base64_alphabet::standard, base64_alphabet::url})
+    {
+      for (bool padding : {true, false})
+      {
+        for (std::size_t offset = 0; offset < 4; ++offset)
+        {
+          for (std::size_t size = 0; size + offset <= data.size(); ++size)
+          {
+            std::string_view input(data.data() + offset, size);
+            const std::string expected = reference_base64(input, alphabet, padding);
+
+            std::string encoded(base64_encoded_size(size, padding), '\0');
+            ASSERT_EQ(base64_encode(input, encoded.data(), alphabet, padding), encoded.size());
+            ASSERT_EQ(encoded, expected) << "size " << size << " offset " << offset;
+
+            std::string decoded(base64_decoded_max_size(expected.size()), '\0');
+            auto written = base64_decode(expected, decoded.data(), alphabet, padding);
+            ASSERT_EQ(written, size) << "size " << size;
+            decoded.resize(size);
+            ASSERT_EQ(decoded, input);
+          }
+        }
+      }
+    }
+  });
+}
+
+TEST_F(EncodingTest, Base64Decode_Whitespace)
+{
+  std::mt19937 rng(3);
+  const std::string data = random_bytes(rng, 1000);
+  std::string mime;
+  const std::string encoded = to_base64(data);
+  for (std::size_t i = 0; i < encoded.size(); i += 76)
+  {
+    mime += encoded.substr(i, 76) + "\r\n";
+  }
+  for_each_isa([&] {
+    EXPECT_EQ(from_base64(mime, base64_alphabet::standard), data);
+    EXPECT_EQ(from_base64(" Zm 9v\tYm\nFy ", base64_alphabet::standard), "foobar");
+    EXPECT_EQ(from_base64("Zg = = \n", base64_alphabet::standard), "f");
+  });
+}
+
+TEST_F(EncodingTest, Base64Decode_Invalid)
+{
+  std::mt19937 rng(5);
+  const std::string valid = to_base64(random_bytes(rng, 150));
+  for_each_isa([&valid] {
+    EXPECT_FALSE(from_base64("Zg", base64_alphabet::standard));
+    EXPECT_FALSE(from_base64("Z===", base64_alphabet::standard));
+    EXPECT_FALSE(from_base64("Zg=", base64_alphabet::standard));
+    EXPECT_FALSE(from_base64("Zg==Zg==", base64_alphabet::standard));
+    EXPECT_FALSE(from_base64("Zm8=x", base64_alphabet::standard));
+    EXPECT_FALSE(from_base64("Zm8=", base64_alphabet::standard, false));
+    EXPECT_FALSE(from_base64("Z", base64_alphabet::standard, false));
+    EXPECT_FALSE(from_base64("Zm9vY", base64_alphabet::standard, false));
+
+    for (std::size_t i = 0; i < valid.size(); ++i)
+    {
+      for (char bad : {'!', '-', '\0', '\x80', '\xff'})
+      {
+        std::string input = valid;
+        input[i]          = bad;
+        ASSERT_FALSE(from_base64(input, base64_alphabet::standard)) << "position " << i << " char " << int(bad);
+      }
+    }
+  });
+}
+
+TEST_F(EncodingTest, Base64Encoder_ChunksMatchOneShot)
+{
+  std::mt19937 rng(11);
+  const std::string data = random_bytes(rng, 700);
+  for_each_isa([&] {
+    for (bool padding : {true, false})
+    {
+      const std::string expected = to_base64(data, base64_alphabet::url, padding);
+      base64_encoder encoder(base64_alphabet::url, padding);
+      for (int round = 0; round < 10; ++round)
+      {
+        std::string out;
+        for (std::string_view chunk : random_chunks(rng, data))
+        {
+          encoder.update(chunk, out);
+        }
+        encoder.finish(out);
+        ASSERT_EQ(out, expected);
+      }
+    }
+  });
+}
+
+TEST_F(EncodingTest, Base64Decoder_ChunksMatchOneShot)
+{
+  std::mt19937 rng(13);
+  for_each_isa([&] {
+    for (bool padding : {true, false})
+    {
+      for (std::size_t size : {0u, 1u, 2u, 3u, 100u, 601u, 602u})
+      {
+        const std::string data    = random_bytes(rng, size);
+        const std::string encoded = to_base64(data, base64_alphabet::standard, padding) + (padding ? " \n" : "");
+        base64_decoder decoder(base64_alphabet::standard, padding);
+        for (int round = 0; round < 10; ++round)
+        {
+          std::string out;
+          for (std::string_view chunk : random_chunks(rng, encoded))
+          {
+            ASSERT_TRUE(decoder.update(chunk, out));
+          }
+          ASSERT_TRUE(decoder.finish(out));
+          ASSERT_EQ(out, data) << "size " << size;
+        }
+      }
+    }
+  });
+}
+
+TEST_F(EncodingTest, Base64Decoder_StickyFailure)
+{
+  base64_decoder decoder;
+  std::string out;
+  EXPECT_TRUE(decoder.update("Zm9", out));
+  EXPECT_FALSE(decoder.finish(out));
+  EXPECT_FALSE(decoder.update("Zm9v", out));
+
+  base64_decoder other;
+  EXPECT_FALSE(other.update("Zm*v", out));
+  EXPECT_FALSE(other.update("Zm9v", out));
+  EXPECT_FALSE(other.finish(out));
+}
+
+// ============================================================================
+// Percent Encoding Tests
+// ============================================================================
+
+TEST_F(EncodingTest, PercentEncoding_RoundTrip)
+{
+  std::mt19937 rng(17);
+  const std::string data = random_bytes(rng, 300);
+  for_each_isa([&data] {
+    std::string encoded(percent_encoded_max_size(data.size()), '\0');
+    encoded.resize(percent_encode(data, encoded.data()));
+    EXPECT_EQ(encoded.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_.~%"),
+              std::string::npos);
+
+    std::string decoded(encoded.size(), '\0');
+    auto written = percent_decode(encoded, decoded.data());
+    ASSERT_TRUE(written);
+    decoded.resize(*written);
+    EXPECT_EQ(decoded, data);
+
+    char out[16];
+    EXPECT_EQ(percent_decode("a+b%20c", out), 5u);
+    EXPECT_EQ(std::string_view(out, 5), "a b c");
+    EXPECT_FALSE(percent_decode("abc%4", out));
+    EXPECT_FALSE(percent_decode("%zz", out));
+  });
+}
+
+// ============================================================================
+// Escaping Tests
+// ============================================================================
+
+TEST_F(EncodingTest, JsonEscape_MatchesReference)
+{
+  std::mt19937 rng(29);
+  const std::string specials("\"\\\b\f\n\r\t\x01\x1f\0\x7f\xc3\xa9", 14);
+  std::vector<std::string> samples = {"", "plain", std::string(1, '\0'), "\"\"\\\\", "caf\xc3\xa9 \x7f"};
+  for (std::size_t size = 1; size <= 300; size += 7)
+  {
+    samples.push_back(random_text(rng, size, specials));
+  }
+  samples.push_back(random_bytes(rng, 500));
+
+  for_each_isa([&samples] {
+    for (const std::string& sample : samples)
+    {
+      const std::string expected = reference_json_escape(sample);
+
+      std::string buffer(json_escaped_max_size(sample.size()), '\0');
+      buffer.resize(json_escape(sample, buffer.data()));
+      ASSERT_EQ(buffer, expected);
+
+      std::string appended = "{\"";
+      append_json_escaped(appended, sample);
+      ASSERT_EQ(appended, "{\"" + expected);
+
+      std::string sunk;
+      format_sink sink(sunk);
+      append_json_escaped(sink, sample);
+      ASSERT_EQ(sunk, expected);
+      ASSERT_EQ(sink.size(), expected.size());
+
+      ASSERT_EQ(json_escape(sample), expected);
+      ASSERT_EQ(json_unescape(expected), sample);
+    }
+  });
+}
+
+TEST_F(EncodingTest, HtmlEscape_MatchesReference)
+{
+  std::mt19937 rng(31);
+  std::vector<std::string> samples = {"", "<b>\"Tom\" & 'Jerry'</b>", "&&&&", "no markup at all, just a long sentence"};
+  for (std::size_t size = 1; size <= 300; size += 11)
+  {
+    samples.push_back(random_text(rng, size, "&<>\"'"));
+  }
+
+  for_each_isa([&samples] {
+    for (const std::string& sample : samples)
+    {
+      std::string expected;
+      for (char ch : sample)
+      {
+        switch (ch)
+        {
+        case '&': expected += "&amp;"; break;
+        case '<': expected += "&lt;"; break;
+        case '>': expected += "&gt;"; break;
+        case '"': expected += "&quot;"; break;
+        case '\'': expected += "&#39;"; break;
+        default: expected.push_back(ch);
+        }
+      }
+
+      std::string buffer(html_escaped_max_size(sample.size()), '\0');
+      buffer.resize(html_escape(sample, buffer.data()));
+      ASSERT_EQ(buffer, expected);
+
+      std::string appended = "<p>";
+      append_html_escaped(appended, sample);
+      ASSERT_EQ(appended, "<p>" + expected);
+
+      ASSERT_EQ(html_escape(sample), expected);
+      ASSERT_EQ(html_unescape(expected), sample);
+    }
+  });
+}
+
+} // namespace fb::test
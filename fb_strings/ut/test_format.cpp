@@ -3,7 +3,9 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <iterator>
 #include <limits>
+#include <vector>
 
 namespace fb
 {
@@ -162,6 +164,25 @@ TEST(Format, FloatSimple)
   EXPECT_EQ(format("{}", 3.14), "3.14");
 }
 
+TEST(Format, FloatShortestRoundTrip)
+{
+  EXPECT_EQ(format("{}", 0.1), "0.1");
+  EXPECT_EQ(format("{}", 2.0 / 3.0), "0.6666666666666666");
+  EXPECT_EQ(format("{}", 123456789.0), "123456789");
+  EXPECT_EQ(format("{}", 1e20), "1e+20");
+  EXPECT_EQ(format("{}", 0.1f), "0.1");
+  EXPECT_EQ(std::stod(format("{}", 1.0 / 3.0)), 1.0 / 3.0);
+  EXPECT_EQ(format("{:>8}", 1.5), "     1.5");
+}
+
+TEST(Format, FloatGeneralDefaultsToSixDigits)
+{
+  EXPECT_EQ(format("{:g}", 2.0 / 3.0), "0.666667");
+  EXPECT_EQ(format("{:.3}", 2.0 / 3.0), "0.667");
+  EXPECT_EQ(format("{:G}", 1e-10), "1E-10");
+  EXPECT_EQ(format("{:.2E}", 1234.5), "1.23E+03");
+}
+
 TEST(Format, FloatPrecision)
 {
   EXPECT_EQ(format("{:.2f}", 3.14159), "3.14");
@@ -414,4 +435,201 @@ TEST(Format, ManyArguments)
             "0123456789");
 }
 
+TEST(Format, LongFixedFloat)
+{
+  // Longer than the on-stack conversion buffer
+  std::string result = format("{:.2f}", 1e300);
+  EXPECT_EQ(result.size(), 304u);
+  EXPECT_EQ(result.substr(0, 4), "1000");
+  EXPECT_EQ(result.substr(result.size() - 3), ".00");
+}
+
+TEST(Format, MinimumInteger)
+{
+  EXPECT_EQ(format("{}", std::numeric_limits<long long>::min()),
+            "-9223372036854775808");
+}
+
+// ============================================================================
+// Output Iterator Tests
+// ============================================================================
+
+TEST(FormatTo, CharBuffer)
+{
+  char buffer[32];
+  char* end = format_to(buffer, "{}:{:04x}", "id", 255);
+  EXPECT_EQ(std::string(buffer, end), "id:00ff");
+}
+
+TEST(FormatTo, BackInserter)
+{
+  std::string out = "log: ";
+  format_to(std::back_inserter(out), "{:>5}|{:.1f}", "warn", 2.25);
+  EXPECT_EQ(out, "log:  warn|2.2");
+
+  std::vector<char> bytes;
+  format_to(std::back_inserter(bytes), "{{{}}}", 7);
+  EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "{7}");
+}
+
+TEST(FormatTo, MatchesFormat)
+{
+  std::string out;
+  format_to(std::back_inserter(out), "{:*^9}{:+}{:#b}{}", "mid", 3, 5, nullptr);
+  EXPECT_EQ(out, format("{:*^9}{:+}{:#b}{}", "mid", 3, 5, nullptr));
+}
+
+TEST(FormatTo, ErrorKeepsWrittenOutput)
+{
+  std::string out;
+  EXPECT_THROW(format_to(std::back_inserter(out), "ab{5}", 1), std::out_of_range);
+  EXPECT_EQ(out, "ab");
+}
+
+TEST(FormatToN, FitsInBuffer)
+{
+  char buffer[16];
+  auto result = format_to_n(buffer, sizeof(buffer), "{}-{}", 12, 34);
+  EXPECT_EQ(result.size, 5u);
+  EXPECT_EQ(std::string(buffer, result.out), "12-34");
+}
+
+TEST(FormatToN, Truncates)
+{
+  char buffer[8] = {};
+  auto result = format_to_n(buffer, 4, "{:>8}", "abc");
+  EXPECT_EQ(result.size, 8u);
+  EXPECT_EQ(result.out, buffer + 4);
+  EXPECT_EQ(std::string(buffer, result.out), "    ");
+  EXPECT_EQ(buffer[4], '\0');
+}
+
+TEST(FormatToN, ZeroLimit)
+{
+  char buffer[1] = {'x'};
+  auto result = format_to_n(buffer, 0, "{}", 42);
+  EXPECT_EQ(result.size, 2u);
+  EXPECT_EQ(result.out, buffer);
+  EXPECT_EQ(buffer[0], 'x');
+}
+
+TEST(FormattedSize, CountsWithoutWriting)
+{
+  EXPECT_EQ(formatted_size(""), 0u);
+  EXPECT_EQ(formatted_size("{:08x}", 1), 8u);
+  EXPECT_EQ(formatted_size("{} {}", "hello", 3.5), format("{} {}", "hello", 3.5).size());
+  EXPECT_EQ(formatted_size("{:-^100}", ""), 100u);
+}
+
+// ============================================================================
+// Compile-Time Format String Tests
+// ============================================================================
+
+static_assert(detail::analyze_format_string("").segments == 0);
+static_assert(detail::analyze_format_string("a{}b{{c").segments == 5);
+static_assert(detail::analyze_format_string("{} {}").arg_count == 2);
+static_assert(detail::analyze_format_string("{3:x} {0}").arg_count == 4);
+static_assert(parse_format_spec("*^+#010.3f").width == 10);
+
+TEST(CompiledFormat, MatchesRuntimeFormat)
+{
+  EXPECT_EQ(format(FB_FORMAT_STRING("Hello, {}!"), "World"), "Hello, World!");
+  EXPECT_EQ(format(FB_FORMAT_STRING("{1} {0}"), "World", "Hello"), "Hello World");
+  EXPECT_EQ(format(FB_FORMAT_STRING("{:*^10}|{:+.2f}|{:#x}"), "hi", 3.14159, 255),
+            format("{:*^10}|{:+.2f}|{:#x}", "hi", 3.14159, 255));
+  EXPECT_EQ(format(FB_FORMAT_STRING("{{{}}} }}"), 7), "{7} }");
+  EXPECT_EQ(format(FB_FORMAT_STRING("")), "");
+}
+
+TEST(CompiledFormat, SegmentsParsedAtCompileTime)
+{
+  auto fmt = FB_FORMAT_STRING("id={:08x};");
+  using compiled = decltype(fmt);
+  static_assert(compiled::segments.size() == 3);
+  static_assert(compiled::segments[0].literal == "id=");
+  static_assert(compiled::segments[1].is_field);
+  static_assert(compiled::segments[1].spec.zero_pad);
+  static_assert(compiled::segments[1].spec.width == 8);
+  static_assert(compiled::segments[1].spec.type == 'x');
+  static_assert(compiled::info.arg_count == 1);
+  EXPECT_EQ(format(fmt, 48879), "id=0000beef;");
+}
+
+TEST(CompiledFormat, OutputIteratorFunctions)
+{
+  char buffer[16];
+  char* end = format_to(buffer, FB_FORMAT_STRING("{}:{}"), "host", 80);
+  EXPECT_EQ(std::string(buffer, end), "host:80");
+
+  auto result = format_to_n(buffer, 3, FB_FORMAT_STRING("{:>6}"), 1);
+  EXPECT_EQ(result.size, 6u);
+  EXPECT_EQ(std::string(buffer, result.out), "   ");
+
+  EXPECT_EQ(formatted_size(FB_FORMAT_STRING("{:.3f}"), 2.0), 5u);
+}
+
+TEST(CompiledFormat, ExtraArgumentsIgnored)
+{
+  EXPECT_EQ(format(FB_FORMAT_STRING("{}"), 1, 2, 3), "1");
+}
+
+// ============================================================================
+// Custom Formatter Tests
+// ============================================================================
+
+struct Celsius
+{
+  int degrees;
+};
+
+struct Kelvin
+{
+  int degrees;
+};
+
+// Formatter returning a string
+template<>
+struct formatter<Celsius>
+{
+  format_spec m_spec;
+
+  std::string format(const Celsius& value) const
+  {
+    return fb::format("{}C", value.degrees);
+  }
+};
+
+// Formatter writing into the sink
+template<>
+struct formatter<Kelvin>
+{
+  format_spec m_spec;
+
+  std::string format(const Kelvin& value) const
+  {
+    return fb::format("{}K", value.degrees);
+  }
+
+  void format(const Kelvin& value, format_sink& out) const
+  {
+    format_to(std::back_inserter(out), "{}", value.degrees);
+    out.push_back('k');
+  }
+};
+
+TEST(Format, CustomFormatter_StringResult)
+{
+  EXPECT_EQ(format("[{}]", Celsius{21}), "[21C]");
+  EXPECT_EQ(formatted_size("{}", Celsius{-5}), 3u);
+}
+
+TEST(Format, CustomFormatter_SinkOverloadPreferred)
+{
+  EXPECT_EQ(format("[{}]", Kelvin{300}), "[300k]");
+
+  char buffer[8];
+  char* end = format_to(buffer, "{}", Kelvin{4});
+  EXPECT_EQ(std::string(buffer, end), "4k");
+}
+
 } // namespace fb
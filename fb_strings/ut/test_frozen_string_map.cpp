@@ -0,0 +1,145 @@
+/// @file test_frozen_string_map.cpp
+/// @brief Unit tests for perfect-hash frozen string maps
+
+#include <fb/frozen_string_map.h>
+#include <fb/string_hash.h>
+#include <fb/string_list.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fb::test
+{
+
+namespace
+{
+
+constexpr auto VENUES = make_constexpr_string_map<int>(
+    {{"XNAS", 1}, {"XNYS", 2}, {"XLON", 3}, {"XPAR", 4}, {"XETR", 5}, {"BATS", 6}, {"ARCX", 7}});
+
+static_assert(VENUES.size() == 7);
+static_assert(*VENUES.find("XLON") == 3);
+static_assert(VENUES.at("ARCX") == 7);
+static_assert(!VENUES.contains("XTKS"));
+static_assert(!VENUES.contains(""));
+static_assert(detail::constexpr_fnv1a_64("") == 0xcbf29ce484222325ULL);
+
+} // namespace
+
+// ============================================================================
+// Runtime Map Tests
+// ============================================================================
+
+TEST(FrozenStringMapTest, FromStringListMapsKeysToIndices)
+{
+  const string_list                      keys{"BeginString", "BodyLength", "MsgType", "SenderCompID", ""};
+  const frozen_string_map<std::uint32_t> tags(keys);
+  EXPECT_EQ(tags.size(), keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    ASSERT_NE(tags.find(keys[i]), nullptr) << keys[i];
+    EXPECT_EQ(*tags.find(keys[i]), i);
+  }
+  EXPECT_EQ(tags.find("msgtype"), nullptr);
+  EXPECT_FALSE(tags.contains("MsgTyp"));
+  EXPECT_THROW((void)tags.at("TargetCompID"), std::out_of_range);
+}
+
+TEST(FrozenStringMapTest, FromPairs)
+{
+  const frozen_string_map<char> sides{{"BUY", '1'}, {"SELL", '2'}, {"SELL_SHORT", '5'}};
+  EXPECT_EQ(sides.at("SELL"), '2');
+  EXPECT_EQ(sides.at("SELL_SHORT"), '5');
+  EXPECT_FALSE(sides.contains("SEL"));
+
+  const std::vector<std::pair<std::string, std::string>> pairs{{"EUR", "Euro"}, {"JPY", "Yen"}};
+  const frozen_string_map<std::string>                  names(pairs.begin(), pairs.end());
+  EXPECT_EQ(names.at("JPY"), "Yen");
+  EXPECT_EQ(names.keys().size(), 2u);
+}
+
+TEST(FrozenStringMapTest, EmptyMap)
+{
+  const frozen_string_map<int> empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.find(""), nullptr);
+
+  const frozen_string_map<int> from_empty_list{string_list()};
+  EXPECT_TRUE(from_empty_list.empty());
+  EXPECT_FALSE(from_empty_list.contains("x"));
+}
+
+TEST(FrozenStringMapTest, DuplicateKeysThrow)
+{
+  EXPECT_THROW((frozen_string_map<int>(string_list{"a", "b", "a"})), std::invalid_argument);
+  EXPECT_THROW((frozen_string_map<int>{{"x", 1}, {"x", 2}}), std::invalid_argument);
+}
+
+TEST(FrozenStringMapTest, LargeKeySetIsPerfect)
+{
+  string_list keys;
+  for (int i = 0; i < 50000; ++i)
+  {
+    keys.push_back("K" + std::to_string(i * 2654435761u % 1000003));
+  }
+  keys.sort().unique();
+  const frozen_string_map<std::uint32_t> map(keys);
+  ASSERT_EQ(map.size(), keys.size());
+
+  // Every slot holds exactly one key
+  std::set<std::string_view> slotted(map.keys().begin(), map.keys().end());
+  EXPECT_EQ(slotted.size(), keys.size());
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    ASSERT_EQ(map.at(keys[i]), i) << keys[i];
+  }
+  for (int i = 0; i < 1000; ++i)
+  {
+    EXPECT_FALSE(map.contains("Z" + std::to_string(i)));
+  }
+}
+
+// ============================================================================
+// Compile-Time Map Tests
+// ============================================================================
+
+TEST(ConstexprStringMapTest, LookupsAtRunTime)
+{
+  const std::vector<std::string> present{"XNAS", "XNYS", "XLON", "XPAR", "XETR", "BATS", "ARCX"};
+  for (std::size_t i = 0; i < present.size(); ++i)
+  {
+    ASSERT_NE(VENUES.find(present[i]), nullptr);
+    EXPECT_EQ(*VENUES.find(present[i]), static_cast<int>(i) + 1);
+  }
+  EXPECT_FALSE(VENUES.contains(std::string("XNAS ")));
+  EXPECT_THROW((void)VENUES.at("XTKS"), std::out_of_range);
+}
+
+TEST(ConstexprStringMapTest, FnvMatchesRuntimeHash)
+{
+  for (const char* s : {"", "a", "XNAS", "SenderCompID", "\xff\x80"})
+  {
+    EXPECT_EQ(detail::constexpr_fnv1a_64(s), hash_fnv1a_64(s)) << s;
+  }
+}
+
+TEST(ConstexprStringMapTest, DuplicateKeysThrowAtRunTime)
+{
+  EXPECT_THROW((void)make_constexpr_string_map<int>({{"a", 1}, {"a", 2}}), std::invalid_argument);
+}
+
+TEST(ConstexprStringMapTest, SingleKey)
+{
+  constexpr auto one = make_constexpr_string_map<int>({{"only", 42}});
+  static_assert(one.at("only") == 42);
+  EXPECT_FALSE(one.contains("other"));
+}
+
+} // namespace fb::test
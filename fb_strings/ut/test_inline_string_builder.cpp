@@ -0,0 +1,164 @@
+/// @file test_inline_string_builder.cpp
+/// @brief Unit tests for the inline_string_builder class
+
+#include <gtest/gtest.h>
+
+#include "fb/inline_string_builder.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace fb::test
+{
+
+using truncating_builder = inline_string_builder<8, inline_overflow::truncate>;
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(InlineStringBuilderTest, DefaultConstruction)
+{
+  inline_string_builder<32> sb;
+  EXPECT_TRUE(sb.empty());
+  EXPECT_EQ(sb.size(), 0u);
+  EXPECT_EQ(sb.capacity(), 32u);
+  EXPECT_STREQ(sb.c_str(), "");
+  EXPECT_FALSE(sb.spilled());
+  EXPECT_EQ(inline_string_builder<32>::inline_capacity(), 32u);
+}
+
+TEST(InlineStringBuilderTest, ConstructionWithContent)
+{
+  inline_string_builder<32> sb("Hello");
+  EXPECT_EQ(sb.view(), "Hello");
+}
+
+// ============================================================================
+// Append Tests
+// ============================================================================
+
+TEST(InlineStringBuilderTest, AppendMatchesStringBuilderApi)
+{
+  inline_string_builder<128> sb;
+  sb.append("side=")
+      .append('B')
+      .append(' ')
+      .append('-', 3)
+      .append_int(std::int32_t{-42})
+      .append(' ')
+      .append_uint(std::uint64_t{18446744073709551615u})
+      .append(' ')
+      .append_double(3.14159, 2)
+      .append(' ')
+      .append_bool(true)
+      .append_line();
+  EXPECT_EQ(sb.view(), "side=B ----42 18446744073709551615 3.14 true\n");
+  EXPECT_FALSE(sb.spilled());
+  EXPECT_EQ(std::strlen(sb.c_str()), sb.size());
+}
+
+TEST(InlineStringBuilderTest, StreamOperators)
+{
+  inline_string_builder<64> sb;
+  sb << "qty=" << std::int64_t{100} << ' ' << std::uint32_t{7} << ' ' << 2.5 << ' ' << false;
+  EXPECT_EQ(sb.view(), "qty=100 7 2.500000 false");
+}
+
+TEST(InlineStringBuilderTest, AppendFormat)
+{
+  inline_string_builder<64> sb;
+  sb.append_format("{} {}@{:.2f}", "BUY", "AAPL", 187.5) << " qty=" << 10;
+  EXPECT_EQ(sb.view(), "BUY AAPL@187.50 qty=10");
+
+  sb.clear().append_format(FB_FORMAT_STRING("{:>5}|"), 42);
+  EXPECT_EQ(sb.view(), "   42|");
+}
+
+TEST(InlineStringBuilderTest, NullCStringAppendsNothing)
+{
+  inline_string_builder<8> sb;
+  sb.append(static_cast<const char*>(nullptr));
+  EXPECT_TRUE(sb.empty());
+}
+
+// ============================================================================
+// Overflow Tests
+// ============================================================================
+
+TEST(InlineStringBuilderTest, ExactCapacityStaysInline)
+{
+  inline_string_builder<8> sb;
+  sb.append("12345678");
+  EXPECT_FALSE(sb.spilled());
+  EXPECT_STREQ(sb.c_str(), "12345678");
+}
+
+TEST(InlineStringBuilderTest, SpillKeepsEverything)
+{
+  inline_string_builder<8> sb;
+  sb.append("1234").append_format("{}", 56789);
+  EXPECT_TRUE(sb.spilled());
+  EXPECT_FALSE(sb.truncated());
+  EXPECT_EQ(sb.view(), "123456789");
+  EXPECT_GE(sb.capacity(), 9u);
+
+  sb.append(std::string(100, 'x'));
+  EXPECT_EQ(sb.size(), 109u);
+  EXPECT_EQ(sb.to_string(), "123456789" + std::string(100, 'x'));
+  EXPECT_STREQ(sb.c_str(), sb.to_string().c_str());
+
+  sb.clear().append("ab");
+  EXPECT_EQ(sb.view(), "ab");
+}
+
+TEST(InlineStringBuilderTest, TruncateKeepsPrefix)
+{
+  truncating_builder sb;
+  sb.append("1234").append_int(std::int32_t{56789}).append("more");
+  EXPECT_TRUE(sb.truncated());
+  EXPECT_FALSE(sb.spilled());
+  EXPECT_EQ(sb.view(), "12345678");
+  EXPECT_STREQ(sb.c_str(), "12345678");
+  EXPECT_EQ(sb.capacity(), 8u);
+}
+
+TEST(InlineStringBuilderTest, TruncateFormatAndRepeat)
+{
+  truncating_builder sb;
+  sb.append_format("{:<20}", "x").append('-', 100);
+  EXPECT_TRUE(sb.truncated());
+  EXPECT_EQ(sb.view(), "x       ");
+
+  sb.clear();
+  EXPECT_FALSE(sb.truncated());
+  sb.append('-', 3);
+  EXPECT_EQ(sb.view(), "---");
+  EXPECT_FALSE(sb.truncated());
+}
+
+TEST(InlineStringBuilderTest, AppendEscaped)
+{
+  inline_string_builder<32> sb;
+  sb.append_json_escaped("a\"b\\c\td").append(' ').append_html_escaped("x<y");
+  EXPECT_EQ(sb.view(), "a\\\"b\\\\c\\td x&lt;y");
+  EXPECT_FALSE(sb.spilled());
+
+  truncating_builder truncated;
+  truncated.append_html_escaped("<<<");
+  EXPECT_EQ(truncated.view(), "&lt;&lt;");
+}
+
+TEST(InlineStringBuilderTest, BaseReferenceAcceptsAnyCapacity)
+{
+  auto write_header = [](inline_string_builder_base& out) { out << "8=FIX.4.4" << '\x01'; };
+
+  inline_string_builder<16> small;
+  inline_string_builder<256> large;
+  write_header(small);
+  write_header(large);
+  EXPECT_EQ(small.view(), large.view());
+}
+
+} // namespace fb::test
@@ -0,0 +1,173 @@
+/// @file test_multi_pattern.cpp
+/// @brief Unit tests for the Aho-Corasick multi_pattern matcher
+
+#include <fb/multi_pattern.h>
+#include <fb/string_list.h>
+#include <fb/string_utils.h>
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fb::test
+{
+
+namespace
+{
+
+/// Leftmost-longest match by trying every needle at every position
+std::optional<multi_pattern::match> naive_find(std::string_view text,
+                                               const std::vector<std::string>& needles,
+                                               std::size_t pos)
+{
+  for (std::size_t p = pos; p < text.size(); ++p)
+  {
+    std::optional<multi_pattern::match> best;
+    for (std::size_t n = 0; n < needles.size(); ++n)
+    {
+      const std::string& needle = needles[n];
+      if (!needle.empty() && text.substr(p, needle.size()) == needle && (!best || needle.size() > best->length))
+      {
+        best = multi_pattern::match{p, needle.size(), n};
+      }
+    }
+    if (best)
+    {
+      return best;
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<multi_pattern::match> naive_find_all(std::string_view text, const std::vector<std::string>& needles)
+{
+  std::vector<multi_pattern::match> matches;
+  std::size_t                       pos = 0;
+  while (auto found = naive_find(text, needles, pos))
+  {
+    matches.push_back(*found);
+    pos = found->position + found->length;
+  }
+  return matches;
+}
+
+} // namespace
+
+// ============================================================================
+// Search Tests
+// ============================================================================
+
+TEST(MultiPatternTest, FindAnyIsLeftmostLongest)
+{
+  const multi_pattern needles{"he", "she", "his", "hers"};
+  auto                found = needles.find_any("ushers");
+  ASSERT_TRUE(found.has_value());
+  EXPECT_EQ(*found, (multi_pattern::match{1, 3, 1})); // "she" starts before "he" and "hers"
+
+  found = needles.find_any("ushers", 2);
+  ASSERT_TRUE(found.has_value());
+  EXPECT_EQ(*found, (multi_pattern::match{2, 4, 3})); // "hers" is longer than "he"
+
+  EXPECT_FALSE(needles.find_any("xyz").has_value());
+  EXPECT_FALSE(needles.find_any("ushers", 100).has_value());
+}
+
+TEST(MultiPatternTest, ContainsAny)
+{
+  const multi_pattern secrets{"password=", "token=", "ssn="};
+  EXPECT_TRUE(secrets.contains_any("user=bob password=hunter2"));
+  EXPECT_TRUE(secrets.contains_any("ssn="));
+  EXPECT_FALSE(secrets.contains_any("user=bob pass=hunter2"));
+  EXPECT_FALSE(secrets.contains_any(""));
+}
+
+TEST(MultiPatternTest, FindAllDoesNotOverlap)
+{
+  const multi_pattern needles{"aa", "a"};
+  EXPECT_EQ(needles.find_all("aaa"),
+            (std::vector<multi_pattern::match>{{0, 2, 0}, {2, 1, 1}}));
+  EXPECT_EQ(needles.count("aaaa"), 2u);
+}
+
+TEST(MultiPatternTest, EmptyAndDuplicateNeedles)
+{
+  const multi_pattern none;
+  EXPECT_TRUE(none.empty());
+  EXPECT_FALSE(none.contains_any("anything"));
+
+  const multi_pattern only_empty{""};
+  EXPECT_EQ(only_empty.size(), 1u);
+  EXPECT_FALSE(only_empty.find_any("abc").has_value());
+
+  const multi_pattern duplicates{"ab", "ab"};
+  EXPECT_EQ(duplicates.find_any("xab")->pattern, 0u);
+}
+
+TEST(MultiPatternTest, AgreesWithNaiveSearch)
+{
+  std::mt19937 rng(42);
+  for (int round = 0; round < 300; ++round)
+  {
+    // Small alphabets make overlapping and nested needles common; some
+    // rounds have more than 8 first bytes, which disables the prefilter
+    const int                alphabet = round % 3 == 0 ? 12 : 3;
+    std::vector<std::string> needles(1 + rng() % 12);
+    for (auto& needle : needles)
+    {
+      needle.resize(rng() % 5);
+      for (char& c : needle)
+      {
+        c = static_cast<char>('a' + rng() % alphabet);
+      }
+    }
+    std::string text(rng() % 64, ' ');
+    for (char& c : text)
+    {
+      c = static_cast<char>('a' + rng() % (alphabet + 1));
+    }
+
+    const multi_pattern matcher(needles.begin(), needles.end());
+    EXPECT_EQ(matcher.find_all(text), naive_find_all(text, needles)) << text;
+    EXPECT_EQ(matcher.contains_any(text), naive_find(text, needles, 0).has_value()) << text;
+  }
+}
+
+TEST(MultiPatternTest, HighBytesAndBinaryText)
+{
+  const multi_pattern needles{"\xff\xfe", std::string_view("\0x", 2)};
+  const std::string   text("a\xff\xfe" "b\0x", 6);
+  EXPECT_EQ(needles.find_all(text), (std::vector<multi_pattern::match>{{1, 2, 0}, {4, 2, 1}}));
+}
+
+// ============================================================================
+// Replacement Tests
+// ============================================================================
+
+TEST(MultiPatternTest, ReplaceManyWithOneReplacement)
+{
+  const multi_pattern secrets{"hunter2", "s3cret", "s3cretive"};
+  EXPECT_EQ(secrets.replace_many("pw=hunter2 key=s3cretive", "***"), "pw=*** key=***");
+  EXPECT_EQ(secrets.replace_many("nothing here", "***"), "nothing here");
+  EXPECT_EQ(secrets.replace_many("hunter2hunter2", ""), "");
+}
+
+TEST(MultiPatternTest, ReplaceManyPerNeedle)
+{
+  const multi_pattern codes{"EUR", "USD", "GBP"};
+  EXPECT_EQ(codes.replace_many("EURUSD GBPUSD", {"\xe2\x82\xac", "$", "\xc2\xa3"}), "\xe2\x82\xac$ \xc2\xa3$");
+  EXPECT_THROW((void)codes.replace_many("EUR", std::vector<std::string_view>{"x"}), std::invalid_argument);
+}
+
+TEST(MultiPatternTest, SingleNeedleMatchesReplaceAll)
+{
+  const std::string   text = "abababa aba";
+  const multi_pattern single{"aba"};
+  EXPECT_EQ(single.replace_many(text, "X"), replace_all(text, "aba", "X"));
+  EXPECT_EQ(multi_pattern(string_list{"aba"}).replace_many(text, ""), remove_all(text, "aba"));
+}
+
+} // namespace fb::test
@@ -0,0 +1,269 @@
+/// @file test_packed_string_list.cpp
+/// @brief Unit tests for the arena-backed packed_string_list
+
+#include <fb/packed_string_list.h>
+#include <fb/string_list.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fb::test
+{
+
+namespace
+{
+
+std::vector<std::string> as_strings(const packed_string_list& list)
+{
+  return std::vector<std::string>(list.begin(), list.end());
+}
+
+} // namespace
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(PackedStringListTest, DefaultConstruction)
+{
+  packed_string_list list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.size(), 0u);
+  EXPECT_EQ(list.bytes(), 0u);
+  EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST(PackedStringListTest, InitializerListConstruction)
+{
+  packed_string_list list{"EURUSD", "", "GBPUSD"};
+  ASSERT_EQ(list.size(), 3u);
+  EXPECT_EQ(list[0], "EURUSD");
+  EXPECT_EQ(list[1], "");
+  EXPECT_EQ(list[2], "GBPUSD");
+  EXPECT_EQ(list.bytes(), 12u);
+}
+
+TEST(PackedStringListTest, RoundTripThroughStringList)
+{
+  string_list        source{"alpha", "beta", "", "gamma"};
+  packed_string_list packed(source);
+  EXPECT_EQ(packed.to_string_list(), source);
+}
+
+TEST(PackedStringListTest, IteratorRangeConstruction)
+{
+  std::vector<const char*> words{"one", "two", "three"};
+  packed_string_list       list(words.begin(), words.end());
+  EXPECT_EQ(as_strings(list), std::vector<std::string>({"one", "two", "three"}));
+}
+
+// ============================================================================
+// Factory Tests
+// ============================================================================
+
+TEST(PackedStringListTest, FromSplit_MatchesStringList)
+{
+  for (const char* input : {"a,b,,c", ",a,", "", "single", ",,,"})
+  {
+    for (bool keep_empty : {true, false})
+    {
+      EXPECT_EQ(packed_string_list::from_split(input, ',', keep_empty).to_string_list(),
+                string_list::from_split(input, ',', keep_empty))
+          << '"' << input << "\" keep_empty " << keep_empty;
+      EXPECT_EQ(packed_string_list::from_split(input, ",,", keep_empty).to_string_list(),
+                string_list::from_split(input, ",,", keep_empty))
+          << '"' << input << "\" keep_empty " << keep_empty;
+    }
+  }
+}
+
+TEST(PackedStringListTest, FromLines_MatchesStringList)
+{
+  for (const char* input : {"one\ntwo\r\nthree", "a\n\nb\n", "", "\r\n"})
+  {
+    for (bool keep_empty : {true, false})
+    {
+      EXPECT_EQ(packed_string_list::from_lines(input, keep_empty).to_string_list(),
+                string_list::from_lines(input, keep_empty))
+          << '"' << input << "\" keep_empty " << keep_empty;
+    }
+  }
+}
+
+TEST(PackedStringListTest, FromSplit_CopiesInputOnce)
+{
+  std::string        input = "AAPL MSFT GOOG";
+  packed_string_list list  = packed_string_list::from_split(input, ' ');
+  input.assign(input.size(), 'x');
+
+  EXPECT_EQ(as_strings(list), std::vector<std::string>({"AAPL", "MSFT", "GOOG"}));
+  EXPECT_EQ(list.bytes(), 14u);
+  list.compact();
+  EXPECT_EQ(list.bytes(), 12u);
+}
+
+// ============================================================================
+// Element Access and Iteration Tests
+// ============================================================================
+
+TEST(PackedStringListTest, ElementAccess)
+{
+  packed_string_list list{"first", "middle", "last"};
+  EXPECT_EQ(list.front(), "first");
+  EXPECT_EQ(list.back(), "last");
+  EXPECT_EQ(list.at(1), "middle");
+  EXPECT_THROW((void)list.at(3), std::out_of_range);
+}
+
+TEST(PackedStringListTest, RandomAccessIterators)
+{
+  packed_string_list list{"a", "b", "c", "d"};
+  auto               it = list.begin();
+  EXPECT_EQ(list.end() - it, 4);
+  EXPECT_EQ(it[2], "c");
+  EXPECT_EQ(*(it + 3), "d");
+  EXPECT_TRUE(it < list.end());
+
+  std::vector<std::string> reversed(list.rbegin(), list.rend());
+  EXPECT_EQ(reversed, std::vector<std::string>({"d", "c", "b", "a"}));
+  EXPECT_EQ(std::find(list.begin(), list.end(), "c") - list.begin(), 2);
+}
+
+// ============================================================================
+// Modifier Tests
+// ============================================================================
+
+TEST(PackedStringListTest, PushBackOwnElement)
+{
+  packed_string_list list{"abcdefghijklmnopqrstuvwxyz"};
+  for (int i = 0; i < 10; ++i)
+  {
+    // Each append may reallocate the arena the argument points into
+    list.push_back(list.back());
+  }
+  EXPECT_EQ(list.count("abcdefghijklmnopqrstuvwxyz"), 11u);
+}
+
+TEST(PackedStringListTest, PopBackReclaimsNewestBytes)
+{
+  packed_string_list list{"keep", "drop"};
+  list.pop_back();
+  EXPECT_EQ(list.size(), 1u);
+  EXPECT_EQ(list.bytes(), 4u);
+  list.push_back("next");
+  EXPECT_EQ(as_strings(list), std::vector<std::string>({"keep", "next"}));
+}
+
+TEST(PackedStringListTest, ShrinkToFitDropsUnreferencedBytes)
+{
+  auto list = packed_string_list::from_split("b,a,b,c,a", ',');
+  list.remove_duplicates();
+  list.shrink_to_fit();
+  EXPECT_EQ(as_strings(list), std::vector<std::string>({"b", "a", "c"}));
+  EXPECT_EQ(list.bytes(), 3u);
+}
+
+TEST(PackedStringListTest, ClearAndSwap)
+{
+  packed_string_list a{"x"};
+  packed_string_list b{"y", "z"};
+  a.swap(b);
+  EXPECT_EQ(a.size(), 2u);
+  EXPECT_EQ(b.front(), "x");
+  a.clear();
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.bytes(), 0u);
+}
+
+// ============================================================================
+// List Operation Tests
+// ============================================================================
+
+TEST(PackedStringListTest, Join)
+{
+  packed_string_list list{"a", "b", "c"};
+  EXPECT_EQ(list.join(", "), "a, b, c");
+  EXPECT_EQ(list.join('|'), "a|b|c");
+  EXPECT_EQ(list.join(), "abc");
+  EXPECT_EQ(packed_string_list().join(","), "");
+}
+
+TEST(PackedStringListTest, Filters)
+{
+  packed_string_list list{"apple", "banana", "grape", "pineapple"};
+  EXPECT_EQ(as_strings(list.filter_containing("apple")), std::vector<std::string>({"apple", "pineapple"}));
+  EXPECT_EQ(as_strings(list.filter_starts_with("b")), std::vector<std::string>({"banana"}));
+  EXPECT_EQ(as_strings(list.filter_ends_with("e")), std::vector<std::string>({"apple", "grape", "pineapple"}));
+  EXPECT_EQ(list.filter([](std::string_view s) { return s.size() > 5; }).size(), 2u);
+}
+
+TEST(PackedStringListTest, Search)
+{
+  packed_string_list list{"Alpha", "beta", "alpha", "beta"};
+  EXPECT_TRUE(list.contains("beta"));
+  EXPECT_FALSE(list.contains("gamma"));
+  EXPECT_FALSE(list.contains("alph"));
+  EXPECT_TRUE(list.contains_ignore_case("ALPHA"));
+  EXPECT_EQ(list.index_of("beta"), 1u);
+  EXPECT_EQ(list.last_index_of("beta"), 3u);
+  EXPECT_EQ(list.index_of("gamma"), std::nullopt);
+  EXPECT_EQ(list.count("beta"), 2u);
+}
+
+TEST(PackedStringListTest, Sorting)
+{
+  packed_string_list list{"file10", "File2", "file1", "file2"};
+  EXPECT_EQ(as_strings(packed_string_list(list).sort()),
+            std::vector<std::string>({"File2", "file1", "file10", "file2"}));
+  EXPECT_EQ(as_strings(packed_string_list(list).sort_natural()),
+            std::vector<std::string>({"File2", "file1", "file2", "file10"}));
+  EXPECT_EQ(as_strings(packed_string_list(list).sort([](std::string_view a, std::string_view b) {
+              return a.size() < b.size() || (a.size() == b.size() && a > b);
+            })),
+            std::vector<std::string>({"file2", "file1", "File2", "file10"}));
+
+  packed_string_list mixed{"b", "A", "c"};
+  EXPECT_EQ(as_strings(mixed.sort_ignore_case()), std::vector<std::string>({"A", "b", "c"}));
+  EXPECT_EQ(as_strings(mixed.reverse()), std::vector<std::string>({"c", "b", "A"}));
+}
+
+TEST(PackedStringListTest, SortedUniqueMatchesStringList)
+{
+  const char* symbols = "MSFT\nAAPL\n\nGOOG\nAAPL\nMSFT\nAMZN\n";
+  auto        packed  = packed_string_list::from_lines(symbols);
+  auto        list    = string_list::from_lines(symbols);
+  packed.remove_empty().sort().unique();
+  list.remove_empty().sort().unique();
+  EXPECT_EQ(packed.to_string_list(), list);
+}
+
+TEST(PackedStringListTest, Slicing)
+{
+  packed_string_list list{"a", "b", "c", "d", "e"};
+  EXPECT_EQ(as_strings(list.take(2)), std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(as_strings(list.skip(3)), std::vector<std::string>({"d", "e"}));
+  EXPECT_EQ(as_strings(list.take_last(2)), std::vector<std::string>({"d", "e"}));
+  EXPECT_EQ(as_strings(list.slice(1, 4)), std::vector<std::string>({"b", "c", "d"}));
+  EXPECT_TRUE(list.slice(4, 2).empty());
+  EXPECT_EQ(list.take(10).size(), 5u);
+  EXPECT_TRUE(list.skip(10).empty());
+
+  // Slices copy only their own characters
+  EXPECT_EQ(list.take(2).bytes(), 2u);
+}
+
+TEST(PackedStringListTest, Equality)
+{
+  packed_string_list a{"x", "y"};
+  packed_string_list b = packed_string_list::from_split("x,y", ',');
+  EXPECT_EQ(a, b);
+  b.push_back("z");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a.to_views(), std::vector<std::string_view>({"x", "y"}));
+}
+
+} // namespace fb::test
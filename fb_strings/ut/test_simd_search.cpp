@@ -0,0 +1,649 @@
+/// @file test_simd_search.cpp
+/// @brief Unit tests for the vectorized search kernels
+
+#include <gtest/gtest.h>
+
+#include "fb/simd_search.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fb::test
+{
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+/// Instruction sets this CPU and build can run
+std::vector<simd::isa> available_isas()
+{
+  const simd::isa original = simd::active_isa();
+  std::vector<simd::isa> result;
+  for (simd::isa target : {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2, simd::isa::neon})
+  {
+    if (simd::select_isa(target))
+    {
+      result.push_back(target);
+    }
+  }
+  simd::select_isa(original);
+  return result;
+}
+
+/// Decodes code points and checks their ranges, independently of the kernels
+bool reference_valid_utf8(std::string_view str)
+{
+  std::size_t i = 0;
+  while (i < str.size())
+  {
+    auto lead          = static_cast<unsigned char>(str[i]);
+    std::size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+    if (length == 0 || str.size() - i < length)
+    {
+      return false;
+    }
+    std::uint32_t codepoint = length == 1 ? lead : lead & (0x7F >> length);
+    for (std::size_t k = 1; k < length; ++k)
+    {
+      auto byte = static_cast<unsigned char>(str[i + k]);
+      if ((byte & 0xC0) != 0x80)
+      {
+        return false;
+      }
+      codepoint = (codepoint << 6) | (byte & 0x3F);
+    }
+    static constexpr std::uint32_t MIN_CODEPOINT[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (codepoint < MIN_CODEPOINT[length] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+    {
+      return false;
+    }
+    i += length;
+  }
+  return true;
+}
+
+/// Runs each test body once per available instruction set
+class SimdSearchTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_original = simd::active_isa();
+    m_isas     = available_isas();
+  }
+
+  void TearDown() override
+  {
+    simd::select_isa(m_original);
+  }
+
+  template<typename Body>
+  void for_each_isa(Body&& body)
+  {
+    for (simd::isa target : m_isas)
+    {
+      ASSERT_TRUE(simd::select_isa(target));
+      SCOPED_TRACE(simd::isa_name(target));
+      body();
+    }
+  }
+
+  simd::isa m_original = simd::isa::scalar;
+  std::vector<simd::isa> m_isas;
+};
+
+// ============================================================================
+// Dispatch Tests
+// ============================================================================
+
+TEST_F(SimdSearchTest, ScalarAlwaysAvailable)
+{
+  EXPECT_NE(std::find(m_isas.begin(), m_isas.end(), simd::isa::scalar), m_isas.end());
+  EXPECT_NE(std::find(m_isas.begin(), m_isas.end(), m_original), m_isas.end());
+}
+
+TEST_F(SimdSearchTest, SelectIsa_ChangesActive)
+{
+  for (simd::isa target : m_isas)
+  {
+    simd::select_isa(target);
+    EXPECT_EQ(simd::active_isa(), target);
+  }
+}
+
+TEST_F(SimdSearchTest, IsaName)
+{
+  EXPECT_STREQ(simd::isa_name(simd::isa::scalar), "scalar");
+  EXPECT_STREQ(simd::isa_name(simd::isa::sse2), "sse2");
+  EXPECT_STREQ(simd::isa_name(simd::isa::avx2), "avx2");
+  EXPECT_STREQ(simd::isa_name(simd::isa::neon), "neon");
+}
+
+// ============================================================================
+// find_any Tests
+// ============================================================================
+
+TEST_F(SimdSearchTest, FindAny_Basic)
+{
+  for_each_isa([] {
+    EXPECT_EQ(simd::find_any("hello, world", ", "), 5u);
+    EXPECT_EQ(simd::find_any("hello, world", ", ", 6), 6u);
+    EXPECT_EQ(simd::find_any("hello, world", ", ", 7), std::string_view::npos);
+    EXPECT_EQ(simd::find_any("hello", ""), std::string_view::npos);
+    EXPECT_EQ(simd::find_any("", "abc"), std::string_view::npos);
+    EXPECT_EQ(simd::find_any("abc", "c", 10), std::string_view::npos);
+  });
+}
+
+TEST_F(SimdSearchTest, FindAny_HighBytesAndNul)
+{
+  std::string text(100, 'a');
+  text[70] = '\xff';
+  text[40] = '\0';
+  for_each_isa([&text] {
+    EXPECT_EQ(simd::find_any(text, std::string_view("\xff\x80", 2)), 70u);
+    EXPECT_EQ(simd::find_any(text, std::string_view("\0|", 2)), 40u);
+  });
+}
+
+TEST_F(SimdSearchTest, FindAny_MatchesFindFirstOf)
+{
+  // Every length up to several blocks, every offset of a 64-byte window,
+  // and set sizes on both sides of the vectorized limit
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::string buffer(64 + 200, '\0');
+  for (char& ch : buffer)
+  {
+    ch = static_cast<char>(byte(rng));
+  }
+
+  for (std::size_t set_size : {1u, 2u, 3u, 5u, 8u, 9u, 20u})
+  {
+    std::string set;
+    for (std::size_t i = 0; i < set_size; ++i)
+    {
+      set.push_back(static_cast<char>(byte(rng)));
+    }
+
+    // Sparse haystack: a filler byte outside the set, with a few hits
+    char filler = 0;
+    while (set.find(filler) != std::string::npos)
+    {
+      ++filler;
+    }
+    std::string sparse(buffer.size(), filler);
+    std::uniform_int_distribution<std::size_t> index(0, sparse.size() - 1);
+    for (int i = 0; i < 3; ++i)
+    {
+      sparse[index(rng)] = set[index(rng) % set.size()];
+    }
+
+    for (const std::string* source : {&buffer, &sparse})
+    {
+      for_each_isa([&] {
+        for (std::size_t offset = 0; offset < 64 && offset < source->size(); ++offset)
+        {
+          for (std::size_t length = 0; offset + length <= source->size(); ++length)
+          {
+            std::string_view text(source->data() + offset, length);
+            for (std::size_t pos : {std::size_t{0}, length / 2})
+            {
+              ASSERT_EQ(simd::find_any(text, set, pos), text.find_first_of(set, pos))
+                  << "set_size=" << set_size << " offset=" << offset << " length=" << length
+                  << " pos=" << pos;
+            }
+          }
+        }
+      });
+    }
+  }
+}
+
+// ============================================================================
+// find Tests
+// ============================================================================
+
+TEST_F(SimdSearchTest, Find_Basic)
+{
+  for_each_isa([] {
+    EXPECT_EQ(simd::find("35=D\x01" "55=ABC\x01", "55="), 5u);
+    EXPECT_EQ(simd::find("abcabc", "bc", 2), 4u);
+    EXPECT_EQ(simd::find("abcabc", "c", 3), 5u);
+    EXPECT_EQ(simd::find("abc", "", 1), 1u);
+    EXPECT_EQ(simd::find("abc", "", 3), 3u);
+    EXPECT_EQ(simd::find("abc", "", 4), std::string_view::npos);
+    EXPECT_EQ(simd::find("abc", "abcd"), std::string_view::npos);
+    EXPECT_EQ(simd::find("", "a"), std::string_view::npos);
+  });
+}
+
+TEST_F(SimdSearchTest, Find_MatchesStringViewFind)
+{
+  // Small alphabets give many first/last-byte candidates that fail in the
+  // middle; every window offset and length crosses the block boundaries
+  std::mt19937 rng(4242);
+  for (int alphabet : {2, 4, 256})
+  {
+    std::uniform_int_distribution<int> byte(0, alphabet - 1);
+    std::string buffer(64 + 160, '\0');
+    for (char& ch : buffer)
+    {
+      ch = static_cast<char>(alphabet == 256 ? byte(rng) : 'a' + byte(rng));
+    }
+
+    for (std::size_t needle_size : {2u, 3u, 5u, 17u, 40u})
+    {
+      std::uniform_int_distribution<std::size_t> start(0, buffer.size() - needle_size);
+      std::vector<std::string> needles{buffer.substr(start(rng), needle_size), buffer.substr(start(rng), needle_size)};
+      needles.back().back() = static_cast<char>(~needles.back().back());
+
+      for (const std::string& needle : needles)
+      {
+        for_each_isa([&] {
+          for (std::size_t offset = 0; offset < 64; offset += 3)
+          {
+            for (std::size_t length = 0; offset + length <= buffer.size(); ++length)
+            {
+              std::string_view text(buffer.data() + offset, length);
+              for (std::size_t pos : {std::size_t{0}, length / 3})
+              {
+                ASSERT_EQ(simd::find(text, needle, pos), text.find(needle, pos))
+                    << "alphabet=" << alphabet << " needle_size=" << needle_size << " offset=" << offset
+                    << " length=" << length << " pos=" << pos;
+              }
+            }
+          }
+        });
+      }
+    }
+  }
+}
+
+TEST_F(SimdSearchTest, Find_NeedleAtEnd)
+{
+  for_each_isa([] {
+    for (std::size_t length = 2; length <= 100; ++length)
+    {
+      std::string text(length, 'x');
+      text[length - 2] = '\r';
+      text[length - 1] = '\n';
+      ASSERT_EQ(simd::find(text, "\r\n"), length - 2) << length;
+      ASSERT_EQ(simd::find(text, "x\r\n"), length > 2 ? length - 3 : std::string_view::npos) << length;
+    }
+  });
+}
+
+// ============================================================================
+// find_json_escape Tests
+// ============================================================================
+
+TEST_F(SimdSearchTest, FindJsonEscape_EveryPosition)
+{
+  for_each_isa([] {
+    EXPECT_EQ(simd::find_json_escape(""), std::string_view::npos);
+    for (std::size_t length = 1; length <= 80; ++length)
+    {
+      std::string text(length, 'a');
+      ASSERT_EQ(simd::find_json_escape(text), std::string_view::npos) << length;
+      for (std::size_t i = 0; i < length; ++i)
+      {
+        for (char special : {'\0', '\x1f', '"', '\\'})
+        {
+          text[i] = special;
+          ASSERT_EQ(simd::find_json_escape(text), i) << length << " " << i;
+          ASSERT_EQ(simd::find_json_escape(text, i + 1), std::string_view::npos) << length << " " << i;
+        }
+        text[i] = 'a';
+      }
+    }
+  });
+}
+
+TEST_F(SimdSearchTest, FindJsonEscape_EveryByte)
+{
+  for_each_isa([] {
+    for (int byte = 0; byte < 256; ++byte)
+    {
+      std::string text(40, ' ');
+      text[35]            = static_cast<char>(byte);
+      const bool special  = byte < 0x20 || byte == '"' || byte == '\\';
+      const std::size_t expected = special ? 35 : std::string_view::npos;
+      ASSERT_EQ(simd::find_json_escape(text), expected) << byte;
+      ASSERT_EQ(simd::find_json_escape(text.substr(30)), special ? 5 : std::string_view::npos) << byte;
+    }
+  });
+}
+
+// ============================================================================
+// is_ascii Tests
+// ============================================================================
+
+TEST_F(SimdSearchTest, IsAscii_EveryPosition)
+{
+  for_each_isa([] {
+    EXPECT_TRUE(simd::is_ascii(""));
+    for (std::size_t length = 1; length <= 200; ++length)
+    {
+      std::string text(length, '\x7f');
+      ASSERT_TRUE(simd::is_ascii(text)) << length;
+      for (std::size_t i = 0; i < length; ++i)
+      {
+        text[i] = '\x80';
+        ASSERT_FALSE(simd::is_ascii(text)) << length << " " << i;
+        text[i] = 'a';
+      }
+    }
+  });
+}
+
+// ============================================================================
+// is_valid_utf8 Tests
+// ============================================================================
+
+TEST_F(SimdSearchTest, IsValidUtf8_Basic)
+{
+  for_each_isa([] {
+    EXPECT_TRUE(simd::is_valid_utf8(""));
+    EXPECT_TRUE(simd::is_valid_utf8("plain ascii"));
+    EXPECT_TRUE(simd::is_valid_utf8("caf\xc3\xa9 \xe4\xb8\x96\xe7\x95\x8c \xf0\x9f\x98\x80"));
+    EXPECT_TRUE(simd::is_valid_utf8("\xed\x9f\xbf \xee\x80\x80 \xf4\x8f\xbf\xbf")); // U+D7FF U+E000 U+10FFFF
+
+    EXPECT_FALSE(simd::is_valid_utf8("\x80"));             // Lone continuation
+    EXPECT_FALSE(simd::is_valid_utf8("\xc3"));             // Truncated
+    EXPECT_FALSE(simd::is_valid_utf8("\xc0\xaf"));         // Overlong '/'
+    EXPECT_FALSE(simd::is_valid_utf8("\xe0\x80\xaf"));     // Overlong 3-byte
+    EXPECT_FALSE(simd::is_valid_utf8("\xf0\x80\x80\xaf")); // Overlong 4-byte
+    EXPECT_FALSE(simd::is_valid_utf8("\xed\xa0\x80"));     // Surrogate U+D800
+    EXPECT_FALSE(simd::is_valid_utf8("\xf4\x90\x80\x80")); // U+110000
+    EXPECT_FALSE(simd::is_valid_utf8("\xf8\x88\x80\x80\x80"));
+    EXPECT_FALSE(simd::is_valid_utf8("\xff"));
+  });
+}
+
+TEST_F(SimdSearchTest, IsValidUtf8_ErrorAtEveryPosition)
+{
+  // Valid and invalid sequences placed across every block boundary
+  const std::string_view sequences[] = {
+      "\xc3\xa9",         "\xe4\xb8\x96",     "\xf0\x9f\x98\x80", "\xc3",         "\xe4\xb8",
+      "\xf0\x9f\x98",     "\x80",             "\xc1\xbf",         "\xe0\x9f\xbf",  "\xed\xa0\x80",
+      "\xf4\x90\x80\x80", "\xf0\x8f\xbf\xbf", "\xc3\xa9\xa9",     "\xfe"};
+  for_each_isa([&sequences] {
+    for (std::string_view sequence : sequences)
+    {
+      const bool valid = reference_valid_utf8(sequence);
+      for (std::size_t pos = 0; pos <= 70; ++pos)
+      {
+        for (std::size_t after : {std::size_t{0}, std::size_t{1}, std::size_t{40}})
+        {
+          std::string text = std::string(pos, 'a') + std::string(sequence) + std::string(after, 'b');
+          ASSERT_EQ(simd::is_valid_utf8(text), valid) << "pos=" << pos << " after=" << after;
+        }
+      }
+    }
+  });
+}
+
+TEST_F(SimdSearchTest, IsValidUtf8_MatchesReference)
+{
+  // Random strings built mostly from valid code points, with a byte
+  // corrupted in about half of them
+  std::mt19937 rng(2024);
+  const std::string_view pieces[] = {"a", "z ", "\xc3\xa9", "\xdf\xbf", "\xe0\xa0\x80", "\xed\x9f\xbf",
+                                     "\xef\xbf\xbf", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf"};
+  std::uniform_int_distribution<std::size_t> piece(0, std::size(pieces) - 1);
+  std::uniform_int_distribution<int> byte(0, 255);
+
+  std::vector<std::string> samples;
+  for (int n = 0; n < 2000; ++n)
+  {
+    std::string text;
+    std::size_t count = static_cast<std::size_t>(n % 80);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      text += pieces[piece(rng)];
+    }
+    if (!text.empty() && n % 2 == 1)
+    {
+      text[static_cast<std::size_t>(byte(rng)) % text.size()] = static_cast<char>(byte(rng));
+    }
+    samples.push_back(text);
+  }
+
+  for_each_isa([&samples] {
+    for (const std::string& text : samples)
+    {
+      ASSERT_EQ(simd::is_valid_utf8(text), reference_valid_utf8(text)) << testing::PrintToString(text);
+    }
+  });
+}
+
+// ============================================================================
+// replace Tests
+// ============================================================================
+
+TEST_F(SimdSearchTest, Replace_MatchesScalarLoop)
+{
+  std::mt19937 rng(777);
+  std::uniform_int_distribution<int> byte('a', 'd');
+  for_each_isa([&rng, &byte] {
+    for (std::size_t length = 0; length <= 130; ++length)
+    {
+      std::string text(length, '\0');
+      for (char& ch : text)
+      {
+        ch = static_cast<char>(byte(rng));
+      }
+      std::string expected = text;
+      std::replace(expected.begin(), expected.end(), 'b', '\xe9');
+
+      // Leading byte, so the vector part starts unaligned
+      std::string padded = "#" + text;
+      simd::replace(padded.data() + 1, length, 'b', '\xe9');
+      ASSERT_EQ(padded.substr(1), expected) << length;
+      ASSERT_EQ(padded[0], '#');
+    }
+  });
+}
+
+TEST_F(SimdSearchTest, Replace_SameCharacter_Unchanged)
+{
+  std::string text = "a,b,c";
+  simd::replace(text.data(), text.size(), ',', ',');
+  EXPECT_EQ(text, "a,b,c");
+}
+
+// ============================================================================
+// Case Conversion Tests
+// ============================================================================
+
+namespace
+{
+
+/// Every byte value, repeated with a shift so each lands in every lane
+std::string all_bytes(std::size_t length)
+{
+  std::string text(length, '\0');
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    text[i] = static_cast<char>((i * 7) % 256);
+  }
+  return text;
+}
+
+} // namespace
+
+TEST_F(SimdSearchTest, CaseConversion_MatchesPerByteRule)
+{
+  for_each_isa([] {
+    for (std::size_t length = 0; length <= 300; ++length)
+    {
+      const std::string text = all_bytes(length);
+      std::string lower = text, upper = text, swapped = text;
+      simd::to_lower(lower.data(), lower.size());
+      simd::to_upper(upper.data(), upper.size());
+      simd::swap_case(swapped.data(), swapped.size());
+
+      for (std::size_t i = 0; i < length; ++i)
+      {
+        const char ch       = text[i];
+        const bool is_upper = ch >= 'A' && ch <= 'Z';
+        const bool is_lower = ch >= 'a' && ch <= 'z';
+        ASSERT_EQ(lower[i], is_upper ? static_cast<char>(ch + 32) : ch) << length << " " << i;
+        ASSERT_EQ(upper[i], is_lower ? static_cast<char>(ch - 32) : ch) << length << " " << i;
+        ASSERT_EQ(swapped[i], is_upper ? static_cast<char>(ch + 32) : is_lower ? static_cast<char>(ch - 32) : ch)
+            << length << " " << i;
+      }
+    }
+  });
+}
+
+TEST_F(SimdSearchTest, EqualsIgnoreCase_EveryMismatchPosition)
+{
+  for_each_isa([] {
+    EXPECT_TRUE(simd::equals_ignore_case("", ""));
+    EXPECT_FALSE(simd::equals_ignore_case("a", "ab"));
+    for (std::size_t length = 1; length <= 100; ++length)
+    {
+      std::string a = all_bytes(length);
+      std::string b = a;
+      simd::swap_case(b.data(), b.size());
+      ASSERT_TRUE(simd::equals_ignore_case(a, b)) << length;
+
+      for (std::size_t i = 0; i < length; ++i)
+      {
+        // Flipping bit 0x20 keeps equality only for letters; bit 0 never
+        std::string c = b;
+        c[i]          = static_cast<char>(c[i] ^ 0x20);
+        const char folded = static_cast<char>(a[i] | 0x20);
+        const bool letter = folded >= 'a' && folded <= 'z';
+        ASSERT_EQ(simd::equals_ignore_case(a, c), letter) << length << " " << i;
+        c[i] = static_cast<char>(c[i] ^ 0x01);
+        ASSERT_FALSE(simd::equals_ignore_case(a, c)) << length << " " << i;
+      }
+    }
+  });
+}
+
+// ============================================================================
+// Whitespace and Line Classification Tests
+// ============================================================================
+
+namespace
+{
+
+bool is_blank(char ch)
+{
+  return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\v' || ch == '\f' || ch == '\r';
+}
+
+/// Text from a small alphabet, dense in boundaries and \r\n pairs
+std::string blank_text(std::mt19937& rng, std::size_t length)
+{
+  static constexpr std::string_view ALPHABET = "ab \t\n\r\v\f\x85\xa0";
+  std::string text(length, '\0');
+  for (char& ch : text)
+  {
+    ch = ALPHABET[rng() % ALPHABET.size()];
+  }
+  return text;
+}
+
+std::size_t reference_words(std::string_view str)
+{
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < str.size(); ++i)
+  {
+    count += !is_blank(str[i]) && (i == 0 || is_blank(str[i - 1])) ? 1 : 0;
+  }
+  return count;
+}
+
+std::size_t reference_lines(std::string_view str)
+{
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < str.size(); ++i)
+  {
+    const bool lone_cr = str[i] == '\r' && (i + 1 == str.size() || str[i + 1] != '\n');
+    count += str[i] == '\n' || lone_cr ? 1 : 0;
+  }
+  return count + (!str.empty() && str.back() != '\n' && str.back() != '\r' ? 1 : 0);
+}
+
+} // namespace
+
+TEST_F(SimdSearchTest, Classify_EveryByte)
+{
+  for_each_isa([] {
+    for (std::size_t size : {64, 63, 1, 0})
+    {
+      for (std::size_t offset = 0; offset < 256; offset += 64)
+      {
+        const std::string   text  = all_bytes(256 + 64).substr(offset, 64);
+        const simd::block_masks masks = simd::classify(text.data(), size);
+        for (std::size_t k = 0; k < 64; ++k)
+        {
+          const char ch = k < size ? text[k] : ' ';
+          ASSERT_EQ((masks.whitespace >> k) & 1, is_blank(ch) ? 1u : 0u) << size << " " << k;
+          ASSERT_EQ((masks.line_feed >> k) & 1, ch == '\n' ? 1u : 0u) << size << " " << k;
+          ASSERT_EQ((masks.carriage_return >> k) & 1, ch == '\r' ? 1u : 0u) << size << " " << k;
+        }
+      }
+    }
+  });
+}
+
+TEST_F(SimdSearchTest, FindWhitespace_MatchesFindFirstOf)
+{
+  std::mt19937 rng(90);
+  for_each_isa([&rng] {
+    for (std::size_t length = 0; length <= 200; ++length)
+    {
+      std::string text = blank_text(rng, length);
+      // Long runs, so the scans cross whole blocks
+      std::string words = std::string(length, 'x') + text + std::string(length, ' ') + "y";
+      for (std::string_view str : {std::string_view(text), std::string_view(words)})
+      {
+        for (std::size_t pos = 0; pos <= str.size() + 1; pos += 1 + pos / 8)
+        {
+          ASSERT_EQ(simd::find_whitespace(str, pos), str.find_first_of(" \t\n\v\f\r", pos)) << length << " " << pos;
+          ASSERT_EQ(simd::find_non_whitespace(str, pos), str.find_first_not_of(" \t\n\v\f\r", pos))
+              << length << " " << pos;
+        }
+      }
+    }
+  });
+}
+
+TEST_F(SimdSearchTest, CountWordsAndLines_MatchReference)
+{
+  std::mt19937 rng(91);
+  for_each_isa([&rng] {
+    EXPECT_EQ(simd::count_words(""), 0u);
+    EXPECT_EQ(simd::count_lines(""), 0u);
+    EXPECT_EQ(simd::count_lines("a\nb"), 2u);
+    EXPECT_EQ(simd::count_lines("a\nb\n"), 2u);
+    EXPECT_EQ(simd::count_lines("\r\n\r\n"), 2u);
+    EXPECT_EQ(simd::count_lines("\n\r"), 2u);
+    for (std::size_t length = 1; length <= 300; ++length)
+    {
+      const std::string text = blank_text(rng, length);
+      ASSERT_EQ(simd::count_words(text), reference_words(text)) << testing::PrintToString(text);
+      ASSERT_EQ(simd::count_lines(text), reference_lines(text)) << testing::PrintToString(text);
+    }
+
+    // \r\n pairs straddling every block boundary
+    for (std::size_t split = 60; split < 70; ++split)
+    {
+      std::string text = std::string(split, 'a') + "\r\n" + std::string(130, 'b') + "\r";
+      ASSERT_EQ(simd::count_lines(text), 2u) << split;
+      ASSERT_EQ(simd::count_words(text), 2u) << split;
+    }
+  });
+}
+
+} // namespace fb::test
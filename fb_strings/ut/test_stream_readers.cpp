@@ -0,0 +1,183 @@
+/// @file test_stream_readers.cpp
+/// @brief Unit tests for the chunked stream readers
+
+#include <fb/stream_readers.h>
+#include <fb/string_iterators.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace fb::test
+{
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+template <typename Reader>
+std::vector<std::string> collect(Reader&& reader)
+{
+  std::vector<std::string> result;
+  while (reader.has_next())
+  {
+    result.emplace_back(reader.next());
+  }
+  return result;
+}
+
+/// line_iterator output without its empty line after a final line ending
+std::vector<std::string> reference_lines(std::string_view input)
+{
+  std::vector<std::string> lines = collect(line_iterator(input));
+  if (input.empty() || input.back() == '\n' || input.back() == '\r')
+  {
+    lines.pop_back();
+  }
+  return lines;
+}
+
+/// Source handing out one byte per read, like a slow socket
+struct trickle
+{
+  std::string_view data;
+  std::size_t      pos = 0;
+
+  static std::size_t read(void* context, char* buffer, std::size_t size)
+  {
+    auto& self = *static_cast<trickle*>(context);
+    if (self.pos == self.data.size() || size == 0)
+    {
+      return 0;
+    }
+    buffer[0] = self.data[self.pos++];
+    return 1;
+  }
+};
+
+std::vector<std::string> random_inputs()
+{
+  std::mt19937             rng(89);
+  const std::string_view   alphabet = "ab \r\n,\t";
+  std::vector<std::string> inputs   = {"", "\n", "\r\n", "\r", "a", "a\n", "a\r\nb", "a\r\r\nb\n\n", " a  b ", ",", "a,,b,"};
+  for (int i = 0; i < 300; ++i)
+  {
+    std::string input(rng() % 40, ' ');
+    for (char& ch : input)
+    {
+      ch = alphabet[rng() % alphabet.size()];
+    }
+    inputs.push_back(input);
+  }
+  return inputs;
+}
+
+// ============================================================================
+// Equivalence with the in-memory iterators
+// ============================================================================
+
+TEST(StreamReadersTest, LinesMatchAcrossChunkSizes)
+{
+  for (const std::string& input : random_inputs())
+  {
+    for (std::size_t chunk : {1, 2, 3, 7, 64})
+    {
+      std::istringstream in(input);
+      EXPECT_EQ(collect(line_reader(in, chunk)), reference_lines(input)) << chunk;
+    }
+    trickle source{input};
+    EXPECT_EQ(collect(line_reader(byte_source(&source, &trickle::read), 4)), reference_lines(input));
+  }
+}
+
+TEST(StreamReadersTest, WordsMatchAcrossChunkSizes)
+{
+  for (const std::string& input : random_inputs())
+  {
+    for (std::size_t chunk : {1, 2, 3, 7, 64})
+    {
+      std::istringstream in(input);
+      EXPECT_EQ(collect(word_reader(in, chunk)), collect(word_iterator(input))) << chunk;
+    }
+  }
+}
+
+TEST(StreamReadersTest, TokensMatchAcrossChunkSizes)
+{
+  for (const std::string& input : random_inputs())
+  {
+    for (std::size_t chunk : {1, 2, 3, 7, 64})
+    {
+      std::istringstream in(input);
+      EXPECT_EQ(collect(token_reader(in, ",\t", chunk)), collect(token_iterator(input, ",\t"))) << chunk;
+    }
+  }
+}
+
+// ============================================================================
+// Buffering
+// ============================================================================
+
+TEST(StreamReadersTest, LongLineGrowsTheBuffer)
+{
+  const std::string  long_line(100000, 'x');
+  std::istringstream in("first\n" + long_line + "\r\nlast");
+  line_reader        lines(in, 16);
+  EXPECT_EQ(lines.next(), "first");
+  EXPECT_EQ(lines.next(), long_line);
+  EXPECT_EQ(lines.next(), "last");
+  EXPECT_FALSE(lines.has_next());
+  EXPECT_EQ(lines.next(), "");
+}
+
+TEST(StreamReadersTest, CrLfSplitAcrossReads)
+{
+  // The \r ends one read and the \n starts the next
+  const std::string input = "a\r\nb\r";
+  trickle           source{input};
+  line_reader       lines(byte_source(&source, &trickle::read));
+  EXPECT_EQ(lines.next(), "a");
+  EXPECT_EQ(lines.next(), "b");
+  EXPECT_FALSE(lines.has_next());
+}
+
+TEST(StreamReadersTest, HasNextDoesNotConsume)
+{
+  std::istringstream in("one two");
+  word_reader        words(in);
+  EXPECT_TRUE(words.has_next());
+  EXPECT_TRUE(words.has_next());
+  EXPECT_EQ(words.next(), "one");
+  EXPECT_EQ(words.next(), "two");
+  EXPECT_FALSE(words.has_next());
+}
+
+#if !defined(_WIN32)
+TEST(StreamReadersTest, ReadsFromFileDescriptor)
+{
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  const std::string input = "8=FIX.4.4|35=D|55=EURUSD";
+  ASSERT_EQ(::write(fds[1], input.data(), input.size()), static_cast<ssize_t>(input.size()));
+  ::close(fds[1]);
+
+  token_reader fields(byte_source::from_fd(fds[0]), "|", 5);
+  EXPECT_EQ(collect(fields), (std::vector<std::string>{"8=FIX.4.4", "35=D", "55=EURUSD"}));
+  ::close(fds[0]);
+}
+
+TEST(StreamReadersTest, ReadErrorThrows)
+{
+  line_reader lines(byte_source::from_fd(-1));
+  EXPECT_THROW((void)lines.has_next(), std::system_error);
+}
+#endif
+
+} // namespace fb::test
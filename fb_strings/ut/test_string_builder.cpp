@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <memory_resource>
 
 namespace fb::test
 {
@@ -199,6 +200,15 @@ TEST(StringBuilderTest, AppendDoubleZero)
   EXPECT_EQ(sb.to_string(), "0.00");
 }
 
+TEST(StringBuilderTest, AppendDoubleLargeValue)
+{
+  string_builder sb("x");
+  sb.append_double(-1e100, 1);
+  EXPECT_EQ(sb.size(), 1 + 1 + 101 + 2u);
+  EXPECT_EQ(sb.view().substr(0, 4), "x-10");
+  EXPECT_EQ(sb.view().substr(sb.size() - 2), ".0");
+}
+
 TEST(StringBuilderTest, AppendBoolTrue)
 {
   string_builder sb;
@@ -213,6 +223,21 @@ TEST(StringBuilderTest, AppendBoolFalse)
   EXPECT_EQ(sb.to_string(), "false");
 }
 
+TEST(StringBuilderTest, AppendJsonEscaped)
+{
+  string_builder sb;
+  sb.append("{\"note\":\"").append_json_escaped("say \"hi\"\n\x01").append("\"}");
+  EXPECT_EQ(sb.to_string(), "{\"note\":\"say \\\"hi\\\"\\n\\u0001\"}");
+}
+
+TEST(StringBuilderTest, AppendHtmlEscaped)
+{
+  std::pmr::monotonic_buffer_resource arena(256);
+  pmr_string_builder sb(&arena);
+  sb.append("<td>").append_html_escaped("AT&T <ok>").append("</td>");
+  EXPECT_EQ(sb.view(), "<td>AT&amp;T &lt;ok&gt;</td>");
+}
+
 // ============================================================================
 // Stream Operator Tests
 // ============================================================================
@@ -640,6 +665,13 @@ TEST(StringBuilderTest, AppendFormatChained)
   EXPECT_EQ(sb.to_string(), "Values: 10, 20\nSum: 30");
 }
 
+TEST(StringBuilderTest, AppendFormatCompiled)
+{
+  string_builder sb("x=");
+  sb.append_format(FB_FORMAT_STRING("{:04}|{:<3}|"), 7, "ab");
+  EXPECT_EQ(sb.to_string(), "x=0007|ab |");
+}
+
 // ============================================================================
 // Clear Returns This Tests
 // ============================================================================
@@ -665,4 +697,79 @@ TEST(StringBuilderTest, ModificationChaining)
   EXPECT_EQ(sb.to_string(), "Hello Wonderful World");
 }
 
+// ============================================================================
+// Release and Reset Tests
+// ============================================================================
+
+TEST(StringBuilderTest, ReleaseMovesBufferOut)
+{
+  string_builder sb;
+  sb.append(std::string(100, 'x'));
+  const char* data = sb.view().data();
+
+  std::string released = sb.release();
+  EXPECT_EQ(released, std::string(100, 'x'));
+  EXPECT_EQ(released.data(), data);
+  EXPECT_TRUE(sb.empty());
+
+  sb.append("next");
+  EXPECT_EQ(sb.to_string(), "next");
+}
+
+TEST(StringBuilderTest, ResetRestoresReleasedCapacity)
+{
+  string_builder sb(512);
+  sb.append("message");
+  const std::size_t capacity = sb.capacity();
+
+  (void)sb.release();
+  sb.reset();
+  EXPECT_TRUE(sb.empty());
+  EXPECT_GE(sb.capacity(), capacity);
+}
+
+TEST(StringBuilderTest, ResetKeepsCapacity)
+{
+  string_builder sb(512);
+  sb.append("message");
+  const std::size_t capacity = sb.capacity();
+
+  sb.reset().append("next");
+  EXPECT_EQ(sb.to_string(), "next");
+  EXPECT_EQ(sb.capacity(), capacity);
+}
+
+// ============================================================================
+// Allocator Tests
+// ============================================================================
+
+TEST(StringBuilderTest, PmrBuilderAllocatesFromResource)
+{
+  char storage[4096];
+  std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage), std::pmr::null_memory_resource());
+
+  pmr_string_builder sb(&arena);
+  sb.append("8=FIX.4.4").append('\x01').append_int(35).append("=D").append_format("|{}|", 42);
+  sb.replace_all("|", "\x01");
+  EXPECT_EQ(sb.view(), "8=FIX.4.4\x01" "35=D\x01" "42\x01");
+  EXPECT_EQ(sb.get_allocator().resource(), &arena);
+
+  std::pmr::string released = sb.release();
+  EXPECT_EQ(released.get_allocator().resource(), &arena);
+  EXPECT_GE(released.data(), storage);
+  EXPECT_LT(released.data(), storage + sizeof(storage));
+}
+
+TEST(StringBuilderTest, PmrBuilderWithCapacityAndContent)
+{
+  std::pmr::monotonic_buffer_resource arena;
+
+  pmr_string_builder reserved(256, &arena);
+  EXPECT_GE(reserved.capacity(), 256u);
+
+  pmr_string_builder initial("Hello", &arena);
+  initial.append(", World");
+  EXPECT_EQ(initial.to_string(), "Hello, World");
+}
+
 } // namespace fb::test
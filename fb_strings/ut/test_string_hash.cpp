@@ -7,6 +7,7 @@
 
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace fb::test
@@ -178,6 +179,23 @@ TEST(StringHashTest, CaseInsensitiveDifferentStrings)
   EXPECT_NE(h1, h2);
 }
 
+TEST(StringHashTest, CaseInsensitiveLongString_MatchesFnv1aOfLowercase)
+{
+  // Spans several internal lowercase chunks
+  std::string upper;
+  for (int i = 0; i < 700; ++i)
+  {
+    upper.push_back(static_cast<char>('A' + i % 26));
+  }
+  std::string lower = upper;
+  for (char& c : lower)
+  {
+    c = static_cast<char>(c + ('a' - 'A'));
+  }
+  EXPECT_EQ(hash_case_insensitive(upper), hash_fnv1a_32(lower));
+  EXPECT_EQ(hash_case_insensitive(lower), hash_fnv1a_32(lower));
+}
+
 TEST(StringHashTest, CaseInsensitiveWithNumbers)
 {
   uint32_t h1 = hash_case_insensitive("Test123");
@@ -253,6 +271,209 @@ TEST(StringHashTest, Crc32WithNullBytes)
   EXPECT_NE(c, crc32("helloworld"));
 }
 
+namespace
+{
+
+/// One bit at a time, straight from the definition
+uint32_t crc_bitwise(uint32_t polynomial, const std::string& data)
+{
+  uint32_t crc = 0xFFFFFFFF;
+  for (unsigned char byte : data)
+  {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; ++bit)
+    {
+      crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+    }
+  }
+  return ~crc;
+}
+
+std::string crc_test_data(std::size_t length)
+{
+  std::string data;
+  uint32_t    state = 12345;
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    state = state * 1103515245 + 12345;
+    data.push_back(static_cast<char>(state >> 16));
+  }
+  return data;
+}
+
+} // namespace
+
+TEST(StringHashTest, Crc32MatchesBitwiseForEveryLengthAndOffset)
+{
+  const std::string data = crc_test_data(300);
+  for (std::size_t offset = 0; offset < 8; ++offset)
+  {
+    for (std::size_t length = 0; offset + length <= data.size(); length += 1 + length / 16)
+    {
+      std::string piece = data.substr(offset, length);
+      EXPECT_EQ(crc32(data.data() + offset, length), crc_bitwise(0xEDB88320, piece))
+          << "offset " << offset << ", length " << length;
+    }
+  }
+}
+
+TEST(StringHashTest, Crc32UpdateMatchesWhole)
+{
+  const std::string data = crc_test_data(1000);
+  for (std::size_t split : {0, 1, 7, 8, 9, 500, 999, 1000})
+  {
+    uint32_t crc = crc32_update(0, data.data(), split);
+    crc          = crc32_update(crc, std::string_view(data).substr(split));
+    EXPECT_EQ(crc, crc32(data)) << "split " << split;
+  }
+}
+
+// ============================================================================
+// CRC-32C Tests
+// ============================================================================
+
+TEST(StringHashTest, Crc32cKnownValues)
+{
+  EXPECT_EQ(crc32c(""), 0x00000000U);
+  EXPECT_EQ(crc32c("123456789"), 0xE3069283U);
+
+  // RFC 3720 (iSCSI) test vectors
+  std::vector<uint8_t> zeros(32, 0x00);
+  std::vector<uint8_t> ones(32, 0xFF);
+  std::vector<uint8_t> ascending;
+  for (int i = 0; i < 32; ++i)
+  {
+    ascending.push_back(static_cast<uint8_t>(i));
+  }
+  EXPECT_EQ(crc32c(zeros.data(), zeros.size()), 0x8A9136AAU);
+  EXPECT_EQ(crc32c(ones.data(), ones.size()), 0x62A8AB43U);
+  EXPECT_EQ(crc32c(ascending.data(), ascending.size()), 0x46DD794EU);
+}
+
+TEST(StringHashTest, Crc32cMatchesBitwiseForEveryLengthAndOffset)
+{
+  const std::string data = crc_test_data(300);
+  for (std::size_t offset = 0; offset < 8; ++offset)
+  {
+    for (std::size_t length = 0; offset + length <= data.size(); length += 1 + length / 16)
+    {
+      std::string piece = data.substr(offset, length);
+      EXPECT_EQ(crc32c(data.data() + offset, length), crc_bitwise(0x82F63B78, piece))
+          << "offset " << offset << ", length " << length;
+    }
+  }
+}
+
+TEST(StringHashTest, Crc32cUpdateMatchesWhole)
+{
+  const std::string data = crc_test_data(1000);
+  uint32_t          crc  = 0;
+  for (std::size_t pos = 0; pos < data.size(); pos += 37)
+  {
+    crc = crc32c_update(crc, std::string_view(data).substr(pos, 37));
+  }
+  EXPECT_EQ(crc, crc32c(data));
+  EXPECT_NE(crc, crc32(data));
+}
+
+// ============================================================================
+// XXH3 Tests
+// ============================================================================
+
+namespace
+{
+
+/// 'a'..'z' repeated, so every length takes a different prefix
+std::string xxh3_pattern(std::size_t length)
+{
+  std::string result;
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    result.push_back(static_cast<char>('a' + i % 26));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(StringHashTest, Xxh3KnownValues)
+{
+  // Reference XXH3_64bits_withSeed() results, one per length class
+  EXPECT_EQ(hash_xxh3_64(""), 0x2d06800538d394c2ULL);
+  EXPECT_EQ(hash_xxh3_64("a"), 0xe6c632b61e964e1fULL);
+  EXPECT_EQ(hash_xxh3_64("hello"), 0x9555e8555c62dcfdULL);
+  EXPECT_EQ(hash_xxh3_64("hello world!"), 0xe155d613728f4b18ULL);
+  EXPECT_EQ(hash_xxh3_64(xxh3_pattern(100)), 0x7f2b83f8e57a6e24ULL);
+  EXPECT_EQ(hash_xxh3_64(xxh3_pattern(200)), 0xe12dae8ffe57bbc9ULL);
+  EXPECT_EQ(hash_xxh3_64(xxh3_pattern(3000)), 0x2543c13b9577de82ULL);
+}
+
+TEST(StringHashTest, Xxh3SeededKnownValues)
+{
+  EXPECT_EQ(hash_xxh3_64("hello", 42), 0xbafa072f07db7937ULL);
+  EXPECT_EQ(hash_xxh3_64(xxh3_pattern(3000), 42), 0x3e54410695b2579dULL);
+}
+
+TEST(StringHashTest, Xxh3SeedChangesEveryLengthClass)
+{
+  for (std::size_t length : {0, 2, 6, 12, 100, 200, 3000})
+  {
+    std::string key = xxh3_pattern(length);
+    EXPECT_NE(hash_xxh3_64(key, 1), hash_xxh3_64(key, 2)) << "length " << length;
+  }
+}
+
+TEST(StringHashTest, Xxh3BinaryOverloadMatchesString)
+{
+  std::string key = xxh3_pattern(500);
+  key[17]         = '\0';
+  EXPECT_EQ(hash_xxh3_64(key.data(), key.size(), 7), hash_xxh3_64(key, 7));
+}
+
+TEST(StringHashTest, Xxh3HasherMatchesOneShotForAnySplit)
+{
+  const std::string data = xxh3_pattern(2100);
+  for (std::size_t length : {0, 1, 17, 240, 241, 256, 257, 1024, 1025, 2100})
+  {
+    std::string_view input(data.data(), length);
+    for (std::size_t chunk : {1, 7, 64, 255, 256, 300, 2100})
+    {
+      xxh3_64_hasher hasher(99);
+      for (std::size_t pos = 0; pos < length; pos += chunk)
+      {
+        hasher.update(input.substr(pos, chunk));
+      }
+      EXPECT_EQ(hasher.digest(), hash_xxh3_64(input, 99)) << "length " << length << ", chunk " << chunk;
+    }
+  }
+}
+
+TEST(StringHashTest, Xxh3HasherDigestKeepsState)
+{
+  xxh3_64_hasher hasher;
+  hasher.update(xxh3_pattern(300));
+  uint64_t first = hasher.digest();
+  EXPECT_EQ(first, hasher.digest());
+
+  hasher.update("more");
+  EXPECT_EQ(hasher.digest(), hash_xxh3_64(xxh3_pattern(300) + "more"));
+
+  hasher.reset(5);
+  EXPECT_EQ(hasher.digest(), hash_xxh3_64("", 5));
+}
+
+TEST(StringHashTest, Xxh3HashFunctorInUnorderedMap)
+{
+  std::unordered_map<std::string, int, xxh3_hash, std::equal_to<>> symbols;
+  symbols.emplace("EURUSD", 1);
+  symbols.emplace("GBPUSD", 2);
+
+  std::string_view key = "EURUSD";
+  EXPECT_EQ(xxh3_hash{}(key), static_cast<std::size_t>(hash_xxh3_64(key)));
+  ASSERT_NE(symbols.find(std::string(key)), symbols.end());
+  EXPECT_EQ(symbols.find(std::string(key))->second, 1);
+}
+
 // ============================================================================
 // General Hash Property Tests
 // ============================================================================
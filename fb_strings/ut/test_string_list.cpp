@@ -319,6 +319,16 @@ TEST(StringList, FilterMatching)
   EXPECT_EQ(filtered.size(), 2u);
 }
 
+TEST(StringList, FilterFuzzy)
+{
+  string_list list{"AAPL", "AAPLX", "APPL", "MSFT", "AAPL.O", "", "GOOGL"};
+  EXPECT_EQ(list.filter_fuzzy("AAPL", 0), (string_list{"AAPL"}));
+  EXPECT_EQ(list.filter_fuzzy("AAPL", 1), (string_list{"AAPL", "AAPLX", "APPL"}));
+  EXPECT_EQ(list.filter_fuzzy("AAPL", 2), (string_list{"AAPL", "AAPLX", "APPL", "AAPL.O"}));
+  EXPECT_EQ(list.filter_fuzzy("", 0), (string_list{""}));
+  EXPECT_EQ(list.filter_fuzzy("AAPL", std::numeric_limits<size_t>::max()).size(), list.size());
+}
+
 // ============================================================================
 // Search Operation Tests
 // ============================================================================
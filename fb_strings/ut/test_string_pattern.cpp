@@ -0,0 +1,283 @@
+/// @file test_string_pattern.cpp
+/// @brief Unit tests for compiled glob/regex patterns and pattern_cache
+
+#include <fb/string_list.h>
+#include <fb/string_pattern.h>
+#include <fb/string_utils.h>
+
+#include <gtest/gtest.h>
+
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace fb::test
+{
+
+namespace
+{
+
+/// Inputs covering empty strings, line terminators and bytes above 127
+std::vector<std::string> sample_inputs()
+{
+  return {"",
+          "a",
+          "b",
+          "ab",
+          "ba",
+          "abc",
+          "aabbcc",
+          "abab",
+          "cab",
+          "xyz",
+          "EURUSD",
+          "eurusd",
+          "EURGBP",
+          "USDJPY",
+          "ERROR 42 disk",
+          "FATAL 7",
+          "WARN 123",
+          "error 42",
+          "a\nb",
+          "a\rb",
+          "\n",
+          "line\n",
+          "x_1 y",
+          "tab\there",
+          "12345",
+          "1.08",
+          "-",
+          "a-z",
+          "\xc3\xa9t\xc3\xa9",
+          "\xff\x80",
+          std::string("nul\0byte", 8),
+          "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab",
+          "(a|b)",
+          "[x]",
+          "a.b*c?"};
+}
+
+} // namespace
+
+// ============================================================================
+// Glob Tests
+// ============================================================================
+
+TEST(CompiledPatternTest, Glob_MatchesWholeString)
+{
+  const auto pattern = compiled_pattern::glob("EUR*");
+  EXPECT_TRUE(pattern.is_dfa());
+  EXPECT_TRUE(pattern.matches("EURUSD"));
+  EXPECT_TRUE(pattern.matches("EUR"));
+  EXPECT_FALSE(pattern.matches("USDEUR"));
+  EXPECT_FALSE(pattern.matches("eurusd"));
+
+  const auto question = compiled_pattern::glob("h???o.txt");
+  EXPECT_TRUE(question.matches("hello.txt"));
+  EXPECT_FALSE(question.matches("helo.txt"));
+}
+
+TEST(CompiledPatternTest, Glob_AgreesWithMatchesPattern)
+{
+  const std::vector<std::string> globs = {"", "*", "?", "a*", "*b", "a*b*c", "*a*", "??", "EUR???", "*USD",
+                                          "E*R*", "a?b", "**", "*\n*", "\xc3*", "*.txt", "[x]", "a.b*c?"};
+  for (const auto& glob : globs)
+  {
+    for (bool case_sensitive : {true, false})
+    {
+      const auto pattern = compiled_pattern::glob(glob, case_sensitive);
+      EXPECT_TRUE(pattern.is_dfa()) << glob;
+      for (const auto& input : sample_inputs())
+      {
+        EXPECT_EQ(pattern.matches(input), matches_pattern(input, glob, case_sensitive))
+            << "glob '" << glob << "' input '" << input << "' case_sensitive " << case_sensitive;
+      }
+    }
+  }
+}
+
+TEST(CompiledPatternTest, Glob_IgnoreCase)
+{
+  const auto pattern = compiled_pattern::glob("*.txt", false);
+  EXPECT_TRUE(pattern.matches("Hello.TXT"));
+  EXPECT_TRUE(pattern.matches("a.txt"));
+  EXPECT_FALSE(pattern.matches("a.doc"));
+}
+
+// ============================================================================
+// Regex Tests
+// ============================================================================
+
+TEST(CompiledPatternTest, Regex_AgreesWithStdRegexSearch)
+{
+  const std::vector<std::string> regexes = {"",
+                                            "a",
+                                            "ab",
+                                            "a|b",
+                                            "a*",
+                                            "a+b",
+                                            "ab?c",
+                                            "^a",
+                                            "b$",
+                                            "^ab$",
+                                            "^$",
+                                            "$",
+                                            "^",
+                                            "a$|^b",
+                                            "(ab)+",
+                                            "(?:ab)*c",
+                                            "(a|b)*c",
+                                            "[abc]+",
+                                            "[ab]c",
+                                            "[^abc]",
+                                            "[a-z]+",
+                                            "^[A-Z]{6}$",
+                                            "[0-9]+\\.[0-9]+",
+                                            "\\d+",
+                                            "\\D",
+                                            "\\w+ \\w",
+                                            "\\W",
+                                            "\\s",
+                                            "\\S+",
+                                            "[\\d_]",
+                                            "[-a]",
+                                            "[a-]",
+                                            "\\.",
+                                            "\\n",
+                                            "a\\nb",
+                                            ".",
+                                            "a.b",
+                                            "^.*$",
+                                            ".*USD",
+                                            "(ERROR|FATAL) [0-9]+",
+                                            "a{2}",
+                                            "a{2,}",
+                                            "a{1,3}b",
+                                            "a{0}",
+                                            "(a|ab)(c|bcd)",
+                                            "a*?b",
+                                            "a+?",
+                                            "(a*)*b",
+                                            "(|a)b",
+                                            "()",
+                                            "\xc3\xa9",
+                                            "[\xff]",
+                                            "[^a-z]+$",
+                                            "(a|b)*a(a|b)(a|b)(a|b)",
+                                            "x$|y"};
+  for (const auto& expression : regexes)
+  {
+    const auto       pattern = compiled_pattern::regex(expression);
+    const std::regex reference(expression);
+    EXPECT_TRUE(pattern.is_dfa()) << expression;
+    for (const auto& input : sample_inputs())
+    {
+      EXPECT_EQ(pattern.matches(input), std::regex_search(input, reference))
+          << "regex '" << expression << "' input '" << input << "'";
+    }
+  }
+}
+
+TEST(CompiledPatternTest, Regex_FallsBackForNonRegularSyntax)
+{
+  for (const std::string expression : {"(a)\\1", "\\bab", "a(?=b)", "[[:digit:]]", "\\x41"})
+  {
+    const auto       pattern = compiled_pattern::regex(expression);
+    const std::regex reference(expression);
+    EXPECT_FALSE(pattern.is_dfa()) << expression;
+    EXPECT_EQ(pattern.state_count(), 0u);
+    for (const auto& input : sample_inputs())
+    {
+      EXPECT_EQ(pattern.matches(input), std::regex_search(input, reference))
+          << "regex '" << expression << "' input '" << input << "'";
+    }
+  }
+}
+
+TEST(CompiledPatternTest, Regex_InvalidPatternThrows)
+{
+  for (const char* expression : {"(", "a)", "[a", "*a", "a{2,1}", "\\"})
+  {
+    EXPECT_THROW((void)compiled_pattern::regex(expression), std::regex_error) << expression;
+  }
+}
+
+TEST(CompiledPatternTest, Regex_LargeRepeatFallsBack)
+{
+  // The DFA for this needs 2^12 states
+  const auto pattern = compiled_pattern::regex("(a|b)*a(a|b){11}");
+  EXPECT_FALSE(pattern.is_dfa());
+  EXPECT_TRUE(pattern.matches("abbbbbbbbbbb"));
+  EXPECT_FALSE(pattern.matches("bbbbbbbbbbbb"));
+}
+
+TEST(CompiledPatternTest, Regex_LongInputHasNoBacktracking)
+{
+  const auto        pattern = compiled_pattern::regex("(a*)*b");
+  const std::string input(100000, 'a');
+  EXPECT_FALSE(pattern.matches(input));
+  EXPECT_TRUE(pattern.matches(input + "b"));
+}
+
+// ============================================================================
+// Pattern Cache Tests
+// ============================================================================
+
+TEST(PatternCacheTest, ReturnsSameCompiledPattern)
+{
+  pattern_cache cache(4);
+  const auto    first = cache.regex("[0-9]+");
+  EXPECT_EQ(cache.regex("[0-9]+"), first);
+  EXPECT_EQ(cache.size(), 1u);
+
+  // Globs and regexes with the same text are different patterns
+  EXPECT_NE(cache.glob("[0-9]+"), first);
+  EXPECT_NE(cache.glob("[0-9]+", false), cache.glob("[0-9]+"));
+  EXPECT_EQ(cache.size(), 3u);
+}
+
+TEST(PatternCacheTest, EvictsLeastRecentlyUsed)
+{
+  pattern_cache cache(2);
+  const auto    a = cache.glob("a*");
+  const auto    b = cache.glob("b*");
+  EXPECT_EQ(cache.glob("a*"), a); // a is now the most recent
+  (void)cache.glob("c*");         // evicts b
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.glob("a*"), a);
+  EXPECT_NE(cache.glob("b*"), b);
+
+  // Evicted patterns stay usable
+  EXPECT_TRUE(b->matches("bee"));
+}
+
+TEST(PatternCacheTest, ZeroCapacityAndClear)
+{
+  pattern_cache uncached(0);
+  EXPECT_TRUE(uncached.regex("x")->matches("xyz"));
+  EXPECT_EQ(uncached.size(), 0u);
+  EXPECT_EQ(uncached.capacity(), 0u);
+
+  pattern_cache cache;
+  (void)cache.regex("x");
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(PatternCacheTest, InvalidRegexIsNotCached)
+{
+  pattern_cache cache;
+  EXPECT_THROW((void)cache.regex("("), std::regex_error);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(PatternCacheTest, FilterMatchingUsesDefaultCache)
+{
+  const string_list lines{"ERROR 1", "INFO 2", "FATAL 3"};
+  EXPECT_EQ(lines.filter_matching(std::string("^(ERROR|FATAL)")), string_list({"ERROR 1", "FATAL 3"}));
+  const auto cached = default_pattern_cache().regex("^(ERROR|FATAL)");
+  EXPECT_EQ(lines.filter_matching(std::string("^(ERROR|FATAL)")).size(), 2u);
+  EXPECT_EQ(default_pattern_cache().regex("^(ERROR|FATAL)"), cached);
+}
+
+} // namespace fb::test
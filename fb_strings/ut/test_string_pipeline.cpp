@@ -0,0 +1,140 @@
+/// @file test_string_pipeline.cpp
+/// @brief Unit tests for lazy string_list pipelines
+
+#include <fb/packed_string_list.h>
+#include <fb/string_list.h>
+#include <fb/string_pipeline.h>
+#include <fb/string_utils.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace fb::test
+{
+
+namespace
+{
+
+string_list config_lines()
+{
+  return string_list{"# comment EURUSD", "EURUSD=1.08", "", "# comment", "GBPUSD=1.27", "# EURUSD off"};
+}
+
+} // namespace
+
+// ============================================================================
+// Stage Tests
+// ============================================================================
+
+TEST(StringPipelineTest, FilterChain_MatchesEagerFilters)
+{
+  const string_list lines = config_lines();
+  EXPECT_EQ(lines.view().filter_starts_with("#").filter_containing("EURUSD").join("\n"),
+            lines.filter_starts_with("#").filter_containing("EURUSD").join("\n"));
+  EXPECT_EQ(lines.view().filter_ends_with("1.27").join(), "GBPUSD=1.27");
+  EXPECT_EQ(lines.view().filter_non_empty().count(), 5u);
+}
+
+TEST(StringPipelineTest, FilterWithCustomPredicate)
+{
+  const string_list lines = config_lines();
+  auto              short_lines = lines.view().filter([](std::string_view line) { return line.size() < 10; });
+  EXPECT_EQ(short_lines.to<std::vector<std::string>>(), std::vector<std::string>({"", "# comment"}));
+}
+
+TEST(StringPipelineTest, TransformToViewAndString)
+{
+  const string_list lines = config_lines();
+
+  // Substrings of the source need no allocation
+  auto keys = lines.view()
+                  .filter_containing("=")
+                  .transform([](std::string_view line) { return line.substr(0, line.find('=')); });
+  EXPECT_EQ(keys.join(','), "EURUSD,GBPUSD");
+
+  // Owned results flow into the following stages
+  auto upper = lines.view()
+                   .filter_starts_with("#")
+                   .transform([](std::string_view line) { return fb::to_upper(line); })
+                   .filter_containing("OFF");
+  EXPECT_EQ(upper.to<string_list>(), string_list({"# EURUSD OFF"}));
+}
+
+// ============================================================================
+// Evaluation Tests
+// ============================================================================
+
+TEST(StringPipelineTest, NothingRunsBeforeTerminalOperation)
+{
+  const string_list lines = config_lines();
+  int               calls = 0;
+  auto              pipeline = lines.view().filter([&calls](std::string_view) {
+    ++calls;
+    return true;
+  });
+  EXPECT_EQ(calls, 0);
+  EXPECT_EQ(pipeline.count(), lines.size());
+  EXPECT_EQ(calls, static_cast<int>(lines.size()));
+}
+
+TEST(StringPipelineTest, StagesRunOncePerElementInOrder)
+{
+  const string_list        lines{"a", "bb", "ccc"};
+  std::vector<std::string> trace;
+  lines.view()
+      .filter([&trace](std::string_view s) {
+        trace.push_back("filter " + std::string(s));
+        return s.size() != 2;
+      })
+      .transform([&trace](std::string_view s) {
+        trace.push_back("transform " + std::string(s));
+        return s;
+      })
+      .for_each([&trace](std::string_view s) { trace.push_back("sink " + std::string(s)); });
+
+  // One fused pass: each element goes through every stage before the next
+  EXPECT_EQ(trace,
+            std::vector<std::string>({"filter a", "transform a", "sink a", "filter bb", "filter ccc",
+                                      "transform ccc", "sink ccc"}));
+}
+
+TEST(StringPipelineTest, RerunsSeeSourceChanges)
+{
+  string_list lines{"x1", "y1"};
+  auto        pipeline = lines.view().filter_starts_with(std::string("x"));
+  EXPECT_EQ(pipeline.count(), 1u);
+  lines.push_back("x2");
+  EXPECT_EQ(pipeline.join(' '), "x1 x2");
+}
+
+TEST(StringPipelineTest, EmptySource)
+{
+  const string_list empty;
+  EXPECT_EQ(empty.view().join(","), "");
+  EXPECT_EQ(empty.view().count(), 0u);
+  EXPECT_TRUE(empty.view().to<string_list>().empty());
+}
+
+// ============================================================================
+// Source and Container Tests
+// ============================================================================
+
+TEST(StringPipelineTest, OverPackedStringList)
+{
+  auto packed = packed_string_list::from_lines("AAPL\nMSFT\n\nAMZN\n");
+  auto result = packed.view().filter_non_empty().filter_starts_with("A").to<packed_string_list>();
+  EXPECT_EQ(result, packed_string_list({"AAPL", "AMZN"}));
+}
+
+TEST(StringPipelineTest, CollectsIntoContainers)
+{
+  const string_list lines{"b", "a"};
+  auto              pipeline = lines.view().transform([](std::string_view s) { return std::string(s) + "!"; });
+  EXPECT_EQ(pipeline.to<string_list>(), string_list({"b!", "a!"}));
+  EXPECT_EQ(pipeline.to<std::vector<std::string>>(), std::vector<std::string>({"b!", "a!"}));
+  EXPECT_EQ(pipeline.to<packed_string_list>(), packed_string_list({"b!", "a!"}));
+}
+
+} // namespace fb::test
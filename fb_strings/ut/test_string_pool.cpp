@@ -0,0 +1,143 @@
+/// @file test_string_pool.cpp
+/// @brief Unit tests for the string interning pool
+
+#include <fb/string_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fb::test
+{
+
+// ============================================================================
+// Interning Tests
+// ============================================================================
+
+TEST(StringPoolTest, EqualStringsShareHandleAndCharacters)
+{
+  string_pool pool;
+  EXPECT_TRUE(pool.empty());
+
+  const std::string first  = "XNAS";
+  const std::string second = "XNAS";
+  const auto        a      = pool.intern(first);
+  const auto        b      = pool.intern(second);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(pool.size(), 1u);
+  EXPECT_EQ(pool.view(a), "XNAS");
+  EXPECT_NE(pool.view(a).data(), first.data());
+  EXPECT_EQ(pool.intern_view(first).data(), pool.intern_view(second).data());
+}
+
+TEST(StringPoolTest, HandlesAreDenseInInterningOrder)
+{
+  string_pool pool;
+  EXPECT_EQ(pool.intern("USD"), 0u);
+  EXPECT_EQ(pool.intern("EUR"), 1u);
+  EXPECT_EQ(pool.intern("USD"), 0u);
+  EXPECT_EQ(pool.intern("JPY"), 2u);
+  EXPECT_EQ(pool.size(), 3u);
+}
+
+TEST(StringPoolTest, FindDoesNotInsert)
+{
+  string_pool pool;
+  EXPECT_FALSE(pool.find("BUY").has_value());
+  const auto buy = pool.intern("BUY");
+  EXPECT_EQ(pool.find("BUY"), buy);
+  EXPECT_FALSE(pool.find("SELL").has_value());
+  EXPECT_FALSE(pool.find("BU").has_value());
+  EXPECT_EQ(pool.size(), 1u);
+}
+
+TEST(StringPoolTest, EmptyAndLongStrings)
+{
+  string_pool       pool;
+  const std::string big(100000, 'x');
+
+  const auto empty = pool.intern("");
+  const auto large = pool.intern(big);
+  EXPECT_NE(empty, large);
+  EXPECT_EQ(pool.intern(""), empty);
+  EXPECT_EQ(pool.view(empty), "");
+  EXPECT_EQ(pool.intern(big), large);
+  EXPECT_EQ(pool.view(large), big);
+  EXPECT_GE(pool.arena_bytes(), big.size());
+}
+
+TEST(StringPoolTest, ViewsStayValidWhileThePoolGrows)
+{
+  string_pool                   pool;
+  std::vector<std::string_view> views;
+  for (int i = 0; i < 50000; ++i)
+  {
+    views.push_back(pool.intern_view("symbol-" + std::to_string(i)));
+  }
+
+  EXPECT_EQ(pool.size(), 50000u);
+  for (int i = 0; i < 50000; ++i)
+  {
+    const std::string expected = "symbol-" + std::to_string(i);
+    ASSERT_EQ(views[i], expected);
+    ASSERT_EQ(pool.view(static_cast<string_pool::handle>(i)), expected);
+    ASSERT_EQ(pool.find(expected), static_cast<string_pool::handle>(i));
+  }
+}
+
+// ============================================================================
+// Concurrency Tests
+// ============================================================================
+
+TEST(StringPoolTest, ConcurrentInternAgreesOnHandles)
+{
+  constexpr int THREADS = 4;
+  constexpr int STRINGS = 20000;
+
+  string_pool                                    pool;
+  std::vector<std::vector<string_pool::handle>> handles(THREADS);
+  std::vector<std::thread>                       threads;
+  for (int t = 0; t < THREADS; ++t)
+  {
+    threads.emplace_back(
+      [&pool, &handles, t]
+      {
+        // Each thread walks the strings from a different start
+        for (int i = 0; i < STRINGS; ++i)
+        {
+          const int         n   = (i + t * STRINGS / THREADS) % STRINGS;
+          const std::string str = "k" + std::to_string(n);
+          const auto        h   = pool.intern(str);
+          if (pool.view(h) != str)
+          {
+            ADD_FAILURE() << "view of " << str;
+          }
+          handles[t].push_back(h);
+        }
+      });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  ASSERT_EQ(pool.size(), static_cast<std::size_t>(STRINGS));
+  std::vector<bool> seen(STRINGS, false);
+  for (int i = 0; i < STRINGS; ++i)
+  {
+    const std::string str = "k" + std::to_string(i);
+    const auto        h   = pool.find(str);
+    ASSERT_TRUE(h.has_value());
+    ASSERT_LT(*h, static_cast<string_pool::handle>(STRINGS));
+    EXPECT_FALSE(seen[*h]);
+    seen[*h] = true;
+    for (int t = 0; t < THREADS; ++t)
+    {
+      ASSERT_EQ(handles[t][(i - t * STRINGS / THREADS + STRINGS) % STRINGS], *h);
+    }
+  }
+}
+
+} // namespace fb::test
@@ -7,9 +7,13 @@
 
 #include <algorithm>
 #include <cctype>
+#include <map>
+#include <random>
 #include <regex>
 #include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace fb::test
 {
@@ -305,6 +309,193 @@ TEST(StringRandomTest, UuidRegexMatch)
   EXPECT_TRUE(std::regex_match(uuid, uuid_pattern));
 }
 
+TEST(StringRandomTest, UuidIntoBuffer)
+{
+  char buffer[UUID_LENGTH + 1];
+  buffer[UUID_LENGTH] = '#';
+  random_uuid(buffer);
+  EXPECT_EQ(buffer[UUID_LENGTH], '#');
+  EXPECT_TRUE(std::regex_match(std::string(buffer, UUID_LENGTH),
+                               std::regex("^[0-9a-f]{8}-[0-9a-f]{4}-4[0-9a-f]{3}-[89ab][0-9a-f]{3}-[0-9a-f]{12}$")));
+}
+
+TEST(StringRandomTest, HexIntoBuffer)
+{
+  char buffer[41];
+  buffer[40] = '#';
+  random_hex(buffer, 40, true);
+  EXPECT_EQ(buffer[40], '#');
+  EXPECT_EQ(std::string(buffer, 40).find_first_not_of("0123456789ABCDEF"), std::string::npos);
+}
+
+// ============================================================================
+// Engine and Seeding Tests
+// ============================================================================
+
+TEST(StringRandomTest, EnginesMatchReferenceOutput)
+{
+  // Reference implementations, state filled by splitmix64 from seed 0
+  xoshiro256pp xoshiro(0);
+  EXPECT_EQ(xoshiro(), 0x53175D61490B23DFu);
+  EXPECT_EQ(xoshiro(), 0x61DA6F3DC380D507u);
+  EXPECT_EQ(xoshiro(), 0x5C0FDF91EC9A7BFCu);
+
+  wyrand wy(0);
+  EXPECT_EQ(wy(), 0x111CB3A78F59A58Eu);
+  EXPECT_EQ(wy(), 0xCEABD938FF4E856Du);
+  EXPECT_EQ(wy(), 0x61FB51318F47D2A4u);
+}
+
+TEST(StringRandomTest, SeedRandomReproducesSequence)
+{
+  seed_random(42);
+  const std::string token = random_alphanumeric(40);
+  const std::string uuid  = random_uuid();
+  seed_random(42);
+  EXPECT_EQ(random_alphanumeric(40), token);
+  EXPECT_EQ(random_uuid(), uuid);
+  seed_random(43);
+  EXPECT_NE(random_alphanumeric(40), token);
+}
+
+TEST(StringRandomTest, ExplicitEngines)
+{
+  xoshiro256pp xoshiro(7);
+  wyrand wy(7);
+  std::mt19937_64 mt(7);
+
+  EXPECT_EQ(random_string(xoshiro, 50, "xyz").find_first_not_of("xyz"), std::string::npos);
+  EXPECT_EQ(random_hex(wy, 33).find_first_not_of("0123456789abcdef"), std::string::npos);
+  EXPECT_EQ(random_uuid(mt).size(), UUID_LENGTH);
+  EXPECT_THROW(random_string(wy, 5, ""), std::invalid_argument);
+
+  wyrand first(99);
+  wyrand second(99);
+  EXPECT_EQ(random_string(first, 25), random_string(second, 25));
+  EXPECT_EQ(random_uuid(first), random_uuid(second));
+}
+
+TEST(StringRandomTest, CharsetsAreUniform)
+{
+  // Power-of-two sizes take bits, others base-size digits: both must be unbiased,
+  // including the characters of a partly used draw
+  for (std::string_view charset : {std::string_view("ab"), std::string_view("abc"), std::string_view("0123456789"),
+                                   std::string_view("0123456789abcdef"),
+                                   std::string_view("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"),
+                                   std::string_view("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/")})
+  {
+    xoshiro256pp engine(charset.size());
+    std::map<char, std::size_t> counts;
+    std::size_t total = 0;
+    for (std::size_t length = 1; total < 2000 * charset.size(); length = length % 23 + 1)
+    {
+      for (char ch : random_string(engine, length, charset))
+      {
+        ++counts[ch];
+      }
+      total += length;
+    }
+
+    ASSERT_EQ(counts.size(), charset.size()) << charset;
+    const double expected = static_cast<double>(total) / charset.size();
+    for (const auto& [ch, count] : counts)
+    {
+      EXPECT_NEAR(static_cast<double>(count), expected, expected * 0.12) << charset << " " << ch;
+    }
+  }
+}
+
+// ============================================================================
+// Time-Ordered ID Tests
+// ============================================================================
+
+TEST(StringRandomTest, UuidV7Format)
+{
+  const std::regex v7("^[0-9a-f]{8}-[0-9a-f]{4}-7[0-9a-f]{3}-[89ab][0-9a-f]{3}-[0-9a-f]{12}$");
+  EXPECT_TRUE(std::regex_match(uuid_v7(), v7));
+
+  // RFC 9562 appendix A.6: unix_ts_ms 0x017F22E279B0
+  unique_id_generator generator(1);
+  char id[UUID_LENGTH + 1];
+  id[UUID_LENGTH] = '#';
+  generator.uuid_v7(id, 0x017F22E279B0);
+  EXPECT_EQ(std::string(id, 15), "017f22e2-79b0-7");
+  EXPECT_EQ(id[UUID_LENGTH], '#');
+  EXPECT_TRUE(std::regex_match(std::string(id, UUID_LENGTH), v7));
+}
+
+TEST(StringRandomTest, UlidFormat)
+{
+  const std::regex crockford("^[0-7][0-9A-HJKMNP-TV-Z]{25}$");
+  EXPECT_TRUE(std::regex_match(ulid(), crockford));
+
+  // ULID specification example: 1469918176385 is "01ARYZ6S41"
+  unique_id_generator generator(1);
+  char id[ULID_LENGTH];
+  generator.ulid(id, 1469918176385);
+  EXPECT_EQ(std::string(id, 10), "01ARYZ6S41");
+  EXPECT_TRUE(std::regex_match(std::string(id, ULID_LENGTH), crockford));
+}
+
+TEST(StringRandomTest, TimeOrderedIdsIncrease)
+{
+  unique_id_generator generator(5);
+  std::string previous_uuid;
+  std::string previous_ulid;
+  // Same millisecond many times, then a clock step back, then forward again
+  for (std::uint64_t unix_ms : {1000u, 1000u, 1000u, 1001u, 999u, 999u, 1002u, 5000u})
+  {
+    for (int i = 0; i < 50; ++i)
+    {
+      std::string uuid(UUID_LENGTH, '\0');
+      std::string id(ULID_LENGTH, '\0');
+      generator.uuid_v7(uuid.data(), unix_ms);
+      generator.ulid(id.data(), unix_ms);
+      ASSERT_GT(uuid, previous_uuid) << unix_ms;
+      ASSERT_GT(id, previous_ulid) << unix_ms;
+      previous_uuid = uuid;
+      previous_ulid = id;
+    }
+  }
+
+  std::string previous = uuid_v7();
+  for (int i = 0; i < 10000; ++i)
+  {
+    std::string next = uuid_v7();
+    ASSERT_GT(next, previous);
+    previous = next;
+  }
+}
+
+TEST(StringRandomTest, TimeOrderedIdsUniqueAcrossThreads)
+{
+  constexpr int THREADS = 4;
+  constexpr int PER_THREAD = 5000;
+  std::vector<std::vector<std::string>> ids(THREADS);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < THREADS; ++t)
+  {
+    workers.emplace_back([&ids, t] {
+      for (int i = 0; i < PER_THREAD; ++i)
+      {
+        ids[t].push_back(uuid_v7());
+        ids[t].push_back(ulid());
+      }
+    });
+  }
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  std::set<std::string> unique;
+  for (const auto& list : ids)
+  {
+    unique.insert(list.begin(), list.end());
+  }
+  EXPECT_EQ(unique.size(), static_cast<std::size_t>(THREADS * PER_THREAD * 2));
+}
+
 // ============================================================================
 // Thread Safety Tests
 // ============================================================================
@@ -0,0 +1,108 @@
+/// @file test_string_set.cpp
+/// @brief Unit tests for the frozen string hash set
+
+#include <fb/packed_string_list.h>
+#include <fb/string_list.h>
+#include <fb/string_set.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace fb::test
+{
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(StringSetTest, DistinctElementsInFirstOccurrenceOrder)
+{
+  const string_list list{"EURUSD", "GBPUSD", "EURUSD", "", "USDJPY", ""};
+  const string_set  set(list);
+  EXPECT_EQ(set.size(), 4u);
+  EXPECT_FALSE(set.empty());
+  EXPECT_EQ(set.elements(), packed_string_list({"EURUSD", "GBPUSD", "", "USDJPY"}));
+  EXPECT_EQ(std::vector<std::string_view>(set.begin(), set.end()),
+            std::vector<std::string_view>({"EURUSD", "GBPUSD", "", "USDJPY"}));
+}
+
+TEST(StringSetTest, EmptySet)
+{
+  const string_set set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.contains(""));
+  EXPECT_FALSE(set.contains_ignore_case("x"));
+  EXPECT_FALSE(set.index_of("x").has_value());
+  EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(StringSetTest, FromOtherSources)
+{
+  const std::vector<std::string> vec{"b", "a", "b"};
+  const string_set               from_range(vec.begin(), vec.end());
+  EXPECT_EQ(from_range.size(), 2u);
+  EXPECT_EQ(from_range.index_of("a"), 1u);
+
+  const string_set from_packed(packed_string_list::from_split("x,y,x", ','));
+  EXPECT_EQ(from_packed.size(), 2u);
+  EXPECT_TRUE(from_packed.contains("y"));
+
+  const string_set from_init{"p", "q"};
+  EXPECT_TRUE(from_init.contains("q"));
+}
+
+// ============================================================================
+// Lookup Tests
+// ============================================================================
+
+TEST(StringSetTest, AgreesWithStringListSearch)
+{
+  string_list list;
+  for (int i = 0; i < 5000; ++i)
+  {
+    list.push_back("SYM" + std::to_string(i * 7 % 3001));
+  }
+  const string_set set(list);
+
+  for (int i = 0; i < 8000; i += 3)
+  {
+    const std::string query = "SYM" + std::to_string(i);
+    EXPECT_EQ(set.contains(query), list.contains(query)) << query;
+    EXPECT_EQ(set.index_of(query), list.index_of(query)) << query;
+  }
+  EXPECT_FALSE(set.contains("sym7"));
+  EXPECT_FALSE(set.contains("SYM"));
+}
+
+TEST(StringSetTest, ContainsIgnoreCase)
+{
+  const string_set set{"EURUSD", "eurusd", "Gbp/Usd", "caf\xc3\xa9"};
+  EXPECT_TRUE(set.contains_ignore_case("EurUsd"));
+  EXPECT_TRUE(set.contains_ignore_case("GBP/USD"));
+  EXPECT_TRUE(set.contains_ignore_case("CAF\xc3\xa9"));
+  EXPECT_FALSE(set.contains_ignore_case("CAF\xc3\x89")); // ASCII folding only
+  EXPECT_FALSE(set.contains_ignore_case("GBPUSD"));
+  EXPECT_FALSE(set.contains("EurUsd"));
+}
+
+TEST(StringSetTest, ContainsIgnoreCaseLongStrings)
+{
+  const std::string long_upper(1000, 'A');
+  const string_set  set{long_upper + "x"};
+  EXPECT_TRUE(set.contains_ignore_case(std::string(1000, 'a') + "X"));
+  EXPECT_FALSE(set.contains_ignore_case(std::string(1000, 'a')));
+}
+
+TEST(StringSetTest, IndexOfIsFirstOccurrence)
+{
+  const string_list list{"a", "b", "a", "c", "b"};
+  const string_set  set(list);
+  EXPECT_EQ(set.index_of("a"), 0u);
+  EXPECT_EQ(set.index_of("b"), 1u);
+  EXPECT_EQ(set.index_of("c"), 3u);
+  EXPECT_FALSE(set.index_of("d").has_value());
+}
+
+} // namespace fb::test
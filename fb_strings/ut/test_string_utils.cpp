@@ -2,7 +2,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <limits>
+#include <random>
+#include <vector>
 
 namespace fb
 {
@@ -63,6 +70,45 @@ TEST(StringUtils, TrimWithChars_RemovesSpecifiedChars)
   EXPECT_EQ(trim("abchelloabc", "abc"), "hello");
 }
 
+TEST(StringUtils, TrimView_PointsIntoInput)
+{
+  const std::string_view str = "  \thello world \n";
+  EXPECT_EQ(trim_view(str), "hello world");
+  EXPECT_EQ(trim_view(str).data(), str.data() + 3);
+  EXPECT_EQ(trim_left_view(str), "hello world \n");
+  EXPECT_EQ(trim_right_view(str), "  \thello world");
+  EXPECT_EQ(trim_view(" \t "), "");
+  EXPECT_EQ(trim_view("xxhelloxx", "x"), "hello");
+  EXPECT_EQ(trim_left_view("xxhelloxx", "x"), "helloxx");
+  EXPECT_EQ(trim_right_view("xxhelloxx", "x"), "xxhello");
+  EXPECT_EQ(trim_view("xxx", "x"), "");
+}
+
+TEST(StringUtils, TrimInplace)
+{
+  std::string str = "  hello  ";
+  trim_left_inplace(str);
+  EXPECT_EQ(str, "hello  ");
+  str = "  hello  ";
+  trim_right_inplace(str);
+  EXPECT_EQ(str, "  hello");
+  str = " \r\n hello world\t";
+  trim_inplace(str);
+  EXPECT_EQ(str, "hello world");
+  str = "   ";
+  trim_inplace(str);
+  EXPECT_EQ(str, "");
+
+  str = "..hello..";
+  trim_inplace(str, ".");
+  EXPECT_EQ(str, "hello");
+  str = "..hello..";
+  trim_left_inplace(str, ".");
+  EXPECT_EQ(str, "hello..");
+  trim_right_inplace(str, ".");
+  EXPECT_EQ(str, "hello");
+}
+
 // ============================================================================
 // Case Conversion Tests
 // ============================================================================
@@ -119,6 +165,22 @@ TEST(StringUtils, SwapCase_MixedCase)
   EXPECT_EQ(swap_case("Hello World"), "hELLO wORLD");
 }
 
+TEST(StringUtils, CaseConversionInplace)
+{
+  // Longer than one vector block, with non-ASCII bytes left untouched
+  std::string symbol = "eur/usd.spot-\xC3\xA9-order-book-level-2";
+  to_upper_inplace(symbol);
+  EXPECT_EQ(symbol, "EUR/USD.SPOT-\xC3\xA9-ORDER-BOOK-LEVEL-2");
+  to_lower_inplace(symbol);
+  EXPECT_EQ(symbol, "eur/usd.spot-\xC3\xA9-order-book-level-2");
+  swap_case_inplace(symbol);
+  EXPECT_EQ(symbol, "EUR/USD.SPOT-\xC3\xA9-ORDER-BOOK-LEVEL-2");
+
+  std::string empty;
+  to_lower_inplace(empty);
+  EXPECT_TRUE(empty.empty());
+}
+
 // ============================================================================
 // Prefix/Suffix Tests
 // ============================================================================
@@ -292,6 +354,26 @@ TEST(StringUtils, ReplaceAll_Char)
   EXPECT_EQ(replace_all("hello", 'l', 'L'), "heLLo");
 }
 
+TEST(StringUtils, ReplaceAllInplace_MatchesCopy)
+{
+  const std::vector<std::string> inputs = {"", "hello hello", "aaaaa", "xhellox", "hellohello", "no match"};
+  const std::vector<std::pair<std::string, std::string>> replacements = {
+    {"hello", "hi"}, {"hello", "HELLO"}, {"hello", "hello, world"}, {"aa", "a"}, {"aa", ""}, {"a", "bb"}, {"", "x"}};
+  for (const auto& input : inputs)
+  {
+    for (const auto& [from, to] : replacements)
+    {
+      std::string str = input;
+      replace_all_inplace(str, from, to);
+      EXPECT_EQ(str, replace_all(input, from, to)) << input << " " << from << " -> " << to;
+    }
+  }
+
+  std::string str = "hello";
+  replace_all_inplace(str, 'l', 'L');
+  EXPECT_EQ(str, "heLLo");
+}
+
 // ============================================================================
 // Removal Tests
 // ============================================================================
@@ -316,6 +398,21 @@ TEST(StringUtils, RemoveAll_Char)
   EXPECT_EQ(remove_all("hello", 'l'), "heo");
 }
 
+TEST(StringUtils, RemoveAllInplace)
+{
+  std::string str = "hello world hello";
+  remove_all_inplace(str, "hello");
+  EXPECT_EQ(str, " world ");
+  remove_all_inplace(str, "");
+  EXPECT_EQ(str, " world ");
+
+  str = "lhellol";
+  remove_all_inplace(str, 'l');
+  EXPECT_EQ(str, "heo");
+  remove_all_inplace(str, 'x');
+  EXPECT_EQ(str, "heo");
+}
+
 // ============================================================================
 // Splitting Tests
 // ============================================================================
@@ -401,6 +498,35 @@ TEST(StringUtils, SplitWhitespace)
   EXPECT_EQ(parts[1], "world");
 }
 
+TEST(StringUtils, SplitWhitespace_WordsAcrossBlocks)
+{
+  // Words and blank runs straddling the 64-byte scan blocks
+  std::string              text;
+  std::vector<std::string> expected;
+  for (std::size_t length = 1; length < 150; length += 7)
+  {
+    expected.push_back(std::string(length, 'w'));
+    text += expected.back() + std::string(length % 5 + 1, length % 2 ? ' ' : '\n');
+  }
+  text = "\t" + text + "end";
+  expected.push_back("end");
+
+  EXPECT_EQ(split_whitespace(text), expected);
+  EXPECT_EQ(word_count(text), expected.size());
+}
+
+TEST(StringUtils, WordAndLineCount)
+{
+  EXPECT_EQ(word_count(""), 0u);
+  EXPECT_EQ(word_count(" \t\n "), 0u);
+  EXPECT_EQ(word_count("one two\tthree\nfour"), 4u);
+  EXPECT_EQ(line_count(""), 0u);
+  EXPECT_EQ(line_count("one"), 1u);
+  EXPECT_EQ(line_count("one\ntwo\r\nthree\rfour"), 4u);
+  EXPECT_EQ(line_count("one\ntwo\n"), 2u);
+  EXPECT_EQ(line_count("\n\n"), 2u);
+}
+
 TEST(StringUtils, SplitN_LimitParts)
 {
   auto parts = split_n("a,b,c,d", ',', 2);
@@ -409,6 +535,80 @@ TEST(StringUtils, SplitN_LimitParts)
   EXPECT_EQ(parts[1], "b,c,d");
 }
 
+// ============================================================================
+// Zero-Copy Split Tests
+// ============================================================================
+
+namespace
+{
+
+// Views compare equal to the owning split() for the same input
+void expect_same_parts(const std::vector<std::string>& expected,
+                       const std::vector<std::string_view>& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    EXPECT_EQ(expected[i], actual[i]) << "part " << i;
+  }
+}
+
+} // namespace
+
+TEST(StringUtils, SplitView_MatchesSplit)
+{
+  const char* inputs[] = {"", ",", "a", "a,b,,c,", ",,x,,", "no delimiter"};
+  for (const char* input : inputs)
+  {
+    expect_same_parts(split(input, ','), split_view(input, ','));
+    expect_same_parts(split(input, ',', false), split_view(input, ',', false));
+    expect_same_parts(split(input, ",,"), split_view(input, ",,"));
+    expect_same_parts(split(input, ""), split_view(input, std::string_view()));
+    expect_same_parts(split_any(input, ", "), split_any_view(input, ", "));
+    expect_same_parts(split_any(input, ", ", true), split_any_view(input, ", ", true));
+    expect_same_parts(split_whitespace(input), split_whitespace_view(input));
+    expect_same_parts(split_n(input, ',', 2), split_n_view(input, ',', 2));
+    expect_same_parts(split_n(input, ',', 0), split_n_view(input, ',', 0));
+  }
+}
+
+TEST(StringUtils, SplitLinesView_MatchesSplitLines)
+{
+  const char* inputs[] = {"", "\n", "a\r\nb\rc\n", "a\n\nb", "\r\n\r\n"};
+  for (const char* input : inputs)
+  {
+    expect_same_parts(split_lines(input), split_lines_view(input));
+    expect_same_parts(split_lines(input, false), split_lines_view(input, false));
+  }
+}
+
+TEST(StringUtils, SplitView_PointsIntoInput)
+{
+  std::string message = "8=FIX.4.4|35=D|55=ABC";
+  auto fields         = split_view(message, '|');
+  ASSERT_EQ(fields.size(), 3u);
+  EXPECT_EQ(fields[1], "35=D");
+  EXPECT_EQ(fields[1].data(), message.data() + 10);
+}
+
+TEST(StringUtils, SplitView_ReusesCallerVector)
+{
+  std::vector<std::string_view> fields;
+  split_view("a|b|c|d", '|', fields);
+  ASSERT_EQ(fields.size(), 4u);
+  const auto* storage = fields.data();
+
+  split_view("x|y", '|', fields);
+  ASSERT_EQ(fields.size(), 2u);
+  EXPECT_EQ(fields[0], "x");
+  EXPECT_EQ(fields[1], "y");
+  EXPECT_EQ(fields.data(), storage);
+
+  split_n_view("k=v=w", '=', 2, fields);
+  ASSERT_EQ(fields.size(), 2u);
+  EXPECT_EQ(fields[1], "v=w");
+}
+
 // ============================================================================
 // Join Tests
 // ============================================================================
@@ -718,6 +918,125 @@ TEST(StringUtils, ToDouble_Scientific)
   EXPECT_NEAR(*result, 1.5e10, 1e5);
 }
 
+TEST(StringUtils, ToInteger_Limits)
+{
+  EXPECT_EQ(to_int("2147483647"), 2147483647);
+  EXPECT_EQ(to_int("-2147483648"), std::numeric_limits<int>::min());
+  EXPECT_EQ(to_int("2147483648"), std::nullopt);
+  EXPECT_EQ(to_int("-2147483649"), std::nullopt);
+  EXPECT_EQ(to_llong("9223372036854775807"), std::numeric_limits<long long>::max());
+  EXPECT_EQ(to_llong("-9223372036854775808"), std::numeric_limits<long long>::min());
+  EXPECT_EQ(to_llong("9223372036854775808"), std::nullopt);
+  EXPECT_EQ(to_ullong("18446744073709551615"), std::numeric_limits<unsigned long long>::max());
+  EXPECT_EQ(to_ullong("18446744073709551616"), std::nullopt);
+  EXPECT_EQ(to_ullong("28446744073709551615"), std::nullopt);
+  EXPECT_EQ(to_ullong("100000000000000000000"), std::nullopt);
+  EXPECT_EQ(to_ullong("000000000000000000000000000042"), 42u);
+  EXPECT_EQ(to_ulong("-1"), std::nullopt);
+  EXPECT_EQ(to_long("+17"), 17L);
+  EXPECT_EQ(to_long("-0"), 0L);
+  EXPECT_EQ(to_long("-"), std::nullopt);
+  EXPECT_EQ(to_long("--1"), std::nullopt);
+  EXPECT_EQ(to_long("1 2"), std::nullopt);
+}
+
+TEST(StringUtils, ToInteger_MatchesFromChars)
+{
+  // Every length and a bad character at every position, through the 8-digit chunks
+  std::mt19937_64 rng(21);
+  for (int round = 0; round < 20000; ++round)
+  {
+    std::string digits = std::to_string(rng() >> (rng() % 64));
+    if (round % 3 == 0)
+    {
+      digits[rng() % digits.size()] = "x/:. "[rng() % 5];
+    }
+    std::optional<unsigned long long> expected;
+    unsigned long long value = 0;
+    auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    if (ec == std::errc() && ptr == digits.data() + digits.size())
+    {
+      expected = value;
+    }
+    if (digits.front() == ' ' || digits.back() == ' ')
+    {
+      continue;
+    }
+    ASSERT_EQ(to_ullong(digits), expected) << digits;
+  }
+}
+
+TEST(StringUtils, ToDouble_CorrectlyRounded)
+{
+  std::mt19937_64 rng(5);
+  char buffer[64];
+  for (int round = 0; round < 20000; ++round)
+  {
+    double value;
+    if (round % 2 == 0)
+    {
+      // Prices: few digits, the fast path
+      value = static_cast<double>(rng() % 100000000) / 10000.0;
+    }
+    else
+    {
+      const std::uint64_t bits = rng();
+      std::memcpy(&value, &bits, sizeof(value));
+      if (!std::isfinite(value))
+      {
+        continue;
+      }
+    }
+    const int length = std::snprintf(buffer, sizeof(buffer), round % 4 < 2 ? "%.17g" : "%.6e", value);
+    double expected  = 0;
+    std::from_chars(buffer, buffer + length, expected);
+    ASSERT_EQ(to_double(std::string_view(buffer, static_cast<size_t>(length))), expected) << buffer;
+  }
+}
+
+TEST(StringUtils, ToDouble_Syntax)
+{
+  EXPECT_EQ(to_double("+1.5"), 1.5);
+  EXPECT_EQ(to_double(".5"), 0.5);
+  EXPECT_EQ(to_double("5."), 5.0);
+  EXPECT_EQ(to_double("-0"), 0.0);
+  EXPECT_TRUE(std::signbit(*to_double("-0.0")));
+  EXPECT_EQ(to_double("1E3"), 1000.0);
+  EXPECT_EQ(to_double("1e-3"), 0.001);
+  EXPECT_EQ(to_double("0x1p4"), 16.0);
+  EXPECT_EQ(to_double("-0x1.8p1"), -3.0);
+  EXPECT_TRUE(std::isinf(*to_double("-inf")));
+  EXPECT_TRUE(std::isnan(*to_double("nan")));
+  EXPECT_EQ(to_double("123456789012345678901234567890"), 123456789012345678901234567890.0);
+  EXPECT_EQ(to_double("1e999"), std::nullopt);
+  EXPECT_EQ(to_double("1,5"), std::nullopt);
+  EXPECT_EQ(to_double("1e"), std::nullopt);
+  EXPECT_EQ(to_double("."), std::nullopt);
+  EXPECT_EQ(to_double("+-1"), std::nullopt);
+  EXPECT_EQ(to_float("0.1"), 0.1f);
+  EXPECT_EQ(to_float("16777217"), 16777216.0f);
+}
+
+TEST(StringUtils, ToDecimal)
+{
+  EXPECT_EQ(to_decimal<4>("187.5"), 1875000);
+  EXPECT_EQ(to_decimal<4>("-0.0001"), -1);
+  EXPECT_EQ(to_decimal<4>(" +42 "), 420000);
+  EXPECT_EQ(to_decimal<4>("1.23450000"), 12345);
+  EXPECT_EQ(to_decimal<4>(".5"), 5000);
+  EXPECT_EQ(to_decimal<4>("5."), 50000);
+  EXPECT_EQ(to_decimal<0>("17"), 17);
+  EXPECT_EQ(to_decimal<2>("92233720368547758.07"), std::numeric_limits<std::int64_t>::max());
+  EXPECT_EQ(to_decimal<2>("-92233720368547758.08"), std::numeric_limits<std::int64_t>::min());
+  EXPECT_EQ(to_decimal<2>("92233720368547758.08"), std::nullopt);
+  EXPECT_EQ(to_decimal<4>("1.23456"), std::nullopt);
+  EXPECT_EQ(to_decimal<4>("1e3"), std::nullopt);
+  EXPECT_EQ(to_decimal<4>("1.2.3"), std::nullopt);
+  EXPECT_EQ(to_decimal<4>("."), std::nullopt);
+  EXPECT_EQ(to_decimal<4>("-"), std::nullopt);
+  EXPECT_EQ(to_decimal<4>(""), std::nullopt);
+}
+
 // ============================================================================
 // Number to String Tests
 // ============================================================================
@@ -734,11 +1053,27 @@ TEST(StringUtils, FromInt_WithBase)
   EXPECT_EQ(from_int(255, 16), "ff");
   EXPECT_EQ(from_int(255, 16, true), "FF");
   EXPECT_EQ(from_int(10, 2), "1010");
+  EXPECT_EQ(from_int(-35, 36, true), "-Z");
+  EXPECT_EQ(from_int(std::numeric_limits<int>::min(), 2),
+            "-10000000000000000000000000000000");
+  EXPECT_EQ(from_int(1, 37), "");
+}
+
+TEST(StringUtils, FromDouble)
+{
+  EXPECT_EQ(from_double(3.14159265), "3.14159");
+  EXPECT_EQ(from_double(1234567.0, 3), "1.23e+06");
 }
 
 TEST(StringUtils, FromDouble_Fixed)
 {
   EXPECT_EQ(from_double_fixed(3.14159, 2), "3.14");
+  EXPECT_EQ(from_double_fixed(1e30, 0), "1000000000000000019884624838656");
+}
+
+TEST(StringUtils, FromDouble_Scientific)
+{
+  EXPECT_EQ(from_double_scientific(1234.5, 2), "1.23e+03");
 }
 
 // ============================================================================
@@ -889,6 +1224,73 @@ TEST(StringUtils, NormalizeWhitespace)
   EXPECT_EQ(normalize_whitespace("\t\nhello\n\tworld\n"), "hello world");
 }
 
+TEST(StringUtils, SqueezeAndNormalizeWhitespaceInplace)
+{
+  std::string str = "aabbccca";
+  squeeze_inplace(str);
+  EXPECT_EQ(str, "abca");
+  str = "hello    world  ";
+  squeeze_inplace(str, ' ');
+  EXPECT_EQ(str, "hello world ");
+  str = "x";
+  squeeze_inplace(str);
+  EXPECT_EQ(str, "x");
+
+  str = "  hello \t\n world  ";
+  normalize_whitespace_inplace(str);
+  EXPECT_EQ(str, "hello world");
+  str = " \n ";
+  normalize_whitespace_inplace(str);
+  EXPECT_EQ(str, "");
+}
+
+TEST(StringUtils, ToSnakeCase)
+{
+  EXPECT_EQ(to_snake_case("HelloWorld"), "hello_world");
+  EXPECT_EQ(to_snake_case("helloWorld"), "hello_world");
+  EXPECT_EQ(to_snake_case("Hello World"), "hello_world");
+  EXPECT_EQ(to_snake_case("hello-world"), "hello_world");
+  EXPECT_EQ(to_snake_case("HTTPServer"), "http_server");
+  EXPECT_EQ(to_snake_case("  __  "), "");
+
+  for (const std::string input : {"HelloWorld", "helloWorld", "Hello World", " --hello-- world__", "HTTPServer",
+                                  "already_snake", "aB", "A", ""})
+  {
+    std::string str = input;
+    to_snake_case_inplace(str);
+    EXPECT_EQ(str, to_snake_case(input)) << input;
+  }
+}
+
+TEST(StringUtils, ExpandTabsInplace)
+{
+  EXPECT_EQ(expand_tabs("a\tbc\td\n\tx", 4), "a   bc  d\n    x");
+
+  std::string str = "a\tbc\td\n\tx";
+  expand_tabs_inplace(str, 4);
+  EXPECT_EQ(str, "a   bc  d\n    x");
+  str = "a\tb";
+  expand_tabs_inplace(str, 0);
+  EXPECT_EQ(str, "ab");
+  str = "no tabs";
+  expand_tabs_inplace(str);
+  EXPECT_EQ(str, "no tabs");
+}
+
+TEST(StringUtils, NormalizeLineEndingsInplace_MatchesCopy)
+{
+  for (const std::string input : {"", "a\r\nb\rc\nd", "\r\r\n\n\r", "no breaks", "\n", "x\r"})
+  {
+    for (const std::string_view ending : {"\n", "\r\n", "", "<br/>"})
+    {
+      std::string str = input;
+      normalize_line_endings_inplace(str, ending);
+      EXPECT_EQ(str, normalize_line_endings(input, ending));
+    }
+  }
+  EXPECT_EQ(normalize_line_endings("a\r\nb\rc\nd", "\r\n"), "a\r\nb\r\nc\r\nd");
+}
+
 TEST(StringUtils, WordWrap)
 {
   std::string text = "hello world foo bar";
@@ -920,4 +1322,74 @@ TEST(StringUtils, LevenshteinDistance)
   EXPECT_EQ(levenshtein_distance("", "hello"), 5u);
 }
 
+/// Full-matrix distance, independent of the library kernels
+size_t reference_levenshtein(std::string_view a, std::string_view b)
+{
+  std::vector<std::vector<size_t>> d(a.size() + 1, std::vector<size_t>(b.size() + 1));
+  for (size_t i = 0; i <= a.size(); ++i)
+  {
+    d[i][0] = i;
+  }
+  for (size_t j = 0; j <= b.size(); ++j)
+  {
+    d[0][j] = j;
+  }
+  for (size_t i = 1; i <= a.size(); ++i)
+  {
+    for (size_t j = 1; j <= b.size(); ++j)
+    {
+      d[i][j] = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1)});
+    }
+  }
+  return d[a.size()][b.size()];
+}
+
+TEST(StringUtils, LevenshteinDistance_MatchesReference)
+{
+  // Small alphabets give many partial matches; lengths cross the 64-character word
+  std::mt19937 rng(9);
+  for (int round = 0; round < 3000; ++round)
+  {
+    std::uniform_int_distribution<size_t> length(0, round % 3 == 0 ? 150 : 70);
+    std::uniform_int_distribution<int> letter('a', round % 2 == 0 ? 'c' : 'z');
+    std::string a(length(rng), ' ');
+    std::string b(length(rng), ' ');
+    for (char& ch : a)
+    {
+      ch = static_cast<char>(letter(rng));
+    }
+    for (char& ch : b)
+    {
+      ch = static_cast<char>(letter(rng));
+    }
+
+    const size_t expected = reference_levenshtein(a, b);
+    ASSERT_EQ(levenshtein_distance(a, b), expected) << a << " / " << b;
+    for (size_t bound : {size_t{0}, size_t{1}, size_t{3}, expected - (expected > 0), expected, expected + 1, size_t{200}})
+    {
+      ASSERT_EQ(levenshtein_distance(a, b, bound), std::min(expected, bound + 1)) << a << " / " << b << " bound " << bound;
+      ASSERT_EQ(fuzzy_match(a, b, bound), expected <= bound);
+    }
+  }
+}
+
+TEST(StringUtils, LevenshteinDistance_Bounded)
+{
+  EXPECT_EQ(levenshtein_distance("kitten", "sitting", 3), 3u);
+  EXPECT_EQ(levenshtein_distance("kitten", "sitting", 2), 3u);
+  EXPECT_EQ(levenshtein_distance("a", std::string(1000, 'b'), 5), 6u);
+  EXPECT_EQ(levenshtein_distance("abc", "abc", 0), 0u);
+  EXPECT_EQ(levenshtein_distance("abc", "xyz", std::numeric_limits<size_t>::max()), 3u);
+  EXPECT_EQ(levenshtein_distance("\xff\x80", "\x80\xff"), 2u);
+}
+
+TEST(StringUtils, Similarity)
+{
+  EXPECT_DOUBLE_EQ(similarity("", ""), 1.0);
+  EXPECT_DOUBLE_EQ(similarity("abcd", "abcd"), 1.0);
+  EXPECT_DOUBLE_EQ(similarity("abcd", "abce"), 0.75);
+  EXPECT_TRUE(fuzzy_match("kitten", "sitting", 3));
+  EXPECT_FALSE(fuzzy_match("kitten", "sitting", 2));
+}
+
 } // namespace fb
@@ -6,6 +6,7 @@
 #include "fb/utf8_utils.h"
 
 #include <string>
+#include <vector>
 
 namespace fb::test
 {
@@ -389,4 +390,84 @@ TEST(Utf8UtilsTest, BeyondUnicode)
   EXPECT_FALSE(is_valid_utf8("\xF4\x90\x80\x80"));
 }
 
+// ============================================================================
+// Indexed View Tests
+// ============================================================================
+
+namespace
+{
+
+/// Strings across several index strides, with multi-byte, invalid and
+/// truncated sequences
+std::vector<std::string> indexed_view_samples()
+{
+  std::string mixed;
+  for (int i = 0; i < 300; ++i)
+  {
+    mixed += i % 3 == 0 ? "\xE4\xB8\x96" : i % 3 == 1 ? "a" : "\xF0\x9F\x98\x80";
+  }
+  std::string invalid = mixed;
+  invalid[100]        = '\x80';
+  invalid[251]        = '\xFF';
+  invalid += "\xE4\xB8";
+
+  return {"", "Hello", std::string(200, 'x'), "Hello, \xE4\xB8\x96\xE7\x95\x8C", mixed, invalid,
+          std::string(utf8_indexed_view::STRIDE, 'a') + "\xC3\xA9"};
+}
+
+} // namespace
+
+TEST(Utf8IndexedViewTest, MatchesFreeFunctions)
+{
+  for (const std::string& text : indexed_view_samples())
+  {
+    utf8_indexed_view view(text);
+    SCOPED_TRACE(testing::PrintToString(text));
+
+    ASSERT_EQ(utf8_length(view), utf8_length(text));
+    EXPECT_EQ(view.str(), text);
+    EXPECT_EQ(view.is_ascii(), utf8_length(text) == text.size());
+
+    const std::size_t length = view.length();
+    for (std::size_t i = 0; i <= length + 1; ++i)
+    {
+      ASSERT_EQ(utf8_byte_offset(view, i), utf8_byte_offset(text, i)) << i;
+      ASSERT_EQ(utf8_at(view, i), utf8_at(text, i)) << i;
+      ASSERT_EQ(utf8_left(view, i), utf8_left(text, i)) << i;
+      ASSERT_EQ(utf8_right(view, i), utf8_right(text, i)) << i;
+      ASSERT_EQ(utf8_mid(view, i), utf8_mid(text, i)) << i;
+      for (std::size_t count : {std::size_t{0}, std::size_t{1}, std::size_t{70}, length})
+      {
+        ASSERT_EQ(utf8_mid(view, i, count), utf8_mid(text, i, count)) << i << " " << count;
+      }
+    }
+    for (std::size_t b = 0; b <= text.size() + 1; ++b)
+    {
+      ASSERT_EQ(utf8_codepoint_index(view, b), utf8_codepoint_index(text, b)) << b;
+    }
+  }
+}
+
+TEST(Utf8IndexedViewTest, ReturnsViewsIntoSource)
+{
+  std::string text = "caf\xC3\xA9 \xE4\xB8\x96\xE7\x95\x8C";
+  utf8_indexed_view view(text);
+
+  EXPECT_EQ(view.length(), 7u);
+  EXPECT_EQ(view.at(3), "\xC3\xA9");
+  EXPECT_EQ(view.at(3).data(), text.data() + 3);
+  EXPECT_EQ(view.substr(5, 2), "\xE4\xB8\x96\xE7\x95\x8C");
+  EXPECT_TRUE(view.at(7).empty());
+  EXPECT_TRUE(view.substr(8).empty());
+}
+
+TEST(Utf8IndexedViewTest, DefaultConstructed_IsEmpty)
+{
+  utf8_indexed_view view;
+  EXPECT_EQ(view.length(), 0u);
+  EXPECT_EQ(view.byte_offset(0), 0u);
+  EXPECT_EQ(view.byte_offset(1), std::string::npos);
+  EXPECT_TRUE(view.at(0).empty());
+}
+
 } // namespace fb::test